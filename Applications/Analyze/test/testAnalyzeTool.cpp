@@ -46,6 +46,7 @@ using namespace OpenSim;
 using namespace std;
 
 void testTutorialOne();
+void testParallelAnalyses();
 void testActuationAnalysisWithDisabledForce();
 
 // Test different default activations are respected when activation
@@ -67,6 +68,11 @@ int main()
         cout << e.what() << endl; failures.push_back("testTutorialOne");
     }
 
+    try { testParallelAnalyses(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl; failures.push_back("testParallelAnalyses");
+    }
+
     // produce passive force-length curve
     try { testTugOfWar("Tug_of_War_ConstantVelocity.sto", 0.01); }
     catch (const std::exception& e) {
@@ -145,6 +151,30 @@ void testTutorialOne() {
     cout << "testAnalyzeTutorialOne passed" << endl;
 }
 
+void testParallelAnalyses() {
+    // Analyzing blocks of frames on separate threads must give the same
+    // results as analyzing them in order.
+    AnalyzeTool analyze("PlotterTool.xml");
+    analyze.setName("BothLegsParallel");
+    analyze.setNumThreads(3);
+    analyze.run();
+    Storage resultFiberLength(
+            "testPlotterTool/BothLegsParallel__FiberLength.sto");
+    Storage standardFiberLength("std_BothLegs_fiberLength.sto");
+    ASSERT(resultFiberLength.getSize() == standardFiberLength.getSize(),
+            __FILE__, __LINE__, "testParallelAnalyses has missing frames");
+    CHECK_STORAGE_AGAINST_STANDARD(resultFiberLength, standardFiberLength,
+        std::vector<double>(100, 0.0001), __FILE__, __LINE__,
+        "testParallelAnalyses failed");
+
+    Storage resultForces("testPlotterTool/BothLegsParallel_Actuation_force.sto");
+    Storage serialForces("testPlotterTool/BothLegs_Actuation_force.sto");
+    CHECK_STORAGE_AGAINST_STANDARD(resultForces, serialForces,
+        std::vector<double>(100, 1e-8), __FILE__, __LINE__,
+        "testParallelAnalyses Actuation forces failed");
+    cout << "testParallelAnalyses passed" << endl;
+}
+
 void testTugOfWar(const string& dataFileName, const double& defaultAct) {
     AnalyzeTool analyze("Tug_of_War_Setup_Analyze.xml");
     analyze.setCoordinatesFileName("");
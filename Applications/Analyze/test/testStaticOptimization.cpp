@@ -46,6 +46,10 @@ void testModelWithPassiveForces();
 
 void testRelativePathInExternalLoads();
 
+void testArm26QuadraticProgram();
+
+void testArm26Parallel();
+
 int main()
 {
     Array<string> muscleModelNames;
@@ -105,6 +109,22 @@ int main()
         failures.push_back("testArm26DisabledMuscles");
     }
 
+    try {
+        testArm26QuadraticProgram();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testArm26QuadraticProgram");
+    }
+
+    try {
+        testArm26Parallel();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testArm26Parallel");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -265,4 +285,81 @@ void testArm26DisabledMuscles() {
     ASSERT_EQUAL(forces.getColumnLabels().findIndex("TRIlat"), -1);
     ASSERT_EQUAL(forces.getColumnLabels().findIndex("TRImed"), -1);
 
-}
\ No newline at end of file
+}
+void testArm26QuadraticProgram() {
+    // The quadratic program solver should find the same solution as ipopt.
+    const string setupFile = "arm26_bounds_Setup_StaticOptimization.xml";
+    AnalyzeTool ipopt(setupFile);
+    ipopt.setResultsDir("Results_arm26_StaticOptimization_ipopt");
+    ipopt.run();
+
+    AnalyzeTool qp(setupFile);
+    qp.setResultsDir("Results_arm26_StaticOptimization_qp");
+    auto& so = dynamic_cast<StaticOptimization&>(qp.updAnalysisSet().get(0));
+    so.setOptimizerAlgorithm("qp");
+    qp.run();
+
+    Storage ipoptActivations(ipopt.getResultsDir() +
+            "/arm26_bounds_StaticOptimization_activation.sto");
+    Storage qpActivations(qp.getResultsDir() +
+            "/arm26_bounds_StaticOptimization_activation.sto");
+    CHECK_STORAGE_AGAINST_STANDARD(qpActivations, ipoptActivations,
+        std::vector<double>(6, 1e-3),
+        __FILE__, __LINE__,
+        "Arm26 activations with the quadratic program solver failed.");
+
+    Storage ipoptForces(ipopt.getResultsDir() +
+            "/arm26_bounds_StaticOptimization_force.sto");
+    Storage qpForces(qp.getResultsDir() +
+            "/arm26_bounds_StaticOptimization_force.sto");
+    CHECK_STORAGE_AGAINST_STANDARD(qpForces, ipoptForces,
+        std::vector<double>(6, 1),
+        __FILE__, __LINE__,
+        "Arm26 forces with the quadratic program solver failed.");
+
+    // The quadratic program requires an activation exponent of 2.
+    AnalyzeTool cubic(setupFile);
+    auto& soCubic =
+            dynamic_cast<StaticOptimization&>(cubic.updAnalysisSet().get(0));
+    soCubic.setOptimizerAlgorithm("qp");
+    soCubic.setActivationExponent(3);
+    ASSERT_THROW(OpenSim::Exception, cubic.run());
+}
+
+void testArm26Parallel() {
+    // Solving contiguous ranges of times on separate threads should give the
+    // same results, in the same order, as solving all the times on one thread.
+    const string setupFile = "arm26_Setup_StaticOptimization.xml";
+    AnalyzeTool serial(setupFile);
+    serial.setResultsDir("Results_arm26_StaticOptimization_serial");
+    dynamic_cast<StaticOptimization&>(serial.updAnalysisSet().get(0))
+            .setOptimizerAlgorithm("qp");
+    serial.run();
+
+    AnalyzeTool parallel(setupFile);
+    parallel.setResultsDir("Results_arm26_StaticOptimization_parallel");
+    dynamic_cast<StaticOptimization&>(parallel.updAnalysisSet().get(0))
+            .setOptimizerAlgorithm("qp");
+    parallel.setNumThreads(3);
+    parallel.run();
+
+    Storage serialActivations(serial.getResultsDir() +
+            "/arm26_StaticOptimization_activation.sto");
+    Storage parallelActivations(parallel.getResultsDir() +
+            "/arm26_StaticOptimization_activation.sto");
+    ASSERT_EQUAL(serialActivations.getSize(), parallelActivations.getSize());
+    CHECK_STORAGE_AGAINST_STANDARD(parallelActivations, serialActivations,
+        std::vector<double>(6, 1e-4),
+        __FILE__, __LINE__,
+        "Arm26 activations with multiple threads failed.");
+
+    Storage serialForces(serial.getResultsDir() +
+            "/arm26_StaticOptimization_force.sto");
+    Storage parallelForces(parallel.getResultsDir() +
+            "/arm26_StaticOptimization_force.sto");
+    ASSERT_EQUAL(serialForces.getSize(), parallelForces.getSize());
+    CHECK_STORAGE_AGAINST_STANDARD(parallelForces, serialForces,
+        std::vector<double>(6, 0.1),
+        __FILE__, __LINE__,
+        "Arm26 forces with multiple threads failed.");
+}
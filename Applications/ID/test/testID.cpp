@@ -70,6 +70,18 @@ int main()
             "testGait failed");
         cout << "testGait passed" << endl;
 
+        // Solving the frames on multiple threads must give the same results.
+        InverseDynamicsTool id3("subject01_Setup_InverseDynamics.xml");
+        id3.setNumThreads(3);
+        id3.setOutputGenForceFileName(
+                "subject01_InverseDynamics_parallel.sto");
+        id3.run();
+        Storage result3("Results/subject01_InverseDynamics_parallel.sto");
+        CHECK_STORAGE_AGAINST_STANDARD(result3, result2,
+            std::vector<double>(23, 1e-5), __FILE__, __LINE__,
+            "testGait with multiple threads failed");
+        cout << "testGait with multiple threads passed" << endl;
+
         testThoracoscapularShoulderModel();
         cout << "testThoracoscapularShoulderModel passed" << endl;
         // Commented out testBallJoint due to sporadic crash in Model destructor
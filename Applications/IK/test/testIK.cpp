@@ -106,6 +106,26 @@ int main()
         failures.push_back("testInverseKinematicsGait2354_GUI_workflow");
     }
 
+    try {
+        // Solving time segments on separate threads gives the same result.
+        InverseKinematicsTool ikParallel(
+                "subject01_Setup_InverseKinematics.xml");
+        ikParallel.setNumThreads(3);
+        ikParallel.setOutputMotionFileName(
+                "subject01_walk1_ik_parallel.mot");
+        ikParallel.run();
+        Storage resultParallel(ikParallel.getOutputMotionFileName());
+        CHECK_STORAGE_AGAINST_STANDARD(resultParallel, standard,
+            std::vector<double>(24, 0.2), __FILE__, __LINE__,
+            "testInverseKinematicsGait2354 with multiple threads failed");
+        cout << "testInverseKinematicsGait2354 with multiple threads passed"
+             << endl;
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testInverseKinematicsGait2354_multiple_threads");
+    }
+
     try {
         InverseKinematicsTool ik3("constraintTest_setup_ik.xml");
         ik3.run();
@@ -90,6 +90,38 @@ int main()
         std::vector<double>(nc, 10.0), __FILE__, __LINE__,
         "testOpenSense::IK solutions differed due to heading.");
 
+    // Solving time segments on separate threads gives the same result.
+    ik_hjc.setModel(facingX);
+    ik_hjc.setNumThreads(3);
+    ik_hjc.set_results_directory("ik_hjc_parallel_" + facingX.getName());
+    ik_hjc.run(false);
+    Storage ik_X_parallel("ik_hjc_parallel_" + facingX.getName() +
+        "/ik_MT_012005D6_009-quaternions_RHJCSwinger.mot");
+    CHECK_STORAGE_AGAINST_STANDARD(ik_X_parallel, ik_X,
+        std::vector<double>(nc, 0.2), __FILE__, __LINE__,
+        "testOpenSense::IK solutions differed with multiple threads.");
+
+    // Solving several trials at once with the same calibrated model gives
+    // the same result as solving each trial. The swinger trial spans the
+    // time range of the setup (417 to 431 s), but the calibration trial does
+    // not, so both trials are solved in full.
+    ik_hjc.setNumThreads(2);
+    ik_hjc.set_time_range(0, -SimTK::Infinity);
+    ik_hjc.set_time_range(1, SimTK::Infinity);
+    ik_hjc.set_results_directory("ik_batch_" + facingX.getName());
+    ik_hjc.runInverseKinematicsWithOrientationsFromFiles(facingX,
+        {"MT_012005D6_009-quaternions_RHJCSwinger.sto",
+         "MT_012005D6_009-quaternions_calibration_trial_Facing_X.sto"});
+    Storage ik_X_batch("ik_batch_" + facingX.getName() +
+        "/ik_MT_012005D6_009-quaternions_RHJCSwinger.mot");
+    CHECK_STORAGE_AGAINST_STANDARD(ik_X_batch, ik_X,
+        std::vector<double>(nc, 1e-6), __FILE__, __LINE__,
+        "testOpenSense::IK solutions differed when solving a batch.");
+    Storage ik_X_calibration("ik_batch_" + facingX.getName() +
+        "/ik_MT_012005D6_009-quaternions_calibration_trial_Facing_X.mot");
+    ASSERT(ik_X_calibration.getSize() > 0);
+    ik_hjc.setNumThreads(1);
+
     // Test a case where model pelvis rotation is non-zero so pelvis-x is different from ground-x
     IMUPlacer imuPlacer_rot("calibrate_rotated.xml");
     imuPlacer_rot.run();
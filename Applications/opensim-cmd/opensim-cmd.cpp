@@ -21,9 +21,12 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
+#include "opensim-cmd_fit-paths.h"
 #include "opensim-cmd_info.h"
 #include "opensim-cmd_print-xml.h"
+#include "opensim-cmd_run-batch.h"
 #include "opensim-cmd_run-tool.h"
+#include "opensim-cmd_serve.h"
 #include "opensim-cmd_update-file.h"
 #include "opensim-cmd_viz.h"
 #include "parse_arguments.h"
@@ -53,10 +56,13 @@ Options:
 
 Available commands:
   run-tool     Run a tool (e.g., Inverse Kinematics) from an XML setup file.
+  run-batch    Run the tools of many XML setup files listed in a manifest.
+  serve        Run the tools of XML setup files read from standard input.
   print-xml    Print a template XML file for a Tool or class.
   info         Show description of properties in an OpenSim class.
   update-file  Update an .xml file (.osim or setup) to this version's format.
   viz          Show a model, motion, or data with the Simbody Visualizer.
+  fit-paths    Replace a model's GeometryPaths with fitted FunctionBasedPaths.
 
   Pass -h or --help to any of these commands to learn how to use them.
 
@@ -94,9 +100,12 @@ int main(int argc, const char** argv) {
 
     commands["print-xml"] = print_xml;
     commands["run-tool"] = run_tool;
+    commands["run-batch"] = run_batch;
+    commands["serve"] = serve;
     commands["info"] = info;
     commands["update-file"] = update_file;
     commands["viz"] = viz;
+    commands["fit-paths"] = fit_paths;
 
     // If no arguments are provided; just print the help text.
     // -------------------------------------------------------
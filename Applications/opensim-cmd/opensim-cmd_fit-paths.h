@@ -0,0 +1,87 @@
+#ifndef OPENSIM_CMD_FIT_PATHS_H_
+#define OPENSIM_CMD_FIT_PATHS_H_
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  opensim-cmd_fit-paths.h                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <iostream>
+
+#include <docopt.h>
+#include "parse_arguments.h"
+
+static const char HELP_FIT_PATHS[] =
+R"(Replace a model's GeometryPaths with fitted polynomial FunctionBasedPaths.
+
+Usage:
+  opensim-cmd [options]... fit-paths <input-model> <output-model>
+  opensim-cmd fit-paths -h | --help
+
+Options:
+  -L <path>, --library <path>  Load a plugin.
+  -o <level>, --log <level>  Logging level.
+  -n <n>, --samples <n>  Number of coordinate samples [default: 1000].
+  -m <n>, --max-order <n>  Largest polynomial order [default: 6].
+  -j <n>, --threads <n>  Number of threads (0 for all) [default: 0].
+
+Description:
+  The independent, unlocked coordinates of <input-model> are sampled within
+  their ranges, and the lengths and moment arms of each path (of muscles,
+  ligaments, path springs, etc.) are computed at each sample. A
+  MultivariatePolynomialFunction of the coordinates the path depends on is
+  then fitted to these data, and the path is replaced with a
+  FunctionBasedPath using this function. The resulting model is written to
+  <output-model>.
+
+  For more control (e.g., over the error tolerances), create a setup file
+  with `opensim-cmd print-xml PolynomialPathFitter` and run it with
+  `opensim-cmd run-tool`.
+
+Examples:
+  opensim-cmd fit-paths arm26.osim arm26_fitted.osim
+  opensim-cmd fit-paths --max-order=4 --threads=8 gait.osim gait_fitted.osim
+)";
+
+int fit_paths(int argc, const char** argv) {
+
+    using namespace OpenSim;
+
+    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
+            HELP_FIT_PATHS, { argv + 1, argv + argc },
+            true); // show help if requested
+
+    const std::string inputFile = args["<input-model>"].asString();
+    const std::string outputFile = args["<output-model>"].asString();
+
+    PolynomialPathFitter fitter;
+    fitter.setModelFileName(inputFile);
+    fitter.setNumSamples(static_cast<int>(args["--samples"].asLong()));
+    fitter.setMaximumPolynomialOrder(
+            static_cast<int>(args["--max-order"].asLong()));
+    fitter.setNumThreads(static_cast<int>(args["--threads"].asLong()));
+
+    if (!fitter.run()) return EXIT_FAILURE;
+
+    log_info("Printing fitted model to '{}'.", outputFile);
+    fitter.getFittedModel().print(outputFile);
+    return EXIT_SUCCESS;
+}
+
+#endif // OPENSIM_CMD_FIT_PATHS_H_
@@ -0,0 +1,506 @@
+#ifndef OPENSIM_CMD_RUN_BATCH_H_
+#define OPENSIM_CMD_RUN_BATCH_H_
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  opensim-cmd_run-batch.h                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#ifdef OPENSIM_WITH_MPI
+#include <mpi.h>
+#endif
+
+#include <docopt.h>
+#include "opensim-cmd_run-tool.h"
+#include "parse_arguments.h"
+
+static const char HELP_RUN_BATCH[] =
+R"(Run the tools of many XML setup files listed in a manifest file.
+
+Usage:
+  opensim-cmd [options]... run-batch [--jobs=<n> | --mpi] [--summary=<file>] <manifest-file>
+  opensim-cmd run-batch -h | --help
+
+Options:
+  -L <path>, --library <path>  Load a plugin.
+  -o <level>, --log <level>  Logging level.
+  -j <n>, --jobs <n>  Number of worker processes [default: 1].
+  --mpi  Distribute the jobs among the processes of an MPI job.
+  -s <file>, --summary <file>  Write the time and status of each job to a file.
+
+Description:
+  The manifest file lists one setup file per line (of any tool supported by
+  `opensim-cmd run-tool`), relative to the directory of the manifest. Empty
+  lines and lines starting with '#' are ignored. Each setup file is run as
+  `opensim-cmd run-tool` would run it from the directory of the setup file.
+
+  The jobs are distributed among --jobs worker processes (the tools change the
+  working directory of their process, so they cannot run on threads of one
+  process). The jobs of a worker run one after another, so that a process is
+  started and the plugins are loaded once per worker rather than once per job.
+  The model files of Inverse Kinematics and Inverse Dynamics setup files are
+  parsed once per worker and copied for each job that uses them. A job that
+  fails does not stop the other jobs.
+
+  With --mpi, the command must be started by an MPI launcher (e.g., `mpirun
+  -n 65 opensim-cmd run-batch --mpi manifest.txt`), possibly on many nodes,
+  and OpenSim must have been built with MPI (OPENSIM_WITH_MPI). The first
+  process reads the manifest and sends the list of setup files to the others
+  once; it then assigns the jobs one at a time to the other processes, each
+  of which is assigned its next job when it reports the result of the
+  previous one, so that long jobs (e.g., Moco solves that take longer to
+  converge) do not leave processes idle. Each process runs its jobs one after
+  another and parses each model file once, as with --jobs. The results of all
+  the jobs are gathered by the first process, which writes the summary; the
+  tools write their results to the files of their setup files (use, e.g., the
+  results_file of AnalyzeTool, or a .h5 solution file of a MocoStudy, to
+  write a few files per job on shared file systems).
+
+  At the end, the wall-clock time and the status of each job are printed and,
+  with --summary, written to a tab-separated file with the columns
+  setup_file, status (success or failure), seconds, and message (the error, if
+  any). The command succeeds only if all the jobs succeed.
+
+Examples:
+  opensim-cmd run-batch study_manifest.txt
+  opensim-cmd run-batch --jobs=8 --summary=study_summary.txt study_manifest.txt
+  mpirun -n 256 opensim-cmd run-batch --mpi study_manifest.txt
+)";
+
+namespace {
+
+struct BatchJobResult {
+    std::string setupFile;
+    bool success = false;
+    double seconds = 0;
+    std::string message;
+};
+
+/// The absolute paths of the setup files listed in a manifest file.
+std::vector<std::string> read_batch_manifest(const std::string& manifestFile) {
+    using namespace OpenSim;
+    std::ifstream manifest(manifestFile);
+    OPENSIM_THROW_IF(!manifest, Exception,
+            "Could not open the manifest file '{}'.", manifestFile);
+    const std::string manifestDir = IO::getParentDirectory(
+            SimTK::Pathname::getAbsolutePathname(manifestFile));
+    std::vector<std::string> setupFiles;
+    std::string line;
+    while (std::getline(manifest, line)) {
+        IO::TrimWhitespace(line);
+        if (line.empty() || line[0] == '#') continue;
+        setupFiles.push_back(SimTK::Pathname::
+                getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                        manifestDir, line));
+    }
+    return setupFiles;
+}
+
+/// Run one job in this process.
+BatchJobResult run_batch_job(const std::string& setupFile,
+        ModelCache& modelCache) {
+    using namespace OpenSim;
+    BatchJobResult result;
+    result.setupFile = setupFile;
+    log_info("Running '{}'...", setupFile);
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        auto cwd = IO::CwdChanger::changeToParentOf(setupFile);
+        result.success = run_setup_file(setupFile, &modelCache);
+        if (!result.success) result.message = "The tool failed.";
+    } catch (const std::exception& e) {
+        result.message = e.what();
+    }
+    result.seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    if (!result.success) {
+        log_error("'{}' failed: {}", setupFile, result.message);
+    }
+    return result;
+}
+
+/// Run the jobs one after another in this process.
+std::vector<BatchJobResult> run_batch_jobs(
+        const std::vector<std::string>& setupFiles) {
+    ModelCache modelCache;
+    std::vector<BatchJobResult> results;
+    for (const auto& setupFile : setupFiles) {
+        results.push_back(run_batch_job(setupFile, modelCache));
+    }
+    return results;
+}
+
+void write_batch_summary(const std::string& summaryFile,
+        const std::vector<BatchJobResult>& results) {
+    using namespace OpenSim;
+    std::ofstream summary(summaryFile);
+    OPENSIM_THROW_IF(!summary, Exception,
+            "Could not open the summary file '{}'.", summaryFile);
+    summary << "setup_file\tstatus\tseconds\tmessage\n";
+    for (const auto& result : results) {
+        std::string message = result.message;
+        for (char& c : message) {
+            if (c == '\t' || c == '\n' || c == '\r') c = ' ';
+        }
+        summary << result.setupFile << "\t"
+                << (result.success ? "success" : "failure") << "\t"
+                << result.seconds << "\t" << message << "\n";
+    }
+}
+
+/// Read the results written by write_batch_summary(), keyed by setup file.
+std::map<std::string, BatchJobResult> read_batch_summary(
+        const std::string& summaryFile) {
+    std::map<std::string, BatchJobResult> results;
+    std::ifstream summary(summaryFile);
+    std::string line;
+    std::getline(summary, line); // Header.
+    while (std::getline(summary, line)) {
+        std::istringstream fields(line);
+        BatchJobResult result;
+        std::string status, seconds;
+        std::getline(fields, result.setupFile, '\t');
+        std::getline(fields, status, '\t');
+        std::getline(fields, seconds, '\t');
+        std::getline(fields, result.message);
+        result.success = status == "success";
+        result.seconds = std::atof(seconds.c_str());
+        results[result.setupFile] = result;
+    }
+    return results;
+}
+
+/// Run the jobs in `numWorkers` processes of this program (`program`), which
+/// are passed `options` (e.g., the plugins to load). The worker processes
+/// read their jobs from, and write their results to, temporary files next to
+/// `manifestFile`.
+std::vector<BatchJobResult> run_batch_workers(const std::string& program,
+        const std::string& options, const std::string& manifestFile,
+        const std::vector<std::string>& setupFiles, int numWorkers) {
+    using namespace OpenSim;
+    const int numJobs = (int)setupFiles.size();
+    std::vector<std::string> workerManifests(numWorkers);
+    std::vector<std::string> workerSummaries(numWorkers);
+    std::vector<std::thread> workers;
+    for (int w = 0; w < numWorkers; ++w) {
+        const std::string base = SimTK::Pathname::getAbsolutePathname(
+                manifestFile) + ".worker" + std::to_string(w);
+        workerManifests[w] = base + ".manifest";
+        workerSummaries[w] = base + ".summary";
+        {
+            // Distribute the jobs round-robin, so that each worker gets a
+            // share of the jobs of each part of the manifest.
+            std::ofstream manifest(workerManifests[w]);
+            OPENSIM_THROW_IF(!manifest, Exception,
+                    "Could not write the file '{}'.", workerManifests[w]);
+            for (int i = w; i < numJobs; i += numWorkers) {
+                manifest << setupFiles[i] << "\n";
+            }
+        }
+        std::string command = "\"" + program + "\"" + options +
+                " run-batch --summary=\"" + workerSummaries[w] + "\" \"" +
+                workerManifests[w] + "\"";
+#ifdef _WIN32
+        // cmd.exe removes the outer quotes of the command.
+        command = "\"" + command + "\"";
+#endif
+        log_info("Starting worker {} of {}.", w + 1, numWorkers);
+        workers.emplace_back([command]() { std::system(command.c_str()); });
+    }
+    for (auto& worker : workers) worker.join();
+
+    std::map<std::string, BatchJobResult> resultsByFile;
+    for (int w = 0; w < numWorkers; ++w) {
+        const auto workerResults = read_batch_summary(workerSummaries[w]);
+        resultsByFile.insert(workerResults.begin(), workerResults.end());
+        std::remove(workerManifests[w].c_str());
+        std::remove(workerSummaries[w].c_str());
+    }
+    std::vector<BatchJobResult> results;
+    for (const auto& setupFile : setupFiles) {
+        auto it = resultsByFile.find(setupFile);
+        if (it != resultsByFile.end()) {
+            results.push_back(it->second);
+        } else {
+            BatchJobResult result;
+            result.setupFile = setupFile;
+            result.message = "The worker process did not report this job.";
+            results.push_back(result);
+        }
+    }
+    return results;
+}
+
+/// Write the summary (if requested) and print the results; returns the exit
+/// status of the command.
+int report_batch_results(std::map<std::string, docopt::value>& args,
+        const std::vector<BatchJobResult>& results, double seconds) {
+    using namespace OpenSim;
+    if (args["--summary"]) {
+        write_batch_summary(args["--summary"].asString(), results);
+    }
+
+    int numSucceeded = 0;
+    std::cout << "\n" << "    time (s)  status   setup file" << std::endl;
+    for (const auto& result : results) {
+        char time[32];
+        std::snprintf(time, sizeof(time), "%12.2f", result.seconds);
+        std::cout << time << "  " << (result.success ? "success" : "FAILURE")
+                  << "  " << result.setupFile << std::endl;
+        if (result.success) ++numSucceeded;
+    }
+    log_info("{} of {} jobs succeeded in {:.2f} s.", numSucceeded,
+            results.size(), seconds);
+    return numSucceeded == (int)results.size() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#ifdef OPENSIM_WITH_MPI
+const int MPI_TAG_RESULT = 1;
+const int MPI_TAG_JOB = 2;
+
+/// Initializes MPI (if necessary) for the lifetime of this object.
+class MPISession {
+public:
+    MPISession() {
+        int initialized = 0;
+        MPI_Initialized(&initialized);
+        if (!initialized) {
+            MPI_Init(nullptr, nullptr);
+            m_finalize = true;
+        }
+        MPI_Comm_rank(MPI_COMM_WORLD, &m_rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &m_size);
+    }
+    ~MPISession() { if (m_finalize) MPI_Finalize(); }
+    int getRank() const { return m_rank; }
+    int getSize() const { return m_size; }
+private:
+    bool m_finalize = false;
+    int m_rank = 0;
+    int m_size = 1;
+};
+
+/// Send the setup files from the first process to all the others, in one
+/// message. A negative size tells the other processes that the manifest
+/// could not be read.
+std::vector<std::string> broadcast_setup_files(
+        const std::vector<std::string>& setupFiles, bool valid, int rank) {
+    std::string buffer;
+    for (const auto& setupFile : setupFiles) buffer += setupFile + "\n";
+    int size = valid ? (int)buffer.size() : -1;
+    MPI_Bcast(&size, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    OPENSIM_THROW_IF(size < 0, OpenSim::Exception,
+            "The first process could not read the manifest file.");
+    buffer.resize(size);
+    if (size) MPI_Bcast(&buffer[0], size, MPI_CHAR, 0, MPI_COMM_WORLD);
+    if (rank == 0) return setupFiles;
+    std::vector<std::string> received;
+    std::istringstream lines(buffer);
+    std::string line;
+    while (std::getline(lines, line)) received.push_back(line);
+    return received;
+}
+
+/// On the first process, assign the jobs dynamically to the other processes
+/// (see run_batch_mpi_worker()) and gather their results.
+std::vector<BatchJobResult> run_batch_mpi_coordinator(
+        const std::vector<std::string>& setupFiles, int numProcesses) {
+    using namespace OpenSim;
+    const int numJobs = (int)setupFiles.size();
+    std::vector<BatchJobResult> results(numJobs);
+    for (int i = 0; i < numJobs; ++i) {
+        results[i].setupFile = setupFiles[i];
+        results[i].message = "The worker process did not report this job.";
+    }
+    int nextJob = 0;
+    int numActiveWorkers = numProcesses - 1;
+    while (numActiveWorkers > 0) {
+        // The first message of a worker is empty; the others contain the
+        // result of its last job.
+        MPI_Status status;
+        MPI_Probe(MPI_ANY_SOURCE, MPI_TAG_RESULT, MPI_COMM_WORLD, &status);
+        int size = 0;
+        MPI_Get_count(&status, MPI_CHAR, &size);
+        std::string buffer(size, '\0');
+        MPI_Recv(size ? &buffer[0] : nullptr, size, MPI_CHAR,
+                status.MPI_SOURCE, MPI_TAG_RESULT, MPI_COMM_WORLD,
+                MPI_STATUS_IGNORE);
+        if (!buffer.empty()) {
+            std::istringstream fields(buffer);
+            std::string index, success, seconds, message;
+            std::getline(fields, index, '\t');
+            std::getline(fields, success, '\t');
+            std::getline(fields, seconds, '\t');
+            std::getline(fields, message, '\0');
+            auto& result = results.at(std::atoi(index.c_str()));
+            result.success = success == "1";
+            result.seconds = std::atof(seconds.c_str());
+            result.message = message;
+        }
+        int job = -1;
+        if (nextJob < numJobs) {
+            job = nextJob++;
+            log_info("Assigning job {} of {} to process {}.", job + 1,
+                    numJobs, status.MPI_SOURCE);
+        } else {
+            --numActiveWorkers;
+        }
+        MPI_Send(&job, 1, MPI_INT, status.MPI_SOURCE, MPI_TAG_JOB,
+                MPI_COMM_WORLD);
+    }
+    return results;
+}
+
+/// On the other processes, run the jobs assigned by the first process until
+/// there are no more jobs.
+void run_batch_mpi_worker(const std::vector<std::string>& setupFiles) {
+    ModelCache modelCache;
+    std::string buffer;
+    while (true) {
+        MPI_Send(buffer.empty() ? nullptr : &buffer[0], (int)buffer.size(),
+                MPI_CHAR, 0, MPI_TAG_RESULT, MPI_COMM_WORLD);
+        int job = -1;
+        MPI_Recv(&job, 1, MPI_INT, 0, MPI_TAG_JOB, MPI_COMM_WORLD,
+                MPI_STATUS_IGNORE);
+        if (job < 0) break;
+        const auto result = run_batch_job(setupFiles.at(job), modelCache);
+        std::ostringstream message;
+        message << job << "\t" << (result.success ? 1 : 0) << "\t"
+                << result.seconds << "\t" << result.message;
+        buffer = message.str();
+    }
+}
+
+/// Run the jobs on the processes of an MPI job (see the help of --mpi).
+int run_batch_mpi(std::map<std::string, docopt::value>& args) {
+    using namespace OpenSim;
+    MPISession mpi;
+    const int rank = mpi.getRank();
+    std::vector<std::string> setupFiles;
+    std::string error;
+    if (rank == 0) {
+        const std::string manifestFile = args["<manifest-file>"].asString();
+        try {
+            setupFiles = read_batch_manifest(manifestFile);
+            if (setupFiles.empty()) {
+                error = "The manifest file '" + manifestFile +
+                        "' does not list any setup files.";
+            }
+        } catch (const std::exception& e) {
+            error = e.what();
+        }
+    }
+    // Throw on the first process only after the others have been told to
+    // stop.
+    try {
+        setupFiles = broadcast_setup_files(setupFiles, error.empty(), rank);
+    } catch (const Exception&) {
+        if (rank == 0) throw Exception(error);
+        return EXIT_FAILURE;
+    }
+
+    const int numJobs = (int)setupFiles.size();
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<BatchJobResult> results;
+    if (rank == 0) {
+        log_info("Preparing to run {} jobs with {} MPI process(es).", numJobs,
+                mpi.getSize());
+        if (mpi.getSize() == 1) {
+            results = run_batch_jobs(setupFiles);
+        } else {
+            results = run_batch_mpi_coordinator(setupFiles, mpi.getSize());
+        }
+    } else {
+        run_batch_mpi_worker(setupFiles);
+    }
+
+    // All the processes exit with the status of the batch.
+    int status = EXIT_SUCCESS;
+    if (rank == 0) {
+        const double seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+        status = report_batch_results(args, results, seconds);
+    }
+    MPI_Bcast(&status, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    return status;
+}
+#endif
+
+} // anonymous namespace
+
+int run_batch(int argc, const char** argv) {
+
+    using namespace OpenSim;
+
+    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
+            HELP_RUN_BATCH, { argv + 1, argv + argc },
+            true); // show help if requested
+
+    if (args["--mpi"].asBool()) {
+#ifdef OPENSIM_WITH_MPI
+        return run_batch_mpi(args);
+#else
+        OPENSIM_THROW(Exception, "Cannot use --mpi: OpenSim was built "
+                "without MPI (OPENSIM_WITH_MPI).");
+#endif
+    }
+
+    const std::string manifestFile = args["<manifest-file>"].asString();
+    const auto setupFiles = read_batch_manifest(manifestFile);
+    OPENSIM_THROW_IF(setupFiles.empty(), Exception,
+            "The manifest file '{}' does not list any setup files.",
+            manifestFile);
+    const int numJobs = (int)setupFiles.size();
+    const int numWorkers = std::min(
+            std::max((int)args["--jobs"].asLong(), 1), numJobs);
+
+    log_info("Preparing to run {} jobs with {} worker process(es).", numJobs,
+            numWorkers);
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<BatchJobResult> results;
+    if (numWorkers == 1) {
+        results = run_batch_jobs(setupFiles);
+    } else {
+        // The worker processes load the same plugins and log at the same
+        // level as this process.
+        std::string options;
+        if (args["--library"]) {
+            for (const auto& plugin : args["--library"].asStringList()) {
+                options += " --library=\"" + plugin + "\"";
+            }
+        }
+        if (args["--log"]) options += " --log=" + args["--log"].asString();
+        results = run_batch_workers(argv[0], options, manifestFile,
+                setupFiles, numWorkers);
+    }
+    const double seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    return report_batch_results(args, results, seconds);
+}
+
+#endif // OPENSIM_CMD_RUN_BATCH_H_
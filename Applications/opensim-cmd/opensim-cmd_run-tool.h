@@ -24,6 +24,8 @@
  * -------------------------------------------------------------------------- */
 
 #include <iostream>
+#include <map>
+#include <memory>
 
 #include <docopt.h>
 #include "parse_arguments.h"
@@ -32,12 +34,14 @@ static const char HELP_RUN_TOOL[] =
 R"(Run a tool (e.g., Inverse Kinematics) from an XML setup file.
 
 Usage:
-  opensim-cmd [options]... run-tool <setup-xml-file>
+  opensim-cmd [options]... run-tool <setup-xml-file>...
   opensim-cmd run-tool -h | --help
 
 Options:
   -L <path>, --library <path>  Load a plugin.
   -o <level>, --log <level>  Logging level.
+  -j <n>, --threads <n>  Number of threads for multiple Scale setup files
+                         (0 for all) [default: 0].
 
 Description:
   The Tool to run is detected from the setup file you provide. Supported tools
@@ -54,6 +58,11 @@ Description:
 
   This command will also recognize tools from plugins.
 
+  Multiple setup files must all be Scale setup files (e.g., one for each
+  subject of a study), which are run in parallel with --threads threads. The
+  files of each subject are found relative to the directory of its setup file.
+  The command succeeds only if all subjects are scaled successfully.
+
   Use `opensim-cmd print-xml` to generate a template <setup-xml-file>.
 
 Examples:
@@ -61,18 +70,43 @@ Examples:
   opensim-cmd -L C:\Plugins\osimMyCustomForce.dll run-tool CMC_setup.xml
   opensim-cmd --library ../plugins/libosimMyPlugin.so run-tool Forward_setup.xml
   opensim-cmd --library=libosimMyCustomForce.dylib run-tool CMC_setup.xml
+  opensim-cmd run-tool --threads=4 subject01/Scale_setup.xml subject02/Scale_setup.xml
 )";
 
-int run_tool(int argc, const char** argv) {
+/// Copies of models loaded from files, so that the jobs of `opensim-cmd
+/// run-batch` that use the same model file parse it only once. The key is the
+/// absolute path of the model file.
+typedef std::map<std::string, std::unique_ptr<OpenSim::Model>> ModelCache;
+
+/// If `modelCache` is not null and `modelFile` is not empty, return a copy of
+/// the model in the cache (loading it first if necessary); otherwise, return
+/// null (the tool loads the model).
+static std::unique_ptr<OpenSim::Model> copy_cached_model(
+        ModelCache* modelCache, const std::string& modelFile) {
+    if (!modelCache || modelFile.empty() || modelFile == "Unassigned") {
+        return nullptr;
+    }
+    // The tools load the model relative to the current working directory.
+    const std::string path = SimTK::Pathname::getAbsolutePathname(modelFile);
+    auto it = modelCache->find(path);
+    if (it == modelCache->end()) {
+        it = modelCache->emplace(path, std::unique_ptr<OpenSim::Model>(
+                new OpenSim::Model(path))).first;
+    } else {
+        log_info("Using the cached model '{}'.", path);
+    }
+    return std::unique_ptr<OpenSim::Model>(it->second->clone());
+}
 
-    using namespace OpenSim;
+/// Detect the tool defined in `setupFile` and run it. Returns true if the tool
+/// succeeded. The models of InverseKinematicsTool and InverseDynamicsTool
+/// setup files are taken from `modelCache`, if provided.
+static bool run_setup_file(const std::string& setupFile,
+        ModelCache* modelCache = nullptr) {
 
-    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
-            HELP_RUN_TOOL, { argv + 1, argv + argc },
-            true); // show help if requested
+    using namespace OpenSim;
 
     // Deserialize.
-    const auto& setupFile = args["<setup-xml-file>"].asString();
     auto obj = std::unique_ptr<Object>(Object::makeObjectFromFile(setupFile));
     if (obj == nullptr) {
         throw Exception( "A problem occurred when trying to load file '" +
@@ -101,32 +135,70 @@ int run_tool(int argc, const char** argv) {
                      "constructed properly.");
             concreteTool.reset(tool->clone());
         }
-        const bool success = concreteTool->run();
-        if (success) return EXIT_SUCCESS;
-        else return EXIT_FAILURE;
+        return concreteTool->run();
     } else if (auto* tool = dynamic_cast<Tool*>(obj.get())) {
         // Tool.
         log_info("Preparing to run {}.", tool->getConcreteClassName());
-        const bool success = tool->run();
-        if (success) return EXIT_SUCCESS;
-        else return EXIT_FAILURE;
+        std::unique_ptr<Model> model;
+        if (auto* ik = dynamic_cast<InverseKinematicsTool*>(tool)) {
+            model = copy_cached_model(modelCache, ik->get_model_file());
+            if (model) ik->setModel(*model);
+        } else if (auto* id = dynamic_cast<InverseDynamicsTool*>(tool)) {
+            model = copy_cached_model(modelCache, id->getModelFileName());
+            if (model) id->setModel(*model);
+        }
+        return tool->run();
     } else if (auto* scale = dynamic_cast<ScaleTool*>(obj.get())) {
         // ScaleTool.
         log_info("Preparing to run {}.", scale->getConcreteClassName());
-        const bool success = scale->run();
-        if (success) return EXIT_SUCCESS;
-        else return EXIT_FAILURE;
+        return scale->run();
     } else if (auto* study = dynamic_cast<MocoStudy*>(obj.get())) {
         log_info("Preparing to run {}.", study->getConcreteClassName());
-        const auto solution = study->solve();
-        if (solution.success()) return EXIT_SUCCESS;
-        else return EXIT_FAILURE;
+        return study->solve().success();
 
     } else {
         throw Exception("The provided file '" + setupFile + "' does not "
                 "define an OpenSim Tool. Did you intend to load a plugin?");
     }
-    return EXIT_FAILURE;
+    return false;
+}
+
+int run_tool(int argc, const char** argv) {
+
+    using namespace OpenSim;
+
+    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
+            HELP_RUN_TOOL, { argv + 1, argv + argc },
+            true); // show help if requested
+
+    const auto& setupFiles = args["<setup-xml-file>"].asStringList();
+    if (setupFiles.size() > 1) {
+        // Scale multiple subjects.
+        for (const auto& setupFile : setupFiles) {
+            auto obj = std::unique_ptr<Object>(
+                    Object::makeObjectFromFile(setupFile));
+            if (!dynamic_cast<ScaleTool*>(obj.get())) {
+                throw Exception("The provided file '" + setupFile + "' does "
+                        "not define a ScaleTool; only Scale setup files can "
+                        "be run together.");
+            }
+        }
+        log_info("Preparing to run ScaleTool for {} subjects.",
+                setupFiles.size());
+        const auto success = ScaleTool::runBatch(setupFiles,
+                static_cast<int>(args["--threads"].asLong()));
+        bool allSucceeded = true;
+        for (size_t i = 0; i < setupFiles.size(); ++i) {
+            if (!success[i]) {
+                log_error("Scaling failed for '{}'.", setupFiles[i]);
+                allSucceeded = false;
+            }
+        }
+        if (allSucceeded) return EXIT_SUCCESS;
+        else return EXIT_FAILURE;
+    }
+
+    return run_setup_file(setupFiles[0]) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
 #endif // OPENSIM_CMD_RUN_TOOL_H_
@@ -0,0 +1,229 @@
+#ifndef OPENSIM_CMD_SERVE_H_
+#define OPENSIM_CMD_SERVE_H_
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  opensim-cmd_serve.h                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <docopt.h>
+#include "opensim-cmd_run-tool.h"
+#include "parse_arguments.h"
+
+static const char HELP_SERVE[] =
+R"(Run the tools of XML setup files read from standard input, one per line.
+
+Usage:
+  opensim-cmd [options]... serve [--results=<file>]
+  opensim-cmd serve -h | --help
+
+Options:
+  -L <path>, --library <path>  Load a plugin.
+  -o <level>, --log <level>  Logging level.
+  -r <file>, --results <file>  Write the results to a file instead of stdout.
+
+Description:
+  Each line of standard input is the path of a setup file (of any tool
+  supported by `opensim-cmd run-tool`), relative to the directory in which
+  the command was started. Empty lines and lines starting with '#' are
+  ignored. The command runs until the end of the input (e.g., when the
+  program writing to its input closes the pipe) or a line that is `quit`.
+
+  The setup files are run, in the order they are received, as `opensim-cmd
+  run-tool` would run them from the directory of the setup file, so that a
+  client that submits many short jobs pays for starting the process,
+  loading the plugins, and registering the types once. The model files of
+  Inverse Kinematics and Inverse Dynamics setup files are parsed once and
+  copied for each job that uses them; the copies are not updated if a model
+  file changes while the command runs. A job that fails does not stop the
+  command. The jobs run one at a time (the tools change the working
+  directory of the process); to run jobs in parallel, start several
+  processes.
+
+  For each job, one line with a JSON object is written to the results (and
+  flushed), with the keys job (the number of the job, starting at 1),
+  setup_file (its absolute path), status (success or failure),
+  queue_seconds (the time from reading the line to starting the job),
+  run_seconds, and message (the error, if any). Since log messages are also
+  written to stdout, use --results or --log=off to read the results from
+  stdout. The command succeeds only if all the jobs succeed.
+
+Examples:
+  opensim-cmd --log=off serve < jobs.txt
+  opensim-cmd serve --results=results.jsonl
+)";
+
+namespace {
+
+/// A setup file read from the input, and when it was read.
+struct ServeJob {
+    int number = 0;
+    std::string setupFile;
+    std::chrono::steady_clock::time_point received;
+};
+
+/// The jobs read from the input and not yet run. The input is read on its own
+/// thread, so that the time jobs spend waiting can be measured.
+class ServeQueue {
+public:
+    void push(ServeJob job) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_jobs.push_back(std::move(job));
+        }
+        m_condition.notify_one();
+    }
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+        }
+        m_condition.notify_one();
+    }
+    /// Wait for the next job; return false if there are no more jobs.
+    bool pop(ServeJob& job) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this] { return m_closed || !m_jobs.empty(); });
+        if (m_jobs.empty()) return false;
+        job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        return true;
+    }
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<ServeJob> m_jobs;
+    bool m_closed = false;
+};
+
+/// `str` as a JSON string, with quotes.
+std::string to_json_string(const std::string& str) {
+    std::string json = "\"";
+    for (const char c : str) {
+        switch (c) {
+        case '"': json += "\\\""; break;
+        case '\\': json += "\\\\"; break;
+        case '\n': json += "\\n"; break;
+        case '\r': json += "\\r"; break;
+        case '\t': json += "\\t"; break;
+        default:
+            if ((unsigned char)c < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                json += escaped;
+            } else {
+                json += c;
+            }
+        }
+    }
+    return json + "\"";
+}
+
+} // anonymous namespace
+
+int serve(int argc, const char** argv) {
+
+    using namespace OpenSim;
+
+    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
+            HELP_SERVE, { argv + 1, argv + argc },
+            true); // show help if requested
+
+    std::ofstream resultsFile;
+    if (args["--results"]) {
+        resultsFile.open(args["--results"].asString());
+        OPENSIM_THROW_IF(!resultsFile, Exception,
+                "Could not open the results file '{}'.",
+                args["--results"].asString());
+    }
+    std::ostream& results = args["--results"] ? resultsFile : std::cout;
+
+    // The setup files are relative to the directory in which the command
+    // was started, even though the tools change the working directory.
+    const std::string cwd = IO::getCwd();
+    ServeQueue queue;
+    std::thread reader([&]() {
+        int number = 0;
+        std::string line;
+        while (std::getline(std::cin, line)) {
+            IO::TrimWhitespace(line);
+            if (line.empty() || line[0] == '#') continue;
+            if (line == "quit") break;
+            ServeJob job;
+            job.number = ++number;
+            job.setupFile = SimTK::Pathname::
+                    getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                            cwd, line);
+            job.received = std::chrono::steady_clock::now();
+            queue.push(std::move(job));
+        }
+        queue.close();
+    });
+
+    log_info("Waiting for setup files on standard input.");
+    ModelCache modelCache;
+    int numJobs = 0;
+    int numSucceeded = 0;
+    ServeJob job;
+    while (queue.pop(job)) {
+        log_info("Running job {}: '{}'...", job.number, job.setupFile);
+        const auto start = std::chrono::steady_clock::now();
+        bool success = false;
+        std::string message;
+        try {
+            auto cwdChanger = IO::CwdChanger::changeToParentOf(job.setupFile);
+            success = run_setup_file(job.setupFile, &modelCache);
+            if (!success) message = "The tool failed.";
+        } catch (const std::exception& e) {
+            message = e.what();
+        }
+        const auto end = std::chrono::steady_clock::now();
+        if (!success) {
+            log_error("'{}' failed: {}", job.setupFile, message);
+        }
+        ++numJobs;
+        if (success) ++numSucceeded;
+
+        results << "{\"job\": " << job.number
+                << ", \"setup_file\": " << to_json_string(job.setupFile)
+                << ", \"status\": \"" << (success ? "success" : "failure")
+                << "\", \"queue_seconds\": "
+                << std::chrono::duration<double>(start - job.received).count()
+                << ", \"run_seconds\": "
+                << std::chrono::duration<double>(end - start).count()
+                << ", \"message\": " << to_json_string(message) << "}"
+                << std::endl;
+    }
+    reader.join();
+
+    log_info("{} of {} jobs succeeded.", numSucceeded, numJobs);
+    return numSucceeded == numJobs ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif // OPENSIM_CMD_SERVE_H_
@@ -23,6 +23,7 @@
 
 #include <SimTKcommon/Testing.h>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <regex>
@@ -349,6 +350,73 @@ void testRunTool() {
     testLoadPluginLibraries("run-tool");
 }
 
+void testRunBatch() {
+    // Help.
+    // =====
+    {
+        StartsWith output("Run the tools of many XML setup files ");
+        testCommand("run-batch -h", EXIT_SUCCESS, output);
+        testCommand("run-batch -help", EXIT_SUCCESS, output);
+    }
+
+    // Error messages.
+    // ===============
+    testCommand("run-batch", EXIT_FAILURE,
+            ContainsSubstring("Arguments did not match expected patterns"));
+    testCommand("run-batch putes.txt", EXIT_FAILURE,
+            ContainsSubstring("Could not open the manifest file 'putes.txt'."));
+
+    // A failing job does not stop the others. These setup files are created
+    // by testRunTool(), and neither can run successfully.
+    {
+        std::ofstream manifest("testrunbatch_manifest.txt");
+        manifest << "# Setup files created by testRunTool().\n"
+                 << "testruntool_cmc_setup.xml\n"
+                 << "\n"
+                 << "testruntool_Model.xml\n";
+    }
+    testCommand("run-batch testrunbatch_manifest.txt", EXIT_FAILURE,
+            std::regex(RE_ANY + "(No model file was specified)" + RE_ANY +
+                       "(does not define an OpenSim Tool)" + RE_ANY +
+                       "(0 of 2 jobs succeeded)" + RE_ANY));
+    testCommand("run-batch --jobs=2 testrunbatch_manifest.txt", EXIT_FAILURE,
+            std::regex(RE_ANY + "(with 2 worker process)" + RE_ANY +
+                       "(0 of 2 jobs succeeded)" + RE_ANY));
+    // Without MPI, --mpi is an error; with MPI, a single process runs all
+    // the jobs.
+    testCommand("run-batch --mpi testrunbatch_manifest.txt", EXIT_FAILURE,
+            std::regex(RE_ANY + "((0 of 2 jobs succeeded)|"
+                       "(OpenSim was built without MPI))" + RE_ANY));
+}
+
+void testServe() {
+    // Help.
+    // =====
+    {
+        StartsWith output("Run the tools of XML setup files read from ");
+        testCommand("serve -h", EXIT_SUCCESS, output);
+        testCommand("serve -help", EXIT_SUCCESS, output);
+    }
+
+    // A failing job does not stop the others, and the jobs after `quit` are
+    // not run. These setup files are created by testRunTool(), and neither
+    // can run successfully.
+    {
+        std::ofstream jobs("testserve_jobs.txt");
+        jobs << "testruntool_cmc_setup.xml\n"
+             << "# A comment.\n"
+             << "testruntool_Model.xml\n"
+             << "quit\n"
+             << "testruntool_Model.xml\n";
+    }
+    testCommand("serve < testserve_jobs.txt", EXIT_FAILURE,
+            std::regex(RE_ANY + "(\\{\"job\": 1, )" + RE_ANY +
+                       "(\"status\": \"failure\")" + RE_ANY +
+                       "(\\{\"job\": 2, )" + RE_ANY +
+                       "(does not define an OpenSim Tool)" + RE_ANY +
+                       "(0 of 2 jobs succeeded)" + RE_ANY));
+}
+
 void testPrintXML() {
     // Help.
     // =====
@@ -494,6 +562,8 @@ int main() {
     SimTK_START_TEST("testCommandLineInterface");
         SimTK_SUBTEST(testNoCommand);
         SimTK_SUBTEST(testRunTool);
+        SimTK_SUBTEST(testRunBatch);
+        SimTK_SUBTEST(testServe);
         SimTK_SUBTEST(testPrintXML);
         SimTK_SUBTEST(testInfo);
         SimTK_SUBTEST(testUpdateFile);
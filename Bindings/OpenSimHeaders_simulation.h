@@ -30,6 +30,7 @@
 #include <OpenSim/Simulation/Model/ElasticFoundationForce.h>
 #include <OpenSim/Simulation/Model/HuntCrossleyForce.h>
 #include <OpenSim/Simulation/Model/SmoothSphereHalfSpaceForce.h>
+#include <OpenSim/Simulation/Model/SmoothSphereHalfSpaceForceGroup.h>
 
 #include <OpenSim/Simulation/Model/ContactGeometrySet.h>
 #include <OpenSim/Simulation/Model/Probe.h>
@@ -52,6 +53,8 @@
 #include <OpenSim/Simulation/Control/ControlLinear.h>
 #include <OpenSim/Simulation/Control/Controller.h>
 #include <OpenSim/Simulation/Control/PrescribedController.h>
+#include <OpenSim/Simulation/Control/ExternalController.h>
+#include <OpenSim/Simulation/Control/TaskSpaceController.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include <OpenSim/Simulation/Model/AnalysisSet.h>
@@ -150,6 +153,7 @@
 #include <OpenSim/Simulation/StatesTrajectoryReporter.h>
 
 #include <OpenSim/Simulation/SimulationUtilities.h>
+#include <OpenSim/Simulation/VectorizedEnvironment.h>
 #include <OpenSim/Simulation/VisualizerUtilities.h>
 
 #include <OpenSim/Simulation/TableProcessor.h>
@@ -24,6 +24,12 @@ using namespace SimTK;
 // Tell SWIG about the simbody module.
 %import "python_simbody.i"
 
+// Add support for converting between NumPy and C arrays (for DataTable).
+%include "numpy.i"
+%init %{
+    import_array();
+%}
+
 // Relay exceptions to the target language.
 // This causes substantial code bloat and possibly hurts performance.
 // Without these try-catch block, a SimTK or OpenSim exception causes the
@@ -289,6 +295,194 @@ note: ## is a "glue" operator: `a ## b` --> `ab`.
     }
 }
 
+// NumPy arrays that alias the data of a table (see DataTable.getMatrixMat()).
+%{
+namespace {
+// Create a NumPy array of doubles that uses `data` (without copying it) and
+// that keeps `owner` (the Python object of the table) alive.
+PyObject* createNumPyView(PyObject* owner, double* data, int nd,
+        npy_intp* dims, npy_intp* strides, bool writeable) {
+    npy_intp size = 1;
+    for (int i = 0; i < nd; ++i) size *= dims[i];
+    if (size == 0) return PyArray_ZEROS(nd, dims, NPY_DOUBLE, 0);
+    PyObject* array = PyArray_New(&PyArray_Type, nd, dims, NPY_DOUBLE,
+            strides, data, 0, writeable ? NPY_ARRAY_WRITEABLE : 0, nullptr);
+    if (!array) return nullptr;
+    Py_INCREF(owner);
+    if (PyArray_SetBaseObject((PyArrayObject*)array, owner) < 0) {
+        Py_DECREF(array);
+        return nullptr;
+    }
+    return array;
+}
+}
+%}
+%apply (int DIM1, double* IN_ARRAY1) {
+    (int nind, double* inddata)
+};
+%apply (int DIM1, int DIM2, double* IN_ARRAY2) {
+    (int nrow, int ncol, double* depdata)
+};
+%extend OpenSim::DataTable_<double, double> {
+    PyObject* _getMatrixMat(PyObject* owner) {
+        auto& matrix = $self->updMatrix();
+        if (matrix.nrow() == 0 || matrix.ncol() == 0) {
+            npy_intp dims[2] = {matrix.nrow(), matrix.ncol()};
+            return createNumPyView(owner, nullptr, 2, dims, nullptr, true);
+        }
+        // The strides are computed from the addresses of the elements, since
+        // SimTK matrices are stored by column.
+        double* data = &matrix.updElt(0, 0);
+        npy_intp dims[2] = {matrix.nrow(), matrix.ncol()};
+        npy_intp strides[2] = {sizeof(double), sizeof(double)};
+        if (matrix.nrow() > 1) {
+            strides[0] = (char*)&matrix.updElt(1, 0) - (char*)data;
+        }
+        if (matrix.ncol() > 1) {
+            strides[1] = (char*)&matrix.updElt(0, 1) - (char*)data;
+        }
+        return createNumPyView(owner, data, 2, dims, strides, true);
+    }
+    PyObject* _getDependentColumnMat(PyObject* owner,
+            const std::string& columnLabel) {
+        const int col = (int)$self->getColumnIndex(columnLabel);
+        auto& matrix = $self->updMatrix();
+        npy_intp dims[1] = {matrix.nrow()};
+        if (matrix.nrow() == 0) {
+            return createNumPyView(owner, nullptr, 1, dims, nullptr, true);
+        }
+        double* data = &matrix.updElt(0, col);
+        npy_intp strides[1] = {sizeof(double)};
+        if (matrix.nrow() > 1) {
+            strides[0] = (char*)&matrix.updElt(1, col) - (char*)data;
+        }
+        return createNumPyView(owner, data, 1, dims, strides, true);
+    }
+    PyObject* _getIndependentColumnMat(PyObject* owner) {
+        const auto& column = $self->getIndependentColumn();
+        npy_intp dims[1] = {(npy_intp)column.size()};
+        npy_intp strides[1] = {sizeof(double)};
+        return createNumPyView(owner, const_cast<double*>(column.data()), 1,
+                dims, strides, false);
+    }
+    void _appendRowsMat(int nind, double* inddata,
+            int nrow, int ncol, double* depdata) {
+        // SimTK::Matrix copies the data given by row, as NumPy stores it.
+        $self->appendRows(std::vector<double>(inddata, inddata + nind),
+                SimTK::Matrix(nrow, ncol, depdata));
+    }
+%pythoncode %{
+    def getMatrixMat(self):
+        """Get the dependent data as a 2D NumPy array (time by column) that
+        uses the memory of this table, without copying it: changing the
+        array changes the table. The array keeps this table alive, but it is
+        invalid after rows or columns are added to or removed from this
+        table (e.g., appendRow())."""
+        return self._getMatrixMat(self)
+    def getDependentColumnMat(self, columnLabel):
+        """Get a column of the dependent data as a 1D NumPy array that uses
+        the memory of this table (see getMatrixMat())."""
+        return self._getDependentColumnMat(self, columnLabel)
+    def getIndependentColumnMat(self):
+        """Get the independent column (e.g., the times) as a read-only 1D
+        NumPy array that uses the memory of this table (see
+        getMatrixMat())."""
+        return self._getIndependentColumnMat(self)
+    def appendRowsMat(self, independentColumn, dependentData):
+        """Append the rows of the 2D NumPy array dependentData (one row per
+        element of the 1D array independentColumn) without converting each
+        element. This is equivalent to appendRow() for each row, but the
+        table is resized once."""
+        import numpy as np
+        self._appendRowsMat(np.asarray(independentColumn, dtype=float),
+                np.asarray(dependentData, dtype=float))
+%}
+}
+
+// Getting and setting the values of many state variables or outputs with one
+// call, with NumPy arrays (see Component.getStateVariableValuesMat()).
+%apply (int DIM1, double* IN_ARRAY1) {
+    (int nsv, double* svdata)
+};
+%apply (int DIM1, double* INPLACE_ARRAY1) {
+    (int nsv, double* svout)
+};
+%apply (int DIM1, double* INPLACE_ARRAY1) {
+    (int nout, double* outdata)
+};
+%extend OpenSim::Component {
+    void _getStateVariableValuesMat(const SimTK::State& state,
+            int nsv, double* svout) const {
+        OPENSIM_THROW_IF(nsv != $self->getNumStateVariables(), Exception,
+                "Expected an array of size {}, but got size {}.",
+                $self->getNumStateVariables(), nsv);
+        // This vector uses the memory of the NumPy array.
+        SimTK::Vector values(nsv, svout, true);
+        values = $self->getStateVariableValues(state);
+    }
+    void _setStateVariableValuesMat(SimTK::State& state,
+            int nsv, double* svdata) const {
+        $self->setStateVariableValues(state, SimTK::Vector(nsv, svdata, true));
+    }
+    void _getOutputValuesMat(const SimTK::State& state,
+            const std::vector<std::string>& outputPaths,
+            int nout, double* outdata) const {
+        OPENSIM_THROW_IF((int)outputPaths.size() != nout, Exception,
+                "Expected an array of size {}, but got size {}.",
+                outputPaths.size(), nout);
+        std::string componentPath, outputName, channelName, alias;
+        for (int i = 0; i < nout; ++i) {
+            const std::string& path = outputPaths[i];
+            OPENSIM_THROW_IF(path.find('|') == std::string::npos, Exception,
+                    "Expected an output path of the form "
+                    "'<component path>|<output name>', but got '{}'.", path);
+            AbstractInput::parseConnecteePath(path, componentPath, outputName,
+                    channelName, alias);
+            const Component& component = componentPath.empty()
+                    ? *$self : $self->getComponent(componentPath);
+            const auto* output = dynamic_cast<const Output<double>*>(
+                    &component.getOutput(outputName));
+            OPENSIM_THROW_IF(!output, Exception,
+                    "Output '{}' is not of type double.", path);
+            outdata[i] = output->getValue(state);
+        }
+    }
+%pythoncode %{
+    def getStateVariableValuesMat(self, state, out=None):
+        """Get the values of all the state variables of this component (in
+        the order of getStateVariableNames()) as a NumPy array, with one call.
+        To avoid allocating an array for each call (e.g., in each step of a
+        simulation), pass an array of doubles of size
+        getNumStateVariables() as `out`, which is filled and returned."""
+        import numpy as np
+        if out is None:
+            out = np.empty(self.getNumStateVariables())
+        self._getStateVariableValuesMat(state, out)
+        return out
+    def setStateVariableValuesMat(self, state, values):
+        """Set the values of all the state variables of this component (in
+        the order of getStateVariableNames()) from a NumPy array, with one
+        call. As with setStateVariableValues(), the model is not assembled
+        and the muscles are not equilibrated."""
+        import numpy as np
+        self._setStateVariableValuesMat(state,
+                np.asarray(values, dtype=float))
+    def getOutputValuesMat(self, state, outputPaths, out=None):
+        """Get the values of outputs of type double of this component or its
+        subcomponents as a NumPy array, with one call. Each output path has
+        the form '<component path>|<output name>', where the component path
+        is relative to this component (e.g., 'forceset/soleus|tension'; use
+        '|<output name>' for the outputs of this component). The state must
+        be realized to the stages the outputs depend on. As with
+        getStateVariableValuesMat(), an array can be passed as `out`."""
+        import numpy as np
+        if out is None:
+            out = np.empty(len(outputPaths))
+        self._getOutputValuesMat(state, outputPaths, out)
+        return out
+%}
+}
+
 // Include all the OpenSim code.
 // =============================
 %include <Bindings/preliminaries.i>
@@ -18,6 +18,13 @@ using namespace OpenSim;
 using namespace SimTK;
 %}
 
+// Add support for converting between NumPy and C arrays (for
+// VectorizedEnvironment).
+%include "numpy.i"
+%init %{
+    import_array();
+%}
+
 // Ignore method that is not callable from Python (uses double[] arg)
 %ignore OpenSim::Coordinate::setRange;
 
@@ -140,6 +147,40 @@ opensim_unique_ptr(OpenSim::PositionMotion);
 // Include all the OpenSim code.
 // =============================
 %include <Bindings/preliminaries.i>
+// Vectorized environments
+// =======================
+// The Python version of VectorizedEnvironment::step() takes a NumPy array of
+// shape (numEnvironments, numActions), which is used without copying if it is
+// C-contiguous with dtype float64. getObservations() returns a NumPy array of
+// shape (numEnvironments, numObservations) that shares the memory of the
+// observations (no copy): it is updated by each step() and reset(), and must
+// not be used after the VectorizedEnvironment is deleted.
+%ignore OpenSim::VectorizedEnvironment::step(const double*);
+%ignore OpenSim::VectorizedEnvironment::getObservations;
+%apply (int DIM1, int DIM2, double* IN_ARRAY2) {
+    (int nrowactions, int ncolactions, double* actions)
+};
+%extend OpenSim::VectorizedEnvironment {
+    void step(int nrowactions, int ncolactions, double* actions) {
+        OPENSIM_THROW_IF(nrowactions != $self->getNumEnvironments() ||
+                ncolactions != $self->getNumActions(), OpenSim::Exception,
+                "Expected actions of shape ({}, {}), but got ({}, {}).",
+                $self->getNumEnvironments(), $self->getNumActions(),
+                nrowactions, ncolactions);
+        $self->step(actions);
+    }
+    PyObject* _getObservations() {
+        npy_intp dims[2] = {$self->getNumEnvironments(),
+                            $self->getNumObservations()};
+        return PyArray_SimpleNewFromData(2, dims, NPY_DOUBLE,
+                const_cast<double*>($self->getObservations()));
+    }
+%pythoncode %{
+    def getObservations(self):
+        return self._getObservations()
+%}
+};
+
 %include <Bindings/simulation.i>
 
 
@@ -565,3 +565,32 @@ class TestDataTable(unittest.TestCase):
                                                  '2_x', '2_y', '2_z')
         print(tableDouble)
         
+
+    def test_TimeSeriesTable_numpy_views(self):
+        import numpy as np
+        table = osim.TimeSeriesTable()
+        table.setColumnLabels(('a', 'b', 'c'))
+        times = np.linspace(0, 1, 5)
+        data = np.arange(15, dtype=float).reshape(5, 3)
+        table.appendRowsMat(times, data)
+        assert table.getNumRows() == 5
+        assert table.getRowAtIndex(1)[2] == 5
+
+        # The arrays alias the table.
+        mat = table.getMatrixMat()
+        assert mat.shape == (5, 3)
+        assert np.array_equal(mat, data)
+        mat[2, 1] = -1
+        assert table.getRowAtIndex(2)[1] == -1
+        col = table.getDependentColumnMat('c')
+        assert np.array_equal(col, data[:, 2])
+        col[0] = 100
+        assert table.getDependentColumn('c')[0] == 100
+        time = table.getIndependentColumnMat()
+        assert np.array_equal(time, times)
+        assert not time.flags.writeable
+
+        # The arrays keep the table alive.
+        del table
+        assert mat[0, 2] == 100
+        assert col[2] == data[2, 2]
@@ -146,6 +146,35 @@ class TestInputsOutputs(unittest.TestCase):
         # TODO no components have inputs yet.
         # When they exist, test connecting inputs and outputs.
 
+    def test_array_state_and_output_values(self):
+        import numpy as np
+        model = osim.Model(os.path.join(test_dir, "arm26.osim"))
+        s = model.initSystem()
+
+        values = model.getStateVariableValuesMat(s)
+        assert len(values) == model.getNumStateVariables()
+        names = model.getStateVariableNames()
+        for i in range(len(values)):
+            assert values[i] == model.getStateVariableValue(s, names.get(i))
+
+        values[0] = 0.3
+        model.setStateVariableValuesMat(s, values)
+        assert model.getStateVariableValue(s, names.get(0)) == 0.3
+        out = np.zeros(model.getNumStateVariables())
+        assert model.getStateVariableValuesMat(s, out) is out
+        assert out[0] == 0.3
+
+        model.realizeDynamics(s)
+        paths = ['/forceset/BIClong|activation',
+                 '/jointset/r_shoulder/r_shoulder_elev|value']
+        outputs = model.getOutputValuesMat(s, paths)
+        assert outputs[0] == 0.05
+        assert outputs[1] == model.getCoordinateSet().get(
+                'r_shoulder_elev').getValue(s)
+        # Outputs that are not doubles are rejected.
+        with self.assertRaises(RuntimeError):
+            model.getOutputValuesMat(s, ['|com_position'])
+
     def test_iterate_outputs(self):
         model = osim.Model(os.path.join(test_dir, "arm26.osim"))
         s = model.initSystem()
@@ -383,8 +383,10 @@ DATATABLE_CLONE(double, SimTK::Rotation_<double>)
 %shared_ptr(OpenSim::STOFileAdapter_<SimTK::Vec6>)
 %shared_ptr(OpenSim::STOFileAdapter_<SimTK::SpatialVec>)
 %shared_ptr(OpenSim::CSVFileAdapter)
+%shared_ptr(OpenSim::OSBFileAdapter)
 %shared_ptr(OpenSim::TRCFileAdapter)
 %shared_ptr(OpenSim::C3DFileAdapter)
+%shared_ptr(OpenSim::HDF5FileAdapter)
 %template(StdMapStringDataAdapter)
         std::map<std::string, std::shared_ptr<OpenSim::DataAdapter> >;
 %template(StdMapStringAbstractDataTable)
@@ -422,6 +424,8 @@ namespace OpenSim {
 %template(STOFileAdapterSpatialVec) OpenSim::STOFileAdapter_<SimTK::SpatialVec>;
 
 %include <OpenSim/Common/CSVFileAdapter.h>
+%ignore OpenSim::OSBFileAdapter::OSBFileAdapter(OSBFileAdapter &&);
+%include <OpenSim/Common/OSBFileAdapter.h>
 %include <OpenSim/Common/XsensDataReader.h>
 
 #if defined (WITH_EZC3D)
@@ -449,6 +453,11 @@ namespace OpenSim {
 };
 #endif
 
+#if defined (WITH_HDF5)
+%ignore OpenSim::HDF5FileAdapter::HDF5FileAdapter(HDF5FileAdapter &&);
+%include <OpenSim/Common/HDF5FileAdapter.h>
+#endif
+
 namespace OpenSim {
     %ignore TableSource_::TableSource_(TableSource_ &&);
 }
@@ -52,6 +52,8 @@ namespace OpenSim {
 %include <OpenSim/Moco/MocoFrameDistanceConstraint.h>
 %include <OpenSim/Moco/MocoOutputConstraint.h>
 
+// Solvers use this to create the instances for each thread.
+%ignore OpenSim::MocoProblemRep::createRepHeap;
 %include <OpenSim/Moco/MocoProblemRep.h>
 
 // MocoProblemRep() is not copyable, but by default, SWIG tries to make a copy
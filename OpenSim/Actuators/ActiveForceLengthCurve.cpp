@@ -170,6 +170,14 @@ double ActiveForceLengthCurve::calcDerivative(double normFiberLength,
     return m_curve.calcDerivative(normFiberLength,order);
 }
 
+SimTK::Vec3 ActiveForceLengthCurve::
+    calcValueAndDerivatives(double normFiberLength, int maxOrder) const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "ActiveForceLengthCurve: Curve is not up-to-date with its properties");
+    return m_curve.calcValueAndDerivatives(normFiberLength, maxOrder);
+}
+
 double ActiveForceLengthCurve::
     calcDerivative(const std::vector<int>& derivComponents,
                    const SimTK::Vector& x) const
@@ -221,6 +221,14 @@ public:
         normalized fiber length.
     */
     double calcDerivative(double normFiberLength, int order) const;
+
+    /** Calculates the active-force-length multiplier and its first and second
+    derivatives with respect to the normalized fiber length, as [value, first
+    derivative, second derivative]; derivatives of order higher than `maxOrder`
+    (0, 1, or 2) are NaN. The curve is searched only once, so this is cheaper
+    than calling calcValue() and calcDerivative() at the same point. */
+    SimTK::Vec3 calcValueAndDerivatives(double normFiberLength,
+                                        int maxOrder = 2) const;
     
     /// If possible, use the simpler overload above.
     double calcDerivative(const std::vector<int>& derivComponents,
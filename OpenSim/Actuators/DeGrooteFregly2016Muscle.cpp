@@ -36,7 +36,8 @@ const std::string DeGrooteFregly2016Muscle::STATE_NORMALIZED_TENDON_FORCE_NAME(
         "normalized_tendon_force");
 const std::string
         DeGrooteFregly2016Muscle::DERIVATIVE_NORMALIZED_TENDON_FORCE_NAME(
-                "implicitderiv_normalized_tendon_force");
+                Component::getImplicitDerivativeName(
+                        "normalized_tendon_force"));
 const std::string
         DeGrooteFregly2016Muscle::RESIDUAL_NORMALIZED_TENDON_FORCE_NAME(
                 "implicitresidual_normalized_tendon_force");
@@ -31,6 +31,8 @@
 
 namespace OpenSim {
 
+class DeGrooteFregly2016MuscleGroup;
+
 // TODO avoid checking ignore_tendon_compliance() in each function;
 //       might be slow.
 // TODO prohibit fiber length from going below 0.2.
@@ -268,6 +270,23 @@ public:
     double getImplicitResidualNormalizedTendonForce(
             const SimTK::State& s) const;
 
+    /// In implicit dynamics mode (see
+    /// getImplicitEnabledNormalizedTendonForce()), this is
+    /// 'normalized_tendon_force', whose residual is the muscle-tendon
+    /// equilibrium residual (see getImplicitResidualNormalizedTendonForce()).
+    std::vector<std::string> getImplicitStateVariableNames() const override {
+        if (!get_ignore_tendon_compliance() && !m_isTendonDynamicsExplicit) {
+            return {STATE_NORMALIZED_TENDON_FORCE_NAME};
+        }
+        return {};
+    }
+    void computeImplicitResiduals(const SimTK::State& s,
+            SimTK::Vector& residuals) const override {
+        if (getImplicitEnabledNormalizedTendonForce(s)) {
+            residuals[0] = getImplicitResidualNormalizedTendonForce(s);
+        }
+    }
+
     /// If ignore_tendon_compliance is true, this gets normalized fiber force
     /// along the tendon instead.
     double getNormalizedTendonForce(const SimTK::State& s) const {
@@ -807,6 +826,8 @@ public:
     /// @}
 
 private:
+    friend class DeGrooteFregly2016MuscleGroup;
+
     void constructProperties();
 
     void calcMuscleLengthInfoHelper(const SimTK::Real& muscleTendonLength,
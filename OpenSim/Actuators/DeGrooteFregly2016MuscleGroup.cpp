@@ -0,0 +1,462 @@
+/* -------------------------------------------------------------------------- *
+ *              OpenSim:  DeGrooteFregly2016MuscleGroup.cpp                   *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "DeGrooteFregly2016MuscleGroup.h"
+
+#include <OpenSim/Common/Logger.h>
+
+#include <algorithm>
+
+using namespace OpenSim;
+
+namespace {
+    // Rows of DeGrooteFregly2016MuscleGroup::m_parameters. Flags are stored as
+    // 0 or 1.
+    enum Parameter {
+        OptimalFiberLength,
+        TendonSlackLength,
+        MaxIsometricForce,
+        FiberWidth,
+        SquareFiberWidth,
+        MaxContractionVelocity,
+        TendonStiffnessParameter,
+        ActiveForceWidthScale,
+        PassiveFiberStrainAtOneNormForce,
+        PassiveForceOffset,
+        PassiveForceDenominator,
+        FiberDamping,
+        IgnoreTendonCompliance,
+        IsTendonDynamicsExplicit,
+        IgnorePassiveFiberForce,
+        NumParameters
+    };
+
+    // Rows of DeGrooteFregly2016MuscleGroup::m_values.
+    enum Value {
+        // Inputs.
+        MuscleTendonLength,
+        MuscleTendonVelocity,
+        Activation,
+        NormTendonForce,
+        NormTendonForceDerivative,
+        // MuscleLengthInfo.
+        NormTendonLength,
+        TendonLength,
+        FiberLengthAlongTendon,
+        FiberLength,
+        NormFiberLength,
+        CosPennationAngle,
+        SinPennationAngle,
+        PennationAngle,
+        PassiveForceLengthMultiplier,
+        ActiveForceLengthMultiplier,
+        // FiberVelocityInfo.
+        ForceVelocityMultiplier,
+        NormFiberVelocity,
+        FiberVelocity,
+        FiberVelocityAlongTendon,
+        TendonVelocity,
+        NormTendonVelocity,
+        PennationAngularVelocity,
+        // MuscleDynamicsInfo.
+        ActiveFiberForce,
+        ConPassiveFiberForce,
+        NonConPassiveFiberForce,
+        FiberForce,
+        FiberForceAlongTendon,
+        OutputNormTendonForce,
+        TendonForce,
+        FiberStiffness,
+        PartialPennationAnglePartialFiberLength,
+        PartialFiberForceAlongTendonPartialFiberLength,
+        FiberStiffnessAlongTendon,
+        TendonStiffness,
+        MuscleStiffness,
+        PartialTendonForcePartialFiberLength,
+        NumValues
+    };
+}
+
+DeGrooteFregly2016MuscleGroup::DeGrooteFregly2016MuscleGroup(
+        const Model& model) {
+    for (const auto& muscle :
+            model.getComponentList<DeGrooteFregly2016Muscle>()) {
+        if (muscle.getConcreteClassName() !=
+                DeGrooteFregly2016Muscle::getClassName()) {
+            continue;
+        }
+        m_muscles.push_back(&muscle);
+    }
+    updateParameters();
+}
+
+void DeGrooteFregly2016MuscleGroup::addMuscle(
+        const DeGrooteFregly2016Muscle& muscle) {
+    m_muscles.push_back(&muscle);
+    updateParameters();
+}
+
+void DeGrooteFregly2016MuscleGroup::clear() {
+    m_muscles.clear();
+    m_parameters.clear();
+    m_values.clear();
+}
+
+void DeGrooteFregly2016MuscleGroup::updateParameters() {
+    m_parameters.assign(NumParameters * m_muscles.size(), SimTK::NaN);
+    m_batchParameters.clear();
+    m_values.assign(NumValues * m_muscles.size(), SimTK::NaN);
+    for (int i = 0; i < getNumMuscles(); ++i) updateParameters(i);
+}
+
+void DeGrooteFregly2016MuscleGroup::updateParameters(int index) {
+    using DGF = DeGrooteFregly2016Muscle;
+    const DGF& muscle = *m_muscles[index];
+    const int n = getNumMuscles();
+    const auto set = [&](Parameter row, double value) {
+        m_parameters[row * n + index] = value;
+    };
+    const double e0 = muscle.get_passive_fiber_strain_at_one_norm_force();
+    const double offset =
+            exp(DGF::kPE * (DGF::m_minNormFiberLength - 1.0) / e0);
+    set(OptimalFiberLength, muscle.get_optimal_fiber_length());
+    set(TendonSlackLength, muscle.get_tendon_slack_length());
+    set(MaxIsometricForce, muscle.get_max_isometric_force());
+    set(FiberWidth, muscle.m_fiberWidth);
+    set(SquareFiberWidth, muscle.m_squareFiberWidth);
+    set(MaxContractionVelocity,
+            muscle.m_maxContractionVelocityInMetersPerSecond);
+    set(TendonStiffnessParameter, muscle.m_kT);
+    set(ActiveForceWidthScale, muscle.get_active_force_width_scale());
+    set(PassiveFiberStrainAtOneNormForce, e0);
+    set(PassiveForceOffset, offset);
+    set(PassiveForceDenominator, exp(DGF::kPE) - offset);
+    set(FiberDamping, muscle.get_fiber_damping());
+    set(IgnoreTendonCompliance, muscle.get_ignore_tendon_compliance());
+    set(IsTendonDynamicsExplicit, muscle.m_isTendonDynamicsExplicit);
+    set(IgnorePassiveFiberForce, muscle.get_ignore_passive_fiber_force());
+}
+
+void DeGrooteFregly2016MuscleGroup::calcMuscleInfos(
+        const SimTK::State& state) const {
+    calcMuscleInfos(std::vector<const SimTK::State*>{&state});
+}
+
+void DeGrooteFregly2016MuscleGroup::calcMuscleInfos(
+        const std::vector<const SimTK::State*>& states) const {
+    using DGF = DeGrooteFregly2016Muscle;
+    using SimTK::square;
+    const int numMuscles = getNumMuscles();
+    if (!numMuscles || states.empty()) return;
+    for (const SimTK::State* s : states) {
+        OPENSIM_THROW_IF(s->getSystemStage() < SimTK::Stage::Velocity,
+                Exception,
+                "Expected the state to be realized to Stage::Velocity, but it "
+                "is realized to Stage::{}.",
+                s->getSystemStage().getName());
+    }
+
+    // Entry i of each row of parameters and values is for muscle
+    // i % numMuscles in state i / numMuscles. With multiple states, the
+    // parameters are repeated for each state, so that the loops below are
+    // the same for one state and for many.
+    const int numStates = (int)states.size();
+    const int n = numMuscles * numStates;
+    const double* parameters = m_parameters.data();
+    if (numStates > 1) {
+        if ((int)m_batchParameters.size() != NumParameters * n) {
+            m_batchParameters.resize(NumParameters * n);
+            for (int row = 0; row < NumParameters; ++row) {
+                for (int j = 0; j < numStates; ++j) {
+                    std::copy_n(&m_parameters[row * numMuscles], numMuscles,
+                            &m_batchParameters[row * n + j * numMuscles]);
+                }
+            }
+        }
+        parameters = m_batchParameters.data();
+    }
+    if ((int)m_values.size() != NumValues * n) {
+        m_values.resize(NumValues * n);
+    }
+
+    const auto p = [&](Parameter row) { return &parameters[row * n]; };
+    const auto v = [&](Value row) { return &m_values[row * n]; };
+
+    const double* lopt = p(OptimalFiberLength);
+    const double* lst = p(TendonSlackLength);
+    const double* fiso = p(MaxIsometricForce);
+    const double* w = p(FiberWidth);
+    const double* squareW = p(SquareFiberWidth);
+    const double* vmax = p(MaxContractionVelocity);
+    const double* kT = p(TendonStiffnessParameter);
+    const double* scale = p(ActiveForceWidthScale);
+    const double* e0 = p(PassiveFiberStrainAtOneNormForce);
+    const double* offset = p(PassiveForceOffset);
+    const double* denom = p(PassiveForceDenominator);
+    const double* damping = p(FiberDamping);
+    const double* rigid = p(IgnoreTendonCompliance);
+    const double* explicitMode = p(IsTendonDynamicsExplicit);
+    const double* noPassive = p(IgnorePassiveFiberForce);
+
+    double* lmt = v(MuscleTendonLength);
+    double* vmt = v(MuscleTendonVelocity);
+    double* a = v(Activation);
+    double* ntf = v(NormTendonForce);
+    double* ntfDot = v(NormTendonForceDerivative);
+
+    // Gather the inputs from the state. This is the only loop that calls
+    // the muscles.
+    for (int i = 0; i < n; ++i) {
+        const DGF& muscle = *m_muscles[i % numMuscles];
+        const SimTK::State& s = *states[i / numMuscles];
+        lmt[i] = muscle.getLength(s);
+        vmt[i] = muscle.getLengtheningSpeed(s);
+        a[i] = muscle.getActivation(s);
+        ntf[i] = SimTK::NaN;
+        ntfDot[i] = SimTK::NaN;
+        if (!rigid[i]) {
+            ntf[i] = muscle.getNormalizedTendonForce(s);
+            if (!explicitMode[i]) {
+                ntfDot[i] = muscle.getNormalizedTendonForceDerivative(s);
+            }
+        }
+    }
+
+    // MuscleLengthInfo (see calcMuscleLengthInfoHelper()).
+    // ---------------------------------------------------
+    double* ntl = v(NormTendonLength);
+    double* lt = v(TendonLength);
+    double* lmAT = v(FiberLengthAlongTendon);
+    double* lm = v(FiberLength);
+    double* nlm = v(NormFiberLength);
+    double* cosPenn = v(CosPennationAngle);
+    double* sinPenn = v(SinPennationAngle);
+    double* penn = v(PennationAngle);
+    double* fpe = v(PassiveForceLengthMultiplier);
+    double* fal = v(ActiveForceLengthMultiplier);
+    for (int i = 0; i < n; ++i) {
+        ntl[i] = rigid[i] ? 1.0
+                          : log((1.0 / DGF::c1) * (ntf[i] + DGF::c3)) /
+                                            kT[i] +
+                                    DGF::c2;
+        lt[i] = lst[i] * ntl[i];
+        lmAT[i] = lmt[i] - lt[i];
+        lm[i] = sqrt(square(lmAT[i]) + squareW[i]);
+        nlm[i] = lm[i] / lopt[i];
+        cosPenn[i] = lmAT[i] / lm[i];
+        sinPenn[i] = w[i] / lm[i];
+    }
+    for (int i = 0; i < n; ++i) penn[i] = asin(sinPenn[i]);
+    for (int i = 0; i < n; ++i) {
+        fpe[i] = noPassive[i] ? 0.0
+                              : (exp(DGF::kPE * (nlm[i] - 1.0) / e0[i]) -
+                                        offset[i]) /
+                                        denom[i];
+    }
+    for (int i = 0; i < n; ++i) {
+        const double x = (nlm[i] - 1.0) / scale[i] + 1.0;
+        fal[i] = DGF::calcGaussianLikeCurve(x, DGF::b11, DGF::b21,
+                         DGF::b31, DGF::b41) +
+                 DGF::calcGaussianLikeCurve(x, DGF::b12, DGF::b22,
+                         DGF::b32, DGF::b42) +
+                 DGF::calcGaussianLikeCurve(x, DGF::b13, DGF::b23,
+                         DGF::b33, DGF::b43);
+    }
+
+    // FiberVelocityInfo (see calcFiberVelocityInfoHelper()).
+    // -----------------------------------------------------
+    double* fv = v(ForceVelocityMultiplier);
+    double* nvm = v(NormFiberVelocity);
+    double* vm = v(FiberVelocity);
+    double* vmAT = v(FiberVelocityAlongTendon);
+    double* vt = v(TendonVelocity);
+    double* nvt = v(NormTendonVelocity);
+    double* pennDot = v(PennationAngularVelocity);
+    for (int i = 0; i < n; ++i) {
+        if (explicitMode[i] && !rigid[i]) {
+            fv[i] = (ntf[i] / cosPenn[i] - fpe[i]) / (a[i] * fal[i]);
+            nvm[i] = DGF::calcForceVelocityInverseCurve(fv[i]);
+            vm[i] = nvm[i] * vmax[i];
+            vmAT[i] = vm[i] / cosPenn[i];
+            vt[i] = vmt[i] - vmAT[i];
+            nvt[i] = vt[i] / lst[i];
+        } else {
+            nvt[i] = rigid[i] ? 0.0
+                              : ntfDot[i] /
+                                        (DGF::c1 * kT[i] *
+                                                exp(kT[i] * (ntl[i] -
+                                                                    DGF::c2)));
+            vt[i] = lst[i] * nvt[i];
+            vmAT[i] = vmt[i] - vt[i];
+            vm[i] = vmAT[i] * cosPenn[i];
+            nvm[i] = vm[i] / vmax[i];
+            fv[i] = DGF::calcForceVelocityMultiplier(nvm[i]);
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        pennDot[i] = -vm[i] / lm[i] * (w[i] / lmAT[i]);
+    }
+
+    // MuscleDynamicsInfo (see calcMuscleDynamicsInfoHelper()).
+    // -------------------------------------------------------
+    double* fAct = v(ActiveFiberForce);
+    double* fPassCon = v(ConPassiveFiberForce);
+    double* fPassNonCon = v(NonConPassiveFiberForce);
+    double* fm = v(FiberForce);
+    double* fmAT = v(FiberForceAlongTendon);
+    double* ntfOut = v(OutputNormTendonForce);
+    double* ft = v(TendonForce);
+    double* km = v(FiberStiffness);
+    double* dPenn = v(PartialPennationAnglePartialFiberLength);
+    double* dFmAT = v(PartialFiberForceAlongTendonPartialFiberLength);
+    double* kmAT = v(FiberStiffnessAlongTendon);
+    double* kt = v(TendonStiffness);
+    double* kmt = v(MuscleStiffness);
+    double* dFt = v(PartialTendonForcePartialFiberLength);
+    for (int i = 0; i < n; ++i) {
+        fAct[i] = fiso[i] * (a[i] * fal[i] * fv[i]);
+        fPassCon[i] = fiso[i] * fpe[i];
+        fPassNonCon[i] = fiso[i] * damping[i] * nvm[i];
+        fm[i] = fAct[i] + fPassCon[i] + fPassNonCon[i];
+        fmAT[i] = fm[i] * cosPenn[i];
+        if (rigid[i]) {
+            ntfOut[i] = fm[i] / fiso[i] * cosPenn[i];
+            ft[i] = fmAT[i];
+        } else {
+            ntfOut[i] = ntf[i];
+            ft[i] = fiso[i] * ntf[i];
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        const double x = (nlm[i] - 1.0) / scale[i] + 1.0;
+        const double dfal =
+                (1.0 / scale[i]) *
+                (DGF::calcGaussianLikeCurveDerivative(x, DGF::b11,
+                         DGF::b21, DGF::b31, DGF::b41) +
+                        DGF::calcGaussianLikeCurveDerivative(x, DGF::b12,
+                                DGF::b22, DGF::b32, DGF::b42) +
+                        DGF::calcGaussianLikeCurveDerivative(x, DGF::b13,
+                                DGF::b23, DGF::b33, DGF::b43));
+        const double dfpe =
+                noPassive[i] ? 0.0
+                             : (DGF::kPE *
+                                       exp((DGF::kPE * (nlm[i] - 1)) /
+                                               e0[i])) /
+                                       (e0[i] * denom[i]);
+        const double dnlm = 1.0 / lopt[i];
+        km[i] = fiso[i] * (a[i] * (dnlm * dfal) * fv[i] + dnlm * dfpe);
+    }
+    for (int i = 0; i < n; ++i) {
+        dPenn[i] = (-w[i] / square(lm[i])) / sqrt(1.0 - square(w[i] / lm[i]));
+        dFmAT[i] = km[i] * cosPenn[i] + fm[i] * (-sinPenn[i] * dPenn[i]);
+        kmAT[i] = dFmAT[i] *
+                  (1.0 / (cosPenn[i] - lm[i] * sinPenn[i] * dPenn[i]));
+        kt[i] = rigid[i] ? SimTK::Infinity
+                         : (fiso[i] / lst[i]) *
+                                   (DGF::c1 * kT[i] *
+                                           exp(kT[i] * (ntl[i] - DGF::c2)));
+        kmt[i] = rigid[i] ? kmAT[i] : (kmAT[i] * kt[i]) / (kmAT[i] + kt[i]);
+        dFt[i] = kt[i] * (lm[i] * sinPenn[i] * dPenn[i] - cosPenn[i]);
+    }
+
+    // Scatter the results to the cache variables of the muscles.
+    // ----------------------------------------------------------
+    for (int i = 0; i < n; ++i) {
+        const DGF& muscle = *m_muscles[i % numMuscles];
+        const SimTK::State& s = *states[i / numMuscles];
+
+        auto& mli = muscle.updMuscleLengthInfo(s);
+        mli.normTendonLength = ntl[i];
+        mli.tendonStrain = ntl[i] - 1.0;
+        mli.tendonLength = lt[i];
+        mli.fiberLengthAlongTendon = lmAT[i];
+        mli.fiberLength = lm[i];
+        mli.normFiberLength = nlm[i];
+        mli.cosPennationAngle = cosPenn[i];
+        mli.sinPennationAngle = sinPenn[i];
+        mli.pennationAngle = penn[i];
+        mli.fiberPassiveForceLengthMultiplier = fpe[i];
+        mli.fiberActiveForceLengthMultiplier = fal[i];
+        muscle.markMuscleLengthInfoValid(s);
+
+        auto& fvi = muscle.updFiberVelocityInfo(s);
+        fvi.fiberForceVelocityMultiplier = fv[i];
+        fvi.normFiberVelocity = nvm[i];
+        fvi.fiberVelocity = vm[i];
+        fvi.fiberVelocityAlongTendon = vmAT[i];
+        fvi.tendonVelocity = vt[i];
+        fvi.normTendonVelocity = nvt[i];
+        fvi.pennationAngularVelocity = pennDot[i];
+        muscle.markFiberVelocityInfoValid(s);
+
+        auto& mdi = muscle.updMuscleDynamicsInfo(s);
+        mdi.activation = a[i];
+        mdi.fiberForce = fm[i];
+        mdi.activeFiberForce = fAct[i];
+        mdi.passiveFiberForce = fPassCon[i] + fPassNonCon[i];
+        mdi.normFiberForce = fm[i] / fiso[i];
+        mdi.fiberForceAlongTendon = fmAT[i];
+        mdi.normTendonForce = ntfOut[i];
+        mdi.tendonForce = ft[i];
+        mdi.fiberStiffness = km[i];
+        mdi.fiberStiffnessAlongTendon = kmAT[i];
+        mdi.tendonStiffness = kt[i];
+        mdi.muscleStiffness = kmt[i];
+        mdi.fiberActivePower = -(fAct[i] + fPassNonCon[i]) * vm[i];
+        mdi.fiberPassivePower = -fPassCon[i] * vm[i];
+        mdi.tendonPower = -ft[i] * vt[i];
+        mdi.musclePower = -ft[i] * vmt[i];
+        mdi.userDefinedDynamicsExtras.resize(5);
+        mdi.userDefinedDynamicsExtras[DGF::m_mdi_passiveFiberElasticForce] =
+                fPassCon[i];
+        mdi.userDefinedDynamicsExtras[DGF::m_mdi_passiveFiberDampingForce] =
+                fPassNonCon[i];
+        mdi.userDefinedDynamicsExtras
+                [DGF::m_mdi_partialPennationAnglePartialFiberLength] =
+                dPenn[i];
+        mdi.userDefinedDynamicsExtras
+                [DGF::m_mdi_partialFiberForceAlongTendonPartialFiberLength] =
+                dFmAT[i];
+        mdi.userDefinedDynamicsExtras
+                [DGF::m_mdi_partialTendonForcePartialFiberLength] = dFt[i];
+        muscle.markMuscleDynamicsInfoValid(s);
+
+        // The implicit mode of the muscle computes the same values as
+        // calcEquilibriumResidual().
+        if (!rigid[i] && !explicitMode[i]) {
+            muscle.setCacheVariableValue(s,
+                    DGF::RESIDUAL_NORMALIZED_TENDON_FORCE_NAME,
+                    ntf[i] - fmAT[i] / fiso[i]);
+        }
+
+        if (lt[i] < lst[i]) {
+            log_info("DeGrooteFregly2016Muscle '{}' is buckling (length < "
+                     "tendon_slack_length) at time {} s.",
+                    muscle.getName(), s.getTime());
+        }
+        if (nvm[i] < -1.0) {
+            log_info("DeGrooteFregly2016Muscle '{}' is exceeding maximum "
+                     "contraction velocity at time {} s.",
+                    muscle.getName(), s.getTime());
+        }
+    }
+}
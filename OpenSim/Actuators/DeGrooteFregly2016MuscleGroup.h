@@ -0,0 +1,107 @@
+#ifndef OPENSIM_DEGROOTEFREGLY2016MUSCLEGROUP_H
+#define OPENSIM_DEGROOTEFREGLY2016MUSCLEGROUP_H
+/* -------------------------------------------------------------------------- *
+ *               OpenSim:  DeGrooteFregly2016MuscleGroup.h                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "DeGrooteFregly2016Muscle.h"
+
+#include <vector>
+
+namespace OpenSim {
+
+/** The DeGrooteFregly2016Muscle%s of a model, whose curves, fiber and tendon
+kinematics, and forces are computed for all the muscles at once rather than
+one muscle at a time. The parameters of the muscles are stored in
+structure-of-arrays form, and each quantity is computed for all the muscles in
+one loop over contiguous arrays, which the compiler can vectorize. For models
+with many muscles (e.g., in MocoInverse), this reduces the cost of computing
+the muscle forces, which is dominated by the exp() and log() of the curves.
+
+calcMuscleInfos() stores the results in the MuscleLengthInfo,
+FiberVelocityInfo, and MuscleDynamicsInfo cache variables of each muscle (and
+the implicit tendon compliance dynamics residual, if it is enabled), so that
+the muscles use them when computing their forces and outputs. The results are
+the same as those that the muscles compute themselves.
+@code
+DeGrooteFregly2016MuscleGroup group(model);
+model.realizeVelocity(state);
+group.calcMuscleInfos(state);
+model.realizeAcceleration(state); // The muscles use the cached values.
+@endcode
+
+The group refers to (and does not copy) the muscles, so it must be rebuilt
+when the model is copied or its system is re-created. If the properties of the
+muscles change (e.g., via a MocoParameter), call updateParameters(). The
+group uses a workspace for each call to calcMuscleInfos(), so one group must
+not be used by multiple threads at the same time (as with the model itself).
+*/
+class OSIMACTUATORS_API DeGrooteFregly2016MuscleGroup {
+public:
+    DeGrooteFregly2016MuscleGroup() = default;
+    /** Add all the DeGrooteFregly2016Muscle%s of `model`, whose system must
+    already exist. Muscles of classes derived from DeGrooteFregly2016Muscle
+    are not added, since they may compute these values differently. */
+    explicit DeGrooteFregly2016MuscleGroup(const Model& model);
+
+    /** Add `muscle`, whose system must already exist. */
+    void addMuscle(const DeGrooteFregly2016Muscle& muscle);
+    void clear();
+
+    int getNumMuscles() const { return (int)m_muscles.size(); }
+    const DeGrooteFregly2016Muscle& getMuscle(int index) const {
+        return *m_muscles.at(index);
+    }
+
+    /** Read the properties of the muscles again (e.g., after they were
+    changed without calling initSystem()). */
+    void updateParameters();
+
+    /** Compute the MuscleLengthInfo, FiberVelocityInfo, and
+    MuscleDynamicsInfo of all the muscles and mark them valid in `state`,
+    which must be realized to SimTK::Stage::Velocity. */
+    void calcMuscleInfos(const SimTK::State& state) const;
+    /** Compute the infos of all the muscles in each of `states` (e.g., the
+    states at all the grid points of a direct collocation problem), which
+    must be distinct and realized to SimTK::Stage::Velocity. The quantities
+    are computed for all the muscles in all the states in the same loops, so
+    that the work per call (and the length of the loops) grows with the
+    number of states. */
+    void calcMuscleInfos(const std::vector<const SimTK::State*>& states) const;
+
+private:
+    void updateParameters(int index);
+
+    std::vector<const DeGrooteFregly2016Muscle*> m_muscles;
+    // The parameters of muscle i are at index i of each row (see the .cpp
+    // file for the rows).
+    std::vector<double> m_parameters;
+    // m_parameters repeated for each state of the most recent call to
+    // calcMuscleInfos() with multiple states.
+    mutable std::vector<double> m_batchParameters;
+    // The inputs, intermediate values, and results of calcMuscleInfos(),
+    // which is therefore not thread-safe (unlike realizing a Model).
+    mutable std::vector<double> m_values;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_DEGROOTEFREGLY2016MUSCLEGROUP_H
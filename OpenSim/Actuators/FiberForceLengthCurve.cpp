@@ -231,6 +231,14 @@ double FiberForceLengthCurve::calcDerivative(double normFiberLength,
     return m_curve.calcDerivative(normFiberLength,order);
 }
 
+SimTK::Vec3 FiberForceLengthCurve::
+    calcValueAndDerivatives(double normFiberLength, int maxOrder) const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "FiberForceLengthCurve: Curve is not up-to-date with its properties");
+    return m_curve.calcValueAndDerivatives(normFiberLength, maxOrder);
+}
+
 double FiberForceLengthCurve::
     calcDerivative(const std::vector<int>& derivComponents,
                    const SimTK::Vector& x) const
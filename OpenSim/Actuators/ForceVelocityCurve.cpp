@@ -188,6 +188,14 @@ double ForceVelocityCurve::calcDerivative(double normFiberVelocity,
     return m_curve.calcDerivative(normFiberVelocity,order);
 }
 
+SimTK::Vec3 ForceVelocityCurve::
+    calcValueAndDerivatives(double normFiberVelocity, int maxOrder) const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "ForceVelocityCurve: Curve is not up-to-date with its properties");
+    return m_curve.calcValueAndDerivatives(normFiberVelocity, maxOrder);
+}
+
 double ForceVelocityCurve::
     calcDerivative(const std::vector<int>& derivComponents,
                    const SimTK::Vector& x) const
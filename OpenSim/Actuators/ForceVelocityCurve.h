@@ -316,6 +316,14 @@ public:
         normalized fiber velocity.
     */
     double calcDerivative(double normFiberVelocity, int order) const;
+
+    /** Calculates the force-velocity multiplier and its first and second
+    derivatives with respect to the normalized fiber velocity, as [value, first
+    derivative, second derivative]; derivatives of order higher than `maxOrder`
+    (0, 1, or 2) are NaN. The curve is searched only once, so this is cheaper
+    than calling calcValue() and calcDerivative() at the same point. */
+    SimTK::Vec3 calcValueAndDerivatives(double normFiberVelocity,
+                                        int maxOrder = 2) const;
     
 
     /// If possible, use the simpler overload above.
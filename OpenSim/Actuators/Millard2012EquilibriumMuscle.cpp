@@ -936,6 +936,13 @@ calcMuscleDynamicsInfo(const SimTK::State& s, MuscleDynamicsInfo& mdi) const
         double dFt_dtl      = 0.0;
         double Ke           = 0.0;
 
+        // The tendon force-length multiplier and its slope, with one search
+        // of the curve.
+        SimTK::Vec3 fseV(0);
+        if(!get_ignore_tendon_compliance()) {
+            fseV = fseCurve.calcValueAndDerivatives(mli.normTendonLength, 1);
+        }
+
         if(fiberStateClamped < 0.5) { //flag is set to 0.0 or 1.0
             SimTK::Vec4 fiberForceV;
 
@@ -976,8 +983,7 @@ calcMuscleDynamicsInfo(const SimTK::State& s, MuscleDynamicsInfo& mdi) const
 
             // Compute the stiffness of the tendon.
             if(!get_ignore_tendon_compliance()) {
-                dFt_dtl = fseCurve.calcDerivative(mli.normTendonLength,1)
-                          *(fiso/tendonSlackLen);
+                dFt_dtl = fseV[1]*(fiso/tendonSlackLen);
 
                 // Compute the stiffness of the whole musculotendon actuator.
                 if (abs(dFmAT_dlceAT*dFt_dtl) > 0.0
@@ -992,7 +998,7 @@ calcMuscleDynamicsInfo(const SimTK::State& s, MuscleDynamicsInfo& mdi) const
 
         double fse = 0.0;
         if(!get_ignore_tendon_compliance()) {
-            fse = fseCurve.calcValue(mli.normTendonLength);
+            fse = fseV[0];
         } else {
             fse = fmAT/fiso;
         }
@@ -1158,14 +1164,17 @@ calcDampedNormFiberVelocity(double fiso,
 
     double df_d_dlceNdt = 0.0;
 
+    const ForceVelocityCurve& fvCurve = get_ForceVelocityCurve();
     while(abs(err) > tol && iter < maxIter) {
-        fv = get_ForceVelocityCurve().calcValue(dlceN_dt);
+        // The multiplier and its slope, with one search of the curve.
+        const SimTK::Vec3 fvV = fvCurve.calcValueAndDerivatives(dlceN_dt, 1);
+        fv = fvV[0];
         fiberForceV = calcFiberForce(fiso,a,fal,fv,fpe,dlceN_dt);
         fiberForce = fiberForceV[0];
 
         err = fiberForce*cosPhi - fse*fiso;
-        df_d_dlceNdt = calc_DFiberForce_DNormFiberVelocity(fiso,a,fal,
-                                                           beta,dlceN_dt);
+        // As in calc_DFiberForce_DNormFiberVelocity().
+        df_d_dlceNdt = fiso * (a*fal*fvV[1] + beta);
         derr_d_dlceNdt = df_d_dlceNdt*cosPhi;
 
         if(abs(err) > tol && abs(derr_d_dlceNdt) > SimTK::SignificantReal) {
@@ -1254,9 +1263,20 @@ double Millard2012EquilibriumMuscle::calcFiberStiffness(double fiso,
 {
     const FiberForceLengthCurve& fpeCurve  = get_FiberForceLengthCurve();
     const ActiveForceLengthCurve& falCurve = get_ActiveForceLengthCurve();
+    return calcFiberStiffness(fiso, a, fv, falCurve.calcDerivative(lceN,1),
+                              fpeCurve.calcDerivative(lceN,1), optFibLen);
+}
+
+double Millard2012EquilibriumMuscle::calcFiberStiffness(double fiso,
+                                                        double a,
+                                                        double fv,
+                                                        double Dfal_DlceN,
+                                                        double Dfpe_DlceN,
+                                                        double optFibLen) const
+{
     double DlceN_Dlce = 1.0/optFibLen;
-    double Dfal_Dlce  = falCurve.calcDerivative(lceN,1) * DlceN_Dlce;
-    double Dfpe_Dlce  = fpeCurve.calcDerivative(lceN,1) * DlceN_Dlce;
+    double Dfal_Dlce  = Dfal_DlceN * DlceN_Dlce;
+    double Dfpe_Dlce  = Dfpe_DlceN * DlceN_Dlce;
 
     // DFm_Dlce
     return  fiso * (a*Dfal_Dlce*fv + Dfpe_Dlce);
@@ -1383,6 +1403,10 @@ Millard2012EquilibriumMuscle::MuscleStateEstimate
     double fal = 0.0;  // normalized active-force-length multiplier
     double fv  = 0.0;  // normalized force-velocity multiplier
     double fpe = 0.0;  // normalized parallel element force
+    // Slopes of the curves, computed together with the multipliers.
+    double dfse_d_tlN  = 0.0;
+    double dfal_d_lceN = 0.0;
+    double dfpe_d_lceN = 0.0;
 
     // Position level
     double tl  = getTendonSlackLength()*1.01;  // begin with small tendon force
@@ -1429,11 +1453,19 @@ Millard2012EquilibriumMuscle::MuscleStateEstimate
         tlN = tl / tsl;
     };
 
-    // Functional to update the force multipliers
+    // Functional to update the force multipliers and the slopes of the
+    // curves, which partialsFunc() uses at the same lengths. Each curve is
+    // searched once per update.
     auto multipliersFunc = [&] {
-        fal = falCurve.calcValue(lceN);
-        fpe = fpeCurve.calcValue(lceN);
-        fse = fseCurve.calcValue(tlN);
+        const SimTK::Vec3 falV = falCurve.calcValueAndDerivatives(lceN, 1);
+        const SimTK::Vec3 fpeV = fpeCurve.calcValueAndDerivatives(lceN, 1);
+        const SimTK::Vec3 fseV = fseCurve.calcValueAndDerivatives(tlN, 1);
+        fal = falV[0];
+        dfal_d_lceN = falV[1];
+        fpe = fpeV[0];
+        dfpe_d_lceN = fpeV[1];
+        fse = fseV[0];
+        dfse_d_tlN = fseV[1];
     };
 
     // Functional to compute the equilibrium force error
@@ -1447,12 +1479,13 @@ Millard2012EquilibriumMuscle::MuscleStateEstimate
 
     // Functional to compute the partial derivative of muscle force w.r.t. lce
     auto partialsFunc = [&] {
-        dFm_dlce = calcFiberStiffness(fiso, ma, fv, lceN, ofl);
+        dFm_dlce = calcFiberStiffness(fiso, ma, fv, dfal_d_lceN, dfpe_d_lceN,
+            ofl);
         dFmAT_dlce = calc_DFiberForceAT_DFiberLength(Fm, dFm_dlce, lce,
             sinphi, cosphi);
         dFmAT_dlceAT = calc_DFiberForceAT_DFiberLengthAT(dFmAT_dlce, sinphi,
             cosphi, lce);
-        dFt_d_tl = fseCurve.calcDerivative(tlN, 1)*fiso / tsl;
+        dFt_d_tl = dfse_d_tlN*fiso / tsl;
         dFt_d_lce = calc_DTendonForce_DFiberLength(dFt_d_tl, lce,
             sinphi, cosphi);
     };
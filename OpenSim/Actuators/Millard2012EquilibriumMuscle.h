@@ -655,6 +655,16 @@ private:
                               double lceN,
                               double optFibLen) const;
 
+    /*  As above, given the slopes of the active-force-length and fiber
+        force-length curves at the normalized fiber length (e.g., computed
+        together with their values by calcValueAndDerivatives()). */
+    double calcFiberStiffness(double fiso,
+                              double a,
+                              double fv,
+                              double Dfal_DlceN,
+                              double Dfpe_DlceN,
+                              double optFibLen) const;
+
     /*  @param fiso the maximum isometric force the fiber can generate
         @param a activation
         @param fal the fiber active-force-length multiplier
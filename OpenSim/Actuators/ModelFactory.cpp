@@ -19,10 +19,15 @@
 #include "ModelFactory.h"
 
 #include <OpenSim/Actuators/CoordinateActuator.h>
+#include <OpenSim/Actuators/Millard2012EquilibriumMuscle.h>
+#include <OpenSim/Simulation/Model/ContactHalfSpace.h>
+#include <OpenSim/Simulation/Model/ContactSphere.h>
+#include <OpenSim/Simulation/Model/SmoothSphereHalfSpaceForce.h>
 #include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
 #include <OpenSim/Simulation/SimbodyEngine/SliderJoint.h>
 #include <OpenSim/Simulation/SimbodyEngine/WeldJoint.h>
 #include <OpenSim/Simulation/Model/GeometryPath.h>
+#include <OpenSim/Simulation/Wrap/WrapCylinder.h>
 #include <OpenSim/Common/CommonUtilities.h>
 
 using namespace OpenSim;
@@ -88,6 +93,104 @@ Model ModelFactory::createNLinkPendulum(int numLinks) {
     return model;
 }
 
+Model ModelFactory::createScalableModel(int numBodies, int numMuscles,
+        int numPathPoints, bool wrap, int numContactSpheres) {
+    OPENSIM_THROW_IF(numBodies < 1, Exception,
+            "Expected numBodies to be at least 1, but got {}.", numBodies);
+    OPENSIM_THROW_IF(numMuscles < 0, Exception,
+            "Expected numMuscles to be nonnegative, but got {}.", numMuscles);
+    OPENSIM_THROW_IF(numPathPoints < 2, Exception,
+            "Expected numPathPoints to be at least 2, but got {}.",
+            numPathPoints);
+    OPENSIM_THROW_IF(numContactSpheres < 0, Exception,
+            "Expected numContactSpheres to be nonnegative, but got {}.",
+            numContactSpheres);
+
+    Model model;
+    model.setName("scalable_" + std::to_string(numBodies) + "bodies_" +
+                  std::to_string(numMuscles) + "muscles");
+
+    // As in createNLinkPendulum(), the origin of each body is at the distal
+    // end of the link, and the joint is at (-1, 0, 0) in the body. The axes
+    // of the odd joints are rotated from z to y, and the muscles of a joint
+    // are offset from the link along the normal that is perpendicular to the
+    // link and to the axis.
+    const Vec3 oddJointOrientation(0.5 * SimTK::Pi, 0, 0);
+    std::vector<const PhysicalFrame*> frames{&model.getGround()};
+    std::vector<WrapCylinder*> cylinders;
+    for (int i = 0; i < numBodies; ++i) {
+        const std::string istr = std::to_string(i);
+        auto* bi = new OpenSim::Body("b" + istr, 1, Vec3(-0.5, 0, 0),
+                Inertia(0.01, 0.09, 0.09));
+        model.addBody(bi);
+        const Vec3 orientation = i % 2 ? oddJointOrientation : Vec3(0);
+        auto* ji = new PinJoint("j" + istr, *frames.back(), Vec3(0),
+                orientation, *bi, Vec3(-1, 0, 0), orientation);
+        ji->updCoordinate().setName("q" + istr);
+        model.addJoint(ji);
+        frames.push_back(bi);
+
+        if (wrap) {
+            auto* cylinder = new WrapCylinder();
+            cylinder->setName("wrap" + istr);
+            cylinder->set_radius(0.04);
+            cylinder->set_length(0.5);
+            cylinder->set_translation(Vec3(-1, 0, 0));
+            cylinder->set_xyz_body_rotation(orientation);
+            bi->addWrapObject(cylinder);
+            cylinders.push_back(cylinder);
+        }
+    }
+
+    for (int i = 0; i < numMuscles; ++i) {
+        const int joint = i % numBodies;
+        const int round = i / numBodies;
+        const double side = round % 2 ? -1 : 1;
+        const double offset = side * (0.05 + 0.01 * ((round / 2) % 5));
+        const Vec3 normal = joint % 2 ? Vec3(0, 0, offset) : Vec3(0, offset, 0);
+
+        auto* muscle = new Millard2012EquilibriumMuscle(
+                "m" + std::to_string(i), 500, 0.6, 0.45, 0);
+        // The points go from the middle of the parent link to the joint (the
+        // origin of the parent), and from the joint (at -1 in the child) to
+        // the middle of the child link.
+        for (int k = 0; k < numPathPoints; ++k) {
+            const double fraction = double(k) / (numPathPoints - 1);
+            const std::string pointName = "point" + std::to_string(k);
+            if (fraction <= 0.5) {
+                muscle->addNewPathPoint(pointName, *frames[joint],
+                        Vec3(-0.5 + fraction, 0, 0) + normal);
+            } else {
+                muscle->addNewPathPoint(pointName, *frames[joint + 1],
+                        Vec3(-1.5 + fraction, 0, 0) + normal);
+            }
+        }
+        if (wrap) muscle->updGeometryPath().addPathWrap(*cylinders[joint]);
+        model.addForce(muscle);
+    }
+
+    if (numContactSpheres > 0) {
+        // The plane is parallel to the ground.
+        auto* floor = new ContactHalfSpace(Vec3(0, -1, 0),
+                Vec3(0, 0, -0.5 * SimTK::Pi), model.getGround(), "floor");
+        model.addContactGeometry(floor);
+        for (int k = 0; k < numContactSpheres; ++k) {
+            const std::string kstr = std::to_string(k);
+            const auto& body = *frames[1 + k % numBodies];
+            auto* sphere = new ContactSphere(0.05,
+                    Vec3(-0.25 * ((k / numBodies) % 4), 0, 0), body,
+                    "sphere" + kstr);
+            model.addContactGeometry(sphere);
+            auto* force = new SmoothSphereHalfSpaceForce(
+                    "contact" + kstr, *sphere, *floor);
+            model.addForce(force);
+        }
+    }
+
+    model.finalizeConnections();
+    return model;
+}
+
 Model ModelFactory::createPlanarPointMass() {
     Model model;
     model.setName("planar_point_mass");
@@ -252,6 +355,57 @@ void ModelFactory::removeMuscles(Model& model) {
     }
 }
 
+void ModelFactory::removeVisualization(Model& model) {
+    // Clearing the geometry of a frame deletes subcomponents, so the frames
+    // are collected before any are modified.
+    std::vector<Frame*> frames;
+    for (auto& frame : model.updComponentList<Frame>()) {
+        if (frame.getProperty_attached_geometry().size()) {
+            frames.push_back(&frame);
+        }
+    }
+    for (auto* frame : frames) {
+        frame->updProperty_attached_geometry().clear();
+    }
+    model.finalizeFromProperties();
+}
+
+void ModelFactory::collapseOffsetFrameChains(Model& model) {
+    model.finalizeConnections();
+
+    // Find the new parents and offsets of all frames before changing any,
+    // since the parents of a frame are not accessible once its socket is
+    // changed (until the connections are finalized again).
+    struct Collapse {
+        PhysicalOffsetFrame* frame;
+        const PhysicalFrame* parent;
+        SimTK::Transform offset;
+    };
+    std::vector<Collapse> collapses;
+    for (auto& frame : model.updComponentList<PhysicalOffsetFrame>()) {
+        const PhysicalFrame* parent = &frame.getParentFrame();
+        SimTK::Transform offset = frame.getOffsetTransform();
+        int length = 0;
+        while (const auto* offsetParent =
+                        dynamic_cast<const PhysicalOffsetFrame*>(parent)) {
+            offset = offsetParent->getOffsetTransform() * offset;
+            parent = &offsetParent->getParentFrame();
+            ++length;
+        }
+        if (length) collapses.push_back({&frame, parent, offset});
+    }
+
+    for (const auto& collapse : collapses) {
+        collapse.frame->setOffsetTransform(collapse.offset);
+        collapse.frame->connectSocket_parent(*collapse.parent);
+    }
+    if (!collapses.empty()) {
+        log_debug("Collapsed the chains of parents of {} "
+                  "PhysicalOffsetFrame(s).", collapses.size());
+    }
+    model.finalizeConnections();
+}
+
 void ModelFactory::createReserveActuators(Model& model, double optimalForce,
         double bound,
         bool skipCoordinatesWithExistingActuators) {
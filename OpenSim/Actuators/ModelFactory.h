@@ -53,6 +53,29 @@ public:
     /// - 2 coordinate actuators: "force_x" and "force_y".
     /// Gravity is default; that is, (0, -g, 0).
     static Model createPlanarPointMass();
+    /// Create a model whose size is set by the arguments, to measure how
+    /// computations (e.g., initSystem(), realization, integration, and Moco
+    /// solves) scale with the size of a model (see the benchmarks). The model
+    /// contains:
+    /// - `numBodies` bodies `/bodyset/b#` (mass 1 kg, 1 m long) in a chain,
+    ///   connected by PinJoint%s `/jointset/j#` with coordinates `q#`, as in
+    ///   createNLinkPendulum(). The axes of the joints alternate between the
+    ///   z and y axes, so that the chain moves in 3 dimensions.
+    /// - `numMuscles` Millard2012EquilibriumMuscle%s `/forceset/m#`. Muscle
+    ///   `i` crosses joint `i % numBodies`, from the middle of the parent
+    ///   body (or near the origin of ground) to the middle of the child body,
+    ///   with `numPathPoints` path points (at least 2) evenly spaced along
+    ///   the path. Successive muscles that cross the same joint are on
+    ///   alternating sides of it, with increasing moment arms.
+    /// - If `wrap` is true, a WrapCylinder `/bodyset/b#/wrap#` about the axis
+    ///   of each joint, over which the muscles that cross the joint wrap.
+    /// - `numContactSpheres` ContactSphere%s `/contactgeometryset/sphere#`,
+    ///   distributed over the bodies, with SmoothSphereHalfSpaceForce%s
+    ///   `/forceset/contact#` with the ContactHalfSpace
+    ///   `/contactgeometryset/floor` (1 m below ground).
+    static Model createScalableModel(int numBodies, int numMuscles,
+            int numPathPoints = 2, bool wrap = false,
+            int numContactSpheres = 0);
 
 
     /// @}
@@ -75,6 +98,20 @@ public:
     static void replaceJointWithWeldJoint(
             Model& model, const std::string& jointName);
 
+    /// Remove the Geometry attached to the frames of the model (which is
+    /// only used for visualization). This does not change the dynamics of the
+    /// model; it makes the model faster to copy and initialize.
+    static void removeVisualization(Model& model);
+
+    /// Connect each PhysicalOffsetFrame whose parent is another
+    /// PhysicalOffsetFrame directly to the first frame in its chain of
+    /// parents that is not a PhysicalOffsetFrame (e.g., a Body), with the
+    /// offset transforms of the chain combined, so that computing the
+    /// transform of the frame does not traverse the chain. The frames
+    /// themselves are kept (other components may connect to them), and their
+    /// transforms in ground change only by roundoff.
+    static void collapseOffsetFrameChains(Model& model);
+
     /// Add CoordinateActuator%s for each unconstrained coordinate (e.g.,
     /// `! Coordinate::isConstrained()`) in the model, using the provided optimal
     /// force. Increasing the optimal force decreases the required control
@@ -148,6 +148,8 @@ public:
         }
         model.addModelComponent(new ExternalLoads(path, true));
     }
+    /// The ExternalLoads and data files are not part of the cache key.
+    bool isCacheable() const override { return false; }
 };
 
 class OSIMACTUATORS_API ModOpReplaceJointsWithWelds : public ModelOperator {
@@ -182,6 +184,41 @@ public:
     }
 };
 
+/// Strip the model of the components that are not needed to compute its
+/// dynamics, so that it is faster to copy and initialize and has a smaller
+/// State: the geometry attached to frames is removed (see
+/// ModelFactory::removeVisualization()), chains of PhysicalOffsetFrames are
+/// collapsed (see ModelFactory::collapseOffsetFrameChains()), and, optionally,
+/// the markers and probes are removed. The dynamics of the model are unchanged
+/// (up to roundoff from combining offset transforms). Keep the markers when
+/// the model is used with marker data (e.g., for inverse kinematics or marker
+/// tracking).
+class OSIMACTUATORS_API ModOpStripForComputation : public ModelOperator {
+    OpenSim_DECLARE_CONCRETE_OBJECT(ModOpStripForComputation, ModelOperator);
+    OpenSim_DECLARE_PROPERTY(remove_markers, bool,
+            "Remove the markers of the model (default: false).");
+    OpenSim_DECLARE_PROPERTY(remove_probes, bool,
+            "Remove the probes of the model (default: false).");
+
+public:
+    ModOpStripForComputation() {
+        constructProperty_remove_markers(false);
+        constructProperty_remove_probes(false);
+    }
+    ModOpStripForComputation(bool removeMarkers, bool removeProbes)
+            : ModOpStripForComputation() {
+        set_remove_markers(removeMarkers);
+        set_remove_probes(removeProbes);
+    }
+    void operate(Model& model, const std::string&) const override {
+        if (get_remove_markers()) model.updMarkerSet().clearAndDestroy();
+        if (get_remove_probes()) model.updProbeSet().clearAndDestroy();
+        model.finalizeConnections();
+        ModelFactory::removeVisualization(model);
+        ModelFactory::collapseOffsetFrameChains(model);
+    }
+};
+
 } // namespace OpenSim
 
 #endif // OPENSIM_MODELOPERATORS_H
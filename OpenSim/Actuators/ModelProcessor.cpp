@@ -0,0 +1,176 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim: ModelProcessor.cpp                                                *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ModelProcessor.h"
+
+#include <OpenSim/Common/About.h>
+#include <OpenSim/Common/IO.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <random>
+
+using namespace OpenSim;
+
+namespace {
+
+std::string& cacheDirectory() {
+    static std::string directory = [] {
+        const char* env = std::getenv("OPENSIM_PROCESSOR_CACHE_DIR");
+        return std::string(env ? env : "");
+    }();
+    return directory;
+}
+
+// 64-bit FNV-1a hash, which can be computed in parts.
+class Hash {
+public:
+    void add(const std::string& str) {
+        for (const char c : str) {
+            _hash ^= static_cast<unsigned char>(c);
+            _hash *= 1099511628211ULL;
+        }
+        // Separate the parts, so that ("ab", "c") and ("a", "bc") differ.
+        _hash ^= 0xff;
+        _hash *= 1099511628211ULL;
+    }
+    std::uint64_t get() const { return _hash; }
+private:
+    std::uint64_t _hash = 14695981039346656037ULL;
+};
+
+std::string resolvePath(
+        const std::string& relativeToDirectory, const std::string& path) {
+    if (relativeToDirectory.empty()) return path;
+    using SimTK::Pathname;
+    return Pathname::getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+            relativeToDirectory, path);
+}
+
+} // anonymous namespace
+
+void ModelProcessor::setCacheDirectory(const std::string& directory) {
+    cacheDirectory() = directory;
+}
+
+const std::string& ModelProcessor::getCacheDirectory() {
+    return cacheDirectory();
+}
+
+std::string ModelProcessor::getCacheFileName(
+        const std::string& relativeToDirectory) const {
+    const std::string& cacheDir = getCacheDirectory();
+    if (cacheDir.empty()) return {};
+    for (int i = 0; i < getProperty_operators().size(); ++i) {
+        if (!get_operators(i).isCacheable()) return {};
+    }
+
+    Hash hash;
+    hash.add(GetVersion());
+    if (get_filepath().empty()) {
+        if (getProperty_model().empty()) return {};
+        hash.add(get_model().dump());
+    } else {
+        std::ifstream in(resolvePath(relativeToDirectory, get_filepath()),
+                std::ios::binary);
+        if (!in.is_open()) return {};
+        const std::string contents((std::istreambuf_iterator<char>(in)),
+                std::istreambuf_iterator<char>());
+        if (contents.find(" file=") != std::string::npos) return {};
+        hash.add(contents);
+    }
+    for (int i = 0; i < getProperty_operators().size(); ++i) {
+        hash.add(get_operators(i).dump());
+    }
+
+    char name[64];
+    snprintf(name, sizeof(name), "%016llx.osim",
+            (unsigned long long)hash.get());
+    const char last = cacheDir.back();
+    return cacheDir + (last == '/' || last == '\\' ? "" : "/") + name;
+}
+
+Model ModelProcessor::process(const std::string& relativeToDirectory) const {
+    // Check the source first, so that the errors do not depend on the cache.
+    if (get_filepath().empty()) {
+        OPENSIM_THROW_IF_FRMOBJ(getProperty_model().empty(), Exception,
+                "No source model.");
+    } else {
+        OPENSIM_THROW_IF_FRMOBJ(!getProperty_model().empty(), Exception,
+                "Expected either a Model object or a filepath, but "
+                "both were provided.");
+    }
+    const std::string inputFileName =
+            get_filepath().empty()
+                    ? get_model().getInputFileName()
+                    : resolvePath(relativeToDirectory, get_filepath());
+
+    const std::string cacheFileName = getCacheFileName(relativeToDirectory);
+    if (!cacheFileName.empty() && IO::FileExists(cacheFileName)) {
+        try {
+            Model model(cacheFileName);
+            // Files referenced by the model (e.g., geometry) are located
+            // relative to the source model, as without the cache.
+            model.setInputFileName(inputFileName);
+            model.finalizeFromProperties();
+            model.finalizeConnections();
+            return model;
+        } catch (const std::exception& x) {
+            log_warn("Ignoring cache file '{}' of ModelProcessor: {}",
+                    cacheFileName, x.what());
+        }
+    }
+
+    Model model;
+    if (get_filepath().empty()) {
+        model = get_model();
+        model.finalizeFromProperties();
+        model.finalizeConnections();
+    } else {
+        Model modelFromFile(inputFileName);
+        model = std::move(modelFromFile);
+        model.finalizeFromProperties();
+        model.finalizeConnections();
+    }
+
+    for (int i = 0; i < getProperty_operators().size(); ++i) {
+        get_operators(i).operate(model, relativeToDirectory);
+    }
+
+    if (!cacheFileName.empty()) {
+        // Write under a temporary name and then rename, so that processes
+        // running the same processor concurrently never read an incomplete
+        // file.
+        const std::string tempFileName = cacheFileName + "." +
+                std::to_string(std::random_device{}()) + ".tmp";
+        bool success = false;
+        try {
+            success = model.print(tempFileName);
+        } catch (const std::exception& x) {
+            log_warn("Could not write cache file '{}' of ModelProcessor: {}",
+                    cacheFileName, x.what());
+        }
+        if (!success ||
+                std::rename(tempFileName.c_str(), cacheFileName.c_str()) != 0) {
+            // E.g., another process wrote the same cache file first.
+            std::remove(tempFileName.c_str());
+        }
+    }
+    return model;
+}
@@ -34,6 +34,12 @@ public:
     any files that this operator reads. */
     virtual void operate(
             Model& model, const std::string& relativeToDirectory) const = 0;
+    /** Whether the result of this operator is determined by its properties
+    and the model it operates on, so that ModelProcessor can cache the
+    processed model (see ModelProcessor::setCacheDirectory()). Operators
+    that read files must return false, since changes to the files would go
+    unnoticed. */
+    virtual bool isCacheable() const { return true; }
 };
 
 /** This class describes a workflow for processing a Model using
@@ -42,7 +48,16 @@ property or the filepath property. In C++, one can easily chain together
 the operators in a processor using the C++ pipe operator:
 @code
 ModelProcessor proc = ModelProcessor("model.osim") | ModOpAddReserves();
-@endcode */
+@endcode
+
+If a cache directory is set (see setCacheDirectory()), process() stores the
+processed model in a file in that directory, named after a hash of the
+contents of the source model (file) and the properties of the operators.
+Processing the same model with the same operators again (e.g., in the next
+run of a parameter sweep) loads this file instead of applying the operators.
+Processors are not cached if any of their operators is not cacheable (see
+ModelOperator::isCacheable()) or if the source model file includes other
+files (through `file` attributes). */
 class OSIMACTUATORS_API ModelProcessor : public Object {
     OpenSim_DECLARE_CONCRETE_OBJECT(ModelProcessor, Object);
 
@@ -105,38 +120,20 @@ public:
     /** Process and obtain the model. If the base model is specified via the
     filepath property, the filepath will be evaluated relative to
     `relativeToDirectory`, if provided. */
-    Model process(const std::string& relativeToDirectory = {}) const {
-        Model model;
-        if (get_filepath().empty()) {
-            if (!getProperty_model().empty()) {
-                model = get_model();
-                model.finalizeFromProperties();
-                model.finalizeConnections();
-            } else {
-                OPENSIM_THROW_FRMOBJ(Exception, "No source model.");
-            }
-        } else {
-            OPENSIM_THROW_IF_FRMOBJ(!getProperty_model().empty(), Exception,
-                    "Expected either a Model object or a filepath, but "
-                    "both were provided.");
-            std::string path = get_filepath();
-            if (!relativeToDirectory.empty()) {
-                using SimTK::Pathname;
-                path = Pathname::
-                        getAbsolutePathnameUsingSpecifiedWorkingDirectory(
-                                relativeToDirectory, path);
-            }
-            Model modelFromFile(path);
-            model = std::move(modelFromFile);
-            model.finalizeFromProperties();
-            model.finalizeConnections();
-        }
-
-        for (int i = 0; i < getProperty_operators().size(); ++i) {
-            get_operators(i).operate(model, relativeToDirectory);
-        }
-        return model;
-    }
+    Model process(const std::string& relativeToDirectory = {}) const;
+
+    /** @name Cache of processed models
+    Caching is disabled by default. The cache directory can also be set with
+    the `OPENSIM_PROCESSOR_CACHE_DIR` environment variable (which also
+    enables the cache of TableProcessor); setCacheDirectory() takes
+    precedence. The directory is not thread-safe to change while models are
+    being processed. */
+    /// @{
+    /** Set the directory for cache files (it must exist). An empty string
+    disables caching. */
+    static void setCacheDirectory(const std::string& directory);
+    static const std::string& getCacheDirectory();
+    /// @}
 
     /** Append an operation to the end of the operations in this processor. */
     ModelProcessor& append(const ModelOperator& op) {
@@ -153,6 +150,10 @@ public:
 
 private:
     OpenSim_DECLARE_OPTIONAL_PROPERTY(model, Model, "Base model to process.");
+
+    /** The path of the cache file of the processed model, or an empty string
+    if this processor cannot be cached. */
+    std::string getCacheFileName(const std::string& relativeToDirectory) const;
 };
 
 } // namespace OpenSim
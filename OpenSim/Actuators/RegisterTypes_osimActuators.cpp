@@ -88,6 +88,7 @@ OSIMACTUATORS_API void RegisterTypes_osimActuators()
     Object::registerType(ModOpAddReserves());
     Object::registerType(ModOpAddExternalLoads());
     Object::registerType(ModOpReplaceJointsWithWelds());
+    Object::registerType(ModOpStripForComputation());
 
     //Object::RegisterType( ConstantMuscleActivation() );
     //Object::RegisterType( ZerothOrderMuscleActivationDynamics() );
@@ -118,5 +119,5 @@ osimActuatorsInstantiator::osimActuatorsInstantiator()
 
 void osimActuatorsInstantiator::registerDllClasses()
 {
-       RegisterTypes_osimActuators();
+       Object::deferTypeRegistration(RegisterTypes_osimActuators);
 }
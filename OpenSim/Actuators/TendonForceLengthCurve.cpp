@@ -235,6 +235,14 @@ double TendonForceLengthCurve::calcDerivative(double aNormLength,
     return m_curve.calcDerivative(aNormLength,order);
 }
 
+SimTK::Vec3 TendonForceLengthCurve::
+    calcValueAndDerivatives(double aNormLength, int maxOrder) const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "TendonForceLengthCurve: Tendon is not up-to-date with its properties");
+    return m_curve.calcValueAndDerivatives(aNormLength, maxOrder);
+}
+
 double TendonForceLengthCurve::
     calcDerivative(const std::vector<int>& derivComponents,
                    const SimTK::Vector& x) const
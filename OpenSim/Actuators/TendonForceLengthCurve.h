@@ -274,6 +274,14 @@ public:
         normalized tendon length.
     */
     double calcDerivative(double aNormLength, int order) const;
+
+    /** Calculates the tendon-force-length multiplier and its first and second
+    derivatives with respect to the normalized tendon length, as [value, first
+    derivative, second derivative]; derivatives of order higher than `maxOrder`
+    (0, 1, or 2) are NaN. The curve is searched only once, so this is cheaper
+    than calling calcValue() and calcDerivative() at the same point. */
+    SimTK::Vec3 calcValueAndDerivatives(double aNormLength,
+                                        int maxOrder = 2) const;
     
     /// If possible, use the simpler overload above.
     double calcDerivative(const std::vector<int>& derivComponents,
@@ -29,6 +29,7 @@
 //    4. testMcKibbenActuator()
 //    5. testActuatorsCombination()
 //    6. testActivationCoordinateActuator()
+//    7. testOverrideActuation()
 //
 //     Add tests here as Actuators are added to OpenSim
 //
@@ -57,6 +58,7 @@ void testClutchedPathSpring();
 void testMcKibbenActuator();
 void testActuatorsCombination();
 void testActivationCoordinateActuator();
+void testOverrideActuation();
 
 
 int main()
@@ -87,6 +89,10 @@ int main()
     catch (const std::exception& e) {
         cout << e.what() << endl; failures.push_back("testActivationCoordinateActuator");
     }
+    try { testOverrideActuation(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl; failures.push_back("testOverrideActuation");
+    }
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -967,3 +973,32 @@ void testActivationCoordinateActuator() {
             aca->getStateVariableValue(state, "activation");
     ASSERT_EQUAL(expectedFinalActivation, foundFinalActivation, 1e-4);
 }
+
+void testOverrideActuation() {
+    Model model;
+    auto* body = new Body("body", 1, SimTK::Vec3(0), SimTK::Inertia(1.0));
+    auto* joint = new PinJoint("joint", *body, model.getGround());
+    joint->updCoordinate().setName("coord");
+    model.addBody(body);
+    model.addJoint(joint);
+    auto* actu = new CoordinateActuator("coord");
+    actu->setName("actu");
+    actu->setOptimalForce(1.0);
+    model.addForce(actu);
+
+    SimTK::State& state = model.initSystem();
+    actu->overrideActuation(state, true);
+    model.realizeVelocity(state);
+
+    // Changing the override actuation must not invalidate the positions and
+    // velocities, but must change the forces and accelerations.
+    for (const double actuation : {10.0, -4.0}) {
+        actu->setOverrideActuation(state, actuation);
+        ASSERT(state.getSystemStage() >= SimTK::Stage::Velocity, __FILE__,
+                __LINE__, "Expected the velocity stage to still be valid.");
+        model.realizeAcceleration(state);
+        ASSERT_EQUAL(actuation, actu->getActuation(state), SimTK::SignificantReal);
+        ASSERT_EQUAL(actuation,
+                joint->getCoordinate().getAccelerationValue(state), 1e-10);
+    }
+}
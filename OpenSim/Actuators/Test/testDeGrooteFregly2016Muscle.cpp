@@ -22,6 +22,7 @@
  * -------------------------------------------------------------------------- */
 
 #include <OpenSim/Actuators/DeGrooteFregly2016Muscle.h>
+#include <OpenSim/Actuators/DeGrooteFregly2016MuscleGroup.h>
 #include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Moco/osimMoco.h>
@@ -1085,3 +1086,175 @@ TEST_CASE("DeGrooteFregly2016Muscle basics") {
         CHECK(state.getY()[2] == Approx(0.451));
     }
 }
+
+TEST_CASE("DeGrooteFregly2016MuscleGroup") {
+    Model model;
+    auto* body = new Body("body", 0.5, SimTK::Vec3(0), SimTK::Inertia(0));
+    model.addComponent(body);
+    auto* joint = new SliderJoint("joint", model.getGround(), *body);
+    auto& coord = joint->updCoordinate(SliderJoint::Coord::TranslationX);
+    coord.setName("x");
+    model.addComponent(joint);
+    const auto addMuscle = [&](const std::string& name) {
+        auto* muscle = new DeGrooteFregly2016Muscle();
+        muscle->setName(name);
+        muscle->set_optimal_fiber_length(0.1);
+        muscle->set_tendon_slack_length(0.05);
+        muscle->set_pennation_angle_at_optimal(0.1);
+        muscle->set_fiber_damping(0.01);
+        muscle->addNewPathPoint("origin", model.updGround(), SimTK::Vec3(0));
+        muscle->addNewPathPoint("insertion", *body, SimTK::Vec3(0));
+        model.addComponent(muscle);
+        return muscle;
+    };
+    addMuscle("rigid")->set_ignore_tendon_compliance(true);
+    addMuscle("explicit")->set_active_force_width_scale(1.5);
+    auto* implicitMuscle = addMuscle("implicit");
+    implicitMuscle->set_tendon_compliance_dynamics_mode("implicit");
+    implicitMuscle->set_ignore_passive_fiber_force(true);
+
+    SimTK::State state = model.initSystem();
+    coord.setValue(state, 0.16);
+    coord.setSpeedValue(state, -0.3);
+    for (const auto& muscle :
+            model.getComponentList<DeGrooteFregly2016Muscle>()) {
+        muscle.setActivation(state, 0.6);
+    }
+    const auto& explicitMuscle =
+            model.getComponent<DeGrooteFregly2016Muscle>("explicit");
+    explicitMuscle.setStateVariableValue(state,
+            DeGrooteFregly2016Muscle::getNormalizedTendonForceStateName(),
+            0.4);
+    implicitMuscle->setStateVariableValue(state,
+            DeGrooteFregly2016Muscle::getNormalizedTendonForceStateName(),
+            0.5);
+    implicitMuscle->setDiscreteVariableValue(state,
+            DeGrooteFregly2016Muscle::getImplicitDynamicsDerivativeName(),
+            0.8);
+
+    DeGrooteFregly2016MuscleGroup group(model);
+    CHECK(group.getNumMuscles() == 3);
+
+    // The muscles compute their own values in `state`, and the group
+    // computes the values in `groupState`.
+    SimTK::State groupState = state;
+    model.realizeVelocity(state);
+    model.realizeVelocity(groupState);
+    group.calcMuscleInfos(groupState);
+
+    for (int i = 0; i < group.getNumMuscles(); ++i) {
+        const auto& muscle = group.getMuscle(i);
+        CAPTURE(muscle.getName());
+        const auto check = [&](double (Muscle::*get)(const SimTK::State&)
+                                       const) {
+            CHECK((muscle.*get)(groupState) ==
+                    Approx((muscle.*get)(state)).epsilon(1e-12));
+        };
+        check(&Muscle::getTendonLength);
+        check(&Muscle::getFiberLength);
+        check(&Muscle::getPennationAngle);
+        check(&Muscle::getActiveForceLengthMultiplier);
+        check(&Muscle::getPassiveForceMultiplier);
+        check(&Muscle::getFiberVelocity);
+        check(&Muscle::getTendonVelocity);
+        check(&Muscle::getPennationAngularVelocity);
+        check(&Muscle::getForceVelocityMultiplier);
+        check(&Muscle::getFiberForce);
+        check(&Muscle::getActiveFiberForce);
+        check(&Muscle::getPassiveFiberForce);
+        check(&Muscle::getTendonForce);
+        check(&Muscle::getFiberStiffness);
+        check(&Muscle::getFiberStiffnessAlongTendon);
+        check(&Muscle::getMuscleStiffness);
+        check(&Muscle::getFiberActivePower);
+        check(&Muscle::getFiberPassivePower);
+        check(&Muscle::getMusclePower);
+        CHECK(muscle.getPassiveFiberDampingForce(groupState) ==
+                Approx(muscle.getPassiveFiberDampingForce(state))
+                        .epsilon(1e-12));
+    }
+    CHECK(implicitMuscle->getImplicitResidualNormalizedTendonForce(
+                  groupState) ==
+            Approx(implicitMuscle->getImplicitResidualNormalizedTendonForce(
+                           state))
+                    .epsilon(1e-12));
+
+    SECTION("Multiple states at once") {
+        std::vector<SimTK::State> states(3, state);
+        for (int j = 0; j < (int)states.size(); ++j) {
+            coord.setValue(states[j], 0.15 + 0.01 * j);
+            coord.setSpeedValue(states[j], -0.3 + 0.2 * j);
+        }
+        std::vector<SimTK::State> groupStates = states;
+        std::vector<const SimTK::State*> groupStatePtrs;
+        for (auto& groupState : groupStates) {
+            model.realizeVelocity(groupState);
+            groupStatePtrs.push_back(&groupState);
+        }
+        group.calcMuscleInfos(groupStatePtrs);
+        for (int j = 0; j < (int)states.size(); ++j) {
+            model.realizeVelocity(states[j]);
+            for (int i = 0; i < group.getNumMuscles(); ++i) {
+                const auto& muscle = group.getMuscle(i);
+                CAPTURE(j, muscle.getName());
+                CHECK(muscle.getTendonForce(groupStates[j]) ==
+                        Approx(muscle.getTendonForce(states[j]))
+                                .epsilon(1e-12));
+                CHECK(muscle.getFiberStiffness(groupStates[j]) ==
+                        Approx(muscle.getFiberStiffness(states[j]))
+                                .epsilon(1e-12));
+            }
+        }
+    }
+
+    SECTION("The state must be realized to Stage::Velocity") {
+        SimTK::State unrealized = state;
+        unrealized.updU();
+        CHECK_THROWS_AS(group.calcMuscleInfos(unrealized), Exception);
+    }
+}
+
+TEST_CASE("DeGrooteFregly2016Muscle implicit residuals") {
+    Model model;
+    auto* body = new Body("body", 0.5, SimTK::Vec3(0), SimTK::Inertia(0));
+    model.addComponent(body);
+    auto* joint = new SliderJoint("joint", model.getGround(), *body);
+    auto& coord = joint->updCoordinate(SliderJoint::Coord::TranslationX);
+    coord.setName("x");
+    model.addComponent(joint);
+    const auto addMuscle = [&](const std::string& name) {
+        auto* muscle = new DeGrooteFregly2016Muscle();
+        muscle->setName(name);
+        muscle->set_optimal_fiber_length(0.1);
+        muscle->set_tendon_slack_length(0.05);
+        muscle->set_ignore_tendon_compliance(false);
+        muscle->addNewPathPoint("origin", model.updGround(), SimTK::Vec3(0));
+        muscle->addNewPathPoint("insertion", *body, SimTK::Vec3(0));
+        model.addComponent(muscle);
+        return muscle;
+    };
+    const auto* explicitMuscle = addMuscle("explicit");
+    auto* implicitMuscle = addMuscle("implicit");
+    implicitMuscle->set_tendon_compliance_dynamics_mode("implicit");
+
+    SimTK::State state = model.initSystem();
+    CHECK(explicitMuscle->getImplicitStateVariableNames().empty());
+    const auto names = implicitMuscle->getImplicitStateVariableNames();
+    REQUIRE(names.size() == 1);
+    CHECK(names[0] ==
+            DeGrooteFregly2016Muscle::getNormalizedTendonForceStateName());
+    CHECK(Component::getImplicitDerivativeName(names[0]) ==
+            DeGrooteFregly2016Muscle::getImplicitDynamicsDerivativeName());
+
+    coord.setValue(state, 0.16);
+    implicitMuscle->setActivation(state, 0.6);
+    implicitMuscle->setStateVariableValue(state, names[0], 0.5);
+    implicitMuscle->setDiscreteVariableValue(state,
+            Component::getImplicitDerivativeName(names[0]), 0.8);
+    model.realizeDynamics(state);
+    SimTK::Vector residuals(1, SimTK::NaN);
+    implicitMuscle->computeImplicitResiduals(state, residuals);
+    CHECK(residuals[0] ==
+            implicitMuscle->getOutputValue<double>(
+                    state, "implicitresidual_normalized_tendon_force"));
+}
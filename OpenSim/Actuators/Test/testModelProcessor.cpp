@@ -20,6 +20,7 @@
 #include "OpenSim/Moco/Test/Testing.h"
 
 #include <OpenSim/Actuators/Millard2012EquilibriumMuscle.h>
+#include <OpenSim/Actuators/ModelFactory.h>
 #include <OpenSim/Actuators/ModelOperators.h>
 #include <OpenSim/Analyses/MuscleAnalysis.h>
 #include <OpenSim/Moco/osimMoco.h>
@@ -123,3 +124,85 @@ TEST_CASE("ModOpReplaceMusclesWithPathActuators") {
             0);
     CHECK(processedModel.countNumComponents<PathActuator>() == 1);
 }
+
+TEST_CASE("ModOpStripForComputation") {
+    Model model = ModelFactory::createDoublePendulum();
+    // A marker on the last frame of a chain of offset frames.
+    auto* offset1 = new PhysicalOffsetFrame("offset1",
+            model.getComponent<Body>("bodyset/b1"),
+            SimTK::Transform(SimTK::Rotation(0.3, SimTK::ZAxis),
+                    SimTK::Vec3(0.1, 0.2, 0)));
+    auto* offset2 = new PhysicalOffsetFrame("offset2", *offset1,
+            SimTK::Transform(SimTK::Vec3(0, 0.5, 0)));
+    model.addComponent(offset1);
+    model.addComponent(offset2);
+    model.addMarker(new Marker("tip", *offset2, SimTK::Vec3(0.1, 0, 0)));
+    model.finalizeConnections();
+    REQUIRE(model.countNumComponents<Geometry>() > 0);
+
+    SimTK::State state = model.initSystem();
+    model.getCoordinateSet().get("q0").setValue(state, 0.4);
+    model.getCoordinateSet().get("q1").setValue(state, -0.7);
+    model.getCoordinateSet().get("q1").setSpeedValue(state, 1.5);
+    model.realizeAcceleration(state);
+
+    ModelProcessor proc(model);
+    proc.append(ModOpStripForComputation());
+    Model processedModel = proc.process();
+    CHECK(processedModel.countNumComponents<Geometry>() == 0);
+    CHECK(processedModel.getMarkerSet().getSize() == 3);
+    const auto& processedOffset2 =
+            processedModel.getComponent<PhysicalOffsetFrame>(
+                    "offset2");
+    CHECK(&processedOffset2.getParentFrame() ==
+            &processedModel.getComponent<Body>("bodyset/b1"));
+
+    SimTK::State processedState = processedModel.initSystem();
+    processedState.updQ() = state.getQ();
+    processedState.updU() = state.getU();
+    processedModel.realizeAcceleration(processedState);
+    CHECK(processedState.getNY() == state.getNY());
+    CHECK((processedState.getUDot() - state.getUDot()).normInf() == 0);
+    const SimTK::Vec3 location = model.getMarkerSet().get("tip")
+            .getLocationInGround(state);
+    const SimTK::Vec3 processedLocation = processedModel.getMarkerSet()
+            .get("tip").getLocationInGround(processedState);
+    CHECK((processedLocation - location).norm() < 1e-14);
+
+    ModelProcessor stripMarkers(model);
+    stripMarkers.append(ModOpStripForComputation(true, true));
+    CHECK(stripMarkers.process().getMarkerSet().getSize() == 0);
+}
+
+TEST_CASE("ModelFactory::createScalableModel") {
+    CHECK_THROWS_AS(ModelFactory::createScalableModel(0, 1), Exception);
+    CHECK_THROWS_AS(ModelFactory::createScalableModel(2, 1, 1), Exception);
+
+    Model model = ModelFactory::createScalableModel(5, 12, 4, true, 3);
+    CHECK(model.countNumComponents<Body>() == 5);
+    CHECK(model.countNumComponents<Coordinate>() == 5);
+    CHECK(model.countNumComponents<Millard2012EquilibriumMuscle>() == 12);
+    CHECK(model.countNumComponents<WrapCylinder>() == 5);
+    CHECK(model.countNumComponents<ContactSphere>() == 3);
+    CHECK(model.countNumComponents<SmoothSphereHalfSpaceForce>() == 3);
+    const auto& muscle = model.getComponent<Muscle>("/forceset/m7");
+    CHECK(muscle.getGeometryPath().getPathPointSet().getSize() == 4);
+    CHECK(muscle.getGeometryPath().getWrapSet().getSize() == 1);
+
+    SimTK::State state = model.initSystem();
+    model.realizeVelocity(state);
+    MomentArmSolver solver(model);
+    for (const auto& m : model.getComponentList<Muscle>()) {
+        CAPTURE(m.getName());
+        CHECK(m.getLength(state) > 0.5);
+        // Each muscle has a moment arm about the joint that it crosses.
+        const int joint = std::stoi(m.getName().substr(1)) % 5;
+        const auto& coord = model.getComponent<Coordinate>(
+                "/jointset/j" + std::to_string(joint) + "/q" +
+                std::to_string(joint));
+        CHECK(std::abs(solver.solve(state, coord, m.getGeometryPath())) >
+                0.01);
+    }
+    model.realizeAcceleration(state);
+    CHECK(!state.getUDot().isNaN());
+}
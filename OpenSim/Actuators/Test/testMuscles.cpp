@@ -100,6 +100,7 @@ void testMillard2012AccelerationMuscle();
 void testDeGrooteFregly2016Muscle();
 void testSchutte1993Muscle();
 void testDelp1990Muscle();
+void testEquilibrateManyMuscles();
 
 void testMuscleEquilibriumSolve(const Model& model, const Storage& statesStore);
 
@@ -151,6 +152,12 @@ int main()
         e.print(cout);
         failures.push_back("testDeGrooteFregly2016Muscle");
     }
+    try { testEquilibrateManyMuscles();
+        cout << "Equilibrate many muscles Test passed" << endl;
+    } catch (const Exception& e) {
+        e.print(cout);
+        failures.push_back("testEquilibrateManyMuscles");
+    }
 
     printf("\n\n");
     cout <<"************************************************************"<<endl;
@@ -837,6 +844,31 @@ void testThelen2003Muscle()
         muscle->setMinimumActivation(0.01);
         model.finalizeFromProperties();
     }
+
+    // The curves use the values of the properties as of the last
+    // finalizeFromProperties().
+    {
+        Model model;
+        auto muscle = new Thelen2003Muscle("muscle", 1., 0.5, 0.5, 0.);
+        muscle->addNewPathPoint("p1", model.updGround(), SimTK::Vec3(0));
+        muscle->addNewPathPoint("p2", model.updGround(), SimTK::Vec3(0,0,1));
+        model.addForce(muscle);
+
+        const double normFiberLength = 1.2;
+        for (double kShapePassive : {4.0, 6.0}) {
+            muscle->set_KshapePassive(kShapePassive);
+            SimTK::State& state = model.initSystem();
+            muscle->setFiberLength(state, normFiberLength * 0.5);
+            model.realizePosition(state);
+            const double e0 = muscle->get_FmaxMuscleStrain();
+            const double expected =
+                    (exp(kShapePassive * (normFiberLength - 1) / e0) - 1) /
+                    (exp(kShapePassive) - 1);
+            ASSERT_EQUAL(expected, muscle->getPassiveForceMultiplier(state),
+                1e-10, __FILE__, __LINE__,
+                "passive force multiplier does not use KshapePassive");
+        }
+    }
 }
 
 
@@ -1009,6 +1041,51 @@ void testDeGrooteFregly2016Muscle() {
         false);
 }
 
+// Model::equilibrateMuscles() equilibrates many muscles concurrently; the
+// results must be those of equilibrating each muscle in turn.
+void testEquilibrateManyMuscles()
+{
+    Model model;
+    auto* body = new Body("body", 1.0, SimTK::Vec3(0), SimTK::Inertia(0.1));
+    model.addBody(body);
+    auto* slider = new SliderJoint("slider", model.getGround(), *body);
+    model.addJoint(slider);
+
+    const int numMuscles = 64;
+    for (int i = 0; i < numMuscles; ++i) {
+        auto* muscle = new Thelen2003Muscle("muscle" + std::to_string(i),
+                MaxIsometricForce0, OptimalFiberLength0, TendonSlackLength0,
+                PennationAngle0);
+        const double y = 0.01 * i;
+        muscle->addNewPathPoint("origin", model.updGround(),
+                SimTK::Vec3(0, y, 0));
+        muscle->addNewPathPoint("insertion", *body,
+                SimTK::Vec3(OptimalFiberLength0 + TendonSlackLength0, y, 0));
+        model.addForce(muscle);
+    }
+
+    SimTK::State& state = model.initSystem();
+    slider->updCoordinate().setValue(state, 0.02);
+    slider->updCoordinate().setSpeedValue(state, -0.1);
+    for (int i = 0; i < numMuscles; ++i) {
+        model.getMuscles()[i].setActivation(state, 0.05 + 0.9 * i / numMuscles);
+    }
+
+    SimTK::State expected = state;
+    model.realizeVelocity(expected);
+    for (int i = 0; i < numMuscles; ++i) {
+        model.getMuscles()[i].computeEquilibrium(expected);
+    }
+
+    model.equilibrateMuscles(state);
+    for (int i = 0; i < numMuscles; ++i) {
+        const Muscle& muscle = model.getMuscles()[i];
+        ASSERT_EQUAL(muscle.getFiberLength(expected),
+                muscle.getFiberLength(state), 0.0, __FILE__, __LINE__,
+                "Fiber length of " + muscle.getName() + " differs.");
+    }
+}
+
 void testSchutte1993Muscle()
 {
     Schutte1993Muscle_Deprecated muscle("muscle",
@@ -100,6 +100,28 @@ void Thelen2003Muscle::extendFinalizeFromProperties()
         "%s: F-v extrapolation threshold must be greater than 1.0/Flen",
         getName().c_str());
 
+    // Cache the values used by the curves and the muscle info (see Parameters).
+    _params.maxIsometricForce = getMaxIsometricForce();
+    _params.optimalFiberLength = getOptimalFiberLength();
+    _params.tendonSlackLength = getTendonSlackLength();
+    _params.maxContractionVelocity = getMaxContractionVelocity();
+    /*The paper reports etoe = 0.609e0, however, this is a severely rounded off
+        The exact answer, to SimTK::Eps is
+        etoe =  99*e0*e^3 / ( 166*e^3 - 67)
+        klin =  67 /( 100*(e0 - (99*e0*e^3)/(166*e^3-67)) )
+        See thelenINIT_20120127.mw for details
+    */
+    const double e0 = get_FmaxTendonStrain();
+    const double t1 = exp(0.3e1);
+    _params.eToe = (0.99e2*e0*t1) / (0.166e3*t1 - 0.67e2);
+    _params.klin = (0.67e2/0.100e3) * 1.0/(e0 - _params.eToe);
+    _params.kShapeActive = get_KshapeActive();
+    _params.e0Muscle = get_FmaxMuscleStrain();
+    _params.kShapePassive = get_KshapePassive();
+    _params.expKShapePassiveMinusOne = exp(get_KshapePassive()) - 1.0;
+    _params.af = get_Af();
+    _params.flen = get_Flen();
+    _params.fvLinearExtrapThreshold = get_fv_linear_extrap_threshold();
 
     OPENSIM_THROW_IF_FRMOBJ(get_minimum_activation() < 0.01,
         InvalidPropertyValue, getProperty_minimum_activation().getName(),
@@ -353,26 +375,26 @@ void Thelen2003Muscle::computeInitialFiberEquilibrium(SimTK::State& s) const
     switch(result.first) {
 
     case StatusFromInitMuscleState::Success_Converged:
-        setActuation(s, result.second["tendon_force"]);
-        setFiberLength(s, result.second["fiber_length"]);
+        setActuation(s, result.second.tendon_force);
+        setFiberLength(s, result.second.fiber_length);
         break;
 
     case StatusFromInitMuscleState::Warning_FiberAtLowerBound:
         log_warn("Thelen2003Muscle initialization: '{}' is at its minimum "
                  "fiber length of {}.", getName(),
-                result.second["fiber_length"]);
-        setActuation(s, result.second["tendon_force"]);
-        setFiberLength(s, result.second["fiber_length"]);
+                result.second.fiber_length);
+        setActuation(s, result.second.tendon_force);
+        setFiberLength(s, result.second.fiber_length);
         break;
 
     case StatusFromInitMuscleState::Failure_MaxIterationsReached:
         // Report internal variables and throw exception.
         std::ostringstream ss;
-        ss << "\n  Solution error " << abs(result.second["solution_error"])
+        ss << "\n  Solution error " << abs(result.second.solution_error)
            << " exceeds tolerance of " << tol << "\n"
            << "  Newton iterations reached limit of " << maxIter << "\n"
            << "  Activation is " << activation << "\n"
-           << "  Fiber length is " << result.second["fiber_length"] << "\n";
+           << "  Fiber length is " << result.second.fiber_length << "\n";
         OPENSIM_THROW_FRMOBJ(MuscleCannotEquilibrate, ss.str());
         break;
     }
@@ -382,9 +404,9 @@ void Thelen2003Muscle::calcMuscleLengthInfo(const SimTK::State& s,
                                             MuscleLengthInfo& mli) const
 {    
     try{
-        double optFiberLength   = getOptimalFiberLength();
+        double optFiberLength   = _params.optimalFiberLength;
         double mclLength        = getLength(s);
-        double tendonSlackLen   = getTendonSlackLength();
+        double tendonSlackLen   = _params.tendonSlackLength;
 
         //Clamp the minimum fiber length to its minimum physical value.
         mli.fiberLength  = getPennationModel().clampFiberLength(
@@ -409,6 +431,11 @@ void Thelen2003Muscle::calcMuscleLengthInfo(const SimTK::State& s,
     
         mli.fiberPassiveForceLengthMultiplier= calcfpe(mli.normFiberLength);
         mli.fiberActiveForceLengthMultiplier = calcfal(mli.normFiberLength);
+
+        // The normalized tendon force depends only on the tendon length, so
+        // it is computed here rather than each time the velocity is.
+        mli.userDefinedLengthExtras.resize(1);
+        mli.userDefinedLengthExtras[0] = calcfse(mli.normTendonLength);
     }catch(const std::exception &x){
         std::string msg = "Exception caught in Thelen2003Muscle::" 
                           "calcMuscleLengthInfo\n"                 
@@ -448,8 +475,7 @@ void Thelen2003Muscle::calcFiberVelocityInfo(const SimTK::State& s,
 
         //Get the static properties of this muscle
             // double mclLength      = getLength(s);
-            double tendonSlackLen = getTendonSlackLength();
-            double optFiberLen    = getOptimalFiberLength();
+            double optFiberLen    = _params.optimalFiberLength;
         //=========================================================================
         // Compute fv by inverting the force-velocity relationship in the 
         // equilibrium equations
@@ -467,8 +493,7 @@ void Thelen2003Muscle::calcFiberVelocityInfo(const SimTK::State& s,
         double cosphi=mli.cosPennationAngle;
         double sinphi = mli.sinPennationAngle;
 
-        //2. compute the tendon length ... because we can with this kind of model
-        double tl = mli.tendonLength;
+        //2. the tendon length and force were computed with the length info
 
         
         //3. Compute force multipliers and the fiber velocity
@@ -500,7 +525,7 @@ void Thelen2003Muscle::calcFiberVelocityInfo(const SimTK::State& s,
         //default values that are appropriate when fiber length has been clamped
         //to its minimum allowable value.
 
-        double fse  = calcfse(tl/tendonSlackLen);    
+        double fse  = mli.userDefinedLengthExtras[0];
         double fal  = mli.fiberActiveForceLengthMultiplier;
         double fpe  = mli.fiberPassiveForceLengthMultiplier;
 
@@ -509,7 +534,7 @@ void Thelen2003Muscle::calcFiberVelocityInfo(const SimTK::State& s,
                                               //is clamped
         double fv     = afalfv/(a*fal);
         double dlceN  = calcdlceN(a,fal,afalfv);
-        double dlce   = dlceN*getMaxContractionVelocity()*optFiberLen;
+        double dlce   = dlceN*_params.maxContractionVelocity*optFiberLen;
         double tanPhi = tan(phi);
         double dphidt = getPennationModel().calcPennationAngularVelocity(
                                             tanPhi,lce,dlce);
@@ -540,7 +565,7 @@ void Thelen2003Muscle::calcFiberVelocityInfo(const SimTK::State& s,
         fvi.pennationAngularVelocity    = dphidt;
 
         fvi.tendonVelocity              = dtl;
-        fvi.normTendonVelocity          = dtl/getTendonSlackLength();
+        fvi.normTendonVelocity          = dtl/_params.tendonSlackLength;
 
         fvi.fiberForceVelocityMultiplier = fv;
 
@@ -571,9 +596,9 @@ void Thelen2003Muscle::calcMuscleDynamicsInfo(const SimTK::State& s,
         const FiberVelocityInfo &mvi = getFiberVelocityInfo(s);
         //Get the static properties of this muscle
         // double mclLength      = getLength(s);
-        double tendonSlackLen = getTendonSlackLength();
-        double optFiberLen    = getOptimalFiberLength();
-        double fiso           = getMaxIsometricForce();
+        double tendonSlackLen = _params.tendonSlackLength;
+        double optFiberLen    = _params.optimalFiberLength;
+        double fiso           = _params.maxIsometricForce;
         double penHeight      = getPennationModel().getParallelogramHeight();
 
         //=========================================================================
@@ -653,9 +678,8 @@ void Thelen2003Muscle::calcMuscleDynamicsInfo(const SimTK::State& s,
         double dmcldt       = getLengtheningSpeed(s);
         double dBoundaryWdt = mdi.tendonForce * dmcldt;
         double ddt_KEPEmW   = dFibPEdt+dTdnPEdt-dFibWdt-dBoundaryWdt;
-        SimTK::Vector userVec(1);
-        userVec(0) = ddt_KEPEmW;  
-        mdi.userDefinedDynamicsExtras = userVec;
+        mdi.userDefinedDynamicsExtras.resize(1);
+        mdi.userDefinedDynamicsExtras[0] = ddt_KEPEmW;
 
         /////////////////////////////
         //Populate the power entries
@@ -946,11 +970,11 @@ Thelen2003Muscle::initMuscleState(const SimTK::State& s,
 
     if (abs(ferr) < aSolTolerance) {  // The solution converged.
 
-        resultValues["solution_error"] = ferr;
-        resultValues["iterations"]     = (double)iter;
-        resultValues["fiber_length"]   = lce;
-        resultValues["passive_force"]  = fpe*fiso;
-        resultValues["tendon_force"]   = fse*fiso;
+        resultValues.solution_error = ferr;
+        resultValues.iterations     = (double)iter;
+        resultValues.fiber_length   = lce;
+        resultValues.passive_force  = fpe*fiso;
+        resultValues.tendon_force   = fse*fiso;
 
         return std::pair<StatusFromInitMuscleState, ValuesFromInitMuscleState>
             (StatusFromInitMuscleState::Success_Converged, resultValues);
@@ -968,21 +992,21 @@ Thelen2003Muscle::initMuscleState(const SimTK::State& s,
         fse = calcfse(tlN);
         fpe = calcfpe(lceN);
 
-        resultValues["solution_error"] = ferr;
-        resultValues["iterations"]     = (double)iter;
-        resultValues["fiber_length"]   = lce;
-        resultValues["passive_force"]  = fpe*fiso;
-        resultValues["tendon_force"]   = fse*fiso;
+        resultValues.solution_error = ferr;
+        resultValues.iterations     = (double)iter;
+        resultValues.fiber_length   = lce;
+        resultValues.passive_force  = fpe*fiso;
+        resultValues.tendon_force   = fse*fiso;
 
         return std::pair<StatusFromInitMuscleState, ValuesFromInitMuscleState>
            (StatusFromInitMuscleState::Warning_FiberAtLowerBound, resultValues);
     }
 
-    resultValues["solution_error"] = ferr;
-    resultValues["iterations"]     = (double)iter;
-    resultValues["fiber_length"]   = SimTK::NaN;
-    resultValues["passive_force"]  = SimTK::NaN;
-    resultValues["tendon_force"]   = SimTK::NaN;
+    resultValues.solution_error = ferr;
+    resultValues.iterations     = (double)iter;
+    resultValues.fiber_length   = SimTK::NaN;
+    resultValues.passive_force  = SimTK::NaN;
+    resultValues.tendon_force   = SimTK::NaN;
 
     return std::pair<StatusFromInitMuscleState, ValuesFromInitMuscleState>
         (StatusFromInitMuscleState::Failure_MaxIterationsReached, resultValues);
@@ -1279,21 +1303,12 @@ void Thelen2003Muscle::
 double Thelen2003Muscle::calcfse(const double tlN) const 
 {
     double x = tlN-1;
-    double e0 = get_FmaxTendonStrain();
-    
-    /*The paper reports etoe = 0.609e0, however, this is a severely rounded off
-        The exact answer, to SimTK::Eps is   
-        etoe =  99*e0*e^3 / ( 166*e^3 - 67)
-        klin =  67 /( 100*(e0 - (99*e0*e^3)/(166*e^3-67)) )
-        See thelenINIT_20120127.mw for details
-    */    
+
+    // eToe and klin are computed in extendFinalizeFromProperties().
     double kToe = 3.0;
     double Ftoe = 33.0/100.0;
-    double t1   = exp(0.3e1);
-    double eToe = (0.99e2*e0*t1) / (0.166e3*t1 - 0.67e2);
-    t1 = exp(0.3e1);
-    double klin = (0.67e2/0.100e3) 
-                * 1.0/(e0 - (0.99e2*e0*t1) / (0.166e3*t1 - 0.67e2));
+    double eToe = _params.eToe;
+    double klin = _params.klin;
 
     //Compute tendon force
     double fse = 0;
@@ -1310,27 +1325,12 @@ double Thelen2003Muscle::calcfse(const double tlN) const
 
 double Thelen2003Muscle::calcDfseDtlN(const double tlN) const {
     double x = tlN-1;
-    double e0 = get_FmaxTendonStrain();
-    
-    /*The paper reports etoe = 0.609e0, however, this is a severely rounded off
-    result of the exact answer:    
-        etoe =  99*e0*e^3 / ( 166*e^3 - 67)
-        See thelenINIT_20120127.mw for details
-    */
+
+    // eToe and klin are computed in extendFinalizeFromProperties().
     double kToe = 3.0;
     double Ftoe = 33.0/100.0;
-
-    double t1   = exp(0.3e1);
-    double eToe = (0.99e2*e0*t1) / (0.166e3*t1 - 0.67e2);
-
-    /*The paper reports etoe = 0.609e0, however, this is a severely rounded off
-    result of the exact answer:    
-        klin =  67 /( 100*(e0 - (99*e0*e^3)/(166*e^3-67)) )
-        See thelenINIT_20120127.mw for details
-    */
-    t1 = exp(0.3e1);
-    double klin = (0.67e2/0.100e3) 
-                * 1.0/(e0 - (0.99e2*e0*t1) / (0.166e3*t1 - 0.67e2));
+    double eToe = _params.eToe;
+    double klin = _params.klin;
 
     //Compute tendon force
     double dfse_d_dtlN = 0;
@@ -1423,13 +1423,13 @@ double Thelen2003Muscle::calcfsefisoPE(double tendonStrain) const
 //
 //==============================================================================
 double Thelen2003Muscle::calcfal(const double lceN) const{       
-    double kShapeActive = get_KshapeActive();   
+    double kShapeActive = _params.kShapeActive;
     double x=(lceN-1.)*(lceN-1.);
     double fal = exp(-x/kShapeActive);
     return fal;
 }
 double Thelen2003Muscle::calcDfalDlceN(const double lceN) const {
-    double kShapeActive = get_KshapeActive();   
+    double kShapeActive = _params.kShapeActive;
     double t1 = lceN - 0.10e1;
     double t2 = 0.1e1 / kShapeActive;
     double t4 = t1 * t1;
@@ -1445,28 +1445,26 @@ double Thelen2003Muscle::calcDfalDlceN(const double lceN) const {
 //=============================================================================
 double Thelen2003Muscle::calcfpe(const double lceN) const {
     double fpe = 0;
-    double e0 = get_FmaxMuscleStrain();
-    double kpe = get_KshapePassive();
+    double e0 = _params.e0Muscle;
+    double kpe = _params.kShapePassive;
 
     //Compute the passive force developed by the muscle
     if(lceN > 1.0){
         double t5 = exp(kpe * (lceN - 0.10e1) / e0);
-        double t7 = exp(kpe);
-        fpe = (t5 - 0.10e1) / (t7 - 0.10e1);
+        fpe = (t5 - 0.10e1) / _params.expKShapePassiveMinusOne;
     }
     return fpe;
 }
 
 double Thelen2003Muscle::calcDfpeDlceN(const double lceN) const {
     double dfpe_d_lceN = 0;
-    double e0 = get_FmaxMuscleStrain();
-    double kpe = get_KshapePassive();
+    double e0 = _params.e0Muscle;
+    double kpe = _params.kShapePassive;
 
     if(lceN > 1.0){
         double t1 = 0.1e1 / e0;
         double t6 = exp(kpe * (lceN - 0.10e1) * t1);
-        double t7 = exp(kpe);
-        dfpe_d_lceN = kpe * t1 * t6 / (t7 - 0.10e1);
+        dfpe_d_lceN = kpe * t1 * t6 / _params.expKShapePassiveMinusOne;
     }
     return dfpe_d_lceN;
 }
@@ -1517,12 +1515,12 @@ double Thelen2003Muscle::calcdlceN(double act,double fal,double actFalFv) const
     //The variable names have all been switched to closely match 
     //with the notation in Thelen 2003.
     double dlceN = 0.0;      //contractile element velocity    
-    double af   = get_Af();
+    double af   = _params.af;
 
     double a    = act;
     double afl  = a*fal; //afl = a*fl
     double Fm   = actFalFv;     //Fm = a*fl*fv    
-    double flen = get_Flen();
+    double flen = _params.flen;
     // double Fmlen_afl = flen*afl;
 
     double dlcedFm = 0.0; //partial derivative of contractile element
@@ -1534,7 +1532,7 @@ double Thelen2003Muscle::calcdlceN(double act,double fal,double actFalFv) const
     double Fm_asyC = 0;           //Concentric contraction asymptote
     double Fm_asyE = afl*flen;    
                                 //Eccentric contraction asymptote
-    double asyE_thresh = get_fv_linear_extrap_threshold();
+    double asyE_thresh = _params.fvLinearExtrapThreshold;
 
     //If fv is in the appropriate region, use 
     //Thelen 2003 Eqns 6 & 7 to compute dlceN
@@ -1602,12 +1600,12 @@ double Thelen2003Muscle::calcDdlceDaFalFv(double aAct,
     //The variable names have all been switched to closely match with 
     //the notation in Thelen 2003.
     // double dlceN = 0.0;      //contractile element velocity    
-    double af   = get_Af();
+    double af   = _params.af;
 
     double a    = aAct;
     double afl  = aAct*aFal;  //afl = a*fl
     double Fm   = aFalFv;    //Fm = a*fl*fv    
-    double flen = get_Flen();
+    double flen = _params.flen;
     // double Fmlen_afl = flen*aAct*aFal;
 
     double dlcedFm = 0.0; //partial derivative of contractile element 
@@ -1619,7 +1617,7 @@ double Thelen2003Muscle::calcDdlceDaFalFv(double aAct,
     double Fm_asyC = 0;           //Concentric contraction asymptote
     double Fm_asyE = aAct*aFal*flen;    
                                 //Eccentric contraction asymptote
-    double asyE_thresh = get_fv_linear_extrap_threshold();
+    double asyE_thresh = _params.fvLinearExtrapThreshold;
 
     //If fv is in the appropriate region, use 
     //Thelen 2003 Eqns 6 & 7 to compute dlceN
@@ -296,6 +296,32 @@ private:
     MemberSubcomponentIndex actMdlIdx{
       constructSubcomponent<MuscleFirstOrderActivationDynamicModel>("actMdl") };
 
+    // The property values used while computing the muscle's length, velocity,
+    // and dynamics info, and the constants of the curves that depend only on
+    // them. These are evaluated for every muscle in every realization, so
+    // their values are copied here (in extendFinalizeFromProperties()) rather
+    // than looked up in the property table each time.
+    struct Parameters {
+        double maxIsometricForce = SimTK::NaN;
+        double optimalFiberLength = SimTK::NaN;
+        double tendonSlackLength = SimTK::NaN;
+        double maxContractionVelocity = SimTK::NaN;
+        // Tendon force-length curve.
+        double eToe = SimTK::NaN;
+        double klin = SimTK::NaN;
+        // Active force-length curve.
+        double kShapeActive = SimTK::NaN;
+        // Passive force-length curve.
+        double e0Muscle = SimTK::NaN;
+        double kShapePassive = SimTK::NaN;
+        double expKShapePassiveMinusOne = SimTK::NaN;
+        // Force-velocity curve.
+        double af = SimTK::NaN;
+        double flen = SimTK::NaN;
+        double fvLinearExtrapThreshold = SimTK::NaN;
+    };
+    Parameters _params;
+
     //=====================================================================
     // Private Computation
     //      -Computes curve values, derivatives and integrals
@@ -308,10 +334,14 @@ private:
         Failure_MaxIterationsReached
     };
 
-    // Associative array of values returned by initMuscleState():
-    // solution_error, iterations, fiber_length, passive_force, and
-    // tendon_force.
-    typedef std::map<std::string, double> ValuesFromInitMuscleState;
+    // Values returned by initMuscleState().
+    struct ValuesFromInitMuscleState {
+        double solution_error;
+        double iterations;
+        double fiber_length;
+        double passive_force;
+        double tendon_force;
+    };
 
     /* Calculate the muscle state such that the fiber and tendon are developing
     the same force.
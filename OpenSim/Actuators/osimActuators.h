@@ -40,6 +40,7 @@
 #include "Millard2012EquilibriumMuscle.h"
 #include "Millard2012AccelerationMuscle.h"
 #include "DeGrooteFregly2016Muscle.h"
+#include "DeGrooteFregly2016MuscleGroup.h"
 
 #include "McKibbenActuator.h"
 
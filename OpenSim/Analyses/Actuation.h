@@ -126,6 +126,7 @@ class Storage;
         int
             printResults(const std::string &aBaseName, const std::string &aDir = "",
             double aDT = -1.0, const std::string &aExtension = ".sto") override;
+        bool getFramesAreIndependent() const override { return true; }
 
         //=============================================================================
     };  // END of class Actuation
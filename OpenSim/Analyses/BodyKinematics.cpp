@@ -446,150 +446,98 @@ record(const SimTK::State& s)
 
     // Realize to Acceleration first since we'll ask for Accelerations 
     _model->getMultibodySystem().realize(s, SimTK::Stage::Acceleration);
-    // VARIABLES
-    SimTK::Vec3 vec,angVec;
-    double Mass = 0.0;
 
-    // GROUND BODY
-    const Ground &ground = _model->getGround();
-
-    // POSITION
-    BodySet& bs = _model->updBodySet();
-
-    for(int i=0;i<_bodyIndices.getSize();i++) {
-        Body& body = bs.get(_bodyIndices[i]);
-        const SimTK::Vec3& com = body.get_mass_center();
-        // GET POSITIONS AND EULER ANGLES
-        vec = body.findStationLocationInGround(s, com);
-        angVec = body.getTransformInGround(s).R().convertRotationToBodyFixedXYZ();
-
-        // CONVERT TO DEGREES?
-        if(getInDegrees()) {
-            angVec[0] *= SimTK_RADIAN_TO_DEGREE;
-            angVec[1] *= SimTK_RADIAN_TO_DEGREE;
-            angVec[2] *= SimTK_RADIAN_TO_DEGREE;
-        }           
-
-        // FILL KINEMATICS ARRAY
-        int I=6*i;
-        memcpy(&_kin[I],&vec[0],3*sizeof(double));
-        memcpy(&_kin[I+3],&angVec[0],3*sizeof(double));
-    }
+    // The kinematics of the bodies are taken directly from the realized
+    // mobilized bodies: each quantity is a single lookup or station
+    // calculation, with no conversion through the OpenSim frames.
+    const SimTK::SimbodyMatterSubsystem& matter = _model->getMatterSubsystem();
+    const BodySet& bs = _model->getBodySet();
+    auto getMobilizedBody = [&](const Body& body)
+            -> const SimTK::MobilizedBody& {
+        return matter.getMobilizedBody(body.getMobilizedBodyIndex());
+    };
+    const double angleScale = getInDegrees() ? SimTK_RADIAN_TO_DEGREE : 1.0;
+    auto fillKinematics = [&](int i, const SimTK::Vec3& vec,
+                                  const SimTK::Vec3& angVec) {
+        int I = 6*i;
+        for(int j=0;j<3;j++) {
+            _kin[I+j] = vec[j];
+            _kin[I+3+j] = angleScale * angVec[j];
+        }
+    };
 
+    // CENTER OF MASS OF WHOLE BODY
+    // Positions, velocities, and accelerations in one pass over the bodies.
+    SimTK::Vec3 rP(0), rV(0), rA(0);
     if(_recordCenterOfMass) {
-        double rP[3] = { 0.0, 0.0, 0.0 };
+        double Mass = 0.0;
         for(int i=0;i<bs.getSize();i++) {
-            Body& body = bs.get(i);
+            const Body& body = bs.get(i);
+            const SimTK::MobilizedBody& mobod = getMobilizedBody(body);
             const SimTK::Vec3& com = body.get_mass_center();
-            vec = body.findStationLocationInGround(s, com);
             // ADD TO WHOLE BODY MASS
             Mass += body.get_mass();
-            rP[0] += body.get_mass() * vec[0];
-            rP[1] += body.get_mass() * vec[1];
-            rP[2] += body.get_mass() * vec[2];
+            rP += body.get_mass() * mobod.findStationLocationInGround(s, com);
+            rV += body.get_mass() * mobod.findStationVelocityInGround(s, com);
+            rA += body.get_mass() *
+                  mobod.findStationAccelerationInGround(s, com);
         }
-
-        //COMPUTE COM OF WHOLE BODY AND ADD TO ARRAY
-        rP[0] /= Mass;
-        rP[1] /= Mass;
-        rP[2] /= Mass;
+        rP /= Mass;
+        rV /= Mass;
+        rA /= Mass;
+    }
+    auto fillCenterOfMass = [&](const SimTK::Vec3& vec) {
+        if(!_recordCenterOfMass) return;
         int I = 6*_bodyIndices.getSize();
-        memcpy(&_kin[I],rP,3*sizeof(double));
+        for(int j=0;j<3;j++) _kin[I+j] = vec[j];
+    };
+
+    // POSITION
+    for(int i=0;i<_bodyIndices.getSize();i++) {
+        const Body& body = bs.get(_bodyIndices[i]);
+        const SimTK::MobilizedBody& mobod = getMobilizedBody(body);
+        // GET POSITIONS AND EULER ANGLES
+        fillKinematics(i,
+                mobod.findStationLocationInGround(s, body.get_mass_center()),
+                mobod.getBodyRotation(s).convertRotationToBodyFixedXYZ());
     }
-    
+    fillCenterOfMass(rP);
     _pStore->append(s.getTime(),_kin.getSize(),&_kin[0]);
 
     // VELOCITY
     for(int i=0;i<_bodyIndices.getSize();i++) {
-        Body& body = bs.get(_bodyIndices[i]);
-        const SimTK::Vec3& com = body.get_mass_center();
+        const Body& body = bs.get(_bodyIndices[i]);
+        const SimTK::MobilizedBody& mobod = getMobilizedBody(body);
         // GET VELOCITIES AND ANGULAR VELOCITIES
-        vec = body.findStationVelocityInGround(s, com);
-        angVec = body.getVelocityInGround(s)[0];
+        SimTK::Vec3 vec =
+                mobod.findStationVelocityInGround(s, body.get_mass_center());
+        SimTK::Vec3 angVec = mobod.getBodyAngularVelocity(s);
         if (_expressInLocalFrame) {
-            vec = ground.expressVectorInAnotherFrame(s, vec, body);
-            angVec = ground.expressVectorInAnotherFrame(s, angVec, body);
+            const SimTK::Rotation& R_GB = mobod.getBodyRotation(s);
+            vec = ~R_GB * vec;
+            angVec = ~R_GB * angVec;
         }
-
-        // CONVERT TO DEGREES?
-        if(getInDegrees()) {
-            angVec[0] *= SimTK_RADIAN_TO_DEGREE;
-            angVec[1] *= SimTK_RADIAN_TO_DEGREE;
-            angVec[2] *= SimTK_RADIAN_TO_DEGREE;
-        }           
-
-        // FILL KINEMATICS ARRAY
-        int I = 6*i;
-        memcpy(&_kin[I],&vec[0],3*sizeof(double));
-        memcpy(&_kin[I+3],&angVec[0],3*sizeof(double));
+        fillKinematics(i, vec, angVec);
     }
-
-    if(_recordCenterOfMass) {
-        double rV[3] = { 0.0, 0.0, 0.0 };
-        for(int i=0;i<bs.getSize();i++) {
-            Body& body = bs.get(i);
-            const SimTK::Vec3& com = body.get_mass_center();
-            vec = body.findStationVelocityInGround(s, com);
-            rV[0] += body.get_mass() * vec[0];
-            rV[1] += body.get_mass() * vec[1];
-            rV[2] += body.get_mass() * vec[2];
-        }
-
-        //COMPUTE VELOCITY OF COM OF WHOLE BODY AND ADD TO ARRAY
-        rV[0] /= Mass;
-        rV[1] /= Mass;
-        rV[2] /= Mass;
-        int I = 6*_bodyIndices.getSize();
-        memcpy(&_kin[I],rV,3*sizeof(double));
-    }
-
+    fillCenterOfMass(rV);
     _vStore->append(s.getTime(),_kin.getSize(),&_kin[0]);
 
     // ACCELERATIONS
     for(int i=0;i<_bodyIndices.getSize();i++) {
-        Body& body = bs.get(_bodyIndices[i]);
-        const SimTK::Vec3& com = body.get_mass_center();
-
+        const Body& body = bs.get(_bodyIndices[i]);
+        const SimTK::MobilizedBody& mobod = getMobilizedBody(body);
         // GET ACCELERATIONS AND ANGULAR ACCELERATIONS
-        vec = body.findStationAccelerationInGround(s, com);
-        angVec = body.getAccelerationInGround(s)[0];
+        SimTK::Vec3 vec = mobod.findStationAccelerationInGround(
+                s, body.get_mass_center());
+        SimTK::Vec3 angVec = mobod.getBodyAngularAcceleration(s);
         if(_expressInLocalFrame) {
-            vec = ground.expressVectorInAnotherFrame(s, vec, body);
-            angVec = ground.expressVectorInAnotherFrame(s, angVec, body);
-        }
-
-        // CONVERT TO DEGREES?
-        if(getInDegrees()) {
-            angVec[0] *= SimTK_RADIAN_TO_DEGREE;
-            angVec[1] *= SimTK_RADIAN_TO_DEGREE;
-            angVec[2] *= SimTK_RADIAN_TO_DEGREE;
-        }           
-
-        // FILL KINEMATICS ARRAY
-        int I = 6*i;
-        memcpy(&_kin[I],&vec[0],3*sizeof(double));
-        memcpy(&_kin[I+3],&angVec[0],3*sizeof(double));
-    }
-
-    if(_recordCenterOfMass) {
-        double rA[3] = { 0.0, 0.0, 0.0 };
-        for(int i=0;i<bs.getSize();i++) {
-            Body& body = bs.get(i);
-            const SimTK::Vec3& com = body.get_mass_center();
-            vec = body.findStationAccelerationInGround(s, com);
-            rA[0] += body.get_mass() * vec[0];
-            rA[1] += body.get_mass() * vec[1];
-            rA[2] += body.get_mass() * vec[2];
+            const SimTK::Rotation& R_GB = mobod.getBodyRotation(s);
+            vec = ~R_GB * vec;
+            angVec = ~R_GB * angVec;
         }
-
-        //COMPUTE ACCELERATION OF COM OF WHOLE BODY AND ADD TO ARRAY
-        rA[0] /= Mass;
-        rA[1] /= Mass;
-        rA[2] /= Mass;
-        int I = 6*_bodyIndices.getSize();
-        memcpy(&_kin[I],rA,3*sizeof(double));
+        fillKinematics(i, vec, angVec);
     }
-
+    fillCenterOfMass(rA);
     _aStore->append(s.getTime(),_kin.getSize(),&_kin[0]);
 
     //printf("BodyKinematics:\taT:\t%.16f\trA[1]:\t%.16f\n",s.getTime(),rA[1]);
@@ -726,4 +674,16 @@ printResults(const string &aBaseName,const string &aDir,double aDT,
     return(0);
 }
 
+//_____________________________________________________________________________
+/**
+ * Append the kinematics recorded by a copy of this analysis.
+ */
+void BodyKinematics::appendResults(Analysis& aAnalysis)
+{
+    BodyKinematics& other = dynamic_cast<BodyKinematics&>(aAnalysis);
+    appendRows(*_aStore, *other._aStore);
+    appendRows(*_vStore, *other._vStore);
+    appendRows(*_pStore, *other._pStore);
+}
+
 
@@ -133,6 +133,8 @@ public:
     int
         printResults(const std::string &aBaseName,const std::string &aDir="",
         double aDT=-1.0,const std::string &aExtension=".sto") override;
+    bool getFramesAreIndependent() const override { return true; }
+    void appendResults(Analysis& aAnalysis) override;
 
 //=============================================================================
 };  // END of class BodyKinematics
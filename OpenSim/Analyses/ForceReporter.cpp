@@ -262,23 +262,21 @@ int ForceReporter::record(const SimTK::State& s)
     StateVector nextRow(s.getTime());
 
     // Model Forces
-    auto forces = _model->getComponentList<Force>();
-
-    for(auto& force : forces) {
+    for (const Force* force : _model->getComponentsOfType<Force>()) {
         // If body force we need to record six values for torque+force
         // If muscle we record one scalar
-        if(!force.appliesForce(s)) continue;
-        Array<double> values = force.getRecordValues(s);
+        if(!force->appliesForce(s)) continue;
+        Array<double> values = force->getRecordValues(s);
         nextRow.getData().append(values);
     }
 
     if(_includeConstraintForces){
         // Model Constraints
-        auto constraints = _model->getComponentList<Constraint>();
-        for (auto& constraint : constraints) {
-            if (!constraint.isEnforced(s))
+        for (const Constraint* constraint :
+                _model->getComponentsOfType<Constraint>()) {
+            if (!constraint->isEnforced(s))
                 continue;
-            Array<double> values = constraint.getRecordValues(s);
+            Array<double> values = constraint->getRecordValues(s);
             nextRow.getData().append(values);
         }
     }
@@ -130,6 +130,7 @@ public:
     int
         printResults(const std::string &aBaseName,const std::string &aDir="",
         double aDT=-1.0,const std::string &aExtension=".sto") override;
+    bool getFramesAreIndependent() const override { return true; }
 
 //=============================================================================
 };  // END of class ForceReporter
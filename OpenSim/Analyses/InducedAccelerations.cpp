@@ -28,6 +28,7 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/ExternalForce.h>
 #include "InducedAccelerations.h"
+#include "InducedAccelerationsSolver.h"
 
 using namespace OpenSim;
 using namespace std;
@@ -485,6 +486,61 @@ void InducedAccelerations::setModel(Model &aModel)
 // ANALYSIS
 //=============================================================================
 //_____________________________________________________________________________
+void InducedAccelerations::recordAccelerations(const SimTK::State& s,
+        const SimTK::Vector& udot,
+        const SimTK::Vector_<SimTK::SpatialVec>& A_GB)
+{
+    const SimTK::SimbodyMatterSubsystem& matter = _model->getMatterSubsystem();
+
+    for(int i=0;i<_coordSet.getSize();i++) {
+        const Coordinate& coord = _coordSet.get(i);
+        double acc = matter.getMobilizedBody(coord.getBodyIndex())
+                .getOneFromUPartition(s, coord.getMobilizerQIndex(), udot);
+
+        if(getInDegrees()) 
+            acc *= SimTK_RADIAN_TO_DEGREE;  
+        _coordIndAccs[i]->append(1, &acc);
+    }
+
+    // With zero speeds, the acceleration of a station has no centripetal
+    // (or Coriolis) terms.
+    for(int i=0;i<_bodySet.getSize();i++) {
+        const Body& body = _bodySet.get(i);
+        const SimTK::SpatialVec& A = A_GB[body.getMobilizedBodyIndex()];
+        const SimTK::Vec3 r = body.getTransformInGround(s).R() *
+                body.get_mass_center();
+        SimTK::Vec3 vec = A[1] + A[0] % r;
+        SimTK::Vec3 angVec = A[0];
+
+        // CONVERT TO DEGREES?
+        if(getInDegrees()) 
+            angVec *= SimTK_RADIAN_TO_DEGREE;   
+
+        // FILL KINEMATICS ARRAY
+        _bodyIndAccs[i]->append(3, &vec[0]);
+        _bodyIndAccs[i]->append(3, &angVec[0]);
+    }
+
+    if(_includeCOM){
+        // Mass-weighted accelerations of the mass centers of the bodies (as
+        // in calcSystemMassCenterAccelerationInGround()).
+        SimTK::Vec3 vec(0);
+        double mass = 0;
+        for(SimTK::MobilizedBodyIndex mbx(1); mbx < matter.getNumBodies();
+                ++mbx) {
+            const SimTK::MobilizedBody& mobod = matter.getMobilizedBody(mbx);
+            const SimTK::MassProperties& mprops =
+                    mobod.getBodyMassProperties(s);
+            const SimTK::Vec3 r = mobod.getBodyRotation(s) *
+                    mprops.getMassCenter();
+            vec += mprops.getMass() * (A_GB[mbx][1] + A_GB[mbx][0] % r);
+            mass += mprops.getMass();
+        }
+        if(mass != 0) vec /= mass;
+        _comIndAccs.append(3, &vec[0]);
+    }
+}
+
 /**
  * Compute and record the results.
  *
@@ -539,8 +595,48 @@ int InducedAccelerations::record(const SimTK::State& s)
     //Use same conditions on constraints
     s_analysis.setTime(aT);
 
+    // The accelerations induced by the actuators are solved for all at once,
+    // reusing the factorization of the mass matrix and constraints (see
+    // InducedAccelerationsSolver::solveForActuators()), unless the constraint
+    // reactions induced by each actuator must be reported.
+    std::vector<const Actuator*> actuators;
+    std::vector<int> actuatorIndices(_contributors.getSize(), -1);
+    if(!_reportConstraintReactions){
+        for(int c=0; c< _contributors.getSize(); c++){
+            if(_contributors[c] == "total" || _contributors[c] == "gravity" ||
+                    _contributors[c] == "velocity")
+                continue;
+            int ai = _model->getActuators().getIndex(_contributors[c]);
+            if(ai<0)
+                throw Exception("InducedAcceleration: ERR- Could not find actuator '"+_contributors[c],__FILE__,__LINE__);
+            actuatorIndices[c] = (int)actuators.size();
+            actuators.push_back(&_model->getActuators().get(ai));
+        }
+    }
+    SimTK::State s_actuators;
+    std::vector<SimTK::Vector> actuatorUDots;
+    std::vector<SimTK::Vector_<SimTK::SpatialVec>> actuatorAccelerations;
+    bool actuatorsSolved = false;
+
     // Cycle through the force contributors to the system acceleration
     for(int c=0; c< _contributors.getSize(); c++){          
+        if(actuatorIndices[c] >= 0){
+            if(!actuatorsSolved){
+                // Solve on a copy so the contributors that follow start from
+                // the same conditions (e.g., constraints) as before.
+                s_actuators = s_analysis;
+                s_actuators.setQ(Q);
+                s_actuators.setZ(s.getZ());
+                InducedAccelerationsSolver::solveForActuators(*_model,
+                        s_actuators, actuators, _computePotentialsOnly,
+                        actuatorUDots, &actuatorAccelerations);
+                actuatorsSolved = true;
+            }
+            recordAccelerations(s_actuators, actuatorUDots[actuatorIndices[c]],
+                    actuatorAccelerations[actuatorIndices[c]]);
+            continue;
+        }
+
         //cout << "Solving for contributor: " << _contributors[c] << endl;
         // Need to be at the dynamics stage to disable a force
         _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Dynamics);
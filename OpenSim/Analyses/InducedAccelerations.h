@@ -208,6 +208,12 @@ public:
 protected:
     //========================== Internal Methods =============================
     int record(const SimTK::State& s);
+    /** Append the accelerations of the coordinates, bodies, and center of
+        mass given the generalized accelerations `udot` and the spatial
+        accelerations `A_GB` of the mobilized bodies at `s`, which has zero
+        speeds and is realized to Stage::Position. */
+    void recordAccelerations(const SimTK::State& s, const SimTK::Vector& udot,
+            const SimTK::Vector_<SimTK::SpatialVec>& A_GB);
     void constructDescription();
     void assembleContributors();
     Array<std::string> constructColumnLabelsForCoordinate();
@@ -26,6 +26,7 @@
 //=============================================================================
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/ExternalForce.h>
+#include <OpenSim/Simulation/Model/Muscle.h>
 #include "InducedAccelerationsSolver.h"
 
 using namespace OpenSim;
@@ -70,31 +71,9 @@ const SimTK::Vector& InducedAccelerationsSolver::solve(const SimTK::State& s,
                 SimTK::Vector_<SimTK::SpatialVec>* constraintReactions)
 {
     int nu = _modelCopy.getNumSpeeds();
-    double aT = s.getTime();
-
-    SimTK::State& s_solver = _modelCopy.updWorkingState();
-
-    //_modelCopy.initStateWithoutRecreatingSystem(s_solver);
-    // Just need to set current time and kinematics to determine state of constraints
-    s_solver.setTime(aT);
-    s_solver.updQ()=s.getQ();
-    s_solver.updU()=s.getU();
 
-    // Check the external forces and determine if contact constraints should be applied at this time
-    // and turn constraint on if it should be.
-    Array<bool> constraintOn = applyContactConstraintAccordingToExternalForces(s_solver);
-
-    // Hang on to a state that has the right flags for contact constraints turned on/off
-    _modelCopy.setPropertiesFromState(s_solver);
-    // Use this state for the remainder of this step (record)
-    s_solver = _modelCopy.getMultibodySystem().realizeTopology();
-    // DO NOT recreate the system, will lose location of constraint
-    _modelCopy.initStateWithoutRecreatingSystem(s_solver);
-
-    //cout << "Solving for contributor: " << _contributors[c] << endl;
-    // Need to be at the dynamics stage to disable a force
-    s_solver.setTime(aT);
-    _modelCopy.getMultibodySystem().realize(s_solver, SimTK::Stage::Dynamics);
+    Array<bool> constraintOn;
+    SimTK::State& s_solver = initializeSolverState(s, constraintOn);
         
     if(forceName == "total"){
         // Set gravity ON
@@ -254,6 +233,127 @@ const SimTK::Vector& InducedAccelerationsSolver::solve(const SimTK::State& s,
     return s_solver.getUDot();
 }
 
+const std::vector<SimTK::Vector>& InducedAccelerationsSolver::solve(
+        const SimTK::State& s, const std::vector<std::string>& actuatorNames,
+        bool computeActuatorPotentialOnly)
+{
+    std::vector<const Actuator*> actuators;
+    actuators.reserve(actuatorNames.size());
+    for (const auto& name : actuatorNames) {
+        const int ai = _modelCopy.getActuators().getIndex(name);
+        OPENSIM_THROW_IF_FRMOBJ(ai < 0, Exception,
+                "Actuator '{}' not found in model '{}'.", name,
+                _modelCopy.getName());
+        actuators.push_back(&_modelCopy.getActuators().get(ai));
+    }
+
+    Array<bool> constraintOn;
+    SimTK::State& s_solver = initializeSolverState(s, constraintOn);
+    s_solver.updZ() = s.getZ();
+    solveForActuators(_modelCopy, s_solver, actuators,
+            computeActuatorPotentialOnly, _actuatorUDots);
+    return _actuatorUDots;
+}
+
+void InducedAccelerationsSolver::solveForActuators(Model& model,
+        SimTK::State& s, const std::vector<const Actuator*>& actuators,
+        bool computeActuatorPotentialOnly, std::vector<SimTK::Vector>& udots,
+        std::vector<SimTK::Vector_<SimTK::SpatialVec>>* bodyAccelerations)
+{
+    const SimTK::MultibodySystem& system = model.getMultibodySystem();
+    const SimTK::SimbodyMatterSubsystem& matter = model.getMatterSubsystem();
+
+    // Need to be at the dynamics stage to disable a force
+    system.realize(s, SimTK::Stage::Dynamics);
+    model.updForceSubsystem().setForceIsDisabled(s,
+            model.getGravityForce().getForceIndex(), true);
+
+    // All the actuators apply their forces (at zero velocity), so that the
+    // forces of each actuator can be computed from the same realized state.
+    const Set<Actuator>& allActuators = model.getActuators();
+    for (int f = 0; f < allActuators.getSize(); ++f) {
+        allActuators[f].setAppliesForce(s, true);
+        const auto* actuator =
+                dynamic_cast<const ScalarActuator*>(&allActuators[f]);
+        if (actuator) {
+            const bool override = computeActuatorPotentialOnly &&
+                                  dynamic_cast<const Muscle*>(actuator);
+            actuator->overrideActuation(s, override);
+            if (override) actuator->setOverrideActuation(s, 1.0);
+        }
+    }
+    s.updU() = 0;
+    system.realize(s, SimTK::Stage::Dynamics);
+
+    // The forces other than the actuators (e.g., passive forces), which are
+    // applied along with the forces of each actuator.
+    SimTK::Vector baseMobilityForces =
+            system.getMobilityForces(s, SimTK::Stage::Dynamics);
+    SimTK::Vector_<SimTK::SpatialVec> baseBodyForces =
+            system.getRigidBodyForces(s, SimTK::Stage::Dynamics);
+    std::vector<SimTK::Vector> mobilityForces(allActuators.getSize());
+    std::vector<SimTK::Vector_<SimTK::SpatialVec>> bodyForces(
+            allActuators.getSize());
+    for (int f = 0; f < allActuators.getSize(); ++f) {
+        allActuators[f].calcForceContribution(
+                s, bodyForces[f], mobilityForces[f]);
+        baseMobilityForces -= mobilityForces[f];
+        baseBodyForces -= bodyForces[f];
+    }
+
+    // The mass matrix and constraints are factored once (when the state's
+    // articulated body inertias are realized); each actuator's accelerations
+    // are then computed in O(n).
+    udots.resize(actuators.size());
+    if (bodyAccelerations) bodyAccelerations->resize(actuators.size());
+    SimTK::Vector appliedMobilityForces;
+    SimTK::Vector_<SimTK::SpatialVec> appliedBodyForces;
+    SimTK::Vector_<SimTK::SpatialVec> A_GB;
+    for (int i = 0; i < (int)actuators.size(); ++i) {
+        const int f = allActuators.getIndex(actuators[i]);
+        OPENSIM_THROW_IF(f < 0, Exception,
+                "Actuator '{}' is not an actuator of model '{}'.",
+                actuators[i]->getName(), model.getName());
+        appliedMobilityForces = baseMobilityForces;
+        appliedMobilityForces += mobilityForces[f];
+        appliedBodyForces = baseBodyForces;
+        appliedBodyForces += bodyForces[f];
+        matter.calcAcceleration(s, appliedMobilityForces, appliedBodyForces,
+                udots[i], bodyAccelerations ? (*bodyAccelerations)[i] : A_GB);
+    }
+}
+
+SimTK::State& InducedAccelerationsSolver::initializeSolverState(
+        const SimTK::State& s, Array<bool>& constraintOn)
+{
+    double aT = s.getTime();
+
+    SimTK::State& s_solver = _modelCopy.updWorkingState();
+
+    //_modelCopy.initStateWithoutRecreatingSystem(s_solver);
+    // Just need to set current time and kinematics to determine state of constraints
+    s_solver.setTime(aT);
+    s_solver.updQ()=s.getQ();
+    s_solver.updU()=s.getU();
+
+    // Check the external forces and determine if contact constraints should be applied at this time
+    // and turn constraint on if it should be.
+    constraintOn = applyContactConstraintAccordingToExternalForces(s_solver);
+
+    // Hang on to a state that has the right flags for contact constraints turned on/off
+    _modelCopy.setPropertiesFromState(s_solver);
+    // Use this state for the remainder of this step (record)
+    s_solver = _modelCopy.getMultibodySystem().realizeTopology();
+    // DO NOT recreate the system, will lose location of constraint
+    _modelCopy.initStateWithoutRecreatingSystem(s_solver);
+
+    //cout << "Solving for contributor: " << _contributors[c] << endl;
+    // Need to be at the dynamics stage to disable a force
+    s_solver.setTime(aT);
+    _modelCopy.getMultibodySystem().realize(s_solver, SimTK::Stage::Dynamics);
+    return s_solver;
+}
+
 const SimTK::State& InducedAccelerationsSolver::
     getSolvedState(const SimTK::State& s) const
 {
@@ -30,11 +30,14 @@
 // Header to define analysis (DLL) interface
 #include "osimAnalysesDLL.h"
 
+#include <vector>
+
 namespace OpenSim { 
 
 class Model;
 class Constraint;
 class Force;
+class Actuator;
 
 //=============================================================================
 //=============================================================================
@@ -164,6 +167,39 @@ public:
                 bool computeActuatorPotentialOnly=false,
                 SimTK::Vector_<SimTK::SpatialVec>* constraintReactions=0);
 
+    /** Solve for the induced (generalized) accelerations (udot) of each of
+        the actuators identified by name, as solve() does for the name of one
+        actuator, but for all of them at once: the state is realized only
+        once, and the accelerations induced by the forces of each actuator are
+        computed by reusing the mass matrix and constraint (articulated body)
+        factorization at this state.
+        @param[in]  state           current State of the model
+        @param[in]  actuatorNames   names of Actuator%s of the model
+        @param[in]  computeActuatorPotentialOnly (see solve())
+        @return     A const reference to the induced generalized accelerations
+                    (udot) of each actuator, in the order of actuatorNames.
+    */
+    const std::vector<SimTK::Vector>& solve(const SimTK::State& state,
+                const std::vector<std::string>& actuatorNames,
+                bool computeActuatorPotentialOnly=false);
+
+    /** The induced accelerations of each of the `actuators` of `model`, each
+        acting alone with zero speeds and without gravity, for all the
+        actuators at once (see the solve() above). This is for callers that
+        prepare `model` and `state` themselves (e.g., with contact constraints
+        enforced), like the InducedAccelerations analysis. `state` must hold
+        the time, coordinates, and auxiliary states of interest; its speeds
+        are set to zero, gravity and the actuators' override actuations are
+        set as needed, and it is left realized to Stage::Dynamics. Optionally,
+        the spatial accelerations of the mobilized bodies (in ground, indexed
+        by SimTK::MobilizedBodyIndex) are returned in `bodyAccelerations`. */
+    static void solveForActuators(Model& model, SimTK::State& state,
+            const std::vector<const Actuator*>& actuators,
+            bool computeActuatorPotentialOnly,
+            std::vector<SimTK::Vector>& udots,
+            std::vector<SimTK::Vector_<SimTK::SpatialVec>>*
+                    bodyAccelerations = nullptr);
+
 
 //----------------------------------------------------------------------------
 /** Convenience coordinate, body, or center of mass acceleration access after
@@ -188,11 +224,18 @@ protected:
 
     Array<bool> applyContactConstraintAccordingToExternalForces(SimTK::State &s);
 
+    /** Set the time and kinematics of `s` in the solver's working state,
+        enforce the contact constraints that replace external forces at this
+        time, and realize the working state to Stage::Dynamics. */
+    SimTK::State& initializeSolverState(const SimTK::State& s,
+            Array<bool>& constraintOn);
+
 private:
     double _forceThreshold;
     Set<Force> _forcesToReplace;
     Set<Constraint> _replacementConstraints; 
     Model _modelCopy;
+    std::vector<SimTK::Vector> _actuatorUDots;
 
 //=============================================================================
 }; // END of class InducedAccelerationsSolver
@@ -27,12 +27,32 @@
 //=============================================================================
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/Actuator.h>
+#include <OpenSim/Common/CommonUtilities.h>
 #include "JointReaction.h"
 
+#include <algorithm>
+#include <memory>
+
 using namespace OpenSim;
 using namespace std;
 using namespace SimTK;
 
+namespace {
+    // Give `table` the rows at `times` and the columns `labels`, keeping its
+    // matrix if it already has them.
+    template <typename T>
+    void prepareTable(TimeSeriesTable_<T>& table,
+            const std::vector<double>& times,
+            const std::vector<std::string>& labels) {
+        if(table.getIndependentColumn() == times &&
+                table.getColumnLabels() == labels)
+            return;
+        table = TimeSeriesTable_<T>(times,
+                SimTK::Matrix_<T>((int)times.size(), (int)labels.size()),
+                labels);
+    }
+}
+
 
 //=============================================================================
 // CONSTANTS
@@ -551,89 +571,234 @@ record(const SimTK::State& s)
 
     _model->updMultibodySystem().realize(s_analysis, s.getSystemStage());
     if(_useForceStorage){
-        const auto& actuatorSet = _model->getActuators();
-        int nA = actuatorSet.getSize();
-        Array<double> forces(0,nA);
-        _storeActuation->getDataAtTime(s.getTime(),nA,forces);
-        int storageIndex = -1;
-        for(int actuatorIndex=0;actuatorIndex<nA;actuatorIndex++)
-        {
-            //Actuator* act = dynamic_cast<Actuator*>(&_forceSet->get(actuatorIndex));
-            std::string actuatorName = actuatorSet.get(actuatorIndex).getName();
-            storageIndex = _storeActuation->getStateIndex(actuatorName, 0);
-            if(storageIndex == -1){
-                log_warn("The actuator '{}' was not found in the forces file.",
-                        actuatorName);
-                break;
-            }
-            const ScalarActuator* act = dynamic_cast<const ScalarActuator*>(&actuatorSet[actuatorIndex]);
-            if (act){
-                act->overrideActuation(s_analysis, true);
-                act->setOverrideActuation(s_analysis, forces[storageIndex]);
-            }
-        }
+        applyOverrideActuations(*_model, s_analysis,
+                getOverrideActuations(s.getTime()));
     }
-    // VARIABLES
-    const Ground& ground = _model->getGround();
 
     _model->realizeAcceleration(s_analysis);
 
     /* retrieved desired joint reactions, convert to desired bodies, and convert
     *  to desired reference frames*/
     int numOutputJoints = _reactionList.getSize();
-    Vector_<Vec3> forcesVec(numOutputJoints), momentsVec(numOutputJoints), pointsVec(numOutputJoints);
-    for(int i=0; i<numOutputJoints; i++) {
-        JointReactionKey currentKey = _reactionList[i];
+    Vector_<SpatialVec> loadsVec;
+    Vector_<Vec3> pointsVec;
+    calcReactionLoads(*_model, s_analysis, _reactionList, loadsVec, pointsVec);
+
+    /* fill out row construction array*/
+    for(int i=0;i<numOutputJoints;i++) {
+        int I = 9*i;
+        for(int j=0;j<3;j++) {
+            _Loads[I+j] = loadsVec[i][1][j];
+            _Loads[I+j+3] = loadsVec[i][0][j];
+            _Loads[I+j+6] = pointsVec[i][j];
+        }
+    }
+    /* Write the reaction data to storage*/
+    _storeReactionLoads.append(s.getTime(),_Loads.getSize(),&_Loads[0]);
+
+    return 0;
+}
+//_____________________________________________________________________________
+/**
+ * The actuation from the forces file at the given time of each actuator, in
+ * the order of the model's actuators. As before, the actuators after the first
+ * one that is missing from the forces file are not overridden.
+ */
+SimTK::Vector JointReaction::getOverrideActuations(double time) const
+{
+    const auto& actuatorSet = _model->getActuators();
+    int nA = actuatorSet.getSize();
+    SimTK::Vector actuations(nA, SimTK::NaN);
+    Array<double> forces(0,nA);
+    _storeActuation->getDataAtTime(time,nA,forces);
+    for(int actuatorIndex=0;actuatorIndex<nA;actuatorIndex++)
+    {
+        std::string actuatorName = actuatorSet.get(actuatorIndex).getName();
+        int storageIndex = _storeActuation->getStateIndex(actuatorName, 0);
+        if(storageIndex == -1){
+            log_warn("The actuator '{}' was not found in the forces file.",
+                    actuatorName);
+            break;
+        }
+        actuations[actuatorIndex] = forces[storageIndex];
+    }
+    return actuations;
+}
+
+void JointReaction::applyOverrideActuations(const Model& model,
+        SimTK::State& s, const SimTK::Vector& actuations)
+{
+    const auto& actuatorSet = model.getActuators();
+    for(int actuatorIndex=0;actuatorIndex<actuatorSet.getSize();actuatorIndex++)
+    {
+        if(SimTK::isNaN(actuations[actuatorIndex])) continue;
+        const ScalarActuator* act = dynamic_cast<const ScalarActuator*>(&actuatorSet[actuatorIndex]);
+        if (act){
+            act->overrideActuation(s, true);
+            act->setOverrideActuation(s, actuations[actuatorIndex]);
+        }
+    }
+}
+
+//_____________________________________________________________________________
+/**
+ * Compute the reaction loads (moment, force) and their points of application
+ * for the given keys, expressed in the requested frames.
+ */
+void JointReaction::calcReactionLoads(const Model& model,
+        const SimTK::State& s, const Array<JointReactionKey>& keys,
+        SimTK::Vector_<SimTK::SpatialVec>& loads,
+        SimTK::Vector_<SimTK::Vec3>& points)
+{
+    loads.resize(keys.getSize());
+    points.resize(keys.getSize());
+
+    // The reactions on the mobilized bodies at the origins of their M frames,
+    // expressed in ground, for all mobilizers at once (asking each mobilized
+    // body for its reaction would compute all of them for each joint). The
+    // model caches them, so that other reactions of this state reuse them.
+    const Vector_<SpatialVec>& reactionsOnBodiesAtM =
+            model.getMobilizerReactionForces(s);
+
+    for(int i=0; i<keys.getSize(); i++) {
+        const JointReactionKey& currentKey = keys[i];
         const Joint& joint = *currentKey.joint;
-        const Frame& expressedInBody = *currentKey.expressedInFrame;
+        const MobilizedBody& mobod = joint.getChildFrame().getMobilizedBody();
+        const SpatialVec& reactionOnChild =
+                reactionsOnBodiesAtM[mobod.getMobilizedBodyIndex()];
         SpatialVec jointReaction;
-        Vec3 pointOfApplication;
-        
+        Vec3 locationInGround;
+
         // check if the load requested is on the parent or child
         if(!currentKey.isAppliedOnChild){
-            jointReaction = joint.calcReactionOnParentExpressedInGround(s_analysis);
-
-            // find the point of application in immediate parent frame, then
-            // transform to the base frame of the parent (expressedInBody)
-            Vec3 parentLocationInGlobal = joint.getParentFrame().getTransformInGround(s_analysis).p();
-            pointOfApplication = 
-                ground.findStationLocationInAnotherFrame(s_analysis, parentLocationInGlobal, expressedInBody);
+            // The reaction on the parent is equal and opposite, at the origin
+            // of the F frame (as in findMobilizerReactionOnParentAtFInGround()).
+            const Transform X_GF = mobod.getParentMobilizedBody()
+                    .getBodyTransform(s) * mobod.getInboardFrame(s);
+            const Transform X_GM =
+                    mobod.getBodyTransform(s) * mobod.getOutboardFrame(s);
+            jointReaction = -shiftForceBy(reactionOnChild, X_GF.p() - X_GM.p());
+            locationInGround = joint.getParentFrame().getTransformInGround(s).p();
         }
         else{
-            jointReaction = joint.calcReactionOnChildExpressedInGround(s_analysis);
-
-            // find the point of application in immediate child frame, then
-            // transform to the base frame of the child (expressedInBody)
-            Vec3 childLocationInGlobal = joint.getChildFrame().getTransformInGround(s_analysis).p();
-            pointOfApplication =
-                ground.findStationLocationInAnotherFrame(s_analysis, childLocationInGlobal, expressedInBody);
+            jointReaction = reactionOnChild;
+            locationInGround = joint.getChildFrame().getTransformInGround(s).p();
         }
 
-        // transform SpatialVec of reaction forces and moments to the
-        // requested base frame (expressedInBody)
-        Vec3 force = ground.expressVectorInAnotherFrame(s_analysis, jointReaction[1], expressedInBody);
-        Vec3 moment = ground.expressVectorInAnotherFrame(s_analysis, jointReaction[0], expressedInBody);
+        // transform SpatialVec of reaction forces and moments and the point
+        // of application to the requested base frame (expressedInBody)
+        const Transform& X_GB =
+                currentKey.expressedInFrame->getTransformInGround(s);
+        const Rotation R_BG = ~X_GB.R();
+        loads[i] = SpatialVec(R_BG * jointReaction[0], R_BG * jointReaction[1]);
+        points[i] = ~X_GB * locationInGround;
+    }
+}
+
+//_____________________________________________________________________________
+/**
+ * Compute the reaction loads at each row of a states table, on copies of the
+ * model on multiple threads.
+ */
+void JointReaction::computeReactionLoads(const TimeSeriesTable& statesTable,
+        TimeSeriesTable_<SimTK::SpatialVec>& reactionLoads,
+        TimeSeriesTable_<SimTK::Vec3>* pointsOfApplication, int numThreads)
+{
+    OPENSIM_THROW_IF_FRMOBJ(_model == nullptr, Exception,
+            "A model must be set before computing reaction loads.");
+    if(!(_forcesFileName == "")) loadForcesFromFile();
 
-        /* place results in the truncated loads vectors*/
-        forcesVec[i] = force;
-        momentsVec[i] = moment;
-        pointsVec[i] = pointOfApplication;
+    const std::vector<double>& times = statesTable.getIndependentColumn();
+    const int numRows = (int)times.size();
+    const int numReactions = _reactionList.getSize();
+    std::vector<std::string> labels;
+    for(int i=0; i<numReactions; ++i) {
+        labels.push_back(_reactionList[i].joint->getName() + "_on_" +
+                _reactionList[i].appliedOnBody->getName() + "_in_" +
+                _reactionList[i].expressedInFrame->getName());
+    }
+    // Allocate the results once, so the rows can be filled in any order.
+    prepareTable(reactionLoads, times, labels);
+    if(pointsOfApplication) prepareTable(*pointsOfApplication, times, labels);
+    if(numRows == 0) return;
+
+    std::vector<SimTK::Vector> overrideActuations;
+    if(_useForceStorage) {
+        // Storage lookups are not thread-safe.
+        for(int r=0; r<numRows; ++r)
+            overrideActuations.push_back(getOverrideActuations(times[r]));
     }
 
-    /* fill out row construction array*/
-    for(int i=0;i<numOutputJoints;i++) {
-        int I = 9*i;
-        for(int j=0;j<3;j++) {
-            _Loads[I+j] = forcesVec[i][j];
-            _Loads[I+j+3] = momentsVec[i][j];
-            _Loads[I+j+6] = pointsVec[i][j];
+    // The models are copied on the calling thread; their Systems are built on
+    // the threads that use them.
+    struct Worker {
+        Model model;
+        bool hasSystem = false;
+        SimTK::State state;
+        Array<JointReactionKey> keys;
+        std::vector<int> stateColumns;
+        SimTK::Vector values;
+        Vector_<SpatialVec> loads;
+        Vector_<Vec3> points;
+        explicit Worker(const Model& m) : model(m) {}
+    };
+    numThreads = std::min(getNumThreadsOrDefault(numThreads), numRows);
+    std::vector<std::unique_ptr<Worker>> workers(numThreads);
+    for(auto& worker : workers) worker.reset(new Worker(*_model));
+
+    auto& loads = reactionLoads.updMatrix();
+    auto* points = pointsOfApplication ?
+            &pointsOfApplication->updMatrix() : nullptr;
+    parallelForEach(numRows, numThreads, [&](int thread, int row) {
+        Worker& worker = *workers[thread];
+        Model& model = worker.model;
+        if(!worker.hasSystem) {
+            worker.state = model.initSystem();
+            // The joints and frames of this copy of the model.
+            for(int i=0; i<numReactions; ++i) {
+                JointReactionKey key = _reactionList[i];
+                key.joint = &model.getComponent<Joint>(
+                        key.joint->getAbsolutePathString());
+                key.appliedOnBody = &model.getComponent<Frame>(
+                        key.appliedOnBody->getAbsolutePathString());
+                key.expressedInFrame = &model.getComponent<Frame>(
+                        key.expressedInFrame->getAbsolutePathString());
+                worker.keys.append(key);
+            }
+            const Array<std::string> names = model.getStateVariableNames();
+            worker.stateColumns.resize(names.getSize(), -1);
+            for(int i=0; i<names.getSize(); ++i) {
+                if(statesTable.hasColumn(names[i]))
+                    worker.stateColumns[i] =
+                            (int)statesTable.getColumnIndex(names[i]);
+            }
+            worker.values = model.getStateVariableValues(worker.state);
+            worker.hasSystem = true;
         }
-    }
-    /* Write the reaction data to storage*/
-    _storeReactionLoads.append(s.getTime(),_Loads.getSize(),&_Loads[0]);
 
-    return 0;
+        SimTK::State& state = worker.state;
+        const auto statesRow = statesTable.getRowAtIndex(row);
+        for(int i=0; i<(int)worker.stateColumns.size(); ++i) {
+            if(worker.stateColumns[i] >= 0)
+                worker.values[i] = statesRow[worker.stateColumns[i]];
+        }
+        state.setTime(times[row]);
+        model.setStateVariableValues(state, worker.values);
+        if(_useForceStorage) {
+            applyOverrideActuations(model, state, overrideActuations[row]);
+        }
+        model.realizeAcceleration(state);
+
+        calcReactionLoads(model, state, worker.keys, worker.loads,
+                worker.points);
+        for(int i=0; i<numReactions; ++i) loads(row, i) = worker.loads[i];
+        if(points) {
+            for(int i=0; i<numReactions; ++i)
+                (*points)(row, i) = worker.points[i];
+        }
+    });
 }
+
 //_____________________________________________________________________________
 /**
  * This method is called at the beginning of an analysis so that any
@@ -735,4 +900,14 @@ printResults(const string &aBaseName,const string &aDir,double aDT,
     return(0);
 }
 
+//_____________________________________________________________________________
+/**
+ * Append the reaction loads recorded by a copy of this analysis.
+ */
+void JointReaction::appendResults(Analysis& aAnalysis)
+{
+    JointReaction& other = dynamic_cast<JointReaction&>(aAnalysis);
+    appendRows(_storeReactionLoads, other._storeReactionLoads);
+}
+
 
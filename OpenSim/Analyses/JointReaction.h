@@ -29,6 +29,7 @@
 //=============================================================================
 #include <OpenSim/Common/PropertyStr.h>
 #include <OpenSim/Common/PropertyStrArray.h>
+#include <OpenSim/Common/TimeSeriesTable.h>
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include "osimAnalysesDLL.h"
 
@@ -198,6 +199,31 @@ public:
     int
         printResults(const std::string &aBaseName,const std::string &aDir="",
         double aDT=-1.0,const std::string &aExtension=".sto") override;
+    bool getFramesAreIndependent() const override { return true; }
+    void appendResults(Analysis& aAnalysis) override;
+
+    //-------------------------------------------------------------------------
+    // BATCH
+    //-------------------------------------------------------------------------
+    /** Compute the reaction loads of the joints of this analysis at each row
+    of `statesTable`, whose columns are the paths of the state variables of
+    the model (e.g., as written by StatesTrajectory::exportToTable()); state
+    variables without a column keep their default values. As in record(),
+    the actuation of the actuators is taken from the forces file if one is
+    given. The model must have been set (see setModel()).
+
+    `reactionLoads` gets a row for each row of `statesTable` and a column for
+    each reaction (labeled <joint>_on_<body>_in_<frame>), whose elements are
+    the (moment, force) SpatialVec%s expressed in the requested frames. If
+    `pointsOfApplication` is given, it gets the points of application
+    expressed in the same frames. A table that already has the right shape
+    is refilled in place; otherwise it is allocated once, with all its rows.
+    The rows are computed on `numThreads` threads (see
+    getNumThreadsOrDefault()), each with its own copy of the model. */
+    void computeReactionLoads(const TimeSeriesTable& statesTable,
+            TimeSeriesTable_<SimTK::SpatialVec>& reactionLoads,
+            TimeSeriesTable_<SimTK::Vec3>* pointsOfApplication = nullptr,
+            int numThreads = -1);
 
 
 protected:
@@ -208,6 +234,20 @@ protected:
     void constructColumnLabels();
     void setupStorage();
     void loadForcesFromFile();
+    /** The actuation of each actuator of the model that is overridden with
+    the forces file at `time`, and NaN for the others. */
+    SimTK::Vector getOverrideActuations(double time) const;
+    /** Override the actuation of the ScalarActuator%s of `model` with the
+    (non-NaN) `actuations` from getOverrideActuations(). */
+    static void applyOverrideActuations(const Model& model, SimTK::State& s,
+            const SimTK::Vector& actuations);
+    /** The reaction load (moment, force) and point of application of each of
+    the `keys` (for joints of `model`) at `s`, which must be realized to
+    Stage::Acceleration. The reactions of all mobilizers are computed once. */
+    static void calcReactionLoads(const Model& model, const SimTK::State& s,
+            const Array<JointReactionKey>& keys,
+            SimTK::Vector_<SimTK::SpatialVec>& loads,
+            SimTK::Vector_<SimTK::Vec3>& points);
 
 //=============================================================================
 }; // END of class JointReaction
@@ -116,6 +116,7 @@ public:
     int
         printResults(const std::string &aBaseName,const std::string &aDir="",
         double aDT=-1.0,const std::string &aExtension=".sto") override;
+    bool getFramesAreIndependent() const override { return true; }
 
 //=============================================================================
 };  // END of class Kinematics
@@ -28,15 +28,30 @@
 //=============================================================================
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/MovingPathPoint.h>
+#include <OpenSim/Simulation/Wrap/PathWrap.h>
 #include "MuscleAnalysis.h"
 
+#include <algorithm>
+#include <numeric>
+
 using namespace OpenSim;
 using namespace std;
 
-
 //=============================================================================
 // CONSTANTS
 //=============================================================================
+namespace {
+// The quantities of the analysis (the names of their storages).
+const std::vector<std::string> quantityNames{"MomentArm", "Moment",
+        "PennationAngle", "Length", "FiberLength", "NormalizedFiberLength",
+        "TendonLength", "FiberVelocity", "NormFiberVelocity",
+        "PennationAngularVelocity", "TendonForce", "FiberForce",
+        "ActiveFiberForce", "PassiveFiberForce",
+        "ActiveFiberForceAlongTendon", "PassiveFiberForceAlongTendon",
+        "FiberActivePower", "FiberPassivePower", "TendonPower",
+        "MuscleActuatorPower"};
+}
 
 
 //=============================================================================
@@ -141,6 +156,8 @@ void MuscleAnalysis::setNull()
     _muscleListProp.getValueStrArray().updElt(0) = "all";
     _coordinateListProp.getValueStrArray().setSize(1);
     _coordinateListProp.getValueStrArray().updElt(0) = "all";
+    _quantityListProp.getValueStrArray().setSize(1);
+    _quantityListProp.getValueStrArray().updElt(0) = "all";
     setComputeMoments(true);
 }
 //_____________________________________________________________________________
@@ -165,6 +182,12 @@ void MuscleAnalysis::setupProperties()
     _computeMomentsProp.setName("compute_moments");
     _propertySet.append( &_computeMomentsProp );
 
+    _quantityListProp.setComment("List of quantities to compute and store "
+        "(e.g., FiberLength TendonForce MomentArm Moment). Use 'all' to "
+        "compute all quantities.");
+    _quantityListProp.setName("quantity_list");
+    _propertySet.append( &_quantityListProp );
+
 }
 //-----------------------------------------------------------------------------
 // DESCRIPTION
@@ -203,9 +226,33 @@ void MuscleAnalysis::allocateStorageObjects()
     _momentArmStorageArray.setSize(0);
     _muscleArray.setMemoryOwner(false);
     _muscleArray.setSize(0);
+    // The spanned coordinates are found again for the new arrays.
+    _maSolver.reset();
+
+    // QUANTITIES
+    _quantityList = _quantityListProp.getValueStrArray();
+    if (_quantityList.getSize() == 1 &&
+            IO::Lowercase(_quantityList[0]) == "all") {
+        _quantityList.setSize(0);
+        for (const auto& name : quantityNames) _quantityList.append(name);
+    } else {
+        int i = 0;
+        while (i < _quantityList.getSize()) {
+            if (std::find(quantityNames.begin(), quantityNames.end(),
+                        _quantityList[i]) == quantityNames.end()) {
+                log_warn("MuscleAnalysis: quantity {} is not supported.",
+                        _quantityList[i]);
+                _quantityList.remove(i);
+            } else {
+                ++i;
+            }
+        }
+    }
 
     // FOR MOMENT ARMS AND MOMENTS
-    if(getComputeMoments()) {
+    const bool computeMomentArms = _quantityList.findIndex("MomentArm") >= 0;
+    const bool computeMoments = _quantityList.findIndex("Moment") >= 0;
+    if(getComputeMoments() && (computeMomentArms || computeMoments)) {
         const CoordinateSet& qSet = _model->getCoordinateSet();
         _coordinateList = _coordinateListProp.getValueStrArray();
 
@@ -231,112 +278,48 @@ void MuscleAnalysis::allocateStorageObjects()
             }
         }
 
+        // POPULATE ACTIVE MOMENT ARM ARRAY (the moment arm storages first,
+        // then the moment storages, in the storage list)
         int nq = _coordinateList.getSize();
-        Storage* store;
-        for(int i=0;i<nq;i++) {
-            string name = "MomentArm_" + _coordinateList[i];
-            store = new Storage(1000,name);
-            store->setDescription(getDescription());
-            _storageList.append(store);
-        }
-        for(int i=0;i<nq;i++) {
-            string name = "Moment_" + _coordinateList[i];
-            store = new Storage(1000,name);
-            store->setDescription(getDescription());
-            _storageList.append(store);
+        for(int i=0; i<nq; i++) {
+            StorageCoordinatePair *pair = new StorageCoordinatePair();
+            pair->q = &qSet[qSet.getIndex(_coordinateList[i])];
+            pair->momentArmStore = createStorage(
+                    "MomentArm_" + _coordinateList[i]);
+            pair->momentStore = NULL;
+            _momentArmStorageArray.append(pair);
         }
-
-        // POPULATE ACTIVE MOMENT ARM ARRAY
-        _momentArmStorageArray.setSize(0);
-
         for(int i=0; i<nq; i++) {
-            int found = qSet.getIndex(_coordinateList[i]);
-            if(found >=0){
-                StorageCoordinatePair *pair = new StorageCoordinatePair();
-                pair->q = &qSet[found];
-                pair->momentArmStore = _storageList[i];
-                pair->momentStore = _storageList[i+nq];
-                _momentArmStorageArray.append(pair);
-            }
+            _momentArmStorageArray[i]->momentStore = createStorage(
+                    "Moment_" + _coordinateList[i]);
         }
     }
 
     // EVERYTHING ELSE
-    //_storageList.setMemoryOwner(false);
-    _pennationAngleStore = new Storage(1000,"PennationAngle");
-    _pennationAngleStore->setDescription(getDescription());
-    _storageList.append(_pennationAngleStore );
-
-    _lengthStore = new Storage(1000,"Length");
-    _lengthStore->setDescription(getDescription());
-    _storageList.append(_lengthStore );
-
-    _fiberLengthStore = new Storage(1000,"FiberLength");
-    _fiberLengthStore->setDescription(getDescription());
-    _storageList.append(_fiberLengthStore );
-
-    _normalizedFiberLengthStore = new Storage(1000,"NormalizedFiberLength");
-    _normalizedFiberLengthStore->setDescription(getDescription());
-    _storageList.append(_normalizedFiberLengthStore );
-
-    _tendonLengthStore = new Storage(1000,"TendonLength");
-    _tendonLengthStore->setDescription(getDescription());
-    _storageList.append(_tendonLengthStore );
-
-    _fiberVelocityStore = new Storage(1000,"FiberVelocity");
-    _fiberVelocityStore->setDescription(getDescription());
-    _storageList.append(_fiberVelocityStore );
-
-    _normFiberVelocityStore = new Storage(1000,"NormFiberVelocity");
-    _normFiberVelocityStore->setDescription(getDescription());
-    _storageList.append(_normFiberVelocityStore );
-
-    _pennationAngularVelocityStore = new Storage(1000,
-        "PennationAngularVelocity");
-    _pennationAngularVelocityStore->setDescription(getDescription());
-    _storageList.append(_pennationAngularVelocityStore );
-
-    _forceStore = new Storage(1000,"TendonForce");
-    _forceStore->setDescription(getDescription());
-    _storageList.append(_forceStore );
-
-    _fiberForceStore = new Storage(1000,"FiberForce");
-    _fiberForceStore->setDescription(getDescription());
-    _storageList.append(_fiberForceStore );
-
-    _activeFiberForceStore = new Storage(1000,"ActiveFiberForce");
-    _activeFiberForceStore->setDescription(getDescription());
-    _storageList.append(_activeFiberForceStore );
-
-    _passiveFiberForceStore = new Storage(1000,"PassiveFiberForce");
-    _passiveFiberForceStore->setDescription(getDescription());
-    _storageList.append(_passiveFiberForceStore );
-
-    _activeFiberForceAlongTendonStore = new Storage(1000,
-        "ActiveFiberForceAlongTendon");
-    _activeFiberForceAlongTendonStore->setDescription(getDescription());
-    _storageList.append(_activeFiberForceAlongTendonStore );
-
-    _passiveFiberForceAlongTendonStore = new Storage(1000,
-        "PassiveFiberForceAlongTendon");
-    _passiveFiberForceAlongTendonStore->setDescription(getDescription());
-    _storageList.append(_passiveFiberForceAlongTendonStore );
-
-    _fiberActivePowerStore = new Storage(1000,"FiberActivePower");
-    _fiberActivePowerStore->setDescription(getDescription());
-    _storageList.append(_fiberActivePowerStore );
-
-    _fiberPassivePowerStore = new Storage(1000,"FiberPassivePower");
-    _fiberPassivePowerStore->setDescription(getDescription());
-    _storageList.append(_fiberPassivePowerStore );
-
-    _tendonPowerStore = new Storage(1000,"TendonPower");
-    _tendonPowerStore->setDescription(getDescription());
-    _storageList.append(_tendonPowerStore );
-
-    _musclePowerStore = new Storage(1000,"MuscleActuatorPower");
-    _musclePowerStore->setDescription(getDescription());
-    _storageList.append(_musclePowerStore );
+    _pennationAngleStore = createStorage("PennationAngle");
+    _lengthStore = createStorage("Length");
+    _fiberLengthStore = createStorage("FiberLength");
+    _normalizedFiberLengthStore = createStorage("NormalizedFiberLength");
+    _tendonLengthStore = createStorage("TendonLength");
+
+    _fiberVelocityStore = createStorage("FiberVelocity");
+    _normFiberVelocityStore = createStorage("NormFiberVelocity");
+    _pennationAngularVelocityStore =
+            createStorage("PennationAngularVelocity");
+
+    _forceStore = createStorage("TendonForce");
+    _fiberForceStore = createStorage("FiberForce");
+    _activeFiberForceStore = createStorage("ActiveFiberForce");
+    _passiveFiberForceStore = createStorage("PassiveFiberForce");
+    _activeFiberForceAlongTendonStore =
+            createStorage("ActiveFiberForceAlongTendon");
+    _passiveFiberForceAlongTendonStore =
+            createStorage("PassiveFiberForceAlongTendon");
+
+    _fiberActivePowerStore = createStorage("FiberActivePower");
+    _fiberPassivePowerStore = createStorage("FiberPassivePower");
+    _tendonPowerStore = createStorage("TendonPower");
+    _musclePowerStore = createStorage("MuscleActuatorPower");
 
     // POPULATE MUSCLE LIST FOR "all"
     ForceSet& fSet = _model->updForceSet();
@@ -377,6 +360,132 @@ void MuscleAnalysis::allocateStorageObjects()
     }
 }
 
+//_____________________________________________________________________________
+/**
+ * Create the storage of a quantity, if the quantity is in the list of
+ * quantities (moment arms and moments are named by their quantity followed by
+ * the coordinate, e.g., MomentArm_knee_angle_r).
+ */
+Storage* MuscleAnalysis::createStorage(const std::string& name)
+{
+    const std::string quantity = name.substr(0, name.find('_'));
+    if (_quantityList.findIndex(quantity) < 0) return nullptr;
+    Storage* store = new Storage(1000, name);
+    store->setDescription(getDescription());
+    _storageList.append(store);
+    return store;
+}
+
+//_____________________________________________________________________________
+/**
+ * Find the coordinates that can change the length of the path of each active
+ * muscle with a GeometryPath. A tension in the path applies forces only to the
+ * bodies of its path points and wrap objects, and these forces sum to zero
+ * (the tension is internal to the path), so the generalized force that a
+ * tension applies to the mobilizer of a body (and so the moment arm about its
+ * coordinates) is zero unless some, but not all, of these bodies are the body
+ * or its descendants. Constraints couple the mobilizers that they constrain
+ * (and, for the constraints on bodies, the mobilizers between the bodies and
+ * ground), so a coordinate is spanned if any mobilizer coupled to its own is
+ * spanned. Paths with moving path points (whose locations depend on
+ * coordinates) span all coordinates.
+ */
+void MuscleAnalysis::findSpannedCoordinates(const SimTK::State& s)
+{
+    const SimTK::SimbodyMatterSubsystem& matter =
+            _model->getMatterSubsystem();
+    const int nb = matter.getNumBodies();
+    const auto getParent = [&](SimTK::MobilizedBodyIndex mbx) {
+        return matter.getMobilizedBody(mbx).getParentMobilizedBody()
+                .getMobilizedBodyIndex();
+    };
+
+    // Group the mobilizers that are coupled by the enabled constraints.
+    std::vector<int> group(nb);
+    std::iota(group.begin(), group.end(), 0);
+    const auto findGroup = [&](int mbx) {
+        while (group[mbx] != mbx) mbx = group[mbx] = group[group[mbx]];
+        return mbx;
+    };
+    for (SimTK::ConstraintIndex cx(0); cx < matter.getNumConstraints();
+            ++cx) {
+        const SimTK::Constraint& constraint = matter.getConstraint(cx);
+        if (constraint.isDisabled(s)) continue;
+        std::vector<SimTK::MobilizedBodyIndex> coupled;
+        for (SimTK::ConstrainedMobilizerIndex cmx(0);
+                cmx < constraint.getNumConstrainedMobilizers(); ++cmx) {
+            coupled.push_back(constraint
+                    .getMobilizedBodyFromConstrainedMobilizer(cmx)
+                    .getMobilizedBodyIndex());
+        }
+        for (SimTK::ConstrainedBodyIndex cbx(0);
+                cbx < constraint.getNumConstrainedBodies(); ++cbx) {
+            for (SimTK::MobilizedBodyIndex mbx =
+                            constraint.getMobilizedBodyFromConstrainedBody(cbx)
+                                    .getMobilizedBodyIndex();
+                    mbx != SimTK::GroundIndex; mbx = getParent(mbx)) {
+                coupled.push_back(mbx);
+            }
+        }
+        for (const auto& mbx : coupled) {
+            group[findGroup(mbx)] = findGroup(coupled.front());
+        }
+    }
+
+    const int nq = _momentArmStorageArray.getSize();
+    _spannedCoordinates.clear();
+    for (int j = 0; j < _muscleArray.getSize(); ++j) {
+        const auto* path = _muscleArray[j]->tryGetPath<GeometryPath>();
+        if (!path) continue;
+
+        // The bodies to which a tension in the path applies forces.
+        std::vector<SimTK::MobilizedBodyIndex> bodies;
+        bool spansAll = false;
+        const PathPointSet& points = path->getPathPointSet();
+        for (int i = 0; i < points.getSize(); ++i) {
+            if (dynamic_cast<const MovingPathPoint*>(&points.get(i))) {
+                spansAll = true;
+            }
+            bodies.push_back(
+                    points.get(i).getParentFrame().getMobilizedBodyIndex());
+        }
+        const PathWrapSet& wraps = path->getWrapSet();
+        for (int i = 0; i < wraps.getSize(); ++i) {
+            const WrapObject* wrapObject = wraps.get(i).getWrapObject();
+            if (wrapObject) {
+                bodies.push_back(
+                        wrapObject->getFrame().getMobilizedBodyIndex());
+            } else {
+                spansAll = true;
+            }
+        }
+        std::sort(bodies.begin(), bodies.end());
+        bodies.erase(std::unique(bodies.begin(), bodies.end()), bodies.end());
+
+        // The number of the bodies that are each body or its descendants.
+        std::vector<int> numDescendants(nb, 0);
+        for (const auto& body : bodies) {
+            for (SimTK::MobilizedBodyIndex mbx = body;
+                    mbx != SimTK::GroundIndex; mbx = getParent(mbx)) {
+                ++numDescendants[mbx];
+            }
+        }
+        std::vector<bool> spannedGroups(nb, false);
+        for (int mbx = 0; mbx < nb; ++mbx) {
+            if (numDescendants[mbx] > 0 &&
+                    numDescendants[mbx] < (int)bodies.size()) {
+                spannedGroups[findGroup(mbx)] = true;
+            }
+        }
+        std::vector<bool> spanned(nq, true);
+        for (int i = 0; i < nq && !spansAll; ++i) {
+            spanned[i] = spannedGroups[findGroup(
+                    _momentArmStorageArray[i]->q->getBodyIndex())];
+        }
+        _spannedCoordinates.push_back(spanned);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // COLUMN LABELS
 //-----------------------------------------------------------------------------
@@ -409,6 +518,7 @@ MuscleAnalysis& MuscleAnalysis::operator=(const MuscleAnalysis &aAnalysis)
     _muscleListProp = aAnalysis._muscleListProp;
     _coordinateListProp = aAnalysis._coordinateListProp;
     _computeMomentsProp = aAnalysis._computeMomentsProp;
+    _quantityListProp = aAnalysis._quantityListProp;
     allocateStorageObjects();
 
     return (*this);
@@ -459,6 +569,20 @@ setCoordinates(OpenSim::Array<std::string>& aCoordinates)
         _coordinateListProp.getValueStrArray().updElt(i) = aCoordinates[i];
     }
 }
+//_____________________________________________________________________________
+/**
+ * Set the list of quantities to compute and store.
+ *
+ * @param aQuantities Array of the names of the quantities.
+ */
+void MuscleAnalysis::setQuantities(OpenSim::Array<std::string>& aQuantities)
+{
+    int size = aQuantities.getSize();
+    _quantityListProp.getValueStrArray().setSize(size);
+    for(int i=0; i<size; i++){
+        _quantityListProp.getValueStrArray().updElt(i) = aQuantities[i];
+    }
+}
 //-----------------------------------------------------------------------------
 // STORAGE CAPACITY
 //-----------------------------------------------------------------------------
@@ -503,6 +627,24 @@ int MuscleAnalysis::record(const SimTK::State& s)
     // ----------------------------------
     // LOOP THROUGH MUSCLES
     int nm = _muscleArray.getSize();
+    int nq = _momentArmStorageArray.getSize();
+
+    // Only the groups of quantities that are stored are computed.
+    const bool computeLengths = _pennationAngleStore || _lengthStore ||
+            _fiberLengthStore || _normalizedFiberLengthStore ||
+            _tendonLengthStore;
+    bool computeMoments = false;
+    for (int i = 0; i < nq; ++i) {
+        if (_momentArmStorageArray[i]->momentStore) computeMoments = true;
+    }
+    const bool computeForces = computeMoments || _forceStore ||
+            _fiberForceStore || _activeFiberForceStore ||
+            _passiveFiberForceStore || _activeFiberForceAlongTendonStore ||
+            _passiveFiberForceAlongTendonStore;
+    const bool computeDynamics = _fiberVelocityStore ||
+            _normFiberVelocityStore || _pennationAngularVelocityStore ||
+            _fiberActivePowerStore || _fiberPassivePowerStore ||
+            _tendonPowerStore || _musclePowerStore;
 
     double nan = SimTK::NaN;
     // Angles and lengths
@@ -523,21 +665,22 @@ int MuscleAnalysis::record(const SimTK::State& s)
     Array<double> fibActivePower(nan,nm), fibPassivePower(nan,nm),
                   tendonPower(nan,nm), muscPower(nan,nm);
 
-    double sysMass = _model->getMatterSubsystem().calcSystemMass(s);
-    bool hasMass = sysMass > SimTK::Eps;
-
     // Just warn once per instant
     bool lengthWarning = false;
     bool forceWarning = false;
     bool dynamicsWarning = false;
 
-    for(int i=0; i<nm; ++i) {
+    for(int i=0; i<nm && (computeLengths || computeForces); ++i) {
         try{
-            len[i] = _muscleArray[i]->getLength(s);
-            tlen[i] = _muscleArray[i]->getTendonLength(s);
-            fiblen[i] = _muscleArray[i]->getFiberLength(s);
-            normfiblen[i] = _muscleArray[i]->getNormalizedFiberLength(s);
-            penang[i] = _muscleArray[i]->getPennationAngle(s);
+            if (_lengthStore) len[i] = _muscleArray[i]->getLength(s);
+            if (_tendonLengthStore)
+                tlen[i] = _muscleArray[i]->getTendonLength(s);
+            if (_fiberLengthStore)
+                fiblen[i] = _muscleArray[i]->getFiberLength(s);
+            if (_normalizedFiberLengthStore)
+                normfiblen[i] = _muscleArray[i]->getNormalizedFiberLength(s);
+            if (_pennationAngleStore)
+                penang[i] = _muscleArray[i]->getPennationAngle(s);
         }
         catch (const std::exception& e) {
             if(!lengthWarning){
@@ -549,16 +692,24 @@ int MuscleAnalysis::record(const SimTK::State& s)
             continue;
         }
 
+        if (!computeForces) continue;
         try{
             // Compute muscle forces that are dependent on Positions, Velocities
             // so that later quantities are valid and setForce is called
             _muscleArray[i]->computeActuation(s);
             force[i] = _muscleArray[i]->getActuation(s);
-            fibforce[i] = _muscleArray[i]->getFiberForce(s);
-            actfibforce[i] = _muscleArray[i]->getActiveFiberForce(s);
-            passfibforce[i] = _muscleArray[i]->getPassiveFiberForce(s);
-            actfibforcealongten[i] = _muscleArray[i]->getActiveFiberForceAlongTendon(s);
-            passfibforcealongten[i] = _muscleArray[i]->getPassiveFiberForceAlongTendon(s);
+            if (_fiberForceStore)
+                fibforce[i] = _muscleArray[i]->getFiberForce(s);
+            if (_activeFiberForceStore)
+                actfibforce[i] = _muscleArray[i]->getActiveFiberForce(s);
+            if (_passiveFiberForceStore)
+                passfibforce[i] = _muscleArray[i]->getPassiveFiberForce(s);
+            if (_activeFiberForceAlongTendonStore)
+                actfibforcealongten[i] =
+                        _muscleArray[i]->getActiveFiberForceAlongTendon(s);
+            if (_passiveFiberForceAlongTendonStore)
+                passfibforcealongten[i] =
+                        _muscleArray[i]->getPassiveFiberForceAlongTendon(s);
         }
         catch (const std::exception& e) {
             if(!forceWarning){
@@ -572,6 +723,8 @@ int MuscleAnalysis::record(const SimTK::State& s)
     }
 
     // Cannot compute system dynamics without mass
+    const bool hasMass = computeDynamics &&
+            _model->getMatterSubsystem().calcSystemMass(s) > SimTK::Eps;
     if(hasMass){
         // state derivatives (activation rate and fiber velocity) evaluated at dynamics
         _model->getMultibodySystem().realize(s,SimTK::Stage::Dynamics);
@@ -579,14 +732,24 @@ int MuscleAnalysis::record(const SimTK::State& s)
         for(int i=0; i<nm; ++i) {
             try{
                 //Velocities
-                fibVel[i] = _muscleArray[i]->getFiberVelocity(s);
-                normFibVel[i] =  _muscleArray[i]->getNormalizedFiberVelocity(s);
-                penAngVel[i] =  _muscleArray[i]->getPennationAngularVelocity(s);
+                if (_fiberVelocityStore)
+                    fibVel[i] = _muscleArray[i]->getFiberVelocity(s);
+                if (_normFiberVelocityStore)
+                    normFibVel[i] =
+                            _muscleArray[i]->getNormalizedFiberVelocity(s);
+                if (_pennationAngularVelocityStore)
+                    penAngVel[i] =
+                            _muscleArray[i]->getPennationAngularVelocity(s);
                 //Powers
-                fibActivePower[i] = _muscleArray[i]->getFiberActivePower(s);
-                fibPassivePower[i] = _muscleArray[i]->getFiberPassivePower(s);
-                tendonPower[i] = _muscleArray[i]->getTendonPower(s);
-                muscPower[i] = _muscleArray[i]->getMusclePower(s);
+                if (_fiberActivePowerStore)
+                    fibActivePower[i] = _muscleArray[i]->getFiberActivePower(s);
+                if (_fiberPassivePowerStore)
+                    fibPassivePower[i] =
+                            _muscleArray[i]->getFiberPassivePower(s);
+                if (_tendonPowerStore)
+                    tendonPower[i] = _muscleArray[i]->getTendonPower(s);
+                if (_musclePowerStore)
+                    muscPower[i] = _muscleArray[i]->getMusclePower(s);
             }
             catch (const std::exception& e) {
                 if(!dynamicsWarning){
@@ -599,7 +762,7 @@ int MuscleAnalysis::record(const SimTK::State& s)
             }
         }
     }
-    else {
+    else if (computeDynamics) {
         if(!dynamicsWarning){
             log_warn("MuscleAnalysis::record() unable to evaluate muscle "
                      "dynamics at time {} because model has no mass and system "
@@ -609,58 +772,89 @@ int MuscleAnalysis::record(const SimTK::State& s)
     }
 
     // APPEND TO STORAGE
-    _pennationAngleStore->append(tReal,penang.getSize(),&penang[0]);
-    _lengthStore->append(tReal,len.getSize(),&len[0]);
-    _fiberLengthStore->append(tReal,fiblen.getSize(),&fiblen[0]);
-    _normalizedFiberLengthStore
-        ->append(tReal,normfiblen.getSize(),&normfiblen[0]);
-    _tendonLengthStore->append(tReal,tlen.getSize(),&tlen[0]);
-
-    _fiberVelocityStore->append(tReal,fibVel.getSize(),&fibVel[0]);
-    _normFiberVelocityStore->append(tReal,normFibVel.getSize(),&normFibVel[0]);
-    _pennationAngularVelocityStore
-        ->append(tReal,penAngVel.getSize(),&penAngVel[0]);
-
-    _forceStore->append(tReal,force.getSize(),&force[0]);
-    _fiberForceStore->append(tReal,fibforce.getSize(),&fibforce[0]);
-    _activeFiberForceStore->append(tReal,actfibforce.getSize(),&actfibforce[0]);
-    _passiveFiberForceStore
-        ->append(tReal,passfibforce.getSize(),&passfibforce[0]);
-    _activeFiberForceAlongTendonStore
-        ->append(tReal,actfibforcealongten.getSize(),&actfibforcealongten[0]);
-    _passiveFiberForceAlongTendonStore
-        ->append(tReal,passfibforcealongten.getSize(),&passfibforcealongten[0]);
-
-    _fiberActivePowerStore
-        ->append(tReal,fibActivePower.getSize(),&fibActivePower[0]);
-    _fiberPassivePowerStore
-        ->append(tReal,fibPassivePower.getSize(),&fibPassivePower[0]);
-    _tendonPowerStore->append(tReal,tendonPower.getSize(),&tendonPower[0]);
-    _musclePowerStore->append(tReal,muscPower.getSize(),&muscPower[0]);
-
-    if (getComputeMoments()){
-        // LOOP OVER ACTIVE MOMENT ARM STORAGE OBJECTS
-        Coordinate *q = NULL;
-        Storage *maStore=NULL, *mStore=NULL;
-        int nq = _momentArmStorageArray.getSize();
+    const auto append = [tReal](Storage* store, Array<double>& values) {
+        if (store) store->append(tReal, values.getSize(), &values[0]);
+    };
+    append(_pennationAngleStore, penang);
+    append(_lengthStore, len);
+    append(_fiberLengthStore, fiblen);
+    append(_normalizedFiberLengthStore, normfiblen);
+    append(_tendonLengthStore, tlen);
+
+    append(_fiberVelocityStore, fibVel);
+    append(_normFiberVelocityStore, normFibVel);
+    append(_pennationAngularVelocityStore, penAngVel);
+
+    append(_forceStore, force);
+    append(_fiberForceStore, fibforce);
+    append(_activeFiberForceStore, actfibforce);
+    append(_passiveFiberForceStore, passfibforce);
+    append(_activeFiberForceAlongTendonStore, actfibforcealongten);
+    append(_passiveFiberForceAlongTendonStore, passfibforcealongten);
+
+    append(_fiberActivePowerStore, fibActivePower);
+    append(_fiberPassivePowerStore, fibPassivePower);
+    append(_tendonPowerStore, tendonPower);
+    append(_musclePowerStore, muscPower);
+
+    if (getComputeMoments() && nq > 0){
         Array<double> ma(0.0,nm),m(0.0,nm);
 
+        std::vector<const GeometryPath*> paths;
+        std::vector<int> pathIndices(nm, -1);
+        for(int j=0; j<nm; j++) {
+            const auto* path = _muscleArray[j]->tryGetPath<GeometryPath>();
+            if (path) {
+                pathIndices[j] = (int)paths.size();
+                paths.push_back(path);
+            }
+        }
+
+        _model->getMultibodySystem().realize(s, s.getSystemStage());
+        if (!_maSolver || &_maSolver->getModel() != _model) {
+            _maSolver.reset(new MomentArmSolver(*_model));
+            findSpannedCoordinates(s);
+        }
+
+        // Solve for the moment arms of all muscles with GeometryPaths about
+        // all the coordinates that any of them spans at once; other paths
+        // compute their own.
+        std::vector<const Coordinate*> coords;
+        std::vector<int> coordIndices(nq, -1);
         for(int i=0; i<nq; i++) {
+            for (int k = 0; k < (int)paths.size(); ++k) {
+                if (_spannedCoordinates[k][i]) {
+                    coordIndices[i] = (int)coords.size();
+                    coords.push_back(_momentArmStorageArray[i]->q);
+                    break;
+                }
+            }
+        }
+        SimTK::Vector pathLengths;
+        SimTK::Matrix pathMomentArms;
+        _maSolver->solve(s, coords, paths, pathLengths, pathMomentArms);
 
-            q = _momentArmStorageArray[i]->q;
-            maStore = _momentArmStorageArray[i]->momentArmStore;
-            mStore = _momentArmStorageArray[i]->momentStore;
-           
-            // bool locked = q->getLocked(s);
+        // LOOP OVER ACTIVE MOMENT ARM STORAGE OBJECTS
+        for(int i=0; i<nq; i++) {
+
+            Storage* maStore = _momentArmStorageArray[i]->momentArmStore;
+            Storage* mStore = _momentArmStorageArray[i]->momentStore;
+            const Coordinate& q = *_momentArmStorageArray[i]->q;
 
-            _model->getMultibodySystem().realize(s, s.getSystemStage());
             // LOOP OVER MUSCLES
             for(int j=0; j<nm; j++) {
-                ma[j] = _muscleArray[j]->computeMomentArm(s,*q);
+                const int k = pathIndices[j];
+                if (k < 0) {
+                    ma[j] = _muscleArray[j]->computeMomentArm(s, q);
+                } else if (_spannedCoordinates[k][i]) {
+                    ma[j] = pathMomentArms(k, coordIndices[i]);
+                } else {
+                    ma[j] = 0;
+                }
                 m[j] = ma[j] * force[j];
             }
-            maStore->append(s.getTime(),nm,&ma[0]);
-            mStore->append(s.getTime(),nm,&m[0]);
+            if (maStore) maStore->append(s.getTime(),nm,&ma[0]);
+            if (mStore) mStore->append(s.getTime(),nm,&m[0]);
         }
     }
     return 0;
@@ -686,6 +880,9 @@ int MuscleAnalysis::begin(const SimTK::State&s )
 
     allocateStorageObjects();
 
+    // The model's system may have been rebuilt since the last analysis.
+    _maSolver.reset();
+
     // RESET STORAGE
     Storage *store;
     int size = _storageList.getSize();
@@ -790,14 +987,16 @@ printResults(const string &aBaseName,const string &aDir,double aDT,
 
     int size = _momentArmStorageArray.getSize();
     for(int i=0;i<size;i++) {
-        string fileName = prefix + _momentArmStorageArray.get(i)
-            ->momentArmStore->getName();
-        Storage::printResult(_momentArmStorageArray.get(i)
-            ->momentArmStore,fileName,aDir,aDT,aExtension);
-        fileName = prefix + _momentArmStorageArray.get(i)
-            ->momentStore->getName();
-        Storage::printResult(_momentArmStorageArray.get(i)
-            ->momentStore,fileName,aDir,aDT,aExtension);
+        Storage* maStore = _momentArmStorageArray.get(i)->momentArmStore;
+        if (maStore) {
+            Storage::printResult(maStore, prefix + maStore->getName(), aDir,
+                    aDT, aExtension);
+        }
+        Storage* mStore = _momentArmStorageArray.get(i)->momentStore;
+        if (mStore) {
+            Storage::printResult(mStore, prefix + mStore->getName(), aDir,
+                    aDT, aExtension);
+        }
     }
 
     return 0;
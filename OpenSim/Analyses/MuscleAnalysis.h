@@ -30,6 +30,7 @@
 //=============================================================================
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include <OpenSim/Simulation/Model/Muscle.h>
+#include <OpenSim/Simulation/MomentArmSolver.h>
 #include "osimAnalysesDLL.h"
 
 
@@ -52,6 +53,16 @@ class Coordinate;
  * A class for recording and computing basic quantities (length, shortening
  * velocity, tendon length, ...) for muscles during a simulation.
  *
+ * Only the quantities in the quantity_list property are computed and stored
+ * (e.g., `FiberLength TendonForce MomentArm`; by default, all of them), so
+ * that, for example, the fiber velocities and powers, which require
+ * realizing the model to Dynamics, are not computed when they are not
+ * requested. The moment arms (and moments) of a muscle with a GeometryPath
+ * are computed only about the coordinates that can change the length of the
+ * path: those of the mobilizers between the bodies of its path points and
+ * wrap objects, and of the mobilizers coupled to them by constraints. The
+ * moment arms about the other coordinates are 0.
+ *
  * @author Ajay Seth, Matthew Millard, Katherine Holzbaur, Frank C. Anderson 
  * @version 1.0
  */
@@ -87,6 +98,9 @@ private:
     /** Compute moments and moment arms. */
     PropertyBool _computeMomentsProp;
 
+    /** List of the quantities to compute and store. */
+    PropertyStrArray _quantityListProp;
+
     /** Pennation angle storage. */
     Storage *_pennationAngleStore;
     /** Muscle-tendon length storage. */
@@ -133,6 +147,9 @@ private:
     /** Work array for holding the list of coordinates. */
     Array<std::string> _coordinateList;
 
+    /** Work array for holding the list of quantities. */
+    Array<std::string> _quantityList;
+
 #ifndef SWIG
     /** Array of active storage and coordinate pairs. */
     ArrayPtrs<StorageCoordinatePair> _momentArmStorageArray;
@@ -140,6 +157,16 @@ private:
     /** Array of active muscles. */
     ArrayPtrs<Muscle> _muscleArray;
 
+#ifndef SWIG
+    /** Solver for the moment arms of the active muscles (with GeometryPaths)
+    about all active coordinates at once; created when first needed. */
+    SimTK::ResetOnCopy<std::unique_ptr<MomentArmSolver>> _maSolver;
+    /** For each active muscle with a GeometryPath, whether each active
+    coordinate can change the length of its path; computed with
+    _maSolver. */
+    std::vector<std::vector<bool>> _spannedCoordinates;
+#endif
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -154,6 +181,12 @@ private:
     void setupProperties();
     void constructDescription();
     void constructColumnLabels();
+    /** Create a storage for the quantity `name`, if it is in the list of
+    quantities, and add it to the storage list; otherwise, return NULL. */
+    Storage* createStorage(const std::string& name);
+    /** Find the coordinates that can change the length of the path of each
+    active muscle with a GeometryPath. */
+    void findSpannedCoordinates(const SimTK::State& s);
 
 public:
     //--------------------------------------------------------------------------
@@ -210,6 +243,13 @@ public:
 
     void setMuscles(Array<std::string>& aMuscles);
     void setCoordinates(Array<std::string>& aCoordinates);
+    /** Set the list of quantities to compute and store (the names of the
+    storages, e.g., FiberLength, TendonForce, or FiberActivePower, and
+    MomentArm and Moment for the moment arms and moments about the
+    coordinates, which also require that compute_moments is true). Use 'all'
+    to compute all the quantities. The storages of the other quantities are
+    NULL. */
+    void setQuantities(Array<std::string>& aQuantities);
 
     void setComputeMoments(bool aTrueFalse) {
         _computeMomentsProp.setValue(aTrueFalse);
@@ -239,6 +279,7 @@ public:
     int
         printResults(const std::string &aBaseName,const std::string &aDir="",
         double aDT=-1.0,const std::string &aExtension=".sto") override;
+    bool getFramesAreIndependent() const override { return true; }
     /** 
      * Intended for use only by GUI that holds one MuscleAnalysis and keeps changing attributes to generate various plots
      * For all other use cases, the code handles the allocation/deallocation of resources internally.
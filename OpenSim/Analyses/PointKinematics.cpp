@@ -669,4 +669,16 @@ printResults(const string &aBaseName,const string &aDir,double aDT,
     return(0);
 }
 
+//_____________________________________________________________________________
+/**
+ * Append the kinematics recorded by a copy of this analysis.
+ */
+void PointKinematics::appendResults(Analysis& aAnalysis)
+{
+    PointKinematics& other = dynamic_cast<PointKinematics&>(aAnalysis);
+    appendRows(*_aStore, *other._aStore);
+    appendRows(*_vStore, *other._vStore);
+    appendRows(*_pStore, *other._pStore);
+}
+
 
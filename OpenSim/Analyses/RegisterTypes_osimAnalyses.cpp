@@ -69,5 +69,5 @@ osimAnalysesInstantiator::osimAnalysesInstantiator()
 } 
 void osimAnalysesInstantiator::registerDllClasses() 
 { 
-        RegisterTypes_osimAnalyses(); 
+        Object::deferTypeRegistration(RegisterTypes_osimAnalyses); 
 } 
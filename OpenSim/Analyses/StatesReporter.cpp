@@ -201,9 +201,22 @@ record(const SimTK::State& s)
     // MAKE SURE ALL StatesReporter QUANTITIES ARE VALID
     _model->getMultibodySystem().realize(s, SimTK::Stage::Velocity );
 
-    SimTK::Vector stateValues = _model->getStateVariableValues(s);
-    StateVector nextRow(s.getTime(), stateValues);
-    _statesStore.append(nextRow);
+    // The accessor is created once per System.
+    if (_stateAccessorSystem.empty() ||
+            !_model->getMultibodySystem().isSameSystem(
+                    _stateAccessorSystem.getRef()) ||
+            _stateAccessor.getNumStateVariables() !=
+                    _model->getNumStateVariables()) {
+        _stateAccessor = StateVariableAccessor(*_model, s);
+        _stateAccessorSystem.reset(&_model->getMultibodySystem());
+    }
+    _stateAccessor.getValues(s, _stateValues);
+    if (_stateValues.size()) {
+        _statesStore.append(s.getTime(), _stateValues.size(),
+                &_stateValues[0]);
+    } else {
+        _statesStore.append(StateVector(s.getTime()));
+    }
 
     return(0);
 }
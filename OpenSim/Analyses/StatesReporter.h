@@ -27,6 +27,7 @@
 //=============================================================================
 // INCLUDES
 //=============================================================================
+#include <OpenSim/Common/StateVariableAccessor.h>
 #include <OpenSim/Common/Storage.h>
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include "osimAnalysesDLL.h"
@@ -61,6 +62,13 @@ protected:
     /** States storage. */
     Storage _statesStore;
 
+private:
+    // Reads the values of all state variables of the model, for the System
+    // _stateAccessorSystem; recreated when the System changes.
+    StateVariableAccessor _stateAccessor;
+    SimTK::ReferencePtr<const SimTK::System> _stateAccessorSystem;
+    SimTK::Vector _stateValues;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -114,6 +122,7 @@ public:
     int
         printResults(const std::string &aBaseName,const std::string &aDir="",
         double aDT=-1.0,const std::string &aExtension=".sto") override;
+    bool getFramesAreIndependent() const override { return true; }
 
 //=============================================================================
 };  // END of class StatesReporter
@@ -47,6 +47,9 @@ using namespace std;
 StaticOptimization::~StaticOptimization()
 {
     deleteStorage();
+    // The optimizer refers to the target, which refers to the model.
+    _optimizer.reset();
+    _target.reset();
     delete _modelWorkingCopy;
     if(_ownsForceSet) delete _forceSet;
 }
@@ -61,6 +64,7 @@ StaticOptimization::StaticOptimization(Model *aModel) :
     _useMusclePhysiology(_useMusclePhysiologyProp.getValueBool()),
     _convergenceCriterion(_convergenceCriterionProp.getValueDbl()),
     _maximumIterations(_maximumIterationsProp.getValueInt()),
+    _optimizerAlgorithm(_optimizerAlgorithmProp.getValueStr()),
     _modelWorkingCopy(NULL)
 {
     setNull();
@@ -82,6 +86,7 @@ StaticOptimization::StaticOptimization(const StaticOptimization &aStaticOptimiza
     _useMusclePhysiology(_useMusclePhysiologyProp.getValueBool()),
     _convergenceCriterion(_convergenceCriterionProp.getValueDbl()),
     _maximumIterations(_maximumIterationsProp.getValueInt()),
+    _optimizerAlgorithm(_optimizerAlgorithmProp.getValueStr()),
     _modelWorkingCopy(NULL)
 {
     setNull();
@@ -114,6 +119,7 @@ operator=(const StaticOptimization &aStaticOptimization)
     _activationExponent=aStaticOptimization._activationExponent;
     _convergenceCriterion=aStaticOptimization._convergenceCriterion;
     _maximumIterations=aStaticOptimization._maximumIterations;
+    _optimizerAlgorithm=aStaticOptimization._optimizerAlgorithm;
     _forceReporter = nullptr;
     _useMusclePhysiology=aStaticOptimization._useMusclePhysiology;
     return(*this);
@@ -138,6 +144,7 @@ void StaticOptimization::setNull()
     _numCoordinateActuators = 0;
     _convergenceCriterion = 1e-4;
     _maximumIterations = 100;
+    _optimizerAlgorithm = "ipopt";
     _forceReporter = nullptr;
     setName("StaticOptimization");
 }
@@ -173,6 +180,14 @@ setupProperties()
         "An integer for setting the maximum number of iterations the optimizer can use at each time.  ");
     _maximumIterationsProp.setName("optimizer_max_iterations");
     _propertySet.append(&_maximumIterationsProp);
+
+    _optimizerAlgorithmProp.setComment(
+        "The algorithm used to solve the optimization problem at each time: "
+        "'ipopt' (default) or 'qp', which solves the problem directly as a "
+        "quadratic program and requires an activation_exponent of 2. Times at "
+        "which the quadratic program cannot be solved are solved with ipopt.");
+    _optimizerAlgorithmProp.setName("optimizer_algorithm");
+    _propertySet.append(&_optimizerAlgorithmProp);
 }
 
 //=============================================================================
@@ -326,42 +341,45 @@ record(const SimTK::State& s)
 
     // IPOPT
     _numericalDerivativeStepSize = 0.0001;
-    _optimizerAlgorithm = "ipopt";
     _printLevel = 0;
     //_optimizationConvergenceTolerance = 1e-004;
     //_maxIterations = 2000;
 
-    // Optimization target
+    // Optimization target and optimizer, which are created at the first time
+    // and reused at the remaining times.
     _modelWorkingCopy->setAllControllersEnabled(false);
-    StaticOptimizationTarget target(sWorkingCopy,_modelWorkingCopy,na,nacc,_useMusclePhysiology);
-    target.setStatesStore(_statesStore);
-    target.setStatesSplineSet(_statesSplineSet);
-    target.setActivationExponent(_activationExponent);
-    target.setDX(_numericalDerivativeStepSize);
-
-    // Pick optimizer algorithm
-    SimTK::OptimizerAlgorithm algorithm = SimTK::InteriorPoint;
-    //SimTK::OptimizerAlgorithm algorithm = SimTK::CFSQP;
-
-    // Optimizer
-    SimTK::Optimizer *optimizer = new SimTK::Optimizer(target, algorithm);
-
-    // Optimizer options
-    //cout<<"\nSetting optimizer print level to "<<_printLevel<<".\n";
-    optimizer->setDiagnosticsLevel(_printLevel);
-    //cout<<"Setting optimizer convergence criterion to "<<_convergenceCriterion<<".\n";
-    optimizer->setConvergenceTolerance(_convergenceCriterion);
-    //cout<<"Setting optimizer maximum iterations to "<<_maximumIterations<<".\n";
-    optimizer->setMaxIterations(_maximumIterations);
-    optimizer->useNumericalGradient(false);
-    optimizer->useNumericalJacobian(false);
-    if(algorithm == SimTK::InteriorPoint) {
-        // Some IPOPT-specific settings
-        optimizer->setLimitedMemoryHistory(500); // works well for our small systems
-        optimizer->setAdvancedBoolOption("warm_start",true);
-        optimizer->setAdvancedRealOption("obj_scaling_factor",1);
-        optimizer->setAdvancedRealOption("nlp_scaling_max_gradient",1);
+    if(!_target) {
+        _target.reset(new StaticOptimizationTarget(sWorkingCopy,_modelWorkingCopy,na,nacc,_useMusclePhysiology));
+        _target->setStatesStore(_statesStore);
+        _target->setStatesSplineSet(_statesSplineSet);
+        _target->setActivationExponent(_activationExponent);
+        _target->setDX(_numericalDerivativeStepSize);
+
+        // Pick optimizer algorithm
+        SimTK::OptimizerAlgorithm algorithm = SimTK::InteriorPoint;
+        //SimTK::OptimizerAlgorithm algorithm = SimTK::CFSQP;
+
+        // Optimizer
+        _optimizer.reset(new SimTK::Optimizer(*_target, algorithm));
+
+        // Optimizer options
+        //cout<<"\nSetting optimizer print level to "<<_printLevel<<".\n";
+        _optimizer->setDiagnosticsLevel(_printLevel);
+        //cout<<"Setting optimizer convergence criterion to "<<_convergenceCriterion<<".\n";
+        _optimizer->setConvergenceTolerance(_convergenceCriterion);
+        //cout<<"Setting optimizer maximum iterations to "<<_maximumIterations<<".\n";
+        _optimizer->setMaxIterations(_maximumIterations);
+        _optimizer->useNumericalGradient(false);
+        _optimizer->useNumericalJacobian(false);
+        if(algorithm == SimTK::InteriorPoint) {
+            // Some IPOPT-specific settings
+            _optimizer->setLimitedMemoryHistory(500); // works well for our small systems
+            _optimizer->setAdvancedBoolOption("warm_start",true);
+            _optimizer->setAdvancedRealOption("obj_scaling_factor",1);
+            _optimizer->setAdvancedRealOption("nlp_scaling_max_gradient",1);
+        }
     }
+    StaticOptimizationTarget& target = *_target;
 
     // Parameter bounds
     SimTK::Vector lowerBounds(na), upperBounds(na);
@@ -376,12 +394,27 @@ record(const SimTK::State& s)
     
     target.setParameterLimits(lowerBounds, upperBounds);
 
-    _parameters = 0; // Set initial guess to zeros
+    // The initial guess is the solution at the previous time (zeros at the
+    // first time), clamped to the bounds.
+    for(int i=0;i<na;i++)
+        _parameters[i] = SimTK::clamp(lowerBounds[i], _parameters[i], upperBounds[i]);
 
     // Static optimization
     _modelWorkingCopy->getMultibodySystem().realize(sWorkingCopy,SimTK::Stage::Velocity);
     target.prepareToOptimize(sWorkingCopy, &_parameters[0]);
 
+    bool solved = false;
+    if(_optimizerAlgorithm == "qp") {
+        solved = target.solveQuadraticProgram(lowerBounds, upperBounds,
+                _parameters, _multipliers, _maximumIterations, 1e-6);
+        if(!solved) {
+            log_warn("StaticOptimization.record: The quadratic program could "
+                     "not be solved at time = {}; using ipopt.",
+                    s.getTime());
+            _multipliers.clear();
+        }
+    }
+
     //LARGE_INTEGER start;
     //LARGE_INTEGER stop;
     //LARGE_INTEGER frequency;
@@ -391,7 +424,7 @@ record(const SimTK::State& s)
 
     try {
         target.setCurrentState( &sWorkingCopy );
-        optimizer->optimize(_parameters);
+        if(!solved) _optimizer->optimize(_parameters);
     }
     catch (const SimTK::Exception::Base& ex) {
         log_warn(ex.getMessage());
@@ -512,6 +545,19 @@ int StaticOptimization::begin(const SimTK::State& s )
 {
     if(!proceed()) return(0);
 
+    if(_optimizerAlgorithm != "ipopt" && _optimizerAlgorithm != "qp")
+        throw(Exception("StaticOptimization: ERROR- optimizer_algorithm must "
+            "be 'ipopt' or 'qp', but it is '" + _optimizerAlgorithm + "'.\n"));
+    if(_optimizerAlgorithm == "qp" && _activationExponent != 2)
+        throw(Exception("StaticOptimization: ERROR- optimizer_algorithm 'qp' "
+            "requires an activation_exponent of 2.\n"));
+
+    // The optimizer and target refer to the working copy of the model, so
+    // they are created again (in record()) for the new working copy.
+    _optimizer.reset();
+    _target.reset();
+    _multipliers.clear();
+
     // Make a working copy of the model
     delete _modelWorkingCopy;
     _modelWorkingCopy = _model->clone();
@@ -666,6 +712,19 @@ int StaticOptimization::end( const SimTK::State& s )
     return(0);
 }
 
+//_____________________________________________________________________________
+/**
+ * Append the activations and forces recorded by a copy of this analysis.
+ */
+void StaticOptimization::appendResults(Analysis& aAnalysis)
+{
+    StaticOptimization& other = dynamic_cast<StaticOptimization&>(aAnalysis);
+    appendRows(*_activationStorage, *other._activationStorage);
+    if(_forceReporter && other._forceReporter) {
+        appendRows(_forceReporter->updForceStorage(),
+                other._forceReporter->getForceStorage());
+    }
+}
 
 //=============================================================================
 // IO
@@ -33,6 +33,10 @@
 #include <OpenSim/Common/GCVSplineSet.h>
 #include "ForceReporter.h"
 
+namespace SimTK {
+class Optimizer;
+}
+
 //=============================================================================
 //=============================================================================
 /**
@@ -41,11 +45,20 @@ namespace OpenSim {
 
 class Model;
 class ForceSet;
+class StaticOptimizationTarget;
 
 /**
  * This class implements static optimization to compute Muscle Forces and 
  * activations. 
  *
+ * The optimization problem and the optimizer are created once and are reused
+ * at every time, and the solution at each time is the initial guess at the
+ * next time. With the "qp" optimizer_algorithm, which requires an
+ * activation_exponent of 2, the problem is solved directly as a quadratic
+ * program (the acceleration constraints are linear in the activations), whose
+ * multipliers are likewise reused as the initial guess at the next time. Times
+ * at which the quadratic program cannot be solved are solved with IPOPT.
+ *
  * @author Jeff Reinbolt
  */
 class OSIMANALYSES_API StaticOptimization : public Analysis {
@@ -76,6 +89,9 @@ protected:
     PropertyInt _maximumIterationsProp;
     int &_maximumIterations;
 
+    PropertyStr _optimizerAlgorithmProp;
+    std::string &_optimizerAlgorithm;
+
     Storage *_activationStorage;
     Storage *_forceStorage;
     GCVSplineSet _statesSplineSet;
@@ -88,9 +104,12 @@ protected:
     ForceSet* _forceSet;
 
     double _numericalDerivativeStepSize;
-    std::string _optimizerAlgorithm;
     int _printLevel;
 
+    std::unique_ptr<StaticOptimizationTarget> _target;
+    std::unique_ptr<SimTK::Optimizer> _optimizer;
+    SimTK::Vector _multipliers;
+
     Model *_modelWorkingCopy;
 
 //=============================================================================
@@ -135,6 +154,9 @@ public:
     double getConvergenceCriterion() { return _convergenceCriterion; }
     void setMaxIterations( const int maxIt) { _maximumIterations = maxIt; }
     int getMaxIterations() {return _maximumIterations; }
+    /** "ipopt" (the default) or "qp" (see the class description). */
+    void setOptimizerAlgorithm(const std::string& algorithm) { _optimizerAlgorithm = algorithm; }
+    const std::string& getOptimizerAlgorithm() const { return _optimizerAlgorithm; }
     //--------------------------------------------------------------------------
     // ANALYSIS
     //--------------------------------------------------------------------------
@@ -144,6 +166,14 @@ public:
         step(const SimTK::State& s, int setNumber ) override;
     int
         end(const SimTK::State& s ) override;
+    /** The solution at each time depends on the previous times only through
+    the initial guess, so AnalyzeTool may solve contiguous ranges of times
+    concurrently with copies of this analysis (e.g., with its num_threads
+    property). Each copy warm-starts within its range, beginning from zeros,
+    so the results match those of one analysis to within the optimizer
+    convergence criterion. */
+    bool getFramesAreIndependent() const override { return true; }
+    void appendResults(Analysis& aAnalysis) override;
 protected:
     virtual int
         record(const SimTK::State& s );
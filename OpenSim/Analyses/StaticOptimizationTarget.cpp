@@ -32,12 +32,54 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include "StaticOptimizationTarget.h"
 
+#include <algorithm>
+
 using namespace OpenSim;
 using namespace std;
 using SimTK::Vector;
 using SimTK::Matrix;
 using SimTK::Real;
 
+namespace {
+    // Solve a * x = b for a symmetric positive-definite matrix a, of which
+    // only the lower triangle is used. The lower triangle of a is overwritten
+    // with its Cholesky factor, and b is overwritten with x. Returns false if
+    // a is not positive definite.
+    bool solveCholesky(Matrix& a, Vector& b)
+    {
+        const int n = a.nrow();
+        for(int j=0; j<n; j++) {
+            double d = a(j,j);
+            for(int k=0; k<j; k++) d -= a(j,k)*a(j,k);
+            if(!(d > 0)) return false;
+            a(j,j) = sqrt(d);
+            for(int i=j+1; i<n; i++) {
+                double sum = a(i,j);
+                for(int k=0; k<j; k++) sum -= a(i,k)*a(j,k);
+                a(i,j) = sum / a(j,j);
+            }
+        }
+        for(int i=0; i<n; i++) {
+            double sum = b[i];
+            for(int k=0; k<i; k++) sum -= a(i,k)*b[k];
+            b[i] = sum / a(i,i);
+        }
+        for(int i=n-1; i>=0; i--) {
+            double sum = b[i];
+            for(int k=i+1; k<n; k++) sum -= a(k,i)*b[k];
+            b[i] = sum / a(i,i);
+        }
+        return true;
+    }
+
+    double maxAbs(const Vector& v)
+    {
+        double m = 0;
+        for(int i=0; i<v.size(); i++) m = std::max(m, fabs(v[i]));
+        return m;
+    }
+}
+
 #define USE_LINEAR_CONSTRAINT_MATRIX
 
 const double StaticOptimizationTarget::SMALLDX = 1.0e-14;
@@ -138,6 +180,103 @@ prepareToOptimize(SimTK::State& s, double *x)
     // return false to indicate that we still need to proceed with optimization
     return false;
 }
+
+bool StaticOptimizationTarget::
+solveQuadraticProgram(const Vector& lower, const Vector& upper, Vector& x,
+        Vector& multipliers, int maxIterations, double tolerance) const
+{
+    // The constraints are a*x + b, and the objective is x'x. For multipliers
+    // lambda, the parameters that minimize the Lagrangian within the bounds
+    // are x(lambda) = clamp(-a'lambda/2), and the (concave) dual function is
+    // d(lambda) = x'x + lambda'(a*x + b), whose gradient is the constraint
+    // vector a*x + b and whose (generalized) Hessian is -a_F*a_F'/2, where
+    // a_F are the columns of a for the parameters that are not at a bound.
+    // Maximizing d gives the solution of the quadratic program.
+    const Matrix& a = _constraintMatrix;
+    const Vector& b = _constraintVector;
+    const int np = getNumParameters();
+    const int nc = getNumConstraints();
+
+    if(x.size() != np) x.resize(np);
+    if(multipliers.size() != nc) {
+        multipliers.resize(nc);
+        multipliers = 0;
+    }
+    if(_qpNormalMatrix.nrow() != nc) {
+        _qpNormalMatrix.resize(nc,nc);
+        _qpConstraints.resize(nc);
+        _qpStep.resize(nc);
+        _qpTrialMultipliers.resize(nc);
+        _qpTrialConstraints.resize(nc);
+    }
+
+    // Compute x(lambda) and the constraints, and return d(lambda).
+    const auto evaluateDual = [&](const Vector& lambda, Vector& c) {
+        double dual = 0;
+        for(int p=0; p<np; p++) {
+            double atLambda = 0;
+            for(int i=0; i<nc; i++) atLambda += a(i,p)*lambda[i];
+            x[p] = SimTK::clamp(lower[p], -0.5*atLambda, upper[p]);
+            dual += x[p]*x[p];
+        }
+        for(int i=0; i<nc; i++) {
+            c[i] = b[i];
+            for(int p=0; p<np; p++) c[i] += a(i,p)*x[p];
+            dual += lambda[i]*c[i];
+        }
+        return dual;
+    };
+
+    double dual = evaluateDual(multipliers, _qpConstraints);
+    for(int iter=0; iter<maxIterations; iter++) {
+        if(maxAbs(_qpConstraints) <= tolerance) return true;
+
+        // Newton step, regularized for parameters at their bounds and for
+        // dependent constraints.
+        double maxDiagonal = 0;
+        for(int i=0; i<nc; i++) {
+            for(int j=0; j<=i; j++) {
+                double sum = 0;
+                for(int p=0; p<np; p++) {
+                    if(x[p] > lower[p] && x[p] < upper[p]) {
+                        sum += a(i,p)*a(j,p);
+                    }
+                }
+                _qpNormalMatrix(i,j) = 0.5*sum;
+            }
+            maxDiagonal = std::max(maxDiagonal, _qpNormalMatrix(i,i));
+        }
+        const double regularization = 1e-10*(1.0 + maxDiagonal);
+        for(int i=0; i<nc; i++) _qpNormalMatrix(i,i) += regularization;
+        _qpStep = _qpConstraints;
+        if(!solveCholesky(_qpNormalMatrix, _qpStep)) break;
+
+        // Backtracking line search for a sufficient increase of the dual.
+        const double slope = ~_qpConstraints*_qpStep;
+        double stepLength = 1;
+        bool accepted = false;
+        for(int search=0; search<30 && !accepted; search++) {
+            for(int i=0; i<nc; i++) {
+                _qpTrialMultipliers[i] =
+                        multipliers[i] + stepLength*_qpStep[i];
+            }
+            const double trialDual =
+                    evaluateDual(_qpTrialMultipliers, _qpTrialConstraints);
+            if(trialDual >= dual + 1e-4*stepLength*slope) {
+                accepted = true;
+                dual = trialDual;
+            } else {
+                stepLength *= 0.5;
+            }
+        }
+        if(!accepted) break;
+        multipliers = _qpTrialMultipliers;
+        _qpConstraints = _qpTrialConstraints;
+    }
+    // x was last evaluated at a trial point if the line search failed.
+    evaluateDual(multipliers, _qpConstraints);
+    return maxAbs(_qpConstraints) <= tolerance;
+}
 //==============================================================================
 // SET AND GET
 //==============================================================================
@@ -68,6 +68,13 @@ private:
     const Storage *_statesStore;
     GCVSplineSet _statesSplineSet;
 
+    // Workspace for solveQuadraticProgram().
+    mutable SimTK::Matrix _qpNormalMatrix;
+    mutable SimTK::Vector _qpConstraints;
+    mutable SimTK::Vector _qpStep;
+    mutable SimTK::Vector _qpTrialMultipliers;
+    mutable SimTK::Vector _qpTrialConstraints;
+
 protected:
     double _activationExponent;
     bool   _useMusclePhysiology;
@@ -113,6 +120,21 @@ public:
 
     bool prepareToOptimize(SimTK::State& s, double *x);
 
+    /** Solve the problem prepared by prepareToOptimize() directly, as the
+    quadratic program it is for an activation exponent of 2: minimize the sum
+    of the squared parameters `x` subject to the (linear) acceleration
+    constraints and the bounds `lower` <= `x` <= `upper`. The problem is
+    solved for the multipliers of the constraints with a semismooth Newton
+    method on the dual problem; `multipliers` holds the initial guess (e.g.,
+    the multipliers at the previous time, or empty for zeros) and the
+    multipliers at the solution. Returns false if the magnitude of each
+    constraint is not below `tolerance` within `maxIterations` iterations
+    (e.g., if the constraints cannot be satisfied within the bounds). */
+    bool solveQuadraticProgram(const SimTK::Vector& lower,
+            const SimTK::Vector& upper, SimTK::Vector& x,
+            SimTK::Vector& multipliers, int maxIterations,
+            double tolerance) const;
+
     //--------------------------------------------------------------------------
     // REQUIRED OPTIMIZATION TARGET METHODS
     //--------------------------------------------------------------------------
@@ -0,0 +1,257 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  testMuscleAnalysis.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/*=============================================================================
+
+MuscleAnalysis Tests:
+1. testSelectedQuantities: Record only some of the quantities, and check that
+   only those are stored, with the same values as when all the quantities are
+   recorded.
+2. testSpannedCoordinates: Check the moment arms of muscles that span some of
+   the coordinates of a model (with and without a constraint that couples the
+   coordinates) against the MomentArmSolver.
+
+//=============================================================================*/
+#include <OpenSim/Common/osimCommon.h>
+#include <OpenSim/Simulation/osimSimulation.h>
+#include <OpenSim/Actuators/osimActuators.h>
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <OpenSim/Analyses/MuscleAnalysis.h>
+
+using namespace OpenSim;
+using namespace std;
+
+void testSelectedQuantities();
+void testSpannedCoordinates(bool coupled);
+
+int main()
+{
+    SimTK::Array_<std::string> failures;
+
+    try { testSelectedQuantities(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testSelectedQuantities");
+    }
+
+    try { testSpannedCoordinates(false); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testSpannedCoordinates (uncoupled)");
+    }
+
+    try { testSpannedCoordinates(true); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testSpannedCoordinates (coupled)");
+    }
+
+    if (!failures.empty()) {
+        cout << "Done, with failure(s): " << failures << endl;
+        return 1;
+    }
+
+    cout << "Done. All cases passed." << endl;
+
+    return 0;
+}
+
+//==============================================================================
+// Test Cases
+//==============================================================================
+namespace {
+// A double pendulum (coordinates q1 and q2) and a slider (coordinate q3), with
+// a muscle that spans q2 ("uni") and a muscle that spans q1 and q2 ("bi").
+Model createModel(bool coupled) {
+    using SimTK::Vec3;
+    Model model;
+    auto* b1 = new Body("b1", 1, Vec3(0), SimTK::Inertia(0.1));
+    auto* b2 = new Body("b2", 1, Vec3(0), SimTK::Inertia(0.1));
+    auto* b3 = new Body("b3", 1, Vec3(0), SimTK::Inertia(0.1));
+    model.addBody(b1);
+    model.addBody(b2);
+    model.addBody(b3);
+    auto* j1 = new PinJoint("j1", model.getGround(), Vec3(0), Vec3(0),
+            *b1, Vec3(0, 0.5, 0), Vec3(0));
+    auto* j2 = new PinJoint("j2", *b1, Vec3(0, -0.5, 0), Vec3(0),
+            *b2, Vec3(0, 0.5, 0), Vec3(0));
+    auto* j3 = new SliderJoint("j3", model.getGround(), Vec3(1, 0, 0),
+            Vec3(0), *b3, Vec3(0), Vec3(0));
+    j1->updCoordinate().setName("q1");
+    j2->updCoordinate().setName("q2");
+    j3->updCoordinate().setName("q3");
+    model.addJoint(j1);
+    model.addJoint(j2);
+    model.addJoint(j3);
+
+    auto* uni = new Thelen2003Muscle("uni", 100, 0.2, 0.3, 0);
+    uni->addNewPathPoint("origin", *b1, Vec3(0.05, -0.2, 0));
+    uni->addNewPathPoint("insertion", *b2, Vec3(0.05, 0.3, 0));
+    model.addForce(uni);
+    auto* bi = new Thelen2003Muscle("bi", 100, 0.3, 1.0, 0);
+    bi->addNewPathPoint("origin", model.getGround(), Vec3(0.05, 0, 0));
+    bi->addNewPathPoint("insertion", *b2, Vec3(0.05, 0.2, 0));
+    model.addForce(bi);
+
+    if (coupled) {
+        // q2 = 0.5 q1.
+        auto* coupler = new CoordinateCouplerConstraint();
+        coupler->setName("coupler");
+        Array<std::string> independentCoordinateNames;
+        independentCoordinateNames.append("q1");
+        coupler->setIndependentCoordinateNames(independentCoordinateNames);
+        coupler->setDependentCoordinateName("q2");
+        LinearFunction function(0.5, 0);
+        coupler->setFunction(&function);
+        model.addConstraint(coupler);
+    }
+    model.finalizeConnections();
+    return model;
+}
+
+// Record the analysis at a few configurations.
+void recordPoses(Model& model, SimTK::State& state,
+        const std::vector<MuscleAnalysis*>& analyses) {
+    const CoordinateSet& coordinates = model.getCoordinateSet();
+    for (int i = 0; i < 3; ++i) {
+        coordinates.get("q1").setValue(state, 0.2 + 0.3 * i, false);
+        coordinates.get("q2").setValue(state, 0.1 - 0.4 * i, false);
+        coordinates.get("q3").setValue(state, 0.1 * i, false);
+        model.assemble(state);
+        model.equilibrateMuscles(state);
+        model.realizeVelocity(state);
+        for (auto* analysis : analyses) {
+            if (i == 0) analysis->begin(state);
+            else analysis->step(state, i);
+        }
+    }
+}
+
+void compareStorages(const Storage* expected, const Storage* actual) {
+    ASSERT(expected != nullptr && actual != nullptr);
+    ASSERT(expected->getSize() == actual->getSize());
+    for (int i = 0; i < expected->getSize(); ++i) {
+        const StateVector& e = *expected->getStateVector(i);
+        const StateVector& a = *actual->getStateVector(i);
+        ASSERT(e.getSize() == a.getSize());
+        for (int j = 0; j < e.getSize(); ++j) {
+            ASSERT_EQUAL(e.getData()[j], a.getData()[j], 1e-10);
+        }
+    }
+}
+}
+
+void testSelectedQuantities()
+{
+    cout << "Running testSelectedQuantities" << endl;
+
+    Model model = createModel(false);
+    auto* all = new MuscleAnalysis();
+    all->setName("all");
+    model.addAnalysis(all);
+    auto* selected = new MuscleAnalysis();
+    selected->setName("selected");
+    Array<std::string> quantities;
+    quantities.append("FiberLength");
+    quantities.append("MomentArm");
+    quantities.append("Moment");
+    quantities.append("NotAQuantity");
+    selected->setQuantities(quantities);
+    model.addAnalysis(selected);
+    SimTK::State& state = model.initSystem();
+    recordPoses(model, state, {all, selected});
+
+    // Only the selected quantities are stored.
+    ASSERT(selected->getMuscleTendonLengthStorage() == nullptr);
+    ASSERT(selected->getForceStorage() == nullptr);
+    ASSERT(selected->getFiberVelocityStorage() == nullptr);
+    ASSERT(selected->getMusclePowerStorage() == nullptr);
+    ASSERT(all->getForceStorage() != nullptr);
+    ASSERT(all->getMusclePowerStorage() != nullptr);
+    compareStorages(all->getFiberLengthStorage(),
+            selected->getFiberLengthStorage());
+    ASSERT(selected->getFiberLengthStorage()->getSize() == 3);
+
+    const auto& expectedPairs = all->getMomentArmStorageArray();
+    const auto& actualPairs = selected->getMomentArmStorageArray();
+    ASSERT(expectedPairs.getSize() == 3);
+    ASSERT(actualPairs.getSize() == 3);
+    for (int i = 0; i < actualPairs.getSize(); ++i) {
+        compareStorages(expectedPairs[i]->momentArmStore,
+                actualPairs[i]->momentArmStore);
+        compareStorages(expectedPairs[i]->momentStore,
+                actualPairs[i]->momentStore);
+    }
+
+    // Without moments, the moment arms are stored alone.
+    quantities.setSize(0);
+    quantities.append("MomentArm");
+    selected->setQuantities(quantities);
+    selected->allocateStorageObjects();
+    recordPoses(model, state, {selected});
+    for (int i = 0; i < actualPairs.getSize(); ++i) {
+        ASSERT(actualPairs[i]->momentStore == nullptr);
+        compareStorages(expectedPairs[i]->momentArmStore,
+                actualPairs[i]->momentArmStore);
+    }
+}
+
+void testSpannedCoordinates(bool coupled)
+{
+    cout << "Running testSpannedCoordinates (" <<
+            (coupled ? "coupled" : "uncoupled") << ")" << endl;
+
+    Model model = createModel(coupled);
+    auto* analysis = new MuscleAnalysis();
+    model.addAnalysis(analysis);
+    SimTK::State& state = model.initSystem();
+    recordPoses(model, state, {analysis});
+
+    // The moment arms at the last pose.
+    MomentArmSolver solver(model);
+    const auto& pairs = analysis->getMomentArmStorageArray();
+    const auto& muscles = model.getMuscles();
+    for (int i = 0; i < pairs.getSize(); ++i) {
+        const Coordinate& coordinate = *pairs[i]->q;
+        const StateVector& momentArms =
+                *pairs[i]->momentArmStore->getLastStateVector();
+        for (int j = 0; j < muscles.getSize(); ++j) {
+            const double expected = solver.solve(state, coordinate,
+                    muscles[j].getPath<GeometryPath>());
+            ASSERT_EQUAL(expected, momentArms.getData()[j], 1e-10);
+        }
+    }
+
+    // The muscle that spans only q2 has no moment arm about q1 unless the
+    // coordinates are coupled, and the muscles have no moment arms about q3.
+    const StateVector& q1MomentArms =
+            *pairs[0]->momentArmStore->getLastStateVector();
+    ASSERT(pairs[0]->q->getName() == "q1");
+    if (coupled) ASSERT(std::abs(q1MomentArms.getData()[0]) > 1e-3);
+    else ASSERT(q1MomentArms.getData()[0] == 0);
+    ASSERT(std::abs(q1MomentArms.getData()[1]) > 1e-3);
+    const StateVector& q3MomentArms =
+            *pairs[2]->momentArmStore->getLastStateVector();
+    ASSERT(pairs[2]->q->getName() == "q3");
+    ASSERT(q3MomentArms.getData()[0] == 0);
+    ASSERT(q3MomentArms.getData()[1] == 0);
+}
@@ -0,0 +1,169 @@
+#ifndef OPENSIM_ALLOCATION_SCOPE_H_
+#define OPENSIM_ALLOCATION_SCOPE_H_
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim: AllocationScope.h                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Counting of the heap allocations (operator new) of a scope, for tests and
+benchmarks (e.g., to check that a hot function does not allocate or to report
+the allocations per integration step):
+
+    AllocationScope scope;
+    model.realizeAcceleration(state);
+    std::cout << scope.getNumAllocations() << std::endl;
+
+The allocations are counted by replacing the global operator new of the
+executable, which applies to the whole process (including the OpenSim and
+Simbody libraries). In exactly one source file of the executable, define
+OPENSIM_ALLOCATION_SCOPE_MAIN before including this header (as with
+CATCH_CONFIG_MAIN):
+
+    #define OPENSIM_ALLOCATION_SCOPE_MAIN
+    #include <OpenSim/Auxiliary/AllocationScope.h>
+
+The allocations of all threads are counted. On Windows, each DLL has its own
+operator new, so the operator is not replaced and isAllocationCountingEnabled()
+is false; tests of the number of allocations should then be skipped. */
+
+#include <atomic>
+#include <cstdint>
+
+namespace OpenSim {
+
+namespace AllocationCounter {
+    inline std::atomic<int64_t>& numAllocations() {
+        static std::atomic<int64_t> count{0};
+        return count;
+    }
+    inline std::atomic<int64_t>& numBytesAllocated() {
+        static std::atomic<int64_t> count{0};
+        return count;
+    }
+    inline std::atomic<bool>& enabled() {
+        static std::atomic<bool> flag{false};
+        return flag;
+    }
+} // namespace AllocationCounter
+
+/// Whether the allocations are counted (that is, whether
+/// OPENSIM_ALLOCATION_SCOPE_MAIN was defined in the executable and the
+/// platform supports replacing operator new). If not, the counts of
+/// AllocationScope are always 0.
+inline bool isAllocationCountingEnabled() {
+    return AllocationCounter::enabled().load(std::memory_order_relaxed);
+}
+
+/** The number of heap allocations (calls to operator new) on all threads, and
+the number of bytes they requested, since the construction of this object or
+the last call to reset(). */
+class AllocationScope {
+public:
+    AllocationScope() { reset(); }
+    void reset() {
+        m_startAllocations = AllocationCounter::numAllocations().load(
+                std::memory_order_relaxed);
+        m_startBytes = AllocationCounter::numBytesAllocated().load(
+                std::memory_order_relaxed);
+    }
+    int64_t getNumAllocations() const {
+        return AllocationCounter::numAllocations().load(
+                       std::memory_order_relaxed) - m_startAllocations;
+    }
+    int64_t getNumBytesAllocated() const {
+        return AllocationCounter::numBytesAllocated().load(
+                       std::memory_order_relaxed) - m_startBytes;
+    }
+private:
+    int64_t m_startAllocations;
+    int64_t m_startBytes;
+};
+
+} // namespace OpenSim
+
+#if defined(OPENSIM_ALLOCATION_SCOPE_MAIN) && !defined(_WIN32)
+
+#include <cstdlib>
+#include <new>
+
+namespace OpenSim {
+namespace AllocationCounter {
+    inline void* allocate(std::size_t size) {
+        numAllocations().fetch_add(1, std::memory_order_relaxed);
+        numBytesAllocated().fetch_add((int64_t)size,
+                std::memory_order_relaxed);
+        // malloc(0) may return null, but operator new may not.
+        return std::malloc(size ? size : 1);
+    }
+    // Mark the counting as enabled before main() runs.
+    static const bool s_enabled = (enabled() = true);
+} // namespace AllocationCounter
+} // namespace OpenSim
+
+// The operators are not inlined into the code of this file, since the
+// compiler would then warn that memory from operator new is passed to free().
+#if defined(__GNUC__)
+#define OPENSIM_ALLOCATION_SCOPE_NOINLINE __attribute__((noinline))
+#else
+#define OPENSIM_ALLOCATION_SCOPE_NOINLINE
+#endif
+
+OPENSIM_ALLOCATION_SCOPE_NOINLINE
+void* operator new(std::size_t size) {
+    void* ptr = OpenSim::AllocationCounter::allocate(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+OPENSIM_ALLOCATION_SCOPE_NOINLINE
+void* operator new[](std::size_t size) {
+    void* ptr = OpenSim::AllocationCounter::allocate(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+OPENSIM_ALLOCATION_SCOPE_NOINLINE
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return OpenSim::AllocationCounter::allocate(size);
+}
+OPENSIM_ALLOCATION_SCOPE_NOINLINE
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return OpenSim::AllocationCounter::allocate(size);
+}
+OPENSIM_ALLOCATION_SCOPE_NOINLINE
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+OPENSIM_ALLOCATION_SCOPE_NOINLINE
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+OPENSIM_ALLOCATION_SCOPE_NOINLINE
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+OPENSIM_ALLOCATION_SCOPE_NOINLINE
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+#undef OPENSIM_ALLOCATION_SCOPE_NOINLINE
+
+#endif
+
+#endif // OPENSIM_ALLOCATION_SCOPE_H_
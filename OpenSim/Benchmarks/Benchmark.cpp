@@ -0,0 +1,253 @@
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim: Benchmark.cpp                             *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Benchmark.h"
+
+#include <OpenSim/Common/About.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+
+using namespace OpenSim;
+
+//=============================================================================
+// BenchmarkState
+//=============================================================================
+void BenchmarkState::pauseTiming() {
+    if (!m_running) return;
+    m_elapsed += std::chrono::duration<double>(Clock::now() - m_start).count();
+    m_allocations += m_allocationScope.getNumAllocations();
+    m_bytes += m_allocationScope.getNumBytesAllocated();
+    m_running = false;
+}
+
+void BenchmarkState::resumeTiming() {
+    if (m_running) return;
+    m_running = true;
+    m_allocationScope.reset();
+    m_start = Clock::now();
+}
+
+//=============================================================================
+// BenchmarkRunner
+//=============================================================================
+namespace {
+    double median(std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        const size_t n = values.size();
+        return n % 2 ? values[n / 2]
+                     : 0.5 * (values[n / 2 - 1] + values[n / 2]);
+    }
+
+    std::string escapeJSON(const std::string& s) {
+        std::string escaped;
+        for (char c : s) {
+            if (c == '"' || c == '\\') {
+                escaped += '\\';
+                escaped += c;
+            } else if ((unsigned char)c < 0x20) {
+                char buffer[8];
+                std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                escaped += buffer;
+            } else {
+                escaped += c;
+            }
+        }
+        return escaped;
+    }
+}
+
+BenchmarkRunner::BenchmarkRunner(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--list") {
+            m_list = true;
+        } else if (arg == "--filter" && hasValue) {
+            m_filter = argv[++i];
+        } else if (arg == "--json" && hasValue) {
+            m_jsonFile = argv[++i];
+        } else if (arg == "--min-time" && hasValue) {
+            m_minTime = std::atof(argv[++i]);
+        } else if (arg == "--repetitions" && hasValue) {
+            m_numRepetitions = std::atoi(argv[++i]);
+            if (m_numRepetitions < 1) {
+                m_error = "Expected a positive number of repetitions.";
+            }
+        } else {
+            m_error = "Unrecognized or incomplete option '" + arg + "'.";
+        }
+    }
+}
+
+void BenchmarkRunner::add(const std::string& name, Function function) {
+    m_benchmarks.emplace_back(name, std::move(function));
+}
+
+void BenchmarkRunner::runBenchmark(const std::string& name,
+        const Function& function, Result& result) const {
+    result.name = name;
+
+    std::vector<double> allocations;
+    std::vector<double> bytes;
+    int numIterations = 1;
+    const auto record = [&](const BenchmarkState& state) {
+        result.secondsPerIteration.push_back(state.m_elapsed / numIterations);
+        allocations.push_back((double)state.m_allocations / numIterations);
+        bytes.push_back((double)state.m_bytes / numIterations);
+    };
+
+    // Find the number of iterations that take at least the minimum time,
+    // growing it at most tenfold at a time, since the first iterations are
+    // slower (the caches are cold). The last of these runs is the first
+    // repetition.
+    while (true) {
+        BenchmarkState state(numIterations);
+        function(state);
+        if (state.m_elapsed >= m_minTime || numIterations >= 1000000000) {
+            record(state);
+            break;
+        }
+        const double factor = 1.4 * m_minTime / std::max(state.m_elapsed,
+                1e-9);
+        numIterations = (int)std::min(
+                std::ceil(numIterations * std::min(factor, 10.0)), 1e9);
+    }
+    result.numIterations = numIterations;
+
+    for (int irep = 1; irep < m_numRepetitions; ++irep) {
+        BenchmarkState state(numIterations);
+        function(state);
+        record(state);
+    }
+    result.allocationsPerIteration = median(allocations);
+    result.bytesPerIteration = median(bytes);
+}
+
+int BenchmarkRunner::run() {
+    if (!m_error.empty()) {
+        std::cerr << m_error << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::regex filter(m_filter);
+    int status = EXIT_SUCCESS;
+    std::vector<Result> results;
+    if (!m_list) {
+        std::cout << std::left << std::setw(56) << "benchmark" << std::right
+                  << std::setw(14) << "ns/iter" << std::setw(12)
+                  << "iterations" << std::setw(12) << "allocs/iter"
+                  << std::setw(14) << "bytes/iter" << std::endl;
+    }
+    for (const auto& benchmark : m_benchmarks) {
+        const std::string& name = benchmark.first;
+        if (!std::regex_search(name, filter)) continue;
+        if (m_list) {
+            std::cout << name << std::endl;
+            continue;
+        }
+        Result result;
+        try {
+            runBenchmark(name, benchmark.second, result);
+        } catch (const std::exception& e) {
+            std::cerr << name << " failed: " << e.what() << std::endl;
+            status = EXIT_FAILURE;
+            continue;
+        }
+        std::cout << std::left << std::setw(56) << name << std::right
+                  << std::fixed << std::setprecision(0) << std::setw(14)
+                  << 1e9 * median(result.secondsPerIteration)
+                  << std::setw(12) << result.numIterations;
+        if (isAllocationCountingEnabled()) {
+            std::cout << std::setprecision(1) << std::setw(12)
+                      << result.allocationsPerIteration << std::setw(14)
+                      << result.bytesPerIteration;
+        }
+        std::cout << std::endl;
+        results.push_back(result);
+    }
+    if (!m_list && !m_jsonFile.empty()) writeJSON(results);
+    return status;
+}
+
+void BenchmarkRunner::writeJSON(const std::vector<Result>& results) const {
+    std::ofstream out(m_jsonFile);
+    if (!out) {
+        std::cerr << "Could not open '" << m_jsonFile << "'." << std::endl;
+        return;
+    }
+    char date[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ",
+            std::gmtime(&now));
+#ifdef NDEBUG
+    const std::string buildType = "release";
+#else
+    const std::string buildType = "debug";
+#endif
+
+    out << std::setprecision(10);
+    out << "{\n";
+    out << "  \"context\": {\n";
+    out << "    \"date\": \"" << date << "\",\n";
+    out << "    \"opensim_version\": \"" << escapeJSON(GetVersionAndDate())
+        << "\",\n";
+    out << "    \"build_type\": \"" << buildType << "\",\n";
+    out << "    \"min_time\": " << m_minTime << ",\n";
+    out << "    \"repetitions\": " << m_numRepetitions << "\n";
+    out << "  },\n";
+    out << "  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& result = results[i];
+        const auto& seconds = result.secondsPerIteration;
+        out << (i ? ",\n" : "\n");
+        out << "    {\n";
+        out << "      \"name\": \"" << escapeJSON(result.name) << "\",\n";
+        out << "      \"iterations\": " << result.numIterations << ",\n";
+        out << "      \"ns_per_iteration\": " << 1e9 * median(seconds)
+            << ",\n";
+        out << "      \"ns_per_iteration_min\": "
+            << 1e9 * *std::min_element(seconds.begin(), seconds.end())
+            << ",\n";
+        out << "      \"ns_per_iteration_max\": "
+            << 1e9 * *std::max_element(seconds.begin(), seconds.end())
+            << ",\n";
+        if (isAllocationCountingEnabled()) {
+            out << "      \"allocations_per_iteration\": "
+                << result.allocationsPerIteration << ",\n";
+            out << "      \"bytes_allocated_per_iteration\": "
+                << result.bytesPerIteration << "\n";
+        } else {
+            out << "      \"allocations_per_iteration\": null,\n";
+            out << "      \"bytes_allocated_per_iteration\": null\n";
+        }
+        out << "    }";
+    }
+    out << "\n  ]\n";
+    out << "}\n";
+}
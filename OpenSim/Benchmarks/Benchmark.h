@@ -0,0 +1,147 @@
+#ifndef OPENSIM_BENCHMARK_H_
+#define OPENSIM_BENCHMARK_H_
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim: Benchmark.h                              *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* A minimal benchmark harness, in the style of Google Benchmark, so that the
+benchmarks need no dependency beyond OpenSim. A benchmark is a function that
+does its (untimed) setup and then loops while keepRunning() returns true; only
+the loop is timed:
+
+    void benchmarkInitSystem(BenchmarkState& state) {
+        Model model("arm26.osim");
+        while (state.keepRunning()) model.initSystem();
+    }
+
+    int main(int argc, char* argv[]) {
+        BenchmarkRunner runner(argc, argv);
+        runner.add("Model/initSystem/arm26", benchmarkInitSystem);
+        return runner.run();
+    }
+
+The runner calls each benchmark with an increasing number of iterations until
+the iterations take at least the minimum time, and then calls it again for
+each remaining repetition with that number of iterations. It reports the median
+(and the minimum and maximum) over the repetitions of the wall-clock time per
+iteration, and the number of heap allocations (operator new) and bytes
+allocated per iteration, in a table and, with --json, as a JSON file.
+Allocations are counted on all threads with AllocationScope (see
+BenchmarkAllocations.cpp); on Windows, where they cannot be counted, they are
+null in the JSON file.
+
+Command-line options:
+    --filter <regex>     Run only the benchmarks whose names match.
+    --json <file>        Write the results to a JSON file.
+    --min-time <s>       Minimum time of each repetition (default: 0.5).
+    --repetitions <n>    Number of repetitions (default: 5).
+    --list               List the names of the benchmarks. */
+
+#include <OpenSim/Auxiliary/AllocationScope.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+/** The state of one repetition of a benchmark, which counts the iterations
+and measures the time and allocations of the timed loop. */
+class BenchmarkState {
+public:
+    /** Returns true if the loop should run another iteration. The first call
+    starts the timer and the last call (which returns false) stops it. */
+    bool keepRunning() {
+        if (m_numIterationsDone == 0 && !m_running) resumeTiming();
+        if (m_numIterationsDone < m_numIterations) {
+            ++m_numIterationsDone;
+            return true;
+        }
+        pauseTiming();
+        return false;
+    }
+    /** Exclude the code between pauseTiming() and resumeTiming() (e.g.,
+    preparing the input of the next iteration) from the time and the
+    allocations. This costs about as much as reading the clock twice. */
+    void pauseTiming();
+    void resumeTiming();
+
+    int getNumIterations() const { return m_numIterations; }
+
+private:
+    friend class BenchmarkRunner;
+    explicit BenchmarkState(int numIterations)
+            : m_numIterations(numIterations) {}
+
+    typedef std::chrono::steady_clock Clock;
+    int m_numIterations;
+    int m_numIterationsDone = 0;
+    bool m_running = false;
+    Clock::time_point m_start;
+    double m_elapsed = 0;
+    AllocationScope m_allocationScope;
+    int64_t m_allocations = 0;
+    int64_t m_bytes = 0;
+};
+
+/** Runs the benchmarks that were added, as selected by the command-line
+options, and reports the results. */
+class BenchmarkRunner {
+public:
+    typedef std::function<void(BenchmarkState&)> Function;
+
+    BenchmarkRunner(int argc, char* argv[]);
+
+    /** Add a benchmark. The names are of the form
+    "<class or area>/<operation>/<input>". */
+    void add(const std::string& name, Function function);
+
+    /** Run the selected benchmarks. Returns the exit code of the program
+    (nonzero if the command-line options are invalid or a benchmark threw). */
+    int run();
+
+private:
+    struct Result {
+        std::string name;
+        int numIterations = 0;
+        std::vector<double> secondsPerIteration;
+        double allocationsPerIteration = 0;
+        double bytesPerIteration = 0;
+    };
+
+    void runBenchmark(const std::string& name, const Function& function,
+            Result& result) const;
+    void writeJSON(const std::vector<Result>& results) const;
+
+    std::vector<std::pair<std::string, Function>> m_benchmarks;
+    std::string m_filter;
+    std::string m_jsonFile;
+    double m_minTime = 0.5;
+    int m_numRepetitions = 5;
+    bool m_list = false;
+    std::string m_error;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_BENCHMARK_H_
@@ -0,0 +1,595 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim: benchmarkOpenSim.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Benchmarks of the hot paths of OpenSim with the models and data that are
+distributed with the tests, and with the models of
+ModelFactory::createScalableModel() of increasing size (see Benchmark.h for
+the options). Run them with the `benchmarks` target, which writes
+benchmarks.json to the build directory, or run this executable from its build
+directory (which contains the data). */
+
+#include "Benchmark.h"
+
+#include <OpenSim/OpenSim.h>
+#ifdef OPENSIM_WITH_CASADI
+#include <OpenSim/Moco/osimMoco.h>
+#endif
+
+using namespace OpenSim;
+
+namespace {
+
+const std::string arm26 = "arm26.osim";
+const std::string gait10dof18musc = "gait10dof18musc_subject01.osim";
+
+/// Two poses near the default pose of the model, so that alternating between
+/// them invalidates the positions without leaving the usual range of motion.
+void createPoses(const Model& model, const SimTK::State& state,
+        SimTK::Vector& q0, SimTK::Vector& q1) {
+    q0 = state.getQ();
+    SimTK::State perturbed = state;
+    for (const auto& coord : model.getComponentList<Coordinate>()) {
+        if (coord.getMotionType() == Coordinate::Rotational &&
+                !coord.getLocked(perturbed)) {
+            coord.setValue(perturbed, coord.getValue(perturbed) + 0.05, false);
+        }
+    }
+    q1 = perturbed.getQ();
+}
+
+void benchmarkLoadModel(BenchmarkState& state, const std::string& file) {
+    while (state.keepRunning()) {
+        Model model(file);
+    }
+}
+
+void benchmarkInitSystem(BenchmarkState& state, const std::string& file) {
+    Model model(file);
+    model.initSystem();
+    while (state.keepRunning()) {
+        model.initSystem();
+    }
+}
+
+void benchmarkRealizePosition(BenchmarkState& state, const std::string& file) {
+    Model model(file);
+    SimTK::State s = model.initSystem();
+    SimTK::Vector q0, q1;
+    createPoses(model, s, q0, q1);
+    int i = 0;
+    while (state.keepRunning()) {
+        s.updQ() = (i++ % 2) ? q1 : q0;
+        model.realizePosition(s);
+    }
+}
+
+/// The lengths of the paths of all the muscles (GeometryPath::computePath(),
+/// including wrapping), excluding the realization of the kinematics.
+void benchmarkPathLengths(BenchmarkState& state, const std::string& file) {
+    Model model(file);
+    SimTK::State s = model.initSystem();
+    SimTK::Vector q0, q1;
+    createPoses(model, s, q0, q1);
+    std::vector<const GeometryPath*> paths;
+    for (const auto& muscle : model.getComponentList<Muscle>()) {
+        paths.push_back(&muscle.getGeometryPath());
+    }
+    int i = 0;
+    double length = 0;
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        s.updQ() = (i++ % 2) ? q1 : q0;
+        model.realizePosition(s);
+        state.resumeTiming();
+        for (const auto* path : paths) length += path->getLength(s);
+    }
+    if (SimTK::isNaN(length)) throw Exception("The path lengths are NaN.");
+}
+
+/// The forces and the state derivatives of the muscles (including
+/// Muscle::computeStateVariableDerivatives()) and of the multibody system,
+/// excluding the realization of the kinematics.
+void benchmarkRealizeAcceleration(
+        BenchmarkState& state, const std::string& file) {
+    Model model(file);
+    SimTK::State s = model.initSystem();
+    for (const auto& muscle : model.getComponentList<Muscle>()) {
+        muscle.setActivation(s, 0.2);
+    }
+    model.equilibrateMuscles(s);
+    model.realizeVelocity(s);
+    while (state.keepRunning()) {
+        s.invalidateAllCacheAtOrAbove(SimTK::Stage::Dynamics);
+        model.realizeAcceleration(s);
+    }
+}
+
+/// Model::equilibrateMuscles() with a full-body number of muscles: each
+/// muscle of the model is copied (with its path) to make `numMuscles` muscles.
+void benchmarkEquilibrateMuscles(BenchmarkState& state,
+        const std::string& file, int numMuscles, int numThreads) {
+    Model model(file);
+    model.finalizeConnections();
+    std::vector<const Muscle*> originals;
+    for (const auto& muscle : model.getComponentList<Muscle>()) {
+        originals.push_back(&muscle);
+    }
+    for (int i = (int)originals.size(); i < numMuscles; ++i) {
+        Muscle* copy = originals[i % originals.size()]->clone();
+        copy->setName(copy->getName() + "_copy" + std::to_string(i));
+        model.addForce(copy);
+    }
+    SimTK::State s = model.initSystem();
+    for (const auto& muscle : model.getComponentList<Muscle>()) {
+        muscle.setActivation(s, 0.2);
+    }
+    model.realizeVelocity(s);
+    const SimTK::State initial = s;
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        s = initial;
+        state.resumeTiming();
+        model.equilibrateMuscles(s, numThreads);
+    }
+}
+
+/// CMCTool::run() over the first 0.1 s of the walk of the CMC tests, with
+/// analyses that record the kinematics and forces, performed on the
+/// integrating thread or on a separate thread that overlaps with the
+/// optimizations of the controller (use_concurrent_analyses).
+void benchmarkCMC(BenchmarkState& state, bool concurrentAnalyses) {
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        CMCTool cmc("gait10dof18musc_Setup_CMC.xml");
+        cmc.setFinalTime(0.7);
+        cmc.setUseConcurrentAnalyses(concurrentAnalyses);
+        cmc.setResultsDir(concurrentAnalyses ? "benchmarkCMC_concurrent"
+                                             : "benchmarkCMC_serial");
+        cmc.updAnalysisSet().adoptAndAppend(new Kinematics());
+        cmc.updAnalysisSet().adoptAndAppend(new BodyKinematics());
+        cmc.updAnalysisSet().adoptAndAppend(new Actuation());
+        cmc.updAnalysisSet().adoptAndAppend(new ForceReporter());
+        state.resumeTiming();
+        if (!cmc.run()) throw Exception("CMCTool failed.");
+    }
+}
+
+/// The generalized forces of a TaskSpaceController with tasks for the feet and
+/// the torso of a full-body model (gait2354, 23 degrees of freedom) at
+/// alternating poses, including the task-space inertia but excluding the
+/// realization of the kinematics. A 1 kHz control loop leaves 1 ms for this.
+void benchmarkTaskSpaceController(BenchmarkState& state) {
+    Model model("subject01.osim");
+    auto* controller = new TaskSpaceController();
+    for (const std::string body : {"calcn_r", "calcn_l", "torso"}) {
+        controller->addTask(new StationTask(body,
+                model.getBodySet().get(body), SimTK::Vec3(0),
+                SimTK::Vec3(0, 1, 0)));
+    }
+    model.addForce(controller);
+    SimTK::State s = model.initSystem();
+    SimTK::Vector q0, q1;
+    createPoses(model, s, q0, q1);
+    int i = 0;
+    double sum = 0;
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        s.updQ() = (i++ % 2) ? q1 : q0;
+        model.realizeVelocity(s);
+        state.resumeTiming();
+        sum += controller->calcGeneralizedForces(s).norm();
+    }
+    if (SimTK::isNaN(sum)) throw Exception("The generalized forces are NaN.");
+}
+
+/// Recording a MuscleAnalysis at alternating poses, with all its quantities
+/// or only the fiber lengths and moment arms.
+void benchmarkMuscleAnalysis(BenchmarkState& state, bool allQuantities) {
+    Model model(gait10dof18musc);
+    auto* analysis = new MuscleAnalysis();
+    if (!allQuantities) {
+        Array<std::string> quantities;
+        quantities.append("FiberLength");
+        quantities.append("MomentArm");
+        analysis->setQuantities(quantities);
+    }
+    model.addAnalysis(analysis);
+    SimTK::State s = model.initSystem();
+    SimTK::Vector q0, q1;
+    createPoses(model, s, q0, q1);
+    analysis->begin(s);
+    int i = 0;
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        s.updQ() = (i++ % 2) ? q1 : q0;
+        model.realizeVelocity(s);
+        state.resumeTiming();
+        analysis->step(s, i);
+    }
+}
+
+void benchmarkReadSTO(BenchmarkState& state, const std::string& file) {
+    while (state.keepRunning()) {
+        const TimeSeriesTable table(file);
+        if (table.getNumRows() == 0) throw Exception("The table is empty.");
+    }
+}
+
+/// The Jacobian of a ConstantCurvatureJoint and its time derivative, which
+/// the mobilizer computes for each multiplication by H and by the transpose
+/// of its time derivative, at a bent configuration.
+void benchmarkConstantCurvatureJacobian(BenchmarkState& state) {
+    const SimTK::Vec3 q(0.5, 0.5, 0.5);
+    const SimTK::Vec3 qDot(0.1, 0.2, 0.3);
+    double sum = 0;
+    while (state.keepRunning()) {
+        sum += ConstantCurvatureJoint::getConstantCurveJacobian(q, 0.2)(3, 0);
+        sum += ConstantCurvatureJoint::getConstantCurveJacobianDerivWrtTime(
+                q, qDot, 0.2)(3, 0);
+    }
+    if (SimTK::isNaN(sum)) throw Exception("The Jacobian is NaN.");
+}
+
+/// Setting the values of all the independent coordinates of a model with
+/// coupled knees (a CoordinateCouplerConstraint per knee) at alternating
+/// poses, enforcing the constraints, either one coordinate at a time (with
+/// Coordinate::setValue(), which assembles the model for each coordinate) or
+/// all at once (with Model::setCoordinateValues(), which assembles it once).
+void benchmarkSetCoordinateValues(BenchmarkState& state, bool bulk) {
+    Model model("subject_walk_armless_18musc.osim");
+    SimTK::State s = model.initSystem();
+    std::vector<int> indices;
+    SimTK::Vector values0, values1;
+    const CoordinateSet& coords = model.getCoordinateSet();
+    for (int i = 0; i < coords.getSize(); ++i) {
+        if (!coords[i].isDependent(s)) indices.push_back(i);
+    }
+    values0.resize((int)indices.size());
+    values1.resize((int)indices.size());
+    for (int i = 0; i < (int)indices.size(); ++i) {
+        const Coordinate& coord = coords[indices[i]];
+        values0[i] = coord.getValue(s);
+        values1[i] = values0[i] +
+                (coord.getMotionType() == Coordinate::Rotational ? 0.05 : 0);
+    }
+    int i = 0;
+    while (state.keepRunning()) {
+        const SimTK::Vector& values = (i++ % 2) ? values1 : values0;
+        if (bulk) {
+            model.setCoordinateValues(s, indices, values);
+        } else {
+            for (int j = 0; j < (int)indices.size(); ++j) {
+                coords[indices[j]].setValue(s, values[j]);
+            }
+        }
+    }
+}
+
+/// The StatesTrajectory (or CompactStatesTrajectory) of a states file of a
+/// full-body model (gait2354 with 54 muscles), as in AnalyzeTool.
+template <typename Trajectory>
+void benchmarkCreateStatesTrajectory(BenchmarkState& state) {
+    Model model("subject01.osim");
+    model.initSystem();
+    const TimeSeriesTable table("std_subject01_walk1_states.sto");
+    while (state.keepRunning()) {
+        const Trajectory states =
+                Trajectory::createFromStatesTable(model, table, true, true);
+        if (states.getSize() == 0) throw Exception("No states were created.");
+    }
+}
+
+/// The sizes of the models of ModelFactory::createScalableModel() for the
+/// benchmarks of the scaling with the size of a model, from a limb to a full
+/// body with wrapping and foot contact.
+struct ScalableModelSize {
+    int numBodies;
+    int numMuscles;
+    bool wrap;
+    int numContactSpheres;
+};
+const std::vector<ScalableModelSize> scalableModelSizes{
+        {5, 20, false, 0}, {10, 50, true, 4}, {20, 100, true, 8},
+        {40, 300, true, 12}};
+
+std::string getName(const ScalableModelSize& size) {
+    return "scalable_" + std::to_string(size.numBodies) + "bodies_" +
+           std::to_string(size.numMuscles) + "muscles" +
+           (size.wrap ? "_wrap" : "") +
+           (size.numContactSpheres
+                           ? "_" + std::to_string(size.numContactSpheres) +
+                                     "spheres"
+                           : "");
+}
+
+Model createScalableModel(const ScalableModelSize& size) {
+    return ModelFactory::createScalableModel(size.numBodies, size.numMuscles,
+            4, size.wrap, size.numContactSpheres);
+}
+
+void benchmarkScalableInitSystem(
+        BenchmarkState& state, const ScalableModelSize& size) {
+    Model model = createScalableModel(size);
+    model.initSystem();
+    while (state.keepRunning()) {
+        model.initSystem();
+    }
+}
+
+/// As benchmarkRealizeAcceleration(), with a model of the given size.
+void benchmarkScalableRealizeAcceleration(
+        BenchmarkState& state, const ScalableModelSize& size) {
+    Model model = createScalableModel(size);
+    SimTK::State s = model.initSystem();
+    for (const auto& muscle : model.getComponentList<Muscle>()) {
+        muscle.setActivation(s, 0.2);
+    }
+    model.equilibrateMuscles(s);
+    model.realizeVelocity(s);
+    while (state.keepRunning()) {
+        s.invalidateAllCacheAtOrAbove(SimTK::Stage::Dynamics);
+        model.realizeAcceleration(s);
+    }
+}
+
+/// Manager::integrate() over 0.05 s of the passive model (the chain falls
+/// under gravity from its default pose).
+void benchmarkScalableIntegrate(
+        BenchmarkState& state, const ScalableModelSize& size) {
+    Model model = createScalableModel(size);
+    SimTK::State s = model.initSystem();
+    for (const auto& muscle : model.getComponentList<Muscle>()) {
+        muscle.setActivation(s, 0.05);
+    }
+    model.equilibrateMuscles(s);
+    const SimTK::State initial = s;
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        s = initial;
+        Manager manager(model);
+        manager.initialize(s);
+        state.resumeTiming();
+        manager.integrate(0.05);
+    }
+}
+
+#ifdef OPENSIM_WITH_CASADI
+void benchmarkMocoInverse(BenchmarkState& state) {
+    MocoInverse inverse;
+    ModelProcessor modelProcessor =
+            ModelProcessor("subject_walk_armless_18musc.osim") |
+            ModOpReplaceJointsWithWelds(
+                    {"subtalar_r", "subtalar_l", "mtp_r", "mtp_l"}) |
+            ModOpReplaceMusclesWithDeGrooteFregly2016() |
+            ModOpIgnorePassiveFiberForcesDGF() |
+            ModOpTendonComplianceDynamicsModeDGF("implicit") |
+            ModOpAddExternalLoads("subject_walk_armless_external_loads.xml");
+    inverse.setModel(modelProcessor);
+    inverse.setKinematics(
+            TableProcessor("subject_walk_armless_coordinates.mot") |
+            TabOpLowPassFilter(6));
+    inverse.set_initial_time(0.450);
+    inverse.set_final_time(1.0);
+    inverse.set_kinematics_allow_extra_columns(true);
+    inverse.set_mesh_interval(0.05);
+    inverse.set_constraint_tolerance(1e-4);
+    inverse.set_convergence_tolerance(1e-4);
+    while (state.keepRunning()) {
+        const MocoInverseSolution solution = inverse.solve();
+        if (!solution.getMocoSolution().success()) {
+            throw Exception("MocoInverse failed.");
+        }
+    }
+}
+
+/// MocoInverse with a model of the given size, which tracks the same
+/// sinusoidal motion of each coordinate over 0.5 s.
+void benchmarkScalableMocoInverse(
+        BenchmarkState& state, const ScalableModelSize& size) {
+    Model model = createScalableModel(size);
+    std::vector<std::string> labels;
+    for (int i = 0; i < size.numBodies; ++i) {
+        const std::string istr = std::to_string(i);
+        labels.push_back("/jointset/j" + istr + "/q" + istr + "/value");
+    }
+    const int numRows = 51;
+    std::vector<double> times(numRows);
+    SimTK::Matrix values(numRows, size.numBodies);
+    for (int j = 0; j < numRows; ++j) {
+        times[j] = 0.01 * j;
+        for (int i = 0; i < size.numBodies; ++i) {
+            values(j, i) = 0.2 * std::sin(2 * SimTK::Pi * times[j] + 0.1 * i);
+        }
+    }
+    TimeSeriesTable kinematics(times, values, labels);
+
+    MocoInverse inverse;
+    inverse.setModel(ModelProcessor(model) |
+                     ModOpReplaceMusclesWithDeGrooteFregly2016() |
+                     ModOpIgnorePassiveFiberForcesDGF() |
+                     ModOpAddReserves(100));
+    inverse.setKinematics(TableProcessor(kinematics));
+    inverse.set_initial_time(0);
+    inverse.set_final_time(0.5);
+    inverse.set_mesh_interval(0.05);
+    inverse.set_constraint_tolerance(1e-4);
+    inverse.set_convergence_tolerance(1e-4);
+    while (state.keepRunning()) {
+        const MocoInverseSolution solution = inverse.solve();
+        if (!solution.getMocoSolution().success()) {
+            throw Exception("MocoInverse failed.");
+        }
+    }
+}
+
+/// A double pendulum whose coordinates are coupled by a
+/// CoordinateCouplerConstraint, so that each evaluation of the multibody
+/// dynamics also applies the constraint forces of the multipliers and, with
+/// Hermite-Simpson, the velocity correction.
+void benchmarkMocoCoordinateCoupler(BenchmarkState& state) {
+    Model model = ModelFactory::createDoublePendulum();
+    auto* constraint = new CoordinateCouplerConstraint();
+    Array<std::string> indepCoordNames;
+    indepCoordNames.append("q0");
+    constraint->setIndependentCoordinateNames(indepCoordNames);
+    constraint->setDependentCoordinateName("q1");
+    LinearFunction linFunc(-2, SimTK::Pi);
+    constraint->setFunction(&linFunc);
+    model.addConstraint(constraint);
+    model.finalizeConnections();
+
+    MocoStudy study;
+    MocoProblem& problem = study.updProblem();
+    problem.setModelAsCopy(model);
+    problem.setTimeBounds(0, 1);
+    problem.setStateInfo("/jointset/j0/q0/value", {-5, 5}, 0, SimTK::Pi / 2);
+    problem.setStateInfo("/jointset/j0/q0/speed", {-10, 10}, 0, 0);
+    problem.setStateInfo("/jointset/j1/q1/value", {-10, 10});
+    problem.setStateInfo("/jointset/j1/q1/speed", {-5, 5}, 0, 0);
+    problem.setControlInfo("/tau0", {-50, 50});
+    problem.setControlInfo("/tau1", {-50, 50});
+    problem.addGoal<MocoControlGoal>();
+
+    auto& solver = study.initCasADiSolver();
+    solver.set_num_mesh_intervals(20);
+    solver.set_verbosity(0);
+    solver.set_optim_convergence_tolerance(1e-3);
+    solver.set_transcription_scheme("hermite-simpson");
+    solver.set_minimize_lagrange_multipliers(true);
+    solver.set_lagrange_multiplier_weight(10);
+    solver.setGuess("bounds");
+    while (state.keepRunning()) {
+        const MocoSolution solution = study.solve();
+        if (!solution.success()) {
+            throw Exception("The coordinate coupler problem failed.");
+        }
+    }
+}
+#endif
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    // Missing geometry files and the like need not be reported.
+    Logger::setLevel(Logger::Level::Error);
+
+    BenchmarkRunner runner(argc, argv);
+    for (const auto& file : {arm26, gait10dof18musc}) {
+        const std::string name = file.substr(0, file.find('.'));
+        runner.add("Model/load/" + name, [file](BenchmarkState& state) {
+            benchmarkLoadModel(state, file);
+        });
+        runner.add("Model/initSystem/" + name, [file](BenchmarkState& state) {
+            benchmarkInitSystem(state, file);
+        });
+        runner.add("Model/realizePosition/" + name,
+                [file](BenchmarkState& state) {
+                    benchmarkRealizePosition(state, file);
+                });
+        runner.add("GeometryPath/getLength/" + name,
+                [file](BenchmarkState& state) {
+                    benchmarkPathLengths(state, file);
+                });
+        runner.add("Model/realizeAcceleration/" + name,
+                [file](BenchmarkState& state) {
+                    benchmarkRealizeAcceleration(state, file);
+                });
+    }
+    for (int numThreads : {1, -1}) {
+        runner.add("Model/equilibrateMuscles/gait10dof18musc_300muscles/" +
+                        std::string(numThreads == 1 ? "serial" : "parallel"),
+                [numThreads](BenchmarkState& state) {
+                    benchmarkEquilibrateMuscles(
+                            state, gait10dof18musc, 300, numThreads);
+                });
+    }
+    for (bool concurrentAnalyses : {false, true}) {
+        runner.add("CMCTool/run/gait10dof18musc/" +
+                        std::string(concurrentAnalyses ? "concurrent_analyses"
+                                                       : "serial_analyses"),
+                [concurrentAnalyses](BenchmarkState& state) {
+                    benchmarkCMC(state, concurrentAnalyses);
+                });
+    }
+    for (bool allQuantities : {true, false}) {
+        runner.add("MuscleAnalysis/record/gait10dof18musc/" +
+                        std::string(allQuantities ? "all_quantities"
+                                                  : "fiber_lengths_moment_arms"),
+                [allQuantities](BenchmarkState& state) {
+                    benchmarkMuscleAnalysis(state, allQuantities);
+                });
+    }
+    runner.add("TaskSpaceController/calcGeneralizedForces/subject01_3tasks",
+            benchmarkTaskSpaceController);
+    for (const std::string file : {"std_subject01_walk1_states.sto",
+                 "subject_walk_armless_coordinates.mot"}) {
+        const std::string name = file.substr(0, file.find('.'));
+        runner.add("STOFileAdapter/read/" + name,
+                [file](BenchmarkState& state) {
+                    benchmarkReadSTO(state, file);
+                });
+    }
+    runner.add("ConstantCurvatureJoint/getConstantCurveJacobian",
+            benchmarkConstantCurvatureJacobian);
+    for (bool bulk : {false, true}) {
+        runner.add(std::string(bulk ? "Model/setCoordinateValues"
+                                    : "Coordinate/setValue") +
+                        "/subject_walk_armless_18musc",
+                [bulk](BenchmarkState& state) {
+                    benchmarkSetCoordinateValues(state, bulk);
+                });
+    }
+    for (const auto& size : scalableModelSizes) {
+        const std::string name = getName(size);
+        runner.add("Model/initSystem/" + name,
+                [size](BenchmarkState& state) {
+                    benchmarkScalableInitSystem(state, size);
+                });
+        runner.add("Model/realizeAcceleration/" + name,
+                [size](BenchmarkState& state) {
+                    benchmarkScalableRealizeAcceleration(state, size);
+                });
+        runner.add("Manager/integrate/" + name,
+                [size](BenchmarkState& state) {
+                    benchmarkScalableIntegrate(state, size);
+                });
+    }
+    runner.add("StatesTrajectory/createFromStatesTable/subject01_walk1",
+            benchmarkCreateStatesTrajectory<StatesTrajectory>);
+    runner.add("CompactStatesTrajectory/createFromStatesTable/subject01_walk1",
+            benchmarkCreateStatesTrajectory<CompactStatesTrajectory>);
+#ifdef OPENSIM_WITH_CASADI
+    runner.add("MocoInverse/solve/subject_walk_armless_18musc",
+            benchmarkMocoInverse);
+    runner.add("MocoCasADiSolver/solve/double_pendulum_coordinate_coupler",
+            benchmarkMocoCoordinateCoupler);
+    // The larger models take minutes to solve.
+    for (const ScalableModelSize& size :
+            {scalableModelSizes[0], scalableModelSizes[1]}) {
+        runner.add("MocoInverse/solve/" + getName(size),
+                [size](BenchmarkState& state) {
+                    benchmarkScalableMocoInverse(state, size);
+                });
+    }
+#endif
+    return runner.run();
+}
@@ -0,0 +1,272 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim: benchmarkPipeline.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Run the standard pipeline of tools on the walking data of the tests
+(subject01, gait2354): inverse kinematics, inverse dynamics, static
+optimization, and the joint reactions of the static optimization solution,
+and report the wall-clock time, the peak resident memory, and the bytes read
+and written by each stage.
+
+Usage:
+  benchmarkPipeline [--json <file>] [<ik> <id> <so> <jr>]
+
+The stages are run from the setup files benchmarkPipeline_Setup_*.xml in the
+working directory (the build directory of this executable), or from the four
+given setup files, so that the pipeline of a study can be measured (e.g., to
+size cluster jobs). Each stage constructs its tool from its setup file, so its
+time includes loading the model and the data.
+
+The peak resident memory (high-water mark) of each stage is measured by
+resetting it before the stage on Linux; elsewhere it is the peak of the
+process up to the end of the stage. The bytes read and written (including
+those served by the operating system's file cache) are reported on Linux and
+Windows. */
+
+#include <OpenSim/OpenSim.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace OpenSim;
+
+namespace {
+
+/// Statistics of the process; -1 if unavailable.
+struct ProcessStats {
+    int64_t peakResidentBytes = -1;
+    int64_t bytesRead = -1;
+    int64_t bytesWritten = -1;
+};
+
+#if defined(__linux__)
+/// The value of the field `key` (e.g., "VmHWM:") of a /proc file, or -1.
+int64_t readProcField(const std::string& file, const std::string& key) {
+    std::ifstream in(file);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.compare(0, key.size(), key) == 0) {
+            return std::stoll(line.substr(key.size()));
+        }
+    }
+    return -1;
+}
+#endif
+
+/// Reset the peak resident memory so that the next call to
+/// getProcessStats() reports the peak since this call. Returns false if the
+/// peak cannot be reset (it is then the peak of the process).
+bool resetPeakResidentMemory() {
+#if defined(__linux__)
+    // See the description of /proc/[pid]/clear_refs in proc(5).
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+    clearRefs.close();
+    return !clearRefs.fail();
+#else
+    return false;
+#endif
+}
+
+ProcessStats getProcessStats() {
+    ProcessStats stats;
+#if defined(__linux__)
+    const int64_t peakKB = readProcField("/proc/self/status", "VmHWM:");
+    if (peakKB >= 0) stats.peakResidentBytes = 1024 * peakKB;
+    stats.bytesRead = readProcField("/proc/self/io", "rchar:");
+    stats.bytesWritten = readProcField("/proc/self/io", "wchar:");
+#elif defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS memory;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &memory, sizeof(memory))) {
+        stats.peakResidentBytes = (int64_t)memory.PeakWorkingSetSize;
+    }
+    IO_COUNTERS io;
+    if (GetProcessIoCounters(GetCurrentProcess(), &io)) {
+        stats.bytesRead = (int64_t)io.ReadTransferCount;
+        stats.bytesWritten = (int64_t)io.WriteTransferCount;
+    }
+#elif defined(__APPLE__)
+    struct rusage usage;
+    // On macOS, ru_maxrss is in bytes.
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        stats.peakResidentBytes = (int64_t)usage.ru_maxrss;
+    }
+#endif
+    return stats;
+}
+
+struct StageResult {
+    std::string name;
+    std::string setupFile;
+    bool success = false;
+    double seconds = 0;
+    bool peakIsPerStage = false;
+    ProcessStats stats;
+};
+
+template <typename ToolType>
+StageResult runStage(const std::string& name, const std::string& setupFile) {
+    StageResult result;
+    result.name = name;
+    result.setupFile = setupFile;
+    std::cout << "Running " << name << " (" << setupFile << ")..."
+              << std::endl;
+
+    result.peakIsPerStage = resetPeakResidentMemory();
+    const ProcessStats before = getProcessStats();
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        ToolType tool(setupFile);
+        result.success = tool.run();
+    } catch (const std::exception& e) {
+        std::cerr << name << " failed: " << e.what() << std::endl;
+    }
+    result.seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    const ProcessStats after = getProcessStats();
+
+    result.stats.peakResidentBytes = after.peakResidentBytes;
+    if (before.bytesRead >= 0 && after.bytesRead >= 0) {
+        result.stats.bytesRead = after.bytesRead - before.bytesRead;
+        result.stats.bytesWritten = after.bytesWritten - before.bytesWritten;
+    }
+    return result;
+}
+
+std::string formatBytes(int64_t bytes) {
+    if (bytes < 0) return "-";
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.1f MB", bytes / 1e6);
+    return buffer;
+}
+
+std::string toJSON(int64_t value) {
+    return value < 0 ? "null" : std::to_string(value);
+}
+
+void writeJSON(const std::string& fileName,
+        const std::vector<StageResult>& results, double totalSeconds) {
+    std::ofstream out(fileName);
+    if (!out) {
+        std::cerr << "Could not open '" << fileName << "'." << std::endl;
+        return;
+    }
+    out << std::setprecision(10);
+    out << "{\n";
+    out << "  \"opensim_version\": \"" << GetVersion() << "\",\n";
+    out << "  \"total_seconds\": " << totalSeconds << ",\n";
+    out << "  \"stages\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& result = results[i];
+        out << (i ? ",\n" : "\n");
+        out << "    {\n";
+        out << "      \"name\": \"" << result.name << "\",\n";
+        out << "      \"success\": " << (result.success ? "true" : "false")
+            << ",\n";
+        out << "      \"seconds\": " << result.seconds << ",\n";
+        out << "      \"peak_resident_bytes\": "
+            << toJSON(result.stats.peakResidentBytes) << ",\n";
+        out << "      \"peak_is_per_stage\": "
+            << (result.peakIsPerStage ? "true" : "false") << ",\n";
+        out << "      \"bytes_read\": " << toJSON(result.stats.bytesRead)
+            << ",\n";
+        out << "      \"bytes_written\": "
+            << toJSON(result.stats.bytesWritten) << "\n";
+        out << "    }";
+    }
+    out << "\n  ]\n";
+    out << "}\n";
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    std::string jsonFile;
+    std::vector<std::string> setupFiles;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc) {
+            jsonFile = argv[++i];
+        } else {
+            setupFiles.push_back(arg);
+        }
+    }
+    if (setupFiles.empty()) {
+        setupFiles = {"benchmarkPipeline_Setup_IK.xml",
+                "benchmarkPipeline_Setup_ID.xml",
+                "benchmarkPipeline_Setup_StaticOptimization.xml",
+                "benchmarkPipeline_Setup_JointReaction.xml"};
+    } else if (setupFiles.size() != 4) {
+        std::cerr << "Usage: " << argv[0] << " [--json <file>] "
+                  << "[<ik-setup> <id-setup> <so-setup> <jr-setup>]"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // The progress of the tools need not be reported.
+    Logger::setLevel(Logger::Level::Warn);
+
+    std::vector<StageResult> results;
+    results.push_back(runStage<InverseKinematicsTool>(
+            "InverseKinematics", setupFiles[0]));
+    results.push_back(runStage<InverseDynamicsTool>(
+            "InverseDynamics", setupFiles[1]));
+    results.push_back(runStage<AnalyzeTool>(
+            "StaticOptimization", setupFiles[2]));
+    results.push_back(runStage<AnalyzeTool>(
+            "JointReaction", setupFiles[3]));
+
+    double totalSeconds = 0;
+    bool success = true;
+    std::cout << "\n" << std::left << std::setw(22) << "stage" << std::right
+              << std::setw(12) << "time (s)" << std::setw(14) << "peak RSS"
+              << std::setw(14) << "read" << std::setw(14) << "written"
+              << std::endl;
+    for (const auto& result : results) {
+        totalSeconds += result.seconds;
+        success = success && result.success;
+        std::cout << std::left << std::setw(22) << result.name << std::right
+                  << std::fixed << std::setprecision(3) << std::setw(12)
+                  << result.seconds << std::setw(14)
+                  << formatBytes(result.stats.peakResidentBytes)
+                  << std::setw(14) << formatBytes(result.stats.bytesRead)
+                  << std::setw(14) << formatBytes(result.stats.bytesWritten)
+                  << (result.success ? "" : "  (failed)") << std::endl;
+    }
+    std::cout << std::left << std::setw(22) << "total" << std::right
+              << std::setw(12) << totalSeconds << std::endl;
+
+    if (!jsonFile.empty()) writeJSON(jsonFile, results, totalSeconds);
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
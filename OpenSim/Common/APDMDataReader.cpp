@@ -1,5 +1,6 @@
 #include <fstream>
 #include "Simbody.h"
+#include "CommonUtilities.h"
 #include "Exception.h"
 #include "FileAdapter.h"
 #include "TimeSeriesTable.h"
@@ -32,7 +33,7 @@ APDMDataReader::extendRead(const std::string& fileName) const {
     OPENSIM_THROW_IF(fileName.empty(),
         EmptyFileName);
 
-    std::ifstream in_stream{ fileName };
+    std::ifstream in_stream{ fileName, std::ios::binary };
     OPENSIM_THROW_IF(!in_stream.good(),
         FileDoesNotExist,
         fileName);
@@ -50,15 +51,6 @@ APDMDataReader::extendRead(const std::string& fileName) const {
     std::vector<int>  orientationsIndex;
 
     int n_imus = _settings.getProperty_ExperimentalSensors().size();
-    int last_size = 1024;
-    // Will read data into pre-allocated Matrices in-memory rather than appendRow
-    // on the fly which copies the whole table on every call.
-    SimTK::Matrix_<SimTK::Quaternion> rotationsData{ last_size, n_imus };
-    SimTK::Matrix_<SimTK::Vec3> linearAccelerationData{ last_size, n_imus };
-    SimTK::Matrix_<SimTK::Vec3> magneticHeadingData{ last_size, n_imus };
-    SimTK::Matrix_<SimTK::Vec3> angularVelocityData{ last_size, n_imus };
-    std::vector<double> times;
-    times.resize(last_size);
     // We support two formats, they contain similar data but headers are different
     std::string line;
     // Line 1
@@ -120,91 +112,76 @@ APDMDataReader::extendRead(const std::string& fileName) const {
         }
     }
     // Will create a table to map 
-    // internally keep track of what data was found in input files
-    bool foundLinearAccelerationData = accIndex.size()>0;
-    bool foundMagneticHeadingData = magIndex.size()>0;
-    bool foundAngularVelocityData = gyroIndex.size()>0;
+    // internally keep track of what data was found in input files (and
+    // requested in the settings)
+    bool foundLinearAccelerationData = _settings.get_read_linear_accelerations()
+            && (int)accIndex.size() == n_imus;
+    bool foundMagneticHeadingData = _settings.get_read_magnetic_heading()
+            && (int)magIndex.size() == n_imus;
+    bool foundAngularVelocityData = _settings.get_read_angular_velocity()
+            && (int)gyroIndex.size() == n_imus;
 
     // If no Orientation data is available we'll abort
-    OPENSIM_THROW_IF((orientationsIndex.size() == 0),
+    OPENSIM_THROW_IF(((int)orientationsIndex.size() != n_imus),
         TableMissingHeader);
     // Line 4, Units unused
     std::getline(in_stream, line);
 
-    // For all tables, will create row, stitch values from different sensors then append
-    bool done = false;
+    // Read the rows into memory at once, then parse only the columns of the
+    // requested data directly into the matrices of the tables, without
+    // tokenizing the rows into strings. Rows are independent, so large files
+    // are parsed on multiple threads.
+    std::string buffer;
+    const std::vector<size_t> lines = readLines(in_stream, buffer);
+    const int rowNumber = (int)lines.size();
+    SimTK::Matrix_<SimTK::Quaternion> rotationsData{ rowNumber, n_imus };
+    SimTK::Matrix_<SimTK::Vec3> linearAccelerationData{
+            foundLinearAccelerationData ? rowNumber : 0, n_imus };
+    SimTK::Matrix_<SimTK::Vec3> magneticHeadingData{
+            foundMagneticHeadingData ? rowNumber : 0, n_imus };
+    SimTK::Matrix_<SimTK::Vec3> angularVelocityData{
+            foundAngularVelocityData ? rowNumber : 0, n_imus };
+    auto parseVec3 = [](const std::vector<const char*>& fields, int column) {
+        return SimTK::Vec3(parseField(fields, column),
+                parseField(fields, column + 1),
+                parseField(fields, column + 2));
+    };
+    // Small files are not worth the cost of creating threads.
+    const int numThreads = rowNumber < 10000 ? 1 : -1;
+    parallelForChunks(rowNumber, numThreads, [&](int, int rowBegin, int rowEnd) {
+        std::vector<const char*> fields;
+        for (int row = rowBegin; row < rowEnd; ++row) {
+            splitFields(&buffer[lines[row]], ',', fields);
+            // Cycle through the imus collating values
+            for (int imu_index = 0; imu_index < n_imus; ++imu_index) {
+                if (foundLinearAccelerationData)
+                    linearAccelerationData(row, imu_index) =
+                            parseVec3(fields, accIndex[imu_index]);
+                if (foundMagneticHeadingData)
+                    magneticHeadingData(row, imu_index) =
+                            parseVec3(fields, magIndex[imu_index]);
+                if (foundAngularVelocityData)
+                    angularVelocityData(row, imu_index) =
+                            parseVec3(fields, gyroIndex[imu_index]);
+                // Create Quaternion from values in file, assume order in file W, X, Y, Z
+                const int column = orientationsIndex[imu_index];
+                rotationsData(row, imu_index) =
+                    SimTK::Quaternion(parseField(fields, column),
+                        parseField(fields, column + 1),
+                        parseField(fields, column + 2),
+                        parseField(fields, column + 3));
+            }
+        }
+    });
+    // We could get some indication of time from file or generate time based on rate
+    // Here we use the latter mechanism.
+    std::vector<double> times(rowNumber);
     double time = 0.0;
     double timeIncrement = 1 / dataRate;
-    int rowNumber = 0;
-    while (!done){
-        // Make vectors one per table
-        TimeSeriesTableQuaternion::RowVector
-            orientation_row_vector{ n_imus, SimTK::Quaternion() };
-        TimeSeriesTableVec3::RowVector
-            accel_row_vector{ n_imus, SimTK::Vec3(SimTK::NaN) };
-        TimeSeriesTableVec3::RowVector
-            magneto_row_vector{ n_imus, SimTK::Vec3(SimTK::NaN) };
-        TimeSeriesTableVec3::RowVector
-            gyro_row_vector{ n_imus, SimTK::Vec3(SimTK::NaN) };
-        std::vector<std::string> nextRow = FileAdapter::getNextLine(in_stream, ",");
-        if (nextRow.empty()) {
-            done = true;
-            break;
-        }
-        // Cycle through the imus collating values
-        for (int imu_index = 0; imu_index < n_imus; ++imu_index) {
-            // parse gyro info from in_stream
-           if (foundLinearAccelerationData)
-                accel_row_vector[imu_index] = SimTK::Vec3(std::stod(nextRow[accIndex[imu_index]]),
-                    std::stod(nextRow[accIndex[imu_index] + 1]), std::stod(nextRow[accIndex[imu_index] + 2]));
-            if (foundMagneticHeadingData)
-                magneto_row_vector[imu_index] = SimTK::Vec3(std::stod(nextRow[magIndex[imu_index]]),
-                    std::stod(nextRow[magIndex[imu_index] + 1]), std::stod(nextRow[magIndex[imu_index] + 2]));
-            if (foundAngularVelocityData)
-                gyro_row_vector[imu_index] = SimTK::Vec3(std::stod(nextRow[gyroIndex[imu_index]]),
-                    std::stod(nextRow[gyroIndex[imu_index] + 1]), std::stod(nextRow[gyroIndex[imu_index] + 2]));
-            // Create Quaternion from values in file, assume order in file W, X, Y, Z
-            orientation_row_vector[imu_index] = 
-                SimTK::Quaternion(std::stod(nextRow[orientationsIndex[imu_index]]),
-                    std::stod(nextRow[orientationsIndex[imu_index] + 1]),
-                    std::stod(nextRow[orientationsIndex[imu_index] + 2]),
-                    std::stod(nextRow[orientationsIndex[imu_index] + 3]));
-        }
-        // append to the tables
-        times[rowNumber] = time;
-        if (foundLinearAccelerationData) 
-            linearAccelerationData[rowNumber] =  accel_row_vector;
-        if (foundMagneticHeadingData) 
-            magneticHeadingData[rowNumber] = magneto_row_vector;
-        if (foundAngularVelocityData) 
-            angularVelocityData[rowNumber] = gyro_row_vector;
-        rotationsData[rowNumber] = orientation_row_vector;
-        // We could get some indication of time from file or generate time based on rate
-        // Here we use the latter mechanism.
+    for (int row = 0; row < rowNumber; ++row) {
+        times[row] = time;
         time += timeIncrement;
-        rowNumber++;
-        if (std::remainder(rowNumber, last_size) == 0) {
-            // resize all Data/Matrices, double the size  while keeping data
-            int newSize = last_size*2;
-            times.resize(newSize);
-            // Repeat for Data matrices in use
-            if (foundLinearAccelerationData) linearAccelerationData.resizeKeep(newSize, n_imus);
-            if (foundMagneticHeadingData) magneticHeadingData.resizeKeep(newSize, n_imus);
-            if (foundAngularVelocityData) angularVelocityData.resizeKeep(newSize, n_imus);
-            rotationsData.resizeKeep(newSize, n_imus);
-            last_size = newSize;
-        }
     }
-    // Trim Matrices in use to actual data and move into tables
-    times.resize(rowNumber);
-    // Repeat for Data matrices in use and create Tables from them or size 0 for empty
-    linearAccelerationData.resizeKeep(foundLinearAccelerationData? rowNumber : 0,
-        n_imus);
-    magneticHeadingData.resizeKeep(foundMagneticHeadingData? rowNumber : 0,
-            n_imus);
-    angularVelocityData.resizeKeep(foundAngularVelocityData? rowNumber :0,
-        n_imus);
-    rotationsData.resizeKeep(rowNumber, n_imus);
     // Now create the tables from matrices
     // Create 4 tables for Rotations, LinearAccelerations, AngularVelocity, MagneticHeading
     // Tables could be empty if data is not present in file(s)
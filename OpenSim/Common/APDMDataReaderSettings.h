@@ -38,6 +38,15 @@ OpenSim_DECLARE_CONCRETE_OBJECT(APDMDataReaderSettings, Object);
 public:
     OpenSim_DECLARE_LIST_PROPERTY(ExperimentalSensors, ExperimentalSensor,
         "List of Experimental sensors and desired associated column labels in resulting tables");
+    OpenSim_DECLARE_PROPERTY(read_linear_accelerations, bool,
+        "Whether to read the linear accelerations (default: true); if false, "
+        "the table of linear accelerations is empty.");
+    OpenSim_DECLARE_PROPERTY(read_magnetic_heading, bool,
+        "Whether to read the magnetic heading (default: true); if false, the "
+        "table of magnetic heading is empty.");
+    OpenSim_DECLARE_PROPERTY(read_angular_velocity, bool,
+        "Whether to read the angular velocities (default: true); if false, "
+        "the table of angular velocities is empty.");
 
 public:
     // Default Constructor
@@ -55,6 +64,9 @@ public:
 private:
     void constructProperties() {
         constructProperty_ExperimentalSensors();
+        constructProperty_read_linear_accelerations(true);
+        constructProperty_read_magnetic_heading(true);
+        constructProperty_read_angular_velocity(true);
     }
 };
 
@@ -93,15 +93,25 @@ void AbstractProperty::readFromXMLParentElement(Xml::Element& parent,
 {
     // If this property has a real name (that is, doesn't use the object type
     // tag as a name), look for the first element whose tag is
-    // that name and read it if found. That is, we're looking for
+    // that name. That is, we're looking for
     //      <propName> ... </propName>
+    Xml::Element propElement;
     if (!isUnnamedProperty()) {
         Xml::element_iterator propElt = parent.element_begin(getName());
-        if (propElt != parent.element_end()) {
-            readFromXMLElement(*propElt, versionNumber);
-            setValueIsDefault(false);
-            return;
-        }
+        if (propElt != parent.element_end()) propElement = *propElt;
+    }
+    readFromXMLParentElement(parent, propElement, versionNumber);
+}
+
+void AbstractProperty::readFromXMLParentElement(Xml::Element& parent,
+                                                Xml::Element& propElement,
+                                                int           versionNumber)
+{
+    // Read the property element if it was found.
+    if (propElement.isValid()) {
+        readFromXMLElement(propElement, versionNumber);
+        setValueIsDefault(false);
+        return;
     }
 
     // Didn't find a property element by its name (or it didn't have one).
@@ -251,6 +251,15 @@ public:
     void readFromXMLParentElement(SimTK::Xml::Element& parent,
                                   int                  versionNumber);
 
+    /** Same as readFromXMLParentElement(parent, versionNumber), but given the
+    first child element of `parent` whose tag is the name of this property, or
+    an empty element if there is none (or if this property is unnamed). This
+    allows the elements of all the properties of an Object to be found in a
+    single pass over its XML element (see Object::updateFromXMLNode()). **/
+    void readFromXMLParentElement(SimTK::Xml::Element& parent,
+                                  SimTK::Xml::Element& propElement,
+                                  int                  versionNumber);
+
     /** Given an XML parent element, append a single child element representing
     the serialized form of this property. **/
     void writeToXMLParentElement(SimTK::Xml::Element& parent) const;
@@ -26,9 +26,17 @@
 #include "DelimFileAdapter.h"
 #include "STOFileAdapter.h"
 #include "CSVFileAdapter.h"
+#include "OSBFileAdapter.h"
+#include "TimeSeriesTableReader.h"
 
 #if defined (WITH_EZC3D)
 
 #include "C3DFileAdapter.h"
 
 #endif
+
+#if defined (WITH_HDF5)
+
+#include "HDF5FileAdapter.h"
+
+#endif
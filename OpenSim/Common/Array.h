@@ -32,6 +32,7 @@
 #include <iostream>
 #include "Logger.h"
 #include <sstream>
+#include <utility>
 
 static const int Array_CAPMIN = 1;
 
@@ -127,6 +128,20 @@ Array(const Array<T> &aArray)
     setNull();
     *this = aArray;
 }
+#ifndef SWIG
+//_____________________________________________________________________________
+/**
+ * Move constructor. The elements of aArray are taken over without being
+ * copied, and aArray is left empty.
+ *
+ * @param aArray Array to be moved.
+ */
+Array(Array<T> &&aArray)
+{
+    setNull();
+    *this = std::move(aArray);
+}
+#endif
 
 private:
 //_____________________________________________________________________________
@@ -207,6 +222,34 @@ Array<T>& operator=(const Array<T> &aArray)
 
     return(*this);
 }
+#ifndef SWIG
+//_____________________________________________________________________________
+/**
+ * Move this array from a specified array. The elements of aArray are taken
+ * over without being copied, and aArray is left empty (with no capacity).
+ *
+ * @param aArray Array to be moved.
+ * @return Reference to this array.
+ */
+Array<T>& operator=(Array<T> &&aArray)
+{
+    if(this==&aArray) return(*this);
+
+    _size = aArray._size;
+    _capacity = aArray._capacity;
+    _capacityIncrement = aArray._capacityIncrement;
+    _defaultValue = aArray._defaultValue;
+
+    // ARRAY
+    if(_array!=NULL) delete[] _array;
+    _array = aArray._array;
+    aArray._array = NULL;
+    aArray._size = 0;
+    aArray._capacity = 0;
+
+    return(*this);
+}
+#endif
 
 //-----------------------------------------------------------------------------
 // EQUALITY (==)
@@ -347,9 +390,9 @@ bool ensureCapacity(int aCapacity)
         return(false);
     }
 
-    // COPY CURRENT ARRAY
+    // MOVE CURRENT ARRAY
     if(_array!=NULL) {
-        for(i=0;i<_size;i++) newArray[i] = _array[i];
+        for(i=0;i<_size;i++) newArray[i] = std::move(_array[i]);
         for(i=_size;i<aCapacity;i++) newArray[i] = _defaultValue;
         delete []_array;  _array=NULL;
     } else {
@@ -386,8 +429,8 @@ void trim()
         return;
     }
 
-    // COPY CURRENT ARRAY
-    for(i=0;i<_size;i++) array[i] = _array[i];
+    // MOVE CURRENT ARRAY
+    for(i=0;i<_size;i++) array[i] = std::move(_array[i]);
 
     // DELETE OLD ARRAY
     delete[] _array;
@@ -519,6 +562,34 @@ int append(const T &aValue)
 
     return(_size);
 }
+#ifndef SWIG
+//_____________________________________________________________________________
+/**
+ * Append a value onto the array, moving it instead of copying it.
+ *
+ * @param aValue Value to be appended.
+ * @return New size of the array, or, equivalently, the index to the new
+ * first empty element of the array.
+ */
+int append(T &&aValue)
+{
+    // ENSURE CAPACITY
+    if((_size+1)>=_capacity) {
+        int newCapacity;
+        bool success;
+        success = computeNewCapacity(_size+1,newCapacity);
+        if(!success) return(_size);
+        success = ensureCapacity(newCapacity);
+        if(!success) return(_size);
+    }
+
+    // SET
+    _array[_size] = std::move(aValue);
+    _size++;
+
+    return(_size);
+}
+#endif
 //_____________________________________________________________________________
 /**
  * Append an array of values.
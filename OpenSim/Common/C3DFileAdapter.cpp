@@ -3,8 +3,12 @@
 #ifdef WITH_EZC3D
 #include "ezc3d/ezc3d_all.h"
 #endif
+#include "CommonUtilities.h"
 #include "STOFileAdapter.h"
 
+#include <algorithm>
+#include <numeric>
+
 namespace {
 
 #ifdef WITH_EZC3D
@@ -37,6 +41,37 @@ convertToSimtkMatrix(const std::vector<ezc3d::Vector3d>& all_vec) {
 
     return simtkMat;
 }
+
+// The indices of the labels `selected` in `labels`, or the indices of all the
+// labels if `selected` is empty. `description` (e.g., "marker") is used in the
+// exception thrown if a selected label is not found.
+std::vector<int> getSelectedIndices(const std::vector<std::string>& labels,
+        const std::vector<std::string>& selected,
+        const std::string& description) {
+    std::vector<int> indices;
+    if (selected.empty()) {
+        indices.resize(labels.size());
+        std::iota(indices.begin(), indices.end(), 0);
+        return indices;
+    }
+    for (const auto& label : selected) {
+        const auto it = std::find(labels.begin(), labels.end(), label);
+        OPENSIM_THROW_IF(it == labels.end(), OpenSim::Exception,
+                "Expected the C3D file to have a {} labeled '{}'.",
+                description, label);
+        indices.push_back(static_cast<int>(it - labels.begin()));
+    }
+    return indices;
+}
+
+// The number of threads to copy `numValues` values, in `numRows` rows, from
+// the c3d data into a table. Each thread copies at least 100000 values, since
+// copying fewer does not pay for starting a thread.
+int getNumThreadsForCopy(int numThreads, int numRows, double numValues) {
+    const int maxNumThreads = static_cast<int>(numValues / 100000);
+    return std::max(1, std::min({OpenSim::getNumThreadsOrDefault(numThreads),
+                               numRows, maxNumThreads}));
+}
 #endif
 } // anonymous namespace
 
@@ -105,40 +140,60 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
 
     if(numMarkers != 0) {
 
+        std::vector<std::string> all_marker_labels{};
+        for (auto label : c3d.parameters().group("POINT")
+                .parameter("LABELS").valuesAsString()) {
+            all_marker_labels.push_back(SimTK::Value<std::string>(label));
+        }
+        std::vector<std::string> marker_labels = all_marker_labels;
+        std::vector<int> marker_indices(numMarkers);
+        std::iota(marker_indices.begin(), marker_indices.end(), 0);
+        if (!_markersToRead.empty()) {
+            marker_labels = _markersToRead;
+            marker_indices = getSelectedIndices(
+                    all_marker_labels, _markersToRead, "marker");
+            for (const int index : marker_indices) {
+                OPENSIM_THROW_IF(index >= numMarkers, Exception,
+                        "Expected marker '{}' of the C3D file to have data.",
+                        all_marker_labels[index]);
+            }
+        }
+
         int marker_nrow = numFrames;
-        int marker_ncol = numMarkers;
+        int marker_ncol = static_cast<int>(marker_indices.size());
 
         std::vector<double> marker_times(marker_nrow);
         SimTK::Matrix_<SimTK::Vec3> marker_matrix(marker_nrow, marker_ncol);
 
-        std::vector<std::string> marker_labels{};
-        for (auto label : c3d.parameters().group("POINT")
-                .parameter("LABELS").valuesAsString()) {
-            marker_labels.push_back(SimTK::Value<std::string>(label));
-        }
-
         double time_step{1.0 / pointFrequency};
-        for(int f = 0; f < marker_nrow; ++f) {
-            SimTK::RowVector_<SimTK::Vec3> row{ numMarkers,
-                                                SimTK::Vec3(SimTK::NaN) };
-            int m{0};
-            // C3D standard is to read empty values as zero, but sets a
-            // "residual" value to -1 and it is how it knows to export these
-            // values as blank, instead of 0,  when exporting to .trc
-            // See: C3D documention 3D Point Residuals
-            // Read in value if it is not zero or residual is not -1
-            for(auto pt : c3d.data().frame(f).points().points()) {
-                if (!pt.isEmpty() ) {//residual is not -1
-                    row[m] = SimTK::Vec3{ static_cast<double>(pt.x()),
-                                          static_cast<double>(pt.y()),
-                                          static_cast<double>(pt.z()) };
+        // The points are copied directly into the matrix, on multiple threads
+        // for large files.
+        parallelForChunks(marker_nrow,
+                getNumThreadsForCopy(_numThreads, marker_nrow,
+                        3.0 * marker_nrow * marker_ncol),
+                [&](int, int begin, int end) {
+            for (int f = begin; f < end; ++f) {
+                const auto& points = c3d.data().frame(f).points();
+                for (int m = 0; m < marker_ncol; ++m) {
+                    const auto& pt = points.point(marker_indices[m]);
+                    // C3D standard is to read empty values as zero, but sets
+                    // a "residual" value to -1 and it is how it knows to
+                    // export these values as blank, instead of 0, when
+                    // exporting to .trc
+                    // See: C3D documention 3D Point Residuals
+                    // Read in value if it is not zero or residual is not -1
+                    if (pt.isEmpty()) {
+                        marker_matrix(f, m) = SimTK::Vec3(SimTK::NaN);
+                    } else {
+                        marker_matrix(f, m) =
+                                SimTK::Vec3{static_cast<double>(pt.x()),
+                                        static_cast<double>(pt.y()),
+                                        static_cast<double>(pt.z())};
+                    }
                 }
-                ++m;
+                marker_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
             }
-
-            marker_matrix.updRow(f) = row;
-            marker_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
-        }
+        });
 
         // Create the data
         auto marker_table =
@@ -183,10 +238,27 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
     const auto& force_platforms_extractor = ezc3d::Modules::ForcePlatforms(c3d);
 
     ForceLocation forceLocation(getLocationForForceExpression());
-    auto numPlatform(static_cast<int>(
+    auto numPlatformsInFile(static_cast<int>(
                              force_platforms_extractor.forcePlatforms().size()));
 
-    for (const auto& platform : force_platforms_extractor.forcePlatforms()){
+    // The (0-based) indices of the force plates to read.
+    std::vector<int> platform_indices(numPlatformsInFile);
+    std::iota(platform_indices.begin(), platform_indices.end(), 0);
+    if (!_forcePlatesToRead.empty()) {
+        platform_indices.clear();
+        for (const int fp : _forcePlatesToRead) {
+            OPENSIM_THROW_IF(fp < 1 || fp > numPlatformsInFile, Exception,
+                    "Expected the number of a force plate to read to be "
+                    "between 1 and {} (the number of force plates in the C3D "
+                    "file), but got {}.",
+                    numPlatformsInFile, fp);
+            platform_indices.push_back(fp - 1);
+        }
+    }
+    auto numPlatform(static_cast<int>(platform_indices.size()));
+
+    for (const int ip : platform_indices) {
+        const auto& platform = force_platforms_extractor.forcePlatform(ip);
 
         const auto& calMatrix = platform.calMatrix();
         const auto& corners   = platform.corners();
@@ -210,17 +282,22 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
                          "Type 1 force platform detected.");
             }
         }
+        OPENSIM_THROW_IF(forceLocation != ForceLocation::CenterOfPressure &&
+                        forceLocation != ForceLocation::OriginOfForcePlate,
+                Exception,
+                "The selected force location is not implemented for ezc3d "
+                "files");
         std::vector<std::string> labels{};
         ValueArray<std::string> units{};
-        for(int fp = 1; fp <= numPlatform; ++fp) {
-            auto fp_str = std::to_string(fp);
+        for (const int ip : platform_indices) {
+            auto fp_str = std::to_string(ip + 1);
 
             auto force_unit =
-                    force_platforms_extractor.forcePlatform(fp-1).forceUnit();
+                    force_platforms_extractor.forcePlatform(ip).forceUnit();
             auto position_unit =
-                    force_platforms_extractor.forcePlatform(fp-1).positionUnit();
+                    force_platforms_extractor.forcePlatform(ip).positionUnit();
             auto moment_unit =
-                    force_platforms_extractor.forcePlatform(fp-1).momentUnit();
+                    force_platforms_extractor.forcePlatform(ip).momentUnit();
 
             labels.push_back(SimTK::Value<std::string>("f" + fp_str));
             units.upd().push_back(SimTK::Value<std::string>(force_unit));
@@ -241,42 +318,36 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
 
         double time_step{1.0 / analogFrequency};
 
-        for(int f = 0; f < nf;  ++f) {
-            SimTK::RowVector_<SimTK::Vec3>
-                    row{numPlatform * 3};
-            int col{0};
-            for (size_t i = 0; i < (size_t)numPlatform; ++i){
-                row[col] = SimTK::Vec3{pf_ref[i].forces()[f](0),
-                                       pf_ref[i].forces()[f](1),
-                                       pf_ref[i].forces()[f](2)};
-                ++col;
-                if (forceLocation == ForceLocation::CenterOfPressure){
-                    row[col] = SimTK::Vec3{pf_ref[i].CoP()[f](0),
-                                           pf_ref[i].CoP()[f](1),
-                                           pf_ref[i].CoP()[f](2)};
-                    ++col;
-                    row[col] = SimTK::Vec3{pf_ref[i].Tz()[f](0),
-                                           pf_ref[i].Tz()[f](1),
-                                           pf_ref[i].Tz()[f](2)};
-                    ++col;
-                } else if (forceLocation == ForceLocation::OriginOfForcePlate){
-                    row[col] = SimTK::Vec3{pf_ref[i].meanCorners()(0),
-                                           pf_ref[i].meanCorners()(1),
-                                           pf_ref[i].meanCorners()(2)};
-                    ++col;
-                    row[col] = SimTK::Vec3{pf_ref[i].moments()[f](0),
-                                           pf_ref[i].moments()[f](1),
-                                           pf_ref[i].moments()[f](2)};
-                    ++col;
-                } else {
-                    OPENSIM_THROW(Exception,
-                                  "The selected force location is not "
-                                  "implemented for ezc3d files");
+        const auto toVec3 = [](const ezc3d::Vector3d& v) {
+            return SimTK::Vec3{v(0), v(1), v(2)};
+        };
+        // The origins do not change from frame to frame.
+        std::vector<SimTK::Vec3> platform_origins;
+        for (const int ip : platform_indices) {
+            platform_origins.push_back(toVec3(pf_ref[ip].meanCorners()));
+        }
+
+        // The forces are copied directly into the matrix, on multiple threads
+        // for large files.
+        parallelForChunks(nf,
+                getNumThreadsForCopy(_numThreads, nf, 9.0 * nf * numPlatform),
+                [&](int, int begin, int end) {
+            for (int f = begin; f < end; ++f) {
+                int col{0};
+                for (int i = 0; i < numPlatform; ++i) {
+                    const auto& platform = pf_ref[platform_indices[i]];
+                    force_matrix(f, col++) = toVec3(platform.forces()[f]);
+                    if (forceLocation == ForceLocation::CenterOfPressure) {
+                        force_matrix(f, col++) = toVec3(platform.CoP()[f]);
+                        force_matrix(f, col++) = toVec3(platform.Tz()[f]);
+                    } else {
+                        force_matrix(f, col++) = platform_origins[i];
+                        force_matrix(f, col++) = toVec3(platform.moments()[f]);
+                    }
                 }
+                force_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
             }
-            force_matrix.updRow(f) = row;
-            force_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
-        }
+        });
 
         auto&  force_table =
                 *(new TimeSeriesTableVec3(force_times, force_matrix, labels));
@@ -324,34 +395,55 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
     }
 
     // Try to extract analog data and place in a new TimeSeriesTable_<double> 
-    std::vector<std::string> analog_labels{};
+    std::vector<std::string> all_analog_labels{};
     for (auto label : c3d.parameters().group("ANALOG")
         .parameter("LABELS").valuesAsString()) {
-        analog_labels.push_back(SimTK::Value<std::string>(label));
+        all_analog_labels.push_back(SimTK::Value<std::string>(label));
     }
+    const std::vector<int> analog_indices = getSelectedIndices(
+            all_analog_labels, _analogChannelsToRead, "analog channel");
+    const std::vector<std::string> analog_labels =
+            _analogChannelsToRead.empty() ? all_analog_labels
+                                          : _analogChannelsToRead;
 
     int numAnalogSignals = (int)analog_labels.size();
-    int totalAnalogFrames = (int) (c3d.data().nbFrames() * c3d.header().nbAnalogByFrame());
+    int numSubframes = (int)c3d.header().nbAnalogByFrame();
+    int totalAnalogFrames = (int) (c3d.data().nbFrames() * numSubframes);
     SimTK::Matrix analog_data_matrix(totalAnalogFrames, numAnalogSignals);
     std::vector<double> analog_times(totalAnalogFrames);
     double analog_time_step{ 1.0 / analogFrequency };
+    for (int row = 0; row < totalAnalogFrames; ++row) {
+        analog_times[row] = row * analog_time_step; //TODO: 0 should be start_time
+    }
 
-    // Exrtact matrix of analog data one (sub)frame at a time
-    int rowNumber = 0;
-    for (const auto& frame : c3d.data().frames()) {
-        for (size_t i = 0; i < frame.analogs().nbSubframes(); ++i) {
-            const auto& subframe(frame.analogs().subframe(i));
-            SimTK::RowVector_<double> row{ numAnalogSignals, SimTK::NaN };
-            for (int col = 0; col < numAnalogSignals; ++col) {
-                row[col] = subframe.channel(col).data();
+    // Extract matrix of analog data one (sub)frame at a time, directly into
+    // the matrix, on multiple threads for large files.
+    parallelForChunks(numFrames,
+            getNumThreadsForCopy(_numThreads, numFrames,
+                    (double)totalAnalogFrames * numAnalogSignals),
+            [&](int, int begin, int end) {
+        for (int f = begin; f < end; ++f) {
+            const auto& analogs = c3d.data().frame(f).analogs();
+            const int nbSubframes = std::min(
+                    (int)analogs.nbSubframes(), numSubframes);
+            for (int i = 0; i < nbSubframes; ++i) {
+                const auto& subframe(analogs.subframe(i));
+                const int rowNumber = f * numSubframes + i;
+                for (int col = 0; col < numAnalogSignals; ++col) {
+                    analog_data_matrix(rowNumber, col) =
+                            subframe.channel(analog_indices[col]).data();
+                }
+            }
+            for (int i = nbSubframes; i < numSubframes; ++i) {
+                for (int col = 0; col < numAnalogSignals; ++col) {
+                    analog_data_matrix(f * numSubframes + i, col) = SimTK::NaN;
+                }
             }
-            analog_data_matrix.updRow(rowNumber) = row;
-            analog_times[rowNumber] = rowNumber * analog_time_step; //TODO: 0 should be start_time
-            rowNumber++;
         }
-    }
+    });
     auto& analog_table =
-        *(new TimeSeriesTable(analog_times, analog_data_matrix, analog_labels));
+        *(new TimeSeriesTable(std::move(analog_times),
+                std::move(analog_data_matrix), analog_labels));
     analog_table.updTableMetaData().setValueForKey("DataRate", std::to_string(analogFrequency));
     tables.emplace(_analog, std::shared_ptr<TimeSeriesTable>(&analog_table));
     return tables;
@@ -116,6 +116,44 @@ public:
         return _location;
     }
 
+    /** Read only the markers with these labels, in this order, into the
+    markers table. By default (an empty list), all the markers of the file are
+    read. read() throws if the file has no marker with one of the labels. */
+    void setMarkersToRead(const std::vector<std::string>& labels) {
+        _markersToRead = labels;
+    }
+    const std::vector<std::string>& getMarkersToRead() const {
+        return _markersToRead;
+    }
+
+    /** Read only these force plates, in this order, into the forces table.
+    The force plates are numbered from 1, as in the column labels (*f1*, *p1*,
+    *m1*, ...), which keep the numbers of the force plates in the file. By
+    default (an empty list), all the force plates are read. read() throws if
+    the file has no force plate with one of the numbers. */
+    void setForcePlatesToRead(const std::vector<int>& forcePlates) {
+        _forcePlatesToRead = forcePlates;
+    }
+    const std::vector<int>& getForcePlatesToRead() const {
+        return _forcePlatesToRead;
+    }
+
+    /** Read only the analog channels with these labels, in this order, into
+    the analog table. By default (an empty list), all the channels are read.
+    read() throws if the file has no channel with one of the labels. */
+    void setAnalogChannelsToRead(const std::vector<std::string>& labels) {
+        _analogChannelsToRead = labels;
+    }
+    const std::vector<std::string>& getAnalogChannelsToRead() const {
+        return _analogChannelsToRead;
+    }
+
+    /** The number of threads that copy the frames of the file into the
+    tables; if not positive (the default), getNumThreadsOrDefault() is used.
+    Small files are copied on one thread. */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
+
 #ifndef SWIG
     static
     void write(const Tables& markerTable, const std::string& fileName);
@@ -153,6 +191,10 @@ private:
     static const std::unordered_map<std::string, std::size_t> _unit_index;
 
     ForceLocation _location{ ForceLocation::OriginOfForcePlate };
+    std::vector<std::string> _markersToRead;
+    std::vector<int> _forcePlatesToRead;
+    std::vector<std::string> _analogChannelsToRead;
+    int _numThreads{-1};
 
 };
 
@@ -26,11 +26,17 @@
 #include "PiecewiseLinearFunction.h"
 #include "STOFileAdapter.h"
 #include "TimeSeriesTable.h"
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstdio>
 #include <ctime>
+#include <exception>
 #include <iomanip>
 #include <memory>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #include <SimTKcommon/internal/Pathname.h>
 
@@ -184,6 +190,152 @@ SimTK::Real OpenSim::solveBisection(
     return midpoint;
 }
 
+int OpenSim::getNumThreadsOrDefault(int requested) {
+    if (requested > 0) return requested;
+    // hardware_concurrency() may return 0 if the value is not computable.
+    return std::max(1, (int)std::thread::hardware_concurrency());
+}
+
+void OpenSim::parallelForChunks(int size, int numThreads,
+        const std::function<void(int, int, int)>& func) {
+    if (size <= 0) return;
+    numThreads = std::min(getNumThreadsOrDefault(numThreads), size);
+    if (numThreads == 1) {
+        func(0, 0, size);
+        return;
+    }
+
+    // Chunk i covers [bounds[i], bounds[i+1]); the first (size % numThreads)
+    // chunks get one extra index.
+    std::vector<int> bounds(numThreads + 1, 0);
+    const int base = size / numThreads;
+    const int remainder = size % numThreads;
+    for (int i = 0; i < numThreads; ++i) {
+        bounds[i + 1] = bounds[i] + base + (i < remainder ? 1 : 0);
+    }
+
+    std::vector<std::exception_ptr> exceptions(numThreads);
+    auto runChunk = [&](int chunk) {
+        try {
+            func(chunk, bounds[chunk], bounds[chunk + 1]);
+        } catch (...) {
+            exceptions[chunk] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (int i = 1; i < numThreads; ++i) {
+        threads.emplace_back(runChunk, i);
+    }
+    runChunk(0);
+    for (auto& thread : threads) thread.join();
+
+    for (const auto& exception : exceptions) {
+        if (exception) std::rethrow_exception(exception);
+    }
+}
+
+void OpenSim::parallelForEach(int size, int numThreads,
+        const std::function<void(int, int)>& func) {
+    if (size <= 0) return;
+    numThreads = std::min(getNumThreadsOrDefault(numThreads), size);
+    if (numThreads == 1) {
+        for (int i = 0; i < size; ++i) func(0, i);
+        return;
+    }
+
+    std::atomic<int> next(0);
+    std::atomic<bool> failed(false);
+    std::vector<std::exception_ptr> exceptions(numThreads);
+    auto runThread = [&](int thread) {
+        try {
+            for (int i = next++; i < size && !failed; i = next++) {
+                func(thread, i);
+            }
+        } catch (...) {
+            exceptions[thread] = std::current_exception();
+            failed = true;
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (int i = 1; i < numThreads; ++i) {
+        threads.emplace_back(runThread, i);
+    }
+    runThread(0);
+    for (auto& thread : threads) thread.join();
+
+    for (const auto& exception : exceptions) {
+        if (exception) std::rethrow_exception(exception);
+    }
+}
+
+void OpenSim::appendFormattedDouble(
+        std::string& buffer, const char* format, double value) {
+    char chars[64];
+    const int n = std::snprintf(chars, sizeof(chars), format, value);
+    if (n < 0) return;
+    if (n < (int)sizeof(chars)) {
+        buffer.append(chars, n);
+    } else {
+        // For example, a large value with a fixed-point format.
+        const size_t size = buffer.size();
+        buffer.resize(size + n + 1);
+        std::snprintf(&buffer[size], n + 1, format, value);
+        buffer.resize(size + n);
+    }
+}
+
+void OpenSim::formatRowsInBlocks(int numRows, int numThreads,
+        const std::function<void(int, std::string&)>& formatRow,
+        const std::function<void(const char*, size_t)>& write) {
+    const int rowsPerBlock = 1024;
+    numThreads = getNumThreadsOrDefault(numThreads);
+    // The buffers are reused for all the blocks, so that they are allocated
+    // only while they grow.
+    std::vector<std::string> blocks(numThreads);
+    for (int first = 0; first < numRows; first += numThreads * rowsPerBlock) {
+        const int numRowsInRound =
+                std::min(numRows - first, numThreads * rowsPerBlock);
+        const int numBlocks =
+                (numRowsInRound + rowsPerBlock - 1) / rowsPerBlock;
+        parallelForChunks(numBlocks, numThreads,
+                [&](int, int begin, int end) {
+                    for (int block = begin; block < end; ++block) {
+                        std::string& buffer = blocks[block];
+                        buffer.clear();
+                        const int rowBegin = first + block * rowsPerBlock;
+                        const int rowEnd = std::min(rowBegin + rowsPerBlock,
+                                first + numRowsInRound);
+                        for (int row = rowBegin; row < rowEnd; ++row) {
+                            formatRow(row, buffer);
+                        }
+                    }
+                });
+        for (int block = 0; block < numBlocks; ++block) {
+            write(blocks[block].data(), blocks[block].size());
+        }
+    }
+}
+
+int OpenSim::findInterval(const double* x, int n, double value, int hint) {
+    const int last = n - 2;
+    const int k = std::max(0, std::min(hint, last));
+    // Find the first element greater than value within [begin, end); the
+    // interval is the one to its left.
+    const auto locate = [&](int begin, int end) -> int {
+        const int i = (int)(std::upper_bound(x + begin, x + end, value) - x);
+        return std::max(0, std::min(i - 1, last));
+    };
+    if (value >= x[k]) {
+        if (k == last || value < x[k + 1]) return k;
+        if (k + 1 == last || value < x[k + 2]) return k + 1;
+        return locate(k + 2, n);
+    }
+    if (k == 0 || value >= x[k - 1]) return std::max(k - 1, 0);
+    return locate(0, k - 1);
+}
+
 SimTK::Matrix OpenSim::computeKNearestNeighbors(const SimTK::Matrix& x,
         const SimTK::Matrix& y, int k) {
 
@@ -29,6 +29,10 @@
 #include <memory>
 #include <mutex>
 #include <stack>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 #include <condition_variable>
 
 #include <SimTKcommon/internal/BigMatrix.h>
@@ -125,9 +129,12 @@ SimTK::Real solveBisection(std::function<double(const double&)> calcResidual,
         int maxIterations = 1000);
 
 /// This class lets you store objects of a single type for reuse by multiple
-/// threads, ensuring threadsafe access to each of those objects.
+/// threads, ensuring threadsafe access to each of those objects. A thread
+/// that takes an object is given the object it left most recently, if that
+/// object is available, so that threads that take and leave objects
+/// repeatedly (e.g., the threads of a ThreadPool) keep using the same objects,
+/// whose memory remains in the caches of their CPUs.
 /// @ingroup commonutil
-// TODO: Find a way to always give the same thread the same object.
 template <typename T> class ThreadsafeJar {
 public:
     /// Request an object for your exclusive use on your thread. This function
@@ -140,16 +147,27 @@ public:
         // Block this thread until the condition variable is woken up
         // (by a notify_...()) and the lambda function returns true.
         m_inventoryMonitor.wait(lock, [this] { return m_entries.size() > 0; });
-        std::unique_ptr<T> top = std::move(m_entries.top());
-        m_entries.pop();
-        return top;
+        // Prefer the object that this thread left most recently; otherwise,
+        // take the object left most recently.
+        const auto thisThread = std::this_thread::get_id();
+        auto it = m_entries.end() - 1;
+        for (auto candidate = m_entries.rbegin();
+                candidate != m_entries.rend(); ++candidate) {
+            if (candidate->first == thisThread) {
+                it = candidate.base() - 1;
+                break;
+            }
+        }
+        std::unique_ptr<T> entry = std::move(it->second);
+        m_entries.erase(it);
+        return entry;
     }
     /// Add or return an object so that another thread can use it. You will need
     /// to std::move() the entry, ensuring that you will no longer have access
     /// to the entry in your code (the pointer will now be null).
     void leave(std::unique_ptr<T> entry) {
         std::unique_lock<std::mutex> lock(m_mutex);
-        m_entries.push(std::move(entry));
+        m_entries.emplace_back(std::this_thread::get_id(), std::move(entry));
         lock.unlock();
         m_inventoryMonitor.notify_one();
     }
@@ -160,11 +178,78 @@ public:
     }
 
 private:
-    std::stack<std::unique_ptr<T>> m_entries;
+    // Each object with the thread that left it.
+    std::vector<std::pair<std::thread::id, std::unique_ptr<T>>> m_entries;
     mutable std::mutex m_mutex;
     std::condition_variable m_inventoryMonitor;
 };
 
+/// Get the number of threads to use for a parallel computation. If
+/// `requested` is positive, it is returned unchanged; otherwise, the number of
+/// concurrent threads supported by the hardware is returned (at least 1).
+/// @ingroup commonutil
+OSIMCOMMON_API int getNumThreadsOrDefault(int requested = -1);
+
+/// Split the index range [0, size) into at most `numThreads` contiguous
+/// chunks of nearly equal length and invoke `func(chunk, begin, end)` for each
+/// chunk, where [begin, end) is the index range of the chunk and `chunk` is in
+/// [0, numThreads). All chunks but the first are processed on newly created
+/// threads; the first is processed on the calling thread. This function
+/// returns once all chunks are processed. If `func` throws for any chunk, the
+/// first such exception is rethrown on the calling thread (after all threads
+/// have joined). If `numThreads` is not positive, getNumThreadsOrDefault() is
+/// used. With one thread (or size <= 1), `func` is invoked directly.
+/// @ingroup commonutil
+OSIMCOMMON_API void parallelForChunks(int size, int numThreads,
+        const std::function<void(int chunk, int begin, int end)>& func);
+
+/// Invoke `func(thread, index)` for each index in [0, size) on at most
+/// `numThreads` threads, where `thread` is in [0, numThreads). Unlike
+/// parallelForChunks(), indices are not assigned to threads in advance: each
+/// thread claims the next unprocessed index once it is done with the previous
+/// one, which balances the load when the cost of `func` varies between
+/// indices. The first thread is the calling thread. If `func` throws, the
+/// threads stop claiming new indices, and the exception of the
+/// lowest-numbered thread that threw is rethrown on the calling thread. If
+/// `numThreads` is not positive, getNumThreadsOrDefault() is used.
+/// @ingroup commonutil
+OSIMCOMMON_API void parallelForEach(int size, int numThreads,
+        const std::function<void(int thread, int index)>& func);
+
+/// Find the index `k` of the interval [x[k], x[k+1]) of the increasing
+/// sequence x[0], ..., x[n-1] (n >= 2) that contains `value`. Values below
+/// x[0] give 0 and values at or above x[n-1] give n - 2. The search starts
+/// with the interval `hint` and its neighbors and only falls back to a binary
+/// search if `value` is not in any of them, so it is fast when successive
+/// lookups are close to each other (a "hunt and locate" search). The result
+/// does not depend on `hint`.
+/// @ingroup commonutil
+OSIMCOMMON_API int findInterval(
+        const double* x, int n, double value, int hint = 0);
+
+/// Append `value`, formatted with the printf() conversion `format` (e.g.,
+/// "%.17g" or IO::GetDoubleOutputFormat()), to `buffer`. The characters are
+/// the same as those of fprintf() with the format, and "%.<p>g" gives the
+/// same characters as writing the value to a std::ostream with
+/// std::setprecision(p), without the overhead of the stream.
+/// @ingroup commonutil
+OSIMCOMMON_API void appendFormattedDouble(
+        std::string& buffer, const char* format, double value);
+
+/// Format the rows [0, numRows) of a file with `formatRow(row, buffer)`,
+/// which appends the characters of the row to `buffer`, and pass them in
+/// order to `write(data, size)` in blocks of many rows, so that the output
+/// costs one write per block rather than one per value. If `numThreads` is
+/// greater than 1, the blocks are formatted on that many threads at a time
+/// (see parallelForChunks()), so `formatRow` must then be safe to invoke
+/// concurrently for distinct rows; the output does not depend on the number
+/// of threads. If `numThreads` is not positive, getNumThreadsOrDefault() is
+/// used.
+/// @ingroup commonutil
+OSIMCOMMON_API void formatRowsInBlocks(int numRows, int numThreads,
+        const std::function<void(int row, std::string& buffer)>& formatRow,
+        const std::function<void(const char* data, size_t size)>& write);
+
 /// Compute the 'k' nearest neighbors of two matrices 'x' and 'y'. 'x' and 'y'
 /// should contain the same number of columns, but can have different numbers of
 /// rows. The function returns a matrix with 'k' number of columns and the same
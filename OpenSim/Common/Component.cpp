@@ -79,29 +79,47 @@ public:
     {   return this->getValueZero(); }
 
     void realizeMeasureTopologyVirtual(SimTK::State& s) const override final
-    {   _Component.extendRealizeTopology(s); }
+    {   ComponentProfiler::Scope scope(_Component,
+                ComponentProfiler::Hook::RealizeTopology);
+        _Component.extendRealizeTopology(s); }
     void realizeMeasureModelVirtual(SimTK::State& s) const override final
-    {   _Component.extendRealizeModel(s); }
+    {   ComponentProfiler::Scope scope(_Component,
+                ComponentProfiler::Hook::RealizeModel);
+        _Component.extendRealizeModel(s); }
     void realizeMeasureInstanceVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeInstance(s); }
+    {   ComponentProfiler::Scope scope(_Component,
+                ComponentProfiler::Hook::RealizeInstance);
+        _Component.extendRealizeInstance(s); }
     void realizeMeasureTimeVirtual(const SimTK::State& s) const override final
-    {   _Component.extendRealizeTime(s); }
+    {   ComponentProfiler::Scope scope(_Component,
+                ComponentProfiler::Hook::RealizeTime);
+        _Component.extendRealizeTime(s); }
     void realizeMeasurePositionVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizePosition(s); }
+    {   ComponentProfiler::Scope scope(_Component,
+                ComponentProfiler::Hook::RealizePosition);
+        _Component.extendRealizePosition(s); }
     void realizeMeasureVelocityVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeVelocity(s); }
+    {   ComponentProfiler::Scope scope(_Component,
+                ComponentProfiler::Hook::RealizeVelocity);
+        _Component.extendRealizeVelocity(s); }
     void realizeMeasureDynamicsVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeDynamics(s); }
+    {   ComponentProfiler::Scope scope(_Component,
+                ComponentProfiler::Hook::RealizeDynamics);
+        _Component.extendRealizeDynamics(s); }
     void realizeMeasureAccelerationVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeAcceleration(s); }
+    {   ComponentProfiler::Scope scope(_Component,
+                ComponentProfiler::Hook::RealizeAcceleration);
+        _Component.extendRealizeAcceleration(s); }
     void realizeMeasureReportVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeReport(s); }
+    {   ComponentProfiler::Scope scope(_Component,
+                ComponentProfiler::Hook::RealizeReport);
+        _Component.extendRealizeReport(s); }
 
 private:
     const Component& _Component;
@@ -179,6 +197,13 @@ void Component::finalizeFromProperties()
 {
     reset();
 
+    // The tree may have changed, so discard the lists of subcomponents by type
+    // of this component and its owners.
+    for (const Component* comp = this; comp;
+            comp = comp->hasOwner() ? &comp->getOwner() : nullptr) {
+        comp->_componentsOfType.clear();
+    }
+
     // last opportunity to modify Object names based on properties
     if (!hasOwner()) {
         // only call when Component is root since method is recursive
@@ -392,6 +417,35 @@ void Component::addToSystem(SimTK::MultibodySystem& system) const
     extendAddToSystem(system);
     componentsAddToSystem(system);
     extendAddToSystemAfterSubcomponents(system);
+
+    // All state variables have been allocated now.
+    if (!hasOwner()) indexStateVariablesByPath();
+    // The subcomponents may have been recreated.
+    if (_profiler) _profiler->forgetComponents();
+}
+
+void Component::setProfilingEnabled(bool enabled)
+{
+    OPENSIM_THROW_IF_FRMOBJ(enabled && hasOwner(), Exception,
+            "Profiling can only be enabled on the root component ('{}').",
+            getRoot().getName());
+    if (enabled) {
+        _profiler.reset(new ComponentProfiler());
+    } else {
+        _profiler.reset();
+    }
+}
+
+const ComponentProfiler& Component::getProfiler() const
+{
+    OPENSIM_THROW_IF_FRMOBJ(!_profiler, Exception,
+            "Profiling is not enabled; call setProfilingEnabled(true).");
+    return *_profiler;
+}
+
+ComponentProfiler& Component::updProfiler()
+{
+    return const_cast<ComponentProfiler&>(getProfiler());
 }
 
 // Base class implementation of virtual method.
@@ -763,9 +817,53 @@ ComponentPath Component::getRelativePath(const Component& wrt) const
 const Component::StateVariable* Component::
     traverseToStateVariable(const std::string& pathName) const
 {
+    if (const StateVariable* sv = findIndexedStateVariable(pathName)) {
+        return sv;
+    }
     return traverseToStateVariable(ComponentPath{pathName});
 }
 
+void Component::indexStateVariablesByPath() const
+{
+    _stateVariablesByPath.clear();
+    for (const auto& it : _namedStateVariableInfo) {
+        _stateVariablesByPath.emplace("/" + it.first,
+                SimTK::ReferencePtr<const StateVariable>(
+                        it.second.stateVariable.get()));
+    }
+    for (const auto& comp : getComponentList<Component>()) {
+        if (comp._namedStateVariableInfo.empty()) continue;
+        const std::string pathName = comp.getAbsolutePathString() + "/";
+        for (const auto& it : comp._namedStateVariableInfo) {
+            _stateVariablesByPath.emplace(pathName + it.first,
+                    SimTK::ReferencePtr<const StateVariable>(
+                            it.second.stateVariable.get()));
+        }
+    }
+    _stateVariablesByPathSystem.reset(&getSystem());
+}
+
+const Component::StateVariable* Component::
+    findIndexedStateVariable(const std::string& pathName) const
+{
+    if (pathName.empty() || !hasSystem()) return nullptr;
+    const Component& root = getRoot();
+    if (root._stateVariablesByPathSystem.empty() ||
+            !getSystem().isSameSystem(root._stateVariablesByPathSystem.getRef()))
+        return nullptr;
+
+    const auto& index = root._stateVariablesByPath;
+    if (pathName[0] == '/') {
+        const auto it = index.find(pathName);
+        return it != index.end() ? it->second.get() : nullptr;
+    }
+    if (&root == this) {
+        const auto it = index.find("/" + pathName);
+        return it != index.end() ? it->second.get() : nullptr;
+    }
+    return nullptr;
+}
+
 const Component::StateVariable* Component::traverseToStateVariable(
         const ComponentPath& path) const
 {
@@ -821,6 +919,9 @@ Array<std::string> Component::getStateVariableNames() const
 double Component::
     getStateVariableValue(const SimTK::State& s, const std::string& name) const
 {
+    if (const StateVariable* rsv = findIndexedStateVariable(name)) {
+        return rsv->getValue(s);
+    }
     return getStateVariableValue(s, ComponentPath{name});
 }
 
@@ -1517,7 +1618,11 @@ void Component::extendRealizeAcceleration(const SimTK::State& s) const
         const SimTK::Subsystem& subSys = getDefaultSubsystem();
 
         // evaluate and set component state derivative values (in cache)
-        computeStateVariableDerivatives(s);
+        {
+            ComponentProfiler::Scope scope(*this,
+                    ComponentProfiler::Hook::ComputeStateVariableDerivatives);
+            computeStateVariableDerivatives(s);
+        }
 
         std::map<std::string, StateVariableInfo>::const_iterator it;
 
@@ -1831,6 +1936,8 @@ void Component::clearStateAllocations()
 void Component::reset()
 {
     _system.reset();
+    _stateVariablesByPath.clear();
+    _stateVariablesByPathSystem.reset();
     _simTKcomponentIndex.invalidate();
     clearStateAllocations();
 
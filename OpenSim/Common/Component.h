@@ -43,6 +43,7 @@
 
 // INCLUDES
 #include "ComponentList.h"
+#include "ComponentProfiler.h"
 #include "ComponentPath.h"
 #include "Logger.h"
 #include "OpenSim/Common/Array.h"
@@ -50,6 +51,9 @@
 #include "OpenSim/Common/ComponentSocket.h"
 #include "OpenSim/Common/Object.h"
 #include "simbody/internal/MultibodySystem.h"
+#include <memory>
+#include <mutex>
+#include <typeindex>
 #include <unordered_map>
 
 #include <OpenSim/Common/osimCommonDLL.h>
@@ -669,6 +673,44 @@ public:
         return count;
     }
 
+    /**
+     * Get the subcomponents of the specified type, in the order of
+     * getComponentList<T>(). The list is built on the first request for a
+     * type and cached, so that later requests (e.g., in every step of a
+     * simulation) do not traverse the tree:
+     *
+     * @code{.cpp}
+     * for (const Muscle* muscle : model.getComponentsOfType<Muscle>()) {
+     *     muscle->getActivation(state);
+     * }
+     * @endcode
+     *
+     * The cached lists are discarded by finalizeFromProperties() of this
+     * component or any of its subcomponents, which is invoked whenever
+     * components are added, so the returned list is only valid until then.
+     * This may be invoked by multiple threads at the same time (as long as
+     * the tree is not changed). Components removed without invoking
+     * finalizeFromProperties() remain in the list.
+     *
+     * @tparam T A subclass of Component (e.g., Body, Muscle).
+     */
+    template <typename T = Component>
+    const std::vector<const T*>& getComponentsOfType() const {
+        static_assert(std::is_base_of<Component, T>::value,
+                "Template argument must be Component or a derived class.");
+        std::lock_guard<std::mutex> lock(_componentsOfType.mutex);
+        std::shared_ptr<void>& list =
+                _componentsOfType.lists[std::type_index(typeid(T))];
+        if (!list) {
+            auto components = std::make_shared<std::vector<const T*>>();
+            for (const auto& comp : getComponentList<T>()) {
+                components->push_back(&comp);
+            }
+            list = components;
+        }
+        return *static_cast<const std::vector<const T*>*>(list.get());
+    }
+
     /** Class that permits iterating over components/subcomponents (but does
      * not actually contain the components themselves). */
     template <typename T>
@@ -1368,6 +1410,49 @@ public:
     double getStateVariableDerivativeValue(const SimTK::State& state,
         const std::string& name) const;
 
+    /**
+     * Get the names (not paths) of the state variables of this Component
+     * (not of its subcomponents) whose dynamics are in implicit form: instead
+     * of computing their derivatives (see computeStateVariableDerivatives()),
+     * this Component computes residuals that are 0 when the derivatives
+     * provided by a solver are consistent with its dynamics (see
+     * computeImplicitResiduals()). The implicit form avoids solving the
+     * dynamics for the derivatives (e.g., a muscle-tendon equilibrium solved
+     * by root finding), but can be used only by solvers that support implicit
+     * dynamics (e.g., Moco), which provide the derivatives through the
+     * discrete variables named by getImplicitDerivativeName().
+     *
+     * This depends only on the properties of the Component (it is valid after
+     * finalizeFromProperties()). By default, there are no such state
+     * variables. Components that override this must override
+     * computeImplicitResiduals() and add the discrete variables for the
+     * derivatives in extendAddToSystem().
+     */
+    virtual std::vector<std::string> getImplicitStateVariableNames() const {
+        return {};
+    }
+
+    /**
+     * Compute the residuals of the implicit dynamics of the state variables
+     * named by getImplicitStateVariableNames(), in that order, given the
+     * derivatives of those state variables in their discrete variables (see
+     * getImplicitDerivativeName()). `residuals` has the size of
+     * getImplicitStateVariableNames(). The residuals may depend on stages up
+     * to SimTK::Stage::Dynamics.
+     */
+    virtual void computeImplicitResiduals(const SimTK::State& state,
+            SimTK::Vector& residuals) const {}
+
+    /**
+     * The name of the discrete variable that holds the derivative of a state
+     * variable whose dynamics are in implicit form (see
+     * getImplicitStateVariableNames()): "implicitderiv_<stateVariableName>".
+     */
+    static std::string getImplicitDerivativeName(
+            const std::string& stateVariableName) {
+        return "implicitderiv_" + stateVariableName;
+    }
+
     /**
      * Get the value of a discrete variable allocated by this Component by name.
      *
@@ -1954,11 +2039,37 @@ public:
     void printOutputInfo(const bool includeDescendants = true) const;
     /// @}
 
+    /** @name Profiling
+    Record the wall-clock time spent in the realization hooks of the
+    components of a tree. See ComponentProfiler. */
+    /// @{
+    /** Start (`true`) or stop (`false`) recording the time spent in the
+    realization hooks of this component and all of its subcomponents.
+    Enabling profiling creates an empty profile; disabling it discards the
+    profile. Profiling can only be enabled on the root component (e.g., the
+    Model), and is not copied with it.                                       */
+    void setProfilingEnabled(bool enabled);
+    /** Whether setProfilingEnabled() has been called with `true` (and not
+    with `false` since).                                                     */
+    bool isProfilingEnabled() const { return _profiler.get() != nullptr; }
+    /** Get the profile of this (root) component.
+    @throws Exception if profiling is not enabled.                            */
+    const ComponentProfiler& getProfiler() const;
+    /** Get a writable reference to the profile of this (root) component, e.g.,
+    to clear() it.
+    @throws Exception if profiling is not enabled.                            */
+    ComponentProfiler& updProfiler();
+    /// @}
+
 protected:
     class StateVariable;
     //template <class T> friend class ComponentSet;
     // Give the ComponentMeasure access to the realize() methods.
     template <class T> friend class ComponentMeasure;
+    // Give the StateVariableAccessor access to the StateVariables.
+    friend class StateVariableAccessor;
+    // Give the ComponentProfiler access to the profiler of the root.
+    friend class ComponentProfiler::Scope;
 
 #ifndef SWIG
     /// @class MemberSubcomponentIndex
@@ -2635,6 +2746,11 @@ public:
      * This returns nullptr if a StateVariable does not exist at the specified
      * path or if the path is invalid.
      *
+     * Absolute paths (and, for the root component, paths relative to the
+     * root) are looked up in an index of all state variables in the tree,
+     * which the root component builds when it is added to a System, so these
+     * lookups do not traverse the tree.
+     *
      * @throws ComponentHasNoSystem if this Component has not been added to a
      *         System (i.e., if initSystem has not been called)
      */
@@ -3242,12 +3358,49 @@ private:
     // Check that the list of _allStateVariables is valid
     bool isAllStatesVariablesListValid() const;
 
+    // Index the state variables of this (root) component and all of its
+    // subcomponents by absolute path, for the current System.
+    void indexStateVariablesByPath() const;
+    // Look up a state variable in the root's index; nullptr if the path is
+    // not in the index or the index is not for the current System.
+    const StateVariable* findIndexedStateVariable(
+            const std::string& pathName) const;
+
     // Array of all state variables for fast access during simulation
     mutable SimTK::Array_<SimTK::ReferencePtr<const StateVariable> >
                                                             _allStateVariables;
     // A handle the System associated with the above state variables
     mutable SimTK::ReferencePtr<const SimTK::System> _statesAssociatedSystem;
 
+    // Index of all state variables in the tree by absolute path (only for the
+    // root component), and the System for which it was built.
+    mutable SimTK::ResetOnCopy<std::unordered_map<std::string,
+            SimTK::ReferencePtr<const StateVariable>>> _stateVariablesByPath;
+    mutable SimTK::ReferencePtr<const SimTK::System>
+            _stateVariablesByPathSystem;
+
+    // The profiler of the tree (only for the root component); null unless
+    // profiling is enabled.
+    SimTK::ResetOnCopy<std::unique_ptr<ComponentProfiler>> _profiler;
+
+    // The lists of subcomponents by type returned by getComponentsOfType();
+    // not copied with the component.
+    struct ComponentsOfTypeCache {
+        ComponentsOfTypeCache() = default;
+        ComponentsOfTypeCache(const ComponentsOfTypeCache&) {}
+        ComponentsOfTypeCache& operator=(const ComponentsOfTypeCache&) {
+            clear();
+            return *this;
+        }
+        void clear() {
+            std::lock_guard<std::mutex> lock(mutex);
+            lists.clear();
+        }
+        std::mutex mutex;
+        std::unordered_map<std::type_index, std::shared_ptr<void>> lists;
+    };
+    mutable ComponentsOfTypeCache _componentsOfType;
+
 //==============================================================================
 };  // END of class Component
 //==============================================================================
@@ -342,6 +342,13 @@ public:
         _output->_outputFcn(_output->_owner.get(), state, _channelName, _result);
         return _result;
     }
+    /** Compute the value of this channel directly into `result`, without
+    copying it through the channel's cache. The caller is responsible for
+    realizing `state` to the stage on which the output depends (see
+    OutputPlan).                                                             */
+    void calcValue(const SimTK::State& state, T& result) const {
+        _output->_outputFcn(_output->_owner.get(), state, _channelName, result);
+    }
     const Output<T>& getOutput() const { return _output.getRef(); }
     const std::string& getChannelName() const override {
         if (_channelName.empty()) return getOutput().getName();
@@ -0,0 +1,135 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  ComponentProfiler.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ComponentProfiler.h"
+
+#include "Component.h"
+
+#include <algorithm>
+#include <fstream>
+#include <tuple>
+
+using namespace OpenSim;
+
+std::atomic<int> ComponentProfiler::s_numProfilers(0);
+
+ComponentProfiler::ComponentProfiler() { ++s_numProfilers; }
+
+ComponentProfiler::~ComponentProfiler() { --s_numProfilers; }
+
+const char* ComponentProfiler::getHookName(Hook hook) {
+    switch (hook) {
+    case Hook::RealizeTopology: return "realizeTopology";
+    case Hook::RealizeModel: return "realizeModel";
+    case Hook::RealizeInstance: return "realizeInstance";
+    case Hook::RealizeTime: return "realizeTime";
+    case Hook::RealizePosition: return "realizePosition";
+    case Hook::RealizeVelocity: return "realizeVelocity";
+    case Hook::RealizeDynamics: return "realizeDynamics";
+    case Hook::RealizeAcceleration: return "realizeAcceleration";
+    case Hook::RealizeReport: return "realizeReport";
+    case Hook::ComputeStateVariableDerivatives:
+        return "computeStateVariableDerivatives";
+    case Hook::ComputeForce: return "computeForce";
+    case Hook::ComputeCacheVariable: return "computeCacheVariable";
+    }
+    return "";
+}
+
+std::vector<std::string> ComponentProfiler::getComponentPaths() const {
+    std::vector<std::string> paths;
+    paths.reserve(_entries.size());
+    for (const auto& entry : _entries) paths.push_back(entry.first);
+    return paths;
+}
+
+ComponentProfiler::Entry ComponentProfiler::getEntry(
+        const std::string& componentPath, Hook hook) const {
+    const auto it = _entries.find(componentPath);
+    if (it == _entries.end()) return Entry();
+    return it->second[int(hook)];
+}
+
+void ComponentProfiler::clear() {
+    _entries.clear();
+    _entriesByComponent.clear();
+}
+
+std::string ComponentProfiler::toString() const {
+    // (time, path, hook, calls), sorted by decreasing time.
+    std::vector<std::tuple<long long, const std::string*, int, long long>>
+            rows;
+    for (const auto& entries : _entries) {
+        for (int ihook = 0; ihook < NumHooks; ++ihook) {
+            const Entry& entry = entries.second[ihook];
+            if (entry.numCalls == 0) continue;
+            rows.emplace_back(entry.timeInNs, &entries.first, ihook,
+                    entry.numCalls);
+        }
+    }
+    std::stable_sort(rows.begin(), rows.end(),
+            [](const decltype(rows)::value_type& a,
+                    const decltype(rows)::value_type& b) {
+                return std::get<0>(a) > std::get<0>(b);
+            });
+
+    std::string table = "component\thook\tcalls\ttotal_time_s\tmean_time_us\n";
+    for (const auto& row : rows) {
+        const double time = 1e-9 * std::get<0>(row);
+        const long long numCalls = std::get<3>(row);
+        table += fmt::format("{}\t{}\t{}\t{:.6g}\t{:.6g}\n",
+                *std::get<1>(row), getHookName(Hook(std::get<2>(row))),
+                numCalls, time, 1e6 * time / numCalls);
+    }
+    return table;
+}
+
+void ComponentProfiler::print(const std::string& fileName) const {
+    std::ofstream file(fileName);
+    OPENSIM_THROW_IF(!file.good(), Exception,
+            "Could not open file '{}' for writing.", fileName);
+    file << toString();
+}
+
+void ComponentProfiler::record(
+        const Component& component, Hook hook, long long timeInNs) {
+    Entries*& entries = _entriesByComponent[&component];
+    if (!entries) {
+        entries = &_entries[component.getAbsolutePathString()];
+    }
+    Entry& entry = (*entries)[int(hook)];
+    ++entry.numCalls;
+    entry.timeInNs += timeInNs;
+}
+
+void ComponentProfiler::Scope::begin(const Component& component, Hook hook) {
+    _profiler = component.getRoot()._profiler.get();
+    if (!_profiler) return;
+    _component = &component;
+    _hook = hook;
+    _startTimeInNs = SimTK::realTimeInNs();
+}
+
+void ComponentProfiler::Scope::end() {
+    _profiler->record(*_component, _hook,
+            SimTK::realTimeInNs() - _startTimeInNs);
+}
@@ -0,0 +1,166 @@
+#ifndef OPENSIM_COMPONENT_PROFILER_H_
+#define OPENSIM_COMPONENT_PROFILER_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  ComponentProfiler.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenSim {
+
+class Component;
+
+/**
+ * Accumulates the wall-clock time spent in, and the number of calls to, the
+ * realization hooks of each component of a component tree (e.g., a Model).
+ * A profiler is created with Component::setProfilingEnabled() on the root
+ * component, and is then available from Component::getProfiler():
+ * @code
+ * model.setProfilingEnabled(true);
+ * SimTK::State& state = model.initSystem();
+ * Manager manager(model, state);
+ * manager.integrate(1.0);
+ * std::cout << model.getProfiler().toString() << std::endl;
+ * model.getProfiler().print("profile.txt");
+ * @endcode
+ *
+ * The times of nested hooks are inclusive: e.g., the time of the
+ * RealizeAcceleration hook of a component includes the time of its
+ * ComputeStateVariableDerivatives hook, and the time of a hook includes the
+ * time of any lazily-evaluated cache variables (e.g., of other components)
+ * that it requires.
+ *
+ * When no profiler exists, a hook costs a single atomic load; when profiling
+ * is enabled (for any component tree), each hook also looks up the profiler
+ * of its root component. A profiler must only be used by one thread at a
+ * time, which is the case if each thread simulates its own copy of a model.
+ */
+class OSIMCOMMON_API ComponentProfiler {
+public:
+    /// The profiled hooks.
+    enum class Hook {
+        RealizeTopology,     ///< Component::extendRealizeTopology()
+        RealizeModel,        ///< Component::extendRealizeModel()
+        RealizeInstance,     ///< Component::extendRealizeInstance()
+        RealizeTime,         ///< Component::extendRealizeTime()
+        RealizePosition,     ///< Component::extendRealizePosition()
+        RealizeVelocity,     ///< Component::extendRealizeVelocity()
+        RealizeDynamics,     ///< Component::extendRealizeDynamics()
+        RealizeAcceleration, ///< Component::extendRealizeAcceleration()
+        RealizeReport,       ///< Component::extendRealizeReport()
+        /// Component::computeStateVariableDerivatives()
+        ComputeStateVariableDerivatives,
+        ComputeForce,        ///< Force::computeForce()
+        /// Recomputation of an invalid cache variable (e.g., the path of a
+        /// GeometryPath).
+        ComputeCacheVariable
+    };
+    static constexpr int NumHooks = int(Hook::ComputeCacheVariable) + 1;
+
+    /// The accumulated number of calls and wall-clock time of a hook.
+    struct Entry {
+        long long numCalls = 0;
+        long long timeInNs = 0;
+    };
+
+    ComponentProfiler();
+    ~ComponentProfiler();
+    ComponentProfiler(const ComponentProfiler&) = delete;
+    ComponentProfiler& operator=(const ComponentProfiler&) = delete;
+
+    /// The name of the hook, e.g., "realizeAcceleration".
+    static const char* getHookName(Hook hook);
+
+    /// The absolute paths of the components for which any hook has been
+    /// recorded, in alphabetical order.
+    std::vector<std::string> getComponentPaths() const;
+    /// The accumulated calls of `hook` of the component with the given
+    /// absolute path (zero if none were recorded).
+    Entry getEntry(const std::string& componentPath, Hook hook) const;
+    /// Discard all recorded calls.
+    void clear();
+
+    /// A table of the recorded hooks (one per line; sorted by decreasing
+    /// time) with the columns component, hook, calls, total time (s), and
+    /// mean time per call (us), separated by tabs.
+    std::string toString() const;
+    /// Write toString() to a file.
+    void print(const std::string& fileName) const;
+
+    /// Add a call of `hook` of `component`, which took `timeInNs`.
+    void record(const Component& component, Hook hook, long long timeInNs);
+    /// Forget the addresses of the components for which calls were recorded
+    /// (but not the recorded calls), e.g., because the component tree was
+    /// rebuilt. Components are identified by absolute path in the results.
+    void forgetComponents() { _entriesByComponent.clear(); }
+
+    /// Times the lifetime of this object and records it as a call of a hook
+    /// of a component in the profiler of the root of the component, if one
+    /// exists. Use it in performance-critical methods of components:
+    /// @code
+    /// {
+    ///     ComponentProfiler::Scope scope(*this,
+    ///             ComponentProfiler::Hook::ComputeCacheVariable);
+    ///     // ... compute the cache variable ...
+    /// }
+    /// @endcode
+    class OSIMCOMMON_API Scope {
+    public:
+        Scope(const Component& component, Hook hook) {
+            if (s_numProfilers.load(std::memory_order_relaxed) != 0) {
+                begin(component, hook);
+            }
+        }
+        ~Scope() { if (_profiler) end(); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        void begin(const Component& component, Hook hook);
+        void end();
+        ComponentProfiler* _profiler = nullptr;
+        const Component* _component = nullptr;
+        Hook _hook = Hook::RealizeTopology;
+        long long _startTimeInNs = 0;
+    };
+
+private:
+    typedef std::array<Entry, NumHooks> Entries;
+
+    // The number of existing profilers, so that hooks can skip the lookup of
+    // the profiler when none exist.
+    static std::atomic<int> s_numProfilers;
+
+    // Entries by absolute path of the component, and a cache of pointers to
+    // them by the address of the component.
+    std::map<std::string, Entries> _entries;
+    std::unordered_map<const Component*, Entries*> _entriesByComponent;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_COMPONENT_PROFILER_H_
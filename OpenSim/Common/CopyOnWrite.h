@@ -0,0 +1,127 @@
+#ifndef OPENSIM_COPY_ON_WRITE_H_
+#define OPENSIM_COPY_ON_WRITE_H_
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  CopyOnWrite.h                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace OpenSim {
+
+/** A value of type T that copies of this object share until one of them is
+modified (copy-on-write), so that copying is O(1). This is used for the data
+and the metadata of DataTable_.
+
+Reading is through get() (or `*` and `->`, which are const). Modifying is
+through upd(), which first copies the value if it is shared. upd() is meant
+for changes made within a call; if a reference to the value is kept (e.g., a
+reference or a view returned to the user by an `upd` method of DataTable_),
+use updUnshared() instead, after which copies of this object do not share the
+value (they copy it right away), since it may be modified through the
+reference at any time. Assigning a new value makes the value shareable again.
+
+As for the standard containers, an object must not be modified while another
+thread accesses it, but distinct objects that share a value can be used by
+different threads.                                                            */
+template <typename T>
+class CopyOnWrite {
+public:
+    CopyOnWrite() : _value(std::make_shared<T>()) {}
+    CopyOnWrite(const T& value) : _value(std::make_shared<T>(value)) {}
+    CopyOnWrite(T&& value) : _value(std::make_shared<T>(std::move(value))) {}
+
+    CopyOnWrite(const CopyOnWrite& other) : _value(other.share()) {}
+    CopyOnWrite(CopyOnWrite&& other) :
+            _value(std::move(other._value)), _shareable(other._shareable) {
+        other._value = std::make_shared<T>();
+        other._shareable = true;
+    }
+    CopyOnWrite& operator=(const CopyOnWrite& other) {
+        if (this != &other) {
+            _value = other.share();
+            _shareable = true;
+        }
+        return *this;
+    }
+    CopyOnWrite& operator=(CopyOnWrite&& other) {
+        if (this != &other) {
+            _value = std::move(other._value);
+            _shareable = other._shareable;
+            other._value = std::make_shared<T>();
+            other._shareable = true;
+        }
+        return *this;
+    }
+    CopyOnWrite& operator=(const T& value) {
+        _value = std::make_shared<T>(value);
+        _shareable = true;
+        return *this;
+    }
+    CopyOnWrite& operator=(T&& value) {
+        _value = std::make_shared<T>(std::move(value));
+        _shareable = true;
+        return *this;
+    }
+
+    const T& get() const { return *_value; }
+    const T& operator*() const { return *_value; }
+    const T* operator->() const { return _value.get(); }
+
+    /** Get a writable reference to the value, which is copied first if it is
+    shared. The reference must not be kept after the changes are made (see
+    updUnshared()).                                                         */
+    T& upd() {
+        if (_value.use_count() > 1) {
+            _value = std::make_shared<T>(*_value);
+        } else {
+            // The other objects that shared the value may have released it
+            // from other threads; their use of the value happens before this
+            // modification.
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *_value;
+    }
+
+    /** Get a writable reference to the value that may be kept: copies of
+    this object do not share the value anymore.                             */
+    T& updUnshared() {
+        T& value = upd();
+        _shareable = false;
+        return value;
+    }
+
+    /** Whether the value is shared with other objects (for testing).       */
+    bool isShared() const { return _value.use_count() > 1; }
+
+private:
+    std::shared_ptr<T> share() const {
+        return _shareable ? _value : std::make_shared<T>(*_value);
+    }
+
+    std::shared_ptr<T> _value;
+    bool _shareable = true;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_COPY_ON_WRITE_H_
@@ -22,10 +22,16 @@
  * See the License for the specific language governing permissions and        *
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
-#include <queue>
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
 #include <SimTKcommon.h>
 #include <OpenSim/Common/osimCommonDLL.h>
+#include <OpenSim/Common/Exception.h>
 
 namespace OpenSim {
 
@@ -54,11 +60,13 @@ public:
     virtual ~DataQueueEntry_(){};
 
     double getTimeStamp() const { return _timeStamp; };
-    SimTK::RowVectorView_<U> getData() const { return _data; };
+    const SimTK::RowVector_<U>& getData() const { return _data; };
 
 private:
     double _timeStamp;
-    SimTK::RowVectorView_<U> _data;
+    // The entry owns its data so that the queue does not need to keep
+    // (and leak) a separate heap-allocated copy alive.
+    SimTK::RowVector_<U> _data;
 };
 /**
  * DataQueue is a wrapper around the std::queue customized to handle data 
@@ -68,6 +76,12 @@ private:
  * making sure order is preserved.
  * timestamp is required to pass in data so that clients can enforce order,
  * however timestamp is not used/order-enforced internally.
+ *
+ * For real-time use (e.g., streaming IMU data at a few hundred Hz), the queue
+ * can be switched to a bounded ring buffer by calling reserve(). In that mode
+ * all storage is preallocated with a fixed row width, and the queue is
+ * lock-free for exactly one producer thread and one consumer thread, so that
+ * neither push_back() nor the pop methods allocate memory or take a mutex.
  */
 // @TODO Test support of multiple consumers. 
 template<class T> class DataQueue_ {
@@ -82,53 +96,215 @@ public:
     
     DataQueue_()                                = default;
     // using compiler generated methods here is problematic due to mutex 
-    DataQueue_(const DataQueue_& other){ 
-        m_data_queue = other.m_data_queue;
-    };
-    DataQueue_(DataQueue_&& other){ 
-        m_data_queue = other.m_data_queue;
-    };
+    // and atomics. Copying is not synchronized with concurrent producers or
+    // consumers of other.
+    DataQueue_(const DataQueue_& other) { copyFrom(other); };
+    DataQueue_(DataQueue_&& other) { copyFrom(other); };
     DataQueue_& operator=(const DataQueue_& other) { 
-        m_data_queue = other.m_data_queue;
+        if (this != &other) copyFrom(other);
         return (*this);
     };
 
+    //--------------------------------------------------------------------------
+    // Ring buffer configuration
+    //--------------------------------------------------------------------------
+    /** Switch this queue to a bounded, preallocated single-producer/
+     * single-consumer ring buffer that can hold up to `capacity` rows, each
+     * with exactly `rowWidth` elements. Any data currently in the queue is
+     * discarded. This must not be called while other threads are using the
+     * queue. */
+    void reserve(int capacity, int rowWidth) {
+        OPENSIM_THROW_IF(capacity <= 0 || rowWidth < 0, Exception,
+                "Expected a positive capacity and a nonnegative row width.");
+        std::unique_lock<std::mutex> mlock(m_mutex);
+        m_data_queue = std::queue<DataQueueEntry_<T>>();
+        m_capacity = static_cast<size_t>(capacity);
+        m_rowWidth = rowWidth;
+        m_ringTimes.assign(m_capacity, SimTK::NaN);
+        m_ringData.assign(m_capacity * rowWidth, T());
+        m_head.store(0);
+        m_tail.store(0);
+    }
+    /** Whether reserve() has been called and the queue uses the ring buffer
+     * backend. */
+    bool isRingBuffer() const { return m_capacity > 0; }
+    /** Maximum number of rows the ring buffer can hold (0 if the queue is not
+     * a ring buffer, in which case it is unbounded). */
+    int getCapacity() const { return static_cast<int>(m_capacity); }
+    /** Number of elements per row in the ring buffer (0 if the queue is not a
+     * ring buffer). */
+    int getRowWidth() const { return m_rowWidth; }
+
     //--------------------------------------------------------------------------
     // DataQueue Interface
     //--------------------------------------------------------------------------
-    // push data and associated timestamp to the end of the queue
+    // push data and associated timestamp to the end of the queue.
+    // If the queue is a ring buffer and is full, wait for the consumer to
+    // make room.
     void push_back(const double time, const SimTK::RowVectorView_<T>& data) { 
-        SimTK::RowVector_<T>* deepCopy = new SimTK::RowVector_<T>(data);
+        if (isRingBuffer()) {
+            while (!try_push_back(time, data)) { std::this_thread::yield(); }
+            return;
+        }
+        DataQueueEntry_<T> entry(time, data);
         std::unique_lock<std::mutex> mlock(m_mutex);
-        m_data_queue.push(DataQueueEntry_<T>(time, *deepCopy));
+        m_data_queue.push(std::move(entry));
         mlock.unlock();     // unlock before notificiation to minimize mutex con
         m_cond.notify_one(); 
     }
+    /** Push data to the end of the queue without waiting. Returns false if
+     * the queue is a ring buffer that is full, in which case nothing is
+     * pushed. */
+    bool try_push_back(const double time,
+            const SimTK::RowVectorView_<T>& data) {
+        if (!isRingBuffer()) {
+            push_back(time, data);
+            return true;
+        }
+        OPENSIM_THROW_IF(data.size() != m_rowWidth, Exception,
+                "Expected a row with " + std::to_string(m_rowWidth) +
+                " elements, but got " + std::to_string(data.size()) + ".");
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == m_capacity) {
+            return false;
+        }
+        const size_t slot = tail % m_capacity;
+        m_ringTimes[slot] = time;
+        T* dest = &m_ringData[slot * m_rowWidth];
+        for (int i = 0; i < m_rowWidth; ++i) { dest[i] = data[i]; }
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
     // pop the front of the queue and return data and associated timestamp
+    // (waits until data is available).
     void pop_front(double& time, SimTK::RowVector_<T>& data) { 
+        if (isRingBuffer()) {
+            while (!try_pop_front(time, data)) { std::this_thread::yield(); }
+            return;
+        }
         std::unique_lock<std::mutex> mlock(m_mutex);
         while (m_data_queue.empty()) { m_cond.wait(mlock); }
-        DataQueueEntry_<SimTK::Rotation> frontEntry = m_data_queue.front();
+        DataQueueEntry_<T> frontEntry = std::move(m_data_queue.front());
         m_data_queue.pop();
         mlock.unlock(); 
         time = frontEntry.getTimeStamp();
         data = frontEntry.getData();
     }
+    /** Pop the front of the queue without waiting. Returns false if the
+     * queue is empty, in which case time and data are not modified. In ring
+     * buffer mode, no memory is allocated if data already has the row width
+     * of the queue. */
+    bool try_pop_front(double& time, SimTK::RowVector_<T>& data) {
+        if (!isRingBuffer()) {
+            std::unique_lock<std::mutex> mlock(m_mutex);
+            if (m_data_queue.empty()) return false;
+            DataQueueEntry_<T> frontEntry = std::move(m_data_queue.front());
+            m_data_queue.pop();
+            mlock.unlock();
+            time = frontEntry.getTimeStamp();
+            data = frontEntry.getData();
+            return true;
+        }
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) return false;
+        const size_t slot = head % m_capacity;
+        time = m_ringTimes[slot];
+        if (data.size() != m_rowWidth) data.resize(m_rowWidth);
+        const T* src = &m_ringData[slot * m_rowWidth];
+        for (int i = 0; i < m_rowWidth; ++i) { data[i] = src[i]; }
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    /** Pop up to `maxRows` rows from the front of the queue without waiting,
+     * writing the timestamps into the first entries of `times` and the data
+     * into the leading rows of `data`. Both must already be large enough to
+     * hold `maxRows` rows (and, for `data`, have as many columns as the row
+     * width); they are not resized. Returns the number of rows popped. */
+    int try_pop_front_batch(int maxRows, SimTK::Vector& times,
+            SimTK::Matrix_<T>& data) {
+        OPENSIM_THROW_IF(times.size() < maxRows || data.nrow() < maxRows,
+                Exception, "Expected times and data to hold at least " +
+                std::to_string(maxRows) + " rows.");
+        int numPopped = 0;
+        SimTK::RowVector_<T> row;
+        while (numPopped < maxRows) {
+            if (isRingBuffer()) {
+                OPENSIM_THROW_IF(data.ncol() != m_rowWidth, Exception,
+                        "Expected data to have " +
+                        std::to_string(m_rowWidth) + " columns.");
+                const size_t head = m_head.load(std::memory_order_relaxed);
+                const size_t tail = m_tail.load(std::memory_order_acquire);
+                if (head == tail) break;
+                // Drain everything that is available in one pass.
+                const size_t available = std::min(tail - head,
+                        static_cast<size_t>(maxRows - numPopped));
+                for (size_t k = 0; k < available; ++k) {
+                    const size_t slot = (head + k) % m_capacity;
+                    times[numPopped] = m_ringTimes[slot];
+                    const T* src = &m_ringData[slot * m_rowWidth];
+                    for (int i = 0; i < m_rowWidth; ++i) {
+                        data(numPopped, i) = src[i];
+                    }
+                    ++numPopped;
+                }
+                m_head.store(head + available, std::memory_order_release);
+            } else {
+                double time;
+                if (!try_pop_front(time, row)) break;
+                times[numPopped] = time;
+                data[numPopped] = row;
+                ++numPopped;
+            }
+        }
+        return numPopped;
+    }
     // check if the queue is empty
     bool isEmpty() { 
+        if (isRingBuffer()) return getSize() == 0;
         bool status = false;
         std::unique_lock<std::mutex> mlock(m_mutex);
         status = m_data_queue.empty();
         mlock.unlock(); 
         return status;
     }
+    /** Number of rows currently in the queue. With concurrent producers or
+     * consumers, this is only a snapshot. */
+    int getSize() {
+        if (isRingBuffer()) {
+            const size_t head = m_head.load(std::memory_order_acquire);
+            const size_t tail = m_tail.load(std::memory_order_acquire);
+            return static_cast<int>(tail - head);
+        }
+        std::unique_lock<std::mutex> mlock(m_mutex);
+        return static_cast<int>(m_data_queue.size());
+    }
 private:
+    void copyFrom(const DataQueue_& other) {
+        m_data_queue = other.m_data_queue;
+        m_capacity = other.m_capacity;
+        m_rowWidth = other.m_rowWidth;
+        m_ringTimes = other.m_ringTimes;
+        m_ringData = other.m_ringData;
+        m_head.store(other.m_head.load());
+        m_tail.store(other.m_tail.load());
+    }
+
     // As of now we use std::queue but other data structures could be used as well
     std::queue<DataQueueEntry_<T>> m_data_queue;
     std::mutex m_mutex;
     std::condition_variable m_cond;
 
-    //=============================================================================
+    // Ring buffer backend (used only if m_capacity > 0). m_head and m_tail
+    // are monotonically increasing counts of popped and pushed rows; the
+    // producer only writes m_tail and the consumer only writes m_head.
+    size_t m_capacity{0};
+    int m_rowWidth{0};
+    std::vector<double> m_ringTimes;
+    std::vector<T> m_ringData;
+    std::atomic<size_t> m_head{0};
+    std::atomic<size_t> m_tail{0};
+
+//=============================================================================
 };  // END of class templatized DataQueue_<T>
 //=============================================================================
 }
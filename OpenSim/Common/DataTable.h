@@ -189,17 +189,17 @@ public:
         // std::string type, drop the metadata because type information is
         // required to interpret them.
         // Column-labels will be handled separately as they need suffixing.
-        for(const auto& key : _dependentsMetaData.getKeys()) {
+        for(const auto& key : _dependentsMetaData->getKeys()) {
             if(key == "labels")
                 continue;
 
-            auto absValueArray = &_dependentsMetaData.updValueArrayForKey(key);
+            auto absValueArray = &_dependentsMetaData.upd().updValueArrayForKey(key);
             ValueArray<std::string>* valueArray{};
             try {
                 valueArray =
                     dynamic_cast<ValueArray<std::string>*>(absValueArray);
             } catch (const std::bad_cast&) {
-                _dependentsMetaData.removeValueArrayForKey(key);
+                _dependentsMetaData.upd().removeValueArrayForKey(key);
                 continue;
             }
             auto& values = valueArray->upd();
@@ -226,14 +226,15 @@ public:
         setColumnLabels(thisLabels);
 
         // Construct matrix for this table from that table.
-        _depData.resize((int)that.getNumRows(), 
+        auto& depData = _depData.upd();
+        depData.resize((int)that.getNumRows(), 
             (int)that.getNumColumns() * that.numComponentsPerElement());
         for(unsigned r = 0; r < that.getNumRows(); ++r) {
             const auto& thatRow = that.getRowAtIndex(r);
             for (unsigned c = 0; c < that.getNumColumns(); ++c) {
-                splitAndAssignElement(_depData.updRow(r).begin() +
+                splitAndAssignElement(depData.updRow(r).begin() +
                                         c*that.numComponentsPerElement(), 
-                                      _depData.updRow(r).end(),
+                                      depData.updRow(r).end(),
                                       thatRow[c]);
             }
         }
@@ -383,12 +384,13 @@ public:
         setColumnLabels(thisLabels);
 
         // Construct matrix for this table from that table.
-        _depData.resize((int)that.getNumRows(), 
+        auto& depData = _depData.upd();
+        depData.resize((int)that.getNumRows(), 
             (int)that.getNumColumns() / numComponentsPerElement());
         for(unsigned r = 0; r < that.getNumRows(); ++r) {
             auto thatRow = that.getRowAtIndex(r).getAsRowVector();
             for(unsigned c = 0; c < this->getNumColumns(); ++c) {
-                _depData.updElt(r,c) = makeElement(
+                depData.updElt(r,c) = makeElement(
                     thatRow.begin() + c*numComponentsPerElement(), 
                     thatRow.end());
             }
@@ -651,11 +653,11 @@ public:
     \throws IncorrectNumColumns If the row added is invalid. Validity of the 
     row added is decided by the derived class.                                */
     void appendRow(const ETX& indRow, const RowVectorView& depRow) {
-        validateRow(_indData.size(), indRow, depRow);
+        validateRow(_indData->size(), indRow, depRow);
 
-        if (_dependentsMetaData.hasKey("labels")) {
+        if (_dependentsMetaData->hasKey("labels")) {
             auto& labels =
-                    _dependentsMetaData.getValueArrayForKey("labels");
+                    _dependentsMetaData->getValueArrayForKey("labels");
             OPENSIM_THROW_IF(static_cast<unsigned>(depRow.ncol()) !=
                              labels.size(),
                              IncorrectNumColumns,
@@ -663,15 +665,77 @@ public:
                              static_cast<size_t>(depRow.ncol()));
         }
 
-        _indData.push_back(indRow);
+        _indData.upd().push_back(indRow);
 
-        if(_depData.nrow() == 0) {
-            _depData.resize(1, depRow.size());
+        auto& depData = _depData.upd();
+        if(depData.nrow() == 0) {
+            depData.resize(1, depRow.size());
         }
         else 
-            _depData.resizeKeep(_depData.nrow() + 1, _depData.ncol());
+            depData.resizeKeep(depData.nrow() + 1, depData.ncol());
             
-        _depData.updRow(_depData.nrow() - 1) = depRow;
+        depData.updRow(depData.nrow() - 1) = depRow;
+    }
+
+    /** Append multiple rows to the DataTable_. This is equivalent to calling
+    appendRow() for each row of `depRows`, but the underlying matrix is resized
+    only once.
+
+    \param indRows Entries for the independent column corresponding to the
+                   rows to be appended.
+    \param depRows Matrix containing the rows to be appended.
+
+    \throws InvalidArgument If the number of entries in `indRows` does not
+                            match the number of rows in `depRows`.
+    \throws IncorrectNumColumns If the rows added are invalid. Validity of the
+    rows added is decided by the derived class.                               */
+    void appendRows(const std::vector<ETX>& indRows,
+                    const MatrixView& depRows) {
+        OPENSIM_THROW_IF(indRows.size() != static_cast<size_t>(depRows.nrow()),
+                         InvalidArgument,
+                         "Length of independent column (" +
+                         std::to_string(indRows.size()) + ") does not match "
+                         "number of rows of dependent data (" +
+                         std::to_string(depRows.nrow()) + ").");
+        if (indRows.empty()) return;
+
+        if (_dependentsMetaData->hasKey("labels")) {
+            auto& labels =
+                    _dependentsMetaData->getValueArrayForKey("labels");
+            OPENSIM_THROW_IF(static_cast<unsigned>(depRows.ncol()) !=
+                             labels.size(),
+                             IncorrectNumColumns,
+                             labels.size(),
+                             static_cast<size_t>(depRows.ncol()));
+        }
+        OPENSIM_THROW_IF(_depData->nrow() != 0 &&
+                         depRows.ncol() != _depData->ncol(),
+                         IncorrectNumColumns,
+                         static_cast<size_t>(_depData->ncol()),
+                         static_cast<size_t>(depRows.ncol()));
+
+        // Validate the rows in order, as appendRow() would.
+        const size_t numRows = _indData->size();
+        try {
+            for (size_t r = 0; r < indRows.size(); ++r) {
+                validateRow(_indData->size(), indRows[r],
+                            depRows.row(static_cast<int>(r)));
+                _indData.upd().push_back(indRows[r]);
+            }
+        } catch (...) {
+            _indData.upd().resize(numRows);
+            throw;
+        }
+
+        auto& depData = _depData.upd();
+        const int numDepRows = depData.nrow();
+        if (numDepRows == 0)
+            depData.resize(depRows.nrow(), depRows.ncol());
+        else
+            depData.resizeKeep(numDepRows + depRows.nrow(), depData.ncol());
+
+        depData.updBlock(numDepRows, 0, depRows.nrow(), depRows.ncol()) =
+                depRows;
     }
 
     /** Get row at index.                                                     
@@ -680,9 +744,9 @@ public:
     const RowVectorView getRowAtIndex(size_t index) const {
         OPENSIM_THROW_IF(isRowIndexOutOfRange(index),
                          RowIndexOutOfRange, 
-                         index, 0, static_cast<unsigned>(_indData.size() - 1));
+                         index, 0, static_cast<unsigned>(_indData->size() - 1));
 
-        return _depData.row(static_cast<int>(index));
+        return _depData->row(static_cast<int>(index));
     }
 
     /** Get row corresponding to the given entry in the independent column. This
@@ -693,12 +757,12 @@ public:
     \throws KeyNotFound If the independent column has no entry with given
                         value.                                                */
     const RowVectorView getRow(const ETX& ind) const {
-        auto iter = std::find(_indData.cbegin(), _indData.cend(), ind);
+        auto iter = std::find(_indData->cbegin(), _indData->cend(), ind);
 
-        OPENSIM_THROW_IF(iter == _indData.cend(),
+        OPENSIM_THROW_IF(iter == _indData->cend(),
                          KeyNotFound, std::to_string(ind));
 
-        return _depData.row((int)std::distance(_indData.cbegin(), iter));
+        return _depData->row((int)std::distance(_indData->cbegin(), iter));
     }
 
     /** Update row at index.                                                  
@@ -707,9 +771,9 @@ public:
     RowVectorView updRowAtIndex(size_t index) {
         OPENSIM_THROW_IF(isRowIndexOutOfRange(index),
                          RowIndexOutOfRange, 
-                         index, 0, static_cast<unsigned>(_indData.size() - 1));
+                         index, 0, static_cast<unsigned>(_indData->size() - 1));
 
-        return _depData.updRow((int)index);
+        return _depData.updUnshared().updRow((int)index);
     }
 
     /** Update row corresponding to the given entry in the independent column.
@@ -720,12 +784,13 @@ public:
     \throws KeyNotFound If the independent column has no entry with given
                         value.                                                */
     RowVectorView updRow(const ETX& ind) {
-        auto iter = std::find(_indData.cbegin(), _indData.cend(), ind);
+        auto iter = std::find(_indData->cbegin(), _indData->cend(), ind);
 
-        OPENSIM_THROW_IF(iter == _indData.cend(),
+        OPENSIM_THROW_IF(iter == _indData->cend(),
                          KeyNotFound, std::to_string(ind));
 
-        return _depData.updRow((int)std::distance(_indData.cbegin(), iter));
+        return _depData.updUnshared().updRow(
+                (int)std::distance(_indData->cbegin(), iter));
     }
 
     /** Set row at index. Equivalent to
@@ -735,7 +800,13 @@ public:
 
     \throws RowIndexOutOfRange If the index is out of range.                  */
     void setRowAtIndex(size_t index, const RowVectorView& depRow) {
-        updRowAtIndex(index) = depRow;
+        OPENSIM_THROW_IF(isRowIndexOutOfRange(index),
+                         RowIndexOutOfRange, 
+                         index, 0, static_cast<unsigned>(_indData->size() - 1));
+
+        // Unlike updRowAtIndex(), this does not keep a view of the matrix, so
+        // the matrix can still be shared with copies of this table.
+        _depData.upd().updRow((int)index) = depRow;
     }
 
     /** Set row at index. Equivalent to
@@ -745,7 +816,7 @@ public:
 
     \throws RowIndexOutOfRange If the index is out of range.                  */
     void setRowAtIndex(size_t index, const RowVector& depRow) {
-        updRowAtIndex(index) = depRow;
+        setRowAtIndex(index, depRow.getAsRowVectorView());
     }
 
     /** Set row corresponding to the given entry in the independent column.
@@ -760,7 +831,12 @@ public:
     \throws KeyNotFound If the independent column has no entry with given
                         value.                                                */
     void setRow(const ETX& ind, const RowVectorView& depRow) {
-        updRow(ind) = depRow;
+        auto iter = std::find(_indData->cbegin(), _indData->cend(), ind);
+
+        OPENSIM_THROW_IF(iter == _indData->cend(),
+                         KeyNotFound, std::to_string(ind));
+
+        setRowAtIndex(std::distance(_indData->cbegin(), iter), depRow);
     }
 
     /** Set row corresponding to the given entry in the independent column.
@@ -775,7 +851,7 @@ public:
     \throws KeyNotFound If the independent column has no entry with given
                         value.                                                */
     void setRow(const ETX& ind, const RowVector& depRow) {
-        updRow(ind) = depRow;
+        setRow(ind, depRow.getAsRowVectorView());
     }
 
     /** Remove row at index.
@@ -784,14 +860,16 @@ public:
     void removeRowAtIndex(size_t index) {
         OPENSIM_THROW_IF(isRowIndexOutOfRange(index),
                          RowIndexOutOfRange, 
-                         index, 0, static_cast<unsigned>(_indData.size() - 1));
+                         index, 0, static_cast<unsigned>(_indData->size() - 1));
 
+        auto& depData = _depData.upd();
         if(index < getNumRows() - 1)
             for(size_t r = index; r < getNumRows() - 1; ++r)
-                _depData.updRow((int)r) = _depData.row((int)(r + 1));
+                depData.updRow((int)r) = depData.row((int)(r + 1));
         
-        _depData.resizeKeep(_depData.nrow() - 1, _depData.ncol());
-        _indData.erase(_indData.begin() + index);
+        depData.resizeKeep(depData.nrow() - 1, depData.ncol());
+        auto& indData = _indData.upd();
+        indData.erase(indData.begin() + index);
     }
 
     /** Remove row corresponding to the given entry in the independent column.
@@ -799,12 +877,12 @@ public:
     \throws KeyNotFound If the independent column has no entry with the given
                         value.                                                */
     void removeRow(const ETX& ind) {
-        auto iter = std::find(_indData.cbegin(), _indData.cend(), ind);
+        auto iter = std::find(_indData->cbegin(), _indData->cend(), ind);
 
-        OPENSIM_THROW_IF(iter == _indData.cend(),
+        OPENSIM_THROW_IF(iter == _indData->cend(),
                          KeyNotFound, std::to_string(ind));
 
-        return removeRowAtIndex((int)std::distance(_indData.cbegin(), iter));
+        return removeRowAtIndex((int)std::distance(_indData->cbegin(), iter));
     }
 
     /// @} End of Row accessors/mutators.
@@ -814,7 +892,7 @@ public:
 
     /** Get independent column.                                               */
     const std::vector<ETX>& getIndependentColumn() const {
-        return _indData;
+        return *_indData;
     }
 
     /** Append column to the DataTable_ using a sequence container.
@@ -944,8 +1022,9 @@ public:
                          static_cast<size_t>(getNumRows()),
                          static_cast<size_t>(depCol.nrow()));
         
-        _depData.resizeKeep(_depData.nrow(), _depData.ncol() + 1);
-        _depData.updCol(_depData.ncol() - 1) = depCol;
+        auto& depData = _depData.upd();
+        depData.resizeKeep(depData.nrow(), depData.ncol() + 1);
+        depData.updCol(depData.ncol() - 1) = depCol;
         appendColumnLabel(columnLabel);
     }
 
@@ -955,21 +1034,22 @@ public:
         void removeColumnAtIndex(size_t index) {
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(index),
             ColumnIndexOutOfRange,
-            index, 0, static_cast<unsigned>(_depData.ncol() - 1));
+            index, 0, static_cast<unsigned>(_depData->ncol() - 1));
 
         // get copy of labels
         auto labels = getColumnLabels();
 
-        OPENSIM_ASSERT(labels.size() == _depData.ncol());
+        OPENSIM_ASSERT(labels.size() == _depData->ncol());
 
         // shift columns unless we're already at the last column
+        auto& depData = _depData.upd();
         for (size_t c = index; c < getNumColumns()-1; ++c) {
-            _depData.updCol((int)c) = _depData.col((int)(c + 1));
+            depData.updCol((int)c) = depData.col((int)(c + 1));
             labels[c] = labels[c + 1];
         }
 
-        _depData.resizeKeep(_depData.nrow(), _depData.ncol()-1);
-        labels.resize(_depData.ncol());
+        depData.resizeKeep(depData.nrow(), depData.ncol()-1);
+        labels.resize(depData.ncol());
         setColumnLabels(labels);
     }
 
@@ -997,9 +1077,9 @@ public:
         OPENSIM_THROW_IF(isEmpty(), EmptyTable);
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(index),
                          ColumnIndexOutOfRange, index, 0,
-                         static_cast<size_t>(_depData.ncol() - 1));
+                         static_cast<size_t>(_depData->ncol() - 1));
 
-        return _depData.col(static_cast<int>(index));
+        return _depData->col(static_cast<int>(index));
     }
 
     /** Get dependent Column which has the given column label.                
@@ -1007,7 +1087,7 @@ public:
     \throws KeyNotFound If columnLabel is not found to be label of any existing
                         column.                                               */
     VectorView getDependentColumn(const std::string& columnLabel) const {
-        return _depData.col(static_cast<int>(getColumnIndex(columnLabel)));
+        return _depData->col(static_cast<int>(getColumnIndex(columnLabel)));
     }
 
     /** Update dependent column at index.
@@ -1019,9 +1099,9 @@ public:
         OPENSIM_THROW_IF(isEmpty(), EmptyTable);
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(index),
                          ColumnIndexOutOfRange, index, 0,
-                         static_cast<size_t>(_depData.ncol() - 1));
+                         static_cast<size_t>(_depData->ncol() - 1));
 
-        return _depData.updCol(static_cast<int>(index));
+        return _depData.updUnshared().updCol(static_cast<int>(index));
     }
 
     /** Update dependent Column which has the given column label.
@@ -1029,7 +1109,8 @@ public:
     \throws KeyNotFound If columnLabel is not found to be label of any existing
                         column.                                               */
     VectorView updDependentColumn(const std::string& columnLabel) {
-        return _depData.updCol(static_cast<int>(getColumnIndex(columnLabel)));
+        return _depData.updUnshared().updCol(
+                static_cast<int>(getColumnIndex(columnLabel)));
     }
 
     /** %Set value of the independent column at index.
@@ -1043,10 +1124,10 @@ public:
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowIndex),
                          RowIndexOutOfRange, 
                          rowIndex, 0, 
-                         static_cast<unsigned>(_indData.size() - 1));
+                         static_cast<unsigned>(_indData->size() - 1));
 
-        validateRow(rowIndex, value, _depData.row((int)rowIndex));
-        _indData[rowIndex] = value;
+        validateRow(rowIndex, value, _depData->row((int)rowIndex));
+        _indData.upd()[rowIndex] = value;
     }
 
     /// @}
@@ -1058,7 +1139,7 @@ public:
 
     /** Get a read-only view to the underlying matrix.                        */
     const MatrixView& getMatrix() const {
-        return _depData.getAsMatrixView();
+        return _depData->getAsMatrixView();
     }
 
     /** Get a read-only view of a block of the underlying matrix.             
@@ -1080,21 +1161,21 @@ public:
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart),
                          RowIndexOutOfRange,
                          rowStart, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(_depData->nrow() - 1));
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart + numRows - 1),
                          RowIndexOutOfRange,
                          rowStart + numRows - 1, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(_depData->nrow() - 1));
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(columnStart),
                          ColumnIndexOutOfRange,
                          columnStart, 0, 
-                         static_cast<unsigned>(_depData.ncol() - 1));
+                         static_cast<unsigned>(_depData->ncol() - 1));
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(columnStart + numColumns - 1),
                          ColumnIndexOutOfRange,
                          columnStart + numColumns - 1, 0, 
-                         static_cast<unsigned>(_depData.ncol() - 1));
+                         static_cast<unsigned>(_depData->ncol() - 1));
 
-        return _depData.block(static_cast<int>(rowStart),
+        return _depData->block(static_cast<int>(rowStart),
                               static_cast<int>(columnStart),
                               static_cast<int>(numRows),
                               static_cast<int>(numColumns));
@@ -1102,7 +1183,7 @@ public:
 
     /** Get a writable view to the underlying matrix.                         */
     MatrixView& updMatrix() {
-        return _depData.updAsMatrixView();
+        return _depData.updUnshared().updAsMatrixView();
     }
 
     /** Get a writable view of a block of the underlying matrix.
@@ -1124,24 +1205,24 @@ public:
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart),
                          RowIndexOutOfRange,
                          rowStart, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(_depData->nrow() - 1));
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart + numRows - 1),
                          RowIndexOutOfRange,
                          rowStart + numRows - 1, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(_depData->nrow() - 1));
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(columnStart),
                          ColumnIndexOutOfRange,
                          columnStart, 0, 
-                         static_cast<unsigned>(_depData.ncol() - 1));
+                         static_cast<unsigned>(_depData->ncol() - 1));
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(columnStart + numColumns - 1),
                          ColumnIndexOutOfRange,
                          columnStart + numColumns - 1, 0, 
-                         static_cast<unsigned>(_depData.ncol() - 1));
+                         static_cast<unsigned>(_depData->ncol() - 1));
 
-        return _depData.updBlock(static_cast<int>(rowStart),
-                                 static_cast<int>(columnStart),
-                                 static_cast<int>(numRows),
-                                 static_cast<int>(numColumns));
+        return _depData.updUnshared().updBlock(static_cast<int>(rowStart),
+                                               static_cast<int>(columnStart),
+                                               static_cast<int>(numRows),
+                                               static_cast<int>(numColumns));
     }
 
     /// @}
@@ -1224,6 +1305,23 @@ protected:
     DataTable_(const std::vector<ETX>& indVec,
         const SimTK::Matrix_<ETY>& depData,
         const std::vector<std::string>& labels) {
+        setData(indVec, depData, labels);
+    }
+
+#ifndef SWIG
+    /** Same as above, but the data is moved into the table instead of being
+    copied.                                                                   */
+    DataTable_(std::vector<ETX>&& indVec,
+        SimTK::Matrix_<ETY>&& depData,
+        const std::vector<std::string>& labels) {
+        setData(std::move(indVec), std::move(depData), labels);
+    }
+#endif
+
+    // Used by the constructors from known data, which copy or move the data.
+    template<typename IndVec, typename DepData>
+    void setData(IndVec&& indVec, DepData&& depData,
+                 const std::vector<std::string>& labels) {
         OPENSIM_THROW_IF((int)indVec.size() != depData.nrow(), InvalidArgument,
             "Length of independent column does not match number of rows of "
             "dependent data.");
@@ -1232,8 +1330,8 @@ protected:
             "dependent data.");
 
         setColumnLabels(labels);
-        _indData = indVec;
-        _depData = depData;
+        _indData = std::forward<IndVec>(indVec);
+        _depData = std::forward<DepData>(depData);
     }
 
     /** Construct a table with only the independent column and 0
@@ -1242,7 +1340,7 @@ protected:
     DataTable_(const std::vector<ETX>& indVec) {
         setColumnLabels({});
         _indData = indVec;
-        _depData.resize((int)indVec.size(), 0);
+        _depData.upd().resize((int)indVec.size(), 0);
     }
 
     // Implement toString.
@@ -1548,22 +1646,22 @@ protected:
 
     /** Check if row index is out of range.                                   */
     bool isRowIndexOutOfRange(size_t index) const {
-        return index >= _indData.size();
+        return index >= _indData->size();
     }
 
     /** Check if column index is out of range.                                */
     bool isColumnIndexOutOfRange(size_t index) const {
-        return index >= static_cast<size_t>(_depData.ncol());
+        return index >= static_cast<size_t>(_depData->ncol());
     }
 
     /** Get number of rows.                                                   */
     size_t implementGetNumRows() const override {
-        return _depData.nrow();
+        return _depData->nrow();
     }
 
     /** Get number of columns.                                                */
     size_t implementGetNumColumns() const override {
-        return _depData.ncol();
+        return _depData->ncol();
     }
 
     /** Validate metadata for independent column.                             
@@ -1572,7 +1670,7 @@ protected:
                             a key named "labels".                             */
     void validateIndependentMetaData() const override {
         try {
-            _independentMetaData.getValueForKey("labels");
+            _independentMetaData->getValueForKey("labels");
         } catch(KeyNotFound&) {
             OPENSIM_THROW(MissingMetaData, "labels");
         }
@@ -1593,7 +1691,7 @@ protected:
     void validateDependentsMetaData() const override {
         size_t numCols{};
 
-        if (!_dependentsMetaData.hasKey("labels")) {
+        if (!_dependentsMetaData->hasKey("labels")) {
             OPENSIM_THROW(MissingMetaData, "labels");
         }
 
@@ -1618,16 +1716,16 @@ protected:
                 "Leading/trailing spaces are not permitted in column labels.");
         }
 
-        OPENSIM_THROW_IF(_depData.ncol() != 0 && 
-                         numCols != static_cast<unsigned>(_depData.ncol()),
+        OPENSIM_THROW_IF(_depData->ncol() != 0 && 
+                         numCols != static_cast<unsigned>(_depData->ncol()),
                          IncorrectMetaDataLength, "labels", 
-                         static_cast<size_t>(_depData.ncol()), numCols);
+                         static_cast<size_t>(_depData->ncol()), numCols);
 
-        for(const std::string& key : _dependentsMetaData.getKeys()) {
+        for(const std::string& key : _dependentsMetaData->getKeys()) {
             OPENSIM_THROW_IF(numCols != 
-                        _dependentsMetaData.getValueArrayForKey(key).size(),
+                        _dependentsMetaData->getValueArrayForKey(key).size(),
                         IncorrectMetaDataLength, key, numCols,
-                        _dependentsMetaData.getValueArrayForKey(key).size());
+                        _dependentsMetaData->getValueArrayForKey(key).size());
         }
     }
 
@@ -1662,8 +1760,10 @@ protected:
         return M * N;
     }
 
-    std::vector<ETX>    _indData;
-    SimTK::Matrix_<ETY> _depData;
+    // The data is shared by copies of the table until it is modified (see
+    // CopyOnWrite), so that copying a table is O(1).
+    CopyOnWrite<std::vector<ETX>>    _indData;
+    CopyOnWrite<SimTK::Matrix_<ETY>> _depData;
 };  // DataTable_
 
 
@@ -27,8 +27,16 @@
 #include "About.h"
 #include "FileAdapter.h"
 #include "TimeSeriesTable.h"
+#include "CommonUtilities.h"
 #include "OpenSim/Common/IO.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
 #include <string>
 #include <fstream>
 #include <regex>
@@ -72,6 +80,8 @@ namespace {
     };
 } // namespace
 
+template<typename T> class TimeSeriesTableReader_;
+
 /** DelimFileAdapter is a FileAdapter that reads and writes text files with
 given delimiters. CSVFileAdapter and MOTFileAdapter derive from this class and
 set the delimiters appropriately for the files they parse. The read/write
@@ -116,7 +126,30 @@ public:
     /** Name of the data type T (template parameter).                         */
     static inline std::string dataTypeName();
 
+    /** Read only the columns whose labels match one of these regular
+    expressions (see FileAdapter::findColumnsToRead()), rather than all the
+    columns of the file. The other values of each row are skipped without
+    being converted, and the table has only the selected columns, in the
+    order of the file. By default (an empty list), all the columns are read.
+    \code{.cpp}
+    STOFileAdapter adapter;
+    adapter.setColumnsToRead({"pelvis_.*", "hip_flexion_r"});
+    auto tables = adapter.read("coordinates.sto");
+    auto& table = dynamic_cast<TimeSeriesTable&>(
+            *tables.at(STOFileAdapter::tableString()));
+    \endcode                                                                 */
+    void setColumnsToRead(const std::vector<std::string>& patterns) {
+        _columnsToRead = patterns;
+    }
+    const std::vector<std::string>& getColumnsToRead() const {
+        return _columnsToRead;
+    }
+
 protected:
+    /** TimeSeriesTableReader_ uses the header and row parsing below to read
+    files incrementally.                                                      */
+    friend class TimeSeriesTableReader_<T>;
+
     /** Implementation of the read functionality.                             */
     OutputTables extendRead(const std::string& filename) const override;
 
@@ -124,6 +157,48 @@ protected:
     void extendWrite(const InputTables& tables,
                      const std::string& filename) const override;
 
+    /** Read the header (metadata and column labels) of a file. On return, the
+    stream is positioned at the first data row. The time column label is
+    checked and removed from `column_labels`.                                 */
+    void readHeader(std::istream& in_stream,
+                    const std::string& fileName,
+                    size_t& line_num,
+                    ValueArrayDictionary& keyValuePairs,
+                    std::vector<std::string>& column_labels) const;
+
+    /** Read up to `maxRows` data rows (all remaining rows if `maxRows` is
+    negative) one line at a time into `timeVec` and `matrix`, which are
+    resized to the number of rows read. `endOfData` is set to true if the end
+    of the data was reached. Returns the number of rows read. If `columns` is
+    given, only those (increasing) indices of the `ncol` columns of the file
+    are read into the matrix.                                                 */
+    int readRows(std::istream& in_stream,
+                 const std::string& fileName,
+                 size_t& line_num,
+                 int ncol,
+                 int maxRows,
+                 std::vector<double>& timeVec,
+                 SimTK::Matrix_<T>& matrix,
+                 bool& endOfData,
+                 const std::vector<int>* columns = nullptr) const;
+
+    /** Read all remaining data rows of the stream (everything following the
+    column labels) into `timeVec` and `matrix` using a fast path: the rest of
+    the file is read into memory in one go, row boundaries are located once,
+    and rows are parsed (in parallel, for large files) directly into the
+    matrix without creating a string per token. This is only available for
+    tables of doubles. Returns false, with the stream restored to its original
+    position, if the fast path is not applicable or if any row does not
+    have the simple expected form (in which case the regular line-by-line
+    parser should be used; it also produces the appropriate error messages).
+    If `columns` is given, only those (increasing) indices of the `ncol`
+    columns of the file are parsed into the matrix.                           */
+    bool readDataFast(std::istream& in_stream,
+                      int ncol,
+                      std::vector<double>& timeVec,
+                      SimTK::Matrix_<T>& matrix,
+                      const std::vector<int>* columns = nullptr) const;
+
     /** Read elements of type T (template parameter) from a sequence of 
     tokens.                                                                   */
     inline SimTK::RowVector_<T> 
@@ -144,6 +219,21 @@ private:
     template<int M>
     static inline std::string dataTypeName_impl(SimTK::Vec<M>);
 
+    /** Following overloads implement readDataFast().                         */
+    bool readDataFast_impl(std::istream& in_stream,
+                           int ncol,
+                           std::vector<double>& timeVec,
+                           SimTK::Matrix_<double>& matrix,
+                           const std::vector<int>* columns) const;
+    template<typename U>
+    bool readDataFast_impl(std::istream&,
+                           int,
+                           std::vector<double>&,
+                           SimTK::Matrix_<U>&,
+                           const std::vector<int>*) const {
+        return false;
+    }
+
     /** Following overloads implement readElems().                            */
     inline SimTK::RowVector_<double>
     readElems_impl(const std::vector<std::string>& tokens,
@@ -173,6 +263,19 @@ private:
     inline void writeElem_impl(std::ostream& stream,
                                const SimTK::Vec<M>& elem,
                                const unsigned& prec) const;
+
+    /** Following overloads append an element to a buffer with the printf()
+    format "%.<prec>g", which gives the same characters as writeElem().      */
+    inline void appendElem_impl(std::string& buffer,
+                                const double& elem,
+                                const char* format) const;
+    inline void appendElem_impl(std::string& buffer,
+                                const SimTK::SpatialVec& elem,
+                                const char* format) const;
+    template<int M>
+    inline void appendElem_impl(std::string& buffer,
+                                const SimTK::Vec<M>& elem,
+                                const char* format) const;
       
     /** Trim string -- remove specified leading and trailing characters from 
     string. Trims out whitespace by default.                                  */
@@ -198,6 +301,8 @@ private:
     static const std::string _opensimVersionString;
     /** File version number.                                                  */
     static const std::string _versionNumber;
+    /** Patterns of the labels of the columns to read (all if empty).        */
+    std::vector<std::string> _columnsToRead;
 };
 
 
@@ -320,6 +425,52 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
                      fileName);
 
     size_t line_num{};
+    ValueArrayDictionary keyValuePairs;
+    std::vector<std::string> column_labels{};
+    readHeader(in_stream, fileName, line_num, keyValuePairs, column_labels);
+
+    std::vector<double> timeVec;
+    int ncol = static_cast<int>(column_labels.size());
+    SimTK::Matrix_<T> matrix;
+
+    std::vector<int> columns;
+    const std::vector<int>* columnsToRead = nullptr;
+    if(!_columnsToRead.empty()) {
+        columns = findColumnsToRead(column_labels, _columnsToRead);
+        columnsToRead = &columns;
+    }
+
+    if(!readDataFast(in_stream, ncol, timeVec, matrix, columnsToRead)) {
+        bool endOfData{};
+        readRows(in_stream, fileName, line_num, ncol, -1,
+                 timeVec, matrix, endOfData, columnsToRead);
+    }
+
+    if(columnsToRead) {
+        std::vector<std::string> selected_labels;
+        for(const int icol : columns)
+            selected_labels.push_back(column_labels[icol]);
+        column_labels = std::move(selected_labels);
+    }
+
+    // Create the table and update other metadata from above
+    auto table = 
+        std::make_shared<TimeSeriesTable_<T>>(timeVec, matrix, column_labels);
+    table->updTableMetaData() = keyValuePairs;
+
+    OutputTables output_tables{};
+    output_tables.emplace(tableString(), table);
+
+    return output_tables;
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::readHeader(std::istream& in_stream,
+                                const std::string& fileName,
+                                size_t& line_num,
+                                ValueArrayDictionary& keyValuePairs,
+                                std::vector<std::string>& column_labels) const {
     // All the lines until "endheader" is header.
     std::regex endheader{R"([ \t]*)" + _endHeaderString + R"([ \t]*)"};
     std::regex keyvalue{R"((.*)=(.*))"};
@@ -327,7 +478,6 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
     std::string line{};
     std::string numberOrDelim = "[0-9][0-9."+_delimitersRead+" -]+";
     std::regex dataLine{ numberOrDelim };
-    ValueArrayDictionary keyValuePairs;
     while(std::getline(in_stream, line)) {
         ++line_num;
 
@@ -389,7 +539,7 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
 
     // Read the line containing column labels and fill up the column labels
     // container.
-    std::vector<std::string> column_labels{};
+    column_labels.clear();
     while (column_labels.size() == 0) { // keep going down rows to find labels
         column_labels = nextLine();
         // for labels we never expect empty elements, so remove them
@@ -408,66 +558,230 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
                      _timeColumnLabel,
                      column_labels[0]);
     column_labels.erase(column_labels.begin());
+}
 
-    // Read the rows one at a time and fill up the time column container and
-    // the data container. Start with a reasonable initial capacity for
-    // tradeoff between a small file and larger files. 100 worked well for
-    // a 50 MB file with ~80000 lines.
-    std::vector<double> timeVec;
-    int initCapacity = 100;
-    int ncol = static_cast<int>(column_labels.size());
+template<typename T>
+int
+DelimFileAdapter<T>::readRows(std::istream& in_stream,
+                              const std::string& fileName,
+                              size_t& line_num,
+                              int ncol,
+                              int maxRows,
+                              std::vector<double>& timeVec,
+                              SimTK::Matrix_<T>& matrix,
+                              bool& endOfData,
+                              const std::vector<int>* columns) const {
+    const int nout = columns ? static_cast<int>(columns->size()) : ncol;
+    // Read the rows one at a time and fill up the time column container
+    // and the data container. Start with a reasonable initial capacity
+    // for tradeoff between a small file and larger files. 100 worked well
+    // for a 50 MB file with ~80000 lines.
+    int initCapacity = maxRows < 0 ? 100 : std::min(maxRows, 100);
+    timeVec.clear();
     timeVec.reserve(initCapacity);
-    SimTK::Matrix_<T> matrix(initCapacity, ncol);
-    
+    matrix.resize(initCapacity, nout);
+
     // Initialize current row and capacity
     int curCapacity = initCapacity;
     int curRow = 0;
+    endOfData = false;
 
     // Start looping through each line
-    auto row = nextLine();
-    while (!row.empty()) {
+    while (maxRows < 0 || curRow < maxRows) {
+        auto row = getNextLine(in_stream, _delimitersRead);
+        if (row.empty()) {
+            endOfData = true;
+            break;
+        }
         ++line_num;
-        
+
         // Double capacity if we reach the end of the containers.
         // This is necessary until Simbody issue #401 is addressed.
         if (curRow+1 > curCapacity) {
             curCapacity *= 2;
+            if (maxRows >= 0)
+                curCapacity = std::min(curCapacity, maxRows);
             timeVec.reserve(curCapacity);
-            matrix.resizeKeep(curCapacity, ncol);
+            matrix.resizeKeep(curCapacity, nout);
         }
 
         // Time is column 0.
         timeVec.push_back(std::stod(row.front()));
         row.erase(row.begin());
 
+        if(columns) {
+            // Only the selected tokens are converted.
+            OPENSIM_THROW_IF(row.size() != static_cast<size_t>(ncol),
+                RowLengthMismatch,
+                fileName,
+                line_num,
+                static_cast<size_t>(ncol),
+                row.size());
+            std::vector<std::string> selected;
+            selected.reserve(columns->size());
+            for(const int icol : *columns)
+                selected.push_back(std::move(row[icol]));
+            row = std::move(selected);
+        }
+
         auto row_vector = readElems(row);
 
-        OPENSIM_THROW_IF(row_vector.size() != (int)column_labels.size(),
+        OPENSIM_THROW_IF(row_vector.size() != nout,
             RowLengthMismatch,
             fileName,
             line_num,
-            column_labels.size(),
+            static_cast<size_t>(nout),
             static_cast<size_t>(row_vector.size()));
-        
+
         matrix.updRow(curRow) = std::move(row_vector);
 
-        row = nextLine();
         ++curRow;
     }
 
     // Resize the matrix down to the correct number of rows.
     // This is necessary until Simbody issue #401 is addressed.
-    matrix.resizeKeep(curRow, ncol);
+    matrix.resizeKeep(curRow, nout);
+    return curRow;
+}
 
-    // Create the table and update other metadata from above
-    auto table = 
-        std::make_shared<TimeSeriesTable_<T>>(timeVec, matrix, column_labels);
-    table->updTableMetaData() = keyValuePairs;
+template<typename T>
+bool
+DelimFileAdapter<T>::readDataFast(std::istream& in_stream,
+                                  int ncol,
+                                  std::vector<double>& timeVec,
+                                  SimTK::Matrix_<T>& matrix,
+                                  const std::vector<int>* columns) const {
+    return readDataFast_impl(in_stream, ncol, timeVec, matrix, columns);
+}
 
-    OutputTables output_tables{};
-    output_tables.emplace(tableString(), table);
+template<typename T>
+bool
+DelimFileAdapter<T>::readDataFast_impl(std::istream& in_stream,
+                                       int ncol,
+                                       std::vector<double>& timeVec,
+                                       SimTK::Matrix_<double>& matrix,
+                                       const std::vector<int>* columns) const {
+    const auto start = in_stream.tellg();
+    if(start < 0)
+        return false;
+    auto restore = [&]() -> bool {
+        in_stream.clear();
+        in_stream.seekg(start);
+        return false;
+    };
 
-    return output_tables;
+    // Read the rest of the file with a single read.
+    in_stream.seekg(0, std::ios::end);
+    const auto end = in_stream.tellg();
+    if(end < start)
+        return restore();
+    in_stream.seekg(start);
+    std::string buffer(static_cast<size_t>(end - start), '\0');
+    if(!buffer.empty())
+        in_stream.read(&buffer[0], buffer.size());
+    // Fewer characters than expected may be read on platforms that convert
+    // CRLF line endings.
+    buffer.resize(static_cast<size_t>(in_stream.gcount()));
+
+    // Locate the row boundaries and null-terminate each row in place. As in
+    // the regular parser, the data ends at the first empty line.
+    std::vector<size_t> rowStarts;
+    size_t pos = 0;
+    while(pos < buffer.size()) {
+        size_t newline = buffer.find('\n', pos);
+        if(newline == std::string::npos)
+            newline = buffer.size();
+        size_t lineEnd = newline;
+        if(lineEnd > pos && buffer[lineEnd - 1] == '\r')
+            --lineEnd;
+        if(lineEnd == pos)
+            break;
+        if(lineEnd < buffer.size())
+            buffer[lineEnd] = '\0';
+        rowStarts.push_back(pos);
+        pos = newline + 1;
+    }
+
+    // The column of the matrix of each column of the file, or -1 for the
+    // columns that are skipped.
+    std::vector<int> target(ncol, -1);
+    if(columns) {
+        for(int i = 0; i < static_cast<int>(columns->size()); ++i)
+            target[(*columns)[i]] = i;
+    } else {
+        std::iota(target.begin(), target.end(), 0);
+    }
+    const int nout = columns ? static_cast<int>(columns->size()) : ncol;
+
+    const int nrow = static_cast<int>(rowStarts.size());
+    timeVec.resize(nrow);
+    matrix.resize(nrow, nout);
+
+    const std::string& delims = _delimitersRead;
+    auto isDelim = [&](char c) -> bool {
+        return c != '\0' && delims.find(c) != std::string::npos;
+    };
+    auto skipSpace = [&](const char*& p) {
+        while(*p != '\0' && !isDelim(*p) &&
+                std::isspace(static_cast<unsigned char>(*p)))
+            ++p;
+    };
+    // Parse one (nonempty) field. std::stod() throws for out-of-range
+    // values, so leave those to the regular parser.
+    auto parseField = [&](const char*& p, double& value) -> bool {
+        skipSpace(p);
+        if(*p == '\0' || isDelim(*p))
+            return false;
+        char* fieldEnd = nullptr;
+        errno = 0;
+        value = std::strtod(p, &fieldEnd);
+        if(fieldEnd == p || errno == ERANGE)
+            return false;
+        p = fieldEnd;
+        skipSpace(p);
+        return true;
+    };
+    // Skip a field of a column that is not read, without converting it.
+    auto skipField = [&](const char*& p) {
+        while(*p != '\0' && !isDelim(*p))
+            ++p;
+    };
+
+    std::atomic<bool> failed{false};
+    const char* data = buffer.c_str();
+    // Small files are not worth the cost of creating threads.
+    const int numThreads = nrow < 10000 ? 1 : -1;
+    parallelForChunks(nrow, numThreads, [&](int, int rowBegin, int rowEnd) {
+        for(int irow = rowBegin; irow < rowEnd; ++irow) {
+            if(failed.load(std::memory_order_relaxed))
+                return;
+            const char* p = data + rowStarts[irow];
+            bool ok = parseField(p, timeVec[irow]);
+            for(int icol = 0; ok && icol < ncol; ++icol) {
+                ok = isDelim(*p);
+                if(ok) {
+                    ++p;
+                    if(target[icol] >= 0)
+                        ok = parseField(p, matrix(irow, target[icol]));
+                    else
+                        skipField(p);
+                }
+            }
+            // Allow a single trailing delimiter.
+            if(ok && isDelim(*p))
+                ++p;
+            if(!ok || *p != '\0') {
+                failed.store(true);
+                return;
+            }
+        }
+    });
+
+    if(failed.load()) {
+        timeVec.clear();
+        return restore();
+    }
+    return true;
 }
 
 template<typename T>
@@ -623,19 +937,29 @@ DelimFileAdapter<T>::extendWrite(const InputTables& absTables,
                       template getValue<std::string>();
     out_stream << "\n";
 
-    // Data rows.
-    for(unsigned row = 0; row < table->getNumRows(); ++row) {
-        constexpr auto prec = std::numeric_limits<double>::digits10 + 1;
-        out_stream << std::setprecision(prec)
-                   << table->getIndependentColumn()[row];
-        const auto& row_r = table->getRowAtIndex(row);
-        for(unsigned col = 0; col < table->getNumColumns(); ++col) {
-            const auto& elt = row_r[col];
-            out_stream << _delimiterWrite;
-            writeElem(out_stream, elt, prec);
-        }
-        out_stream << "\n";
-    }
+    // Data rows. They are formatted into large blocks that are written at
+    // once (and formatted on multiple threads if requested with
+    // IO::SetNumThreadsForWriting()), with the same characters as writing
+    // each element to the stream with writeElem().
+    constexpr auto prec = std::numeric_limits<double>::digits10 + 1;
+    char format[16];
+    std::snprintf(format, sizeof(format), "%%.%dg", prec);
+    const auto& times = table->getIndependentColumn();
+    const auto& matrix = table->getMatrix();
+    const int numColumns = (int)table->getNumColumns();
+    formatRowsInBlocks((int)table->getNumRows(),
+            IO::GetNumThreadsForWriting(),
+            [&](int row, std::string& buffer) {
+                appendFormattedDouble(buffer, format, times[row]);
+                for(int col = 0; col < numColumns; ++col) {
+                    buffer += _delimiterWrite;
+                    appendElem_impl(buffer, matrix(row, col), format);
+                }
+                buffer += '\n';
+            },
+            [&](const char* data, size_t size) {
+                out_stream.write(data, size);
+            });
 }
 
 template<typename T>
@@ -678,6 +1002,40 @@ DelimFileAdapter<T>::writeElem_impl(std::ostream& stream,
         stream << _compDelimWrite << std::setprecision(prec) << elem[i];
 }
 
+template<typename T>
+void
+DelimFileAdapter<T>::appendElem_impl(std::string& buffer,
+                                     const double& elem,
+                                     const char* format) const {
+    appendFormattedDouble(buffer, format, elem);
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::appendElem_impl(std::string& buffer,
+                                     const SimTK::SpatialVec& elem,
+                                     const char* format) const {
+    for(int i = 0; i < 2; ++i) {
+        for(int j = 0; j < 3; ++j) {
+            if(i || j) buffer += _compDelimWrite;
+            appendFormattedDouble(buffer, format, elem[i][j]);
+        }
+    }
+}
+
+template<typename T>
+template<int M>
+void
+DelimFileAdapter<T>::appendElem_impl(std::string& buffer,
+                                     const SimTK::Vec<M>& elem,
+                                     const char* format) const {
+    appendFormattedDouble(buffer, format, elem[0]);
+    for(auto i = 1u; i < M; ++i) {
+        buffer += _compDelimWrite;
+        appendFormattedDouble(buffer, format, elem[i]);
+    }
+}
+
 } // namespace OpenSim
 
 #endif // OPENSIM_DELIM_FILE_ADAPTER_H_
@@ -2,6 +2,9 @@
 #include <OpenSim/Common/IO.h>
 #include "STOFileAdapter.h"
 
+#include <numeric>
+#include <regex>
+
 namespace OpenSim {
 
 std::shared_ptr<DataAdapter>
@@ -80,6 +83,38 @@ FileAdapter::getNextLine(std::istream& stream,
     return {};
 }
 
+std::vector<int>
+FileAdapter::findColumnsToRead(const std::vector<std::string>& labels,
+                               const std::vector<std::string>& patterns) {
+    std::vector<int> columns;
+    if(patterns.empty()) {
+        columns.resize(labels.size());
+        std::iota(columns.begin(), columns.end(), 0);
+        return columns;
+    }
+    std::vector<std::regex> regexes;
+    for(const auto& pattern : patterns)
+        regexes.emplace_back(pattern);
+    std::vector<bool> matched(patterns.size(), false);
+    for(int icol = 0; icol < static_cast<int>(labels.size()); ++icol) {
+        bool selected = false;
+        for(size_t i = 0; i < regexes.size(); ++i) {
+            if(std::regex_match(labels[icol], regexes[i])) {
+                matched[i] = true;
+                selected = true;
+            }
+        }
+        if(selected)
+            columns.push_back(icol);
+    }
+    for(size_t i = 0; i < patterns.size(); ++i) {
+        OPENSIM_THROW_IF(!matched[i], Exception,
+                "Expected a column label to match the pattern '{}'.",
+                patterns[i]);
+    }
+    return columns;
+}
+
 std::shared_ptr<DataAdapter>
 FileAdapter::createAdapterFromExtension(const std::string& fileName) {
     auto extension = FileAdapter::findExtension(fileName);
@@ -213,6 +213,18 @@ public:
     specifies that either a space or a tab can act as the delimiter.          */
     static std::vector<std::string> tokenize(const std::string& str, 
                                       const std::string& delims);
+
+    /** The indices of the column labels that match (std::regex_match()) at
+    least one of the regular expressions `patterns`, in the order of `labels`,
+    or the indices of all the labels if `patterns` is empty. A label without
+    special characters is a pattern that matches only itself. This is used by
+    the adapters that can read only some of the columns of a file (e.g.,
+    DelimFileAdapter::setColumnsToRead()). Throws if a pattern matches none of
+    the labels.                                                               */
+    static std::vector<int> findColumnsToRead(
+            const std::vector<std::string>& labels,
+            const std::vector<std::string>& patterns);
+
     /** Create a concerte FileAdapter based on the extension of the passed in file and return it.
      This serves as a Factory of FileAdapters so clients don't need to know specific concrete 
      subclasses, as long as the generic base class read interface is used */
@@ -29,6 +29,7 @@
 // INCLUDES
 #include "Function.h"
 
+#include <mutex>
 
 using namespace OpenSim;
 using namespace std;
@@ -38,6 +39,15 @@ using SimTK::Vector;
 //=============================================================================
 // STATICS
 //=============================================================================
+namespace {
+    // Serializes the creation of the SimTK::Functions of all Functions, which
+    // is rare. It is recursive since a createSimTKFunction() may evaluate
+    // other Functions.
+    std::recursive_mutex& getSimTKFunctionMutex() {
+        static std::recursive_mutex mutex;
+        return mutex;
+    }
+}
 
 
 //=============================================================================
@@ -57,7 +67,8 @@ Function::~Function()
  * Default constructor.
  */
 Function::Function() :
-    _function(NULL)
+    _function(NULL),
+    _functionCreated(false)
 {
     setNull();
 }
@@ -69,7 +80,8 @@ Function::Function() :
  */
 Function::Function(const Function &aFunction) :
     Object(aFunction),
-    _function(NULL)
+    _function(NULL),
+    _functionCreated(false)
 {
 }
 
@@ -161,30 +173,45 @@ evaluateTotalSecondDerivative(double aX,double aDxdt,double aD2xdt2)
 */
 double Function::calcValue(const Vector& x) const
 {
-    if (_function == NULL)
-        _function = createSimTKFunction();
-    return _function->calcValue(x);
+    return getSimTKFunction().calcValue(x);
 }
 
 double Function::calcDerivative(const std::vector<int>& derivComponents, const Vector& x) const
 {
-    if (_function == NULL)
-        _function = createSimTKFunction();
-    return _function->calcDerivative(derivComponents, x);
+    return getSimTKFunction().calcDerivative(derivComponents, x);
 }
 
 int Function::getArgumentSize() const
 {
-    if (_function == NULL)
-        _function = createSimTKFunction();
-    return _function->getArgumentSize();
+    return getSimTKFunction().getArgumentSize();
 }
 
 int Function::getMaxDerivativeOrder() const
 {
-    if (_function == NULL)
-        _function = createSimTKFunction();
-    return _function->getMaxDerivativeOrder();
+    return getSimTKFunction().getMaxDerivativeOrder();
+}
+
+const SimTK::Function& Function::getSimTKFunction() const
+{
+    // Once the function is created, it is only read, so that the common case
+    // needs no lock.
+    if (!_functionCreated.load(std::memory_order_acquire)) {
+        std::lock_guard<std::recursive_mutex> lock(getSimTKFunctionMutex());
+        if (!_functionCreated.load(std::memory_order_relaxed)) {
+            if (_function == NULL)
+                _function = createSimTKFunction();
+            _functionCreated.store(true, std::memory_order_release);
+        }
+    }
+    return *_function;
+}
+
+void Function::setSimTKFunction(SimTK::Function* function) const
+{
+    std::lock_guard<std::recursive_mutex> lock(getSimTKFunctionMutex());
+    delete _function;
+    _function = function;
+    _functionCreated.store(true, std::memory_order_release);
 }
 
 void Function::resetFunction()
@@ -192,4 +219,5 @@ void Function::resetFunction()
     if (_function != NULL)
         delete _function;
     _function = NULL;
+    _functionCreated.store(false, std::memory_order_release);
 }
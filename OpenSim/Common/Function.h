@@ -32,6 +32,8 @@
 #include "Object.h"
 #include "SimTKmath.h"
 
+#include <atomic>
+
 
 //=============================================================================
 //=============================================================================
@@ -58,9 +60,16 @@ OpenSim_DECLARE_ABSTRACT_OBJECT(Function, Object);
 // DATA
 //=============================================================================
 protected:
-    // The SimTK::Function object implementing this function.
+    // The SimTK::Function object implementing this function. Use
+    // getSimTKFunction() to access it, which creates it if necessary.
     mutable SimTK::Function* _function;
 
+private:
+    // Whether _function has been created by getSimTKFunction() (or set with
+    // setSimTKFunction()); this synchronizes the threads that evaluate the
+    // function for the first time.
+    mutable std::atomic<bool> _functionCreated;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -135,6 +144,20 @@ protected:
      */
     void resetFunction();
 
+    /**
+     * The internal SimTK::Function object used to evaluate this function,
+     * which is created with createSimTKFunction() on the first call. This is
+     * thread-safe: the const methods of a Function may be called from
+     * multiple threads at once, including the first time it is evaluated.
+     */
+    const SimTK::Function& getSimTKFunction() const;
+
+    /**
+     * Replace the internal SimTK::Function object (taking ownership of it),
+     * e.g., with one that was created from precomputed coefficients.
+     */
+    void setSimTKFunction(SimTK::Function* function) const;
+
 //=============================================================================
 };  // END class Function
 
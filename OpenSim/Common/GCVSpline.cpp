@@ -33,6 +33,7 @@
 #include "gcvspl.h"
 #include "XYFunctionInterface.h"
 
+#include <algorithm>
 
 
 using namespace OpenSim;
@@ -45,6 +46,50 @@ using SimTK::Vec;
 //=============================================================================
 // STATICS
 //=============================================================================
+namespace OpenSim {
+/// A spline fit to the data of a GCVSpline, with the data, so that copies of
+/// the GCVSpline can check whether the fit is still valid for them.
+struct GCVSplineFit {
+    int degree;
+    double errorVariance;
+    std::vector<double> x, y;
+    SimTK::Spline spline;
+
+    bool isFitTo(int aDegree, double aErrorVariance,
+            const Array<double>& aX, const Array<double>& aY) const {
+        if (degree != aDegree || errorVariance != aErrorVariance ||
+                (int)x.size() != aX.getSize() ||
+                (int)y.size() != aY.getSize())
+            return false;
+        return std::equal(x.begin(), x.end(), aX.get()) &&
+               std::equal(y.begin(), y.end(), aY.get());
+    }
+};
+}
+
+namespace {
+/// The SimTK::Function of a GCVSpline, which evaluates a (shared) fit.
+class GCVSplineFunction : public SimTK::Function {
+public:
+    explicit GCVSplineFunction(std::shared_ptr<const GCVSplineFit> fit)
+            : _fit(std::move(fit)) {}
+    double calcValue(const Vector& x) const override {
+        return _fit->spline.calcValue(x);
+    }
+    double calcDerivative(const SimTK::Array_<int>& derivComponents,
+            const Vector& x) const override {
+        return _fit->spline.calcDerivative(derivComponents, x);
+    }
+    int getArgumentSize() const override {
+        return _fit->spline.getArgumentSize();
+    }
+    int getMaxDerivativeOrder() const override {
+        return _fit->spline.getMaxDerivativeOrder();
+    }
+private:
+    std::shared_ptr<const GCVSplineFit> _fit;
+};
+}
 
 
 //=============================================================================
@@ -230,6 +275,7 @@ setEqual(const GCVSpline &aSpline)
     _y = aSpline._y;
     _weights = aSpline._weights;
     _coefficients = aSpline._coefficients;
+    _fit = aSpline._fit;
 }
 
 //-----------------------------------------------------------------------------
@@ -255,6 +301,9 @@ void GCVSpline::updateFromXMLNode(SimTK::Xml::Element& aNode, int versionNumber)
     // Coefficients may not have been specified in the XML file.
     if (_coefficients.getSize() < _x.getSize())
         _coefficients.setSize(_x.getSize());
+
+    // The coefficients are refit from the new data.
+    resetFunction();
 }   
 
 //_____________________________________________________________________________
@@ -340,6 +389,7 @@ operator=(const GCVSpline &aSpline)
 
     // DATA
     setEqual(aSpline);
+    resetFunction();
 
     return(*this);
 }
@@ -445,6 +495,112 @@ getCoefficients() const
 //=============================================================================
 // EVALUATION
 //=============================================================================
+//_____________________________________________________________________________
+double GCVSpline::
+evaluate(double aX, int aDerivOrder) const
+{
+    if (aDerivOrder < 0)
+        throw Exception("GCVSpline::evaluate(): negative derivative order.");
+    updateCoefficients();
+    int interval = 0;
+    return evaluate(aX, aDerivOrder, interval);
+}
+
+void GCVSpline::
+evaluate(const Vector& aX, int aDerivOrder, Vector& rValues) const
+{
+    if (aDerivOrder < 0)
+        throw Exception("GCVSpline::evaluate(): negative derivative order.");
+    updateCoefficients();
+    rValues.resize(aX.size());
+    int interval = 0;
+    for (int i = 0; i < aX.size(); ++i)
+        rValues[i] = evaluate(aX[i], aDerivOrder, interval);
+}
+
+void GCVSpline::
+updateCoefficients() const
+{
+    // The coefficients are fit when the SimTK::Function is created.
+    getSimTKFunction();
+}
+
+void GCVSpline::
+setFittedCoefficients(const std::vector<double>& coefficients) const
+{
+    OPENSIM_THROW_IF((int)coefficients.size() != _x.getSize(), Exception,
+            "Expected {} coefficients, but got {}.", _x.getSize(),
+            coefficients.size());
+    _coefficients.setSize(_x.getSize());
+    Vector x(_x.getSize());
+    Vector controlPoints(_x.getSize());
+    for (int i = 0; i < x.size(); ++i) {
+        x[i] = _x[i];
+        controlPoints[i] = coefficients[i];
+        _coefficients[i] = coefficients[i];
+    }
+    setSimTKFunction(new SimTK::Spline(_halfOrder*2-1, x, controlPoints));
+}
+
+double GCVSpline::
+evaluate(double aX, int aDerivOrder, int& rInterval) const
+{
+    if (aDerivOrder < 0)
+        throw Exception("GCVSpline::evaluate(): negative derivative order.");
+    updateCoefficients();
+    // splder() needs a workspace of 2*m doubles, and m is at most 4.
+    double work[8];
+    return splder(aDerivOrder, _halfOrder, _x.getSize(), aX, _x.get(),
+            _coefficients.get(), &rInterval, work);
+}
+
+bool GCVSpline::
+hasSameKnots(const GCVSpline& aSpline) const
+{
+    return _halfOrder == aSpline._halfOrder &&
+           _x.getSize() == aSpline._x.getSize() &&
+           std::equal(_x.get(), _x.get() + _x.getSize(), aSpline._x.get());
+}
+
+void GCVSpline::
+calcCoefficientWeights(double aX, int aMaxDerivOrder, int& rInterval,
+        int& rFirst, SimTK::Matrix& rWeights) const
+{
+    if (aMaxDerivOrder < 0)
+        throw Exception("GCVSpline::calcCoefficientWeights(): negative "
+                        "derivative order.");
+    const int n = _x.getSize();
+    search(n, _x.get(), aX, &rInterval);
+    // splder() is linear in the coefficients and uses only those from
+    // rInterval-m to rInterval+m-1, so the weights are its results with each
+    // of these coefficients set to 1 and the others to 0.
+    rFirst = std::max(rInterval - _halfOrder, 0);
+    const int last = std::min(rInterval + _halfOrder - 1, n - 1);
+    rWeights.resize(aMaxDerivOrder + 1, std::max(last - rFirst + 1, 0));
+    // All zeros between calls.
+    thread_local std::vector<double> unit;
+    if ((int)unit.size() < n) unit.assign(n, 0.0);
+    double work[8];
+    for (int k = 0; k < rWeights.ncol(); ++k) {
+        unit[rFirst + k] = 1.0;
+        for (int d = 0; d <= aMaxDerivOrder; ++d) {
+            rWeights(d, k) = splder(d, _halfOrder, n, aX, _x.get(),
+                    unit.data(), &rInterval, work);
+        }
+        unit[rFirst + k] = 0.0;
+    }
+}
+
+double GCVSpline::
+evaluate(int aDerivOrder, int aFirst, const SimTK::Matrix& aWeights) const
+{
+    updateCoefficients();
+    double value = 0.0;
+    for (int k = 0; k < aWeights.ncol(); ++k)
+        value += aWeights(aDerivOrder, k) * _coefficients[aFirst + k];
+    return value;
+}
+
 double GCVSpline::
 getX(int aIndex) const
 {
@@ -582,21 +738,31 @@ addPoint(double aX, double aY)
 
 SimTK::Function* GCVSpline::createSimTKFunction() const {
     int degree = _halfOrder*2-1;
-    Vector x(_x.getSize());
-    Vector y(_y.getSize());
-    for (int i = 0; i < x.size(); ++i)
-        x[i] = _x[i];
-    for (int i = 0; i < y.size(); ++i)
-        y[i] = _y[i];
-    SimTK::Spline* spline;
-    if (_errorVariance < 0.0)
-        spline = new SimTK::Spline(SimTK::SplineFitter<double>::fitFromGCV(degree, x, y).getSpline());
-    else
-        spline = new SimTK::Spline(SimTK::SplineFitter<double>::fitFromErrorVariance(degree, x, y, _errorVariance).getSpline());
-
-     int sz = _coefficients.getSize();
+    // Fitting is expensive, so the fit of the spline this was copied from is
+    // used if it was fit to the same data.
+    if (!_fit || !_fit->isFitTo(degree, _errorVariance, _x, _y)) {
+        Vector x(_x.getSize());
+        Vector y(_y.getSize());
+        for (int i = 0; i < x.size(); ++i)
+            x[i] = _x[i];
+        for (int i = 0; i < y.size(); ++i)
+            y[i] = _y[i];
+        auto fit = std::make_shared<GCVSplineFit>();
+        fit->degree = degree;
+        fit->errorVariance = _errorVariance;
+        fit->x.assign(_x.get(), _x.get() + _x.getSize());
+        fit->y.assign(_y.get(), _y.get() + _y.getSize());
+        if (_errorVariance < 0.0)
+            fit->spline = SimTK::SplineFitter<double>::fitFromGCV(degree, x, y).getSpline();
+        else
+            fit->spline = SimTK::SplineFitter<double>::fitFromErrorVariance(degree, x, y, _errorVariance).getSpline();
+        _fit = std::move(fit);
+    }
+
+    _coefficients.setSize(_x.getSize());
+    int sz = _coefficients.getSize();
     for (int i = 0; i < sz; ++i)
-        _coefficients[i] = spline->getControlPointValues()[i];
-    return spline;
+        _coefficients[i] = _fit->spline.getControlPointValues()[i];
+    return new GCVSplineFunction(_fit);
 }
 
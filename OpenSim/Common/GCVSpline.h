@@ -26,7 +26,9 @@
 
 // INCLUDES
 #include "osimCommonDLL.h"
+#include <memory>
 #include <string>
+#include <vector>
 #include "PropertyInt.h"
 #include "PropertyDbl.h"
 #include "PropertyDblArray.h"
@@ -41,6 +43,8 @@
 //=============================================================================
 namespace OpenSim { 
 
+struct GCVSplineFit;
+
 template <class T> class Array;
 
 /**
@@ -109,6 +113,12 @@ protected:
     /** A workspace used when calculating derivatives of the spline. */
     mutable std::vector<int> _workDeriv;
 
+private:
+    /** The SimTK::Spline fit to the data by createSimTKFunction(), with the
+    data it was fit to. Copies of this spline share the fit (e.g., in the
+    clones of a model) and only fit their own if their data changes. */
+    mutable std::shared_ptr<const GCVSplineFit> _fit;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -233,6 +243,71 @@ public:
     //--------------------------------------------------------------------------
     // EVALUATION
     //--------------------------------------------------------------------------
+    /**
+     * Evaluate the spline or one of its derivatives. The result is the same
+     * as from calcValue() or calcDerivative(), but the spline coefficients
+     * are evaluated directly, which avoids the overhead of the generic
+     * SimTK::Function interface.
+     *
+     * @param aX Value of the independent variable.
+     * @param aDerivOrder Order of the derivative (0 for the value).
+     * @return Value of the spline or of its derivative at aX.
+     */
+    double evaluate(double aX, int aDerivOrder = 0) const;
+    /**
+     * Evaluate the spline or one of its derivatives at each of a sequence of
+     * values of the independent variable. The search for the knot interval
+     * containing each value starts from the interval of the previous value,
+     * so this is fastest when the values are sorted.
+     *
+     * @param aX Values of the independent variable.
+     * @param aDerivOrder Order of the derivative (0 for the value).
+     * @param rValues Resized to the size of aX and set to the values of the
+     * spline or of its derivative.
+     */
+    void evaluate(const SimTK::Vector& aX, int aDerivOrder,
+            SimTK::Vector& rValues) const;
+    /**
+     * Evaluate the spline or one of its derivatives at aX, starting the
+     * search for the knot interval containing aX at rInterval, which is
+     * updated to that interval (start from 0). Splines with the same knots
+     * (e.g., of the columns of one data file) can share rInterval, so that
+     * only the first of them searches.
+     */
+    double evaluate(double aX, int aDerivOrder, int& rInterval) const;
+    /**
+     * Whether this spline and aSpline have the same degree and knots, so that
+     * they can be evaluated with the same coefficient weights (see
+     * calcCoefficientWeights()).
+     */
+    bool hasSameKnots(const GCVSpline& aSpline) const;
+    /**
+     * Compute the weights of the coefficients of the spline in its value and
+     * its derivatives at aX: derivative d (0 for the value), up to
+     * aMaxDerivOrder, is the sum over k of rWeights(d, k) times coefficient
+     * rFirst + k (see evaluate(int, int, const SimTK::Matrix&)). The weights
+     * depend only on the degree and the knots, so splines with the same knots
+     * (e.g., of the columns of one data file) are evaluated at aX, for all
+     * the derivative orders, with one interval search and one set of weights.
+     * rInterval is as in evaluate(double, int, int&).
+     */
+    void calcCoefficientWeights(double aX, int aMaxDerivOrder, int& rInterval,
+            int& rFirst, SimTK::Matrix& rWeights) const;
+    /**
+     * Evaluate the spline or one of its derivatives from the coefficient
+     * weights computed by calcCoefficientWeights() with this spline or a
+     * spline with the same knots (see hasSameKnots()).
+     */
+    double evaluate(int aDerivOrder, int aFirst,
+            const SimTK::Matrix& aWeights) const;
+private:
+    /** Make sure the coefficients are fit to the current data. */
+    void updateCoefficients() const;
+    /** Use the given coefficients, of an earlier fit of the same data with
+    the same degree and error variance, instead of fitting the data. */
+    void setFittedCoefficients(const std::vector<double>& coefficients) const;
+    friend class GCVSplineSet;
+public:
 
 //=============================================================================
 };  // END class GCVSpline
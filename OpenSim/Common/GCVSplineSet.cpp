@@ -23,11 +23,65 @@
 
 #include "GCVSplineSet.h"
 #include "GCVSpline.h"
+#include "CommonUtilities.h"
 #include "Storage.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+
 
 using namespace OpenSim;
 
+namespace {
+
+// Layout of the cache files (see GCVSplineSet::fitSplines()). All numbers are
+// stored with the byte order of the machine that wrote the file.
+const char cacheSignature[8] = {'O', 'S', 'I', 'M', 'S', 'P', 'L', 'C'};
+const std::uint32_t cacheByteOrderMark = 0x01020304;
+const std::uint32_t cacheFormatVersion = 1;
+
+std::string& cacheDirectory() {
+    static std::string directory = [] {
+        const char* env = std::getenv("OPENSIM_SPLINE_CACHE_DIR");
+        return std::string(env ? env : "");
+    }();
+    return directory;
+}
+
+// 64-bit FNV-1a hash, which can be computed in parts.
+class Hash {
+public:
+    void add(const void* data, std::size_t numBytes) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < numBytes; ++i) {
+            _hash ^= bytes[i];
+            _hash *= 1099511628211ULL;
+        }
+    }
+    template <typename U>
+    void add(const U& value) { add(&value, sizeof(U)); }
+    std::uint64_t get() const { return _hash; }
+private:
+    std::uint64_t _hash = 14695981039346656037ULL;
+};
+
+template <typename U>
+void writePod(std::ostream& out, const U& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(U));
+}
+
+template <typename U>
+bool readPod(std::istream& in, U& value) {
+    in.read(reinterpret_cast<char*>(&value), sizeof(U));
+    return (bool)in;
+}
+
+} // anonymous namespace
+
 GCVSplineSet::~GCVSplineSet() {
     // No operation;
 }
@@ -68,6 +122,135 @@ GCVSplineSet::GCVSplineSet(const TimeSeriesTable& table,
         adoptAndAppend(new GCVSpline(degree, column.size(), time.data(),
                                      &column[0], label, errorVariance));
     }
+    fitSplines();
+}
+
+void GCVSplineSet::setCacheDirectory(const std::string& directory) {
+    cacheDirectory() = directory;
+}
+
+const std::string& GCVSplineSet::getCacheDirectory() {
+    return cacheDirectory();
+}
+
+void GCVSplineSet::fitSplines() {
+    // Splines without enough data points are left as they are (evaluating
+    // them is an error, as before).
+    std::vector<const GCVSpline*> splines;
+    std::size_t numPoints = 0;
+    for (int i = 0; i < getSize(); ++i) {
+        const auto* spline = getGCVSpline(i);
+        if (spline && spline->getSize() >= spline->getOrder() &&
+                spline->getSize() > 0) {
+            splines.push_back(spline);
+            numPoints += spline->getSize();
+        }
+    }
+    if (splines.empty()) return;
+
+    // The name of the cache file is a hash of everything the fit depends on.
+    const std::string& cacheDir = getCacheDirectory();
+    std::string cacheFileName;
+    std::uint64_t key = 0;
+    if (!cacheDir.empty()) {
+        Hash hash;
+        hash.add<std::uint64_t>(splines.size());
+        for (const auto* spline : splines) {
+            hash.add<std::int32_t>(spline->getHalfOrder());
+            hash.add<double>(spline->_errorVariance);
+            hash.add<std::int32_t>(spline->getSize());
+            hash.add(spline->getXValues(), sizeof(double) * spline->getSize());
+            hash.add(spline->getYValues(), sizeof(double) * spline->getSize());
+        }
+        key = hash.get();
+        char name[64];
+        snprintf(name, sizeof(name), "%016llx.osimsplc",
+                (unsigned long long)key);
+        const char last = cacheDir.back();
+        cacheFileName = cacheDir +
+                (last == '/' || last == '\\' ? "" : "/") + name;
+
+        std::ifstream in(cacheFileName, std::ios::binary);
+        if (in.is_open()) {
+            try {
+                char signature[sizeof(cacheSignature)];
+                in.read(signature, sizeof(signature));
+                std::uint32_t byteOrderMark = 0, formatVersion = 0;
+                std::uint64_t fileKey = 0, numSplines = 0;
+                OPENSIM_THROW_IF(!in ||
+                        !std::equal(signature,
+                                signature + sizeof(signature),
+                                cacheSignature) ||
+                        !readPod(in, byteOrderMark) ||
+                        byteOrderMark != cacheByteOrderMark ||
+                        !readPod(in, formatVersion) ||
+                        formatVersion != cacheFormatVersion ||
+                        !readPod(in, fileKey) || fileKey != key ||
+                        !readPod(in, numSplines) ||
+                        numSplines != splines.size(),
+                        Exception, "Unexpected header.");
+                std::vector<std::vector<double>> coefficients(splines.size());
+                for (std::size_t i = 0; i < splines.size(); ++i) {
+                    std::uint64_t size = 0;
+                    OPENSIM_THROW_IF(!readPod(in, size) ||
+                            size != (std::uint64_t)splines[i]->getSize(),
+                            Exception, "Unexpected number of coefficients.");
+                    coefficients[i].resize((std::size_t)size);
+                    in.read(reinterpret_cast<char*>(coefficients[i].data()),
+                            sizeof(double) * size);
+                    OPENSIM_THROW_IF(!in, Exception,
+                            "Unexpected end of file.");
+                }
+                for (std::size_t i = 0; i < splines.size(); ++i) {
+                    splines[i]->setFittedCoefficients(coefficients[i]);
+                }
+                return;
+            } catch (const std::exception& x) {
+                log_warn("Ignoring spline cache file '{}': {}", cacheFileName,
+                        x.what());
+            }
+        }
+    }
+
+    // Creating threads takes longer than fitting small data sets.
+    const int minPointsPerThread = 10000;
+    const int numThreads = (int)std::max<std::size_t>(1,
+            std::min<std::size_t>({(std::size_t)getNumThreadsOrDefault(),
+                    splines.size(), numPoints / minPointsPerThread}));
+    parallelForEach((int)splines.size(), numThreads,
+            [&](int, int i) { splines[i]->updateCoefficients(); });
+
+    if (cacheFileName.empty()) return;
+    // Write under a temporary name and then rename, so that processes
+    // constructing sets from the same data concurrently never read an
+    // incomplete file.
+    const std::string tempFileName = cacheFileName + "." +
+            std::to_string(std::random_device{}()) + ".tmp";
+    bool success = false;
+    {
+        std::ofstream out(tempFileName, std::ios::binary);
+        if (out.good()) {
+            out.write(cacheSignature, sizeof(cacheSignature));
+            writePod(out, cacheByteOrderMark);
+            writePod(out, cacheFormatVersion);
+            writePod<std::uint64_t>(out, key);
+            writePod<std::uint64_t>(out, splines.size());
+            for (const auto* spline : splines) {
+                const Array<double>& coefficients = spline->getCoefficients();
+                writePod<std::uint64_t>(out, coefficients.getSize());
+                out.write(reinterpret_cast<const char*>(coefficients.get()),
+                        sizeof(double) * coefficients.getSize());
+            }
+            success = out.good();
+        }
+    }
+    if (!success) {
+        std::remove(tempFileName.c_str());
+        log_warn("Could not write spline cache file '{}'.", cacheFileName);
+    } else if (std::rename(tempFileName.c_str(), cacheFileName.c_str()) != 0) {
+        // E.g., another process wrote the same cache file first.
+        std::remove(tempFileName.c_str());
+    }
 }
 
 void GCVSplineSet::setNull() {
@@ -118,8 +301,6 @@ void GCVSplineSet::construct(int aDegree,
         // CONSTRUCT SPLINE
         //printf("%s\t",name);
         spline = new GCVSpline(aDegree,nData,times,data,name,aErrorVariance);
-        SimTK::Function* fp = spline->createSimTKFunction();
-        delete fp;  
 
         // ADD SPLINE
         adoptAndAppend(spline);
@@ -129,6 +310,9 @@ void GCVSplineSet::construct(int aDegree,
     // CLEANUP
     if(times!=NULL) delete[] times;
     if(data!=NULL) delete[] data;
+
+    // FIT THE SPLINES
+    fitSplines();
 }
 
 GCVSpline* GCVSplineSet::getGCVSpline(int aIndex) const {
@@ -136,6 +320,20 @@ GCVSpline* GCVSplineSet::getGCVSpline(int aIndex) const {
     return(&func);
 }
 
+SimTK::Vector GCVSplineSet::evaluateAll(double aX, int aDerivOrder) const {
+    const int n = getSize();
+    SimTK::Vector values(n);
+    for (int i = 0; i < n; ++i) {
+        const auto* spline = dynamic_cast<const GCVSpline*>(&get(i));
+        if (spline) {
+            values[i] = spline->evaluate(aX, aDerivOrder);
+        } else {
+            values[i] = evaluate(i, aDerivOrder, aX);
+        }
+    }
+    return values;
+}
+
 Storage* GCVSplineSet::constructStorage(int aDerivOrder,double aDX) {
     if(aDerivOrder<0) return(NULL);
     if(getSize()<=0) return(NULL);
@@ -186,14 +384,11 @@ Storage* GCVSplineSet::constructStorage(int aDerivOrder,double aDX) {
     }
     store->setColumnLabels(labels);
 
-    // SET STATES
-    Array<double> y(0.0,n);
-
     // LOOP THROUGH THE DATA
     // constant increments
     if(aDX>0.0) {
         for(double x=getMinX(); x<=getMaxX(); x+=aDX) {
-            evaluate(y,aDerivOrder,x);
+            const SimTK::Vector y = evaluateAll(x,aDerivOrder);
             store->append(x,n,&y[0]);
         }
 
@@ -207,7 +402,7 @@ Storage* GCVSplineSet::constructStorage(int aDerivOrder,double aDX) {
             if(xOrig[ix]<getMinX()) continue;
             if(xOrig[ix]>getMaxX()) break;
 
-            evaluate(y,aDerivOrder,xOrig[ix]);
+            const SimTK::Vector y = evaluateAll(xOrig[ix],aDerivOrder);
             store->append(xOrig[ix],n,&y[0]);
         }
     }
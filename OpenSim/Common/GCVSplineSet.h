@@ -44,6 +44,14 @@ class Storage;
 /**
  * A class for holding a set of generalized cross-validated splines.
  *
+ * The constructors from a Storage or a TimeSeriesTable fit the splines of the
+ * columns on multiple threads (small data sets are fit on one thread). If a
+ * cache directory is set (see setCacheDirectory()), the fitted coefficients
+ * are also stored in a file in that directory, named after a hash of the data,
+ * the degree and the error variance, so that constructing a set from the same
+ * data again (e.g., in the next run of a tool) reads the coefficients instead
+ * of fitting the splines.
+ *
  * @see GCVSpline
  * @author Frank C. Anderson
  */
@@ -109,12 +117,30 @@ public:
                  double errorVariance                   = 0.0);
     virtual ~GCVSplineSet();
 
+    /** @name Cache of fitted splines
+    Caching is disabled by default. The cache directory can also be set with
+    the `OPENSIM_SPLINE_CACHE_DIR` environment variable; setCacheDirectory()
+    takes precedence. The directory is not thread-safe to change while sets
+    are being constructed. */
+    /// @{
+    /** Set the directory for cache files (it must exist). An empty string
+    disables caching. */
+    static void setCacheDirectory(const std::string& directory);
+    static const std::string& getCacheDirectory();
+    /// @}
+
 private:
     /**
      * Set all member variables to NULL values.
      */
     void setNull();
 
+    /**
+     * Fit the splines of this set (in parallel), or read their coefficients
+     * from the cache.
+     */
+    void fitSplines();
+
     /**
      * Construct a set of generalized cross-validated splines based on the 
      * states stored in an Storage object.
@@ -137,6 +163,19 @@ public:
     double getMinX() const;
     double getMaxX() const;
 
+    /**
+     * Evaluate all the functions in the set, or their derivatives, at the
+     * same value of the independent variable. GCVSpline's are evaluated
+     * directly from their coefficients (see GCVSpline::evaluate()), which is
+     * faster than FunctionSet::evaluate().
+     *
+     * @param aX Value of the independent variable.
+     * @param aDerivOrder Order of the derivative (0 for the value).
+     * @return One value per function, in the order of the functions in the
+     * set.
+     */
+    SimTK::Vector evaluateAll(double aX, int aDerivOrder = 0) const;
+
     /**
      * Construct a storage object (see Storage) for this spline set or for 
      * some derivative of this spline set.
@@ -0,0 +1,538 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  HDF5FileAdapter.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "HDF5FileAdapter.h"
+
+#include "DelimFileAdapter.h"
+
+#include <hdf5.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+
+namespace OpenSim {
+
+namespace {
+
+// The HDF5 library is thread-safe only if it was built so; all the calls of
+// this adapter are serialized.
+std::mutex hdf5Mutex;
+
+const char* const dataTypeAttribute = "opensim_datatype";
+const char* const dependentsMetaDataGroup = "dependents_metadata";
+
+void check(herr_t status, const std::string& what) {
+    OPENSIM_THROW_IF(status < 0, IOError, "HDF5 error: could not " + what +
+            ".");
+}
+
+/// Owns an HDF5 identifier and closes it with `close`.
+class H5Handle {
+public:
+    H5Handle(hid_t id, herr_t (*close)(hid_t), const std::string& what)
+            : m_id(id), m_close(close) {
+        OPENSIM_THROW_IF(id < 0, IOError, "HDF5 error: could not " + what +
+                ".");
+    }
+    H5Handle(H5Handle&& other) : m_id(other.m_id), m_close(other.m_close) {
+        other.m_id = -1;
+    }
+    H5Handle(const H5Handle&) = delete;
+    H5Handle& operator=(const H5Handle&) = delete;
+    H5Handle& operator=(H5Handle&&) = delete;
+    ~H5Handle() { if (m_id >= 0) m_close(m_id); }
+    operator hid_t() const { return m_id; }
+private:
+    hid_t m_id;
+    herr_t (*m_close)(hid_t);
+};
+
+/// The type of variable-length (UTF-8) strings.
+H5Handle createStringType() {
+    H5Handle type(H5Tcopy(H5T_C_S1), H5Tclose, "create a string type");
+    check(H5Tset_size(type, H5T_VARIABLE), "create a string type");
+    check(H5Tset_cset(type, H5T_CSET_UTF8), "create a string type");
+    return type;
+}
+
+void writeStringAttribute(hid_t loc, const std::string& name,
+        const std::string& value) {
+    const H5Handle type = createStringType();
+    const H5Handle space(H5Screate(H5S_SCALAR), H5Sclose,
+            "create a dataspace");
+    const H5Handle attribute(H5Acreate2(loc, name.c_str(), type, space,
+            H5P_DEFAULT, H5P_DEFAULT), H5Aclose,
+            "create attribute '" + name + "'");
+    const char* str = value.c_str();
+    check(H5Awrite(attribute, type, &str), "write attribute '" + name + "'");
+}
+
+template <typename U>
+void writeNumberAttribute(hid_t loc, const std::string& name, hid_t fileType,
+        hid_t memoryType, const U& value) {
+    const H5Handle space(H5Screate(H5S_SCALAR), H5Sclose,
+            "create a dataspace");
+    const H5Handle attribute(H5Acreate2(loc, name.c_str(), fileType, space,
+            H5P_DEFAULT, H5P_DEFAULT), H5Aclose,
+            "create attribute '" + name + "'");
+    check(H5Awrite(attribute, memoryType, &value),
+            "write attribute '" + name + "'");
+}
+
+std::string readStringAttribute(hid_t loc, const std::string& name) {
+    const H5Handle attribute(H5Aopen(loc, name.c_str(), H5P_DEFAULT),
+            H5Aclose, "open attribute '" + name + "'");
+    const H5Handle fileType(H5Aget_type(attribute), H5Tclose,
+            "get the type of attribute '" + name + "'");
+    OPENSIM_THROW_IF(H5Tis_variable_str(fileType) <= 0, IOError,
+            "Expected attribute '" + name + "' to be a variable-length "
+            "string.");
+    const H5Handle type = createStringType();
+    char* str = nullptr;
+    check(H5Aread(attribute, type, &str), "read attribute '" + name + "'");
+    const std::string value = str ? str : "";
+    H5free_memory(str);
+    return value;
+}
+
+void writeStrings(hid_t loc, const std::string& name,
+        const std::vector<std::string>& values) {
+    const H5Handle type = createStringType();
+    const hsize_t size = values.size();
+    const H5Handle space(H5Screate_simple(1, &size, nullptr), H5Sclose,
+            "create a dataspace");
+    const H5Handle dataset(H5Dcreate2(loc, name.c_str(), type, space,
+            H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT), H5Dclose,
+            "create dataset '" + name + "'");
+    if (values.empty()) return;
+    std::vector<const char*> strs;
+    for (const auto& value : values) strs.push_back(value.c_str());
+    check(H5Dwrite(dataset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+            strs.data()), "write dataset '" + name + "'");
+}
+
+std::vector<std::string> readStrings(hid_t loc, const std::string& name) {
+    const H5Handle dataset(H5Dopen2(loc, name.c_str(), H5P_DEFAULT),
+            H5Dclose, "open dataset '" + name + "'");
+    const H5Handle fileType(H5Dget_type(dataset), H5Tclose,
+            "get the type of dataset '" + name + "'");
+    OPENSIM_THROW_IF(H5Tis_variable_str(fileType) <= 0, IOError,
+            "Expected dataset '" + name + "' to contain variable-length "
+            "strings.");
+    const H5Handle space(H5Dget_space(dataset), H5Sclose,
+            "get the dataspace of dataset '" + name + "'");
+    const hssize_t size = H5Sget_simple_extent_npoints(space);
+    check(size < 0 ? -1 : 0, "get the size of dataset '" + name + "'");
+    std::vector<char*> strs(static_cast<std::size_t>(size), nullptr);
+    if (strs.empty()) return {};
+    const H5Handle type = createStringType();
+    check(H5Dread(dataset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, strs.data()),
+            "read dataset '" + name + "'");
+    std::vector<std::string> values;
+    for (char* str : strs) {
+        values.emplace_back(str ? str : "");
+        H5free_memory(str);
+    }
+    return values;
+}
+
+/// The properties of a dataset with chunks of `chunkSize` rows, compressed
+/// with `compressionLevel`. Datasets without elements are not chunked.
+H5Handle createDatasetProperties(const std::vector<hsize_t>& dims,
+        int chunkSize, int compressionLevel) {
+    H5Handle properties(H5Pcreate(H5P_DATASET_CREATE), H5Pclose,
+            "create dataset properties");
+    if (std::find(dims.begin(), dims.end(), hsize_t(0)) != dims.end()) {
+        return properties;
+    }
+    std::vector<hsize_t> chunk = dims;
+    chunk[0] = std::min(dims[0], static_cast<hsize_t>(chunkSize));
+    check(H5Pset_chunk(properties, static_cast<int>(chunk.size()),
+            chunk.data()), "set the chunk size");
+    if (compressionLevel > 0) {
+        // Shuffling the bytes of the doubles makes them compress better.
+        check(H5Pset_shuffle(properties), "set the shuffle filter");
+        check(H5Pset_deflate(properties, compressionLevel),
+                "set the deflate filter");
+    }
+    return properties;
+}
+
+void writeDoubles(hid_t loc, const std::string& name,
+        const std::vector<hsize_t>& dims, const double* data,
+        int chunkSize, int compressionLevel) {
+    const H5Handle space(H5Screate_simple(static_cast<int>(dims.size()),
+            dims.data(), nullptr), H5Sclose, "create a dataspace");
+    const H5Handle properties =
+            createDatasetProperties(dims, chunkSize, compressionLevel);
+    const H5Handle dataset(H5Dcreate2(loc, name.c_str(), H5T_IEEE_F64LE,
+            space, H5P_DEFAULT, properties, H5P_DEFAULT), H5Dclose,
+            "create dataset '" + name + "'");
+    hsize_t size = 1;
+    for (const auto dim : dims) size *= dim;
+    if (size == 0) return;
+    check(H5Dwrite(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+            data), "write dataset '" + name + "'");
+}
+
+/// Read a dataset of doubles into `data`, and return its dimensions.
+std::vector<hsize_t> readDoubles(hid_t loc, const std::string& name,
+        std::vector<double>& data) {
+    const H5Handle dataset(H5Dopen2(loc, name.c_str(), H5P_DEFAULT),
+            H5Dclose, "open dataset '" + name + "'");
+    const H5Handle space(H5Dget_space(dataset), H5Sclose,
+            "get the dataspace of dataset '" + name + "'");
+    const int rank = H5Sget_simple_extent_ndims(space);
+    check(rank < 0 ? -1 : 0, "get the rank of dataset '" + name + "'");
+    std::vector<hsize_t> dims(rank);
+    check(H5Sget_simple_extent_dims(space, dims.data(), nullptr),
+            "get the dimensions of dataset '" + name + "'");
+    hsize_t size = 1;
+    for (const auto dim : dims) size *= dim;
+    data.resize(static_cast<std::size_t>(size));
+    if (size) {
+        check(H5Dread(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL,
+                H5P_DEFAULT, data.data()), "read dataset '" + name + "'");
+    }
+    return dims;
+}
+
+/// The names of the links (groups, datasets) in a group.
+std::vector<std::string> getLinkNames(hid_t group) {
+    H5G_info_t info;
+    check(H5Gget_info(group, &info), "get the contents of a group");
+    std::vector<std::string> names;
+    for (hsize_t i = 0; i < info.nlinks; ++i) {
+        const ssize_t size = H5Lget_name_by_idx(group, ".", H5_INDEX_NAME,
+                H5_ITER_INC, i, nullptr, 0, H5P_DEFAULT);
+        check(size < 0 ? -1 : 0, "get the name of a link");
+        std::string name(static_cast<std::size_t>(size) + 1, '\0');
+        check(H5Lget_name_by_idx(group, ".", H5_INDEX_NAME, H5_ITER_INC, i,
+                &name[0], name.size(), H5P_DEFAULT) < 0 ? -1 : 0,
+                "get the name of a link");
+        name.resize(static_cast<std::size_t>(size));
+        names.push_back(name);
+    }
+    return names;
+}
+
+herr_t appendAttributeName(hid_t, const char* name, const H5A_info_t*,
+        void* names) {
+    static_cast<std::vector<std::string>*>(names)->emplace_back(name);
+    return 0;
+}
+
+std::vector<std::string> getAttributeNames(hid_t loc) {
+    std::vector<std::string> names;
+    check(H5Aiterate2(loc, H5_INDEX_NAME, H5_ITER_INC, nullptr,
+            appendAttributeName, &names), "get the attributes of a group");
+    return names;
+}
+
+/// Append the paths of the tables in `group` (at `path`) and its subgroups.
+void findTables(hid_t group, const std::string& path,
+        std::vector<std::string>& tablePaths) {
+    for (const auto& name : getLinkNames(group)) {
+        const H5Handle object(H5Oopen(group, name.c_str(), H5P_DEFAULT),
+                H5Oclose, "open '" + name + "'");
+        if (H5Iget_type(object) != H5I_GROUP) continue;
+        const std::string objectPath = path.empty() ? name : path + "/" + name;
+        if (H5Aexists(object, dataTypeAttribute) > 0) {
+            tablePaths.push_back(objectPath);
+        } else {
+            findTables(object, objectPath, tablePaths);
+        }
+    }
+}
+
+template <typename T>
+bool writeTable(hid_t file, const std::string& path,
+        const AbstractDataTable* absTable, int chunkSize,
+        int compressionLevel) {
+    const auto* table = dynamic_cast<const TimeSeriesTable_<T>*>(absTable);
+    if (!table) return false;
+
+    constexpr std::size_t ncomp = sizeof(T) / sizeof(double);
+    const std::size_t nrow = table->getNumRows();
+    const std::size_t ncol = table->getNumColumns();
+
+    const H5Handle linkProperties(H5Pcreate(H5P_LINK_CREATE), H5Pclose,
+            "create link properties");
+    check(H5Pset_create_intermediate_group(linkProperties, 1),
+            "set link properties");
+    const H5Handle group(H5Gcreate2(file, path.c_str(), linkProperties,
+            H5P_DEFAULT, H5P_DEFAULT), H5Gclose,
+            "create group '" + path + "'");
+
+    writeStringAttribute(group, dataTypeAttribute,
+            DelimFileAdapter<T>::dataTypeName());
+    const auto& metadata = table->getTableMetaData();
+    for (const auto& key : metadata.getKeys()) {
+        if (key == dataTypeAttribute) continue;
+        const SimTK::AbstractValue& value = metadata.getValueForKey(key);
+        if (const auto* str =
+                dynamic_cast<const SimTK::Value<std::string>*>(&value)) {
+            writeStringAttribute(group, key, str->get());
+        } else if (const auto* dbl =
+                dynamic_cast<const SimTK::Value<double>*>(&value)) {
+            writeNumberAttribute(group, key, H5T_IEEE_F64LE,
+                    H5T_NATIVE_DOUBLE, dbl->get());
+        } else if (const auto* integer =
+                dynamic_cast<const SimTK::Value<int>*>(&value)) {
+            writeNumberAttribute(group, key, H5T_STD_I32LE, H5T_NATIVE_INT,
+                    integer->get());
+        }
+    }
+
+    const auto& time = table->getIndependentColumn();
+    writeDoubles(group, "time", {nrow}, time.data(), chunkSize,
+            compressionLevel);
+
+    // The dataset is row-major, while the matrix is column-major.
+    const auto& matrix = table->getMatrix();
+    std::vector<double> data(nrow * ncol * ncomp);
+    for (std::size_t irow = 0; irow < nrow; ++irow) {
+        for (std::size_t icol = 0; icol < ncol; ++icol) {
+            std::memcpy(&data[(irow * ncol + icol) * ncomp],
+                    &matrix((int)irow, (int)icol), sizeof(T));
+        }
+    }
+    std::vector<hsize_t> dims{nrow, ncol};
+    if (ncomp > 1) dims.push_back(ncomp);
+    writeDoubles(group, "data", dims, data.data(), chunkSize,
+            compressionLevel);
+
+    const H5Handle dependents(H5Gcreate2(group, dependentsMetaDataGroup,
+            H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT), H5Gclose,
+            "create group '" + path + "/" + dependentsMetaDataGroup + "'");
+    const auto& dependentsMetaData = table->getDependentsMetaData();
+    for (const auto& key : dependentsMetaData.getKeys()) {
+        const auto* values = dynamic_cast<const ValueArray<std::string>*>(
+                &dependentsMetaData.getValueArrayForKey(key));
+        if (!values) continue;
+        std::vector<std::string> strs;
+        for (const auto& value : values->get()) strs.push_back(value.get());
+        writeStrings(dependents, key, strs);
+    }
+    return true;
+}
+
+template <typename T>
+std::shared_ptr<AbstractDataTable> readTable(hid_t group,
+        const std::string& path) {
+    constexpr std::size_t ncomp = sizeof(T) / sizeof(double);
+
+    ValueArrayDictionary dependentsMetaData;
+    {
+        const H5Handle dependents(H5Gopen2(group, dependentsMetaDataGroup,
+                H5P_DEFAULT), H5Gclose,
+                "open group '" + path + "/" + dependentsMetaDataGroup + "'");
+        for (const auto& key : getLinkNames(dependents)) {
+            ValueArray<std::string> values;
+            for (const auto& str : readStrings(dependents, key)) {
+                values.upd().push_back(SimTK::Value<std::string>(str));
+            }
+            dependentsMetaData.setValueArrayForKey(key, values);
+        }
+    }
+    OPENSIM_THROW_IF(!dependentsMetaData.hasKey("labels"), IOError,
+            "Table '" + path + "' has no column labels.");
+    const auto& labelValues = dynamic_cast<const ValueArray<std::string>&>(
+            dependentsMetaData.getValueArrayForKey("labels"));
+    std::vector<std::string> labels;
+    for (const auto& label : labelValues.get()) labels.push_back(label.get());
+
+    std::vector<double> time;
+    const auto timeDims = readDoubles(group, "time", time);
+    std::vector<double> data;
+    const auto dims = readDoubles(group, "data", data);
+    const std::size_t nrow = time.size();
+    const std::size_t ncol = labels.size();
+    std::vector<hsize_t> expectedDims{nrow, ncol};
+    if (ncomp > 1) expectedDims.push_back(ncomp);
+    OPENSIM_THROW_IF(timeDims.size() != 1 || dims != expectedDims, IOError,
+            "The datasets of table '" + path + "' do not have the "
+            "dimensions of its data type and column labels.");
+
+    SimTK::Matrix_<T> matrix((int)nrow, (int)ncol);
+    for (std::size_t irow = 0; irow < nrow; ++irow) {
+        for (std::size_t icol = 0; icol < ncol; ++icol) {
+            std::memcpy(&matrix.updElt((int)irow, (int)icol),
+                    &data[(irow * ncol + icol) * ncomp], sizeof(T));
+        }
+    }
+    auto table = std::make_shared<TimeSeriesTable_<T>>(time, matrix, labels);
+    table->setDependentsMetaData(dependentsMetaData);
+
+    for (const auto& name : getAttributeNames(group)) {
+        if (name == dataTypeAttribute) continue;
+        const H5Handle attribute(H5Aopen(group, name.c_str(), H5P_DEFAULT),
+                H5Aclose, "open attribute '" + name + "'");
+        const H5Handle type(H5Aget_type(attribute), H5Tclose,
+                "get the type of attribute '" + name + "'");
+        const H5T_class_t typeClass = H5Tget_class(type);
+        if (typeClass == H5T_STRING) {
+            table->updTableMetaData().setValueForKey(
+                    name, readStringAttribute(group, name));
+        } else if (typeClass == H5T_FLOAT) {
+            double value;
+            check(H5Aread(attribute, H5T_NATIVE_DOUBLE, &value),
+                    "read attribute '" + name + "'");
+            table->updTableMetaData().setValueForKey(name, value);
+        } else if (typeClass == H5T_INTEGER) {
+            int value;
+            check(H5Aread(attribute, H5T_NATIVE_INT, &value),
+                    "read attribute '" + name + "'");
+            table->updTableMetaData().setValueForKey(name, value);
+        }
+    }
+    return table;
+}
+
+} // anonymous namespace
+
+HDF5FileAdapter*
+HDF5FileAdapter::clone() const {
+    return new HDF5FileAdapter{*this};
+}
+
+const std::string
+HDF5FileAdapter::tableString() {
+    return "table";
+}
+
+void
+HDF5FileAdapter::setCompressionLevel(int level) {
+    OPENSIM_THROW_IF(level < 0 || level > 9, Exception,
+            "Expected a compression level from 0 to 9, but got {}.", level);
+    _compressionLevel = level;
+}
+
+void
+HDF5FileAdapter::setChunkSize(int numRows) {
+    OPENSIM_THROW_IF(numRows < 1, Exception,
+            "Expected a positive chunk size, but got {}.", numRows);
+    _chunkSize = numRows;
+}
+
+HDF5FileAdapter::OutputTables
+HDF5FileAdapter::extendRead(const std::string& fileName) const {
+    OPENSIM_THROW_IF(fileName.empty(), EmptyFileName);
+    OPENSIM_THROW_IF(!std::ifstream(fileName).good(), FileDoesNotExist,
+            fileName);
+
+    std::lock_guard<std::mutex> lock(hdf5Mutex);
+    const H5Handle file(H5Fopen(fileName.c_str(), H5F_ACC_RDONLY,
+            H5P_DEFAULT), H5Fclose, "open file '" + fileName + "'");
+    std::vector<std::string> paths;
+    findTables(file, "", paths);
+    OPENSIM_THROW_IF(paths.empty(), IOError,
+            "File '" + fileName + "' contains no tables.");
+
+    using namespace SimTK;
+    OutputTables output_tables{};
+    for (const auto& path : paths) {
+        const H5Handle group(H5Gopen2(file, path.c_str(), H5P_DEFAULT),
+                H5Gclose, "open group '" + path + "'");
+        const std::string type = readStringAttribute(group, dataTypeAttribute);
+        std::shared_ptr<AbstractDataTable> table;
+        if (type == "double")
+            table = readTable<double>(group, path);
+        else if (type == "Vec2")
+            table = readTable<Vec2>(group, path);
+        else if (type == "Vec3")
+            table = readTable<Vec3>(group, path);
+        else if (type == "Vec4")
+            table = readTable<Vec4>(group, path);
+        else if (type == "Vec5")
+            table = readTable<Vec5>(group, path);
+        else if (type == "Vec6")
+            table = readTable<Vec6>(group, path);
+        else if (type == "Vec7")
+            table = readTable<Vec7>(group, path);
+        else if (type == "Vec8")
+            table = readTable<Vec8>(group, path);
+        else if (type == "Vec9")
+            table = readTable<Vec9>(group, path);
+        else if (type == "Vec10")
+            table = readTable<Vec<10>>(group, path);
+        else if (type == "Vec11")
+            table = readTable<Vec<11>>(group, path);
+        else if (type == "Vec12")
+            table = readTable<Vec<12>>(group, path);
+        else if (type == "UnitVec3")
+            table = readTable<UnitVec3>(group, path);
+        else if (type == "Quaternion")
+            table = readTable<Quaternion>(group, path);
+        else if (type == "SpatialVec")
+            table = readTable<SpatialVec>(group, path);
+        else
+            OPENSIM_THROW(IOError, "Table '" + path + "' of file '" +
+                    fileName + "' has unsupported datatype '" + type + "'.");
+        output_tables.emplace(path, table);
+    }
+    return output_tables;
+}
+
+void
+HDF5FileAdapter::extendWrite(const InputTables& absTables,
+                             const std::string& fileName) const {
+    OPENSIM_THROW_IF(absTables.empty(), NoTableFound);
+    OPENSIM_THROW_IF(fileName.empty(), EmptyFileName);
+
+    std::lock_guard<std::mutex> lock(hdf5Mutex);
+    const H5Handle file(H5Fcreate(fileName.c_str(), H5F_ACC_TRUNC,
+            H5P_DEFAULT, H5P_DEFAULT), H5Fclose,
+            "create file '" + fileName + "'");
+
+    using namespace SimTK;
+    for (const auto& keyTable : absTables) {
+        const std::string& path = keyTable.first;
+        const AbstractDataTable* absTable = keyTable.second;
+        OPENSIM_THROW_IF(path.empty(), Exception,
+                "Expected a non-empty key for each table.");
+        const int c = _chunkSize;
+        const int l = _compressionLevel;
+        if (writeTable<UnitVec3>(file, path, absTable, c, l)) continue;
+        if (writeTable<Quaternion>(file, path, absTable, c, l)) continue;
+        if (writeTable<SpatialVec>(file, path, absTable, c, l)) continue;
+        if (writeTable<double>(file, path, absTable, c, l)) continue;
+        if (writeTable<Vec2>(file, path, absTable, c, l)) continue;
+        if (writeTable<Vec3>(file, path, absTable, c, l)) continue;
+        if (writeTable<Vec4>(file, path, absTable, c, l)) continue;
+        if (writeTable<Vec5>(file, path, absTable, c, l)) continue;
+        if (writeTable<Vec6>(file, path, absTable, c, l)) continue;
+        if (writeTable<Vec7>(file, path, absTable, c, l)) continue;
+        if (writeTable<Vec8>(file, path, absTable, c, l)) continue;
+        if (writeTable<Vec9>(file, path, absTable, c, l)) continue;
+        if (writeTable<Vec<10>>(file, path, absTable, c, l)) continue;
+        if (writeTable<Vec<11>>(file, path, absTable, c, l)) continue;
+        if (writeTable<Vec<12>>(file, path, absTable, c, l)) continue;
+
+        OPENSIM_THROW(IncorrectTableType,
+                "HDF5FileAdapter can only write TimeSeriesTable_'s.");
+    }
+}
+
+} // namespace OpenSim
@@ -0,0 +1,131 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  HDF5FileAdapter.h                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#ifndef OPENSIM_HDF5_FILE_ADAPTER_H_
+#define OPENSIM_HDF5_FILE_ADAPTER_H_
+
+#include "FileAdapter.h"
+#include "TimeSeriesTable.h"
+
+namespace OpenSim {
+
+/** HDF5FileAdapter is a FileAdapter that reads and writes any number of
+TimeSeriesTable_'s in a single HDF5 file (extension ".h5"), so that all the
+results of a trial (e.g., of all the analyses of an AnalyzeTool) are in one
+file instead of one file per table. This is available only if OpenSim was
+built with HDF5 (CMake option OPENSIM_WITH_HDF5).
+
+Each table is a group of the file, whose path is the key of the table in the
+InputTables/OutputTables (a key with '/' creates nested groups, e.g.,
+"MuscleAnalysis/FiberLength"). The group contains:
+- the dataset `time` (the independent column);
+- the dataset `data`, of doubles with dimensions (rows, columns) for tables
+  of double, or (rows, columns, components) for tables of other element types
+  (e.g., 3 components for SimTK::Vec3, 4 for SimTK::Quaternion, 6 for
+  SimTK::SpatialVec);
+- the group `dependents_metadata`, with a dataset of strings for each key of
+  the dependents metadata that has string values (including the column
+  `labels`).
+
+The data type of the elements (e.g., "double" or "Vec3", as in STO files) is
+the attribute `opensim_datatype` of the group, and the table metadata with
+string, double, or int values are the other attributes of the group. The
+datasets are chunked (see setChunkSize()) and compressed with the deflate
+filter (see setCompressionLevel()), so that they can be read by rows by other
+HDF5 tools (e.g., h5py) without decompressing the whole dataset.
+
+\code{.cpp}
+HDF5FileAdapter::write(table, "states.h5");
+
+HDF5FileAdapter adapter;
+adapter.setCompressionLevel(9);
+adapter.writeTables({{"Kinematics/Coordinates", &coordinates},
+                     {"BodyKinematics/pos_global", &positions}},
+                    "trial01.h5");
+TimeSeriesTable fromFile("trial01.h5", "Kinematics/Coordinates");
+\endcode
+
+Each call to write or writeTables() creates (or truncates) the file; the
+tables of a trial must be written with one call. Different files can be
+written concurrently by separate processes (e.g., one per trial); within a
+process, the calls that access HDF5 files are serialized, since the HDF5
+library is not necessarily thread-safe.                                    */
+class OSIMCOMMON_API HDF5FileAdapter : public FileAdapter {
+public:
+    HDF5FileAdapter()                                  = default;
+    HDF5FileAdapter(const HDF5FileAdapter&)            = default;
+    HDF5FileAdapter(HDF5FileAdapter&&)                 = default;
+    HDF5FileAdapter& operator=(const HDF5FileAdapter&) = default;
+    HDF5FileAdapter& operator=(HDF5FileAdapter&&)      = default;
+    ~HDF5FileAdapter()                                 = default;
+
+    HDF5FileAdapter* clone() const override;
+
+    /** The level of the deflate (gzip) compression of the datasets, from 0
+    (no compression) to 9 (the smallest files, but the slowest to write). The
+    default is 4.                                                             */
+    void setCompressionLevel(int level);
+    int getCompressionLevel() const { return _compressionLevel; }
+
+    /** The number of rows in each chunk of the datasets (at most the number
+    of rows of the table). Compression is applied to each chunk, and a chunk
+    is the smallest part of a dataset that is read. The default is 1024.      */
+    void setChunkSize(int numRows);
+    int getChunkSize() const { return _chunkSize; }
+
+    /** Write the tables to a file, with the settings of this adapter. The
+    keys of `tables` are the paths of the tables in the file.                 */
+    void writeTables(const InputTables& tables,
+                     const std::string& fileName) const {
+        extendWrite(tables, fileName);
+    }
+
+    /** Write a TimeSeriesTable_ to a file, with the default settings.       */
+    template<typename T>
+    static void write(const TimeSeriesTable_<T>& table,
+                      const std::string& fileName) {
+        InputTables tables{};
+        tables.emplace(tableString(), &table);
+        HDF5FileAdapter{}.extendWrite(tables, fileName);
+    }
+
+    /** Key used for table associative array returned/accepted by write/read
+    for a file with a single table.                                           */
+    static const std::string tableString();
+
+protected:
+    /** Implementation of the read functionality. All the tables of the file
+    are read, keyed by their paths in the file.                               */
+    OutputTables extendRead(const std::string& fileName) const override;
+
+    /** Implementation of the write functionality.                            */
+    void extendWrite(const InputTables& tables,
+                     const std::string& fileName) const override;
+
+private:
+    int _compressionLevel = 4;
+    int _chunkSize = 1024;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_HDF5_FILE_ADAPTER_H_
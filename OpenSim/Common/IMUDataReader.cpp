@@ -1,5 +1,10 @@
 #include "IMUDataReader.h"
 
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <istream>
+
 namespace OpenSim {
 
     const std::string IMUDataReader::Orientations{ "orientations" };         // name of table for orientation data
@@ -48,4 +53,56 @@ namespace OpenSim {
         return tables;
 
     }
+
+    std::vector<size_t> IMUDataReader::readLines(
+            std::istream& stream, std::string& buffer) {
+        buffer.clear();
+        char block[1 << 16];
+        while (stream.read(block, sizeof(block)) || stream.gcount() > 0) {
+            buffer.append(block, (size_t)stream.gcount());
+        }
+
+        std::vector<size_t> lines;
+        size_t pos = 0;
+        while (pos < buffer.size()) {
+            size_t newline = buffer.find('\n', pos);
+            if (newline == std::string::npos) newline = buffer.size();
+            size_t lineEnd = newline;
+            if (lineEnd > pos && buffer[lineEnd - 1] == '\r') --lineEnd;
+            if (lineEnd == pos) break;
+            if (lineEnd < buffer.size()) buffer[lineEnd] = '\0';
+            lines.push_back(pos);
+            pos = newline + 1;
+        }
+        return lines;
+    }
+
+    void IMUDataReader::splitFields(
+            char* line, char delimiter, std::vector<const char*>& fields) {
+        fields.clear();
+        fields.push_back(line);
+        for (char* p = line; *p != '\0'; ++p) {
+            if (*p == delimiter) {
+                *p = '\0';
+                fields.push_back(p + 1);
+            }
+        }
+    }
+
+    double IMUDataReader::parseField(
+            const std::vector<const char*>& fields, int column) {
+        OPENSIM_THROW_IF(column < 0 || column >= (int)fields.size(),
+                Exception, "Expected at least {} fields, but the line has {}.",
+                column + 1, fields.size());
+        const char* field = fields[column];
+        char* end = nullptr;
+        errno = 0;
+        const double value = std::strtod(field, &end);
+        while (end != field && std::isspace(static_cast<unsigned char>(*end)))
+            ++end;
+        OPENSIM_THROW_IF(end == field || *end != '\0' || errno == ERANGE,
+                Exception, "Expected a number for field {}, but got '{}'.",
+                column + 1, field);
+        return value;
+    }
 }
@@ -78,6 +78,23 @@ protected:
         const SimTK::Matrix_<SimTK::Vec3>& linearAccelerationData, 
         const SimTK::Matrix_<SimTK::Vec3>& magneticHeadingData, 
         const SimTK::Matrix_<SimTK::Vec3>& angularVelocityData) const;
+
+    /** Read the remainder of `stream` into `buffer` and return the offsets of
+     * the lines in `buffer`, up to the first empty line or the end of the
+     * stream. The line endings (including a `'\r'` before a `'\n'`) are
+     * replaced with `'\0'`, so each offset is that of a C string. */
+    static std::vector<size_t> readLines(
+            std::istream& stream, std::string& buffer);
+    /** Split the C string `line` in place into the fields separated by
+     * `delimiter` (terminating each field with `'\0'`), and store the start of
+     * each field in `fields`. */
+    static void splitFields(
+            char* line, char delimiter, std::vector<const char*>& fields);
+    /** Convert the field with index `column` of `fields` (from splitFields())
+     * to a double, like std::stod() but without allocating. Throws if the
+     * line has no such field or the field is not a number. */
+    static double parseField(
+            const std::vector<const char*>& fields, int column);
 };
 
 } // OpenSim namespace
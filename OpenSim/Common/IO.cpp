@@ -64,6 +64,7 @@ int IO::_Pad = 8;
 int IO::_Precision = 8;
 char IO::_DoubleFormat[] = "%16.8lf";
 bool IO::_PrintOfflineDocuments = true;
+int IO::_NumThreadsForWriting = 1;
 
 
 //=============================================================================
@@ -321,6 +322,21 @@ GetPrintOfflineDocuments()
 {
     return _PrintOfflineDocuments;
 }
+
+//=============================================================================
+// Writing data files
+//=============================================================================
+void IO::
+SetNumThreadsForWriting(int numThreads)
+{
+    _NumThreadsForWriting = numThreads;
+}
+
+int IO::
+GetNumThreadsForWriting()
+{
+    return _NumThreadsForWriting;
+}
 //=============================================================================
 // READ
 //=============================================================================
@@ -65,6 +65,8 @@ private:
     static char _DoubleFormat[256];
     /** Whether offline documents should also be printed when Object::print is called. */
     static bool _PrintOfflineDocuments;
+    /** The number of threads that format the rows of data files. */
+    static int _NumThreadsForWriting;
 
 
 //=============================================================================
@@ -92,6 +94,14 @@ public:
     // Object printing
     static void SetPrintOfflineDocuments(bool aTrueFalse);
     static bool GetPrintOfflineDocuments();
+    // Writing data files
+    /** Set the number of threads that format the rows of the data files
+    written by Storage::print() and the delimited file adapters (e.g.,
+    STOFileAdapter), which does not change the contents of the files (see
+    formatRowsInBlocks()). The default is 1; if not positive, the number of
+    hardware threads is used. */
+    static void SetNumThreadsForWriting(int numThreads);
+    static int GetNumThreadsForWriting();
     // READ
 #ifndef SWIG
     static std::string ReadToTokenLine(std::istream &aIS,const std::string &aToken);
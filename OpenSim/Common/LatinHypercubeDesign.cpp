@@ -25,6 +25,7 @@
 
 #include "Assertion.h"
 #include "Exception.h"
+#include <algorithm>
 #include <numeric>
 #include <random>
 
@@ -38,6 +39,194 @@ using namespace OpenSim;
 static const std::vector<std::string> ValidDistanceCriteria =
         {"maximin", "phi_p"};
 
+namespace {
+// The distance criterion of a design, which is updated as elements of a
+// column are exchanged between two rows: such an exchange only changes the
+// distances between these two rows and the others, so evaluating it takes
+// O(numSamples * numVariables) operations instead of
+// O(numSamples^2 * numVariables). For "phi_p", this keeps the sum of the
+// inverse (L1) distances raised to the exponent. For "maximin", this keeps the
+// squared (Euclidean) distance of each row to its nearest neighbor and the
+// index of the neighbor. The design is stored by rows.
+class DesignDistances {
+public:
+    DesignDistances(const SimTK::Matrix& design, bool maximin, int exponent,
+            int numThreads)
+            : m_numRows(design.nrow()), m_numCols(design.ncol()),
+              m_maximin(maximin), m_exponent(exponent),
+              m_numThreads(numThreads),
+              m_x((size_t)m_numRows * m_numCols) {
+        for (int i = 0; i < m_numRows; ++i) {
+            for (int j = 0; j < m_numCols; ++j) {
+                m_x[(size_t)i * m_numCols + j] = design(i, j);
+            }
+        }
+        computeAll();
+    }
+
+    double getScore() const { return calcScore(m_value); }
+
+    // The score of the design if the elements of column 'col' of the rows
+    // 'row1' and 'row2' were exchanged. This may be invoked by multiple
+    // threads at the same time.
+    double calcScoreAfterExchange(int row1, int row2, int col) const {
+        return calcScore(calcValueAfterExchange(row1, row2, col));
+    }
+
+    // Exchange the elements of column 'col' of the rows 'row1' and 'row2'.
+    void exchange(int row1, int row2, int col) {
+        if (row1 == row2) return;
+        const double value = calcValueAfterExchange(row1, row2, col);
+        std::swap(at(row1, col), at(row2, col));
+        if (!m_maximin) {
+            // Removing the terms of the closest pairs from the sum can cancel
+            // most of its digits.
+            if (value < 1e-6 * m_value) {
+                computeAll();
+            } else {
+                m_value = value;
+            }
+            return;
+        }
+        for (int i = 0; i < m_numRows; ++i) {
+            if (i == row1 || i == row2 || m_neighbor[i] == row1 ||
+                    m_neighbor[i] == row2) {
+                computeNearestNeighbor(i);
+            } else {
+                for (int r : {row1, row2}) {
+                    const double d = calcDistance(i, r);
+                    if (d < m_nearest[i]) {
+                        m_nearest[i] = d;
+                        m_neighbor[i] = r;
+                    }
+                }
+            }
+        }
+        m_value = *std::min_element(m_nearest.begin(), m_nearest.end());
+    }
+
+    SimTK::Matrix getDesign() const {
+        SimTK::Matrix design(m_numRows, m_numCols);
+        for (int i = 0; i < m_numRows; ++i) {
+            for (int j = 0; j < m_numCols; ++j) design(i, j) = at(i, j);
+        }
+        return design;
+    }
+
+private:
+    double at(int row, int col) const {
+        return m_x[(size_t)row * m_numCols + col];
+    }
+    double& at(int row, int col) {
+        return m_x[(size_t)row * m_numCols + col];
+    }
+
+    // The L1 distance ("phi_p") or the squared Euclidean distance ("maximin")
+    // between two rows, with the element of column 'col' of row 'i' replaced
+    // by 'value_i' (if 'col' is not negative).
+    double calcDistance(int i, int j, int col = -1, double value_i = 0) const {
+        const double* x_i = &m_x[(size_t)i * m_numCols];
+        const double* x_j = &m_x[(size_t)j * m_numCols];
+        double distance = 0;
+        for (int k = 0; k < m_numCols; ++k) {
+            const double diff = (k == col ? value_i : x_i[k]) - x_j[k];
+            distance += m_maximin ? diff * diff : std::abs(diff);
+        }
+        return distance;
+    }
+    double calcTerm(double distance) const {
+        return std::pow(1.0 / distance, m_exponent);
+    }
+    double calcScore(double value) const {
+        if (m_maximin) return -std::sqrt(value);
+        return std::pow(std::max(value, 0.0), 1.0 / m_exponent);
+    }
+
+    void computeNearestNeighbor(int i) {
+        m_nearest[i] = SimTK::Infinity;
+        m_neighbor[i] = -1;
+        for (int j = 0; j < m_numRows; ++j) {
+            if (j == i) continue;
+            const double d = calcDistance(i, j);
+            if (d < m_nearest[i]) {
+                m_nearest[i] = d;
+                m_neighbor[i] = j;
+            }
+        }
+    }
+
+    // Evaluate the criterion over all pairs of rows, by row on multiple
+    // threads. The sum over the rows is taken in order, so the result does
+    // not depend on the number of threads.
+    void computeAll() {
+        if (m_maximin) {
+            m_nearest.assign(m_numRows, SimTK::Infinity);
+            m_neighbor.assign(m_numRows, -1);
+            parallelForEach(m_numRows, m_numThreads, [&](int, int i) {
+                computeNearestNeighbor(i);
+            });
+            m_value = m_numRows > 1 ? *std::min_element(
+                    m_nearest.begin(), m_nearest.end()) : SimTK::Infinity;
+        } else {
+            std::vector<double> rowSums(m_numRows, 0.0);
+            parallelForEach(m_numRows, m_numThreads, [&](int, int i) {
+                for (int j = i + 1; j < m_numRows; ++j) {
+                    rowSums[i] += calcTerm(calcDistance(i, j));
+                }
+            });
+            m_value = std::accumulate(rowSums.begin(), rowSums.end(), 0.0);
+        }
+    }
+
+    double calcValueAfterExchange(int row1, int row2, int col) const {
+        if (row1 == row2) return m_value;
+        const double value1 = at(row1, col);
+        const double value2 = at(row2, col);
+        if (!m_maximin) {
+            // The distance between 'row1' and 'row2' does not change.
+            double delta = 0;
+            for (int k = 0; k < m_numRows; ++k) {
+                if (k == row1 || k == row2) continue;
+                delta += calcTerm(calcDistance(row1, k, col, value2)) +
+                         calcTerm(calcDistance(row2, k, col, value1)) -
+                         calcTerm(calcDistance(row1, k)) -
+                         calcTerm(calcDistance(row2, k));
+            }
+            return m_value + delta;
+        }
+        // The nearest neighbors of the other rows are still valid unless
+        // they are 'row1' or 'row2'.
+        double value = calcDistance(row1, row2);
+        for (int i = 0; i < m_numRows; ++i) {
+            if (i == row1 || i == row2) continue;
+            value = std::min(value, calcDistance(row1, i, col, value2));
+            value = std::min(value, calcDistance(row2, i, col, value1));
+            if (m_neighbor[i] != row1 && m_neighbor[i] != row2) {
+                value = std::min(value, m_nearest[i]);
+            } else {
+                for (int j = 0; j < m_numRows; ++j) {
+                    if (j == i || j == row1 || j == row2) continue;
+                    value = std::min(value, calcDistance(i, j));
+                }
+            }
+        }
+        return value;
+    }
+
+    int m_numRows;
+    int m_numCols;
+    bool m_maximin;
+    int m_exponent;
+    int m_numThreads;
+    std::vector<double> m_x;
+    // The sum of the terms ("phi_p") or the smallest squared distance
+    // ("maximin").
+    double m_value = 0;
+    std::vector<double> m_nearest;
+    std::vector<int> m_neighbor;
+};
+}
+
 //=============================================================================
 // CONSTRUCTION
 //=============================================================================
@@ -91,6 +280,14 @@ int LatinHypercubeDesign::getPhiPDistanceExponent() const {
     return m_phiDistanceExponent;
 }
 
+void LatinHypercubeDesign::setNumThreads(int numThreads) {
+    m_numThreads = numThreads;
+}
+
+int LatinHypercubeDesign::getNumThreads() const {
+    return m_numThreads;
+}
+
 //=============================================================================
 // LATIN HYPERCUBE DESIGN
 //=============================================================================
@@ -209,38 +406,14 @@ SimTK::Matrix LatinHypercubeDesign::generateStochasticEvolutionaryDesign(
 
 double LatinHypercubeDesign::evaluateDesign(
         const SimTK::Matrix& design) const {
-    if (m_useMaximinDistanceCriterion) {
-        return computeMaximinDistanceCriterion(design);
-    } else {
-        return computePhiDistanceCriterion(design);
-    }
+    return DesignDistances(design, m_useMaximinDistanceCriterion,
+            m_phiDistanceExponent, getNumThreadsOrDefault(m_numThreads))
+            .getScore();
 }
 
 //=============================================================================
 // HELPER FUNCTIONS
 //=============================================================================
-double LatinHypercubeDesign::computeMaximinDistanceCriterion(
-        const SimTK::Matrix& design) {
-   SimTK::Matrix neighbors = computeKNearestNeighbors(design, design, 2);
-   return -SimTK::min(neighbors.col(1));
-}
-
-double LatinHypercubeDesign::computePhiDistanceCriterion(
-        const SimTK::Matrix& design) const {
-    double sumInverseDistancesP = 0;
-    const int numRows = design.nrow();
-    for (int i = 0; i < numRows - 1; ++i) {
-        const SimTK::RowVectorView row_i = design.row(i);
-        for (int j = i + 1; j < numRows; ++j) {
-            const SimTK::RowVectorView row_j = design.row(j);
-            double distance = (row_j - row_i).abs().sum();
-            sumInverseDistancesP += pow(1.0 / distance,
-                    m_phiDistanceExponent);
-        }
-    }
-    return pow(sumInverseDistancesP, 1.0 / m_phiDistanceExponent);
-}
-
 SimTK::Matrix LatinHypercubeDesign::computeTranslationalPropagationDesign(
         SimTK::Matrix seed) const {
 
@@ -417,16 +590,22 @@ SimTK::Matrix LatinHypercubeDesign::computeStochasticEvolutionaryDesign(
 
     // Initialize the algorithm parameters.
     // ------------------------------------
-    // Initialize the design and their initial distance criterion values.
-    SimTK::Matrix designCurrent = initialDesign;
+    // Initialize the design and their initial distance criterion values. The
+    // candidate exchanges of an inner iteration are evaluated in parallel
+    // (for designs large enough to benefit from it), each from the changes
+    // in the distances of its two rows.
+    const int numThreads = numSamples >= 1000 ?
+            getNumThreadsOrDefault(m_numThreads) : 1;
+    DesignDistances designCurrent(initialDesign,
+            m_useMaximinDistanceCriterion, m_phiDistanceExponent, numThreads);
     SimTK::Matrix designBest = initialDesign;
-    double distanceCurrent = evaluateDesign(designCurrent);
+    double distanceCurrent = designCurrent.getScore();
     double distanceBest = distanceCurrent;
     double distanceOldBest;
 
     // Initialize the initial threshold and the warming/cooling schedule
     // parameters.
-    double threshold = 5e-3 * std::abs(evaluateDesign(designCurrent));
+    double threshold = 5e-3 * std::abs(distanceCurrent);
     double alpha1 = 0.8;
     double alpha2 = 0.9;
     double alpha3 = 0.7;
@@ -435,6 +614,9 @@ SimTK::Matrix LatinHypercubeDesign::computeStochasticEvolutionaryDesign(
     // Perform the stochastic evolutionary algorithm.
     // ----------------------------------------------
     SimTK::Matrix randomMatrix(2*numColumnExchanges, numInnerIterations);
+    std::vector<int> rows1(numColumnExchanges);
+    std::vector<int> rows2(numColumnExchanges);
+    std::vector<double> distancesTry(numColumnExchanges);
     int numAccepted, numImproved, inner, outer = 0;
     bool improving;
     double acceptanceRatio, improvementRatio;
@@ -457,44 +639,45 @@ SimTK::Matrix LatinHypercubeDesign::computeStochasticEvolutionaryDesign(
             // Select the column to exchange variables in.
             int col = inner % numVariables;
 
-            // Iterate through random column exchanges.
-            SimTK::Matrix designTry = designCurrent;
-            double distanceTry = distanceCurrent;
-            double temp;
+            // Evaluate the random column exchanges, each applied to the
+            // current design.
             for (int i = 0; i < numColumnExchanges; ++i) {
                 // Select two random rows for the element exchange.
-                int row1 = (int)std::floor(
+                rows1[i] = (int)std::floor(
                         randomMatrix[2*i][inner] * numSamples);
-                int row2 = (int)std::floor(
-                        randomMatrix[2*i-1][inner] * numSamples);
-
-                // Exchange the elements in the current column for each row.
-                temp = designCurrent[row1][col];
-                designCurrent.set(row1, col, designCurrent[row2][col]);
-                designCurrent.set(row2, col, temp);
-
-                // Check if the exchange is an improvement.
-                double newDistance = evaluateDesign(designCurrent);
-                if (newDistance < distanceTry) {
-                    designTry = designCurrent;
-                    distanceTry = newDistance;
+                rows2[i] = (int)std::floor(
+                        randomMatrix[2*i+1][inner] * numSamples);
+            }
+            parallelForEach(numColumnExchanges, numThreads,
+                    [&](int, int i) {
+                        distancesTry[i] = designCurrent.calcScoreAfterExchange(
+                                rows1[i], rows2[i], col);
+                    });
+
+            // Keep the first exchange with the largest improvement.
+            int exchangeTry = -1;
+            double distanceTry = distanceCurrent;
+            for (int i = 0; i < numColumnExchanges; ++i) {
+                if (distancesTry[i] < distanceTry) {
+                    exchangeTry = i;
+                    distanceTry = distancesTry[i];
                 }
-
-                // Undo the element exchange in the current.
-                designCurrent.set(row2, col, designCurrent[row1][col]);
-                designCurrent.set(row1, col, temp);
             }
 
             // Check for acceptance.
             if ((distanceTry - distanceCurrent) <=
                     threshold * random.getValue()) {
-                designCurrent = designTry;
+                if (exchangeTry != -1) {
+                    designCurrent.exchange(rows1[exchangeTry],
+                            rows2[exchangeTry], col);
+                    distanceTry = designCurrent.getScore();
+                }
                 distanceCurrent = distanceTry;
                 ++numAccepted;
 
                 // Check for improvement.
                 if (distanceTry < distanceBest) {
-                    designBest = designCurrent;
+                    designBest = designCurrent.getDesign();
                     distanceBest = distanceTry;
                     ++numImproved;
                 }
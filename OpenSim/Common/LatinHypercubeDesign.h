@@ -122,7 +122,10 @@ namespace OpenSim {
  * method is slower than the other two methods, but generally leads to better
  * designs. This algorithm requires many evaluations of the design score, so
  * it is recommended to use the "phi_p" distance criterion, which approximates
- * "maximin", but is much faster.
+ * "maximin", but is much faster. Each element exchange is evaluated from the
+ * changes in the distances of the two exchanged samples only, i.e., in time
+ * proportional to the number of samples rather than to its square, and the
+ * candidate exchanges are evaluated in parallel (see setNumThreads()).
  *
  * References
  * ----------
@@ -178,6 +181,17 @@ public:
     /// @copydoc setPhiPDistanceExponent()
     int getPhiPDistanceExponent() const;
 
+    /**
+     * The number of threads used to evaluate designs and the candidate
+     * element exchanges of generateStochasticEvolutionaryDesign(). If not
+     * positive (the default), the number of hardware threads is used (see
+     * getNumThreadsOrDefault()). The designs do not depend on the number of
+     * threads.
+     */
+    void setNumThreads(int numThreads);
+    /// @copydoc setNumThreads()
+    int getNumThreads() const;
+
     // LATIN HYPERCUBE DESIGN
     /**
      * Generate a Latin hypercube design based on the best design score from
@@ -238,13 +252,6 @@ private:
     SimTK::Matrix computeTranslationalPropagationDesign(
             SimTK::Matrix seed) const;
 
-    /**
-     * Helper functions for computing the distance between samples in a Latin
-     * hypercube design.
-     */
-    static double computeMaximinDistanceCriterion(const SimTK::Matrix& design);
-    double computePhiDistanceCriterion(const SimTK::Matrix& design) const;
-
     /**
      * Helper functions for computing random Latin hypercube designs.
      */
@@ -280,6 +287,7 @@ private:
     std::string m_distanceCriterion = "maximin";
     bool m_useMaximinDistanceCriterion = true;
     int m_phiDistanceExponent = 50;
+    int m_numThreads = -1;
 };
 
 } // namespace OpenSim
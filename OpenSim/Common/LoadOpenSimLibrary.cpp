@@ -26,6 +26,7 @@
 
 #include "IO.h"
 #include "Logger.h"
+#include "Object.h"
 #include <iostream>
 
 using namespace OpenSim;
@@ -175,6 +176,14 @@ OpenSim::LoadOpenSimLibraryExact(const std::string& exactPath,
     }
 }
 
+OSIMCOMMON_API void
+OpenSim::LoadOpenSimLibraryExactOnDemand(const std::string& exactPath,
+                                         bool verbose) {
+    Object::deferTypeRegistrationUntilUnknownType([exactPath, verbose]() {
+        LoadOpenSimLibraryExact(exactPath, verbose);
+    });
+}
+
 //_____________________________________________________________________________
 /**
  * A function for loading libraries specified in a command line.
@@ -90,6 +90,16 @@ OSIMCOMMON_API void LoadOpenSimLibrary(const std::string &aLibraryName);
  * @returns true if the library was successfully loaded; false otherwise. */
 OSIMCOMMON_API bool LoadOpenSimLibraryExact(const std::string &exactPath,
                                             bool verbose = true);
+/** Load an OpenSim plugin library with LoadOpenSimLibraryExact(), but only
+ * once it is needed: the library is loaded the first time a type that is not
+ * registered is looked up (e.g., when reading a model file that contains a
+ * type from the plugin), or all the registered types are listed (see
+ * Object::deferTypeRegistrationUntilUnknownType()). This avoids the cost of
+ * loading plugins that a program may not use. Unlike with
+ * LoadOpenSimLibraryExact(), a library that cannot be loaded is only reported
+ * (if verbose) when it is needed. */
+OSIMCOMMON_API void LoadOpenSimLibraryExactOnDemand(
+        const std::string& exactPath, bool verbose = true);
 /** Used to process legacy command line arguments that specify plugin libraries
  * to load. Internally uses LoadOpenSimLibrary(const std::string&, bool) with
  * verbosity. */
@@ -26,8 +26,12 @@
 #include "IO.h"
 #include "LogSink.h"
 
+#include "spdlog/async.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
 
+#include <algorithm>
+#include <functional>
+
 using namespace OpenSim;
 
 static void initializeLogger(spdlog::logger& l, const char* pattern) {
@@ -104,13 +108,77 @@ spdlog::logger& Logger::getDefaultLogger() {
     return *defaultLogger;
 }
 
+// the thread that writes the messages in the asynchronous mode, and its queue;
+// null if the messages are written synchronously
+static std::shared_ptr<spdlog::details::thread_pool> asyncThreadPool = nullptr;
+static spdlog::async_overflow_policy asyncOverflowPolicy =
+        spdlog::async_overflow_policy::block;
+
+// write the queued messages at exit, before the loggers and their sinks are
+// destroyed
+static struct AsyncLoggingFinalizer {
+    ~AsyncLoggingFinalizer() { Logger::disableAsync(); }
+} asyncLoggingFinalizer;
+
+// a logger with the same name, sinks, and levels as `l` that writes the
+// messages as the current mode requires (see Logger::enableAsync())
+static std::shared_ptr<spdlog::logger> copyLogger(spdlog::logger& l) {
+    std::shared_ptr<spdlog::logger> copy;
+    if (asyncThreadPool) {
+        copy = std::make_shared<spdlog::async_logger>(l.name(),
+                l.sinks().begin(), l.sinks().end(), asyncThreadPool,
+                asyncOverflowPolicy);
+    } else {
+        copy = std::make_shared<spdlog::logger>(
+                l.name(), l.sinks().begin(), l.sinks().end());
+    }
+    copy->set_level(l.level());
+    copy->flush_on(l.flush_level());
+    return copy;
+}
+
+// replace the loggers with copies (see copyLogger()) whose sinks are edited
+// by `editSinks`. In the asynchronous mode, the background thread may be
+// writing messages to the sinks of the current loggers, so those are not
+// modified; the queued messages keep the current loggers alive. The sinks
+// keep their formatters, so the patterns need not be set again.
+static void replaceLoggers(
+        const std::function<void(std::vector<spdlog::sink_ptr>&)>& editSinks) {
+    auto newCoutLogger = copyLogger(*coutLogger);
+    auto newDefaultLogger = copyLogger(*defaultLogger);
+    if (editSinks) {
+        editSinks(newCoutLogger->sinks());
+        editSinks(newDefaultLogger->sinks());
+    }
+    coutLogger = newCoutLogger;
+    defaultLogger = newDefaultLogger;
+    // spdlog::set_level() and spdlog::flush_on() apply to the registered
+    // loggers.
+    spdlog::drop(coutLogger->name());
+    spdlog::register_logger(coutLogger);
+    spdlog::set_default_logger(defaultLogger);
+}
+
 static void addSinkInternal(std::shared_ptr<spdlog::sinks::sink> sink) {
+    if (asyncThreadPool) {
+        replaceLoggers([&](std::vector<spdlog::sink_ptr>& sinks) {
+            sinks.push_back(sink);
+        });
+        return;
+    }
     coutLogger->sinks().push_back(sink);
     defaultLogger->sinks().push_back(sink);
 }
 
 static void removeSinkInternal(const std::shared_ptr<spdlog::sinks::sink> sink)
 {
+    if (asyncThreadPool) {
+        replaceLoggers([&](std::vector<spdlog::sink_ptr>& sinks) {
+            sinks.erase(std::remove(sinks.begin(), sinks.end(), sink),
+                    sinks.end());
+        });
+        return;
+    }
     {
         auto& sinks = defaultLogger->sinks();
         auto new_end = std::remove(sinks.begin(), sinks.end(), sink);
@@ -273,4 +341,37 @@ void Logger::removeSink(const std::shared_ptr<LogSink> sink) {
     removeSinkInternal(std::static_pointer_cast<spdlog::sinks::sink>(sink));
 }
 
+void Logger::enableAsync(std::size_t queueSize, OverflowPolicy overflowPolicy) {
+    OPENSIM_THROW_IF(queueSize == 0, Exception,
+            "Expected the queue size to be positive.");
+    // The file sink is added to the loggers before they are copied.
+    initFileLoggingAsNeeded();
+    // Write the messages queued by the current thread pool, if any.
+    disableAsync();
+    asyncThreadPool =
+            std::make_shared<spdlog::details::thread_pool>(queueSize, 1);
+    asyncOverflowPolicy =
+            overflowPolicy == OverflowPolicy::Block
+                    ? spdlog::async_overflow_policy::block
+                    : spdlog::async_overflow_policy::overrun_oldest;
+    replaceLoggers(nullptr);
+}
 
+void Logger::disableAsync() {
+    if (!asyncThreadPool) return;
+    auto threadPool = std::move(asyncThreadPool);
+    asyncThreadPool = nullptr;
+    replaceLoggers(nullptr);
+    // The destructor of the thread pool writes the queued messages and joins
+    // its thread.
+    threadPool.reset();
+}
+
+bool Logger::isAsync() {
+    return asyncThreadPool != nullptr;
+}
+
+void Logger::flush() {
+    coutLogger->flush();
+    defaultLogger->flush();
+}
@@ -23,6 +23,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "osimCommonDLL.h"
+#include <cstddef>
 #include <set>
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/basic_file_sink.h>
@@ -182,6 +183,47 @@ public:
     /// @note This function is not thread-safe. Do not invoke this function
     /// concurrently, or concurrently with addLogFile() or addSink().
     static void removeSink(const std::shared_ptr<LogSink> sink);
+
+    /// What to do with a message when the queue of the asynchronous mode
+    /// (enableAsync()) is full.
+    enum class OverflowPolicy {
+        /// Wait until the background thread makes room in the queue; no
+        /// messages are lost.
+        Block,
+        /// Discard the oldest message in the queue to make room for the new
+        /// one, so that logging never waits for the sinks.
+        DiscardOldest
+    };
+
+    /// Write the messages to the sinks (the console, the log file, and
+    /// those added with addSink()) on a background thread, so that the
+    /// threads that log do not wait for the sinks (e.g., for a log file on a
+    /// network file system). The messages are queued, at most `queueSize` of
+    /// them, and are written in the order in which they were logged; see
+    /// OverflowPolicy for what happens when the queue is full. If the
+    /// asynchronous mode is already enabled, the queue is replaced (after
+    /// writing the queued messages).
+    /// Messages may appear on the console after the output written directly
+    /// to std::cout; call flush() or disableAsync() where that matters.
+    /// @note This function is not thread-safe. Do not invoke this function
+    /// concurrently with logging or with the functions that add or remove
+    /// sinks.
+    static void enableAsync(std::size_t queueSize = 8192,
+            OverflowPolicy overflowPolicy = OverflowPolicy::Block);
+
+    /// Write the queued messages and then write the messages on the thread
+    /// that logs them (the default). If the asynchronous mode is not enabled,
+    /// this does nothing.
+    /// @note This function is not thread-safe; see enableAsync().
+    static void disableAsync();
+
+    /// Whether the messages are written on a background thread (see
+    /// enableAsync()).
+    static bool isAsync();
+
+    /// Flush the sinks. In the asynchronous mode, the flush is queued after
+    /// the messages logged so far, and this function does not wait for it.
+    static void flush();
 private:
     static spdlog::logger& getCoutLogger();
     static spdlog::logger& getDefaultLogger();
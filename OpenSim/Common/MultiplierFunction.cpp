@@ -24,7 +24,8 @@
 
 // C++ INCLUDES
 #include "MultiplierFunction.h"
-#include "FunctionAdapter.h"
+
+#include <memory>
 
 using namespace OpenSim;
 using namespace std;
@@ -34,6 +35,33 @@ using SimTK::Vector;
 //=============================================================================
 // STATICS
 //=============================================================================
+namespace {
+/// The SimTK::Function of a MultiplierFunction: the SimTK::Function of the
+/// multiplied function, scaled. Evaluating it does not go through the
+/// OpenSim::Function interface (see FunctionAdapter), so that, e.g., a scaled
+/// SimmSpline of a CustomJoint is evaluated directly.
+class ScaledFunction : public SimTK::Function {
+public:
+    ScaledFunction(SimTK::Function* function, double scale) :
+            _function(function), _scale(scale) {}
+    double calcValue(const Vector& x) const override {
+        return _function->calcValue(x) * _scale;
+    }
+    double calcDerivative(const SimTK::Array_<int>& derivComponents,
+            const Vector& x) const override {
+        return _function->calcDerivative(derivComponents, x) * _scale;
+    }
+    int getArgumentSize() const override {
+        return _function->getArgumentSize();
+    }
+    int getMaxDerivativeOrder() const override {
+        return _function->getMaxDerivativeOrder();
+    }
+private:
+    std::unique_ptr<SimTK::Function> _function;
+    double _scale;
+};
+} // anonymous namespace
 
 
 //=============================================================================
@@ -203,7 +231,9 @@ int MultiplierFunction::getMaxDerivativeOrder() const
 }
 
 SimTK::Function* MultiplierFunction::createSimTKFunction() const {
-    return new FunctionAdapter(*this);
+    if (!_osFunction)
+        throw Exception("MultiplierFunction::createSimTKFunction(): _osFunction is NULL.");
+    return new ScaledFunction(_osFunction->createSimTKFunction(), _scale);
 }
 
 void MultiplierFunction::init(Function* aFunction)
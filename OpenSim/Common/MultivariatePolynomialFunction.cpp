@@ -20,8 +20,63 @@
 
 #include "Exception.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
 using namespace OpenSim;
 
+namespace {
+/// Invoke `func(coeff_nr, nq, powers)` for each term of a polynomial of the
+/// given dimension and order, in the order of the coefficients (see the class
+/// documentation). `nq` holds the exponents of the term and
+/// `powers[i * (order + 1) + p]` is x[i]^p. The powers are tabulated once, so
+/// that each term costs only a few multiplications instead of a std::pow()
+/// per input. With dimension 0 there are order + 1 (constant) terms, to match
+/// the number of coefficients expected by SimTKMultivariatePolynomial.
+template <class T, class F>
+void forEachTerm(int dimension, int order, const SimTK::Vector& x, F func) {
+    const int nd = std::max(dimension, 1);
+    const int np = order + 1;
+    std::array<T, 6 * 8> stackPowers;
+    std::vector<T> heapPowers;
+    T* powers = stackPowers.data();
+    if (nd * np > (int)stackPowers.size()) {
+        heapPowers.resize(nd * np);
+        powers = heapPowers.data();
+    }
+    // std::pow() gives the same rounding as evaluating each term directly.
+    for (int i = 0; i < nd; ++i) {
+        T* row = powers + i * np;
+        for (int p = 0; p < np; ++p) {
+            row[p] = i < dimension ? std::pow(x[i], p) : static_cast<T>(1);
+        }
+    }
+
+    // Visit the exponents like an odometer whose last digit turns fastest,
+    // with the sum of the digits never exceeding the order.
+    std::array<int, 6> nq{{0, 0, 0, 0, 0, 0}};
+    int sum = 0;
+    int coeff_nr = 0;
+    while (true) {
+        func(coeff_nr, nq, static_cast<const T*>(powers));
+        ++coeff_nr;
+        int i = nd - 1;
+        for (; i >= 0; --i) {
+            if (sum < order) {
+                ++nq[i];
+                ++sum;
+                break;
+            }
+            sum -= nq[i];
+            nq[i] = 0;
+        }
+        if (i < 0) break;
+    }
+}
+} // anonymous namespace
+
 template <class T>
 class SimTKMultivariatePolynomial : public SimTK::Function_<T> {
 public:
@@ -75,153 +130,66 @@ public:
                 coefficients.size());
     }
     T calcValue(const SimTK::Vector& x) const override {
-        std::array<int, 6> nq{{0, 0, 0, 0, 0, 0}};
+        const int np = order + 1;
         T value = static_cast<T>(0);
-        int coeff_nr = 0;
-        for (nq[0] = 0; nq[0] < order + 1; ++nq[0]) {
-            int nq2_s;
-            if (dimension < 2)
-                nq2_s = 0;
-            else
-                nq2_s = order - nq[0];
-            for (nq[1] = 0; nq[1] < nq2_s + 1; ++nq[1]) {
-                int nq3_s;
-                if (dimension < 3)
-                    nq3_s = 0;
-                else
-                    nq3_s = order - nq[0] - nq[1];
-                for (nq[2] = 0; nq[2] < nq3_s + 1; ++nq[2]) {
-                    int nq4_s;
-                    if (dimension < 4)
-                        nq4_s = 0;
-                    else
-                        nq4_s = order - nq[0] - nq[1] - nq[2];
-                    for (nq[3] = 0; nq[3] < nq4_s + 1; ++nq[3]) {
-                        int nq5_s;
-                        if (dimension < 5)
-                            nq5_s = 0;
-                        else
-                            nq5_s = order - nq[0] - nq[1] - nq[2] - nq[3];
-                        for (nq[4] = 0; nq[4] < nq5_s + 1; ++nq[4]) {
-                            int nq6_s;
-                            if (dimension < 6)
-                                nq6_s = 0;
-                            else
-                                nq6_s = order - nq[0] - nq[1] - nq[2] - nq[3] - nq[4];
-                            for (nq[5] = 0; nq[5] < nq6_s + 1; ++nq[5]) {
-                                T valueP = static_cast<T>(1);
-                                for (int i = 0; i < dimension; ++i) {
-                                    valueP *= std::pow(x[i], nq[i]);
-                                }
-                                value += valueP * coefficients[coeff_nr];
-                                ++coeff_nr;
-                            }
-                        }
+        forEachTerm<T>(dimension, order, x,
+                [&](int coeff_nr, const std::array<int, 6>& nq,
+                        const T* powers) {
+                    T valueP = static_cast<T>(1);
+                    for (int i = 0; i < dimension; ++i) {
+                        valueP *= powers[i * np + nq[i]];
                     }
-                }
-            }
-        }
+                    value += valueP * coefficients[coeff_nr];
+                });
         return value;
     }
     T calcDerivative(const SimTK::Array_<int>& derivComponent,
             const SimTK::Vector& x) const override {
-        std::array<int, 6> nq{{0, 0, 0, 0, 0, 0}};
+        const int j = derivComponent[0];
+        if (j < 0 || j >= dimension) return static_cast<T>(0);
+        const int np = order + 1;
         T value = static_cast<T>(0);
-        int nqNonNegative;
-        int coeff_nr = 0;
-        for (nq[0] = 0; nq[0] < order + 1; ++nq[0]) {
-            int nq2_s;
-            if (dimension < 2)
-                nq2_s = 0;
-            else
-                nq2_s = order - nq[0];
-            for (nq[1] = 0; nq[1] < nq2_s + 1; ++nq[1]) {
-                int nq3_s;
-                if (dimension < 3)
-                    nq3_s = 0;
-                else
-                    nq3_s = order - nq[0] - nq[1];
-                for (nq[2] = 0; nq[2] < nq3_s + 1; ++nq[2]) {
-                    int nq4_s;
-                    if (dimension < 4)
-                        nq4_s = 0;
-                    else
-                        nq4_s = order - nq[0] - nq[1] - nq[2];
-                    for (nq[3] = 0; nq[3] < nq4_s + 1; ++nq[3]) {
-                        int nq5_s;
-                        if (dimension < 5)
-                            nq5_s = 0;
-                        else
-                            nq5_s = order - nq[0] - nq[1] - nq[2] - nq[3];
-                        for (nq[4] = 0; nq[4] < nq5_s + 1; ++nq[4]) {
-                            int nq6_s;
-                            if (dimension < 6)
-                                nq6_s = 0;
-                            else
-                                nq6_s = order - nq[0] - nq[1] - nq[2] - nq[3] - nq[4];
-                            for (nq[5] = 0; nq[5] < nq6_s + 1; ++nq[5]) {
-                                if (derivComponent[0] == 0) {
-                                    nqNonNegative = nq[0] - 1;
-                                    if (nqNonNegative < 0) nqNonNegative = 0;
-                                    T valueP = nq[0] * std::pow(x[0], nqNonNegative);
-                                    for (int i = 0; i < dimension; ++i) {
-                                        if (i == derivComponent[0]) continue;
-                                        valueP *= std::pow(x[i], nq[i]);
-                                    }
-                                    value += valueP * coefficients[coeff_nr];
-                                } else if (derivComponent[0] == 1) {
-                                    nqNonNegative = nq[1] - 1;
-                                    if (nqNonNegative < 0) nqNonNegative = 0;
-                                    T valueP = nq[1] * std::pow(x[1], nqNonNegative);
-                                    for (int i = 0; i < dimension; ++i) {
-                                        if (i == derivComponent[0]) continue;
-                                        valueP *= std::pow(x[i], nq[i]);
-                                    }
-                                    value += valueP * coefficients[coeff_nr];
-                                } else if (derivComponent[0] == 2) {
-                                    nqNonNegative = nq[2] - 1;
-                                    if (nqNonNegative < 0) nqNonNegative = 0;
-                                    T valueP = nq[2] * std::pow(x[2], nqNonNegative);
-                                    for (int i = 0; i < dimension; ++i) {
-                                        if (i == derivComponent[0]) continue;
-                                        valueP *= std::pow(x[i], nq[i]);
-                                    }
-                                    value += valueP * coefficients[coeff_nr];
-                                } else if (derivComponent[0] == 3) {
-                                    nqNonNegative = nq[3] - 1;
-                                    if (nqNonNegative < 0) nqNonNegative = 0;
-                                    T valueP = nq[3] * std::pow(x[3], nqNonNegative);
-                                    for (int i = 0; i < dimension; ++i) {
-                                        if (i == derivComponent[0]) continue;
-                                        valueP *= std::pow(x[i], nq[i]);
-                                    }
-                                    value += valueP * coefficients[coeff_nr];
-                                } else if (derivComponent[0] == 4) {
-                                    nqNonNegative = nq[4] - 1;
-                                    if (nqNonNegative < 0) nqNonNegative = 0;
-                                    T valueP = nq[4] * std::pow(x[4], nqNonNegative);
-                                    for (int i = 0; i < dimension; ++i) {
-                                        if (i == derivComponent[0]) continue;
-                                        valueP *= std::pow(x[i], nq[i]);
-                                    }
-                                    value += valueP * coefficients[coeff_nr];
-                                } else if (derivComponent[0] == 5) {
-                                    nqNonNegative = nq[5] - 1;
-                                    if (nqNonNegative < 0) nqNonNegative = 0;
-                                    T valueP = nq[5] * std::pow(x[5], nqNonNegative);
-                                    for (int i = 0; i < dimension; ++i) {
-                                        if (i == derivComponent[0]) continue;
-                                        valueP *= std::pow(x[i], nq[i]);
-                                    }
-                                    value += valueP * coefficients[coeff_nr];
-                                }
-                                ++coeff_nr;
-                            }
-                        }
+        forEachTerm<T>(dimension, order, x,
+                [&](int coeff_nr, const std::array<int, 6>& nq,
+                        const T* powers) {
+                    if (nq[j] == 0) return;
+                    T valueP = nq[j] * powers[j * np + nq[j] - 1];
+                    for (int i = 0; i < dimension; ++i) {
+                        if (i == j) continue;
+                        valueP *= powers[i * np + nq[i]];
                     }
-                }
-            }
-        }
+                    value += valueP * coefficients[coeff_nr];
+                });
+        return value;
+    }
+    /// Compute the value and all first partial derivatives in one pass over
+    /// the terms; `gradient` must have `dimension` elements.
+    T calcValueAndGradient(const SimTK::Vector& x, T* gradient) const {
+        const int np = order + 1;
+        T value = static_cast<T>(0);
+        std::fill(gradient, gradient + dimension, static_cast<T>(0));
+        forEachTerm<T>(dimension, order, x,
+                [&](int coeff_nr, const std::array<int, 6>& nq,
+                        const T* powers) {
+                    const T c = coefficients[coeff_nr];
+                    // Products of the factors before and after each input.
+                    std::array<T, 7> prefix;
+                    std::array<T, 7> suffix;
+                    prefix[0] = static_cast<T>(1);
+                    suffix[dimension] = static_cast<T>(1);
+                    for (int i = 0; i < dimension; ++i) {
+                        prefix[i + 1] = prefix[i] * powers[i * np + nq[i]];
+                    }
+                    for (int i = dimension - 1; i >= 0; --i) {
+                        suffix[i] = suffix[i + 1] * powers[i * np + nq[i]];
+                    }
+                    value += prefix[dimension] * c;
+                    for (int i = 0; i < dimension; ++i) {
+                        if (nq[i] == 0) continue;
+                        gradient[i] += c * nq[i] * powers[i * np + nq[i] - 1] *
+                                       prefix[i] * suffix[i + 1];
+                    }
+                });
         return value;
     }
     int getArgumentSize() const override { return dimension; }
@@ -240,6 +208,68 @@ private:
     int order;
 };
 
+double MultivariatePolynomialFunction::calcValueAndGradient(
+        const SimTK::Vector& x, SimTK::Vector& gradient) const {
+    const auto& polynomial =
+            static_cast<const SimTKMultivariatePolynomial<SimTK::Real>&>(
+                    getSimTKFunction());
+    gradient.resize(getDimension());
+    return polynomial.calcValueAndGradient(
+            x, gradient.size() ? &gradient[0] : nullptr);
+}
+
+SimTK::Vector MultivariatePolynomialFunction::getTermValues(
+        const SimTK::Vector& x) const {
+    const int dimension = getDimension();
+    const int order = getOrder();
+    OPENSIM_THROW_IF_FRMOBJ(dimension < 0 || dimension > 6, Exception,
+            "Expected dimension >= 0 && <=6 but got {}.", dimension);
+    OPENSIM_THROW_IF_FRMOBJ(order < 0, Exception,
+            "Expected order >= 0 but got {}.", order);
+    OPENSIM_THROW_IF_FRMOBJ(x.size() < dimension, Exception,
+            "Expected at least {} inputs but got {}.", dimension, x.size());
+    const int np = order + 1;
+    std::vector<double> terms;
+    forEachTerm<double>(dimension, order, x,
+            [&](int, const std::array<int, 6>& nq, const double* powers) {
+                double valueP = 1;
+                for (int i = 0; i < dimension; ++i) {
+                    valueP *= powers[i * np + nq[i]];
+                }
+                terms.push_back(valueP);
+            });
+    return SimTK::Vector((int)terms.size(), terms.data());
+}
+
+SimTK::Vector MultivariatePolynomialFunction::getTermDerivatives(
+        int derivComponent, const SimTK::Vector& x) const {
+    const int dimension = getDimension();
+    const int order = getOrder();
+    OPENSIM_THROW_IF_FRMOBJ(dimension < 0 || dimension > 6, Exception,
+            "Expected dimension >= 0 && <=6 but got {}.", dimension);
+    OPENSIM_THROW_IF_FRMOBJ(order < 0, Exception,
+            "Expected order >= 0 but got {}.", order);
+    OPENSIM_THROW_IF_FRMOBJ(x.size() < dimension, Exception,
+            "Expected at least {} inputs but got {}.", dimension, x.size());
+    const int j = derivComponent;
+    const int np = order + 1;
+    std::vector<double> terms;
+    forEachTerm<double>(dimension, order, x,
+            [&](int, const std::array<int, 6>& nq, const double* powers) {
+                if (j < 0 || j >= dimension || nq[j] == 0) {
+                    terms.push_back(0);
+                    return;
+                }
+                double valueP = nq[j] * powers[j * np + nq[j] - 1];
+                for (int i = 0; i < dimension; ++i) {
+                    if (i == j) continue;
+                    valueP *= powers[i * np + nq[i]];
+                }
+                terms.push_back(valueP);
+            });
+    return SimTK::Vector((int)terms.size(), terms.data());
+}
+
 SimTK::Function* MultivariatePolynomialFunction::createSimTKFunction() const {
     return new SimTKMultivariatePolynomial<SimTK::Real>(
             get_coefficients(), get_dimension(), getOrder());
@@ -98,6 +98,27 @@ public:
     /// Return function
     SimTK::Function* createSimTKFunction() const override;
 
+    /// Compute the value of the polynomial and its first partial derivatives
+    /// with respect to each input (the gradient, resized to getDimension())
+    /// in a single pass over the terms. This is cheaper than calling
+    /// calcValue() and then calcDerivative() for each input, since the powers
+    /// of the inputs are computed only once.
+    double calcValueAndGradient(
+            const SimTK::Vector& x, SimTK::Vector& gradient) const;
+
+    /// Compute the value of each term of the polynomial (i.e., each monomial
+    /// without its coefficient) at `x`, in the order of the coefficients.
+    /// Since the polynomial is linear in its coefficients, this is the row of
+    /// the design matrix for fitting the coefficients to data at `x`; the
+    /// coefficients property does not need to be set.
+    SimTK::Vector getTermValues(const SimTK::Vector& x) const;
+
+    /// Compute the first partial derivative of each term of the polynomial
+    /// with respect to input `derivComponent` at `x`, in the order of the
+    /// coefficients (see getTermValues()).
+    SimTK::Vector getTermDerivatives(
+            int derivComponent, const SimTK::Vector& x) const;
+
 private:
     void constructProperties() {
         constructProperty_coefficients(SimTK::Vector(0));
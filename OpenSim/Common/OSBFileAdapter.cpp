@@ -0,0 +1,403 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  OSBFileAdapter.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "OSBFileAdapter.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace OpenSim {
+
+namespace {
+
+const char signature[8] = {'O', 'S', 'B', 'T', 'A', 'B', 'L', 'E'};
+const std::uint32_t byteOrderMark = 0x01020304;
+const std::uint32_t formatVersion = 1;
+
+struct OSBHeader {
+    std::string dataType;
+    std::uint64_t numComponents{};
+    std::uint64_t numRows{};
+    std::uint64_t numColumns{};
+    std::vector<std::pair<std::string, std::string>> metadata;
+    std::vector<std::string> labels;
+};
+
+template <typename U>
+void writePod(std::ostream& out, const U& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(U));
+}
+
+void writeString(std::ostream& out, const std::string& str) {
+    writePod<std::uint64_t>(out, str.size());
+    out.write(str.data(), str.size());
+}
+
+void readBytes(std::istream& in, const std::string& fileName, char* dest,
+        std::size_t numBytes) {
+    in.read(dest, numBytes);
+    OPENSIM_THROW_IF(!in, IOError,
+            "Unexpected end of file or read error in '" + fileName + "'.");
+}
+
+template <typename U>
+U readPod(std::istream& in, const std::string& fileName) {
+    U value;
+    readBytes(in, fileName, reinterpret_cast<char*>(&value), sizeof(U));
+    return value;
+}
+
+std::string readString(std::istream& in, const std::string& fileName) {
+    const auto size = readPod<std::uint64_t>(in, fileName);
+    std::string str(static_cast<std::size_t>(size), '\0');
+    if (size) readBytes(in, fileName, &str[0], str.size());
+    return str;
+}
+
+void readDoubles(std::istream& in, const std::string& fileName,
+        std::vector<double>& data, std::size_t count) {
+    data.resize(count);
+    if (count) {
+        readBytes(in, fileName, reinterpret_cast<char*>(data.data()),
+                count * sizeof(double));
+    }
+}
+
+/// Open the file and read everything up to (but excluding) the independent
+/// column.
+OSBHeader readHeader(std::ifstream& in, const std::string& fileName) {
+    OPENSIM_THROW_IF(fileName.empty(), EmptyFileName);
+    in.open(fileName, std::ios::binary);
+    OPENSIM_THROW_IF(!in.good(), FileDoesNotExist, fileName);
+    OPENSIM_THROW_IF(in.peek() == std::ifstream::traits_type::eof(),
+            FileIsEmpty, fileName);
+
+    char fileSignature[sizeof(signature)];
+    readBytes(in, fileName, fileSignature, sizeof(signature));
+    OPENSIM_THROW_IF(
+            std::memcmp(fileSignature, signature, sizeof(signature)) != 0,
+            IOError, "File '" + fileName + "' is not an OSB file.");
+    OPENSIM_THROW_IF(readPod<std::uint32_t>(in, fileName) != byteOrderMark,
+            IOError,
+            "File '" + fileName + "' was written on a machine with a "
+            "different byte order, which is not supported.");
+    const auto version = readPod<std::uint32_t>(in, fileName);
+    OPENSIM_THROW_IF(version > formatVersion, IOError,
+            "File '" + fileName + "' has OSB format version " +
+            std::to_string(version) + ", but only versions up to " +
+            std::to_string(formatVersion) + " are supported.");
+
+    OSBHeader header;
+    header.dataType = readString(in, fileName);
+    header.numComponents = readPod<std::uint64_t>(in, fileName);
+    header.numRows = readPod<std::uint64_t>(in, fileName);
+    header.numColumns = readPod<std::uint64_t>(in, fileName);
+    const auto numMetadata = readPod<std::uint64_t>(in, fileName);
+    for (std::uint64_t i = 0; i < numMetadata; ++i) {
+        std::string key = readString(in, fileName);
+        std::string value = readString(in, fileName);
+        header.metadata.emplace_back(std::move(key), std::move(value));
+    }
+    header.labels.reserve(static_cast<std::size_t>(header.numColumns));
+    for (std::uint64_t i = 0; i < header.numColumns; ++i) {
+        header.labels.push_back(readString(in, fileName));
+    }
+    return header;
+}
+
+template <typename T>
+bool writeTable(const AbstractDataTable* absTable,
+        const std::string& fileName) {
+    const auto* table = dynamic_cast<const TimeSeriesTable_<T>*>(absTable);
+    if (!table) return false;
+
+    std::ofstream out(fileName, std::ios::binary);
+    OPENSIM_THROW_IF(!out.good(), IOError,
+            "Could not open file '" + fileName + "' for writing.");
+
+    constexpr std::size_t ncomp = sizeof(T) / sizeof(double);
+    const int nrow = static_cast<int>(table->getNumRows());
+    const int ncol = static_cast<int>(table->getNumColumns());
+
+    out.write(signature, sizeof(signature));
+    writePod(out, byteOrderMark);
+    writePod(out, formatVersion);
+    writeString(out, DelimFileAdapter<T>::dataTypeName());
+    writePod<std::uint64_t>(out, ncomp);
+    writePod<std::uint64_t>(out, nrow);
+    writePod<std::uint64_t>(out, ncol);
+
+    // As with STO files, only metadata with string values is written.
+    std::vector<std::pair<std::string, std::string>> metadata;
+    for (const auto& key : table->getTableMetaDataKeys()) {
+        try {
+            metadata.emplace_back(
+                    key, table->template getTableMetaData<std::string>(key));
+        } catch (const InvalidTemplateArgument&) {}
+    }
+    writePod<std::uint64_t>(out, metadata.size());
+    for (const auto& keyValue : metadata) {
+        writeString(out, keyValue.first);
+        writeString(out, keyValue.second);
+    }
+    for (const auto& label : table->getColumnLabels()) {
+        writeString(out, label);
+    }
+
+    const auto& time = table->getIndependentColumn();
+    out.write(reinterpret_cast<const char*>(time.data()),
+            time.size() * sizeof(double));
+
+    // Each column is one contiguous block.
+    const auto& matrix = table->getMatrix();
+    std::vector<double> buffer(nrow * ncomp);
+    for (int icol = 0; icol < ncol; ++icol) {
+        for (int irow = 0; irow < nrow; ++irow) {
+            std::memcpy(&buffer[irow * ncomp], &matrix(irow, icol),
+                    sizeof(T));
+        }
+        out.write(reinterpret_cast<const char*>(buffer.data()),
+                buffer.size() * sizeof(double));
+    }
+    OPENSIM_THROW_IF(!out.good(), IOError,
+            "Error writing to file '" + fileName + "'.");
+    return true;
+}
+
+template <typename T>
+std::shared_ptr<AbstractDataTable> readTable(std::ifstream& in,
+        const OSBHeader& header, const std::string& fileName) {
+    constexpr std::size_t ncomp = sizeof(T) / sizeof(double);
+    OPENSIM_THROW_IF(header.numComponents != ncomp, IOError,
+            "File '" + fileName + "' has " +
+            std::to_string(header.numComponents) +
+            " components per element, but data type '" + header.dataType +
+            "' has " + std::to_string(ncomp) + ".");
+    const int nrow = static_cast<int>(header.numRows);
+    const int ncol = static_cast<int>(header.numColumns);
+
+    std::vector<double> time;
+    readDoubles(in, fileName, time, nrow);
+
+    SimTK::Matrix_<T> matrix(nrow, ncol);
+    std::vector<double> buffer;
+    for (int icol = 0; icol < ncol; ++icol) {
+        readDoubles(in, fileName, buffer, nrow * ncomp);
+        for (int irow = 0; irow < nrow; ++irow) {
+            std::memcpy(&matrix.updElt(irow, icol), &buffer[irow * ncomp],
+                    sizeof(T));
+        }
+    }
+
+    auto table = std::make_shared<TimeSeriesTable_<T>>(
+            time, matrix, header.labels);
+    for (const auto& keyValue : header.metadata) {
+        table->updTableMetaData().setValueForKey(
+                keyValue.first, keyValue.second);
+    }
+    return table;
+}
+
+} // anonymous namespace
+
+OSBFileAdapter*
+OSBFileAdapter::clone() const {
+    return new OSBFileAdapter{*this};
+}
+
+const std::string
+OSBFileAdapter::tableString() {
+    return "table";
+}
+
+OSBFileAdapter::OutputTables
+OSBFileAdapter::extendRead(const std::string& fileName) const {
+    std::ifstream in;
+    const auto header = readHeader(in, fileName);
+
+    using namespace SimTK;
+    const auto& type = header.dataType;
+    std::shared_ptr<AbstractDataTable> table;
+    if (type == "double")
+        table = readTable<double>(in, header, fileName);
+    else if (type == "Vec2")
+        table = readTable<Vec2>(in, header, fileName);
+    else if (type == "Vec3")
+        table = readTable<Vec3>(in, header, fileName);
+    else if (type == "Vec4")
+        table = readTable<Vec4>(in, header, fileName);
+    else if (type == "Vec5")
+        table = readTable<Vec5>(in, header, fileName);
+    else if (type == "Vec6")
+        table = readTable<Vec6>(in, header, fileName);
+    else if (type == "Vec7")
+        table = readTable<Vec7>(in, header, fileName);
+    else if (type == "Vec8")
+        table = readTable<Vec8>(in, header, fileName);
+    else if (type == "Vec9")
+        table = readTable<Vec9>(in, header, fileName);
+    else if (type == "Vec10")
+        table = readTable<Vec<10>>(in, header, fileName);
+    else if (type == "Vec11")
+        table = readTable<Vec<11>>(in, header, fileName);
+    else if (type == "Vec12")
+        table = readTable<Vec<12>>(in, header, fileName);
+    else if (type == "UnitVec3")
+        table = readTable<UnitVec3>(in, header, fileName);
+    else if (type == "Quaternion")
+        table = readTable<Quaternion>(in, header, fileName);
+    else if (type == "SpatialVec")
+        table = readTable<SpatialVec>(in, header, fileName);
+    else
+        OPENSIM_THROW(OSBDataTypeNotSupported, type);
+
+    OutputTables output_tables{};
+    output_tables.emplace(tableString(), table);
+    return output_tables;
+}
+
+void
+OSBFileAdapter::extendWrite(const InputTables& absTables,
+                            const std::string& fileName) const {
+    OPENSIM_THROW_IF(absTables.empty(), NoTableFound);
+    OPENSIM_THROW_IF(fileName.empty(), EmptyFileName);
+
+    const AbstractDataTable* absTable{};
+    try {
+        absTable = absTables.at(tableString());
+    } catch(std::out_of_range&) {
+        OPENSIM_THROW(KeyMissing, tableString());
+    }
+
+    using namespace SimTK;
+    if (writeTable<UnitVec3>(absTable, fileName)) return;
+    if (writeTable<Quaternion>(absTable, fileName)) return;
+    if (writeTable<SpatialVec>(absTable, fileName)) return;
+    if (writeTable<double>(absTable, fileName)) return;
+    if (writeTable<Vec2>(absTable, fileName)) return;
+    if (writeTable<Vec3>(absTable, fileName)) return;
+    if (writeTable<Vec4>(absTable, fileName)) return;
+    if (writeTable<Vec5>(absTable, fileName)) return;
+    if (writeTable<Vec6>(absTable, fileName)) return;
+    if (writeTable<Vec7>(absTable, fileName)) return;
+    if (writeTable<Vec8>(absTable, fileName)) return;
+    if (writeTable<Vec9>(absTable, fileName)) return;
+    if (writeTable<Vec<10>>(absTable, fileName)) return;
+    if (writeTable<Vec<11>>(absTable, fileName)) return;
+    if (writeTable<Vec<12>>(absTable, fileName)) return;
+
+    OPENSIM_THROW(IncorrectTableType,
+            "OSBFileAdapter can only write TimeSeriesTable_'s.");
+}
+
+std::vector<double>
+OSBFileAdapter::readIndependentColumn(const std::string& fileName) {
+    std::ifstream in;
+    const auto header = readHeader(in, fileName);
+    std::vector<double> time;
+    readDoubles(in, fileName, time, header.numRows);
+    return time;
+}
+
+std::vector<std::string>
+OSBFileAdapter::readColumnLabels(const std::string& fileName) {
+    std::ifstream in;
+    return readHeader(in, fileName).labels;
+}
+
+TimeSeriesTable
+OSBFileAdapter::readColumns(const std::string& fileName,
+                            const std::vector<std::string>& columnLabels,
+                            double initialTime,
+                            double finalTime) {
+    std::ifstream in;
+    const auto header = readHeader(in, fileName);
+    OPENSIM_THROW_IF(header.dataType != "double" || header.numComponents != 1,
+            IncorrectTableType,
+            "Requested data type 'double' but file '" + fileName +
+            "' contains data type '" + header.dataType + "'.");
+
+    std::vector<double> time;
+    readDoubles(in, fileName, time, header.numRows);
+    const std::streamoff dataStart = static_cast<std::streamoff>(in.tellg());
+
+    const auto begin = std::lower_bound(time.begin(), time.end(),
+            initialTime) - time.begin();
+    const auto end = std::max(std::upper_bound(time.begin(), time.end(),
+            finalTime) - time.begin(), begin);
+    const int nrow = static_cast<int>(end - begin);
+
+    const auto& labels = columnLabels.empty() ? header.labels : columnLabels;
+    SimTK::Matrix matrix(nrow, static_cast<int>(labels.size()));
+    std::vector<double> buffer;
+    for (int j = 0; j < static_cast<int>(labels.size()); ++j) {
+        const auto it = std::find(header.labels.begin(), header.labels.end(),
+                labels[j]);
+        OPENSIM_THROW_IF(it == header.labels.end(), KeyNotFound, labels[j]);
+        const auto icol =
+                static_cast<std::uint64_t>(it - header.labels.begin());
+        // Read only the rows in the time window of this column.
+        in.seekg(dataStart + static_cast<std::streamoff>(
+                (icol * header.numRows + begin) * sizeof(double)));
+        readDoubles(in, fileName, buffer, nrow);
+        for (int i = 0; i < nrow; ++i) matrix(i, j) = buffer[i];
+    }
+
+    TimeSeriesTable table(std::vector<double>(time.begin() + begin,
+            time.begin() + end), matrix, labels);
+    for (const auto& keyValue : header.metadata) {
+        table.updTableMetaData().setValueForKey(
+                keyValue.first, keyValue.second);
+    }
+    return table;
+}
+
+void
+OSBFileAdapter::readColumnData(const std::string& fileName,
+                               const std::string& columnLabel,
+                               const std::string& dataTypeName,
+                               int numComponents,
+                               std::vector<double>& data) {
+    std::ifstream in;
+    const auto header = readHeader(in, fileName);
+    OPENSIM_THROW_IF(header.dataType != dataTypeName ||
+                     header.numComponents != (std::uint64_t)numComponents,
+            IncorrectTableType,
+            "Requested data type '" + dataTypeName + "' but file '" +
+            fileName + "' contains data type '" + header.dataType + "'.");
+
+    const auto it = std::find(header.labels.begin(), header.labels.end(),
+            columnLabel);
+    OPENSIM_THROW_IF(it == header.labels.end(), KeyNotFound, columnLabel);
+    const auto icol = static_cast<std::uint64_t>(it - header.labels.begin());
+
+    // Skip the independent column and the preceding dependent columns.
+    const std::uint64_t columnSize = header.numRows * numComponents;
+    in.seekg(static_cast<std::streamoff>(
+            (header.numRows + icol * columnSize) * sizeof(double)),
+            std::ios::cur);
+    readDoubles(in, fileName, data, static_cast<std::size_t>(columnSize));
+}
+
+} // namespace OpenSim
@@ -0,0 +1,157 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  OSBFileAdapter.h                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#ifndef OPENSIM_OSB_FILE_ADAPTER_H_
+#define OPENSIM_OSB_FILE_ADAPTER_H_
+
+#include "DelimFileAdapter.h"
+
+#include <cstring>
+
+namespace OpenSim {
+
+class OSBDataTypeNotSupported : public Exception {
+public:
+    OSBDataTypeNotSupported(const std::string& file,
+                            size_t line,
+                            const std::string& func,
+                            const std::string& datatype) :
+        Exception(file, line, func) {
+        std::string msg = "Datatype '" + datatype + "' is not supported.";
+
+        addMessage(msg);
+    }
+};
+
+/** OSBFileAdapter is a FileAdapter that reads and writes TimeSeriesTable_'s in
+a binary, column-major format (extension ".osb"). Writing and reading such
+files involves no text formatting or parsing, so it is much faster than using
+STO files for passing data between stages of a pipeline, and the files are
+smaller. Furthermore, since each column is stored as a contiguous block, a
+single column can be read from a large file without reading the others (see
+readDependentColumn()).
+
+The file contains, in order:
+- an 8-byte signature ("OSBTABLE"), a 4-byte byte-order mark and a 4-byte
+  format version number;
+- the name of the data type (e.g., "double" or "Vec3", as in STO files), the
+  number of doubles per element, and the number of rows and columns;
+- the table metadata (only string values are written) and column labels;
+- the independent (time) column, followed by each dependent column.
+
+All numbers are stored with the byte order of the machine that wrote the file;
+reading a file written on a machine with a different byte order is not
+supported. The supported data types are the same as for STOFileAdapter.
+Typically, you do not need to use this class directly:
+\code{.cpp}
+STOFileAdapter::write(table, "states.sto");     // Text.
+OSBFileAdapter::write(table, "states.osb");     // Binary.
+TimeSeriesTable fromFile("states.osb");
+\endcode                                                                      */
+class OSIMCOMMON_API OSBFileAdapter : public FileAdapter {
+public:
+    OSBFileAdapter()                                 = default;
+    OSBFileAdapter(const OSBFileAdapter&)            = default;
+    OSBFileAdapter(OSBFileAdapter&&)                 = default;
+    OSBFileAdapter& operator=(const OSBFileAdapter&) = default;
+    OSBFileAdapter& operator=(OSBFileAdapter&&)      = default;
+    ~OSBFileAdapter()                                = default;
+
+    OSBFileAdapter* clone() const override;
+
+    /** Write a TimeSeriesTable_ to a binary file.                            */
+    template<typename T>
+    static void write(const TimeSeriesTable_<T>& table,
+                      const std::string& fileName) {
+        InputTables tables{};
+        tables.emplace(tableString(), &table);
+        OSBFileAdapter{}.extendWrite(tables, fileName);
+    }
+
+    /** Read only the independent (time) column from a binary file.          */
+    static std::vector<double> readIndependentColumn(
+            const std::string& fileName);
+
+    /** Read only the labels of the dependent columns of a binary file.      */
+    static std::vector<std::string> readColumnLabels(
+            const std::string& fileName);
+
+    /** Read the dependent columns with the given labels (in that order; all
+    the columns if `columnLabels` is empty) for the rows whose times are in
+    [initialTime, finalTime], along with the table metadata, without reading
+    the other columns and rows. The file must contain data type double, and
+    its times must be increasing.
+
+    \throws IncorrectTableType If the file does not contain doubles.
+    \throws KeyNotFound If the file has no column with one of the labels.    */
+    static TimeSeriesTable readColumns(const std::string& fileName,
+            const std::vector<std::string>& columnLabels,
+            double initialTime = -SimTK::Infinity,
+            double finalTime = SimTK::Infinity);
+
+    /** Read only the dependent column with the given label from a binary
+    file, without reading the other columns. The template argument must match
+    the data type of the file.
+
+    \throws IncorrectTableType If T does not match the file's data type.
+    \throws KeyNotFound If the file has no column with the given label.      */
+    template<typename T>
+    static SimTK::Vector_<T> readDependentColumn(const std::string& fileName,
+            const std::string& columnLabel) {
+        std::vector<double> data;
+        readColumnData(fileName, columnLabel,
+                DelimFileAdapter<T>::dataTypeName(),
+                static_cast<int>(sizeof(T) / sizeof(double)), data);
+        const int nrow = static_cast<int>(data.size() * sizeof(double) /
+                                          sizeof(T));
+        SimTK::Vector_<T> column(nrow);
+        for (int i = 0; i < nrow; ++i) {
+            std::memcpy(&column[i], data.data() + i * sizeof(T) /
+                    sizeof(double), sizeof(T));
+        }
+        return column;
+    }
+
+    /** Key used for table associative array returned/accepted by write/read. */
+    static const std::string tableString();
+
+protected:
+    /** Implementation of the read functionality.                             */
+    OutputTables extendRead(const std::string& fileName) const override;
+
+    /** Implementation of the write functionality.                            */
+    void extendWrite(const InputTables& tables,
+                     const std::string& fileName) const override;
+
+private:
+    /** Read the data of a single dependent column (as numComponents doubles
+    per row) into `data`.                                                     */
+    static void readColumnData(const std::string& fileName,
+                               const std::string& columnLabel,
+                               const std::string& dataTypeName,
+                               int numComponents,
+                               std::vector<double>& data);
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_OSB_FILE_ADAPTER_H_
@@ -39,7 +39,13 @@
 #include "PropertyTransform.h"
 #include "Property_Deprecated.h"
 #include "XMLDocument.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <fstream>
+#include <mutex>
+#include <set>
+#include <vector>
 
 using namespace OpenSim;
 using namespace std;
@@ -50,12 +56,40 @@ using SimTK::Transform;
 // STATICS
 //=============================================================================
 ArrayPtrs<Object>           Object::_registeredTypes;
-std::map<string,Object*>    Object::_mapTypesToDefaultObjects;
-std::map<string,string>     Object::_renamedTypesMap;
+std::unordered_map<string,Object*>  Object::_mapTypesToDefaultObjects;
+std::unordered_map<string,string>   Object::_renamedTypesMap;
 
 bool                        Object::_serializeAllDefaults=false;
 const string                Object::DEFAULT_NAME(ObjectDEFAULT_NAME);
 
+namespace {
+    // Incremented whenever the name of an Object changes; see
+    // Object::getNumNameChanges().
+    std::atomic<long long> numNameChanges{0};
+
+    // The registrations deferred with Object::deferTypeRegistration() and
+    // Object::deferTypeRegistrationUntilUnknownType(). This is constructed on
+    // first use since libraries defer their registrations from their static
+    // initializers.
+    struct DeferredTypeRegistrations {
+        // Held while invoking the registrations. It is recursive because the
+        // registrations register types themselves.
+        std::recursive_mutex mutex;
+        // True until the registrations have been invoked, so that the
+        // registered types can be used without locking afterwards.
+        std::atomic<bool> pending{false};
+        std::vector<void (*)()> registrations;
+        // All the registrations ever deferred, to defer each only once.
+        std::set<void (*)()> deferred;
+        std::atomic<bool> pendingUntilUnknownType{false};
+        std::vector<std::function<void()>> registrationsUntilUnknownType;
+    };
+    DeferredTypeRegistrations& getDeferredTypeRegistrations() {
+        static DeferredTypeRegistrations registrations;
+        return registrations;
+    }
+}
+
 //=============================================================================
 // CONSTRUCTOR(S)
 //=============================================================================
@@ -186,7 +220,10 @@ Object::Object(SimTK::Xml::Element& aNode)
 Object& Object::operator=(const Object& source)
 {
     if (&source != this) {
-        _name           = source._name;
+        if (_name != source._name) {
+            _name = source._name;
+            ++numNameChanges;
+        }
         _description    = source._description;
         _authors        = source._authors;
         _references     = source._references;
@@ -212,7 +249,10 @@ void Object::setNull()
     _propertyTable.clear();
     _objectIsUpToDate = false;
 
-    _name = "";
+    if (!_name.empty()) {
+        _name = "";
+        ++numNameChanges;
+    }
     _description = "";
     _authors = "";
     _references = "";
@@ -304,7 +344,9 @@ operator<(const Object& other) const
 void Object::
 setName(const string &aName)
 {
+    if (_name == aName) return;
     _name = aName;
+    ++numNameChanges;
 }
 //_____________________________________________________________________________
 /**
@@ -315,6 +357,15 @@ getName() const
 {
     return(_name);
 }
+//_____________________________________________________________________________
+/**
+ * Get the number of times the name of any Object has been changed.
+ */
+long long Object::
+getNumNameChanges()
+{
+    return numNameChanges.load(std::memory_order_acquire);
+}
 
 //_____________________________________________________________________________
 /**
@@ -498,6 +549,9 @@ updPropertyByName(const std::string& name) {
 /*static*/ void Object::
 registerType(const Object& aObject)
 {
+    // A type registered directly replaces the default of a deferred one.
+    registerDeferredTypes();
+
     // GET TYPE
     const string& type = aObject.getConcreteClassName();
     if(type.empty()) {
@@ -507,18 +561,23 @@ registerType(const Object& aObject)
     log_debug("Object.registerType: {}.", type);
 
     // REPLACE IF A MATCHING TYPE IS ALREADY REGISTERED
-    for(int i=0; i <_registeredTypes.size(); ++i) {
-        Object *object = _registeredTypes.get(i);
-        if(object->getConcreteClassName() == type) {
-            log_debug("Object.registerType: replacing registered object of "
-                      "type {} with a new default object of the same type.",
-                      type);
-            Object* defaultObj = aObject.clone();
-            defaultObj->setName(DEFAULT_NAME);
-            _registeredTypes.set(i,defaultObj);
-            _mapTypesToDefaultObjects[type]= defaultObj;
-            return;
-        } 
+    // The map is checked first so that registering all the types of a library
+    // does not search the array of registered types for each of them.
+    const auto registered = _mapTypesToDefaultObjects.find(type);
+    if (registered != _mapTypesToDefaultObjects.end()) {
+        for(int i=0; i <_registeredTypes.size(); ++i) {
+            if(_registeredTypes.get(i) == registered->second) {
+                log_debug("Object.registerType: replacing registered object "
+                          "of type {} with a new default object of the same "
+                          "type.",
+                          type);
+                Object* defaultObj = aObject.clone();
+                defaultObj->setName(DEFAULT_NAME);
+                _registeredTypes.set(i,defaultObj);
+                registered->second = defaultObj;
+                return;
+            }
+        }
     }
 
     // REGISTERING FOR THE FIRST TIME -- APPEND
@@ -534,10 +593,10 @@ renameType(const std::string& oldTypeName, const std::string& newTypeName)
     if(oldTypeName == newTypeName)
         return; 
 
-    std::map<std::string,Object*>::const_iterator p = 
-        _mapTypesToDefaultObjects.find(newTypeName);
+    registerDeferredTypes();
 
-    if (p == _mapTypesToDefaultObjects.end())
+    if (_mapTypesToDefaultObjects.find(newTypeName) ==
+            _mapTypesToDefaultObjects.end())
         throw OpenSim::Exception(
             "Object::renameType(): illegal attempt to rename object type "
             + oldTypeName + " to " + newTypeName + " which is unregistered.",
@@ -546,8 +605,73 @@ renameType(const std::string& oldTypeName, const std::string& newTypeName)
     _renamedTypesMap[oldTypeName] = newTypeName;
 }
 
+/*static*/ void Object::
+deferTypeRegistration(void (*registerTypes)())
+{
+    auto& deferred = getDeferredTypeRegistrations();
+    std::lock_guard<std::recursive_mutex> lock(deferred.mutex);
+    if (!deferred.deferred.insert(registerTypes).second) return;
+    deferred.registrations.push_back(registerTypes);
+    deferred.pending = true;
+}
+
+/*static*/ void Object::
+deferTypeRegistrationUntilUnknownType(std::function<void()> registerTypes)
+{
+    auto& deferred = getDeferredTypeRegistrations();
+    std::lock_guard<std::recursive_mutex> lock(deferred.mutex);
+    deferred.registrationsUntilUnknownType.push_back(std::move(registerTypes));
+    deferred.pendingUntilUnknownType = true;
+}
+
+/*static*/ void Object::
+registerDeferredTypes()
+{
+    auto& deferred = getDeferredTypeRegistrations();
+    if (!deferred.pending) return;
+    std::lock_guard<std::recursive_mutex> lock(deferred.mutex);
+    // When invoked by one of the registrations below (e.g., from
+    // registerType()), the registrations have already been taken.
+    if (deferred.registrations.empty()) return;
+
+    const auto start = std::chrono::steady_clock::now();
+    int numRegistrations = 0;
+    while (!deferred.registrations.empty()) {
+        std::vector<void (*)()> registrations;
+        registrations.swap(deferred.registrations);
+        for (auto* registerTypes : registrations) registerTypes();
+        numRegistrations += (int)registrations.size();
+    }
+    deferred.pending = false;
+    log_debug("Object: registered the types of {} libraries in {} ms.",
+            numRegistrations,
+            std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - start).count());
+}
+
+/*static*/ bool Object::
+registerTypesOfUnknownTypes()
+{
+    auto& deferred = getDeferredTypeRegistrations();
+    if (!deferred.pendingUntilUnknownType) return false;
+    std::lock_guard<std::recursive_mutex> lock(deferred.mutex);
+    if (deferred.registrationsUntilUnknownType.empty()) return false;
+
+    while (!deferred.registrationsUntilUnknownType.empty()) {
+        std::vector<std::function<void()>> registrations;
+        registrations.swap(deferred.registrationsUntilUnknownType);
+        for (const auto& registerTypes : registrations) registerTypes();
+    }
+    deferred.pendingUntilUnknownType = false;
+    // The registrations (e.g., loading a library) may defer more.
+    registerDeferredTypes();
+    return true;
+}
+
 /*static*/ const Object* Object::
 getDefaultInstanceOfType(const std::string& objectTypeTag) {
+    registerDeferredTypes();
+
     std::string actualName = objectTypeTag;
     bool wasRenamed = false; // for a better error message
 
@@ -557,8 +681,7 @@ getDefaultInstanceOfType(const std::string& objectTypeTag) {
     const int MaxRenames = (int)_renamedTypesMap.size();
     int renameCount = 0;
     while(true) {
-        std::map<std::string,std::string>::const_iterator newNamep =
-            _renamedTypesMap.find(actualName);
+        const auto newNamep = _renamedTypesMap.find(actualName);
         if (newNamep == _renamedTypesMap.end())
             break; // actualName has not been renamed
 
@@ -573,11 +696,14 @@ getDefaultInstanceOfType(const std::string& objectTypeTag) {
     }
 
     // Look up the "actualName" default object and return it.
-    std::map<std::string,Object*>::const_iterator p = 
-        _mapTypesToDefaultObjects.find(actualName);
+    const auto p = _mapTypesToDefaultObjects.find(actualName);
     if (p != _mapTypesToDefaultObjects.end())
         return p->second;
 
+    // The type may be registered by a deferred registration (e.g., a plugin).
+    if (registerTypesOfUnknownTypes())
+        return getDefaultInstanceOfType(objectTypeTag);
+
     // The requested object was not registered. That's OK normally but is
     // a bug if we went through the rename table since you are only allowed
     // to rename things to registered objects.
@@ -623,10 +749,17 @@ newInstanceOfType(const std::string& objectTypeTag)
 /*static*/ void Object::
 getRegisteredTypenames(Array<std::string>& rTypeNames)
 {
-    std::map<string,Object*>::const_iterator p = 
-        _mapTypesToDefaultObjects.begin();
-    for (; p != _mapTypesToDefaultObjects.end(); ++p)
-        rTypeNames.append(p->first);
+    registerDeferredTypes();
+    registerTypesOfUnknownTypes();
+
+    // The names are sorted, as they were when the map was ordered.
+    std::vector<std::string> typeNames;
+    typeNames.reserve(_mapTypesToDefaultObjects.size());
+    for (const auto& entry : _mapTypesToDefaultObjects)
+        typeNames.push_back(entry.first);
+    std::sort(typeNames.begin(), typeNames.end());
+    for (const auto& typeName : typeNames)
+        rTypeNames.append(typeName);
     // Renamed type names don't appear in the registeredTypes map, unless
     // they were separately registered.
 }
@@ -792,10 +925,28 @@ try {
     // UPDATE DEFAULT OBJECTS
     updateDefaultObjectsFromXMLNode(); // May need to pass in aNode
 
+    // FIND THE PROPERTY ELEMENTS
+    // In a single pass over the child elements, look up each tag in the
+    // property table, rather than searching the child elements for the name
+    // of each property. As before, the first element with a property's name
+    // is the element of the property.
+    const int numProperties = _propertyTable.getNumProperties();
+    std::vector<SimTK::Xml::Element> propElements(numProperties);
+    for (SimTK::Xml::element_iterator iter = aNode.element_begin();
+            iter != aNode.element_end(); ++iter) {
+        const int ix = _propertyTable.findPropertyIndex(iter->getElementTag());
+        if (ix < 0 || propElements[ix].isValid()) continue;
+        // Unnamed properties are named after their object type, but their
+        // elements are found by type (and name attribute).
+        if (_propertyTable.getAbstractPropertyByIndex(ix).isUnnamedProperty())
+            continue;
+        propElements[ix] = *iter;
+    }
+
     // LOOP THROUGH PROPERTIES
-    for(int i=0; i < _propertyTable.getNumProperties(); ++i) {
+    for(int i=0; i < numProperties; ++i) {
         AbstractProperty& prop = _propertyTable.updAbstractPropertyByIndex(i);
-        prop.readFromXMLParentElement(aNode, versionNumber);
+        prop.readFromXMLParentElement(aNode, propElements[i], versionNumber);
     }
 
     // LOOP THROUGH DEPRECATED PROPERTIES
@@ -1413,6 +1564,8 @@ PrintPropertyInfo(ostream &aOStream,
 
     if(aClassName=="") {
         // NO CLASS
+        registerDeferredTypes();
+        registerTypesOfUnknownTypes();
         int size = _registeredTypes.getSize();
         ss<<"REGISTERED CLASSES ("<<size<<")\n";
         Object *obj;
@@ -1609,6 +1762,7 @@ makeObjectFromFile(const std::string &aFileName)
             SimTK::Xml::Element e = doc->getRootElement();
             newObject->updateFromXMLNode(e, 10500);
         }
+        doc->updateCache(*newObject);
 
         return newObject;
     } catch(const std::exception& x) {
@@ -1669,6 +1823,7 @@ void Object::updateFromXMLDocument()
     SimTK::Xml::Element e = _document->getRootDataElement();
     IO::CwdChanger cwd = IO::CwdChanger::changeToParentOf(_document->getFileName());
     updateFromXMLNode(e, _document->getDocumentVersion());
+    _document->updateCache(*this);
 }
 
 std::string Object::dump() const {
@@ -1749,7 +1904,7 @@ osimCommonInstantiator::osimCommonInstantiator()
 extern "C" OSIMCOMMON_API void RegisterTypes_osimCommon(); 
 void osimCommonInstantiator::registerDllClasses() 
 { 
-        RegisterTypes_osimCommon(); 
+        Object::deferTypeRegistration(RegisterTypes_osimCommon); 
 } 
     
 static osimCommonInstantiator instantiator; 
@@ -42,6 +42,8 @@
 #include "Property.h"
 
 #include <cstring>
+#include <functional>
+#include <unordered_map>
 
 // DISABLES MULTIPLE INSTANTIATION WARNINGS
 
@@ -163,9 +165,12 @@ An %Object type needs to be "registered" by calling Object::registerType() with
 an instance of a concrete object so that the serialization infrastructure knows 
 what kind of %Object to create when it encounters a specific XML tag. This 
 associates the concrete object's class name (object type tag) with a default 
-instance of that object. The registration process is normally done during 
+instance of that object. The registration process is normally requested during 
 dynamic library (DLL) loading, that is, as part of the static initializer
-execution that occurs before program execution.
+execution that occurs before program execution. The %OpenSim libraries defer
+their registration (see deferTypeRegistration()) until a type is first looked
+up, so that programs that never read objects from XML do not pay for
+constructing the default instances of all the types.
 
 For backwards compatibility, we support a renaming mechanism in which 
 now-deprecated class names can be mapped to their current equivalents. This
@@ -418,6 +423,25 @@ public:
     static void renameType(const std::string& oldTypeName, 
                            const std::string& newTypeName);
 
+    /** Defer the registration of the types of a library: \a registerTypes
+    (e.g., RegisterTypes_osimSimulation()) is invoked just before the types are
+    first used, that is, before the first lookup of a type by name, the first
+    listing of the registered types, or the first direct call to
+    registerType() or renameType(). Deferred registrations are invoked in the
+    order in which they were deferred. Deferring a function that was already
+    deferred (or already invoked as a deferred registration) does nothing.
+    This is normally called as part of the static initialization of a dynamic
+    library, instead of registering the types right away. **/
+    static void deferTypeRegistration(void (*registerTypes)());
+
+    /** Defer the registration of types that are only needed if a type is
+    looked up that is not registered: \a registerTypes (e.g., a function that
+    loads a plugin library; see LoadOpenSimLibraryExactOnDemand()) is invoked
+    the first time a type that is not registered is looked up, or when all the
+    registered types are listed. It is then invoked only once. **/
+    static void deferTypeRegistrationUntilUnknownType(
+            std::function<void()> registerTypes);
+
     /** Return a pointer to the default instance of the registered (concrete)
     %Object whose class name is given, or NULL if the type is not registered.
     Note that this refers to the default %Object instance that is stored with
@@ -470,6 +494,8 @@ public:
     all Joints, Constraints, ModelComponents, Analyses, etc. **/
     template<class T> static void 
     getRegisteredObjectsOfGivenType(ArrayPtrs<T>& rArray) {
+        registerDeferredTypes();
+        registerTypesOfUnknownTypes();
         rArray.setSize(0);
         rArray.setMemoryOwner(false);
         for(int i=0; i<_registeredTypes.getSize(); i++) {
@@ -491,7 +517,8 @@ public:
     node of the XML file passed in. This is useful since the constructor of 
     %Object doesn't have the proper type info. This works by using the defaults 
     table so that %Object does not need to know about its derived classes. It 
-    uses the defaults table to get an instance. **/
+    uses the defaults table to get an instance. To avoid parsing files that
+    are read repeatedly, see XMLDocument::setCacheDirectory(). **/
     static Object* makeObjectFromFile(const std::string& fileName);
 
     /** We're given an XML element from which we are to populate this %Object.
@@ -823,6 +850,12 @@ protected:
     void checkPropertyValueIsInRangeOrSet(const Property<T>& p,
             const T& lower, const T& upper, const std::set<T>& set) const;
 
+    /** The number of times the name of any Object in this process has been
+    changed (by setName(), assignment, or deserialization). Containers that
+    index their Objects by name (e.g., Set) compare this count to the one at
+    which they built their index to detect that the index may be stale. **/
+    static long long getNumNameChanges();
+
     //--------------------------------------------------------------------------
 // PRIVATE METHODS
 //--------------------------------------------------------------------------
@@ -867,7 +900,9 @@ private:
     // type kept in the above array of registered types. Renamed types are *not* 
     // normally entered here; the names are mapped separately using the map 
     // below.
-    static std::map<std::string,Object*>        _mapTypesToDefaultObjects;
+    // This is a hash map since it is searched for every Object that is read
+    // from XML.
+    static std::unordered_map<std::string,Object*> _mapTypesToDefaultObjects;
 
     // Map types that have been renamed to their new names, which can
     // then be used to find them in the default object map. This lets us 
@@ -876,7 +911,16 @@ private:
     // to map one registered type to a different one programmatically, because
     // we'll look up the name in the rename table first prior to searching
     // the registered types list.
-    static std::map<std::string,std::string>    _renamedTypesMap;
+    static std::unordered_map<std::string,std::string> _renamedTypesMap;
+
+    // Invoke the registrations deferred with deferTypeRegistration() that
+    // have not been invoked yet. This is called by all the methods that use
+    // the tables above.
+    static void registerDeferredTypes();
+    // Invoke the registrations deferred with
+    // deferTypeRegistrationUntilUnknownType() that have not been invoked yet.
+    // Returns true if any were invoked.
+    static bool registerTypesOfUnknownTypes();
 
     // Global flag to indicate if all registered objects are to be written in 
     // a "defaults" section.
@@ -1402,9 +1446,9 @@ ObjectProperty<T>::readFromXMLElement
         if (objectsFound > this->getMaxListSize())
             continue; // ignore this one
 
-        // Create an Object of the element tag's type.
-        Object* object = Object::newInstanceOfType(objTypeTag);
-        OPENSIM_ASSERT(object); // we just checked above
+        // Create an Object of the element tag's type (the equivalent of
+        // newInstanceOfType(), without looking up the type again).
+        Object* object = registeredObj->clone();
         object->readObjectFromXMLNodeOrFile(*iter, versionNumber);
 
         T* objectT = dynamic_cast<T*>(object);
@@ -31,6 +31,7 @@
 //=============================================================================
 #include <stdio.h>
 #include "OptimizationTarget.h"
+#include "CommonUtilities.h"
 
 //=============================================================================
 // EXPORTED STATIC CONSTANTS
@@ -309,3 +310,125 @@ ForwardDifferences(const OptimizationTarget *aTarget,
 
     return(status);
 }
+
+//=============================================================================
+// PARALLEL STATIC DERIVATIVES
+//=============================================================================
+namespace {
+// Evaluate 'perturb(target, i, status)' for each parameter i on one thread
+// per target, and return the status of the first parameter whose evaluation
+// failed, or the status of the last parameter.
+int evaluatePerturbations(
+        const std::vector<const OptimizationTarget*>& targets, int nx,
+        const std::function<void(const OptimizationTarget&, int, int&)>&
+                perturb)
+{
+    for (const auto* target : targets) if (!target) return -1;
+    std::vector<int> statuses(nx, -1);
+    parallelForEach(nx, (int)targets.size(), [&](int thread, int i) {
+        perturb(*targets[thread], i, statuses[i]);
+    });
+    for (int i = 0; i < nx; ++i) if (statuses[i] < 0) return statuses[i];
+    return statuses[nx - 1];
+}
+}
+
+//_____________________________________________________________________________
+/**
+ * Compute derivatives of the constraints with respect to the controls by
+ * central differences, with the perturbations distributed over the targets.
+ */
+int OptimizationTarget::
+CentralDifferencesConstraint(
+    const std::vector<const OptimizationTarget*>& targets,
+    double *dx,const Vector &x,Matrix &jacobian)
+{
+    if(targets.empty() || !targets[0]) return(-1);
+    int nx = targets[0]->getNumParameters(); if(nx<=0) return(-1);
+    int nc = targets[0]->getNumConstraints(); if(nc<=0) return(-1);
+
+    return evaluatePerturbations(targets, nx,
+            [&](const OptimizationTarget& target, int i, int& status) {
+        Vector xp=x;
+        Vector cf(nc),cb(nc);
+
+        // PERTURB FORWARD
+        xp[i] = x[i] + dx[i];
+        status = target.constraintFunc(xp,true,cf);
+        if(status<0) return;
+
+        // PERTURB BACKWARD
+        xp[i] = x[i] - dx[i];
+        status = target.constraintFunc(xp,true,cb);
+        if(status<0) return;
+
+        // DERIVATIVES OF CONSTRAINTS
+        double rdx = 0.5 / dx[i];
+        for(int j=0;j<nc;j++) jacobian(j,i) = rdx*(cf[j]-cb[j]);
+    });
+}
+//_____________________________________________________________________________
+/**
+ * Compute derivatives of performance with respect to the controls by central
+ * differences, with the perturbations distributed over the targets.
+ */
+int OptimizationTarget::
+CentralDifferences(
+    const std::vector<const OptimizationTarget*>& targets,
+    double *dx,const Vector &x,Vector &dpdx)
+{
+    if(targets.empty() || !targets[0]) return(-1);
+    int nx = targets[0]->getNumParameters();  if(nx<=0) return(-1);
+
+    return evaluatePerturbations(targets, nx,
+            [&](const OptimizationTarget& target, int i, int& status) {
+        Vector xp=x;
+        double pf,pb;
+
+        // PERTURB FORWARD
+        xp[i] = x[i] + dx[i];
+        status = target.objectiveFunc(xp,true,pf);
+        if(status<0) return;
+
+        // PERTURB BACKWARD
+        xp[i] = x[i] - dx[i];
+        status = target.objectiveFunc(xp,true,pb);
+        if(status<0) return;
+
+        // DERIVATIVES OF PERFORMANCE
+        double rdx = 0.5 / dx[i];
+        dpdx[i] = rdx*(pf-pb);
+    });
+}
+//_____________________________________________________________________________
+/**
+ * Compute derivatives of performance with respect to the controls by forward
+ * differences, with the perturbations distributed over the targets.
+ */
+int OptimizationTarget::
+ForwardDifferences(
+    const std::vector<const OptimizationTarget*>& targets,
+    double *dx,const Vector &x,Vector &dpdx)
+{
+    if(targets.empty() || !targets[0]) return(-1);
+    int nx = targets[0]->getNumParameters();  if(nx<=0) return(-1);
+
+    // current objective function value
+    double pb;
+    int baseStatus = targets[0]->objectiveFunc(x,true,pb);
+    if(baseStatus<0) return(baseStatus);
+
+    return evaluatePerturbations(targets, nx,
+            [&](const OptimizationTarget& target, int i, int& status) {
+        Vector xp=x;
+        double pf;
+
+        // PERTURB FORWARD
+        xp[i] = x[i] + dx[i];
+        status = target.objectiveFunc(xp,true,pf);
+        if(status<0) return;
+
+        // DERIVATIVES OF PERFORMANCE
+        dpdx[i] = (pf-pb)/dx[i];
+    });
+}
@@ -35,6 +35,8 @@
 #include "Array.h"
 #include <simmath/Optimizer.h>
 
+#include <vector>
+
 
 namespace OpenSim { 
 
@@ -88,6 +90,27 @@ public:
         ForwardDifferences(const OptimizationTarget *aTarget,
         double *dx,const SimTK::Vector &x,SimTK::Vector &dpdx);
 
+    /** Parallel versions of the finite differences above: the perturbations
+    of the parameters are evaluated on one thread per target, each thread
+    with its own target. The targets must describe the same problem and must
+    not share any state that their evaluation changes (e.g., each has its own
+    copy of the model and of the state), so that they can be evaluated at the
+    same time. The results are the same as with one target. If an evaluation
+    fails, the status of the failed evaluation of the first parameter is
+    returned, but the other parameters are still evaluated. */
+    static int
+        CentralDifferencesConstraint(
+        const std::vector<const OptimizationTarget*>& targets,
+        double *dx,const SimTK::Vector &x,SimTK::Matrix &jacobian);
+    static int
+        CentralDifferences(
+        const std::vector<const OptimizationTarget*>& targets,
+        double *dx,const SimTK::Vector &x,SimTK::Vector &dpdx);
+    static int
+        ForwardDifferences(
+        const std::vector<const OptimizationTarget*>& targets,
+        double *dx,const SimTK::Vector &x,SimTK::Vector &dpdx);
+
 };
 
 }; //namespace
@@ -0,0 +1,145 @@
+#ifndef OPENSIM_OUTPUT_PLAN_H_
+#define OPENSIM_OUTPUT_PLAN_H_
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  OutputPlan.h                            *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ComponentOutput.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <SimTKcommon/internal/System.h>
+
+namespace OpenSim {
+
+/**
+ * The channels of many Output%s of type T, resolved once so that their values
+ * can be computed repeatedly (e.g., at every time of a trajectory or every
+ * reporting step of a simulation) without looking up the outputs, checking
+ * their types, or copying values through the caches of the channels.
+ *
+ * The channels are grouped by the stage on which their outputs depend. When
+ * evaluated with a System, the state is realized to each of these stages
+ * only once, in increasing order, and only as far as the channels require.
+ * @code
+ * OutputPlan<double> plan;
+ * plan.addOutput(model.getComponent("/body").getOutput("speed"));
+ * plan.addOutput(model.getOutput("kinetic_energy"));
+ * std::vector<double> values(plan.getNumChannels());
+ * for (const auto& state : statesTrajectory) {
+ *     plan.evaluate(model.getSystem(), state, values);
+ *     // ...
+ * }
+ * @endcode
+ *
+ * The plan refers to the channels (it does not copy them), so it must be
+ * rebuilt when the outputs are destroyed or their channels change (e.g.,
+ * when the components are copied or their connections are finalized).
+ */
+template <typename T>
+class OutputPlan {
+public:
+    typedef typename Output<T>::Channel Channel;
+
+    /** Append all the channels of `output`, which must be an Output<T>. */
+    void addOutput(const AbstractOutput& output) {
+        const auto* typedOutput = dynamic_cast<const Output<T>*>(&output);
+        OPENSIM_THROW_IF(!typedOutput, Exception,
+                "Expected output '{}' to have type {}, but it has type {}.",
+                output.getPathName(), Object_GetClassName<T>::name(),
+                output.getTypeName());
+        for (const auto& channel : typedOutput->getChannels()) {
+            addChannel(channel.second);
+        }
+    }
+
+    /** Append `channel`; its value is at index getNumChannels() - 1 of the
+    values computed by evaluate().                                           */
+    void addChannel(const Channel& channel) {
+        const SimTK::Stage stage = channel.getOutput().getDependsOnStage();
+        const Entry entry{&channel, stage, getNumChannels()};
+        // Keep the entries sorted by stage, and in the order in which they
+        // were added within each stage.
+        const auto position = std::upper_bound(_entries.begin(),
+                _entries.end(), stage,
+                [](const SimTK::Stage& s, const Entry& e) {
+                    return s < e.stage;
+                });
+        _entries.insert(position, entry);
+        _labels.push_back(channel.getPathName());
+        if (stage > _requiredStage) _requiredStage = stage;
+    }
+
+    void clear() {
+        _entries.clear();
+        _labels.clear();
+        _requiredStage = SimTK::Stage::Topology;
+    }
+
+    int getNumChannels() const { return (int)_labels.size(); }
+    /** The path name of the channel with the given index (see
+    AbstractChannel::getPathName()).                                         */
+    const std::string& getLabel(int index) const { return _labels.at(index); }
+    /** The highest stage on which the outputs of the channels depend. */
+    const SimTK::Stage& getRequiredStage() const { return _requiredStage; }
+
+    /** Compute the values of all the channels at `state`, realizing `system`
+    to the stage of each group of channels before computing them. The value
+    of the channel with index i is assigned to `values[i]`, so `values` can
+    be, for example, a std::vector<T>, a T*, or a row of a SimTK::Matrix_<T>,
+    with (at least) getNumChannels() elements. As with System::realize(),
+    `state` must already be realized to Stage::Model.                        */
+    template <typename Values>
+    void evaluate(const SimTK::System& system, const SimTK::State& state,
+            Values&& values) const {
+        for (const auto& entry : _entries) {
+            if (state.getSystemStage() < entry.stage) {
+                system.realize(state, entry.stage);
+            }
+            entry.channel->calcValue(state, values[entry.index]);
+        }
+    }
+
+    /** Compute the values of all the channels at `state` (see above), which
+    the caller has already realized to getRequiredStage().                   */
+    template <typename Values>
+    void evaluate(const SimTK::State& state, Values&& values) const {
+        for (const auto& entry : _entries) {
+            entry.channel->calcValue(state, values[entry.index]);
+        }
+    }
+
+private:
+    struct Entry {
+        const Channel* channel;
+        SimTK::Stage stage;
+        // The index of the channel in the order in which it was added.
+        int index;
+    };
+    std::vector<Entry> _entries;
+    std::vector<std::string> _labels;
+    SimTK::Stage _requiredStage = SimTK::Stage::Topology;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_OUTPUT_PLAN_H_
@@ -24,6 +24,7 @@
 
 // C++ INCLUDES
 #include "PiecewiseLinearFunction.h"
+#include "CommonUtilities.h"
 #include "Constant.h"
 #include "FunctionAdapter.h"
 #include "SimmMacros.h"
@@ -56,7 +57,8 @@ PiecewiseLinearFunction::~PiecewiseLinearFunction()
  */
 PiecewiseLinearFunction::PiecewiseLinearFunction() :
     _x(_propX.getValueDblArray()),
-    _y(_propY.getValueDblArray())
+    _y(_propY.getValueDblArray()),
+    _intervalHint(0)
 {
     setNull();
 }
@@ -67,7 +69,8 @@ PiecewiseLinearFunction::PiecewiseLinearFunction(int aN,const double *aX,const d
     const string &aName) :
     _x(_propX.getValueDblArray()),
     _y(_propY.getValueDblArray()),
-   _b(0.0)
+   _b(0.0),
+   _intervalHint(0)
 {
     setNull();
 
@@ -112,7 +115,8 @@ PiecewiseLinearFunction::PiecewiseLinearFunction(const PiecewiseLinearFunction &
     Function(aFunction),
     _x(_propX.getValueDblArray()),
     _y(_propY.getValueDblArray()),
-   _b(0.0)
+   _b(0.0),
+   _intervalHint(0)
 {
     setEqual(aFunction);
 }
@@ -429,38 +433,10 @@ void PiecewiseLinearFunction::calcCoefficients()
 
 double PiecewiseLinearFunction::calcValue(const Vector& x) const
 {
-    int n = _x.getSize();
-    double aX = x[0];
-
-    if (aX < _x[0])
-        return _y[0] + (aX - _x[0]) * _b[0];
-    else if (aX > _x[n-1])
-        return _y[n-1] + (aX - _x[n-1]) * _b[n-1];
-
-    /* Check to see if the abscissa is close to one of the end points
-     * (the binary search method doesn't work well if you are at one of the
-     * end points.
-     */
-    if (EQUAL_WITHIN_ERROR(aX, _x[0]))
-        return _y[0];
-    else if (EQUAL_WITHIN_ERROR(aX,_x[n-1]))
-        return _y[n-1];
-
-    // Do a binary search to find which two points the abscissa is between.
-    int k, i = 0;
-    int j = n;
-    while (1)
-    {
-        k = (i+j)/2;
-        if (aX < _x[k])
-            j = k;
-        else if (aX > _x[k+1])
-            i = k;
-        else
-            break;
-    }
-
-    return _y[k] + (aX - _x[k]) * _b[k];
+    int interval = _intervalHint.load(std::memory_order_relaxed);
+    const double value = evaluate(x[0], 0, interval);
+    _intervalHint.store(interval, std::memory_order_relaxed);
+    return value;
 }
 
 double PiecewiseLinearFunction::calcDerivative(const std::vector<int>& derivComponents, const Vector& x) const
@@ -470,40 +446,56 @@ double PiecewiseLinearFunction::calcDerivative(const std::vector<int>& derivComp
     if (derivComponents.size() > 1)
         return 0.0;
 
-    int n = _x.getSize();
-    double aX = x[0];
+    int interval = _intervalHint.load(std::memory_order_relaxed);
+    const double value = evaluate(x[0], 1, interval);
+    _intervalHint.store(interval, std::memory_order_relaxed);
+    return value;
+}
 
-    if (aX < _x[0]) {
-        return _b[0];
-    } else if (aX > _x[n-1]) {
-        return _b[n-1];
+void PiecewiseLinearFunction::evaluate(const Vector& aX, int aDerivOrder,
+        Vector& rValues) const
+{
+    if (aDerivOrder < 0)
+        throw Exception("PiecewiseLinearFunction::evaluate(): negative "
+                        "derivative order.");
+
+    rValues.resize(aX.size());
+    if (aDerivOrder > 1) {
+        rValues = 0.0;
+        return;
     }
+    int interval = _intervalHint.load(std::memory_order_relaxed);
+    for (int i = 0; i < aX.size(); ++i)
+        rValues[i] = evaluate(aX[i], aDerivOrder, interval);
+    _intervalHint.store(interval, std::memory_order_relaxed);
+}
+
+double PiecewiseLinearFunction::evaluate(double aX, int aDerivOrder,
+        int& rInterval) const
+{
+    int n = _x.getSize();
+    if (aDerivOrder > 1) return 0.0;
+
+    if (aX < _x[0])
+        return aDerivOrder == 0 ? _y[0] + (aX - _x[0]) * _b[0] : _b[0];
+    else if (aX > _x[n-1])
+        return aDerivOrder == 0 ? _y[n-1] + (aX - _x[n-1]) * _b[n-1] : _b[n-1];
 
     /* Check to see if the abscissa is close to one of the end points
-     * (the binary search method doesn't work well if you are at one of the
-     * end points.
+     * (the interval search doesn't need to be done if you are at one of the
+     * end points).
      */
-    if (EQUAL_WITHIN_ERROR(aX, _x[0])) {
-        return _b[0];
-    } else if (EQUAL_WITHIN_ERROR(aX,_x[n-1])) {
-        return _b[n-1];
-    }
+    if (EQUAL_WITHIN_ERROR(aX, _x[0]))
+        return aDerivOrder == 0 ? _y[0] : _b[0];
+    else if (EQUAL_WITHIN_ERROR(aX,_x[n-1]))
+        return aDerivOrder == 0 ? _y[n-1] : _b[n-1];
 
-    // Do a binary search to find which two points the abscissa is between.
-    int k, i = 0;
-    int j = n;
-    while (1)
-    {
-        k = (i+j)/2;
-        if (aX < _x[k])
-            j = k;
-        else if (aX > _x[k+1])
-            i = k;
-        else
-            break;
-    }
+    // Find which two points the abscissa is between, starting the search
+    // from the interval of the previous evaluation.
+    rInterval = findInterval(&_x[0], n, aX, rInterval);
+    const int k = rInterval;
 
-    return _b[k];
+    return aDerivOrder == 0 ? _y[k] + (aX - _x[k]) * _b[k] : _b[k];
 }
 
 int PiecewiseLinearFunction::getArgumentSize() const
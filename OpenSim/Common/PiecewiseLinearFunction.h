@@ -31,6 +31,8 @@
 #include "PropertyDblArray.h"
 #include "Function.h"
 
+#include <atomic>
+
 
 //=============================================================================
 //=============================================================================
@@ -64,6 +66,10 @@ protected:
 
 private:
     Array<double> _b;
+    /** Knot interval found by the last evaluation, where the search for the
+    interval of the next evaluation starts. This is atomic so that concurrent
+    evaluations are safe; they can only make the hint less effective. */
+    mutable std::atomic<int> _intervalHint;
 
 //=============================================================================
 // METHODS
@@ -119,6 +125,27 @@ public:
     int getArgumentSize() const override;
     int getMaxDerivativeOrder() const override;
     SimTK::Function* createSimTKFunction() const override;
+    /**
+     * Evaluate the function or one of its derivatives at each of a sequence
+     * of values of the independent variable. The search for the interval
+     * containing each value starts from the interval of the previous value,
+     * so this is fastest when the values are sorted.
+     *
+     * @param aX Values of the independent variable.
+     * @param aDerivOrder Order of the derivative (0 for the value).
+     * @param rValues Resized to the size of aX and set to the values of the
+     * function or of its derivative.
+     */
+    void evaluate(const SimTK::Vector& aX, int aDerivOrder,
+            SimTK::Vector& rValues) const;
+    /**
+     * Evaluate the function or one of its derivatives at aX, starting the
+     * search for the interval containing aX at rInterval, which is updated to
+     * that interval. Functions with the same independent values (e.g., the
+     * columns of one data file) can share rInterval, so that only the first
+     * of them searches.
+     */
+    double evaluate(double aX, int aDerivOrder, int& rInterval) const;
 
     void updateFromXMLNode(SimTK::Xml::Element& aNode, int versionNumber=-1) override;
 
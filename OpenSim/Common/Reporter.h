@@ -24,6 +24,7 @@
  * -------------------------------------------------------------------------- */
 // INCLUDE
 #include <OpenSim/Common/Component.h>
+#include <OpenSim/Common/OutputPlan.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
 
 namespace OpenSim {
@@ -182,15 +183,28 @@ public:
     TableReporter_() = default;
     virtual ~TableReporter_() = default;
 
-    /** Retrieve the report as a TimeSeriesTable.                             */
+    /** Retrieve the report as a TimeSeriesTable. Rows reported since the
+    last call are buffered by the reporter and appended to the table here, so
+    it is cheaper to call this once after a simulation than after every step.*/
     const TimeSeriesTable_<ValueT>& getTable() const {
+        const_cast<Self*>(this)->flushPendingRows();
         return _outputTable;
     }
 
+    /** Preallocate memory for `numRows` reported rows (e.g., the expected
+    number of reporting times of a simulation) so that reporting does not
+    reallocate memory. Without it, the capacity is doubled as needed.        */
+    void reserveRows(int numRows) {
+        if (numRows <= _pendingRows.nrow()) return;
+        _pendingRows.resizeKeep(numRows, _pendingRows.ncol());
+        _pendingTimes.reserve(numRows);
+    }
+
     /** Clear the report. This can be used for example in loops performing 
     simulation. Each new iteration should start with an empty report and so this
     function can be used to clear the report at the end of each iteration.    */
     void clearTable() {
+        _pendingTimes.clear();
         std::vector<std::string> columnLabels;
         // Handle the case where no outputs were connected to the reporter.
         if (_outputTable.hasColumnLabels()) {
@@ -205,24 +219,13 @@ public:
 protected:
     void implementReport(const SimTK::State& state) const override {
         const auto& input = this->template getInput<InputT>("inputs");
-        SimTK::RowVector_<ValueT> result;
-        result.resize(int(input.getNumConnectees()));
-
-        for (auto idx = 0u; idx < input.getNumConnectees(); ++idx) {
-              const auto& chan = input.getChannel(idx);
-              const auto& value = chan.getValue(state);
-              result[idx] = value;
-        }
-        try {
-            const_cast<Self*>(this)->_outputTable.appendRow(state.getTime(),
-                                                            result);
-        } catch(const InvalidTimestamp& exception) {
-            OPENSIM_THROW(Exception,
-                          "Attempting to update reporter with rows having "
-                          "invalid timestamps. Hint: If running simulation in "
-                          "a loop, use clearTable() to clear table at the end "
-                          "of each loop.\n\n" + std::string{exception.what()});
-        }
+        const int numColumns = int(input.getNumConnectees());
+        auto* mutableThis = const_cast<Self*>(this);
+        const int row = mutableThis->appendPendingRow(state.getTime(),
+                                                      numColumns);
+        // The values are computed directly into the row, without looking up
+        // the channels of the connectees.
+        _outputPlan.evaluate(state, mutableThis->_pendingRows[row]);
     }
 
     void extendFinalizeConnections(Component& root) override {
@@ -231,8 +234,10 @@ protected:
         const auto& input = this->template getInput<InputT>("inputs");
 
         std::vector<std::string> labels;
+        _outputPlan.clear();
         for (auto idx = 0u; idx < input.getNumConnectees(); ++idx) {
             labels.push_back( input.getLabel(idx) );
+            _outputPlan.addChannel(input.getChannel(idx));
         }
         if (!labels.empty()) {
             const_cast<Self*>(this)->_outputTable.setColumnLabels(labels);
@@ -246,11 +251,61 @@ protected:
     }
 
 private:
+    /** Append a row with the given time to the buffer of reported rows, and
+    return its index in the buffer. The values of the row are left for the
+    caller to fill in. The buffer is appended to the table by getTable().     */
+    int appendPendingRow(double time, int numColumns) {
+        const double* previousTime = nullptr;
+        if (!_pendingTimes.empty()) {
+            previousTime = &_pendingTimes.back();
+        } else if (_outputTable.getNumRows() != 0) {
+            previousTime = &_outputTable.getIndependentColumn().back();
+        }
+        OPENSIM_THROW_IF(previousTime && time <= *previousTime, Exception,
+                         "Attempting to update reporter with rows having "
+                         "invalid timestamps. Hint: If running simulation in "
+                         "a loop, use clearTable() to clear table at the end "
+                         "of each loop.\n\nTimestamp {} is less than or "
+                         "equal to the previous timestamp {}.",
+                         time, *previousTime);
+
+        if (numColumns != _pendingRows.ncol()) {
+            flushPendingRows();
+            _pendingRows.resize(_pendingRows.nrow(), numColumns);
+        }
+        const int row = int(_pendingTimes.size());
+        if (row == _pendingRows.nrow()) {
+            const int capacity = std::max(2 * row, 64);
+            _pendingRows.resizeKeep(capacity, numColumns);
+            _pendingTimes.reserve(capacity);
+        }
+        _pendingTimes.push_back(time);
+        return row;
+    }
+
+    /** Append the buffered rows to the table.                                */
+    void flushPendingRows() {
+        if (_pendingTimes.empty()) return;
+        _outputTable.appendRows(_pendingTimes,
+                _pendingRows.block(0, 0, int(_pendingTimes.size()),
+                                   _pendingRows.ncol()));
+        _pendingTimes.clear();
+    }
 
     // Hold the output values in a table with values as columns and time rows
     // We write to this table in const methods, but only because we ensure
     // those const methods are never called with trial integrator states.
     TimeSeriesTable_<ValueT> _outputTable;
+
+    // Rows that have been reported but not yet appended to _outputTable.
+    // Only the first _pendingTimes.size() rows of _pendingRows are in use;
+    // the rest is capacity for rows reported later.
+    SimTK::Matrix_<ValueT> _pendingRows;
+    std::vector<double> _pendingTimes;
+
+    // The channels of the connectees of the input, resolved when the
+    // connections are finalized.
+    SimTK::ResetOnCopy<OutputPlan<InputT>> _outputPlan;
 };
 
 /** A reporter that simply prints quantities to the console
@@ -349,18 +404,22 @@ inline void TableReporter_<SimTK::Vector, SimTK::Real>::
 {
     const auto& input = getInput<SimTK::Vector>("inputs");
     const SimTK::Vector& result = input.getValue(state, 0);
+    auto* mutableThis = const_cast<Self*>(this);
     
-    if (_outputTable.getNumRows() == 0) {
+    if (_outputTable.getNumRows() == 0 && _pendingTimes.empty()) {
         std::vector<std::string> labels;
         const std::string& base = input.getLabel(0);
         for (int ix = 0; ix < result.size(); ++ix) {
             labels.push_back(base + "[" + std::to_string(ix)+"]");
         }
-        const_cast<Self*>(this)->_outputTable.setColumnLabels(labels);
+        mutableThis->_outputTable.setColumnLabels(labels);
     }
 
-    const_cast<Self*>(this)->_outputTable.appendRow(state.getTime(), 
-                                                    (~result).getAsRowVector());
+    const int row = mutableThis->appendPendingRow(state.getTime(),
+                                                  result.size());
+    for (int ix = 0; ix < result.size(); ++ix) {
+        mutableThis->_pendingRows.updElt(row, ix) = result[ix];
+    }
 }
 
 /** @name Commonly used concrete TableReporters */
@@ -81,7 +81,13 @@ setNull()
 /**
  * Solve for the roots.
  *
- * 
+ * The N roots are found with Brent's method (bracketing with inverse
+ * quadratic interpolation), advanced together so that each iteration
+ * evaluates the function once for all N equations. An equation that has
+ * converged is no longer changed, and the iterations stop as soon as all the
+ * equations have converged, without evaluating the function again.
+ *
+ * @see getNumIterations()
  */
 Array<double> RootSolver::
 solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
@@ -98,8 +104,10 @@ solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
     Array<double> q(0.0,N);
     Array<double> new_step(0.0,N);
 
-    bool finished = false;
-    Array<int>   converged(0,N);
+    Array<bool>  converged(false,N);
+    int numConverged = 0;
+    _numIterations.setSize(N);
+    for(i=0;i<N;i++) _numIterations[i] = 0;
 
 
     // INITIALIZATIONS
@@ -113,7 +121,7 @@ solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
 
     // ITERATION LOOP
     int iter;
-    for(iter=0;!finished;iter++) {
+    for(iter=0;;iter++) {
 
         // ABSCISSAE MANIPULATION LOOP
         for(i=0;i<N;i++) {
@@ -143,7 +151,9 @@ solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
             // Converged?
             // Original convergence test:
             if(fabs(new_step[i])<=tol_act[i] || fb[i]==(double)0.0 ) {
-                converged[i] = iter;
+                converged[i] = true;
+                _numIterations[i] = iter;
+                ++numConverged;
                 continue;
             }
 
@@ -194,20 +204,13 @@ solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
             b[i] += new_step[i];
              
         } // END ABSCISSAE LOOP
-     
+
+        // FINISHED?
+        // The roots of the converged equations have already been evaluated.
+        if(numConverged==N) break;
 
         // NEW FUNCTION EVALUATION
         _function->evaluate(s, b,fb);
-
-
-        // FINISHED?
-        for(i=0;i<N;i++) {
-            finished = true;
-            if(!converged[i]) {
-                finished = false;
-                break;
-            }
-        }
     }
 
     // PRINT
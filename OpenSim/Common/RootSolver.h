@@ -69,6 +69,8 @@ class OSIMCOMMON_API RootSolver
 private:
     
     VectorFunctionUncoupledNxN *_function;
+    // The number of iterations of each equation in the last solve().
+    Array<int> _numIterations;
 
 
 //=============================================================================
@@ -90,6 +92,12 @@ public:
     Array<double> solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
         const Array<double> &tol);
 
+    /** The number of iterations (function evaluations after the evaluations
+    at the ends of the brackets) that each of the N equations took to converge
+    in the last solve(). The solve took as many function evaluations as the
+    largest of these (plus 2). */
+    const Array<int>& getNumIterations() const { return _numIterations; }
+
 //=============================================================================
 };  // END class RootSolver
 
@@ -24,6 +24,7 @@
 // INCLUDES
 //=============================================================================
 #include "SegmentedQuinticBezierToolkit.h"
+#include <algorithm>
 #include <fstream>
 
 
@@ -781,7 +782,92 @@ double SegmentedQuinticBezierToolkit::calcU(
         "Error: input ax was not in the domain of the Bezier curve specified \n"
         "by the control points in bezierPtsX.");
 
-    double u = splineUX.calcValue(ax);
+    return calcUFromGuess(ax, bezierPtsX, splineUX.calcValue(ax), tol,
+            maxIter);
+}
+
+SegmentedQuinticBezierToolkit::UOfXTable
+SegmentedQuinticBezierToolkit::createUOfXTable(
+    const SimTK::Vec6& bezierPtsX,
+    const SimTK::Spline& splineUX,
+    int numPoints,
+    double tol,
+    int maxIter)
+{
+    SimTK_ERRCHK1_ALWAYS( numPoints >= 2,
+        "SegmentedQuinticBezierToolkit::createUOfXTable",
+        "Error: numPoints must be at least 2, but it is %d.", numPoints);
+    const double xStart = bezierPtsX(0);
+    const double xEnd = bezierPtsX(5);
+    SimTK_ERRCHK_ALWAYS( xEnd > xStart,
+        "SegmentedQuinticBezierToolkit::createUOfXTable",
+        "Error: the x values of the Bezier curve must be increasing.");
+
+    const double dx = (xEnd - xStart) / (numPoints - 1);
+    SimTK::Array_<double> u(numPoints);
+    SimTK::Array_<double> dudx(numPoints);
+    for(int i=0; i<numPoints; i++){
+        if(i == 0){
+            u[i] = 0;
+        }else if(i == numPoints-1){
+            u[i] = 1;
+        }else{
+            u[i] = calcU(xStart + i*dx, bezierPtsX, splineUX, tol, maxIter);
+        }
+        dudx[i] = 1.0/calcQuinticBezierCurveDerivU(u[i],bezierPtsX,1);
+    }
+
+    UOfXTable table;
+    table.x0 = xStart;
+    table.invDx = 1.0/dx;
+    table.coefficients.resize(numPoints-1);
+    for(int i=0; i<numPoints-1; i++){
+        const double du = u[i+1] - u[i];
+        // The slopes in terms of the fraction of the interval.
+        const double m0 = dudx[i]*dx;
+        const double m1 = dudx[i+1]*dx;
+        // The slopes of a cubic that does not overshoot are at most 3 times
+        // the secant (Fritsch and Carlson, 1980).
+        const bool cubic = SimTK::isFinite(m0) && SimTK::isFinite(m1) &&
+                m0 >= 0 && m1 >= 0 && m0 <= 3*du && m1 <= 3*du;
+        if(cubic){
+            table.coefficients[i] = SimTK::Vec4(u[i], m0,
+                    3*du - 2*m0 - m1, m0 + m1 - 2*du);
+        }else{
+            table.coefficients[i] = SimTK::Vec4(u[i], du, 0, 0);
+        }
+    }
+    return table;
+}
+
+double SegmentedQuinticBezierToolkit::calcU(
+    double ax,
+    const SimTK::Vec6& bezierPtsX,
+    const UOfXTable& tableUX,
+    double tol,
+    int maxIter)
+{
+    SimTK_ERRCHK_ALWAYS( ax >= SimTK::min(bezierPtsX) && ax <= SimTK::max(bezierPtsX),
+        "SegmentedQuinticBezierToolkit::calcU", 
+        "Error: input ax was not in the domain of the Bezier curve specified \n"
+        "by the control points in bezierPtsX.");
+
+    const int numIntervals = (int)tableUX.coefficients.size();
+    const double t = (ax - tableUX.x0)*tableUX.invDx;
+    const int i = std::min(std::max((int)t, 0), numIntervals-1);
+    const double f = t - i;
+    const SimTK::Vec4& c = tableUX.coefficients[i];
+    return calcUFromGuess(ax, bezierPtsX, c[0] + f*(c[1] + f*(c[2] + f*c[3])),
+            tol, maxIter);
+}
+
+double SegmentedQuinticBezierToolkit::calcUFromGuess(
+    double ax,
+    const SimTK::Vec6& bezierPtsX,
+    double u,
+    double tol,
+    int maxIter)
+{
     u = clampU(u);
     double f = 0;
 
@@ -193,6 +193,59 @@ class OSIMCOMMON_API SegmentedQuinticBezierToolkit
             double tol,
             int maxIter);
 
+        /**
+        A table of u(x) for one quintic Bezier curve section, from which
+        calcU() computes an initial guess that is accurate enough for the
+        Newton iteration to usually converge in one step. The table holds
+        the coefficients of a cubic Hermite interpolant of u(x) (in Horner
+        form) on each of the intervals between points evenly spaced in x, so
+        that looking up a guess costs an index computation and 3
+        multiply-adds, rather than a search through the knots of a spline.
+        */
+        struct UOfXTable {
+            /**The x value of the first point of the table.*/
+            double x0 = 0;
+            /**The inverse of the spacing of the points.*/
+            double invDx = 0;
+            /**The 4 coefficients of the interpolant on each interval, in
+            terms of the fraction s of the interval: u = c0 + s*(c1 + s*(c2 +
+            s*c3)).*/
+            SimTK::Array_<SimTK::Vec4> coefficients;
+        };
+
+        /**
+        Create a UOfXTable with `numPoints` points for the Bezier section
+        with the control points bezierPtsX, whose x values must be increasing
+        in u. The u values of the points are computed with calcU() using
+        splineUX (see above), and the slopes of the interpolant are 1/(dx/du).
+        Near points at which dx/du is close to 0 (where u(x) is steep), the
+        cubic would overshoot, so the interpolant is linear on those
+        intervals.
+
+        @param bezierPtsX The 6 Bezier point values
+        @param splineUX   The spline for the approximate u(x) curve
+        @param numPoints  The number of points of the table (at least 2)
+        @param tol        The desired tolerance on u of the points
+        @param maxIter    The maximum number of Newton iterations allowed
+        */
+        static UOfXTable createUOfXTable(
+            const SimTK::Vec6& bezierPtsX,
+            const SimTK::Spline& splineUX,
+            int numPoints,
+            double tol,
+            int maxIter);
+
+        /**
+        The same as calcU() above, but the initial guess is interpolated from
+        a table made with createUOfXTable() for the same control points.
+        */
+        static double calcU(
+            double ax,
+            const SimTK::Vec6& bezierPtsX,
+            const UOfXTable& tableUX,
+            double tol,
+            int maxIter);
+
 
 
         /**
@@ -699,6 +752,16 @@ class OSIMCOMMON_API SegmentedQuinticBezierToolkit
         */
         static double clampU(double u);
 
+        /**
+        The Newton iteration of calcU(), starting from the guess u.
+        */
+        static double calcUFromGuess(
+            double ax,
+            const SimTK::Vec6& bezierPtsX,
+            double u,
+            double tol,
+            int maxIter);
+
         
 ///@cond
 /**
@@ -25,6 +25,9 @@
 
 // INCLUDES
 #include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include "osimCommonDLL.h"
 #include "Object.h"
 #include "ArrayPtrs.h"
@@ -40,6 +43,11 @@ namespace OpenSim {
  * base class C and is implemented as a wrapper around template class
  * ArrayPtrs<T>.  
  *
+ * Lookups by name (get(), getIndex() and contains()) use an index of the
+ * names of the objects, which is built on the first lookup after the Set
+ * changes or an Object is renamed (see Object::getNumNameChanges()). The
+ * lookups then do not scan the whole array.
+ *
  * @see ArrayPtrs
  * @author Frank C. Anderson
  */
@@ -60,6 +68,20 @@ PropertyObjArray<ObjectGroup> _propObjectGroups;
 ArrayPtrs<T> &_objects;
 ArrayPtrs<ObjectGroup> &_objectGroups;
 
+private:
+/** Index of the first object with each name, and the state of the Set
+when the index was built (to detect that it is stale). */
+struct NameIndex {
+    std::unordered_map<std::string, int> indices;
+    long long numNameChanges;
+    int size;
+    const T* first;
+    const T* last;
+};
+/** Built by findIndexByName(); accessed atomically so that const lookups
+can be made from multiple threads. */
+mutable std::shared_ptr<const NameIndex> _nameIndex;
+
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 // METHODS
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -132,7 +154,57 @@ setNull()
     setupProperties();
     _objects.setSize(0);
     _objectGroups.setSize(0);
+    resetNameIndex();
+}
+//_____________________________________________________________________________
+/**
+ * Discard the name index; it is rebuilt by the next lookup by name.
+ */
+void
+resetNameIndex()
+{
+    std::atomic_store(&_nameIndex, std::shared_ptr<const NameIndex>());
 }
+//_____________________________________________________________________________
+/**
+ * Get the index of the first object named aName, or -1 if there is none.
+ * Small sets are searched linearly; otherwise the name index is used (and
+ * rebuilt if the Set or the name of any Object has changed).
+ */
+int
+findIndexByName(const std::string &aName) const
+{
+    const int size = _objects.getSize();
+    if (size < 16) return _objects.getIndex(aName);
+
+    const long long numNameChanges = Object::getNumNameChanges();
+    const T* first = _objects[0];
+    const T* last = _objects[size - 1];
+    std::shared_ptr<const NameIndex> nameIndex = std::atomic_load(&_nameIndex);
+    if (!nameIndex || nameIndex->numNameChanges != numNameChanges ||
+            nameIndex->size != size || nameIndex->first != first ||
+            nameIndex->last != last) {
+        auto newIndex = std::make_shared<NameIndex>();
+        newIndex->indices.reserve(size);
+        for (int i = 0; i < size; ++i) {
+            if (_objects[i]) newIndex->indices.emplace(_objects[i]->getName(), i);
+        }
+        newIndex->numNameChanges = numNameChanges;
+        newIndex->size = size;
+        newIndex->first = first;
+        newIndex->last = last;
+        nameIndex = newIndex;
+        std::atomic_store(&_nameIndex, nameIndex);
+    }
+    const auto it = nameIndex->indices.find(aName);
+    if (it == nameIndex->indices.end()) return -1;
+    // The objects may have been replaced without the Set knowing (e.g.,
+    // through its property); fall back to a search in that case.
+    const T* obj = _objects[it->second];
+    if (!obj || obj->getName() != aName) return _objects.getIndex(aName);
+    return it->second;
+}
+
 //_____________________________________________________________________________
 /**
  * Setup serialized member variables.
@@ -186,6 +258,7 @@ Set<T,C>& operator=(const Set<T,C> &set)
     Super::operator=(set);
     _objects = set._objects;
     _objectGroups = set._objectGroups;
+    resetNameIndex();
 
     return(*this);
 }
@@ -388,6 +461,7 @@ int getCapacityIncrement() const
  */
 virtual bool setSize(int aSize)
 {
+    resetNameIndex();
     return( _objects.setSize(aSize) );
 }
 //_____________________________________________________________________________
@@ -432,7 +506,12 @@ virtual int getIndex(const T *aObject,int aStartIndex=0) const
  */
 virtual int getIndex(const std::string &aName,int aStartIndex=0) const
 {
-    return( _objects.getIndex(aName,aStartIndex) );
+    const int index = findIndexByName(aName);
+    // The first object with the name comes before aStartIndex; there may be
+    // another one at or after aStartIndex.
+    if (index >= 0 && index < aStartIndex)
+        return( _objects.getIndex(aName,aStartIndex) );
+    return index;
 }
 //_____________________________________________________________________________
 /**
@@ -459,6 +538,7 @@ void getGroupNamesContaining(const std::string &aObjectName, Array<std::string>
  */
 virtual bool adoptAndAppend(T *aObject)
 {
+    resetNameIndex();
     return( _objects.append(aObject) );
 }
 
@@ -497,6 +577,7 @@ virtual bool cloneAndAppend(const T& aObject)
  */
 virtual bool insert(int aIndex,T *aObject)
 {
+    resetNameIndex();
     return( _objects.insert(aIndex,aObject) );
 }
 #ifndef SWIG
@@ -546,6 +627,7 @@ virtual bool remove(int aIndex)
     for (i=0; i<_objectGroups.getSize(); i++)
         _objectGroups.get(i)->remove(_objects.get(aIndex));
 
+    resetNameIndex();
     return( _objects.remove(aIndex) );
 }
 //_____________________________________________________________________________
@@ -567,11 +649,13 @@ virtual bool remove(const T* aObject)
     for (i=0; i<_objectGroups.getSize(); i++)
         _objectGroups.get(i)->remove(aObject);
 
+    resetNameIndex();
     return( _objects.remove(aObject) );
 }
 
 virtual void clearAndDestroy()
 {
+    resetNameIndex();
     _objects.clearAndDestroy();
     _objectGroups.clearAndDestroy();
 }
@@ -596,6 +680,7 @@ virtual void clearAndDestroy()
  */
 virtual bool set(int aIndex, T *aObject, bool preserveGroups = false)
 {
+    resetNameIndex();
     if (!preserveGroups)
         return( _objects.set(aIndex,aObject) );
     if (aObject != NULL && aIndex >= 0 && aIndex < _objects.getSize())
@@ -661,12 +746,18 @@ virtual T& get(int aIndex) const
  */
 T& get(const std::string &aName)
 {
-    return( *_objects.get(aName) );
+    const int index = findIndexByName(aName);
+    // ArrayPtrs::get() throws the exception if there is no such object.
+    if (index < 0) return( *_objects.get(aName) );
+    return( *_objects[index] );
 }
 #ifndef SWIG
 const T& get(const std::string &aName) const
 {
-    return( *_objects.get(aName) );
+    const int index = findIndexByName(aName);
+    // ArrayPtrs::get() throws the exception if there is no such object.
+    if (index < 0) return( *_objects.get(aName) );
+    return( *_objects[index] );
 }
 #endif
 //_____________________________________________________________________________
@@ -678,7 +769,7 @@ const T& get(const std::string &aName) const
  */
 bool contains(const std::string &aName) const
 {
-    return( _objects.getIndex(aName) != -1 );
+    return( findIndexByName(aName) != -1 );
 }//_____________________________________________________________________________
 /**
  * Get names of objects in the set.
@@ -160,14 +160,36 @@ SmoothSpline(int degree,double T,double fc,int N,double *times,double *sig,doubl
 int Signal::
 LowpassIIR(double T,double fc,int N,const double *sig,double *sigf)
 {
-int i,j;
+    return LowpassIIRInterleaved(T,fc,N,1,sig,sigf);
+}
+//_____________________________________________________________________________
+/**
+ * 3RD ORDER LOWPASS IIR BUTTERWORTH DIGITAL FILTER OF INTERLEAVED SIGNALS
+ *
+ * Sample i of signal j is at sig[i*M+j] and sigf[i*M+j], where M is the
+ * number of signals. Each signal is filtered as by LowpassIIR().
+ *
+ *  @param T Sample interval in seconds.
+ *  @param fc Cutoff frequency in Hz.
+ *  @param N Number of data points in each signal.
+ *  @param M Number of signals.
+ *  @param sig The sampled signals.
+ *  @param sigf The filtered signals.
+ *
+ * @return 0 on success, and -1 on failure.
+ */
+int Signal::
+LowpassIIRInterleaved(double T,double fc,int N,int M,const double *sig,
+        double *sigf)
+{
+int i,j,k;
 double fs/*,ws*/,wc,wa,wa2,wa3;
 double a[4],b[4],denom;
-double *sigr;
 
     // ERROR CHECK
     if(T==0) return(-1);
     if(N==0) return(-1);
+    if(M<=0) return(-1);
     if(sig==NULL) return(-1);
     if(sigf==NULL) return(-1);
 
@@ -201,42 +223,47 @@ double *sigr;
     b[3] = (wa - 1) * (wa2 - wa + 1) / denom;
 
     // ALLOCATE MEMORY FOR sigr[]
-    sigr = new double[N];
-    if(sigr==NULL) {
-        log_error("Signal.lowpassIIR: Not enough memory.");
-        return(-1);
-    }
+    std::vector<double> sigrVec((size_t)N*M);
+    double *sigr = sigrVec.data();
 
     // FILTER THE DATA
     // FILL THE 1ST THREE TERMS OF sigf
-    for (i=0;i<=3;i++) sigf[i] = sig[i];
+    for (i=0;i<4*M && i<N*M;i++) sigf[i] = sig[i];
 
     // IMPLEMENT THE FORMULA
+    // The innermost loops are over the signals, which are independent.
     for (i=3;i<N;i++) {
-        sigf[i] = a[0]*sig[i] + a[1]*sig[i-1] +  a[2]*sig[i-2] +  a[3]*sig[i-3]
-                            - b[1]*sigf[i-1] - b[2]*sigf[i-2] - b[3]*sigf[i-3];
+        const double *x = sig + i*M;
+        double *y = sigf + i*M;
+        for (k=0;k<M;k++) {
+            y[k] = a[0]*x[k] + a[1]*x[k-M] +  a[2]*x[k-2*M] +  a[3]*x[k-3*M]
+                            - b[1]*y[k-M] - b[2]*y[k-2*M] - b[3]*y[k-3*M];
+        }
     }
 
     // REVERSE THE FILTERED ARRAY
-    for (i=0,j=N-1;i<N;i++,j--)  sigr[i] = sigf[j]; 
+    for (i=0,j=N-1;i<N;i++,j--)
+        for (k=0;k<M;k++) sigr[i*M+k] = sigf[j*M+k];
 
     // FILL THE 1ST THREE TERMS OF sigf
-    for (i=0;i<=3;i++) sigf[i] = sigr[i];
+    for (i=0;i<4*M && i<N*M;i++) sigf[i] = sigr[i];
 
     // IMPLEMENT THE FORMULA AGAIN
     for (i=3;i<N;i++) {
-        sigf[i] = a[0]*sigr[i] + a[1]*sigr[i-1] +  a[2]*sigr[i-2] +  a[3]*sigr[i-3]
-                             - b[1]*sigf[i-1] - b[2]*sigf[i-2] - b[3]*sigf[i-3];
+        const double *x = sigr + i*M;
+        double *y = sigf + i*M;
+        for (k=0;k<M;k++) {
+            y[k] = a[0]*x[k] + a[1]*x[k-M] +  a[2]*x[k-2*M] +  a[3]*x[k-3*M]
+                            - b[1]*y[k-M] - b[2]*y[k-2*M] - b[3]*y[k-3*M];
+        }
     }
 
     // REVERSE THE FILTERED ARRAY AGAIN
-    for (i=0,j=N-1;i<N;i++,j--)  sigr[i] = sigf[j]; 
+    for (i=0,j=N-1;i<N;i++,j--)
+        for (k=0;k<M;k++) sigr[i*M+k] = sigf[j*M+k];
 
     // ASSIGN sigf TO sigr
-    for (i=0;i<N;i++)  sigf[i] = sigr[i];
-
-    // CLEANUP
-    if(sigr!=NULL)  delete[] sigr;
+    for (i=0;i<N*M;i++)  sigf[i] = sigr[i];
 
   return(0);
 }
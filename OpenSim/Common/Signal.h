@@ -64,6 +64,16 @@ public:
     static int
         LowpassIIR(double aDeltaT,double aCutOffFrequency,
         int aN,const double *aSignal,double *rFilteredSignal);
+    /// Same as LowpassIIR(), but filters aNumSignals signals at once. The
+    /// signals are interleaved: sample i of signal j is at
+    /// aSignals[i * aNumSignals + j] (and likewise for rFilteredSignals), so
+    /// that the filter is applied to all of the signals in the innermost loop
+    /// and can be vectorized. The results are the same as filtering each
+    /// signal with LowpassIIR().
+    static int
+        LowpassIIRInterleaved(double aDeltaT,double aCutOffFrequency,
+        int aN,int aNumSignals,const double *aSignals,
+        double *rFilteredSignals);
     static int
         LowpassFIR(int aOrder,double aDeltaT,double aCutoffFrequency,
         int aN,double *aSignal,double *rFilteredSignal);
@@ -24,16 +24,21 @@
 
 // C++ INCLUDES
 #include "SimmSpline.h"
+#include "CommonUtilities.h"
 #include "Constant.h"
 #include "SimmMacros.h"
 #include "XYFunctionInterface.h"
-#include "FunctionAdapter.h"
 
 
 using namespace OpenSim;
 using namespace std;
 using SimTK::Vector;
 
+namespace OpenSim {
+struct SimmSplineCoefficients {
+    std::vector<double> x, y, b, c, d;
+};
+}
 
 //=============================================================================
 // STATICS
@@ -57,7 +62,7 @@ SimmSpline::~SimmSpline()
 SimmSpline::SimmSpline() :
     _x(_propX.getValueDblArray()),
     _y(_propY.getValueDblArray()),
-    _b(0.0), _c(0.0), _d(0.0)
+    _intervalHint(0)
 {
     setNull();
 }
@@ -68,7 +73,7 @@ SimmSpline::SimmSpline(int aN,const double *aX,const double *aY,
     const string &aName) :
     _x(_propX.getValueDblArray()),
     _y(_propY.getValueDblArray()),
-    _b(0.0), _c(0.0), _d(0.0)
+    _intervalHint(0)
 {
     setNull();
 
@@ -110,7 +115,7 @@ SimmSpline::SimmSpline(const SimmSpline &aSpline) :
     Function(aSpline),
     _x(_propX.getValueDblArray()),
     _y(_propY.getValueDblArray()),
-    _b(0.0), _c(0.0), _d(0.0)
+    _intervalHint(0)
 {
     setEqual(aSpline);
 }
@@ -164,9 +169,8 @@ void SimmSpline::setEqual(const SimmSpline &aSpline)
     // ALLOCATE ARRAYS
     _x = aSpline._x;
     _y = aSpline._y;
-    _b = aSpline._b;
-    _c = aSpline._c;
-    _d = aSpline._d;
+    // The coefficients are immutable, so they are shared instead of copied.
+    _coefficients = aSpline._coefficients;
 }
 //_____________________________________________________________________________
 /**
@@ -324,19 +328,30 @@ void SimmSpline::calcCoefficients()
     int nm1, nm2, i, j;
    double t;
 
-   if (n < 2)
+   if (n < 2) {
+      _coefficients.reset();
       return;
+   }
 
-   _b.setSize(n);
-   _c.setSize(n);
-   _d.setSize(n);
+   // The coefficients are computed into a new buffer, so that copies of this
+   // spline (and their SimTK::Functions) keep sharing the previous ones.
+   auto coefficients = std::make_shared<SimmSplineCoefficients>();
+   coefficients->x.assign(&_x[0], &_x[0] + n);
+   coefficients->y.assign(&_y[0], &_y[0] + n);
+   std::vector<double>& b = coefficients->b;
+   std::vector<double>& c = coefficients->c;
+   std::vector<double>& d = coefficients->d;
+   b.resize(n);
+   c.resize(n);
+   d.resize(n);
 
    if (n == 2)
    {
       t = MAX(TINY_NUMBER,_x[1]-_x[0]);
-      _b[0] = _b[1] = (_y[1]-_y[0])/t;
-      _c[0] = _c[1] = 0.0;
-      _d[0] = _d[1] = 0.0;
+      b[0] = b[1] = (_y[1]-_y[0])/t;
+      c[0] = c[1] = 0.0;
+      d[0] = d[1] = 0.0;
+      _coefficients = std::move(coefficients);
       return;
    }
 
@@ -347,24 +362,24 @@ void SimmSpline::calcCoefficients()
     * b = diagonal, d = offdiagonal, c = right-hand side
     */
 
-   _d[0] = MAX(TINY_NUMBER,_x[1] - _x[0]);
-   _c[1] = (_y[1]-_y[0])/_d[0];
+   d[0] = MAX(TINY_NUMBER,_x[1] - _x[0]);
+   c[1] = (_y[1]-_y[0])/d[0];
    for (i=1; i<nm1; i++)
    {
-      _d[i] = MAX(TINY_NUMBER,_x[i+1] - _x[i]);
-      _b[i] = 2.0*(_d[i-1]+_d[i]);
-      _c[i+1] = (_y[i+1]-_y[i])/_d[i];
-      _c[i] = _c[i+1] - _c[i];
+      d[i] = MAX(TINY_NUMBER,_x[i+1] - _x[i]);
+      b[i] = 2.0*(d[i-1]+d[i]);
+      c[i+1] = (_y[i+1]-_y[i])/d[i];
+      c[i] = c[i+1] - c[i];
    }
 
    /* End conditions. Third derivatives at x[0] and x[n-1]
     * are obtained from divided differences.
     */
 
-   _b[0] = -_d[0];
-   _b[nm1] = -_d[nm2];
-   _c[0] = 0.0;
-   _c[nm1] = 0.0;
+   b[0] = -d[0];
+   b[nm1] = -d[nm2];
+   c[0] = 0.0;
+   c[nm1] = 0.0;
 
    if (n > 3)
    {
@@ -376,43 +391,44 @@ void SimmSpline::calcCoefficients()
       d2 = MAX(TINY_NUMBER,_x[nm2]-_x[n-4]);
       d30 = MAX(TINY_NUMBER,_x[3] - _x[0]);
       d3 = MAX(TINY_NUMBER,_x[nm1]-_x[n-4]);
-      _c[0] = _c[2]/d31 - _c[1]/d20;
-      _c[nm1] = _c[nm2]/d1 - _c[n-3]/d2;
-      _c[0] = _c[0]*_d[0]*_d[0]/d30;
-      _c[nm1] = -_c[nm1]*_d[nm2]*_d[nm2]/d3;
+      c[0] = c[2]/d31 - c[1]/d20;
+      c[nm1] = c[nm2]/d1 - c[n-3]/d2;
+      c[0] = c[0]*d[0]*d[0]/d30;
+      c[nm1] = -c[nm1]*d[nm2]*d[nm2]/d3;
    }
 
    /* Forward elimination */
 
    for (i=1; i<n; i++)
    {
-      t = _d[i-1]/_b[i-1];
-      _b[i] -= t*_d[i-1];
-      _c[i] -= t*_c[i-1];
+      t = d[i-1]/b[i-1];
+      b[i] -= t*d[i-1];
+      c[i] -= t*c[i-1];
    }
 
    /* Back substitution */
 
-   _c[nm1] /= _b[nm1];
+   c[nm1] /= b[nm1];
    for (j=0; j<nm1; j++)
    {
       i = nm2 - j;
-      _c[i] = (_c[i]-_d[i]*_c[i+1])/_b[i];
+      c[i] = (c[i]-d[i]*c[i+1])/b[i];
    }
 
    /* compute polynomial coefficients */
 
-   _b[nm1] = (_y[nm1]-_y[nm2])/_d[nm2] +
-               _d[nm2]*(_c[nm2]+2.0*_c[nm1]);
+   b[nm1] = (_y[nm1]-_y[nm2])/d[nm2] +
+               d[nm2]*(c[nm2]+2.0*c[nm1]);
    for (i=0; i<nm1; i++)
    {
-      _b[i] = (_y[i+1]-_y[i])/_d[i] - _d[i]*(_c[i+1]+2.0*_c[i]);
-      _d[i] = (_c[i+1]-_c[i])/_d[i];
-      _c[i] *= 3.0;
+      b[i] = (_y[i+1]-_y[i])/d[i] - d[i]*(c[i+1]+2.0*c[i]);
+      d[i] = (c[i+1]-c[i])/d[i];
+      c[i] *= 3.0;
    }
-   _c[nm1] *= 3.0;
-   _d[nm1] = _d[nm2];
+   c[nm1] *= 3.0;
+   d[nm1] = d[nm2];
 
+   _coefficients = std::move(coefficients);
 }
 
 double SimmSpline::getX(int aIndex) const
@@ -508,20 +524,18 @@ int SimmSpline::addPoint(double aX, double aY)
     return i;
 }
 
-double SimmSpline::calcValue(const Vector& x) const
+namespace {
+/// Evaluate the spline with the knots x[0..n-1] and the polynomial
+/// coefficients y, b, c, d of its intervals (see calcCoefficients()). This is
+/// shared by SimmSpline and its SimTK::Function, so that both give the same
+/// results.
+double evaluateSpline(int n, const double* x, const double* y,
+        const double* b, const double* c, const double* d, double aX,
+        int aDerivOrder, int& rInterval)
 {
-    // NOT A NUMBER
-    if(!_y.getSize()) return(SimTK::NaN);
-    if(!_b.getSize()) return(SimTK::NaN);
-    if(!_c.getSize()) return(SimTK::NaN);
-    if(!_d.getSize()) return(SimTK::NaN);
-
-    int i, j, k;
+    int k;
     double dx;
 
-    int n = _x.getSize();
-    double aX = x[0];
-
    /* Check if the abscissa is out of range of the function. If it is,
     * then use the slope of the function at the appropriate end point to
     * extrapolate. You do this rather than printing an error because the
@@ -532,142 +546,147 @@ double SimmSpline::calcValue(const Vector& x) const
     * and the coordinate is still out of range, deal with it quietly.
     */
 
-   if (aX < _x[0])
-       return _y[0] + (aX - _x[0])*_b[0];
-   else if (aX > _x[n-1])
-       return _y[n-1] + (aX - _x[n-1])*_b[n-1];
-
-   /* Check to see if the abscissa is close to one of the end points
-    * (the binary search method doesn't work well if you are at one of the
-    * end points.
-    */
-   if (EQUAL_WITHIN_ERROR(aX,_x[0]))
-       return _y[0];
-   else if (EQUAL_WITHIN_ERROR(aX,_x[n-1]))
-       return _y[n-1];
-
-    if (n < 3)
-    {
-        /* If there are only 2 function points, then set k to zero
-         * (you've already checked to see if the abscissa is out of
-         * range or equal to one of the endpoints).
-         */
-        k = 0;
-    }
-    else
-    {
-        /* Do a binary search to find which two points the abscissa is between. */
-        i = 0;
-        j = n;
-        while (1)
-        {
-            k = (i+j)/2;
-            if (aX < _x[k])
-                j = k;
-            else if (aX > _x[k+1])
-                i = k;
-            else
-                break;
-        }
-    }
-
-   dx = aX - _x[k];
-   return _y[k] + dx*(_b[k] + dx*(_c[k] + dx*_d[k]));
-}
-
-double SimmSpline::calcDerivative(const std::vector<int>& derivComponents, const Vector& x) const
-{
-    // NOT A NUMBER
-    if(!_y.getSize()) return(SimTK::NaN);
-    if(!_b.getSize()) return(SimTK::NaN);
-    if(!_c.getSize()) return(SimTK::NaN);
-    if(!_d.getSize()) return(SimTK::NaN);
-
-    int i, j, k;
-    double dx;
-
-    int n = _x.getSize();
-    double aX = x[0];
-    int aDerivOrder = (int)derivComponents.size();
-    if (aDerivOrder < 1 || aDerivOrder > 2)
-        throw Exception("SimmSpline::calcDerivative(): derivative order must be 1 or 2.");
-
-   /* Check if the abscissa is out of range of the function. If it is,
-    * then use the slope of the function at the appropriate end point to
-    * extrapolate. You do this rather than printing an error because the
-    * assumption is that this will only occur in relatively harmless
-    * situations (like a motion file that contains an out-of-range coordinate
-    * value). The rest of the SIMM code has many checks to clamp a coordinate
-    * value within its range of motion, so if you make it to this function
-    * and the coordinate is still out of range, deal with it quietly.
-    */
-
-   if (aX < _x[0])
+   if (aX < x[0])
    {
-      if (aDerivOrder == 1)
-         return _b[0];
+      if (aDerivOrder == 0)
+         return y[0] + (aX - x[0])*b[0];
+      else if (aDerivOrder == 1)
+         return b[0];
       else
          return 0;
    }
-   else if (aX > _x[n-1])
+   else if (aX > x[n-1])
    {
-      if (aDerivOrder == 1)
-         return _b[n-1];
+      if (aDerivOrder == 0)
+         return y[n-1] + (aX - x[n-1])*b[n-1];
+      else if (aDerivOrder == 1)
+         return b[n-1];
       else
          return 0;
    }
 
    /* Check to see if the abscissa is close to one of the end points
-    * (the binary search method doesn't work well if you are at one of the
-    * end points.
+    * (the interval search doesn't need to be done if you are at one of the
+    * end points).
     */
-   if (EQUAL_WITHIN_ERROR(aX,_x[0]))
+   if (EQUAL_WITHIN_ERROR(aX,x[0]))
    {
-      if (aDerivOrder == 1)
-         return _b[0];
+      if (aDerivOrder == 0)
+         return y[0];
+      else if (aDerivOrder == 1)
+         return b[0];
       else
-         return 2.0*_c[0];
+         return 2.0*c[0];
    }
-   else if (EQUAL_WITHIN_ERROR(aX,_x[n-1]))
+   else if (EQUAL_WITHIN_ERROR(aX,x[n-1]))
    {
-      if (aDerivOrder == 1)
-         return _b[n-1];
+      if (aDerivOrder == 0)
+         return y[n-1];
+      else if (aDerivOrder == 1)
+         return b[n-1];
       else
-         return 2.0*_c[n-1];
+         return 2.0*c[n-1];
    }
 
-    if (n < 3)
-    {
-        /* If there are only 2 function points, then set k to zero
-         * (you've already checked to see if the abscissa is out of
-         * range or equal to one of the endpoints).
-         */
-        k = 0;
+    /* Find which two points the abscissa is between, starting the search
+     * from the interval of the previous evaluation. With only 2 function
+     * points, this is always the first interval.
+     */
+    rInterval = findInterval(x, n, aX, rInterval);
+    k = rInterval;
+
+   dx = aX - x[k];
+
+   if (aDerivOrder == 0)
+      return y[k] + dx*(b[k] + dx*(c[k] + dx*d[k]));
+   else if (aDerivOrder == 1)
+      return (b[k] + dx*(2.0*c[k] + 3.0*dx*d[k]));
+   else
+      return (2.0*c[k] + 6.0*dx*d[k]);
+}
+
+/// The SimTK::Function of a SimmSpline (e.g., for the TransformAxis of a
+/// CustomJoint). It shares the knots and coefficients of the spline and
+/// evaluates them directly, without converting the arguments for the
+/// OpenSim::Function interface (as FunctionAdapter does) on each call.
+class SimmSplineFunction : public SimTK::Function {
+public:
+    SimmSplineFunction(
+            std::shared_ptr<const SimmSplineCoefficients> coefficients)
+            : _coefficients(std::move(coefficients)), _intervalHint(0) {}
+    double calcValue(const Vector& x) const override {
+        return evaluate(x[0], 0);
     }
-    else
-    {
-        /* Do a binary search to find which two points the abscissa is between. */
-        i = 0;
-        j = n;
-        while (1)
-        {
-            k = (i+j)/2;
-            if (aX < _x[k])
-                j = k;
-            else if (aX > _x[k+1])
-                i = k;
-            else
-                break;
-        }
+    double calcDerivative(const SimTK::Array_<int>& derivComponents,
+            const Vector& x) const override {
+        const int derivOrder = (int)derivComponents.size();
+        if (derivOrder < 1 || derivOrder > 2)
+            throw Exception("SimmSpline::calcDerivative(): derivative order "
+                            "must be 1 or 2.");
+        return evaluate(x[0], derivOrder);
+    }
+    int getArgumentSize() const override { return 1; }
+    int getMaxDerivativeOrder() const override { return 2; }
+private:
+    double evaluate(double x, int derivOrder) const {
+        // As in SimmSpline::evaluate(), the spline is NaN without its
+        // coefficients.
+        if (!_coefficients) return SimTK::NaN;
+        const SimmSplineCoefficients& k = *_coefficients;
+        int interval = _intervalHint.load(std::memory_order_relaxed);
+        const double value = evaluateSpline((int)k.x.size(), k.x.data(),
+                k.y.data(), k.b.data(), k.c.data(), k.d.data(), x, derivOrder,
+                interval);
+        _intervalHint.store(interval, std::memory_order_relaxed);
+        return value;
     }
+    std::shared_ptr<const SimmSplineCoefficients> _coefficients;
+    mutable std::atomic<int> _intervalHint;
+};
+} // anonymous namespace
 
-   dx = aX - _x[k];
+double SimmSpline::calcValue(const Vector& x) const
+{
+    int interval = _intervalHint.load(std::memory_order_relaxed);
+    const double value = evaluate(x[0], 0, interval);
+    _intervalHint.store(interval, std::memory_order_relaxed);
+    return value;
+}
 
-   if (aDerivOrder == 1)
-      return (_b[k] + dx*(2.0*_c[k] + 3.0*dx*_d[k]));
+double SimmSpline::calcDerivative(const std::vector<int>& derivComponents, const Vector& x) const
+{
+    int aDerivOrder = (int)derivComponents.size();
+    if (aDerivOrder < 1 || aDerivOrder > 2)
+        throw Exception("SimmSpline::calcDerivative(): derivative order must be 1 or 2.");
 
-   else
-      return (2.0*_c[k] + 6.0*dx*_d[k]);
+    int interval = _intervalHint.load(std::memory_order_relaxed);
+    const double value = evaluate(x[0], aDerivOrder, interval);
+    _intervalHint.store(interval, std::memory_order_relaxed);
+    return value;
+}
+
+void SimmSpline::evaluate(const Vector& aX, int aDerivOrder,
+        Vector& rValues) const
+{
+    if (aDerivOrder < 0 || aDerivOrder > 2)
+        throw Exception("SimmSpline::evaluate(): derivative order must be 0, 1, or 2.");
+
+    rValues.resize(aX.size());
+    int interval = _intervalHint.load(std::memory_order_relaxed);
+    for (int i = 0; i < aX.size(); ++i)
+        rValues[i] = evaluate(aX[i], aDerivOrder, interval);
+    _intervalHint.store(interval, std::memory_order_relaxed);
+}
+
+double SimmSpline::evaluate(double aX, int aDerivOrder, int& rInterval) const
+{
+    // NOT A NUMBER
+    if(!_y.getSize()) return(SimTK::NaN);
+    if(!_coefficients) return(SimTK::NaN);
+
+    const SimmSplineCoefficients& k = *_coefficients;
+    return evaluateSpline((int)k.x.size(), k.x.data(), k.y.data(),
+            k.b.data(), k.c.data(), k.d.data(), aX, aDerivOrder, rInterval);
 }
 
 int SimmSpline::getArgumentSize() const
@@ -681,5 +700,5 @@ int SimmSpline::getMaxDerivativeOrder() const
 }
 
 SimTK::Function* SimmSpline::createSimTKFunction() const {
-    return new FunctionAdapter(*this);
+    return new SimmSplineFunction(_coefficients);
 }
@@ -31,11 +31,16 @@
 #include "PropertyDblArray.h"
 #include "Function.h"
 
+#include <atomic>
+#include <memory>
+
 
 //=============================================================================
 //=============================================================================
 namespace OpenSim { 
 
+struct SimmSplineCoefficients;
+
 /**
  * A class implementing a smooth function with a cubic spline as 
  * implemented in SIMM. Use a SIMM Spline if you want to reproduce
@@ -65,9 +70,15 @@ protected:
     Array<double> &_y;
 
 private:
-    Array<double> _b;
-    Array<double> _c;
-    Array<double> _d;
+    /** The knots and polynomial coefficients of the spline, computed by
+    calcCoefficients(). They are never modified, only replaced, so that they
+    are shared by the copies of the spline and their SimTK::Functions instead
+    of being copied with each clone of a model. */
+    std::shared_ptr<const SimmSplineCoefficients> _coefficients;
+    /** Knot interval found by the last evaluation, where the search for the
+    interval of the next evaluation starts. This is atomic so that concurrent
+    evaluations are safe; they can only make the hint less effective. */
+    mutable std::atomic<int> _intervalHint;
 
 //=============================================================================
 // METHODS
@@ -123,11 +134,27 @@ public:
     int getArgumentSize() const override;
     int getMaxDerivativeOrder() const override;
     SimTK::Function* createSimTKFunction() const override;
+    /**
+     * Evaluate the spline or one of its derivatives at each of a sequence
+     * of values of the independent variable. The search for the knot
+     * interval containing each value starts from the interval of the
+     * previous value, so this is fastest when the values are sorted.
+     *
+     * @param aX Values of the independent variable.
+     * @param aDerivOrder Order of the derivative (0, 1, or 2).
+     * @param rValues Resized to the size of aX and set to the values of the
+     * spline or of its derivative.
+     */
+    void evaluate(const SimTK::Vector& aX, int aDerivOrder,
+            SimTK::Vector& rValues) const;
 
     void updateFromXMLNode(SimTK::Xml::Element& aNode, int versionNumber=-1) override;
 
 private:
     void calcCoefficients();
+    /** Evaluate starting the interval search at rInterval, which is updated
+    to the interval containing aX. */
+    double evaluate(double aX, int aDerivOrder, int& rInterval) const;
 //=============================================================================
 };  // END class SimmSpline
 
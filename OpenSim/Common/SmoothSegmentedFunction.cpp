@@ -45,6 +45,10 @@ static double INTTOL = (double)SimTK::Eps*1e2;
 static int MAXITER = 20;
 static constexpr int NUM_SAMPLE_PTS = 100;
 static_assert(NUM_SAMPLE_PTS>0, "SmoothSegmentedFunction::NUM_SAMPLE_PTS must be larger than zero.");
+// With a cubic interpolant on 63 intervals per Bezier section, the initial
+// guess for u is usually accurate enough for the Newton iteration in calcU()
+// to converge in one step.
+static constexpr int NUM_TABLE_PTS = 64;
 
 //=============================================================================
 // PARAMETERS
@@ -215,6 +219,11 @@ struct SmoothSegmentedFunctionData
     /**Array of spline fit functions X(u) for each Bezier elbow*/
     SimTK::Array_<SimTK::Spline> _arraySplineUX;
 
+    /**Array of tables of u(x) for each Bezier elbow, from which the curve
+    evaluations compute the initial guess for u (see
+    SegmentedQuinticBezierToolkit::createUOfXTable())*/
+    SimTK::Array_<SegmentedQuinticBezierToolkit::UOfXTable> _arrayTableUX;
+
     /**Spline fit of the integral of the curve y(x)*/
     SimTK::Spline _splineYintX;
 
@@ -424,6 +433,7 @@ SmoothSegmentedFunctionData::SmoothSegmentedFunctionData(
     //Used to generate the set of knot points of the integral of y(x)    
    SimTK::Vector xALL(NUM_SAMPLE_PTS*_numBezierSections-(_numBezierSections-1));
     _arraySplineUX.resize(_numBezierSections);
+    _arrayTableUX.resize(_numBezierSections);
     int xidx = 0;
 
     for(int s=0; s < _numBezierSections; s++){
@@ -448,6 +458,8 @@ SmoothSegmentedFunctionData::SmoothSegmentedFunctionData(
         //Create the array of approximate inverses for u(x)    
         _arraySplineUX[s] = SimTK::SplineFitter<Real>::
             fitForSmoothingParameter(3,x,u,0).getSpline();
+        _arrayTableUX[s] = SegmentedQuinticBezierToolkit::createUOfXTable(
+            _ctrlPtsX[s], _arraySplineUX[s], NUM_TABLE_PTS, UTOL, MAXITER);
     }
 
     if(computeIntegral){
@@ -541,8 +553,8 @@ ________________________________________________________________________
 
 double SmoothSegmentedFunction::calcValue(double x) const
 {
-    const SimTK::Array_<SimTK::Spline>& arraySplineUX =
-    _smoothData->_arraySplineUX;
+    const SimTK::Array_<SegmentedQuinticBezierToolkit::UOfXTable>&
+    arrayTableUX = _smoothData->_arrayTableUX;
     const SimTK::Array_<SimTK::Vec6>& ctrlPtsX = _smoothData->_ctrlPtsX;
     const SimTK::Array_<SimTK::Vec6>& ctrlPtsY = _smoothData->_ctrlPtsY;
     double x0 = _smoothData->_x0;
@@ -558,7 +570,7 @@ double SmoothSegmentedFunction::calcValue(double x) const
     {
         int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,ctrlPtsX);
         double u = SegmentedQuinticBezierToolkit::
-                 calcU(x,ctrlPtsX[idx], arraySplineUX[idx], UTOL,MAXITER);
+                 calcU(x,ctrlPtsX[idx], arrayTableUX[idx], UTOL,MAXITER);
         yVal = SegmentedQuinticBezierToolkit::
                  calcQuinticBezierCurveVal(u,ctrlPtsY[idx]);
     }else{
@@ -619,8 +631,8 @@ double SmoothSegmentedFunction::calcDerivative(double x, int order) const
 
     //QUINTIC SPLINE
 
-    const SimTK::Array_<SimTK::Spline>& arraySplineUX =
-    _smoothData->_arraySplineUX;
+    const SimTK::Array_<SegmentedQuinticBezierToolkit::UOfXTable>&
+    arrayTableUX = _smoothData->_arrayTableUX;
     const SimTK::Array_<SimTK::Vec6>& ctrlPtsX = _smoothData->_ctrlPtsX;
     const SimTK::Array_<SimTK::Vec6>& ctrlPtsY = _smoothData->_ctrlPtsY;
     double x0 = _smoothData->_x0;
@@ -634,7 +646,7 @@ double SmoothSegmentedFunction::calcDerivative(double x, int order) const
             if(x >= x0 && x <= x1){
                 int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,ctrlPtsX);
                 double u = SegmentedQuinticBezierToolkit::
-                                calcU(x,ctrlPtsX[idx], arraySplineUX[idx],
+                                calcU(x,ctrlPtsX[idx], arrayTableUX[idx],
                                 UTOL,MAXITER);
                 yVal = SegmentedQuinticBezierToolkit::
                             calcQuinticBezierCurveDerivDYDX(u, ctrlPtsX[idx],
@@ -658,6 +670,61 @@ double SmoothSegmentedFunction::calcDerivative(double x, int order) const
 
 
 
+SimTK::Vec3 SmoothSegmentedFunction::calcValueAndDerivatives(double x,
+                                                             int maxOrder) const
+{
+    SimTK_ERRCHK2_ALWAYS( maxOrder >= 0 && maxOrder <= 2,
+        "SmoothSegmentedFunction::calcValueAndDerivatives",
+        "%s: maxOrder must be 0, 1, or 2, but %i was entered",
+        _name.c_str(), maxOrder);
+
+    const SimTK::Array_<SegmentedQuinticBezierToolkit::UOfXTable>&
+    arrayTableUX = _smoothData->_arrayTableUX;
+    const SimTK::Array_<SimTK::Vec6>& ctrlPtsX = _smoothData->_ctrlPtsX;
+    const SimTK::Array_<SimTK::Vec6>& ctrlPtsY = _smoothData->_ctrlPtsY;
+    double x0 = _smoothData->_x0;
+    double x1 = _smoothData->_x1;
+
+    SimTK::Vec3 result(SimTK::NaN);
+
+    if(x >= x0 && x <= x1){
+        int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,ctrlPtsX);
+        double u = SegmentedQuinticBezierToolkit::
+                        calcU(x,ctrlPtsX[idx], arrayTableUX[idx],
+                        UTOL,MAXITER);
+        const SimTK::Vec6& xpts = ctrlPtsX[idx];
+        const SimTK::Vec6& ypts = ctrlPtsY[idx];
+        result[0] = SegmentedQuinticBezierToolkit::
+                        calcQuinticBezierCurveVal(u,ypts);
+        if(maxOrder >= 1){
+            double dxdu  = SegmentedQuinticBezierToolkit::
+                            calcQuinticBezierCurveDerivU(u,xpts,1);
+            double dydu  = SegmentedQuinticBezierToolkit::
+                            calcQuinticBezierCurveDerivU(u,ypts,1);
+            // Same as calcQuinticBezierCurveDerivDYDX() for orders 1 and 2.
+            result[1] = dydu/dxdu;
+            if(maxOrder >= 2){
+                double d2xdu2= SegmentedQuinticBezierToolkit::
+                                calcQuinticBezierCurveDerivU(u,xpts,2);
+                double d2ydu2= SegmentedQuinticBezierToolkit::
+                                calcQuinticBezierCurveDerivU(u,ypts,2);
+                double t1 = 0.1e1 / dxdu;
+                double t3 = dxdu*dxdu;
+                result[2] = (d2ydu2 * t1 - dydu / t3 * d2xdu2) * t1;
+            }
+        }
+        return result;
+    }
+
+    double xEnd    = x < x0 ? x0 : x1;
+    double yEnd    = x < x0 ? _smoothData->_y0 : _smoothData->_y1;
+    double dydxEnd = x < x0 ? _smoothData->_dydx0 : _smoothData->_dydx1;
+    result[0] = yEnd + dydxEnd*(x-xEnd);
+    if(maxOrder >= 1) result[1] = dydxEnd;
+    if(maxOrder >= 2) result[2] = 0;
+    return result;
+}
+
 double SmoothSegmentedFunction::
     calcDerivative(const SimTK::Array_<int>& derivComponents,
                  const SimTK::Vector& ax) const
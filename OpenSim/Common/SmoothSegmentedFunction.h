@@ -137,6 +137,28 @@ namespace OpenSim {
        */
        double calcDerivative(double x, int order) const;       
 
+       /**Calculates the value and the first and second derivatives of the 
+       curve this object represents, with a single search for the Bezier 
+       section that contains x and a single solve for the Bezier parameter u.
+       This is cheaper than calling calcValue() and calcDerivative() 
+       separately, which repeat the search and the solve (e.g., in the Newton 
+       iterations of muscle equilibrium solvers).
+
+       @param x         The domain point of interest.
+       @param maxOrder  The highest order of derivative to compute (0, 1, 
+                        or 2); the derivatives of higher order are NaN.
+       @throws OpenSim::Exception
+        -If maxOrder is not 0, 1, or 2
+       @return          [y(x), dy/dx, d^2y/dx^2]
+
+       <B>Computational Costs</B>
+       \verbatim
+            x in curve domain  : ~370 (maxOrder 1) to ~450 (maxOrder 2) flops
+            x in linear section:   ~5 flops
+       \endverbatim
+       */
+       SimTK::Vec3 calcValueAndDerivatives(double x, int maxOrder = 2) const;
+
 #ifndef SWIG
        /// Allow the more general calcDerivative from the base class to be used.
        // This helps avoid the -Woverloaded-virtual warning with Clang.
@@ -0,0 +1,149 @@
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  StateVariableAccessor.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "StateVariableAccessor.h"
+
+using namespace OpenSim;
+
+StateVariableAccessor::StateVariableAccessor(const Component& component,
+        const SimTK::State& state) {
+    OPENSIM_THROW_IF(!component.hasSystem(), ComponentHasNoSystem, component);
+    const Array<std::string> names = component.getStateVariableNames();
+    _paths.reserve(names.size());
+    for (int i = 0; i < names.size(); ++i) _paths.push_back(names[i]);
+    resolve(component, state);
+}
+
+StateVariableAccessor::StateVariableAccessor(const Component& component,
+        const SimTK::State& state, const std::vector<std::string>& paths)
+        : _paths(paths) {
+    OPENSIM_THROW_IF(!component.hasSystem(), ComponentHasNoSystem, component);
+    resolve(component, state);
+}
+
+void StateVariableAccessor::resolve(const Component& component,
+        const SimTK::State& state) {
+    const int n = getNumStateVariables();
+    _numY = state.getNY();
+    std::vector<const Component::StateVariable*> svs(n);
+    for (int i = 0; i < n; ++i) {
+        svs[i] = component.traverseToStateVariable(_paths[i]);
+        OPENSIM_THROW_IF(!svs[i], Exception,
+                "State variable '{}' not found in {} '{}'.", _paths[i],
+                component.getConcreteClassName(),
+                component.getAbsolutePathString());
+    }
+
+    // Find the slot of each state variable in Y: give each slot a distinct
+    // value, and accept a slot only if the state variable reports the same
+    // slot for a second assignment of values.
+    SimTK::State probe = state;
+    const auto slotValue = [](int iy, int trial) {
+        return trial == 0 ? iy + 1.0 : -0.5 * (iy + 1.0);
+    };
+    _yIndices.assign(n, -1);
+    for (int iy = 0; iy < _numY; ++iy) probe.updY()[iy] = slotValue(iy, 0);
+    for (int i = 0; i < n; ++i) {
+        const double value = svs[i]->getValue(probe);
+        const int iy = (int)value - 1;
+        if (iy >= 0 && iy < _numY && value == slotValue(iy, 0)) {
+            _yIndices[i] = iy;
+        }
+    }
+    for (int iy = 0; iy < _numY; ++iy) probe.updY()[iy] = slotValue(iy, 1);
+    for (int i = 0; i < n; ++i) {
+        const int iy = _yIndices[i];
+        if (iy < 0) continue;
+        if (svs[i]->getValue(probe) != slotValue(iy, 1)) _yIndices[i] = -1;
+    }
+
+    _stateVariables.assign(n, nullptr);
+    for (int i = 0; i < n; ++i) {
+        if (_yIndices[i] < 0) _stateVariables[i] = svs[i];
+    }
+}
+
+void StateVariableAccessor::checkState(const SimTK::State& state) const {
+    OPENSIM_THROW_IF(state.getNY() != _numY, Exception,
+            "Expected a state with {} continuous state variables, but it has "
+            "{}; the accessor must be created for the current System.",
+            _numY, state.getNY());
+}
+
+void StateVariableAccessor::getValues(const SimTK::State& state,
+        double* values) const {
+    checkState(state);
+    const SimTK::Vector& y = state.getY();
+    const int n = getNumStateVariables();
+    for (int i = 0; i < n; ++i) {
+        const int iy = _yIndices[i];
+        values[i] = iy >= 0 ? y[iy] : _stateVariables[i]->getValue(state);
+    }
+}
+
+void StateVariableAccessor::getValues(const SimTK::State& state,
+        SimTK::Vector& values) const {
+    checkState(state);
+    const int n = getNumStateVariables();
+    if (values.size() != n) values.resize(n);
+    const SimTK::Vector& y = state.getY();
+    for (int i = 0; i < n; ++i) {
+        const int iy = _yIndices[i];
+        values[i] = iy >= 0 ? y[iy] : _stateVariables[i]->getValue(state);
+    }
+}
+
+SimTK::Vector StateVariableAccessor::getValues(
+        const SimTK::State& state) const {
+    SimTK::Vector values(getNumStateVariables());
+    getValues(state, values);
+    return values;
+}
+
+void StateVariableAccessor::setValues(SimTK::State& state,
+        const double* values) const {
+    checkState(state);
+    const int n = getNumStateVariables();
+    SimTK::Vector& y = state.updY();
+    for (int i = 0; i < n; ++i) {
+        if (_yIndices[i] >= 0) y[_yIndices[i]] = values[i];
+    }
+    for (int i = 0; i < n; ++i) {
+        if (_yIndices[i] < 0) _stateVariables[i]->setValue(state, values[i]);
+    }
+}
+
+void StateVariableAccessor::setValues(SimTK::State& state,
+        const SimTK::Vector& values) const {
+    OPENSIM_THROW_IF(values.size() != getNumStateVariables(), Exception,
+            "Expected {} values, but got {}.", getNumStateVariables(),
+            values.size());
+    checkState(state);
+    const int n = getNumStateVariables();
+    SimTK::Vector& y = state.updY();
+    for (int i = 0; i < n; ++i) {
+        if (_yIndices[i] >= 0) y[_yIndices[i]] = values[i];
+    }
+    for (int i = 0; i < n; ++i) {
+        if (_yIndices[i] < 0) _stateVariables[i]->setValue(state, values[i]);
+    }
+}
@@ -0,0 +1,113 @@
+#ifndef OPENSIM_STATE_VARIABLE_ACCESSOR_H_
+#define OPENSIM_STATE_VARIABLE_ACCESSOR_H_
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  StateVariableAccessor.h                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Component.h"
+
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+/**
+ * Reads (gathers) and writes (scatters) the values of a fixed list of state
+ * variables of a Component in bulk. The paths of the state variables are
+ * resolved once, when the accessor is created, to their indices in
+ * SimTK::State::getY(), so that getValues() and setValues() only copy
+ * numbers between the state and a contiguous buffer, without looking up
+ * names or calling the virtual accessors of each state variable. This is
+ * useful when the same state variables are read at every time step, e.g.,
+ * by reporters.
+ *
+ * @code
+ * SimTK::State& state = model.initSystem();
+ * StateVariableAccessor accessor(model, state,
+ *         {"/jointset/knee/knee_angle/value", "/forceset/soleus/activation"});
+ * SimTK::Vector values;
+ * for (...) {
+ *     accessor.getValues(state, values);
+ *     ...
+ * }
+ * @endcode
+ *
+ * The accessor is valid for states of the System the Component was part of
+ * when the accessor was created; create a new accessor after calling
+ * initSystem() again. A state variable whose value is not stored in a single
+ * slot of Y is read and written through the state variable itself.
+ */
+class OSIMCOMMON_API StateVariableAccessor {
+public:
+    StateVariableAccessor() = default;
+
+    /** Access all state variables of `component` and its subcomponents, in
+    the order of Component::getStateVariableNames(). `state` must be a state
+    of the System to which `component` has been added (e.g., the state
+    returned by Model::initSystem()). */
+    StateVariableAccessor(const Component& component,
+            const SimTK::State& state);
+
+    /** Access the state variables with the given paths (see
+    Component::getStateVariableValue()), in the given order. Throws an
+    exception if a path does not refer to a state variable. */
+    StateVariableAccessor(const Component& component,
+            const SimTK::State& state, const std::vector<std::string>& paths);
+
+    int getNumStateVariables() const { return (int)_paths.size(); }
+    /** The paths of the state variables, as provided to the constructor (or
+    as returned by Component::getStateVariableNames()). */
+    const std::vector<std::string>& getStateVariablePaths() const {
+        return _paths;
+    }
+    /** The index of state variable `i` in SimTK::State::getY(), or -1 if its
+    value is not stored in a single slot of Y. */
+    int getSystemYIndex(int i) const { return _yIndices[i]; }
+
+    /** Copy the values of the state variables into `values`, which must have
+    room for getNumStateVariables() elements. */
+    void getValues(const SimTK::State& state, double* values) const;
+    /** Same as above; `values` is resized if necessary. */
+    void getValues(const SimTK::State& state, SimTK::Vector& values) const;
+    SimTK::Vector getValues(const SimTK::State& state) const;
+
+    /** Set the values of the state variables from `values`, which must have
+    getNumStateVariables() elements. The values are written directly into
+    Y, so, unlike Component::setStateVariableValue(), this also changes the
+    values of locked coordinates. */
+    void setValues(SimTK::State& state, const double* values) const;
+    /** Same as above; throws an exception if `values` has the wrong size. */
+    void setValues(SimTK::State& state, const SimTK::Vector& values) const;
+
+private:
+    void resolve(const Component& component, const SimTK::State& state);
+    void checkState(const SimTK::State& state) const;
+
+    std::vector<std::string> _paths;
+    std::vector<int> _yIndices;
+    // Only for the state variables whose y index is -1.
+    std::vector<const Component::StateVariable*> _stateVariables;
+    int _numY = 0;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_STATE_VARIABLE_ACCESSOR_H_
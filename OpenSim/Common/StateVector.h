@@ -71,6 +71,7 @@ private:
 public:
     StateVector()                   = default;
     StateVector(const StateVector&) = default;
+    StateVector(StateVector&&)      = default;
     virtual ~StateVector();
 
     StateVector(double aT);
@@ -85,6 +86,7 @@ private:
 public:
 #ifndef SWIG
     StateVector& operator=(const StateVector &aStateVector);
+    StateVector& operator=(StateVector&&) = default;
     bool operator==(const StateVector &aStateVector) const;
     bool operator<(const StateVector &aStateVector) const;
     friend std::ostream& operator<<(std::ostream &aOut,
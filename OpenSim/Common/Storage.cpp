@@ -42,6 +42,7 @@
 #include "StateVector.h"
 #include "TableUtilities.h"
 #include "TimeSeriesTable.h"
+#include <algorithm>
 #include <iostream>
 
 using namespace OpenSim;
@@ -50,55 +51,62 @@ using namespace std;
 void convertTableToStorage(const AbstractDataTable* table, Storage& sto)
 {
     sto.purge();
-    TimeSeriesTable out;
+    TimeSeriesTable flattened;
+    const TimeSeriesTable* out = &flattened;
 
     if (auto td = dynamic_cast<const TimeSeriesTable*>(table))
-        // Table is already flattened, so clone for further processing
-        out = TimeSeriesTable{ *td };
+        // Table is already flattened, so use it directly
+        out = td;
     else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec2>*>(table))
-        out = tst->flatten();
+        flattened = tst->flatten();
     else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec3>*>(table))
-        out = tst->flatten({ "_x", "_y", "_z" });
+        flattened = tst->flatten({ "_x", "_y", "_z" });
     else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec4>*>(table))
-        out = tst->flatten();
+        flattened = tst->flatten();
     else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec5>*>(table))
-        out = tst->flatten();
+        flattened = tst->flatten();
     else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec6>*>(table))
-        out = tst->flatten();
+        flattened = tst->flatten();
     else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec7>*>(table))
-        out = tst->flatten();
+        flattened = tst->flatten();
     else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec8>*>(table))
-        out = tst->flatten();
+        flattened = tst->flatten();
     else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec9>*>(table))
-        out = tst->flatten();
+        flattened = tst->flatten();
     else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec<10>>*>(table))
-        out = tst->flatten();
+        flattened = tst->flatten();
     else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec<11>>*>(table))
-        out = tst->flatten();
+        flattened = tst->flatten();
     else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec<12>>*>(table))
-        out = tst->flatten();
+        flattened = tst->flatten();
     else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::UnitVec3>*>(table))
-        out = tst->flatten({ "_x", "_y", "_z" });
+        flattened = tst->flatten({ "_x", "_y", "_z" });
     else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Quaternion>*>(table))
-        out = tst->flatten();
+        flattened = tst->flatten();
     else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::SpatialVec>*>(table))
-        out = tst->flatten({ "_rx", "_ry", "_rz", "_tx", "_ty", "_tz" });
+        flattened = tst->flatten({ "_rx", "_ry", "_rz", "_tx", "_ty", "_tz" });
     else {
         OPENSIM_THROW( STODataTypeNotSupported, typeid(table).name());
     }
 
-    OpenSim::Array<std::string> labels("", (int)out.getNumColumns() + 1);
+    const int ncol = (int)out->getNumColumns();
+    OpenSim::Array<std::string> labels("", ncol + 1);
     labels[0] = "time";
-    for (int i = 0; i < (int)out.getNumColumns(); ++i) {
-        labels[i + 1] = out.getColumnLabel(i);
+    for (int i = 0; i < ncol; ++i) {
+        labels[i + 1] = out->getColumnLabel(i);
     }
     sto.setColumnLabels(labels);
 
-    const auto& times = out.getIndependentColumn();
-    for (unsigned i_time = 0; i_time < out.getNumRows(); ++i_time) {
-        const SimTK::Vector rowVector =
-            out.getRowAtIndex(i_time).transpose().getAsVector();
-        sto.append(times[i_time], rowVector);
+    // Allocate all the rows at once, and copy each row of the matrix
+    // directly instead of through a temporary row vector.
+    const auto& times = out->getIndependentColumn();
+    const auto& matrix = out->getMatrix();
+    const int nrow = (int)out->getNumRows();
+    sto.ensureCapacity(nrow);
+    std::vector<double> row(ncol);
+    for (int i_time = 0; i_time < nrow; ++i_time) {
+        for (int j = 0; j < ncol; ++j) row[j] = matrix(i_time, j);
+        sto.append(times[i_time], ncol, row.data());
     }
 }
 
@@ -168,6 +176,20 @@ Storage::Storage(int aCapacity,const string &aName) :
     setName(aName);
 }
 //_____________________________________________________________________________
+/*
+ * Construct a Storage instance from a TimeSeriesTable.
+ */
+Storage::Storage(const TimeSeriesTable& table, const string &aName) :
+    Storage(Storage_DEFAULT_CAPACITY, aName)
+{
+    convertTableToStorage(&table, *this);
+    const auto& metaData = table.getTableMetaData();
+    if (metaData.hasKey("inDegrees")) {
+        _inDegrees = metaData.getValueForKey("inDegrees")
+                .getValue<std::string>() == "yes";
+    }
+}
+//_____________________________________________________________________________
 /*
  * Construct an Storage instance from file.
  *
@@ -1347,13 +1369,25 @@ TimeSeriesTable Storage::exportToTable() const {
                 _columnLabels.get() + _columnLabels.getSize());
     }
 
-    for(int i = 0; i < _storage.getSize(); ++i) {
-        const auto& row = getStateVector(i)->getData();
-        const auto time = getStateVector(i)->getTime();
-        // Exclude the first column. It is 'time'. Time is a separate column in
-        // TimeSeriesTable.
-        table.appendRow(time, row.get(), row.get() + row.getSize());
+    const int nrow = _storage.getSize();
+    if (nrow == 0) return table;
+
+    // Fill the times and the matrix of the table directly and append them at
+    // once, rather than reallocating the matrix for each row.
+    const int ncol = _columnLabels.getSize() > 1 ? _columnLabels.getSize() - 1
+                                                 : _storage[0].getSize();
+    std::vector<double> times(nrow);
+    SimTK::Matrix data(nrow, ncol);
+    for(int i = 0; i < nrow; ++i) {
+        const StateVector& vec = _storage[i];
+        OPENSIM_THROW_IF(vec.getSize() != ncol, IncorrectNumColumns,
+                static_cast<size_t>(ncol),
+                static_cast<size_t>(vec.getSize()));
+        times[i] = vec.getTime();
+        const double* row = vec.getData().get();
+        for(int j = 0; j < ncol; ++j) data(i, j) = row[j];
     }
+    table.appendRows(times, data);
 
     return table;
 }
@@ -1487,8 +1521,17 @@ append(double aT,int aN,const double *aY,bool aCheckForDuplicateTime)
     if(aN<0) return(_storage.getSize());
 
     // APPEND
+    // The new state vector is moved (not copied) into the storage.
     StateVector vec(aT, SimTK::Vector_<double>(aN, aY));
-    append(vec,aCheckForDuplicateTime);
+    if(aCheckForDuplicateTime && _storage.getSize() && _storage.getLast().getTime()==aT)
+        _storage.updLast() = std::move(vec);
+    else
+        _storage.append(std::move(vec));
+
+    if (_fp!=0){
+        _storage.getLast().print(_fp);
+        fflush(_fp);
+    }
     // TODO: use some tolerance when checking for duplicate time?
     /*
     if(aCheckForDuplicateTime && _storage.getSize() && _storage.getLast().getTime()==vec.getTime())
@@ -2476,10 +2519,11 @@ lowpassFIR(int aOrder,double aCutoffFrequency)
  * Find the index of the storage element that occurred immediately before
  * or at time aT ( aT <= getTime(index) ).
  *
- * This method can be much more efficient than findIndex(aT) if a good guess
- * is made for aI.
- * If aI corresponds to a state which occurred later than aT, an exhaustive
- * search is performed by calling findIndex(aT).
+ * The search first checks the interval starting at aI and the next one, and
+ * only bisects the remaining state vectors if aT is in neither, so it is
+ * fast if aI is a good guess (e.g., the result of the previous search).
+ * If aI corresponds to a state which occurred later than aT, the search
+ * starts at the first state.
  *
  * @param aI Index at which to start searching.
  * @param aT Time.
@@ -2490,15 +2534,24 @@ int Storage::
 findIndex(int aI,double aT) const
 {
     // MAKE SURE aI IS VALID
-    if(_storage.getSize()<=0) return(-1);
-    if((aI>=_storage.getSize())||(aI<0)) aI=0;
-    if(getStateVector(aI)->getTime()>aT) aI=0;
+    const int n = _storage.getSize();
+    if(n<=0) return(-1);
+    if((aI>=n)||(aI<0)) aI=0;
+    if(_storage[aI].getTime()>aT) aI=0;
 
     // SEARCH
-    //cout << "Storage.findIndex: starting at " << aI << endl;
-    int i;
-    for(i=aI;i<_storage.getSize();i++) {
-        if(aT<getStateVector(i)->getTime()) break;
+    // Find the first state after aT, assuming the times of the states are
+    // monotonically increasing.
+    int i = aI+1;
+    if((i<n) && !(aT<_storage[i].getTime())) {
+        i++;
+        if((i<n) && !(aT<_storage[i].getTime())) {
+            const StateVector* first = &_storage[0];
+            i = (int)(std::upper_bound(first+i+1, first+n, aT,
+                    [](double t, const StateVector& vec) {
+                        return t < vec.getTime();
+                    }) - first);
+        }
     }
     _lastI = i-1;
     if(_lastI<0) _lastI=0;
@@ -2509,8 +2562,7 @@ findIndex(int aI,double aT) const
  * Find the index of the storage element that occurred immediately before
  * or at a specified time ( getTime(index) <= aT ).
  *
- * This method is not very efficient because it always starts its search
- * with the first stored state.
+ * The search starts with the interval found by the previous search.
  *
  * @param aT Time.
  * @return Index preceding or at time aT.  If aT is less than the earliest
@@ -2519,14 +2571,7 @@ findIndex(int aI,double aT) const
 int Storage::
 findIndex(double aT) const
 {
-    if(_storage.getSize()<=0) return(-1);
-    int i;
-    for(i=0;i<_storage.getSize();i++) {
-        if(aT<getStateVector(i)->getTime()) break;
-    }
-    _lastI = i-1;
-    if(_lastI<0) _lastI=0;
-    return(_lastI);
+    return(findIndex(_lastI,aT));
 }
 //_____________________________________________________________________________
 /**
@@ -2747,17 +2792,32 @@ print(const string &aFileName,const string &aMode, const string& aComment) const
         return(false);
     }
 
-//printf("Storage.cpp:print storage=%x  n=%d ",&_storage, _storage.getSize());
-//std::cout << aFileName << endl;
-
     // VECTORS
-    for(int i=0;i<_storage.getSize();i++) {
-        n = getStateVector(i)->print(fp);
-        if(n<0) {
-            log_error("Storage.print: error printing to {}.", aFileName);
-            return(false);
-        }
-        nTotal += n;
+    // The rows are formatted as by StateVector::print(), but into large
+    // blocks that are written at once (and formatted on multiple threads if
+    // requested with IO::SetNumThreadsForWriting()).
+    const char* format = IO::GetDoubleOutputFormat();
+    bool failed = false;
+    formatRowsInBlocks(_storage.getSize(), IO::GetNumThreadsForWriting(),
+            [&](int row, std::string& buffer) {
+                const StateVector& vec = _storage[row];
+                appendFormattedDouble(buffer, format, vec.getTime());
+                const Array<double>& data = vec.getData();
+                for (int j = 0; j < data.getSize(); ++j) {
+                    buffer += '\t';
+                    appendFormattedDouble(buffer, format, data[j]);
+                }
+                buffer += '\n';
+            },
+            [&](const char* data, size_t size) {
+                if (failed) return;
+                if (fwrite(data, 1, size, fp) != size) failed = true;
+                nTotal += (int)size;
+            });
+    if(failed) {
+        log_error("Storage.print: error printing to {}.", aFileName);
+        fclose(fp);
+        return(false);
     }
 
     // CLOSE
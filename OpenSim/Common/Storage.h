@@ -128,6 +128,13 @@ public:
     Please use FileAdapter (STOFileAdpater, C3DFileAdapter, ...) and TimeSeriesTable
     instead, whenever possible. */
     Storage(const std::string &aFileName, bool readHeadersOnly=false) SWIG_DECLARE_EXCEPTION;
+    /** Create a Storage from a TimeSeriesTable (the inverse of
+    exportToTable()), with the table's column labels after "time". The rows
+    are allocated at once and copied directly from the table's matrix. If the
+    table has "inDegrees" metadata (as written by exportToTable()), it sets
+    isInDegrees(). */
+    explicit Storage(const TimeSeriesTable& table,
+        const std::string &aName="UNKNOWN");
     Storage(const Storage &aStorage,bool aCopyData=true);
     Storage(const Storage &aStorage,int aStateIndex,int aN,
         const char *aDelimiter="\t");
@@ -207,7 +214,11 @@ public:
     void getDataColumn(const std::string& columnName, Array<double>& data, double startTime=0.0) override;
 
     /** Convert to a TimeSeriesTable. This may be useful if you need to use
-    parts of the API that require a TimeSeriesTable instead of a Storage. */
+    parts of the API that require a TimeSeriesTable instead of a Storage. The
+    matrix of the table is allocated once and filled directly from the rows of
+    this Storage, which must all have one value per column label (other than
+    "time").
+    @throws IncorrectNumColumns if a row has a different number of values. */
     TimeSeriesTable exportToTable() const;
 
 #ifndef SWIG
@@ -230,6 +241,11 @@ public:
     // STEP INTERVAL
     void setStepInterval(int aStepInterval);
     int getStepInterval() const;
+    // CAPACITY
+    /** Reserve room for at least aCapacity state vectors, so that appending
+    up to that many does not reallocate the storage. */
+    void ensureCapacity(int aCapacity) { _storage.ensureCapacity(aCapacity); }
+    int getCapacity() const { return _storage.getCapacity(); }
     // CAPACITY INCREMENT
     void setCapacityIncrement(int aIncrement);
     int getCapacityIncrement() const;
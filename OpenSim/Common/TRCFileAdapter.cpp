@@ -167,11 +167,15 @@ TRCFileAdapter::extendRead(const std::string& fileName) const {
     }
     
     const size_t expected{ column_labels.size() * 3 + 2 };
+    // The markers to read (all of them by default).
+    const std::vector<int> markers =
+            findColumnsToRead(column_labels, _columnsToRead);
+    const int num_markers = static_cast<int>(markers.size());
     // Will first store data in a SimTK::Matrix to avoid expensive calls 
     // to the table's appendRow() which reallocates and copies the whole table.
     int rowNumber = 0;
     int last_size = 1024; 
-    SimTK::Matrix_<SimTK::Vec3> markerData{last_size, static_cast<int>(num_markers_expected)};
+    SimTK::Matrix_<SimTK::Vec3> markerData{last_size, num_markers};
     std::vector<double> times;
     times.resize(last_size);
 
@@ -184,22 +188,21 @@ TRCFileAdapter::extendRead(const std::string& fileName) const {
                          expected,
                          row.size());
 
-        // Columns 2 till the end are data.
-        TimeSeriesTableVec3::RowVector 
-            row_vector{static_cast<int>(num_markers_expected), 
-                       SimTK::Vec3(SimTK::NaN)};
-        int ind{0};
-        for (std::size_t c = 2; c < column_labels.size() * 3 + 2; c += 3) {
+        // Columns 2 till the end are data; only the columns of the markers
+        // that are read are converted.
+        for (int ind = 0; ind < num_markers; ++ind) {
+            const std::size_t c = 3 * markers[ind] + 2;
             //only if each component is specified read process as a Vec3
             if ( !(row.at(c).empty() || row.at(c + 1).empty() 
                                      || row.at(c + 2).empty()) ) {
-                row_vector[ind] = SimTK::Vec3{ std::stod(row.at(c)),
-                                               std::stod(row.at(c + 1)),
-                                               std::stod(row.at(c + 2)) };
-            } // otherwise the value will remain NaN (default)
-            ++ind;
+                markerData(rowNumber, ind) =
+                        SimTK::Vec3{ std::stod(row.at(c)),
+                                     std::stod(row.at(c + 1)),
+                                     std::stod(row.at(c + 2)) };
+            } else {
+                markerData(rowNumber, ind) = SimTK::Vec3(SimTK::NaN);
+            }
         }
-        markerData[rowNumber] = row_vector;
         // Column 1 is time.
         times[rowNumber] = std::stod(row.at(1));
         rowNumber++;
@@ -208,7 +211,7 @@ TRCFileAdapter::extendRead(const std::string& fileName) const {
             int newSize = last_size * 2;
             times.resize(newSize);
             // Repeat for Data matrices in use
-            markerData.resizeKeep(newSize, (int)num_markers_expected);
+            markerData.resizeKeep(newSize, num_markers);
             last_size = newSize;
         }
         row = nextLine();
@@ -216,12 +219,12 @@ TRCFileAdapter::extendRead(const std::string& fileName) const {
     }
     // Trim Matrices in use to actual data and move into tables
     times.resize(rowNumber);
-    markerData.resizeKeep(rowNumber, (int)num_markers_expected);
+    markerData.resizeKeep(rowNumber, num_markers);
 
     // Set the column labels of the table.
     std::vector<std::string> labels{};
-    for(const auto& cl : column_labels)
-            labels.push_back(SimTK::Value<std::string>{cl});
+    for(const int m : markers)
+            labels.push_back(SimTK::Value<std::string>{column_labels[m]});
     auto table = std::make_shared<TimeSeriesTableVec3>(
             times, markerData, labels);
     table->updTableMetaData() = metaData;
@@ -151,6 +151,19 @@ public:
     static
     void write(const TimeSeriesTableVec3& table, const std::string& filename);
 
+    /** Read only the markers whose labels match one of these regular
+    expressions (see FileAdapter::findColumnsToRead()), rather than all the
+    markers of the file. The coordinates of the other markers are skipped
+    without being converted, and the table has only the selected markers, in
+    the order of the file. By default (an empty list), all the markers are
+    read.                                                                     */
+    void setColumnsToRead(const std::vector<std::string>& patterns) {
+        _columnsToRead = patterns;
+    }
+    const std::vector<std::string>& getColumnsToRead() const {
+        return _columnsToRead;
+    }
+
     /** Key used for table associative array returned/accepted by write/read. */
     static const std::string              _markers;
 
@@ -187,6 +200,8 @@ private:
     static const unsigned                 _dataStartsAtLine;
     /** Ordered collection of metadata keys.                                  */
     static const std::vector<std::string> _metadataKeys;
+    /** Patterns of the labels of the markers to read (all if empty).      */
+    std::vector<std::string>              _columnsToRead;
 };
 
 } // namespace OpenSim
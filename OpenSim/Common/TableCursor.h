@@ -0,0 +1,210 @@
+#ifndef OPENSIM_TABLE_CURSOR_H_
+#define OPENSIM_TABLE_CURSOR_H_
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  TableCursor.h                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "TimeSeriesTable.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace OpenSim {
+
+/** A position in the time column of a TimeSeriesTable_, for looking up the
+rows of the table at a sequence of times, and interpolating between them,
+without searching the whole time column for each time:
+
+@code
+TableCursor cursor(table);
+SimTK::RowVector values;
+for (double time : times) {
+    cursor.getValuesAtTime(time, values);
+    ...
+}
+@endcode
+
+The cursor remembers the interval of rows of the last lookup, so that looking
+up increasing (or repeated) times takes amortized constant time; looking up
+an earlier time searches the time column (in logarithmic time). If the times
+of the table are uniformly sampled (each time is within a tenth of the
+interval of its uniformly sampled value), the interval is computed from the
+time directly.
+
+The table must outlive the cursor and must not be changed while the cursor
+is used. A cursor must not be used by more than one thread at a time; use a
+cursor per thread instead. Interpolation requires that the elements (ETY)
+can be scaled and added (e.g., SimTK::Real or SimTK::Vec3).              */
+template <typename ETY = SimTK::Real>
+class TableCursor_ {
+public:
+    /** How getValuesAtTime() interpolates between the rows of the table. */
+    enum class Interpolation {
+        /** Linear interpolation between the two rows around the time. */
+        Linear,
+        /** Cubic Hermite interpolation between the two rows around the time,
+        with the slopes at the rows estimated from the neighboring rows
+        (central differences, or one-sided differences at the first and last
+        row). It is exact for quadratic data in the interior of uniformly
+        sampled tables and, unlike linear interpolation, has a continuous
+        first derivative. */
+        Hermite
+    };
+
+    /** Create a cursor at the first row of `table`.
+    \throws EmptyTable If the table is empty.                                 */
+    explicit TableCursor_(const TimeSeriesTable_<ETY>& table)
+            : m_table(table) {
+        const auto& times = m_table.getIndependentColumn();
+        OPENSIM_THROW_IF(times.empty(), EmptyTable);
+        const size_t numRows = times.size();
+        if (numRows < 2) return;
+        const double dt = (times.back() - times.front()) / (numRows - 1);
+        if (!(dt > 0)) return;
+        for (size_t i = 0; i < numRows; ++i) {
+            if (std::abs(times[i] - (times.front() + i * dt)) > 0.1 * dt) {
+                return;
+            }
+        }
+        m_timeStep = dt;
+    }
+
+    const TimeSeriesTable_<ETY>& getTable() const { return m_table; }
+
+    /** Whether the times of the table are uniformly sampled, in which case
+    lookups do not depend on the position of the cursor. */
+    bool isUniformlySampled() const { return !SimTK::isNaN(m_timeStep); }
+
+    /** The interval between the times of a uniformly sampled table, or NaN
+    if the table is not uniformly sampled. */
+    double getTimeStep() const { return m_timeStep; }
+
+    /** Move the cursor to `time` and return the index of the row that starts
+    the interval of rows that contains the time: the last row whose time is
+    less than or equal to `time`, but at most the second-to-last row (or 0,
+    if the table has one row). A time within SimTK::SignificantReal of the
+    first or last time of the table is considered to be equal to it.
+    \throws TimeOutOfRange If the time is out of the range of the table.     */
+    size_t seek(double time) {
+        const auto& times = m_table.getIndependentColumn();
+        const SimTK::Real eps = SimTK::SignificantReal;
+        OPENSIM_THROW_IF(
+                (time < times.front() - eps) || (time > times.back() + eps),
+                TimeOutOfRange, time, times.front(), times.back());
+        const size_t last = times.size() - 1;
+        if (last == 0) return 0;
+
+        size_t index = m_index;
+        if (isUniformlySampled()) {
+            const double estimate =
+                    std::floor((time - times.front()) / m_timeStep);
+            index = static_cast<size_t>(
+                    std::max(0.0, std::min(estimate, double(last - 1))));
+        } else if (time < times[index]) {
+            const auto next =
+                    std::upper_bound(times.begin(), times.end(), time);
+            index = next == times.begin()
+                    ? 0 : std::distance(times.begin(), next) - 1;
+            index = std::min(index, last - 1);
+        }
+        // Correct the estimate for times that are not exactly uniform, or
+        // move forward to the time.
+        while (index + 1 < last && times[index + 1] <= time) ++index;
+        while (index > 0 && times[index] > time) --index;
+        m_index = index;
+        return index;
+    }
+
+    /** Move the cursor to `time` and return the index of the row whose time
+    is nearest to `time`, which is the same row as
+    TimeSeriesTable_::getNearestRowIndexForTime().
+    \throws TimeOutOfRange If the time is out of the range of the table.     */
+    size_t getNearestRowIndex(double time) {
+        const size_t index = seek(time);
+        const auto& times = m_table.getIndependentColumn();
+        if (index + 1 < times.size() &&
+                (times[index + 1] - time) <= (time - times[index])) {
+            return index + 1;
+        }
+        return index;
+    }
+
+    /** Move the cursor to `time` and interpolate the row of the table at the
+    time into `values`, which is resized to the number of columns of the
+    table if necessary (so that a buffer reused from one call to the next is
+    not reallocated).
+    \throws TimeOutOfRange If the time is out of the range of the table.     */
+    void getValuesAtTime(double time, SimTK::RowVector_<ETY>& values,
+            Interpolation interpolation = Interpolation::Linear) {
+        const size_t index = seek(time);
+        const auto& times = m_table.getIndependentColumn();
+        const auto& matrix = m_table.getMatrix();
+        const int numColumns = (int)m_table.getNumColumns();
+        if (values.size() != numColumns) values.resize(numColumns);
+        const int i = (int)index;
+        if (index + 1 == times.size()) {
+            for (int j = 0; j < numColumns; ++j) values[j] = matrix(i, j);
+            return;
+        }
+        const double h = times[index + 1] - times[index];
+        const double s = std::max(0.0, std::min((time - times[index]) / h,
+                1.0));
+        if (interpolation == Interpolation::Linear) {
+            for (int j = 0; j < numColumns; ++j) {
+                values[j] = matrix(i, j) * (1 - s) + matrix(i + 1, j) * s;
+            }
+            return;
+        }
+        // The Hermite basis functions, with the slopes scaled by h.
+        const double s2 = s * s;
+        const double s3 = s2 * s;
+        const double h00 = 2 * s3 - 3 * s2 + 1;
+        const double h10 = s3 - 2 * s2 + s;
+        const double h01 = -2 * s3 + 3 * s2;
+        const double h11 = s3 - s2;
+        const int last = (int)times.size() - 1;
+        const int before = std::max(i - 1, 0);
+        const int after = std::min(i + 2, last);
+        const double w0 = h / (times[i + 1] - times[before]);
+        const double w1 = h / (times[after] - times[i]);
+        for (int j = 0; j < numColumns; ++j) {
+            const ETY m0 = (matrix(i + 1, j) - matrix(before, j)) * w0;
+            const ETY m1 = (matrix(after, j) - matrix(i, j)) * w1;
+            values[j] = matrix(i, j) * h00 + m0 * h10 +
+                        matrix(i + 1, j) * h01 + m1 * h11;
+        }
+    }
+
+private:
+    const TimeSeriesTable_<ETY>& m_table;
+    double m_timeStep = SimTK::NaN;
+    size_t m_index = 0;
+};
+
+/** See TableCursor_ for details on the interface.                            */
+typedef TableCursor_<SimTK::Real> TableCursor;
+
+/** See TableCursor_ for details on the interface.                            */
+typedef TableCursor_<SimTK::Vec3> TableCursorVec3;
+
+} // namespace OpenSim
+
+#endif // OPENSIM_TABLE_CURSOR_H_
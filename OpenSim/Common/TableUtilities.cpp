@@ -24,12 +24,12 @@
 #include "TableUtilities.h"
 
 #include "CommonUtilities.h"
-#include "FunctionSet.h"
-#include "GCVSplineSet.h"
 #include "PiecewiseLinearFunction.h"
 #include "Signal.h"
 #include "Storage.h"
 
+#include <algorithm>
+
 using namespace OpenSim;
 
 void TableUtilities::checkNonUniqueLabels(std::vector<std::string> labels) {
@@ -119,8 +119,21 @@ int TableUtilities::findStateLabelIndexInternal(const std::string* begin,
     return -1;
 }
 
-void TableUtilities::filterLowpass(
-        TimeSeriesTable& table, double cutoffFreq, bool padData) {
+namespace {
+/// The number of threads with which to process the columns of a table: 1 for
+/// small tables, for which creating threads would take longer than the work.
+int getNumThreadsForTable(const TimeSeriesTable& table, int numThreads) {
+    const int minElementsPerThread = 10000;
+    const int numColumns = (int)table.getNumColumns();
+    const int numElements = (int)table.getNumRows() * numColumns;
+    return std::max(1, std::min({getNumThreadsOrDefault(numThreads),
+                               numColumns,
+                               numElements / minElementsPerThread}));
+}
+} // namespace
+
+void TableUtilities::filterLowpass(TimeSeriesTable& table, double cutoffFreq,
+        bool padData, int numThreads) {
     OPENSIM_THROW_IF(cutoffFreq < 0, Exception,
             "Cutoff frequency must be non-negative; got {}.", cutoffFreq);
 
@@ -147,14 +160,45 @@ void TableUtilities::filterLowpass(
         table = resampleWithInterval(table, dtMin);
     }
 
-    SimTK::Vector filtered(numRows);
-    for (int icol = 0; icol < (int)table.getNumColumns(); ++icol) {
-        SimTK::VectorView column = table.getDependentColumnAtIndex(icol);
-        Signal::LowpassIIR(dtMin, cutoffFreq, numRows,
-                column.getContiguousScalarData(),
-                filtered.updContiguousScalarData());
-        table.updDependentColumnAtIndex(icol) = filtered;
+    // Warn about the cutoff frequency once, rather than for each column.
+    if (cutoffFreq >= 0.5 / dtMin) {
+        cutoffFreq = 0.49 / dtMin;
+        log_warn("Cutoff frequency should be less than half sample frequency. "
+                 "Changing the cutoff frequency to 0.49*(Sample Frequency)..."
+                 "cutoff = {}", cutoffFreq);
     }
+
+    // The columns are filtered in blocks that are copied into interleaved
+    // buffers, so that each step of the filter is applied to all the columns
+    // of a block at once (see Signal::LowpassIIRInterleaved()).
+    const int numColumns = (int)table.getNumColumns();
+    const int blockSize = 4;
+    const int numBlocks = (numColumns + blockSize - 1) / blockSize;
+    auto& matrix = table.updMatrix();
+    parallelForChunks(numBlocks, getNumThreadsForTable(table, numThreads),
+            [&](int, int begin, int end) {
+                std::vector<double> signals(numRows * blockSize);
+                std::vector<double> filtered(numRows * blockSize);
+                for (int iblock = begin; iblock < end; ++iblock) {
+                    const int firstCol = iblock * blockSize;
+                    const int width =
+                            std::min(blockSize, numColumns - firstCol);
+                    for (int irow = 0; irow < numRows; ++irow) {
+                        for (int k = 0; k < width; ++k) {
+                            signals[irow * width + k] =
+                                    matrix(irow, firstCol + k);
+                        }
+                    }
+                    Signal::LowpassIIRInterleaved(dtMin, cutoffFreq, numRows,
+                            width, signals.data(), filtered.data());
+                    for (int irow = 0; irow < numRows; ++irow) {
+                        for (int k = 0; k < width; ++k) {
+                            matrix(irow, firstCol + k) =
+                                    filtered[irow * width + k];
+                        }
+                    }
+                }
+            });
 }
 
 void TableUtilities::pad(
@@ -167,12 +211,12 @@ void TableUtilities::pad(
             numRowsToPrependAndAppend);
 
     table._indData = Signal::Pad(numRowsToPrependAndAppend,
-            (int)table._indData.size(), table._indData.data());
+            (int)table._indData->size(), table._indData->data());
 
     size_t numColumns = table.getNumColumns();
 
-    // _indData.size() is now the number of rows after padding.
-    SimTK::Matrix newMatrix((int)table._indData.size(), (int)numColumns);
+    // _indData->size() is now the number of rows after padding.
+    SimTK::Matrix newMatrix((int)table._indData->size(), (int)numColumns);
     for (size_t icol = 0; icol < numColumns; ++icol) {
         SimTK::Vector column = table.getDependentColumnAtIndex(icol);
         const std::vector<double> newColumn =
@@ -181,29 +225,27 @@ void TableUtilities::pad(
         newMatrix.updCol((int)icol) =
                 SimTK::Vector((int)newColumn.size(), newColumn.data(), true);
     }
-    table.updMatrix() = newMatrix;
+    table._depData = std::move(newMatrix);
 }
 
 namespace {
 template <typename FunctionType>
-std::unique_ptr<FunctionSet> createFunctionSet(const TimeSeriesTable& table) {
-    auto set = make_unique<FunctionSet>();
+std::unique_ptr<FunctionType> createFunction(
+        const TimeSeriesTable& table, int icol) {
     const auto& time = table.getIndependentColumn();
-    const auto numRows = (int)table.getNumRows();
-    for (int icol = 0; icol < (int)table.getNumColumns(); ++icol) {
-        const double* y =
-                table.getDependentColumnAtIndex(icol).getContiguousScalarData();
-        set->adoptAndAppend(new FunctionType(numRows, time.data(), y));
-    }
-    return set;
+    const double* y =
+            table.getDependentColumnAtIndex(icol).getContiguousScalarData();
+    return make_unique<FunctionType>((int)table.getNumRows(), time.data(), y);
 }
 
 template <>
-inline std::unique_ptr<FunctionSet> createFunctionSet<GCVSpline>(
-        const TimeSeriesTable& table) {
+inline std::unique_ptr<GCVSpline> createFunction<GCVSpline>(
+        const TimeSeriesTable& table, int icol) {
     const auto& time = table.getIndependentColumn();
-    return OpenSim::make_unique<GCVSplineSet>(table, std::vector<std::string>{},
-            std::min((int)time.size() - 1, 5));
+    const double* y =
+            table.getDependentColumnAtIndex(icol).getContiguousScalarData();
+    return make_unique<GCVSpline>(std::min((int)time.size() - 1, 5),
+            (int)time.size(), time.data(), y);
 }
 } // namespace
 
@@ -217,8 +259,8 @@ inline std::unique_ptr<FunctionSet> createFunctionSet<GCVSpline>(
 /// decreasing, or if getNumTimes() < 2.
 /// @ingroup moconumutil
 template <typename TimeVector, typename FunctionType>
-TimeSeriesTable TableUtilities::resample(
-        const TimeSeriesTable& in, const TimeVector& newTime) {
+TimeSeriesTable TableUtilities::resample(const TimeSeriesTable& in,
+        const TimeVector& newTime, int numThreads) {
 
     const auto& time = in.getIndependentColumn();
 
@@ -238,26 +280,33 @@ TimeSeriesTable TableUtilities::resample(
                 "New times must be non-decreasing, but "
                 "time[{}] < time[{}] ({} < {}).",
                 itime, itime - 1, newTime[itime], newTime[itime - 1]);
+        OPENSIM_THROW_IF(newTime[itime] == newTime[itime - 1],
+                TimestampLessThanEqualToPrevious, itime, newTime[itime],
+                newTime[itime - 1]);
     }
 
     // Copy over metadata.
     TimeSeriesTable out = in;
-    for (int irow = (int)out.getNumRows() - 1; irow >= 0; --irow) {
-        out.removeRowAtIndex(irow);
-    }
-
-    std::unique_ptr<FunctionSet> functions =
-            createFunctionSet<FunctionType>(in);
-    SimTK::Vector curTime(1);
-    SimTK::RowVector row(functions->getSize());
-    for (int itime = 0; itime < (int)newTime.size(); ++itime) {
-        curTime[0] = newTime[itime];
-        for (int icol = 0; icol < functions->getSize(); ++icol) {
-            row(icol) = functions->get(icol).calcValue(curTime);
-        }
-        // Not efficient!
-        out.appendRow(curTime[0], row);
-    }
+    const int numTimes = (int)newTime.size();
+    const int numColumns = (int)in.getNumColumns();
+    std::vector<double> times(numTimes);
+    for (int itime = 0; itime < numTimes; ++itime) times[itime] = newTime[itime];
+
+    // Each column is fit and evaluated at all the new times by one thread,
+    // and written directly into the matrix of the new table.
+    SimTK::Matrix matrix(numTimes, numColumns);
+    parallelForEach(numColumns, getNumThreadsForTable(in, numThreads),
+            [&](int, int icol) {
+                const auto function = createFunction<FunctionType>(in, icol);
+                int interval = 0;
+                for (int itime = 0; itime < numTimes; ++itime) {
+                    matrix(itime, icol) =
+                            function->evaluate(times[itime], 0, interval);
+                }
+            });
+    // The copy of `in` shares its data until the data is replaced here.
+    out._indData = std::move(times);
+    out._depData = std::move(matrix);
     return out;
 }
 
@@ -314,17 +363,17 @@ TimeSeriesTable_<SimTK::Vec3> TableUtilities::convertRotationsToEulerAngles(
 // Explicit template instantiations.
 namespace OpenSim {
 template OSIMCOMMON_API TimeSeriesTable TableUtilities::resample<SimTK::Vector, GCVSpline>(
-        const TimeSeriesTable&, const SimTK::Vector&);
+        const TimeSeriesTable&, const SimTK::Vector&, int);
 template OSIMCOMMON_API TimeSeriesTable
 TableUtilities::resample<SimTK::Vector, PiecewiseLinearFunction>(
-        const TimeSeriesTable&, const SimTK::Vector&);
+        const TimeSeriesTable&, const SimTK::Vector&, int);
 
 template OSIMCOMMON_API TimeSeriesTable
 TableUtilities::resample<std::vector<double>, GCVSpline>(
-        const TimeSeriesTable&, const std::vector<double>&);
+        const TimeSeriesTable&, const std::vector<double>&, int);
 template OSIMCOMMON_API TimeSeriesTable
 TableUtilities::resample<std::vector<double>, PiecewiseLinearFunction>(
-        const TimeSeriesTable&, const std::vector<double>&);
+        const TimeSeriesTable&, const std::vector<double>&, int);
 
 template OSIMCOMMON_API TimeSeriesTable TableUtilities::resampleWithInterval<GCVSpline>(
         const TimeSeriesTable&, double);
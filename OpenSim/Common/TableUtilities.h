@@ -63,9 +63,12 @@ public:
     /// Lowpass filter the data in a TimeSeriesTable at a provided cutoff
     /// frequency. If padData is true, then the data is first padded with pad()
     /// using numRowsToPrependAndAppend = table.getNumRows() / 2.
-    /// The filtering is performed with Signal::LowpassIIR()
+    /// The filtering is performed with Signal::LowpassIIR() (several columns
+    /// at a time; see Signal::LowpassIIRInterleaved()). The columns are
+    /// filtered on `numThreads` threads; a value of 0 or less uses all
+    /// available threads. Small tables are filtered on one thread.
     static void filterLowpass(TimeSeriesTable& table,
-            double cutoffFreq, bool padData = false);
+            double cutoffFreq, bool padData = false, int numThreads = -1);
 
     /// Pad each column by the number of rows specified. The padded data is
     /// obtained by reflecting and negating the data in the table.
@@ -78,12 +81,15 @@ public:
     /// the table has too few points for a 5th-order spline. Alternatively, you
     /// can provide a different function type as a template argument; currently,
     /// the only other supported function is PiecewiseLinearFunction.
+    /// The columns are fit and evaluated on `numThreads` threads; a value of
+    /// 0 or less uses all available threads. Small tables are resampled on
+    /// one thread.
     /// @throws Exception if new times are
     /// not within existing initial and final times, if the new times are
     /// decreasing, or if getNumTimes() < 2.
     template <typename TimeVector, typename FunctionType = GCVSpline>
-    static TimeSeriesTable resample(
-            const TimeSeriesTable& in, const TimeVector& newTime);
+    static TimeSeriesTable resample(const TimeSeriesTable& in,
+            const TimeVector& newTime, int numThreads = -1);
 
     /// Resample the table using the given time interval (using resample()).
     /// The new final time is not guaranteed to match the original final
@@ -122,3 +122,22 @@ TEST_CASE("APDMDataReader Behaves as Expected with Format=7")
     const SimTK::Vec3 fromFileMagneto = reader.getMagneticHeadingTable(tables).getRowAtIndex(2)[1]; 
     ASSERT_EQUAL(refMagneto, fromFileMagneto, tolerance);
 }
+
+TEST_CASE("APDMDataReader skips the data that is not read")
+{
+    APDMDataReaderSettings readerSettings;
+    readerSettings.append_ExperimentalSensors(
+            ExperimentalSensor("Static", "torso"));
+    readerSettings.set_read_magnetic_heading(false);
+    readerSettings.set_read_angular_velocity(false);
+    APDMDataReader reader(readerSettings);
+    DataAdapter::OutputTables tables = reader.read("imuData01.csv");
+    CHECK(reader.getMagneticHeadingTable(tables).getNumRows() == 0);
+    CHECK(reader.getAngularVelocityTable(tables).getNumRows() == 0);
+    const TimeSeriesTableVec3& accelTable =
+            reader.getLinearAccelerationsTable(tables);
+    REQUIRE(accelTable.getNumRows() == 1024);
+    ASSERT_EQUAL(accelTable.getRowAtIndex(0)[0],
+            SimTK::Vec3{ 0.102542184,0.048829611,9.804986382 }, SimTK::Eps);
+    REQUIRE(reader.getOrientationsTable(tables).getNumRows() == 1024);
+}
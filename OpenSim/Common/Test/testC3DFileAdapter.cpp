@@ -220,9 +220,66 @@ void test(const std::string filename) {
 
 }
 
+void testReadSelectedChannels(const std::string filename) {
+    using namespace OpenSim;
+
+    C3DFileAdapter allAdapter{};
+    auto all = allAdapter.read(filename);
+    auto allMarkers = allAdapter.getMarkersTable(all);
+    auto allForces = allAdapter.getForcesTable(all);
+    auto allAnalog = allAdapter.getAnalogDataTable(all);
+    ASSERT(allMarkers->getNumColumns() >= 2 &&
+           allForces->getNumColumns() >= 6 &&
+           allAnalog->getNumColumns() >= 2);
+
+    const auto& markerLabels = allMarkers->getColumnLabels();
+    const auto& analogLabels = allAnalog->getColumnLabels();
+    C3DFileAdapter adapter{};
+    adapter.setMarkersToRead({markerLabels[1], markerLabels[0]});
+    adapter.setForcePlatesToRead({2});
+    adapter.setAnalogChannelsToRead({analogLabels[1]});
+    auto selected = adapter.read(filename);
+    auto markers = adapter.getMarkersTable(selected);
+    auto forces = adapter.getForcesTable(selected);
+    auto analog = adapter.getAnalogDataTable(selected);
+
+    ASSERT(markers->getColumnLabels() ==
+           std::vector<std::string>({markerLabels[1], markerLabels[0]}));
+    ASSERT(forces->getColumnLabels() ==
+           std::vector<std::string>({"f2", "p2", "m2"}));
+    ASSERT(analog->getColumnLabels() ==
+           std::vector<std::string>({analogLabels[1]}));
+    ASSERT(markers->getNumRows() == allMarkers->getNumRows());
+    ASSERT(forces->getNumRows() == allForces->getNumRows());
+    ASSERT(analog->getNumRows() == allAnalog->getNumRows());
+    for (int r = 0; r < (int)markers->getNumRows(); ++r) {
+        for (int c = 0; c < 2; ++c) {
+            const auto& value = markers->getMatrix()(r, c);
+            const auto& expected = allMarkers->getMatrix()(r, 1 - c);
+            ASSERT(value == expected || (value.isNaN() && expected.isNaN()));
+        }
+    }
+    for (int r = 0; r < (int)forces->getNumRows(); ++r) {
+        for (int c = 0; c < 3; ++c) {
+            ASSERT(forces->getMatrix()(r, c) ==
+                   allForces->getMatrix()(r, 3 + c));
+        }
+    }
+    for (int r = 0; r < (int)analog->getNumRows(); ++r) {
+        ASSERT(analog->getMatrix()(r, 0) == allAnalog->getMatrix()(r, 1));
+    }
+
+    adapter.setMarkersToRead({"not_a_marker"});
+    ASSERT_THROW(OpenSim::Exception, adapter.read(filename));
+    adapter.setMarkersToRead({});
+    adapter.setForcePlatesToRead({0});
+    ASSERT_THROW(OpenSim::Exception, adapter.read(filename));
+}
+
 int main() {
     SimTK_START_TEST("testC3DFileAdapter");
         SimTK_SUBTEST1(test, "walking2.c3d");
         SimTK_SUBTEST1(test, "walking5.c3d");
+        SimTK_SUBTEST1(testReadSelectedChannels, "walking5.c3d");
     SimTK_END_TEST();
 }
@@ -23,7 +23,9 @@
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Common/Component.h>
 #include <OpenSim/Common/Function.h>
+#include <OpenSim/Common/OutputPlan.h>
 #include <OpenSim/Common/Reporter.h>
+#include <OpenSim/Common/StateVariableAccessor.h>
 #include <OpenSim/Common/TableSource.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Common/CommonUtilities.h>
@@ -1212,6 +1214,53 @@ TEST_CASE("Component Interface Component::findComponent")
     SimTK_TEST(&b3->getConnectee<A>("socket_a") == a3);
 }
 
+TEST_CASE("Component Interface Component::getComponentsOfType")
+{
+    class A : public Component {
+        OpenSim_DECLARE_CONCRETE_OBJECT(A, Component);
+    public:
+        A(const std::string& name) { setName(name); }
+    };
+    class B : public Component {
+        OpenSim_DECLARE_CONCRETE_OBJECT(B, Component);
+    public:
+        B(const std::string& name) { setName(name); }
+    };
+
+    A top("top");
+    B* b1 = new B("b1");
+    top.addComponent(b1);
+    A* a1 = new A("a1");
+    b1->addComponent(a1);
+    B* b2 = new B("b2");
+    a1->addComponent(b2);
+
+    const auto& bs = top.getComponentsOfType<B>();
+    REQUIRE(bs.size() == 2);
+    CHECK(bs[0] == b1);
+    CHECK(bs[1] == b2);
+    // The list is cached.
+    CHECK(&top.getComponentsOfType<B>() == &bs);
+    REQUIRE(top.getComponentsOfType<A>().size() == 1);
+    CHECK(top.getComponentsOfType<A>()[0] == a1);
+    CHECK(top.getComponentsOfType().size() == 3);
+
+    // Adding a component to a subcomponent updates the lists of its owners.
+    B* b3 = new B("b3");
+    b2->addComponent(b3);
+    CHECK(top.getComponentsOfType<B>().size() == 3);
+    CHECK(b1->getComponentsOfType<B>().size() == 2);
+    CHECK(top.getComponentsOfType<B>()[2] == b3);
+
+    // Copies build their own lists.
+    A copy(top);
+    copy.finalizeFromProperties();
+    const auto& copyBs = copy.getComponentsOfType<B>();
+    REQUIRE(copyBs.size() == 3);
+    CHECK(copyBs[0] == &copy.getComponent<B>("b1"));
+    CHECK(copyBs[0] != b1);
+}
+
 TEST_CASE("Component Interface can Traverse Path to Component")
 {
     class A : public Component {
@@ -1336,10 +1385,129 @@ TEST_CASE("Component Interface Component::getStateVariableValue")
     SimTK_TEST(b->getStateVariableValue(s, "subState") == 30);
     SimTK_TEST(b->getStateVariableValue(s, "../subState") == 20);
     SimTK_TEST(b->getStateVariableValue(s, "../../internalSub/subState") == 10);
+    // Absolute paths, looked up in the root's index.
+    SimTK_TEST(top.getStateVariableValue(s, "/a/b/subState") == 30);
+    SimTK_TEST(b->getStateVariableValue(s, "/internalSub/subState") == 10);
+    SimTK_TEST(b->getStateVariableValue(s, "/a/subState") == 20);
 
     SimTK_TEST_MUST_THROW_EXC(
             top.getStateVariableValue(s, "typo/b/subState"),
             OpenSim::Exception);
+    SimTK_TEST_MUST_THROW_EXC(
+            b->getStateVariableValue(s, "/typo/b/subState"),
+            OpenSim::Exception);
+
+    // The index is rebuilt for a new System.
+    Sub* c = new Sub();
+    c->setName("c");
+    b->addComponent(c);
+    MultibodySystem system2;
+    top.buildUpSystem(system2);
+    State s2 = system2.realizeTopology();
+    SimTK_TEST(s2.getNY() == 4);
+    s2.updY() = 0;
+    top.setStateVariableValue(s2, "/a/b/c/subState", 40);
+    SimTK_TEST(c->getStateVariableValue(s2, "subState") == 40);
+    SimTK_TEST(a->getStateVariableValue(s2, "/a/b/c/subState") == 40);
+    SimTK_TEST(top.getStateVariableValue(s2, "a/b/subState") == 0);
+}
+
+TEST_CASE("Component Interface StateVariableAccessor")
+{
+    TheWorld top;
+    top.setName("top");
+    Sub* a = new Sub();
+    a->setName("a");
+    Sub* b = new Sub();
+    b->setName("b");
+    top.add(a);
+    a->addComponent(b);
+
+    MultibodySystem system;
+    top.buildUpSystem(system);
+    State s = system.realizeTopology();
+    s.updY()[0] = 10;
+    s.updY()[1] = 20;
+    s.updY()[2] = 30;
+
+    // All state variables, in the order of getStateVariableNames().
+    StateVariableAccessor all(top, s);
+    REQUIRE(all.getNumStateVariables() == 3);
+    SimTK::Vector values = all.getValues(s);
+    SimTK::Vector expected = top.getStateVariableValues(s);
+    for (int i = 0; i < 3; ++i) {
+        CHECK(all.getSystemYIndex(i) >= 0);
+        CHECK(values[i] == expected[i]);
+    }
+
+    // A subset, with relative and absolute paths.
+    StateVariableAccessor some(*a, s, {"b/subState", "/internalSub/subState"});
+    double buffer[2];
+    some.getValues(s, buffer);
+    CHECK(buffer[0] == 30);
+    CHECK(buffer[1] == 10);
+    const double newValues[2] = {-3, -1};
+    some.setValues(s, newValues);
+    CHECK(b->getStateVariableValue(s, "subState") == -3);
+    CHECK(top.getStateVariableValue(s, "internalSub/subState") == -1);
+    CHECK(a->getStateVariableValue(s, "subState") == 20);
+
+    CHECK_THROWS_AS(StateVariableAccessor(top, s, {"a/typo"}),
+            OpenSim::Exception);
+    CHECK_THROWS_AS(some.setValues(s, SimTK::Vector(3, 0.0)),
+            OpenSim::Exception);
+}
+
+TEST_CASE("Component Interface Profiling")
+{
+    TheWorld top;
+    top.setName("top");
+    Sub* a = new Sub();
+    a->setName("a");
+    top.add(a);
+
+    CHECK_FALSE(top.isProfilingEnabled());
+    CHECK_THROWS_AS(top.getProfiler(), OpenSim::Exception);
+    // Only the root component can own a profiler.
+    CHECK_THROWS_AS(a->setProfilingEnabled(true), OpenSim::Exception);
+    top.setProfilingEnabled(true);
+    CHECK(top.isProfilingEnabled());
+
+    MultibodySystem system;
+    top.buildUpSystem(system);
+    State s = system.realizeTopology();
+    const int numRealizations = 3;
+    for (int i = 0; i < numRealizations; ++i) {
+        s.setTime(0.1 * i);
+        system.realize(s, Stage::Acceleration);
+    }
+
+    using Hook = ComponentProfiler::Hook;
+    const ComponentProfiler& profiler = top.getProfiler();
+    for (const std::string path : {"/a", "/internalSub"}) {
+        CHECK(profiler.getEntry(path, Hook::RealizeTopology).numCalls == 1);
+        CHECK(profiler.getEntry(path,
+                Hook::ComputeStateVariableDerivatives).numCalls ==
+                numRealizations);
+        CHECK(profiler.getEntry(path, Hook::RealizeAcceleration).numCalls ==
+                numRealizations);
+    }
+    CHECK(profiler.getEntry("/a", Hook::RealizeReport).numCalls == 0);
+    CHECK(profiler.getEntry("/typo", Hook::RealizeTopology).numCalls == 0);
+
+    const std::string table = profiler.toString();
+    CHECK(table.find("component\thook\tcalls") == 0);
+    CHECK(table.find("/a\tcomputeStateVariableDerivatives\t3\t") !=
+            std::string::npos);
+
+    // Copies of the component are not profiled.
+    TheWorld copy(top);
+    CHECK_FALSE(copy.isProfilingEnabled());
+
+    top.updProfiler().clear();
+    CHECK(profiler.getComponentPaths().empty());
+    top.setProfilingEnabled(false);
+    CHECK_FALSE(top.isProfilingEnabled());
 }
 
 TEST_CASE("Component Interface getStateVariableValue with Component Path")
@@ -1906,42 +2074,46 @@ TEST_CASE("Component Interface Table Source")
     theWorld.connect();
     theWorld.buildUpSystem(system);
 
-    const auto& report = tableReporter->getTable();
+    // Reported rows are appended to the table when it is retrieved.
+    const auto reportedRow = [&](size_t index) {
+        return tableReporter->getTable().getRowAtIndex(index);
+    };
 
     State s = system.realizeTopology();
 
     s.setTime(0);
     tableReporter->report(s);
-    assertEqual(table.getRowAtIndex(0)  , report.getRowAtIndex(0));
+    assertEqual(table.getRowAtIndex(0)  , reportedRow(0));
 
     s.setTime(0.1);
     tableReporter->report(s);
     row = RowVector_<double>{4, 0.4};
-    assertEqual(row.getAsRowVectorView(), report.getRowAtIndex(1));
+    assertEqual(row.getAsRowVectorView(), reportedRow(1));
 
     s.setTime(0.25);
     tableReporter->report(s);
-    assertEqual(table.getRowAtIndex(1)  , report.getRowAtIndex(2));
+    assertEqual(table.getRowAtIndex(1)  , reportedRow(2));
 
     s.setTime(0.4);
     tableReporter->report(s);
     row = RowVector_<double>{4, 1.6};
-    assertEqual(row.getAsRowVectorView(), report.getRowAtIndex(3));
+    assertEqual(row.getAsRowVectorView(), reportedRow(3));
 
     s.setTime(0.5);
     tableReporter->report(s);
-    assertEqual(table.getRowAtIndex(2)  , report.getRowAtIndex(4));
+    assertEqual(table.getRowAtIndex(2)  , reportedRow(4));
 
     s.setTime(0.6);
     tableReporter->report(s);
     row = RowVector_<double>{4, 2.4};
-    assertEqual(row.getAsRowVectorView(), report.getRowAtIndex(5));
+    assertEqual(row.getAsRowVectorView(), reportedRow(5));
 
     s.setTime(0.75);
     tableReporter->report(s);
-    assertEqual(table.getRowAtIndex(3)  , report.getRowAtIndex(6));
+    assertEqual(table.getRowAtIndex(3)  , reportedRow(6));
 
     std::cout << "Report: " << std::endl;
+    const auto& report = tableReporter->getTable();
     std::cout << report << std::endl;
 }
 
@@ -1996,6 +2168,74 @@ TEST_CASE("Component Interface TableReporter Usage")
     }
 }
 
+TEST_CASE("Component Interface OutputPlan")
+{
+    // Each output reports the stage to which the state was realized when the
+    // output was computed.
+    class StageOutputs : public Component {
+        OpenSim_DECLARE_CONCRETE_OBJECT(StageOutputs, Component);
+    public:
+        OpenSim_DECLARE_OUTPUT(velocity, double, calcStage,
+                SimTK::Stage::Velocity);
+        OpenSim_DECLARE_OUTPUT(time, double, calcStage, SimTK::Stage::Time);
+        OpenSim_DECLARE_LIST_OUTPUT(position, double, calcPosition,
+                SimTK::Stage::Position);
+        OpenSim_DECLARE_OUTPUT(vec, Vec3, calcVec, SimTK::Stage::Time);
+        double calcStage(const SimTK::State& s) const {
+            return s.getSystemStage().getInt();
+        }
+        double calcPosition(const SimTK::State& s,
+                const std::string& channel) const {
+            return 10 * std::stoi(channel) + s.getSystemStage().getInt();
+        }
+        Vec3 calcVec(const SimTK::State&) const { return Vec3(1); }
+    private:
+        void extendFinalizeFromProperties() override {
+            auto& position = updOutput("position");
+            position.addChannel("1"); position.addChannel("2");
+        }
+    };
+
+    TheWorld world;
+    auto* comp = new StageOutputs();
+    comp->setName("comp");
+    world.add(comp);
+    MultibodySystem system;
+    world.buildUpSystem(system);
+    State s = system.realizeTopology();
+    system.realizeModel(s);
+
+    OutputPlan<double> plan;
+    plan.addOutput(comp->getOutput("velocity"));
+    plan.addOutput(comp->getOutput("position"));
+    plan.addOutput(comp->getOutput("time"));
+    SimTK_TEST_MUST_THROW_EXC(plan.addOutput(comp->getOutput("vec")),
+            OpenSim::Exception);
+    CHECK(plan.getNumChannels() == 4);
+    CHECK(plan.getLabel(0) == "/comp|velocity");
+    CHECK(plan.getLabel(2) == "/comp|position:2");
+    CHECK(plan.getRequiredStage() == SimTK::Stage::Velocity);
+
+    // The state is realized only as far as each channel requires, and the
+    // values are in the order in which the channels were added.
+    std::vector<double> values(plan.getNumChannels());
+    plan.evaluate(system, s, values);
+    CHECK(s.getSystemStage() == SimTK::Stage::Velocity);
+    CHECK(values[0] == SimTK::Stage::VelocityIndex);
+    CHECK(values[1] == 10 + SimTK::Stage::PositionIndex);
+    CHECK(values[2] == 20 + SimTK::Stage::PositionIndex);
+    CHECK(values[3] == SimTK::Stage::TimeIndex);
+
+    // The values are the same as those from the channels.
+    Vector row(plan.getNumChannels(), 0.0);
+    plan.evaluate(s, row);
+    CHECK(row[0] == comp->getOutputValue<double>(s, "velocity"));
+    CHECK(row[3] == comp->getOutputValue<double>(s, "time"));
+
+    plan.clear();
+    CHECK(plan.getNumChannels() == 0);
+}
+
 const std::string dataFileNameForInputConnecteeSerialization =
         "testComponentInterface_testInputConnecteeSerialization_data.sto";
 
@@ -0,0 +1,111 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  testDataQueue.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Common/DataQueue.h>
+
+#include <thread>
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch/catch.hpp>
+
+using namespace OpenSim;
+
+TEST_CASE("DataQueue unbounded mode") {
+    DataQueue_<double> queue;
+    CHECK(!queue.isRingBuffer());
+    SimTK::RowVector row(3, 1.0);
+    queue.push_back(0.1, row);
+    row = 2.0;
+    queue.push_back(0.2, row);
+    CHECK(queue.getSize() == 2);
+
+    double time;
+    SimTK::RowVector out;
+    queue.pop_front(time, out);
+    CHECK(time == 0.1);
+    CHECK(out.size() == 3);
+    CHECK(out[2] == 1.0);
+    REQUIRE(queue.try_pop_front(time, out));
+    CHECK(time == 0.2);
+    CHECK(out[0] == 2.0);
+    CHECK(!queue.try_pop_front(time, out));
+    CHECK(queue.isEmpty());
+}
+
+TEST_CASE("DataQueue ring buffer mode") {
+    DataQueue_<double> queue;
+    queue.reserve(4, 2);
+    CHECK(queue.isRingBuffer());
+    CHECK(queue.getCapacity() == 4);
+    CHECK(queue.getRowWidth() == 2);
+
+    SimTK::RowVector row(2);
+    for (int i = 0; i < 4; ++i) {
+        row = double(i);
+        REQUIRE(queue.try_push_back(0.1 * i, row));
+    }
+    // The buffer is full.
+    CHECK(!queue.try_push_back(1.0, row));
+    CHECK(queue.getSize() == 4);
+
+    double time;
+    REQUIRE(queue.try_pop_front(time, row));
+    CHECK(time == 0.0);
+
+    // Rows of the wrong width are rejected.
+    SimTK::RowVector wrongWidth(3, 0.0);
+    CHECK_THROWS_AS(queue.try_push_back(0.0, wrongWidth), Exception);
+
+    SimTK::Vector times(5);
+    SimTK::Matrix data(5, 2);
+    CHECK(queue.try_pop_front_batch(5, times, data) == 3);
+    CHECK(times[0] == 0.1);
+    CHECK(data(2, 1) == 3.0);
+    CHECK(queue.isEmpty());
+}
+
+TEST_CASE("DataQueue ring buffer with concurrent producer and consumer") {
+    const int numRows = 10000;
+    DataQueue_<double> queue;
+    queue.reserve(16, 3);
+
+    std::thread producer([&]() {
+        SimTK::RowVector row(3);
+        for (int i = 0; i < numRows; ++i) {
+            row = double(i);
+            queue.push_back(double(i), row);
+        }
+    });
+
+    double time;
+    SimTK::RowVector out(3);
+    bool inOrder = true;
+    for (int i = 0; i < numRows; ++i) {
+        queue.pop_front(time, out);
+        if (time != double(i) || out[0] != double(i) || out[2] != double(i)) {
+            inOrder = false;
+        }
+    }
+    producer.join();
+    CHECK(inOrder);
+    CHECK(queue.isEmpty());
+}
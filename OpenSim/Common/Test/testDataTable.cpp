@@ -27,9 +27,12 @@
 #include <OpenSim/Auxiliary/catch/catch.hpp>
 
 #include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/CopyOnWrite.h>
 #include <OpenSim/Common/PiecewiseLinearFunction.h>
+#include <OpenSim/Common/Signal.h>
 #include <OpenSim/Common/TableUtilities.h>
 #include <OpenSim/Common/STOFileAdapter.h>
+#include <OpenSim/Common/TableCursor.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
 
 using namespace SimTK;
@@ -917,3 +920,224 @@ TEST_CASE("TableUtilities::resample") {
         CHECK(column[5] == Approx(0.0).margin(1e-10));
     }
 }
+
+TEST_CASE("TableUtilities filterLowpass and resample on many columns") {
+    // Large enough to be processed on multiple threads, with a number of
+    // columns that is not a multiple of the block size of the filter.
+    const int numRows = 2000;
+    const int numColumns = 23;
+    SimTK::Vector timeVec = createVectorLinspace(numRows, 0, 2);
+    std::vector<double> time(timeVec.getContiguousScalarData(),
+            timeVec.getContiguousScalarData() + numRows);
+    std::vector<std::string> labels;
+    for (int icol = 0; icol < numColumns; ++icol) {
+        labels.push_back("c" + std::to_string(icol));
+    }
+    SimTK::Matrix matrix(numRows, numColumns);
+    for (int icol = 0; icol < numColumns; ++icol) {
+        matrix.updCol(icol) = SimTK::Test::randVector(numRows);
+    }
+    const TimeSeriesTable table(time, matrix, labels);
+
+    SECTION("filterLowpass") {
+        TimeSeriesTable serial = table;
+        TableUtilities::filterLowpass(serial, 6.0, false, 1);
+        TimeSeriesTable parallel = table;
+        TableUtilities::filterLowpass(parallel, 6.0, false, 4);
+        SimTK::Vector filtered(numRows);
+        for (int icol = 0; icol < numColumns; ++icol) {
+            Signal::LowpassIIR(time[1] - time[0], 6.0, numRows,
+                    table.getDependentColumnAtIndex(icol)
+                            .getContiguousScalarData(),
+                    filtered.updContiguousScalarData());
+            for (int irow = 0; irow < numRows; ++irow) {
+                CHECK(parallel.getMatrix()(irow, icol) ==
+                        serial.getMatrix()(irow, icol));
+                CHECK(parallel.getMatrix()(irow, icol) ==
+                        Approx(filtered[irow]));
+            }
+        }
+    }
+
+    SECTION("resample") {
+        const SimTK::Vector newTime = createVectorLinspace(777, 0.1, 1.9);
+        const TimeSeriesTable serial =
+                TableUtilities::resample(table, newTime, 1);
+        const TimeSeriesTable parallel =
+                TableUtilities::resample(table, newTime, 4);
+        REQUIRE(parallel.getNumRows() == 777);
+        REQUIRE(parallel.getColumnLabels() == labels);
+        CHECK(parallel.getIndependentColumn() ==
+                serial.getIndependentColumn());
+        CHECK(parallel.getIndependentColumn()[5] == newTime[5]);
+        GCVSpline spline(5, numRows, time.data(),
+                table.getDependentColumnAtIndex(7).getContiguousScalarData());
+        for (int irow = 0; irow < 777; ++irow) {
+            CHECK(parallel.getMatrix()(irow, 7) == serial.getMatrix()(irow, 7));
+            CHECK(parallel.getMatrix()(irow, 7) ==
+                    Approx(spline.calcValue(
+                            SimTK::Vector(1, newTime[irow]))));
+        }
+
+        // Repeated times cannot be appended to a TimeSeriesTable.
+        CHECK_THROWS_AS(TableUtilities::resample(
+                                table, createVector({0.5, 0.5})),
+                TimestampLessThanEqualToPrevious);
+    }
+}
+
+TEST_CASE("DataTable appendRows") {
+    TimeSeriesTable table(std::vector<double>{0}, SimTK::Matrix(1, 2, 1.0),
+            std::vector<std::string>{"a", "b"});
+    SimTK::Matrix rows(3, 2);
+    for (int r = 0; r < 3; ++r) {
+        rows(r, 0) = r + 2;
+        rows(r, 1) = -(r + 2);
+    }
+    table.appendRows({0.1, 0.2, 0.3}, rows);
+    REQUIRE(table.getNumRows() == 4);
+    CHECK(table.getIndependentColumn()[3] == 0.3);
+    CHECK(table.getRowAtIndex(0)[1] == 1.0);
+    CHECK(table.getRowAtIndex(2)[0] == 3.0);
+    CHECK(table.getRowAtIndex(3)[1] == -4.0);
+
+    // Invalid rows leave the table unchanged.
+    CHECK_THROWS_AS(table.appendRows({0.4, 0.4}, rows.block(0, 0, 2, 2)),
+            InvalidRow);
+    CHECK_THROWS_AS(table.appendRows({0.4}, rows.block(0, 0, 1, 1)),
+            IncorrectNumColumns);
+    CHECK_THROWS_AS(table.appendRows({0.4}, rows), InvalidArgument);
+    CHECK(table.getNumRows() == 4);
+    CHECK(table.getIndependentColumn().size() == 4);
+}
+
+TEST_CASE("DataTable copies share data until modified") {
+    SECTION("CopyOnWrite") {
+        CopyOnWrite<std::vector<int>> a(std::vector<int>{1, 2});
+        CopyOnWrite<std::vector<int>> b(a);
+        CHECK(a.isShared());
+        CHECK(&a.get() == &b.get());
+        b.upd().push_back(3);
+        CHECK(!a.isShared());
+        CHECK(a->size() == 2);
+        CHECK(b->size() == 3);
+
+        // Copies of a value with a kept reference do not share it.
+        std::vector<int>& kept = a.updUnshared();
+        CopyOnWrite<std::vector<int>> c(a);
+        CHECK(!a.isShared());
+        kept[0] = 10;
+        CHECK((*c)[0] == 1);
+        // Assigning a new value makes it shareable again.
+        a = std::vector<int>{4};
+        CopyOnWrite<std::vector<int>> d(a);
+        CHECK(d.isShared());
+    }
+
+    std::vector<double> time{0, 0.1, 0.2};
+    SimTK::Matrix matrix(3, 2, 1.0);
+    TimeSeriesTable table(std::move(time), std::move(matrix),
+            std::vector<std::string>{"a", "b"});
+    table.addTableMetaData("key", std::string("value"));
+    REQUIRE(table.getNumRows() == 3);
+    REQUIRE(table.getNumColumns() == 2);
+
+    SECTION("Copies share data") {
+        TimeSeriesTable copy(table);
+        CHECK(&copy.getMatrix() == &table.getMatrix());
+        CHECK(&copy.getIndependentColumn() == &table.getIndependentColumn());
+        CHECK(&copy.getTableMetaData() == &table.getTableMetaData());
+    }
+
+    SECTION("Modifying a copy leaves the original unchanged") {
+        TimeSeriesTable copy(table);
+        copy.setRowAtIndex(1, SimTK::RowVector(2, 5.0));
+        copy.appendRow(0.3, SimTK::RowVector(2, 6.0));
+        copy.removeColumn("a");
+        copy.removeTableMetaDataKey("key");
+        CHECK(copy.getNumRows() == 4);
+        CHECK(copy.getNumColumns() == 1);
+        CHECK(copy.getRowAtIndex(1)[0] == 5.0);
+        CHECK(table.getNumRows() == 3);
+        CHECK(table.getNumColumns() == 2);
+        CHECK(table.getRowAtIndex(1)[0] == 1.0);
+        CHECK(table.getIndependentColumn().size() == 3);
+        CHECK(table.getTableMetaData().hasKey("key"));
+    }
+
+    SECTION("Views from upd methods are not shared by later copies") {
+        auto view = table.updMatrix();
+        TimeSeriesTable copy(table);
+        CHECK(&copy.getMatrix() != &table.getMatrix());
+        view(0, 0) = 7.0;
+        CHECK(table.getRowAtIndex(0)[0] == 7.0);
+        CHECK(copy.getRowAtIndex(0)[0] == 1.0);
+
+        // A copy made before taking the view is not modified through it.
+        TimeSeriesTable other(copy);
+        auto row = copy.updRowAtIndex(2);
+        row[1] = 8.0;
+        CHECK(copy.getRowAtIndex(2)[1] == 8.0);
+        CHECK(other.getRowAtIndex(2)[1] == 1.0);
+    }
+}
+
+TEST_CASE("TableCursor") {
+    // Uniformly sampled times, except that the times are perturbed by less
+    // than a tenth of the interval.
+    std::vector<double> uniformTimes;
+    for (int i = 0; i < 11; ++i) {
+        uniformTimes.push_back(0.1 * i + (i % 2 ? 1e-4 : 0));
+    }
+    std::vector<double> nonuniformTimes{0, 0.05, 0.3, 0.35, 0.8, 1.0};
+    for (const auto& times : {uniformTimes, nonuniformTimes}) {
+        SimTK::Matrix matrix((int)times.size(), 2);
+        for (int i = 0; i < (int)times.size(); ++i) {
+            matrix(i, 0) = times[i] * times[i];
+            matrix(i, 1) = -times[i];
+        }
+        TimeSeriesTable table(times, matrix,
+                std::vector<std::string>{"a", "b"});
+        TableCursor cursor(table);
+        CHECK(cursor.isUniformlySampled() == (times.size() == 11));
+
+        // The nearest rows are those of the table, also when the times go
+        // backward.
+        for (double time : {0.0, 0.02, 0.025, 0.3, 0.31, 0.7, 1.0, 0.4, 0.0,
+                     0.999, 0.5}) {
+            INFO(time);
+            CHECK(cursor.getNearestRowIndex(time) ==
+                    table.getNearestRowIndexForTime(time));
+        }
+        CHECK_THROWS_AS(cursor.seek(-0.1), TimeOutOfRange);
+        CHECK_THROWS_AS(cursor.seek(times.back() + 0.1), TimeOutOfRange);
+
+        // Linear interpolation.
+        SimTK::RowVector values;
+        cursor.getValuesAtTime(times[2], values);
+        REQUIRE(values.size() == 2);
+        CHECK(values[0] == Approx(times[2] * times[2]));
+        const double mid = 0.5 * (times[2] + times[3]);
+        cursor.getValuesAtTime(mid, values);
+        CHECK(values[0] == Approx(0.5 * (matrix(2, 0) + matrix(3, 0))));
+        CHECK(values[1] == Approx(-mid));
+        cursor.getValuesAtTime(times.back(), values);
+        CHECK(values[0] == Approx(matrix((int)times.size() - 1, 0)));
+
+        // Hermite interpolation is exact for linear data, and for quadratic
+        // data in the interior of uniformly sampled tables.
+        cursor.getValuesAtTime(mid, values,
+                TableCursor::Interpolation::Hermite);
+        CHECK(values[1] == Approx(-mid));
+    }
+
+    TimeSeriesTable table(std::vector<double>{0, 0.1, 0.2, 0.3, 0.4},
+            SimTK::Matrix(5, 1, 0.0), std::vector<std::string>{"a"});
+    for (int i = 0; i < 5; ++i) table.updMatrix()(i, 0) = 0.01 * i * i;
+    TableCursor cursor(table);
+    SimTK::RowVector values;
+    cursor.getValuesAtTime(0.25, values, TableCursor::Interpolation::Hermite);
+    CHECK(values[0] == Approx(0.25 * 0.25));
+    cursor.getValuesAtTime(0.25, values);
+    CHECK(values[0] == Approx(0.5 * (0.04 + 0.09)));
+}
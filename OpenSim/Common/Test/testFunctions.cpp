@@ -24,10 +24,17 @@
 #include "ComponentsForTesting.h"
 
 #include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/Constant.h>
+#include <OpenSim/Common/FunctionSet.h>
+#include <OpenSim/Common/GCVSpline.h>
+#include <OpenSim/Common/MultiplierFunction.h>
 #include <OpenSim/Common/MultivariatePolynomialFunction.h>
 #include <OpenSim/Common/Reporter.h>
+#include <OpenSim/Common/PiecewiseLinearFunction.h>
 #include <OpenSim/Common/SignalGenerator.h>
+#include <OpenSim/Common/SimmSpline.h>
 #include <OpenSim/Common/Sine.h>
+#include <OpenSim/Common/XYFunctionInterface.h>
 
 #define CATCH_CONFIG_MAIN
 #include <OpenSim/Auxiliary/catch/catch.hpp>
@@ -93,6 +100,132 @@ TEST_CASE("Interpolate using PiecewiseLinearFunction") {
     SimTK_TEST(SimTK::isNaN(newY[3]));
 }
 
+TEST_CASE("findInterval()") {
+    const SimTK::Vector x = createVector({0, 1, 2, 2, 3, 5, 8});
+    const int n = x.size();
+    const SimTK::Vector values =
+            createVector({-1, 0, 0.5, 1, 2, 2.5, 3, 4.9, 5, 7, 8, 9});
+    const std::vector<int> expected = {0, 0, 0, 1, 3, 3, 4, 4, 5, 5, 5, 5};
+    for (int i = 0; i < values.size(); ++i) {
+        // The result must not depend on the hint.
+        for (int hint = -2; hint < n + 2; ++hint) {
+            CHECK(findInterval(&x[0], n, values[i], hint) == expected[i]);
+        }
+    }
+}
+
+TEST_CASE("PiecewiseLinearFunction and SimmSpline interval hints") {
+    const int n = 20;
+    double x[n], y[n];
+    for (int i = 0; i < n; ++i) {
+        x[i] = 0.1 * i * i;
+        y[i] = std::sin(x[i]);
+    }
+    PiecewiseLinearFunction linear(n, x, y);
+    SimmSpline spline(n, x, y);
+
+    // Sorted values, including some outside the range of the knots.
+    const int nt = 200;
+    SimTK::Vector times(nt);
+    for (int i = 0; i < nt; ++i) times[i] = -1.0 + 40.0 * i / (nt - 1);
+
+    auto check = [&](const Function& f, int derivOrder) {
+        SimTK::Vector values;
+        if (const auto* plf = dynamic_cast<const PiecewiseLinearFunction*>(&f))
+            plf->evaluate(times, derivOrder, values);
+        else
+            dynamic_cast<const SimmSpline&>(f).evaluate(
+                    times, derivOrder, values);
+        REQUIRE(values.size() == nt);
+        const std::vector<int> derivComponents(derivOrder, 0);
+        // Visit the points out of order so that the hint is often wrong;
+        // each result must match a fresh copy without a useful hint.
+        for (int j = 0; j < nt; ++j) {
+            const int i = (j * 37) % nt;
+            const SimTK::Vector t(1, times[i]);
+            std::unique_ptr<Function> fresh(f.clone());
+            const double value = derivOrder == 0 ? f.calcValue(t) :
+                    f.calcDerivative(derivComponents, t);
+            const double expected = derivOrder == 0 ? fresh->calcValue(t) :
+                    fresh->calcDerivative(derivComponents, t);
+            CHECK(value == expected);
+            CHECK(values[i] == expected);
+        }
+    };
+    for (int derivOrder = 0; derivOrder <= 2; ++derivOrder) {
+        check(linear, derivOrder);
+        check(spline, derivOrder);
+    }
+
+    SimTK::Vector values;
+    CHECK_THROWS_AS(linear.evaluate(times, -1, values), Exception);
+    CHECK_THROWS_AS(spline.evaluate(times, 3, values), Exception);
+}
+
+TEST_CASE("SimTK::Functions of SimmSpline and MultiplierFunction") {
+    // These are the functions of the TransformAxes of CustomJoints.
+    const int n = 10;
+    double x[n], y[n];
+    for (int i = 0; i < n; ++i) {
+        x[i] = 0.2 * i;
+        y[i] = std::cos(x[i]);
+    }
+    SimmSpline spline(n, x, y);
+    MultiplierFunction multiplier(spline.clone(), -0.5);
+    std::unique_ptr<SimTK::Function> splineFunction(
+            spline.createSimTKFunction());
+    std::unique_ptr<SimTK::Function> multiplierFunction(
+            multiplier.createSimTKFunction());
+    CHECK(splineFunction->getArgumentSize() == 1);
+    CHECK(splineFunction->getMaxDerivativeOrder() == 2);
+    CHECK(multiplierFunction->getMaxDerivativeOrder() == 2);
+
+    for (int i = 0; i < 100; ++i) {
+        const SimTK::Vector t(1, -0.5 + 0.03 * i);
+        CHECK(splineFunction->calcValue(t) == spline.calcValue(t));
+        CHECK(multiplierFunction->calcValue(t) == multiplier.calcValue(t));
+        for (int derivOrder = 1; derivOrder <= 2; ++derivOrder) {
+            const SimTK::Array_<int> components(derivOrder, 0);
+            const std::vector<int> derivComponents(derivOrder, 0);
+            CHECK(splineFunction->calcDerivative(components, t) ==
+                    spline.calcDerivative(derivComponents, t));
+            CHECK(multiplierFunction->calcDerivative(components, t) ==
+                    multiplier.calcDerivative(derivComponents, t));
+        }
+    }
+    CHECK_THROWS_AS(splineFunction->calcDerivative(
+            SimTK::Array_<int>(3, 0), SimTK::Vector(1, 0.0)), Exception);
+}
+
+TEST_CASE("Copies of splines share their coefficients until modified") {
+    const int n = 10;
+    double x[n], y[n];
+    for (int i = 0; i < n; ++i) {
+        x[i] = 0.2 * i;
+        y[i] = std::cos(x[i]);
+    }
+    SimmSpline simmSpline(n, x, y);
+    GCVSpline gcvSpline(5, n, x, y);
+    const SimTK::Vector t(1, 0.5);
+    const double simmValue = simmSpline.calcValue(t);
+    const double gcvValue = gcvSpline.calcValue(t);
+
+    for (Function* original : std::vector<Function*>{&simmSpline,
+                &gcvSpline}) {
+        const double value = original->calcValue(t);
+        std::unique_ptr<Function> copy(original->clone());
+        CHECK(copy->calcValue(t) == value);
+
+        // Modifying the copy does not modify the original.
+        XYFunctionInterface xy(copy.get());
+        xy.setY(2, 10.0);
+        CHECK(copy->calcValue(t) != value);
+        CHECK(original->calcValue(t) == value);
+    }
+    CHECK(simmSpline.calcValue(t) == simmValue);
+    CHECK(gcvSpline.calcValue(t) == gcvValue);
+}
+
 TEST_CASE("MultivariatePolynomialFunction") {
     SECTION("Input errors") {
         {
@@ -161,6 +294,29 @@ TEST_CASE("MultivariatePolynomialFunction") {
                           c[6] * input[0];
         CHECK(f.calcValue(input) == expected);
     }
+    SECTION("calcValueAndGradient() matches calcValue() and calcDerivative()") {
+        for (int dimension = 1; dimension <= 6; ++dimension) {
+            for (int order = 0; order <= 4; ++order) {
+                // The number of terms is (order + dimension) choose dimension.
+                int numCoefficients = 1;
+                for (int i = 1; i <= dimension; ++i) {
+                    numCoefficients = numCoefficients * (order + i) / i;
+                }
+                MultivariatePolynomialFunction f(
+                        SimTK::Test::randVector(numCoefficients), dimension,
+                        order);
+                const SimTK::Vector x = SimTK::Test::randVector(dimension);
+                SimTK::Vector gradient;
+                const double value = f.calcValueAndGradient(x, gradient);
+                CHECK(value == Approx(f.calcValue(x)));
+                REQUIRE(gradient.size() == dimension);
+                for (int i = 0; i < dimension; ++i) {
+                    CHECK(gradient[i] ==
+                            Approx(f.calcDerivative({i}, x)).margin(1e-12));
+                }
+            }
+        }
+    }
 }
 
 TEST_CASE("solveBisection()") {
@@ -185,3 +341,47 @@ TEST_CASE("solveBisection()") {
         REQUIRE_THROWS_AS(solveBisection(parabola, -5, 5), OpenSim::Exception);
     }
 }
+
+TEST_CASE("Set lookup by name") {
+    // The Set is large enough for the lookups to use the name index.
+    FunctionSet set;
+    const int size = 40;
+    for (int i = 0; i < size; ++i) {
+        auto* function = new Constant(i);
+        function->setName("f" + std::to_string(i));
+        set.adoptAndAppend(function);
+    }
+    for (int i = 0; i < size; ++i) {
+        const std::string name = "f" + std::to_string(i);
+        CHECK(set.getIndex(name) == i);
+        CHECK(set.contains(name));
+        CHECK(&set.get(name) == &set.get(i));
+    }
+    CHECK(set.getIndex("g") == -1);
+    CHECK_FALSE(set.contains("g"));
+    CHECK_THROWS_AS(set.get("g"), OpenSim::Exception);
+
+    SECTION("Renaming an object") {
+        set.get(5).setName("renamed");
+        CHECK(set.getIndex("renamed") == 5);
+        CHECK_FALSE(set.contains("f5"));
+    }
+
+    SECTION("Removing and inserting objects") {
+        set.remove(0);
+        CHECK(set.getIndex("f1") == 0);
+        CHECK_FALSE(set.contains("f0"));
+        auto* function = new Constant(0);
+        function->setName("f0");
+        set.insert(0, function);
+        CHECK(set.getIndex("f0") == 0);
+        CHECK(set.getIndex("f1") == 1);
+    }
+
+    SECTION("Duplicate names and the start index") {
+        set.get(30).setName("f10");
+        CHECK(set.getIndex("f10") == 10);
+        CHECK(set.getIndex("f10", 11) == 30);
+        CHECK(set.getIndex("f10", 31) == 10);
+    }
+}
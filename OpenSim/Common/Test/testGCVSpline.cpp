@@ -22,6 +22,7 @@
 
 #include <OpenSim/Common/GCVSpline.h>
 #include <OpenSim/Common/GCVSplineSet.h>
+#include <OpenSim/Common/IO.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
 #define CATCH_CONFIG_MAIN
@@ -86,3 +87,156 @@ TEST_CASE("GCVSpline Behaves as Expected")
             "Duplicate GCVSpline failed to reproduce identical first derivative.");
     }
 }
+
+TEST_CASE("GCVSpline direct and batch evaluation match calcValue")
+{
+    const int size = 101;
+    const double dt = 0.01;
+    TimeSeriesTable table;
+    table.setColumnLabels({"a", "b"});
+    for (int i = 0; i < size; ++i) {
+        const double x = dt*i;
+        SimTK::RowVector row(2);
+        row[0] = sin(3*x);
+        row[1] = x*x*x;
+        table.appendRow(x, row);
+    }
+    GCVSplineSet splines(table);
+    const GCVSpline& spline = *splines.getGCVSpline(0);
+
+    // Sorted times, including some outside the range of the data.
+    const int nt = 257;
+    SimTK::Vector times(nt);
+    for (int i = 0; i < nt; ++i) times[i] = -0.05 + 1.1*i/(nt - 1);
+
+    for (int order = 0; order <= 6; ++order) {
+        SimTK::Vector values;
+        spline.evaluate(times, order, values);
+        REQUIRE(values.size() == nt);
+        std::vector<int> derivComponents(order, 0);
+        for (int i = 0; i < nt; ++i) {
+            const SimTK::Vector t(1, times[i]);
+            const double expected = order == 0 ? spline.calcValue(t) :
+                    spline.calcDerivative(derivComponents, t);
+            CHECK(values[i] == Approx(expected).margin(1e-10));
+            CHECK(spline.evaluate(times[i], order) == values[i]);
+        }
+    }
+
+    // Unsorted times give the same results.
+    SimTK::Vector reversed(nt);
+    for (int i = 0; i < nt; ++i) reversed[i] = times[nt - 1 - i];
+    SimTK::Vector forward, backward;
+    spline.evaluate(times, 1, forward);
+    spline.evaluate(reversed, 1, backward);
+    for (int i = 0; i < nt; ++i) CHECK(backward[i] == forward[nt - 1 - i]);
+
+    CHECK_THROWS_AS(spline.evaluate(0.5, -1), Exception);
+
+    for (int order = 0; order <= 2; ++order) {
+        const SimTK::Vector values = splines.evaluateAll(0.505, order);
+        REQUIRE(values.size() == 2);
+        for (int i = 0; i < 2; ++i) {
+            CHECK(values[i] ==
+                    Approx(splines.evaluate(i, order, 0.505)).margin(1e-10));
+        }
+    }
+}
+
+TEST_CASE("GCVSpline coefficient weights match direct evaluation")
+{
+    const int size = 101;
+    const double dt = 0.01;
+    TimeSeriesTable table;
+    table.setColumnLabels({"a", "b", "c"});
+    for (int i = 0; i < size; ++i) {
+        const double x = dt*i;
+        SimTK::RowVector row(3);
+        row[0] = sin(3*x);
+        row[1] = x*x*x;
+        row[2] = exp(-x);
+        table.appendRow(x, row);
+    }
+    for (int degree : {1, 3, 5, 7}) {
+        GCVSplineSet splines(table, {}, degree);
+        const GCVSpline& first = *splines.getGCVSpline(0);
+        for (int i = 0; i < 3; ++i) {
+            CHECK(splines.getGCVSpline(i)->hasSameKnots(first));
+        }
+
+        // Times inside and outside the range of the data.
+        int interval = 0;
+        SimTK::Matrix weights;
+        for (double x : {-0.05, 0.0, 0.123, 0.5, 0.505, 0.999, 1.0, 1.07}) {
+            int firstCoefficient = -1;
+            first.calcCoefficientWeights(x, 2, interval, firstCoefficient,
+                    weights);
+            REQUIRE(weights.nrow() == 3);
+            for (int i = 0; i < 3; ++i) {
+                const GCVSpline& spline = *splines.getGCVSpline(i);
+                for (int order = 0; order <= 2; ++order) {
+                    CHECK(spline.evaluate(order, firstCoefficient, weights) ==
+                            Approx(spline.evaluate(x, order)).margin(1e-10));
+                }
+            }
+        }
+    }
+
+    // Splines of another degree do not share the weights.
+    GCVSplineSet cubic(table, {}, 3);
+    GCVSplineSet quintic(table, {}, 5);
+    CHECK_FALSE(cubic.getGCVSpline(0)->hasSameKnots(
+            *quintic.getGCVSpline(0)));
+
+    int interval = 0;
+    int firstCoefficient = 0;
+    SimTK::Matrix weights;
+    CHECK_THROWS_AS(cubic.getGCVSpline(0)->calcCoefficientWeights(0.5, -1,
+            interval, firstCoefficient, weights), Exception);
+}
+
+TEST_CASE("GCVSplineSet fits columns in parallel and caches the fits")
+{
+    // Enough data points for the columns to be fit on multiple threads.
+    const int size = 3000;
+    const int numColumns = 12;
+    TimeSeriesTable table;
+    std::vector<std::string> labels;
+    for (int j = 0; j < numColumns; ++j) labels.push_back(to_string(j));
+    table.setColumnLabels(labels);
+    for (int i = 0; i < size; ++i) {
+        const double x = 0.001*i;
+        SimTK::RowVector row(numColumns);
+        for (int j = 0; j < numColumns; ++j) row[j] = sin((j + 1)*x) + 0.1*j;
+        table.appendRow(x, row);
+    }
+    const auto& time = table.getIndependentColumn();
+
+    const GCVSplineSet splines(table, {}, 5, -1);
+    REQUIRE(splines.getSize() == numColumns);
+    for (int j = 0; j < numColumns; ++j) {
+        const GCVSpline expected(5, size, time.data(),
+                table.getDependentColumnAtIndex(j).getContiguousScalarData(),
+                "", -1);
+        for (double x : {0.0, 0.5123, 1.7, 2.999}) {
+            CHECK(splines.getGCVSpline(j)->evaluate(x) == expected.evaluate(x));
+        }
+    }
+
+    const std::string cacheDir = "testGCVSpline_cache";
+    IO::makeDir(cacheDir);
+    GCVSplineSet::setCacheDirectory(cacheDir);
+    // The first set writes the cache file, and the second reads it.
+    const GCVSplineSet written(table, {}, 5, -1);
+    const GCVSplineSet read(table, {}, 5, -1);
+    GCVSplineSet::setCacheDirectory("");
+    for (int j = 0; j < numColumns; ++j) {
+        const SimTK::Vector x(1, 1.2345);
+        for (int order = 0; order <= 2; ++order) {
+            CHECK(read.getGCVSpline(j)->evaluate(x[0], order) ==
+                    splines.getGCVSpline(j)->evaluate(x[0], order));
+        }
+        CHECK(read.get(j).calcValue(x) ==
+                Approx(splines.get(j).calcValue(x)).margin(1e-12));
+    }
+}
@@ -0,0 +1,128 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  testHDF5FileAdapter.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+
+#include <OpenSim/Common/Adapters.h>
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch/catch.hpp>
+
+using namespace OpenSim;
+
+TEST_CASE("HDF5FileAdapter round trip of a TimeSeriesTable") {
+    TimeSeriesTable table;
+    table.setColumnLabels({"hip_flexion", "knee_angle", "ankle_angle"});
+    table.addTableMetaData("inDegrees", std::string("no"));
+    table.addTableMetaData("scale", 2.5);
+    table.addTableMetaData("trial", 7);
+    SimTK::RowVector row(3);
+    for (int i = 0; i < 50; ++i) {
+        row[0] = 0.1 * i;
+        row[1] = -0.2 * i;
+        row[2] = std::sqrt(double(i));
+        table.appendRow(0.01 * i, row);
+    }
+    const std::string filename = "testHDF5FileAdapter_double.h5";
+
+    for (int level : {0, 9}) {
+        HDF5FileAdapter adapter;
+        adapter.setCompressionLevel(level);
+        adapter.setChunkSize(16);
+        adapter.writeTables({{HDF5FileAdapter::tableString(), &table}},
+                filename);
+
+        TimeSeriesTable fromFile(filename);
+        CHECK(fromFile.getColumnLabels() == table.getColumnLabels());
+        CHECK(fromFile.getIndependentColumn() ==
+                table.getIndependentColumn());
+        CHECK(fromFile.getTableMetaData<std::string>("inDegrees") == "no");
+        CHECK(fromFile.getTableMetaData<double>("scale") == 2.5);
+        CHECK(fromFile.getTableMetaData<int>("trial") == 7);
+        REQUIRE(fromFile.getNumRows() == table.getNumRows());
+        for (int i = 0; i < (int)table.getNumRows(); ++i) {
+            for (int j = 0; j < 3; ++j) {
+                CHECK(fromFile.getMatrix()(i, j) == table.getMatrix()(i, j));
+            }
+        }
+    }
+
+    HDF5FileAdapter adapter;
+    CHECK_THROWS(adapter.setCompressionLevel(10));
+    CHECK_THROWS(adapter.setChunkSize(0));
+}
+
+TEST_CASE("HDF5FileAdapter writes tables of all element types to one file") {
+    TimeSeriesTableVec3 markers;
+    markers.setColumnLabels({"marker1", "marker2"});
+    SimTK::RowVector_<SimTK::Vec3> markerRow(2);
+    TimeSeriesTableQuaternion orientations;
+    orientations.setColumnLabels({"pelvis_imu"});
+    SimTK::RowVector_<SimTK::Quaternion> orientationRow(1);
+    TimeSeriesTable_<SimTK::SpatialVec> wrenches;
+    wrenches.setColumnLabels({"calcn_r"});
+    SimTK::RowVector_<SimTK::SpatialVec> wrenchRow(1);
+    for (int i = 0; i < 10; ++i) {
+        markerRow[0] = SimTK::Vec3(i, 2 * i, 3 * i);
+        markerRow[1] = SimTK::Vec3(-i, 0.5, SimTK::NaN);
+        markers.appendRow(0.1 * i, markerRow);
+        orientationRow[0] = SimTK::Quaternion(
+                SimTK::Rotation(0.1 * i, SimTK::ZAxis));
+        orientations.appendRow(0.1 * i, orientationRow);
+        wrenchRow[0] = SimTK::SpatialVec(SimTK::Vec3(i), SimTK::Vec3(-i));
+        wrenches.appendRow(0.1 * i, wrenchRow);
+    }
+    // A table without rows.
+    TimeSeriesTable empty;
+    empty.setColumnLabels({"a"});
+
+    const std::string filename = "testHDF5FileAdapter_trial.h5";
+    FileAdapter::writeFile({{"markers", &markers},
+                            {"imu/orientations", &orientations},
+                            {"imu/wrenches", &wrenches},
+                            {"empty", &empty}}, filename);
+
+    auto tables = HDF5FileAdapter().read(filename);
+    REQUIRE(tables.size() == 4);
+    CHECK(tables.count("imu/orientations"));
+    CHECK(tables.at("empty")->getNumRows() == 0);
+
+    TimeSeriesTableVec3 markersFromFile(filename, "markers");
+    REQUIRE(markersFromFile.getNumRows() == 10);
+    CHECK(markersFromFile.getColumnLabels() == markers.getColumnLabels());
+    CHECK(markersFromFile.getRowAtIndex(4)[0] == markers.getRowAtIndex(4)[0]);
+    CHECK(markersFromFile.getRowAtIndex(4)[1][1] == 0.5);
+    CHECK(SimTK::isNaN(markersFromFile.getRowAtIndex(4)[1][2]));
+
+    TimeSeriesTableQuaternion orientationsFromFile(
+            filename, "imu/orientations");
+    CHECK(orientationsFromFile.getRowAtIndex(3)[0] ==
+            orientations.getRowAtIndex(3)[0]);
+    TimeSeriesTable_<SimTK::SpatialVec> wrenchesFromFile(
+            filename, "imu/wrenches");
+    CHECK(wrenchesFromFile.getRowAtIndex(9)[0] ==
+            wrenches.getRowAtIndex(9)[0]);
+
+    // Reading a table of the wrong type fails.
+    CHECK_THROWS(TimeSeriesTable(filename, "markers"));
+    // A file with several tables requires the name of the table.
+    CHECK_THROWS(TimeSeriesTableVec3(filename));
+}
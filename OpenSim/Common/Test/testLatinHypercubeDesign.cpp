@@ -23,6 +23,9 @@
 
 #include <OpenSim/Common/LatinHypercubeDesign.h>
 
+#include <algorithm>
+#include <cmath>
+
 #define CATCH_CONFIG_MAIN
 #include <OpenSim/Auxiliary/catch/catch.hpp>
 
@@ -98,6 +101,60 @@ TEST_CASE("Distance criterion values") {
     REQUIRE(lhs.evaluateDesign(design) >= 0.0);
 }
 
+TEST_CASE("Distance criterion values match their definitions") {
+    LatinHypercubeDesign lhs;
+    lhs.setNumSamples(40);
+    lhs.setNumVariables(3);
+    lhs.setPhiPDistanceExponent(5);
+    lhs.setNumThreads(3);
+    SimTK::Matrix design = lhs.generateRandomDesign(1);
+
+    double minDistance = SimTK::Infinity;
+    double sumInverseDistancesP = 0;
+    for (int i = 0; i < design.nrow(); ++i) {
+        for (int j = i + 1; j < design.nrow(); ++j) {
+            const SimTK::RowVector diff = design.row(i) - design.row(j);
+            minDistance = std::min(minDistance, diff.norm());
+            sumInverseDistancesP += std::pow(1.0 / diff.abs().sum(), 5);
+        }
+    }
+    lhs.setDistanceCriterion("maximin");
+    REQUIRE_THAT(lhs.evaluateDesign(design),
+            Catch::Matchers::WithinRel(-minDistance, 1e-12));
+    lhs.setDistanceCriterion("phi_p");
+    REQUIRE_THAT(lhs.evaluateDesign(design),
+            Catch::Matchers::WithinRel(
+                    std::pow(sumInverseDistancesP, 1.0 / 5), 1e-12));
+}
+
+TEST_CASE("Stochastic evolutionary algorithm keeps a Latin hypercube") {
+    for (const std::string criterion : {"maximin", "phi_p"}) {
+        LatinHypercubeDesign lhs;
+        lhs.setNumSamples(30);
+        lhs.setNumVariables(3);
+        lhs.setDistanceCriterion(criterion);
+        lhs.setPhiPDistanceExponent(10);
+        SimTK::Matrix initial = lhs.generateRandomDesign(1);
+        SimTK::Matrix design =
+                lhs.generateStochasticEvolutionaryDesign(3, initial);
+
+        // The exchanges of elements within the columns improve the design
+        // and keep the values of each column.
+        CAPTURE(criterion);
+        REQUIRE(lhs.evaluateDesign(design) <= lhs.evaluateDesign(initial));
+        for (int j = 0; j < design.ncol(); ++j) {
+            std::vector<double> initialColumn, column;
+            for (int i = 0; i < design.nrow(); ++i) {
+                initialColumn.push_back(initial(i, j));
+                column.push_back(design(i, j));
+            }
+            std::sort(initialColumn.begin(), initialColumn.end());
+            std::sort(column.begin(), column.end());
+            REQUIRE(column == initialColumn);
+        }
+    }
+}
+
 TEST_CASE("Invalid configurations") {
     LatinHypercubeDesign lhs;
 
@@ -0,0 +1,82 @@
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  testLogger.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Common/LogSink.h>
+#include <OpenSim/Common/Logger.h>
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch/catch.hpp>
+
+using namespace OpenSim;
+
+TEST_CASE("Logger asynchronous mode") {
+    Logger::removeFileSink();
+    auto sink = std::make_shared<StringLogSink>();
+    Logger::addSink(sink);
+
+    SECTION("Block keeps all messages in order") {
+        Logger::enableAsync(4, Logger::OverflowPolicy::Block);
+        CHECK(Logger::isAsync());
+        std::string expected;
+        for (int i = 0; i < 100; ++i) {
+            log_info("message {}", i);
+            expected += "message " + std::to_string(i) + "\n";
+        }
+        // The queued messages are written before this returns.
+        Logger::disableAsync();
+        CHECK_FALSE(Logger::isAsync());
+        CHECK(sink->getString() == expected);
+    }
+
+    SECTION("DiscardOldest keeps the newest message") {
+        Logger::enableAsync(4, Logger::OverflowPolicy::DiscardOldest);
+        for (int i = 0; i < 1000; ++i) log_info("message {}", i);
+        Logger::disableAsync();
+        CHECK(sink->getString().find("message 999\n") != std::string::npos);
+    }
+
+    SECTION("Sinks can be added and removed in the asynchronous mode") {
+        Logger::enableAsync();
+        auto otherSink = std::make_shared<StringLogSink>();
+        Logger::addSink(otherSink);
+        log_info("to both sinks");
+        Logger::removeSink(otherSink);
+        log_info("to one sink");
+        Logger::disableAsync();
+        CHECK(otherSink->getString() == "to both sinks\n");
+        CHECK(sink->getString() == "to both sinks\nto one sink\n");
+    }
+
+    SECTION("The level applies in the asynchronous mode") {
+        Logger::enableAsync();
+        Logger::setLevel(Logger::Level::Warn);
+        log_info("not logged");
+        log_warn("logged");
+        Logger::setLevel(Logger::Level::Info);
+        Logger::disableAsync();
+        CHECK(sink->getString().find("not logged") == std::string::npos);
+        CHECK(sink->getString().find("logged\n") != std::string::npos);
+    }
+
+    CHECK_THROWS(Logger::enableAsync(0));
+    Logger::removeSink(sink);
+}
@@ -0,0 +1,113 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  testOSBFileAdapter.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Common/Adapters.h>
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch/catch.hpp>
+
+using namespace OpenSim;
+
+TEST_CASE("OSBFileAdapter round trip of a TimeSeriesTable") {
+    TimeSeriesTable table;
+    table.setColumnLabels({"hip_flexion", "knee_angle", "ankle_angle"});
+    table.addTableMetaData("inDegrees", std::string("no"));
+    SimTK::RowVector row(3);
+    for (int i = 0; i < 50; ++i) {
+        row[0] = 0.1 * i;
+        row[1] = -0.2 * i;
+        row[2] = std::sqrt(double(i));
+        table.appendRow(0.01 * i, row);
+    }
+    const std::string filename = "testOSBFileAdapter_double.osb";
+    OSBFileAdapter::write(table, filename);
+
+    TimeSeriesTable fromFile(filename);
+    CHECK(fromFile.getColumnLabels() == table.getColumnLabels());
+    CHECK(fromFile.getIndependentColumn() == table.getIndependentColumn());
+    CHECK(fromFile.getTableMetaData<std::string>("inDegrees") == "no");
+    REQUIRE(fromFile.getNumRows() == table.getNumRows());
+    for (int i = 0; i < (int)table.getNumRows(); ++i) {
+        for (int j = 0; j < 3; ++j) {
+            CHECK(fromFile.getMatrix()(i, j) == table.getMatrix()(i, j));
+        }
+    }
+
+    SECTION("Read a single column") {
+        const auto time = OSBFileAdapter::readIndependentColumn(filename);
+        CHECK(time == table.getIndependentColumn());
+        const auto knee = OSBFileAdapter::readDependentColumn<double>(
+                filename, "knee_angle");
+        REQUIRE(knee.size() == 50);
+        CHECK(knee[10] == table.getDependentColumn("knee_angle")[10]);
+        CHECK_THROWS_AS(OSBFileAdapter::readDependentColumn<double>(
+                                filename, "nonexistent"),
+                KeyNotFound);
+        CHECK_THROWS_AS(OSBFileAdapter::readDependentColumn<SimTK::Vec3>(
+                                filename, "knee_angle"),
+                IncorrectTableType);
+    }
+
+    SECTION("Read some columns in a time window") {
+        CHECK(OSBFileAdapter::readColumnLabels(filename) ==
+                table.getColumnLabels());
+        const auto part = OSBFileAdapter::readColumns(
+                filename, {"ankle_angle", "hip_flexion"}, 0.095, 0.205);
+        CHECK(part.getColumnLabels() ==
+                std::vector<std::string>{"ankle_angle", "hip_flexion"});
+        CHECK(part.getTableMetaData<std::string>("inDegrees") == "no");
+        REQUIRE(part.getNumRows() == 11);
+        for (int i = 0; i < 11; ++i) {
+            CHECK(part.getIndependentColumn()[i] ==
+                    table.getIndependentColumn()[i + 10]);
+            CHECK(part.getMatrix()(i, 0) == table.getMatrix()(i + 10, 2));
+            CHECK(part.getMatrix()(i, 1) == table.getMatrix()(i + 10, 0));
+        }
+        CHECK(OSBFileAdapter::readColumns(filename, {}).getNumColumns() == 3);
+        CHECK(OSBFileAdapter::readColumns(filename, {}, 1, 2).getNumRows() ==
+                0);
+        CHECK_THROWS_AS(OSBFileAdapter::readColumns(filename, {"nonexistent"}),
+                KeyNotFound);
+    }
+}
+
+TEST_CASE("OSBFileAdapter round trip of a TimeSeriesTableVec3") {
+    TimeSeriesTableVec3 table;
+    table.setColumnLabels({"marker1", "marker2"});
+    SimTK::RowVector_<SimTK::Vec3> row(2);
+    for (int i = 0; i < 10; ++i) {
+        row[0] = SimTK::Vec3(i, 2 * i, 3 * i);
+        row[1] = SimTK::Vec3(-i, 0.5, SimTK::NaN);
+        table.appendRow(0.1 * i, row);
+    }
+    const std::string filename = "testOSBFileAdapter_Vec3.osb";
+    FileAdapter::writeFile({{"table", &table}}, filename);
+
+    TimeSeriesTableVec3 fromFile(filename);
+    REQUIRE(fromFile.getNumRows() == 10);
+    CHECK(fromFile.getRowAtIndex(4)[0] == table.getRowAtIndex(4)[0]);
+    CHECK(fromFile.getRowAtIndex(4)[1][1] == 0.5);
+    CHECK(SimTK::isNaN(fromFile.getRowAtIndex(4)[1][2]));
+
+    // Reading a table of the wrong type fails.
+    CHECK_THROWS(TimeSeriesTable(filename));
+}
@@ -40,6 +40,7 @@
 #include <OpenSim/Common/RootSolver.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include "ExampleVectorFunctionUncoupledNxN.h"
+#include "SimTKcommon.h"
 
 using namespace OpenSim;
 using namespace std;
@@ -62,12 +63,17 @@ int main()
         Array<double> a(-1.0,N), b(1.0,N), tol(1.0e-6,N);
         Array<double> roots(0.0,N);
         RootSolver solver(&function);
-        //roots = solver.solve(a,b,tol);  NOTE: JACKM need to pass in state or change CMC 
+        SimTK::State s;
+        roots = solver.solve(s,a,b,tol);
         cout<<endl<<endl<<"-------------"<<endl;
         cout<<"roots:\n";
         cout<<roots<<endl<<endl;
+        const Array<int>& numIterations = solver.getNumIterations();
+        ASSERT(numIterations.getSize() == N);
         for (int i=0; i <= 100; i++){
-            //ASSERT_EQUAL(i*0.01, roots[i], 1e-6);
+            ASSERT_EQUAL(i*0.01, roots[i], 1e-6);
+            // Only the last root is at an end of its bracket.
+            ASSERT((numIterations[i] == 0) == (i == 100));
         }
     }
     catch (const Exception& e) {
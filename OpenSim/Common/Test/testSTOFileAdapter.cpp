@@ -24,6 +24,8 @@
 #include "OpenSim/Common/CommonUtilities.h"
 #include <cstdio>
 #include <fstream>
+#include <iomanip>
+#include <sstream>
 #include <unordered_set>
 
 #define CATCH_CONFIG_MAIN
@@ -353,3 +355,193 @@ TEST_CASE("Trimming whitespace in metadata values") {
 
 
 
+
+TEST_CASE("Fast and regular parsers read the same data") {
+    // Large enough that the fast path parses rows on multiple threads.
+    const int nrow = 20000;
+    const int ncol = 5;
+    TimeSeriesTable table;
+    table.setColumnLabels({"a", "b", "c", "d", "e"});
+    SimTK::RowVector row(ncol);
+    for (int i = 0; i < nrow; ++i) {
+        for (int j = 0; j < ncol; ++j) row[j] = 0.001 * i * (j - 2) + 1e-12;
+        table.appendRow(0.001 * i, row);
+    }
+    const std::string filename = "testing_fast_parser.sto";
+    STOFileAdapter::write(table, filename);
+
+    TimeSeriesTable fromFile(filename);
+    REQUIRE(fromFile.getNumRows() == nrow);
+    REQUIRE(fromFile.getNumColumns() == ncol);
+    CHECK(fromFile.getIndependentColumn() == table.getIndependentColumn());
+    int numMismatches = 0;
+    for (int i = 0; i < nrow; ++i) {
+        for (int j = 0; j < ncol; ++j) {
+            if (fromFile.getMatrix()(i, j) != table.getMatrix()(i, j)) {
+                ++numMismatches;
+            }
+        }
+    }
+    CHECK(numMismatches == 0);
+
+    SECTION("Malformed rows fall back to the regular parser") {
+        const std::string malformed = "testing_fast_parser_malformed.sto";
+        {
+            std::ofstream out(malformed);
+            out << "version=1\nnRows=2\nnColumns=3\nendheader\n"
+                << "time\ta\tb\n"
+                << "0\t1\t2\n"
+                << "0.1\t3\n";
+        }
+        CHECK_THROWS_AS(TimeSeriesTable(malformed), RowLengthMismatch);
+    }
+}
+
+TEST_CASE("STOFileAdapter reads only the selected columns") {
+    TimeSeriesTable table;
+    table.setColumnLabels({"pelvis_tx", "pelvis_ty", "hip_r", "knee_r"});
+    for (int i = 0; i < 10; ++i) {
+        table.appendRow(0.1 * i, SimTK::RowVector(4, 1.0 * i) +
+                        ~createVectorLinspace(4, 0, 0.3));
+    }
+    const std::string filename = "testing_columns_to_read.sto";
+    STOFileAdapter::write(table, filename);
+
+    auto readColumns = [&](const std::vector<std::string>& patterns)
+            -> TimeSeriesTable {
+        STOFileAdapter adapter;
+        adapter.setColumnsToRead(patterns);
+        auto tables = adapter.read(filename);
+        return dynamic_cast<TimeSeriesTable&>(
+                *tables.at(STOFileAdapter::tableString()));
+    };
+
+    // The columns keep the order of the file.
+    TimeSeriesTable selected = readColumns({"knee_r", "pelvis_.*"});
+    CHECK(selected.getColumnLabels() ==
+          std::vector<std::string>({"pelvis_tx", "pelvis_ty", "knee_r"}));
+    CHECK(selected.getIndependentColumn() == table.getIndependentColumn());
+    for (int i = 0; i < 10; ++i) {
+        CHECK(selected.getMatrix()(i, 0) == table.getMatrix()(i, 0));
+        CHECK(selected.getMatrix()(i, 1) == table.getMatrix()(i, 1));
+        CHECK(selected.getMatrix()(i, 2) == table.getMatrix()(i, 3));
+    }
+    CHECK(readColumns({}).getNumColumns() == 4);
+    CHECK_THROWS(readColumns({"ankle_r"}));
+
+    SECTION("The regular parser reads the same columns") {
+        // Only tables of doubles are read by the fast parser.
+        TimeSeriesTableVec3 tableVec3(table.getIndependentColumn(),
+                SimTK::Matrix_<SimTK::Vec3>(10, 3, SimTK::Vec3(1, 2, 3)),
+                {"a", "b", "c"});
+        tableVec3.updMatrix()(4, 2) = SimTK::Vec3(4, 5, 6);
+        const std::string filenameVec3 = "testing_columns_to_read_vec3.sto";
+        STOFileAdapterVec3::write(tableVec3, filenameVec3);
+        STOFileAdapterVec3 adapter;
+        adapter.setColumnsToRead({"c"});
+        auto tables = adapter.read(filenameVec3);
+        auto& fromFile = dynamic_cast<TimeSeriesTableVec3&>(
+                *tables.at(STOFileAdapterVec3::tableString()));
+        CHECK(fromFile.getColumnLabels() == std::vector<std::string>({"c"}));
+        REQUIRE(fromFile.getNumRows() == 10);
+        CHECK(fromFile.getMatrix()(4, 0) == SimTK::Vec3(4, 5, 6));
+        CHECK(fromFile.getMatrix()(0, 0) == SimTK::Vec3(1, 2, 3));
+    }
+}
+
+TEST_CASE("TimeSeriesTableReader reads a file in chunks") {
+    TimeSeriesTable table;
+    table.setColumnLabels({"a", "b"});
+    table.addTableMetaData("inDegrees", std::string("yes"));
+    for (int i = 0; i < 25; ++i) {
+        table.appendRow(0.1 * i, SimTK::RowVector(2, double(i)));
+    }
+    const std::string filename = "testing_chunked_reader.sto";
+    STOFileAdapter::write(table, filename);
+
+    TimeSeriesTableReader reader(filename);
+    CHECK(reader.getColumnLabels() == table.getColumnLabels());
+    std::vector<int> chunkSizes;
+    std::vector<double> times;
+    while (reader.hasNext()) {
+        const auto chunk = reader.nextChunk(10);
+        chunkSizes.push_back((int)chunk.getNumRows());
+        CHECK(chunk.getTableMetaDataAsString("inDegrees") == "yes");
+        for (int i = 0; i < (int)chunk.getNumRows(); ++i) {
+            times.push_back(chunk.getIndependentColumn()[i]);
+            CHECK(chunk.getMatrix()(i, 1) == double(times.size() - 1));
+        }
+    }
+    CHECK(chunkSizes == std::vector<int>{10, 10, 5});
+    CHECK(times == table.getIndependentColumn());
+    CHECK(reader.getNumRowsRead() == 25);
+    CHECK(reader.nextChunk(10).getNumRows() == 0);
+}
+
+namespace {
+    std::string readFile(const std::string& filename) {
+        std::ifstream stream(filename);
+        return std::string(std::istreambuf_iterator<char>(stream),
+                std::istreambuf_iterator<char>());
+    }
+}
+
+TEST_CASE("Written values match writing to a stream with setprecision()") {
+    // More rows than one block of formatRowsInBlocks(), with values whose
+    // formatting differs between the formats of printf().
+    const std::vector<double> special{0.0, -0.0, 1e-300, -1e300, 1.0 / 3,
+            123456789.0123456789, 1e16, 5e-324, SimTK::Infinity,
+            -SimTK::Infinity, SimTK::NaN};
+    TimeSeriesTable table;
+    table.setColumnLabels({"a", "b"});
+    TimeSeriesTableVec3 tableVec3;
+    tableVec3.setColumnLabels({"c"});
+    const int numRows = 3000;
+    for (int i = 0; i < numRows; ++i) {
+        SimTK::RowVector row(2);
+        row[0] = special[i % special.size()];
+        row[1] = std::sin(0.37 * i) * std::pow(10.0, i % 40 - 20);
+        table.appendRow(0.001 * i, row);
+        tableVec3.appendRow(0.001 * i, SimTK::RowVector_<SimTK::Vec3>(1,
+                SimTK::Vec3(row[0], row[1], -i)));
+    }
+
+    // The data rows as they were written before, with a stream.
+    std::ostringstream stream, streamVec3;
+    constexpr auto prec = std::numeric_limits<double>::digits10 + 1;
+    for (int i = 0; i < numRows; ++i) {
+        const double time = table.getIndependentColumn()[i];
+        stream << std::setprecision(prec) << time;
+        streamVec3 << std::setprecision(prec) << time;
+        for (int j = 0; j < 2; ++j) {
+            stream << "\t" << std::setprecision(prec)
+                   << table.getMatrix()(i, j);
+        }
+        const SimTK::Vec3& elem = tableVec3.getMatrix()(i, 0);
+        streamVec3 << "\t" << std::setprecision(prec) << elem[0] << ","
+                   << std::setprecision(prec) << elem[1] << ","
+                   << std::setprecision(prec) << elem[2];
+        stream << "\n";
+        streamVec3 << "\n";
+    }
+    const std::string expected = stream.str();
+    const std::string expectedVec3 = streamVec3.str();
+
+    for (int numThreads : {1, 4}) {
+        IO::SetNumThreadsForWriting(numThreads);
+        STOFileAdapter::write(table, "testing_formatting.sto");
+        STOFileAdapterVec3::write(tableVec3, "testing_formatting_vec3.sto");
+        IO::SetNumThreadsForWriting(1);
+        for (const auto& pair : {std::make_pair("testing_formatting.sto",
+                                         expected),
+                     std::make_pair("testing_formatting_vec3.sto",
+                             expectedVec3)}) {
+            const std::string contents = readFile(pair.first);
+            const auto endHeader = contents.find("endheader\n");
+            REQUIRE(endHeader != std::string::npos);
+            const auto firstRow =
+                    contents.find('\n', endHeader + 10) + 1;
+            CHECK(contents.substr(firstRow) == pair.second);
+        }
+    }
+}
@@ -37,6 +37,7 @@
 #include "SimTKcommon.h"
 
 #include <iostream>
+#include <memory>
 #include <string>
 
 #include "SerializableObject.h"
@@ -81,6 +82,10 @@ static void dumpObj(const Object& obj, int nSpaces) {
     }
 }
 
+static void registerDeferredSerializableObject() {
+    Object::renameType("DeferredSerializableObject", "SerializableObject");
+}
+
 static void testPropertyOutputHelper(const double& val, const std::string& ans)
 {
     cout << "(double)" << val << ":  ";
@@ -266,6 +271,51 @@ int main()
         Object::registerType(SerializableObject2());
         Object::registerType(SerializableObject3());
 
+        // Re-registering a type replaces its default object, whose property
+        // values new instances get.
+        {
+            SerializableObject modifiedDefault;
+            modifiedDefault.set_Test_Bool_2(
+                    !SerializableObject().get_Test_Bool_2());
+            Object::registerType(modifiedDefault);
+            std::unique_ptr<Object> instance(
+                    Object::newInstanceOfType("SerializableObject"));
+            SimTK_TEST(dynamic_cast<SerializableObject&>(*instance)
+                    .get_Test_Bool_2() == modifiedDefault.get_Test_Bool_2());
+            Object::registerType(SerializableObject());
+            Object::renameType("OldSerializableObject", "SerializableObject");
+            instance.reset(Object::newInstanceOfType("OldSerializableObject"));
+            SimTK_TEST(dynamic_cast<SerializableObject&>(*instance)
+                    .get_Test_Bool_2() == SerializableObject().get_Test_Bool_2());
+            SimTK_TEST(Object::isObjectTypeDerivedFrom<SerializableObject>(
+                    "OldSerializableObject"));
+
+            // The registered type names are sorted.
+            Array<std::string> typeNames;
+            Object::getRegisteredTypenames(typeNames);
+            for (int i = 1; i < typeNames.size(); ++i) {
+                SimTK_TEST(typeNames[i - 1] < typeNames[i]);
+            }
+        }
+
+        // Deferred registrations are invoked on the first lookup, and those
+        // deferred until an unknown type only when a lookup fails.
+        {
+            Object::deferTypeRegistration(registerDeferredSerializableObject);
+            int numUnknownTypeRegistrations = 0;
+            Object::deferTypeRegistrationUntilUnknownType(
+                    [&numUnknownTypeRegistrations]() {
+                        ++numUnknownTypeRegistrations;
+                    });
+            SimTK_TEST(Object::isObjectTypeDerivedFrom<SerializableObject>(
+                    "DeferredSerializableObject"));
+            SimTK_TEST(numUnknownTypeRegistrations == 0);
+            SimTK_TEST(!Object::getDefaultInstanceOfType("NotAnObjectType"));
+            SimTK_TEST(numUnknownTypeRegistrations == 1);
+            SimTK_TEST(!Object::getDefaultInstanceOfType("NotAnObjectType"));
+            SimTK_TEST(numUnknownTypeRegistrations == 1);
+        }
+
         ObjSet objSet;
         const Set<SerializableObject>& baseSet = objSet;
 
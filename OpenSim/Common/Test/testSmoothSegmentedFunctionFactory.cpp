@@ -589,6 +589,47 @@ void testQuinticBezier_Exceptions(){
 }
 
 
+/**
+    This function tests that the tabulated u(x) of a quintic Bezier curve gives
+    the same u as the spline of u(x), and that its initial guess is accurate
+    enough for the Newton iteration to converge in one step.
+*/
+void testQuinticBezier_UOfXTable()
+{
+    cout <<"**************************************************"<<endl;
+    cout << "   TEST: Bezier Curve u(x) Table" << endl;
+
+    SimTK::Vec6 xPts = {0, 0.5, 0.5, 0.75, 0.75, 1};
+    SimTK::Vector u(100);
+    SimTK::Vector x(100);
+    for(int i=0; i<100; i++){
+        u(i) = ((double)i)/((double)99);
+        x(i)=SegmentedQuinticBezierToolkit::calcQuinticBezierCurveVal(u(i), xPts);
+    }
+    SimTK::Spline splineUX = SimTK::SplineFitter<Real>::
+            fitForSmoothingParameter(3,x,u,0).getSpline();
+    const double tol = SimTK::Eps*1e2;
+    SegmentedQuinticBezierToolkit::UOfXTable table =
+            SegmentedQuinticBezierToolkit::createUOfXTable(
+                    xPts, splineUX, 64, tol, 20);
+    SimTK_TEST(table.coefficients.size() == 63);
+
+    for(int i=0; i<=1000; i++){
+        const double xVal = ((double)i)/1000.0;
+        const double uSpline = SegmentedQuinticBezierToolkit::
+                calcU(xVal, xPts, splineUX, tol, 20);
+        // With at most one Newton step.
+        const double uTable = SegmentedQuinticBezierToolkit::
+                calcU(xVal, xPts, table, tol, 1);
+        SimTK_TEST_EQ_TOL(uTable, uSpline, 1e-12);
+    }
+
+    SimTK_TEST_MUST_THROW(SegmentedQuinticBezierToolkit::
+            createUOfXTable(xPts, splineUX, 1, tol, 20));
+    cout << "    passed." << endl;
+    cout <<"**************************************************"<<endl;
+}
+
 /**
     This function will create a quintic Bezier curve y(x) and sample it, its 
     first derivative w.r.t. U (dx(u)/du and dy(u)/du), and its first derivative
@@ -1108,6 +1149,40 @@ void testMuscleCurveC2Continuity(SmoothSegmentedFunction mcf,
     cout << endl;
 }
 
+/*
+ 3b. The fused evaluation of the value and the first two derivatives will be
+     compared to the separate evaluations, within and outside of the curve
+     domain.
+*/
+void testMuscleCurveValueAndDerivatives(SmoothSegmentedFunction mcf,
+                                        SimTK::Matrix mcfSample)
+{
+    cout << "   TEST: Fused value and derivatives " << endl;
+    SimTK::Vector x = mcfSample(0);
+    SimTK::Vec2 domain = mcf.getCurveDomain();
+    SimTK::Vector xTest(x.size() + 2);
+    xTest(0, x.size()) = x;
+    xTest(x.size())     = domain(0) - 0.1;
+    xTest(x.size() + 1) = domain(1) + 0.1;
+
+    double tol = 1e-12;
+    for(int i=0; i<xTest.size(); i++){
+        SimTK::Vec3 fused = mcf.calcValueAndDerivatives(xTest(i));
+        SimTK_TEST_EQ_TOL(fused[0], mcf.calcValue(xTest(i)), tol);
+        SimTK_TEST_EQ_TOL(fused[1], mcf.calcDerivative(xTest(i),1), tol);
+        SimTK_TEST_EQ_TOL(fused[2], mcf.calcDerivative(xTest(i),2), tol);
+
+        SimTK::Vec3 slope = mcf.calcValueAndDerivatives(xTest(i), 1);
+        SimTK_TEST_EQ(slope[0], fused[0]);
+        SimTK_TEST_EQ(slope[1], fused[1]);
+        SimTK_TEST(SimTK::isNaN(slope[2]));
+    }
+    SimTK_TEST_MUST_THROW(mcf.calcValueAndDerivatives(x(0), 3));
+    SimTK_TEST_MUST_THROW(mcf.calcValueAndDerivatives(x(0), -1));
+    cout << "   passed" << endl;
+    cout << endl;
+}
+
 /*
  4. The MuscleCurveFunctions which are supposed to be monotonic will be
     tested for monotonicity.
@@ -1143,6 +1218,7 @@ int main(int argc, char* argv[])
         
         testQuinticBezier_DU_DYDX();
         testQuinticBezier_Exceptions();
+        testQuinticBezier_UOfXTable();
 
         //Functions to facilitate manual debugging        
         //sampleQuinticBezierValDeriv();
@@ -1207,6 +1283,7 @@ int main(int argc, char* argv[])
 
         //3. Test numerically to see if the curve is C2 continuous
             testMuscleCurveC2Continuity(tendonCurve,tendonCurveSample);
+            testMuscleCurveValueAndDerivatives(tendonCurve,tendonCurveSample);
         //4. Test for monotonicity where appropriate
             testMonotonicity(tendonCurveSample);
 
@@ -1276,6 +1353,7 @@ int main(int argc, char* argv[])
 
         //3. Test numerically to see if the curve is C2 continuous
             testMuscleCurveC2Continuity(fiberFLCurve,fiberFLCurveSample);
+            testMuscleCurveValueAndDerivatives(fiberFLCurve,fiberFLCurveSample);
         //4. Test for monotonicity where appropriate
 
             testMonotonicity(fiberFLCurveSample);
@@ -1345,6 +1423,7 @@ int main(int argc, char* argv[])
 
         //3. Test numerically to see if the curve is C2 continuous
             testMuscleCurveC2Continuity(fiberCECurve,fiberCECurveSample);
+            testMuscleCurveValueAndDerivatives(fiberCECurve,fiberCECurveSample);
         //4. Test for monotonicity where appropriate
 
             testMonotonicity(fiberCECurveSample);
@@ -1410,6 +1489,7 @@ int main(int argc, char* argv[])
 
         //3. Test numerically to see if the curve is C2 continuous
             testMuscleCurveC2Continuity(fiberCEPhiCurve,fiberCEPhiCurveSample);
+            testMuscleCurveValueAndDerivatives(fiberCEPhiCurve,fiberCEPhiCurveSample);
         //4. Test for monotonicity where appropriate
             testMonotonicity(fiberCEPhiCurveSample);
         //5. Testing Exceptions
@@ -1482,6 +1562,7 @@ int main(int argc, char* argv[])
 
         //3. Test numerically to see if the curve is C2 continuous
             testMuscleCurveC2Continuity(fiberCECosPhiCurve,fiberCECosPhiCurveSample);
+            testMuscleCurveValueAndDerivatives(fiberCECosPhiCurve,fiberCECosPhiCurveSample);
         //4. Test for monotonicity where appropriate
 
             testMonotonicity(fiberCECosPhiCurveSample);
@@ -1572,6 +1653,7 @@ int main(int argc, char* argv[])
 
         //3. Test numerically to see if the curve is C2 continuous
             testMuscleCurveC2Continuity(fiberFVCurve,fiberFVCurveSample);
+            testMuscleCurveValueAndDerivatives(fiberFVCurve,fiberFVCurveSample);
         //4. Test for monotonicity where appropriate
 
             testMonotonicity(fiberFVCurveSample);
@@ -1683,6 +1765,7 @@ int main(int argc, char* argv[])
 
         //3. Test numerically to see if the curve is C2 continuous
             testMuscleCurveC2Continuity(fiberFVInvCurve,fiberFVInvCurveSample);
+            testMuscleCurveValueAndDerivatives(fiberFVInvCurve,fiberFVInvCurveSample);
         //4. Test for monotonicity where appropriate
 
             testMonotonicity(fiberFVInvCurveSample);
@@ -1832,6 +1915,7 @@ int main(int argc, char* argv[])
 
         //3. Test numerically to see if the curve is C2 continuous
             testMuscleCurveC2Continuity(fiberfalCurve,fiberfalCurveSample);
+            testMuscleCurveValueAndDerivatives(fiberfalCurve,fiberfalCurveSample);
 
             //fiberfalCurve.MuscleCurveToCSVFile("C:/mjhmilla/Stanford/dev");
        
@@ -26,6 +26,7 @@
 
 #define CATCH_CONFIG_MAIN
 #include <OpenSim/Auxiliary/catch/catch.hpp>
+#include <algorithm>
 #include <fstream>
 
 using namespace OpenSim;
@@ -120,6 +121,53 @@ TEST_CASE("Test Storage Legacy Behavior")
     }
 }
 
+TEST_CASE("Storage findIndex and growth")
+{
+    // Append enough rows to grow the storage several times, including
+    // duplicate times.
+    Storage st(4);
+    const int n = 1000;
+    for (int i = 0; i < n; ++i) {
+        const double time = 0.01 * (i / 2);
+        const double data[] = {time, -time, (double)i};
+        st.append(time, 3, data, false);
+    }
+    REQUIRE(st.getSize() == n);
+    for (int i = 0; i < n; ++i) {
+        const StateVector& row = *st.getStateVector(i);
+        REQUIRE(row.getSize() == 3);
+        CHECK(row.getData()[0] == row.getTime());
+        CHECK(row.getData()[1] == -row.getTime());
+        CHECK(row.getData()[2] == i);
+    }
+    st.ensureCapacity(2 * n);
+    CHECK(st.getCapacity() >= 2 * n);
+    CHECK(st.getStateVector(n - 1)->getData()[2] == n - 1);
+
+    // The index of the last row at or before a time, found by linear search.
+    const auto expectedIndex = [&](double time) {
+        int i = 0;
+        while (i < st.getSize() && !(time < st.getStateVector(i)->getTime())) {
+            ++i;
+        }
+        return std::max(i - 1, 0);
+    };
+    // Increasing times (the common case), times in random order, and times
+    // outside the stored range.
+    for (double time = -0.1; time < 5.1; time += 0.0037) {
+        CHECK(st.findIndex(time) == expectedIndex(time));
+    }
+    SimTK::Random::Uniform random(-1.0, 6.0);
+    random.setSeed(5);
+    for (int k = 0; k < 500; ++k) {
+        const double time = random.getValue();
+        const int hint = (int)(random.getValue() * 200);
+        CHECK(st.findIndex(time) == expectedIndex(time));
+        CHECK(st.findIndex(hint, time) == expectedIndex(time));
+    }
+    CHECK(Storage().findIndex(0.0) == -1);
+}
+
 TEST_CASE("Storage `GetStateIndex` Backwards Compatibility")
 {
     auto convert = [](const std::vector<std::string>& vec) {
@@ -195,3 +243,48 @@ TEST_CASE("Verify the loading of marker data (14 markers) from .trc into a Stora
 {
     loadStorageWithNColsFromFile("dataWithNaNsOfDifferentCases.trc", 43);
 }
+
+TEST_CASE("Storage and TimeSeriesTable round trip")
+{
+    Storage st;
+    Array<std::string> labels;
+    for (const auto& label : {"time", "a", "b", "c"}) labels.append(label);
+    st.setColumnLabels(labels);
+    st.setInDegrees(true);
+    const int n = 500;
+    for (int i = 0; i < n; ++i) {
+        const double time = 0.01 * i;
+        const double data[] = {time, -time, (double)i};
+        st.append(time, 3, data);
+    }
+
+    const TimeSeriesTable table = st.exportToTable();
+    REQUIRE(table.getNumRows() == n);
+    REQUIRE(table.getColumnLabels() ==
+            std::vector<std::string>({"a", "b", "c"}));
+    for (int i = 0; i < n; ++i) {
+        CHECK(table.getIndependentColumn()[i] == st.getStateVector(i)->getTime());
+        for (int j = 0; j < 3; ++j) {
+            CHECK(table.getMatrix()(i, j) ==
+                    st.getStateVector(i)->getData()[j]);
+        }
+    }
+
+    const Storage fromTable(table);
+    CHECK(fromTable.isInDegrees());
+    REQUIRE(fromTable.getSize() == n);
+    REQUIRE(fromTable.getColumnLabels() == st.getColumnLabels());
+    for (int i = 0; i < n; ++i) {
+        const StateVector& row = *fromTable.getStateVector(i);
+        CHECK(row.getTime() == st.getStateVector(i)->getTime());
+        REQUIRE(row.getSize() == 3);
+        for (int j = 0; j < 3; ++j) {
+            CHECK(row.getData()[j] == st.getStateVector(i)->getData()[j]);
+        }
+    }
+
+    // Rows must have a value for each column.
+    const double data[] = {1.0, 2.0};
+    st.append(10.0, 2, data);
+    CHECK_THROWS_AS(st.exportToTable(), IncorrectNumColumns);
+}
@@ -203,6 +203,33 @@ int main() {
     // Use final time < first time should throw exception 
     SimTK_TEST_MUST_THROW_EXC(table.trim(.02, 0), OpenSim::EmptyTable);
     
+    std::cout << "Testing TRCFileAdapter::setColumnsToRead()" << std::endl;
+    {
+        TimeSeriesTableVec3 all("subject01_static.trc");
+        const auto& labels = all.getColumnLabels();
+        TRCFileAdapter adapter{};
+        adapter.setColumnsToRead({labels[3], labels[1]});
+        auto tables = adapter.read("subject01_static.trc");
+        auto& selected = dynamic_cast<TimeSeriesTableVec3&>(
+                *tables.at(TRCFileAdapter::_markers));
+        // The markers keep the order of the file.
+        OPENSIM_THROW_IF(selected.getColumnLabels() !=
+                        std::vector<std::string>({labels[1], labels[3]}),
+                OpenSim::Exception, "Wrong markers selected.");
+        for (int i = 0; i < (int)all.getNumRows(); ++i) {
+            for (int j = 0; j < 2; ++j) {
+                const auto& value = selected.getMatrix()(i, j);
+                const auto& expected = all.getMatrix()(i, 2 * j + 1);
+                OPENSIM_THROW_IF(value != expected &&
+                                !(value.isNaN() && expected.isNaN()),
+                        OpenSim::Exception, "Selected marker data differ.");
+            }
+        }
+        adapter.setColumnsToRead({"not_a_marker"});
+        SimTK_TEST_MUST_THROW_EXC(adapter.read("subject01_static.trc"),
+                OpenSim::Exception);
+    }
+
     std::remove(("trimmed_" + tmpfile).c_str());
     std::remove(tmpfile.c_str());
     std::cout << "\nAll tests passed!" << std::endl;
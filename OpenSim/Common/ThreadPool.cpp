@@ -0,0 +1,187 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  ThreadPool.cpp                            *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ThreadPool.h"
+
+#include "CommonUtilities.h"
+
+#if defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+#elif defined(_WIN32)
+    #define NOMINMAX
+    #include <windows.h>
+#endif
+
+using namespace OpenSim;
+
+namespace {
+    // The pool whose loop the current thread is performing, and the index of
+    // the thread in that pool.
+    thread_local const ThreadPool* currentPool = nullptr;
+    thread_local int currentThreadIndex = -1;
+
+    class CurrentThreadScope {
+    public:
+        CurrentThreadScope(const ThreadPool* pool, int thread)
+                : _pool(currentPool), _thread(currentThreadIndex) {
+            currentPool = pool;
+            currentThreadIndex = thread;
+        }
+        ~CurrentThreadScope() {
+            currentPool = _pool;
+            currentThreadIndex = _thread;
+        }
+    private:
+        const ThreadPool* _pool;
+        int _thread;
+    };
+
+    // The CPUs on which this process may run.
+    std::vector<int> getAvailableCPUs() {
+        std::vector<int> cpus;
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+            }
+        }
+#elif defined(_WIN32)
+        DWORD_PTR processMask, systemMask;
+        if (GetProcessAffinityMask(
+                    GetCurrentProcess(), &processMask, &systemMask)) {
+            for (int cpu = 0; cpu < (int)(8 * sizeof(DWORD_PTR)); ++cpu) {
+                if (processMask & (DWORD_PTR(1) << cpu)) cpus.push_back(cpu);
+            }
+        }
+#endif
+        return cpus;
+    }
+
+    void pinCurrentThread(int cpu) {
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#elif defined(_WIN32)
+        SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu);
+#else
+        (void)cpu;
+#endif
+    }
+}
+
+ThreadPool::ThreadPool(int numThreads, bool pinThreads) {
+    numThreads = getNumThreadsOrDefault(numThreads);
+    std::vector<int> cpus;
+    if (pinThreads) cpus = getAvailableCPUs();
+    _exceptions.resize(numThreads);
+    _workers.reserve(numThreads - 1);
+    for (int thread = 1; thread < numThreads; ++thread) {
+        const int cpu = cpus.empty() ? -1 : cpus[thread % cpus.size()];
+        _workers.emplace_back(&ThreadPool::runWorker, this, thread, cpu);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _loopStarted.notify_all();
+    for (auto& worker : _workers) worker.join();
+}
+
+int ThreadPool::getCurrentThreadIndex() const {
+    return currentPool == this ? currentThreadIndex : -1;
+}
+
+void ThreadPool::parallelForEach(
+        int size, const std::function<void(int, int)>& func) {
+    if (size <= 0) return;
+    const int currentThread = getCurrentThreadIndex();
+    if (currentThread != -1 || _workers.empty() || size == 1) {
+        for (int i = 0; i < size; ++i) {
+            func(currentThread == -1 ? 0 : currentThread, i);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> submitLock(_submitMutex);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _func = &func;
+        _size = size;
+        _next = 0;
+        _failed = false;
+        for (auto& exception : _exceptions) exception = nullptr;
+        _numWorkersRunning = (int)_workers.size();
+        ++_loopIndex;
+    }
+    _loopStarted.notify_all();
+    {
+        CurrentThreadScope scope(this, 0);
+        runIterations(0);
+    }
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _loopFinished.wait(lock, [this] { return _numWorkersRunning == 0; });
+        _func = nullptr;
+    }
+    for (const auto& exception : _exceptions) {
+        if (exception) std::rethrow_exception(exception);
+    }
+}
+
+void ThreadPool::runIterations(int thread) {
+    try {
+        for (int i = _next++; i < _size && !_failed; i = _next++) {
+            (*_func)(thread, i);
+        }
+    } catch (...) {
+        _exceptions[thread] = std::current_exception();
+        _failed = true;
+    }
+}
+
+void ThreadPool::runWorker(int thread, int cpu) {
+    if (cpu != -1) pinCurrentThread(cpu);
+    CurrentThreadScope scope(this, thread);
+    long long loopIndex = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _loopStarted.wait(lock,
+                    [&] { return _stop || _loopIndex != loopIndex; });
+            if (_stop) return;
+            loopIndex = _loopIndex;
+        }
+        runIterations(thread);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_numWorkersRunning == 0) _loopFinished.notify_one();
+        }
+    }
+}
@@ -0,0 +1,112 @@
+#ifndef OPENSIM_THREAD_POOL_H_
+#define OPENSIM_THREAD_POOL_H_
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  ThreadPool.h                             *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OpenSim {
+
+/**
+ * A fixed set of threads that perform the iterations of parallel loops, like
+ * parallelForEach(), but that are created once rather than for each loop.
+ * Loops that are run many times (e.g., evaluating a function at every time
+ * point of an optimization problem, in every iteration of the optimizer)
+ * thereby avoid the cost of creating threads, and state that the threads keep
+ * between loops (thread_local variables, the caches of the CPU) remains warm.
+ * @code
+ * ThreadPool pool(8, true);
+ * for (int iter = 0; iter < numIterations; ++iter) {
+ *     pool.parallelForEach(numPoints, [&](int thread, int index) {
+ *         // ... evaluate point `index`, using the workspace of `thread` ...
+ *     });
+ * }
+ * @endcode
+ *
+ * If the threads are pinned, thread i (for i >= 1) only runs on the i-th of
+ * the CPUs on which the process may run (Linux and Windows; elsewhere,
+ * pinning has no effect). Restrict the process to the CPUs of one NUMA node
+ * (e.g., with `numactl --cpunodebind`) to keep the threads and their memory
+ * on that node. The calling thread, which performs the iterations of thread
+ * 0, is never pinned.
+ */
+class OSIMCOMMON_API ThreadPool {
+public:
+    /// Create a pool with `numThreads` threads in total, including the
+    /// thread that calls parallelForEach(); if `numThreads` is not
+    /// positive, getNumThreadsOrDefault() is used.
+    explicit ThreadPool(int numThreads = 0, bool pinThreads = false);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int getNumThreads() const { return (int)_workers.size() + 1; }
+
+    /// Invoke `func(thread, index)` for each index in [0, size), where
+    /// `thread` is in [0, getNumThreads()); like OpenSim::parallelForEach(),
+    /// threads claim the next unprocessed index once they are done with the
+    /// previous one, the calling thread is thread 0, and the exception of
+    /// the lowest-numbered thread that threw is rethrown. Loops submitted by
+    /// different threads run one after the other. A loop submitted from
+    /// within a loop of the same pool runs on the submitting thread alone.
+    void parallelForEach(
+            int size, const std::function<void(int thread, int index)>& func);
+
+    /// While the calling thread performs iterations of a loop of this pool,
+    /// its thread index in the pool; otherwise, -1.
+    int getCurrentThreadIndex() const;
+
+private:
+    void runWorker(int thread, int cpu);
+    void runIterations(int thread);
+
+    std::vector<std::thread> _workers;
+
+    // Loops are submitted one at a time.
+    std::mutex _submitMutex;
+
+    // The current loop, and the state with which the workers are notified of
+    // it (guarded by _mutex).
+    std::mutex _mutex;
+    std::condition_variable _loopStarted;
+    std::condition_variable _loopFinished;
+    long long _loopIndex = 0;
+    int _numWorkersRunning = 0;
+    bool _stop = false;
+    const std::function<void(int, int)>* _func = nullptr;
+    int _size = 0;
+    std::atomic<int> _next{0};
+    std::atomic<bool> _failed{false};
+    std::vector<std::exception_ptr> _exceptions;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_THREAD_POOL_H_
@@ -151,48 +151,27 @@ public:
         const SimTK::Matrix_<ETY>& depData,
         const std::vector<std::string>& labels) : 
             DataTable_<double, ETY>(indVec, depData, labels) {
-        try {
-            // Perform the validation of the data of this TimeSeriesTable.
-            // validateDependentsMetaData() invoked by the DataTable_
-            // constructor via setColumnLabels(), but we invoke it again
-            // because base classes cannot properly invoke virtual functions.
-            this->validateDependentsMetaData();
-            for (size_t i = 0; i < indVec.size(); ++i) {
-                this->validateRow(i, indVec[i], depData.row(int(i)));
-            }
-        }
-        catch (std::exception&) {
-            // wipe out the data loaded if any
-            this->_indData.clear();
-            this->_depData.clear();
-            this->removeDependentsMetaDataForKey("labels");
-            throw;
-        }
+        validateConstructedTable();
     }
 
+#ifndef SWIG
+    /** Same as above, but the data is moved into the table instead of being
+    copied.                                                                   */
+    TimeSeriesTable_(std::vector<double>&& indVec,
+        SimTK::Matrix_<ETY>&& depData,
+        const std::vector<std::string>& labels) :
+            DataTable_<double, ETY>(std::move(indVec), std::move(depData),
+                                    labels) {
+        validateConstructedTable();
+    }
+#endif
+
     /** Construct a table with only the independent (time) column and 0
     dependent columns. This constructor is useful if you want to populate the
     table by appending columns rather than by appending rows.                 */
     TimeSeriesTable_(const std::vector<double>& indVec) :
             DataTable_<double, ETY>(indVec) {
-        try {
-            // Perform the validation of the data of this TimeSeriesTable.
-            // validateDependentsMetaData() invoked by the DataTable_
-            // constructor via setColumnLabels(), but we invoke it again
-            // because base classes cannot properly invoke virtual functions.
-            this->validateDependentsMetaData();
-            for (size_t i = 0; i < indVec.size(); ++i) {
-                this->validateRow(i, indVec[i], this->_depData.row(int(i)));
-            }
-        }
-        catch (std::exception&) {
-            // wipe out the data loaded if any
-            this->_indData.clear();
-            this->_depData.clear(); // should be empty
-            this->removeDependentsMetaDataForKey("labels"); // should be empty
-            throw;
-        }
-
+        validateConstructedTable();
     }
 
 #ifndef SWIG
@@ -216,11 +195,11 @@ public:
         DataTable_<double, ETY>(datatable) {
         using DT = DataTable_<double, ETY>;
 
-        OPENSIM_THROW_IF(!std::is_sorted(DT::_indData.cbegin(), 
-                                         DT::_indData.cend()) ||
-                         std::adjacent_find(DT::_indData.cbegin(), 
-                                            DT::_indData.cend()) != 
-                         DT::_indData.cend(),
+        OPENSIM_THROW_IF(!std::is_sorted(DT::_indData->cbegin(), 
+                                         DT::_indData->cend()) ||
+                         std::adjacent_find(DT::_indData->cbegin(), 
+                                            DT::_indData->cend()) != 
+                         DT::_indData->cend(),
                          TimeColumnNotIncreasing);
     }
 
@@ -478,19 +457,19 @@ protected:
                      const RowVector& row) const override {
         using DT = DataTable_<double, ETY>;
 
-        if(DT::_indData.empty())
+        if(DT::_indData->empty())
             return;
 
         if(rowIndex > 0) {
-            OPENSIM_THROW_IF(DT::_indData[rowIndex - 1] >= time,
+            OPENSIM_THROW_IF((*DT::_indData)[rowIndex - 1] >= time,
                              TimestampLessThanEqualToPrevious, rowIndex, time, 
-                             DT::_indData[rowIndex - 1]);
+                             (*DT::_indData)[rowIndex - 1]);
         }
 
-        if(rowIndex < DT::_indData.size() - 1) {
-            OPENSIM_THROW_IF(DT::_indData[rowIndex + 1] <= time,
+        if(rowIndex < DT::_indData->size() - 1) {
+            OPENSIM_THROW_IF((*DT::_indData)[rowIndex + 1] <= time,
                              TimestampGreaterThanEqualToNext, rowIndex, time, 
-                             DT::_indData[rowIndex + 1]);
+                             (*DT::_indData)[rowIndex + 1]);
         }
     }
     /** trim table to rows between start_index and last_index inclusively
@@ -501,18 +480,40 @@ protected:
         // Side effect may include that headers/metaData may be left stale.
         // Alternatively we can create a new TimeSeriesTable and copy contents
         // one row at a time but that's rather overkill
-        SimTK::Matrix_<ETY> matrixBlock = this->updMatrix()((int)start_index, 0,
+        SimTK::Matrix_<ETY> matrixBlock = this->getMatrix()((int)start_index, 0,
                 (int)(last_index - start_index + 1),
                 (int)this->getNumColumns());
-        this->updMatrix() = matrixBlock;
+        this->_depData = std::move(matrixBlock);
         std::vector<double> newIndependentVector = std::vector<double>(
                 this->getIndependentColumn().begin() + start_index,
                 this->getIndependentColumn().begin() + last_index + 1);
-        this->_indData = newIndependentVector;
+        this->_indData = std::move(newIndependentVector);
     }
 
     friend class TableUtilities;
 
+private:
+    // Validate the data given to a constructor; the data is cleared if it is
+    // invalid. validateDependentsMetaData() is invoked by the DataTable_
+    // constructor via setColumnLabels(), but we invoke it again because base
+    // classes cannot properly invoke virtual functions.
+    void validateConstructedTable() {
+        try {
+            this->validateDependentsMetaData();
+            const auto& indVec = this->getIndependentColumn();
+            for (size_t i = 0; i < indVec.size(); ++i) {
+                this->validateRow(i, indVec[i], this->_depData->row(int(i)));
+            }
+        }
+        catch (std::exception&) {
+            // wipe out the data loaded if any
+            this->_indData.upd().clear();
+            this->_depData.upd().clear();
+            this->removeDependentsMetaDataForKey("labels");
+            throw;
+        }
+    }
+
 }; // TimeSeriesTable_
 
 /** See TimeSeriesTable_ for details on the interface.                        */
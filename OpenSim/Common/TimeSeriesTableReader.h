@@ -0,0 +1,136 @@
+#ifndef OPENSIM_TIME_SERIES_TABLE_READER_H_
+#define OPENSIM_TIME_SERIES_TABLE_READER_H_
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  TimeSeriesTableReader.h                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "DelimFileAdapter.h"
+
+namespace OpenSim {
+
+/** TimeSeriesTableReader_ reads a delimited data file (.sto, .mot, or .csv)
+incrementally, a chunk of rows at a time, so that arbitrarily long recordings
+can be processed in bounded memory. The file header (metadata and column
+labels) is parsed on construction; each call to nextChunk() then parses only
+the requested number of rows.
+\code{.cpp}
+TimeSeriesTableReader reader("long_recording.sto");
+while (reader.hasNext()) {
+    TimeSeriesTable chunk = reader.nextChunk(10000);
+    // ... process chunk ...
+}
+\endcode
+The files are parsed exactly as with STOFileAdapter and CSVFileAdapter; CSV
+files are supported only for T = double.                                      */
+template<typename T>
+class TimeSeriesTableReader_ {
+public:
+    /** Open the file and read its header.
+
+    \throws FileDoesNotExist If the file cannot be opened.
+    \throws FileIsEmpty If the file is empty.
+    \throws InvalidArgument If the file extension is not supported.           */
+    explicit TimeSeriesTableReader_(const std::string& fileName) :
+            _fileName(fileName),
+            _adapter(createAdapter(fileName)) {
+        OPENSIM_THROW_IF(fileName.empty(), EmptyFileName);
+        _stream.open(fileName);
+        OPENSIM_THROW_IF(!_stream.good(), FileDoesNotExist, fileName);
+        OPENSIM_THROW_IF(
+                _stream.peek() == std::ifstream::traits_type::eof(),
+                FileIsEmpty, fileName);
+        _adapter.readHeader(
+                _stream, fileName, _lineNum, _metaData, _columnLabels);
+    }
+
+    TimeSeriesTableReader_(const TimeSeriesTableReader_&)            = delete;
+    TimeSeriesTableReader_& operator=(const TimeSeriesTableReader_&) = delete;
+
+    /** Column labels of the dependent columns (excludes time).               */
+    const std::vector<std::string>& getColumnLabels() const {
+        return _columnLabels;
+    }
+
+    /** Metadata from the file header; this is also the table metadata of
+    every chunk.                                                              */
+    const ValueArrayDictionary& getTableMetaData() const { return _metaData; }
+
+    /** Whether there might be more rows to read. This becomes false once a
+    call to nextChunk() reaches the end of the data.                          */
+    bool hasNext() const { return !_endOfData; }
+
+    /** Total number of rows returned so far by nextChunk().                  */
+    size_t getNumRowsRead() const { return _numRowsRead; }
+
+    /** Read the next (up to) `numRows` rows. The returned table has fewer
+    rows than requested (possibly none) if the end of the data is reached.
+
+    \throws RowLengthMismatch If a row has an unexpected number of columns.  */
+    TimeSeriesTable_<T> nextChunk(int numRows) {
+        OPENSIM_THROW_IF(numRows <= 0, InvalidArgument,
+                "Expected numRows to be positive, but got " +
+                std::to_string(numRows) + ".");
+        const int ncol = static_cast<int>(_columnLabels.size());
+        if (!_endOfData) {
+            _numRowsRead += _adapter.readRows(_stream, _fileName, _lineNum,
+                    ncol, numRows, _timeBuffer, _matrixBuffer, _endOfData);
+        } else {
+            _timeBuffer.clear();
+            _matrixBuffer.resize(0, ncol);
+        }
+        TimeSeriesTable_<T> chunk(_timeBuffer, _matrixBuffer, _columnLabels);
+        chunk.updTableMetaData() = _metaData;
+        return chunk;
+    }
+
+private:
+    static DelimFileAdapter<T> createAdapter(const std::string& fileName) {
+        const auto extension = FileAdapter::findExtension(fileName);
+        if (extension == "sto" || extension == "mot") {
+            return DelimFileAdapter<T>("\t", "\t", ",", ",");
+        }
+        OPENSIM_THROW_IF(extension != "csv" ||
+                         !std::is_same<T, double>::value,
+                InvalidArgument,
+                "TimeSeriesTableReader_ does not support reading file '" +
+                fileName + "'.");
+        return DelimFileAdapter<T>(",", ",");
+    }
+
+    std::string _fileName;
+    DelimFileAdapter<T> _adapter;
+    std::ifstream _stream;
+    size_t _lineNum{};
+    ValueArrayDictionary _metaData;
+    std::vector<std::string> _columnLabels;
+    bool _endOfData{false};
+    size_t _numRowsRead{};
+    // Reused across chunks.
+    std::vector<double> _timeBuffer;
+    SimTK::Matrix_<T> _matrixBuffer;
+};
+
+typedef TimeSeriesTableReader_<double> TimeSeriesTableReader;
+typedef TimeSeriesTableReader_<SimTK::Vec3> TimeSeriesTableReaderVec3;
+
+} // namespace OpenSim
+
+#endif // OPENSIM_TIME_SERIES_TABLE_READER_H_
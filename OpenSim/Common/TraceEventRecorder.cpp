@@ -0,0 +1,157 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  TraceEventRecorder.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "TraceEventRecorder.h"
+
+#include "Exception.h"
+
+#include <SimTKcommon/internal/Timing.h>
+#include <cmath>
+#include <fstream>
+
+using namespace OpenSim;
+
+namespace {
+    // Append `str` as a JSON string literal.
+    void appendJSONString(std::string& json, const std::string& str) {
+        json += '"';
+        for (const char c : str) {
+            switch (c) {
+            case '"': json += "\\\""; break;
+            case '\\': json += "\\\\"; break;
+            case '\n': json += "\\n"; break;
+            case '\t': json += "\\t"; break;
+            default:
+                if ((unsigned char)c < 0x20) {
+                    json += fmt::format("\\u{:04x}", (int)c);
+                } else {
+                    json += c;
+                }
+            }
+        }
+        json += '"';
+    }
+
+    // JSON has no representation of NaN or infinity.
+    void appendJSONNumber(std::string& json, double value) {
+        if (std::isfinite(value)) {
+            json += fmt::format("{}", value);
+        } else {
+            json += "null";
+        }
+    }
+}
+
+TraceEventRecorder::TraceEventRecorder()
+        : _startTimeInNs(SimTK::realTimeInNs()) {}
+
+long long TraceEventRecorder::getTimeInNs() const {
+    return SimTK::realTimeInNs() - _startTimeInNs;
+}
+
+void TraceEventRecorder::recordComplete(const std::string& category,
+        const std::string& name, long long startTimeInNs,
+        long long durationInNs, Arguments args) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _events.push_back({'X', getStringIndex(category), getStringIndex(name),
+            getThreadIndex(), startTimeInNs, durationInNs, std::move(args)});
+}
+
+void TraceEventRecorder::recordCounter(const std::string& category,
+        const std::string& name, Arguments values) {
+    const long long time = getTimeInNs();
+    std::lock_guard<std::mutex> lock(_mutex);
+    _events.push_back({'C', getStringIndex(category), getStringIndex(name),
+            getThreadIndex(), time, 0, std::move(values)});
+}
+
+int TraceEventRecorder::getNumEvents() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return (int)_events.size();
+}
+
+void TraceEventRecorder::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _events.clear();
+}
+
+int TraceEventRecorder::getStringIndex(const std::string& str) {
+    const auto it = _stringIndices.find(str);
+    if (it != _stringIndices.end()) return it->second;
+    const int index = (int)_strings.size();
+    _strings.push_back(str);
+    _stringIndices.emplace(str, index);
+    return index;
+}
+
+int TraceEventRecorder::getThreadIndex() {
+    const auto id = std::this_thread::get_id();
+    const auto it = _threadIndices.find(id);
+    if (it != _threadIndices.end()) return it->second;
+    const int index = (int)_threadIndices.size();
+    _threadIndices.emplace(id, index);
+    return index;
+}
+
+std::string TraceEventRecorder::toJSON() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    // Name the tracks of the threads.
+    for (int thread = 0; thread < (int)_threadIndices.size(); ++thread) {
+        if (thread) json += ',';
+        json += fmt::format("{{\"name\":\"thread_name\",\"ph\":\"M\","
+                            "\"pid\":0,\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}",
+                thread, thread == 0 ? "main" : fmt::format("thread {}", thread));
+    }
+    for (const auto& event : _events) {
+        json += ",\n{\"name\":";
+        appendJSONString(json, _strings[event.name]);
+        json += ",\"cat\":";
+        appendJSONString(json, _strings[event.category]);
+        // Timestamps are in microseconds.
+        json += fmt::format(",\"ph\":\"{}\",\"pid\":0,\"tid\":{},\"ts\":{:.3f}",
+                event.phase, event.thread, 1e-3 * event.startTimeInNs);
+        if (event.phase == 'X') {
+            json += fmt::format(",\"dur\":{:.3f}", 1e-3 * event.durationInNs);
+        }
+        if (!event.args.empty()) {
+            json += ",\"args\":{";
+            for (int i = 0; i < (int)event.args.size(); ++i) {
+                if (i) json += ',';
+                appendJSONString(json, event.args[i].first);
+                json += ':';
+                appendJSONNumber(json, event.args[i].second);
+            }
+            json += '}';
+        }
+        json += '}';
+    }
+    json += "]}\n";
+    return json;
+}
+
+void TraceEventRecorder::print(const std::string& fileName) const {
+    std::ofstream file(fileName);
+    OPENSIM_THROW_IF(!file.good(), Exception,
+            "Could not open file '{}' for writing.", fileName);
+    file << toJSON();
+}
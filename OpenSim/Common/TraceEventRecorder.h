@@ -0,0 +1,159 @@
+#ifndef OPENSIM_TRACE_EVENT_RECORDER_H_
+#define OPENSIM_TRACE_EVENT_RECORDER_H_
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  TraceEventRecorder.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace OpenSim {
+
+/**
+ * Records timed events (e.g., the phases of a solver and the evaluations of
+ * its callbacks) from any number of threads, and writes them as a JSON file
+ * in the Trace Event Format, which can be viewed with chrome://tracing or
+ * https://ui.perfetto.dev.
+ * @code
+ * TraceEventRecorder recorder;
+ * {
+ *     TraceEventRecorder::Scope scope(&recorder, "solver", "transcribe");
+ *     // ...
+ * }
+ * recorder.print("trace.json");
+ * @endcode
+ *
+ * Times are measured with SimTK::realTimeInNs(), relative to the
+ * construction of the recorder. Event names and categories are stored once,
+ * so each event takes a few tens of bytes; nevertheless, recording every
+ * evaluation of a function that is called millions of times produces large
+ * files. Each thread that records events is shown as its own track, numbered
+ * in the order in which the threads recorded their first event.
+ */
+class OSIMCOMMON_API TraceEventRecorder {
+public:
+    /// Additional (numeric) information attached to an event, shown when the
+    /// event is selected in the viewer.
+    typedef std::vector<std::pair<std::string, double>> Arguments;
+
+    TraceEventRecorder();
+    TraceEventRecorder(const TraceEventRecorder&) = delete;
+    TraceEventRecorder& operator=(const TraceEventRecorder&) = delete;
+
+    /// The time (ns) since the construction of this recorder.
+    long long getTimeInNs() const;
+
+    /// Record an event `name` in `category` that started at `startTimeInNs`
+    /// (see getTimeInNs()) and took `durationInNs`, on the calling thread.
+    void recordComplete(const std::string& category, const std::string& name,
+            long long startTimeInNs, long long durationInNs,
+            Arguments args = {});
+    /// Record the values of counters (e.g., the objective of an
+    /// optimization), which the viewer plots against time as track `name`.
+    void recordCounter(const std::string& category, const std::string& name,
+            Arguments values);
+
+    /// The number of recorded events.
+    int getNumEvents() const;
+    /// Discard all recorded events.
+    void clear();
+
+    /// The recorded events in the Trace Event Format (JSON).
+    std::string toJSON() const;
+    /// Write toJSON() to a file.
+    void print(const std::string& fileName) const;
+
+    /// Records the lifetime of this object as a complete event. If the
+    /// recorder is null, nothing is recorded, so that tracing can be disabled
+    /// at negligible cost.
+    class OSIMCOMMON_API Scope {
+    public:
+        Scope(TraceEventRecorder* recorder, const char* category,
+                const char* name)
+                : _recorder(recorder), _category(category), _name(name) {
+            if (_recorder) _startTimeInNs = _recorder->getTimeInNs();
+        }
+        /// Record a formatted name, e.g., the name of a function and its
+        /// index.
+        Scope(TraceEventRecorder* recorder, const char* category,
+                std::string name)
+                : _recorder(recorder), _category(category),
+                  _nameStorage(std::move(name)) {
+            _name = _nameStorage.c_str();
+            if (_recorder) _startTimeInNs = _recorder->getTimeInNs();
+        }
+        ~Scope() { finish(); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        /// Attach a value to the event.
+        void addArgument(std::string key, double value) {
+            if (_recorder) _args.emplace_back(std::move(key), value);
+        }
+        /// Record the event now, rather than when this object is destroyed
+        /// (for phases that do not coincide with a C++ scope).
+        void finish() {
+            if (!_recorder) return;
+            _recorder->recordComplete(_category, _name, _startTimeInNs,
+                    _recorder->getTimeInNs() - _startTimeInNs,
+                    std::move(_args));
+            _recorder = nullptr;
+        }
+    private:
+        TraceEventRecorder* _recorder;
+        const char* _category;
+        const char* _name = nullptr;
+        std::string _nameStorage;
+        long long _startTimeInNs = 0;
+        Arguments _args;
+    };
+
+private:
+    struct Event {
+        char phase;
+        int category;
+        int name;
+        int thread;
+        long long startTimeInNs;
+        long long durationInNs;
+        Arguments args;
+    };
+
+    // The following require _mutex to be locked.
+    int getStringIndex(const std::string& str);
+    int getThreadIndex();
+
+    long long _startTimeInNs;
+    mutable std::mutex _mutex;
+    std::vector<Event> _events;
+    std::vector<std::string> _strings;
+    std::map<std::string, int> _stringIndices;
+    std::map<std::thread::id, int> _threadIndices;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_TRACE_EVENT_RECORDER_H_
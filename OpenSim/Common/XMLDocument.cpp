@@ -31,8 +31,19 @@
 //-----------------------------------------------------------------------------
 #include "Assertion.h"
 #include "XMLDocument.h"
+#include "About.h"
+#include "Logger.h"
 #include "Object.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <functional>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
 
 
 using namespace OpenSim;
@@ -70,6 +81,120 @@ using namespace std;
 // 40500 for updating 'GeometryPath' nodes to have property name 'path'.
 
 const int XMLDocument::LatestVersion = 40500;
+
+namespace {
+
+// Layout of the binary cache files (see XMLDocument::updateCache()). All
+// numbers are stored with the byte order of the machine that wrote the file.
+const char cacheSignature[8] = {'O', 'S', 'I', 'M', 'X', 'M', 'L', 'C'};
+const std::uint32_t cacheByteOrderMark = 0x01020304;
+const std::uint32_t cacheFormatVersion = 1;
+
+std::string& cacheDirectory() {
+    static std::string directory = [] {
+        const char* env = std::getenv("OPENSIM_XML_CACHE_DIR");
+        return std::string(env ? env : "");
+    }();
+    return directory;
+}
+
+// 64-bit FNV-1a hash.
+std::uint64_t hashContents(const std::string& contents) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (const char c : contents) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Whether the element or any element it contains refers to another file.
+bool includesOtherFiles(SimTK::Xml::Element elt) {
+    if (elt.hasAttribute("file")) return true;
+    for (auto it = elt.element_begin(); it != elt.element_end(); ++it) {
+        if (includesOtherFiles(*it)) return true;
+    }
+    return false;
+}
+
+template <typename U>
+void writePod(std::ostream& out, const U& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(U));
+}
+
+void writeString(std::ostream& out, const std::string& str) {
+    writePod<std::uint64_t>(out, str.size());
+    out.write(str.data(), str.size());
+}
+
+// Tag, attributes, and either the text value or the child elements (comments
+// are dropped).
+void writeElement(std::ostream& out, SimTK::Xml::Element elt) {
+    writeString(out, elt.getElementTag());
+    std::vector<std::pair<std::string, std::string>> attributes;
+    for (auto it = elt.attribute_begin(); it != elt.attribute_end(); ++it) {
+        attributes.emplace_back(it->getName(), it->getValue());
+    }
+    writePod<std::uint64_t>(out, attributes.size());
+    for (const auto& attribute : attributes) {
+        writeString(out, attribute.first);
+        writeString(out, attribute.second);
+    }
+    const bool isValue = elt.isValueElement();
+    writePod<std::uint8_t>(out, isValue);
+    if (isValue) {
+        writeString(out, elt.getValue());
+    } else {
+        std::vector<SimTK::Xml::Element> children;
+        for (auto it = elt.element_begin(); it != elt.element_end(); ++it) {
+            children.push_back(*it);
+        }
+        writePod<std::uint64_t>(out, children.size());
+        for (const auto& child : children) writeElement(out, child);
+    }
+}
+
+void readBytes(std::istream& in, char* dest, std::size_t numBytes) {
+    in.read(dest, numBytes);
+    OPENSIM_THROW_IF(!in, IOError, "Unexpected end of cache file.");
+}
+
+template <typename U>
+U readPod(std::istream& in) {
+    U value;
+    readBytes(in, reinterpret_cast<char*>(&value), sizeof(U));
+    return value;
+}
+
+std::string readString(std::istream& in) {
+    const auto size = readPod<std::uint64_t>(in);
+    std::string str(static_cast<std::size_t>(size), '\0');
+    if (size) readBytes(in, &str[0], str.size());
+    return str;
+}
+
+// Everything written by writeElement() after the tag.
+void readElementContents(std::istream& in, SimTK::Xml::Element& elt) {
+    const auto numAttributes = readPod<std::uint64_t>(in);
+    for (std::uint64_t i = 0; i < numAttributes; ++i) {
+        const std::string name = readString(in);
+        elt.setAttributeValue(name, readString(in));
+    }
+    if (readPod<std::uint8_t>(in)) {
+        const std::string value = readString(in);
+        if (!value.empty()) elt.setValue(value);
+    } else {
+        const auto numChildren = readPod<std::uint64_t>(in);
+        for (std::uint64_t i = 0; i < numChildren; ++i) {
+            SimTK::Xml::Element child(readString(in));
+            readElementContents(in, child);
+            elt.insertNodeAfter(elt.node_end(), child);
+        }
+    }
+}
+
+} // anonymous namespace
+
 //=============================================================================
 // DESTRUCTOR AND CONSTRUCTOR(S)
 //=============================================================================
@@ -114,13 +239,35 @@ XMLDocument::XMLDocument()
  *
  * @param aFileName File name of the XML document.
  */
-XMLDocument::XMLDocument(const string &aFileName) :
-SimTK::Xml::Document(aFileName)
+XMLDocument::XMLDocument(const string &aFileName)
 {
-
-
     _fileName = aFileName;
 
+    const std::string& cacheDir = getCacheDirectory();
+    std::ifstream in;
+    if (!cacheDir.empty()) in.open(aFileName, std::ios::binary);
+    if (in.is_open()) {
+        const std::string contents((std::istreambuf_iterator<char>(in)),
+                std::istreambuf_iterator<char>());
+        _contentHash = hashContents(contents);
+        char name[64];
+        snprintf(name, sizeof(name), "%016llx_%d.osimxmlc",
+                _contentHash, LatestVersion);
+        const char last = cacheDir.back();
+        _cacheFileName = cacheDir +
+                (last == '/' || last == '\\' ? "" : "/") + name;
+
+        if (readCache()) {
+            _readFromCache = true;
+            _documentVersion = LatestVersion;
+            return;
+        }
+        readFromString(contents);
+        if (includesOtherFiles(getRootElement())) _cacheFileName.clear();
+    } else {
+        readFromFile(aFileName);
+    }
+
     // Update document version based on parsing
     updateDocumentVersion();
 }
@@ -192,6 +339,98 @@ print(const string &aFileName)
     }
     return true;
 }
+
+//-----------------------------------------------------------------------------
+// CACHE
+//-----------------------------------------------------------------------------
+void XMLDocument::setCacheDirectory(const std::string& directory)
+{
+    cacheDirectory() = directory;
+}
+
+const std::string& XMLDocument::getCacheDirectory()
+{
+    return cacheDirectory();
+}
+//_____________________________________________________________________________
+/**
+ * Read the document from its cache file, if the file exists and was written
+ * for the same file contents by the same version of OpenSim.
+ *
+ * @return Whether the document was read.
+ */
+bool XMLDocument::
+readCache()
+{
+    std::ifstream in(_cacheFileName, std::ios::binary);
+    if (!in.good()) return false;
+    try {
+        char signature[sizeof(cacheSignature)];
+        readBytes(in, signature, sizeof(signature));
+        if (std::memcmp(signature, cacheSignature, sizeof(signature)) != 0 ||
+                readPod<std::uint32_t>(in) != cacheByteOrderMark ||
+                readPod<std::uint32_t>(in) != cacheFormatVersion ||
+                readPod<std::int32_t>(in) != LatestVersion ||
+                readString(in) != GetVersion() ||
+                readPod<std::uint64_t>(in) != _contentHash) {
+            log_debug("Ignoring outdated cache file '{}' for '{}'.",
+                    _cacheFileName, _fileName);
+            return false;
+        }
+        setRootTag(readString(in));
+        SimTK::Xml::Element root = getRootElement();
+        readElementContents(in, root);
+    } catch (const std::exception& x) {
+        log_warn("Ignoring invalid cache file '{}' for '{}': {}",
+                _cacheFileName, _fileName, x.what());
+        return false;
+    }
+    log_debug("Read '{}' from cache file '{}'.", _fileName, _cacheFileName);
+    return true;
+}
+//_____________________________________________________________________________
+/**
+ * Serialize the object at the latest document version and write it to the
+ * cache file of this document. The file is written under a temporary name
+ * and then renamed, so that processes reading the same document concurrently
+ * never see an incomplete cache file.
+ */
+void XMLDocument::
+updateCache(const Object& object) const
+{
+    if (_cacheFileName.empty() || _readFromCache) return;
+    std::string tempFileName;
+    try {
+        XMLDocument doc;
+        SimTK::Xml::Element root = doc.getRootElement();
+        object.updateXMLNode(root);
+
+        tempFileName = _cacheFileName + "." +
+                std::to_string(std::random_device{}()) + ".tmp";
+        {
+            std::ofstream out(tempFileName, std::ios::binary);
+            OPENSIM_THROW_IF(!out.good(), IOError,
+                    "Could not open '" + tempFileName + "' for writing.");
+            out.write(cacheSignature, sizeof(cacheSignature));
+            writePod(out, cacheByteOrderMark);
+            writePod(out, cacheFormatVersion);
+            writePod<std::int32_t>(out, LatestVersion);
+            writeString(out, GetVersion());
+            writePod<std::uint64_t>(out, _contentHash);
+            writeElement(out, root);
+            OPENSIM_THROW_IF(!out.good(), IOError,
+                    "Could not write '" + tempFileName + "'.");
+        }
+        if (std::rename(tempFileName.c_str(), _cacheFileName.c_str()) != 0) {
+            // E.g., another process wrote the same cache file first.
+            std::remove(tempFileName.c_str());
+        }
+    } catch (const std::exception& x) {
+        if (!tempFileName.empty()) std::remove(tempFileName.c_str());
+        log_warn("Could not write cache file '{}' for '{}': {}",
+                _cacheFileName, _fileName, x.what());
+    }
+}
 //_____________________________________________________________________________
 
 //-----------------------------------------------------------------------------
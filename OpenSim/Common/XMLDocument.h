@@ -70,6 +70,13 @@ private:
     /** Document Version as written to the file */
     int _documentVersion;
     OpenSim::Array<Object*> _defaultObjects;
+    /** Name of the cache file for this document (empty if caching is disabled
+    or the document was not read from a file) */
+    std::string _cacheFileName;
+    /** Hash of the contents of the file from which the document was read */
+    unsigned long long _contentHash = 0;
+    /** Whether the document was read from its cache file */
+    bool _readFromCache = false;
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -167,6 +174,48 @@ public:
     /// If the filename is empty, the file is printed to cout.
     bool print(const std::string& aFileName = {});
 
+    //--------------------------------------------------------------------------
+    // CACHE
+    //--------------------------------------------------------------------------
+    /** @name Binary cache of deserialized documents
+    Reading a large model file involves parsing its XML and migrating the
+    elements of older document versions while the objects are deserialized
+    (see Object::updateFromXMLNode()). If a cache directory is set, then,
+    after an object is read from a file (with Object::makeObjectFromFile(),
+    the constructors from a file name, or Object::updateFromXMLDocument()),
+    the object is serialized at the latest document version into a compact
+    binary file in that directory. The next time a file with the same
+    contents is read, with the same version of OpenSim, the document is
+    read from this binary file instead: no XML is parsed and no version
+    migration is performed. The cache files are named after a hash of the
+    contents of the original file, so editing the file invalidates its
+    cache entry. Files that include objects from other files (through `file`
+    attributes) are not cached, since changes to the included files would go
+    unnoticed. A document read from the cache reports the latest document
+    version (see getDocumentVersion()).
+
+    Caching is disabled by default. The cache directory can also be set with
+    the `OPENSIM_XML_CACHE_DIR` environment variable; setCacheDirectory()
+    takes precedence. The directory is not thread-safe to change while
+    documents are being read. */
+    /// @{
+    /** Set the directory for cache files (it must exist). An empty string
+    disables caching. */
+    static void setCacheDirectory(const std::string& directory);
+    static const std::string& getCacheDirectory();
+    /** Whether this document was read from its cache file instead of the
+    original XML file. */
+    bool isReadFromCache() const { return _readFromCache; }
+    /** Write the cache file for this document from `object`, which must be
+    the object that was read from this document. Does nothing if caching is
+    disabled, the document was read from the cache, or the document includes
+    other files. Failure to write the cache file is logged but is not an
+    error. */
+    void updateCache(const Object& object) const;
+    /// @}
+private:
+    bool readCache();
+
 //=============================================================================
 };  // END CLASS XMLDocument
 
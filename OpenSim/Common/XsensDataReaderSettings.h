@@ -43,6 +43,15 @@ public:
         "Name of trial (Common prefix of txt files representing trial).");
     OpenSim_DECLARE_LIST_PROPERTY(ExperimentalSensors, ExperimentalSensor,
         "List of Experimental sensors and desired associated names in resulting tables");
+    OpenSim_DECLARE_PROPERTY(read_linear_accelerations, bool,
+        "Whether to read the linear accelerations (default: true); if false, "
+        "the table of linear accelerations is empty.");
+    OpenSim_DECLARE_PROPERTY(read_magnetic_heading, bool,
+        "Whether to read the magnetic heading (default: true); if false, the "
+        "table of magnetic heading is empty.");
+    OpenSim_DECLARE_PROPERTY(read_angular_velocity, bool,
+        "Whether to read the angular velocities (default: true); if false, "
+        "the table of angular velocities is empty.");
 
 public:
     // Default Constructor
@@ -62,6 +71,9 @@ private:
         constructProperty_data_folder("");
         constructProperty_trial_prefix("");
         constructProperty_ExperimentalSensors();
+        constructProperty_read_linear_accelerations(true);
+        constructProperty_read_magnetic_heading(true);
+        constructProperty_read_angular_velocity(true);
     }
 };
 
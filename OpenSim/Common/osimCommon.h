@@ -27,6 +27,7 @@
 #include "Adapters.h"
 #include "Assertion.h"
 #include "CommonUtilities.h"
+#include "ComponentProfiler.h"
 #include "Constant.h"
 #include "DataTable.h"
 #include "FunctionSet.h"
@@ -52,11 +53,14 @@
 #include "SimmSpline.h"
 #include "Sine.h"
 #include "SmoothSegmentedFunctionFactory.h"
+#include "StateVariableAccessor.h"
 #include "StepFunction.h"
 #include "Stopwatch.h"
 #include "StorageInterface.h"
+#include "TableCursor.h"
 #include "TableSource.h"
 #include "TableUtilities.h"
 #include "TimeSeriesTable.h"
+#include "TraceEventRecorder.h"
 
 #endif // OPENSIM_OSIMCOMMON_H_
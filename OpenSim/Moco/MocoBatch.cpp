@@ -0,0 +1,162 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim: MocoBatch.cpp                                                     *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MocoBatch.h"
+
+#include "MocoCasADiSolver/MocoCasADiSolver.h"
+#include "MocoProblem.h"
+#include "MocoProblemRep.h"
+#include "MocoTropterSolver.h"
+
+#include <OpenSim/Common/CommonUtilities.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace OpenSim;
+
+namespace {
+    // A value drawn uniformly from the bounds, or NaN if the bounds are not
+    // finite.
+    double drawFromBounds(const MocoBounds& bounds, SimTK::Random& random) {
+        if (!bounds.isSet() || !std::isfinite(bounds.getLower()) ||
+                !std::isfinite(bounds.getUpper())) {
+            return SimTK::NaN;
+        }
+        return bounds.getLower() +
+               random.getValue() * (bounds.getUpper() - bounds.getLower());
+    }
+
+    // The solver's "bounds" guess, in which each variable with finite bounds
+    // is replaced by a constant random value within its bounds.
+    template <typename SolverType>
+    MocoTrajectory createRandomGuess(const SolverType& solver,
+            const MocoProblemRep& problemRep, int seed) {
+        MocoTrajectory guess = solver.createGuess("bounds");
+        SimTK::Random::Uniform random(0, 1);
+        random.setSeed(seed);
+        const int numTimes = guess.getNumTimes();
+        for (const auto& name : guess.getStateNames()) {
+            const double value =
+                    drawFromBounds(problemRep.getStateInfo(name).getBounds(),
+                            random);
+            if (!SimTK::isNaN(value)) {
+                guess.setState(name, SimTK::Vector(numTimes, value));
+            }
+        }
+        for (const auto& name : guess.getControlNames()) {
+            const double value =
+                    drawFromBounds(problemRep.getControlInfo(name).getBounds(),
+                            random);
+            if (!SimTK::isNaN(value)) {
+                guess.setControl(name, SimTK::Vector(numTimes, value));
+            }
+        }
+        for (const auto& name : guess.getParameterNames()) {
+            const double value = drawFromBounds(
+                    problemRep.getParameter(name).getBounds(), random);
+            if (!SimTK::isNaN(value)) guess.setParameter(name, value);
+        }
+        return guess;
+    }
+}
+
+int MocoBatch::addStudy(const MocoStudy& study) {
+    m_entries.push_back({study, 0, 0});
+    return (int)m_entries.size() - 1;
+}
+
+int MocoBatch::addMultiStart(
+        const MocoStudy& study, int numStarts, int seed) {
+    OPENSIM_THROW_IF(numStarts < 1, Exception,
+            "Expected the number of starts to be positive, but got {}.",
+            numStarts);
+    const int first = (int)m_entries.size();
+    for (int start = 0; start < numStarts; ++start) {
+        m_entries.push_back({study, start, seed});
+        m_entries.back().study.setName(
+                fmt::format("{}_start{}", study.getName(), start));
+    }
+    return first;
+}
+
+void MocoBatch::setNumThreadsPerStudy(int numThreadsPerStudy) {
+    OPENSIM_THROW_IF(numThreadsPerStudy < 1, Exception,
+            "Expected the number of threads per study to be positive, but got "
+            "{}.",
+            numThreadsPerStudy);
+    m_numThreadsPerStudy = numThreadsPerStudy;
+}
+
+std::vector<MocoSolution> MocoBatch::solve() const {
+    const int numStudies = (int)m_entries.size();
+    std::vector<MocoSolution> solutions(numStudies);
+    if (numStudies == 0) return solutions;
+    const int numThreads = std::min(numStudies,
+            std::max(1, getNumThreadsOrDefault(m_numThreads) /
+                                m_numThreadsPerStudy));
+
+    // The studies (and their models) are copied on the calling thread.
+    std::vector<MocoStudy> studies;
+    studies.reserve(numStudies);
+    for (const auto& entry : m_entries) studies.push_back(entry.study);
+
+    parallelForEach(numStudies, numThreads, [&](int, int index) {
+        MocoStudy& study = studies[index];
+        if (m_parameterization) m_parameterization(index, study);
+
+        MocoSolver& solver = study.updSolver();
+        auto* casadiSolver = dynamic_cast<MocoCasADiSolver*>(&solver);
+        if (casadiSolver) {
+            // For the parallel property, 1 means all cores.
+            casadiSolver->set_parallel(
+                    m_numThreadsPerStudy == 1 ? 0 : m_numThreadsPerStudy);
+        }
+
+        const Entry& entry = m_entries[index];
+        if (entry.start > 0) {
+            const MocoProblemRep problemRep = study.getProblem().createRep();
+            solver.resetProblem(study.getProblem());
+            const int seed = entry.seed + entry.start;
+            if (casadiSolver) {
+                casadiSolver->setGuess(
+                        createRandomGuess(*casadiSolver, problemRep, seed));
+            } else {
+                auto* tropterSolver = dynamic_cast<MocoTropterSolver*>(&solver);
+                OPENSIM_THROW_IF(!tropterSolver, Exception,
+                        "Multi-start requires a MocoCasADiSolver or a "
+                        "MocoTropterSolver, but study {} uses a {}.",
+                        index, solver.getConcreteClassName());
+                tropterSolver->setGuess(
+                        createRandomGuess(*tropterSolver, problemRep, seed));
+            }
+        }
+        solutions[index] = study.solve();
+    });
+    return solutions;
+}
+
+int MocoBatch::findBestSolution(const std::vector<MocoSolution>& solutions) {
+    int best = -1;
+    for (int i = 0; i < (int)solutions.size(); ++i) {
+        if (!solutions[i].success()) continue;
+        if (best == -1 ||
+                solutions[i].getObjective() < solutions[best].getObjective()) {
+            best = i;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,117 @@
+#ifndef OPENSIM_MOCOBATCH_H
+#define OPENSIM_MOCOBATCH_H
+/* -------------------------------------------------------------------------- *
+ * OpenSim: MocoBatch.h                                                       *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MocoStudy.h"
+
+#include <functional>
+#include <vector>
+
+namespace OpenSim {
+
+/** Solve many independent MocoStudy%s concurrently, e.g., the same problem
+for many subjects or parameter values, or a non-convex problem from many
+initial guesses (multi-start). Each study is solved on one of a pool of
+threads, which take the next pending study whenever they finish one (see
+parallelForEach()), since solves take differing amounts of time.
+
+@code
+MocoBatch batch;
+for (const auto& subject : subjects) batch.addStudy(createStudy(subject));
+// Solve a non-convex problem from 8 initial guesses.
+const int first = batch.addMultiStart(nonConvexStudy, 8);
+std::vector<MocoSolution> solutions = batch.solve();
+const int best = MocoBatch::findBestSolution(
+        {solutions.begin() + first, solutions.begin() + first + 8});
+@endcode
+
+The studies are copied when they are added and again before solving, on the
+calling thread, so each thread works on its own copy of the model. When
+solving many problems, parallelizing across problems is more efficient than
+parallelizing within each solve, so the `parallel` property of each
+MocoCasADiSolver is overridden to use setNumThreadsPerStudy() threads (1 by
+default), and the batch uses the available hardware threads divided by that
+number, so that, together, the solves do not use more threads than the
+hardware provides. The settings of MocoTropterSolver are not changed.
+
+If a study's `write_solution` property is true, its solution is written as
+usual; give the studies distinct names so that the files do not overwrite
+each other. The copies created by addMultiStart() are named after the study
+with the suffix "_start<k>".                                                 */
+class OSIMMOCO_API MocoBatch {
+public:
+    /** A function that modifies (the copy of) the study with the given index
+    before it is solved, e.g., to set the weight of a goal or a parameter of
+    the model. It is invoked on the thread that solves the study.            */
+    typedef std::function<void(int index, MocoStudy& study)> Parameterization;
+
+    /** Add a copy of `study` (with its solver and guess) and return its index
+    in the batch, which is the index of its solution in the result of
+    solve().                                                                 */
+    int addStudy(const MocoStudy& study);
+    /** Add `numStarts` copies of `study` and return the index of the first.
+    The first copy starts from the study's guess (if any); the others start
+    from guesses in which each state, control, and parameter with finite
+    bounds has a constant value drawn uniformly from its bounds, and the
+    other variables have the values of the solver's "bounds" guess. The
+    random values are determined by `seed` and the index of the start, so
+    the guesses are the same each time the batch is solved.
+    The solver of the study must be a MocoCasADiSolver or a
+    MocoTropterSolver.                                                       */
+    int addMultiStart(const MocoStudy& study, int numStarts, int seed = 0);
+    int getNumStudies() const { return (int)m_entries.size(); }
+
+    /** Sets the total number of threads used by the batch. A value of 0 or
+    less (default) uses all available hardware threads.                     */
+    void setNumThreads(int numThreads) { m_numThreads = numThreads; }
+    /** Sets the number of threads that each MocoCasADiSolver uses to
+    evaluate the problem in parallel (default: 1). The batch solves
+    max(1, numThreads / numThreadsPerStudy) studies at a time.               */
+    void setNumThreadsPerStudy(int numThreadsPerStudy);
+    /** Sets a function that is invoked on the copy of each study before it
+    is solved (see Parameterization).                                        */
+    void setParameterization(Parameterization parameterization) {
+        m_parameterization = std::move(parameterization);
+    }
+
+    /** Solve all the studies and return their solutions, in the order in
+    which the studies were added. As with MocoStudy::solve(), solutions of
+    solves that failed are sealed. If solving any study throws an exception,
+    the exception is rethrown here (after the running solves have finished).
+                                                                             */
+    std::vector<MocoSolution> solve() const;
+
+    /** The index of the successful solution with the smallest objective, or
+    -1 if no solution succeeded.                                             */
+    static int findBestSolution(const std::vector<MocoSolution>& solutions);
+
+private:
+    struct Entry {
+        MocoStudy study;
+        // If positive, the start of a multi-start whose guess is random.
+        int start;
+        int seed;
+    };
+    std::vector<Entry> m_entries;
+    int m_numThreads = 0;
+    int m_numThreadsPerStudy = 1;
+    Parameterization m_parameterization;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MOCOBATCH_H
@@ -20,88 +20,866 @@
 
 #include "CasOCProblem.h"
 
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/ThreadPool.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+
 using namespace CasOC;
 
-casadi::Sparsity calcJacobianSparsityWithPerturbation(const VectorDM& x0s,
+/// Detect the sparsity of the Jacobian of `function` at `x0` by perturbing
+/// each input in turn.
+casadi::Sparsity calcJacobianSparsityWithPerturbation(const casadi::DM& x0,
         int numOutputs,
-        std::function<void(const casadi::DM&, casadi::DM&)> function) {
-
-    OPENSIM_THROW_IF(x0s.size() < 1, OpenSim::Exception,
-            "x0s must have at least 1 element.");
+        const std::function<void(const casadi::DM&, casadi::DM&)>& function) {
+    OPENSIM_THROW_IF(x0.columns() != 1, OpenSim::Exception,
+            "x0 must have exactly 1 column.");
     using casadi::DM;
     using casadi::Sparsity;
-    using std::isnan;
-    auto sparsityForSingleX0 = [&](const casadi::DM& x0) {
-        OPENSIM_THROW_IF(x0.columns() != 1, OpenSim::Exception,
-                "x0 must have exactly 1 column.");
-        Sparsity sparsity(numOutputs, x0.numel());
-        double eps = 1e-5;
-        DM x = x0;
-        DM output0(numOutputs, 1);
-        function(x, output0);
-        DM output(numOutputs, 1);
-        DM diff(numOutputs, 1);
-        for (int j = 0; j < x0.numel(); ++j) {
-            output = 0;
-            x(j) += eps;
-            function(x, output);
-            x(j) = x0(j);
-            diff = output - output0;
-            for (int i = 0; i < (int)numOutputs; ++i) {
-                if (std::isnan(diff(i).scalar())) {
-                    std::cout << "[CasOC] Warning: NaN encountered when "
-                                 "detecting sparsity of Jacobian; entry (";
-                    std::cout << i << ", " << j;
-                    std::cout << ")." << std::endl;
-                    // Set non-zero here just in case this Jacobian element is
-                    // important.
-                    sparsity.add_nz(i, j);
-                }
-                if (diff(i).scalar() != 0) sparsity.add_nz(i, j);
+    Sparsity sparsity(numOutputs, x0.numel());
+    double eps = 1e-5;
+    DM x = x0;
+    DM output0(numOutputs, 1);
+    function(x, output0);
+    DM output(numOutputs, 1);
+    DM diff(numOutputs, 1);
+    for (int j = 0; j < x0.numel(); ++j) {
+        output = 0;
+        x(j) += eps;
+        function(x, output);
+        x(j) = x0(j);
+        diff = output - output0;
+        for (int i = 0; i < (int)numOutputs; ++i) {
+            if (std::isnan(diff(i).scalar())) {
+                OpenSim::log_warn("[CasOC] NaN encountered when detecting "
+                                  "sparsity of Jacobian; entry ({}, {}).",
+                        i, j);
+                // Set non-zero here just in case this Jacobian element is
+                // important.
+                sparsity.add_nz(i, j);
             }
-            diff = 0;
+            if (diff(i).scalar() != 0) sparsity.add_nz(i, j);
         }
-        return sparsity;
-    };
+        diff = 0;
+    }
+    return sparsity;
+}
 
-    Sparsity combinedSparsity(numOutputs, x0s[0].numel());
-    for (const auto& x0 : x0s) {
-        OPENSIM_THROW_IF(x0.numel() != x0s[0].numel(), OpenSim::Exception,
-                "x0s contains vectors of different sizes.");
-        combinedSparsity = combinedSparsity + sparsityForSingleX0(x0);
+/// The union of `patterns` (at least 1, all of the same size). The union is
+/// assembled from prefix and suffix unions, so that the union of all
+/// patterns but one is also available for each pattern: `numUnique[k]` is
+/// the number of nonzeros that only `patterns[k]` contains. A sample point
+/// with no unique nonzeros did not change the detected pattern.
+casadi::Sparsity unionSparsityPatterns(
+        const std::vector<casadi::Sparsity>& patterns,
+        std::vector<casadi_int>& numUnique) {
+    const int n = (int)patterns.size();
+    std::vector<casadi::Sparsity> prefix(patterns);
+    std::vector<casadi::Sparsity> suffix(patterns);
+    for (int k = 1; k < n; ++k) prefix[k] = prefix[k - 1] + patterns[k];
+    for (int k = n - 2; k >= 0; --k) suffix[k] = suffix[k + 1] + patterns[k];
+    const casadi::Sparsity& combined = prefix[n - 1];
+    numUnique.assign(n, 0);
+    for (int k = 0; k < n; ++k) {
+        casadi_int numOthers = 0;
+        if (k == 0 && n > 1) {
+            numOthers = suffix[1].nnz();
+        } else if (k == n - 1 && n > 1) {
+            numOthers = prefix[n - 2].nnz();
+        } else if (n > 1) {
+            numOthers = (prefix[k - 1] + suffix[k + 1]).nnz();
+        }
+        numUnique[k] = combined.nnz() - numOthers;
     }
-    return combinedSparsity;
+    return combined;
 }
 
-casadi::Sparsity Function::get_jacobian_sparsity() const {
-    using casadi::DM;
+/// Group the columns of `sparsity` for which `isColored` is true such that no
+/// two columns in a group have a nonzero in the same row, using a greedy
+/// (first-fit) coloring.
+std::vector<std::vector<int>> colorColumns(const casadi::Sparsity& sparsity,
+        const std::vector<bool>& isColored) {
+    const std::vector<casadi_int> colind = sparsity.get_colind();
+    const std::vector<casadi_int> row = sparsity.get_row();
+    const int numColumns = (int)sparsity.size2();
+    // The colors of the columns that have a nonzero in each row.
+    std::vector<std::vector<int>> colorsOfRows(sparsity.size1());
+    // forbidden[c] == j if color c is used in a row of column j.
+    std::vector<int> forbidden;
+    std::vector<std::vector<int>> columnsByColor;
+    for (int j = 0; j < numColumns; ++j) {
+        if (!isColored[j]) continue;
+        for (casadi_int k = colind[j]; k < colind[j + 1]; ++k) {
+            for (int c : colorsOfRows[row[k]]) forbidden[c] = j;
+        }
+        int color = 0;
+        while (color < (int)forbidden.size() && forbidden[color] == j) {
+            ++color;
+        }
+        if (color == (int)forbidden.size()) {
+            forbidden.push_back(-1);
+            columnsByColor.emplace_back();
+        }
+        columnsByColor[color].push_back(j);
+        for (casadi_int k = colind[j]; k < colind[j + 1]; ++k) {
+            colorsOfRows[row[k]].push_back(color);
+        }
+    }
+    return columnsByColor;
+}
+
+/// Read a sparsity pattern written by writeSparsity(). Returns false if the
+/// file does not exist or does not contain a pattern with the given size.
+bool readSparsity(const std::string& fileName, casadi_int numRows,
+        casadi_int numColumns, casadi::Sparsity& sparsity) {
+    std::ifstream file(fileName);
+    if (!file.good()) return false;
+    std::string header;
+    casadi_int nrow = -1, ncol = -1, nnz = -1;
+    file >> header >> nrow >> ncol >> nnz;
+    if (!file || header != "casoc_sparsity" || nrow != numRows ||
+            ncol != numColumns || nnz < 0) {
+        return false;
+    }
+    std::vector<casadi_int> colind(ncol + 1);
+    std::vector<casadi_int> row(nnz);
+    for (auto& value : colind) file >> value;
+    for (auto& value : row) file >> value;
+    if (!file || colind.front() != 0 || colind.back() != nnz) return false;
+    for (casadi_int j = 0; j < ncol; ++j) {
+        if (colind[j] > colind[j + 1]) return false;
+    }
+    for (const auto& value : row) {
+        if (value < 0 || value >= nrow) return false;
+    }
+    sparsity = casadi::Sparsity(nrow, ncol, colind, row);
+    return true;
+}
+
+/// Write a sparsity pattern (in compressed column format) to a text file. The
+/// file is written under a temporary name and then renamed, so that
+/// concurrent solves never read a partially-written file.
+void writeSparsity(const std::string& fileName,
+        const casadi::Sparsity& sparsity) {
+    const std::string tempFileName = fileName + ".tmp";
+    {
+        std::ofstream file(tempFileName);
+        if (!file.good()) {
+            OpenSim::log_warn("Could not write the sparsity pattern cache "
+                              "file '{}'.", fileName);
+            return;
+        }
+        file << "casoc_sparsity " << sparsity.size1() << " "
+             << sparsity.size2() << " " << sparsity.nnz() << "\n";
+        for (const auto& value : sparsity.get_colind()) file << value << " ";
+        file << "\n";
+        for (const auto& value : sparsity.get_row()) file << value << " ";
+        file << "\n";
+    }
+    std::remove(fileName.c_str());
+    if (std::rename(tempFileName.c_str(), fileName.c_str()) != 0) {
+        OpenSim::log_warn("Could not write the sparsity pattern cache "
+                          "file '{}'.", fileName);
+        std::remove(tempFileName.c_str());
+    }
+}
+
+Function::~Function() = default;
+
+void Function::evalOnStackedInputs(
+        const casadi::DM& x, casadi::DM& y) const {
     using casadi::Slice;
+    // Split input into separate DMs.
+    std::vector<casadi::DM> in(n_in());
+    {
+        int offset = 0;
+        for (int iin = 0; iin < n_in(); ++iin) {
+            OPENSIM_THROW_IF(size2_in(iin) != 1, OpenSim::Exception,
+                    "Internal error.");
+            const auto size = size1_in(iin);
+            in[iin] = x(Slice(offset, offset + size));
+            offset += size;
+        }
+    }
+
+    // Evaluate the function.
+    std::vector<casadi::DM> out = eval(in);
+
+    // Create output.
+    y = casadi::DM::veccat(out);
+}
+
+bool Function::loadCachedJacobianSparsity() const {
+    const std::string cacheFile = m_casProblem->getSparsityCacheFile(m_name);
+    if (cacheFile.empty() || !readSparsity(cacheFile, nnz_out(), nnz_in(),
+                                     m_jacobianSparsity)) {
+        return false;
+    }
+    OpenSim::log_debug("CasOC::Function '{}': loaded the Jacobian "
+                       "sparsity pattern from '{}'.",
+            m_name, cacheFile);
+    m_hasJacobianSparsity = true;
+    return true;
+}
 
-    auto function = [this](const casadi::DM& x, casadi::DM& y) {
-        // Split input into separate DMs.
-        std::vector<casadi::DM> in(this->n_in());
-        {
-            int offset = 0;
-            for (int iin = 0; iin < this->n_in(); ++iin) {
-                OPENSIM_THROW_IF(this->size2_in(iin) != 1, OpenSim::Exception,
-                        "Internal error.");
-                const auto size = this->size1_in(iin);
-                in[iin] = x(Slice(offset, offset + size));
-                offset += size;
+void Function::setDetectedJacobianSparsity(
+        const std::vector<casadi::Sparsity>& patterns) const {
+    std::vector<casadi_int> numUnique;
+    m_jacobianSparsity = unionSparsityPatterns(patterns, numUnique);
+    m_hasJacobianSparsity = true;
+    if (patterns.size() > 1) {
+        std::string counts;
+        for (const auto& count : numUnique) {
+            counts += (counts.empty() ? "" : ", ") + std::to_string(count);
+        }
+        OpenSim::log_debug("CasOC::Function '{}': detected {} Jacobian "
+                           "nonzeros from {} points; nonzeros found at only "
+                           "one point (by point): {}.",
+                m_name, m_jacobianSparsity.nnz(), patterns.size(), counts);
+    }
+    const std::string cacheFile = m_casProblem->getSparsityCacheFile(m_name);
+    if (!cacheFile.empty()) writeSparsity(cacheFile, m_jacobianSparsity);
+}
+
+casadi::Sparsity Function::get_jacobian_sparsity() const {
+    if (!m_hasJacobianSparsity) detectJacobianSparsity({this}, 1, nullptr);
+    return m_jacobianSparsity;
+}
+
+void Function::detectJacobianSparsity(
+        const std::vector<const Function*>& functions, int numThreads,
+        OpenSim::ThreadPool* pool) {
+    // Each task perturbs the inputs of one function at one point.
+    struct Task {
+        int function;
+        int point;
+    };
+    std::vector<const Function*> pending;
+    std::vector<VectorDM> points;
+    std::vector<Task> tasks;
+    for (const Function* function : functions) {
+        if (!function->has_jacobian_sparsity() ||
+                function->m_hasJacobianSparsity ||
+                std::find(pending.begin(), pending.end(), function) !=
+                        pending.end() ||
+                function->loadCachedJacobianSparsity()) {
+            continue;
+        }
+        VectorDM x0s = function->getSubsetPointsForSparsityDetection();
+        for (const auto& x0 : x0s) {
+            OPENSIM_THROW_IF(x0.numel() != x0s[0].numel(), OpenSim::Exception,
+                    "x0s contains vectors of different sizes.");
+        }
+        for (int ipoint = 0; ipoint < (int)x0s.size(); ++ipoint) {
+            tasks.push_back({(int)pending.size(), ipoint});
+        }
+        pending.push_back(function);
+        points.push_back(std::move(x0s));
+    }
+    if (tasks.empty()) return;
+
+    // The cost of a task grows with the number of inputs that are perturbed;
+    // claiming the costliest tasks first keeps a large task from being left
+    // for the end, when the other threads are idle.
+    std::stable_sort(tasks.begin(), tasks.end(),
+            [&](const Task& a, const Task& b) {
+                return pending[a.function]->nnz_in() >
+                       pending[b.function]->nnz_in();
+            });
+
+    std::vector<std::vector<casadi::Sparsity>> patterns(pending.size());
+    for (int i = 0; i < (int)pending.size(); ++i) {
+        patterns[i].resize(points[i].size());
+    }
+    // The problem provides a copy of the model to each thread that evaluates
+    // a function, so that the tasks can run concurrently.
+    const auto detect = [&](int, int itask) {
+        const Task& task = tasks[itask];
+        const Function& function = *pending[task.function];
+        OpenSim::TraceEventRecorder::Scope scope(
+                function.m_casProblem->getTraceRecorder(),
+                "sparsity_detection", function.m_name.c_str());
+        patterns[task.function][task.point] =
+                calcJacobianSparsityWithPerturbation(
+                        points[task.function][task.point],
+                        (int)function.nnz_out(),
+                        [&function](const casadi::DM& x, casadi::DM& y) {
+                            function.evalOnStackedInputs(x, y);
+                        });
+    };
+    if (pool && numThreads > 1) {
+        pool->parallelForEach((int)tasks.size(), detect);
+    } else {
+        OpenSim::parallelForEach(
+                (int)tasks.size(), std::max(1, numThreads), detect);
+    }
+
+    for (int i = 0; i < (int)pending.size(); ++i) {
+        pending[i]->setDetectedJacobianSparsity(patterns[i]);
+    }
+}
+
+casadi::Function Function::get_jacobian(const std::string& name,
+        const std::vector<std::string>& inames,
+        const std::vector<std::string>& onames,
+        const casadi::Dict& opts) const {
+    m_jacobians.push_back(OpenSim::make_unique<SparseJacobian>());
+    SparseJacobian& jacobian = *m_jacobians.back();
+    jacobian.constructFunction(*this, *this, 1, m_casProblem, name, inames,
+            onames, get_jacobian_sparsity(), m_finite_difference_scheme, opts);
+    OpenSim::log_debug("CasOC::Function '{}': perturbing {} inputs in {} "
+                       "groups to compute the Jacobian.",
+            m_name, jacobian.getNumPerturbedInputs(),
+            jacobian.getNumColors());
+    return jacobian;
+}
+
+namespace {
+    // The inputs of `function` at column `column` of `args`, which are in
+    // the form of the inputs of Function::evalBatch().
+    VectorDM getColumn(const casadi::Function& function, const VectorDM& args,
+            int column) {
+        VectorDM in(args.size());
+        for (int i = 0; i < (int)args.size(); ++i) {
+            const casadi_int size = function.nnz_in(i);
+            const double* begin = args[i].ptr() + column * size;
+            in[i] = casadi::DM(function.sparsity_in(i),
+                    std::vector<double>(begin, begin + size));
+        }
+        return in;
+    }
+
+    // The column `column` of each of `out` (in the form of the outputs of
+    // Function::evalBatch()) are the nonzeros of each of `pointOut`.
+    void setColumn(const casadi::Function& function, const VectorDM& pointOut,
+            int column, VectorDM& out) {
+        for (int o = 0; o < (int)out.size(); ++o) {
+            const casadi_int size = function.nnz_out(o);
+            std::copy_n(pointOut[o].ptr(), size, out[o].ptr() + column * size);
+        }
+    }
+
+    VectorDM createBatchOutputs(const casadi::Function& function,
+            int numColumns) {
+        VectorDM out(function.n_out());
+        for (int o = 0; o < (int)out.size(); ++o) {
+            out[o] = casadi::DM::zeros(function.nnz_out(o), numColumns);
+        }
+        return out;
+    }
+}
+
+VectorDM Function::evalBatch(const VectorDM& args, int numColumns) const {
+    VectorDM out = createBatchOutputs(*this, numColumns);
+    for (int k = 0; k < numColumns; ++k) {
+        setColumn(*this, eval(getColumn(*this, args, k)), k, out);
+    }
+    return out;
+}
+
+void SparseJacobian::constructFunction(const Function& function,
+        const casadi::Callback& evaluated, int numColumns,
+        const Problem* casProblem, const std::string& name,
+        const std::vector<std::string>& inames,
+        const std::vector<std::string>& onames,
+        const casadi::Sparsity& sparsity, const std::string& finiteDiffScheme,
+        casadi::Dict opts) {
+    OPENSIM_THROW_IF(
+            (casadi_int)inames.size() != function.n_in() + function.n_out() ||
+                    onames.size() != 1,
+            OpenSim::Exception,
+            "Internal error: expected the Jacobian of '{}' to have {} inputs "
+            "and 1 output, but got {} and {}.",
+            function.name(), function.n_in() + function.n_out(),
+            inames.size(), onames.size());
+    m_function = &function;
+    m_evaluated = &evaluated;
+    m_numColumns = numColumns;
+    m_casProblem = casProblem;
+    m_name = name;
+    m_inputNames = inames;
+    m_outputNames = onames;
+    m_pointSparsity = sparsity;
+    m_finite_difference_scheme = finiteDiffScheme;
+
+    m_inputIndices.clear();
+    m_inputOffsets.clear();
+    for (int iin = 0; iin < (int)function.n_in(); ++iin) {
+        for (int k = 0; k < (int)function.nnz_in(iin); ++k) {
+            m_inputIndices.push_back(iin);
+            m_inputOffsets.push_back(k);
+        }
+    }
+    OPENSIM_THROW_IF((casadi_int)m_inputIndices.size() != sparsity.size2(),
+            OpenSim::Exception,
+            "Internal error: the Jacobian sparsity of '{}' has {} columns, "
+            "but the function has {} input nonzeros.",
+            function.name(), sparsity.size2(), m_inputIndices.size());
+
+    // Perturbing an input changes all of its rows, including those in the
+    // analytic block, so the coloring uses the entire sparsity; but only
+    // inputs with entries outside of the block must be perturbed.
+    m_analyticBlock = function.getAnalyticJacobianBlock();
+    const auto& block = m_analyticBlock;
+    const std::vector<casadi_int> colind = sparsity.get_colind();
+    const std::vector<casadi_int> row = sparsity.get_row();
+    m_isAnalytic.assign(sparsity.nnz(), false);
+    std::vector<bool> isPerturbed(sparsity.size2(), false);
+    for (int j = 0; j < (int)sparsity.size2(); ++j) {
+        const bool inBlockColumns = j >= block.firstColumn &&
+                                    j < block.firstColumn + block.numColumns;
+        for (casadi_int k = colind[j]; k < colind[j + 1]; ++k) {
+            m_isAnalytic[k] = inBlockColumns && row[k] >= block.firstRow &&
+                              row[k] < block.firstRow + block.numRows;
+            if (!m_isAnalytic[k]) isPerturbed[j] = true;
+        }
+    }
+    m_columnsByColor = colorColumns(sparsity, isPerturbed);
+
+    // The inputs and outputs of a batch are those of the function at each
+    // column, one after the other, so the Jacobian of a batch consists of
+    // the Jacobian at each column, scattered into a block-diagonal pattern.
+    m_outputIndices.clear();
+    for (int k = 0; k < numColumns; ++k) {
+        casadi_int offset = 0;
+        for (int o = 0; o < (int)function.n_out(); ++o) {
+            const casadi_int size = function.nnz_out(o);
+            for (casadi_int r = 0; r < size; ++r) {
+                m_outputIndices.push_back(
+                        numColumns * offset + k * size + r);
             }
+            offset += size;
         }
+    }
+    m_batchInputIndices.clear();
+    for (int k = 0; k < numColumns; ++k) {
+        casadi_int offset = 0;
+        for (int i = 0; i < (int)function.n_in(); ++i) {
+            const casadi_int size = function.nnz_in(i);
+            for (casadi_int r = 0; r < size; ++r) {
+                m_batchInputIndices.push_back(
+                        numColumns * offset + k * size + r);
+            }
+            offset += size;
+        }
+    }
+    const casadi_int numOutputs = sparsity.size1();
+    const casadi_int numInputs = sparsity.size2();
+    std::vector<casadi_int> rows;
+    std::vector<casadi_int> columns;
+    sparsity.get_triplet(rows, columns);
+    std::vector<casadi_int> batchRows;
+    std::vector<casadi_int> batchColumns;
+    batchRows.reserve(numColumns * rows.size());
+    batchColumns.reserve(numColumns * rows.size());
+    for (int k = 0; k < numColumns; ++k) {
+        for (int p = 0; p < (int)rows.size(); ++p) {
+            batchRows.push_back(m_outputIndices[k * numOutputs + rows[p]]);
+            batchColumns.push_back(
+                    m_batchInputIndices[k * numInputs + columns[p]]);
+        }
+    }
+    m_sparsity = casadi::Sparsity::triplet(numColumns * numOutputs,
+            numColumns * numInputs, batchRows, batchColumns);
+    m_nonzeroIndices = m_sparsity.get_nz(batchRows, batchColumns);
 
-        // Evaluate the function.
-        std::vector<casadi::DM> out = this->eval(in);
+    // Second derivatives (e.g., for an exact Hessian) are computed by a
+    // SparseJacobianDerivative (see get_jacobian()).
+    construct(name, opts);
+}
 
-        // Create output.
-        y = casadi::DM::veccat(out);
+namespace {
+    // The (row, column) of each entry of the Jacobian of a SparseJacobian:
+    // the derivative of nonzero p of the Jacobian at one point (in row r)
+    // with respect to each input in the pattern of row r, for each column k
+    // of the batch, in this order.
+    void calcDerivativeTriplets(const casadi::Sparsity& pointSparsity,
+            int numColumns, const std::vector<casadi_int>& nonzeroIndices,
+            const std::vector<casadi_int>& batchInputIndices,
+            std::vector<casadi_int>& rows, std::vector<casadi_int>& columns) {
+        std::vector<casadi_int> pointRows;
+        std::vector<casadi_int> pointColumns;
+        pointSparsity.get_triplet(pointRows, pointColumns);
+        std::vector<std::vector<casadi_int>> columnsByRow(
+                pointSparsity.size1());
+        for (int p = 0; p < (int)pointRows.size(); ++p) {
+            columnsByRow[pointRows[p]].push_back(pointColumns[p]);
+        }
+        const casadi_int pointNumNonzeros = pointSparsity.nnz();
+        const casadi_int pointNumInputs = pointSparsity.size2();
+        rows.clear();
+        columns.clear();
+        for (int k = 0; k < numColumns; ++k) {
+            for (int p = 0; p < (int)pointRows.size(); ++p) {
+                for (casadi_int j : columnsByRow[pointRows[p]]) {
+                    rows.push_back(nonzeroIndices[k * pointNumNonzeros + p]);
+                    columns.push_back(
+                            batchInputIndices[k * pointNumInputs + j]);
+                }
+            }
+        }
+    }
+}
+
+casadi::Sparsity SparseJacobian::get_jacobian_sparsity() const {
+    std::vector<casadi_int> rows;
+    std::vector<casadi_int> columns;
+    calcDerivativeTriplets(m_pointSparsity, m_numColumns, m_nonzeroIndices,
+            m_batchInputIndices, rows, columns);
+    // The Jacobian does not depend on the nominal outputs, which are the
+    // last inputs.
+    return casadi::Sparsity::triplet(
+            m_sparsity.nnz(), nnz_in(), rows, columns);
+}
+
+casadi::Function SparseJacobian::get_jacobian(const std::string& name,
+        const std::vector<std::string>& inames,
+        const std::vector<std::string>& onames,
+        const casadi::Dict& opts) const {
+    m_derivatives.push_back(OpenSim::make_unique<SparseJacobianDerivative>());
+    SparseJacobianDerivative& derivative = *m_derivatives.back();
+    derivative.constructFunction(*this, name, inames, onames, opts);
+    OpenSim::log_debug("CasOC::Function '{}': perturbing the inputs in {} "
+                       "groups to compute the second derivatives.",
+            m_function->name(), derivative.getNumColors());
+    return derivative;
+}
+
+casadi::Sparsity SparseJacobian::get_sparsity_in(casadi_int i) {
+    const casadi_int numInputs = m_evaluated->n_in();
+    if (i < numInputs) return m_evaluated->sparsity_in(i);
+    return m_evaluated->sparsity_out(i - numInputs);
+}
+
+VectorDM SparseJacobian::eval(const VectorDM& args) const {
+    OpenSim::TraceEventRecorder::Scope scope(
+            m_casProblem->getTraceRecorder(), "jacobian", m_name.c_str());
+    const int numInputs = (int)m_function->n_in();
+    const VectorDM inputs(args.begin(), args.begin() + numInputs);
+    // The outputs of the function at the unperturbed inputs.
+    const std::vector<double> nominal =
+            casadi::DM::veccat(VectorDM(args.begin() + numInputs, args.end()))
+                    .nonzeros();
+
+    const bool central = m_finite_difference_scheme == "central";
+    // Steps that balance truncation and round-off errors, relative to the
+    // magnitude of each input (but no smaller than for an input of 1).
+    const double eps = std::numeric_limits<double>::epsilon();
+    const double relativeStep = central ? std::cbrt(eps) : std::sqrt(eps);
+    const double sign = m_finite_difference_scheme == "backward" ? -1 : 1;
+
+    const std::vector<casadi_int> colind = m_pointSparsity.get_colind();
+    const std::vector<casadi_int> row = m_pointSparsity.get_row();
+    const casadi_int pointNumNonzeros = m_pointSparsity.nnz();
+    const casadi_int pointNumOutputs = m_pointSparsity.size1();
+    casadi::DM jacobian(m_sparsity);
+    std::vector<double>& values = jacobian.nonzeros();
+    // The step of input nonzero j at column k is steps[k * nnz_in + j].
+    const int pointNumInputs = (int)m_inputIndices.size();
+    std::vector<double> steps(m_numColumns * pointNumInputs);
+    // The value of input nonzero j at column k of `in`.
+    const auto inputValue = [&](VectorDM& in, int k, int j) -> double& {
+        const int iin = m_inputIndices[j];
+        return in[iin].nonzeros()[k * m_function->nnz_in(iin) +
+                                  m_inputOffsets[j]];
+    };
+    const auto value = [&](int k, casadi_int p) -> double& {
+        return values[m_nonzeroIndices[k * pointNumNonzeros + p]];
+    };
+    const auto outputIndex = [&](int k, casadi_int r) {
+        return m_outputIndices[k * pointNumOutputs + r];
+    };
+
+    if (m_analyticBlock.numRows && m_analyticBlock.numColumns) {
+        casadi::DM block;
+        for (int k = 0; k < m_numColumns; ++k) {
+            m_function->calcAnalyticJacobianBlock(
+                    m_numColumns == 1 ? inputs
+                                      : getColumn(*m_function, inputs, k),
+                    block);
+            for (int j = m_analyticBlock.firstColumn;
+                    j < m_analyticBlock.firstColumn +
+                                m_analyticBlock.numColumns;
+                    ++j) {
+                for (casadi_int p = colind[j]; p < colind[j + 1]; ++p) {
+                    if (!m_isAnalytic[p]) continue;
+                    value(k, p) = block(row[p] - m_analyticBlock.firstRow,
+                            j - m_analyticBlock.firstColumn).scalar();
+                }
+            }
+        }
+    }
+
+    auto evalPerturbed = [&](const std::vector<int>& columns, double scale) {
+        VectorDM perturbed = inputs;
+        for (int k = 0; k < m_numColumns; ++k) {
+            for (int j : columns) {
+                inputValue(perturbed, k, j) +=
+                        scale * steps[k * pointNumInputs + j];
+            }
+        }
+        return casadi::DM::veccat(m_evaluated->eval(perturbed)).nonzeros();
+    };
+
+    VectorDM unperturbed = inputs;
+    for (const auto& columns : m_columnsByColor) {
+        for (int k = 0; k < m_numColumns; ++k) {
+            for (int j : columns) {
+                const double x = inputValue(unperturbed, k, j);
+                steps[k * pointNumInputs + j] =
+                        sign * relativeStep * std::max(1.0, std::abs(x));
+            }
+        }
+        // Since the columns in the group have no rows in common, each row of
+        // the perturbed outputs belongs to (at most) one of the columns.
+        if (central) {
+            const std::vector<double> plus = evalPerturbed(columns, 1);
+            const std::vector<double> minus = evalPerturbed(columns, -1);
+            for (int k = 0; k < m_numColumns; ++k) {
+                for (int j : columns) {
+                    const double step = steps[k * pointNumInputs + j];
+                    for (casadi_int p = colind[j]; p < colind[j + 1]; ++p) {
+                        if (m_isAnalytic[p]) continue;
+                        const casadi_int r = outputIndex(k, row[p]);
+                        value(k, p) = (plus[r] - minus[r]) / (2 * step);
+                    }
+                }
+            }
+        } else {
+            const std::vector<double> perturbed = evalPerturbed(columns, 1);
+            for (int k = 0; k < m_numColumns; ++k) {
+                for (int j : columns) {
+                    const double step = steps[k * pointNumInputs + j];
+                    for (casadi_int p = colind[j]; p < colind[j + 1]; ++p) {
+                        if (m_isAnalytic[p]) continue;
+                        const casadi_int r = outputIndex(k, row[p]);
+                        value(k, p) = (perturbed[r] - nominal[r]) / step;
+                    }
+                }
+            }
+        }
+    }
+    return {jacobian};
+}
+
+void SparseJacobianDerivative::constructFunction(
+        const SparseJacobian& jacobian, const std::string& name,
+        const std::vector<std::string>& inames,
+        const std::vector<std::string>& onames, casadi::Dict opts) {
+    OPENSIM_THROW_IF(
+            (casadi_int)inames.size() != jacobian.n_in() + 1 ||
+                    onames.size() != 1,
+            OpenSim::Exception,
+            "Internal error: expected the Jacobian of '{}' to have {} inputs "
+            "and 1 output, but got {} and {}.",
+            jacobian.name(), jacobian.n_in() + 1, inames.size(),
+            onames.size());
+    m_jacobian = &jacobian;
+    m_name = name;
+    m_inputNames = inames;
+    m_outputNames = onames;
+
+    const casadi::Sparsity& pointSparsity = jacobian.m_pointSparsity;
+    std::vector<casadi_int> rows;
+    std::vector<casadi_int> columns;
+    calcDerivativeTriplets(pointSparsity, jacobian.m_numColumns,
+            jacobian.m_nonzeroIndices, jacobian.m_batchInputIndices, rows,
+            columns);
+    m_sparsity = casadi::Sparsity::triplet(
+            jacobian.m_sparsity.nnz(), jacobian.nnz_in(), rows, columns);
+    m_derivativeIndices = m_sparsity.get_nz(rows, columns);
+
+    std::vector<casadi_int> pointRows;
+    std::vector<casadi_int> pointColumns;
+    pointSparsity.get_triplet(pointRows, pointColumns);
+    m_nonzerosByRow.assign(pointSparsity.size1(), {});
+    m_positionsInRow.resize(pointRows.size());
+    for (int p = 0; p < (int)pointRows.size(); ++p) {
+        m_positionsInRow[p] = m_nonzerosByRow[pointRows[p]].size();
+        m_nonzerosByRow[pointRows[p]].push_back(p);
+    }
+    m_derivativeOffsets.resize(pointRows.size());
+    casadi_int offset = 0;
+    for (int p = 0; p < (int)pointRows.size(); ++p) {
+        m_derivativeOffsets[p] = offset;
+        offset += m_nonzerosByRow[pointRows[p]].size();
+    }
+
+    // Perturbing an input changes every entry in the rows of its column,
+    // including the entries that the SparseJacobian computes analytically.
+    m_columnsByColor = colorColumns(
+            pointSparsity, std::vector<bool>(pointSparsity.size2(), true));
+    construct(name, opts);
+}
+
+casadi::Sparsity SparseJacobianDerivative::get_sparsity_in(casadi_int i) {
+    if (i < m_jacobian->n_in()) return m_jacobian->sparsity_in(i);
+    return m_jacobian->sparsity_out(0);
+}
+
+VectorDM SparseJacobianDerivative::eval(const VectorDM& args) const {
+    const SparseJacobian& jac = *m_jacobian;
+    OpenSim::TraceEventRecorder::Scope scope(
+            jac.m_casProblem->getTraceRecorder(), "jacobian_derivative",
+            m_name.c_str());
+    const int numInputs = (int)jac.m_function->n_in();
+    const VectorDM inputs(args.begin(), args.begin() + numInputs);
+    // The Jacobian at the unperturbed inputs.
+    const std::vector<double>& nominal = args.back().nonzeros();
+
+    const bool central = jac.m_finite_difference_scheme == "central";
+    // The Jacobian is itself computed with finite differences, so the steps
+    // are larger than those of the SparseJacobian to limit the round-off
+    // error of differencing its (less accurate) entries.
+    const double eps = std::numeric_limits<double>::epsilon();
+    const double relativeStep =
+            central ? std::pow(eps, 0.25) : std::cbrt(eps);
+    const double sign = jac.m_finite_difference_scheme == "backward" ? -1 : 1;
+
+    const std::vector<casadi_int> colind = jac.m_pointSparsity.get_colind();
+    const std::vector<casadi_int> row = jac.m_pointSparsity.get_row();
+    const casadi_int pointNumNonzeros = jac.m_pointSparsity.nnz();
+    const casadi_int numDerivatives =
+            (casadi_int)m_derivativeIndices.size() / jac.m_numColumns;
+    casadi::DM derivative(m_sparsity);
+    std::vector<double>& values = derivative.nonzeros();
+    const int pointNumInputs = (int)jac.m_inputIndices.size();
+    std::vector<double> steps(jac.m_numColumns * pointNumInputs);
+    const auto inputValue = [&](VectorDM& in, int k, int j) -> double& {
+        const int iin = jac.m_inputIndices[j];
+        return in[iin].nonzeros()[k * jac.m_function->nnz_in(iin) +
+                                  jac.m_inputOffsets[j]];
+    };
+
+    auto evalPerturbed = [&](const std::vector<int>& columns, double scale) {
+        VectorDM perturbed = inputs;
+        for (int k = 0; k < jac.m_numColumns; ++k) {
+            for (int j : columns) {
+                inputValue(perturbed, k, j) +=
+                        scale * steps[k * pointNumInputs + j];
+            }
+        }
+        // Forward (and backward) differences of the Jacobian use the
+        // outputs of the function at the perturbed inputs.
+        VectorDM jacobianArgs = perturbed;
+        if (central) {
+            jacobianArgs.insert(jacobianArgs.end(), args.begin() + numInputs,
+                    args.end() - 1);
+        } else {
+            const VectorDM out = jac.m_evaluated->eval(perturbed);
+            jacobianArgs.insert(jacobianArgs.end(), out.begin(), out.end());
+        }
+        return jac.eval(jacobianArgs)[0].nonzeros();
+    };
+
+    // Since the columns in a group have no rows in common, each row of the
+    // Jacobian (and so each of its entries) depends on (at most) one of the
+    // perturbed inputs.
+    const auto setDerivatives = [&](const std::vector<int>& columns,
+                                        const std::vector<double>& diff,
+                                        double scale) {
+        for (int k = 0; k < jac.m_numColumns; ++k) {
+            for (int j : columns) {
+                const double step = scale * steps[k * pointNumInputs + j];
+                for (casadi_int q = colind[j]; q < colind[j + 1]; ++q) {
+                    for (casadi_int p : m_nonzerosByRow[row[q]]) {
+                        const casadi_int entry =
+                                jac.m_nonzeroIndices[k * pointNumNonzeros + p];
+                        values[m_derivativeIndices[k * numDerivatives +
+                                                   m_derivativeOffsets[p] +
+                                                   m_positionsInRow[q]]] =
+                                diff[entry] / step;
+                    }
+                }
+            }
+        }
     };
 
-    const VectorDM x0s = getSubsetPointsForSparsityDetection();
+    VectorDM unperturbed = inputs;
+    std::vector<double> diff(nominal.size());
+    for (const auto& columns : m_columnsByColor) {
+        for (int k = 0; k < jac.m_numColumns; ++k) {
+            for (int j : columns) {
+                const double x = inputValue(unperturbed, k, j);
+                steps[k * pointNumInputs + j] =
+                        sign * relativeStep * std::max(1.0, std::abs(x));
+            }
+        }
+        const std::vector<double> plus = evalPerturbed(columns, 1);
+        if (central) {
+            const std::vector<double> minus = evalPerturbed(columns, -1);
+            for (int i = 0; i < (int)diff.size(); ++i) {
+                diff[i] = plus[i] - minus[i];
+            }
+            setDerivatives(columns, diff, 2);
+        } else {
+            for (int i = 0; i < (int)diff.size(); ++i) {
+                diff[i] = plus[i] - nominal[i];
+            }
+            setDerivatives(columns, diff, 1);
+        }
+    }
+    return {derivative};
+}
 
-    return calcJacobianSparsityWithPerturbation(
-            x0s, (int)this->nnz_out(), function);
+void BatchFunction::constructFunction(const Function& function,
+        int numColumns, int numThreads, OpenSim::ThreadPool* pool) {
+    m_function = &function;
+    m_numColumns = numColumns;
+    m_numThreads = std::max(1, std::min(numThreads, numColumns));
+    m_pool = pool;
+    construct(fmt::format("batch{}_{}", numColumns, function.name()), {});
+}
+
+VectorDM BatchFunction::eval(const VectorDM& args) const {
+    if (m_numThreads == 1) return m_function->evalBatch(args, m_numColumns);
+
+    // Each thread evaluates a contiguous range of the columns.
+    VectorDM out = createBatchOutputs(*m_function, m_numColumns);
+    const auto evalChunk = [&](int, int chunk) {
+        const int begin = chunk * m_numColumns / m_numThreads;
+        const int end = (chunk + 1) * m_numColumns / m_numThreads;
+        VectorDM chunkArgs(args.size());
+        for (int i = 0; i < (int)args.size(); ++i) {
+            const casadi_int size = m_function->nnz_in(i);
+            chunkArgs[i] = casadi::DM(casadi::Sparsity::dense(size, end - begin),
+                    std::vector<double>(args[i].ptr() + begin * size,
+                            args[i].ptr() + end * size));
+        }
+        const VectorDM chunkOut = m_function->evalBatch(chunkArgs, end - begin);
+        for (int o = 0; o < (int)out.size(); ++o) {
+            const casadi_int size = m_function->nnz_out(o);
+            std::copy_n(chunkOut[o].ptr(), (end - begin) * size,
+                    out[o].ptr() + begin * size);
+        }
+    };
+    if (m_pool) {
+        m_pool->parallelForEach(m_numThreads, evalChunk);
+    } else {
+        OpenSim::parallelForEach(m_numThreads, m_numThreads, evalChunk);
+    }
+    return out;
+}
+
+casadi::Function BatchFunction::get_jacobian(const std::string& name,
+        const std::vector<std::string>& inames,
+        const std::vector<std::string>& onames,
+        const casadi::Dict& opts) const {
+    const casadi::Sparsity pointSparsity =
+            m_function->has_jacobian_sparsity()
+                    ? m_function->get_jacobian_sparsity()
+                    : casadi::Sparsity::dense(
+                              m_function->nnz_out(), m_function->nnz_in());
+    m_jacobians.push_back(OpenSim::make_unique<SparseJacobian>());
+    SparseJacobian& jacobian = *m_jacobians.back();
+    jacobian.constructFunction(*m_function, *this, m_numColumns,
+            m_function->getCasProblem(), name, inames, onames, pointSparsity,
+            m_function->getFiniteDifferenceScheme(), opts);
+    return jacobian;
 }
 
 void Function::constructFunction(const Problem* casProblem,
@@ -109,6 +887,7 @@ void Function::constructFunction(const Problem* casProblem,
         std::shared_ptr<const std::vector<VariablesDM>>
                 pointsForSparsityDetection) {
     m_casProblem = casProblem;
+    m_name = name;
     m_finite_difference_scheme = finiteDiffScheme;
     m_fullPointsForSparsityDetection = pointsForSparsityDetection;
     casadi::Dict opts;
@@ -135,6 +914,8 @@ casadi::Sparsity Function::get_sparsity_in(casadi_int i) {
 }
 
 VectorDM PathConstraint::eval(const VectorDM& args) const {
+    OpenSim::TraceEventRecorder::Scope scope(
+            m_casProblem->getTraceRecorder(), "function", m_name.c_str());
     Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5)};
     VectorDM out{casadi::DM(sparsity_out(0))};
@@ -143,6 +924,8 @@ VectorDM PathConstraint::eval(const VectorDM& args) const {
 }
 
 VectorDM CostIntegrand::eval(const VectorDM& args) const {
+    OpenSim::TraceEventRecorder::Scope scope(
+            m_casProblem->getTraceRecorder(), "function", m_name.c_str());
     Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5)};
     VectorDM out{casadi::DM(casadi::Sparsity::scalar())};
@@ -151,6 +934,8 @@ VectorDM CostIntegrand::eval(const VectorDM& args) const {
 }
 
 VectorDM EndpointConstraintIntegrand::eval(const VectorDM& args) const {
+    OpenSim::TraceEventRecorder::Scope scope(
+            m_casProblem->getTraceRecorder(), "function", m_name.c_str());
     Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
                                    args.at(3), args.at(4), args.at(5)};
     VectorDM out{casadi::DM(casadi::Sparsity::scalar())};
@@ -189,6 +974,8 @@ casadi::Sparsity Endpoint::get_sparsity_in(casadi_int i) {
     }
 }
 VectorDM Cost::eval(const VectorDM& args) const {
+    OpenSim::TraceEventRecorder::Scope scope(
+            m_casProblem->getTraceRecorder(), "function", m_name.c_str());
     Problem::CostInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5).scalar(), args.at(6), args.at(7),
             args.at(8), args.at(9), args.at(10), args.at(11).scalar()};
@@ -197,6 +984,8 @@ VectorDM Cost::eval(const VectorDM& args) const {
     return out;
 }
 VectorDM EndpointConstraint::eval(const VectorDM& args) const {
+    OpenSim::TraceEventRecorder::Scope scope(
+            m_casProblem->getTraceRecorder(), "function", m_name.c_str());
     Problem::CostInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5).scalar(), args.at(6), args.at(7),
             args.at(8), args.at(9), args.at(10), args.at(11).scalar()};
@@ -205,6 +994,41 @@ VectorDM EndpointConstraint::eval(const VectorDM& args) const {
     return out;
 }
 
+namespace {
+    // Evaluate a multibody system function at the columns of `args` with
+    // one call to `calc(inputs, outputs)`, where `Output` is
+    // Problem::MultibodySystemExplicitOutput or
+    // Problem::MultibodySystemImplicitOutput.
+    template <typename Output, typename Calc>
+    VectorDM evalMultibodySystemBatch(const casadi::Function& function,
+            const VectorDM& args, int numColumns, Calc calc) {
+        std::vector<double> times(numColumns);
+        std::vector<VectorDM> pointArgs(numColumns);
+        std::vector<VectorDM> pointOuts(numColumns);
+        std::vector<Problem::ContinuousInput> inputs;
+        std::vector<Output> outputs;
+        inputs.reserve(numColumns);
+        outputs.reserve(numColumns);
+        for (int k = 0; k < numColumns; ++k) {
+            pointArgs[k] = getColumn(function, args, k);
+            times[k] = pointArgs[k][0].scalar();
+            for (casadi_int o = 0; o < function.n_out(); ++o) {
+                pointOuts[k].push_back(casadi::DM(function.sparsity_out(o)));
+            }
+            const VectorDM& in = pointArgs[k];
+            VectorDM& out = pointOuts[k];
+            inputs.push_back({times[k], in[1], in[2], in[3], in[4], in[5]});
+            outputs.push_back({out[0], out[1], out[2], out[3]});
+        }
+        calc(inputs, outputs);
+        VectorDM out = createBatchOutputs(function, numColumns);
+        for (int k = 0; k < numColumns; ++k) {
+            setColumn(function, pointOuts[k], k, out);
+        }
+        return out;
+    }
+}
+
 template <bool CalcKCErrors>
 casadi::Sparsity MultibodySystemExplicit<CalcKCErrors>::get_sparsity_out(
         casadi_int i) {
@@ -232,6 +1056,8 @@ casadi::Sparsity MultibodySystemExplicit<CalcKCErrors>::get_sparsity_out(
 template <bool CalcKCErrors>
 VectorDM MultibodySystemExplicit<CalcKCErrors>::eval(
         const VectorDM& args) const {
+    OpenSim::TraceEventRecorder::Scope scope(
+            m_casProblem->getTraceRecorder(), "function", m_name.c_str());
     Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5)};
     VectorDM out((int)n_out());
@@ -244,6 +1070,21 @@ VectorDM MultibodySystemExplicit<CalcKCErrors>::eval(
     return out;
 }
 
+template <bool CalcKCErrors>
+VectorDM MultibodySystemExplicit<CalcKCErrors>::evalBatch(
+        const VectorDM& args, int numColumns) const {
+    OpenSim::TraceEventRecorder::Scope scope(
+            m_casProblem->getTraceRecorder(), "function", m_name.c_str());
+    return evalMultibodySystemBatch<Problem::MultibodySystemExplicitOutput>(
+            *this, args, numColumns,
+            [this](const std::vector<Problem::ContinuousInput>& inputs,
+                    std::vector<Problem::MultibodySystemExplicitOutput>&
+                            outputs) {
+                m_casProblem->calcMultibodySystemExplicitBatch(
+                        inputs, CalcKCErrors, outputs);
+            });
+}
+
 template class CasOC::MultibodySystemExplicit<false>;
 template class CasOC::MultibodySystemExplicit<true>;
 
@@ -284,6 +1125,8 @@ casadi::DM VelocityCorrection::getSubsetPoint(
 }
 
 VectorDM VelocityCorrection::eval(const VectorDM& args) const {
+    OpenSim::TraceEventRecorder::Scope scope(
+            m_casProblem->getTraceRecorder(), "function", m_name.c_str());
     VectorDM out{casadi::DM(sparsity_out(0))};
     m_casProblem->calcVelocityCorrection(
             args.at(0).scalar(), args.at(1), args.at(2), args.at(3), out[0]);
@@ -317,6 +1160,8 @@ casadi::Sparsity MultibodySystemImplicit<CalcKCErrors>::get_sparsity_out(
 template <bool CalcKCErrors>
 VectorDM MultibodySystemImplicit<CalcKCErrors>::eval(
         const VectorDM& args) const {
+    OpenSim::TraceEventRecorder::Scope scope(
+            m_casProblem->getTraceRecorder(), "function", m_name.c_str());
     Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5)};
     VectorDM out((int)n_out());
@@ -330,5 +1175,47 @@ VectorDM MultibodySystemImplicit<CalcKCErrors>::eval(
     return out;
 }
 
+template <bool CalcKCErrors>
+VectorDM MultibodySystemImplicit<CalcKCErrors>::evalBatch(
+        const VectorDM& args, int numColumns) const {
+    OpenSim::TraceEventRecorder::Scope scope(
+            m_casProblem->getTraceRecorder(), "function", m_name.c_str());
+    return evalMultibodySystemBatch<Problem::MultibodySystemImplicitOutput>(
+            *this, args, numColumns,
+            [this](const std::vector<Problem::ContinuousInput>& inputs,
+                    std::vector<Problem::MultibodySystemImplicitOutput>&
+                            outputs) {
+                m_casProblem->calcMultibodySystemImplicitBatch(
+                        inputs, CalcKCErrors, outputs);
+            });
+}
+
+template <bool CalcKCErrors>
+Function::JacobianBlock
+MultibodySystemImplicit<CalcKCErrors>::getAnalyticJacobianBlock() const {
+    JacobianBlock block;
+    // With prescribed kinematics, the accelerations are not variables.
+    if (!m_casProblem->hasMassMatrix() ||
+            m_casProblem->getNumAccelerations() == 0) {
+        return block;
+    }
+    // The multibody residuals are the first output, and the accelerations
+    // are the first derivatives.
+    block.numRows = m_casProblem->getNumMultibodyDynamicsEquations();
+    block.firstColumn = 1 + m_casProblem->getNumStates() +
+                        m_casProblem->getNumControls() +
+                        m_casProblem->getNumMultipliers();
+    block.numColumns = m_casProblem->getNumAccelerations();
+    return block;
+}
+
+template <bool CalcKCErrors>
+void MultibodySystemImplicit<CalcKCErrors>::calcAnalyticJacobianBlock(
+        const VectorDM& inputs, casadi::DM& block) const {
+    Problem::ContinuousInput input{inputs.at(0).scalar(), inputs.at(1),
+            inputs.at(2), inputs.at(3), inputs.at(4), inputs.at(5)};
+    m_casProblem->calcMassMatrix(input, block);
+}
+
 template class CasOC::MultibodySystemImplicit<false>;
 template class CasOC::MultibodySystemImplicit<true>;
@@ -22,29 +22,41 @@
 
 #include <OpenSim/Common/Exception.h>
 
+#include <memory>
+
+namespace OpenSim {
+class ThreadPool;
+} // namespace OpenSim
+
 namespace CasOC {
 
 class Problem;
+class SparseJacobian;
+class SparseJacobianDerivative;
 
 using VectorDM = std::vector<casadi::DM>;
 
 class Function : public casadi::Callback {
 public:
-    virtual ~Function() = default;
+    virtual ~Function();
     void constructFunction(const Problem* casProblem, const std::string& name,
             const std::string& finiteDiffScheme,
             std::shared_ptr<const std::vector<VariablesDM>>
                     pointsForSparsityDetection);
     void setCommonOptions(casadi::Dict& opts) {
+        // If the sparsity of the Jacobian is known, CasADi computes the
+        // derivatives of this function from get_jacobian().
+        if (has_jacobian_sparsity()) return;
         // Compute the derivatives of this function using finite differences.
         opts["enable_fd"] = true;
         opts["fd_method"] = getFiniteDifferenceScheme();
         // Using "forward", iterations are 10x faster but problems are less
         // likely to converge.
     }
-    std::string getFiniteDifferenceScheme() {
+    std::string getFiniteDifferenceScheme() const {
         return m_finite_difference_scheme;
     }
+    const Problem* getCasProblem() const { return m_casProblem; }
     casadi_int get_n_in() override { return 6; }
     std::string get_name_in(casadi_int i) override {
         switch (i) {
@@ -62,9 +74,52 @@ public:
         return !m_fullPointsForSparsityDetection->empty();
     }
     casadi::Sparsity get_jacobian_sparsity() const override;
+    /// Detect the sparsity of the Jacobians of `functions` (those without a
+    /// known or cached sparsity) at all of their points for sparsity
+    /// detection, on up to `numThreads` threads (of `pool`, if not null).
+    /// The evaluations of all pairs of functions and points are distributed
+    /// among the threads, and the patterns of each function are then unioned
+    /// over its points. get_jacobian_sparsity() detects the sparsity of a
+    /// single function serially.
+    static void detectJacobianSparsity(
+            const std::vector<const Function*>& functions, int numThreads,
+            OpenSim::ThreadPool* pool);
+    /// If the sparsity of the Jacobian is detected, the Jacobian is a
+    /// SparseJacobian, which perturbs structurally independent inputs
+    /// together.
+    bool has_jacobian() const override { return has_jacobian_sparsity(); }
+    casadi::Function get_jacobian(const std::string& name,
+            const std::vector<std::string>& inames,
+            const std::vector<std::string>& onames,
+            const casadi::Dict& opts) const override;
+
+    /// A dense block of the Jacobian (rows are output nonzeros, columns are
+    /// input nonzeros) that a derived class computes directly, e.g., with
+    /// Simbody's operators, rather than with finite differences.
+    struct JacobianBlock {
+        int firstRow = 0;
+        int numRows = 0;
+        int firstColumn = 0;
+        int numColumns = 0;
+    };
+    /// By default, the entire Jacobian is computed with finite differences.
+    virtual JacobianBlock getAnalyticJacobianBlock() const { return {}; }
+    /// Compute the block given by getAnalyticJacobianBlock() at these inputs.
+    virtual void calcAnalyticJacobianBlock(
+            const VectorDM& /*inputs*/, casadi::DM& /*block*/) const {}
+
+    /// Evaluate this function at each of the `numColumns` columns of `args`
+    /// (input i is dense, with nnz_in(i) rows and `numColumns` columns) and
+    /// return the outputs in the same form (see BatchFunction). By default,
+    /// this invokes eval() for each column; derived classes override this to
+    /// share work across the columns.
+    virtual VectorDM evalBatch(const VectorDM& args, int numColumns) const;
 
 protected:
     const Problem* m_casProblem;
+    /// The name of this function, for the events of
+    /// Problem::getTraceRecorder().
+    std::string m_name;
 
 private:
     /// Here, "point" refers to a vector of all variables in the optimization
@@ -76,6 +131,15 @@ private:
         }
         return out;
     }
+    /// Evaluate this function with its inputs stacked into the column `x`,
+    /// and stack its outputs into `y`.
+    void evalOnStackedInputs(const casadi::DM& x, casadi::DM& y) const;
+    /// Load the sparsity from Problem::getSparsityCacheFile(), if possible.
+    bool loadCachedJacobianSparsity() const;
+    /// Set the sparsity to the union of the patterns detected at each point
+    /// and cache it.
+    void setDetectedJacobianSparsity(
+            const std::vector<casadi::Sparsity>& patterns) const;
     virtual casadi::DM getSubsetPoint(const VariablesDM& fullPoint) const {
         int itime = 0;
         using casadi::Slice;
@@ -91,6 +155,218 @@ private:
 
     std::shared_ptr<const std::vector<VariablesDM>>
             m_fullPointsForSparsityDetection;
+
+    // Sparsity detection is costly, and the sparsity is also needed by the
+    // Jacobian.
+    mutable bool m_hasJacobianSparsity = false;
+    mutable casadi::Sparsity m_jacobianSparsity;
+    // CasADi refers to (but does not own) the Jacobian functions, which must
+    // therefore live as long as this function.
+    mutable std::vector<std::unique_ptr<SparseJacobian>> m_jacobians;
+};
+
+/// The Jacobian of a CasOC::Function with respect to all of its inputs,
+/// computed with finite differences in which structurally independent inputs
+/// (columns of the Jacobian's sparsity pattern without common nonzero rows)
+/// are perturbed together (column compression, as in Curtis, Powell, and
+/// Reid, 1974). The columns are grouped by a greedy coloring. Each evaluation
+/// costs one (forward or backward differences) or two (central differences)
+/// evaluations of the function per group, rather than per input; e.g., the
+/// states of different muscles usually fall into the same groups. Entries in
+/// the Function's analytic block (see Function::getAnalyticJacobianBlock())
+/// are not computed with finite differences, and inputs whose entries are all
+/// in that block are not perturbed.
+///
+/// This is also the Jacobian of a BatchFunction, which evaluates the Function
+/// at `numColumns` independent points; the Jacobian is then block diagonal,
+/// and each group of inputs is perturbed at all points in the same
+/// (batched) evaluation.
+class SparseJacobian : public casadi::Callback {
+public:
+    /// `evaluated` is `function` itself (with `numColumns` = 1) or a
+    /// BatchFunction of `function` with `numColumns` columns; `sparsity` is
+    /// the sparsity of the Jacobian of `function` at one point.
+    void constructFunction(const Function& function,
+            const casadi::Callback& evaluated, int numColumns,
+            const Problem* casProblem, const std::string& name,
+            const std::vector<std::string>& inames,
+            const std::vector<std::string>& onames,
+            const casadi::Sparsity& sparsity,
+            const std::string& finiteDiffScheme, casadi::Dict opts);
+    casadi_int get_n_in() override { return (casadi_int)m_inputNames.size(); }
+    casadi_int get_n_out() override { return 1; }
+    std::string get_name_in(casadi_int i) override {
+        return m_inputNames.at(i);
+    }
+    std::string get_name_out(casadi_int i) override {
+        return m_outputNames.at(i);
+    }
+    /// The inputs are the inputs of the function, followed by its (nominal)
+    /// outputs.
+    casadi::Sparsity get_sparsity_in(casadi_int i) override;
+    casadi::Sparsity get_sparsity_out(casadi_int) override {
+        return m_sparsity;
+    }
+    VectorDM eval(const VectorDM& args) const override;
+
+    /// The Jacobian of this Jacobian (i.e., the second derivatives of the
+    /// function, as required for an exact Hessian of the Lagrangian) is a
+    /// SparseJacobianDerivative. Entry (r, c) of the Jacobian can only
+    /// depend on the inputs that output r depends on, so its sparsity follows
+    /// from the sparsity of this Jacobian.
+    bool has_jacobian_sparsity() const override { return true; }
+    casadi::Sparsity get_jacobian_sparsity() const override;
+    bool has_jacobian() const override { return true; }
+    casadi::Function get_jacobian(const std::string& name,
+            const std::vector<std::string>& inames,
+            const std::vector<std::string>& onames,
+            const casadi::Dict& opts) const override;
+
+    /// The number of groups of inputs that are perturbed together.
+    int getNumColors() const { return (int)m_columnsByColor.size(); }
+    /// The number of inputs that are perturbed (i.e., that have entries
+    /// outside of the analytic block).
+    int getNumPerturbedInputs() const {
+        int num = 0;
+        for (const auto& columns : m_columnsByColor) {
+            num += (int)columns.size();
+        }
+        return num;
+    }
+
+private:
+    const Function* m_function = nullptr;
+    const casadi::Callback* m_evaluated = nullptr;
+    int m_numColumns = 1;
+    const Problem* m_casProblem = nullptr;
+    std::string m_name;
+    std::vector<std::string> m_inputNames;
+    std::vector<std::string> m_outputNames;
+    casadi::Sparsity m_pointSparsity;
+    casadi::Sparsity m_sparsity;
+    std::string m_finite_difference_scheme;
+    // For each column of the Jacobian at one point (nonzero of the inputs),
+    // the index of the input and the index of the nonzero within that input.
+    std::vector<int> m_inputIndices;
+    std::vector<int> m_inputOffsets;
+    std::vector<std::vector<int>> m_columnsByColor;
+    Function::JacobianBlock m_analyticBlock;
+    // For each nonzero of the Jacobian at one point, whether it is in the
+    // analytic block.
+    std::vector<bool> m_isAnalytic;
+    // The index of the nonzero of the Jacobian for nonzero p of the Jacobian
+    // at column k is m_nonzeroIndices[k * nnz + p], and the index of the
+    // output nonzero for output nonzero r at column k is
+    // m_outputIndices[k * nnz_out + r].
+    std::vector<casadi_int> m_nonzeroIndices;
+    std::vector<casadi_int> m_outputIndices;
+    // The index of input nonzero j at column k is
+    // m_batchInputIndices[k * nnz_in + j].
+    std::vector<casadi_int> m_batchInputIndices;
+
+    friend class SparseJacobianDerivative;
+    // CasADi refers to (but does not own) the derivative functions.
+    mutable std::vector<std::unique_ptr<SparseJacobianDerivative>>
+            m_derivatives;
+};
+
+/// The Jacobian of a SparseJacobian with respect to the inputs of the
+/// function, i.e., the second derivatives of the function, which CasADi
+/// contracts with the constraint multipliers to form the Hessian of the
+/// Lagrangian. It is computed with finite differences of the SparseJacobian
+/// (second-order finite differences of the function), in which the inputs are
+/// perturbed in groups: inputs that do not affect a common output cannot
+/// affect a common entry of the Jacobian, so the groups are found by
+/// coloring the columns of the Jacobian's sparsity, as for the
+/// SparseJacobian itself (but including the inputs whose entries are
+/// computed analytically). Each evaluation costs one (forward or backward
+/// differences) or two (central differences) evaluations of the
+/// SparseJacobian per group. The Jacobian does not depend on the nominal
+/// outputs of the function, so their derivatives are zero.
+class SparseJacobianDerivative : public casadi::Callback {
+public:
+    void constructFunction(const SparseJacobian& jacobian,
+            const std::string& name, const std::vector<std::string>& inames,
+            const std::vector<std::string>& onames, casadi::Dict opts);
+    casadi_int get_n_in() override { return (casadi_int)m_inputNames.size(); }
+    casadi_int get_n_out() override { return 1; }
+    std::string get_name_in(casadi_int i) override {
+        return m_inputNames.at(i);
+    }
+    std::string get_name_out(casadi_int i) override {
+        return m_outputNames.at(i);
+    }
+    /// The inputs are the inputs of the SparseJacobian, followed by its
+    /// (nominal) output.
+    casadi::Sparsity get_sparsity_in(casadi_int i) override;
+    casadi::Sparsity get_sparsity_out(casadi_int) override {
+        return m_sparsity;
+    }
+    VectorDM eval(const VectorDM& args) const override;
+
+    /// The number of groups of inputs that are perturbed together.
+    int getNumColors() const { return (int)m_columnsByColor.size(); }
+
+private:
+    const SparseJacobian* m_jacobian = nullptr;
+    std::string m_name;
+    std::vector<std::string> m_inputNames;
+    std::vector<std::string> m_outputNames;
+    casadi::Sparsity m_sparsity;
+    std::vector<std::vector<int>> m_columnsByColor;
+    // The nonzeros of each row of the Jacobian at one point, and the position
+    // of each nonzero within its row.
+    std::vector<std::vector<casadi_int>> m_nonzerosByRow;
+    std::vector<casadi_int> m_positionsInRow;
+    // The index of the derivative of nonzero p of the Jacobian at one point
+    // with respect to the input of nonzero q (in the same row as p), at
+    // column k of a batch, is m_derivativeIndices[k * numDerivatives +
+    // m_derivativeOffsets[p] + m_positionsInRow[q]].
+    std::vector<casadi_int> m_derivativeOffsets;
+    std::vector<casadi_int> m_derivativeIndices;
+};
+
+/// Evaluates a CasOC::Function at each of `numColumns` columns of its inputs
+/// (e.g., at all mesh points) with Function::evalBatch(), instead of with one
+/// CasADi call per point, as with casadi::Function::map(). The columns are
+/// split among `numThreads` threads (on `pool`, if provided), each of which
+/// evaluates its columns in one batch. The Jacobian is a SparseJacobian that
+/// perturbs each group of inputs at all points at once, using the detected
+/// sparsity of the Function's Jacobian or, without sparsity detection, a
+/// dense Jacobian at each point.
+class BatchFunction : public casadi::Callback {
+public:
+    void constructFunction(const Function& function, int numColumns,
+            int numThreads, OpenSim::ThreadPool* pool);
+    casadi_int get_n_in() override { return m_function->n_in(); }
+    casadi_int get_n_out() override { return m_function->n_out(); }
+    std::string get_name_in(casadi_int i) override {
+        return m_function->name_in(i);
+    }
+    std::string get_name_out(casadi_int i) override {
+        return m_function->name_out(i);
+    }
+    casadi::Sparsity get_sparsity_in(casadi_int i) override {
+        return casadi::Sparsity::dense(m_function->nnz_in(i), m_numColumns);
+    }
+    casadi::Sparsity get_sparsity_out(casadi_int i) override {
+        return casadi::Sparsity::dense(m_function->nnz_out(i), m_numColumns);
+    }
+    VectorDM eval(const VectorDM& args) const override;
+    bool has_jacobian() const override { return true; }
+    casadi::Function get_jacobian(const std::string& name,
+            const std::vector<std::string>& inames,
+            const std::vector<std::string>& onames,
+            const casadi::Dict& opts) const override;
+
+private:
+    const Function* m_function = nullptr;
+    int m_numColumns = 0;
+    int m_numThreads = 1;
+    OpenSim::ThreadPool* m_pool = nullptr;
+    // CasADi refers to (but does not own) the Jacobian functions, which must
+    // therefore live as long as this function.
+    mutable std::vector<std::unique_ptr<SparseJacobian>> m_jacobians;
 };
 
 class PathConstraint : public Function {
@@ -268,6 +544,8 @@ public:
     }
     casadi::Sparsity get_sparsity_out(casadi_int i) override final;
     VectorDM eval(const VectorDM& args) const override;
+    /// This invokes Problem::calcMultibodySystemExplicitBatch().
+    VectorDM evalBatch(const VectorDM& args, int numColumns) const override;
 };
 
 /// This function should compute a velocity correction term to make feasible
@@ -311,6 +589,14 @@ class MultibodySystemImplicit : public Function {
     }
     casadi::Sparsity get_sparsity_out(casadi_int i) override final;
     VectorDM eval(const VectorDM& args) const override;
+    /// This invokes Problem::calcMultibodySystemImplicitBatch().
+    VectorDM evalBatch(const VectorDM& args, int numColumns) const override;
+    /// The derivative of the multibody residuals with respect to the
+    /// generalized accelerations is the mass matrix, since forces cannot
+    /// depend on accelerations.
+    JacobianBlock getAnalyticJacobianBlock() const override;
+    void calcAnalyticJacobianBlock(
+            const VectorDM& inputs, casadi::DM& block) const override;
 };
 
 } // namespace CasOC
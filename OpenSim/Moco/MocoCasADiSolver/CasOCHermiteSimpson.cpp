@@ -19,6 +19,7 @@
 
 using casadi::DM;
 using casadi::MX;
+using casadi::SX;
 using casadi::Slice;
 
 namespace CasOC {
@@ -55,34 +56,29 @@ void HermiteSimpson::calcDefectsImpl(const casadi::MX& x,
     // For more information, see doxygen documentation for the class.
 
     const int NS = m_problem.getNumStates();
+    // The mesh interval points are the start and the midpoint.
+    const SX x_i = SX::sym("x_i", NS, 2);
+    const SX xdot_i = SX::sym("xdot_i", NS, 2);
+    const SX x_ip1 = SX::sym("x_ip1", NS);
+    const SX xdot_ip1 = SX::sym("xdot_ip1", NS);
+    const SX h = SX::sym("h");
+    const SX x_mid = x_i(Slice(), 1);
+    const SX xdot_mid = xdot_i(Slice(), 1);
 
-    int time_i;
-    int time_mid;
-    int time_ip1;
-    for (int imesh = 0; imesh < m_numMeshIntervals; ++imesh) {
-        time_i = 2 * imesh; // Needed for defects and path constraints.
+    // Hermite interpolant defects.
+    const SX hermite = x_mid - 0.5 * (x_ip1 + x_i(Slice(), 0)) -
+                       (h / 8.0) * (xdot_i(Slice(), 0) - xdot_ip1);
 
-        // We enforce defect constraints on a mesh interval basis, so add
-        // constraints until the number of mesh intervals is reached.
-        time_mid = 2 * imesh + 1;
-        time_ip1 = 2 * imesh + 2;
+    // Simpson integration defects.
+    const SX simpson = x_ip1 - x_i(Slice(), 0) -
+                       (h / 6.0) * (xdot_ip1 + 4.0 * xdot_mid +
+                                           xdot_i(Slice(), 0));
 
-        const auto h = m_times(time_ip1) - m_times(time_i);
-        const auto x_i = x(Slice(), time_i);
-        const auto x_mid = x(Slice(), time_mid);
-        const auto x_ip1 = x(Slice(), time_ip1);
-        const auto xdot_i = xdot(Slice(), time_i);
-        const auto xdot_mid = xdot(Slice(), time_mid);
-        const auto xdot_ip1 = xdot(Slice(), time_ip1);
-
-        // Hermite interpolant defects.
-        defects(Slice(0, NS), imesh) =
-                x_mid - 0.5 * (x_ip1 + x_i) - (h / 8.0) * (xdot_i - xdot_ip1);
-
-        // Simpson integration defects.
-        defects(Slice(NS, 2 * NS), imesh) =
-                x_ip1 - x_i - (h / 6.0) * (xdot_ip1 + 4.0 * xdot_mid + xdot_i);
-    }
+    defects = evalOnMeshIntervals(
+            casadi::Function("hermite_simpson_defects",
+                    std::vector<SX>{x_i, xdot_i, x_ip1, xdot_ip1, h},
+                    std::vector<SX>{SX::vertcat({hermite, simpson})}),
+            x, xdot);
 }
 
 void HermiteSimpson::calcInterpolatingControlsImpl(
@@ -74,6 +74,23 @@ struct Solution : public Iterate {
     casadi::Dict stats;
     double objective;
     ObjectiveBreakdown objective_breakdown;
+    /// The multipliers of the bounds on the (unscaled) variables, in the
+    /// layout of `variables`, and of the constraints, for warm-starting a
+    /// related solve (see WarmStart).
+    VariablesDM bound_multipliers;
+    casadi::DM constraint_multipliers;
+};
+
+/// The multipliers from a previous solve, used to warm-start the optimization
+/// solver (see Solver::setWarmStart()). The bound multipliers are resampled
+/// to the grid of the new solve like an initial guess. The constraint
+/// multipliers are only used if the number of constraints is unchanged.
+/// If the barrier parameter is positive (e.g., from a checkpoint of an
+/// unfinished solve), IPOPT starts from it instead of its default mu_init.
+struct WarmStart {
+    Iterate bound_multipliers;
+    casadi::DM constraint_multipliers;
+    double barrier_parameter = 0;
 };
 
 } // namespace CasOC
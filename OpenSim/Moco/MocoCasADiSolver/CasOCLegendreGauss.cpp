@@ -19,6 +19,7 @@
 
 using casadi::DM;
 using casadi::MX;
+using casadi::SX;
 using casadi::Slice;
 
 namespace CasOC {
@@ -59,24 +60,26 @@ void LegendreGauss::calcDefectsImpl(const casadi::MX& x,
     // For more information, see doxygen documentation for the class.
 
     const int NS = m_problem.getNumStates();
-    for (int imesh = 0; imesh < m_numMeshIntervals; ++imesh) {
-        const int igrid = imesh * (m_degree + 1);
-        const auto h = m_times(igrid + m_degree + 1) - m_times(igrid);
-        const auto x_i = x(Slice(), Slice(igrid, igrid + m_degree + 1));
-        const auto xdot_i = xdot(Slice(),
-                Slice(igrid + 1, igrid + m_degree + 1));
-        const auto x_ip1 = x(Slice(), igrid + m_degree + 1);
+    // The mesh interval points are the start and the collocation points.
+    const SX x_i = SX::sym("x_i", NS, m_degree + 1);
+    const SX xdot_i = SX::sym("xdot_i", NS, m_degree + 1);
+    const SX x_ip1 = SX::sym("x_ip1", NS);
+    const SX xdot_ip1 = SX::sym("xdot_ip1", NS);
+    const SX h = SX::sym("h");
 
-        // Residual function defects.
-        MX residual = h * xdot_i - MX::mtimes(x_i, m_differentiationMatrix);
-        for (int d = 0; d < m_degree; ++d) {
-            defects(Slice(d * NS, (d + 1) * NS), imesh) = residual(Slice(), d);
-        }
+    // Residual function defects.
+    const SX residual = h * xdot_i(Slice(), Slice(1, m_degree + 1)) -
+                        SX::mtimes(x_i, SX(m_differentiationMatrix));
 
-        // End state interpolation.
-        defects(Slice(m_degree * NS, (m_degree + 1) * NS), imesh) =
-                x_ip1 - MX::mtimes(x_i, m_interpolationCoefficients);
-    }
+    // End state interpolation.
+    const SX interpolation =
+            x_ip1 - SX::mtimes(x_i, SX(m_interpolationCoefficients));
+
+    defects = evalOnMeshIntervals(
+            casadi::Function("legendre_gauss_defects",
+                    std::vector<SX>{x_i, xdot_i, x_ip1, xdot_ip1, h},
+                    std::vector<SX>{SX::vertcat({SX::vec(residual), interpolation})}),
+            x, xdot);
 }
 
 void LegendreGauss::calcInterpolatingControlsImpl(
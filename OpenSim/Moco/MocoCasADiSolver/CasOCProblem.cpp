@@ -27,6 +27,8 @@
 #include <OpenSim/Moco/MocoTrajectory.h>
 #include "MocoCasOCProblem.h"
 
+#include <cctype>
+
 using OpenSim::Exception;
 
 namespace CasOC {
@@ -47,4 +49,62 @@ Problem::createKinematicConstraintEquationNamesImpl() const {
     return names;
 }
 
+std::string Problem::getStructureDescription() const {
+    std::string description = fmt::format(
+            "dynamics_mode {}\nprescribed_kinematics {}\n"
+            "enforce_constraint_derivatives {}\nnum_coordinates {}\n"
+            "num_speeds {}\nnum_auxiliary_states {}\n"
+            "num_auxiliary_residuals {}\nnum_kinematic_constraints {}\n"
+            "num_multibody_dynamics_equations {}\n",
+            m_dynamicsMode, m_prescribedKinematics,
+            m_enforceConstraintDerivatives, m_numCoordinates, m_numSpeeds,
+            m_numAuxiliaryStates, m_numAuxiliaryResiduals,
+            getNumKinematicConstraintEquations(),
+            getNumMultibodyDynamicsEquations());
+    for (const auto& info : m_stateInfos) {
+        description += fmt::format("state {} {}\n", info.name, (int)info.type);
+    }
+    for (const auto& info : m_controlInfos) {
+        description += fmt::format("control {}\n", info.name);
+    }
+    for (const auto& info : m_multiplierInfos) {
+        description += fmt::format(
+                "multiplier {} {}\n", info.name, (int)info.level);
+    }
+    for (const auto& info : m_slackInfos) {
+        description += fmt::format("slack {}\n", info.name);
+    }
+    for (const auto& info : m_paramInfos) {
+        description += fmt::format("parameter {}\n", info.name);
+    }
+    for (const auto& name : m_auxiliaryDerivativeNames) {
+        description += fmt::format("auxiliary_derivative {}\n", name);
+    }
+    for (const auto& info : m_costInfos) {
+        description += fmt::format("cost {} {} {}\n", info.name,
+                info.num_outputs, (bool)info.integrand_function);
+    }
+    for (const auto& info : m_endpointConstraintInfos) {
+        description += fmt::format("endpoint_constraint {} {} {}\n",
+                info.name, info.num_outputs, (bool)info.integrand_function);
+    }
+    for (const auto& info : m_pathInfos) {
+        description += fmt::format(
+                "path_constraint {} {}\n", info.name, info.size());
+    }
+    return description + getStructureDescriptionImpl();
+}
+
+std::string Problem::getSparsityCacheFile(
+        const std::string& functionName) const {
+    if (m_sparsityCachePrefix.empty()) return {};
+    // Function names contain the names of goals, which may contain any
+    // character.
+    std::string fileName = functionName;
+    for (char& c : fileName) {
+        if (!std::isalnum((unsigned char)c) && c != '_' && c != '-') c = '_';
+    }
+    return m_sparsityCachePrefix + fileName + ".sparsity";
+}
+
 } // namespace CasOC
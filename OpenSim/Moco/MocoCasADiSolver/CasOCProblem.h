@@ -18,6 +18,7 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
+#include <OpenSim/Common/TraceEventRecorder.h>
 #include <OpenSim/Moco/MocoUtilities.h>
 #include "CasOCFunction.h"
 #include <casadi/casadi.hpp>
@@ -312,6 +313,36 @@ public:
             bool calcKCErrors, MultibodySystemExplicitOutput& output) const = 0;
     virtual void calcMultibodySystemImplicit(const ContinuousInput& input,
             bool calcKCErrors, MultibodySystemImplicitOutput& output) const = 0;
+    /// Evaluate calcMultibodySystemExplicit() at many points (e.g., all the
+    /// mesh points). Problems can override this to share work across the
+    /// points; by default, this invokes calcMultibodySystemExplicit() for
+    /// each point.
+    virtual void calcMultibodySystemExplicitBatch(
+            const std::vector<ContinuousInput>& inputs, bool calcKCErrors,
+            std::vector<MultibodySystemExplicitOutput>& outputs) const {
+        for (int i = 0; i < (int)inputs.size(); ++i) {
+            calcMultibodySystemExplicit(inputs[i], calcKCErrors, outputs[i]);
+        }
+    }
+    /// The implicit counterpart of calcMultibodySystemExplicitBatch().
+    virtual void calcMultibodySystemImplicitBatch(
+            const std::vector<ContinuousInput>& inputs, bool calcKCErrors,
+            std::vector<MultibodySystemImplicitOutput>& outputs) const {
+        for (int i = 0; i < (int)inputs.size(); ++i) {
+            calcMultibodySystemImplicit(inputs[i], calcKCErrors, outputs[i]);
+        }
+    }
+    /// Problems that can compute the mass matrix of the multibody system
+    /// return true, in which case calcMassMatrix() provides the derivative of
+    /// the implicit multibody residuals with respect to the generalized
+    /// accelerations, instead of finite differences.
+    virtual bool hasMassMatrix() const { return false; }
+    /// The (dense, NU x NU) mass matrix at the generalized coordinates (and
+    /// parameters) of `input`.
+    virtual void calcMassMatrix(const ContinuousInput& /*input*/,
+            casadi::DM& /*massMatrix*/) const {
+        OPENSIM_THROW(OpenSim::Exception, "Internal error.");
+    }
     virtual void calcVelocityCorrection(const double& time,
             const casadi::DM& multibody_states, const casadi::DM& slacks,
             const casadi::DM& parameters,
@@ -336,12 +367,24 @@ public:
     void intermediateCallbackWithIterate(const CasOC::Iterate& it) const {
         intermediateCallbackWithIterateImpl(it);
     }
+    void checkpointCallback(const CasOC::Iterate& it,
+            const CasOC::WarmStart& warmStart) const {
+        checkpointCallbackImpl(it, warmStart);
+    }
+    /// Derived classes can describe the parts of their structure that are
+    /// not known to CasOC (e.g., the model); see getStructureDescription().
+    virtual std::string getStructureDescriptionImpl() const { return {}; }
     /// This is invoked once for each iterate in the optimization process.
     virtual void intermediateCallbackImpl() const {}
     /// Process an intermediate iterate. The frequency with which this is
     /// evaluated is governed by Solver::getOutputInterval().
     virtual void intermediateCallbackWithIterateImpl(
             const CasOC::Iterate&) const {}
+    /// Save the primal-dual iterate of an intermediate iteration, from which
+    /// the solve can be resumed. The frequency with which this is evaluated
+    /// is governed by Solver::getCheckpointInterval().
+    virtual void checkpointCallbackImpl(
+            const CasOC::Iterate&, const CasOC::WarmStart&) const {}
     /// @}
 
 public:
@@ -379,10 +422,36 @@ public:
         return it;
     }
 
+    /// If not null, the evaluations of the CasOC::Function%s of this
+    /// problem, the phases of the transcription, and the iterations of the
+    /// optimization solver are recorded with this recorder (not owned).
+    void setTraceRecorder(OpenSim::TraceEventRecorder* recorder) {
+        m_traceRecorder = recorder;
+    }
+    OpenSim::TraceEventRecorder* getTraceRecorder() const {
+        return m_traceRecorder;
+    }
+
+    /// A description of the structure of this problem (the names and sizes of
+    /// its variables and functions, and, from getStructureDescriptionImpl(),
+    /// of the underlying model), which determines the sparsity of the
+    /// Jacobians of its functions. Problems with the same description can
+    /// share cached sparsity patterns (see getSparsityCacheFile()).
+    std::string getStructureDescription() const;
+    /// The file in which the sparsity pattern of the Jacobian of the function
+    /// `functionName` is cached, or an empty string if sparsity patterns are
+    /// not cached (see Solver::setSparsityCacheDirectory()).
+    std::string getSparsityCacheFile(const std::string& functionName) const;
+
+    /// If `sparsityCachePrefix` is not empty, the sparsity patterns detected
+    /// with `pointsForSparsityDetection` are cached in files whose names
+    /// start with this prefix.
     void initialize(const std::string& finiteDiffScheme,
             std::shared_ptr<const std::vector<VariablesDM>>
-                    pointsForSparsityDetection) const {
+                    pointsForSparsityDetection,
+            std::string sparsityCachePrefix = {}) const {
         auto* mutThis = const_cast<Problem*>(this);
+        mutThis->m_sparsityCachePrefix = std::move(sparsityCachePrefix);
 
         {
             int index = 0;
@@ -633,6 +702,8 @@ private:
     std::unique_ptr<MultibodySystemImplicit<false>>
             m_implicitMultibodyFuncIgnoringConstraints;
     std::unique_ptr<VelocityCorrection> m_velocityCorrectionFunc;
+    OpenSim::TraceEventRecorder* m_traceRecorder = nullptr;
+    std::string m_sparsityCachePrefix;
 };
 
 } // namespace CasOC
@@ -22,12 +22,27 @@
 #include "CasOCLegendreGauss.h"
 #include "CasOCLegendreGaussRadau.h"
 
+#include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/ThreadPool.h>
 #include <OpenSim/Moco/MocoUtilities.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
 using OpenSim::Exception;
 
 namespace CasOC {
 
+std::string hashToHexString(const std::string& str) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const char c : str) {
+        hash ^= (unsigned char)c;
+        hash *= 1099511628211ull;
+    }
+    return fmt::format("{:016x}", hash);
+}
+
 std::unique_ptr<Transcription> Solver::createTranscription() const {
     std::unique_ptr<Transcription> transcription;
     if (m_transcriptionScheme == "trapezoidal") {
@@ -113,9 +128,20 @@ void Solver::setParallelism(std::string parallelism, int numThreads) {
     OPENSIM_THROW_IF(numThreads < 1, OpenSim::Exception,
             "Expected numThreads >= 1 but got {}.", numThreads);
     m_numThreads = numThreads;
+    if (parallelism == "pool") {
+        if (!m_threadPool || m_threadPool->getNumThreads() != numThreads) {
+            m_threadPool =
+                    std::make_shared<OpenSim::ThreadPool>(numThreads, true);
+        }
+    } else {
+        m_threadPool.reset();
+    }
 }
 
 Solution Solver::solve(const Iterate& guess) const {
+    using TraceScope = OpenSim::TraceEventRecorder::Scope;
+    auto* recorder = m_problem.getTraceRecorder();
+    TraceScope initializeScope(recorder, "transcription", "initialize");
     auto transcription = createTranscription();
     auto pointsForSparsityDetection =
             std::make_shared<std::vector<VariablesDM>>();
@@ -138,10 +164,225 @@ Solution Solver::solve(const Iterate& guess) const {
                             .variables);
         }
     }
+    std::string sparsityCachePrefix;
+    if (!m_sparsity_cache_directory.empty() &&
+            m_sparsity_detection != "none") {
+        // The initial guess is not part of the key, so the patterns detected
+        // from one initial guess are reused with other guesses.
+        const std::string key = hashToHexString(fmt::format(
+                "sparsity_detection {}\nrandom_count {}\n{}",
+                m_sparsity_detection, m_sparsity_detection_random_count,
+                m_problem.getStructureDescription()));
+        OpenSim::IO::makeDir(m_sparsity_cache_directory);
+        sparsityCachePrefix = m_sparsity_cache_directory + "/" + key + "_";
+    }
     m_problem.initialize(m_finite_difference_scheme,
             std::const_pointer_cast<const std::vector<VariablesDM>>(
-                    pointsForSparsityDetection));
+                    pointsForSparsityDetection),
+            std::move(sparsityCachePrefix));
+    initializeScope.finish();
     return transcription->solve(guess);
 }
 
+namespace {
+// Linearly interpolate the columns of `values`, one for each of `times`,
+// onto `newTimes`.
+casadi::DM interpolateColumns(const casadi::DM& times, const casadi::DM& values,
+        const std::vector<double>& newTimes) {
+    const auto numNewTimes = (casadi_int)newTimes.size();
+    casadi::DM result = casadi::DM::zeros(values.rows(), numNewTimes);
+    if (values.rows() == 0) return result;
+    const std::vector<double> t = casadi::DM::densify(times).nonzeros();
+    casadi_int k = 0;
+    for (casadi_int i = 0; i < numNewTimes; ++i) {
+        while (k + 2 < (casadi_int)t.size() && t[k + 1] <= newTimes[i]) ++k;
+        const double h = t[k + 1] - t[k];
+        const double s = h > 0 ? (newTimes[i] - t[k]) / h : 0;
+        result(casadi::Slice(), i) =
+                (1 - s) * values(casadi::Slice(), k) +
+                s * values(casadi::Slice(), k + 1);
+    }
+    return result;
+}
+
+// The local error of a mesh interval of length h is proportional to
+// h^order.
+double getLocalErrorOrder(const std::string& scheme) {
+    if (scheme == "trapezoidal") return 3;
+    if (scheme == "hermite-simpson") return 5;
+    const std::string radau = "legendre-gauss-radau-";
+    if (scheme.compare(0, radau.size(), radau) == 0) {
+        return 2 * std::stoi(scheme.substr(radau.size()));
+    }
+    const std::string gauss = "legendre-gauss-";
+    if (scheme.compare(0, gauss.size(), gauss) == 0) {
+        return 2 * std::stoi(scheme.substr(gauss.size())) + 1;
+    }
+    OPENSIM_THROW(Exception, "Unknown transcription scheme '{}'.", scheme);
+}
+} // anonymous namespace
+
+casadi::DM Solver::calcMeshIntervalErrors(const Iterate& iterate) const {
+    using casadi::DM;
+    using casadi::Slice;
+    const auto& vars = iterate.variables;
+    const auto getVariable = [&](Var var) {
+        const auto it = vars.find(var);
+        if (it != vars.end()) return it->second;
+        return DM::zeros(0, var == parameters ? 1 : iterate.times.numel());
+    };
+    const DM statesTraj = getVariable(states);
+    const DM controlsTraj = getVariable(controls);
+    const DM multipliersTraj = getVariable(multipliers);
+    const DM derivativesTraj = getVariable(derivatives);
+    const DM parametersValue = getVariable(parameters);
+    const double initialTime = vars.at(initial_time).scalar();
+    const double duration = vars.at(final_time).scalar() - initialTime;
+
+    const int NQ = m_problem.getNumCoordinates();
+    const int NU = m_problem.getNumSpeeds();
+    const int NS = m_problem.getNumStates();
+    const bool implicit = m_problem.isDynamicsModeImplicit();
+    const casadi::Function& multibodyFunc =
+            implicit ? m_problem.getImplicitMultibodySystemIgnoringConstraints()
+                     : m_problem.getMultibodySystemIgnoringConstraints();
+
+    // The state derivatives at the given times and states, with the other
+    // variables interpolated from the iterate.
+    const auto calcStateDerivatives = [&](const std::vector<double>& times,
+                                              const DM& statesAtTimes) {
+        const auto numTimes = (casadi_int)times.size();
+        const DM derivs =
+                interpolateColumns(iterate.times, derivativesTraj, times);
+        const casadi::DMVector in{DM(times).T(), statesAtTimes,
+                interpolateColumns(iterate.times, controlsTraj, times),
+                interpolateColumns(iterate.times, multipliersTraj, times),
+                derivs, DM::repmat(parametersValue, 1, numTimes)};
+        const casadi::DMVector out =
+                m_threadPool ? evalOnColumns(*m_threadPool, multibodyFunc, in,
+                                       (int)numTimes)
+                             : multibodyFunc.map(numTimes, m_parallelism,
+                                       m_numThreads)(in);
+        DM stateDerivatives = DM::zeros(NS, numTimes);
+        stateDerivatives(Slice(0, NQ), Slice()) =
+                statesAtTimes(Slice(NQ, NQ + NU), Slice());
+        stateDerivatives(Slice(NQ, NQ + NU), Slice()) =
+                implicit ? DM(derivs(Slice(0, NU), Slice())) : out.at(0);
+        stateDerivatives(Slice(NQ + NU, NS), Slice()) = out.at(1);
+        return stateDerivatives;
+    };
+
+    const int numMeshIntervals = (int)m_mesh.size() - 1;
+    std::vector<double> meshTimes;
+    for (const double meshPoint : m_mesh) {
+        meshTimes.push_back(initialTime + meshPoint * duration);
+    }
+    const DM statesMesh =
+            interpolateColumns(iterate.times, statesTraj, meshTimes);
+    const DM derivsMesh = calcStateDerivatives(meshTimes, statesMesh);
+
+    // The cubic Hermite interpolant of the states at 1/4, 1/2, and 3/4 of
+    // each mesh interval.
+    const int numInteriorPoints = 3;
+    std::vector<double> interiorTimes;
+    DM statesInterior = DM::zeros(NS, numInteriorPoints * numMeshIntervals);
+    for (int imesh = 0; imesh < numMeshIntervals; ++imesh) {
+        const double h = meshTimes[imesh + 1] - meshTimes[imesh];
+        const DM x0 = statesMesh(Slice(), imesh);
+        const DM x1 = statesMesh(Slice(), imesh + 1);
+        const DM f0 = derivsMesh(Slice(), imesh);
+        const DM f1 = derivsMesh(Slice(), imesh + 1);
+        for (int k = 0; k < numInteriorPoints; ++k) {
+            const double s = (k + 1) / double(numInteriorPoints + 1);
+            interiorTimes.push_back(meshTimes[imesh] + s * h);
+            statesInterior(Slice(), numInteriorPoints * imesh + k) =
+                    (2 * s * s * s - 3 * s * s + 1) * x0 +
+                    (s * s * s - 2 * s * s + s) * h * f0 +
+                    (-2 * s * s * s + 3 * s * s) * x1 +
+                    (s * s * s - s * s) * h * f1;
+        }
+    }
+    const DM derivsInterior =
+            calcStateDerivatives(interiorTimes, statesInterior);
+
+    // Errors are relative to the magnitude of each state.
+    std::vector<double> stateScales(NS, 1.0);
+    for (int istate = 0; istate < NS; ++istate) {
+        for (casadi_int itime = 0; itime < statesTraj.columns(); ++itime) {
+            stateScales[istate] = std::max(stateScales[istate],
+                    1 + std::abs(statesTraj(istate, itime).scalar()));
+        }
+    }
+
+    DM errors = DM::zeros(1, numMeshIntervals);
+    for (int imesh = 0; imesh < numMeshIntervals; ++imesh) {
+        const double h = meshTimes[imesh + 1] - meshTimes[imesh];
+        const int i = numInteriorPoints * imesh;
+        // Composite Simpson's rule on two halves of the interval.
+        const DM integral = h / 12 *
+                (derivsMesh(Slice(), imesh) + 4 * derivsInterior(Slice(), i) +
+                        2 * derivsInterior(Slice(), i + 1) +
+                        4 * derivsInterior(Slice(), i + 2) +
+                        derivsMesh(Slice(), imesh + 1));
+        const DM change =
+                statesMesh(Slice(), imesh + 1) - statesMesh(Slice(), imesh);
+        double error = 0;
+        for (int istate = 0; istate < NS; ++istate) {
+            error = std::max(error,
+                    std::abs(change(istate).scalar() -
+                             integral(istate).scalar()) /
+                            stateScales[istate]);
+        }
+        errors(imesh) = error;
+    }
+    return errors;
+}
+
+std::vector<double> Solver::createRefinedMesh(
+        const casadi::DM& errors, double tolerance) const {
+    const int numMeshIntervals = (int)m_mesh.size() - 1;
+    OPENSIM_THROW_IF(errors.numel() != numMeshIntervals, Exception,
+            "Expected {} mesh interval errors, but got {}.", numMeshIntervals,
+            errors.numel());
+    const double order = getLocalErrorOrder(m_transcriptionScheme);
+    const std::vector<double> error = casadi::DM::densify(errors).nonzeros();
+    std::vector<double> mesh{m_mesh[0]};
+    int imesh = 0;
+    while (imesh < numMeshIntervals) {
+        const double left = m_mesh[imesh];
+        const double right = m_mesh[imesh + 1];
+        if (error[imesh] > tolerance) {
+            // Split the interval into as many intervals as are required to
+            // meet the tolerance, but no more than 5, as the estimate is
+            // unreliable for coarse meshes.
+            const int numSplits = std::min(5, std::max(2,
+                    (int)std::ceil(std::pow(error[imesh] / tolerance,
+                            1.0 / order))));
+            for (int k = 1; k < numSplits; ++k) {
+                mesh.push_back(left + k * (right - left) / numSplits);
+            }
+            mesh.push_back(right);
+            ++imesh;
+            continue;
+        }
+        if (imesh + 1 < numMeshIntervals && error[imesh + 1] <= tolerance) {
+            // Merge two intervals if the merged interval would still meet the
+            // tolerance by a wide margin.
+            const double merged = m_mesh[imesh + 2] - left;
+            const double shortest =
+                    std::min(right - left, m_mesh[imesh + 2] - right);
+            if (std::max(error[imesh], error[imesh + 1]) *
+                            std::pow(merged / shortest, order) <
+                    0.1 * tolerance) {
+                mesh.push_back(m_mesh[imesh + 2]);
+                imesh += 2;
+                continue;
+            }
+        }
+        mesh.push_back(right);
+        ++imesh;
+    }
+    return mesh;
+}
+
 } // namespace CasOC
@@ -20,8 +20,11 @@
 
 #include "CasOCProblem.h"
 
+#include <memory>
+
 namespace OpenSim {
 class MocoCasADiSolver;
+class ThreadPool;
 } // namespace OpenSim
 
 namespace CasOC {
@@ -59,6 +62,11 @@ public:
     bool getScaleVariablesUsingBounds() const {
         return m_scaleVariablesUsingBounds;
     }
+    /// Scale the variables using their bounds or (if unbounded) the initial
+    /// guess, and the constraints using the constraint Jacobian at the
+    /// initial guess.
+    void setScaleAutomatically(bool value) { m_scaleAutomatically = value; }
+    bool getScaleAutomatically() const { return m_scaleAutomatically; }
     bool getMinimizeLagrangeMultipliers() const {
         return m_minimizeLagrangeMultipliers;
     }
@@ -146,6 +154,15 @@ public:
     }
 
     int getCallbackInterval() const { return m_callbackInterval; }
+    /// Pass the primal-dual iterate (the variables and the multipliers of the
+    /// bounds and constraints) and an estimate of the barrier parameter to
+    /// Problem::checkpointCallback() every `checkpointInterval` iterations
+    /// (0, the default, for never), so that an interrupted solve can be
+    /// resumed from it with setWarmStart().
+    void setCheckpointInterval(int checkpointInterval) {
+        m_checkpointInterval = checkpointInterval;
+    }
+    int getCheckpointInterval() const { return m_checkpointInterval; }
     /// "none" to use block sparsity (treat all CasOC::Function%s as dense;
     /// default), "initial-guess", or "random".
     void setSparsityDetection(const std::string& setting);
@@ -161,15 +178,82 @@ public:
     }
     std::string getWriteSparsity() const { return m_write_sparsity; }
 
+    /// If this is set to a non-empty string and sparsity detection is
+    /// enabled, the detected sparsity patterns are saved to files in this
+    /// directory (created if necessary), and later solves of problems with
+    /// the same structure (see Problem::getStructureDescription()) and
+    /// sparsity detection settings load the patterns from these files instead
+    /// of detecting them.
+    void setSparsityCacheDirectory(std::string directory) {
+        m_sparsity_cache_directory = std::move(directory);
+    }
+    const std::string& getSparsityCacheDirectory() const {
+        return m_sparsity_cache_directory;
+    }
+
+    /// If this is set to a non-empty string, the parts of the transcription
+    /// that do not invoke the problem's functions (the defects and the
+    /// interpolation of controls) are generated as C code, compiled into
+    /// shared libraries in this directory (created if necessary), and
+    /// evaluated from those libraries. The libraries are named after a hash of
+    /// the generated code, so later solves of problems with the same
+    /// structure and mesh load them instead of compiling them again.
+    void setCodegenDirectory(std::string directory) {
+        m_codegen_directory = std::move(directory);
+    }
+    const std::string& getCodegenDirectory() const {
+        return m_codegen_directory;
+    }
+    /// The command that compiles generated C code into a shared library; it
+    /// is followed by the source file and "-o" and the library file.
+    void setCodegenCompilerCommand(std::string command) {
+        m_codegen_compiler_command = std::move(command);
+    }
+    const std::string& getCodegenCompilerCommand() const {
+        return m_codegen_compiler_command;
+    }
+
     /// Use this to tell CasADi to evaluate differential-algebraic equations,
     /// path constraints, integrands, etc. in parallel across grid points.
     /// "parallelism" is passed on directly to
     /// the "parallelism" argument of casadi::MX::map(). CasADi supports
     /// "serial", "openmp", "thread", and perhaps some other options.
+    /// Additionally, "pool" evaluates the functions on an OpenSim::ThreadPool
+    /// whose (pinned) threads are created here and persist across all
+    /// evaluations, instead of on threads that CasADi creates for each
+    /// evaluation.
     void setParallelism(std::string parallelism, int numThreads);
     std::pair<std::string, int> getParallelism() const {
         return std::make_pair(m_parallelism, m_numThreads);
     }
+    /// Evaluate the CasOC::Function%s on the trajectory (multibody
+    /// dynamics, path constraints, integrands) for all of their points in
+    /// one call (see BatchFunction), and compute their Jacobians by
+    /// perturbing each group of inputs at all points together, rather than
+    /// evaluating each point separately through casadi::Function::map().
+    void setBatchEvaluation(bool batchEvaluation) {
+        m_batchEvaluation = batchEvaluation;
+    }
+    bool getBatchEvaluation() const { return m_batchEvaluation; }
+    /// The thread pool if the parallelism is "pool"; otherwise, null.
+    const std::shared_ptr<OpenSim::ThreadPool>& getThreadPool() const {
+        return m_threadPool;
+    }
+
+    /// Start the optimization solver from the multipliers of a previous
+    /// solve, in addition to the initial guess passed to solve(). With IPOPT,
+    /// this also enables IPOPT's warm-start options (warm_start_init_point
+    /// and small bound pushes) if the multipliers can be used.
+    void setWarmStart(WarmStart warmStart) {
+        m_warmStart = std::move(warmStart);
+        m_hasWarmStart = true;
+    }
+    void clearWarmStart() {
+        m_warmStart = WarmStart();
+        m_hasWarmStart = false;
+    }
+    bool hasWarmStart() const { return m_hasWarmStart; }
+    const WarmStart& getWarmStart() const { return m_warmStart; }
 
     void setPluginOptions(casadi::Dict opts) {
         m_pluginOptions = std::move(opts);
@@ -188,6 +272,25 @@ public:
 
     Solution solve(const Iterate& guess) const;
 
+    /// Estimate the local discretization error of each mesh interval of an
+    /// iterate on the current mesh (e.g., a solution returned by solve()),
+    /// as a row vector. The dynamics are integrated across each interval by
+    /// Simpson's rule on the cubic Hermite interpolant of the states at the
+    /// interval's endpoints, and the error is the largest difference between
+    /// the integral and the change of a state across the interval, relative
+    /// to 1 + the largest magnitude of that state. The interval is sampled at
+    /// 3 interior points, which are not collocation points of any of the
+    /// schemes, so the error is not 0 if the dynamics are satisfied only at
+    /// the collocation points. This must be called after solve().
+    casadi::DM calcMeshIntervalErrors(const Iterate& iterate) const;
+    /// Create a mesh in which the mesh intervals whose error (from
+    /// calcMeshIntervalErrors()) exceeds the tolerance are split into 2 to 5
+    /// intervals, depending on the error and the order of the transcription
+    /// scheme, and pairs of adjacent intervals whose error is far below the
+    /// tolerance are merged.
+    std::vector<double> createRefinedMesh(
+            const casadi::DM& errors, double tolerance) const;
+
 private:
     std::unique_ptr<Transcription> createTranscription() const;
 
@@ -195,6 +298,7 @@ private:
     std::vector<double> m_mesh;
     std::string m_transcriptionScheme = "hermite-simpson";
     bool m_scaleVariablesUsingBounds = false;
+    bool m_scaleAutomatically = false;
     bool m_minimizeLagrangeMultipliers = false;
     double m_lagrangeMultiplierWeight = 1.0;
     bool m_minimizeImplicitMultibodyAccelerations = false;
@@ -208,15 +312,28 @@ private:
     std::string m_finite_difference_scheme = "central";
     std::string m_sparsity_detection = "none";
     std::string m_write_sparsity;
+    std::string m_sparsity_cache_directory;
+    std::string m_codegen_directory;
+    std::string m_codegen_compiler_command = "cc -O2 -fPIC -shared";
     int m_callbackInterval = 0;
+    int m_checkpointInterval = 0;
     int m_sparsity_detection_random_count = 3;
     std::string m_parallelism = "serial";
     int m_numThreads = 1;
+    std::shared_ptr<OpenSim::ThreadPool> m_threadPool;
+    bool m_batchEvaluation = false;
     casadi::Dict m_pluginOptions;
     casadi::Dict m_solverOptions;
     std::string m_optimSolver;
+    WarmStart m_warmStart;
+    bool m_hasWarmStart = false;
 };
 
+/// A 64-bit FNV-1a hash of `str` as 16 hexadecimal digits. Unlike std::hash,
+/// this is the same on all platforms and in all runs, so it can name files
+/// that are reused across solves.
+std::string hashToHexString(const std::string& str);
+
 } // namespace CasOC
 
 #endif // OPENSIM_CASOCSOLVER_H
@@ -0,0 +1,207 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim: CasOCThreadPoolMap.cpp                                            *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+#include "CasOCThreadPoolMap.h"
+
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/Exception.h>
+#include <OpenSim/Common/ThreadPool.h>
+
+#include <algorithm>
+
+using namespace CasOC;
+
+namespace {
+    // The nonzeros of each of `args`, which have `numColumns` columns.
+    std::vector<std::vector<double>> getDenseNonzeros(const VectorDM& args) {
+        std::vector<std::vector<double>> nonzeros;
+        nonzeros.reserve(args.size());
+        for (const auto& arg : args) {
+            nonzeros.push_back(casadi::DM::densify(arg).nonzeros());
+        }
+        return nonzeros;
+    }
+
+    // Column `column` of each of the inputs of `function`.
+    VectorDM getColumn(const casadi::Function& function,
+            const std::vector<std::vector<double>>& args, int column) {
+        VectorDM in(args.size());
+        for (int i = 0; i < (int)args.size(); ++i) {
+            const casadi_int numRows = function.size1_in(i);
+            in[i] = casadi::DM::zeros(numRows, 1);
+            std::copy_n(args[i].begin() + column * numRows, numRows,
+                    in[i].ptr());
+        }
+        return in;
+    }
+}
+
+VectorDM CasOC::evalOnColumns(OpenSim::ThreadPool& pool,
+        const casadi::Function& function, const VectorDM& args,
+        int numColumns) {
+    OPENSIM_THROW_IF((casadi_int)args.size() != function.n_in(),
+            OpenSim::Exception, "Expected {} inputs, but got {}.",
+            function.n_in(), args.size());
+    const auto inputs = getDenseNonzeros(args);
+    VectorDM out(function.n_out());
+    std::vector<double*> outputs(out.size());
+    for (int o = 0; o < (int)out.size(); ++o) {
+        out[o] = casadi::DM::zeros(function.size1_out(o), numColumns);
+        outputs[o] = out[o].ptr();
+    }
+    pool.parallelForEach(numColumns, [&](int, int column) {
+        const VectorDM res = function(getColumn(function, inputs, column));
+        for (int o = 0; o < (int)res.size(); ++o) {
+            const casadi_int numRows = function.size1_out(o);
+            const std::vector<double> values =
+                    casadi::DM::densify(res[o]).nonzeros();
+            std::copy_n(values.begin(), numRows,
+                    outputs[o] + column * numRows);
+        }
+    });
+    return out;
+}
+
+ThreadPoolMap::~ThreadPoolMap() = default;
+
+void ThreadPoolMap::constructFunction(const casadi::Function& function,
+        int numColumns, OpenSim::ThreadPool& pool) {
+    // Empty inputs and outputs (e.g., the kinematic constraint errors of a
+    // model without constraints) are 0x0 rather than column vectors.
+    for (casadi_int i = 0; i < function.n_in(); ++i) {
+        OPENSIM_THROW_IF(function.size2_in(i) != 1 && function.numel_in(i),
+                OpenSim::Exception,
+                "Expected input {} of '{}' to be a column vector.", i,
+                function.name());
+    }
+    for (casadi_int i = 0; i < function.n_out(); ++i) {
+        OPENSIM_THROW_IF(function.size2_out(i) != 1 && function.numel_out(i),
+                OpenSim::Exception,
+                "Expected output {} of '{}' to be a column vector.", i,
+                function.name());
+    }
+    m_function = function;
+    m_numColumns = numColumns;
+    m_pool = &pool;
+    construct(fmt::format("pool_map{}_{}", numColumns, function.name()), {});
+}
+
+VectorDM ThreadPoolMap::eval(const VectorDM& args) const {
+    return evalOnColumns(*m_pool, m_function, args, m_numColumns);
+}
+
+casadi::Function ThreadPoolMap::get_jacobian(const std::string& name,
+        const std::vector<std::string>& inames,
+        const std::vector<std::string>& onames,
+        const casadi::Dict& opts) const {
+    m_jacobians.push_back(OpenSim::make_unique<ThreadPoolMapJacobian>());
+    m_jacobians.back()->constructFunction(*this, m_function.jacobian(),
+            m_numColumns, *m_pool, name, inames, onames, opts);
+    return *m_jacobians.back();
+}
+
+void ThreadPoolMapJacobian::constructFunction(const casadi::Function& map,
+        const casadi::Function& pointJacobian, int numColumns,
+        OpenSim::ThreadPool& pool, const std::string& name,
+        const std::vector<std::string>& inames,
+        const std::vector<std::string>& onames, casadi::Dict opts) {
+    m_pointJacobian = pointJacobian;
+    m_numColumns = numColumns;
+    m_pool = &pool;
+    m_inputNames = inames;
+    m_outputNames = onames;
+    m_inputSparsities.clear();
+    for (casadi_int i = 0; i < map.n_in(); ++i) {
+        m_inputSparsities.push_back(map.sparsity_in(i));
+    }
+    for (casadi_int i = 0; i < map.n_out(); ++i) {
+        m_inputSparsities.push_back(map.sparsity_out(i));
+    }
+
+    // The rows of the Jacobians are the stacked outputs, and the columns are
+    // the stacked inputs. The outputs and inputs of the map are those of the
+    // function at each column, one after the other.
+    const auto getOffsets = [](const std::vector<casadi_int>& sizes) {
+        std::vector<casadi_int> offsets(sizes.size() + 1, 0);
+        for (int i = 0; i < (int)sizes.size(); ++i) {
+            offsets[i + 1] = offsets[i] + sizes[i];
+        }
+        return offsets;
+    };
+    std::vector<casadi_int> outputSizes;
+    for (casadi_int i = 0; i < map.n_out(); ++i) {
+        outputSizes.push_back(map.size1_out(i));
+    }
+    std::vector<casadi_int> inputSizes;
+    for (casadi_int i = 0; i < map.n_in(); ++i) {
+        inputSizes.push_back(map.size1_in(i));
+    }
+    const auto outputOffsets = getOffsets(outputSizes);
+    const auto inputOffsets = getOffsets(inputSizes);
+    // The index of the map's row or column for a row or column of the
+    // Jacobian of the function at `column`.
+    const auto getMapIndex = [numColumns](
+            const std::vector<casadi_int>& offsets, casadi_int index,
+            int column) {
+        const auto block = std::upper_bound(offsets.begin(), offsets.end(),
+                                   index) -
+                           offsets.begin() - 1;
+        const casadi_int size = offsets[block + 1] - offsets[block];
+        return numColumns * offsets[block] + column * size +
+               (index - offsets[block]);
+    };
+
+    const casadi::Sparsity& pointSparsity = pointJacobian.sparsity_out(0);
+    std::vector<casadi_int> pointRows;
+    std::vector<casadi_int> pointColumns;
+    pointSparsity.get_triplet(pointRows, pointColumns);
+    std::vector<casadi_int> rows;
+    std::vector<casadi_int> columns;
+    rows.reserve(numColumns * pointRows.size());
+    columns.reserve(numColumns * pointRows.size());
+    for (int column = 0; column < numColumns; ++column) {
+        for (int j = 0; j < (int)pointRows.size(); ++j) {
+            rows.push_back(getMapIndex(outputOffsets, pointRows[j], column));
+            columns.push_back(
+                    getMapIndex(inputOffsets, pointColumns[j], column));
+        }
+    }
+    m_sparsity = casadi::Sparsity::triplet(numColumns * outputOffsets.back(),
+            numColumns * inputOffsets.back(), rows, columns);
+    m_nonzeroIndices = m_sparsity.get_nz(rows, columns);
+
+    // Second derivatives are computed with finite differences, as for the
+    // Jacobian of a CasOC::Function.
+    opts["enable_fd"] = true;
+    construct(name, opts);
+}
+
+VectorDM ThreadPoolMapJacobian::eval(const VectorDM& args) const {
+    const auto inputs = getDenseNonzeros(args);
+    casadi::DM jacobian(m_sparsity);
+    std::vector<double>& values = jacobian.nonzeros();
+    const casadi_int pointNumNonzeros = m_pointJacobian.sparsity_out(0).nnz();
+    m_pool->parallelForEach(m_numColumns, [&](int, int column) {
+        const casadi::DM pointJacobian =
+                m_pointJacobian(getColumn(m_pointJacobian, inputs, column))
+                        .at(0);
+        const std::vector<double>& pointValues = pointJacobian.nonzeros();
+        for (casadi_int j = 0; j < pointNumNonzeros; ++j) {
+            values[m_nonzeroIndices[column * pointNumNonzeros + j]] =
+                    pointValues[j];
+        }
+    });
+    return {jacobian};
+}
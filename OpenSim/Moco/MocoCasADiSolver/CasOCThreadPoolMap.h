@@ -0,0 +1,123 @@
+#ifndef OPENSIM_CASOCTHREADPOOLMAP_H
+#define OPENSIM_CASOCTHREADPOOLMAP_H
+/* -------------------------------------------------------------------------- *
+ * OpenSim: CasOCThreadPoolMap.h                                              *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <casadi/casadi.hpp>
+#include <memory>
+
+namespace OpenSim {
+class ThreadPool;
+} // namespace OpenSim
+
+namespace CasOC {
+
+using VectorDM = std::vector<casadi::DM>;
+
+/// Evaluate `function` at each of the `numColumns` columns of its inputs
+/// (each input has `numColumns` columns) on the threads of `pool`, and return
+/// its outputs, each with `numColumns` columns. The inputs and outputs of
+/// `function` must be dense column vectors.
+VectorDM evalOnColumns(OpenSim::ThreadPool& pool,
+        const casadi::Function& function, const VectorDM& args,
+        int numColumns);
+
+class ThreadPoolMapJacobian;
+
+/// The equivalent of function.map(numColumns, "thread", numThreads), whose
+/// evaluations are performed by a persistent OpenSim::ThreadPool instead of
+/// by threads that CasADi creates for each evaluation. The Jacobian is
+/// evaluated on the pool as well, from the Jacobian of the function at each
+/// column.
+class ThreadPoolMap : public casadi::Callback {
+public:
+    void constructFunction(const casadi::Function& function, int numColumns,
+            OpenSim::ThreadPool& pool);
+    casadi_int get_n_in() override { return m_function.n_in(); }
+    casadi_int get_n_out() override { return m_function.n_out(); }
+    std::string get_name_in(casadi_int i) override {
+        return m_function.name_in(i);
+    }
+    std::string get_name_out(casadi_int i) override {
+        return m_function.name_out(i);
+    }
+    casadi::Sparsity get_sparsity_in(casadi_int i) override {
+        return casadi::Sparsity::dense(m_function.size1_in(i), m_numColumns);
+    }
+    casadi::Sparsity get_sparsity_out(casadi_int i) override {
+        return casadi::Sparsity::dense(m_function.size1_out(i), m_numColumns);
+    }
+    VectorDM eval(const VectorDM& args) const override;
+    bool has_jacobian() const override { return true; }
+    casadi::Function get_jacobian(const std::string& name,
+            const std::vector<std::string>& inames,
+            const std::vector<std::string>& onames,
+            const casadi::Dict& opts) const override;
+
+    ~ThreadPoolMap();
+
+private:
+    casadi::Function m_function;
+    int m_numColumns = 0;
+    OpenSim::ThreadPool* m_pool = nullptr;
+    // CasADi refers to (but does not own) the Jacobian functions, which must
+    // therefore live as long as this function.
+    mutable std::vector<std::unique_ptr<ThreadPoolMapJacobian>> m_jacobians;
+};
+
+/// The Jacobian of a ThreadPoolMap with respect to all of its inputs, which
+/// is assembled from the Jacobians of the mapped function at each column
+/// (evaluated on the pool). Its inputs are the inputs of the map followed by
+/// the (nominal) outputs of the map.
+class ThreadPoolMapJacobian : public casadi::Callback {
+public:
+    void constructFunction(const casadi::Function& map,
+            const casadi::Function& pointJacobian, int numColumns,
+            OpenSim::ThreadPool& pool, const std::string& name,
+            const std::vector<std::string>& inames,
+            const std::vector<std::string>& onames, casadi::Dict opts);
+    casadi_int get_n_in() override { return (casadi_int)m_inputNames.size(); }
+    casadi_int get_n_out() override { return 1; }
+    std::string get_name_in(casadi_int i) override {
+        return m_inputNames.at(i);
+    }
+    std::string get_name_out(casadi_int i) override {
+        return m_outputNames.at(i);
+    }
+    casadi::Sparsity get_sparsity_in(casadi_int i) override {
+        return m_inputSparsities.at(i);
+    }
+    casadi::Sparsity get_sparsity_out(casadi_int) override {
+        return m_sparsity;
+    }
+    VectorDM eval(const VectorDM& args) const override;
+
+private:
+    casadi::Function m_pointJacobian;
+    int m_numColumns = 0;
+    OpenSim::ThreadPool* m_pool = nullptr;
+    std::vector<std::string> m_inputNames;
+    std::vector<std::string> m_outputNames;
+    std::vector<casadi::Sparsity> m_inputSparsities;
+    casadi::Sparsity m_sparsity;
+    // The index of the nonzero of the Jacobian for nonzero j of the Jacobian
+    // of the function at column k is m_nonzeroIndices[k * nnz + j].
+    std::vector<casadi_int> m_nonzeroIndices;
+};
+
+} // namespace CasOC
+
+#endif // OPENSIM_CASOCTHREADPOOLMAP_H
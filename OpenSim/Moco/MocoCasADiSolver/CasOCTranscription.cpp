@@ -17,10 +17,21 @@
  * -------------------------------------------------------------------------- */
 #include "CasOCTranscription.h"
 
+#include <OpenSim/Common/IO.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+
 using casadi::DM;
 using casadi::MX;
 using casadi::MXVector;
 using casadi::Slice;
+using TraceScope = OpenSim::TraceEventRecorder::Scope;
 
 namespace CasOC {
 
@@ -56,7 +67,41 @@ public:
             return casadi::Sparsity(0, 0);
         }
     }
+    /// Pass checkpoints to the problem every `interval` iterations (see
+    /// Solver::setCheckpointInterval()). The bounds are those of the scaled
+    /// variables and constraints passed to the NLP solver, which are the NLP
+    /// constraints divided by `constraintScaling`.
+    void enableCheckpoints(int interval, DM lowerBounds, DM upperBounds,
+            DM constraintLowerBounds, DM constraintUpperBounds,
+            DM constraintScaling) {
+        m_checkpointInterval = interval;
+        m_lowerBounds = std::move(lowerBounds);
+        m_upperBounds = std::move(upperBounds);
+        m_constraintLowerBounds = std::move(constraintLowerBounds);
+        m_constraintUpperBounds = std::move(constraintUpperBounds);
+        m_constraintScaling = std::move(constraintScaling);
+    }
+    /// Start timing the first iteration (see eval()).
+    void beginIterations() {
+        if (auto* recorder = m_problem.getTraceRecorder()) {
+            m_iterationStartTimeInNs = recorder->getTimeInNs();
+        }
+    }
     std::vector<DM> eval(const std::vector<DM>& args) const override {
+        if (auto* recorder = m_problem.getTraceRecorder()) {
+            // The time since the previous iteration (or beginIterations())
+            // includes the evaluations of the functions for this iteration.
+            // args.at(1) is the objective ("f").
+            const double objective = args.at(1).scalar();
+            const long long time = recorder->getTimeInNs();
+            recorder->recordComplete("solver", "iteration",
+                    m_iterationStartTimeInNs, time - m_iterationStartTimeInNs,
+                    {{"iteration", (double)evalCount},
+                            {"objective", objective}});
+            recorder->recordCounter("solver", "objective",
+                    {{"objective", objective}});
+            m_iterationStartTimeInNs = time;
+        }
         if (m_callbackInterval > 0 && evalCount % m_callbackInterval == 0) {
             Iterate iterate = m_problem.createIterate<Iterate>();
             iterate.variables = m_transcription.expandVariables(args.at(0));
@@ -66,18 +111,79 @@ public:
             iterate.iteration = evalCount;
             m_problem.intermediateCallbackWithIterate(iterate);
         }
+        if (m_checkpointInterval > 0 && evalCount % m_checkpointInterval == 0) {
+            writeCheckpoint(args);
+        }
         m_problem.intermediateCallback();
         ++evalCount;
         return {0};
     }
 
 private:
+    void writeCheckpoint(const std::vector<DM>& args) const {
+        // args are in the order of casadi::nlpsol_out().
+        const DM& x = args.at(0);
+        const DM& g = args.at(2);
+        const DM& lam_x = args.at(3);
+        const DM& lam_g = args.at(4);
+
+        Iterate iterate = m_problem.createIterate<Iterate>();
+        iterate.variables = m_transcription.unscaleVariables(
+                m_transcription.expandVariables(x));
+        iterate.times = m_transcription.createTimes(
+                iterate.variables[initial_time], iterate.variables[final_time]);
+        iterate.iteration = evalCount;
+
+        WarmStart warmStart;
+        warmStart.bound_multipliers = m_problem.createIterate<Iterate>();
+        warmStart.bound_multipliers.variables =
+                m_transcription.unscaleBoundMultipliers(
+                        m_transcription.expandVariables(lam_x));
+        warmStart.bound_multipliers.times = iterate.times;
+        warmStart.constraint_multipliers = lam_g * m_constraintScaling;
+
+        // IPOPT does not pass its barrier parameter to the callback, but
+        // IPOPT keeps the complementarity of each inequality (the product of
+        // its multiplier and its distance to the bound) close to the barrier
+        // parameter, so the average complementarity estimates it.
+        double complementarity = 0;
+        int numInequalities = 0;
+        const auto accumulate = [&](const DM& value, const DM& lower,
+                                        const DM& upper, const DM& lambda) {
+            for (casadi_int i = 0; i < value.numel(); ++i) {
+                const double lo = lower(i).scalar();
+                const double up = upper(i).scalar();
+                if (lo == up) continue;
+                // CasADi's multipliers are negative for lower bounds.
+                const double lam = lambda(i).scalar();
+                const double distance = lam < 0 ? value(i).scalar() - lo
+                                                : up - value(i).scalar();
+                if (std::isinf(distance)) continue;
+                complementarity += std::abs(lam * distance);
+                ++numInequalities;
+            }
+        };
+        accumulate(x, m_lowerBounds, m_upperBounds, lam_x);
+        accumulate(g, m_constraintLowerBounds, m_constraintUpperBounds, lam_g);
+        if (numInequalities) {
+            warmStart.barrier_parameter = complementarity / numInequalities;
+        }
+        m_problem.checkpointCallback(iterate, warmStart);
+    }
+
     const Transcription& m_transcription;
     const Problem& m_problem;
     casadi_int m_numVariables;
     casadi_int m_numConstraints;
     casadi_int m_callbackInterval;
+    int m_checkpointInterval = 0;
+    DM m_lowerBounds;
+    DM m_upperBounds;
+    DM m_constraintLowerBounds;
+    DM m_constraintUpperBounds;
+    DM m_constraintScaling;
     mutable int evalCount = 0;
+    mutable long long m_iterationStartTimeInNs = 0;
 };
 
 void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
@@ -188,6 +294,7 @@ void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
 
     initializeScalingDM(m_shift);
     initializeScalingDM(m_scale);
+    initializeScalingDM(m_scaleUsingGuess);
 
     setVariableBounds(initial_time, 0, 0, m_problem.getTimeInitialBounds());
     setVariableBounds(final_time, 0, 0, m_problem.getTimeFinalBounds());
@@ -272,6 +379,10 @@ void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
             ++ip;
         }
     }
+    createUnscaledVariables();
+}
+
+void Transcription::createUnscaledVariables() {
     m_unscaledVars = unscaleVariables(m_scaledVars);
 
     m_duration = m_unscaledVars[final_time] - m_unscaledVars[initial_time];
@@ -288,11 +399,66 @@ void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
                        m_numPathConstraintPoints);
 }
 
+void Transcription::scaleUnboundedVariablesUsingGuess(
+        const VariablesDM& guess) {
+    for (auto& kv : m_scale) {
+        const auto it = guess.find(kv.first);
+        if (it == guess.end() || it->second.rows() != kv.second.rows()) {
+            continue;
+        }
+        const DM& usingGuess = m_scaleUsingGuess.at(kv.first);
+        for (casadi_int i = 0; i < kv.second.rows(); ++i) {
+            if (usingGuess(i).scalar() == 0) continue;
+            double magnitude = 1;
+            for (casadi_int j = 0; j < it->second.columns(); ++j) {
+                const double value = std::abs(it->second(i, j).scalar());
+                if (std::isfinite(value)) {
+                    magnitude = std::max(magnitude, value);
+                }
+            }
+            kv.second(i) = magnitude;
+        }
+    }
+    createUnscaledVariables();
+}
+
+casadi::DM Transcription::calcConstraintScaling(const casadi::MX& x,
+        const casadi::MX& g, const casadi::DM& x0) const {
+    // Rows whose derivatives are much smaller or larger than 1 are scaled by
+    // at most 1e3, so that the scaling cannot hide (or dominate) a
+    // constraint whose derivatives happen to be nearly zero at the guess.
+    const double maxScale = 1e3;
+    casadi::Function jacobianFunc(
+            "constraint_jacobian", {x}, {MX::jacobian(g, x)});
+    const DM jacobian = jacobianFunc(std::vector<DM>{x0}).at(0);
+    const std::vector<casadi_int> row = jacobian.sparsity().get_row();
+    const std::vector<double>& values = jacobian.nonzeros();
+    std::vector<double> norms(g.numel(), 0);
+    for (int k = 0; k < (int)values.size(); ++k) {
+        if (std::isfinite(values[k])) {
+            norms[row[k]] = std::max(norms[row[k]], std::abs(values[k]));
+        }
+    }
+    DM scaling(casadi::Sparsity::dense(g.numel(), 1));
+    for (int i = 0; i < (int)norms.size(); ++i) {
+        scaling(i) = norms[i] == 0 ? 1
+                                   : std::min(maxScale,
+                                             std::max(1 / maxScale,
+                                                     1 / norms[i]));
+    }
+    return scaling;
+}
+
 void Transcription::transcribe() {
 
+    auto* recorder = m_problem.getTraceRecorder();
+
     // Cost.
     // =====
-    setObjectiveAndEndpointConstraints();
+    {
+        TraceScope scope(recorder, "transcription", "objective");
+        setObjectiveAndEndpointConstraints();
+    }
 
     // Compute DAEs at necessary grid points.
     // ======================================
@@ -448,7 +614,10 @@ void Transcription::transcribe() {
 
     // Calculate defects.
     // ------------------
-    calcDefects();
+    {
+        TraceScope scope(recorder, "transcription", "defects");
+        calcDefects();
+    }
 
     // Path constraints
     // ----------------
@@ -460,6 +629,7 @@ void Transcription::transcribe() {
     m_constraintsUpperBounds.path.resize(numPathConstraints);
     for (int ipc = 0; ipc < (int)m_constraints.path.size(); ++ipc) {
         const auto& info = m_problem.getPathConstraintInfos()[ipc];
+        TraceScope scope(recorder, "transcription", "path_constraint");
         const auto out = evalOnTrajectory(*info.function,
                 {states, controls, multipliers, derivatives},
                 m_pathConstraintIndices);
@@ -482,7 +652,10 @@ void Transcription::transcribe() {
     m_constraintsLowerBounds.interp_controls = boundsOnInterpControls;
     m_constraintsUpperBounds.interp_controls = boundsOnInterpControls;
 
-    calcInterpolatingControls();
+    {
+        TraceScope scope(recorder, "transcription", "interpolating_controls");
+        calcInterpolatingControls();
+    }
 }
 
 void Transcription::setObjectiveAndEndpointConstraints() {
@@ -536,6 +709,7 @@ void Transcription::setObjectiveAndEndpointConstraints() {
         }
 
         MXVector costOut;
+        m_evaluatedFunctions.push_back(info.endpoint_function.get());
         info.endpoint_function->call(
                 {m_unscaledVars[initial_time],
                         m_unscaledVars[states](Slice(), 0),
@@ -610,6 +784,7 @@ void Transcription::setObjectiveAndEndpointConstraints() {
         }
 
         MXVector endpointOut;
+        m_evaluatedFunctions.push_back(info.endpoint_function.get());
         info.endpoint_function->call(
                 {m_unscaledVars[initial_time],
                         m_unscaledVars[states](Slice(), 0),
@@ -631,56 +806,80 @@ void Transcription::setObjectiveAndEndpointConstraints() {
 }
 
 Solution Transcription::solve(const Iterate& guessOrig) {
+    auto* recorder = m_problem.getTraceRecorder();
 
     // Define the NLP.
     // ---------------
-    transcribe();
+    {
+        TraceScope scope(recorder, "transcription", "transcribe");
+        if (m_solver.getScaleAutomatically()) {
+            scaleUnboundedVariablesUsingGuess(guessOrig.variables);
+        }
+        transcribe();
+    }
+
+    // Detect the sparsity of the Jacobians of the functions in the NLP
+    // before CasADi requests them (one function at a time) while creating
+    // the NLP.
+    {
+        TraceScope scope(recorder, "transcription", "sparsity_detection");
+        Function::detectJacobianSparsity(m_evaluatedFunctions,
+                m_solver.getParallelism().second,
+                m_solver.getThreadPool().get());
+    }
 
     // Resample the guess.
     // -------------------
+    TraceScope createNlpScope(recorder, "transcription", "create_nlp");
     const auto guessTimes = createTimes(guessOrig.variables.at(initial_time),
             guessOrig.variables.at(final_time));
     auto guess = guessOrig.resample(guessTimes);
 
     // Adjust guesses for the slack variables to ensure they are the correct
     // length (i.e. slacks.size2() == m_numPointsIgnoringConstraints).
-    if (guess.variables.find(Var::slacks) != guess.variables.end()) {
-        auto& slacks = guess.variables.at(Var::slacks);
-
-        // If slack variables provided in the guess are equal to the grid
-        // length, remove the elements on the mesh points where the slack
-        // variables are not defined.
-        if (slacks.size2() == m_numGridPoints) {
-            casadi::DM meshIndices = createMeshIndices();
-            std::vector<casadi_int> slackColumnsToRemove;
-            for (int itime = 0; itime < m_numGridPoints; ++itime) {
-                if (meshIndices(itime).__nonzero__()) {
-                    slackColumnsToRemove.push_back(itime);
+    auto adjustSlacks = [this](Iterate& iterate) {
+        if (iterate.variables.find(Var::slacks) != iterate.variables.end()) {
+            auto& slacks = iterate.variables.at(Var::slacks);
+
+            // If slack variables provided in the guess are equal to the grid
+            // length, remove the elements on the mesh points where the slack
+            // variables are not defined.
+            if (slacks.size2() == m_numGridPoints) {
+                casadi::DM meshIndices = createMeshIndices();
+                std::vector<casadi_int> slackColumnsToRemove;
+                for (int itime = 0; itime < m_numGridPoints; ++itime) {
+                    if (meshIndices(itime).__nonzero__()) {
+                        slackColumnsToRemove.push_back(itime);
+                    }
                 }
+                // The first argument is an empty vector since we don't want to
+                // remove an entire row.
+                slacks.remove(std::vector<casadi_int>(), slackColumnsToRemove);
             }
-            // The first argument is an empty vector since we don't want to
-            // remove an entire row.
-            slacks.remove(std::vector<casadi_int>(), slackColumnsToRemove);
-        }
 
-        // Check that either that the slack variables provided in the guess
-        // are the correct length, or that the correct number of columns
-        // were removed.
-        OPENSIM_THROW_IF(slacks.size2() != m_numMeshInteriorPoints,
-                OpenSim::Exception,
-                "Expected slack variables to be length {}, but they are length "
-                "{}.",
-                m_numMeshInteriorPoints, slacks.size2());
+            // Check that either that the slack variables provided in the guess
+            // are the correct length, or that the correct number of columns
+            // were removed.
+            OPENSIM_THROW_IF(slacks.size2() != m_numMeshInteriorPoints,
+                    OpenSim::Exception,
+                    "Expected slack variables to be length {}, but they are "
+                    "length {}.",
+                    m_numMeshInteriorPoints, slacks.size2());
+        }
+    };
+    adjustSlacks(guess);
+
+    // The bound multipliers of a warm start are resampled like the guess.
+    const bool hasWarmStart = m_solver.hasWarmStart();
+    Iterate boundMultipliers;
+    if (hasWarmStart) {
+        boundMultipliers =
+                m_solver.getWarmStart().bound_multipliers.resample(guessTimes);
+        adjustSlacks(boundMultipliers);
     }
 
     // Create the CasADi NLP function.
     // -------------------------------
-    // Option handling is copied from casadi::OptiNode::solver().
-    casadi::Dict options = m_solver.getPluginOptions();
-    if (!options.empty()) {
-        options[m_solver.getOptimSolver()] = m_solver.getSolverOptions();
-    }
-
     auto x = flattenVariables(m_scaledVars);
     casadi_int numVariables = x.numel();
 
@@ -689,6 +888,45 @@ Solution Transcription::solve(const Iterate& guessOrig) {
     auto g = flattenConstraints(m_constraints);
     casadi_int numConstraints = g.numel();
 
+    // The NLP constraints are the constraints times these factors, and the
+    // NLP constraint multipliers are the multipliers divided by them.
+    const DM constraintScaling =
+            m_solver.getScaleAutomatically()
+                    ? calcConstraintScaling(x, g,
+                              flattenVariables(scaleVariables(guess.variables)))
+                    : DM::ones(numConstraints, 1);
+
+    // The constraint multipliers can only be reused if the constraints are
+    // the same (e.g., the mesh has not changed).
+    const bool useWarmStartMultipliers =
+            hasWarmStart &&
+            m_solver.getWarmStart().constraint_multipliers.numel() ==
+                    numConstraints;
+    casadi::Dict solverOptions = m_solver.getSolverOptions();
+    if (useWarmStartMultipliers && m_solver.getOptimSolver() == "ipopt") {
+        // Start from the provided multipliers, and keep the initial point
+        // close to the previous solution rather than pushing it into the
+        // interior of the bounds.
+        solverOptions["warm_start_init_point"] = "yes";
+        solverOptions["warm_start_bound_push"] = 1e-9;
+        solverOptions["warm_start_bound_frac"] = 1e-9;
+        solverOptions["warm_start_slack_bound_push"] = 1e-9;
+        solverOptions["warm_start_slack_bound_frac"] = 1e-9;
+        solverOptions["warm_start_mult_bound_push"] = 1e-9;
+        // Continue an unfinished solve (e.g., from a checkpoint) with its
+        // barrier parameter, rather than restarting the barrier method from
+        // the default mu_init, which would undo the progress of the
+        // iterations toward the solution. IPOPT requires mu_init > 0.
+        const double mu = m_solver.getWarmStart().barrier_parameter;
+        if (mu > 0) solverOptions["mu_init"] = std::max(mu, 1e-11);
+    }
+
+    // Option handling is copied from casadi::OptiNode::solver().
+    casadi::Dict options = m_solver.getPluginOptions();
+    if (!options.empty()) {
+        options[m_solver.getOptimSolver()] = solverOptions;
+    }
+
     NlpsolCallback callback(*this, m_problem, numVariables, numConstraints,
             m_solver.getCallbackInterval());
     options["iteration_callback"] = callback;
@@ -703,7 +941,7 @@ Solution Transcription::solve(const Iterate& guessOrig) {
         objective = 0;
     }
     nlp.emplace(std::make_pair("f", objective));
-    nlp.emplace(std::make_pair("g", g));
+    nlp.emplace(std::make_pair("g", g * constraintScaling));
     if (!m_solver.getWriteSparsity().empty()) {
         const auto prefix = m_solver.getWriteSparsity();
         auto gradient = casadi::MX::gradient(nlp["f"], nlp["x"]);
@@ -723,16 +961,51 @@ Solution Transcription::solve(const Iterate& guessOrig) {
     }
     const casadi::Function nlpFunc =
             casadi::nlpsol("nlp", m_solver.getOptimSolver(), nlp, options);
+    createNlpScope.finish();
 
     // Run the optimization (evaluate the CasADi NLP function).
     // --------------------------------------------------------
     // The inputs and outputs of nlpFunc are numeric (casadi::DM).
-    const casadi::DMDict nlpResult = nlpFunc(casadi::DMDict{
-                    {"x0", flattenVariables(scaleVariables(guess.variables))},
-                    {"lbx", flattenVariables(scaleVariables(m_lowerBounds))},
-                    {"ubx", flattenVariables(scaleVariables(m_upperBounds))},
-                    {"lbg", flattenConstraints(m_constraintsLowerBounds)},
-                    {"ubg", flattenConstraints(m_constraintsUpperBounds)}});
+    TraceScope nlpsolScope(recorder, "solver", "nlpsol");
+    casadi::DMDict nlpArgs{
+            {"x0", flattenVariables(scaleVariables(guess.variables))},
+            {"lbx", flattenVariables(scaleVariables(m_lowerBounds))},
+            {"ubx", flattenVariables(scaleVariables(m_upperBounds))},
+            {"lbg", flattenConstraints(m_constraintsLowerBounds) *
+                            constraintScaling},
+            {"ubg", flattenConstraints(m_constraintsUpperBounds) *
+                            constraintScaling}};
+    if (m_solver.getCheckpointInterval() > 0) {
+        callback.enableCheckpoints(m_solver.getCheckpointInterval(),
+                nlpArgs.at("lbx"), nlpArgs.at("ubx"), nlpArgs.at("lbg"),
+                nlpArgs.at("ubg"), constraintScaling);
+    }
+    callback.beginIterations();
+    if (useWarmStartMultipliers) {
+        nlpArgs["lam_x0"] = flattenVariables(
+                scaleBoundMultipliers(boundMultipliers.variables));
+        nlpArgs["lam_g0"] = m_solver.getWarmStart().constraint_multipliers /
+                            constraintScaling;
+    }
+    const casadi::DMDict nlpResult = nlpFunc(nlpArgs);
+    // The solver's own breakdown of its time and calls (e.g., t_wall_nlp_jac_g
+    // and n_call_nlp_jac_g for the constraint Jacobian, including finite
+    // differences, and t_wall_total), from which the time spent in the
+    // solver itself (e.g., in IPOPT's linear algebra) can be deduced.
+    for (const auto& stat : nlpFunc.stats()) {
+        if (stat.first.compare(0, 7, "t_wall_") != 0 &&
+                stat.first.compare(0, 7, "n_call_") != 0) {
+            continue;
+        }
+        if (stat.second.is_double()) {
+            nlpsolScope.addArgument(stat.first, stat.second.to_double());
+        } else if (stat.second.is_int()) {
+            nlpsolScope.addArgument(stat.first, (double)stat.second.to_int());
+        }
+    }
+    nlpsolScope.finish();
+
+    TraceScope postprocessScope(recorder, "transcription", "postprocess");
 
     // Create a CasOC::Solution.
     // -------------------------
@@ -740,6 +1013,10 @@ Solution Transcription::solve(const Iterate& guessOrig) {
     const auto finalVariables = nlpResult.at("x");
     solution.variables = unscaleVariables(expandVariables(finalVariables));
     solution.objective = nlpResult.at("f").scalar();
+    solution.bound_multipliers =
+            unscaleBoundMultipliers(expandVariables(nlpResult.at("lam_x")));
+    solution.constraint_multipliers =
+            nlpResult.at("lam_g") * constraintScaling;
 
     casadi::DMVector finalVarsDMV{finalVariables};
     casadi::Function objectiveFunc("objective", {x}, {m_objectiveTerms});
@@ -1229,9 +1506,25 @@ Iterate Transcription::createRandomIterateWithinBounds(
 casadi::MXVector Transcription::evalOnTrajectory(
         const casadi::Function& pointFunction, const std::vector<Var>& inputs,
         const casadi::Matrix<casadi_int>& timeIndices) const {
-    auto parallelism = m_solver.getParallelism();
-    const auto trajFunc = pointFunction.map(
-            timeIndices.size2(), parallelism.first, parallelism.second);
+    casadi::Function trajFunc;
+    const auto* function = dynamic_cast<const Function*>(&pointFunction);
+    if (function) m_evaluatedFunctions.push_back(function);
+    if (m_solver.getBatchEvaluation() && function) {
+        m_batchFunctions.push_back(OpenSim::make_unique<BatchFunction>());
+        m_batchFunctions.back()->constructFunction(*function,
+                (int)timeIndices.size2(), m_solver.getParallelism().second,
+                m_solver.getThreadPool().get());
+        trajFunc = *m_batchFunctions.back();
+    } else if (const auto& pool = m_solver.getThreadPool()) {
+        m_threadPoolMaps.push_back(OpenSim::make_unique<ThreadPoolMap>());
+        m_threadPoolMaps.back()->constructFunction(
+                pointFunction, (int)timeIndices.size2(), *pool);
+        trajFunc = *m_threadPoolMaps.back();
+    } else {
+        auto parallelism = m_solver.getParallelism();
+        trajFunc = pointFunction.map(
+                timeIndices.size2(), parallelism.first, parallelism.second);
+    }
 
     // Assemble input.
     // Add 1 for time input and 1 for parameters input.
@@ -1276,4 +1569,123 @@ casadi::MXVector Transcription::evalOnTrajectory(
     }*/
 }
 
+casadi::MX Transcription::evalOnMeshIntervals(
+        const casadi::Function& intervalDefects, const casadi::MX& x,
+        const casadi::MX& xdot) const {
+    const int numPoints = (m_numGridPoints - 1) / m_numMeshIntervals;
+    const int end = numPoints * m_numMeshIntervals;
+    const Slice meshStarts(0, end, numPoints);
+    const Slice meshEnds(numPoints, end + 1, numPoints);
+    const MX h = MX::reshape(m_times(meshEnds) - m_times(meshStarts), 1,
+            m_numMeshIntervals);
+    // The map splits the inputs into blocks of columns, one block per mesh
+    // interval. It replaces the slices and products of each interval with a
+    // single node, which is faster to evaluate and to differentiate. The
+    // defects are cheap compared to the dynamics, so the map is serial.
+    const casadi::Function mapped = intervalDefects.map(m_numMeshIntervals);
+    return MX::densify(mapped(std::vector<MX>{x(Slice(), Slice(0, end)),
+            xdot(Slice(), Slice(0, end)), x(Slice(), meshEnds),
+            xdot(Slice(), meshEnds), h}).at(0));
+}
+
+casadi::MX Transcription::evalAlgebra(const std::string& name,
+        const std::vector<casadi::MX>& inputs,
+        const casadi::Sparsity& outputSparsity,
+        const std::function<void(const std::vector<casadi::MX>&, casadi::MX&)>&
+                calc) {
+    MX output(outputSparsity);
+    if (m_solver.getCodegenDirectory().empty() || !output.numel()) {
+        calc(inputs, output);
+        return output;
+    }
+
+    TraceScope scope(m_problem.getTraceRecorder(), "transcription",
+            "compile_" + name);
+    std::vector<MX> symbols;
+    std::vector<MX> args;
+    for (int i = 0; i < (int)inputs.size(); ++i) {
+        symbols.push_back(
+                MX::sym(fmt::format("in{}", i), inputs[i].sparsity()));
+        args.push_back(inputs[i]);
+    }
+    // The implementation uses the times of the grid, which depend on the
+    // initial and final time variables.
+    const MX times = m_times;
+    m_times = MX::sym("times", times.sparsity());
+    symbols.push_back(m_times);
+    args.push_back(times);
+    calc(std::vector<MX>(symbols.begin(), symbols.end() - 1), output);
+    m_times = times;
+
+    // Expanding the function into scalar operations produces compact code.
+    const casadi::Function function =
+            casadi::Function(name, symbols, {output}).expand();
+    return compileFunction(function)(args).at(0);
+}
+
+casadi::Function Transcription::compileFunction(
+        const casadi::Function& function) const {
+#if defined(_WIN32)
+    const std::string libraryExtension = ".dll";
+#elif defined(__APPLE__)
+    const std::string libraryExtension = ".dylib";
+#else
+    const std::string libraryExtension = ".so";
+#endif
+    const std::string& directory = m_solver.getCodegenDirectory();
+    OpenSim::IO::makeDir(directory);
+
+    // CasADi looks for the derivatives of an external function under these
+    // names.
+    const casadi::Function jacobian = function.jacobian();
+    casadi::CodeGenerator generator(function.name());
+    generator.add(function);
+    generator.add(jacobian);
+    generator.add(jacobian.jacobian());
+    // Generate the code under a temporary name (concurrent solves may share
+    // the directory), and name the library after the contents of the code.
+    const std::string prefix = fmt::format(
+            "{}/tmp{:08x}_", directory, std::random_device()());
+    const std::string tempSourceFile = generator.generate(prefix);
+    std::string code;
+    {
+        std::ifstream file(tempSourceFile);
+        OPENSIM_THROW_IF(!file.good(), OpenSim::Exception,
+                "Could not read the generated code '{}'.", tempSourceFile);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        code = contents.str();
+    }
+    const std::string base = fmt::format("{}/{}_{}", directory,
+            function.name(), hashToHexString(code));
+    const std::string library = base + libraryExtension;
+
+    if (!OpenSim::IO::FileExists(library)) {
+        const std::string sourceFile = base + ".c";
+        std::remove(sourceFile.c_str());
+        std::rename(tempSourceFile.c_str(), sourceFile.c_str());
+        // Compile under a temporary name so that concurrent solves never
+        // load a partially-written library.
+        const std::string tempLibrary = prefix + function.name() +
+                                        libraryExtension;
+        const std::string command = fmt::format("{} \"{}\" -o \"{}\"",
+                m_solver.getCodegenCompilerCommand(), sourceFile, tempLibrary);
+        OpenSim::log_info("Compiling '{}': {}", function.name(), command);
+        const int status = std::system(command.c_str());
+        OPENSIM_THROW_IF(status != 0, OpenSim::Exception,
+                "Compiling the generated code '{}' failed (status {}) with "
+                "the command '{}'.",
+                sourceFile, status, command);
+        std::remove(library.c_str());
+        OPENSIM_THROW_IF(
+                std::rename(tempLibrary.c_str(), library.c_str()) != 0,
+                OpenSim::Exception, "Could not create the library '{}'.",
+                library);
+    } else {
+        std::remove(tempSourceFile.c_str());
+        OpenSim::log_debug("Loading '{}' from '{}'.", function.name(), library);
+    }
+    return casadi::external(function.name(), library);
+}
+
 } // namespace CasOC
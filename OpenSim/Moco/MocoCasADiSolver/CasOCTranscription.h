@@ -19,6 +19,9 @@
  * -------------------------------------------------------------------------- */
 
 #include "CasOCSolver.h"
+#include "CasOCThreadPoolMap.h"
+
+#include <functional>
 
 namespace CasOC {
 
@@ -81,6 +84,16 @@ protected:
             const std::vector<Var>& inputs,
             const casadi::Matrix<casadi_int>& timeIndices) const;
 
+    /// Evaluate the defects of each mesh interval with a map() of
+    /// `intervalDefects`, and return them with one column per mesh interval.
+    /// The inputs of `intervalDefects` are the states and state derivatives
+    /// at the grid points of a mesh interval up to (excluding) its last grid
+    /// point (each with one column per point), the states and state
+    /// derivatives at the last grid point, and the duration of the interval.
+    /// The mesh intervals must have the same number of grid points.
+    casadi::MX evalOnMeshIntervals(const casadi::Function& intervalDefects,
+            const casadi::MX& x, const casadi::MX& xdot) const;
+
     template <typename TRow, typename TColumn>
     void setVariableBounds(Var var, const TRow& rowIndices,
             const TColumn& columnIndices, const Bounds& bounds) {
@@ -99,7 +112,9 @@ protected:
     template <typename TRow, typename TColumn>
     void setVariableScaling(Var key, const TRow& rowIndices,
         const TColumn& columnIndices, const Bounds& bounds) {
-        if (m_solver.getScaleVariablesUsingBounds()) {
+        m_scaleUsingGuess.at(key)(rowIndices, columnIndices) = 0;
+        if (m_solver.getScaleVariablesUsingBounds() ||
+                m_solver.getScaleAutomatically()) {
             const auto& lower = bounds.lower;
             const auto& upper = bounds.upper;
             double dilate = upper - lower;
@@ -107,6 +122,10 @@ protected:
             if (std::isinf(dilate) || std::isnan(dilate)) {
                 dilate = 1;
                 shift = 0;
+                // See scaleUnboundedVariablesUsingGuess().
+                if (m_solver.getScaleAutomatically()) {
+                    m_scaleUsingGuess.at(key)(rowIndices, columnIndices) = 1;
+                }
             } else if (dilate == 0) {
                 dilate = 1;
                 shift = upper;
@@ -165,6 +184,8 @@ private:
     VariablesDM m_upperBounds;
     VariablesDM m_shift;
     VariablesDM m_scale;
+    // 1 for the (unbounded) variables that are scaled using the guess.
+    VariablesDM m_scaleUsingGuess;
 
     casadi::DM m_meshIndicesMap;
     casadi::Matrix<casadi_int> m_gridIndices;
@@ -181,6 +202,17 @@ private:
     Constraints<casadi::DM> m_constraintsLowerBounds;
     Constraints<casadi::DM> m_constraintsUpperBounds;
 
+    // The maps created by evalOnTrajectory() if the solver uses a thread
+    // pool; the NLP refers to them, so they must live as long as this
+    // transcription.
+    mutable std::vector<std::unique_ptr<ThreadPoolMap>> m_threadPoolMaps;
+    // The functions created by evalOnTrajectory() if the solver uses batch
+    // evaluation.
+    mutable std::vector<std::unique_ptr<BatchFunction>> m_batchFunctions;
+    // The CasOC::Function%s that the NLP evaluates, whose Jacobian sparsity
+    // solve() detects before creating the NLP.
+    mutable std::vector<const Function*> m_evaluatedFunctions;
+
 private:
     /// Override this function in your derived class to compute a vector of
     /// quadrature coeffecients (of length m_numGridPoints) required to set the
@@ -201,16 +233,51 @@ private:
                 "Must provide constraints for interpolating controls.")
     }
 
+    /// Create the unscaled variables (and the times and parameter
+    /// trajectories) from the scaled variables using m_shift and m_scale.
+    void createUnscaledVariables();
+    /// For scale_automatically, scale each unbounded variable by the largest
+    /// magnitude of its guess (if greater than 1).
+    void scaleUnboundedVariablesUsingGuess(const VariablesDM& guess);
+    /// For scale_automatically, the factor by which each constraint is
+    /// multiplied: the reciprocal of the infinity norm of its row of the
+    /// constraint Jacobian at the (scaled) guess `x0`.
+    casadi::DM calcConstraintScaling(const casadi::MX& x, const casadi::MX& g,
+            const casadi::DM& x0) const;
     void transcribe();
     void setObjectiveAndEndpointConstraints();
     void calcDefects() {
-        calcDefectsImpl(
-                m_unscaledVars.at(states), m_xdot, m_constraints.defects);
+        m_constraints.defects = evalAlgebra("transcription_defects",
+                {m_unscaledVars.at(states), m_xdot},
+                m_constraints.defects.sparsity(),
+                [this](const std::vector<casadi::MX>& in, casadi::MX& out) {
+                    calcDefectsImpl(in[0], in[1], out);
+                });
     }
     void calcInterpolatingControls() {
-        calcInterpolatingControlsImpl(
-                m_unscaledVars.at(controls), m_constraints.interp_controls);
+        m_constraints.interp_controls = evalAlgebra(
+                "transcription_interpolating_controls",
+                {m_unscaledVars.at(controls)},
+                m_constraints.interp_controls.sparsity(),
+                [this](const std::vector<casadi::MX>& in, casadi::MX& out) {
+                    calcInterpolatingControlsImpl(in[0], out);
+                });
     }
+    /// Compute an expression with the given sparsity from `inputs` with
+    /// `calc`, which may also use m_times. If Solver::getCodegenDirectory()
+    /// is set, `calc` is applied to symbols instead, and the result is an
+    /// evaluation of the function of these symbols (and m_times), compiled
+    /// by compileFunction().
+    casadi::MX evalAlgebra(const std::string& name,
+            const std::vector<casadi::MX>& inputs,
+            const casadi::Sparsity& outputSparsity,
+            const std::function<void(const std::vector<casadi::MX>&,
+                    casadi::MX&)>& calc);
+    /// Generate C code for `function` and its first and second derivatives,
+    /// compile it into a shared library in Solver::getCodegenDirectory(),
+    /// and return the function from the library. A library from a previous
+    /// solve is reused if the generated code is the same.
+    casadi::Function compileFunction(const casadi::Function& function) const;
 
     /// Use this function to ensure you iterate through variables in the same
     /// order.
@@ -249,7 +316,7 @@ private:
 
     /// unscaled = (upper - lower) * scaled - 0.5 * (upper + lower);
     template <typename T>
-    Variables<T> unscaleVariables(const Variables<T>& scaledVars) {
+    Variables<T> unscaleVariables(const Variables<T>& scaledVars) const {
         using casadi::DM;
         Variables<T> out;
 
@@ -287,6 +354,25 @@ private:
         return out;
     }
 
+    /// The multipliers of the bounds on the scaled variables are those of the
+    /// unscaled variables times the scale.
+    VariablesDM scaleBoundMultipliers(const VariablesDM& unscaled) const {
+        VariablesDM out;
+        for (const auto& kv : unscaled) {
+            out[kv.first] = kv.second * casadi::DM::repmat(m_scale.at(kv.first),
+                                                1, kv.second.columns());
+        }
+        return out;
+    }
+    VariablesDM unscaleBoundMultipliers(const VariablesDM& scaled) const {
+        VariablesDM out;
+        for (const auto& kv : scaled) {
+            out[kv.first] = kv.second / casadi::DM::repmat(m_scale.at(kv.first),
+                                                1, kv.second.columns());
+        }
+        return out;
+    }
+
     /// Flatten the constraints into a row vector, keeping constraints
     /// grouped together by time. Organizing the sparsity of the Jacobian
     /// this way might have benefits for sparse linear algebra.
@@ -19,6 +19,7 @@
 
 using casadi::DM;
 using casadi::MX;
+using casadi::SX;
 using casadi::Slice;
 
 namespace CasOC {
@@ -43,19 +44,24 @@ DM Trapezoidal::createMeshIndicesImpl() const {
 void Trapezoidal::calcDefectsImpl(
         const casadi::MX& x, const casadi::MX& xdot, casadi::MX& defects) const {
 
-    // We have arranged the code this way so that all constraints at a given
-    // mesh point are grouped together (organizing the sparsity of the Jacobian
-    // this way might have benefits for sparse linear algebra).
-    for (int itime = 0; itime < m_numMeshIntervals; ++itime) {
-        const auto h = m_times(itime + 1) - m_times(itime);
-        const auto x_i = x(Slice(), itime);
-        const auto x_ip1 = x(Slice(), itime + 1);
-        const auto xdot_i = xdot(Slice(), itime);
-        const auto xdot_ip1 = xdot(Slice(), itime + 1);
-
-        // Trapezoidal defects.
-        defects(Slice(), itime) = x_ip1 - (x_i + 0.5 * h * (xdot_ip1 + xdot_i));
-    }
+    // All constraints at a given mesh point are grouped together (organizing
+    // the sparsity of the Jacobian this way might have benefits for sparse
+    // linear algebra).
+    const int NS = m_problem.getNumStates();
+    const SX x_i = SX::sym("x_i", NS);
+    const SX xdot_i = SX::sym("xdot_i", NS);
+    const SX x_ip1 = SX::sym("x_ip1", NS);
+    const SX xdot_ip1 = SX::sym("xdot_ip1", NS);
+    const SX h = SX::sym("h");
+
+    // Trapezoidal defects.
+    const SX trapezoidal = x_ip1 - (x_i + 0.5 * h * (xdot_ip1 + xdot_i));
+
+    defects = evalOnMeshIntervals(
+            casadi::Function("trapezoidal_defects",
+                    std::vector<SX>{x_i, xdot_i, x_ip1, xdot_ip1, h},
+                    std::vector<SX>{trapezoidal}),
+            x, xdot);
 }
 
 } // namespace CasOC
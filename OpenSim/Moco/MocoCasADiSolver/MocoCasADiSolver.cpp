@@ -19,14 +19,18 @@
 #include "MocoCasADiSolver.h"
 
 #include <OpenSim/Common/Assertion.h>
+#include <OpenSim/Common/OSBFileAdapter.h>
 #include <OpenSim/Moco/MocoUtilities.h>
 
+#include <cstdio>
+
 #ifdef OPENSIM_WITH_CASADI
     #include "CasOCSolver.h"
     #include "MocoCasOCProblem.h"
     #include <casadi/casadi.hpp>
 
     #include <OpenSim/Common/Stopwatch.h>
+    #include <OpenSim/Common/TraceEventRecorder.h>
 
     using casadi::Callback;
     using casadi::Dict;
@@ -38,16 +42,83 @@
 
 using namespace OpenSim;
 
+namespace {
+std::string getCheckpointFilePath(
+        const std::string& prefix, const std::string& part) {
+    return prefix + "_" + part + ".osb";
+}
+} // anonymous namespace
+
+MocoCasADiWarmStart::MocoCasADiWarmStart(const std::string& prefix)
+        : m_iterate(getCheckpointFilePath(prefix, "iterate")),
+          m_boundMultipliers(
+                  getCheckpointFilePath(prefix, "bound_multipliers")) {
+    const std::string constraintsFile =
+            getCheckpointFilePath(prefix, "constraint_multipliers");
+    const TimeSeriesTable constraints = OSBFileAdapter::readColumns(
+            constraintsFile, {"constraint_multipliers"});
+    m_constraintMultipliers =
+            constraints.getDependentColumn("constraint_multipliers");
+    OPENSIM_THROW_IF(!constraints.hasTableMetaDataKey("barrier_parameter"),
+            Exception, "Expected the file '{}' to contain the barrier "
+            "parameter.", constraintsFile);
+    SimTK::convertStringTo(
+            constraints.getTableMetaData<std::string>("barrier_parameter"),
+            m_barrierParameter);
+}
+
+void MocoCasADiWarmStart::write(const std::string& prefix) const {
+    const std::vector<std::string> parts{
+            "iterate", "bound_multipliers", "constraint_multipliers"};
+    const auto getTempFilePath = [&](const std::string& part) {
+        return getCheckpointFilePath(prefix, part) + ".tmp";
+    };
+    m_iterate.write(getTempFilePath(parts[0]));
+    m_boundMultipliers.write(getTempFilePath(parts[1]));
+
+    const int numConstraints = m_constraintMultipliers.size();
+    std::vector<double> indices(numConstraints);
+    for (int i = 0; i < numConstraints; ++i) indices[i] = i;
+    SimTK::Matrix multipliers(numConstraints, 1);
+    for (int i = 0; i < numConstraints; ++i) {
+        multipliers(i, 0) = m_constraintMultipliers[i];
+    }
+    TimeSeriesTable constraints(
+            indices, multipliers, {"constraint_multipliers"});
+    constraints.updTableMetaData().setValueForKey("barrier_parameter",
+            fmt::format("{:.17g}", m_barrierParameter));
+    OSBFileAdapter::write(constraints, getTempFilePath(parts[2]));
+
+    for (const auto& part : parts) {
+        const std::string path = getCheckpointFilePath(prefix, part);
+        // std::rename() does not replace an existing file on all platforms.
+        std::remove(path.c_str());
+        OPENSIM_THROW_IF(
+                std::rename(getTempFilePath(part).c_str(), path.c_str()),
+                Exception, "Could not write the checkpoint file '{}'.", path);
+    }
+}
+
 MocoCasADiSolver::MocoCasADiSolver() { constructProperties(); }
 
 void MocoCasADiSolver::constructProperties() {
     constructProperty_scale_variables_using_bounds(false);
+    constructProperty_scale_automatically(false);
     constructProperty_parameters_require_initsystem(true);
     constructProperty_optim_sparsity_detection("none");
+    constructProperty_optim_sparsity_detection_random_count(3);
     constructProperty_optim_write_sparsity("");
+    constructProperty_optim_sparsity_cache_directory("");
+    constructProperty_optim_batch_evaluation(false);
+    constructProperty_codegen_directory("");
+    constructProperty_codegen_compiler_command("cc -O2 -fPIC -shared");
     constructProperty_optim_finite_difference_scheme("central");
-    constructProperty_parallel();
+    constructProperty_mesh_refinement_tolerance(-1);
+    constructProperty_mesh_refinement_max_iterations(5);
+    constructProperty_parallel_thread_pool(false);
     constructProperty_output_interval(0);
+    constructProperty_checkpoint_interval(0);
+    constructProperty_checkpoint_file("MocoCasADiSolver_checkpoint");
 
     constructProperty_minimize_implicit_multibody_accelerations(false);
     constructProperty_implicit_multibody_accelerations_weight(1.0);
@@ -104,6 +175,11 @@ void MocoCasADiSolver::setGuessFile(const std::string& file) {
     set_guess_file(file);
 }
 
+void MocoCasADiSolver::setWarmStart(MocoCasADiWarmStart warmStart) {
+    if (!warmStart.empty()) checkGuess(warmStart.getIterate());
+    m_warmStart = std::move(warmStart);
+}
+
 void MocoCasADiSolver::checkGuess(const MocoTrajectory& guess) const {
     OPENSIM_THROW_IF(get_multibody_dynamics_mode() == "implicit" &&
             guess.hasCoordinateStates() &&
@@ -148,21 +224,7 @@ const MocoTrajectory& MocoCasADiSolver::getGuess() const {
 std::unique_ptr<MocoCasOCProblem> MocoCasADiSolver::createCasOCProblem() const {
 #ifdef OPENSIM_WITH_CASADI
     const auto& problemRep = getProblemRep();
-    int parallel = 1;
-    int parallelEV = getMocoParallelEnvironmentVariable();
-    if (getProperty_parallel().size()) {
-        parallel = get_parallel();
-    } else if (parallelEV != -1) {
-        parallel = parallelEV;
-    }
-    int numThreads;
-    if (parallel == 0) {
-        numThreads = 1;
-    } else if (parallel == 1) {
-        numThreads = std::thread::hardware_concurrency();
-    } else {
-        numThreads = parallel;
-    }
+    const int numThreads = getNumParallelThreads();
 
     checkPropertyValueIsInSet(
             getProperty_multibody_dynamics_mode(), {"explicit", "implicit"});
@@ -256,6 +318,20 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
         }
         solverOptions["hessian_approximation"] =
                 get_optim_hessian_approximation();
+        checkPropertyValueIsInSet(getProperty_optim_linear_solver(),
+                {"", "mumps", "ma27", "ma57", "ma77", "ma86", "ma97",
+                        "pardiso", "pardisomkl", "spral"});
+        const std::string& linearSolver = get_optim_linear_solver();
+        if (!linearSolver.empty()) {
+            solverOptions["linear_solver"] = linearSolver;
+            // Keep the symbolic factorization when Pardiso perturbs the
+            // matrix, unless the inertia is still wrong.
+            if (linearSolver.compare(0, 7, "pardiso") == 0) {
+                solverOptions
+                        ["pardiso_redo_symbolic_fact_only_if_inertia_wrong"] =
+                                "yes";
+            }
+        }
 
         if (get_optim_max_iterations() != -1)
             solverOptions["max_iter"] = get_optim_max_iterations();
@@ -280,15 +356,30 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
     checkPropertyValueIsInSet(getProperty_optim_sparsity_detection(),
             {"none", "random", "initial-guess"});
     casSolver->setSparsityDetection(get_optim_sparsity_detection());
-    casSolver->setSparsityDetectionRandomCount(3);
+    OPENSIM_THROW_IF(get_optim_sparsity_detection_random_count() < 1,
+            Exception,
+            "Property optim_sparsity_detection_random_count must be "
+            "positive, but it is set to {}.",
+            get_optim_sparsity_detection_random_count());
+    casSolver->setSparsityDetectionRandomCount(
+            get_optim_sparsity_detection_random_count());
 
     casSolver->setWriteSparsity(get_optim_write_sparsity());
+    casSolver->setSparsityCacheDirectory(
+            get_optim_sparsity_cache_directory());
+    casSolver->setBatchEvaluation(get_optim_batch_evaluation());
+    casSolver->setCodegenDirectory(get_codegen_directory());
+    casSolver->setCodegenCompilerCommand(get_codegen_compiler_command());
 
     checkPropertyValueIsInSet(getProperty_optim_finite_difference_scheme(),
             {"central", "forward", "backward"});
     casSolver->setFiniteDifferenceScheme(get_optim_finite_difference_scheme());
 
     casSolver->setCallbackInterval(get_output_interval());
+    OPENSIM_THROW_IF_FRMOBJ(get_checkpoint_interval() < 0, Exception,
+            "Property checkpoint_interval must be non-negative, but it is set "
+            "to {}.", get_checkpoint_interval());
+    casSolver->setCheckpointInterval(get_checkpoint_interval());
 
     Dict pluginOptions;
     pluginOptions["verbose_init"] = true;
@@ -304,6 +395,7 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
     }
     casSolver->setTranscriptionScheme(get_transcription_scheme());
     casSolver->setScaleVariablesUsingBounds(get_scale_variables_using_bounds());
+    casSolver->setScaleAutomatically(get_scale_automatically());
     casSolver->setMinimizeLagrangeMultipliers(
             get_minimize_lagrange_multipliers());
     casSolver->setLagrangeMultiplierWeight(get_lagrange_multiplier_weight());
@@ -337,7 +429,9 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
     casSolver->setEnforcePathConstraintMidpoints(
             get_enforce_path_constraint_midpoints());
     if (casProblem.getJarSize() > 1) {
-        casSolver->setParallelism("thread", casProblem.getJarSize());
+        casSolver->setParallelism(
+                get_parallel_thread_pool() ? "pool" : "thread",
+                casProblem.getJarSize());
     }
     casSolver->setPluginOptions(pluginOptions);
     casSolver->setSolverOptions(solverOptions);
@@ -358,34 +452,112 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
         log_info(std::string(72, '-'));
         getProblemRep().printDescription();
     }
+    std::unique_ptr<TraceEventRecorder> recorder;
+    if (!get_trace_file().empty()) {
+        recorder = OpenSim::make_unique<TraceEventRecorder>();
+    }
+    TraceEventRecorder::Scope solveScope(
+            recorder.get(), "solver", "MocoCasADiSolver");
+    TraceEventRecorder::Scope createScope(
+            recorder.get(), "solver", "create_problem");
     auto casProblem = createCasOCProblem();
+    casProblem->setTraceRecorder(recorder.get());
     auto casSolver = createCasOCSolver(*casProblem);
+    createScope.finish();
     if (get_verbosity()) {
         log_info("Number of threads: {}", casProblem->getJarSize());
     }
 
-    MocoTrajectory guess = getGuess();
     CasOC::Iterate casGuess;
-    if (guess.empty()) {
-        casGuess = casSolver->createInitialGuessFromBounds();
+    if (!m_warmStart.empty()) {
+        checkGuess(m_warmStart.getIterate());
+        casGuess = convertToCasOCIterate(m_warmStart.getIterate());
+        CasOC::WarmStart casWarmStart;
+        casWarmStart.bound_multipliers =
+                convertToCasOCIterate(m_warmStart.getBoundMultipliers());
+        casWarmStart.constraint_multipliers =
+                convertToCasADiDM(m_warmStart.getConstraintMultipliers());
+        casWarmStart.barrier_parameter = m_warmStart.getBarrierParameter();
+        casSolver->setWarmStart(std::move(casWarmStart));
     } else {
-        casGuess = convertToCasOCIterate(guess);
+        MocoTrajectory guess = getGuess();
+        if (guess.empty()) {
+            casGuess = casSolver->createInitialGuessFromBounds();
+        } else {
+            casGuess = convertToCasOCIterate(guess);
+        }
     }
 
-    // Temporarily disable printing of negative muscle force warnings so the
-    // log isn't flooded while computing finite differences.
-    Logger::Level origLoggerLevel = Logger::getLevel();
-    Logger::setLevel(Logger::Level::Warn);
-    CasOC::Solution casSolution;
-    try {
-        casSolution = casSolver->solve(casGuess);
-    } catch (...) {
+    const auto solveNLP = [&](const CasOC::Iterate& guess) {
+        // Temporarily disable printing of negative muscle force warnings so
+        // the log isn't flooded while computing finite differences.
+        Logger::Level origLoggerLevel = Logger::getLevel();
+        Logger::setLevel(Logger::Level::Warn);
+        CasOC::Solution solution;
+        try {
+            solution = casSolver->solve(guess);
+        } catch (...) {
+            OpenSim::Logger::setLevel(origLoggerLevel);
+        }
         OpenSim::Logger::setLevel(origLoggerLevel);
+        return solution;
+    };
+    CasOC::Solution casSolution = solveNLP(casGuess);
+
+    if (get_mesh_refinement_tolerance() > 0) {
+        OPENSIM_THROW_IF_FRMOBJ(get_mesh_refinement_max_iterations() < 0,
+                Exception,
+                "Property mesh_refinement_max_iterations must be "
+                "non-negative, but it is set to {}.",
+                get_mesh_refinement_max_iterations());
+        // The multipliers of a warm start do not apply to the new meshes.
+        casSolver->clearWarmStart();
+        const double tolerance = get_mesh_refinement_tolerance();
+        for (int iter = 0; iter <= get_mesh_refinement_max_iterations();
+                ++iter) {
+            if (!bool(casSolution.stats.at("success"))) break;
+            TraceEventRecorder::Scope refineScope(
+                    recorder.get(), "solver", "mesh_refinement");
+            const casadi::DM errors =
+                    casSolver->calcMeshIntervalErrors(casSolution);
+            const double maxError = casadi::DM::mmax(errors).scalar();
+            if (get_verbosity()) {
+                log_info("Mesh refinement: {} mesh intervals, largest "
+                         "estimated error {:.3g} (tolerance {:g}).",
+                        errors.numel(), maxError, tolerance);
+            }
+            if (maxError <= tolerance) break;
+            if (iter == get_mesh_refinement_max_iterations()) {
+                log_warn("Mesh refinement reached "
+                         "mesh_refinement_max_iterations ({}) without meeting "
+                         "the tolerance.",
+                        iter);
+                break;
+            }
+            casSolver->setMesh(casSolver->createRefinedMesh(errors, tolerance));
+            refineScope.finish();
+            casSolution = solveNLP(casSolution);
+        }
     }
-    OpenSim::Logger::setLevel(origLoggerLevel);
 
+    TraceEventRecorder::Scope convertScope(
+            recorder.get(), "solver", "convert_solution");
     MocoSolution mocoSolution =
             convertToMocoTrajectory<MocoSolution>(casSolution);
+    {
+        // The solution is stored unsealed, so that a solve that did not
+        // converge (e.g., reached max_iterations) can be continued.
+        MocoCasADiWarmStart warmStart;
+        warmStart.m_iterate = convertToMocoTrajectory(casSolution);
+        CasOC::Iterate casBoundMultipliers = casSolution;
+        casBoundMultipliers.variables = casSolution.bound_multipliers;
+        warmStart.m_boundMultipliers =
+                convertToMocoTrajectory(casBoundMultipliers);
+        warmStart.m_constraintMultipliers =
+                convertToSimTKVector(casSolution.constraint_multipliers);
+        m_lastWarmStart = std::move(warmStart);
+    }
+    convertScope.finish();
 
     // If enforcing model constraints and not minimizing Lagrange multipliers,
     // check the rank of the constraint Jacobian and if rank-deficient, print
@@ -438,6 +610,14 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
             casSolution.stats.at("iter_count"), SimTK::nsToSec(elapsed),
             casSolution.objective_breakdown);
 
+    if (recorder) {
+        solveScope.finish();
+        recorder->print(get_trace_file());
+        if (get_verbosity()) {
+            log_info("Wrote trace of the solver to '{}'.", get_trace_file());
+        }
+    }
+
     if (get_verbosity()) {
         log_info(std::string(72, '-'));
         log_info("Elapsed real time: {}.", stopwatch.formatNs(elapsed));
@@ -28,6 +28,59 @@ namespace OpenSim {
 
 class MocoCasOCProblem;
 
+/// The final iterate of a solve with MocoCasADiSolver and the multipliers of
+/// the bounds and constraints of its nonlinear program, with which
+/// MocoCasADiSolver::setWarmStart() starts a related solve. A checkpoint of an
+/// unfinished solve (see the property checkpoint_interval) is also a
+/// MocoCasADiWarmStart, read from the files that write() creates.
+class OSIMMOCO_API MocoCasADiWarmStart {
+public:
+    MocoCasADiWarmStart() = default;
+    MocoCasADiWarmStart(MocoTrajectory iterate,
+            MocoTrajectory boundMultipliers,
+            SimTK::Vector constraintMultipliers, double barrierParameter = 0)
+            : m_iterate(std::move(iterate)),
+              m_boundMultipliers(std::move(boundMultipliers)),
+              m_constraintMultipliers(std::move(constraintMultipliers)),
+              m_barrierParameter(barrierParameter) {}
+    /// Read the files written by write() with the given prefix.
+    explicit MocoCasADiWarmStart(const std::string& prefix);
+
+    bool empty() const { return m_iterate.empty(); }
+    /// The final iterate, which the related solve uses as its initial guess.
+    const MocoTrajectory& getIterate() const { return m_iterate; }
+    /// The multipliers of the bounds on the variables, arranged like the
+    /// variables of the iterate (e.g., getBoundMultipliers().getState(name)).
+    const MocoTrajectory& getBoundMultipliers() const {
+        return m_boundMultipliers;
+    }
+    /// The multipliers of the constraints of the nonlinear program (defects,
+    /// path constraints, etc.), which are only meaningful for a nonlinear
+    /// program with the same constraints.
+    const SimTK::Vector& getConstraintMultipliers() const {
+        return m_constraintMultipliers;
+    }
+    /// The barrier parameter with which IPOPT continues (0 to start from
+    /// IPOPT's mu_init). This is an estimate for a checkpoint and 0 for the
+    /// end of a solve, whose barrier parameter is negligible.
+    double getBarrierParameter() const { return m_barrierParameter; }
+
+    /// Write the iterate, bound multipliers, and constraint multipliers (with
+    /// the barrier parameter) to the binary files
+    /// `<prefix>_iterate.osb`, `<prefix>_bound_multipliers.osb`, and
+    /// `<prefix>_constraint_multipliers.osb` (see OSBFileAdapter), which
+    /// preserve the values exactly. Existing files are only replaced after all
+    /// three files are written, so that an interrupted write does not destroy
+    /// the previous checkpoint.
+    void write(const std::string& prefix) const;
+private:
+    MocoTrajectory m_iterate;
+    MocoTrajectory m_boundMultipliers;
+    SimTK::Vector m_constraintMultipliers;
+    double m_barrierParameter = 0;
+    friend class MocoCasADiSolver;
+};
+
 class MocoCasADiSolverNotAvailable : public Exception {
 public:
     MocoCasADiSolverNotAvailable(
@@ -58,19 +111,125 @@ because we ensure that no "nonzeros" are accidentally treated as "zeros."
 However, the problem may solve faster if we discover more "zeros."
 
 See the optim_sparsity_detection setting for more information. In the case
-of "random", we use 3 random trajectories and combine the resulting sparsity
-patterns. The seed used for these 3 random trajectories is always exactly
-the same, ensuring that the sparsity pattern is deterministic.
+of "random", we use optim_sparsity_detection_random_count (default: 3) random
+trajectories and combine the resulting sparsity patterns. The seed used for
+these random trajectories is always exactly the same, ensuring that the
+sparsity pattern is deterministic. With parallel > 1, the functions are
+evaluated at the random trajectories on multiple threads. The log (at the
+debug level) reports, for each function, how many nonzeros were found at only
+one of the trajectories; if these numbers are 0 for all functions, fewer
+trajectories detect the same patterns.
+
+When the sparsity pattern is detected, the Jacobian of each function that
+invokes OpenSim is also computed more cheaply: instead of perturbing one input
+at a time, the finite differences perturb groups of inputs that affect
+disjoint sets of outputs (e.g., the states of different muscles) together, so
+that each Jacobian requires roughly as many function evaluations as there are
+groups rather than inputs.
+In implicit multibody dynamics mode, the derivative of the multibody residuals
+with respect to the generalized accelerations is the mass matrix, which is
+obtained directly from Simbody; the accelerations are only perturbed if they
+affect other outputs (e.g., acceleration-level kinematic constraint errors).
+With optim_hessian_approximation set to "exact", the second derivatives of
+these functions are computed with finite differences of these Jacobians,
+perturbing the inputs in groups in the same way; the Hessian of each function
+is only nonzero where the inputs of an output are paired, so an exact Hessian
+requires roughly as many Jacobian evaluations as there are groups (twice as
+many with "central" differences).
+
+With optim_batch_evaluation, the functions on the trajectory (multibody
+dynamics, path constraints, and cost and constraint integrands) are evaluated
+at all the grid points in one call per thread, rather than in one call per
+point. The multibody dynamics at all the points of a call are computed with
+the same copy of the model, whose parameters are only updated when they
+change. The Jacobians perturb each group of inputs (or, without sparsity
+detection, each input) at all the points at once, since the points do not
+depend on each other; the Jacobian of the trajectory then requires as many
+batched evaluations as a single point requires evaluations.
+
+Sparsity detection evaluates the model many times. When the same problem is
+solved repeatedly (e.g., with new reference data), set
+optim_sparsity_cache_directory to save the detected patterns in files and
+reuse them in later solves. The files are named after a hash of the structure
+of the problem: the model (its entire XML description), the names and types
+of the goals and constraints, the names of the variables, and the dynamics
+mode and sparsity detection settings. New reference data, bounds, weights, or
+initial guesses reuse the files. If you change a goal's settings in a way
+that changes the variables it depends on (e.g., the states that a tracking
+goal tracks) without renaming it, delete the files.
 
 To explore the sparsity pattern for your problem, set optim_write_sparsity
 and run the resulting files with the plot_casadi_sparsity.py Python script.
 
+Scaling
+=======
+IPOPT converges in fewer iterations when the variables and the constraints
+have similar magnitudes. With scale_automatically, each variable is scaled by
+the range of its bounds (as with scale_variables_using_bounds) or, if it is
+unbounded, by the largest magnitude of its initial guess (if greater than 1).
+Each constraint (e.g., a defect or a multibody residual) is then divided by
+the largest magnitude of its row of the constraint Jacobian at the scaled
+initial guess (limited to between 1e-3 and 1e3), which costs one evaluation
+of the Jacobian before the optimization. Since the scaling is derived from
+the problem and the guess, no tuning is required for each subject; the
+solution and the multipliers returned by the solver are unscaled.
+
 Finite difference scheme
 ========================
 The "central" finite difference is more accurate but can be 2 times
 slower than "forward" (tested on exampleSlidingMass). Sometimes, problems
 may struggle to converge with "forward".
 
+Code generation
+===============
+CasADi evaluates the transcription's expression graph (e.g., the defect
+constraints and their derivatives) with a virtual machine. If
+codegen_directory is set, the parts of the transcription that do not invoke
+the model (the defects and the interpolation of controls) are instead
+generated as C code, compiled with codegen_compiler_command into shared
+libraries in that directory, and loaded from there. The libraries are named
+after a hash of the generated code, so repeated solves of a problem with the
+same structure and mesh (e.g., with new reference data) skip compilation. The
+functions that invoke the model (multibody dynamics, goals, and path
+constraints) are evaluated by OpenSim and cannot be generated. The default
+command, `cc -O2 -fPIC -shared`, requires a C compiler on the PATH; the
+source file, "-o", and the library file are appended to the command.
+
+Warm starts
+===========
+Solving a sequence of related problems (e.g., increasing the weight of a goal
+step by step, or refining the mesh) converges faster if each solve starts
+where the previous one ended, including the multipliers of the nonlinear
+program, rather than from a guess of the variables alone:
+@code
+auto& solver = study.initCasADiSolver();
+MocoSolution solution = study.solve();
+solver.setWarmStart(solver.getWarmStart());
+goal.setWeight(10 * goal.getWeight());
+solution = study.solve();
+@endcode
+The multipliers are only used if the nonlinear program has the same number of
+constraints as the one that produced them; otherwise (e.g., after changing
+num_mesh_intervals), only the iterate is used, like a guess.
+
+Mesh refinement
+===============
+Trajectories with brief, fast transients (e.g., at foot contact) require a
+fine mesh during the transients but not elsewhere. If
+mesh_refinement_tolerance is positive, the solver estimates the local error of
+each mesh interval of the solution by integrating the dynamics across the
+interval with Simpson's rule, on an interpolant of the states, and comparing
+the integral to the change of the states across the interval (relative to the
+magnitude of each state). Mesh intervals whose error exceeds the tolerance are
+split into 2 to 5 intervals (depending on the error and the order of the
+transcription scheme), pairs of adjacent intervals whose error is far below
+the tolerance are merged, and the problem is solved again on the new mesh,
+starting from the previous solution. This repeats until all errors are below
+the tolerance or mesh_refinement_max_iterations is reached. Start from a
+coarse num_mesh_intervals (or mesh); the solution has the final mesh. Each
+refinement re-solves the whole problem, so a tolerance of 1e-3 to 1e-5 is
+usually sufficient.
+
 Parallelization
 ===============
 By default, CasADi evaluate the integral cost integrand and the
@@ -89,7 +248,18 @@ use all 4 cores.
 Note that there is overhead in the parallelization; if you plan to solve
 many problems, it is better to turn off parallelization here and parallelize
 the solving of your multiple problems using your system (e.g., invoke Moco in
-multiple Terminals or Command Prompts).
+multiple Terminals or Command Prompts) or with MocoBatch.
+
+By default, CasADi creates new threads each time the functions are evaluated
+across the grid points (several times in every iteration of the optimizer).
+If the `parallel_thread_pool` property is true, the functions are instead
+evaluated by a ThreadPool whose threads are created once per solve and are
+pinned to the processors on which Moco may run; each thread also keeps using
+the same copy of the model. This avoids the cost of creating threads and
+keeps each thread's data in the caches (and memory node) of its processor,
+which matters most for problems with many grid points on machines with many
+cores. To keep the threads on one NUMA node, restrict Moco to the processors
+of that node (e.g., with `numactl --cpunodebind=0`).
 
 Note that the `parallel` property overrides the environment variable,
 allowing more granular control over parallelization. However, the
@@ -125,6 +295,11 @@ public:
             "Scale optimization variables based on the difference between "
             "variable lower and upper bounds."
             "Default: False.");
+    OpenSim_DECLARE_PROPERTY(scale_automatically, bool,
+            "Scale the optimization variables using their bounds (or, for "
+            "unbounded variables, the magnitude of the initial guess), and "
+            "scale the constraints using the constraint Jacobian at the "
+            "initial guess. Default: False.");
     OpenSim_DECLARE_PROPERTY(parameters_require_initsystem, bool,
             "Do some MocoParameters in the problem require invoking "
             "initSystem() to take effect properly? "
@@ -134,26 +309,64 @@ public:
             "Detect the sparsity pattern of derivatives; 'none' "
             "(for safe block sparsity; default), 'random', or "
             "'initial-guess'.");
+    OpenSim_DECLARE_PROPERTY(optim_sparsity_detection_random_count, int,
+            "The number of random trajectories used to detect the sparsity "
+            "pattern if optim_sparsity_detection is 'random' (default: 3).");
     OpenSim_DECLARE_PROPERTY(optim_write_sparsity, std::string,
             "Write files for the sparsity pattern of the gradient, Jacobian, "
             "and Hessian to the working directory using this as a prefix; "
             "empty (default) to not write such files.");
+    OpenSim_DECLARE_PROPERTY(optim_sparsity_cache_directory, std::string,
+            "If sparsity detection is enabled, save the detected sparsity "
+            "patterns in this directory and, in later solves of problems with "
+            "the same structure, load them instead of detecting them; "
+            "empty (default) to always detect the patterns.");
+    OpenSim_DECLARE_PROPERTY(optim_batch_evaluation, bool,
+            "Evaluate the functions that invoke the model at all grid points "
+            "in one call, and compute their Jacobians by perturbing the "
+            "inputs at all grid points together (default: false).");
+    OpenSim_DECLARE_PROPERTY(codegen_directory, std::string,
+            "Generate and compile C code for the parts of the transcription "
+            "that do not invoke the model, and store the compiled libraries "
+            "in this directory for reuse in later solves; empty (default) to "
+            "evaluate the transcription with CasADi's virtual machine.");
+    OpenSim_DECLARE_PROPERTY(codegen_compiler_command, std::string,
+            "The command that compiles generated code into a shared library "
+            "(default: 'cc -O2 -fPIC -shared'); see 'codegen_directory'.");
     OpenSim_DECLARE_PROPERTY(optim_finite_difference_scheme, std::string,
             "The finite difference scheme CasADi will use to calculate problem "
             "derivatives (default: 'central').");
 
-    OpenSim_DECLARE_OPTIONAL_PROPERTY(parallel, int,
-            "Evaluate integral costs and the differential-algebraic "
-            "equations in parallel across grid points? "
-            "0: not parallel; 1: use all cores (default); greater than 1: use"
-            "this number of parallel jobs. This overrides the OPENSIM_MOCO_PARALLEL "
-            "environment variable.");
+    OpenSim_DECLARE_PROPERTY(mesh_refinement_tolerance, double,
+            "If positive, refine the mesh after solving until the estimated "
+            "local error of every mesh interval is below this tolerance, "
+            "re-solving from the interpolated solution (default: -1, no "
+            "refinement). See the section 'Mesh refinement'.");
+    OpenSim_DECLARE_PROPERTY(mesh_refinement_max_iterations, int,
+            "The maximum number of times the mesh is refined and the problem "
+            "is re-solved (default: 5).");
+    OpenSim_DECLARE_PROPERTY(parallel_thread_pool, bool,
+            "When evaluating in parallel, use a persistent pool of threads, "
+            "each pinned to a processor, instead of creating threads for each "
+            "evaluation (default: false). See the section "
+            "'Parallelization'.");
     OpenSim_DECLARE_PROPERTY(output_interval, int,
             "Write intermediate trajectories to file. 0, the default, "
             "indicates no intermediate trajectories are saved, 1 indicates "
             "each iteration is saved, 5 indicates every fifth iteration is "
             "saved, etc.");
 
+    OpenSim_DECLARE_PROPERTY(checkpoint_interval, int,
+            "Write a checkpoint of the primal-dual iterate every this number "
+            "of iterations, from which an interrupted solve can be resumed "
+            "(see resumeFromCheckpoint()). 0, the default, indicates no "
+            "checkpoints are written. Each checkpoint replaces the previous "
+            "one.");
+    OpenSim_DECLARE_PROPERTY(checkpoint_file, std::string,
+            "The prefix of the checkpoint files (see checkpoint_interval and "
+            "MocoCasADiWarmStart::write()). "
+            "Default: 'MocoCasADiSolver_checkpoint'.");
+
     OpenSim_DECLARE_PROPERTY(minimize_implicit_multibody_accelerations, bool,
             "Minimize the integral of the squared acceleration continuous "
             "variables when using the implicit multibody mode. "
@@ -225,6 +438,35 @@ public:
 
     /// @}
 
+    /// @name Warm starts
+    /// @{
+
+    /// The final iterate and multipliers of the most recent solve with this
+    /// solver (empty if this solver has not solved yet).
+    const MocoCasADiWarmStart& getWarmStart() const { return m_lastWarmStart; }
+    /// Start subsequent solves from `warmStart` (e.g., getWarmStart() of a
+    /// previous solve of a related problem): its iterate is used instead of
+    /// the guess, interpolated onto the mesh, and, if the nonlinear program
+    /// has the same number of constraints (e.g., the mesh and the constraints
+    /// are unchanged), so are its multipliers, and IPOPT is told to warm-start
+    /// from them. The iterate must be compatible with the problem (see
+    /// setGuess()).
+    void setWarmStart(MocoCasADiWarmStart warmStart);
+    /// Solve from the guess again.
+    void clearWarmStart() { m_warmStart = MocoCasADiWarmStart(); }
+    /// Resume an interrupted solve of the same problem (with the same mesh
+    /// and solver settings) from the checkpoint files with the given prefix
+    /// (see the property checkpoint_interval): IPOPT is warm-started from the
+    /// iterate, the multipliers, and the barrier parameter of the checkpoint.
+    /// IPOPT counts the iterations from 0 again, so optim_max_iterations
+    /// applies to the resumed solve alone. This is setWarmStart() with
+    /// MocoCasADiWarmStart(prefix).
+    void resumeFromCheckpoint(const std::string& prefix) {
+        setWarmStart(MocoCasADiWarmStart(prefix));
+    }
+
+    /// @}
+
 protected:
     MocoSolution solveImpl() const override;
 
@@ -244,6 +486,9 @@ private:
     MocoTrajectory m_guessFromAPI;
     mutable SimTK::ResetOnCopy<MocoTrajectory> m_guessFromFile;
     mutable SimTK::ReferencePtr<const MocoTrajectory> m_guessToUse;
+
+    MocoCasADiWarmStart m_warmStart;
+    mutable SimTK::ResetOnCopy<MocoCasADiWarmStart> m_lastWarmStart;
 };
 
 } // namespace OpenSim
@@ -36,7 +36,8 @@ MocoCasOCProblem::MocoCasOCProblem(const MocoCasADiSolver& mocoCasADiSolver,
         : m_jar(std::move(jar)),
           m_paramsRequireInitSystem(
                   mocoCasADiSolver.get_parameters_require_initsystem()),
-          m_formattedTimeString(getFormattedDateTime(true)) {
+          m_formattedTimeString(getFormattedDateTime(true)),
+          m_checkpointFile(mocoCasADiSolver.get_checkpoint_file()) {
 
     setDynamicsMode(dynamicsMode);
     const auto& model = problemRep.getModelBase();
@@ -55,6 +56,10 @@ MocoCasOCProblem::MocoCasOCProblem(const MocoCasADiSolver& mocoCasADiSolver,
 
     if (problemRep.isPrescribedKinematics()) {
         setPrescribedKinematics(true, model.getWorkingState().getNU());
+        m_cachePrescribedKinematics =
+                problemRep.getTimeInitialBounds().isEquality() &&
+                problemRep.getTimeFinalBounds().isEquality() &&
+                problemRep.createKinematicConstraintNames().empty();
     }
 
     auto stateNames =
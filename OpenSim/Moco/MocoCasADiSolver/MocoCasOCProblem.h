@@ -27,6 +27,9 @@
 #include <OpenSim/Moco/MocoBounds.h>
 #include <OpenSim/Moco/MocoProblemRep.h>
 
+#include <algorithm>
+#include <set>
+
 namespace OpenSim {
 
 using VectorDM = std::vector<casadi::DM>;
@@ -165,8 +168,9 @@ TOut convertToMocoTrajectory(const CasOC::Iterate& casIt) {
 
     TOut mocoTraj(simtkTimes, casIt.state_names, casIt.control_names,
             casIt.multiplier_names, derivativeNames, casIt.parameter_names,
-            simtkStates, simtkControls, simtkMultipliers, simtkDerivatives,
-            simtkParameters);
+            std::move(simtkStates), std::move(simtkControls),
+            std::move(simtkMultipliers), std::move(simtkDerivatives),
+            std::move(simtkParameters));
 
     // Append slack variables. MocoTrajectory requires the slack variables to be
     // the same length as its time vector, but it will not be if the
@@ -205,18 +209,61 @@ private:
             bool calcKCErrors,
             MultibodySystemExplicitOutput& output) const override {
         auto mocoProblemRep = m_jar->take();
-
+        calcMultibodySystemExplicit(
+                mocoProblemRep, input, calcKCErrors, output, true);
+        m_jar->leave(std::move(mocoProblemRep));
+    }
+    /// All points of the batch use the same MocoProblemRep (and states), and
+    /// the parameters are applied to the model only when they differ from
+    /// those of the previous point (usually, they are the same at all
+    /// points). If each point has its own state (see
+    /// applyMultibodySystemInputBatch()), the muscles are computed for all
+    /// the points at once.
+    void calcMultibodySystemExplicitBatch(
+            const std::vector<ContinuousInput>& inputs, bool calcKCErrors,
+            std::vector<MultibodySystemExplicitOutput>& outputs)
+            const override {
+        auto mocoProblemRep = m_jar->take();
+        std::vector<SimTK::State*> states;
+        if (applyMultibodySystemInputBatch(inputs, mocoProblemRep, states)) {
+            for (int i = 0; i < (int)inputs.size(); ++i) {
+                finishMultibodySystemExplicit(mocoProblemRep, *states[i],
+                        calcKCErrors, outputs[i]);
+            }
+        } else {
+            for (int i = 0; i < (int)inputs.size(); ++i) {
+                calcMultibodySystemExplicit(mocoProblemRep, inputs[i],
+                        calcKCErrors, outputs[i],
+                        i == 0 || parametersDiffer(inputs[i], inputs[i - 1]));
+            }
+        }
+        m_jar->leave(std::move(mocoProblemRep));
+    }
+    void calcMultibodySystemExplicit(
+            const std::unique_ptr<const MocoProblemRep>& mocoProblemRep,
+            const ContinuousInput& input, bool calcKCErrors,
+            MultibodySystemExplicitOutput& output,
+            bool applyParameters) const {
+        auto& simtkStateDisabledConstraints = applyMultibodySystemInput(
+                input, mocoProblemRep, applyParameters);
+
+        // Compute the quantities of all DeGrooteFregly2016Muscles at once,
+        // before the muscles compute their forces.
+        mocoProblemRep->calcMuscleGroupInfos(simtkStateDisabledConstraints);
+
+        finishMultibodySystemExplicit(mocoProblemRep,
+                simtkStateDisabledConstraints, calcKCErrors, output);
+    }
+    /// The rest of calcMultibodySystemExplicit() after the input is applied
+    /// to `simtkStateDisabledConstraints` and the muscles are computed.
+    void finishMultibodySystemExplicit(
+            const std::unique_ptr<const MocoProblemRep>& mocoProblemRep,
+            SimTK::State& simtkStateDisabledConstraints, bool calcKCErrors,
+            MultibodySystemExplicitOutput& output) const {
         const auto& modelBase = mocoProblemRep->getModelBase();
         auto& simtkStateBase = mocoProblemRep->updStateBase();
-
         const auto& modelDisabledConstraints =
                 mocoProblemRep->getModelDisabledConstraints();
-        auto& simtkStateDisabledConstraints =
-                mocoProblemRep->updStateDisabledConstraints();
-
-        applyInput(SimTK::Stage::Acceleration, input.time, input.states,
-                input.controls, input.multipliers, input.derivatives,
-                input.parameters, mocoProblemRep);
 
         // Compute the accelerations.
         modelDisabledConstraints.realizeAcceleration(
@@ -240,14 +287,55 @@ private:
         // Copy auxiliary residuals to output.
         copyImplicitResidualsToOutput(*mocoProblemRep,
                 simtkStateDisabledConstraints, output.auxiliary_residuals);
-
-        m_jar->leave(std::move(mocoProblemRep));
     }
     void calcMultibodySystemImplicit(const ContinuousInput& input,
             bool calcKCErrors,
             MultibodySystemImplicitOutput& output) const override {
         auto mocoProblemRep = m_jar->take();
+        calcMultibodySystemImplicit(
+                mocoProblemRep, input, calcKCErrors, output, true);
+        m_jar->leave(std::move(mocoProblemRep));
+    }
+    /// See calcMultibodySystemExplicitBatch().
+    void calcMultibodySystemImplicitBatch(
+            const std::vector<ContinuousInput>& inputs, bool calcKCErrors,
+            std::vector<MultibodySystemImplicitOutput>& outputs)
+            const override {
+        auto mocoProblemRep = m_jar->take();
+        std::vector<SimTK::State*> states;
+        if (applyMultibodySystemInputBatch(inputs, mocoProblemRep, states)) {
+            for (int i = 0; i < (int)inputs.size(); ++i) {
+                finishMultibodySystemImplicit(mocoProblemRep, *states[i],
+                        calcKCErrors, outputs[i]);
+            }
+        } else {
+            for (int i = 0; i < (int)inputs.size(); ++i) {
+                calcMultibodySystemImplicit(mocoProblemRep, inputs[i],
+                        calcKCErrors, outputs[i],
+                        i == 0 || parametersDiffer(inputs[i], inputs[i - 1]));
+            }
+        }
+        m_jar->leave(std::move(mocoProblemRep));
+    }
+    void calcMultibodySystemImplicit(
+            const std::unique_ptr<const MocoProblemRep>& mocoProblemRep,
+            const ContinuousInput& input, bool calcKCErrors,
+            MultibodySystemImplicitOutput& output,
+            bool applyParameters) const {
+        auto& simtkStateDisabledConstraints = applyMultibodySystemInput(
+                input, mocoProblemRep, applyParameters);
+
+        // See calcMultibodySystemExplicit().
+        mocoProblemRep->calcMuscleGroupInfos(simtkStateDisabledConstraints);
 
+        finishMultibodySystemImplicit(mocoProblemRep,
+                simtkStateDisabledConstraints, calcKCErrors, output);
+    }
+    /// See finishMultibodySystemExplicit().
+    void finishMultibodySystemImplicit(
+            const std::unique_ptr<const MocoProblemRep>& mocoProblemRep,
+            SimTK::State& simtkStateDisabledConstraints, bool calcKCErrors,
+            MultibodySystemImplicitOutput& output) const {
         // Original model and its associated state. These are used to calculate
         // kinematic constraint forces and errors.
         const auto& modelBase = mocoProblemRep->getModelBase();
@@ -257,12 +345,6 @@ private:
         // used to compute the accelerations.
         const auto& modelDisabledConstraints =
                 mocoProblemRep->getModelDisabledConstraints();
-        auto& simtkStateDisabledConstraints =
-                mocoProblemRep->updStateDisabledConstraints();
-
-        applyInput(SimTK::Stage::Acceleration, input.time, input.states,
-                input.controls, input.multipliers, input.derivatives,
-                input.parameters, mocoProblemRep);
 
         modelDisabledConstraints.realizeAcceleration(
                 simtkStateDisabledConstraints);
@@ -293,6 +375,38 @@ private:
         // Copy auxiliary residuals to output.
         copyImplicitResidualsToOutput(*mocoProblemRep,
                 simtkStateDisabledConstraints, output.auxiliary_residuals);
+    }
+    static bool parametersDiffer(
+            const ContinuousInput& a, const ContinuousInput& b) {
+        return a.parameters.nonzeros() != b.parameters.nonzeros();
+    }
+    bool hasMassMatrix() const override { return true; }
+    void calcMassMatrix(const ContinuousInput& input,
+            casadi::DM& massMatrix) const override {
+        auto mocoProblemRep = m_jar->take();
+
+        // The mass matrix is the same with or without the constraints.
+        const auto& modelDisabledConstraints =
+                mocoProblemRep->getModelDisabledConstraints();
+        auto& simtkStateDisabledConstraints =
+                mocoProblemRep->updStateDisabledConstraints();
+
+        applyInput(SimTK::Stage::Position, input.time, input.states,
+                input.controls, input.multipliers, input.derivatives,
+                input.parameters, mocoProblemRep);
+        modelDisabledConstraints.realizePosition(simtkStateDisabledConstraints);
+
+        SimTK::Matrix simtkMassMatrix;
+        modelDisabledConstraints.getMatterSubsystem().calcM(
+                simtkStateDisabledConstraints, simtkMassMatrix);
+        massMatrix = casadi::DM::zeros(getNumSpeeds(), getNumSpeeds());
+        // DM stores its nonzeros by column.
+        for (int j = 0; j < getNumSpeeds(); ++j) {
+            for (int i = 0; i < getNumSpeeds(); ++i) {
+                massMatrix.ptr()[j * getNumSpeeds() + i] =
+                        simtkMassMatrix(i, j);
+            }
+        }
 
         m_jar->leave(std::move(mocoProblemRep));
     }
@@ -308,10 +422,7 @@ private:
 
         // Update the model and state.
         applyParametersToModelProperties(parameters, *mocoProblemRep);
-        convertStatesToSimTKState(
-                SimTK::Stage::Velocity, time, multibody_states,
-                modelBase, simtkStateBase, false);
-        modelBase.realizeVelocity(simtkStateBase);
+        updateStateBase(time, multibody_states, modelBase, simtkStateBase);
 
         // Apply velocity correction to qdot if at a mesh interval midpoint.
         // This correction modifies the dynamics to enable a projection of
@@ -491,6 +602,31 @@ private:
         m_jar->leave(std::move(mocoProblemRep));
         return names;
     }
+    /// The structure of the problem depends on the entire model (e.g., the
+    /// coordinates spanned by each muscle) and on the types of the goals and
+    /// constraints, but not on the goals' reference data.
+    std::string getStructureDescriptionImpl() const override {
+        auto mocoProblemRep = m_jar->take();
+        std::string description = mocoProblemRep->getModelBase().dump();
+        for (const auto& name : mocoProblemRep->createCostNames()) {
+            description += fmt::format("cost_type {} {}\n", name,
+                    mocoProblemRep->getCost(name).getConcreteClassName());
+        }
+        for (const auto& name :
+                mocoProblemRep->createEndpointConstraintNames()) {
+            description += fmt::format("endpoint_constraint_type {} {}\n",
+                    name,
+                    mocoProblemRep->getEndpointConstraint(name)
+                            .getConcreteClassName());
+        }
+        for (const auto& name : mocoProblemRep->createPathConstraintNames()) {
+            description += fmt::format("path_constraint_type {} {}\n", name,
+                    mocoProblemRep->getPathConstraint(name)
+                            .getConcreteClassName());
+        }
+        m_jar->leave(std::move(mocoProblemRep));
+        return description;
+    }
     void intermediateCallbackImpl() const override {
         m_fileDeletionThrower->throwIfDeleted();
     }
@@ -501,6 +637,14 @@ private:
                         m_formattedTimeString, iterate.iteration);
         convertToMocoTrajectory(iterate).write(filename);
     }
+    void checkpointCallbackImpl(const CasOC::Iterate& iterate,
+            const CasOC::WarmStart& warmStart) const override {
+        MocoCasADiWarmStart checkpoint(convertToMocoTrajectory(iterate),
+                convertToMocoTrajectory(warmStart.bound_multipliers),
+                convertToSimTKVector(warmStart.constraint_multipliers),
+                warmStart.barrier_parameter);
+        checkpoint.write(m_checkpointFile);
+    }
 
 private:
     /// Apply parameters to properties in the models returned by
@@ -543,6 +687,37 @@ private:
         }
     }
 
+    /// Set the time, coordinates, and speeds of the state of the model with
+    /// enabled constraints (which is used only for its constraint Jacobian
+    /// and constraint errors) and realize it to Velocity. If the state
+    /// already has these values and is realized (e.g., when the derivatives
+    /// of a function are estimated by perturbing only the controls or the
+    /// multipliers, or when the velocity correction is evaluated at a point at
+    /// which the multibody system was just evaluated), the state is not
+    /// changed, so that its kinematics, and the constraint Jacobian that
+    /// depends on them, are reused rather than computed again. The state is
+    /// always changed if the problem has parameters, since the parameters may
+    /// change the model.
+    void updateStateBase(const double& time, const casadi::DM& states,
+            const Model& modelBase, SimTK::State& stateBase) const {
+        bool same = getNumParameters() == 0 &&
+                    stateBase.getSystemStage() >= SimTK::Stage::Velocity &&
+                    stateBase.getTime() == time;
+        const SimTK::Vector& q = stateBase.getQ();
+        for (int isv = 0; same && isv < getNumCoordinates(); ++isv) {
+            same = q[m_yIndexMap.at(isv)] == *(states.ptr() + isv);
+        }
+        same = same && std::equal(states.ptr() + getNumCoordinates(),
+                               states.ptr() + getNumCoordinates() +
+                                       getNumSpeeds(),
+                               stateBase.getU().getContiguousScalarData());
+        if (!same) {
+            convertStatesToSimTKState(SimTK::Stage::Velocity, time, states,
+                    modelBase, stateBase, false);
+        }
+        modelBase.realizeVelocity(stateBase);
+    }
+
     /// Invoke convertStatesToSimTKState() and also
     /// copy values from `controls` into the discrete state variable managed
     /// by the `discreteController`. We assume that if we need the controls
@@ -573,7 +748,7 @@ private:
             const casadi::DM& multipliers, const casadi::DM& derivatives,
             const casadi::DM& parameters,
             const std::unique_ptr<const MocoProblemRep>& mocoProblemRep,
-            int stateDisConIndex = 0) const {
+            int stateDisConIndex = 0, bool applyParameters = true) const {
         // Original model and its associated state. These are used to calculate
         // kinematic constraint forces and errors.
         const auto& modelBase = mocoProblemRep->getModelBase();
@@ -587,7 +762,7 @@ private:
                 mocoProblemRep->updStateDisabledConstraints(stateDisConIndex);
 
         // Update the model and state.
-        if (stageDep >= SimTK::Stage::Instance) {
+        if (stageDep >= SimTK::Stage::Instance && applyParameters) {
             applyParametersToModelProperties(parameters, *mocoProblemRep);
         }
 
@@ -633,14 +808,88 @@ private:
             // We pass copyAuxStates as false: we use the base model for its
             // constraint Jacobian, which depends only on kinematics and cannot
             // depend on auxiliary states.
-            convertStatesToSimTKState(
-                    stageDep, time, states, modelBase, simtkStateBase, false);
+            updateStateBase(time, states, modelBase, simtkStateBase);
             calcKinematicConstraintForces(multipliers, simtkStateBase,
                     modelBase, mocoProblemRep->getConstraintForces(),
                     simtkStateDisabledConstraints);
         }
     }
 
+    /// Apply the input of the multibody system functions and return the
+    /// state of the model with disabled constraints to realize. With
+    /// m_cachePrescribedKinematics, this is the state for the time of the
+    /// input (see MocoProblemRep::updStateDisabledConstraintsAtTime()), whose
+    /// kinematics are already realized; only the auxiliary states, the
+    /// controls, and the auxiliary derivatives are applied to it, so that
+    /// realizing it recomputes only the dynamics.
+    SimTK::State& applyMultibodySystemInput(const ContinuousInput& input,
+            const std::unique_ptr<const MocoProblemRep>& mocoProblemRep,
+            bool applyParameters) const {
+        if (!m_cachePrescribedKinematics) {
+            applyInput(SimTK::Stage::Acceleration, input.time, input.states,
+                    input.controls, input.multipliers, input.derivatives,
+                    input.parameters, mocoProblemRep, 0, applyParameters);
+            return mocoProblemRep->updStateDisabledConstraints();
+        }
+        // Changing the parameters discards the states at each time.
+        if (applyParameters) {
+            applyParametersToModelProperties(input.parameters, *mocoProblemRep);
+        }
+        auto& simtkState =
+                mocoProblemRep->updStateDisabledConstraintsAtTime(input.time);
+        const auto& implicitRefs =
+                mocoProblemRep->getImplicitComponentReferencePtrs();
+        const int numAccels = getNumAccelerations();
+        for (int i = 0; i < (int)implicitRefs.size(); ++i) {
+            const auto& comp = implicitRefs[i].second.getRef();
+            comp.setDiscreteVariableValue(simtkState, implicitRefs[i].first,
+                    *(input.derivatives.ptr() + numAccels + i));
+        }
+        // Unlike updY(), updZ() does not invalidate the kinematics.
+        std::copy_n(input.states.ptr() + getNumCoordinates() + getNumSpeeds(),
+                getNumAuxiliaryStates(),
+                simtkState.updZ().updContiguousScalarData());
+        SimTK::Vector& simtkControls =
+                mocoProblemRep->getDiscreteControllerDisabledConstraints()
+                        .updDiscreteControls(simtkState);
+        for (int ic = 0; ic < getNumControls(); ++ic) {
+            simtkControls[m_modelControlIndices[ic]] =
+                    *(input.controls.ptr() + ic);
+        }
+        return simtkState;
+    }
+
+    /// With cached prescribed kinematics, each grid point has its own state
+    /// (see MocoProblemRep::updStateDisabledConstraintsAtTime()), so the
+    /// inputs of all the points of a batch can be applied before any of the
+    /// points is evaluated, and the quantities of the muscles can then be
+    /// computed for all the points at once (see
+    /// DeGrooteFregly2016MuscleGroup). This applies the inputs, computes the
+    /// muscles, and returns the state of each point in `states`, or returns
+    /// false (without applying the inputs) if the points do not have their
+    /// own states or if the parameters differ between the points.
+    bool applyMultibodySystemInputBatch(
+            const std::vector<ContinuousInput>& inputs,
+            const std::unique_ptr<const MocoProblemRep>& mocoProblemRep,
+            std::vector<SimTK::State*>& states) const {
+        if (!m_cachePrescribedKinematics || inputs.size() < 2) return false;
+        std::set<double> times;
+        for (const auto& input : inputs) {
+            // Points at the same time would share a state.
+            if (!times.insert(input.time).second) return false;
+            // Changing the parameters discards the states at each time.
+            if (parametersDiffer(input, inputs[0])) return false;
+        }
+        states.clear();
+        for (int i = 0; i < (int)inputs.size(); ++i) {
+            states.push_back(&applyMultibodySystemInput(
+                    inputs[i], mocoProblemRep, i == 0));
+        }
+        mocoProblemRep->calcMuscleGroupInfos(
+                std::vector<const SimTK::State*>(states.begin(), states.end()));
+        return true;
+    }
+
     void calcKinematicConstraintForces(const casadi::DM& multipliers,
             const SimTK::State& stateBase, const Model& modelBase,
             const DiscreteForces& constraintForces,
@@ -735,12 +984,8 @@ private:
     void copyImplicitResidualsToOutput(const MocoProblemRep& mocoProblemRep,
             const SimTK::State& state, casadi::DM& auxiliary_residuals) const {
         if (getNumAuxiliaryResidualEquations()) {
-            const auto& residualOutputs =
-                    mocoProblemRep.getImplicitResidualReferencePtrs();
-            SimTK::Vector auxResiduals((int)residualOutputs.size(), 0.0);
-            for (int i = 0; i < (int)residualOutputs.size(); ++i) {
-                auxResiduals[i] = residualOutputs[i]->getValue(state);
-            }
+            SimTK::Vector auxResiduals;
+            mocoProblemRep.calcImplicitResiduals(state, auxResiduals);
             std::copy_n(auxResiduals.getContiguousScalarData(),
                     auxResiduals.size(), auxiliary_residuals.ptr());
         }
@@ -748,7 +993,13 @@ private:
 
     std::unique_ptr<ThreadsafeJar<const MocoProblemRep>> m_jar;
     bool m_paramsRequireInitSystem = true;
+    // With prescribed kinematics, fixed initial and final times, and no
+    // kinematic constraints, the positions and velocities at each grid point
+    // are the same in every evaluation, so the multibody system functions
+    // realize them once per grid point (see applyMultibodySystemInput()).
+    bool m_cachePrescribedKinematics = false;
     std::string m_formattedTimeString;
+    std::string m_checkpointFile;
     std::unordered_map<int, int> m_yIndexMap;
     std::vector<int> m_modelControlIndices;
     std::unique_ptr<FileDeletionThrower> m_fileDeletionThrower;
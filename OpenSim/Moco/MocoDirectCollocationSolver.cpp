@@ -18,6 +18,10 @@
 
 #include "MocoDirectCollocationSolver.h"
 
+#include "MocoUtilities.h"
+
+#include <OpenSim/Common/CommonUtilities.h>
+
 using namespace OpenSim;
 
 void MocoDirectCollocationSolver::constructProperties() {
@@ -34,12 +38,28 @@ void MocoDirectCollocationSolver::constructProperties() {
     constructProperty_optim_constraint_tolerance(-1);
     constructProperty_optim_hessian_approximation("limited-memory");
     constructProperty_optim_ipopt_print_level(-1);
+    constructProperty_optim_linear_solver("");
     constructProperty_guess_file("");
     constructProperty_velocity_correction_bounds({-0.1, 0.1});
     constructProperty_implicit_multibody_acceleration_bounds({-1000, 1000});
     constructProperty_implicit_auxiliary_derivative_bounds({-1000, 1000});
     constructProperty_minimize_lagrange_multipliers(false);
     constructProperty_lagrange_multiplier_weight(1.0);
+    constructProperty_parallel();
+    constructProperty_trace_file("");
+}
+
+int MocoDirectCollocationSolver::getNumParallelThreads() const {
+    int parallel = 1;
+    int parallelEV = getMocoParallelEnvironmentVariable();
+    if (getProperty_parallel().size()) {
+        parallel = get_parallel();
+    } else if (parallelEV != -1) {
+        parallel = parallelEV;
+    }
+    if (parallel == 0) return 1;
+    if (parallel == 1) return getNumThreadsOrDefault();
+    return parallel;
 }
 
 void MocoDirectCollocationSolver::setMesh(const std::vector<double>& mesh) {
@@ -85,7 +85,40 @@ the minimization of all Lagrange multipliers associated with kinematic
 constraints in the problem. The `velocity_correction_bounds` setting allows you
 to set the bounds on the velocity correction variables that project state
 variables onto the constraint manifold when necessary to properly enforce defect
-constraints (see Posa et al. 2016 for details). */
+constraints (see Posa et al. 2016 for details).
+
+Linear solver
+-------------
+Each IPOPT iteration solves a sparse, symmetric indefinite (KKT) system, which
+takes most of the time of the optimization for large problems (e.g., a
+MocoInverse with many muscles and mesh intervals). The `optim_linear_solver`
+setting selects the solver for these systems. The MUMPS solver built with
+%OpenSim is sequential; the HSL solvers MA86 and MA97 and the Pardiso solvers
+('pardiso' from pardiso-project.org, or 'pardisomkl' from Intel MKL) factorize
+in parallel, using the number of threads set by the OMP_NUM_THREADS (or
+MKL_NUM_THREADS) environment variable. The HSL and Pardiso libraries are not
+distributed with %OpenSim; IPOPT loads them at runtime (e.g., libhsl or
+libpardiso) if they are on the library search path.
+
+The sparsity pattern of the KKT systems does not change during a solve, so
+IPOPT computes the ordering and symbolic factorization of the pattern once per
+solve and reuses it in every iteration; with Pardiso, the symbolic
+factorization is also kept when the matrix is perturbed to correct its inertia,
+unless the inertia is still wrong after the perturbation. A new solve (e.g.,
+with a warm start) analyzes the pattern again, which is cheap compared to the
+numeric factorizations of the iterations.
+
+Tracing
+-------
+To find out where the time of a solve goes, set `trace_file` to the name of a
+JSON file. The solver records the phases of the solve (e.g., transcription and
+the optimization), each evaluation of the problem's functions (e.g., the
+multibody system, goal integrands, and path constraints; including the
+evaluations for finite differences, on the threads that perform them), and,
+for MocoCasADiSolver, each iteration of the optimization solver and the
+solver's own breakdown of its time. Recording every evaluation adds some
+overhead and can produce large files, so use a coarse mesh or limit the number
+of iterations. */
 class OSIMMOCO_API MocoDirectCollocationSolver : public MocoSolver {
     OpenSim_DECLARE_ABSTRACT_OBJECT(MocoDirectCollocationSolver, MocoSolver);
 
@@ -126,6 +159,11 @@ public:
             "Newton.");
     OpenSim_DECLARE_PROPERTY(optim_ipopt_print_level, int,
             "IPOPT's verbosity (see IPOPT documentation).");
+    OpenSim_DECLARE_PROPERTY(optim_linear_solver, std::string,
+            "When using IPOPT, the sparse linear solver for the KKT systems: "
+            "'mumps', 'ma27', 'ma57', 'ma77', 'ma86', 'ma97', 'pardiso', "
+            "'pardisomkl', or 'spral' (which must be available to IPOPT), or "
+            "'' (default) for IPOPT's default.");
     OpenSim_DECLARE_OPTIONAL_PROPERTY(enforce_constraint_derivatives, bool,
             "'true' (default) or 'false', whether or not derivatives of "
             "kinematic constraints are enforced as path constraints in the "
@@ -153,6 +191,17 @@ public:
     OpenSim_DECLARE_PROPERTY(implicit_auxiliary_derivative_bounds, MocoBounds,
             "Bounds on derivative variables for components with auxiliary "
             "dynamics in implicit form. Default: [-1000, 1000]");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(parallel, int,
+            "Evaluate integral costs and the differential-algebraic "
+            "equations in parallel across grid points? "
+            "0: not parallel; 1: use all cores (default); greater than 1: use "
+            "this number of parallel jobs. This overrides the "
+            "OPENSIM_MOCO_PARALLEL environment variable.");
+    OpenSim_DECLARE_PROPERTY(trace_file, std::string,
+            "If not empty, the timing of the phases of the solver and of the "
+            "evaluations of the problem's functions is written to this file "
+            "in the Trace Event Format (JSON), which can be viewed with "
+            "chrome://tracing or ui.perfetto.dev. Default: empty (disabled).");
 
     MocoDirectCollocationSolver() { constructProperties(); }
 
@@ -169,6 +218,12 @@ protected:
             "Usually non-uniform, user-defined list of mesh points to sample. "
             "Takes precedence over uniform mesh with num_mesh_intervals.");
     void constructProperties();
+
+    /// The number of threads with which to evaluate the problem's functions
+    /// across grid points, from the `parallel` property or, if it is not set,
+    /// the OPENSIM_MOCO_PARALLEL environment variable (see
+    /// getMocoParallelEnvironmentVariable()); by default, all cores are used.
+    int getNumParallelThreads() const;
 };
 
 } // namespace OpenSim
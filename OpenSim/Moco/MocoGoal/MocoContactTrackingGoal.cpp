@@ -314,7 +314,6 @@ void MocoContactTrackingGoal::calcIntegrandImpl(
     const auto& state = input.state;
     const auto& time = state.getTime();
     getModel().realizeVelocity(state);
-    SimTK::Vector timeVec(1, time);
 
     integrand = 0;
     SimTK::Vec3 force_ref;
@@ -326,16 +325,22 @@ void MocoContactTrackingGoal::calcIntegrandImpl(
         // Model force.
         SimTK::Vec3 force_model(0);
         for (const auto& entry : group.contacts) {
-            Array<double> recordValues = entry.first->getRecordValues(state);
+            // The record offset is 0 for the forces on the sphere and 6 for
+            // the forces on the half space (see findRecordOffset()); only
+            // these forces are computed, rather than all the record values.
             const auto& recordOffset = entry.second;
-            for (int im = 0; im < force_model.size(); ++im) {
-                force_model[im] += recordValues[recordOffset + im];
+            if (recordOffset == 0) {
+                force_model += entry.first->getSphereForce(state)[1];
+            } else {
+                force_model += entry.first->getHalfSpaceForce(state)[1];
             }
         }
 
         // Reference force.
+        const double* refValues =
+                group.refCache.getValues(group.refSplines, time);
         for (int ir = 0; ir < force_ref.size(); ++ir) {
-            force_ref[ir] = group.refSplines[ir].calcValue(timeVec);
+            force_ref[ir] = refValues[ir];
         }
 
         // Re-express the reference force.
@@ -19,6 +19,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "MocoGoal.h"
+#include "MocoReferenceCache.h"
 #include <OpenSim/Simulation/Model/ExternalLoads.h>
 
 namespace OpenSim {
@@ -325,6 +326,8 @@ private:
     struct GroupInfo {
         std::vector<std::pair<const SmoothSphereHalfSpaceForce*, int>> contacts;
         GCVSplineSet refSplines;
+        /// The values of refSplines at the times of the grid.
+        MocoReferenceCache refCache;
         const PhysicalFrame* refExpressedInFrame = nullptr;
         SimTK::Vec3 normalizeFactors = SimTK::Vec3(1.0);
     };
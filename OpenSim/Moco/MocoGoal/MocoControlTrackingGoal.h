@@ -20,6 +20,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "MocoGoal.h"
+#include "MocoReferenceCache.h"
 
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
@@ -283,6 +284,8 @@ private:
     mutable std::vector<int> m_control_indices;
     mutable std::vector<double> m_control_weights;
     mutable GCVSplineSet m_ref_splines;
+    /// The values of m_ref_splines at the times of the grid.
+    MocoReferenceCache m_ref_cache;
     mutable std::vector<int> m_ref_indices;
     mutable std::vector<std::string> m_control_names;
     mutable std::vector<std::string> m_ref_labels;
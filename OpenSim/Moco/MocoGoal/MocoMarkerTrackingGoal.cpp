@@ -121,6 +121,7 @@ void MocoMarkerTrackingGoal::initializeOnModelImpl(const Model& model) const {
     // trajectories.
     m_refsplines =
             GCVSplineSet(get_markers_reference().getMarkerTable().flatten());
+    m_refcache.clear();
 
     setRequirements(1, 1, SimTK::Stage::Position);
 }
@@ -129,7 +130,7 @@ void MocoMarkerTrackingGoal::calcIntegrandImpl(
         const IntegrandInput& input, SimTK::Real& integrand) const {
      const auto& time = input.state.getTime();
      getModel().realizePosition(input.state);
-     SimTK::Vector timeVec(1, time);
+     const double* refValues = m_refcache.getValues(m_refsplines, time);
 
     for (int i = 0; i < (int)m_model_markers.size(); ++i) {
          const auto& modelValue =
@@ -139,9 +140,9 @@ void MocoMarkerTrackingGoal::calcIntegrandImpl(
         // Get the markers reference index corresponding to the current
         // model marker and get the reference value.
         int refidx = m_refindices[i];
-        refValue[0] = m_refsplines[3 * refidx].calcValue(timeVec);
-        refValue[1] = m_refsplines[3 * refidx + 1].calcValue(timeVec);
-        refValue[2] = m_refsplines[3 * refidx + 2].calcValue(timeVec);
+        refValue[0] = refValues[3 * refidx];
+        refValue[1] = refValues[3 * refidx + 1];
+        refValue[2] = refValues[3 * refidx + 2];
 
         // Apply scale factors for this marker, if they exist.
         const auto& scaleFactorRef = m_scaleFactorRefs[i];
@@ -19,6 +19,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "MocoGoal.h"
+#include "MocoReferenceCache.h"
 
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
@@ -127,6 +128,8 @@ protected:
             "not in the model (such data would be ignored). Default: false.");
 
     mutable GCVSplineSet m_refsplines;
+    /// The values of m_refsplines at the times of the grid.
+    MocoReferenceCache m_refcache;
     mutable std::vector<SimTK::ReferencePtr<const Marker>> m_model_markers;
     mutable std::vector<int> m_refindices;
     mutable SimTK::Array_<double> m_marker_weights;
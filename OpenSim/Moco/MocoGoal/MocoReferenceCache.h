@@ -0,0 +1,92 @@
+#ifndef OPENSIM_MOCOREFERENCECACHE_H
+#define OPENSIM_MOCOREFERENCECACHE_H
+/* -------------------------------------------------------------------------- *
+ * OpenSim: MocoReferenceCache.h                                              *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Common/GCVSpline.h>
+#include <OpenSim/Common/GCVSplineSet.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace OpenSim {
+
+/** The values of the reference splines of a tracking goal at each of the times
+at which the goal is evaluated. A solver evaluates the integrand of a goal at
+the same grid times in every iteration, so the splines are evaluated once per
+grid time and solve, and the values for a time are stored contiguously (in the
+order of the splines). Once all the grid times have been seen, getValues()
+neither evaluates the splines nor allocates memory.
+
+If the grid times change between iterations (e.g., the final time is a
+variable), the cache is cleared once it holds more than a fixed number of
+values, which bounds its memory. A goal holds one cache per spline set; the
+cache is not thread-safe, but each thread of a solver uses its own copy of the
+goal. */
+class MocoReferenceCache {
+public:
+    /** Remove all values (e.g., when the splines are created for a new
+    solve). */
+    void clear() {
+        m_rows.clear();
+        m_values.clear();
+        m_intervals.clear();
+    }
+
+    /** The values of each of the splines in `splines` at `time`. The splines
+    must be the same each time this is called (until clear()). The pointer
+    is valid until the next call. */
+    const double* getValues(const GCVSplineSet& splines, double time) const {
+        const auto it = m_rows.find(time);
+        const int numSplines = splines.getSize();
+        if (it != m_rows.end()) {
+            return m_values.data() + it->second * numSplines;
+        }
+        if ((int)m_values.size() + numSplines > s_maxNumValues) {
+            m_rows.clear();
+            m_values.clear();
+        }
+        if ((int)m_intervals.size() != numSplines) {
+            m_intervals.assign(numSplines, 0);
+        }
+        const int row = (int)m_rows.size();
+        m_rows[time] = row;
+        m_values.resize(m_values.size() + numSplines);
+        double* values = m_values.data() + row * numSplines;
+        for (int i = 0; i < numSplines; ++i) {
+            const auto* spline = dynamic_cast<const GCVSpline*>(&splines[i]);
+            if (spline) {
+                // Consecutive grid times are usually in the same or the next
+                // knot interval, which makes the search short.
+                values[i] = spline->evaluate(time, 0, m_intervals[i]);
+            } else {
+                values[i] = splines[i].calcValue(SimTK::Vector(1, time));
+            }
+        }
+        return values;
+    }
+
+private:
+    // About 8 MB of values.
+    static constexpr int s_maxNumValues = 1 << 20;
+    mutable std::unordered_map<double, int> m_rows;
+    mutable std::vector<double> m_values;
+    mutable std::vector<int> m_intervals;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MOCOREFERENCECACHE_H
@@ -86,6 +86,7 @@ void MocoStateTrackingGoal::initializeOnModelImpl(const Model& model) const {
     // allow_unused_references is set to true, an exception is thrown for
     // names in the references that don't correspond to a state variable.
     const auto& scaleFactors = getModel().getComponentList<MocoScaleFactor>();
+    m_refcache.clear();
     for (int iref = 0; iref < allSplines.getSize(); ++iref) {
         const auto& refName = allSplines[iref].getName();
         if (allSysYIndices.count(refName) == 0) {
@@ -143,14 +144,12 @@ void MocoStateTrackingGoal::calcIntegrandImpl(
         const IntegrandInput& input, SimTK::Real& integrand) const {
     const auto& time = input.time;
 
-    SimTK::Vector timeVec(1, time);
-
-    // TODO cache the reference coordinate values at the mesh points, rather
-    // than evaluating the spline.
+    const double* refValues = m_refcache.getValues(m_refsplines, time);
+    const auto& y = input.state.getY();
     integrand = 0;
     for (int iref = 0; iref < m_refsplines.getSize(); ++iref) {
-        const auto& modelValue = input.state.getY()[m_sysYIndices[iref]];
-        const auto& refValue = m_refsplines[iref].calcValue(timeVec);
+        const auto& modelValue = y[m_sysYIndices[iref]];
+        const auto& refValue = refValues[iref];
 
         // If a scale factor exists for this state, retrieve its value.
         double scaleFactor = 1.0;
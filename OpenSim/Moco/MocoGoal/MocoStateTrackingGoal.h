@@ -19,6 +19,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "MocoGoal.h"
+#include "MocoReferenceCache.h"
 
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
@@ -195,6 +196,8 @@ private:
     }
 
     mutable GCVSplineSet m_refsplines;
+    /// The values of m_refsplines at the times of the grid.
+    MocoReferenceCache m_refcache;
     /// The indices in Y corresponding to the provided reference coordinates.
     mutable std::vector<int> m_sysYIndices;
     mutable std::vector<double> m_state_weights;
@@ -407,7 +407,13 @@ A MocoProblem is a series of phases, each of which contains the following:
   - goals (costs and endpoint constraints)
   - path constraints
 
-Currently, only single-phase problems are supported.
+Currently, only single-phase problems are supported (createRep() throws an
+exception if the problem has more than one phase), so a trial with many
+strides is solved as one phase. The functions at the points of a phase can
+still be evaluated in parallel (see MocoCasADiSolver's `parallel` and
+`optim_batch_evaluation` settings), and the constraint Jacobian of a
+collocation is already block-banded in time, since the defects of each mesh
+interval only depend on the variables of that interval.
 This class has convenience methods to configure the first (0-th) phase.
 
 This class allows you to define your problem, but does not let you do
@@ -508,6 +514,7 @@ public:
     /// Get a modifiable phase of the problem by index (starting index of 0).
     /// This accesses the internal phases property.
     const MocoPhase& getPhase(int index = 0) const { return get_phases(index); }
+    int getNumPhases() const { return getProperty_phases().size(); }
 
 #ifndef SWIG // MocoProblemRep() is not copyable.
     /// Create an instance of MocoProblemRep, which fills in additional
@@ -25,6 +25,7 @@
 #include "MocoProblemInfo.h"
 #include "MocoScaleFactor.h"
 #include <regex>
+#include <set>
 #include <unordered_set>
 
 #include <OpenSim/Simulation/PositionMotion.h>
@@ -39,6 +40,16 @@ MocoProblemRep::MocoProblemRep(const MocoProblem& problem)
         : m_problem(&problem) {
     initialize();
 }
+std::unique_ptr<MocoProblemRep> MocoProblemRep::createRepHeap() const {
+    OPENSIM_THROW_IF(!m_problem, Exception,
+            "Expected this MocoProblemRep to be created from a MocoProblem.");
+    std::unique_ptr<MocoProblemRep> rep(new MocoProblemRep());
+    rep->m_problem = m_problem;
+    rep->m_model_processed = m_model_processed;
+    rep->initialize();
+    return rep;
+}
+
 void MocoProblemRep::initialize() {
 
     // Clear member variables.
@@ -51,9 +62,13 @@ void MocoProblemRep::initialize() {
     m_position_motion_disabled_constraints.reset();
     m_constraint_forces.reset();
     m_acceleration_motion.reset();
+    m_muscle_group.clear();
     m_state_infos.clear();
     m_control_infos.clear();
+    m_states_disabled_constraints_at_time.clear();
     m_parameters.clear();
+    m_applied_parameter_values.clear();
+    m_applied_parameters_initialized_system = false;
     m_costs.clear();
     m_endpoint_constraints.clear();
     m_path_constraints.clear();
@@ -62,15 +77,24 @@ void MocoProblemRep::initialize() {
     m_kinematic_constraint_eq_names_with_derivatives.clear();
     m_kinematic_constraint_eq_names_without_derivatives.clear();
     m_implicit_component_refs.clear();
+    m_implicit_residual_components.clear();
     m_implicit_residual_refs.clear();
 
     if (!getTimeInitialBounds().isSet() && !getTimeFinalBounds().isSet()) {
         log_warn("No time bounds set.");
     }
 
+    OPENSIM_THROW_IF(m_problem->getNumPhases() != 1, Exception,
+            "Expected the problem to have 1 phase, but it has {}; multi-phase "
+            "problems are not supported.",
+            m_problem->getNumPhases());
     const auto& ph0 = m_problem->getPhase(0);
     // TODO: Provide directory from which to load model file.
-    m_model_base = ph0.getModelProcessor().process();
+    if (!m_model_processed) {
+        m_model_processed = std::make_shared<const Model>(
+                ph0.getModelProcessor().process());
+    }
+    m_model_base = *m_model_processed;
 
     auto discreteControllerBaseUPtr = make_unique<DiscreteController>();
     m_discrete_controller_base.reset(discreteControllerBaseUPtr.get());
@@ -186,6 +210,8 @@ void MocoProblemRep::initialize() {
     // its constraints below.
     m_state_disabled_constraints[0] = m_model_disabled_constraints.initSystem();
     m_state_disabled_constraints[1] = m_state_disabled_constraints[0];
+    m_muscle_group =
+            DeGrooteFregly2016MuscleGroup(m_model_disabled_constraints);
 
     // See comment above for m_position_motion_base.
     if (m_prescribedKinematics) {
@@ -487,20 +513,43 @@ void MocoProblemRep::initialize() {
         }
     }
 
-    // Auxiliary state implicit residual outputs.
+    // Auxiliary states with dynamics in implicit form.
+    std::set<std::string> implicitStatePaths;
+    for (const auto& component :
+            m_model_disabled_constraints.getComponentList()) {
+        const auto stateNames = component.getImplicitStateVariableNames();
+        if (stateNames.empty()) continue;
+        m_implicit_residual_components.emplace_back(
+                &component, (int)stateNames.size());
+        for (const auto& stateName : stateNames) {
+            m_implicit_component_refs.emplace_back(
+                    Component::getImplicitDerivativeName(stateName),
+                    &component);
+            implicitStatePaths.insert(
+                    component.getAbsolutePathString() + "/" + stateName);
+        }
+    }
+
+    // Auxiliary state implicit residual outputs, for components that do not
+    // provide their residuals through computeImplicitResiduals().
     const auto allImplicitResiduals = getModelOutputReferencePtrs<double>(
             m_model_disabled_constraints, "^implicitresidual_.*", true);
     for (const auto& output : allImplicitResiduals) {
         const auto& component = output->getOwner();
         const auto nameStart = output->getName().find("_") + 1;
         const std::string stateName = output->getName().substr(nameStart);
+        if (implicitStatePaths.count(
+                    component.getAbsolutePathString() + "/" + stateName)) {
+            continue;
+        }
         bool enabled = component.getOutputValue<bool>(
                 m_state_disabled_constraints[0],
                 "implicitenabled_" + stateName);
         if (enabled) {
             m_implicit_residual_refs.emplace_back(output.get());
             m_implicit_component_refs.emplace_back(
-                    "implicitderiv_" + stateName, &component);
+                    Component::getImplicitDerivativeName(stateName),
+                    &component);
         }
     }
 
@@ -774,6 +823,23 @@ const std::vector<MocoVariableInfo>& MocoProblemRep::getMultiplierInfos(
     }
 }
 
+void MocoProblemRep::calcImplicitResiduals(
+        const SimTK::State& state, SimTK::Vector& residuals) const {
+    residuals.resize(getNumImplicitAuxiliaryResiduals());
+    int offset = 0;
+    SimTK::Vector componentResiduals;
+    for (const auto& entry : m_implicit_residual_components) {
+        componentResiduals.resize(entry.second);
+        componentResiduals = 0;
+        entry.first->computeImplicitResiduals(state, componentResiduals);
+        residuals(offset, entry.second) = componentResiduals;
+        offset += entry.second;
+    }
+    for (const auto& output : m_implicit_residual_refs) {
+        residuals[offset++] = output->getValue(state);
+    }
+}
+
 void MocoProblemRep::applyParametersToModelProperties(
         const SimTK::Vector& parameterValues,
         bool initSystemAndDisableConstraints) const {
@@ -782,9 +848,30 @@ void MocoProblemRep::applyParametersToModelProperties(
             "There are {} parameters in this MocoProblem, but {} values were "
             "provided.",
             m_parameters.size(), parameterValues.size());
+    // The solvers apply the same values for every time point of an iterate
+    // (e.g., from each thread of CasADi); rebuilding the system is only
+    // necessary when the values change.
+    if ((int)m_applied_parameter_values.size() == parameterValues.size() &&
+            (m_applied_parameters_initialized_system ||
+                    !initSystemAndDisableConstraints)) {
+        bool unchanged = true;
+        for (int i = 0; i < parameterValues.size(); ++i) {
+            if (parameterValues[i] != m_applied_parameter_values[i]) {
+                unchanged = false;
+                break;
+            }
+        }
+        if (unchanged) return;
+    }
     for (int i = 0; i < (int)m_parameters.size(); ++i) {
         m_parameters[i]->applyParameterToModelProperties(parameterValues(i));
     }
+    m_states_disabled_constraints_at_time.clear();
+    m_applied_parameter_values.resize(parameterValues.size());
+    for (int i = 0; i < parameterValues.size(); ++i) {
+        m_applied_parameter_values[i] = parameterValues[i];
+    }
+    m_applied_parameters_initialized_system = initSystemAndDisableConstraints;
     if (initSystemAndDisableConstraints) {
         // TODO: Avoid these const_casts.
 
@@ -831,6 +918,22 @@ void MocoProblemRep::applyParametersToModelProperties(
             }
         }
     }
+    m_muscle_group.updateParameters();
+}
+
+SimTK::State& MocoProblemRep::updStateDisabledConstraintsAtTime(
+        double time) const {
+    auto it = m_states_disabled_constraints_at_time.find(time);
+    if (it == m_states_disabled_constraints_at_time.end()) {
+        SimTK::State state = m_state_disabled_constraints[0];
+        state.setTime(time);
+        m_model_disabled_constraints.getSystem().prescribe(state);
+        m_model_disabled_constraints.realizeVelocity(state);
+        it = m_states_disabled_constraints_at_time
+                     .emplace(time, std::move(state))
+                     .first;
+    }
+    return it->second;
 }
 
 void MocoProblemRep::printDescription() const {
@@ -27,6 +27,9 @@
 #include <OpenSim/Common/Assertion.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Actuators/DeGrooteFregly2016Muscle.h>
+#include <OpenSim/Actuators/DeGrooteFregly2016MuscleGroup.h>
+
+#include <map>
 
 namespace OpenSim {
 
@@ -66,15 +69,24 @@ public:
     MocoProblemRep(const MocoProblemRep&) = delete;
     MocoProblemRep& operator=(const MocoProblemRep&) = delete;
     MocoProblemRep(MocoProblemRep&& source)
-            : m_problem(std::move(source.m_problem)) {
+            : m_problem(std::move(source.m_problem)),
+              m_model_processed(std::move(source.m_model_processed)) {
         if (m_problem) initialize();
     }
     MocoProblemRep& operator=(MocoProblemRep&& source) {
         m_problem = std::move(source.m_problem);
+        m_model_processed = std::move(source.m_model_processed);
         if (m_problem) initialize();
         return *this;
     }
 
+    /// Create another instance of MocoProblemRep for the same MocoProblem,
+    /// whose models are built from the model already processed by this
+    /// instance: the ModelProcessor is not invoked again. Solvers use this to
+    /// create an instance for each thread (see
+    /// MocoSolver::createProblemRepJar()).
+    std::unique_ptr<MocoProblemRep> createRepHeap() const;
+
     const std::string& getName() const;
 
     /// Get a reference to the copy of the model being used by this
@@ -115,6 +127,19 @@ public:
         OPENSIM_ASSERT(index <= 1);
         return m_state_disabled_constraints[index];
     }
+    /// For problems with prescribed kinematics, a state for
+    /// ModelDisabledConstraints whose time is `time` and whose prescribed
+    /// positions and velocities have been applied and realized to
+    /// SimTK::Stage::Velocity. The state is created (as a copy of
+    /// updStateDisabledConstraints()) the first time it is requested for a
+    /// given time and kept for later requests, so that solvers that only
+    /// change the auxiliary states, controls, and discrete variables of the
+    /// state compute the kinematics (and the path lengths, moment arms, etc.)
+    /// once per time point instead of once per evaluation. The states are
+    /// discarded when the parameters change (see
+    /// applyParametersToModelProperties()). The times should come from a
+    /// fixed grid, since a state is kept for each distinct time.
+    SimTK::State& updStateDisabledConstraintsAtTime(double time) const;
     /// This is a component inside ModelDisabledConstraints that you can use to
     /// set the value of control signals.
     const DiscreteController& getDiscreteControllerDisabledConstraints() const {
@@ -148,7 +173,7 @@ public:
     /// coordinates, speeds, and accelerations?
     bool isPrescribedKinematics() const { return m_prescribedKinematics; }
     int getNumImplicitAuxiliaryResiduals() const {
-        return (int)m_implicit_residual_refs.size();
+        return (int)m_implicit_component_refs.size();
     }
     /// This excludes generalized coordinate and speed states if
     /// isPrescribedKinematics() is true.
@@ -292,6 +317,29 @@ public:
         return errors;
     }
 
+    /// Compute the fiber and tendon quantities and forces of all the
+    /// DeGrooteFregly2016Muscle%s in ModelDisabledConstraints at once (see
+    /// DeGrooteFregly2016MuscleGroup), after realizing `state` to
+    /// SimTK::Stage::Velocity. Solvers can call this before realizing `state`
+    /// to SimTK::Stage::Dynamics, so that the muscles use the cached values
+    /// instead of computing them one muscle at a time.
+    void calcMuscleGroupInfos(const SimTK::State& state) const {
+        if (!m_muscle_group.getNumMuscles()) return;
+        m_model_disabled_constraints.realizeVelocity(state);
+        m_muscle_group.calcMuscleInfos(state);
+    }
+    /// Compute the quantities of the muscles in all of `states` at once,
+    /// which must be distinct states of ModelDisabledConstraints (e.g., from
+    /// updStateDisabledConstraintsAtTime()).
+    void calcMuscleGroupInfos(
+            const std::vector<const SimTK::State*>& states) const {
+        if (!m_muscle_group.getNumMuscles()) return;
+        for (const SimTK::State* state : states) {
+            m_model_disabled_constraints.realizeVelocity(*state);
+        }
+        m_muscle_group.calcMuscleInfos(states);
+    }
+
     /// Apply paramater values to the models created from the model passed to
     /// initialize() within the current MocoProblem. Values must be consistent
     /// with the order of parameters returned from createParameterNames().
@@ -300,12 +348,28 @@ public:
     /// method in order for provided parameter values to be applied to the
     /// model. You can pass `true` to have initSystem() called for you, and to
     /// also re-disable any constraints re-enabled by the initSystem() call
-    /// (see getModelDisabledConstraints()).
+    /// (see getModelDisabledConstraints()). If the values are the same as
+    /// those of the previous call (and initSystem() was invoked for them, if
+    /// requested), this method does nothing, so that the models are not
+    /// rebuilt and the states are not reset for every time point.
     void applyParametersToModelProperties(const SimTK::Vector& parameterValues,
             bool initSystemAndDisableConstraints = false) const;
 
+    /// Compute the residuals of the dynamics in implicit form of the
+    /// components of the model returned by getModelDisabledConstraints(), in
+    /// the order of getImplicitComponentReferencePtrs(). These are the
+    /// residuals from Component::computeImplicitResiduals(), followed by the
+    /// values of the outputs from getImplicitResidualReferencePtrs().
+    /// `residuals` is resized to getNumImplicitAuxiliaryResiduals().
+    void calcImplicitResiduals(
+            const SimTK::State& state, SimTK::Vector& residuals) const;
+
     /// Get a vector of reference pointers to model outputs that return residual
-    /// values for any components with dynamics in implicit forms. The 
+    /// values for any components with dynamics in implicit forms, for
+    /// components that provide their residuals through outputs named
+    /// "implicitresidual_<state_name>" (with a boolean output
+    /// "implicitenabled_<state_name>") instead of through
+    /// Component::computeImplicitResiduals(). The
     /// references returned are from the model returned by 
     /// getModelDisabledConstraints(). 
     const std::vector<SimTK::ReferencePtr<const Output<double>>>&
@@ -376,7 +440,12 @@ private:
         return outputs;
     }
 
-    const MocoProblem* m_problem;
+    const MocoProblem* m_problem = nullptr;
+
+    /// The model from the ModelProcessor, before the components added by
+    /// initialize(). It is not modified, and is shared by the instances
+    /// created with createRepHeap().
+    std::shared_ptr<const Model> m_model_processed;
 
     Model m_model_base;
     mutable SimTK::State m_state_base;
@@ -385,12 +454,15 @@ private:
 
     Model m_model_disabled_constraints;
     mutable std::array<SimTK::State, 2> m_state_disabled_constraints;
+    mutable std::map<double, SimTK::State>
+            m_states_disabled_constraints_at_time;
     SimTK::ReferencePtr<const DiscreteController>
             m_discrete_controller_disabled_constraints;
     SimTK::ReferencePtr<const PositionMotion>
             m_position_motion_disabled_constraints;
     SimTK::ReferencePtr<DiscreteForces> m_constraint_forces;
     SimTK::ReferencePtr<AccelerationMotion> m_acceleration_motion;
+    mutable DeGrooteFregly2016MuscleGroup m_muscle_group;
 
     bool m_prescribedKinematics = false;
 
@@ -398,6 +470,10 @@ private:
     std::unordered_map<std::string, MocoVariableInfo> m_control_infos;
 
     std::vector<std::unique_ptr<MocoParameter>> m_parameters;
+    // The values last passed to applyParametersToModelProperties(), and
+    // whether initSystem() was invoked for them.
+    mutable std::vector<double> m_applied_parameter_values;
+    mutable bool m_applied_parameters_initialized_system = false;
     std::vector<std::unique_ptr<MocoGoal>> m_costs;
     std::vector<std::unique_ptr<MocoGoal>> m_endpoint_constraints;
     std::vector<std::unique_ptr<MocoPathConstraint>> m_path_constraints;
@@ -409,6 +485,10 @@ private:
     std::vector<std::string>
             m_kinematic_constraint_eq_names_without_derivatives;
 
+    // The components whose residuals are from computeImplicitResiduals(), and
+    // the number of their residuals.
+    std::vector<std::pair<SimTK::ReferencePtr<const Component>, int>>
+            m_implicit_residual_components;
     std::vector<SimTK::ReferencePtr<const Output<double>>>
             m_implicit_residual_refs;
     std::vector<std::pair<std::string, SimTK::ReferencePtr<const Component>>>
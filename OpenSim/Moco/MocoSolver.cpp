@@ -81,7 +81,7 @@ MocoTrajectory MocoSolver::createGuessTimeStepping() const {
 
 void MocoSolver::resetProblem(const MocoProblem& problem) const {
     m_problem.reset(&problem);
-    m_problemRep = problem.createRep();
+    m_problemRep = problem.createRepHeap();
 }
 
 MocoSolution MocoSolver::solve() const {
@@ -105,7 +105,7 @@ std::unique_ptr<ThreadsafeJar<const MocoProblemRep>>
         MocoSolver::createProblemRepJar(int size) const {
     auto jar = OpenSim::make_unique<ThreadsafeJar<const MocoProblemRep>>();
     for (int i = 0; i < size; ++i) {
-        jar->leave(std::unique_ptr<MocoProblemRep>(m_problem->createRepHeap()));
+        jar->leave(getProblemRep().createRepHeap());
     }
     return jar;
 }
@@ -90,10 +90,13 @@ protected:
                     {});
 
     const MocoProblemRep& getProblemRep() const {
-        return m_problemRep;
+        OPENSIM_THROW_IF(!m_problemRep, Exception, "Problem not set.");
+        return *m_problemRep;
     }
 
     /// Create a library of MocoProblemRep%s for use in parallelized code.
+    /// The MocoProblemRep%s reuse the model processed for getProblemRep()
+    /// (see MocoProblemRep::createRepHeap()).
     // TODO SWIG ignore.
     std::unique_ptr<ThreadsafeJar<const MocoProblemRep>>
     createProblemRepJar(int size) const;
@@ -110,7 +113,8 @@ private:
     virtual MocoSolution solveImpl() const = 0;
 
     mutable SimTK::ReferencePtr<const MocoProblem> m_problem;
-    mutable SimTK::ResetOnCopy<MocoProblemRep> m_problemRep;
+    // This is a pointer because moving a MocoProblemRep initializes it again.
+    mutable SimTK::ResetOnCopy<std::unique_ptr<MocoProblemRep>> m_problemRep;
 
 };
 
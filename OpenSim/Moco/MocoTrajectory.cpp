@@ -21,10 +21,17 @@
 #include "MocoUtilities.h"
 
 #include <OpenSim/Common/Assertion.h>
+#include <OpenSim/Common/OSBFileAdapter.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Common/GCVSplineSet.h>
+#ifdef WITH_HDF5
+#include <OpenSim/Common/HDF5FileAdapter.h>
+#endif
 #include <OpenSim/Simulation/Model/Model.h>
 
+#include <map>
+#include <set>
+
 using namespace OpenSim;
 
 const std::vector<std::string> MocoTrajectory::m_allowedKeys =
@@ -52,21 +59,23 @@ MocoTrajectory::MocoTrajectory(
           m_derivative_names(std::move(derivative_names)),
           m_parameter_names(std::move(parameter_names)) {}
 
-MocoTrajectory::MocoTrajectory(const SimTK::Vector& time,
+MocoTrajectory::MocoTrajectory(SimTK::Vector time,
         std::vector<std::string> state_names,
         std::vector<std::string> control_names,
         std::vector<std::string> multiplier_names,
         std::vector<std::string> parameter_names,
-        const SimTK::Matrix& statesTrajectory,
-        const SimTK::Matrix& controlsTrajectory,
-        const SimTK::Matrix& multipliersTrajectory,
-        const SimTK::RowVector& parameters)
-        : m_time(time), m_state_names(std::move(state_names)),
+        SimTK::Matrix statesTrajectory,
+        SimTK::Matrix controlsTrajectory,
+        SimTK::Matrix multipliersTrajectory,
+        SimTK::RowVector parameters)
+        : m_time(std::move(time)), m_state_names(std::move(state_names)),
           m_control_names(std::move(control_names)),
           m_multiplier_names(std::move(multiplier_names)),
           m_parameter_names(std::move(parameter_names)),
-          m_states(statesTrajectory), m_controls(controlsTrajectory),
-          m_multipliers(multipliersTrajectory), m_parameters(parameters) {
+          m_states(std::move(statesTrajectory)),
+          m_controls(std::move(controlsTrajectory)),
+          m_multipliers(std::move(multipliersTrajectory)),
+          m_parameters(std::move(parameters)) {
     OPENSIM_THROW_IF((int)m_state_names.size() != m_states.ncol(), Exception,
             "Inconsistent number of states.");
     OPENSIM_THROW_IF((int)m_control_names.size() != m_controls.ncol(),
@@ -74,23 +83,23 @@ MocoTrajectory::MocoTrajectory(const SimTK::Vector& time,
     OPENSIM_THROW_IF((int)m_multiplier_names.size() != m_multipliers.ncol(),
             Exception, "Inconsistent number of multipliers.");
     if (m_states.ncol()) {
-        OPENSIM_THROW_IF(time.size() != m_states.nrow(), Exception,
-                "Expected states to have {} rows but it has {}.", time.size(),
-                m_states.nrow());
+        OPENSIM_THROW_IF(m_time.size() != m_states.nrow(), Exception,
+                "Expected states to have {} rows but it has {}.",
+                m_time.size(), m_states.nrow());
     } else {
         m_states.resize(m_time.size(), 0);
     }
     if (m_controls.ncol()) {
-        OPENSIM_THROW_IF(time.size() != m_controls.nrow(), Exception,
-                "Expected controls to have {} rows but it has {}.", time.size(),
-                m_controls.nrow());
+        OPENSIM_THROW_IF(m_time.size() != m_controls.nrow(), Exception,
+                "Expected controls to have {} rows but it has {}.",
+                m_time.size(), m_controls.nrow());
     } else {
         m_controls.resize(m_time.size(), 0);
     }
     if (m_multipliers.ncol()) {
-        OPENSIM_THROW_IF(time.size() != m_multipliers.nrow(), Exception,
+        OPENSIM_THROW_IF(m_time.size() != m_multipliers.nrow(), Exception,
                 "Expected multipliers to have {} rows but it has {}.",
-                time.size(), m_multipliers.nrow());
+                m_time.size(), m_multipliers.nrow());
     } else {
         m_multipliers.resize(m_time.size(), 0);
     }
@@ -99,26 +108,28 @@ MocoTrajectory::MocoTrajectory(const SimTK::Vector& time,
             Exception, "Inconsistent number of parameters.");
 }
 
-MocoTrajectory::MocoTrajectory(const SimTK::Vector& time,
+MocoTrajectory::MocoTrajectory(SimTK::Vector time,
         std::vector<std::string> state_names,
         std::vector<std::string> control_names,
         std::vector<std::string> multiplier_names,
         std::vector<std::string> derivative_names,
         std::vector<std::string> parameter_names,
-        const SimTK::Matrix& statesTrajectory,
-        const SimTK::Matrix& controlsTrajectory,
-        const SimTK::Matrix& multipliersTrajectory,
-        const SimTK::Matrix& derivativesTrajectory,
-        const SimTK::RowVector& parameters)
-        : MocoTrajectory(time, state_names, control_names, multiplier_names,
-                  parameter_names, statesTrajectory, controlsTrajectory,
-                  multipliersTrajectory, parameters) {
-    m_derivative_names = derivative_names;
-    m_derivatives = derivativesTrajectory;
+        SimTK::Matrix statesTrajectory,
+        SimTK::Matrix controlsTrajectory,
+        SimTK::Matrix multipliersTrajectory,
+        SimTK::Matrix derivativesTrajectory,
+        SimTK::RowVector parameters)
+        : MocoTrajectory(std::move(time), std::move(state_names),
+                  std::move(control_names), std::move(multiplier_names),
+                  std::move(parameter_names), std::move(statesTrajectory),
+                  std::move(controlsTrajectory),
+                  std::move(multipliersTrajectory), std::move(parameters)) {
+    m_derivative_names = std::move(derivative_names);
+    m_derivatives = std::move(derivativesTrajectory);
     OPENSIM_THROW_IF((int)m_derivative_names.size() != m_derivatives.ncol(),
             Exception, "Inconsistent number of derivatives.");
     if (m_derivatives.ncol()) {
-        OPENSIM_THROW_IF((int)time.size() != m_derivatives.nrow(), Exception,
+        OPENSIM_THROW_IF((int)m_time.size() != m_derivatives.nrow(), Exception,
                 "Inconsistent number of times in derivatives trajectory.");
     } else {
         m_derivatives.resize(m_time.size(), 0);
@@ -849,8 +860,138 @@ MocoTrajectory::MocoTrajectory(const std::string& filepath) {
     }
 }
 
+namespace {
+bool isOSBFile(const std::string& filepath) {
+    return IO::EndsWith(IO::Lowercase(filepath), ".osb");
+}
+int getNumVariables(const TimeSeriesTable& table, const std::string& key) {
+    int num;
+    SimTK::convertStringTo(
+            table.getTableMetaData().getValueForKey(key).getValue<std::string>(),
+            num);
+    OPENSIM_THROW_IF(num < 0, Exception, "Invalid {}.", key);
+    return num;
+}
+} // anonymous namespace
+
+MocoTrajectory::MocoTrajectory(const std::string& filepath,
+        const std::vector<std::string>& variableNames, double initialTime,
+        double finalTime) {
+    TimeSeriesTable table;
+    std::vector<std::string> allNames;
+    // The values of the parameters are in the first row, which may be
+    // outside of the time window.
+    std::map<std::string, double> firstRow;
+    const bool isOSB = isOSBFile(filepath);
+    if (isOSB) {
+        allNames = OSBFileAdapter::readColumnLabels(filepath);
+        table = OSBFileAdapter::readColumns(
+                filepath, variableNames, initialTime, finalTime);
+    } else {
+        TimeSeriesTable fullTable(filepath);
+        allNames = fullTable.getColumnLabels();
+        std::vector<double> times;
+        std::vector<int> rows;
+        const auto& fullTimes = fullTable.getIndependentColumn();
+        for (int i = 0; i < (int)fullTimes.size(); ++i) {
+            if (fullTimes[i] >= initialTime && fullTimes[i] <= finalTime) {
+                times.push_back(fullTimes[i]);
+                rows.push_back(i);
+            }
+        }
+        const auto& names = variableNames.empty() ? allNames : variableNames;
+        SimTK::Matrix matrix((int)rows.size(), (int)names.size());
+        for (int j = 0; j < (int)names.size(); ++j) {
+            OPENSIM_THROW_IF(!fullTable.hasColumn(names[j]), KeyNotFound,
+                    names[j]);
+            const auto column = fullTable.getDependentColumn(names[j]);
+            for (int i = 0; i < (int)rows.size(); ++i) {
+                matrix(i, j) = column[rows[i]];
+            }
+        }
+        table = TimeSeriesTable(std::move(times), std::move(matrix), names);
+        table.updTableMetaData() = fullTable.getTableMetaData();
+        if (fullTable.getNumRows()) {
+            for (const auto& name : allNames) {
+                firstRow[name] = fullTable.getDependentColumn(name)[0];
+            }
+        }
+    }
+
+    const int numStates = getNumVariables(table, "num_states");
+    const int numControls = getNumVariables(table, "num_controls");
+    const int numMultipliers = getNumVariables(table, "num_multipliers");
+    const int numDerivatives = getNumVariables(table, "num_derivatives");
+    const int numSlacks = getNumVariables(table, "num_slacks");
+    const int numParameters = getNumVariables(table, "num_parameters");
+    OPENSIM_THROW_IF(numStates + numControls + numMultipliers + numDerivatives +
+                                     numSlacks + numParameters !=
+                             (int)allNames.size(),
+            Exception,
+            "Expected num_states + num_controls + num_multipliers + "
+            "num_derivatives + num_slacks + num_parameters = "
+            "number of columns, but the sum is {} and there are {} columns.",
+            numStates + numControls + numMultipliers + numDerivatives +
+                    numSlacks + numParameters,
+            allNames.size());
+
+    // Keep the variables in the order of the file, grouped by kind.
+    const std::set<std::string> selected(
+            variableNames.begin(), variableNames.end());
+    std::vector<std::string>* groups[] = {&m_state_names, &m_control_names,
+            &m_multiplier_names, &m_derivative_names, &m_slack_names,
+            &m_parameter_names};
+    const int groupSizes[] = {numStates, numControls, numMultipliers,
+            numDerivatives, numSlacks, numParameters};
+    int offset = 0;
+    for (int igroup = 0; igroup < 6; ++igroup) {
+        for (int i = offset; i < offset + groupSizes[igroup]; ++i) {
+            if (selected.empty() || selected.count(allNames[i])) {
+                groups[igroup]->push_back(allNames[i]);
+            }
+        }
+        offset += groupSizes[igroup];
+    }
+
+    const auto& time = table.getIndependentColumn();
+    const int numTimes = (int)time.size();
+    m_time = SimTK::Vector(numTimes, time.data());
+    const auto fill = [&](const std::vector<std::string>& names,
+                              SimTK::Matrix& matrix) {
+        matrix.resize(numTimes, (int)names.size());
+        for (int j = 0; j < (int)names.size(); ++j) {
+            matrix.updCol(j) = table.getDependentColumn(names[j]);
+        }
+    };
+    fill(m_state_names, m_states);
+    fill(m_control_names, m_controls);
+    fill(m_multiplier_names, m_multipliers);
+    fill(m_derivative_names, m_derivatives);
+    fill(m_slack_names, m_slacks);
+    m_parameters.resize((int)m_parameter_names.size());
+    for (int i = 0; i < (int)m_parameter_names.size(); ++i) {
+        const auto& name = m_parameter_names[i];
+        m_parameters[i] = isOSB ? OSBFileAdapter::readColumns(filepath, {name})
+                                          .getDependentColumn(name)[0]
+                                : firstRow.at(name);
+    }
+}
+
 void MocoTrajectory::write(const std::string& filepath) const {
     ensureUnsealed();
+    if (isOSBFile(filepath)) {
+        OSBFileAdapter::write(convertToTable(), filepath);
+        return;
+    }
+    if (IO::EndsWith(IO::Lowercase(filepath), ".h5")) {
+#ifdef WITH_HDF5
+        HDF5FileAdapter::write(convertToTable(), filepath);
+        return;
+#else
+        OPENSIM_THROW(Exception, "Cannot write '{}': OpenSim was built "
+                "without HDF5 (OPENSIM_WITH_HDF5).", filepath);
+#endif
+    }
     STOFileAdapter::write(convertToTable(), filepath);
 }
 
@@ -1301,73 +1442,108 @@ double MocoTrajectory::compareContinuousVariablesRMSInternal(
                                multiplierNames.size() + derivativeNames.size());
     if (numColumns == 0) return 0;
 
-    std::vector<double> selfTime =
-            std::vector<double>(&m_time[0], &m_time[0] + m_time.size());
-    std::vector<double> otherTime = std::vector<double>(
-            &other.m_time[0], &other.m_time[0] + other.m_time.size());
-
-    const auto initialTime = std::min(selfTime.front(), otherTime.front());
-    const auto finalTime = std::max(selfTime.back(), otherTime.back());
+    const auto initialTime = std::min(m_time[0], other.m_time[0]);
+    const auto finalTime = std::max(m_time[m_time.size() - 1],
+            other.m_time[other.m_time.size() - 1]);
     const auto numTimes = std::max(getNumTimes(), other.getNumTimes());
     // Times to use for integrating over time.
     auto integTime = createVectorLinspace(numTimes, initialTime, finalTime);
     const auto timeInterval = integTime[1] - integTime[0];
-
-    auto integralSumSquaredError =
-            [&selfTime, &otherTime, &numTimes, &integTime, &timeInterval](
-                    const VecStr& namesToUse, const SimTK::Matrix& selfData,
-                    const VecStr& selfNames, const SimTK::Matrix& otherData,
-                    const VecStr& otherNames) -> double {
-        if (namesToUse.empty()) return 0;
-
-        TimeSeriesTable selfTable(selfTime, selfData, selfNames);
-        TimeSeriesTable otherTable(otherTime, otherData, otherNames);
-
-        GCVSplineSet self(selfTable, namesToUse,
-                std::min((int)selfTable.getNumRows() - 1, 5));
-        GCVSplineSet other(otherTable, namesToUse,
-                std::min((int)otherTable.getNumRows() - 1, 5));
-
-        SimTK::Vector sumSquaredError(numTimes, 0.0);
-        for (int itime = 0; itime < numTimes; ++itime) {
-            const auto& curTime = integTime[itime];
-            SimTK::Vector curTimeVec(1, curTime);
-            bool selfInRange =
-                    self.getMinX() <= curTime && curTime <= self.getMaxX();
-            bool otherInRange =
-                    other.getMinX() <= curTime && curTime <= other.getMaxX();
-            for (int iname = 0; iname < (int)namesToUse.size(); ++iname) {
-                double selfValue =
-                        selfInRange ? self.get(iname).calcValue(curTimeVec) : 0;
-                double otherValue =
-                        otherInRange ? other.get(iname).calcValue(curTimeVec)
-                                     : 0;
-                sumSquaredError[itime] += SimTK::square(selfValue - otherValue);
+    OPENSIM_ASSERT(numTimes > 2);
+
+    // Fit the splines of all the columns to compare in a single set for each
+    // trajectory (so that they are fit together; see GCVSplineSet), from a
+    // table with only those columns.
+    auto createSplines = [&](const MocoTrajectory& traj) {
+        std::vector<std::string> labels;
+        SimTK::Matrix data(traj.getNumTimes(), numColumns);
+        auto addColumns = [&](const VecStr& namesToUse,
+                                  const SimTK::Matrix& values,
+                                  const VecStr& names) {
+            for (const auto& name : namesToUse) {
+                const auto index = std::distance(names.cbegin(),
+                        std::find(names.cbegin(), names.cend(), name));
+                data.updCol((int)labels.size()) = values.col((int)index);
+                labels.push_back(name);
             }
+        };
+        addColumns(stateNames, traj.m_states, traj.m_state_names);
+        addColumns(controlNames, traj.m_controls, traj.m_control_names);
+        addColumns(multiplierNames, traj.m_multipliers,
+                traj.m_multiplier_names);
+        addColumns(derivativeNames, traj.m_derivatives,
+                traj.m_derivative_names);
+        const std::vector<double> time(
+                &traj.m_time[0], &traj.m_time[0] + traj.m_time.size());
+        return std::unique_ptr<GCVSplineSet>(
+                new GCVSplineSet(TimeSeriesTable(time, data, labels), {},
+                        std::min(traj.getNumTimes() - 1, 5)));
+    };
+    const auto selfSplines = createSplines(*this);
+    const auto otherSplines = createSplines(other);
+
+    // The times of the integration grid within the range of a spline set
+    // (outside the range, the values are 0).
+    auto findRange = [&](const GCVSplineSet& splines) {
+        int begin = 0;
+        while (begin < numTimes && integTime[begin] < splines.getMinX()) {
+            ++begin;
         }
+        int end = begin;
+        while (end < numTimes && integTime[end] <= splines.getMaxX()) {
+            ++end;
+        }
+        return std::make_pair(begin, end);
+    };
+    const auto selfRange = findRange(*selfSplines);
+    const auto otherRange = findRange(*otherSplines);
+    const SimTK::Vector selfTimes =
+            integTime(selfRange.first, selfRange.second - selfRange.first);
+    const SimTK::Vector otherTimes =
+            integTime(otherRange.first, otherRange.second - otherRange.first);
+
+    // Evaluate the splines of each column on the grid (searching the knot
+    // intervals incrementally along the grid) and integrate the squared
+    // error of the column in one pass, on several threads if there are many
+    // columns. Creating threads takes longer than evaluating small grids.
+    const int minEvaluationsPerThread = 10000;
+    const int numThreads = std::max(1,
+            std::min({getNumThreadsOrDefault(), numColumns,
+                    2 * numColumns * numTimes / minEvaluationsPerThread}));
+    std::vector<SimTK::Vector> selfValues(numThreads);
+    std::vector<SimTK::Vector> otherValues(numThreads);
+    std::vector<double> columnISS(numColumns);
+    parallelForEach(numColumns, numThreads, [&](int thread, int icol) {
+        SimTK::Vector& selfColumn = selfValues[thread];
+        SimTK::Vector& otherColumn = otherValues[thread];
+        selfSplines->getGCVSpline(icol)->evaluate(selfTimes, 0, selfColumn);
+        otherSplines->getGCVSpline(icol)->evaluate(
+                otherTimes, 0, otherColumn);
         // Trapezoidal rule for uniform grid:
         // dt / 2 (f_0 + 2f_1 + 2f_2 + 2f_3 + ... + 2f_{N-1} + f_N)
-        OPENSIM_ASSERT(numTimes > 2);
-        return timeInterval / 2.0 *
-               (sumSquaredError.sum() + sumSquaredError(1, numTimes - 2).sum());
-    };
-
-    const auto stateISS = integralSumSquaredError(stateNames, m_states,
-            m_state_names, other.m_states, other.m_state_names);
-    const auto controlISS = integralSumSquaredError(controlNames, m_controls,
-            m_control_names, other.m_controls, other.m_control_names);
-    const auto multiplierISS = integralSumSquaredError(multiplierNames,
-            m_multipliers, m_multiplier_names, other.m_multipliers,
-            other.m_multiplier_names);
-    const auto derivativeISS = integralSumSquaredError(derivativeNames,
-            m_derivatives, m_derivative_names, other.m_derivatives,
-            other.m_derivative_names);
+        double sum = 0;
+        for (int itime = 0; itime < numTimes; ++itime) {
+            const bool selfInRange =
+                    selfRange.first <= itime && itime < selfRange.second;
+            const bool otherInRange =
+                    otherRange.first <= itime && itime < otherRange.second;
+            const double selfValue =
+                    selfInRange ? selfColumn[itime - selfRange.first] : 0;
+            const double otherValue =
+                    otherInRange ? otherColumn[itime - otherRange.first] : 0;
+            const double weight =
+                    (itime == 0 || itime == numTimes - 1) ? 1.0 : 2.0;
+            sum += weight * SimTK::square(selfValue - otherValue);
+        }
+        columnISS[icol] = timeInterval / 2.0 * sum;
+    });
 
     // sqrt(1/(T*N) * integral_t (sum_is error_is^2 + sum_ic error_ic^2
     //                                          + sum_im error_im^2)
     // `is`: index for states; `ic`: index for controls;
     // `im`: index for multipliers.
-    const double ISS = stateISS + controlISS + multiplierISS + derivativeISS;
+    double ISS = 0;
+    for (const double iss : columnISS) ISS += iss;
     return sqrt(ISS / (finalTime - initialTime) / numColumns);
 }
 
@@ -108,7 +108,10 @@ values or coordinate speeds, which are part of the states trajectory. Note that
 these accessors create fresh data structures from the existing member variables,
 so repeated calls should be avoided. Similarly, the accessors
 getAccelerationsTrajectory() and getDerivativesWithoutAccelerationsTrajectory()
-are available to access subcomponents of the derivatives trajectory.
+are available to access subcomponents of the derivatives trajectory. To read
+these subcomponents without copying them, use the accessors ending in "View"
+(e.g., getValuesTrajectoryView()), which refer to the data of the trajectory
+and are only valid until the trajectory is changed or destroyed.
  */
 // Not using three-slash doxygen comments because that messes up verbatim.
 class OSIMMOCO_API MocoTrajectory {
@@ -127,28 +130,31 @@ public:
             std::vector<std::string> multiplier_names,
             std::vector<std::string> derivative_names,
             std::vector<std::string> parameter_names);
-    MocoTrajectory(const SimTK::Vector& time,
+    /// The time and trajectories are taken by value, so that temporaries
+    /// (or arguments passed with std::move()) are moved into the trajectory
+    /// rather than copied.
+    MocoTrajectory(SimTK::Vector time,
             std::vector<std::string> state_names,
             std::vector<std::string> control_names,
             std::vector<std::string> multiplier_names,
             std::vector<std::string> parameter_names,
-            const SimTK::Matrix& statesTrajectory,
-            const SimTK::Matrix& controlsTrajectory,
-            const SimTK::Matrix& multipliersTrajectory,
-            const SimTK::RowVector& parameters);
+            SimTK::Matrix statesTrajectory,
+            SimTK::Matrix controlsTrajectory,
+            SimTK::Matrix multipliersTrajectory,
+            SimTK::RowVector parameters);
     /// This constructor is for use with the implicit dynamics mode, and
     /// allows specifying a derivativesTrajectory.
-    MocoTrajectory(const SimTK::Vector& time,
+    MocoTrajectory(SimTK::Vector time,
             std::vector<std::string> state_names,
             std::vector<std::string> control_names,
             std::vector<std::string> multiplier_names,
             std::vector<std::string> derivative_names,
             std::vector<std::string> parameter_names,
-            const SimTK::Matrix& statesTrajectory,
-            const SimTK::Matrix& controlsTrajectory,
-            const SimTK::Matrix& multipliersTrajectory,
-            const SimTK::Matrix& derivativesTrajectory,
-            const SimTK::RowVector& parameters);
+            SimTK::Matrix statesTrajectory,
+            SimTK::Matrix controlsTrajectory,
+            SimTK::Matrix multipliersTrajectory,
+            SimTK::Matrix derivativesTrajectory,
+            SimTK::RowVector parameters);
 #ifndef SWIG
     /// This constructor allows you to control which
     /// data you provide for the trajectory. The possible keys for
@@ -162,11 +168,29 @@ public:
                     continuousVars,
             const NamesAndData<SimTK::RowVector>& parameters = {});
 #endif
-    /// Read a MocoTrajectory from an STO file (see STOFileAdapter). See output
-    /// of write() for the correct format.
+    /// Read a MocoTrajectory from an STO file (see STOFileAdapter), a binary
+    /// OSB file (see OSBFileAdapter), or an HDF5 file with one table (see
+    /// HDF5FileAdapter). See output of write() for the correct format.
     explicit MocoTrajectory(const std::string& filepath);
+    /// Read only the variables with the given names (e.g., the controls; all
+    /// the variables if `variableNames` is empty) at the times in
+    /// [initialTime, finalTime] from a file written by write(). The variables
+    /// keep their kind (state, control, etc.), and parameters keep their
+    /// values. For an OSB file, only these parts of the file are read, which
+    /// makes loading a part of a large trajectory (or a part of each of many
+    /// trajectories) much faster; an STO file is read completely.
+    MocoTrajectory(const std::string& filepath,
+            const std::vector<std::string>& variableNames,
+            double initialTime = -SimTK::Infinity,
+            double finalTime = SimTK::Infinity);
 
     virtual ~MocoTrajectory() = default;
+    // The destructor would otherwise suppress the move operations, so that
+    // returning or assigning a trajectory (or a MocoSolution) would copy it.
+    MocoTrajectory(const MocoTrajectory&) = default;
+    MocoTrajectory(MocoTrajectory&&) = default;
+    MocoTrajectory& operator=(const MocoTrajectory&) = default;
+    MocoTrajectory& operator=(MocoTrajectory&&) = default;
 
     /// Returns a dynamically-allocated copy of this trajectory. You must manage
     /// the memory for return value.
@@ -576,33 +600,48 @@ public:
         return m_derivatives;
     }
     SimTK::Matrix getValuesTrajectory() const {
+        return getValuesTrajectoryView();
+    }
+    SimTK::Matrix getSpeedsTrajectory() const {
+        return getSpeedsTrajectoryView();
+    }
+    SimTK::Matrix getAccelerationsTrajectory() const {
+        return getAccelerationsTrajectoryView();
+    }
+    SimTK::Matrix getDerivativesWithoutAccelerationsTrajectory() const {
+        return getDerivativesWithoutAccelerationsTrajectoryView();
+    }
+#ifndef SWIG
+    /// The coordinate values in the states trajectory, without copying them.
+    /// The view is invalidated by any change to the size of the trajectory.
+    SimTK::MatrixView getValuesTrajectoryView() const {
         ensureUnsealed();
         auto indices = getValueIndices();
         if (indices.empty()) indices.push_back(0);
-        return {m_states.block(0, indices[0],
-                m_states.nrow(), getNumValues())};
+        return m_states.block(0, indices[0], m_states.nrow(), getNumValues());
     }
-    SimTK::Matrix getSpeedsTrajectory() const {
+    SimTK::MatrixView getSpeedsTrajectoryView() const {
         ensureUnsealed();
         auto indices = getSpeedIndices();
         if (indices.empty()) indices.push_back(0);
-        return {m_states.block(0, indices[0],
-                m_states.nrow(), getNumSpeeds())};
+        return m_states.block(0, indices[0], m_states.nrow(), getNumSpeeds());
     }
-    SimTK::Matrix getAccelerationsTrajectory() const {
+    SimTK::MatrixView getAccelerationsTrajectoryView() const {
         ensureUnsealed();
         auto indices = getAccelerationIndices();
         if (indices.empty()) indices.push_back(0);
-        return {m_derivatives.block(0, indices[0],
-                m_derivatives.nrow(), getNumAccelerations())};
+        return m_derivatives.block(0, indices[0], m_derivatives.nrow(),
+                getNumAccelerations());
     }
-    SimTK::Matrix getDerivativesWithoutAccelerationsTrajectory() const {
+    SimTK::MatrixView getDerivativesWithoutAccelerationsTrajectoryView()
+            const {
         ensureUnsealed();
         auto indices = getDerivativeIndicesWithoutAccelerations();
         if (indices.empty()) indices.push_back(0);
-        return {m_derivatives.block(0, indices[0], m_derivatives.nrow(),
-                getNumDerivativesWithoutAccelerations())};
+        return m_derivatives.block(0, indices[0], m_derivatives.nrow(),
+                getNumDerivativesWithoutAccelerations());
     }
+#endif
     const SimTK::RowVector& getParameters() const {
         ensureUnsealed();
         return m_parameters;
@@ -701,7 +740,13 @@ public:
     /// @name Convert to other formats
     /// @{
 
-    /// Save the trajectory to a STO file. Use the ."sto" file extension.
+    /// Save the trajectory to a STO file, or to a binary OSB file (see
+    /// OSBFileAdapter) if the extension of `filepath` is ".osb". OSB files
+    /// are faster to write and read, and parts of them can be read without
+    /// reading the rest (see MocoTrajectory(const std::string&,
+    /// const std::vector<std::string>&, double, double)). If the extension
+    /// is ".h5", the trajectory is written to an HDF5 file (see
+    /// HDF5FileAdapter), which requires that OpenSim was built with HDF5.
     void write(const std::string& filepath) const;
 
     /// This table can be saved as a Storage file that can be used in the
@@ -22,6 +22,7 @@
 
 #include <OpenSim/Common/Assertion.h>
 #include <OpenSim/Common/Stopwatch.h>
+#include <OpenSim/Common/TraceEventRecorder.h>
 
 #ifdef OPENSIM_WITH_TROPTER
     #include "tropter/TropterProblem.h"
@@ -46,14 +47,17 @@ bool MocoTropterSolver::isAvailable() {
 }
 
 std::shared_ptr<const MocoTropterSolver::TropterProblemBase<double>>
-MocoTropterSolver::createTropterProblem() const {
+MocoTropterSolver::createTropterProblem(
+        std::unique_ptr<const MocoProblemRep> problemRep) const {
 #ifdef OPENSIM_WITH_TROPTER
     checkPropertyValueIsInSet(
             getProperty_multibody_dynamics_mode(), {"explicit", "implicit"});
     if (get_multibody_dynamics_mode() == "explicit") {
-        return std::make_shared<ExplicitTropterProblem<double>>(*this);
+        return std::make_shared<ExplicitTropterProblem<double>>(
+                *this, std::move(problemRep));
     } else if (get_multibody_dynamics_mode() == "implicit") {
-        return std::make_shared<ImplicitTropterProblem<double>>(*this);
+        return std::make_shared<ImplicitTropterProblem<double>>(
+                *this, std::move(problemRep));
     } else {
         OPENSIM_THROW_FRMOBJ(Exception, "Internal error.");
     }
@@ -197,6 +201,20 @@ MocoTropterSolver::createTropterSolver(
                         "print_level", get_optim_ipopt_print_level());
             }
         }
+        checkPropertyValueIsInSet(getProperty_optim_linear_solver(),
+                {"", "mumps", "ma27", "ma57", "ma77", "ma86", "ma97",
+                        "pardiso", "pardisomkl", "spral"});
+        const std::string& linearSolver = get_optim_linear_solver();
+        if (!linearSolver.empty()) {
+            optsolver.set_advanced_option_string("linear_solver", linearSolver);
+            // Keep the symbolic factorization when Pardiso perturbs the
+            // matrix, unless the inertia is still wrong.
+            if (linearSolver.compare(0, 7, "pardiso") == 0) {
+                optsolver.set_advanced_option_string(
+                        "pardiso_redo_symbolic_fact_only_if_inertia_wrong",
+                        "yes");
+            }
+        }
     }
     // Check that sparsity detection mode is valid.
     checkPropertyValueIsInSet(getProperty_optim_sparsity_detection(),
@@ -322,7 +340,16 @@ MocoSolution MocoTropterSolver::solveImpl() const {
             "MocoTropterSolver does not support prescribed kinematics. "
             "Try using prescribed motion constraints in the Coordinates.");
 
+    std::unique_ptr<TraceEventRecorder> recorder;
+    if (!get_trace_file().empty()) {
+        recorder = OpenSim::make_unique<TraceEventRecorder>();
+    }
+    TraceEventRecorder::Scope solveScope(
+            recorder.get(), "solver", "MocoTropterSolver");
+    TraceEventRecorder::Scope createScope(
+            recorder.get(), "solver", "create_problem");
     auto ocp = createTropterProblem();
+    ocp->setTraceRecorder(recorder.get());
 
     // Apply settings/options.
     // -----------------------
@@ -337,20 +364,42 @@ MocoSolution MocoTropterSolver::solveImpl() const {
         getProblemRep().printDescription();
     }
     auto dircol = createTropterSolver(ocp);
+
+    // Evaluate the mesh points in parallel, with a copy of the problem (and
+    // of its MocoProblemRep) for each additional thread.
+    const int numThreads = getNumParallelThreads();
+    if (numThreads > 1) {
+        auto jar = createProblemRepJar(numThreads - 1);
+        std::vector<std::shared_ptr<const tropter::Problem<double>>> copies;
+        for (int i = 1; i < numThreads; ++i) {
+            auto copy = createTropterProblem(jar->take());
+            copy->setTraceRecorder(recorder.get());
+            copies.push_back(std::move(copy));
+        }
+        dircol->set_thread_problems(std::move(copies));
+    }
+    if (get_verbosity()) {
+        log_info("Number of threads: {}", dircol->get_num_threads());
+    }
     MocoTrajectory guess = getGuess();
     tropter::Iterate tropIterate = ocp->convertToTropterIterate(guess);
+    createScope.finish();
 
     // Temporarily disable printing of negative muscle force warnings so the
     // output stream isn't flooded while computing finite differences.
     Logger::Level origLoggerLevel = Logger::getLevel();
     Logger::setLevel(Logger::Level::Warn);
     tropter::Solution tropSolution;
+    TraceEventRecorder::Scope optimizeScope(
+            recorder.get(), "solver", "optimize");
     try {
         tropSolution = dircol->solve(tropIterate);
     } catch (...) {
         OpenSim::Logger::setLevel(origLoggerLevel);
     }
     OpenSim::Logger::setLevel(origLoggerLevel);
+    optimizeScope.addArgument("iterations", tropSolution.num_iterations);
+    optimizeScope.finish();
 
     if (get_verbosity()) { dircol->print_constraint_values(tropSolution); }
 
@@ -408,6 +457,14 @@ MocoSolution MocoTropterSolver::solveImpl() const {
             tropSolution.objective, tropSolution.status,
             tropSolution.num_iterations, SimTK::nsToSec(elapsed));
 
+    if (recorder) {
+        solveScope.finish();
+        recorder->print(get_trace_file());
+        if (get_verbosity()) {
+            log_info("Wrote trace of the solver to '{}'.", get_trace_file());
+        }
+    }
+
     if (get_verbosity()) {
         log_info(std::string(72, '-'));
         log_info("Elapsed real time: {}", stopwatch.formatNs(elapsed));
@@ -34,6 +34,7 @@ class DirectCollocationSolver;
 namespace OpenSim {
 
 class MocoProblem;
+class MocoProblemRep;
 
 class MocoTropterSolverNotAvailable : public Exception {
 public:
@@ -58,6 +59,15 @@ property:
 - ipopt
 - snopt
 
+Parallelization
+===============
+The differential-algebraic equations and the integral cost integrands are
+evaluated in parallel across the mesh points, with one copy of the problem
+(and of the model) for each thread. The number of threads is set by the
+`parallel` property or by the OPENSIM_MOCO_PARALLEL environment variable, as
+for MocoCasADiSolver; set either to 0 to evaluate the mesh points serially.
+Ensure that custom model components are threadsafe.
+
 Using this solver in C++ requires that a tropter shared library is
 available, but tropter header files are not required. No tropter symbols
 are exposed in Moco's interface. */
@@ -149,8 +159,11 @@ protected:
     template <typename T>
     class ImplicitTropterProblem;
 
-    std::shared_ptr<const TropterProblemBase<double>>
-    createTropterProblem() const;
+    /// If `problemRep` is not null, the problem uses it instead of the
+    /// solver's MocoProblemRep (e.g., to evaluate mesh points on another
+    /// thread).
+    std::shared_ptr<const TropterProblemBase<double>> createTropterProblem(
+            std::unique_ptr<const MocoProblemRep> problemRep = nullptr) const;
     std::unique_ptr<tropter::DirectCollocationSolver<double>>
     createTropterSolver(
             std::shared_ptr<const TropterProblemBase<double>>
@@ -75,6 +75,20 @@ TimeSeriesTable_<T> analyzeMocoTrajectory(
             derivativesWithoutAccelerationsTable);
 }
 
+/// The same as analyzeMocoTrajectory(), but the outputs are computed with
+/// analyzeParallel() on `numThreads` threads (if not positive,
+/// getNumThreadsOrDefault() is used).
+/// @ingroup mocoutil
+template <typename T>
+TimeSeriesTable_<T> analyzeMocoTrajectoryParallel(const Model& model,
+        const MocoTrajectory& trajectory,
+        const std::vector<std::string>& outputPaths, int numThreads = -1) {
+    return analyzeParallel<T>(model, trajectory.exportToStatesTable(),
+            trajectory.exportToControlsTable(), outputPaths,
+            trajectory.exportToDerivativesWithoutAccelerationsTable(),
+            numThreads);
+}
+
 /// Given a MocoTrajectory and the associated OpenSim model, return the model
 /// with a prescribed controller appended that will compute the control values
 /// from the MocoTrajectory. This can be useful when computing state-dependent
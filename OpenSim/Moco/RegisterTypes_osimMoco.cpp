@@ -132,4 +132,6 @@ OSIMMOCO_API void RegisterTypes_osimMoco() {
 
 osimMocoInstantiator::osimMocoInstantiator() { registerDllClasses(); }
 
-void osimMocoInstantiator::registerDllClasses() { RegisterTypes_osimMoco(); }
+void osimMocoInstantiator::registerDllClasses() {
+    Object::deferTypeRegistration(RegisterTypes_osimMoco);
+}
@@ -1086,3 +1086,35 @@ TEST_CASE("MocoGoal divide by displacement/duration/mass") {
     CHECK_THAT(goalValues[1], Catch::WithinAbs(duration, SimTK::Eps));
     CHECK_THAT(goalValues[2], Catch::WithinAbs(mass, SimTK::Eps));
 }
+
+TEST_CASE("MocoReferenceCache") {
+    TimeSeriesTable table;
+    table.setColumnLabels({"a", "b"});
+    for (int i = 0; i < 11; ++i) {
+        const double time = 0.1 * i;
+        table.appendRow(time, {std::sin(time), time * time});
+    }
+    GCVSplineSet splines(table);
+    MocoReferenceCache cache;
+
+    // The values match the splines, whether the time is cached or not, and
+    // the times can be queried in any order.
+    for (int pass = 0; pass < 2; ++pass) {
+        for (double time : {0.05, 0.93, 0.5, 0.0, 1.0}) {
+            const double* values = cache.getValues(splines, time);
+            const SimTK::Vector timeVec(1, time);
+            for (int i = 0; i < splines.getSize(); ++i) {
+                CHECK_THAT(values[i], Catch::WithinAbs(
+                        splines[i].calcValue(timeVec), 1e-12));
+            }
+        }
+    }
+
+    // The cache stays correct when it is cleared because it is full.
+    for (int i = 0; i < 600000; ++i) {
+        cache.getValues(splines, 1e-6 * i);
+    }
+    CHECK_THAT(cache.getValues(splines, 0.5)[1],
+            Catch::WithinAbs(splines[1].calcValue(SimTK::Vector(1, 0.5)),
+                    1e-12));
+}
@@ -27,6 +27,8 @@
 #include <OpenSim/Simulation/SimbodyEngine/ScapulothoracicJoint.h>
 
 #include <fstream>
+#include <sstream>
+#include <type_traits>
 
 #define CATCH_CONFIG_MAIN
 #include "Testing.h"
@@ -225,6 +227,13 @@ TEMPLATE_TEST_CASE("Solver options", "", MocoCasADiSolver, MocoTropterSolver) {
     SimTK_TEST_MUST_THROW(study.solve());
     ms.set_optim_hessian_approximation("limited-memory");
 
+    ms.set_optim_linear_solver("nonexistent");
+    SimTK_TEST_MUST_THROW_EXC(study.solve(), Exception);
+    // MUMPS is built with OpenSim.
+    ms.set_optim_linear_solver("mumps");
+    SimTK_TEST(study.solve().isNumericallyEqual(solDefault, 1e-5));
+    ms.set_optim_linear_solver("");
+
     {
         ms.set_optim_max_iterations(1);
         MocoSolution solution = study.solve();
@@ -257,6 +266,303 @@ TEMPLATE_TEST_CASE("Solver options", "", MocoCasADiSolver, MocoTropterSolver) {
         ms.set_optim_constraint_tolerance(-1);
         ms.set_optim_convergence_tolerance(-1);
     }
+    {
+        const std::string traceFile = "testMocoInterface_trace.json";
+        ms.set_optim_max_iterations(3);
+        ms.set_trace_file(traceFile);
+        study.solve();
+        std::ifstream file(traceFile);
+        REQUIRE(file.good());
+        std::stringstream contents;
+        contents << file.rdbuf();
+        const std::string trace = contents.str();
+        CHECK(trace.find("\"traceEvents\"") != std::string::npos);
+        CHECK(trace.find("\"create_problem\"") != std::string::npos);
+        CHECK(trace.find("\"cat\":\"function\"") != std::string::npos);
+        if (std::is_same<TestType, MocoCasADiSolver>::value) {
+            CHECK(trace.find("\"name\":\"iteration\"") !=
+                    std::string::npos);
+            CHECK(trace.find("\"name\":\"explicit_multibody_system\"") !=
+                    std::string::npos);
+        }
+        ms.set_trace_file("");
+        ms.set_optim_max_iterations(-1);
+    }
+}
+
+TEST_CASE("MocoCasADiSolver sparsity pattern cache") {
+    const std::string cacheDir = "testMocoInterface_sparsity_cache";
+    const std::string traceFile = "testMocoInterface_sparsity_trace.json";
+    auto solveAndReadTrace = [&](MocoSolution& solution) {
+        MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+        auto& ms = study.updSolver<MocoCasADiSolver>();
+        ms.set_optim_sparsity_detection("random");
+        ms.set_optim_sparsity_cache_directory(cacheDir);
+        ms.set_trace_file(traceFile);
+        solution = study.solve();
+        std::ifstream file(traceFile);
+        REQUIRE(file.good());
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    };
+    // The first solve detects the patterns (unless they are left over from a
+    // previous run of this test), and the second solve loads them.
+    MocoSolution solutionDetect;
+    solveAndReadTrace(solutionDetect);
+    MocoSolution solutionCached;
+    const std::string traceCached = solveAndReadTrace(solutionCached);
+    CHECK(traceCached.find("\"cat\":\"sparsity_detection\"") ==
+            std::string::npos);
+    CHECK(solutionCached.isNumericallyEqual(solutionDetect));
+}
+
+TEST_CASE("MocoCasADiSolver code generation") {
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>(
+            "hermite-simpson");
+    auto& ms = study.updSolver<MocoCasADiSolver>();
+    MocoSolution solution = study.solve();
+    ms.set_codegen_directory("testMocoInterface_codegen");
+    // The first solve compiles the libraries (unless they are left over from
+    // a previous run of this test), and the second solve loads them.
+    MocoSolution solutionCompiled = study.solve();
+    MocoSolution solutionLoaded = study.solve();
+    CHECK(solutionCompiled.isNumericallyEqual(solution, 1e-6));
+    CHECK(solutionLoaded.isNumericallyEqual(solutionCompiled));
+}
+
+TEST_CASE("MocoCasADiSolver warm start") {
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    auto& ms = study.updSolver<MocoCasADiSolver>();
+    CHECK(ms.getWarmStart().empty());
+    MocoSolution solution = study.solve();
+    const MocoCasADiWarmStart warmStart = ms.getWarmStart();
+    REQUIRE(!warmStart.empty());
+    CHECK(warmStart.getIterate().isNumericallyEqual(solution));
+    CHECK(warmStart.getBoundMultipliers().getNumTimes() ==
+            solution.getNumTimes());
+
+    // Starting from the solution and its multipliers, the solver converges
+    // (almost) immediately.
+    ms.setWarmStart(warmStart);
+    MocoSolution solutionWarm = study.solve();
+    CHECK(solutionWarm.getNumIterations() <= 2);
+    CHECK(solutionWarm.isNumericallyEqual(solution, 1e-6));
+
+    // With a different mesh, the multipliers are discarded, and the iterate
+    // is used as a guess.
+    ms.set_num_mesh_intervals(29);
+    MocoSolution solutionRefined = study.solve();
+    CHECK(solutionRefined.success());
+    CHECK(solutionRefined.getNumIterations() <= solution.getNumIterations());
+
+    ms.clearWarmStart();
+    MocoSolution solutionCold = study.solve();
+    CHECK(solutionCold.getNumIterations() >= solutionWarm.getNumIterations());
+}
+
+TEST_CASE("MocoCasADiSolver checkpoints") {
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    auto& ms = study.updSolver<MocoCasADiSolver>();
+    MocoSolution solution = study.solve();
+    const int numIterations = solution.getNumIterations();
+    REQUIRE(numIterations > 4);
+
+    // Interrupt the solve before it converges.
+    const std::string prefix = "testMocoInterface_checkpoint";
+    ms.set_checkpoint_interval(1);
+    ms.set_checkpoint_file(prefix);
+    ms.set_optim_max_iterations(numIterations - 3);
+    MocoSolution unfinished = study.solve();
+    CHECK(!unfinished.success());
+
+    const MocoCasADiWarmStart checkpoint(prefix);
+    CHECK(checkpoint.getIterate().getNumTimes() == solution.getNumTimes());
+    CHECK(checkpoint.getBoundMultipliers().getNumTimes() ==
+            solution.getNumTimes());
+    CHECK(checkpoint.getConstraintMultipliers().size() ==
+            ms.getWarmStart().getConstraintMultipliers().size());
+    CHECK(checkpoint.getBarrierParameter() > 0);
+
+    // The resumed solve needs fewer iterations than a solve from the start.
+    ms.set_checkpoint_interval(0);
+    ms.set_optim_max_iterations(-1);
+    ms.resumeFromCheckpoint(prefix);
+    MocoSolution resumed = study.solve();
+    CHECK(resumed.success());
+    CHECK(resumed.getNumIterations() < numIterations);
+    CHECK(resumed.isNumericallyEqual(solution, 1e-5));
+}
+
+TEST_CASE("MocoCasADiSolver parallel thread pool") {
+    for (const std::string scheme : {"trapezoidal", "hermite-simpson"}) {
+        MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>(scheme);
+        auto& ms = study.updSolver<MocoCasADiSolver>();
+        ms.set_parallel(2);
+        MocoSolution solutionThread = study.solve();
+        ms.set_parallel_thread_pool(true);
+        MocoSolution solutionPool = study.solve();
+        CHECK(solutionPool.success());
+        CHECK(solutionPool.getNumIterations() ==
+                solutionThread.getNumIterations());
+        CHECK(solutionPool.isNumericallyEqual(solutionThread, 1e-8));
+    }
+}
+
+TEST_CASE("MocoTropterSolver parallel") {
+    const std::string dynamicsMode =
+            GENERATE(as<std::string>{}, "explicit", "implicit");
+    for (const std::string scheme : {"trapezoidal", "hermite-simpson"}) {
+        MocoStudy study = createSlidingMassMocoStudy<MocoTropterSolver>(scheme);
+        auto& ms = study.updSolver<MocoTropterSolver>();
+        ms.set_multibody_dynamics_mode(dynamicsMode);
+        ms.set_parallel(0);
+        MocoSolution solutionSerial = study.solve();
+        ms.set_parallel(3);
+        MocoSolution solutionParallel = study.solve();
+        CHECK(solutionParallel.success());
+        CHECK(solutionParallel.getNumIterations() ==
+                solutionSerial.getNumIterations());
+        CHECK(solutionParallel.isNumericallyEqual(solutionSerial, 1e-8));
+    }
+}
+
+TEST_CASE("MocoCasADiSolver parallel sparsity detection") {
+    // The sparsity patterns detected on multiple threads are the same as
+    // those detected serially, so the solver takes the same iterations.
+    MocoStudy study =
+            createSlidingMassMocoStudy<MocoCasADiSolver>("hermite-simpson");
+    auto& ms = study.updSolver<MocoCasADiSolver>();
+    ms.set_optim_sparsity_detection("random");
+    ms.set_optim_sparsity_detection_random_count(4);
+    ms.set_parallel(1);
+    MocoSolution solutionSerial = study.solve();
+    for (bool threadPool : {false, true}) {
+        ms.set_parallel(4);
+        ms.set_parallel_thread_pool(threadPool);
+        MocoSolution solution = study.solve();
+        CHECK(solution.success());
+        CHECK(solution.getNumIterations() ==
+                solutionSerial.getNumIterations());
+        CHECK(solution.isNumericallyEqual(solutionSerial, 1e-8));
+    }
+}
+
+TEST_CASE("MocoCasADiSolver batch evaluation") {
+    const std::string dynamicsMode =
+            GENERATE(as<std::string>{}, "explicit", "implicit");
+    const std::string sparsityDetection =
+            GENERATE(as<std::string>{}, "none", "random");
+    MocoStudy study =
+            createSlidingMassMocoStudy<MocoCasADiSolver>("hermite-simpson");
+    auto& ms = study.updSolver<MocoCasADiSolver>();
+    ms.set_multibody_dynamics_mode(dynamicsMode);
+    ms.set_optim_sparsity_detection(sparsityDetection);
+    MocoSolution solution = study.solve();
+    ms.set_optim_batch_evaluation(true);
+    MocoSolution solutionBatch = study.solve();
+    CHECK(solutionBatch.success());
+    CHECK(solutionBatch.getFinalTime() ==
+            Approx(solution.getFinalTime()).epsilon(1e-4));
+    CHECK(solutionBatch.compareContinuousVariablesRMS(solution) < 1e-3);
+}
+
+TEST_CASE("MocoCasADiSolver exact Hessian with sparsity detection") {
+    const bool batchEvaluation = GENERATE(false, true);
+    const std::string scheme =
+            GENERATE(as<std::string>{}, "central", "forward");
+    MocoStudy study =
+            createSlidingMassMocoStudy<MocoCasADiSolver>("hermite-simpson");
+    auto& ms = study.updSolver<MocoCasADiSolver>();
+    ms.set_optim_sparsity_detection("random");
+    ms.set_optim_batch_evaluation(batchEvaluation);
+    ms.set_optim_finite_difference_scheme(scheme);
+    MocoSolution solution = study.solve();
+    // The second derivatives are finite differences of the sparse Jacobians.
+    ms.set_optim_hessian_approximation("exact");
+    MocoSolution solutionExact = study.solve();
+    CHECK(solutionExact.success());
+    CHECK(solutionExact.getFinalTime() ==
+            Approx(solution.getFinalTime()).epsilon(1e-4));
+    CHECK(solutionExact.compareContinuousVariablesRMS(solution) < 1e-3);
+}
+
+TEST_CASE("MocoCasADiSolver automatic scaling") {
+    const std::string dynamicsMode =
+            GENERATE(as<std::string>{}, "explicit", "implicit");
+    MocoStudy study =
+            createSlidingMassMocoStudy<MocoCasADiSolver>("hermite-simpson");
+    auto& ms = study.updSolver<MocoCasADiSolver>();
+    ms.set_multibody_dynamics_mode(dynamicsMode);
+    MocoSolution solution = study.solve();
+    ms.set_scale_automatically(true);
+    MocoSolution solutionScaled = study.solve();
+    CHECK(solutionScaled.success());
+    CHECK(solutionScaled.getFinalTime() ==
+            Approx(solution.getFinalTime()).epsilon(1e-4));
+    CHECK(solutionScaled.compareContinuousVariablesRMS(solution) < 1e-3);
+
+    // The multipliers are unscaled, so a warm start from the scaled solve
+    // converges (almost) immediately.
+    ms.setWarmStart(ms.getWarmStart());
+    MocoSolution solutionWarm = study.solve();
+    CHECK(solutionWarm.getNumIterations() <= 2);
+    CHECK(solutionWarm.isNumericallyEqual(solutionScaled, 1e-6));
+}
+
+TEST_CASE("MocoCasADiSolver mesh refinement") {
+    MocoStudy study =
+            createSlidingMassMocoStudy<MocoCasADiSolver>("trapezoidal", 5);
+    auto& ms = study.updSolver<MocoCasADiSolver>();
+    MocoSolution solutionCoarse = study.solve();
+    ms.set_mesh_refinement_tolerance(1e-4);
+    MocoSolution solutionRefined = study.solve();
+    CHECK(solutionRefined.success());
+    CHECK(solutionRefined.getNumTimes() > solutionCoarse.getNumTimes());
+
+    ms.set_mesh_refinement_tolerance(-1);
+    ms.set_num_mesh_intervals(100);
+    MocoSolution solutionFine = study.solve();
+    CHECK(std::abs(solutionRefined.getFinalTime() -
+                   solutionFine.getFinalTime()) <
+            std::abs(solutionCoarse.getFinalTime() -
+                     solutionFine.getFinalTime()));
+}
+
+TEMPLATE_TEST_CASE("MocoBatch", "", MocoCasADiSolver, MocoTropterSolver) {
+    MocoBatch batch;
+    batch.setNumThreads(2);
+    const std::vector<int> numMeshIntervals{9, 14, 19};
+    for (int i = 0; i < (int)numMeshIntervals.size(); ++i) {
+        batch.addStudy(createSlidingMassMocoStudy<TestType>());
+    }
+    batch.setParameterization([&](int index, MocoStudy& study) {
+        if (index < (int)numMeshIntervals.size()) {
+            study.updSolver<TestType>().set_num_mesh_intervals(
+                    numMeshIntervals[index]);
+        }
+    });
+    const int firstStart = batch.addMultiStart(
+            createSlidingMassMocoStudy<TestType>(), 3, 5);
+    CHECK(firstStart == 3);
+    CHECK(batch.getNumStudies() == 6);
+    const std::vector<MocoSolution> solutions = batch.solve();
+    REQUIRE(solutions.size() == 6);
+
+    // The solutions are the same as those of solving the studies one at a
+    // time.
+    for (int i = 0; i < (int)numMeshIntervals.size(); ++i) {
+        MocoStudy study = createSlidingMassMocoStudy<TestType>();
+        study.updSolver<TestType>().set_num_mesh_intervals(numMeshIntervals[i]);
+        CHECK(solutions[i].isNumericallyEqual(study.solve()));
+    }
+    // The problem is convex, so all starts find the same solution.
+    for (int i = firstStart; i < (int)solutions.size(); ++i) {
+        REQUIRE(solutions[i].success());
+        CHECK(solutions[i].getFinalTime() ==
+                Approx(solutions[firstStart].getFinalTime()).epsilon(1e-4));
+    }
+    CHECK(MocoBatch::findBestSolution(solutions) >= 0);
 }
 
 TEMPLATE_TEST_CASE("Ordering of calls", "", MocoCasADiSolver,
@@ -417,6 +723,47 @@ TEST_CASE("Building a problem", "") {
             SimTK_TEST_MUST_THROW_EXC(mp.createRep(), Exception);
         }
     }
+    // Multi-phase problems are not supported.
+    {
+        MocoProblem mp;
+        mp.setModel(createSlidingMassModel());
+        mp.updProperty_phases().appendValue(mp.getPhase(0));
+        SimTK_TEST(mp.getNumPhases() == 2);
+        SimTK_TEST_MUST_THROW_EXC(mp.createRep(), Exception);
+    }
+}
+
+namespace {
+// Counts the number of times that a model is processed.
+class ModOpCountCalls : public ModelOperator {
+    OpenSim_DECLARE_CONCRETE_OBJECT(ModOpCountCalls, ModelOperator);
+
+public:
+    static int numCalls;
+    void operate(Model&, const std::string&) const override { ++numCalls; }
+};
+int ModOpCountCalls::numCalls = 0;
+} // namespace
+
+TEST_CASE("MocoProblemRep::createRepHeap() reuses the processed model") {
+    MocoProblem problem;
+    problem.setModelProcessor(
+            ModelProcessor(*createSlidingMassModel()) | ModOpCountCalls());
+    problem.setTimeBounds(0, 1);
+    problem.setStateInfo("/slider/position/value", {0, 1}, 0, 1);
+
+    ModOpCountCalls::numCalls = 0;
+    auto rep = problem.createRepHeap();
+    CHECK(ModOpCountCalls::numCalls == 1);
+    auto other = rep->createRepHeap();
+    CHECK(ModOpCountCalls::numCalls == 1);
+
+    CHECK(&other->getModelBase() != &rep->getModelBase());
+    CHECK(other->createStateInfoNames() == rep->createStateInfoNames());
+    CHECK(other->getNumKinematicConstraintEquations() ==
+            rep->getNumKinematicConstraintEquations());
+    CHECK(other->getModelDisabledConstraints().getNumStateVariables() ==
+            rep->getModelDisabledConstraints().getNumStateVariables());
 }
 
 TEMPLATE_TEST_CASE("Workflow", "", MocoCasADiSolver, MocoTropterSolver) {
@@ -1534,6 +1881,8 @@ TEMPLATE_TEST_CASE("MocoTrajectory", "", MocoCasADiSolver, MocoTropterSolver) {
     testCompareContinuousVariablesRMS(21, 2, 0, 2, 15.0, 0.01);
     // 6 is the minimum required number of times; ensure that it works.
     testCompareContinuousVariablesRMS(6, 0, 3, 0, 0.1, 0.9);
+    // Enough columns and times to compare the columns on several threads.
+    testCompareContinuousVariablesRMS(101, 60, 30, 10, 2.0, 0.02);
 
     // Providing a subset of states/columns to compare.
     testCompareContinuousVariablesRMS(10, 2, 3, 1, 0.6, 0.05, {"s1"});
@@ -1649,6 +1998,82 @@ TEST_CASE("MocoTrajectory randomize") {
     }
 }
 
+TEST_CASE("MocoTrajectory views and moves") {
+    SimTK::Vector time(3);
+    time[0] = 0;
+    time[1] = 0.1;
+    time[2] = 0.25;
+    const SimTK::Matrix states = SimTK::Test::randMatrix(3, 2);
+    const SimTK::Matrix derivatives = SimTK::Test::randMatrix(3, 2);
+    SimTK::Matrix movedStates = states;
+    MocoTrajectory orig(time, {"/q/value", "/q/speed"}, {"c"}, {},
+            {"/q/accel", "d"}, {}, std::move(movedStates),
+            SimTK::Test::randMatrix(3, 1), SimTK::Matrix(), derivatives,
+            SimTK::RowVector());
+    SimTK_TEST_EQ(orig.getStatesTrajectory(), states);
+
+    // The views refer to the data of the trajectory.
+    const SimTK::MatrixView values = orig.getValuesTrajectoryView();
+    CHECK(&values(0, 0) == &orig.getStatesTrajectory()(0, 0));
+    SimTK_TEST_EQ(SimTK::Matrix(values), orig.getValuesTrajectory());
+    SimTK_TEST_EQ(SimTK::Matrix(orig.getSpeedsTrajectoryView()),
+            SimTK::Matrix(states.block(0, 1, 3, 1)));
+    SimTK_TEST_EQ(SimTK::Matrix(orig.getAccelerationsTrajectoryView()),
+            SimTK::Matrix(derivatives.block(0, 0, 3, 1)));
+    SimTK_TEST_EQ(SimTK::Matrix(
+                          orig.getDerivativesWithoutAccelerationsTrajectoryView()),
+            SimTK::Matrix(derivatives.block(0, 1, 3, 1)));
+
+    MocoTrajectory copy = orig;
+    MocoTrajectory moved = std::move(copy);
+    CHECK(moved.isNumericallyEqual(orig));
+    MocoTrajectory assigned;
+    assigned = std::move(moved);
+    CHECK(assigned.isNumericallyEqual(orig));
+}
+
+TEST_CASE("MocoTrajectory OSB files and partial reads") {
+    SimTK::Vector time(4);
+    time[0] = 0;
+    time[1] = 0.1;
+    time[2] = 0.25;
+    time[3] = 0.4;
+    SimTK::RowVector parameters(1, 5.0);
+    MocoTrajectory orig(time, {"/q/value", "/q/speed"}, {"c0", "c1"}, {},
+            {}, {"p"}, SimTK::Test::randMatrix(4, 2),
+            SimTK::Test::randMatrix(4, 2), SimTK::Matrix(), SimTK::Matrix(),
+            parameters);
+    orig.write("testMocoInterface_partial_reads.osb");
+    orig.write("testMocoInterface_partial_reads.sto");
+
+    MocoTrajectory fromOSB("testMocoInterface_partial_reads.osb");
+    CHECK(fromOSB.isNumericallyEqual(orig));
+
+    for (const std::string extension : {".osb", ".sto"}) {
+        INFO(extension);
+        const std::string filepath = "testMocoInterface_partial_reads" +
+                                     extension;
+        MocoTrajectory part(filepath, {"c1", "p"}, 0.05, 0.3);
+        CHECK(part.getStateNames().empty());
+        CHECK(part.getControlNames() == std::vector<std::string>{"c1"});
+        CHECK(part.getParameterNames() == std::vector<std::string>{"p"});
+        REQUIRE(part.getNumTimes() == 2);
+        CHECK(part.getTime()[0] == 0.1);
+        CHECK(part.getTime()[1] == 0.25);
+        for (int i = 0; i < 2; ++i) {
+            CHECK(part.getControl("c1")[i] ==
+                    Approx(orig.getControl("c1")[i + 1]));
+        }
+        // The parameters are read from the first row of the file.
+        CHECK(part.getParameter("p") == 5.0);
+
+        MocoTrajectory all(filepath, {});
+        CHECK(all.isNumericallyEqual(orig));
+
+        CHECK_THROWS(MocoTrajectory(filepath, {"not_a_variable"}));
+    }
+}
+
 TEST_CASE("createPeriodicTrajectory") {
     const std::string hip_r = "hip_r/hip_flexion_r/value";
     const std::string hip_l = "hip_l/hip_flexion_l/value";
@@ -258,3 +258,27 @@ TEMPLATE_TEST_CASE("See-saw center of mass", "",
 
     CHECK(sol_xCOM == Approx(xCOM).epsilon(0.003));
 }
+
+TEST_CASE("Applying unchanged parameter values does not rebuild the system") {
+    MocoProblem mp;
+    mp.setModel(createOscillatorModel());
+    mp.addParameter("oscillator_mass", "body", "mass", MocoBounds(0, 10));
+    MocoProblemRep rep = mp.createRep();
+
+    const auto& body = rep.getModelBase().getComponent<Body>("body");
+    rep.applyParametersToModelProperties(SimTK::Vector(1, MASS), true);
+    CHECK(body.getMass() == MASS);
+    CHECK(rep.getModelBase().getMatterSubsystem().calcSystemMass(
+            rep.updStateBase()) == MASS);
+
+    // initSystem() would reset the time of the state.
+    rep.updStateBase().setTime(1.0);
+    rep.applyParametersToModelProperties(SimTK::Vector(1, MASS), true);
+    CHECK(rep.updStateBase().getTime() == 1.0);
+
+    rep.applyParametersToModelProperties(SimTK::Vector(1, 2 * MASS), true);
+    CHECK(body.getMass() == 2 * MASS);
+    CHECK(rep.updStateBase().getTime() == 0);
+    CHECK(rep.getModelBase().getMatterSubsystem().calcSystemMass(
+            rep.updStateBase()) == 2 * MASS);
+}
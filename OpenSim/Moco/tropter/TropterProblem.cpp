@@ -113,9 +113,10 @@ convertIterateTropterToMoco(const tropIterateType& tropSol) const {
     SimTK::RowVector parameters(numParameters, tropSol.parameters.data());
 
     // Create iterate.
-    MocoTrajectoryType mocoIter(time, state_names, control_names, multiplier_names,
-                        derivative_names, parameter_names, states, controls,
-                        multipliers, derivatives, parameters);
+    MocoTrajectoryType mocoIter(std::move(time), state_names, control_names,
+            multiplier_names, derivative_names, parameter_names,
+            std::move(states), std::move(controls), std::move(multipliers),
+            std::move(derivatives), std::move(parameters));
     // Append slack variables.
     for (int i = 0; i < numSlacks; ++i) {
         mocoIter.appendSlack(slack_names[i], slacks.col(i));
@@ -20,6 +20,7 @@
 
 #include <simbody/internal/Constraint.h>
 
+#include <OpenSim/Common/TraceEventRecorder.h>
 #include <OpenSim/Moco/Components/AccelerationMotion.h>
 #include <OpenSim/Moco/Components/DiscreteController.h>
 #include <OpenSim/Moco/Components/DiscreteForces.h>
@@ -46,10 +47,17 @@ inline tropter::FinalBounds convertBounds(const MocoFinalBounds& mb) {
 template <typename T>
 class MocoTropterSolver::TropterProblemBase : public tropter::Problem<T> {
 protected:
-    TropterProblemBase(const MocoTropterSolver& solver, bool implicit = false)
+    /// If `problemRep` is not null, this problem is a copy for evaluating the
+    /// mesh points on another thread, and uses (and owns) `problemRep` instead
+    /// of the solver's MocoProblemRep.
+    TropterProblemBase(const MocoTropterSolver& solver,
+            std::unique_ptr<const MocoProblemRep> problemRep,
+            bool implicit = false)
             : tropter::Problem<T>(solver.getProblemRep().getName()),
               m_mocoTropterSolver(solver),
-              m_mocoProbRep(solver.getProblemRep()),
+              m_ownedProbRep(std::move(problemRep)),
+              m_mocoProbRep(m_ownedProbRep ? *m_ownedProbRep
+                                           : solver.getProblemRep()),
               m_modelBase(m_mocoProbRep.getModelBase()),
               m_stateBase(m_mocoProbRep.updStateBase()),
               m_modelDisabledConstraints(
@@ -90,10 +98,13 @@ protected:
         addKinematicConstraints();
         addGenericPathConstraints();
 
-        std::string formattedTimeString(getFormattedDateTime(true));
-        m_fileDeletionThrower = OpenSim::make_unique<FileDeletionThrower>(
-                fmt::format("delete_this_to_stop_optimization_{}_{}.txt",
-                        m_mocoProbRep.getName(), formattedTimeString));
+        // Only the original problem checks for the deletion of the file.
+        if (!m_ownedProbRep) {
+            std::string formattedTimeString(getFormattedDateTime(true));
+            m_fileDeletionThrower = OpenSim::make_unique<FileDeletionThrower>(
+                    fmt::format("delete_this_to_stop_optimization_{}_{}.txt",
+                            m_mocoProbRep.getName(), formattedTimeString));
+        }
     }
 
     void addStateVariables() {
@@ -280,7 +291,7 @@ protected:
 
     void initialize_on_iterate(
             const Eigen::VectorXd& parameters) const override final {
-        m_fileDeletionThrower->throwIfDeleted();
+        if (m_fileDeletionThrower) m_fileDeletionThrower->throwIfDeleted();
         // If they exist, apply parameter values to the model.
         this->applyParametersToModelProperties(parameters);
     }
@@ -358,6 +369,8 @@ protected:
 
     void calc_cost_integrand(int cost_index, const tropter::Input<T>& in,
             T& integrand) const override {
+        TraceEventRecorder::Scope scope(
+                m_traceRecorder, "function", "cost_integrand");
         if (cost_index == m_multiplierCostIndex) {
             // Unpack variables.
             const auto& adjuncts = in.adjuncts;
@@ -388,6 +401,7 @@ protected:
 
     void calc_cost(int cost_index, const tropter::CostInput<T>& in,
             T& cost_value) const override {
+        TraceEventRecorder::Scope scope(m_traceRecorder, "function", "cost");
         if (cost_index == m_multiplierCostIndex) {
             cost_value = in.integral;
             return;
@@ -418,6 +432,7 @@ protected:
     }
 
     const MocoTropterSolver& m_mocoTropterSolver;
+    std::unique_ptr<const MocoProblemRep> m_ownedProbRep;
     const MocoProblemRep& m_mocoProbRep;
     const Model& m_modelBase;
     SimTK::State& m_stateBase;
@@ -443,6 +458,8 @@ protected:
     mutable int m_total_ma = 0;
     // This is the sum of m_total_m(p|v|a).
     mutable int m_numMultipliers = 0;
+    // Records the evaluations of the functions of the problem, if not null.
+    mutable TraceEventRecorder* m_traceRecorder = nullptr;
     // This is the output argument of
     // SimbodyMatterSubsystem::calcConstraintAccelerationErrors(), and includes
     // the acceleration-level holonomic, non-holonomic constraint errors and the
@@ -550,6 +567,13 @@ protected:
     }
 
 public:
+    /// Record the evaluations of the functions of this problem with this
+    /// recorder (not owned), if not null. This is const so that it can be set
+    /// on the problem returned by createTropterProblem().
+    void setTraceRecorder(TraceEventRecorder* recorder) const {
+        m_traceRecorder = recorder;
+    }
+
     template <typename MocoTrajectoryType, typename tropIterateType>
     MocoTrajectoryType convertIterateTropterToMoco(
             const tropIterateType& tropSol) const;
@@ -567,11 +591,15 @@ template <typename T>
 class MocoTropterSolver::ExplicitTropterProblem
         : public MocoTropterSolver::TropterProblemBase<T> {
 public:
-    ExplicitTropterProblem(const MocoTropterSolver& solver)
-            : MocoTropterSolver::TropterProblemBase<T>(solver) {}
+    ExplicitTropterProblem(const MocoTropterSolver& solver,
+            std::unique_ptr<const MocoProblemRep> problemRep = nullptr)
+            : MocoTropterSolver::TropterProblemBase<T>(
+                      solver, std::move(problemRep)) {}
     void initialize_on_mesh(const Eigen::VectorXd&) const override {}
     void calc_differential_algebraic_equations(const tropter::Input<T>& in,
             tropter::Output<T> out) const override {
+        TraceEventRecorder::Scope scope(this->m_traceRecorder, "function",
+                "differential_algebraic_equations");
         // Unpack variables.
         const auto& diffuses = in.diffuses;
 
@@ -640,8 +668,9 @@ template <typename T>
 class MocoTropterSolver::ImplicitTropterProblem
         : public MocoTropterSolver::TropterProblemBase<T> {
 public:
-    ImplicitTropterProblem(const MocoTropterSolver& solver)
-            : TropterProblemBase<T>(solver, true) {
+    ImplicitTropterProblem(const MocoTropterSolver& solver,
+            std::unique_ptr<const MocoProblemRep> problemRep = nullptr)
+            : TropterProblemBase<T>(solver, std::move(problemRep), true) {
         OPENSIM_THROW_IF(this->m_numKinematicConstraintEquations, Exception,
                 "Cannot use implicit dynamics mode with kinematic "
                 "constraints.");
@@ -668,6 +697,8 @@ public:
     }
     void calc_differential_algebraic_equations(const tropter::Input<T>& in,
             tropter::Output<T> out) const override {
+        TraceEventRecorder::Scope scope(this->m_traceRecorder, "function",
+                "differential_algebraic_equations");
 
         const auto& states = in.states;
         const auto& adjuncts = in.adjuncts;
@@ -33,12 +33,15 @@
 class osimInstantiator
 {
 public:
+    // The libraries defer the registration of their types (see
+    // Object::deferTypeRegistration()); this only ensures that they are
+    // linked, and does nothing if they already deferred their registration.
     osimInstantiator() {
-        RegisterTypes_osimCommon();
-        RegisterTypes_osimSimulation();
-        RegisterTypes_osimActuators();
-        RegisterTypes_osimAnalyses();
-        RegisterTypes_osimTools();
+        OpenSim::Object::deferTypeRegistration(RegisterTypes_osimCommon);
+        OpenSim::Object::deferTypeRegistration(RegisterTypes_osimSimulation);
+        OpenSim::Object::deferTypeRegistration(RegisterTypes_osimActuators);
+        OpenSim::Object::deferTypeRegistration(RegisterTypes_osimAnalyses);
+        OpenSim::Object::deferTypeRegistration(RegisterTypes_osimTools);
     }
 };
 
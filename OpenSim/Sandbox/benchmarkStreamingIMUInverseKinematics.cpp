@@ -0,0 +1,131 @@
+/* -------------------------------------------------------------------------- *
+ *          OpenSim: benchmarkStreamingIMUInverseKinematics.cpp               *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Replay a recorded Xsens or APDM trial at real-time rate (or a multiple of
+it) through StreamingIMUInverseKinematics, and report the latency and
+throughput of the solutions and the number of skipped frames.
+
+Usage:
+  benchmarkStreamingIMUInverseKinematics <calibrated-model> <reader-settings>
+      <data> [speed] [deadline]
+
+<reader-settings> is an XsensDataReaderSettings or APDMDataReaderSettings
+file, whose sensor names must be those of the calibrated IMU frames of the
+model (see IMUPlacer). <data> is the folder of the Xsens files or the APDM
+.csv file. The orientations are rotated from the sensor frame to the OpenSim
+frame with space-fixed XYZ rotations of (-90, 0, 0) degrees, as in the
+OpenSense examples. A speed of 2 replays the data twice as fast as it was
+recorded (default: 1); without a deadline (default: Infinity), every frame is
+solved. */
+
+#include <OpenSim/Common/APDMDataReader.h>
+#include <OpenSim/Common/XsensDataReader.h>
+#include <OpenSim/OpenSim.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace OpenSim;
+
+static TimeSeriesTable_<SimTK::Quaternion> readOrientations(
+        const std::string& settingsFile, const std::string& data) {
+    std::unique_ptr<Object> settings(Object::makeObjectFromFile(settingsFile));
+    if (auto* xsens = dynamic_cast<XsensDataReaderSettings*>(settings.get())) {
+        XsensDataReader reader(*xsens);
+        const auto tables = reader.read(data);
+        return reader.getOrientationsTable(tables);
+    }
+    if (auto* apdm = dynamic_cast<APDMDataReaderSettings*>(settings.get())) {
+        APDMDataReader reader(*apdm);
+        const auto tables = reader.read(data);
+        return reader.getOrientationsTable(tables);
+    }
+    OPENSIM_THROW(Exception, "Expected '" + settingsFile + "' to be an "
+            "XsensDataReaderSettings or APDMDataReaderSettings file.");
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        std::cout << "Usage: " << argv[0] << " <calibrated-model> "
+                  << "<reader-settings> <data> [speed] [deadline]"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    const double speed = argc > 4 ? std::stod(argv[4]) : 1.0;
+    const double deadline = argc > 5 ? std::stod(argv[5]) : SimTK::Infinity;
+
+    Model model(argv[1]);
+    // Translations cannot be determined from orientations (as in
+    // IMUInverseKinematicsTool).
+    for (auto& coord : model.updComponentList<Coordinate>()) {
+        if (coord.getMotionType() == Coordinate::Translational) {
+            coord.setDefaultLocked(true);
+        }
+    }
+
+    auto quatTable = readOrientations(argv[2], argv[3]);
+    OpenSenseUtilities::rotateOrientationTable(quatTable,
+            SimTK::Rotation(SimTK::BodyOrSpaceType::SpaceRotationSequence,
+                    -SimTK::Pi / 2, SimTK::XAxis, 0, SimTK::YAxis,
+                    0, SimTK::ZAxis));
+    const auto orientations =
+            OpenSenseUtilities::convertQuaternionsToRotations(quatTable);
+    const auto& times = orientations.getIndependentColumn();
+    std::cout << "Replaying " << times.size() << " frames of "
+              << orientations.getNumColumns() << " sensors ("
+              << times.back() - times.front() << " s) at " << speed
+              << "x real time." << std::endl;
+
+    StreamingIMUInverseKinematics ik(model, orientations.getColumnLabels());
+    ik.setDeadline(deadline);
+    ik.start();
+
+    // Push each frame at the wall-clock time at which it was recorded.
+    typedef std::chrono::steady_clock Clock;
+    const auto replayStart = Clock::now();
+    for (size_t i = 0; i < times.size(); ++i) {
+        std::this_thread::sleep_until(replayStart +
+                std::chrono::duration_cast<Clock::duration>(
+                        std::chrono::duration<double>(
+                                (times[i] - times.front()) / speed)));
+        ik.pushFrame(times[i], orientations.getRowAtIndex(i));
+    }
+    ik.stop();
+
+    const auto stats = ik.getStatistics();
+    std::cout << "frames received:  " << stats.numFramesReceived << "\n"
+              << "frames rejected:  " << stats.numFramesRejected << "\n"
+              << "frames skipped:   " << stats.numFramesSkipped << "\n"
+              << "frames solved:    " << stats.numFramesSolved << "\n"
+              << "frames failed:    " << stats.numFramesFailed << "\n"
+              << "latency (ms):     mean " << 1e3 * stats.meanLatency
+              << ", max " << 1e3 * stats.maxLatency << "\n"
+              << "solve time (ms):  mean " << 1e3 * stats.meanSolveTime
+              << ", max " << 1e3 * stats.maxSolveTime << "\n"
+              << "throughput (Hz):  " << stats.throughput << "\n"
+              << "data rate (Hz):   "
+              << speed * (times.size() - 1) / (times.back() - times.front())
+              << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -94,6 +94,8 @@ void AssemblySolver::setupGoals(SimTK::State &s)
 
     // clear any old coordinate goals
     _coordinateAssemblyConditions.clear();
+    _coordinateGoals.clear();
+    _coordinateRanges.clear();
 
     // Get model coordinates
     const CoordinateSet& modelCoordSet = getModel().getCoordinateSet();
@@ -105,6 +107,9 @@ void AssemblySolver::setupGoals(SimTK::State &s)
             _assembler->restrictQ(coord.getBodyIndex(), 
                 MobilizerQIndex(coord.getMobilizerQIndex()),
                 coord.getRangeMin(), coord.getRangeMax());
+            _coordinateRanges.push_back({coord.getBodyIndex(),
+                SimTK::MobilizerQIndex(coord.getMobilizerQIndex()),
+                coord.getRangeMin(), coord.getRangeMax()});
         }
     }
 
@@ -133,6 +138,9 @@ void AssemblySolver::setupGoals(SimTK::State &s)
                 _coordinateAssemblyConditions.push_back(coordGoal);
                 // Add coordinate matching goal to the ik objective
                 _assembler->adoptAssemblyGoal(coordGoal, coordRef->getWeight(s));
+                _coordinateGoals.push_back({coord.getBodyIndex(),
+                    SimTK::MobilizerQIndex(coord.getMobilizerQIndex()),
+                    coordRef->getWeight(s), coordRef->getValue(s)});
             }
         }
     }
@@ -169,8 +177,9 @@ void AssemblySolver::updateGoals(SimTK::State &s)
     unsigned int nqrefs = _coordinateReferencesp.size();
     for(unsigned int i=0; i<nqrefs; i++){
         //update goal values from reference.
-        _coordinateAssemblyConditions[i]->setValue
-           ((_coordinateReferencesp)[i].getValue(s));
+        const double value = (_coordinateReferencesp)[i].getValue(s);
+        _coordinateAssemblyConditions[i]->setValue(value);
+        _coordinateGoals[i].value = value;
         //_assembler->setAssemblyConditionWeight(_coordinateAssemblyConditions[i]->
     }
 }
@@ -85,6 +85,9 @@ public:
         must call assemble() before being able to track().*/
     void setAccuracy(double accuracy);
 
+    /** Get the unitless accuracy of the assembly solution. */
+    double getAccuracy() const { return _accuracy; }
+
     /** %Set the relative weighting for constraints. Use Infinity to identify the 
         strict enforcement of constraints, otherwise any positive weighting will
         append the constraint errors to the assembly cost which the solver will
@@ -132,6 +135,32 @@ protected:
     /** Write access to the underlying SimTK::Assembler. */
     SimTK::Assembler& updAssembler();
 
+    /** A coordinate goal of the Assembler: the coordinate's mobilizer and q,
+        the weight of the goal, and the desired value of the coordinate. */
+    struct CoordinateGoal {
+        SimTK::MobilizedBodyIndex body;
+        SimTK::MobilizerQIndex q;
+        double weight;
+        double value;
+    };
+    /** A range of a clamped coordinate to which the Assembler restricts the
+        solution. */
+    struct CoordinateRange {
+        SimTK::MobilizedBodyIndex body;
+        SimTK::MobilizerQIndex q;
+        double min;
+        double max;
+    };
+    /** The coordinate goals, in the order of getCoordinateReferences(), as of
+        the last setupGoals() and updateGoals(). This allows subclasses to
+        solve the assembly problem themselves (see
+        InverseKinematicsSolver::setUseLeastSquaresTracking()). */
+    const SimTK::Array_<CoordinateGoal>& getCoordinateGoals() const
+    {   return _coordinateGoals; }
+    /** The ranges of the clamped coordinates, as of the last setupGoals(). */
+    const SimTK::Array_<CoordinateRange>& getCoordinateRanges() const
+    {   return _coordinateRanges; }
+
 private:
 
     // The assembly solution accuracy
@@ -147,6 +176,8 @@ private:
     SimTK::ResetOnCopy< std::unique_ptr<SimTK::Assembler>> _assembler;
 
     SimTK::Array_<SimTK::QValue*> _coordinateAssemblyConditions;
+    SimTK::Array_<CoordinateGoal> _coordinateGoals;
+    SimTK::Array_<CoordinateRange> _coordinateRanges;
 //=============================================================================
 };  // END of class AssemblySolver
 //=============================================================================
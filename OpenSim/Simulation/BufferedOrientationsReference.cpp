@@ -41,32 +41,35 @@ void BufferedOrientationsReference::getValuesAtTime(
         double time, SimTK::Array_<Rotation> &values) const
 {
     auto& times = _orientationData.getIndependentColumn();
-    SimTK::RowVector_<SimTK::Rotation> nextRow;
 
-    if (time >= times.front() && time <= times.back()) {
-        nextRow = _orientationData.getRow(time);
+    if (!times.empty() && time >= times.front() && time <= times.back()) {
+        _nextRow = _orientationData.getRow(time);
     } else {
-        _orientationDataQueue.pop_front(time, nextRow);
-    }
-    int n = nextRow.size();
-    values.resize(n);
-
-    for (int i = 0; i < n; ++i) { 
-        values[i] = nextRow[i];
+        _orientationDataQueue.pop_front(time, _nextRow);
     }
+    copyQueuedRow(values);
 }
 
 double BufferedOrientationsReference::getNextValuesAndTime(
         SimTK::Array_<SimTK::Rotation_<double>>& values) {
 
     double returnTime;
-    SimTK::RowVector_<SimTK::Rotation> nextRow;
-    _orientationDataQueue.pop_front(returnTime, nextRow);
-    int n = nextRow.size();
+    _orientationDataQueue.pop_front(returnTime, _nextRow);
+    copyQueuedRow(values);
+    return returnTime;
+}
+
+void BufferedOrientationsReference::copyQueuedRow(
+        SimTK::Array_<SimTK::Rotation_<double>>& values) const {
+    // Array_::resize() does not reallocate if the size is unchanged.
+    int n = _nextRow.size();
     values.resize(n);
+    for (int i = 0; i < n; ++i) { values[i] = _nextRow[i]; }
+}
 
-    for (int i = 0; i < n; ++i) { values[i] = nextRow[i]; }
-    return returnTime;
+void BufferedOrientationsReference::setBufferCapacity(int capacity) {
+    _orientationDataQueue.reserve(capacity, getNumRefs());
+    _nextRow.resize(getNumRefs());
 }
 
 void BufferedOrientationsReference::putValues(
@@ -89,9 +89,29 @@ public:
     void setFinished(bool finished) { 
         _finished = finished;
     };
+
+    /** Use a bounded, preallocated ring buffer that can hold up to
+     * `capacity` frames for the queued data. The row width is the number of
+     * orientation sensors in this reference (see getNames()), so all frames
+     * passed to putValues() must contain that many orientations. With a ring
+     * buffer, putValues() and getValuesAtTime() do not allocate memory or
+     * lock a mutex, provided that data is pushed from one thread and
+     * consumed from one other thread. If the buffer is full, putValues()
+     * waits for the consumer. Any queued data is discarded. */
+    void setBufferCapacity(int capacity);
+
+    /** The maximum number of frames that can be queued, or 0 if the queue is
+     * unbounded (the default). */
+    int getBufferCapacity() const {
+        return _orientationDataQueue.getCapacity();
+    }
 private:
+    void copyQueuedRow(SimTK::Array_<SimTK::Rotation_<double>>& values) const;
+
     // Use a specialized data structure for holding the orientation data
     mutable DataQueue_<SimTK::Rotation> _orientationDataQueue;
+    // Reused across calls so that draining the queue does not allocate.
+    mutable SimTK::RowVector_<SimTK::Rotation> _nextRow;
     bool _finished{false};
     //=============================================================================
 };  // END of class BufferedOrientationsReference
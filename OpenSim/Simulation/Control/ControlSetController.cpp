@@ -162,6 +162,17 @@ void ControlSetController::computeControls(const SimTK::State& s, SimTK::Vector&
 {
     SimTK_ASSERT( _controlSet , "ControlSetController::computeControls controlSet is NULL");
 
+    if (!_piecewiseLinearControls.empty()) {
+        const int nc = _piecewiseLinearControls.getNumControls();
+        std::vector<double> values(nc);
+        int hint = 0;
+        _piecewiseLinearControls.calcValues(s.getTime(), hint, values.data());
+        for (int c = 0; c < nc; ++c) {
+            addInControl(_piecewiseLinearActuators[c], values[c], controls);
+        }
+        return;
+    }
+
     std::string actName = "";
     int index = -1;
 
@@ -176,8 +187,8 @@ void ControlSetController::computeControls(const SimTK::State& s, SimTK::Vector&
         }
 
         if(index >= 0){
-            SimTK::Vector actControls(1, _controlSet->get(index).getControlValue(s.getTime()));
-            getActuatorSet()[i].addInControls(actControls, controls);
+            addInControl(i, _controlSet->get(index).getControlValue(s.getTime()),
+                    controls);
         }
     }
 }
@@ -272,3 +283,64 @@ void ControlSetController::extendFinalizeFromProperties()
             updProperty_actuator_list().appendValue(actName);
     }
 }
+
+void ControlSetController::extendConnectToModel(Model& model)
+{
+    Super::extendConnectToModel(model);
+
+    _piecewiseLinearControls = PiecewiseLinearControls();
+    _piecewiseLinearActuators.clear();
+    if (_controlSet == nullptr) return;
+
+    // Find the control of each actuator, as in computeControls().
+    std::vector<ControlLinear*> linearControls;
+    for (int i = 0; i < getActuatorSet().getSize(); ++i) {
+        std::string actName = getActuatorSet()[i].getName();
+        int index = _controlSet->getIndex(actName);
+        if (index < 0) index = _controlSet->getIndex(actName + ".excitation");
+        if (index < 0) continue;
+        auto* control = dynamic_cast<ControlLinear*>(&_controlSet->get(index));
+        if (!control || control->getUseSteps()) return;
+        linearControls.push_back(control);
+        _piecewiseLinearActuators.push_back(i);
+    }
+    if (linearControls.empty()) return;
+
+    // The controls must have the same node times.
+    const ControlLinear& first = *linearControls[0];
+    const int n = first.getNumParameters();
+    if (n < 2) return;
+    std::vector<double> times(n);
+    for (int k = 0; k < n; ++k) {
+        times[k] = first.getParameterTime(k);
+        if (k > 0 && !(times[k - 1] < times[k])) return;
+    }
+    for (const ControlLinear* control : linearControls) {
+        if (control->getNumParameters() != n ||
+                control->getExtrapolate() != first.getExtrapolate()) {
+            return;
+        }
+        for (int k = 0; k < n; ++k) {
+            if (control->getParameterTime(k) != times[k]) return;
+        }
+    }
+
+    const int nc = (int)linearControls.size();
+    PiecewiseLinearControls grid(times, nc, first.getExtrapolate());
+    for (int c = 0; c < nc; ++c) {
+        const ControlLinear& control = *linearControls[c];
+        double slope = 0;
+        for (int k = 0; k < n; ++k) {
+            // As in ControlLinear::Interpolate(). The last slope is used to
+            // extrapolate after the last node.
+            if (k < n - 1) {
+                const double dx = times[k + 1] - times[k];
+                slope = fabs(dx) < SimTK::Zero ? 0.0
+                        : (control.getParameterValue(k + 1) -
+                                  control.getParameterValue(k)) / dx;
+            }
+            grid.set(k, c, control.getParameterValue(k), slope);
+        }
+    }
+    _piecewiseLinearControls = std::move(grid);
+}
@@ -31,6 +31,7 @@
 // These files contain declarations and definitions of variables and methods
 // that will be used by the Controller class.
 #include "Controller.h"
+#include "PiecewiseLinearControls.h"
 #include <OpenSim/Common/PropertyStr.h>
 
 //=============================================================================
@@ -53,6 +54,11 @@ OpenSim_DECLARE_CONCRETE_OBJECT(ControlSetController, Controller);
 protected:
     ControlSet* _controlSet;
 
+    /** The controls of the actuators in _piecewiseLinearActuators on their
+    shared grid of times, or empty if the controls do not allow it. */
+    PiecewiseLinearControls _piecewiseLinearControls;
+    std::vector<int> _piecewiseLinearActuators;
+
     /** Name of the controls file. */
     PropertyStr _controlsFileNameProp;
     std::string &_controlsFileName;
@@ -81,9 +87,18 @@ public:
     virtual ~ControlSetController();
 
     const ControlSet *getControlSet() {return _controlSet;} 
-    ControlSet *updControlSet() {return _controlSet;}
+    /** Access the control set for modification. Since the controls may be
+    changed, they are evaluated one at a time until the model is connected
+    again (see computeControls()). */
+    ControlSet *updControlSet() {
+        _piecewiseLinearControls = PiecewiseLinearControls();
+        return _controlSet;
+    }
 
-    void setControlSet(ControlSet *aControlSet) {_controlSet = aControlSet;}
+    void setControlSet(ControlSet *aControlSet) {
+        _piecewiseLinearControls = PiecewiseLinearControls();
+        _controlSet = aControlSet;
+    }
 
 
     
@@ -111,6 +126,9 @@ protected:
     /// read in ControlSet and update Controller's actuator list
     void extendFinalizeFromProperties() override;
 
+    /// map the controls to the actuators (see computeControls())
+    void extendConnectToModel(Model& model) override;
+
     //--------------------------------------------------------------------------
     // OPERATORS
     //--------------------------------------------------------------------------
@@ -130,7 +148,11 @@ public:
     //--------------------------------------------------------------------------
     /**
      * Compute the control values for all actuators under the control of this
-     * Controller
+     * Controller. If the controls of the actuators are all ControlLinear
+     * controls with linear interpolation, the same extrapolation setting, and
+     * nodes at the same times (e.g., controls read from a storage file), they
+     * are evaluated together on their shared grid of times (see
+     * PiecewiseLinearControls), which is much faster for many actuators.
      *
      * @param s         system state 
      * @param controls  return control values 
@@ -197,6 +197,17 @@ void Controller::extendAddToSystem(SimTK::MultibodySystem& system) const
     Super::extendAddToSystem(system);
 }
 
+void Controller::extendRealizeTopology(SimTK::State& state) const
+{
+    Super::extendRealizeTopology(state);
+
+    // The actuators have their control indices once the system is created.
+    _actuatorControlIndices.resize(_actuatorSet.getSize());
+    for (int i = 0; i < _actuatorSet.getSize(); ++i) {
+        _actuatorControlIndices[i] = _actuatorSet[i].getControlIndex();
+    }
+}
+
 // makes a request for which actuators a controller will control
 void Controller::setActuators(const Set<Actuator>& actuators)
 {
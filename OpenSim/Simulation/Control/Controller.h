@@ -31,6 +31,8 @@
 #include <OpenSim/Simulation/Model/ModelComponent.h>
 #include <OpenSim/Common/Set.h>
 
+#include <vector>
+
 namespace OpenSim { 
 
 // Forward declarations of classes that are used by the controller implementation
@@ -133,9 +135,32 @@ protected:
         measures, etc... required by the controller. */
     void extendAddToSystem(SimTK::MultibodySystem& system) const override;
 
+    /** Finds the indices of the controls of the actuators in the model's
+        controls (see addInControl()). Subclasses that override this must call
+        Super::extendRealizeTopology(). */
+    void extendRealizeTopology(SimTK::State& state) const override;
+
     /** Only a Controller can set its number of controls based on its actuators */
     void setNumControls(int numControls) {_numControls = numControls; }
 
+    /** Add `control` to the control of the actuator with index `index` in
+        getActuatorSet(), which must have a single control, in the model
+        controls `controls` (as given to computeControls()). Unlike
+        Actuator::addInControls(), this needs no temporary Vector and no
+        virtual calls; the indices of the controls are found when the system
+        is created. */
+    void addInControl(int index, double control,
+                      SimTK::Vector& controls) const {
+        controls[_actuatorControlIndices[index]] += control;
+    }
+
+    /** The index of the first control of each actuator of getActuatorSet()
+        in the model's controls (see Actuator::getControlIndex()), available
+        once the system is created. */
+    const std::vector<int>& getActuatorControlIndices() const {
+        return _actuatorControlIndices;
+    }
+
     void updateFromXMLNode(SimTK::Xml::Element& node,
                            int versionNumber) override;
 
@@ -146,6 +171,9 @@ private:
     // the (sub)set of Model actuators that this controller controls */ 
     Set<const Actuator> _actuatorSet;
 
+    // the index of the first control of each actuator in the model controls
+    mutable std::vector<int> _actuatorControlIndices;
+
     // construct and initialize properties
     void constructProperties();
 
@@ -0,0 +1,95 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  ExternalController.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ExternalController.h"
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+using namespace OpenSim;
+
+struct ExternalController::Buffers {
+    struct Sample {
+        double time = SimTK::NaN;
+        std::vector<double> controls;
+    };
+
+    explicit Buffers(int numControls) {
+        for (auto& sample : samples) sample.controls.assign(numControls, 0.0);
+    }
+
+    // Set in the middle index when the middle sample holds controls that the
+    // consumer has not taken yet.
+    static const int NewBit = 4;
+
+    std::array<Sample, 3> samples;
+    // The sample the producer writes to; used only by the producer.
+    int back = 0;
+    // The sample the consumer reads from; used only by the consumer.
+    int front = 1;
+    // The sample exchanged between them.
+    std::atomic<int> middle{2};
+};
+
+void ExternalController::extendRealizeTopology(SimTK::State& state) const {
+    Super::extendRealizeTopology(state);
+    _buffers.reset(new Buffers(getActuatorSet().getSize()));
+}
+
+void ExternalController::setControls(
+        double time, const SimTK::Vector& controls) const {
+    Buffers* buffers = _buffers.get();
+    OPENSIM_THROW_IF_FRMOBJ(!buffers, Exception,
+            "Controls can only be set after Model::initSystem().");
+    Buffers::Sample& sample = buffers->samples[buffers->back];
+    OPENSIM_THROW_IF_FRMOBJ(controls.size() != (int)sample.controls.size(),
+            Exception, "Expected {} controls, but got {}.",
+            sample.controls.size(), controls.size());
+    for (int i = 0; i < controls.size(); ++i) sample.controls[i] = controls[i];
+    sample.time = time;
+    // Release the filled sample to the consumer and take the one it held.
+    buffers->back = buffers->middle.exchange(
+                            buffers->back | Buffers::NewBit,
+                            std::memory_order_acq_rel) & ~Buffers::NewBit;
+}
+
+double ExternalController::getControlsTime() const {
+    const Buffers* buffers = _buffers.get();
+    if (!buffers) return SimTK::NaN;
+    return buffers->samples[buffers->front].time;
+}
+
+void ExternalController::computeControls(
+        const SimTK::State&, SimTK::Vector& controls) const {
+    Buffers* buffers = _buffers.get();
+    if (!buffers) return;
+    if (buffers->middle.load(std::memory_order_acquire) & Buffers::NewBit) {
+        buffers->front = buffers->middle.exchange(buffers->front,
+                                 std::memory_order_acq_rel) & ~Buffers::NewBit;
+    }
+    const Buffers::Sample& sample = buffers->samples[buffers->front];
+    if (SimTK::isNaN(sample.time)) return;
+    for (int i = 0; i < (int)sample.controls.size(); ++i) {
+        addInControl(i, sample.controls[i], controls);
+    }
+}
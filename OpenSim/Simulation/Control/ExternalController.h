@@ -0,0 +1,97 @@
+#ifndef OPENSIM_EXTERNAL_CONTROLLER_H_
+#define OPENSIM_EXTERNAL_CONTROLLER_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  ExternalController.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Controller.h"
+
+#include <memory>
+
+namespace OpenSim {
+
+/** A Controller whose controls are computed outside of the simulation, e.g.,
+by a control policy running on its own thread, and published to the controller
+with setControls() while the simulation runs:
+
+@code
+auto* controller = new ExternalController();
+controller->addActuator(model.getComponent<Actuator>("/forceset/muscle"));
+model.addController(controller);
+SimTK::State& state = model.initSystem();
+std::thread policy([&]() {
+    while (...) controller->setControls(time, computePolicy(...));
+});
+Manager manager(model, state);
+manager.integrate(finalTime);
+@endcode
+
+Publishing and using the controls are lock-free: setControls() never waits for
+the simulation and computeControls() never waits for the producer, and neither
+allocates memory or changes the State (the controls are not stored in discrete
+variables). The controls are exchanged through three buffers: the producer
+fills one, the simulation reads another, and the third holds the most recently
+published controls. Each evaluation of the controls uses the most recent
+complete set of published controls; sets published between two evaluations are
+skipped, and a set is never read while it is being written. Until the first set
+is published, this controller adds nothing to the controls.
+
+There may be at most one producer thread (calling setControls()) and one
+consumer, i.e., one simulation using this controller at a time. Because the
+controls may change between the stages of an integration step, use a
+fixed-step integrator or advance the simulation with Manager::integrate() in
+small steps if the results must be reproducible. The buffers are created by
+initSystem() (Model::initSystem() must return before the producer starts) and
+are not copied with the controller. */
+class OSIMSIMULATION_API ExternalController : public Controller {
+OpenSim_DECLARE_CONCRETE_OBJECT(ExternalController, Controller);
+
+public:
+    ExternalController() = default;
+
+    /** Publish the controls computed for the given time, one per actuator of
+    this controller in the order of getActuatorSet(). The controls are copied,
+    and replace any previously published controls that the simulation has not
+    used yet. This may be invoked from another thread than the one running the
+    simulation, but only from one thread at a time. */
+    void setControls(double time, const SimTK::Vector& controls) const;
+
+    /** The time passed to setControls() with the controls used by the last
+    evaluation of the controls (computeControls()), or NaN if no controls were
+    used yet. Use this on the thread running the simulation to detect stale
+    controls. */
+    double getControlsTime() const;
+
+    void computeControls(const SimTK::State& s,
+            SimTK::Vector& controls) const override;
+
+protected:
+    void extendRealizeTopology(SimTK::State& state) const override;
+
+private:
+    struct Buffers;
+    mutable SimTK::ResetOnCopy<std::shared_ptr<Buffers>> _buffers;
+
+};  // END of class ExternalController
+
+} // namespace OpenSim
+
+#endif // OPENSIM_EXTERNAL_CONTROLLER_H_
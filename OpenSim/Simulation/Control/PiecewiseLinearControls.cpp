@@ -0,0 +1,72 @@
+/* -------------------------------------------------------------------------- *
+ *                  OpenSim:  PiecewiseLinearControls.cpp                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "PiecewiseLinearControls.h"
+
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/Exception.h>
+
+#include <utility>
+
+using namespace OpenSim;
+
+PiecewiseLinearControls::PiecewiseLinearControls(std::vector<double> times,
+        int numControls, bool extrapolate)
+        : m_times(std::move(times)), m_numControls(numControls),
+          m_extrapolate(extrapolate) {
+    OPENSIM_THROW_IF(m_times.size() < 2, Exception,
+            "Expected at least 2 times, but got {}.", m_times.size());
+    for (size_t i = 1; i < m_times.size(); ++i) {
+        OPENSIM_THROW_IF(!(m_times[i - 1] < m_times[i]), Exception,
+                "Expected the times to be strictly increasing, but time {} "
+                "is {} and time {} is {}.",
+                i - 1, m_times[i - 1], i, m_times[i]);
+    }
+    OPENSIM_THROW_IF(numControls < 0, Exception,
+            "Expected a nonnegative number of controls, but got {}.",
+            numControls);
+    m_values.assign(m_times.size() * numControls, 0.0);
+    m_slopes.assign(m_times.size() * numControls, 0.0);
+}
+
+void PiecewiseLinearControls::calcValues(
+        double t, int& hint, double* values) const {
+    const int n = (int)m_times.size();
+    int k;
+    double dt;
+    if (t >= m_times[n - 1]) {
+        k = n - 1;
+        dt = m_extrapolate ? t - m_times[k] : 0.0;
+    } else if (t < m_times[0]) {
+        k = 0;
+        dt = m_extrapolate ? t - m_times[0] : 0.0;
+    } else {
+        hint = findInterval(m_times.data(), n, t, hint);
+        k = hint;
+        dt = t - m_times[k];
+    }
+    const double* rowValues = m_values.data() + k * m_numControls;
+    const double* rowSlopes = m_slopes.data() + k * m_numControls;
+    for (int c = 0; c < m_numControls; ++c) {
+        values[c] = rowValues[c] + rowSlopes[c] * dt;
+    }
+}
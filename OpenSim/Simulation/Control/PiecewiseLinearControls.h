@@ -0,0 +1,81 @@
+#ifndef OPENSIM_PIECEWISE_LINEAR_CONTROLS_H_
+#define OPENSIM_PIECEWISE_LINEAR_CONTROLS_H_
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  PiecewiseLinearControls.h                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimSimulationDLL.h"
+
+#include <vector>
+
+namespace OpenSim {
+
+/** Piecewise linear controls that share one grid of times, stored as
+contiguous rows (one per time) of values and slopes. All the controls at a
+time are evaluated with one interval search and one pass over a row, instead
+of one search per control; controllers use this for their controls when the
+controls allow it (see PrescribedController and ControlSetController).
+
+Between the times `t[k]` and `t[k+1]`, control `c` is
+`value(k, c) + slope(k, c) * (t - t[k])`. Before the first time, row 0 is
+used; at or after the last time, the last row is used. Without extrapolation,
+the controls are instead held at their first and last values outside the
+grid. */
+class OSIMSIMULATION_API PiecewiseLinearControls {
+public:
+    /** An empty set of controls (see empty()). */
+    PiecewiseLinearControls() = default;
+
+    /** Controls on the grid `times`, which must be strictly increasing and
+    have at least 2 times. The values and slopes start as zero. */
+    PiecewiseLinearControls(std::vector<double> times, int numControls,
+            bool extrapolate = true);
+
+    bool empty() const { return m_times.empty(); }
+    int getNumTimes() const { return (int)m_times.size(); }
+    int getNumControls() const { return m_numControls; }
+    const std::vector<double>& getTimes() const { return m_times; }
+
+    /** Set the value and slope of control `control` at the time with index
+    `time`. The slope applies from that time to the next one (and after the
+    last time, if extrapolating). */
+    void set(int time, int control, double value, double slope) {
+        m_values[time * m_numControls + control] = value;
+        m_slopes[time * m_numControls + control] = slope;
+    }
+
+    /** Evaluate all the controls at time `t` into `values` (of size
+    getNumControls()). The interval search starts from `hint`, which is
+    updated to the interval of `t`; keep it between calls for successive
+    times (see findInterval()). */
+    void calcValues(double t, int& hint, double* values) const;
+
+private:
+    std::vector<double> m_times;
+    int m_numControls = 0;
+    bool m_extrapolate = true;
+    std::vector<double> m_values;
+    std::vector<double> m_slopes;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_PIECEWISE_LINEAR_CONTROLS_H_
@@ -28,6 +28,7 @@
 #include <OpenSim/Common/Storage.h>
 #include <OpenSim/Common/GCVSpline.h>
 #include <OpenSim/Common/PiecewiseConstantFunction.h>
+#include <OpenSim/Common/PiecewiseLinearFunction.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/Actuator.h>
 
@@ -158,18 +159,67 @@ void PrescribedController::extendConnectToModel(Model& model)
             }// if found in functions, it has already been prescribed
         }// end looping through columns
     }// if no controls storage specified, do nothing
+
+    createPiecewiseLinearControls();
+}
+
+void PrescribedController::createPiecewiseLinearControls()
+{
+    _piecewiseLinearControls = PiecewiseLinearControls();
+
+    const FunctionSet& functions = get_ControlFunctions();
+    const int na = getActuatorSet().getSize();
+    if (na == 0 || functions.getSize() != na) return;
+
+    std::vector<const PiecewiseLinearFunction*> linearFunctions(na);
+    for (int i = 0; i < na; ++i) {
+        linearFunctions[i] =
+                dynamic_cast<const PiecewiseLinearFunction*>(&functions[i]);
+        if (!linearFunctions[i]) return;
+    }
+    const Array<double>& x = linearFunctions[0]->getX();
+    const int n = x.getSize();
+    if (n < 2) return;
+    for (int i = 1; i < na; ++i) {
+        if (!(linearFunctions[i]->getX() == x)) return;
+    }
+    for (int k = 1; k < n; ++k) {
+        if (!(x[k - 1] < x[k])) return;
+    }
+
+    PiecewiseLinearControls controls(
+            std::vector<double>(&x[0], &x[0] + n), na);
+    const std::vector<int> derivComponents{0};
+    for (int i = 0; i < na; ++i) {
+        const Array<double>& y = linearFunctions[i]->getY();
+        for (int k = 0; k < n; ++k) {
+            // The slope of the interval starting at x[k] (of the last
+            // interval before the first and after the last abscissa).
+            controls.set(k, i, y[k], linearFunctions[i]->calcDerivative(
+                    derivComponents, SimTK::Vector(1, x[k])));
+        }
+    }
+    _piecewiseLinearControls = std::move(controls);
 }
 
 
 // compute the control value for an actuator
 void PrescribedController::computeControls(const SimTK::State& s, SimTK::Vector& controls) const
 {
-    SimTK::Vector actControls(1, 0.0);
+    if (!_piecewiseLinearControls.empty()) {
+        std::vector<double> values(_piecewiseLinearControls.getNumControls());
+        int hint = 0;
+        _piecewiseLinearControls.calcValues(s.getTime(), hint, values.data());
+        for(int i=0; i<getActuatorSet().getSize(); i++){
+            addInControl(i, values[i], controls);
+        }
+        return;
+    }
+
     SimTK::Vector time(1, s.getTime());
 
     for(int i=0; i<getActuatorSet().getSize(); i++){
-        actControls[0] = get_ControlFunctions()[i].calcValue(time);
-        getActuatorSet()[i].addInControls(actControls, controls);
+        addInControl(i, get_ControlFunctions()[i].calcValue(time), controls);
     }  
 }
 
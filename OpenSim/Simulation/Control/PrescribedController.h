@@ -24,6 +24,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "Controller.h"
+#include "PiecewiseLinearControls.h"
 #include <OpenSim/Common/FunctionSet.h>
 
 
@@ -120,6 +121,12 @@ protected:
     /** Model component interface */
     void extendConnectToModel(Model& model) override;
 private:
+    // If all the control functions are PiecewiseLinearFunctions with the
+    // same abscissae, their values and slopes on the shared grid, so that all
+    // the controls are evaluated with one interval search. Otherwise empty.
+    void createPiecewiseLinearControls();
+    PiecewiseLinearControls _piecewiseLinearControls;
+
     // construct and initialize properties
     void constructProperties();
 
@@ -0,0 +1,197 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  TaskSpaceController.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "TaskSpaceController.h"
+
+#include <OpenSim/Simulation/Model/Model.h>
+
+using namespace OpenSim;
+
+//=============================================================================
+// STATION TASK
+//=============================================================================
+StationTask::StationTask() {
+    constructProperties();
+}
+
+StationTask::StationTask(const std::string& name, const PhysicalFrame& frame,
+        const SimTK::Vec3& location, const SimTK::Vec3& target) {
+    constructProperties();
+    setName(name);
+    connectSocket_frame(frame);
+    set_location(location);
+    set_target(target);
+}
+
+void StationTask::constructProperties() {
+    constructProperty_location(SimTK::Vec3(0));
+    constructProperty_target(SimTK::Vec3(0));
+    constructProperty_stiffness(100);
+    constructProperty_damping(20);
+}
+
+SimTK::Vec3 StationTask::calcDesiredAcceleration(
+        const SimTK::State& s) const {
+    const auto& frame = getConnectee<PhysicalFrame>("frame");
+    const SimTK::Vec3 location =
+            frame.findStationLocationInGround(s, get_location());
+    const SimTK::Vec3 velocity =
+            frame.findStationVelocityInGround(s, get_location());
+    return get_stiffness() * (get_target() - location) -
+           get_damping() * velocity;
+}
+
+//=============================================================================
+// TASK SPACE CONTROLLER
+//=============================================================================
+TaskSpaceController::TaskSpaceController() {
+    constructProperties();
+}
+
+void TaskSpaceController::constructProperties() {
+    constructProperty_tasks();
+    constructProperty_compensate_gravity(true);
+}
+
+void TaskSpaceController::addTask(StationTask* task) {
+    OPENSIM_THROW_IF_FRMOBJ(task == nullptr, Exception,
+            "Expected a task, but got nullptr.");
+    updProperty_tasks().adoptAndAppendValue(task);
+    finalizeFromProperties();
+}
+
+void TaskSpaceController::extendAddToSystem(
+        SimTK::MultibodySystem& system) const {
+    Super::extendAddToSystem(system);
+    _taskSpaceInertiaCV = addCacheVariable("task_space_inertia",
+            SimTK::Matrix(), SimTK::Stage::Position);
+}
+
+void TaskSpaceController::extendRealizeTopology(SimTK::State& state) const {
+    Super::extendRealizeTopology(state);
+    _bodies.clear();
+    _stations.clear();
+    for (int i = 0; i < getProperty_tasks().size(); ++i) {
+        const StationTask& task = get_tasks(i);
+        const auto& frame = task.getConnectee<PhysicalFrame>("frame");
+        _bodies.push_back(frame.getMobilizedBodyIndex());
+        _stations.push_back(
+                frame.findTransformInBaseFrame() * task.get_location());
+    }
+    OPENSIM_THROW_IF_FRMOBJ(getNumScalarTasks() > state.getNU(), Exception,
+            "Expected at most {} scalar tasks (the number of degrees of "
+            "freedom), but got {}.",
+            state.getNU(), getNumScalarTasks());
+}
+
+const SimTK::Matrix& TaskSpaceController::getTaskSpaceInertia(
+        const SimTK::State& s) const {
+    if (isCacheVariableValid(s, _taskSpaceInertiaCV)) {
+        return getCacheVariableValue(s, _taskSpaceInertiaCV);
+    }
+    const auto& matter = getModel().getMatterSubsystem();
+    const int nst = getNumScalarTasks();
+    const int nt = (int)_bodies.size();
+
+    // Build J M^-1 J^T one column at a time, from the products of J^T, M^-1,
+    // and J with a unit task force (all O(n) operators).
+    SimTK::Matrix inertiaInverse(nst, nst);
+    SimTK::Vector_<SimTK::Vec3> unitForce(nt, SimTK::Vec3(0));
+    SimTK::Vector_<SimTK::Vec3> JMInvJTColumn(nt);
+    SimTK::Vector JTColumn;
+    SimTK::Vector MInvJTColumn;
+    for (int j = 0; j < nst; ++j) {
+        unitForce[j / 3][j % 3] = 1;
+        matter.multiplyByStationJacobianTranspose(
+                s, _bodies, _stations, unitForce, JTColumn);
+        unitForce[j / 3][j % 3] = 0;
+        matter.multiplyByMInv(s, JTColumn, MInvJTColumn);
+        matter.multiplyByStationJacobian(
+                s, _bodies, _stations, MInvJTColumn, JMInvJTColumn);
+        for (int i = 0; i < nst; ++i) {
+            inertiaInverse(i, j) = JMInvJTColumn[i / 3][i % 3];
+        }
+    }
+
+    SimTK::Matrix& inertia = updCacheVariableValue(s, _taskSpaceInertiaCV);
+    if (nst == 0) inertia.resize(0, 0);
+    else SimTK::FactorLU(inertiaInverse).inverse(inertia);
+    markCacheVariableValid(s, _taskSpaceInertiaCV);
+    return inertia;
+}
+
+SimTK::Vector TaskSpaceController::calcGeneralizedForces(
+        const SimTK::State& s) const {
+    const Model& model = getModel();
+    const auto& matter = model.getMatterSubsystem();
+    const int nst = getNumScalarTasks();
+    const int nt = (int)_bodies.size();
+    if (nst == 0) return SimTK::Vector(s.getNU(), 0.0);
+
+    // The Coriolis and gyroscopic forces c, and the gravity forces g (on the
+    // same side of the equations of motion as M udot).
+    SimTK::Vector bias;
+    matter.calcResidualForceIgnoringConstraints(s, SimTK::Vector(0),
+            SimTK::Vector_<SimTK::SpatialVec>(0), SimTK::Vector(0), bias);
+    SimTK::Vector gravity;
+    matter.multiplyBySystemJacobianTranspose(
+            s, model.getGravityForce().getBodyForces(s), gravity);
+    gravity.negateInPlace();
+    if (!get_compensate_gravity()) bias += gravity;
+
+    // The task forces are F = Lambda (a* - Jdot u + J M^-1 bias).
+    SimTK::Vector MInvBias;
+    matter.multiplyByMInv(s, bias, MInvBias);
+    SimTK::Vector_<SimTK::Vec3> JMInvBias;
+    matter.multiplyByStationJacobian(
+            s, _bodies, _stations, MInvBias, JMInvBias);
+    SimTK::Vector_<SimTK::Vec3> JDotu;
+    matter.calcBiasForStationJacobian(s, _bodies, _stations, JDotu);
+
+    SimTK::Vector taskAccelerations(nst);
+    for (int k = 0; k < nt; ++k) {
+        const SimTK::Vec3 acceleration =
+                get_tasks(k).calcDesiredAcceleration(s) - JDotu[k] +
+                JMInvBias[k];
+        for (int i = 0; i < 3; ++i) {
+            taskAccelerations[3 * k + i] = acceleration[i];
+        }
+    }
+    const SimTK::Vector taskForces =
+            getTaskSpaceInertia(s) * taskAccelerations;
+    SimTK::Vector_<SimTK::Vec3> stationForces(nt);
+    for (int k = 0; k < nt; ++k) {
+        stationForces[k] = SimTK::Vec3::getAs(&taskForces[3 * k]);
+    }
+
+    SimTK::Vector generalizedForces;
+    matter.multiplyByStationJacobianTranspose(
+            s, _bodies, _stations, stationForces, generalizedForces);
+    if (get_compensate_gravity()) generalizedForces += gravity;
+    return generalizedForces;
+}
+
+void TaskSpaceController::computeForce(const SimTK::State& s,
+        SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+        SimTK::Vector& generalizedForces) const {
+    generalizedForces += calcGeneralizedForces(s);
+}
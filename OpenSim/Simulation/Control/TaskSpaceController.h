@@ -0,0 +1,144 @@
+#ifndef OPENSIM_TASK_SPACE_CONTROLLER_H_
+#define OPENSIM_TASK_SPACE_CONTROLLER_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  TaskSpaceController.h                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Simulation/Model/Force.h>
+#include <OpenSim/Simulation/Model/PhysicalFrame.h>
+
+namespace OpenSim {
+
+/** A task of a TaskSpaceController: a point fixed on a frame (the station)
+is driven to a target location in ground with the task-space acceleration
+
+\f[ \ddot{x}^* = k (x_{target} - x) - d \dot{x} \f]
+
+where \f$ x \f$ and \f$ \dot{x} \f$ are the location and velocity of the
+station in ground, \f$ k \f$ is the stiffness and \f$ d \f$ the damping of the
+task. The target may be changed between the steps of a simulation with
+set_target(). */
+class OSIMSIMULATION_API StationTask : public Component {
+OpenSim_DECLARE_CONCRETE_OBJECT(StationTask, Component);
+public:
+    OpenSim_DECLARE_PROPERTY(location, SimTK::Vec3,
+        "The location of the station in the frame (m).");
+    OpenSim_DECLARE_PROPERTY(target, SimTK::Vec3,
+        "The target location of the station, in ground (m).");
+    OpenSim_DECLARE_PROPERTY(stiffness, double,
+        "The gain of the error in location (1/s^2). Default: 100.");
+    OpenSim_DECLARE_PROPERTY(damping, double,
+        "The gain of the velocity of the station (1/s). Default: 20.");
+
+    OpenSim_DECLARE_SOCKET(frame, PhysicalFrame,
+        "The frame on which the station is fixed.");
+
+    StationTask();
+    StationTask(const std::string& name, const PhysicalFrame& frame,
+            const SimTK::Vec3& location, const SimTK::Vec3& target);
+
+    /** The desired acceleration of the station in ground; the State must be
+    realized to Velocity. */
+    SimTK::Vec3 calcDesiredAcceleration(const SimTK::State& s) const;
+
+private:
+    void constructProperties();
+};
+
+/** An operational-space (task-space) controller [1] that applies the
+generalized forces
+
+\f[ \tau = J^T \Lambda (\ddot{x}^* - \dot{J}u + J M^{-1} c) + g \f]
+
+so that the stations of its tasks (see StationTask) have the desired
+accelerations \f$ \ddot{x}^* \f$ (i.e., \f$ J \dot{u} + \dot{J} u =
+\ddot{x}^* \f$), where \f$ J \f$ is the Jacobian of the stations (3 rows per
+task), \f$ M \f$ the mass matrix, \f$ \Lambda = (J M^{-1} J^T)^{-1} \f$ the
+task-space inertia, \f$ c \f$ the Coriolis and gyroscopic generalized forces,
+and \f$ g \f$ the generalized forces of gravity, which are compensated in the
+nullspace of the tasks (the forces are \f$ J^T F + N^T g \f$ with the task
+forces \f$ F = \Lambda \ddot{x}^* + \mu + p \f$ of [1]). With
+`compensate_gravity` off, only the tasks are compensated for gravity
+(\f$ c \f$ is replaced by \f$ c + g \f$ and the last term is omitted).
+
+The forces are applied directly to the mobilities, as by ideal actuators at
+every degree of freedom, and the task accelerations are achieved only if
+gravity is the only other force applied to the model (e.g., the muscles are
+disabled). Constraints are ignored, and the tasks must not be redundant
+(\f$ J M^{-1} J^T \f$ must be invertible); there must be at most as many
+scalar tasks (3 per task) as degrees of freedom.
+
+No dense matrix with a dimension of the number of degrees of freedom is
+formed: the products with \f$ J \f$, \f$ J^T \f$ and \f$ M^{-1} \f$ are
+computed with the O(n) operators of SimTK::SimbodyMatterSubsystem for all the
+tasks at once; \f$ M^{-1} \f$ reuses the articulated-body inertias that
+Simbody computes once per configuration. \f$ \Lambda \f$, which depends only
+on the configuration, is cached (see getTaskSpaceInertia()), so evaluating
+the forces at several states with the same configuration (e.g., the stages of
+an integration step that change only the speeds) computes it once.
+
+[1] Khatib, Oussama, et al. "Robotics-based synthesis of human motion."
+Journal of physiology-Paris 103.3 (2009): 211-219. */
+class OSIMSIMULATION_API TaskSpaceController : public Force {
+OpenSim_DECLARE_CONCRETE_OBJECT(TaskSpaceController, Force);
+public:
+    OpenSim_DECLARE_LIST_PROPERTY(tasks, StationTask,
+        "The station tasks, all with the same priority.");
+    OpenSim_DECLARE_PROPERTY(compensate_gravity, bool,
+        "Compensate gravity in the nullspace of the tasks (default: true).");
+
+    TaskSpaceController();
+
+    /** Add a task; this controller takes ownership of it. */
+    void addTask(StationTask* task);
+
+    /** The number of scalar tasks (3 per task). */
+    int getNumScalarTasks() const { return 3 * getProperty_tasks().size(); }
+
+    /** The task-space inertia \f$ \Lambda \f$ (3 rows and columns per task,
+    in the order of the tasks); the State must be realized to Position. */
+    const SimTK::Matrix& getTaskSpaceInertia(const SimTK::State& s) const;
+
+    /** The generalized forces that this controller applies; the State must be
+    realized to Velocity. */
+    SimTK::Vector calcGeneralizedForces(const SimTK::State& s) const;
+
+protected:
+    void computeForce(const SimTK::State& s,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& generalizedForces) const override;
+
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+    void extendRealizeTopology(SimTK::State& state) const override;
+
+private:
+    void constructProperties();
+
+    // The bodies and stations (in the body frames) of the tasks.
+    mutable SimTK::Array_<SimTK::MobilizedBodyIndex> _bodies;
+    mutable SimTK::Array_<SimTK::Vec3> _stations;
+
+    mutable CacheVariable<SimTK::Matrix> _taskSpaceInertiaCV;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_TASK_SPACE_CONTROLLER_H_
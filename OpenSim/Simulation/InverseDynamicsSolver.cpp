@@ -23,13 +23,29 @@
 
 #include "InverseDynamicsSolver.h"
 #include "Model/Model.h"
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/FunctionSet.h>
+#include <OpenSim/Common/GCVSpline.h>
+
+#include <algorithm>
+#include <memory>
 
 using namespace std;
 using namespace SimTK;
 
 namespace OpenSim {
 
+namespace {
+    // Evaluate function `index` of the set (or a derivative), bypassing the
+    // generic SimTK::Function interface for GCVSpline's.
+    double evaluateCoordinateFunction(const FunctionSet& Qs, int index,
+            int derivOrder, double time) {
+        const auto* spline = dynamic_cast<const GCVSpline*>(&Qs.get(index));
+        if (spline) { return spline->evaluate(time, derivOrder); }
+        return Qs.evaluate(index, derivOrder, time);
+    }
+}
+
 //______________________________________________________________________________
 /**
  * An implementation of the InverseDynamicsSolver 
@@ -116,9 +132,9 @@ Vector InverseDynamicsSolver::solve(SimTK::State &s, const FunctionSet &Qs, doub
     Vector &udot = s.updUDot();
 
     for(int i=0; i<nq; i++){
-        q[i] = Qs.evaluate(i, 0, time);
-        u[i] = Qs.evaluate(i, 1, time);
-        udot[i] = Qs.evaluate(i, 2, time);
+        q[i] = evaluateCoordinateFunction(Qs, i, 0, time);
+        u[i] = evaluateCoordinateFunction(Qs, i, 1, time);
+        udot[i] = evaluateCoordinateFunction(Qs, i, 2, time);
     }
 
     // Perform general inverse dynamics
@@ -146,12 +162,14 @@ Vector InverseDynamicsSolver::solve(SimTK::State& s, const FunctionSet& Qs,
     Vector& udot = s.updUDot();
 
     for (int i = 0; i < nq; i++) {
-        q[i] = Qs.evaluate(i, 0, time);
+        q[i] = evaluateCoordinateFunction(Qs, i, 0, time);
     }
 
     for (int i = 0; i < nu; i++) {
-        u[i] = Qs.evaluate(coordinatesToSpeedsIndexMap[i], 1, time);
-        udot[i] = Qs.evaluate(coordinatesToSpeedsIndexMap[i], 2, time);
+        u[i] = evaluateCoordinateFunction(
+                Qs, coordinatesToSpeedsIndexMap[i], 1, time);
+        udot[i] = evaluateCoordinateFunction(
+                Qs, coordinatesToSpeedsIndexMap[i], 2, time);
     }
 
     // Perform general inverse dynamics
@@ -195,4 +213,36 @@ void InverseDynamicsSolver::solve(SimTK::State& s, const FunctionSet& Qs,
     }
 }
 
+void InverseDynamicsSolver::solve(const SimTK::State& s, const FunctionSet& Qs,
+        const std::vector<int>& coordinatesToSpeedsIndexMap,
+        TimeSeriesTable& genForceTable, int numThreads) {
+    if ((int)genForceTable.getNumColumns() != s.getNU()) {
+        throw Exception("InverseDynamicsSolver::solve genForceTable must have "
+                        "'nu' columns");
+    }
+    const std::vector<double>& times = genForceTable.getIndependentColumn();
+    const int nt = (int)times.size();
+    if (nt == 0) { return; }
+    numThreads = std::min(getNumThreadsOrDefault(numThreads), nt);
+
+    // Functions may cache intermediate results during evaluation (e.g.,
+    // GCVSpline), so each thread evaluates its own copy. The copies are made
+    // here, on the calling thread.
+    std::vector<SimTK::State> states(numThreads, s);
+    std::vector<std::unique_ptr<FunctionSet>> functions(numThreads);
+    for (int i = 0; i < numThreads; ++i) {
+        functions[i].reset(Qs.clone());
+    }
+
+    auto& genForces = genForceTable.updMatrix();
+    parallelForChunks(nt, numThreads,
+            [&](int chunk, int begin, int end) {
+                for (int i = begin; i < end; ++i) {
+                    genForces.updRow(i) = ~solve(states[chunk],
+                            *functions[chunk], coordinatesToSpeedsIndexMap,
+                            times[i]);
+                }
+            });
+}
+
 } // end of namespace OpenSim
\ No newline at end of file
@@ -25,6 +25,7 @@
 
 #include "Solver.h"
 #include "SimTKcommon/internal/State.h"
+#include <OpenSim/Common/TimeSeriesTable.h>
 
 namespace OpenSim {
 
@@ -121,6 +122,20 @@ public:
             const std::vector<int> coordinatesToSpeedsIndexMap,
             const SimTK::Array_<double>& times,
             SimTK::Array_<SimTK::Vector>& genForceTrajectory);
+
+    /** Solve for the generalized-coordinate forces at every time in the
+       independent column of a preallocated TimeSeriesTable, splitting the
+       frames into contiguous blocks that are solved concurrently. The table
+       must have one column per u in the provided SimTK::State; row i of the
+       table is filled with the forces at the i'th time. Each thread works on
+       its own copy of the SimTK::State `s` and of the coordinate functions
+       `Qs`; the model itself is shared and is only used through const access.
+       Unlike the overloads above, the model's analyses are not stepped.
+       @param numThreads number of threads to use; a value of 0 or less uses
+       all available hardware threads. */
+    virtual void solve(const SimTK::State& s, const FunctionSet& Qs,
+            const std::vector<int>& coordinatesToSpeedsIndexMap,
+            TimeSeriesTable& genForceTable, int numThreads = -1);
 #endif
 //=============================================================================
 };  // END of class InverseDynamicsSolver
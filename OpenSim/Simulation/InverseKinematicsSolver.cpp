@@ -31,6 +31,41 @@
 using namespace std;
 using namespace SimTK;
 
+namespace {
+    // Store the quaternion of rotation R as column i of (w, x, y, z) rows of
+    // n quaternions each.
+    void storeQuaternion(const SimTK::Rotation& R, int i, int n,
+            double* quaternions) {
+        const SimTK::Quaternion q = R.convertRotationToQuaternion();
+        for (int k = 0; k < 4; ++k) quaternions[k * n + i] = q[k];
+    }
+
+    // Compute the angles (in [0, pi]) of the rotations from each of the n
+    // unit quaternions a to the corresponding quaternion b, whose (w, x, y, z)
+    // components are in consecutive rows of n values. The rotation from a to
+    // b is conj(a)*b, whose angle is computed with atan2 rather than acos to
+    // remain accurate for small errors.
+    void calcQuaternionErrorAngles(int n, const double* a, const double* b,
+            double* angles) {
+        const double* aw = a;         const double* bw = b;
+        const double* ax = a + n;     const double* bx = b + n;
+        const double* ay = a + 2 * n; const double* by = b + 2 * n;
+        const double* az = a + 3 * n; const double* bz = b + 3 * n;
+        for (int i = 0; i < n; ++i) {
+            const double w = aw[i]*bw[i] + ax[i]*bx[i] + ay[i]*by[i]
+                    + az[i]*bz[i];
+            const double x = aw[i]*bx[i] - bw[i]*ax[i]
+                    - (ay[i]*bz[i] - az[i]*by[i]);
+            const double y = aw[i]*by[i] - bw[i]*ay[i]
+                    - (az[i]*bx[i] - ax[i]*bz[i]);
+            const double z = aw[i]*bz[i] - bw[i]*az[i]
+                    - (ax[i]*by[i] - ay[i]*bx[i]);
+            angles[i] = 2 * std::atan2(std::sqrt(x*x + y*y + z*z),
+                                       std::abs(w));
+        }
+    }
+}
+
 namespace OpenSim {
 
 //______________________________________________________________________________
@@ -57,38 +92,9 @@ InverseKinematicsSolver::InverseKinematicsSolver(const Model& model,
           _orientationsReference(orientationsReference) {
 
     setAuthors("Ajay Seth, Ayman Habib");
-    
-    if (_markersReference && _markersReference->getNumRefs() > 0) {
-        // Do some consistency checking for markers
-        const MarkerSet &modelMarkerSet = getModel().getMarkerSet();
 
-        if (modelMarkerSet.getSize() < 1) {
-            log_error("InverseKinematicsSolver: Model has no markers!");
-            throw Exception("InverseKinematicsSolver: Model has no markers!");
-        }
-        const SimTK::Array_<std::string>& markerNames
-            = _markersReference->getNames(); // size and content as in trc file
+    checkMarkersReference();
 
-        if (markerNames.size() < 1) {
-            log_error("InverseKinematicsSolver: No markers available from data provided.");
-            throw Exception("InverseKinematicsSolver: No markers available from data provided.");
-        }
-        int index = 0, cnt = 0;
-        for (unsigned int i = 0; i < markerNames.size(); i++) {
-            // Check if we have this marker in the model, else ignore it
-            index = modelMarkerSet.getIndex(markerNames[i], index);
-            if (index >= 0) //found corresponding model
-                cnt++;
-        }
-
-        if (cnt < 1) {
-            log_error("InverseKinematicsSolver: Marker data does not correspond to any model markers.");
-            throw Exception("InverseKinematicsSolver: Marker data does not correspond to any model markers.");
-        }
-        if (cnt < 4)
-            log_warn("WARNING: InverseKinematicsSolver found only {} markers to track.", cnt);
-
-    }
     if (_orientationsReference && _orientationsReference->getNumRefs() > 0) {
         const SimTK::Array_<std::string>& sensorNames =
                 _orientationsReference
@@ -122,6 +128,47 @@ InverseKinematicsSolver::InverseKinematicsSolver(const Model& model,
     }
 }
 
+void InverseKinematicsSolver::checkMarkersReference() const
+{
+    if (_markersReference && _markersReference->getNumRefs() > 0) {
+        // Do some consistency checking for markers
+        const MarkerSet &modelMarkerSet = getModel().getMarkerSet();
+
+        if (modelMarkerSet.getSize() < 1) {
+            log_error("InverseKinematicsSolver: Model has no markers!");
+            throw Exception("InverseKinematicsSolver: Model has no markers!");
+        }
+        const SimTK::Array_<std::string>& markerNames
+            = _markersReference->getNames(); // size and content as in trc file
+
+        if (markerNames.size() < 1) {
+            log_error("InverseKinematicsSolver: No markers available from data provided.");
+            throw Exception("InverseKinematicsSolver: No markers available from data provided.");
+        }
+        int index = 0, cnt = 0;
+        for (unsigned int i = 0; i < markerNames.size(); i++) {
+            // Check if we have this marker in the model, else ignore it
+            index = modelMarkerSet.getIndex(markerNames[i], index);
+            if (index >= 0) //found corresponding model
+                cnt++;
+        }
+
+        if (cnt < 1) {
+            log_error("InverseKinematicsSolver: Marker data does not correspond to any model markers.");
+            throw Exception("InverseKinematicsSolver: Marker data does not correspond to any model markers.");
+        }
+        if (cnt < 4)
+            log_warn("WARNING: InverseKinematicsSolver found only {} markers to track.", cnt);
+    }
+}
+
+void InverseKinematicsSolver::setMarkersReference(
+        std::shared_ptr<MarkersReference> markersReference)
+{
+    _markersReference = markersReference;
+    checkMarkersReference();
+}
+
 int InverseKinematicsSolver::getNumMarkersInUse() const
 {
     return _markerAssemblyCondition->getNumMarkers();
@@ -289,6 +336,33 @@ void InverseKinematicsSolver::
                     findCurrentMarkerErrorSquared(SimTK::Markers::MarkerIx(i));
 }
 
+/* Compute the locations of all markers in ground once, and their squared
+errors from these locations (as Markers::findCurrentMarkerErrorSquared(), an
+observation that is missing or not finite has no error). */
+void InverseKinematicsSolver::computeCurrentMarkerLocationsAndSquaredErrors(
+        SimTK::Array_<SimTK::Vec3> &markerLocations,
+        SimTK::Array_<double> &squaredMarkerErrors)
+{
+    const int nm = _markerAssemblyCondition->getNumMarkers();
+    markerLocations.resize(nm);
+    squaredMarkerErrors.resize(nm);
+    for (int i = 0; i < nm; ++i) {
+        const SimTK::Markers::MarkerIx mx(i);
+        markerLocations[i] =
+                _markerAssemblyCondition->findCurrentMarkerLocation(mx);
+        const SimTK::Markers::ObservationIx ox =
+                _markerAssemblyCondition->getObservationIxForMarker(mx);
+        squaredMarkerErrors[i] = 0;
+        if (!ox.isValid()) continue;
+        const SimTK::Vec3& observation =
+                _markerAssemblyCondition->getObservation(ox);
+        if (observation.isFinite()) {
+            squaredMarkerErrors[i] =
+                    (markerLocations[i] - observation).normSqr();
+        }
+    }
+}
+
 /* Marker errors are reported in order different from tasks file or model, find name corresponding to passed in index  */
 std::string InverseKinematicsSolver::getMarkerNameForIndex(int markerIndex) const
 {
@@ -353,10 +427,34 @@ double InverseKinematicsSolver::computeCurrentOrientationError(int osensorIndex)
 void InverseKinematicsSolver::computeCurrentOrientationErrors(
                                           SimTK::Array_<double>& osensorErrors)
 {
-    osensorErrors.resize(_orientationAssemblyCondition->getNumOSensors());
-    for (unsigned int i = 0; i<osensorErrors.size(); i++)
-        osensorErrors[i] = _orientationAssemblyCondition->
-        findCurrentOSensorError(OrientationSensors::OSensorIx(i));
+    const int nos = _orientationAssemblyCondition->getNumOSensors();
+    osensorErrors.resize(nos);
+    if (nos == 0) return;
+
+    // The model o-sensor orientations in ground, from the body rotations of
+    // the assembler's current solution.
+    const SimTK::State& s = getAssembler().getInternalState();
+    getModel().getMultibodySystem().realize(s, SimTK::Stage::Position);
+    const SimTK::SimbodyMatterSubsystem& matter = getModel().getMatterSubsystem();
+    _currentOSensorQuaternions.resize(4 * nos);
+    for (int i = 0; i < nos; ++i) {
+        const SimTK::Rotation& R_GB =
+                matter.getMobilizedBody(_osensorBodies[i]).getBodyRotation(s);
+        storeQuaternion(R_GB * _osensorRotationsInBodies[i], i, nos,
+                _currentOSensorQuaternions.data());
+    }
+
+    calcQuaternionErrorAngles(nos, _currentOSensorQuaternions.data(),
+            _observedOSensorQuaternions.data(), osensorErrors.data());
+
+    // Leave o-sensors without a (finite) observation to the assembly
+    // condition.
+    for (int i = 0; i < nos; ++i) {
+        if (SimTK::isNaN(osensorErrors[i])) {
+            osensorErrors[i] = _orientationAssemblyCondition->
+                findCurrentOSensorError(OrientationSensors::OSensorIx(i));
+        }
+    }
 }
 
 /* Orientation errors may be reported in an order that may be different from
@@ -379,6 +477,9 @@ void InverseKinematicsSolver::setupGoals(SimTK::State &s)
 
     setupOrientationsGoal(s);
 
+    // The least-squares method is set up for the new goals in the next frame.
+    _leastSquaresIsSetUp = false;
+
     updateGoals(s);
 }
 
@@ -403,6 +504,9 @@ void InverseKinematicsSolver::setupMarkersGoal(SimTK::State &s)
 
     int index = -1;
     SimTK::Transform X_BF;
+    _markerBodies.clear();
+    _markerStations.clear();
+    _markerObservationIndices.clear();
     //Loop through all markers in the reference
     for (unsigned int i = 0; i < markerNames.size(); ++i) {
         // Check if we have this marker in the model, else ignore it
@@ -416,6 +520,9 @@ void InverseKinematicsSolver::setupMarkersGoal(SimTK::State &s)
             _markerAssemblyCondition->
                 addMarker(marker.getName(), mobod, X_BF*marker.get_location(),
                     markerWeights[i]);
+            _markerBodies.push_back(mobod.getMobilizedBodyIndex());
+            _markerStations.push_back(X_BF*marker.get_location());
+            _markerObservationIndices.push_back(i);
         }
     }
 
@@ -448,18 +555,26 @@ void InverseKinematicsSolver::setupOrientationsGoal(SimTK::State &s)
     _orientationsReference->getWeights(s, orientationWeights);
     // get orientation sensors defined by the model 
     const auto onFrames = getModel().getComponentList<PhysicalFrame>();
+    _osensorBodies.clear();
+    _osensorRotationsInBodies.clear();
+    _osensorObservationIndices.clear();
 
     for (const auto& modelFrame : onFrames) {
         const std::string& modelFrameName = modelFrame.getName();
         auto found = std::find(osensorNames.begin(), osensorNames.end(), modelFrameName);
         if (found != osensorNames.end()) {
             int index = (int)std::distance(osensorNames.begin(), found);
+            const SimTK::Rotation R_BO =
+                    modelFrame.findTransformInBaseFrame().R();
             _orientationAssemblyCondition->addOSensor(modelFrameName,
-                modelFrame.getMobilizedBodyIndex(),
-                modelFrame.findTransformInBaseFrame().R(),
+                modelFrame.getMobilizedBodyIndex(), R_BO,
                 orientationWeights[index]);
+            _osensorBodies.push_back(modelFrame.getMobilizedBodyIndex());
+            _osensorRotationsInBodies.push_back(R_BO);
+            _osensorObservationIndices.push_back(index);
         }
     }
+    _observedOSensorQuaternions.assign(4 * _osensorBodies.size(), SimTK::NaN);
 
     // Add orientations goal to the ik objective and transfer ownership of the 
     // goal (AssemblyCondition) to Assembler
@@ -481,12 +596,10 @@ void InverseKinematicsSolver::updateGoals(SimTK::State &s)
         double nextTime = NaN;
         if (_orientationsReference &&
                 _orientationsReference->getNumRefs() > 0) {
-            SimTK::Array_<SimTK::Rotation> orientationValues;
             nextTime = _orientationsReference->getNextValuesAndTime(
-                    orientationValues);
+                    _orientationValues);
             s.setTime(nextTime);
-            _orientationAssemblyCondition->moveAllObservations(
-                    orientationValues);
+            moveOrientationObservations();
         }
         // update coordinates if any based on new time
         AssemblySolver::updateGoals(s);
@@ -498,16 +611,263 @@ void InverseKinematicsSolver::updateGoals(SimTK::State &s)
     double nextTime = s.getTime();
     // specify the marker observations to be matched
     if (_markersReference && _markersReference->getNumRefs() > 0) {
-        SimTK::Array_<SimTK::Vec3> markerValues;
-        _markersReference->getValuesAtTime(nextTime, markerValues);
-        _markerAssemblyCondition->moveAllObservations(markerValues);
+        _markersReference->getValuesAtTime(nextTime, _markerValues);
+        _markerAssemblyCondition->moveAllObservations(_markerValues);
     }
 
     // specify the orientation observations to be matched
     if (_orientationsReference && _orientationsReference->getNumRefs() > 0) {
-        SimTK::Array_<SimTK::Rotation> orientationValues;
-        _orientationsReference->getValuesAtTime(nextTime, orientationValues);
-        _orientationAssemblyCondition->moveAllObservations(orientationValues);
+        _orientationsReference->getValuesAtTime(nextTime, _orientationValues);
+        moveOrientationObservations();
+    }
+}
+
+void InverseKinematicsSolver::track(SimTK::State& s)
+{
+    // With time advanced from the references, updating the goals consumes the
+    // observations, so the goals can only be updated once per frame.
+    if (_useLeastSquaresTracking && !_advanceTimeFromReference &&
+            getAssembler().isInitialized()) {
+        updateGoals(s);
+        if (trackByLeastSquares(s)) return;
+        log_debug("InverseKinematicsSolver: the least-squares method did not "
+                  "solve the frame at t = {}; using the Assembler.",
+                s.getTime());
+    }
+    AssemblySolver::track(s);
+}
+
+bool InverseKinematicsSolver::trackByLeastSquares(SimTK::State& s)
+{
+    const SimTK::Assembler& assembler = getAssembler();
+    const SimTK::State& internalState = assembler.getInternalState();
+    const SimTK::SimbodyMatterSubsystem& matter =
+            getModel().getMatterSubsystem();
+    const int nf = assembler.getNumFreeQs();
+
+    if (!_leastSquaresIsSetUp) {
+        // The method only handles the marker and coordinate goals.
+        if (nf == 0 || !_osensorBodies.empty()) return false;
+        for (SimTK::ConstraintIndex cx(0); cx < matter.getNumConstraints();
+                ++cx) {
+            if (!matter.getConstraint(cx).isDisabled(internalState))
+                return false;
+        }
+        _leastSquaresState = internalState;
+        const int nq = _leastSquaresState.getNQ();
+        std::vector<int> freeQOfQ(nq, -1);
+        _freeQIndices.resize(nf);
+        for (SimTK::Assembler::FreeQIndex fx(0); fx < nf; ++fx) {
+            _freeQIndices[fx] = assembler.getQIndexOfFreeQ(fx);
+            freeQOfQ[_freeQIndices[fx]] = fx;
+        }
+        auto getFreeQ = [&](SimTK::MobilizedBodyIndex body,
+                SimTK::MobilizerQIndex q) -> int {
+            return freeQOfQ[(int)matter.getMobilizedBody(body)
+                    .getFirstQIndex(_leastSquaresState) + (int)q];
+        };
+        _freeQMin.assign(nf, -SimTK::Infinity);
+        _freeQMax.assign(nf, SimTK::Infinity);
+        for (const auto& range : getCoordinateRanges()) {
+            const int f = getFreeQ(range.body, range.q);
+            if (f < 0) continue;
+            _freeQMin[f] = range.min;
+            _freeQMax[f] = range.max;
+        }
+        _coordinateGoalFreeQs.clear();
+        for (const auto& goal : getCoordinateGoals()) {
+            _coordinateGoalFreeQs.push_back(getFreeQ(goal.body, goal.q));
+        }
+        _freeQs.resize(nf);
+        _leastSquaresIsSetUp = true;
+    }
+
+    // The markers that are part of the objective in this frame. As in the
+    // Markers assembly condition, the weights of the markers are normalized by
+    // their sum.
+    _activeMarkerBodies.clear();
+    _activeMarkerStations.clear();
+    _activeMarkers.clear();
+    _activeMarkerSqrtWeights.clear();
+    double totalWeight = 0;
+    for (int k = 0; k < (int)_markerBodies.size(); ++k) {
+        const double weight = _markerAssemblyCondition->getMarkerWeight(
+                SimTK::Markers::MarkerIx(k));
+        if (weight == 0 ||
+                !_markerValues[_markerObservationIndices[k]].isFinite())
+            continue;
+        _activeMarkerBodies.push_back(_markerBodies[k]);
+        _activeMarkerStations.push_back(_markerStations[k]);
+        _activeMarkers.push_back(k);
+        _activeMarkerSqrtWeights.push_back(weight);
+        totalWeight += weight;
+    }
+    for (auto& w : _activeMarkerSqrtWeights) w = std::sqrt(w / totalWeight);
+
+    // Start from the solution of the previous frame, as the Assembler does.
+    _leastSquaresState.updQ() = internalState.getQ();
+    const double tolerance = 1e-2 * getAccuracy();
+    const int maxIterations = 50;
+    double cost = calcLeastSquaresResiduals(true);
+    bool converged = false;
+    int numEvaluations = 1;
+    std::vector<double> diagonal(nf);
+    for (int iter = 0; iter < maxIterations && !converged; ++iter) {
+        // Gauss-Newton normal equations: (J^T J) dq = -J^T r.
+        _normalMatrix = ~_residualJacobian * _residualJacobian;
+        _gradient = ~_residualJacobian * _residuals;
+        SimTK::Vector& q = _leastSquaresState.updQ();
+        for (int f = 0; f < nf; ++f) _freeQs[f] = q[_freeQIndices[f]];
+
+        // Increase the damping until a step decreases the cost.
+        bool decreased = false;
+        double maxStep = 0;
+        for (int attempt = 0; attempt < 20 && !decreased; ++attempt) {
+            SimTK::Matrix& A = _normalMatrix;
+            for (int f = 0; f < nf; ++f) {
+                diagonal[f] = A(f, f);
+                A(f, f) += _leastSquaresDamping *
+                           std::max(diagonal[f], SimTK::SignificantReal);
+            }
+            _normalMatrixFactor.factor(A);
+            for (int f = 0; f < nf; ++f) A(f, f) = diagonal[f];
+            _normalMatrixFactor.solve(-_gradient, _step);
+
+            maxStep = 0;
+            SimTK::Vector& qTrial = _leastSquaresState.updQ();
+            for (int f = 0; f < nf; ++f) {
+                const double value = SimTK::clamp(_freeQMin[f],
+                        _freeQs[f] + _step[f], _freeQMax[f]);
+                maxStep = std::max(maxStep, std::abs(value - _freeQs[f]));
+                qTrial[_freeQIndices[f]] = value;
+            }
+            const double trialCost = calcLeastSquaresResiduals(false);
+            ++numEvaluations;
+            if (SimTK::isFinite(trialCost) && trialCost <= cost) {
+                decreased = true;
+                converged = maxStep <= tolerance ||
+                            cost - trialCost <= 1e-12 * cost;
+                cost = trialCost;
+                _leastSquaresDamping =
+                        std::max(0.1 * _leastSquaresDamping, 1e-12);
+            } else {
+                _leastSquaresDamping *= 10;
+            }
+        }
+        if (!decreased) {
+            // No step decreases the cost: this is a minimum, unless the
+            // steps were large.
+            SimTK::Vector& qBest = _leastSquaresState.updQ();
+            for (int f = 0; f < nf; ++f) qBest[_freeQIndices[f]] = _freeQs[f];
+            converged = maxStep <= tolerance;
+            break;
+        }
+        if (!converged) {
+            calcLeastSquaresResiduals(true);
+            ++numEvaluations;
+        }
+    }
+    if (_leastSquaresDamping > 1e6) _leastSquaresDamping = 1e-3;
+    if (!converged || !SimTK::isFinite(cost)) return false;
+
+    log_debug("Least-squares tracking: t= {} (cost={}, evals={})",
+            s.getTime(), cost, numEvaluations);
+
+    // Make the solution the Assembler's, for the errors of the goals and
+    // the next frame.
+    const SimTK::Vector& q = _leastSquaresState.getQ();
+    for (int f = 0; f < nf; ++f) _freeQs[f] = q[_freeQIndices[f]];
+    updAssembler().setInternalStateFromFreeQs(_freeQs);
+    getModel().getMultibodySystem().realize(
+            getAssembler().getInternalState(), SimTK::Stage::Position);
+    getAssembler().updateFromInternalState(s);
+    return true;
+}
+
+double InverseKinematicsSolver::calcLeastSquaresResiduals(bool withJacobian)
+{
+    const SimTK::State& state = _leastSquaresState;
+    const SimTK::SimbodyMatterSubsystem& matter =
+            getModel().getMatterSubsystem();
+    getModel().getMultibodySystem().realize(state, SimTK::Stage::Position);
+
+    const int na = (int)_activeMarkers.size();
+    const auto& coordinateGoals = getCoordinateGoals();
+    const int nc = (int)coordinateGoals.size();
+    const int nf = (int)_freeQIndices.size();
+    SimTK::Vector& r = withJacobian ? _residuals : _trialResiduals;
+    r.resize(3 * na + nc);
+
+    // The weighted marker errors.
+    for (int i = 0; i < na; ++i) {
+        const int k = _activeMarkers[i];
+        const SimTK::Vec3 location = matter.getMobilizedBody(
+                _markerBodies[k]).findStationLocationInGround(
+                        state, _markerStations[k]);
+        const SimTK::Vec3 error =
+                location - _markerValues[_markerObservationIndices[k]];
+        for (int j = 0; j < 3; ++j)
+            r[3 * i + j] = _activeMarkerSqrtWeights[i] * error[j];
+    }
+    // The weighted coordinate errors.
+    const SimTK::Vector& q = state.getQ();
+    for (int i = 0; i < nc; ++i) {
+        const int qx = (int)matter.getMobilizedBody(
+                coordinateGoals[i].body).getFirstQIndex(state) +
+                (int)coordinateGoals[i].q;
+        r[3 * na + i] = std::sqrt(coordinateGoals[i].weight) *
+                        (q[qx] - coordinateGoals[i].value);
+    }
+
+    if (withJacobian) {
+        // The marker rows: the station Jacobians (with respect to the u's),
+        // times N^-1 to get the derivatives with respect to the q's.
+        _residualJacobian.resize(3 * na + nc, nf);
+        _residualJacobian = 0;
+        if (na > 0) {
+            matter.calcStationJacobian(state, _activeMarkerBodies,
+                    _activeMarkerStations, _stationJacobian);
+            const int nu = state.getNU();
+            _jacobianRowU.resize(nu);
+            for (int row = 0; row < 3 * na; ++row) {
+                for (int j = 0; j < nu; ++j)
+                    _jacobianRowU[j] = _stationJacobian(row, j);
+                matter.multiplyByNInv(state, true, _jacobianRowU,
+                        _jacobianRowQ);
+                const double w = _activeMarkerSqrtWeights[row / 3];
+                for (int f = 0; f < nf; ++f)
+                    _residualJacobian(row, f) =
+                            w * _jacobianRowQ[_freeQIndices[f]];
+            }
+        }
+        // The coordinate rows.
+        for (int i = 0; i < nc; ++i) {
+            const int f = _coordinateGoalFreeQs[i];
+            if (f >= 0) {
+                _residualJacobian(3 * na + i, f) =
+                        std::sqrt(coordinateGoals[i].weight);
+            }
+        }
+    }
+    return r.normSqr();
+}
+
+void InverseKinematicsSolver::moveOrientationObservations()
+{
+    _orientationAssemblyCondition->moveAllObservations(_orientationValues);
+
+    // A NaN quaternion marks an o-sensor without a finite observation.
+    const int nos = (int)_osensorObservationIndices.size();
+    for (int i = 0; i < nos; ++i) {
+        const SimTK::Rotation& R_GS =
+                _orientationValues[_osensorObservationIndices[i]];
+        if (R_GS.isFinite()) {
+            storeQuaternion(R_GS, i, nos, _observedOSensorQuaternions.data());
+        } else {
+            for (int k = 0; k < 4; ++k) {
+                _observedOSensorQuaternions[k * nos + i] = SimTK::NaN;
+            }
+        }
     }
 }
 
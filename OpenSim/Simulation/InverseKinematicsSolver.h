@@ -149,6 +149,14 @@ public:
         solver was constructed. */
     void updateMarkerWeights(const SimTK::Array_<double> &weights);
 
+    /** Replace the marker reference values and weightings to track, e.g., to
+        solve another trial with the same model and coordinate references
+        without constructing a new solver. The marker goal is set up for the
+        new reference when assemble() is called next, which must be done
+        before track(). */
+    void setMarkersReference(
+            std::shared_ptr<MarkersReference> markersReference);
+
     /** Change the weighting of an orientation sensor, given its name. Takes
     effect when assemble() or track() is called next. */
     void updateOrientationWeight(const std::string& orientationName, double value);
@@ -194,6 +202,14 @@ public:
         returned by computeCurrentMarkerErrors(). */
     void computeCurrentSquaredMarkerErrors(SimTK::Array_<double> &markerErrors);
 
+    /** Compute the spatial locations of all markers in the ground frame and
+        their squared-distance errors from the same locations, which is
+        cheaper than calling computeCurrentMarkerLocations() and
+        computeCurrentSquaredMarkerErrors(). */
+    void computeCurrentMarkerLocationsAndSquaredErrors(
+            SimTK::Array_<SimTK::Vec3> &markerLocations,
+            SimTK::Array_<double> &squaredMarkerErrors);
+
     /** Marker locations and errors may be computed in an order that is different
         from tasks file or listed in the model. Return the corresponding marker
         name for an index in the list of marker locations/errors returned by the
@@ -218,7 +234,11 @@ public:
     sensor and its observation, given the o-sensor's index. */
     double computeCurrentOrientationError(int osensorIndex);
     /** Compute all the orientation errors between the model orientation
-    sensors and their observations. */
+    sensors and their observations. The errors are the same as those of
+    computeCurrentOrientationError(), but are computed for all the o-sensors
+    at once: the observed and model o-sensor orientations are stored as
+    quaternions in contiguous arrays (one per component), from which the
+    angles of the error rotations are computed in a single loop. */
     void computeCurrentOrientationErrors(SimTK::Array_<double>& osensorErrors);
 
     /** Orientation sensor locations and errors may be computed in an order that
@@ -226,6 +246,36 @@ public:
     corresponding orientation sensor name for an index in the list of
     orientations returned by the solver. */
     std::string getOrientationSensorNameForIndex(int osensorIndex) const;
+    /** %Set whether track() solves the frames with a Levenberg-Marquardt
+        (damped Gauss-Newton) method specialized for the least-squares
+        objective of the marker and coordinate goals, instead of the
+        general-purpose optimizer of the SimTK::Assembler. The residuals of
+        the least-squares problem are the weighted marker and coordinate
+        errors, whose analytic Jacobian is computed from the station Jacobians
+        of the markers, so that each iteration evaluates the model kinematics
+        only once or twice. The damping of the method carries over from frame
+        to frame. The solution is the same as that of the Assembler, to within
+        the accuracy, but is usually found with far fewer evaluations.
+
+        This applies to problems with only marker and coordinate goals, no
+        enabled model constraints, and at least one unlocked coordinate.
+        Otherwise, or if the method does not converge in a frame, track() uses
+        the Assembler as usual. assemble() always uses the Assembler. The
+        default is false. */
+    void setUseLeastSquaresTracking(bool useLeastSquaresTracking) {
+        _useLeastSquaresTracking = useLeastSquaresTracking;
+    }
+    /** Get whether track() uses the least-squares method (see
+        setUseLeastSquaresTracking()). */
+    bool getUseLeastSquaresTracking() const {
+        return _useLeastSquaresTracking;
+    }
+
+    /** Obtain a model configuration that meets the InverseKinematics
+        conditions given a state that satisfies or is close to satisfying
+        them (see AssemblySolver::track() and setUseLeastSquaresTracking()). */
+    void track(SimTK::State& s) override;
+
     /** indicate whether time is provided by Reference objects or driver program */
     void setAdvanceTimeFromReference(bool newValue) {
         _advanceTimeFromReference = newValue;
@@ -241,6 +291,10 @@ protected:
     void updateGoals(SimTK::State &s) override;
 
 private:
+    /** Check that the markers reference, if it has any markers, corresponds
+        to markers of the model. */
+    void checkMarkersReference() const;
+
     /** Define and apply marker tracking goal to the assembly problem. */
     void setupMarkersGoal(SimTK::State &s);
 
@@ -248,12 +302,81 @@ private:
         assembly problem. */
     void setupOrientationsGoal(SimTK::State &s);
 
+    /** Solve the frame with the least-squares method and update the
+        Assembler's internal state and `s` with the solution (see
+        setUseLeastSquaresTracking()). Returns false, without changing the
+        Assembler or `s`, if the problem does not qualify or the method does
+        not converge. The goals must be up-to-date. */
+    bool trackByLeastSquares(SimTK::State& s);
+
+    /** Compute the least-squares residuals (and, if withJacobian, their
+        Jacobian with respect to the free q's of the Assembler) at the q's of
+        _leastSquaresState, and return the sum of their squares. */
+    double calcLeastSquaresResiduals(bool withJacobian);
+
+    /** Move the orientation observations of the current frame (in
+        _orientationValues) into the assembly condition, and store their
+        quaternions for computeCurrentOrientationErrors(). */
+    void moveOrientationObservations();
+
     // The marker reference values and weightings
     std::shared_ptr<MarkersReference> _markersReference;
 
+    // The marker observations of the current frame, whose memory is reused
+    // from frame to frame.
+    SimTK::Array_<SimTK::Vec3> _markerValues;
+
     // The orientation reference values and weightings
     std::shared_ptr<OrientationsReference> _orientationsReference;
 
+    // The orientation observations of the current frame, whose memory is
+    // reused from frame to frame.
+    SimTK::Array_<SimTK::Rotation> _orientationValues;
+
+    // The mobilized body of each o-sensor (in the order of the OSensorIx),
+    // the orientation of the o-sensor in that body, and the index of its
+    // observation.
+    std::vector<SimTK::MobilizedBodyIndex> _osensorBodies;
+    std::vector<SimTK::Rotation> _osensorRotationsInBodies;
+    std::vector<int> _osensorObservationIndices;
+
+    // The quaternions of the observed and of the current model o-sensor
+    // orientations, with the w, x, y, and z components of all the o-sensors
+    // in consecutive rows (see computeCurrentOrientationErrors()).
+    std::vector<double> _observedOSensorQuaternions;
+    std::vector<double> _currentOSensorQuaternions;
+
+    // The mobilized body, the location in that body, and the index of the
+    // observation of each marker (in the order of the MarkerIx).
+    std::vector<SimTK::MobilizedBodyIndex> _markerBodies;
+    std::vector<SimTK::Vec3> _markerStations;
+    std::vector<int> _markerObservationIndices;
+
+    // The state, indices and work space of the least-squares method (see
+    // trackByLeastSquares()), which are set up in the first frame after
+    // setupGoals() and reused from frame to frame.
+    bool _useLeastSquaresTracking{false};
+    bool _leastSquaresIsSetUp{false};
+    SimTK::State _leastSquaresState;
+    // The index of the q of each free q of the Assembler, and its range.
+    std::vector<SimTK::QIndex> _freeQIndices;
+    std::vector<double> _freeQMin, _freeQMax;
+    // The free q index (or -1) of each coordinate goal.
+    std::vector<int> _coordinateGoalFreeQs;
+    // The markers with a (finite) observation and a nonzero weight in the
+    // current frame, and the square roots of their normalized weights.
+    SimTK::Array_<SimTK::MobilizedBodyIndex> _activeMarkerBodies;
+    SimTK::Array_<SimTK::Vec3> _activeMarkerStations;
+    std::vector<int> _activeMarkers;
+    std::vector<double> _activeMarkerSqrtWeights;
+    SimTK::Vector _residuals, _trialResiduals;
+    SimTK::Matrix _residualJacobian, _stationJacobian;
+    SimTK::Vector _jacobianRowU, _jacobianRowQ;
+    SimTK::Matrix _normalMatrix;
+    SimTK::Vector _gradient, _step, _freeQs;
+    SimTK::FactorLU _normalMatrixFactor;
+    double _leastSquaresDamping{1e-3};
+
     // Markers collectively form a single assembly condition for the 
     // SimTK::Assembler and the memory is managed by the Assembler
     SimTK::ReferencePtr<SimTK::Markers> _markerAssemblyCondition;
@@ -0,0 +1,129 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  BatchManager.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "BatchManager.h"
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Simulation/StatesTrajectoryReporter.h>
+
+#include <algorithm>
+#include <memory>
+
+using namespace OpenSim;
+
+namespace {
+    // The copy of the model used by one thread, and the reporter that records
+    // the states of the simulations on that thread.
+    struct Worker {
+        Worker(const Model& model, double reportTimeInterval) : model(model) {
+            this->model.setUseVisualizer(false);
+            auto* statesReporter = new StatesTrajectoryReporter();
+            statesReporter->setName("batch_manager_states_reporter");
+            statesReporter->set_report_time_interval(reportTimeInterval);
+            this->model.addComponent(statesReporter);
+            reporter.reset(statesReporter);
+        }
+        Model model;
+        SimTK::ReferencePtr<StatesTrajectoryReporter> reporter;
+        bool hasSystem = false;
+    };
+
+    // Set the time and the continuous state variables of `state` to those of
+    // `initialState`.
+    void setContinuousState(const SimTK::State& initialState,
+            SimTK::State& state) {
+        OPENSIM_THROW_IF(initialState.getNQ() != state.getNQ() ||
+                                 initialState.getNU() != state.getNU() ||
+                                 initialState.getNZ() != state.getNZ(),
+                Exception,
+                "Expected the initial state to have {} q's, {} u's, and {} "
+                "z's, but it has {}, {}, and {}.",
+                state.getNQ(), state.getNU(), state.getNZ(),
+                initialState.getNQ(), initialState.getNU(),
+                initialState.getNZ());
+        state.setTime(initialState.getTime());
+        state.updQ() = initialState.getQ();
+        state.updU() = initialState.getU();
+        state.updZ() = initialState.getZ();
+    }
+}
+
+BatchManager::BatchManager(const Model& model) : _model(model) {}
+
+std::vector<StatesTrajectory> BatchManager::integrate(
+        const std::vector<SimTK::State>& initialStates,
+        double finalTime) const {
+    const int numSimulations = (int)initialStates.size();
+    for (int i = 0; i < numSimulations; ++i) {
+        OPENSIM_THROW_IF(finalTime <= initialStates[i].getTime(), Exception,
+                "Expected the final time ({}) to be greater than the time of "
+                "initial state {} ({}).",
+                finalTime, i, initialStates[i].getTime());
+    }
+    std::vector<StatesTrajectory> trajectories(numSimulations);
+    if (numSimulations == 0) return trajectories;
+    const int numThreads =
+            std::min(getNumThreadsOrDefault(_numThreads), numSimulations);
+
+    // The models are copied on the calling thread; their Systems are built on
+    // the threads that use them.
+    std::vector<std::unique_ptr<Worker>> workers(numThreads);
+    for (auto& worker : workers) {
+        worker.reset(new Worker(_model, _reportTimeInterval));
+    }
+
+    parallelForEach(numSimulations, numThreads,
+            [&](int thread, int index) {
+                Worker& worker = *workers[thread];
+                Model& model = worker.model;
+                const SimTK::State& initialState = initialStates[index];
+
+                SimTK::State state;
+                if (_parameterization || !worker.hasSystem) {
+                    if (_parameterization) _parameterization(index, model);
+                    state = model.initSystemFrom(initialState);
+                    worker.hasSystem = true;
+                } else {
+                    state = model.getWorkingState();
+                    setContinuousState(initialState, state);
+                }
+
+                worker.reporter->clear();
+                if (_reportTimeInterval > 0) {
+                    worker.reporter->reserve((size_t)((finalTime -
+                            initialState.getTime()) / _reportTimeInterval) + 2);
+                }
+
+                Manager manager(model);
+                manager.setIntegratorMethod(_integratorMethod);
+                if (!SimTK::isNaN(_integratorAccuracy)) {
+                    manager.setIntegratorAccuracy(_integratorAccuracy);
+                }
+                manager.setPerformAnalyses(false);
+                manager.setWriteToStorage(false);
+                manager.initialize(state);
+                manager.integrate(finalTime);
+
+                trajectories[index] = worker.reporter->releaseStates();
+            });
+
+    return trajectories;
+}
@@ -0,0 +1,133 @@
+#ifndef OPENSIM_BATCH_MANAGER_H_
+#define OPENSIM_BATCH_MANAGER_H_
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  BatchManager.h                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Manager.h"
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/StatesTrajectory.h>
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace OpenSim {
+
+//=============================================================================
+//=============================================================================
+/**
+ * A class that runs many forward simulations of the same model concurrently,
+ * e.g., for Monte Carlo analyses or for tuning controllers. Each simulation
+ * starts from its own initial state and, optionally, uses its own
+ * parameterization of the model (e.g., controller gains); the simulations
+ * are performed with a Manager on multiple threads, each of which owns a copy
+ * of the model. Since simulations may take differing amounts of time, the
+ * threads take the next pending simulation whenever they finish one (see
+ * parallelForEach()).
+ *
+ * @code
+ * BatchManager batch(model);
+ * batch.setIntegratorAccuracy(1e-4);
+ * batch.setReportTimeInterval(0.01);
+ * batch.setParameterization([&](int i, Model& copy) {
+ *     copy.updComponent<PrescribedController>("/controllerset/controller")
+ *             .prescribeControlForActuator("actuator",
+ *                     new Constant(excitations[i]));
+ * });
+ * std::vector<StatesTrajectory> trajectories =
+ *         batch.integrate(initialStates, 1.0);
+ * @endcode
+ *
+ * The initial states must have the same numbers of q's, u's, and z's as the
+ * states of the model (they are typically copies of the model's working
+ * state, with modified values); only the time and the values of these
+ * continuous state variables are taken from the initial states (see
+ * Model::initSystemFrom()). Discrete state variables are initialized from the
+ * properties of the model.
+ *
+ * Analyses of the model are not performed, and the states are not recorded
+ * in a Storage; the states of each simulation are recorded by a
+ * StatesTrajectoryReporter, whose memory is preallocated for the expected
+ * number of reporting times.
+ */
+class OSIMSIMULATION_API BatchManager {
+public:
+    /** A function that modifies the properties of (a copy of) the model for
+    the simulation with the given index, e.g., to change the parameters of a
+    controller.                                                              */
+    typedef std::function<void(int index, Model& model)> Parameterization;
+
+    /** The model is copied; later changes to `model` do not affect this
+    BatchManager.                                                            */
+    BatchManager(const Model& model);
+
+    /** Sets the integrator method used for each simulation (see
+    Manager::setIntegratorMethod()). The default is RungeKuttaMerson.        */
+    void setIntegratorMethod(Manager::IntegratorMethod method) {
+        _integratorMethod = method;
+    }
+    /** Sets the accuracy of the integrator (see
+    Manager::setIntegratorAccuracy()). If not set, the default accuracy of the
+    integrator is used.                                                      */
+    void setIntegratorAccuracy(double accuracy) {
+        _integratorAccuracy = accuracy;
+    }
+    /** Sets the interval between the reported states (s). If the interval is
+    0 (default), the state after every integration step is reported.         */
+    void setReportTimeInterval(double interval) {
+        _reportTimeInterval = interval;
+    }
+    /** Sets the number of threads on which the simulations are performed. A
+    value of 0 or less (default) uses all available hardware threads.        */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+
+    /** Sets a function that is invoked, before simulation `index` and on the
+    thread that performs it, on the copy of the model used for the
+    simulation; the System of the copy is then rebuilt. The function must set
+    all the properties that it changes for any simulation, since the copies of
+    the model are reused for multiple simulations. Without a parameterization
+    (default), the System of each copy is built only once.                   */
+    void setParameterization(Parameterization parameterization) {
+        _parameterization = std::move(parameterization);
+    }
+
+    /** Simulate the model from each of the initial states until `finalTime`,
+    and return the reported states of each simulation, in the order of the
+    initial states. If any simulation fails, the exception is rethrown here
+    (after the running simulations have finished).                           */
+    std::vector<StatesTrajectory> integrate(
+            const std::vector<SimTK::State>& initialStates,
+            double finalTime) const;
+
+private:
+    Model _model;
+    Manager::IntegratorMethod _integratorMethod =
+            Manager::IntegratorMethod::RungeKuttaMerson;
+    double _integratorAccuracy = SimTK::NaN;
+    double _reportTimeInterval = 0;
+    int _numThreads = 0;
+    Parameterization _parameterization;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_BATCH_MANAGER_H_
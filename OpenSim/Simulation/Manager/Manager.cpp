@@ -24,7 +24,14 @@
 /* Note: This code was originally developed by Realistic Dynamics Inc.
  * Author: Frank C. Anderson
  */
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
 #include "Manager.h"
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/AnalysisSet.h>
@@ -40,9 +47,95 @@ using namespace std;
 // STATICS
 //=============================================================================
 std::string Manager::_displayName = "Simulator";
+
+// Performs the Analyses of the states that integrate() records on a separate
+// thread, in the order in which they are recorded.
+class Manager::AnalysisThread {
+public:
+    explicit AnalysisThread(AnalysisSet& analysisSet) :
+        _analysisSet(analysisSet),
+        _thread(&AnalysisThread::run, this) {}
+
+    // Stop without performing the Analyses of the queued states.
+    ~AnalysisThread() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _queue.clear();
+            _done = true;
+        }
+        _changed.notify_all();
+        if (_thread.joinable()) _thread.join();
+    }
+
+    // Queue a copy of the state (waiting if many states are queued already,
+    // so that the copies do not pile up when the Analyses are slower than
+    // the integration).
+    void push(const SimTK::State& s, int step) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _changed.wait(lock, [this] { return _queue.size() < maxQueued; });
+        _queue.push_back({s, step});
+        lock.unlock();
+        _changed.notify_all();
+    }
+
+    // Wait for the Analyses of all the queued states, and rethrow the first
+    // exception of an Analysis.
+    void finish() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _done = true;
+        }
+        _changed.notify_all();
+        if (_thread.joinable()) _thread.join();
+        if (_exception) std::rethrow_exception(_exception);
+    }
+
+private:
+    struct Record {
+        SimTK::State state;
+        int step;
+    };
+    static const std::size_t maxQueued = 64;
+
+    void run() {
+        while (true) {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _changed.wait(lock, [this] { return _done || !_queue.empty(); });
+            if (_queue.empty()) return;
+            Record record = std::move(_queue.front());
+            _queue.pop_front();
+            lock.unlock();
+            _changed.notify_all();
+
+            // After an exception, the results are incomplete anyway.
+            if (_exception) continue;
+            try {
+                if (record.step == 0)
+                    _analysisSet.begin(record.state);
+                else if (record.step < 0)
+                    _analysisSet.end(record.state);
+                else
+                    _analysisSet.step(record.state, record.step);
+            } catch (...) {
+                _exception = std::current_exception();
+            }
+        }
+    }
+
+    AnalysisSet& _analysisSet;
+    std::mutex _mutex;
+    std::condition_variable _changed;
+    std::deque<Record> _queue;
+    bool _done = false;
+    std::exception_ptr _exception;
+    // Started last, once the other members are constructed.
+    std::thread _thread;
+};
+
 //=============================================================================
 // DESTRUCTOR
 //=============================================================================
+Manager::~Manager() = default;
 
 
 //=============================================================================
@@ -63,6 +156,7 @@ Manager::Manager(Model& model, const SimTK::State& state)
 Manager::Manager(Model& model, bool dummyVar) :
        _model(&model),
        _performAnalyses(true),
+       _performAnalysesConcurrently(false),
        _writeToStorage(true),
        _controllerSet(&model.updControllerSet())
 {
@@ -95,10 +189,16 @@ setNull()
     _specifiedDT = false;
     _constantDT = false;
     _dt = 1.0e-4;
+    _recordInterval = 0;
     _performAnalyses=true;
+    _performAnalysesConcurrently=false;
     _writeToStorage=true;
     _tArray.setSize(0);
     _dtArray.setSize(0);
+    _stepSize = SimTK::NaN;
+    resetStepLatencies();
+    _recordPerformanceTrace = false;
+    resetPerformanceStats();
 }
 
 //_____________________________________________________________________________
@@ -236,6 +336,14 @@ getUseSpecifiedDT() const
  * @see setUseSpecifiedDT()
  * @see getUseSpecifiedDT();
  */
+void Manager::setRecordInterval(double interval)
+{
+    OPENSIM_THROW_IF(interval < 0 || SimTK::isNaN(interval), Exception,
+            "Expected the record interval to be non-negative, but got {}.",
+            interval);
+    _recordInterval = interval;
+}
+//_____________________________________________________________________________
 void Manager::
 setUseConstantDT(bool aTrueFalse)
 {
@@ -510,10 +618,15 @@ void Manager::setIntegratorMethod(IntegratorMethod integMethod)
     }
 
     auto& sys = _model->getMultibodySystem();
+    // Destroy the previous integrator before creating the new one, so that
+    // two integrators never exist at the same time (replacing a CPodes
+    // integrator while a new one existed has crashed).
+    _integ.reset();
     switch (integMethod) {
-        //case IntegratorMethod::CPodes:
-        //    _integ.reset(new SimTK::CPodesIntegrator(sys));
-        //    break;
+        case IntegratorMethod::CPodes:
+            _integ.reset(new SimTK::CPodesIntegrator(
+                    sys, SimTK::CPodes::BDF, SimTK::CPodes::Newton));
+            break;
 
         case IntegratorMethod::ExplicitEuler:
             _integ.reset(new SimTK::ExplicitEulerIntegrator(sys));
@@ -652,6 +765,19 @@ const SimTK::State& Manager::integrate(double finalTime)
             "initialized. Call Manager::initialize() first.");
     }
 
+    // The duration of the integration is added to the statistics however
+    // integrate() returns.
+    struct AddWallClockTime {
+        double& wallClockTime;
+        const std::chrono::steady_clock::time_point start =
+                std::chrono::steady_clock::now();
+        ~AddWallClockTime() {
+            wallClockTime += std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start).count();
+        }
+    } addWallClockTime{_wallClockTime};
+    auto lastTraceRow = std::chrono::steady_clock::now();
+
     // Get the internal state
     const SimTK::State& s = _integ->getState();
 
@@ -692,8 +818,22 @@ const SimTK::State& Manager::integrate(double finalTime)
 
     auto status = SimTK::Integrator::InvalidSuccessfulStepStatus;
 
+    // With a record interval, stepTo() returns at each recording time (with
+    // an interpolated state if the integrator stepped past it) rather than
+    // after each step.
+    const bool recordAtInterval = !fixedStep && _recordInterval > 0;
+    int numRecords = 1;
     if (!fixedStep) {
-        _integ->setReturnEveryInternalStep(true);
+        _integ->setReturnEveryInternalStep(!recordAtInterval);
+    }
+
+    // The analysis thread is stopped if the integration throws.
+    struct StopAnalysisThread {
+        std::unique_ptr<AnalysisThread>& thread;
+        ~StopAnalysisThread() { thread.reset(); }
+    } stopAnalysisThread{_analysisThread};
+    if (_performAnalyses && _performAnalysesConcurrently) {
+        _analysisThread.reset(new AnalysisThread(_model->updAnalysisSet()));
     }
 
     _model->realizeVelocity(s);
@@ -709,6 +849,7 @@ const SimTK::State& Manager::integrate(double finalTime)
 
     if (time >= stepToTime) {
         // No integration can be performed.
+        finishAnalyses();
         return getState();
     }
 
@@ -723,11 +864,36 @@ const SimTK::State& Manager::integrate(double finalTime)
             if (fixedStepSize + time >= finalTime)  fixedStepSize = finalTime - time;
             _integ->setFixedStepSize(fixedStepSize);
             stepToTime = time + fixedStepSize;
+        } else if (recordAtInterval) {
+            stepToTime = std::min(initialTime + numRecords * _recordInterval,
+                    finalTime);
         }
 
         status = _timeStepper->stepTo(stepToTime);
+        if (_recordPerformanceTrace) {
+            const auto now = std::chrono::steady_clock::now();
+            if (appendPerformanceTraceRow(std::chrono::duration<double>(
+                        now - lastTraceRow).count())) {
+                lastTraceRow = now;
+            }
+        }
 
-        if ( (status == SimTK::Integrator::TimeHasAdvanced) ||
+        if (recordAtInterval) {
+            if (_integ->getState().getTime() >= stepToTime) {
+                record(_integ->getState(), step);
+                step++;
+                numRecords++;
+            } else if (_integ->isSimulationOver() &&
+                    _integ->getTerminationReason() !=
+                        SimTK::Integrator::ReachedFinalTime) {
+                log_error("Integration failed due to the following reason: {}",
+                    _integ->getTerminationReasonString(
+                            _integ->getTerminationReason()));
+                finishAnalyses();
+                return getState();
+            }
+        }
+        else if ( (status == SimTK::Integrator::TimeHasAdvanced) ||
              (status == SimTK::Integrator::ReachedScheduledEvent) ) {
             const SimTK::State& s = _integ->getState();
             record(s, step);
@@ -739,6 +905,7 @@ const SimTK::State& Manager::integrate(double finalTime)
                         SimTK::Integrator::ReachedFinalTime) {
             log_error("Integration failed due to the following reason: {}",
                 _integ->getTerminationReasonString(_integ->getTerminationReason()));
+            finishAnalyses();
             return getState();
         }
 
@@ -751,6 +918,7 @@ const SimTK::State& Manager::integrate(double finalTime)
     clearHalt();
 
     record(_integ->getState(), -1);
+    finishAnalyses();
 
     return getState();
 }
@@ -798,6 +966,136 @@ void Manager::initializeStorageAndAnalyses(const SimTK::State& s)
 
     record(s, 0);
 }
+const SimTK::State& Manager::step(double stepSize)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    OPENSIM_THROW_IF(_timeStepper == nullptr, Exception,
+        "Manager has not been initialized. Call Manager::initialize() "
+        "first.");
+    OPENSIM_THROW_IF(!(stepSize > 0), Exception,
+        "Expected the step size to be positive, but it is {}.", stepSize);
+
+    // Undo the settings of integrate(), if it was called; a final time would
+    // end the simulation.
+    _integ->setFinalTime(SimTK::Infinity);
+    _integ->setReturnEveryInternalStep(false);
+    if (SimTK::isNaN(_stepSize)) {
+        if (_model->getUseVisualizer()) {
+            _model->updVisualizer().updSimbodyVisualizer().setMode(
+                SimTK::Visualizer::Sampling);
+        }
+    }
+    if (stepSize != _stepSize) {
+        _integ->setFixedStepSize(stepSize);
+        _stepSize = stepSize;
+    }
+
+    // The TimeStepper returns early at significant states (e.g., events).
+    const double finalTime = _integ->getState().getTime() + stepSize;
+    while (_integ->getState().getTime() < finalTime) {
+        _timeStepper->stepTo(finalTime);
+        OPENSIM_THROW_IF(_integ->isSimulationOver(), Exception,
+            "Integration failed due to the following reason: {}",
+            _integ->getTerminationReasonString(
+                _integ->getTerminationReason()));
+    }
+
+    const double latency = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    _maxStepLatency = std::max(_maxStepLatency, latency);
+    _sumStepLatency += latency;
+    ++_numSteps;
+    _wallClockTime += latency;
+    appendPerformanceTraceRow(latency);
+
+    return getState();
+}
+
+void Manager::resetStepLatencies()
+{
+    _numSteps = 0;
+    _maxStepLatency = 0;
+    _sumStepLatency = 0;
+}
+
+//-----------------------------------------------------------------------------
+// PERFORMANCE STATISTICS
+//-----------------------------------------------------------------------------
+Manager::PerformanceStats Manager::calcPerformanceTotals() const
+{
+    PerformanceStats totals;
+    if (!_timeStepper) return totals;
+    totals.numStepsAttempted = _integ->getNumStepsAttempted();
+    totals.numStepsTaken = _integ->getNumStepsTaken();
+    totals.numErrorTestFailures = _integ->getNumErrorTestFailures();
+    totals.numConvergenceTestFailures =
+            _integ->getNumConvergenceTestFailures();
+    totals.numRealizationFailures = _integ->getNumRealizationFailures();
+    totals.numProjectionFailures = _integ->getNumProjectionFailures();
+    totals.numRealizations = _integ->getNumRealizations();
+    totals.numProjections = _integ->getNumProjections();
+    const SimTK::System& system = _model->getMultibodySystem();
+    for (SimTK::Stage stage = SimTK::Stage::Empty;
+            stage <= SimTK::Stage::Report; stage = stage.next()) {
+        totals.numRealizationsPerStage.push_back(
+                system.getNumRealizationsOfThisStage(stage));
+    }
+    return totals;
+}
+
+Manager::PerformanceStats Manager::getPerformanceStats() const
+{
+    OPENSIM_THROW_IF(_timeStepper == nullptr, Exception,
+        "Manager has not been initialized. Call Manager::initialize() "
+        "first.");
+    PerformanceStats stats = calcPerformanceTotals();
+    const PerformanceStats& start = *_statsStart;
+    stats.numStepsAttempted -= start.numStepsAttempted;
+    stats.numStepsTaken -= start.numStepsTaken;
+    stats.numErrorTestFailures -= start.numErrorTestFailures;
+    stats.numConvergenceTestFailures -= start.numConvergenceTestFailures;
+    stats.numRealizationFailures -= start.numRealizationFailures;
+    stats.numProjectionFailures -= start.numProjectionFailures;
+    stats.numRealizations -= start.numRealizations;
+    stats.numProjections -= start.numProjections;
+    for (int i = 0; i < (int)start.numRealizationsPerStage.size(); ++i) {
+        stats.numRealizationsPerStage[i] -= start.numRealizationsPerStage[i];
+    }
+    stats.wallClockTime = _wallClockTime;
+    return stats;
+}
+
+void Manager::resetPerformanceStats()
+{
+    _wallClockTime = 0;
+    _statsStart.reset(new PerformanceStats(calcPerformanceTotals()));
+    _traceLast.reset(new PerformanceStats(*_statsStart));
+    _performanceTrace = TimeSeriesTable();
+    _performanceTrace.setColumnLabels({"step_size", "num_steps_attempted",
+            "num_steps_taken", "num_error_test_failures", "num_realizations",
+            "wall_clock_time"});
+}
+
+bool Manager::appendPerformanceTraceRow(double wallClockTime)
+{
+    if (!_recordPerformanceTrace) return false;
+    const double time = _integ->getState().getTime();
+    const auto& times = _performanceTrace.getIndependentColumn();
+    if (!times.empty() && time <= times.back()) return false;
+    PerformanceStats totals = calcPerformanceTotals();
+    SimTK::RowVector row(6);
+    row[0] = _integ->getPreviousStepSizeTaken();
+    row[1] = totals.numStepsAttempted - _traceLast->numStepsAttempted;
+    row[2] = totals.numStepsTaken - _traceLast->numStepsTaken;
+    row[3] = totals.numErrorTestFailures - _traceLast->numErrorTestFailures;
+    row[4] = totals.numRealizations - _traceLast->numRealizations;
+    row[5] = wallClockTime;
+    _performanceTrace.appendRow(time, row);
+    *_traceLast = std::move(totals);
+    return true;
+}
+
 //_____________________________________________________________________________
 /**
 * Set and initialize a SimTK::TimeStepper
@@ -821,6 +1119,7 @@ void Manager::initialize(const SimTK::State& s)
         _timeStepper->initialize(s);
         _timeStepper->setReportAllSignificantStates(true);
     }
+    resetPerformanceStats();
 
     // Here we call the constructStorage because it is possible that
     // the Model's control storage has already been appended in a
@@ -834,7 +1133,11 @@ void Manager::initialize(const SimTK::State& s)
 void Manager::record(const SimTK::State& s, const int& step)
 {
     // ANALYSES
-    if (_performAnalyses) {
+    if (_performAnalyses && _analysisThread) {
+        // The thread only reads what the integrating thread computed.
+        _model->getMultibodySystem().realize(s, SimTK::Stage::Report);
+        _analysisThread->push(s, step);
+    } else if (_performAnalyses) {
         AnalysisSet& analysisSet = _model->updAnalysisSet();
         if (step == 0)
             analysisSet.begin(s);
@@ -854,6 +1157,13 @@ void Manager::record(const SimTK::State& s, const int& step)
     }
 }
 
+void Manager::finishAnalyses()
+{
+    if (!_analysisThread) return;
+    std::unique_ptr<AnalysisThread> thread(std::move(_analysisThread));
+    thread->finish();
+}
+
 //=============================================================================
 // INTERRUPT
 //=============================================================================
@@ -101,6 +101,9 @@ private:
     bool _constantDT;
     /** Constant integration time step. */
     double _dt;
+    /** Interval at which integrate() records interpolated states; 0 to
+    record at each step of the integrator. */
+    double _recordInterval;
     /** Vector of integration time steps. */
     Array<double> _tArray;
     /** Vector of integration time step deltas. */
@@ -112,12 +115,44 @@ private:
     /** flag indicating if manager should call Analyses after each step */
     bool _performAnalyses;
 
+    /** flag indicating if integrate() should perform the Analyses on a
+    separate thread */
+    bool _performAnalysesConcurrently;
+
+    /** The thread that performs the Analyses during integrate(), if
+    _performAnalysesConcurrently is true. */
+    class AnalysisThread;
+    std::unique_ptr<AnalysisThread> _analysisThread;
+
     /** flag indicating if manager should write to storage  each step */
     bool _writeToStorage;
 
     /** controllerSet used for the integration */
     SimTK::ReferencePtr<ControllerSet> _controllerSet;
 
+    /** Step size of the last call to step(); NaN before the first call. */
+    double _stepSize;
+    /** Number of calls to step() since initialize() or
+    resetStepLatencies(). */
+    int _numSteps;
+    /** Largest and summed wall-clock durations of the calls to step() (s). */
+    double _maxStepLatency;
+    double _sumStepLatency;
+
+    /** Wall-clock duration of integrate() and step() since initialize() or
+    resetPerformanceStats() (s). */
+    double _wallClockTime;
+public:
+    struct PerformanceStats;
+private:
+    /** The counts of the integrator and the system when initialize() or
+    resetPerformanceStats() was called, and when the last row of the
+    performance trace was appended. */
+    std::unique_ptr<PerformanceStats> _statsStart;
+    std::unique_ptr<PerformanceStats> _traceLast;
+    bool _recordPerformanceTrace;
+    TimeSeriesTable _performanceTrace;
+
 
 //=============================================================================
 // METHODS
@@ -146,6 +181,8 @@ public:
     Manager(const Manager&) = delete;
     void operator=(const Manager&) = delete;
 
+    ~Manager();
+
 private:
     void setNull();
     bool constructStorage();
@@ -160,6 +197,20 @@ public:
 
     void setPerformAnalyses(bool performAnalyses)
     { _performAnalyses =  performAnalyses; }
+    /** Perform the Analyses of the model on a separate thread during
+    integrate(), so that they overlap with the integration (e.g., with the
+    optimizations of a CMC controller). The states are recorded in order, and
+    realized to Stage::Report before they are handed to the thread, so that
+    the controllers compute their controls on the integrating thread and the
+    Analyses only read the results. The Analyses must not modify the model,
+    and the on/off flags of the Analyses must not change during integrate().
+    integrate() returns after the Analyses of all the recorded states are
+    done, and rethrows the first exception that an Analysis threw. The
+    default is false. */
+    void setPerformAnalysesConcurrently(bool performAnalysesConcurrently)
+    { _performAnalysesConcurrently = performAnalysesConcurrently; }
+    bool getPerformAnalysesConcurrently() const
+    { return _performAnalysesConcurrently; }
     void setWriteToStorage(bool writeToStorage)
     { _writeToStorage =  writeToStorage; }
 
@@ -177,10 +228,10 @@ public:
         RungeKuttaFeldberg = 3, ///< 3 : For details, see SimTK::RungeKuttaFeldbergIntegrator.
         RungeKuttaMerson   = 4, ///< 4 : For details, see SimTK::RungeKuttaMersonIntegrator.
         SemiExplicitEuler2 = 5, ///< 5 : For details, see SimTK::SemiExplicitEuler2Integrator.
-        Verlet             = 6  ///< 6 : For details, see SimTK::VerletIntegrator.
+        Verlet             = 6, ///< 6 : For details, see SimTK::VerletIntegrator.
+        CPodes             = 7  ///< 7 : Implicit (BDF with Newton iteration); see SimTK::CPodesIntegrator.
 
         // Not included
-        //CPodes, stochastic segfaults when destructed via unique_ptr::reset()
         //SemiExplicitEuler, no error ctrl, requires fixed stepSize arg on construction
     };
 
@@ -188,6 +239,15 @@ public:
       * integrator will be set to its default options, even if the caller
       * requests the same integrator method. Note that this function must
       * be called before `Manager::initialize()`.
+      *
+      * The explicit methods must take steps that are small enough to be
+      * stable, which, for stiff systems (e.g., muscles with stiff elastic
+      * tendons, or stiff contact), can be much smaller than the steps needed
+      * for accuracy. For such systems, IntegratorMethod::CPodes, which uses
+      * implicit backward differentiation formulas and reuses its iteration
+      * matrix (Jacobian) across steps until its convergence degrades, can
+      * take far fewer steps. Each of its steps is more expensive, so it is
+      * slower for systems that are not stiff.
       
       <b>C++ example</b>
       \code{.cpp}
@@ -235,6 +295,18 @@ public:
    
     /** @} */
 
+    /** Record the states and step the analyses at multiples of `interval`
+    (s) after the initial time of each call to integrate(), instead of at
+    each step of the integrator. The integrator takes its natural steps and
+    the states at the recording times are interpolated (see
+    SimTK::Integrator::setAllowInterpolation()), so that, unlike
+    setUseConstantDT(), the recording interval does not limit the step size.
+    Reporters with a report_time_interval are given interpolated states in the
+    same way. An interval of 0 (the default) records at each step. The
+    interval does not apply when specified or constant time steps are used. */
+    void setRecordInterval(double interval);
+    double getRecordInterval() const { return _recordInterval; }
+
     // SPECIFIED TIME STEP
     void setUseSpecifiedDT(bool aTrueFalse);
     bool getUseSpecifiedDT() const;
@@ -330,6 +402,120 @@ public:
     */
     const SimTK::State& integrate(double finalTime);
 
+    /** @name Fixed-step stepping
+    For driving a simulation in a real-time loop (e.g., with hardware in the
+    loop), step() advances the simulation by exactly one fixed step per call.
+    Unlike integrate(), step() does not record the states, controls, or
+    analyses, and the integrator takes a single step of the given size
+    without error control (see SimTK::Integrator::setFixedStepSize()). The
+    integrator keeps its workspace between calls, so stepping does not
+    allocate memory in the Manager.
+    @code
+    Manager manager(model);
+    manager.initialize(state);
+    while (running) {
+        // ... update the inputs of the model's controllers ...
+        const SimTK::State& s = manager.step(0.001);
+        // ... send outputs to the hardware ...
+    }
+    log_info("Max step latency: {} s", manager.getMaxStepLatency());
+    @endcode
+    If the model uses the visualizer, its mode is set to
+    SimTK::Visualizer::Sampling on the first call to step(), so that frames
+    are dropped (rather than the simulation waiting) when the visualizer
+    cannot keep up.
+    @{ */
+    /** Advance the simulation by `stepSize` (s), and return the new state.
+    Scheduled events (e.g., periodic reporters) that occur within the step
+    are handled, and the step then continues to the requested time. An
+    exception is thrown if the integrator fails. You must call
+    Manager::initialize() before calling this function. */
+    const SimTK::State& step(double stepSize);
+    /** Number of calls to step() since initialize() or resetStepLatencies().
+    */
+    int getNumSteps() const { return _numSteps; }
+    /** The largest wall-clock duration of a call to step() (s). */
+    double getMaxStepLatency() const { return _maxStepLatency; }
+    /** The mean wall-clock duration of a call to step() (s). */
+    double getMeanStepLatency() const {
+        return _numSteps ? _sumStepLatency / _numSteps : 0;
+    }
+    /** Reset the step latency statistics (e.g., after warm-up steps). */
+    void resetStepLatencies();
+    /** @} */
+
+    /** @name Performance statistics
+    Statistics of integrate() and step(), for tuning the accuracy, the step
+    limits, and the integrator of a model (e.g., by comparing the statistics
+    of short simulations with several settings):
+    @code
+    Manager manager(model);
+    manager.setRecordPerformanceTrace(true);
+    manager.initialize(state);
+    manager.integrate(1.0);
+    const Manager::PerformanceStats stats = manager.getPerformanceStats();
+    log_info("{} steps ({} attempted), {} s per step",
+            stats.numStepsTaken, stats.numStepsAttempted,
+            stats.getWallClockTimePerStep());
+    CSVFileAdapter::write(manager.getPerformanceTrace(), "trace.csv");
+    @endcode
+    @{ */
+    /** The statistics of the integration since initialize() or
+    resetPerformanceStats(). The counts other than numRealizationsPerStage are
+    those of the integrator (see SimTK::Integrator, e.g.,
+    SimTK::Integrator::getNumStepsAttempted()). */
+    struct PerformanceStats {
+        int numStepsAttempted = 0;
+        int numStepsTaken = 0;
+        /** Steps rejected because the error estimate was too large. */
+        int numErrorTestFailures = 0;
+        /** Steps rejected because the iterations of an implicit integrator
+        did not converge. */
+        int numConvergenceTestFailures = 0;
+        /** Steps rejected because the system could not be realized (e.g., an
+        exception in a component). */
+        int numRealizationFailures = 0;
+        /** Steps rejected because the state could not be projected onto the
+        constraint manifold. */
+        int numProjectionFailures = 0;
+        /** Realizations of the system by the integrator. */
+        int numRealizations = 0;
+        /** Projections of the state onto the constraint manifold. */
+        int numProjections = 0;
+        /** The number of realizations of each stage of the system (by the
+        integrator, and also, e.g., by the analyses, the reporters, or the
+        controllers), indexed by stage (e.g.,
+        `numRealizationsPerStage[SimTK::Stage::Position]`). */
+        std::vector<int> numRealizationsPerStage;
+        /** The wall-clock duration of integrate() and step() (s). */
+        double wallClockTime = 0;
+        /** The mean wall-clock duration of a step of the integrator (s). */
+        double getWallClockTimePerStep() const {
+            return numStepsTaken ? wallClockTime / numStepsTaken : 0;
+        }
+    };
+    /** Get the statistics of the integration since initialize() or
+    resetPerformanceStats(). You must call Manager::initialize() before
+    calling this function. */
+    PerformanceStats getPerformanceStats() const;
+    /** Reset the performance statistics and the performance trace (e.g.,
+    after a warm-up integration). */
+    void resetPerformanceStats();
+    /** Record a row of the performance trace each time the integrator
+    returns to integrate() (after each step, or at each recording time with
+    setRecordInterval()) or step() returns. The columns are the step size of
+    the integrator, the numbers of steps attempted and taken, of error test
+    failures, and of realizations since the previous row, and the wall-clock
+    duration since the previous row (s). The default is false. */
+    void setRecordPerformanceTrace(bool recordPerformanceTrace)
+    { _recordPerformanceTrace = recordPerformanceTrace; }
+    bool getRecordPerformanceTrace() const { return _recordPerformanceTrace; }
+    /** The performance trace (see setRecordPerformanceTrace()), which can be
+    written with CSVFileAdapter. */
+    const TimeSeriesTable& getPerformanceTrace() const
+    { return _performanceTrace; }
+    /** @} */
+
     /** Get the current State from the Integrator associated with this 
       * Manager. */
     const SimTK::State& getState() const;
@@ -363,6 +549,18 @@ private:
     // step = 0 is the beginning, step = -1 used to denote the end/final step
     void record(const SimTK::State& s, const int& step);
 
+    // The counts of the integrator and the system since the integrator was
+    // initialized (the wall-clock time is 0).
+    PerformanceStats calcPerformanceTotals() const;
+    // Append a row to the performance trace, if it is recorded and the time
+    // advanced since the last row; return whether a row was appended.
+    bool appendPerformanceTraceRow(double wallClockTime);
+
+    // Wait for the analysis thread to perform the Analyses of all the
+    // recorded states (rethrowing the first exception of an Analysis), and
+    // stop it.
+    void finishAnalyses();
+
 //=============================================================================
 };  // END of class Manager
 
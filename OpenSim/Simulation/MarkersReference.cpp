@@ -23,6 +23,7 @@
 
 #include "MarkersReference.h"
 #include <SimTKcommon/internal/State.h>
+#include <algorithm>
 #include <cmath>
 
 using namespace std;
@@ -132,6 +133,34 @@ populateFromMarkerData(const TimeSeriesTable_<SimTK::Vec3>& markerTable,
 
     // Names must be assigned before weights can be updated
     updateInternalWeights();
+
+    updateFrames();
+}
+
+void MarkersReference::updateFrames() {
+    const int nf = static_cast<int>(_markerTable.getNumRows());
+    const int nm = static_cast<int>(_markerTable.getNumColumns());
+    const auto& matrix = _markerTable.getMatrix();
+    _frames.resize(static_cast<size_t>(nf) * nm);
+    for (int f = 0; f < nf; ++f) {
+        for (int m = 0; m < nm; ++m) {
+            _frames[static_cast<size_t>(f) * nm + m] = matrix(f, m);
+        }
+    }
+
+    // The sampled times (e.g., of a .trc file) are rounded, so frames are
+    // considered uniform if each time is within a tenth of the interval of
+    // its uniformly sampled value; getNearestFrameIndex() corrects for the
+    // rounding.
+    _timeStep = SimTK::NaN;
+    const auto& times = _markerTable.getIndependentColumn();
+    if (nf < 2) return;
+    const double dt = (times.back() - times.front()) / (nf - 1);
+    if (!(dt > 0)) return;
+    for (int f = 0; f < nf; ++f) {
+        if (std::abs(times[f] - (times.front() + f * dt)) > 0.1 * dt) return;
+    }
+    _timeStep = dt;
 }
 
 SimTK::Vec2 MarkersReference::getValidTimeRange() const {
@@ -156,10 +185,36 @@ const SimTK::Array_<std::string>& MarkersReference::getNames() const {
 
 void MarkersReference::getValuesAtTime(double time,
                                   SimTK::Array_<Vec3>& values) const {
-    const auto rowView = _markerTable.getNearestRow(time);
-    values.clear();
-    for(int i = 0; i < rowView.ncol(); ++i)
-        values.push_back(rowView[i]);
+    const size_t nm = _markerTable.getNumColumns();
+    const Vec3* frame = _frames.data() + getNearestFrameIndex(time) * nm;
+    values.assign(frame, frame + nm);
+}
+
+size_t MarkersReference::getNearestFrameIndex(double time) const {
+    if (SimTK::isNaN(_timeStep)) {
+        return _markerTable.getNearestRowIndexForTime(time);
+    }
+    const auto& times = _markerTable.getIndependentColumn();
+    const SimTK::Real eps = SimTK::SignificantReal;
+    OPENSIM_THROW_IF((time < times.front() - eps) ||
+                     (time > times.back() + eps),
+                     TimeOutOfRange,
+                     time, times.front(), times.back());
+
+    const size_t last = times.size() - 1;
+    const double estimate = std::round((time - times.front()) / _timeStep);
+    size_t index = static_cast<size_t>(
+            std::max(0.0, std::min(estimate, double(last))));
+    // Move to the nearest frame if the times are not exactly uniform, with
+    // the same tie-breaking as TimeSeriesTable_::getNearestRowIndexForTime().
+    while (index < last &&
+            (times[index + 1] - time) <= (time - times[index])) {
+        ++index;
+    }
+    while (index > 0 && (times[index] - time) > (time - times[index - 1])) {
+        --index;
+    }
+    return index;
 }
 
 // void
@@ -143,7 +143,10 @@ public:
     SimTK::Vec2 getValidTimeRange() const override;
     /** get the names of the markers serving as references */
     const SimTK::Array_<std::string>& getNames() const override;
-    /** get the value of the MarkersReference  */
+    /** get the value of the MarkersReference: the marker locations of the
+        frame nearest to `time` (see getNearestFrameIndex()). `values` is
+        resized to getNumRefs(), so reusing it across calls avoids
+        reallocating it. */
     void getValuesAtTime(
             double time, SimTK::Array_<SimTK::Vec3> &values) const override;
     // The following two methods are commented out as they are not implemented
@@ -176,6 +179,12 @@ public:
     void setMarkerWeightSet(const Set<MarkerWeight>& markerWeights);
     void setDefaultWeight(double weight);
     size_t getNumFrames() const;
+    /** Get the index of the frame whose time is nearest to `time`, which is
+        the same row as TimeSeriesTable_::getNearestRowIndexForTime() of the
+        marker table. If the frames are uniformly sampled, the index is
+        computed from the sampling interval rather than searched for.
+        @throws TimeOutOfRange if `time` is not within getValidTimeRange(). */
+    size_t getNearestFrameIndex(double time) const;
 
 private:
     void constructProperties();
@@ -184,8 +193,17 @@ private:
                            const Set<MarkerWeight>& markerWeightSet,
                            const std::string& units = "Meters");
     void updateInternalWeights() const;
+    /** Copy the marker table into _frames, and detect whether its frames are
+        uniformly sampled. */
+    void updateFrames();
 
     TimeSeriesTable_<SimTK::Vec3> _markerTable;
+    // The rows of the marker table, frame after frame, so that the marker
+    // locations of a frame are contiguous (the columns of the table are).
+    std::vector<SimTK::Vec3> _frames;
+    // The time between consecutive frames if they are uniformly sampled,
+    // otherwise NaN.
+    double _timeStep = SimTK::NaN;
     // marker names inside the marker data
     SimTK::Array_<std::string> _markerNames;
     // List of weights guaranteed to be in the same order as marker names.
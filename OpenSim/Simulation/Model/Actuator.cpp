@@ -186,8 +186,10 @@ void ScalarActuator::extendAddToSystem(SimTK::MultibodySystem& system) const
     _actuationCV = addCacheVariable("actuation", 0.0, Stage::Velocity);
     _speedCV = addCacheVariable("speed", 0.0, Stage::Velocity);
 
-    // Discrete state variable is the override actuation value if in override mode
-    addDiscreteVariable(overrideActuationKey, Stage::Time);
+    // Discrete state variable is the override actuation value if in override
+    // mode. It is used only when computing forces, so changing it invalidates
+    // only the Dynamics stage.
+    addDiscreteVariable(overrideActuationKey, Stage::Dynamics);
 }
 
 double ScalarActuator::getControl(const SimTK::State& s) const
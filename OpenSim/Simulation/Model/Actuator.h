@@ -90,6 +90,11 @@ public:
     //Model building
     virtual int numControls() const = 0;
 
+    /** The index of the first control of this actuator in the model's
+    controls (see Model::getControls()), or -1 before the system is created
+    (see Model::initSystem()). */
+    int getControlIndex() const { return _controlIndex; }
+
     /** Actuator default controls are zero */
     virtual const SimTK::Vector getDefaultControls() { return SimTK::Vector(numControls(), 0.0); } 
 #ifndef SWIG
@@ -203,6 +208,11 @@ public:
     /**
     * set the actuation value used when the override is true 
     * 
+    * The value affects only the forces of the ScalarActuator, so setting it
+    * invalidates only SimTK::Stage::Dynamics: the positions and velocities
+    * already realized in `s` are still valid (unlike when the override is
+    * enabled or disabled, which invalidates SimTK::Stage::Instance).
+    *
     * @param s      current state
     * @param value  value of override actuation   
     */
@@ -352,6 +352,23 @@ ArrayPtrs<Storage>& Analysis::getStorageList()
     return _storageList;
 }
 
+void Analysis::appendResults(Analysis& aAnalysis)
+{
+    ArrayPtrs<Storage>& storages = getStorageList();
+    ArrayPtrs<Storage>& others = aAnalysis.getStorageList();
+    OPENSIM_THROW_IF_FRMOBJ(storages.getSize() != others.getSize(), Exception,
+            "Expected analysis '{}' to have {} storages, but it has {}.",
+            aAnalysis.getName(), storages.getSize(), others.getSize());
+    for (int i = 0; i < storages.getSize(); ++i)
+        appendRows(*storages[i], *others[i]);
+}
+
+void Analysis::appendRows(Storage& aTo, const Storage& aFrom)
+{
+    for (int i = 0; i < aFrom.getSize(); ++i)
+        aTo.append(*aFrom.getStateVector(i));
+}
+
 // GET AND SET
 //=============================================================================
 //_____________________________________________________________________________
@@ -231,6 +231,28 @@ public:
         printResults(const std::string &aBaseName,const std::string &aDir="",
         double aDT=-1.0,const std::string &aExtension=".sto");
 
+    /**
+     * Whether the results of this analysis at a time frame depend only on
+     * the state at that frame. If so, AnalyzeTool may analyze disjoint,
+     * contiguous ranges of frames concurrently with separate copies of this
+     * analysis, and concatenate their results with appendResults(). The
+     * default is false.
+     */
+    virtual bool getFramesAreIndependent() const { return false; }
+
+    /**
+     * Append the results of a copy of this analysis, which analyzed frames
+     * after those analyzed by this analysis, to the results of this
+     * analysis. The default implementation appends the rows of each Storage
+     * in the copy's getStorageList() to the corresponding Storage of this
+     * analysis. Analyses that record into other Storages override this.
+     */
+    virtual void appendResults(Analysis& aAnalysis);
+
+protected:
+    /** Append the rows of aFrom to aTo (e.g., in appendResults()). */
+    static void appendRows(Storage& aTo, const Storage& aFrom);
+
 //=============================================================================
 };  // END of class Analysis
 
@@ -253,10 +253,13 @@ void Bhargava2004SmoothedMuscleMetabolics::extendRealizeTopology(
         SimTK::State& state) const {
     Super::extendRealizeTopology(state);
     m_muscleIndices.clear();
+    m_muscles.clear();
     for (int i = 0; i < getProperty_muscle_parameters().size(); ++i) {
-        const auto& muscle = get_muscle_parameters(i).getMuscle();
+        const auto& parameters = get_muscle_parameters(i);
+        const auto& muscle = parameters.getMuscle();
         if (muscle.get_appliesForce()) {
             m_muscleIndices[muscle.getAbsolutePathString()] = i;
+            m_muscles.push_back({i, &parameters, &muscle});
         }
     }
 }
@@ -265,73 +268,73 @@ void Bhargava2004SmoothedMuscleMetabolics::extendAddToSystem(
         SimTK::MultibodySystem& system) const {
     Super::extendAddToSystem(system);
     SimTK::Vector rates = SimTK::Vector((int)m_muscleIndices.size(), 0.0);
-    addCacheVariable<SimTK::Vector>("metabolic_rate", rates,
+    m_metabolicRateCV = addCacheVariable("metabolic_rate", rates,
             SimTK::Stage::Dynamics);
-    addCacheVariable<SimTK::Vector>("activation_rate", rates,
+    m_activationRateCV = addCacheVariable("activation_rate", rates,
             SimTK::Stage::Dynamics);
-    addCacheVariable<SimTK::Vector>("maintenance_rate", rates,
+    m_maintenanceRateCV = addCacheVariable("maintenance_rate", rates,
             SimTK::Stage::Dynamics);
-    addCacheVariable<SimTK::Vector>("shortening_rate", rates,
+    m_shorteningRateCV = addCacheVariable("shortening_rate", rates,
             SimTK::Stage::Dynamics);
-    addCacheVariable<SimTK::Vector>("mechanical_work_rate", rates,
+    m_mechanicalWorkRateCV = addCacheVariable("mechanical_work_rate", rates,
             SimTK::Stage::Dynamics);
 }
 
 void Bhargava2004SmoothedMuscleMetabolics::calcMetabolicRateForCache(
     const SimTK::State& s) const {
     calcMetabolicRate(s,
-            updCacheVariableValue<SimTK::Vector>(s, "metabolic_rate"),
-            updCacheVariableValue<SimTK::Vector>(s, "activation_rate"),
-            updCacheVariableValue<SimTK::Vector>(s, "maintenance_rate"),
-            updCacheVariableValue<SimTK::Vector>(s, "shortening_rate"),
-            updCacheVariableValue<SimTK::Vector>(s, "mechanical_work_rate")
+            updCacheVariableValue(s, m_metabolicRateCV),
+            updCacheVariableValue(s, m_activationRateCV),
+            updCacheVariableValue(s, m_maintenanceRateCV),
+            updCacheVariableValue(s, m_shorteningRateCV),
+            updCacheVariableValue(s, m_mechanicalWorkRateCV)
             );
-    markCacheVariableValid(s, "metabolic_rate");
-    markCacheVariableValid(s, "activation_rate");
-    markCacheVariableValid(s, "maintenance_rate");
-    markCacheVariableValid(s, "shortening_rate");
-    markCacheVariableValid(s, "mechanical_work_rate");
+    markCacheVariableValid(s, m_metabolicRateCV);
+    markCacheVariableValid(s, m_activationRateCV);
+    markCacheVariableValid(s, m_maintenanceRateCV);
+    markCacheVariableValid(s, m_shorteningRateCV);
+    markCacheVariableValid(s, m_mechanicalWorkRateCV);
 }
 
 const SimTK::Vector& Bhargava2004SmoothedMuscleMetabolics::getMetabolicRate(
         const SimTK::State& s) const {
-    if (!isCacheVariableValid(s, "metabolic_rate")) {
+    if (!isCacheVariableValid(s, m_metabolicRateCV)) {
         calcMetabolicRateForCache(s);
     }
-    return getCacheVariableValue<SimTK::Vector>(s, "metabolic_rate");
+    return getCacheVariableValue(s, m_metabolicRateCV);
 }
 
 const SimTK::Vector& Bhargava2004SmoothedMuscleMetabolics::getActivationRate(
         const SimTK::State& s) const {
-    if (!isCacheVariableValid(s, "activation_rate")) {
+    if (!isCacheVariableValid(s, m_activationRateCV)) {
         calcMetabolicRateForCache(s);
     }
-    return getCacheVariableValue<SimTK::Vector>(s, "activation_rate");
+    return getCacheVariableValue(s, m_activationRateCV);
 }
 
 const SimTK::Vector& Bhargava2004SmoothedMuscleMetabolics::getMaintenanceRate(
         const SimTK::State& s) const {
-    if (!isCacheVariableValid(s, "maintenance_rate")) {
+    if (!isCacheVariableValid(s, m_maintenanceRateCV)) {
         calcMetabolicRateForCache(s);
     }
-    return getCacheVariableValue<SimTK::Vector>(s, "maintenance_rate");
+    return getCacheVariableValue(s, m_maintenanceRateCV);
 }
 
 const SimTK::Vector& Bhargava2004SmoothedMuscleMetabolics::getShorteningRate(
         const SimTK::State& s) const {
-    if (!isCacheVariableValid(s, "shortening_rate")) {
+    if (!isCacheVariableValid(s, m_shorteningRateCV)) {
         calcMetabolicRateForCache(s);
     }
-    return getCacheVariableValue<SimTK::Vector>(s, "shortening_rate");
+    return getCacheVariableValue(s, m_shorteningRateCV);
 }
 
 const SimTK::Vector&
 Bhargava2004SmoothedMuscleMetabolics::getMechanicalWorkRate(
         const SimTK::State& s) const {
-    if (!isCacheVariableValid(s, "mechanical_work_rate")) {
+    if (!isCacheVariableValid(s, m_mechanicalWorkRateCV)) {
         calcMetabolicRateForCache(s);
     }
-    return getCacheVariableValue<SimTK::Vector>(s, "mechanical_work_rate");
+    return getCacheVariableValue(s, m_mechanicalWorkRateCV);
 }
 
 void Bhargava2004SmoothedMuscleMetabolics::calcMetabolicRate(
@@ -349,12 +352,15 @@ void Bhargava2004SmoothedMuscleMetabolics::calcMetabolicRate(
     double mechanicalWorkRate;
     activationHeatRate = maintenanceHeatRate = shorteningHeatRate =
         mechanicalWorkRate = 0;
+    // The fiber-length dependence curve is shared by all the muscles; the
+    // search for the interval of each muscle starts from that of the last.
+    int fiberLengthDepInterval = 0;
 
-    for (const auto& muscleIndex : m_muscleIndices) {
+    for (const auto& metabolicMuscle : m_muscles) {
 
-        const auto& index = muscleIndex.second;
-        const auto& muscleParameter = get_muscle_parameters(index);
-        const auto& muscle = muscleParameter.getMuscle();
+        const int index = metabolicMuscle.index;
+        const auto& muscleParameter = *metabolicMuscle.parameters;
+        const auto& muscle = *metabolicMuscle.muscle;
 
         const double maximalIsometricForce = muscle.getMaxIsometricForce();
         const double activation =
@@ -402,8 +408,8 @@ void Bhargava2004SmoothedMuscleMetabolics::calcMetabolicRate(
 
         // MAINTENANCE HEAT RATE (W).
         // --------------------------
-        const double fiber_length_dependence = m_fiberLengthDepCurve.calcValue(
-                    SimTK::Vector(1, fiberLengthNormalized));
+        const double fiber_length_dependence = m_fiberLengthDepCurve.evaluate(
+                    fiberLengthNormalized, 0, fiberLengthDepInterval);
         maintenanceHeatRate =
             muscleParameter.getMuscleMass() * fiber_length_dependence
                 * ( (muscleParameter.get_maintenance_constant_slow_twitch()
@@ -21,6 +21,7 @@
 
 #include <OpenSim/Moco/osimMocoDLL.h>
 #include <unordered_map>
+#include <vector>
 
 #include <OpenSim/Common/PiecewiseLinearFunction.h>
 #include <OpenSim/Simulation/Model/ModelComponent.h>
@@ -369,6 +370,20 @@ private:
             SimTK::Vector& shorteningRatesForMuscles,
             SimTK::Vector& mechanicalWorkRatesForMuscles) const;
     mutable std::unordered_map<std::string, int> m_muscleIndices;
+    // The muscles that apply force, with their parameters and the index of
+    // the parameters in muscle_parameters, bound when the topology is
+    // realized so that calcMetabolicRate() does not look them up.
+    struct MetabolicMuscle {
+        int index;
+        const Bhargava2004SmoothedMuscleMetabolics_MuscleParameters* parameters;
+        const Muscle* muscle;
+    };
+    mutable std::vector<MetabolicMuscle> m_muscles;
+    mutable CacheVariable<SimTK::Vector> m_metabolicRateCV;
+    mutable CacheVariable<SimTK::Vector> m_activationRateCV;
+    mutable CacheVariable<SimTK::Vector> m_maintenanceRateCV;
+    mutable CacheVariable<SimTK::Vector> m_shorteningRateCV;
+    mutable CacheVariable<SimTK::Vector> m_mechanicalWorkRateCV;
     using ConditionalFunction =
             double(const double&, const double&, const double&, const double&,
                     const int&);
@@ -0,0 +1,74 @@
+/* -------------------------------------------------------------------------- *
+ *                  OpenSim:  CompiledLeptonExpression.cpp                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "CompiledLeptonExpression.h"
+
+#include <algorithm>
+#include <lepton/Exception.h>
+#include <lepton/ParsedExpression.h>
+#include <lepton/Parser.h>
+
+using namespace OpenSim;
+
+CompiledLeptonExpression::CompiledLeptonExpression(
+        const std::string& expression, std::vector<std::string> variableNames)
+        : m_expression(Lepton::Parser::parse(expression)
+                               .optimize()
+                               .createCompiledExpression()),
+          m_variableNames(std::move(variableNames)) {
+    for (const auto& name : m_expression.getVariables()) {
+        if (std::find(m_variableNames.begin(), m_variableNames.end(), name) ==
+                m_variableNames.end()) {
+            throw Lepton::Exception("Unknown variable '" + name +
+                                    "' in expression '" + expression + "'.");
+        }
+    }
+    bindVariables();
+}
+
+CompiledLeptonExpression::CompiledLeptonExpression(
+        const CompiledLeptonExpression& other)
+        : m_expression(other.m_expression),
+          m_variableNames(other.m_variableNames) {
+    bindVariables();
+}
+
+CompiledLeptonExpression& CompiledLeptonExpression::operator=(
+        const CompiledLeptonExpression& other) {
+    if (this != &other) {
+        m_expression = other.m_expression;
+        m_variableNames = other.m_variableNames;
+        bindVariables();
+    }
+    return *this;
+}
+
+void CompiledLeptonExpression::bindVariables() {
+    m_variables.assign(m_variableNames.size(), nullptr);
+    const auto& used = m_expression.getVariables();
+    for (int i = 0; i < (int)m_variableNames.size(); ++i) {
+        if (used.count(m_variableNames[i])) {
+            m_variables[i] =
+                    &m_expression.getVariableReference(m_variableNames[i]);
+        }
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef OPENSIM_COMPILED_LEPTON_EXPRESSION_H_
+#define OPENSIM_COMPILED_LEPTON_EXPRESSION_H_
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  CompiledLeptonExpression.h                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+
+#include <lepton/CompiledExpression.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+/** A Lepton expression whose variables are given, in order, when it is
+created, so that it can be evaluated from an array of values without the
+std::map of variable names (and the interpreted stack machine) of
+Lepton::ExpressionProgram::evaluate(). The expression is compiled with
+Lepton::CompiledExpression, and the locations of the values of its variables
+are looked up once (and again when the expression is copied).
+@code
+CompiledLeptonExpression force("-10*q-qdot", {"q", "qdot"});
+const double values[] = {q, qdot};
+double f = force.evaluate(values);
+@endcode
+
+The expression may use any subset of its variables; the values of variables
+that it does not use are ignored. As with Lepton::CompiledExpression,
+evaluate() writes to a workspace; the workspace is locked during the
+evaluation, so that the forces that use an expression can be evaluated for
+different States by multiple threads at the same time (the evaluations of an
+expression are serialized, so threads that evaluate the same forces often are
+better served by their own copies of the model; see ModelPool). */
+class OSIMSIMULATION_API CompiledLeptonExpression {
+public:
+    CompiledLeptonExpression() = default;
+    /** Parse and compile `expression`, whose variables are `variableNames`.
+    Throws Lepton::Exception if the expression cannot be parsed or uses a
+    variable that is not in `variableNames`. */
+    CompiledLeptonExpression(const std::string& expression,
+            std::vector<std::string> variableNames);
+    CompiledLeptonExpression(const CompiledLeptonExpression& other);
+    CompiledLeptonExpression& operator=(const CompiledLeptonExpression& other);
+
+    /** Evaluate the expression, with the value of the i-th variable given to
+    the constructor at `values[i]`. */
+    double evaluate(const double* values) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (int i = 0; i < (int)m_variables.size(); ++i) {
+            if (m_variables[i]) *m_variables[i] = values[i];
+        }
+        return m_expression.evaluate();
+    }
+
+private:
+    void bindVariables();
+
+    Lepton::CompiledExpression m_expression;
+    std::vector<std::string> m_variableNames;
+    // The location in the workspace of m_expression of the value of each
+    // variable, or nullptr if the expression does not use the variable.
+    std::vector<double*> m_variables;
+    // Guards the workspace of m_expression; not copied.
+    mutable std::mutex m_mutex;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_COMPILED_LEPTON_EXPRESSION_H_
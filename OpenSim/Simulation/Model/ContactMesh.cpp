@@ -53,6 +53,7 @@ ContactMesh::ContactMesh(const std::string& filename,
         mesh.loadFile(filename);
         _geometry.reset(new SimTK::ContactGeometry::TriangleMesh(mesh));
         _decorativeGeometry.reset(new SimTK::DecorativeMesh(mesh));
+        _meshFilename = filename;
     }
 }
 
@@ -77,8 +78,12 @@ void ContactMesh::constructProperties()
 }
 
 void ContactMesh::extendFinalizeFromProperties() {
-    _geometry.reset();
-    _decorativeGeometry.reset();
+    // Keep the loaded mesh (and its spatial index) if the filename has not
+    // changed; createSimTKContactGeometry() also checks the model file.
+    if (_meshFilename != get_filename()) {
+        _geometry.reset();
+        _decorativeGeometry.reset();
+    }
 }
 
 const std::string& ContactMesh::getFilename() const
@@ -120,8 +125,14 @@ SimTK::ContactGeometry::TriangleMesh* ContactMesh::
 
 SimTK::ContactGeometry ContactMesh::createSimTKContactGeometry() const
 {
-    if (!_geometry)
+    const std::string modelFileName =
+            _model.empty() ? "" : _model->getInputFileName();
+    if (!_geometry || _meshFilename != get_filename() ||
+            _meshModelFileName != modelFileName) {
         _geometry.reset(loadMesh(get_filename()));
+        _meshFilename = get_filename();
+        _meshModelFileName = modelFileName;
+    }
     return *_geometry;
 }
 
@@ -32,6 +32,15 @@ namespace OpenSim {
 /**
  * This class represents a polygonal mesh for use in contact modeling.
  *
+ * Loading the mesh also builds its spatial index (the tree of bounding boxes
+ * that Simbody uses to find the pairs of triangles in contact), which is
+ * costly for meshes with many triangles. The loaded mesh is therefore kept
+ * when the model's system is re-created (e.g., by initSystem() after a
+ * property of another component changes) and is shared by copies of this
+ * ContactMesh (e.g., the copies of a model used by different threads). It is
+ * loaded again only if the filename or the directory of the model file
+ * changes.
+ *
  * @author Peter Eastman
  */
 class OSIMSIMULATION_API ContactMesh : public ContactGeometry {
@@ -111,10 +120,15 @@ private:
 //=============================================================================
 // DATA
 //=============================================================================
-    mutable SimTK::ResetOnCopy<std::unique_ptr<SimTK::ContactGeometry::TriangleMesh>>
+    // The loaded meshes are not modified, so copies of this ContactMesh share
+    // them.
+    mutable std::shared_ptr<const SimTK::ContactGeometry::TriangleMesh>
         _geometry;
-    mutable SimTK::ResetOnCopy<std::unique_ptr<SimTK::DecorativeMesh>>
-        _decorativeGeometry;
+    mutable std::shared_ptr<const SimTK::DecorativeMesh> _decorativeGeometry;
+    // The filename from which the meshes were loaded, and the model file
+    // relative to which the filename was resolved.
+    mutable std::string _meshFilename;
+    mutable std::string _meshModelFileName;
 
 //=============================================================================
 };  // END of class ContactMesh
@@ -282,6 +282,33 @@ double CoordinateLimitForce::calcLimitForce( const SimTK::State& s) const
     return f_limit;
 }
 
+double CoordinateLimitForce::calcLimitStiffness(const SimTK::State& s) const
+{
+    double q = _coord->getValue(s);
+    SimTK::Vector qv(1,q);
+    const std::vector<int> derivComponents{0};
+    double K_up = _upStep->calcValue(qv);
+    double K_low = _loStep->calcValue(qv);
+    double dK_up = _upStep->calcDerivative(derivComponents, qv);
+    double dK_low = _loStep->calcDerivative(derivComponents, qv);
+
+    double qdot = _coord->getSpeedValue(s);
+    // Partial derivatives of the terms of calcLimitForce() with respect to q.
+    double df_up = -dK_up*(q - _qup) - K_up;
+    double df_low = dK_low*(_qlow - q) - K_low;
+    double df_damp = -_damp*(dK_up/_Kup + dK_low/_Klow)*qdot;
+
+    return -(df_up + df_low + df_damp);
+}
+
+double CoordinateLimitForce::calcLimitDamping(const SimTK::State& s) const
+{
+    SimTK::Vector qv(1, _coord->getValue(s));
+    double K_up = _upStep->calcValue(qv);
+    double K_low = _loStep->calcValue(qv);
+    return _damp*(K_up/_Kup + K_low/_Klow);
+}
+
 // Potential energy stored in the limit spring
 double CoordinateLimitForce::computePotentialEnergy(const SimTK::State& s) const
 {
@@ -88,6 +88,14 @@ public:
         "CoordinateLimitForce. If true the dissipation power is automatically "
         "integrated to provide energy. Default is false.");
 
+//==============================================================================
+// OUTPUTS
+//==============================================================================
+    OpenSim_DECLARE_OUTPUT(limit_stiffness, double, calcLimitStiffness,
+            SimTK::Stage::Velocity);
+    OpenSim_DECLARE_OUTPUT(limit_damping, double, calcLimitDamping,
+            SimTK::Stage::Position);
+
 //=============================================================================
 // PUBLIC METHODS
 //=============================================================================
@@ -188,6 +196,21 @@ public:
     /** Force calculation operator. **/
     double calcLimitForce( const SimTK::State& s) const;
 
+    /** The stiffness of the limit force, that is, the negated partial
+    derivative of calcLimitForce() with respect to the coordinate's value, in
+    internal units (N/m or N*m/rad). It includes the change of the stiffness
+    and damping through the transition region, and is zero within the
+    limits. Together with calcLimitDamping(), it is the analytic Jacobian of
+    the force, e.g., for estimating the largest stable step size of an
+    explicit integrator (about 2*sqrt(m/k) for an effective mass m) or for
+    implicit or linearized treatments of the limit. **/
+    double calcLimitStiffness(const SimTK::State& s) const;
+
+    /** The damping of the limit force, that is, the negated partial
+    derivative of calcLimitForce() with respect to the coordinate's speed, in
+    internal units (N/(m/s) or N*m/(rad/s)). **/
+    double calcLimitDamping(const SimTK::State& s) const;
+
     /** Contribute this Force component's potential energy to the accounting
     of the total system energy. **/
     double computePotentialEnergy(const SimTK::State& s) const override;
@@ -24,14 +24,20 @@
 //=============================================================================
 // INCLUDES
 //=============================================================================
-#include <Lepton.h>
-
 #include "ExpressionBasedBushingForce.h"
 
 using namespace std;
 using namespace SimTK;
 using namespace OpenSim;
 
+namespace {
+    // The variables of the expressions, in the order of the deflections.
+    std::vector<std::string> getDeflectionVariableNames() {
+        return {"theta_x", "theta_y", "theta_z",
+                "delta_x", "delta_y", "delta_z"};
+    }
+}
+
 
 // string formatting helper utility
 
@@ -215,59 +221,65 @@ void ExpressionBasedBushingForce::extendFinalizeFromProperties()
     }
 }
 
-/** Set the expression for the Mx function and create it's lepton program */
+/** Set the expression for the Mx function and compile it */
 void ExpressionBasedBushingForce::setMxExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Mx_expression(expression);
-    MxProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    MxExpr = CompiledLeptonExpression(
+            expression, getDeflectionVariableNames());
 }
 
-/** Set the expression for the My function and create it's lepton program */
+/** Set the expression for the My function and compile it */
 void ExpressionBasedBushingForce::setMyExpression(std::string expression) 
 {
     
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_My_expression(expression);
-    MyProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    MyExpr = CompiledLeptonExpression(
+            expression, getDeflectionVariableNames());
 }
 
-/** Set the expression for the Mz function and create it's lepton program */
+/** Set the expression for the Mz function and compile it */
 void ExpressionBasedBushingForce::setMzExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Mz_expression(expression);
-    MzProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    MzExpr = CompiledLeptonExpression(
+            expression, getDeflectionVariableNames());
 }
 
-/** Set the expression for the Fx function and create it's lepton program */
+/** Set the expression for the Fx function and compile it */
 void ExpressionBasedBushingForce::setFxExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fx_expression(expression);
-    FxProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    FxExpr = CompiledLeptonExpression(
+            expression, getDeflectionVariableNames());
 }
 
-/** Set the expression for the Fy function and create it's lepton program */
+/** Set the expression for the Fy function and compile it */
 void ExpressionBasedBushingForce::setFyExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fy_expression(expression);
-    FyProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    FyExpr = CompiledLeptonExpression(
+            expression, getDeflectionVariableNames());
 }
 
-/** Set the expression for the Fz function and create it's lepton program */
+/** Set the expression for the Fz function and compile it */
 void ExpressionBasedBushingForce::setFzExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fz_expression(expression);
-    FzProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    FzExpr = CompiledLeptonExpression(
+            expression, getDeflectionVariableNames());
 }
 //=============================================================================
 // COMPUTATION
@@ -282,21 +294,12 @@ SimTK::Vec6 ExpressionBasedBushingForce::
 
     Vec6 fk = Vec6(0.0);
 
-    std::map<std::string, double> deflectionVars;
-    deflectionVars["theta_x"] = dq[0];
-    deflectionVars["theta_y"] = dq[1];
-    deflectionVars["theta_z"] = dq[2];
-    deflectionVars["delta_x"] = dq[3];
-    deflectionVars["delta_y"] = dq[4];
-    deflectionVars["delta_z"] = dq[5];
-
-
-    fk[0] = MxProg.evaluate(deflectionVars);
-    fk[1] = MyProg.evaluate(deflectionVars);
-    fk[2] = MzProg.evaluate(deflectionVars);
-    fk[3] = FxProg.evaluate(deflectionVars);
-    fk[4] = FyProg.evaluate(deflectionVars);
-    fk[5] = FzProg.evaluate(deflectionVars);
+    fk[0] = MxExpr.evaluate(&dq[0]);
+    fk[1] = MyExpr.evaluate(&dq[0]);
+    fk[2] = MzExpr.evaluate(&dq[0]);
+    fk[3] = FxExpr.evaluate(&dq[0]);
+    fk[4] = FyExpr.evaluate(&dq[0]);
+    fk[5] = FzExpr.evaluate(&dq[0]);
 
     return -fk;
 }
@@ -27,6 +27,7 @@
 // INCLUDE
 #include "Force.h"
 #include <OpenSim/Simulation/Model/TwoFrameLinker.h>
+#include "CompiledLeptonExpression.h"
 
 namespace OpenSim {
 
@@ -272,8 +273,9 @@ private:
 
     SimTK::Mat66 _dampingMatrix{ 0.0 };
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram MxProg, MyProg, MzProg, FxProg, FyProg, FzProg;
+    // compiled expressions of the moments and forces, whose variables are the
+    // deflections (see getDeflectionVariableNames() in the .cpp file)
+    CompiledLeptonExpression MxExpr, MyExpr, MzExpr, FxExpr, FyExpr, FzExpr;
 
 //==============================================================================
 };  // END of class ExpressionBasedBushingForce
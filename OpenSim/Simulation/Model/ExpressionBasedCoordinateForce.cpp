@@ -26,8 +26,6 @@
 //=============================================================================
 #include "ExpressionBasedCoordinateForce.h"
 #include <OpenSim/Simulation/Model/Model.h>
-#include <lepton/Parser.h>
-#include <lepton/ParsedExpression.h>
 
 using namespace OpenSim;
 using namespace std;
@@ -97,7 +95,7 @@ void ExpressionBasedCoordinateForce::extendConnectToModel(Model& aModel)
             remove_if(expression.begin(), expression.end(), ::isspace), 
                       expression.end() );
     
-    _forceProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    _forceExpr = CompiledLeptonExpression(expression, {"q", "qdot"});
 
     // Look up the coordinate
     if (!_model->updCoordinateSet().contains(coordName)) {
@@ -135,12 +133,8 @@ void ExpressionBasedCoordinateForce::computeForce(const SimTK::State& s,
 double ExpressionBasedCoordinateForce::calcExpressionForce(const SimTK::State& s ) const
 {
     using namespace SimTK;
-    double q = _coord->getValue(s);
-    double qdot = _coord->getSpeedValue(s);
-    std::map<std::string, double> forceVars;
-    forceVars["q"] = q;
-    forceVars["qdot"] = qdot;
-    double forceMag = _forceProg.evaluate(forceVars);
+    const double forceVars[] = {_coord->getValue(s), _coord->getSpeedValue(s)};
+    double forceMag = _forceExpr.evaluate(forceVars);
     setCacheVariableValue(s, _forceMagnitudeCV, forceMag);
     return forceMag;
 }
@@ -26,8 +26,6 @@
 //=============================================================================
 #include "ExpressionBasedPointToPointForce.h"
 #include <OpenSim/Simulation/Model/Model.h>
-#include <lepton/Parser.h>
-#include <lepton/ParsedExpression.h>
 
 using namespace OpenSim;
 using namespace std;
@@ -137,7 +135,7 @@ void ExpressionBasedPointToPointForce::extendConnectToModel(Model& model)
             remove_if(expression.begin(), expression.end(), ::isspace), 
                       expression.end() );
     
-    _forceProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    _forceExpr = CompiledLeptonExpression(expression, {"d", "ddot"});
 }
 
 //=============================================================================
@@ -187,11 +185,8 @@ void ExpressionBasedPointToPointForce::computeForce(const SimTK::State& s,
     //speed along the line connecting the two bodies
     const double ddot = dot(vRel, r_G)/d;
 
-    std::map<std::string, double> forceVars;
-    forceVars["d"] = d;
-    forceVars["ddot"] = ddot;
-
-    double forceMag = _forceProg.evaluate(forceVars);
+    const double forceVars[] = {d, ddot};
+    double forceMag = _forceExpr.evaluate(forceVars);
     setCacheVariableValue(s, _forceMagnitudeCV, forceMag);
 
     const Vec3 f1_G = (forceMag/d) * r_G;
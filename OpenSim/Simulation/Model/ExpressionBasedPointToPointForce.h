@@ -24,7 +24,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "Force.h"
-#include <lepton/ExpressionProgram.h>
+#include "CompiledLeptonExpression.h"
 
 namespace SimTK {
 class MobilizedBody;
@@ -169,8 +169,8 @@ private:
     void setNull();
     void constructProperties();
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram _forceProg;
+    // compiled expression of the force, whose variables are d and ddot
+    CompiledLeptonExpression _forceExpr;
 
     // Temporary solution until implemented with Sockets
     SimTK::ReferencePtr<const PhysicalFrame> _body1;
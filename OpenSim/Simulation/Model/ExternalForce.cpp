@@ -200,6 +200,12 @@ void ExternalForce::extendConnectToModel(Model& model)
                 get_point_expressed_in_body());
         _pointExpressedInBody = &_model->getGround();
     }
+    // Data already expressed in the frames used to apply the force (e.g., by
+    // ExternalLoads::transformToAppliedBodies()) need not be re-expressed.
+    _forceExpressedInGround =
+            _forceExpressedInBody.get() == &getModel().getGround();
+    _pointExpressedInAppliedBody = !_specifiesPoint ||
+            _pointExpressedInBody.get() == _appliedToBody.get();
 
     if(!_dataSource){
         throw Exception("ExternalForce: No Data source has been set.");
@@ -265,6 +271,8 @@ void ExternalForce::extendConnectToModel(Model& model)
     _forceFunctions.clearAndDestroy();
     _pointFunctions.clearAndDestroy();
     _torqueFunctions.clearAndDestroy();
+    _numDataTimes = nt;
+    _dataIntervalHint.value.store(0, std::memory_order_relaxed);
 
     // Create functions now that we should have good data remaining
     if(_appliesForce){
@@ -319,6 +327,10 @@ void ExternalForce::extendConnectToModel(Model& model)
             }
         }
     }
+
+    // Fit the splines now rather than at their first evaluation.
+    Vec3 force0, point0, torque0;
+    calcDataAtTime(time[0], force0, point0, torque0);
 }
 
 
@@ -336,12 +348,15 @@ void ExternalForce::computeForce(const SimTK::State& state,
 
     OPENSIM_ASSERT_FRMOBJ(_appliedToBody != nullptr);
 
+    Vec3 force, point, torque;
+    calcDataAtTime(time, force, point, torque);
+
     if (_appliesForce) {
-        Vec3 force = getForceAtTime(time);
-        force = _forceExpressedInBody->expressVectorInGround(state, force);
-        Vec3 point(0); // Default is body origin.
-        if (_specifiesPoint) {
-            point = getPointAtTime(time);
+        if (!_forceExpressedInGround) {
+            force = _forceExpressedInBody->expressVectorInGround(state, force);
+        }
+        // The point is the body origin unless one is specified.
+        if (!_pointExpressedInAppliedBody) {
             point = _pointExpressedInBody->
                 findStationLocationInAnotherFrame(state, point, *_appliedToBody);
         }
@@ -349,8 +364,9 @@ void ExternalForce::computeForce(const SimTK::State& state,
     }
 
     if (_appliesTorque) {
-        Vec3 torque = getTorqueAtTime(time);
-        torque = _forceExpressedInBody->expressVectorInGround(state, torque);
+        if (!_forceExpressedInGround) {
+            torque = _forceExpressedInBody->expressVectorInGround(state, torque);
+        }
         applyTorque(state, *_appliedToBody, torque, bodyForces);
     }
 }
@@ -360,49 +376,63 @@ void ExternalForce::computeForce(const SimTK::State& state,
  */
 Vec3 ExternalForce::getForceAtTime(double aTime) const  
 {
-    SimTK::Vector timeAsVector(1, aTime);
-    const Function* forceX=NULL;
-    const Function* forceY=NULL;
-    const Function* forceZ=NULL;
-    if (_forceFunctions.size()==3){
-        forceX=_forceFunctions[0];  forceY=_forceFunctions[1];  forceZ=_forceFunctions[2];
-    }
-    Vec3 force(forceX?forceX->calcValue(timeAsVector):0.0, 
-        forceY?forceY->calcValue(timeAsVector):0.0, 
-        forceZ?forceZ->calcValue(timeAsVector):0.0);
+    Vec3 force, point, torque;
+    calcDataAtTime(aTime, force, point, torque);
     return force;
 }
 
 Vec3 ExternalForce::getPointAtTime(double aTime) const
 {
-    SimTK::Vector timeAsVector(1, aTime);
-    const Function* pointX=NULL;
-    const Function* pointY=NULL;
-    const Function* pointZ=NULL;
-    if (_pointFunctions.size()==3){
-        pointX=_pointFunctions[0];  pointY=_pointFunctions[1];  pointZ=_pointFunctions[2];
-    }
-    Vec3 point(pointX?pointX->calcValue(timeAsVector):0.0, 
-        pointY?pointY->calcValue(timeAsVector):0.0, 
-        pointZ?pointZ->calcValue(timeAsVector):0.0);
+    Vec3 force, point, torque;
+    calcDataAtTime(aTime, force, point, torque);
     return point;
 }
 
 Vec3 ExternalForce::getTorqueAtTime(double aTime) const
 {
-    SimTK::Vector timeAsVector(1, aTime);
-    const Function* torqueX=NULL;
-    const Function* torqueY=NULL;
-    const Function* torqueZ=NULL;
-    if (_torqueFunctions.size()==3){
-        torqueX=_torqueFunctions[0];    torqueY=_torqueFunctions[1];    torqueZ=_torqueFunctions[2];
-    }
-    Vec3 torque(torqueX?torqueX->calcValue(timeAsVector):0.0, 
-        torqueY?torqueY->calcValue(timeAsVector):0.0, 
-        torqueZ?torqueZ->calcValue(timeAsVector):0.0);
+    Vec3 force, point, torque;
+    calcDataAtTime(aTime, force, point, torque);
     return torque;
 }
 
+void ExternalForce::calcDataAtTime(double aTime, Vec3& rForce, Vec3& rPoint,
+        Vec3& rTorque) const
+{
+    // All the functions have the same times, so only the first one searches
+    // for the interval that contains aTime; the search starts from the
+    // interval of the previous evaluation, which usually contains aTime or
+    // is next to it.
+    int interval = _dataIntervalHint.value.load(std::memory_order_relaxed);
+    const auto evaluate = [&](const ArrayPtrs<Function>& functions,
+            Vec3& values) {
+        values = Vec3(0);
+        if (functions.size() != 3) return;
+        for (int i = 0; i < 3; ++i)
+            values[i] = calcDataFunctionValue(*functions[i], aTime, interval);
+    };
+    evaluate(_forceFunctions, rForce);
+    evaluate(_pointFunctions, rPoint);
+    evaluate(_torqueFunctions, rTorque);
+    _dataIntervalHint.value.store(interval, std::memory_order_relaxed);
+}
+
+double ExternalForce::calcDataFunctionValue(const Function& function,
+        double aTime, int& rInterval) const
+{
+    // The functions are created in extendConnectToModel().
+    switch (_numDataTimes) {
+        case 1:
+            return static_cast<const Constant&>(function).getValue();
+        case 2:
+        case 3:
+            return static_cast<const PiecewiseLinearFunction&>(function)
+                    .evaluate(aTime, 0, rInterval);
+        default:
+            return static_cast<const GCVSpline&>(function)
+                    .evaluate(aTime, 0, rInterval);
+    }
+}
+
 
 //-----------------------------------------------------------------------------
 // Reporting
@@ -440,14 +470,15 @@ OpenSim::Array<double> ExternalForce::getRecordValues(const SimTK::State& state)
     OpenSim::Array<double>  values(SimTK::NaN);
     double time = state.getTime();
 
+    Vec3 force, point, torque;
+    calcDataAtTime(time, force, point, torque);
+
     if (_appliesForce) {
-        Vec3 force = getForceAtTime(time);
         force = _forceExpressedInBody->expressVectorInGround(state, force);
         for(int i=0; i<3; ++i)
             values.append(force[i]);
     
         if (_specifiesPoint) {
-            Vec3 point = getPointAtTime(time);
             point = _pointExpressedInBody->
                 findStationLocationInAnotherFrame(state, point, *_appliedToBody);
             for(int i=0; i<3; ++i)
@@ -455,7 +486,6 @@ OpenSim::Array<double> ExternalForce::getRecordValues(const SimTK::State& state)
         }
     }
     if (_appliesTorque){
-        Vec3 torque = getTorqueAtTime(time);
         torque = _forceExpressedInBody->expressVectorInGround(state, torque);
         for(int i=0; i<3; ++i)
             values.append(torque[i]);
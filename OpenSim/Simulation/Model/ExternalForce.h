@@ -25,6 +25,8 @@
 // INCLUDE
 #include "Force.h"
 
+#include <atomic>
+
 namespace OpenSim {
 
 class Model;
@@ -229,6 +231,13 @@ protected:
 private:
     void setNull();
     void constructProperties();
+    /** Evaluate the force, point, and torque functions (those that are
+        applied; the others are zero) at the given time, with one search for
+        the interval of the data times that contains it. */
+    void calcDataAtTime(double aTime, SimTK::Vec3& rForce,
+            SimTK::Vec3& rPoint, SimTK::Vec3& rTorque) const;
+    double calcDataFunctionValue(const Function& function, double aTime,
+            int& rInterval) const;
 
 
 //==============================================================================
@@ -253,11 +262,31 @@ private:
     bool _appliesForce {false};
     bool _specifiesPoint {false};
     bool _appliesTorque {false};
+    /** whether the data are already expressed in the frames in which the
+        force is applied (ground for the force and torque, the applied-to body
+        for the point), so computeForce() need not re-express them */
+    bool _forceExpressedInGround {false};
+    bool _pointExpressedInAppliedBody {false};
 
     /** force data as a function of time used internally */
     ArrayPtrs<Function> _forceFunctions;
     ArrayPtrs<Function> _torqueFunctions;
     ArrayPtrs<Function> _pointFunctions;
+    /** The number of data times, which determines the type of the
+        functions: Constant (1), PiecewiseLinearFunction (2 or 3), or
+        GCVSpline. */
+    int _numDataTimes {0};
+
+    /** The interval of the data times that contained the time of the last
+        evaluation, where the search for the next time starts. It is only a
+        hint (the results do not depend on it), so it is not copied. */
+    struct IntervalHint {
+        IntervalHint() = default;
+        IntervalHint(const IntervalHint&) {}
+        IntervalHint& operator=(const IntervalHint&) { return *this; }
+        mutable std::atomic<int> value {0};
+    };
+    IntervalHint _dataIntervalHint;
 
     friend class ExternalLoads;
 //==============================================================================
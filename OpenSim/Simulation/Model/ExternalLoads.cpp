@@ -31,6 +31,8 @@
 #include <OpenSim/Simulation/Model/PrescribedForce.h>
 #include <OpenSim/Common/IO.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace OpenSim;
 using SimTK::Vec3;
@@ -393,6 +395,141 @@ ExternalForce* ExternalLoads::transformPointExpressedInGroundToAppliedBody(
     return exF_transformedPoint;
 }
 
+//_____________________________________________________________________________
+/**
+ * Re-express the data of all ExternalForces in this collection of
+ * ExternalLoads in the frames in which the forces are applied: forces and
+ * torques in ground and points in the appliedToBody. Each transformed
+ * ExternalForce gets its own data source, with the data at the times of the
+ * kinematics, and replaces the original ExternalForce. computeForce() then
+ * only evaluates the data functions of the transformed forces.
+ * ExternalForces whose data are already expressed in these frames are left
+ * untouched.
+ *
+ * @param kinematics Storage containing the time history of generalized
+ * coordinates for the model. Note that all generalized coordinates must
+ * be specified and in radians and Euler parameters.
+ */
+void ExternalLoads::transformToAppliedBodies(
+    const Storage &kinematics, double startTime, double endTime)
+{
+    std::vector<ExternalForce*> transformedForces;
+    for (int i = 0; i < getSize(); ++i) {
+        transformedForces.push_back(
+                transformToAppliedBody(get(i), kinematics, startTime, endTime));
+    }
+    bool transformed = false;
+    for (int i = 0; i < (int)transformedForces.size(); ++i) {
+        if (transformedForces[i]) {
+            set(i, transformedForces[i]);
+            transformed = true;
+        }
+    }
+
+    if (transformed)
+        _dataFileName = "";
+}
+
+ExternalForce* ExternalLoads::transformToAppliedBody(
+    const ExternalForce &exForce, const Storage &kinematics,
+    double startTime, double endTime)
+{
+    OPENSIM_THROW_IF_FRMOBJ(!hasModel() || !getModel().isValidSystem(),
+            Exception,
+            "Transforming ExternalForce '{}' requires a model with a valid "
+            "system.", exForce.getName());
+
+    const Ground& ground = getModel().getGround();
+    const PhysicalFrame& appliedToBody = *exForce._appliedToBody;
+    const PhysicalFrame& forceExpressedInBody = *exForce._forceExpressedInBody;
+
+    const bool transformForce = &forceExpressedInBody != &ground;
+    const bool transformPoint = exForce._specifiesPoint &&
+            exForce._pointExpressedInBody.get() != &appliedToBody;
+    if (!transformForce && !transformPoint) return nullptr;
+
+    int nt = kinematics.getSize();
+    if (nt == 0) {
+        log_warn("ExternalLoads: Specified load kinematics contains no "
+                 "coordinate values. ExternalForce '{}' cannot be "
+                 "transformed.", exForce.getName());
+        return nullptr;
+    }
+    int startIndex = 0;
+    int lastIndex = nt - 1;
+    // Include one more time at each end of the data, as in
+    // transformPointExpressedInGroundToAppliedBody().
+    if (startTime != -SimTK::Infinity)
+        startIndex = std::max(kinematics.findIndex(startTime) - 1, 0);
+    if (endTime != SimTK::Infinity)
+        lastIndex = std::min(kinematics.findIndex(endTime) + 1, lastIndex);
+    nt = lastIndex - startIndex + 1;
+
+    // Construct a new storage to contain the re-expressed data for the new
+    // external force.
+    Storage* newDataSource = new Storage(nt);
+    Array<string> labels;
+    labels.append("time");
+    const auto appendLabels = [&labels](const std::string& identifier) {
+        labels.append(identifier + ".x");
+        labels.append(identifier + ".y");
+        labels.append(identifier + ".z");
+    };
+    if (exForce._appliesForce) appendLabels(exForce.getForceIdentifier());
+    if (exForce._specifiesPoint) appendLabels(exForce.getPointIdentifier());
+    if (exForce._appliesTorque) appendLabels(exForce.getTorqueIdentifier());
+    newDataSource->setColumnLabels(labels);
+
+    SimTK::State& s = updModel().updWorkingState();
+    const int nq = getModel().getNumCoordinates();
+    const CoordinateSet& coordinates = getModel().getCoordinateSet();
+    Array<double> Q(0.0, nq);
+    SimTK::Vector datarow(labels.getSize() - 1, SimTK::NaN);
+    double time = 0;
+    Vec3 force, point, torque;
+    for (int i = startIndex; i <= lastIndex; ++i) {
+        kinematics.getTime(i, time);
+        kinematics.getData(i, nq, &Q[0]);
+        // Position the model according to the specified kinematics.
+        for (int j = 0; j < nq; ++j) {
+            coordinates.get(j).setValue(s, Q[j], j == nq - 1);
+        }
+        getModel().getMultibodySystem().realize(s, SimTK::Stage::Position);
+
+        exForce.calcDataAtTime(time, force, point, torque);
+        int col = 0;
+        const auto appendData = [&datarow, &col](const Vec3& data) {
+            for (int j = 0; j < 3; ++j) datarow[col++] = data[j];
+        };
+        if (exForce._appliesForce) {
+            appendData(forceExpressedInBody.expressVectorInGround(s, force));
+        }
+        if (exForce._specifiesPoint) {
+            appendData(exForce._pointExpressedInBody->
+                    findStationLocationInAnotherFrame(s, point, appliedToBody));
+        }
+        if (exForce._appliesTorque) {
+            appendData(forceExpressedInBody.expressVectorInGround(s, torque));
+        }
+        newDataSource->append(time, datarow);
+    }
+
+    newDataSource->setName(exForce.getDataSourceName() + "_transformed");
+
+    ExternalForce* exF_transformed = exForce.clone();
+    exF_transformed->setName(exForce.getName() + "_transformed");
+    exF_transformed->setForceExpressedInBodyName(ground.getName());
+    if (exForce._specifiesPoint) {
+        exF_transformed->setPointExpressedInBodyName(
+                exForce.getAppliedToBodyName());
+    }
+    exF_transformed->setDataSource(*newDataSource);
+
+    _storages.push_back(shared_ptr<Storage>(newDataSource));
+
+    return exF_transformed;
+}
+
 //-----------------------------------------------------------------------------
 // UPDATE FROM OLDER VERSION
 //-----------------------------------------------------------------------------
@@ -114,6 +114,26 @@ public:
     void transformPointsExpressedInGroundToAppliedBodies(const Storage &kinematics, double startTime = -SimTK::Infinity, double endTime = SimTK::Infinity);
     ExternalForce* transformPointExpressedInGroundToAppliedBody(const ExternalForce &exForce, const Storage &kinematics, double startTime, double endTime);
 
+    /** Re-express the data of all the ExternalForces in the frames in which
+    they are applied (forces and torques in ground, points in the applied-to
+    body) once, at each time of the given kinematics (the values of all the
+    coordinates of the model, in the order of its CoordinateSet), so that
+    computing the forces does not transform the data again. This is meant for
+    prescribed kinematics (e.g., inverse dynamics or analyses of a motion);
+    the transformed forces replace the original ones, and their data are
+    interpolated between the times of the kinematics. ExternalForces whose
+    data are already expressed in these frames are not replaced. Requires a
+    model with a valid system. */
+    void transformToAppliedBodies(const Storage& kinematics,
+            double startTime = -SimTK::Infinity,
+            double endTime = SimTK::Infinity);
+    /** Create a copy of the given ExternalForce with its data re-expressed as
+    described by transformToAppliedBodies(), or return nullptr if its data are
+    already expressed in the frames in which it is applied. The new data
+    source is owned by this ExternalLoads. */
+    ExternalForce* transformToAppliedBody(const ExternalForce& exForce,
+            const Storage& kinematics, double startTime, double endTime);
+
     /// ExternalLoads remembers the file it was loaded from, even after being
     /// copied. This file path is used to find the datafile relative to the
     /// location of the ExternalLoads file itself. This function can clear
@@ -57,6 +57,7 @@ void Force::setNull()
 void Force::constructProperties()
 {
     constructProperty_appliesForce(true);
+    constructProperty_compute_in_parallel(false);
 }
 
 void
@@ -164,6 +165,17 @@ bool Force::appliesForce(const SimTK::State& s) const
     return get_appliesForce();
 }
 
+void Force::calcForceContribution(const SimTK::State& state,
+        SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+        SimTK::Vector& generalizedForces) const
+{
+    OPENSIM_THROW_IF_FRMOBJ(!_index.isValid(), Exception,
+            "Force is not part of a system; call initSystem() first.");
+    SimTK::Vector_<SimTK::Vec3> particleForces;
+    _model->getForceSubsystem().getForce(_index).calcForceContribution(
+            state, bodyForces, particleForces, generalizedForces);
+}
+
 //-----------------------------------------------------------------------------
 // ABSTRACT METHODS
 //-----------------------------------------------------------------------------
@@ -54,6 +54,10 @@ public:
         "NOTE: Prior to OpenSim 4.0, this behavior was controlled by the "
         "'isDisabled' property, where 'true' meant that force was not being "
         "applied. Thus, if 'isDisabled' is true, then 'appliesForce` is false.");
+    OpenSim_DECLARE_PROPERTY(compute_in_parallel, bool,
+        "Flag asserting that computeForce() of this force is thread-safe, so "
+        "that it may be computed in parallel with the other forces of the "
+        "model (see shouldBeParallelized()). Default is false.");
     //=========================================================================
     // OUTPUTS
     //=========================================================================
@@ -70,11 +74,20 @@ public:
     * complete their calcForce method. Note that all forces
     * that set this flag to false will be put in series on a
     * thread that is running in parallel with other forces
-    * that marked this flag as true.
+    * that marked this flag as true. Each thread adds its forces to its own
+    * body and generalized force vectors, which are summed once all the forces
+    * are computed.
+    *
+    * The default is the value of the compute_in_parallel property. Only set
+    * it for forces whose computeForce() is thread-safe: it may read the state
+    * and the cache variables of this force (and of its subcomponents), but it
+    * must not lazily evaluate a cache variable that another force also
+    * evaluates (e.g., a path shared by two forces). Forces computed in
+    * parallel are not timed by the ComponentProfiler.
     */
     virtual bool shouldBeParallelized() const
     {
-        return false;
+        return get_compute_in_parallel();
     }
 
     /** Return if the Force is applied (or enabled) or not.                   */
@@ -82,6 +95,18 @@ public:
     /** %Set whether or not the Force is applied.                             */
     void setAppliesForce(SimTK::State& s, bool applyForce) const;
 
+    /** Compute the body and generalized (mobility) forces that this Force
+    would apply at `state` (whether or not it is applied), without adding them
+    to the forces of the system. The outputs are resized (to the number of
+    mobilized bodies and the number of speeds) and zeroed first. The state
+    must be realized to the stage that the force requires (usually
+    SimTK::Stage::Velocity). This is useful for evaluating the contribution of
+    one force to the dynamics (e.g., induced accelerations), since it does
+    not require re-realizing the rest of the system. */
+    void calcForceContribution(const SimTK::State& state,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& generalizedForces) const;
+
     /**
      * Methods to query a Force for the value actually applied during 
      * simulation. The names of the quantities (column labels) is returned by 
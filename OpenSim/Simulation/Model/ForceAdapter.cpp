@@ -46,6 +46,13 @@ void ForceAdapter::calcForce(const SimTK::State& state,
     SimTK::Vector_<SimTK::SpatialVec>& bodyForces,SimTK::Vector_<SimTK::Vec3>& particleForces,
     SimTK::Vector& mobilityForces) const
 {
+    // A profiler must only be used by one thread at a time.
+    if (_force->shouldBeParallelized()) {
+        _force->computeForce(state, bodyForces, mobilityForces);
+        return;
+    }
+    ComponentProfiler::Scope scope(*_force,
+            ComponentProfiler::Hook::ComputeForce);
     _force->computeForce(state, bodyForces, mobilityForces);
 }
 
@@ -56,4 +63,8 @@ SimTK::Real ForceAdapter::calcPotentialEnergy(const SimTK::State& state) const
 
 bool ForceAdapter::shouldBeParallelized() const {
     return _force->shouldBeParallelized(); 
-}
\ No newline at end of file
+}
+
+bool ForceAdapter::shouldBeParallelized() {
+    return _force->shouldBeParallelized();
+}
@@ -62,8 +62,10 @@ public:
     // CALC POTENTIAL ENERGY (Called by Simbody)
     SimTK::Real calcPotentialEnergy(const SimTK::State& state) const override;   
 
-    // SIMBODY PARALLELISM FLAG 
+    // SIMBODY PARALLELISM FLAG (Force::shouldBeParallelized()). Simbody
+    // queries the non-const overload.
     bool shouldBeParallelized() const;
+    bool shouldBeParallelized();
 
     // No need to override realize() methods; we don't provide that service
     // to OpenSim Force elements.
@@ -204,6 +204,11 @@ void FunctionBasedPath::computeLength(const SimTK::State& s) const
         return;
     }
 
+    if (!_lengthPolynomial.empty()) {
+        computeLengthAndMomentArms(s);
+        return;
+    }
+
     setCacheVariableValue(s, _lengthCV,
             getLengthFunction().calcValue(computeCoordinateValues(s)));
 }
@@ -214,6 +219,11 @@ void FunctionBasedPath::computeMomentArms(const SimTK::State& s) const
         return;
     }
 
+    if (!_lengthPolynomial.empty()) {
+        computeLengthAndMomentArms(s);
+        return;
+    }
+
     const auto& values = computeCoordinateValues(s);
     SimTK::Vector momentArms((int)_coordinates.size(), 0.0);
     if (_computeMomentArms) {
@@ -264,6 +274,23 @@ void FunctionBasedPath::computeLengtheningSpeed(const SimTK::State& s) const
     }
 }
 
+void FunctionBasedPath::computeLengthAndMomentArms(
+        const SimTK::State& s) const
+{
+    // The length polynomial and its partial derivatives share the powers of
+    // the coordinate values, so compute them in one pass.
+    SimTK::Vector gradient;
+    const double length = _lengthPolynomial->calcValueAndGradient(
+            computeCoordinateValues(s), gradient);
+    if (!isCacheVariableValid(s, _lengthCV)) {
+        setCacheVariableValue(s, _lengthCV, length);
+    }
+    if (!isCacheVariableValid(s, _momentArmsCV)) {
+        // Negative sign to obey the OpenSim convention.
+        setCacheVariableValue(s, _momentArmsCV, SimTK::Vector(-gradient));
+    }
+}
+
 //=============================================================================
 // MODEL COMPONENT INTERFACE
 //=============================================================================
@@ -301,8 +328,12 @@ void FunctionBasedPath::extendFinalizeFromProperties() {
                         getLengthFunction().getArgumentSize(),
                         getProperty_coordinate_paths().size()))
 
+    _lengthPolynomial.clear();
     if (getProperty_moment_arm_functions().empty()) {
         _computeMomentArms = true;
+        _lengthPolynomial.reset(
+                dynamic_cast<const MultivariatePolynomialFunction*>(
+                        &getLengthFunction()));
         OPENSIM_THROW_IF_FRMOBJ(getLengthFunction().getMaxDerivativeOrder() < 1,
                 Exception, "Since moment arm functions were not provided, "
                            "expected the length function to be at least "
@@ -25,6 +25,7 @@
 
 #include "OpenSim/Simulation/Model/AbstractPath.h"
 #include "OpenSim/Common/Function.h"
+#include "OpenSim/Common/MultivariatePolynomialFunction.h"
 
 namespace OpenSim {
 
@@ -206,12 +207,17 @@ private:
     void computeLength(const SimTK::State& s) const;
     void computeMomentArms(const SimTK::State& s) const;
     void computeLengtheningSpeed(const SimTK::State& s) const;
+    void computeLengthAndMomentArms(const SimTK::State& s) const;
 
     // MEMBER VARIABLES
     std::vector<SimTK::ReferencePtr<const Coordinate>> _coordinates;
     std::unordered_map<std::string, int> _coordinateIndices;
     bool _computeMomentArms = false;
     bool _computeLengtheningSpeed = false;
+    // Set if the moment arms are computed from a length function that is a
+    // MultivariatePolynomialFunction, so that the length and moment arms can
+    // be computed together.
+    SimTK::ReferencePtr<const MultivariatePolynomialFunction> _lengthPolynomial;
 
     // CACHE VARIABLES
     mutable CacheVariable<double> _lengthCV;
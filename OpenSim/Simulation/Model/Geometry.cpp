@@ -24,7 +24,13 @@
 //=============================================================================
 // INCLUDES
 //=============================================================================
+#include <algorithm>
+#include <condition_variable>
 #include <fstream>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
 #include "Frame.h"
 #include "Geometry.h"
 #include "Model.h"
@@ -35,6 +41,91 @@ using namespace std;
 using namespace OpenSim;
 using namespace SimTK;
 
+namespace {
+/* The meshes decoded from files in this process, keyed by the path of the
+file. Copies of a DecorativeMeshFile share its decoded PolygonalMesh, so the
+cached DecorativeMeshFiles are copied to the Meshes that use the same file. A
+file is decoded either on a background thread (startLoading()), with at most
+one decoding thread per core, or on the first call to get(). */
+class MeshFileCache {
+public:
+    static MeshFileCache& getInstance() {
+        static MeshFileCache cache;
+        return cache;
+    }
+
+    void startLoading(const std::string& path) {
+        find(path, std::launch::async);
+    }
+
+    /// Wait for the mesh if it is being decoded in the background, or decode
+    /// it now if it has not been requested yet. Throws if the file cannot be
+    /// loaded (the file is then attempted again by the next call).
+    DecorativeMeshFile get(const std::string& path) {
+        std::shared_future<DecorativeMeshFile> mesh =
+                find(path, std::launch::deferred);
+        try {
+            return mesh.get();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_meshes.erase(path);
+            throw;
+        }
+    }
+
+private:
+    std::shared_future<DecorativeMeshFile> find(
+            const std::string& path, std::launch policy) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_meshes.find(path);
+        if (it != m_meshes.end()) return it->second;
+        std::shared_future<DecorativeMeshFile> mesh =
+                std::async(policy, [this, path, policy]() {
+                    ThreadSlot slot(
+                            policy == std::launch::async ? this : nullptr);
+                    DecorativeMeshFile mesh(path);
+                    // Decode the file now rather than on first use.
+                    mesh.getMesh();
+                    return mesh;
+                }).share();
+        m_meshes[path] = mesh;
+        return mesh;
+    }
+
+    // Limits the number of background threads that decode at once.
+    class ThreadSlot {
+    public:
+        ThreadSlot(MeshFileCache* cache) : m_cache(cache) {
+            if (!m_cache) return;
+            std::unique_lock<std::mutex> lock(m_cache->m_threadsMutex);
+            const unsigned maxNumThreads =
+                    std::max(1u, std::thread::hardware_concurrency());
+            m_cache->m_threadsAvailable.wait(lock, [this, maxNumThreads]() {
+                return m_cache->m_numThreads < maxNumThreads;
+            });
+            ++m_cache->m_numThreads;
+        }
+        ~ThreadSlot() {
+            if (!m_cache) return;
+            {
+                std::lock_guard<std::mutex> lock(m_cache->m_threadsMutex);
+                --m_cache->m_numThreads;
+            }
+            m_cache->m_threadsAvailable.notify_one();
+        }
+    private:
+        MeshFileCache* m_cache;
+    };
+
+    std::mutex m_mutex;
+    std::map<std::string, std::shared_future<DecorativeMeshFile>> m_meshes;
+
+    std::mutex m_threadsMutex;
+    std::condition_variable m_threadsAvailable;
+    unsigned m_numThreads = 0;
+};
+} // anonymous namespace
+
 OpenSim_DEFINE_SOCKET_FD(frame, Geometry);
 
 Geometry::Geometry() {
@@ -219,6 +310,8 @@ void FrameGeometry::implementCreateDecorativeGeometry(SimTK::Array_<SimTK::Decor
 void Mesh::extendFinalizeFromProperties() {
 
     if (!isObjectUpToDateWithProperties()) {
+        meshFilePath.clear();
+        cachedMesh.reset();
         const Component* rootModel = nullptr;
         if (!hasOwner()) {
             log_error("Mesh {} not connected to model...ignoring",
@@ -294,27 +387,37 @@ void Mesh::extendFinalizeFromProperties() {
             return;
         }
 
-        cachedMesh.reset(new DecorativeMeshFile(attempts.back().c_str()));
+        // The file is decoded on first use (or in the background; see
+        // startLoadingMeshFile()).
+        meshFilePath = attempts.back();
     }
 }
 
+void Mesh::startLoadingMeshFile() const
+{
+    if (!meshFilePath.empty() && cachedMesh.get() == nullptr)
+        MeshFileCache::getInstance().startLoading(meshFilePath);
+}
+
 
 void Mesh::implementCreateDecorativeGeometry(SimTK::Array_<SimTK::DecorativeGeometry>& decoGeoms) const
 {
-    if (cachedMesh.get() != nullptr) {
+    if (cachedMesh.get() == nullptr && !meshFilePath.empty()) {
         try {
-            // Force the loading of the mesh to see if it has bad contents
-            // (e.g., binary vtp).
+            // Load the mesh to see if it has bad contents (e.g., binary vtp).
             // We do not want to do this in extendFinalizeFromProperties b/c
             // it's expensive to repeatedly load meshes.
-            cachedMesh->getMesh();
+            cachedMesh.reset(new DecorativeMeshFile(
+                    MeshFileCache::getInstance().get(meshFilePath)));
         } catch (const std::exception& e) {
             log_warn("Visualizer couldn't open {} because: {}",
                 get_mesh_file(), e.what());
             // No longer try to visualize this mesh.
-            cachedMesh.reset();
+            meshFilePath.clear();
             return;
         }
+    }
+    if (cachedMesh.get() != nullptr) {
         cachedMesh->setScaleFactors(get_scale_factors());
         decoGeoms.push_back(*cachedMesh);
     }
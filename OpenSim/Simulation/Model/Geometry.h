@@ -547,6 +547,13 @@ protected:
 /**
 * A class to represent Mesh geometry that comes from a file.
 * Supported file formats .vtp, .stl, .obj but will grow over time
+*
+* The decoded meshes are cached per process, keyed by the path of the file,
+* so that a file is decoded once no matter how many Meshes (or copies of a
+* Model) use it. When a ModelVisualizer is created, it starts decoding the
+* files of all the Meshes of the Model on background threads, while the
+* visualizer window starts. Meshes are not loaded at all if visualization is
+* disabled in the Model's ModelDisplayHints.
 */
 class OSIMSIMULATION_API Mesh : public Geometry
 {
@@ -589,6 +596,14 @@ protected:
     void implementCreateDecorativeGeometry(
         SimTK::Array_<SimTK::DecorativeGeometry>& decoGeoms) const override;
 private:
+    // Start decoding the mesh file on a background thread, if it is not
+    // already decoded or being decoded (see ModelVisualizer).
+    void startLoadingMeshFile() const;
+    friend class ModelVisualizer;
+
+    // The path of the mesh file found in extendFinalizeFromProperties(), or
+    // empty if there is no mesh to display (or it could not be loaded).
+    mutable std::string meshFilePath;
     // We cache the DecorativeMeshFile if we successfully
     // load the mesh from file so we don't try loading from disk every frame.
     // This is mutable since it is not part of the public interface.
@@ -32,6 +32,13 @@
 
 #include <OpenSim/Common/Assertion.h>
 #include <OpenSim/Simulation/Wrap/PathWrap.h>
+#include <OpenSim/Simulation/Wrap/WrapDoubleCylinderObst.h>
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <typeinfo>
+#include <unordered_map>
 
 //=============================================================================
 // STATICS
@@ -128,6 +135,155 @@ static void PopulatePathElementLookup(
     }
 }
 
+class OpenSim::GeometryPath::Surrogate {
+public:
+    // An exact evaluation of the path, from which the length and its
+    // gradient are extrapolated to the rest of the cell of the grid that
+    // contains it, and the errors of the extrapolation estimated from other
+    // exact evaluations in the cell.
+    struct Sample {
+        SimTK::Vector q;    // the coordinates of the grid
+        double length;
+        SimTK::Vector dLdq;
+        int numChecks = 0;
+        double lengthError = 0;
+        double dLdqError = 0;
+    };
+
+    // The number of exact evaluations that must confirm the errors of a
+    // sample before it is used.
+    static const int minChecks = 3;
+
+    struct KeyHash {
+        std::size_t operator()(const std::vector<int>& key) const {
+            std::size_t hash = 0;
+            for (int k : key) hash = hash * 1000003u ^ std::hash<int>()(k);
+            return hash;
+        }
+    };
+
+    // Find the coordinates of the grid, in a state realized to
+    // Stage::Position.
+    void initialize(const GeometryPath& path, const SimTK::State& s);
+
+    // Update the estimated errors of the sample from an exact evaluation at
+    // another posture in its cell. Evaluations close to the sample are not
+    // used, since the errors there say little about the rest of the cell.
+    static void check(Sample& sample, const Sample& exact, double resolution)
+    {
+        double offset = 0;
+        double change = 0;
+        for (int i = 0; i < exact.q.size(); ++i) {
+            const double dq = exact.q[i] - sample.q[i];
+            offset = std::max(offset, std::abs(dq));
+            change += sample.dLdq[i] * dq;
+        }
+        if (offset < 0.25 * resolution) return;
+        // The error in the length grows quadratically with the offset and
+        // that in the gradient linearly; scale both to the size of a cell.
+        const double scale = resolution / offset;
+        sample.lengthError = std::max(sample.lengthError,
+                std::abs(exact.length - sample.length - change) *
+                        scale * scale);
+        sample.dLdqError = std::max(sample.dLdqError,
+                (exact.dLdq - sample.dLdq).normInf() * scale);
+        ++sample.numChecks;
+    }
+
+    std::mutex mutex;
+    bool initialized = false;
+    bool usable = false;
+    std::vector<SimTK::QIndex> qIndices;
+    std::unordered_map<std::vector<int>, Sample, KeyHash> cells;
+};
+
+void GeometryPath::Surrogate::initialize(const GeometryPath& path,
+        const SimTK::State& s)
+{
+    initialized = true;
+    const SimTK::SimbodyMatterSubsystem& matter =
+            path.getModel().getMatterSubsystem();
+
+    // The bodies that the path points and wrap objects are on, and the
+    // coordinates that the moving and conditional path points depend on.
+    std::vector<SimTK::MobilizedBodyIndex> bodies;
+    std::vector<const Coordinate*> coordinates;
+    const PathPointSet& pps = path.get_PathPointSet();
+    for (int i = 0; i < pps.getSize(); ++i) {
+        const AbstractPathPoint& point = pps[i];
+        if (typeid(point) == typeid(ConditionalPathPoint)) {
+            const auto& conditional =
+                    static_cast<const ConditionalPathPoint&>(point);
+            if (conditional.hasCoordinate())
+                coordinates.push_back(&conditional.getCoordinate());
+        } else if (typeid(point) == typeid(MovingPathPoint)) {
+            const auto& moving = static_cast<const MovingPathPoint&>(point);
+            if (moving.hasXCoordinate())
+                coordinates.push_back(&moving.getXCoordinate());
+            if (moving.hasYCoordinate())
+                coordinates.push_back(&moving.getYCoordinate());
+            if (moving.hasZCoordinate())
+                coordinates.push_back(&moving.getZCoordinate());
+        } else if (typeid(point) != typeid(PathPoint)) {
+            // The location of the point may depend on anything.
+            return;
+        }
+        bodies.push_back(point.getParentFrame().getMobilizedBodyIndex());
+    }
+    const PathWrapSet& pws = path.get_PathWrapSet();
+    for (int i = 0; i < pws.getSize(); ++i) {
+        const WrapObject* wrapObject = pws[i].getWrapObject();
+        if (!wrapObject) continue;
+        bodies.push_back(wrapObject->getFrame().getMobilizedBodyIndex());
+        if (const auto* doubleCylinder =
+                dynamic_cast<const WrapDoubleCylinderObst*>(wrapObject)) {
+            bodies.push_back(path.getModel().getBodySet().get(
+                    doubleCylinder->get_wrapVcylHomeBodyName())
+                            .getMobilizedBodyIndex());
+        }
+    }
+
+    // The path only depends on the joints between its bodies and their
+    // nearest common ancestor, since moving the ancestor moves the whole
+    // path rigidly.
+    const auto parent = [&](SimTK::MobilizedBodyIndex body) {
+        return matter.getMobilizedBody(body).getParentMobilizedBody()
+                .getMobilizedBodyIndex();
+    };
+    const auto level = [&](SimTK::MobilizedBodyIndex body) {
+        return matter.getMobilizedBody(body).getLevelInMultibodyTree();
+    };
+    SimTK::MobilizedBodyIndex ancestor = bodies.front();
+    for (SimTK::MobilizedBodyIndex body : bodies) {
+        while (body != ancestor) {
+            if (level(body) >= level(ancestor)) body = parent(body);
+            else ancestor = parent(ancestor);
+        }
+    }
+    std::vector<SimTK::MobilizedBodyIndex> joints;
+    for (SimTK::MobilizedBodyIndex body : bodies) {
+        for (; body != ancestor; body = parent(body)) joints.push_back(body);
+    }
+    for (const Coordinate* coordinate : coordinates) {
+        const SimTK::MobilizedBody& mobod =
+                matter.getMobilizedBody(coordinate->getBodyIndex());
+        if (mobod.getNumQ(s) != mobod.getNumU(s)) return;
+        qIndices.push_back(SimTK::QIndex(mobod.getFirstQIndex(s) +
+                coordinate->getMobilizerQIndex()));
+    }
+    for (SimTK::MobilizedBodyIndex body : joints) {
+        const SimTK::MobilizedBody& mobod = matter.getMobilizedBody(body);
+        if (mobod.getNumQ(s) != mobod.getNumU(s)) return;
+        for (int i = 0; i < mobod.getNumQ(s); ++i) {
+            qIndices.push_back(SimTK::QIndex(mobod.getFirstQIndex(s) + i));
+        }
+    }
+    std::sort(qIndices.begin(), qIndices.end());
+    qIndices.erase(std::unique(qIndices.begin(), qIndices.end()),
+            qIndices.end());
+    usable = true;
+}
+
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //=============================================================================
@@ -157,6 +313,15 @@ void GeometryPath::extendFinalizeFromProperties()
             upd_PathWrapSet()[i].setName(label.str());
         }
     }
+
+    OPENSIM_THROW_IF_FRMOBJ(get_surrogate_tolerance() < 0,
+            InvalidPropertyValue,
+            getProperty_surrogate_tolerance().getName(),
+            "Expected a non-negative value.");
+    OPENSIM_THROW_IF_FRMOBJ(get_surrogate_resolution() <= 0,
+            InvalidPropertyValue,
+            getProperty_surrogate_resolution().getName(),
+            "Expected a positive value.");
 }
 
 void GeometryPath::extendConnectToModel(Model& aModel)
@@ -191,6 +356,17 @@ void GeometryPath::extendConnectToModel(Model& aModel)
     // Cache the set of points currently defining this path.
     this->_currentPathCV = addCacheVariable("current_path", std::vector<PathElementLookup>{}, SimTK::Stage::Position);
 
+    // Cache the generalized forces due to a unit tension, from which the
+    // moment arms about all the coordinates are computed, and whether
+    // constraints couple the coordinates (which depends on which constraints
+    // are enabled and which coordinates are prescribed).
+    this->_unitTensionForcesCV = addCacheVariable("unit_tension_forces",
+            SimTK::Vector(), SimTK::Stage::Position);
+    this->_coupledCoordinatesCV = addCacheVariable("coupled_coordinates",
+            true, SimTK::Stage::Instance);
+    this->_surrogateUsedCV = addCacheVariable("surrogate_used", false,
+            SimTK::Stage::Position);
+
     // We consider this cache entry valid any time after it has been created
     // and first marked valid, and we won't ever invalidate it.
     this->_colorCV = addCacheVariable("color", get_Appearance().get_color(), SimTK::Stage::Topology);
@@ -202,6 +378,66 @@ void GeometryPath::extendConnectToModel(Model& aModel)
     markCacheVariableValid(s, _colorCV);  // it is OK at its default value
 }
 
+void GeometryPath::extendRealizeTopology(SimTK::State& s) const
+{
+    Super::extendRealizeTopology(s);
+
+    // The MobilizedBodies of all the frames are known now.
+    const PathPointSet& pps = get_PathPointSet();
+    _fixedPathPoints.clear();
+    _pathPointKinds.assign(pps.getSize(), 0);
+    for (int i = 0; i < pps.getSize(); ++i) {
+        // Classes derived from PathPoint (other than ConditionalPathPoint)
+        // may compute their locations differently.
+        const auto* point = dynamic_cast<const PathPoint*>(&pps[i]);
+        if (!point) continue;
+        const bool conditional =
+                typeid(*point) == typeid(ConditionalPathPoint);
+        if (typeid(*point) != typeid(PathPoint) && !conditional) continue;
+
+        const PhysicalFrame& frame = point->getParentFrame();
+        const auto& base =
+                dynamic_cast<const PhysicalFrame&>(frame.findBaseFrame());
+        FixedPathPoint fixed;
+        fixed.point = point;
+        fixed.body = base.getMobilizedBodyIndex();
+        fixed.hasOffset = &base != &frame;
+        if (fixed.hasOffset) fixed.X_BF = frame.findTransformInBaseFrame();
+        _fixedPathPoints.push_back(fixed);
+        _pathPointKinds[i] = conditional ? 2 : 1;
+    }
+    std::stable_sort(_fixedPathPoints.begin(), _fixedPathPoints.end(),
+            [](const FixedPathPoint& a, const FixedPathPoint& b) {
+                return a.body < b.body;
+            });
+
+    // The exact evaluations of a previous system are not valid anymore.
+    if (get_surrogate_tolerance() > 0) _surrogate.reset(new Surrogate());
+    else _surrogate.reset();
+}
+
+void GeometryPath::calcFixedPathPointLocations(const SimTK::State& s) const
+{
+    const SimTK::SimbodyMatterSubsystem& matter =
+            getModel().getMatterSubsystem();
+    SimTK::MobilizedBodyIndex body;
+    const Transform* X_GB = nullptr;
+    for (const auto& fixed : _fixedPathPoints) {
+        if (fixed.body != body) {
+            body = fixed.body;
+            X_GB = &matter.getMobilizedBody(body).getBodyTransform(s);
+        }
+        // The location is read from the property on each evaluation, since
+        // it may be edited without initializing the system again. The
+        // transforms are composed as in Station and OffsetFrame, so that the
+        // results are identical.
+        const Vec3& location = fixed.point->getStation().get_location();
+        fixed.point->setLocationInGroundCache(s, fixed.hasOffset
+                ? (*X_GB * fixed.X_BF) * location
+                : *X_GB * location);
+    }
+}
+
 //------------------------------------------------------------------------------
 //                         GENERATE DECORATIONS
 //------------------------------------------------------------------------------
@@ -220,11 +456,14 @@ generateDecorations(bool fixed, const ModelDisplayHints& hints,
     // There is no fixed geometry to generate here.
     if (fixed) { return; }
 
-    const Array<AbstractPathPoint*>& pathPoints = getCurrentPath(state);
+    const std::vector<PathElementLookup>& pathPoints =
+            getCurrentPathLookups(state);
+    const PathPointSet& pps = get_PathPointSet();
+    const PathWrapSet& pws = get_PathWrapSet();
 
     OPENSIM_ASSERT_FRMOBJ(pathPoints.size() > 1);
 
-    const AbstractPathPoint* lastPoint = pathPoints[0];
+    const AbstractPathPoint* lastPoint = pathPoints[0].toPtr(pps, pws);
     MobilizedBodyIndex mbix(0);
 
     Vec3 lastPos = lastPoint->getLocationInGround(state);
@@ -233,8 +472,8 @@ generateDecorations(bool fixed, const ModelDisplayHints& hints,
 
     Vec3 pos;
 
-    for (int i = 1; i < pathPoints.getSize(); ++i) {
-        AbstractPathPoint* point = pathPoints[i];
+    for (int i = 1; i < (int)pathPoints.size(); ++i) {
+        AbstractPathPoint* point = pathPoints[i].toPtr(pps, pws);
         PathWrapPoint* pwp = dynamic_cast<PathWrapPoint*>(point);
 
         if (pwp) {
@@ -281,6 +520,10 @@ void GeometryPath::constructProperties()
     constructProperty_PathPointSet(PathPointSet());
 
     constructProperty_PathWrapSet(PathWrapSet());
+
+    constructProperty_surrogate_tolerance(0.0);
+    constructProperty_surrogate_resolution(0.01);
+    constructProperty_apply_tension_as_generalized_forces(false);
 }
 
 //_____________________________________________________________________________
@@ -313,10 +556,22 @@ void GeometryPath::namePathPoints(int aStartingIndex)
 const OpenSim::Array <AbstractPathPoint*> & GeometryPath::
 getCurrentPath(const SimTK::State& s)  const
 {
-    computePath(s);   // compute checks if path needs to be recomputed
+    // the pointers array is shared by all states, so it is re-populated from
+    // the path in the given state on every call
+    PopulatePathPointersCache(get_PathPointSet(),
+                              get_PathWrapSet(),
+                              getCurrentPathLookups(s),
+                              _currentPathPtrsCache);
     return _currentPathPtrsCache;
 }
 
+const std::vector<GeometryPath::PathElementLookup>& GeometryPath::
+getCurrentPathLookups(const SimTK::State& s) const
+{
+    computePath(s);   // compute checks if path needs to be recomputed
+    return getCacheVariableValue(s, _currentPathCV);
+}
+
 // get the path as PointForceDirections directions 
 // CAUTION: the return points are heap allocated; you must delete them yourself! 
 // (TODO: that is really lame)
@@ -329,21 +584,25 @@ getPointForceDirections(const SimTK::State& s,
     AbstractPathPoint* end;
     const OpenSim::PhysicalFrame* startBody;
     const OpenSim::PhysicalFrame* endBody;
-    const Array<AbstractPathPoint*>& currentPath = getCurrentPath(s);
+    const std::vector<PathElementLookup>& currentPath =
+            getCurrentPathLookups(s);
+    const PathPointSet& pps = get_PathPointSet();
+    const PathWrapSet& pws = get_PathWrapSet();
 
-    int np = currentPath.getSize();
+    int np = (int)currentPath.size();
     rPFDs->ensureCapacity(np);
     
     for (i = 0; i < np; i++) {
+        const AbstractPathPoint* point = currentPath[i].toPtr(pps, pws);
         PointForceDirection *pfd = 
-            new PointForceDirection(currentPath[i]->getLocation(s), 
-                                    currentPath[i]->getParentFrame(), Vec3(0));
+            new PointForceDirection(point->getLocation(s), 
+                                    point->getParentFrame(), Vec3(0));
         rPFDs->append(pfd);
     }
 
     for (i = 0; i < np-1; i++) {
-        start = currentPath[i];
-        end = currentPath[i+1];
+        start = currentPath[i].toPtr(pps, pws);
+        end = currentPath[i+1].toPtr(pps, pws);
         startBody = &start->getParentFrame();
         endBody = &end->getParentFrame();
 
@@ -387,17 +646,73 @@ void GeometryPath::addInEquivalentForces(const SimTK::State& s,
     const double& tension, 
     SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
     SimTK::Vector& mobilityForces) const
+{
+    if (useSurrogate(s)) {
+        mobilityForces +=
+                tension * getCacheVariableValue(s, _unitTensionForcesCV);
+        return;
+    }
+    if (get_apply_tension_as_generalized_forces()) {
+        mobilityForces += tension * getGeneralizedForcesDueToUnitTension(s);
+        return;
+    }
+    addInEquivalentBodyForces(s, tension, bodyForces, mobilityForces);
+}
+
+void GeometryPath::addInEquivalentBodyForces(const SimTK::State& s,
+    double tension,
+    SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+    SimTK::Vector& mobilityForces) const
 {
     AbstractPathPoint* start = NULL;
     AbstractPathPoint* end = NULL;
     const SimTK::MobilizedBody* bo = NULL;
     const SimTK::MobilizedBody* bf = NULL;
-    const Array<AbstractPathPoint*>& currentPath = getCurrentPath(s);
-    int np = currentPath.getSize();
+    const std::vector<PathElementLookup>& currentPath =
+            getCurrentPathLookups(s);
+    const PathPointSet& pps = get_PathPointSet();
+    const PathWrapSet& pws = get_PathWrapSet();
+    int np = (int)currentPath.size();
 
     const SimTK::SimbodyMatterSubsystem& matter = 
                                         getModel().getMatterSubsystem();
 
+    // The point forces are summed for each body (as the resultant force and
+    // its moment about the ground origin, both in ground) and added to
+    // bodyForces once per body. A path spans few bodies; if there are more
+    // than fit, the sums are flushed to bodyForces.
+    struct BodyForce {
+        const SimTK::MobilizedBody* body;
+        Vec3 moment;
+        Vec3 force;
+    };
+    static const int maxNumBodyForces = 16;
+    BodyForce sums[maxNumBodyForces];
+    int numSums = 0;
+    const auto flush = [&]() {
+        for (int j = 0; j < numSums; ++j) {
+            const Vec3& p_GB = sums[j].body->getBodyOriginLocation(s);
+            bodyForces[sums[j].body->getMobilizedBodyIndex()] +=
+                    SimTK::SpatialVec(sums[j].moment - p_GB % sums[j].force,
+                            sums[j].force);
+        }
+        numSums = 0;
+    };
+    const auto addInPointForce = [&](const SimTK::MobilizedBody* body,
+            const Vec3& point, const Vec3& pointForce) {
+        int j = 0;
+        while (j < numSums && sums[j].body != body) ++j;
+        if (j == numSums) {
+            if (numSums == maxNumBodyForces) flush();
+            j = numSums++;
+            sums[j].body = body;
+            sums[j].moment = Vec3(0);
+            sums[j].force = Vec3(0);
+        }
+        sums[j].moment += point % pointForce;
+        sums[j].force += pointForce;
+    };
+
     // start point, end point,  direction, and force vectors in ground
     Vec3 po(0), pf(0), dir(0), force(0);
     // partial velocity of point in body expressed in ground 
@@ -407,8 +722,8 @@ void GeometryPath::addInEquivalentForces(const SimTK::State& s,
     double fo, ff;
 
     for (int i = 0; i < np-1; ++i) {
-        start = currentPath[i];
-        end = currentPath[i+1];
+        start = currentPath[i].toPtr(pps, pws);
+        end = currentPath[i+1].toPtr(pps, pws);
 
         bo = &start->getParentFrame().getMobilizedBody();
         bf = &end->getParentFrame().getMobilizedBody();
@@ -435,6 +750,10 @@ void GeometryPath::addInEquivalentForces(const SimTK::State& s,
 
             force = tension*dir;
 
+            // add in the tension point forces to body forces
+            addInPointForce(bo, po, force);
+            addInPointForce(bf, pf, -force);
+
             const MovingPathPoint* mppo =
                 dynamic_cast<MovingPathPoint *>(start);
 
@@ -442,33 +761,6 @@ void GeometryPath::addInEquivalentForces(const SimTK::State& s,
             const MovingPathPoint* mppf =
                 dynamic_cast<MovingPathPoint *>(end);
 
-            // add in the tension point forces to body forces
-            if (mppo) {// moving path point location is a function of the state
-                // transform of the frame of the point to the base mobilized body
-                auto X_BF = mppo->getParentFrame().findTransformInBaseFrame();
-                bo->applyForceToBodyPoint(s, X_BF*mppo->getLocation(s), force,
-                    bodyForces);
-            }
-            else {
-                // transform of the frame of the point to the base mobilized body
-                auto X_BF = start->getParentFrame().findTransformInBaseFrame();
-                bo->applyForceToBodyPoint(s, X_BF*start->getLocation(s), force,
-                    bodyForces);
-            }
-
-            if (mppf) {// moving path point location is a function of the state
-                // transform of the frame of the point to the base mobilized body
-                auto X_BF = mppf->getParentFrame().findTransformInBaseFrame();
-                bf->applyForceToBodyPoint(s, X_BF*mppf->getLocation(s), -force,
-                    bodyForces);
-            }
-            else {
-                // transform of the frame of the point to the base mobilized body
-                auto X_BF = end->getParentFrame().findTransformInBaseFrame();
-                bf->applyForceToBodyPoint(s, X_BF*end->getLocation(s), -force,
-                    bodyForces);
-            }
-
             // Now account for the work being done by virtue of the moving
             // path point motion relative to the body it is on
             if(mppo){
@@ -501,6 +793,7 @@ void GeometryPath::addInEquivalentForces(const SimTK::State& s,
             }
         }       
     }
+    flush();
 }
 
 //_____________________________________________________________________________
@@ -531,7 +824,8 @@ void GeometryPath::updateGeometry(const SimTK::State& s) const
  */
 double GeometryPath::getLength( const SimTK::State& s) const
 {
-    computePath(s);  // compute checks if path needs to be recomputed
+    // compute checks if path needs to be recomputed
+    if (!useSurrogate(s)) computePath(s);
     return getCacheVariableValue(s, _lengthCV);
 }
 
@@ -890,31 +1184,43 @@ extendPostScale(const SimTK::State& s, const ScaleSet& scaleSet)
 void GeometryPath::computePath(const SimTK::State& s) const
 {
     if (isCacheVariableValid(s, _currentPathCV)) {
-        // even though the cache variable is valid, re-populate the pointers cache
-        //
-        // this is because although it may be valid *in the state* the
-        // model-level pointers cache may be dirty with lookups from other
-        // states
-        PopulatePathPointersCache(get_PathPointSet(),
-                                  get_PathWrapSet(),
-                                  getCacheVariableValue(s, _currentPathCV),
-                                  _currentPathPtrsCache);
         return;
     }
 
-    // Clear the current path.
-    _currentPathPtrsCache.setSize(0);
+    ComponentProfiler::Scope scope(*this,
+            ComponentProfiler::Hook::ComputeCacheVariable);
+
+    // The path is computed in a local array (rather than in the pointers
+    // array of getCurrentPath(), which is shared by all the states), so that
+    // the paths of different states can be computed concurrently.
+    Array<AbstractPathPoint*> currentPath(nullptr, 0,
+            get_PathPointSet().getSize() + 2 * get_PathWrapSet().getSize());
+
+    // Compute the locations of the PathPoints body by body, rather than
+    // through the caches of each point, its Station, and its frame.
+    const PathPointSet& pps = get_PathPointSet();
+    const bool useFixedPathPoints = (int)_pathPointKinds.size() ==
+            pps.getSize();
+    if (useFixedPathPoints) calcFixedPathPointLocations(s);
 
     // Add the active fixed and moving via points to the path.
-    for (int i = 0; i < get_PathPointSet().getSize(); i++) {
-        if (get_PathPointSet()[i].isActive(s))
-            _currentPathPtrsCache.append(&get_PathPointSet()[i]); // <--- !!!!BAD
+    for (int i = 0; i < pps.getSize(); i++) {
+        bool active;
+        if (useFixedPathPoints && _pathPointKinds[i] == 1) {
+            active = true;
+        } else if (useFixedPathPoints && _pathPointKinds[i] == 2) {
+            active = static_cast<const ConditionalPathPoint&>(pps[i])
+                    .ConditionalPathPoint::isActive(s);
+        } else {
+            active = pps[i].isActive(s);
+        }
+        if (active) currentPath.append(&pps[i]);
     }
   
     // Use the current path so far to check for intersection with wrap objects, 
     // which may add additional points to the path.
-    applyWrapObjects(s, _currentPathPtrsCache);
-    calcLengthAfterPathComputation(s, _currentPathPtrsCache);
+    applyWrapObjects(s, currentPath);
+    calcLengthAfterPathComputation(s, currentPath);
 
     // the pointers array now contains the "correct" (wrapped) path
     //
@@ -928,7 +1234,7 @@ void GeometryPath::computePath(const SimTK::State& s) const
     std::vector<PathElementLookup>& lookups = updCacheVariableValue(s, _currentPathCV);
     PopulatePathElementLookup(get_PathPointSet(),
                               get_PathWrapSet(),
-                              _currentPathPtrsCache,
+                              currentPath,
                               *this,
                               lookups);
     markCacheVariableValid(s, _currentPathCV);
@@ -944,12 +1250,24 @@ void GeometryPath::computeLengtheningSpeed(const SimTK::State& s) const
         return;
     }
 
-    const Array<AbstractPathPoint*>& currentPath = getCurrentPath(s);
+    // The power of a unit tension, f*u, is the shortening speed.
+    if (useSurrogate(s)) {
+        const SimTK::Vector& forces =
+                getCacheVariableValue(s, _unitTensionForcesCV);
+        setLengtheningSpeed(s, -(~forces * s.getU()));
+        return;
+    }
+
+    const std::vector<PathElementLookup>& currentPath =
+            getCurrentPathLookups(s);
+    const PathPointSet& pps = get_PathPointSet();
+    const PathWrapSet& pws = get_PathWrapSet();
 
     double speed = 0.0;
     
-    for (int i = 0; i < currentPath.getSize() - 1; i++) {
-        speed += currentPath[i]->calcSpeedBetween(s, *currentPath[i+1]);
+    for (int i = 0; i < (int)currentPath.size() - 1; i++) {
+        speed += currentPath[i].toPtr(pps, pws)->calcSpeedBetween(s,
+                *currentPath[i+1].toPtr(pps, pws));
     }
 
     setLengtheningSpeed(s, speed);
@@ -1248,12 +1566,143 @@ calcLengthAfterPathComputation(const SimTK::State& s,
 double GeometryPath::
 computeMomentArm(const SimTK::State& s, const Coordinate& aCoord) const
 {
+    // The moment arm r = -dL/dq is the generalized force due to a unit
+    // tension. Unless constraints couple the speed of the coordinate to those
+    // of other coordinates (which the MomentArmSolver accounts for), it is
+    // the generalized force on the mobility of the coordinate.
+    if (s.getSystemStage() >= SimTK::Stage::Position &&
+            !hasCoupledCoordinates(s)) {
+        const SimTK::MobilizedBody& mobod = getModel().getMatterSubsystem()
+                .getMobilizedBody(aCoord.getBodyIndex());
+        return getGeneralizedForcesDueToUnitTension(s)[
+                int(mobod.getFirstUIndex(s)) + aCoord.getMobilizerQIndex()];
+    }
+
     if (!_maSolver)
         const_cast<Self*>(this)->_maSolver.reset(new MomentArmSolver(*_model));
 
     return _maSolver->solve(s, aCoord,  *this);
 }
 
+const SimTK::Vector& GeometryPath::
+getGeneralizedForcesDueToUnitTension(const SimTK::State& s) const
+{
+    if (isCacheVariableValid(s, _unitTensionForcesCV) || useSurrogate(s)) {
+        return getCacheVariableValue(s, _unitTensionForcesCV);
+    }
+
+    const SimTK::SimbodyMatterSubsystem& matter =
+            getModel().getMatterSubsystem();
+    SimTK::Vector_<SimTK::SpatialVec> bodyForces(matter.getNumBodies(),
+            SimTK::SpatialVec(Vec3(0), Vec3(0)));
+    SimTK::Vector mobilityForces(s.getNU(), 0.0);
+    addInEquivalentBodyForces(s, 1.0, bodyForces, mobilityForces);
+
+    // f = ~J(q) * F, as in the MomentArmSolver.
+    SimTK::Vector& forces = updCacheVariableValue(s, _unitTensionForcesCV);
+    matter.multiplyBySystemJacobianTranspose(s, bodyForces, forces);
+    forces += mobilityForces;
+    markCacheVariableValid(s, _unitTensionForcesCV);
+    return forces;
+}
+
+bool GeometryPath::hasCoupledCoordinates(const SimTK::State& s) const
+{
+    if (isCacheVariableValid(s, _coupledCoordinatesCV)) {
+        return getCacheVariableValue(s, _coupledCoordinatesCV);
+    }
+
+    // Locked coordinates are enabled constraints as well.
+    const SimTK::SimbodyMatterSubsystem& matter =
+            getModel().getMatterSubsystem();
+    bool coupled = false;
+    for (SimTK::ConstraintIndex ix(0);
+            ix < matter.getNumConstraints() && !coupled; ++ix) {
+        coupled = !matter.getConstraint(ix).isDisabled(s);
+    }
+    const CoordinateSet& coordinates = getModel().getCoordinateSet();
+    for (int i = 0; i < coordinates.getSize() && !coupled; ++i) {
+        coupled = coordinates[i].isPrescribed(s);
+    }
+    setCacheVariableValue(s, _coupledCoordinatesCV, coupled);
+    return coupled;
+}
+
+bool GeometryPath::useSurrogate(const SimTK::State& s) const
+{
+    if (!_surrogate || s.getSystemStage() < SimTK::Stage::Position) {
+        return false;
+    }
+    if (isCacheVariableValid(s, _surrogateUsedCV)) {
+        return getCacheVariableValue(s, _surrogateUsedCV);
+    }
+    // The exact path computed below uses the queries of the path themselves.
+    setCacheVariableValue(s, _surrogateUsedCV, false);
+    // With coupled coordinates, the moment arms are not the gradient of the
+    // length.
+    if (hasCoupledCoordinates(s)) return false;
+
+    Surrogate& surrogate = *_surrogate;
+    const SimTK::SimbodyMatterSubsystem& matter =
+            getModel().getMatterSubsystem();
+    const double resolution = get_surrogate_resolution();
+    std::unique_lock<std::mutex> lock(surrogate.mutex);
+    if (!surrogate.initialized) surrogate.initialize(*this, s);
+    if (!surrogate.usable) return false;
+
+    const int n = (int)surrogate.qIndices.size();
+    Surrogate::Sample exact;
+    exact.q.resize(n);
+    std::vector<int> key(n);
+    for (int i = 0; i < n; ++i) {
+        exact.q[i] = s.getQ()[surrogate.qIndices[i]];
+        key[i] = (int)std::floor(exact.q[i] / resolution);
+    }
+    auto cell = surrogate.cells.find(key);
+    if (cell != surrogate.cells.end() &&
+            cell->second.numChecks >= Surrogate::minChecks &&
+            cell->second.lengthError <= get_surrogate_tolerance() &&
+            cell->second.dLdqError <= get_surrogate_tolerance()) {
+        const Surrogate::Sample& sample = cell->second;
+        double length = sample.length;
+        SimTK::Vector dLdq(s.getNQ(), 0.0);
+        for (int i = 0; i < n; ++i) {
+            length += sample.dLdq[i] * (exact.q[i] - sample.q[i]);
+            dLdq[surrogate.qIndices[i]] = sample.dLdq[i];
+        }
+        lock.unlock();
+
+        // f = -~N * dL/dq, since f*u = -dL/dt = -(dL/dq)*N*u.
+        SimTK::Vector& forces = updCacheVariableValue(s, _unitTensionForcesCV);
+        matter.multiplyByN(s, true, dLdq, forces);
+        forces *= -1.0;
+        markCacheVariableValid(s, _unitTensionForcesCV);
+        setLength(s, length);
+        setCacheVariableValue(s, _surrogateUsedCV, true);
+        return true;
+    }
+    lock.unlock();
+
+    // Compute the path exactly (without holding the lock), and use the
+    // result to create or check the sample of the cell.
+    computePath(s);
+    exact.length = getCacheVariableValue(s, _lengthCV);
+    SimTK::Vector dLdq;
+    matter.multiplyByNInv(s, true, getGeneralizedForcesDueToUnitTension(s),
+            dLdq);
+    exact.dLdq.resize(n);
+    for (int i = 0; i < n; ++i) {
+        exact.dLdq[i] = -dLdq[surrogate.qIndices[i]];
+    }
+
+    lock.lock();
+    auto inserted = surrogate.cells.insert({key, exact});
+    if (!inserted.second) {
+        Surrogate::check(inserted.first->second, exact, resolution);
+    }
+    return false;
+}
+
 //_____________________________________________________________________________
 // Override default implementation by object to intercept and fix the XML node
 // underneath the model to match current version.
@@ -30,6 +30,7 @@
 #include <OpenSim/Simulation/Wrap/PathWrapSet.h>
 #include <OpenSim/Simulation/MomentArmSolver.h>
 
+#include <memory>
 
 #ifdef SWIG
     #ifdef OSIMSIMULATION_API
@@ -41,6 +42,7 @@
 namespace OpenSim {
 
 class Coordinate;
+class PathPoint;
 class PointForceDirection;
 class ScaleSet;
 class WrapResult;
@@ -52,6 +54,21 @@ class WrapObject;
  * A concrete class representing a path (muscle, ligament, etc.) based on 
  * geometry objects in the model (e.g., PathPoints and PathWraps).
  *
+ * For simulations that visit the same postures many times, the path can
+ * answer queries from a surrogate that is built as the postures are visited
+ * (see the surrogate_tolerance property). The coordinates are divided into a
+ * grid of cells of size surrogate_resolution, and the first exact evaluation
+ * of the path in a cell (its length L and the gradient dL/dq) is extrapolated
+ * linearly to the rest of the cell. Further exact evaluations in the cell
+ * estimate the error of the extrapolation, and the cell answers queries once
+ * three of them have confirmed that the errors in the length and in the
+ * moment arms are below the tolerance. Only the coordinates of the joints
+ * between the bodies of the path (and those of its moving and conditional
+ * path points) form the grid. The surrogate is not used if constraints couple
+ * the coordinates, if a joint on the path uses quaternions, or if the path
+ * has custom types of path points. getCurrentPath(), getPointForceDirections()
+ * and the visualization of the path always use the exact path.
+ *
  * @author Peter Loan
  */
 class OSIMSIMULATION_API GeometryPath : public AbstractPath {
@@ -67,13 +84,35 @@ private:
     OpenSim_DECLARE_UNNAMED_PROPERTY(PathWrapSet,
         "The wrap objects that are associated with this path");
 
+public:
+    OpenSim_DECLARE_PROPERTY(surrogate_tolerance, double,
+        "If positive, the length and moment arms of the path (and the "
+        "lengthening speed and generalized forces that follow from them) are "
+        "extrapolated from an exact evaluation at a nearby posture whenever "
+        "the estimated errors in the length and in each moment arm are below "
+        "this tolerance, and the path is computed exactly otherwise. "
+        "Default is 0 (the path is always computed exactly).");
+    OpenSim_DECLARE_PROPERTY(surrogate_resolution, double,
+        "The size of the cells (in the units of the coordinates) of the "
+        "grid over the coordinates that the path depends on, within which "
+        "the surrogate extrapolates from one exact evaluation of the path "
+        "(see surrogate_tolerance). Default is 0.01.");
+    OpenSim_DECLARE_PROPERTY(apply_tension_as_generalized_forces, bool,
+        "If true, the tension is applied as the generalized forces that "
+        "follow from the moment arms of the path (computed once per posture), "
+        "instead of as forces on the bodies along the path. The motion is the "
+        "same, but the path adds no forces to the bodies (e.g., to the "
+        "reaction forces of the joints). Default is false.");
+private:
+
     // Solver used to compute moment-arms. The GeometryPath owns this object,
     // but we cannot simply use a unique_ptr because we want the pointer to be
     // cleared on copy.
     SimTK::ResetOnCopy<std::unique_ptr<MomentArmSolver> > _maSolver;
 
-    // populated from the current path cache variable whenever the implementation
-    // needs an array of `AbstractPathPoint`s
+    // populated from the current path cache variable by getCurrentPath(); the
+    // implementation uses the cache variable directly, since this array is
+    // shared by all states
     mutable SimTK::ResetOnCopy<Array<AbstractPathPoint*>> _currentPathPtrsCache;
 
     mutable CacheVariable<double> _lengthCV;
@@ -83,6 +122,35 @@ public:
 private:
     mutable CacheVariable<std::vector<PathElementLookup>> _currentPathCV;
     mutable CacheVariable<SimTK::Vec3> _colorCV;
+    mutable CacheVariable<SimTK::Vector> _unitTensionForcesCV;
+    mutable CacheVariable<bool> _coupledCoordinatesCV;
+
+    // Exact evaluations of the path at the postures visited so far, from
+    // which the length and moment arms are extrapolated if
+    // surrogate_tolerance is positive (see useSurrogate()). It is shared by
+    // all the states, and replaced when the topology is realized.
+    class Surrogate;
+    mutable SimTK::ResetOnCopy<std::shared_ptr<Surrogate>> _surrogate;
+    // Whether the length and the generalized forces due to a unit tension in
+    // a state come from the surrogate.
+    mutable CacheVariable<bool> _surrogateUsedCV;
+
+    // The PathPoints of the PathPointSet (including ConditionalPathPoints)
+    // whose locations in Ground computePath() computes itself, ordered by the
+    // MobilizedBody of the base frame of their parent frame, so that the
+    // transform of each body is looked up once. Found when the topology is
+    // realized.
+    struct FixedPathPoint {
+        const PathPoint* point;
+        SimTK::MobilizedBodyIndex body;
+        // The transform of the parent frame in the base frame, if they differ.
+        bool hasOffset;
+        SimTK::Transform X_BF;
+    };
+    mutable std::vector<FixedPathPoint> _fixedPathPoints;
+    // For each point of the PathPointSet: 1 for a PathPoint, 2 for a
+    // ConditionalPathPoint in _fixedPathPoints, and 0 otherwise.
+    mutable std::vector<char> _pathPointKinds;
     
 //=============================================================================
 // METHODS
@@ -164,6 +232,11 @@ public:
     //--------------------------------------------------------------------------
     // COMPUTATIONS
     //--------------------------------------------------------------------------
+    /** The moment arm of the path about a coordinate, r = -dL/dq, from the
+    generalized forces due to a unit tension in the path, which are computed
+    once per state (realized to Stage::Position) for all the coordinates.
+    If enabled constraints or prescribed coordinates couple the coordinates,
+    a MomentArmSolver accounts for the coupling. */
     double computeMomentArm(const SimTK::State& s,
                             const Coordinate& aCoord) const override;
 
@@ -192,6 +265,7 @@ protected:
     void extendConnectToModel(Model& aModel) override;
     void extendInitStateFromProperties(SimTK::State& s) const override;
     void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+    void extendRealizeTopology(SimTK::State& s) const override;
 
     // Visual support GeometryPath drawing in SimTK visualizer.
     void generateDecorations(
@@ -206,6 +280,30 @@ protected:
 private:
 
     void computePath(const SimTK::State& s ) const;
+    // Compute the locations in Ground of the points in _fixedPathPoints and
+    // store them in the caches of the points.
+    void calcFixedPathPointLocations(const SimTK::State& s) const;
+    // The generalized forces due to a unit tension in the path, computed
+    // once per state for all the coordinates.
+    const SimTK::Vector& getGeneralizedForcesDueToUnitTension(
+            const SimTK::State& s) const;
+    // The point forces of the tension on the bodies along the exact path
+    // (and the generalized forces of its moving path points).
+    void addInEquivalentBodyForces(const SimTK::State& s, double tension,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& mobilityForces) const;
+    // Whether enabled constraints or prescribed coordinates couple the speeds
+    // of the coordinates (so that a moment arm is not just the generalized
+    // force on the mobility of its coordinate).
+    bool hasCoupledCoordinates(const SimTK::State& s) const;
+    // Whether the surrogate provides the length and the generalized forces
+    // due to a unit tension in the given state (in the cache variables of
+    // the path). Otherwise, the path is computed exactly and the result is
+    // added to the surrogate.
+    bool useSurrogate(const SimTK::State& s) const;
+    // The current path in the given state (computed if necessary).
+    const std::vector<PathElementLookup>& getCurrentPathLookups(
+            const SimTK::State& s) const;
     void computeLengtheningSpeed(const SimTK::State& s) const;
     void applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path ) const;
     double calcPathLengthChange(const SimTK::State& s, const WrapObject& wo, 
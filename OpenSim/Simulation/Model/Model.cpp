@@ -43,6 +43,7 @@
 #include <iostream>
 #include <string>
 
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/Logger.h>
@@ -438,6 +439,33 @@ SimTK::State& Model::initializeState() {
     if (!hasSystem()) 
         throw Exception("Model::initializeState(): call buildSystem() first.");
 
+    createWorkingState(nullptr);
+
+    // Do the assembly
+    createAssemblySolver(_workingState);
+    assemble(_workingState);
+    // We can now collect up all the fixed geometry, which needs full configuration.
+    if (getUseVisualizer())
+        _modelViz->collectFixedGeometry(_workingState);
+
+    return _workingState;
+}
+
+SimTK::State& Model::initSystemFrom(const SimTK::State& initialState) {
+    buildSystem();
+
+    createWorkingState(&initialState);
+
+    // The assembly solver refers to the previous System, if any; it is
+    // recreated by assemble() if needed.
+    _assemblySolver.reset();
+    if (getUseVisualizer())
+        _modelViz->collectFixedGeometry(_workingState);
+
+    return _workingState;
+}
+
+void Model::createWorkingState(const SimTK::State* initialState) {
     // This tells Simbody to finalize the System.
     getMultibodySystem().invalidateSystemTopologyCache();
     getMultibodySystem().realizeTopology();
@@ -456,6 +484,22 @@ SimTK::State& Model::initializeState() {
     // Invoke the ModelComponent interface for initializing the state.
     initStateFromProperties(_workingState);
 
+    if (initialState) {
+        OPENSIM_THROW_IF_FRMOBJ(initialState->getNQ() != _workingState.getNQ()
+                        || initialState->getNU() != _workingState.getNU()
+                        || initialState->getNZ() != _workingState.getNZ(),
+                Exception,
+                "Expected the initial state to have {} q's, {} u's, and {} "
+                "z's, but it has {}, {}, and {}.",
+                _workingState.getNQ(), _workingState.getNU(),
+                _workingState.getNZ(), initialState->getNQ(),
+                initialState->getNU(), initialState->getNZ());
+        _workingState.setTime(initialState->getTime());
+        _workingState.updQ() = initialState->getQ();
+        _workingState.updU() = initialState->getU();
+        _workingState.updZ() = initialState->getZ();
+    }
+
     // Realize instance variables that may have been set above. This 
     // means floating point parameters such as mass properties and 
     // geometry placements are frozen.
@@ -468,15 +512,6 @@ SimTK::State& Model::initializeState() {
     // Reset (initialize) all underlying Probe SimTK::Measures
     for (int i=0; i<getProbeSet().getSize(); ++i)
         getProbeSet().get(i).reset(_workingState);
-
-    // Do the assembly
-    createAssemblySolver(_workingState);
-    assemble(_workingState);
-    // We can now collect up all the fixed geometry, which needs full configuration.
-    if (getUseVisualizer())
-        _modelViz->collectFixedGeometry(_workingState);
-
-    return _workingState;
 }
 
 
@@ -500,7 +535,14 @@ const SimTK::State& Model::getWorkingState() const
 
 void Model::assemble(SimTK::State& s, const Coordinate *coord, double weight)
 {
-    
+    std::vector<std::pair<const Coordinate*, double>> weights;
+    if (coord) weights.emplace_back(coord, weight);
+    assembleWithCoordinateWeights(s, weights);
+}
+
+void Model::assembleWithCoordinateWeights(SimTK::State& s,
+        const std::vector<std::pair<const Coordinate*, double>>& weights)
+{
     bool constrained = false;
     const CoordinateSet &coords = getCoordinateSet();
     for(int i=0; i<coords.getSize(); ++i){
@@ -536,8 +578,12 @@ void Model::assemble(SimTK::State& s, const Coordinate *coord, double weight)
         _assemblySolver->updateCoordinateReference(coordName, c.getValue(s));
     }
 
-    if(coord) // use specified weighting for coordinate being set
-        _assemblySolver->updateCoordinateReference(coord->getName(), coord->getValue(s), weight);
+    // use specified weighting for coordinates being set
+    for (const auto& coordWeight : weights) {
+        const Coordinate* coord = coordWeight.first;
+        _assemblySolver->updateCoordinateReference(
+                coord->getName(), coord->getValue(s), coordWeight.second);
+    }
 
 
     try{
@@ -571,6 +617,62 @@ void Model::assemble(SimTK::State& s, const Coordinate *coord, double weight)
 
 }
 
+void Model::setCoordinateValues(SimTK::State& s,
+        const std::vector<std::string>& names, const SimTK::Vector& values,
+        bool enforceConstraints)
+{
+    std::vector<int> indices;
+    indices.reserve(names.size());
+    for (const auto& name : names) {
+        const int index = getCoordinateSet().getIndex(name);
+        OPENSIM_THROW_IF_FRMOBJ(index < 0, Exception,
+                "Coordinate '{}' not found.", name);
+        indices.push_back(index);
+    }
+    setCoordinateValues(s, indices, values, enforceConstraints);
+}
+
+void Model::setCoordinateValues(SimTK::State& s,
+        const std::vector<int>& indices, const SimTK::Vector& values,
+        bool enforceConstraints)
+{
+    OPENSIM_THROW_IF_FRMOBJ((int)indices.size() != values.size(), Exception,
+            "Expected {} values (one per coordinate), but got {}.",
+            indices.size(), values.size());
+    const CoordinateSet& coords = getCoordinateSet();
+    // Set all the values first (as Coordinate::setValue() would, without
+    // enforcing the constraints), so that the model is assembled once.
+    bool constrained = false;
+    for (int i = 0; i < (int)indices.size(); ++i) {
+        OPENSIM_THROW_IF(indices[i] < 0 || indices[i] >= coords.getSize(),
+                IndexOutOfRange, (size_t)indices[i], 0,
+                (size_t)coords.getSize() - 1);
+        const Coordinate& coord = coords[indices[i]];
+        double value = values[i];
+        if (enforceConstraints && coord.getClamped(s)) {
+            value = SimTK::clamp(
+                    coord.get_range(0), value, coord.get_range(1));
+        }
+        coord.setValue(s, value, false);
+        constrained = constrained || coord.isConstrained(s);
+    }
+    if (!enforceConstraints) return;
+
+    if (getConstraintSet().getSize() > 0 || constrained) {
+        // As in Coordinate::setValue(), the values of dependent coordinates
+        // are dictated by the other coordinates.
+        std::vector<std::pair<const Coordinate*, double>> weights;
+        weights.reserve(indices.size());
+        for (const int index : indices) {
+            const Coordinate& coord = coords[index];
+            weights.emplace_back(&coord, coord.isDependent(s) ? 0.0 : 10);
+        }
+        assembleWithCoordinateWeights(s, weights);
+    } else {
+        getMultibodySystem().realize(s, Stage::Position);
+    }
+}
+
 void Model::invalidateSystem()
 {
     if (_system)
@@ -593,6 +695,8 @@ bool Model::isValidSystem() const
  */
 void Model::createMultibodySystem()
 {
+    // The rendering thread of the visualizer, if any, uses the System.
+    if (_modelViz) _modelViz->setDecoupledRendering(false);
     // We must reset these unique_ptr's before deleting the System (through
     // reset()), since deleting the System puts a null handle pointer inside
     // the subsystems (since System deletes the subsystems).
@@ -1033,6 +1137,9 @@ void Model::extendAddToSystem(SimTK::MultibodySystem& system) const
         Stage::Velocity, Stage::Acceleration);
 
     mutableThis->_modelControlsIndex = modelControls.getSubsystemMeasureIndex();
+
+    _mobilizerReactionForcesCV = addCacheVariable("mobilizer_reaction_forces",
+            SimTK::Vector_<SimTK::SpatialVec>(), Stage::Acceleration);
 }
 
 
@@ -1201,36 +1308,73 @@ void Model::generateDecorations
     }
 }
 
-void Model::equilibrateMuscles(SimTK::State& state)
+void Model::equilibrateMuscles(SimTK::State& state, int numThreads)
 {
     getMultibodySystem().realize(state, Stage::Velocity);
 
-    bool failed = false;
-    string errorMsg = "";
+    std::vector<const Muscle*> muscles;
+    for (const Muscle* muscle : getComponentsOfType<Muscle>()) {
+        if (muscle->appliesForce(state)) muscles.push_back(muscle);
+    }
+    const int numMuscles = (int)muscles.size();
 
-    auto muscles = getComponentList<Muscle>();
+    // Just because one muscle failed to equilibrate doesn't mean it isn't
+    // still useful to have remaining muscles equilibrate; in an analysis, for
+    // example, we might not be reporting about all muscles, so continue with
+    // the rest.
+    std::vector<std::string> errors(numMuscles);
+    const auto equilibrate = [&](int i, SimTK::State& s) {
+        try {
+            muscles[i]->computeEquilibrium(s);
+        }
+        catch (const std::exception& e) {
+            errors[i] = e.what();
+        }
+    };
 
-    for (auto& muscle : muscles) {
-        if (muscle.appliesForce(state)){
-            try{
-                muscle.computeEquilibrium(state);
+    // The equilibrium of a muscle depends only on the kinematics and on its
+    // own state, so the muscles can be equilibrated concurrently, each thread
+    // in its own copy of the state. Copying the state costs about as much as
+    // equilibrating a few muscles, so each thread gets several muscles.
+    const int minMusclesPerThread = 16;
+    numThreads = std::min(getNumThreadsOrDefault(numThreads),
+            numMuscles / minMusclesPerThread);
+    if (numThreads < 2) {
+        for (int i = 0; i < numMuscles; ++i) equilibrate(i, state);
+    } else {
+        std::vector<SimTK::State> copies(numThreads, state);
+        std::vector<int> copyOfMuscle(numMuscles);
+        parallelForChunks(numMuscles, numThreads,
+                [&](int chunk, int begin, int end) {
+                    for (int i = begin; i < end; ++i) {
+                        equilibrate(i, copies[chunk]);
+                        copyOfMuscle[i] = chunk;
+                    }
+                });
+        // Copy the state variables and actuations of the muscles that were
+        // equilibrated to the state, as if they had been computed in it.
+        for (int i = 0; i < numMuscles; ++i) {
+            if (!errors[i].empty()) continue;
+            const Muscle& muscle = *muscles[i];
+            const SimTK::State& copy = copies[copyOfMuscle[i]];
+            const Array<std::string> names = muscle.getStateVariableNames();
+            for (int j = 0; j < names.getSize(); ++j) {
+                muscle.setStateVariableValue(state, names[j],
+                        muscle.getStateVariableValue(copy, names[j]));
             }
-            catch (const std::exception& e) {
-                if(!failed){ // haven't failed to equilibrate other muscles yet
-                    errorMsg = e.what();
-                    failed = true;
-                }
-                // just because one muscle failed to equilibrate doesn't mean 
-                // it isn't still useful to have remaining muscles equilibrate
-                // in an analysis, for example, we might not be reporting about
-                // all muscles, so continue with the rest.
-                continue;
+            if (muscle.isCacheVariableValid(copy, "actuation")) {
+                muscle.setActuation(state, muscle.getActuation(copy));
             }
         }
     }
 
-    if(failed) // Notify the caller of the failure to equilibrate 
-        throw Exception("Model::equilibrateMuscles() "+errorMsg, __FILE__, __LINE__);
+    for (const auto& error : errors) {
+        if (!error.empty()) {
+            // Notify the caller of the failure to equilibrate
+            throw Exception("Model::equilibrateMuscles() " + error,
+                    __FILE__, __LINE__);
+        }
+    }
 }
 
 //=============================================================================
@@ -1538,30 +1682,29 @@ bool Model::scale(SimTK::State& s, const ScaleSet& scaleSet,
     for (Body& body : updComponentList<Body>())
         body.scaleInertialProperties(scaleSet, !preserveMassDist);
 
-    // When bodies are scaled, the properties of the model are changed. The
-    // general rule is that you MUST recreate and initialize the system when
-    // properties of the model change. We must do that here or we will be
-    // querying a stale system (e.g., wrong body properties!).
-    s = initSystem();
-
     // Now that the masses of the individual bodies have been scaled (if
     // preserveMassDist == false), get the total mass and compare it to
     // finalMass in order to determine how much to scale the body masses again,
-    // so that the total model mass comes out to finalMass.
+    // so that the total model mass comes out to finalMass. The total mass is
+    // the sum of the masses of the bodies (as computed by getTotalMass()), so
+    // the system is not needed (and is recreated only once, below).
+    const auto calcTotalBodyMass = [this]() {
+        double mass = 0;
+        for (const Body& body : getComponentList<Body>())
+            mass += body.getMass();
+        return mass;
+    };
     if (finalMass > 0.0)
     {
-        const double mass = getTotalMass(s);
+        const double mass = calcTotalBodyMass();
         if (mass > 0.0)
         {
             const double factor = finalMass / mass;
             for (Body& body : updComponentList<Body>())
                 body.scaleMass(factor);
 
-            // Recreate the system and update the state after updating masses.
-            s = initSystem();
-
             // Ensure the final model mass is correct.
-            const double newMass = getTotalMass(s);
+            const double newMass = calcTotalBodyMass();
             const double normDiffMass = abs(finalMass - newMass) / finalMass;
             if (normDiffMass > SimTK::SignificantReal) {
                 throw Exception("Model::scale() scaled model mass does not match specified subject mass.");
@@ -1569,6 +1712,12 @@ bool Model::scale(SimTK::State& s, const ScaleSet& scaleSet,
         }
     }
 
+    // When bodies are scaled, the properties of the model are changed. The
+    // general rule is that you MUST recreate and initialize the system when
+    // properties of the model change. We must do that here or we will be
+    // querying a stale system (e.g., wrong body properties!).
+    s = initSystem();
+
     // Call postScale() on all ModelComponents owned by the model so that
     // components like muscles, ligaments, and path springs can update their
     // properties based on their new path length.
@@ -2206,6 +2355,17 @@ SimTK::Vec3 Model::calcMassCenterAcceleration(const SimTK::State &s) const
     return getMatterSubsystem().calcSystemMassCenterAccelerationInGround(s);
 }
 
+const SimTK::Vector_<SimTK::SpatialVec>& Model::getMobilizerReactionForces(
+        const SimTK::State& s) const
+{
+    if (!isCacheVariableValid(s, _mobilizerReactionForcesCV)) {
+        getMatterSubsystem().calcMobilizerReactionForces(s,
+                updCacheVariableValue(s, _mobilizerReactionForcesCV));
+        markCacheVariableValid(s, _mobilizerReactionForcesCV);
+    }
+    return getCacheVariableValue(s, _mobilizerReactionForcesCV);
+}
+
 SimTK::SpatialVec Model::calcMomentum(const SimTK::State &s) const
 {
     getMultibodySystem().realize(s, Stage::Velocity);
@@ -145,6 +145,24 @@ related objects are maintained in a runtime section of the Model object. You
 can also ask a Model to provide visualization using the setUseVisualizer()
 method, in which case it will allocate and maintain a ModelVisualizer.
 
+<h3>Thread safety</h3>
+After initSystem(), a Model may be used by multiple threads at the same time
+to realize *distinct* States (SimTK::System::realize() and the const methods of
+the components that compute quantities from a State, e.g.,
+Muscle::getFiberLength() or Force::computeForce()), since the results of those
+computations are kept in the cache of the State rather than in the Model.
+Anything that modifies the Model (setting properties, adding components,
+initSystem()) must not run concurrently with any other use of it. A few const
+methods use storage shared by all States and are not covered by this
+guarantee: GeometryPath::getCurrentPath() and, in models with enabled
+constraints or prescribed coordinates, GeometryPath::computeMomentArm() (and
+the moment arms of muscles), the Outputs of components
+(AbstractOutput::getValue() keeps the last value in the Output), and solvers
+(e.g., InverseKinematicsSolver), which keep their own copy of a State. To use
+these concurrently, give each thread its own copy of the model (see
+ModelPool). testConcurrentRealization checks this guarantee and is meant to
+also be run with ThreadSanitizer.
+
 @authors Frank Anderson, Peter Loan, Ayman Habib, Ajay Seth, Michael Sherman
 @see ModelComponent, ModelVisualizer, SimTK::System
 **/
@@ -404,6 +422,34 @@ public:
         return initializeState();
     }
 
+    /** Like initSystem(), but the values of the continuous state variables
+    (q, u, and z) and the time of the returned State are taken from
+    `initialState` instead of from the default values of the state variables,
+    and the configuration is not assembled. `initialState` is typically the
+    working state of the initialized model from which this %Model was copied.
+    The System is still built, but skipping the assembly (which dominates the
+    cost of initSystem() for models with constraints) makes instantiating many
+    copies of a model cheaper, e.g., for parameter sweeps in which the changed
+    properties do not affect the state variables or the constraints:
+    @code
+    const SimTK::State& s0 = model.initSystem();
+    for (double stiffness : stiffnesses) {
+        Model copy(model);
+        copy.updComponent<PathSpring>("/forceset/spring").setStiffness(
+                stiffness);
+        SimTK::State& s = copy.initSystemFrom(s0);
+        // ...
+    }
+    @endcode
+    Discrete state variables (e.g., whether coordinates are locked) are still
+    initialized from the properties of this %Model, and the assembly solver
+    is created only when it is needed (e.g., by assemble()). An exception is
+    thrown if the numbers of state variables of `initialState` and this
+    %Model differ; it is up to the caller to ensure that `initialState`
+    satisfies the constraints of this %Model. **/
+    SimTK::State& initSystemFrom(const SimTK::State& initialState)
+            SWIG_DECLARE_EXCEPTION;
+
 
     /** Convenience method that returns a reference to the model's 'working'
     state. This is just returning the reference that was returned by 
@@ -459,11 +505,48 @@ public:
      */
     void assemble(SimTK::State& state, const Coordinate *coord = NULL, double weight = 10);
 
+    /**
+     * Set the values of several coordinates at once. This is equivalent to
+     * calling Coordinate::setValue() for each coordinate, but the
+     * constraints are enforced (by assembling the model, if it has
+     * constraints) once, after all the values are set, rather than after
+     * each value; while assembling, the coordinates that were set are
+     * weighted as Coordinate::setValue() weights the coordinate it sets.
+     * If `enforceConstraints` is true, the values of clamped coordinates
+     * are clamped to their ranges, and the state is realized to Position
+     * (Velocity, if the model is assembled). The values of locked
+     * coordinates are not changed.
+     *
+     * @param state The state in which to set the values.
+     * @param names The names of the coordinates (in the CoordinateSet).
+     * @param values The values of the coordinates, in the order of `names`.
+     * @param enforceConstraints Whether to clamp the values and satisfy the
+     *      constraints, after setting all the values.
+     */
+    void setCoordinateValues(SimTK::State& state,
+            const std::vector<std::string>& names,
+            const SimTK::Vector& values, bool enforceConstraints = true);
+    /** Same as above, but the coordinates are given by their indices in the
+     * CoordinateSet, which avoids looking them up by name. */
+    void setCoordinateValues(SimTK::State& state,
+            const std::vector<int>& indices,
+            const SimTK::Vector& values, bool enforceConstraints = true);
+
 
     /**
      * Update the state of all Muscles so they are in equilibrium.
+     *
+     * The muscles are independent given the kinematics, so with enough
+     * muscles (e.g., in full-body models), they are equilibrated on
+     * `numThreads` threads, each with its own copy of the state (solving for
+     * the equilibrium of a muscle sets its state variables, which would
+     * invalidate the cache of a shared state). The results are those of
+     * equilibrating the muscles one after another. If `numThreads` is not
+     * positive, the number of hardware threads is used (see
+     * getNumThreadsOrDefault()); with 1, the muscles are equilibrated in
+     * `state` itself.
      */
-    void equilibrateMuscles(SimTK::State& state);
+    void equilibrateMuscles(SimTK::State& state, int numThreads = -1);
 
     //--------------------------------------------------------------------------
     /**@name       Access to the Simbody System and components
@@ -889,6 +972,18 @@ public:
      */
     SimTK::Vec3 calcLinearMomentum(const SimTK::State &s) const;
 
+    /**
+     * Return the reaction forces of all the mobilizers of the system, indexed
+     * by SimTK::MobilizedBodyIndex: the moment and force on each mobilized
+     * body at the origin of its mobilizer's M frame, expressed in Ground (see
+     * SimTK::SimbodyMatterSubsystem::calcMobilizerReactionForces()). They are
+     * computed once for each realization of the state to Acceleration and
+     * shared by all the Joint reactions of that state (e.g., of several
+     * MocoJointReactionGoals). The state must be realized to Acceleration.
+     */
+    const SimTK::Vector_<SimTK::SpatialVec>& getMobilizerReactionForces(
+            const SimTK::State& s) const;
+
     /** Return the total Kinetic Energy for the underlying system.*/
     double calcKineticEnergy(const SimTK::State &s) const {
         return getMultibodySystem().calcKineticEnergy(s);
@@ -1149,6 +1244,15 @@ private:
     void createMultibodySystem();
 
     void createAssemblySolver(const SimTK::State& s);
+    // Assemble, weighting each of the given coordinates with its weight.
+    void assembleWithCoordinateWeights(SimTK::State& s,
+            const std::vector<std::pair<const Coordinate*, double>>& weights);
+
+    // The part of initializeState() before the assembly: realize the topology
+    // and create the working state, with the values of the continuous state
+    // variables from initialState if it is not null, and realize it through
+    // Stage::Position.
+    void createWorkingState(const SimTK::State* initialState);
 
     // To provide access to private _modelComponents member.
     friend class Component; 
@@ -1257,6 +1361,10 @@ private:
     // Default values pooled from Actuators upon system creation.
     mutable SimTK::Vector _defaultControls;
 
+    // The reaction forces of all mobilizers (see getMobilizerReactionForces()).
+    mutable CacheVariable<SimTK::Vector_<SimTK::SpatialVec>>
+            _mobilizerReactionForcesCV;
+
 
     //                          VISUALIZATION
     // Anyone generating display geometry from this Model should consult this
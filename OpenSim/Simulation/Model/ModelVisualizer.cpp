@@ -22,13 +22,19 @@
  * -------------------------------------------------------------------------- */
 
 #include "ModelVisualizer.h"
+#include "Geometry.h"
 #include "Model.h"
 #include <OpenSim/version.h>
+#include <OpenSim/Common/Logger.h>
 #include <OpenSim/Common/ModelDisplayHints.h>
 #include <simbody/internal/Visualizer_InputListener.h>
-#include <simbody/internal/Visualizer_Reporter.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <thread>
 using std::string;
 #include <iostream>
 using std::cerr; using std::clog; using std::endl;
@@ -127,16 +133,162 @@ void DefaultGeometry::generateDecorations
                                state, geometry);
 }
 
+//==============================================================================
+//                           VISUALIZER REPORTER
+//==============================================================================
+
+/* This reports the states of a simulation to the ModelVisualizer at regular
+intervals. It replaces the SimTK::Visualizer::Reporter, which always reports
+to the Visualizer, so that the ModelVisualizer can pass the states to its
+rendering thread instead. */
+class ModelVisualizer::Reporter : public PeriodicEventReporter {
+public:
+    Reporter(const ModelVisualizer& viz, Real reportInterval)
+        : PeriodicEventReporter(reportInterval), _viz(viz) {}
+
+    void handleEvent(const State& state) const override {
+        _viz.report(state);
+    }
+private:
+    const ModelVisualizer& _viz;
+};
+
+//==============================================================================
+//                                 RENDERER
+//==============================================================================
+
+/* The rendering thread of decoupled rendering. The simulation thread
+publishes states with publish(), and the rendering thread draws the latest
+published state at the visualizer's desired frame rate.
+
+The states are exchanged through three buffers so that neither thread ever
+waits for the other: the simulation thread writes into its back buffer and
+then swaps it with the middle buffer, and the rendering thread swaps its front
+buffer with the middle buffer if a state was published since it last did. */
+class ModelVisualizer::Renderer {
+public:
+    explicit Renderer(const ModelVisualizer& viz) : _viz(viz) {
+        _thread = std::thread(&Renderer::run, this);
+    }
+
+    ~Renderer() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _condition.notify_one();
+        _thread.join();
+    }
+
+    // Called by the simulation thread.
+    void publish(const State& state) {
+        Frame& frame = _frames[_back];
+        frame.time = state.getTime();
+        frame.y = state.getY(); // Reuses the memory once sized.
+        _back = _middle.exchange(_back | Fresh, std::memory_order_acq_rel)
+                & IndexMask;
+    }
+
+private:
+    struct Frame {
+        double time = 0;
+        Vector y;
+    };
+
+    // The latest frame, or nullptr if none was published since the last
+    // call.
+    const Frame* consume() {
+        if (!(_middle.load(std::memory_order_acquire) & Fresh)) return nullptr;
+        _front = _middle.exchange(_front, std::memory_order_acq_rel)
+                 & IndexMask;
+        return &_frames[_front];
+    }
+
+    void draw(State& state, const Frame& frame) const {
+        if (frame.y.size() != state.getNY()) return;
+        state.setTime(frame.time);
+        state.updY() = frame.y;
+        _viz.show(state);
+    }
+
+    void run() {
+        try {
+            const MultibodySystem& system = _viz.getModel().getMultibodySystem();
+            State state = system.getDefaultState();
+            system.realize(state, Stage::Model);
+            const auto period = std::chrono::duration<double>(
+                    1. / _viz.getSimbodyVisualizer().getDesiredFrameRate());
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (!_stop) {
+                lock.unlock();
+                if (const Frame* frame = consume()) draw(state, *frame);
+                lock.lock();
+                _condition.wait_for(lock, period, [this] { return _stop; });
+            }
+            lock.unlock();
+            // Draw the state published after the last frame, if any.
+            if (const Frame* frame = consume()) draw(state, *frame);
+        } catch (const std::exception& e) {
+            // The simulation continues without visualization.
+            log_error("ModelVisualizer: decoupled rendering stopped: {}",
+                    e.what());
+        }
+    }
+
+    // The middle index holds this flag if its frame has not been consumed.
+    static const int Fresh = 4;
+    static const int IndexMask = 3;
+
+    const ModelVisualizer& _viz;
+    Frame _frames[3];
+    int _back = 0;                  // Only used by the simulation thread.
+    std::atomic<int> _middle{1};
+    int _front = 2;                 // Only used by the rendering thread.
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _stop = false;
+    std::thread _thread;
+};
+
 //==============================================================================
 //                            MODEL VISUALIZER
 //==============================================================================
 
+ModelVisualizer::~ModelVisualizer() {clear();}
+
+void ModelVisualizer::clear() {
+    // The rendering thread uses the Visualizer.
+    _renderer.reset();
+    delete _viz; _viz = 0;
+    _silo = 0; // Visualizer will have deleted this.
+}
+
 void ModelVisualizer::show(const SimTK::State& state) const {
     // Make sure we're realized at least through Velocity stage.
     _model.getMultibodySystem().realize(state, SimTK::Stage::Velocity);
     getSimbodyVisualizer().report(state);
 }
 
+void ModelVisualizer::setDecoupledRendering(bool decoupled) {
+    if (decoupled == getDecoupledRendering()) return;
+    if (decoupled) {
+        OPENSIM_THROW_IF(
+                !_model.getMultibodySystem().systemTopologyHasBeenRealized(),
+                OpenSim::Exception,
+                "Call Model::initSystem() before turning on decoupled "
+                "rendering.");
+        _renderer.reset(new Renderer(*this));
+    } else {
+        _renderer.reset();
+    }
+}
+
+void ModelVisualizer::report(const SimTK::State& state) const {
+    if (_renderer) _renderer->publish(state);
+    else getSimbodyVisualizer().report(state);
+}
+
 // See if we can find the given file. The rules are
 //  - if it is an absolute pathname, we only get one shot, else:
 //  - define "modelDir" to be the absolute pathname of the 
@@ -220,6 +372,11 @@ void ModelVisualizer::addDirToGeometrySearchPaths(const std::string& dir) {
 void ModelVisualizer::createVisualizer() {
     _model.updMatterSubsystem().setShowDefaultGeometry(false);
 
+    // Decode the mesh files on background threads while the visualizer
+    // window starts; collectFixedGeometry() waits for them.
+    for (const auto& mesh : _model.getComponentList<OpenSim::Mesh>())
+        mesh.startLoadingMeshFile();
+
     // Allocate a Simbody Visualizer. The search will go as 
     // follows: first look in the same directory as the currently-
     // executing executable; then look at all the paths in the environment
@@ -283,7 +440,7 @@ void ModelVisualizer::createVisualizer() {
     // This is used for regular output of frames during forward dynamics.
     // TODO: allow user control of timing.
     _model.updMultibodySystem().addEventReporter
-        (new SimTK::Visualizer::Reporter(*_viz, 1./30));
+        (new Reporter(*this, 1./30));
 }
 
 // We also rummage through the model to find fixed geometry that should be part
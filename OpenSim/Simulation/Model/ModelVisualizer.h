@@ -32,6 +32,8 @@ that uses the OpenSim API. **/
 #include <OpenSim/Simulation/osimSimulationDLL.h>
 #include <simbody/internal/Visualizer.h>
 
+#include <memory>
+
 namespace OpenSim {
 class Model;
 }
@@ -120,7 +122,7 @@ visualizer. The search proceeds in the following order:
 class OSIMSIMULATION_API ModelVisualizer {
 public:
 
-    ~ModelVisualizer() {clear();}
+    ~ModelVisualizer();
 
     /** @name                Drawing methods
     Currently there is just a single method for generating a frame. **/
@@ -130,6 +132,35 @@ public:
     void show(const SimTK::State& state) const;
     /**@}**/
 
+    /** @name                Decoupled rendering
+    During a simulation, the states are reported to the visualizer 30 times
+    per simulated second. By default, each report generates the geometry and
+    sends it to the visualizer window on the simulation thread, so that the
+    simulation runs no faster than the visualizer can draw (and waits for the
+    connection to the visualizer window).
+
+    With decoupled rendering, a report only copies the time and the
+    continuous state variables (q, u, and z) of the state into a slot that the
+    simulation never waits for (the latest of three buffers), and a rendering
+    thread draws the latest state in the slot at the desired frame rate of
+    the visualizer (see SimTK::Visualizer::setDesiredFrameRate()); states that
+    are replaced before they are drawn are not drawn. This lets you monitor a
+    long simulation without slowing it down. The rendering thread realizes a
+    copy of the default state of the System, so geometry that depends on
+    discrete state variables (e.g., prescribed controls) is drawn with their
+    default values. While decoupled rendering is on, do not call show() or
+    change the Model's geometry or display hints from other threads (the
+    visualizer's menu is handled as usual). **/
+    /**@{**/
+    /** Turn decoupled rendering on or off; this starts or stops (after it
+    draws the latest state) the rendering thread. Call this after
+    Model::initSystem(); decoupled rendering is turned off when the %Model
+    creates a new System (e.g., in the next Model::initSystem()). **/
+    void setDecoupledRendering(bool decoupled);
+    /** Whether decoupled rendering is on (off by default). **/
+    bool getDecoupledRendering() const {return _renderer != nullptr;}
+    /**@}**/
+
     /** @name       Access to SimTK::Visualizer features
     These methods provide access to lower-level SimTK::Visualizer objects
     that are used in the implementation of this ModelVisualizer. **/
@@ -230,13 +261,17 @@ private:
     // through Instance stage.
     void collectFixedGeometry(const SimTK::State& state) const;
 
-    void clear() {
-        delete _viz; _viz = 0;
-        _silo = 0; // Visualizer will have deleted this.
-    }
+    // Called by the System's reporter during a simulation: draw the state,
+    // or give it to the rendering thread.
+    void report(const SimTK::State& state) const;
+
+    void clear();
 
     void createVisualizer();
 
+    class Reporter;
+    class Renderer;
+
 private:
     Model&                       _model;
     SimTK::Visualizer*           _viz;
@@ -246,6 +281,9 @@ private:
     // don't delete it!
     SimTK::Visualizer::InputSilo*   _silo;
 
+    // The rendering thread, if decoupled rendering is on.
+    std::unique_ptr<Renderer>       _renderer;
+
     // List of directories to search.
     static SimTK::Array_<std::string> dirsToSearch;
 };
@@ -558,6 +558,21 @@ updMuscleDynamicsInfo(const SimTK::State& s) const
     return updCacheVariableValue(s, _dynamicsInfoCV);
 }
 
+void Muscle::markMuscleLengthInfoValid(const SimTK::State& s) const
+{
+    markCacheVariableValid(s, _lengthInfoCV);
+}
+
+void Muscle::markFiberVelocityInfoValid(const SimTK::State& s) const
+{
+    markCacheVariableValid(s, _velInfoCV);
+}
+
+void Muscle::markMuscleDynamicsInfoValid(const SimTK::State& s) const
+{
+    markCacheVariableValid(s, _dynamicsInfoCV);
+}
+
 const Muscle::MusclePotentialEnergyInfo& Muscle::
 getMusclePotentialEnergyInfo(const SimTK::State& s) const
 {
@@ -375,6 +375,14 @@ protected:
     const MusclePotentialEnergyInfo& getMusclePotentialEnergyInfo(const SimTK::State& s) const;
     MusclePotentialEnergyInfo& updMusclePotentialEnergyInfo(const SimTK::State& s) const;
 
+    /** Mark the values assigned through updMuscleLengthInfo(),
+    updFiberVelocityInfo(), and updMuscleDynamicsInfo() as valid, so that the
+    corresponding get methods return them instead of calling the calc methods
+    (e.g., when the values are computed for many muscles at once). */
+    void markMuscleLengthInfoValid(const SimTK::State& s) const;
+    void markFiberVelocityInfoValid(const SimTK::State& s) const;
+    void markMuscleDynamicsInfoValid(const SimTK::State& s) const;
+
     //--------------------------------------------------------------------------
     // CALCULATIONS
     //--------------------------------------------------------------------------
@@ -144,7 +144,10 @@ public:
     such that vec_P = X_PF*vec_F.
     
     This transform is stored via the translation and orientation
-    properties of this object.
+    properties of this object. The kinematics of an OffsetFrame are computed
+    from its base frame, with the offsets of its chain of parent frames
+    combined when the frame is added to the System; so that the frames
+    attached to this one use the new offset, call initSystem().
     
     @param offset   The transform between this frame and its parent frame.
     */
@@ -164,6 +167,7 @@ protected:
     /**@{**/
     void extendFinalizeFromProperties() override;
     void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
     /**@}**/
 
     // The transform X_GO for this OffsetFrame, O, in Ground, G.
@@ -183,6 +187,13 @@ private:
 
     // the Offset transform in its parent frame
     SimTK::Transform _offsetTransform;
+
+    // The base frame of this frame and the transform of this frame in it (the
+    // offsets of a chain of OffsetFrames combined), so that the kinematics in
+    // ground need not traverse the chain. These are set when the frame is
+    // added to the System; until then, the chain is traversed.
+    mutable SimTK::ReferencePtr<const Frame> _baseFrame;
+    mutable SimTK::Transform _transformInBaseFrame;
 //=============================================================================
 }; // END of class OffsetFrame
 //=============================================================================
@@ -251,6 +262,9 @@ template <class C>
 SimTK::Transform OffsetFrame<C>::
 calcTransformInGround(const SimTK::State& state) const
 {
+    if (!_baseFrame.empty()) {
+        return _baseFrame->getTransformInGround(state)*_transformInBaseFrame;
+    }
     return this->getParentFrame().getTransformInGround(state)*getOffsetTransform();
 }
 
@@ -258,6 +272,15 @@ template <class C>
 SimTK::SpatialVec OffsetFrame<C>::
 calcVelocityInGround(const SimTK::State& state) const
 {
+    if (!_baseFrame.empty()) {
+        // The rigid offset of the OffsetFrame from its base frame, expressed
+        // in ground
+        const SimTK::Vec3& r = _baseFrame->getTransformInGround(state).R()*
+            _transformInBaseFrame.p();
+        SimTK::SpatialVec V_GF = _baseFrame->getVelocityInGround(state);
+        V_GF(1) += V_GF(0) % r;
+        return V_GF;
+    }
     // The rigid offset of the OffsetFrame expressed in ground
     const SimTK::Vec3& r = this->getParentFrame().getTransformInGround(state).R()*
         getOffsetTransform().p();
@@ -273,6 +296,14 @@ template <class C>
 SimTK::SpatialVec OffsetFrame<C>::
 calcAccelerationInGround(const SimTK::State& state) const
 {
+    if (!_baseFrame.empty()) {
+        const SimTK::Vec3& r = _baseFrame->getTransformInGround(state).R()*
+            _transformInBaseFrame.p();
+        const SimTK::SpatialVec& V_GF = _baseFrame->getVelocityInGround(state);
+        SimTK::SpatialVec A_GF = _baseFrame->getAccelerationInGround(state);
+        A_GF[1] += (A_GF[0] % r + V_GF[0] % (V_GF[0] % r));
+        return A_GF;
+    }
     // The rigid offset of the OffsetFrame expressed in ground
     const SimTK::Vec3& r = this->getParentFrame().getTransformInGround(state).R()*
         getOffsetTransform().p();
@@ -310,6 +341,10 @@ template <class C>
 void OffsetFrame<C>::setOffsetTransform(const SimTK::Transform& xform)
 {
     _offsetTransform = xform;
+    if (!_baseFrame.empty()) {
+        _transformInBaseFrame =
+                getParentFrame().findTransformInBaseFrame() * xform;
+    }
     // Make sure properties are updated in case we either get properties or
     // serialize after this call
     set_translation(xform.p());
@@ -352,6 +387,8 @@ void OffsetFrame<C>::extendFinalizeFromProperties()
     Super::extendFinalizeFromProperties();
     _offsetTransform.updP() = get_translation();
     _offsetTransform.updR().setRotationToBodyFixedXYZ(get_orientation());
+    // The offsets of the chain may have changed.
+    _baseFrame.reset();
 }
 
 template<class C>
@@ -362,6 +399,17 @@ void OffsetFrame<C>::extendConnectToModel(Model& model)
         getConcreteClassName() + " cannot connect to itself!");
 }
 
+template<class C>
+void OffsetFrame<C>::extendAddToSystem(SimTK::MultibodySystem& system) const
+{
+    Super::extendAddToSystem(system);
+    // All the connections (and offsets) of the chain of parents are final.
+    // Note that changing the offset of a parent frame afterwards (without
+    // calling initSystem()) does not affect this frame.
+    _baseFrame.reset(&findBaseFrame());
+    _transformInBaseFrame = findTransformInBaseFrame();
+}
+
 } // end of namespace OpenSim
 
 #endif // OPENSIM_OFFSET_FRAME_H_
@@ -112,6 +112,10 @@ private:
 
     MemberSubcomponentIndex stationIx{ constructSubcomponent<Station>("station") };
 
+    // GeometryPath computes the locations of its PathPoints in Ground for
+    // all the points on a body at once.
+    friend class GeometryPath;
+
 //=============================================================================
 };  // END of class PathPoint
 //=============================================================================
@@ -71,6 +71,13 @@ const SimTK::Vec3& Point::getLocationInGround(const SimTK::State& s) const
     return location;
 }
 
+void Point::setLocationInGroundCache(const SimTK::State& s,
+        const SimTK::Vec3& location) const
+{
+    updCacheVariableValue(s, _locationCV) = location;
+    markCacheVariableValid(s, _locationCV);
+}
+
 const SimTK::Vec3& Point::getVelocityInGround(const SimTK::State& s) const
 {
     if (isCacheVariableValid(s, _velocityCV)) {
@@ -147,6 +147,13 @@ protected:
     void extendAddToSystem(SimTK::MultibodySystem& system) const override;
     /**@}**/
 
+    /** Store the location of this Point in Ground in the cache of the state,
+    for a Point whose location is computed together with that of other
+    Points (e.g., the PathPoints of a GeometryPath). It must equal the result
+    of calcLocationInGround(). */
+    void setLocationInGroundCache(const SimTK::State& state,
+            const SimTK::Vec3& location) const;
+
 private:
 
     mutable CacheVariable<SimTK::Vec3> _locationCV;
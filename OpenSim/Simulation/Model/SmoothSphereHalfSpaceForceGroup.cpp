@@ -0,0 +1,432 @@
+/* -------------------------------------------------------------------------- *
+ *               OpenSim: SmoothSphereHalfSpaceForceGroup.cpp                 *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SmoothSphereHalfSpaceForceGroup.h"
+
+#include "SmoothSphereHalfSpaceForce.h"
+
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace OpenSim;
+
+namespace {
+    // Rows of SmoothSphereHalfSpaceForceGroup::m_parameters.
+    enum Parameter {
+        // (4/3) k sqrt(R k), with k = 0.5 E^(2/3).
+        HertzCoefficient,
+        Dissipation,
+        StaticFriction,
+        DynamicFriction,
+        ViscousFriction,
+        TransitionVelocity,
+        ConstantContactForce,
+        HertzSmoothing,
+        HuntCrossleySmoothing,
+        NumParameters
+    };
+
+    // Rows of the workspace of calcContactForces().
+    enum Value {
+        // Inputs.
+        Indentation,
+        IndentationRate,
+        TangentialVelocityX,
+        TangentialVelocityY,
+        TangentialVelocityZ,
+        // Results.
+        NormalForce,
+        // The friction force is -FrictionScale times the tangential velocity.
+        FrictionScale,
+        NumValues
+    };
+}
+
+//=============================================================================
+//  SMOOTH SPHERE HALF SPACE FORCE GROUP CONTACT
+//=============================================================================
+SmoothSphereHalfSpaceForceGroup_Contact::
+        SmoothSphereHalfSpaceForceGroup_Contact() {
+    constructProperties();
+}
+
+void SmoothSphereHalfSpaceForceGroup_Contact::constructProperties() {
+    constructProperty_stiffness(1.0);
+    constructProperty_dissipation(0.0);
+    constructProperty_static_friction(0.0);
+    constructProperty_dynamic_friction(0.0);
+    constructProperty_viscous_friction(0.0);
+    constructProperty_transition_velocity(0.01);
+    constructProperty_constant_contact_force(1e-5);
+    constructProperty_hertz_smoothing(300.0);
+    constructProperty_hunt_crossley_smoothing(50.0);
+}
+
+//=============================================================================
+//  SMOOTH SPHERE HALF SPACE FORCE GROUP
+//=============================================================================
+SmoothSphereHalfSpaceForceGroup::SmoothSphereHalfSpaceForceGroup() {
+    constructProperties();
+}
+
+void SmoothSphereHalfSpaceForceGroup::constructProperties() {
+    constructProperty_contacts();
+    constructProperty_force_visualization_radius(0.01);
+    constructProperty_force_visualization_scale_factor();
+}
+
+SmoothSphereHalfSpaceForceGroup_Contact&
+SmoothSphereHalfSpaceForceGroup::addContact(const std::string& name,
+        const ContactSphere& sphere, const ContactHalfSpace& halfSpace) {
+    append_contacts(SmoothSphereHalfSpaceForceGroup_Contact());
+    auto& contact = upd_contacts(getProperty_contacts().size() - 1);
+    contact.setName(name);
+    contact.connectSocket_sphere(sphere);
+    contact.connectSocket_half_space(halfSpace);
+    return contact;
+}
+
+SmoothSphereHalfSpaceForceGroup_Contact&
+SmoothSphereHalfSpaceForceGroup::addContact(
+        const SmoothSphereHalfSpaceForce& force) {
+    auto& contact = addContact(force.getName(),
+            force.getConnectee<ContactSphere>("sphere"),
+            force.getConnectee<ContactHalfSpace>("half_space"));
+    contact.set_stiffness(force.get_stiffness());
+    contact.set_dissipation(force.get_dissipation());
+    contact.set_static_friction(force.get_static_friction());
+    contact.set_dynamic_friction(force.get_dynamic_friction());
+    contact.set_viscous_friction(force.get_viscous_friction());
+    contact.set_transition_velocity(force.get_transition_velocity());
+    contact.set_constant_contact_force(force.get_constant_contact_force());
+    contact.set_hertz_smoothing(force.get_hertz_smoothing());
+    contact.set_hunt_crossley_smoothing(force.get_hunt_crossley_smoothing());
+    return contact;
+}
+
+void SmoothSphereHalfSpaceForceGroup::extendFinalizeFromProperties() {
+    Super::extendFinalizeFromProperties();
+    updOutput("sphere_force").clearChannels();
+    updOutput("half_space_force").clearChannels();
+    for (int i = 0; i < getNumContacts(); ++i) {
+        const std::string& name = get_contacts(i).getName();
+        updOutput("sphere_force").addChannel(name);
+        updOutput("half_space_force").addChannel(name);
+    }
+}
+
+void SmoothSphereHalfSpaceForceGroup::extendAddToSystem(
+        SimTK::MultibodySystem& system) const {
+    Super::extendAddToSystem(system);
+
+    const int n = getNumContacts();
+    m_sphereBodies.resize(n);
+    m_halfSpaceBodies.resize(n);
+    m_sphereLocations.resize(n);
+    m_halfSpaceNormals.resize(n);
+    m_halfSpaceOrigins.resize(n);
+    m_radii.resize(n);
+    m_parameters.assign(NumParameters * n, SimTK::NaN);
+    const auto set = [&](Parameter row, int index, double value) {
+        m_parameters[row * n + index] = value;
+    };
+    for (int i = 0; i < n; ++i) {
+        const auto& contact = get_contacts(i);
+        const auto& sphere = contact.getConnectee<ContactSphere>("sphere");
+        const auto& halfSpace =
+                contact.getConnectee<ContactHalfSpace>("half_space");
+
+        m_sphereBodies[i] = sphere.getFrame().getMobilizedBodyIndex();
+        m_sphereLocations[i] = sphere.getFrame().findTransformInBaseFrame() *
+                               sphere.get_location();
+        // The half-space occupies the positive x side of its frame, so its
+        // outward normal is the negative x axis of the frame.
+        const SimTK::Transform X_BH =
+                halfSpace.getFrame().findTransformInBaseFrame() *
+                halfSpace.getTransform();
+        m_halfSpaceBodies[i] = halfSpace.getFrame().getMobilizedBodyIndex();
+        m_halfSpaceNormals[i] = -X_BH.R().x().asVec3();
+        m_halfSpaceOrigins[i] = X_BH.p();
+
+        const double radius = sphere.getRadius();
+        m_radii[i] = radius;
+        const double k = 0.5 * std::pow(contact.get_stiffness(), 2.0 / 3.0);
+        set(HertzCoefficient, i, (4.0 / 3.0) * k * std::sqrt(radius * k));
+        set(Dissipation, i, contact.get_dissipation());
+        set(StaticFriction, i, contact.get_static_friction());
+        set(DynamicFriction, i, contact.get_dynamic_friction());
+        set(ViscousFriction, i, contact.get_viscous_friction());
+        set(TransitionVelocity, i, contact.get_transition_velocity());
+        set(ConstantContactForce, i, contact.get_constant_contact_force());
+        set(HertzSmoothing, i, contact.get_hertz_smoothing());
+        set(HuntCrossleySmoothing, i, contact.get_hunt_crossley_smoothing());
+    }
+
+    const SimTK::Vector_<SimTK::SpatialVec> forces(n, SimTK::SpatialVec(0));
+    this->_sphereForcesCV =
+            addCacheVariable("sphere_forces", forces, SimTK::Stage::Velocity);
+    this->_halfSpaceForcesCV = addCacheVariable(
+            "half_space_forces", forces, SimTK::Stage::Velocity);
+}
+
+void SmoothSphereHalfSpaceForceGroup::extendRealizeInstance(
+        const SimTK::State& state) const {
+    Super::extendRealizeInstance(state);
+    if (!getProperty_force_visualization_scale_factor().empty()) {
+        m_forceVizScaleFactor = get_force_visualization_scale_factor();
+    } else {
+        const Model& model = getModel();
+        const double mass = model.getTotalMass(state);
+        const double weight = mass * model.getGravity().norm();
+        m_forceVizScaleFactor = 1 / weight;
+    }
+}
+
+int SmoothSphereHalfSpaceForceGroup::getContactIndex(
+        const std::string& name) const {
+    for (int i = 0; i < getNumContacts(); ++i) {
+        if (get_contacts(i).getName() == name) return i;
+    }
+    OPENSIM_THROW_FRMOBJ(Exception, "No contact named '{}'.", name);
+}
+
+//=============================================================================
+//  COMPUTATION
+//=============================================================================
+void SmoothSphereHalfSpaceForceGroup::calcContactForces(
+        const SimTK::State& s) const {
+    if (isCacheVariableValid(s, _sphereForcesCV) &&
+            isCacheVariableValid(s, _halfSpaceForcesCV)) {
+        return;
+    }
+    const SimTK::SimbodyMatterSubsystem& matter =
+            getModel().getMatterSubsystem();
+    const int n = getNumContacts();
+    std::vector<double> values(NumValues * n);
+    std::vector<SimTK::Vec3> normals(n);
+    std::vector<SimTK::Vec3> points(n);
+    const auto p = [&](Parameter row, int index) {
+        return m_parameters[row * n + index];
+    };
+    const auto v = [&](Value row) { return values.data() + row * n; };
+
+    // Gather the indentation and the relative velocity at the contact point
+    // of each contact, in ground.
+    for (int i = 0; i < n; ++i) {
+        const SimTK::MobilizedBody& sphereBody =
+                matter.getMobilizedBody(m_sphereBodies[i]);
+        const SimTK::MobilizedBody& halfSpaceBody =
+                matter.getMobilizedBody(m_halfSpaceBodies[i]);
+        const SimTK::Transform& X_GS = sphereBody.getBodyTransform(s);
+        const SimTK::Transform& X_GH = halfSpaceBody.getBodyTransform(s);
+        const SimTK::SpatialVec& V_GS = sphereBody.getBodyVelocity(s);
+        const SimTK::SpatialVec& V_GH = halfSpaceBody.getBodyVelocity(s);
+
+        const SimTK::Vec3 center = X_GS * m_sphereLocations[i];
+        const SimTK::Vec3 normal = X_GH.R() * m_halfSpaceNormals[i];
+        const SimTK::Vec3 origin = X_GH * m_halfSpaceOrigins[i];
+        const double indentation =
+                m_radii[i] - SimTK::dot(normal, center - origin);
+        // The contact point is halfway through the indentation.
+        const SimTK::Vec3 point =
+                center - (m_radii[i] - 0.5 * indentation) * normal;
+
+        // The velocity of the sphere relative to the half-space at the
+        // contact point.
+        const SimTK::Vec3 velocity =
+                (V_GS[1] + V_GS[0] % (point - X_GS.p())) -
+                (V_GH[1] + V_GH[0] % (point - X_GH.p()));
+        const double normalVelocity = SimTK::dot(velocity, normal);
+        const SimTK::Vec3 tangentialVelocity =
+                velocity - normalVelocity * normal;
+
+        v(Indentation)[i] = indentation;
+        v(IndentationRate)[i] = -normalVelocity;
+        v(TangentialVelocityX)[i] = tangentialVelocity[0];
+        v(TangentialVelocityY)[i] = tangentialVelocity[1];
+        v(TangentialVelocityZ)[i] = tangentialVelocity[2];
+        normals[i] = normal;
+        points[i] = point;
+    }
+
+    // The smooth Hunt-Crossley normal force and the friction force of all the
+    // contacts (see SmoothSphereHalfSpaceForce).
+    const double* indentation = v(Indentation);
+    const double* indentationRate = v(IndentationRate);
+    const double* vtx = v(TangentialVelocityX);
+    const double* vty = v(TangentialVelocityY);
+    const double* vtz = v(TangentialVelocityZ);
+    double* normalForce = v(NormalForce);
+    double* frictionScale = v(FrictionScale);
+    for (int i = 0; i < n; ++i) {
+        const double cf = p(ConstantContactForce, i);
+        const double c = p(Dissipation, i);
+        const double fH = p(HertzCoefficient, i) *
+                std::pow(std::sqrt(indentation[i] * indentation[i] + cf),
+                        1.5);
+        const double fHd = fH * (0.5 + 0.5 * std::tanh(p(HertzSmoothing, i) *
+                                                        indentation[i]));
+        const double fHC = fHd * (1.0 + 1.5 * c * indentationRate[i]);
+        const double fHCd = fHC *
+                (0.5 + 0.5 * std::tanh(p(HuntCrossleySmoothing, i) *
+                                       (indentationRate[i] + 2.0 / (3.0 * c))));
+
+        const double vslip =
+                std::sqrt(vtx[i] * vtx[i] + vty[i] * vty[i] +
+                          vtz[i] * vtz[i] + cf);
+        const double vrel = vslip / p(TransitionVelocity, i);
+        const double ud = p(DynamicFriction, i);
+        const double us = p(StaticFriction, i);
+        const double ff = fHCd * (std::min(vrel, 1.0) *
+                                          (ud + 2.0 * (us - ud) /
+                                                        (1.0 + vrel * vrel)) +
+                                         p(ViscousFriction, i) * vslip);
+        normalForce[i] = fHCd;
+        frictionScale[i] = ff / vslip;
+    }
+
+    // The spatial forces on the bodies, about their origins.
+    auto& sphereForces = updCacheVariableValue(s, _sphereForcesCV);
+    auto& halfSpaceForces = updCacheVariableValue(s, _halfSpaceForcesCV);
+    for (int i = 0; i < n; ++i) {
+        const SimTK::Vec3 force =
+                normalForce[i] * normals[i] -
+                frictionScale[i] * SimTK::Vec3(vtx[i], vty[i], vtz[i]);
+        const SimTK::Vec3& sphereOrigin =
+                matter.getMobilizedBody(m_sphereBodies[i])
+                        .getBodyOriginLocation(s);
+        const SimTK::Vec3& halfSpaceOrigin =
+                matter.getMobilizedBody(m_halfSpaceBodies[i])
+                        .getBodyOriginLocation(s);
+        sphereForces[i] =
+                SimTK::SpatialVec((points[i] - sphereOrigin) % force, force);
+        halfSpaceForces[i] = SimTK::SpatialVec(
+                (points[i] - halfSpaceOrigin) % -force, -force);
+    }
+    markCacheVariableValid(s, _sphereForcesCV);
+    markCacheVariableValid(s, _halfSpaceForcesCV);
+}
+
+const SimTK::Vector_<SimTK::SpatialVec>&
+SmoothSphereHalfSpaceForceGroup::getSphereForces(const SimTK::State& s) const {
+    calcContactForces(s);
+    return getCacheVariableValue(s, _sphereForcesCV);
+}
+
+const SimTK::Vector_<SimTK::SpatialVec>&
+SmoothSphereHalfSpaceForceGroup::getHalfSpaceForces(
+        const SimTK::State& s) const {
+    calcContactForces(s);
+    return getCacheVariableValue(s, _halfSpaceForcesCV);
+}
+
+SimTK::SpatialVec SmoothSphereHalfSpaceForceGroup::getSphereForce(
+        const SimTK::State& s, const std::string& channel) const {
+    return getSphereForces(s)[getContactIndex(channel)];
+}
+
+SimTK::SpatialVec SmoothSphereHalfSpaceForceGroup::getHalfSpaceForce(
+        const SimTK::State& s, const std::string& channel) const {
+    return getHalfSpaceForces(s)[getContactIndex(channel)];
+}
+
+void SmoothSphereHalfSpaceForceGroup::computeForce(const SimTK::State& s,
+        SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+        SimTK::Vector& /*generalizedForces*/) const {
+    const auto& sphereForces = getSphereForces(s);
+    const auto& halfSpaceForces = getHalfSpaceForces(s);
+    for (int i = 0; i < getNumContacts(); ++i) {
+        bodyForces[m_sphereBodies[i]] += sphereForces[i];
+        bodyForces[m_halfSpaceBodies[i]] += halfSpaceForces[i];
+    }
+}
+
+//=============================================================================
+//  REPORTING
+//=============================================================================
+OpenSim::Array<std::string>
+SmoothSphereHalfSpaceForceGroup::getRecordLabels() const {
+    OpenSim::Array<std::string> labels("");
+    for (int i = 0; i < getNumContacts(); ++i) {
+        const std::string& name = get_contacts(i).getName();
+        for (const std::string body : {".Sphere", ".HalfSpace"}) {
+            labels.append(name + body + ".force.X");
+            labels.append(name + body + ".force.Y");
+            labels.append(name + body + ".force.Z");
+            labels.append(name + body + ".torque.X");
+            labels.append(name + body + ".torque.Y");
+            labels.append(name + body + ".torque.Z");
+        }
+    }
+    return labels;
+}
+
+OpenSim::Array<double> SmoothSphereHalfSpaceForceGroup::getRecordValues(
+        const SimTK::State& state) const {
+    OpenSim::Array<double> values(1);
+    const auto& sphereForces = getSphereForces(state);
+    const auto& halfSpaceForces = getHalfSpaceForces(state);
+    for (int i = 0; i < getNumContacts(); ++i) {
+        values.append(3, &sphereForces[i][1][0]);
+        values.append(3, &sphereForces[i][0][0]);
+        values.append(3, &halfSpaceForces[i][1][0]);
+        values.append(3, &halfSpaceForces[i][0][0]);
+    }
+    return values;
+}
+
+void SmoothSphereHalfSpaceForceGroup::generateDecorations(bool fixed,
+        const ModelDisplayHints& hints, const SimTK::State& state,
+        SimTK::Array_<SimTK::DecorativeGeometry>& geometry) const {
+    Super::generateDecorations(fixed, hints, state, geometry);
+
+    if (!fixed && (state.getSystemStage() >= SimTK::Stage::Dynamics) &&
+            hints.get_show_forces()) {
+        const auto& sphereForces = getSphereForces(state);
+        for (int i = 0; i < getNumContacts(); ++i) {
+            const auto& sphere =
+                    get_contacts(i).getConnectee<ContactSphere>("sphere");
+
+            // Scale the contact force vector and compute the cylinder length.
+            const SimTK::Vec3 scaledContactForce =
+                    m_forceVizScaleFactor * sphereForces[i][1];
+            const SimTK::Real length(scaledContactForce.norm());
+
+            // Compute the force visualization transform.
+            const SimTK::Vec3 contactSpherePosition =
+                    sphere.getFrame().findStationLocationInGround(
+                            state, sphere.get_location());
+            const SimTK::Transform forceVizTransform(
+                    SimTK::Rotation(SimTK::UnitVec3(scaledContactForce),
+                            SimTK::YAxis),
+                    contactSpherePosition + scaledContactForce / 2.0);
+
+            SimTK::DecorativeCylinder forceViz(
+                    get_force_visualization_radius(), 0.5 * length);
+            forceViz.setTransform(forceVizTransform);
+            forceViz.setColor(SimTK::Vec3(0.0, 0.6, 0.0));
+            geometry.push_back(forceViz);
+        }
+    }
+}
@@ -0,0 +1,224 @@
+#ifndef OPENSIM_SMOOTH_SPHERE_HALF_SPACE_FORCE_GROUP_H_
+#define OPENSIM_SMOOTH_SPHERE_HALF_SPACE_FORCE_GROUP_H_
+/* -------------------------------------------------------------------------- *
+ *                OpenSim: SmoothSphereHalfSpaceForceGroup.h                  *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ContactHalfSpace.h"
+#include "ContactSphere.h"
+#include "Force.h"
+
+#include <vector>
+
+namespace OpenSim {
+
+class SmoothSphereHalfSpaceForce;
+
+/** The parameters and geometry of one sphere-half-space contact of a
+SmoothSphereHalfSpaceForceGroup. The properties have the same meaning and
+default values as those of SmoothSphereHalfSpaceForce. */
+class OSIMSIMULATION_API SmoothSphereHalfSpaceForceGroup_Contact
+        : public Component {
+    OpenSim_DECLARE_CONCRETE_OBJECT(
+            SmoothSphereHalfSpaceForceGroup_Contact, Component);
+public:
+    OpenSim_DECLARE_PROPERTY(stiffness, double,
+            "The stiffness constant (i.e., plain strain modulus), "
+            "default is 1 (N/m^2)");
+    OpenSim_DECLARE_PROPERTY(dissipation, double,
+            "The dissipation coefficient, default is 0 (s/m).");
+    OpenSim_DECLARE_PROPERTY(static_friction, double,
+            "The coefficient of static friction, default is 0.");
+    OpenSim_DECLARE_PROPERTY(dynamic_friction, double,
+            "The coefficient of dynamic friction, default is 0.");
+    OpenSim_DECLARE_PROPERTY(viscous_friction, double,
+            "The coefficient of viscous friction, default is 0.");
+    OpenSim_DECLARE_PROPERTY(transition_velocity, double,
+            "The transition velocity, default is 0.01 (m/s).");
+    OpenSim_DECLARE_PROPERTY(constant_contact_force, double,
+            "The constant that enforces non-null derivatives, "
+            "default is 1e-5 (N).");
+    OpenSim_DECLARE_PROPERTY(hertz_smoothing, double,
+            "The parameter that determines the smoothness of the transition "
+            "of the tanh used to smooth the Hertz force, default is 300.");
+    OpenSim_DECLARE_PROPERTY(hunt_crossley_smoothing, double,
+            "The parameter that determines the smoothness of the transition "
+            "of the tanh used to smooth the Hunt-Crossley force, "
+            "default is 50.");
+
+    OpenSim_DECLARE_SOCKET(sphere, ContactSphere,
+            "The sphere participating in this contact.");
+    OpenSim_DECLARE_SOCKET(half_space, ContactHalfSpace,
+            "The half-space participating in this contact.");
+
+    SmoothSphereHalfSpaceForceGroup_Contact();
+
+private:
+    void constructProperties();
+};
+
+/** The sphere-half-space contacts of a model (e.g., the 12 to 24 contact
+spheres of the feet of a gait model), whose forces are computed with the same
+smooth formulation as SmoothSphereHalfSpaceForce, but for all the contacts at
+once. Rather than one SimTK::Force per contact, each of which finds its bodies
+and transforms its geometry separately, the group gathers the positions and
+velocities of the spheres and half-spaces of all the contacts, computes the
+normal and friction forces of all the contacts in one loop over contiguous
+arrays of the kinematics and parameters (which the compiler can vectorize),
+and applies the forces to the bodies in one pass.
+
+The forces are stored in a cache variable once computed, so that the outputs
+(whose channels are the names of the contacts) and getRecordValues() do not
+compute them again. The record labels and the body forces of each contact are
+the same as those of a SmoothSphereHalfSpaceForce with the name of the
+contact.
+@code
+auto* group = new SmoothSphereHalfSpaceForceGroup();
+group->setName("contacts");
+group->addContact("heel_r", heelSphere, floor);
+group->addContact("toe_r", toeSphere, floor);
+model.addForce(group);
+@endcode
+
+@see SmoothSphereHalfSpaceForce */
+class OSIMSIMULATION_API SmoothSphereHalfSpaceForceGroup : public Force {
+    OpenSim_DECLARE_CONCRETE_OBJECT(SmoothSphereHalfSpaceForceGroup, Force);
+
+public:
+    //=========================================================================
+    // PROPERTIES
+    //=========================================================================
+    OpenSim_DECLARE_LIST_PROPERTY(contacts,
+            SmoothSphereHalfSpaceForceGroup_Contact,
+            "The sphere-half-space contacts whose forces this group "
+            "computes.");
+    OpenSim_DECLARE_PROPERTY(force_visualization_radius, double,
+            "The radius of the cylinders that visualize contact "
+            "forces generated by this force component. Default: 0.01 m");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(force_visualization_scale_factor, double,
+            "(Optional) The scale factor that determines the length of the "
+            "cylinders that visualize contact forces generated by this force "
+            "component. A cylinder will be one meter long when the contact "
+            "force magnitude is equal to this value. If this property is not "
+            "specified, the total weight of the model is used "
+            "as the scale factor.")
+
+    //=========================================================================
+    // OUTPUTS
+    //=========================================================================
+    OpenSim_DECLARE_LIST_OUTPUT(sphere_force, SimTK::SpatialVec,
+            getSphereForce, SimTK::Stage::Dynamics);
+    OpenSim_DECLARE_LIST_OUTPUT(half_space_force, SimTK::SpatialVec,
+            getHalfSpaceForce, SimTK::Stage::Dynamics);
+
+    //=========================================================================
+    // PUBLIC METHODS
+    //=========================================================================
+    SmoothSphereHalfSpaceForceGroup();
+
+    int getNumContacts() const { return getProperty_contacts().size(); }
+
+    /** Add a contact between `sphere` and `halfSpace` with the default
+    parameters, and return it so that its parameters can be set. */
+    SmoothSphereHalfSpaceForceGroup_Contact& addContact(
+            const std::string& name, const ContactSphere& sphere,
+            const ContactHalfSpace& halfSpace);
+
+    /** Add a contact with the name, parameters, and geometry of `force`
+    (e.g., to replace the SmoothSphereHalfSpaceForce%s of a model with a
+    group). `force` must be connected to its sphere and half-space. */
+    SmoothSphereHalfSpaceForceGroup_Contact& addContact(
+            const SmoothSphereHalfSpaceForce& force);
+
+    //=========================================================================
+    // REPORTING
+    //=========================================================================
+    /// The labels of the forces (XYZ) and torques (XYZ) applied on the sphere
+    /// followed by those applied on the half space, for each contact (see
+    /// SmoothSphereHalfSpaceForce::getRecordLabels()).
+    OpenSim::Array<std::string> getRecordLabels() const override;
+    /// The values that correspond to the labels, expressed in the ground
+    /// frame.
+    OpenSim::Array<double> getRecordValues(
+            const SimTK::State& state) const override;
+
+    /// The forces and torques applied to the sphere of the contact whose name
+    /// is `channel`, as with SmoothSphereHalfSpaceForce::getSphereForce().
+    SimTK::SpatialVec getSphereForce(
+            const SimTK::State& s, const std::string& channel) const;
+
+    /// The forces and torques applied to the half space of the contact whose
+    /// name is `channel`.
+    SimTK::SpatialVec getHalfSpaceForce(
+            const SimTK::State& s, const std::string& channel) const;
+
+    /// The forces and torques applied to the sphere of each contact, in the
+    /// order of the `contacts` property. `s` must be realized to
+    /// SimTK::Stage::Velocity.
+    const SimTK::Vector_<SimTK::SpatialVec>& getSphereForces(
+            const SimTK::State& s) const;
+    /// The forces and torques applied to the half space of each contact.
+    const SimTK::Vector_<SimTK::SpatialVec>& getHalfSpaceForces(
+            const SimTK::State& s) const;
+
+protected:
+    void computeForce(const SimTK::State& state,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& generalizedForces) const override;
+
+    void extendFinalizeFromProperties() override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+    void extendRealizeInstance(const SimTK::State& state) const override;
+    void generateDecorations(bool fixed, const ModelDisplayHints& hints,
+            const SimTK::State& state,
+            SimTK::Array_<SimTK::DecorativeGeometry>& geometry) const override;
+
+private:
+    void constructProperties();
+    int getContactIndex(const std::string& name) const;
+    /// Compute the forces of all the contacts and store them in the cache
+    /// variables (if they are not valid already).
+    void calcContactForces(const SimTK::State& s) const;
+
+    mutable double m_forceVizScaleFactor;
+
+    // The geometry of the contacts, which is fixed once the system is created:
+    // the mobilized bodies of the sphere and of the half-space, the location
+    // of the center of the sphere in its body, the radius of the sphere, and
+    // the outward normal and origin of the half-space in its body.
+    mutable std::vector<SimTK::MobilizedBodyIndex> m_sphereBodies;
+    mutable std::vector<SimTK::MobilizedBodyIndex> m_halfSpaceBodies;
+    mutable std::vector<SimTK::Vec3> m_sphereLocations;
+    mutable std::vector<double> m_radii;
+    mutable std::vector<SimTK::Vec3> m_halfSpaceNormals;
+    mutable std::vector<SimTK::Vec3> m_halfSpaceOrigins;
+    // The parameters of contact i are at index i of each row (see the .cpp
+    // file for the rows).
+    mutable std::vector<double> m_parameters;
+
+    mutable CacheVariable<SimTK::Vector_<SimTK::SpatialVec>> _sphereForcesCV;
+    mutable CacheVariable<SimTK::Vector_<SimTK::SpatialVec>>
+            _halfSpaceForcesCV;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_SMOOTH_SPHERE_HALF_SPACE_FORCE_GROUP_H_
@@ -0,0 +1,78 @@
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  ModelPool.cpp                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ModelPool.h"
+
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Simulation/Model/Model.h>
+
+using namespace OpenSim;
+
+ModelPool::ModelPool(const Model& model, int numModels)
+        : m_source(model.clone()) {
+    const int n = getNumThreadsOrDefault(numModels);
+    m_models.resize(n);
+    m_initialStates.resize(n);
+    m_states.resize(n);
+}
+
+ModelPool::~ModelPool() = default;
+
+Model& ModelPool::updModel(int index) {
+    OPENSIM_THROW_IF(index < 0 || index >= getNumModels(), IndexOutOfRange,
+            (size_t)index, 0, (size_t)getNumModels() - 1);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_models[index]) {
+        std::unique_ptr<Model> model(m_source->clone());
+        model->finalizeFromProperties();
+        const SimTK::State& state = model->initSystem();
+        m_initialStates[index].reset(new SimTK::State(state));
+        m_states[index].reset(new SimTK::State(state));
+        m_models[index] = std::move(model);
+    }
+    return *m_models[index];
+}
+
+SimTK::State& ModelPool::updState(int index) {
+    updModel(index);
+    return *m_states[index];
+}
+
+SimTK::State& ModelPool::resetState(int index) {
+    updModel(index);
+    *m_states[index] = *m_initialStates[index];
+    return *m_states[index];
+}
+
+void ModelPool::parallelFor(int size, const std::function<void(Model& model,
+        SimTK::State& state, int index)>& func) {
+    parallelForChunks(size, getNumModels(),
+            [&](int chunk, int begin, int end) {
+                Model& model = updModel(chunk);
+                SimTK::State& state = *m_states[chunk];
+                for (int i = begin; i < end; ++i) func(model, state, i);
+            });
+}
+
+void ModelPool::setTime(SimTK::State& state, double time) {
+    state.setTime(time);
+}
@@ -0,0 +1,134 @@
+#ifndef OPENSIM_MODEL_POOL_H_
+#define OPENSIM_MODEL_POOL_H_
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  ModelPool.h                             *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimSimulationDLL.h"
+#include <OpenSim/Common/TimeSeriesTable.h>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace SimTK {
+class State;
+}
+
+namespace OpenSim {
+
+class Model;
+
+/** A fixed number of independent copies of a model, each with its own
+SimTK::State, for evaluating the model on multiple threads. Although threads
+may realize distinct States of one Model at the same time (see Model), a Model
+must not be modified, and a State and most solvers must not be used, by more
+than one thread at a time; with a pool, each thread uses its own copy:
+
+@code
+ModelPool pool(model);
+pool.parallelForFrames(table,
+        [&](Model& model, SimTK::State& state, int row) {
+    // state.getTime() is the time of the row.
+    ...
+});
+@endcode
+
+The copies are made from a copy of the source model that the pool takes at
+construction (later changes to the source model do not affect the pool). Each
+copy is cloned and initialized (initSystem()) the first time it is used, so
+that a pool with more copies than a computation needs costs nothing for the
+unused copies. Making the copies is serialized, since constructing models is
+not guaranteed to be thread-safe; using them is not.
+
+In parallelFor() and parallelForFrames(), each thread processes a contiguous
+range of indices (frames) in order with the same copy, so that the state from
+one frame can be used as the initial guess for the next (e.g., for tracking
+with an InverseKinematicsSolver). Use resetState() to start from the initial
+state of the model instead. */
+class OSIMSIMULATION_API ModelPool {
+public:
+    /** Create a pool of `numModels` copies of `model`. If `numModels` is not
+    positive, the number of hardware threads is used (see
+    getNumThreadsOrDefault()). */
+    explicit ModelPool(const Model& model, int numModels = -1);
+    ~ModelPool();
+
+    ModelPool(const ModelPool&) = delete;
+    ModelPool& operator=(const ModelPool&) = delete;
+
+    /** The number of copies of the model in the pool, which is also the
+    maximum number of threads of parallelFor(). */
+    int getNumModels() const { return (int)m_models.size(); }
+
+    /** The copy of the model with the given index (in [0, getNumModels())),
+    which is cloned and initialized if this is its first use. */
+    Model& updModel(int index);
+
+    /** The working state of the copy of the model with the given index. It
+    starts as the state returned by initSystem() and keeps the changes made
+    to it between uses of the copy. */
+    SimTK::State& updState(int index);
+
+    /** Reset the working state of the copy with the given index to the
+    state returned by initSystem() (a copy of a State, which is much cheaper
+    than initializing the system again), and return it. */
+    SimTK::State& resetState(int index);
+
+    /** Invoke `func(model, state, index)` for each index in [0, size), with
+    the indices split into contiguous ranges, one per thread (at most
+    getNumModels() threads), and `model` and `state` the copy and working
+    state of the thread. If `func` throws, the first exception is rethrown
+    after all the threads finish (see parallelForChunks()). */
+    void parallelFor(int size, const std::function<void(Model& model,
+            SimTK::State& state, int index)>& func);
+
+    /** Invoke `func(model, state, row)` for each row of `table`, as with
+    parallelFor(), after setting the time of `state` to the time of the
+    row. */
+    template <typename ETY>
+    void parallelForFrames(const TimeSeriesTable_<ETY>& table,
+            const std::function<void(Model& model, SimTK::State& state,
+                    int row)>& func) {
+        const auto& times = table.getIndependentColumn();
+        parallelFor((int)table.getNumRows(),
+                [&](Model& model, SimTK::State& state, int row) {
+                    setTime(state, times[row]);
+                    func(model, state, row);
+                });
+    }
+
+private:
+    // Defined in the .cpp file, so that this header need not include the
+    // headers of SimTK::State.
+    static void setTime(SimTK::State& state, double time);
+
+    std::unique_ptr<Model> m_source;
+    std::vector<std::unique_ptr<Model>> m_models;
+    std::vector<std::unique_ptr<SimTK::State>> m_initialStates;
+    std::vector<std::unique_ptr<SimTK::State>> m_states;
+    std::mutex m_mutex;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MODEL_POOL_H_
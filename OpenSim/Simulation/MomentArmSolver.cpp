@@ -24,6 +24,10 @@
 #include "MomentArmSolver.h"
 #include "Model/PointForceDirection.h"
 #include "Model/Model.h"
+#include <OpenSim/Common/CommonUtilities.h>
+
+#include <algorithm>
+#include <memory>
 
 using namespace std;
 using namespace SimTK;
@@ -132,6 +136,119 @@ double MomentArmSolver::solve(const State &state, const Coordinate &aCoord,
     return ~_coupling*_generalizedForces;
 }
 
+void MomentArmSolver::solve(const State& state,
+        const std::vector<const Coordinate*>& coordinates,
+        const std::vector<const GeometryPath*>& paths,
+        Vector& lengths, Matrix& momentArms) const
+{
+    const int nc = (int)coordinates.size();
+    const int np = (int)paths.size();
+    lengths.resize(np);
+    momentArms.resize(np, nc);
+
+    //Local modifiable copy of the state
+    State& s_ma = _stateCopy;
+    s_ma.updQ() = state.getQ();
+
+    // compute the coupling between coordinates due to constraints, once for
+    // all paths
+    std::vector<Vector> couplings(nc);
+    for (int j = 0; j < nc; ++j)
+        couplings[j] = computeCouplingVector(s_ma, *coordinates[j]);
+
+    // set speeds to zero
+    s_ma.updU() = 0;
+
+    Vector pathDependentMobilityForces(s_ma.getNU());
+    for (int k = 0; k < np; ++k) {
+        // The wrapping computed for the length is reused by the forces.
+        lengths[k] = paths[k]->getLength(s_ma);
+
+        // apply a tension of unity to the bodies of the path
+        _bodyForces *= 0;
+        pathDependentMobilityForces = 0;
+        paths[k]->addInEquivalentForces(s_ma, 1.0, _bodyForces,
+                pathDependentMobilityForces);
+
+        // f = ~J(q) * F, once per path for all coordinates
+        getModel().getMultibodySystem().getMatterSubsystem()
+            .multiplyBySystemJacobianTranspose(s_ma, _bodyForces,
+                    _generalizedForces);
+        _generalizedForces += pathDependentMobilityForces;
+
+        for (int j = 0; j < nc; ++j)
+            momentArms(k, j) = ~couplings[j]*_generalizedForces;
+    }
+}
+
+void MomentArmSolver::solve(const Matrix& qTrajectory,
+        const std::vector<const Coordinate*>& coordinates,
+        const std::vector<const GeometryPath*>& paths,
+        Matrix& lengths, std::vector<Matrix>& momentArms,
+        int numThreads) const
+{
+    const int nf = qTrajectory.nrow();
+    const int nc = (int)coordinates.size();
+    const int np = (int)paths.size();
+    if (qTrajectory.ncol() != _stateCopy.getNQ()) {
+        throw Exception("MomentArmSolver::solve qTrajectory must have 'nq' "
+                        "columns.");
+    }
+    lengths.resize(nf, np);
+    momentArms.assign(np, Matrix(nf, nc));
+    if (nf == 0) { return; }
+    numThreads = std::min(getNumThreadsOrDefault(numThreads), nf);
+
+    // The first block is solved with this solver and model; the others with
+    // copies of the model (and their own solvers), created here on the
+    // calling thread.
+    struct Worker {
+        std::unique_ptr<Model> model;
+        std::unique_ptr<MomentArmSolver> solver;
+        std::vector<const Coordinate*> coordinates;
+        std::vector<const GeometryPath*> paths;
+        State state;
+    };
+    std::vector<Worker> workers(numThreads);
+    workers[0].coordinates = coordinates;
+    workers[0].paths = paths;
+    workers[0].state = _stateCopy;
+    for (int t = 1; t < numThreads; ++t) {
+        Worker& worker = workers[t];
+        worker.model.reset(getModel().clone());
+        worker.model->finalizeFromProperties();
+        worker.state = worker.model->initSystem();
+        worker.solver.reset(new MomentArmSolver(*worker.model));
+        for (const auto* coordinate : coordinates) {
+            worker.coordinates.push_back(
+                    &worker.model->getComponent<Coordinate>(
+                            coordinate->getAbsolutePathString()));
+        }
+        for (const auto* path : paths) {
+            worker.paths.push_back(&worker.model->getComponent<GeometryPath>(
+                    path->getAbsolutePathString()));
+        }
+    }
+
+    parallelForChunks(nf, numThreads,
+            [&](int chunk, int begin, int end) {
+                Worker& worker = workers[chunk];
+                const MomentArmSolver& solver =
+                        worker.solver ? *worker.solver : *this;
+                Vector frameLengths;
+                Matrix frameMomentArms;
+                for (int i = begin; i < end; ++i) {
+                    worker.state.updQ() = ~qTrajectory[i];
+                    solver.solve(worker.state, worker.coordinates,
+                            worker.paths, frameLengths, frameMomentArms);
+                    lengths.updRow(i) = ~frameLengths;
+                    for (int k = 0; k < np; ++k) {
+                        momentArms[k].updRow(i) = frameMomentArms[k];
+                    }
+                }
+            });
+}
+
 SimTK::Vector MomentArmSolver::computeCouplingVector(SimTK::State &state, 
         const Coordinate &coordinate) const
 {
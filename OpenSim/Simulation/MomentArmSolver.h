@@ -26,6 +26,8 @@
 #include "Solver.h"
 #include "SimTKcommon/internal/State.h"
 
+#include <vector>
+
 namespace OpenSim {
 
 class GeometryPath;
@@ -83,6 +85,50 @@ public:
     double solve(const SimTK::State& state, const Coordinate &coordinate, 
         const Array<PointForceDirection *> &pfds) const;
 
+#ifndef SWIG
+    /** Solve for the lengths of several GeometryPaths and their moment-arms
+        about several coordinates at once. The coupling between coordinates
+        due to constraints is computed once per coordinate, and the
+        generalized forces due to a unit tension once per path, instead of
+        once per path and coordinate as when calling solve() for each pair.
+    @param  state               current state of the model
+    @param  coordinates         Coordinates about which we want the moment-arms
+    @param  paths               GeometryPaths for which to calculate lengths
+                                and moment-arms
+    @param  lengths             resulting length of each path
+    @param  momentArms          resulting moment-arms (rows: paths, columns:
+                                coordinates)
+    */
+    void solve(const SimTK::State& state,
+        const std::vector<const Coordinate*>& coordinates,
+        const std::vector<const GeometryPath*>& paths,
+        SimTK::Vector& lengths, SimTK::Matrix& momentArms) const;
+
+    /** Solve for the lengths of several GeometryPaths and their moment-arms
+        about several coordinates (as above) at every frame of a trajectory
+        of generalized coordinates. Contiguous blocks of frames are solved
+        concurrently. Since evaluating the paths (e.g., wrapping) is not
+        thread-safe, each additional thread uses its own copy of the model.
+    @param  qTrajectory         generalized coordinates (rows: frames,
+                                columns: q's in the order of the State)
+    @param  coordinates         Coordinates (of this solver's model) about
+                                which we want the moment-arms
+    @param  paths               GeometryPaths (of this solver's model) for
+                                which to calculate lengths and moment-arms
+    @param  lengths             resulting lengths (rows: frames, columns:
+                                paths)
+    @param  momentArms          resulting moment-arms, one Matrix per path
+                                (rows: frames, columns: coordinates)
+    @param  numThreads          number of threads; -1 (default) uses all
+                                available hardware threads
+    */
+    void solve(const SimTK::Matrix& qTrajectory,
+        const std::vector<const Coordinate*>& coordinates,
+        const std::vector<const GeometryPath*>& paths,
+        SimTK::Matrix& lengths, std::vector<SimTK::Matrix>& momentArms,
+        int numThreads = -1) const;
+#endif
+
 private:
     // Internal state of the solver initialized as a copy of the default state
     mutable SimTK::State _stateCopy;
@@ -71,7 +71,11 @@ void OpenSim::OpenSenseUtilities::rotateOrientationTable(
                 quaternionsTable,
         const SimTK::Rotation_<double>& rotationMatrix)
 {
-    SimTK::Rotation R_XG = rotationMatrix;
+    // Rotate the quaternions directly (q_XG*q) rather than converting each
+    // one to a Rotation and back; the result is normalized and has a
+    // nonnegative w, as with Rotation::convertRotationToQuaternion().
+    const Quaternion q_XG = rotationMatrix.convertRotationToQuaternion();
+    const double w0 = q_XG[0], x0 = q_XG[1], y0 = q_XG[2], z0 = q_XG[3];
 
     int nc = int(quaternionsTable.getNumColumns());
     size_t nt = quaternionsTable.getNumRows();
@@ -79,9 +83,14 @@ void OpenSim::OpenSenseUtilities::rotateOrientationTable(
     for (size_t i = 0; i < nt; ++i) {
         auto quatRow = quaternionsTable.updRowAtIndex(i);
         for (int j = 0; j < nc; ++j) {
-            // This can be done completely in Quaternions but this is easier to debug for now
-            Quaternion quatO = (R_XG * Rotation(quatRow[j])).convertRotationToQuaternion();
-            quatRow[j] = quatO;
+            Quaternion& q = quatRow[j];
+            const double w = q[0], x = q[1], y = q[2], z = q[3];
+            Vec4 quatO(w0*w - x0*x - y0*y - z0*z,
+                       w0*x + x0*w + y0*z - z0*y,
+                       w0*y - x0*z + y0*w + z0*x,
+                       w0*z + x0*y - y0*x + z0*w);
+            if (quatO[0] < 0) quatO = -quatO;
+            q = Quaternion(quatO);
         }
     }
     return;
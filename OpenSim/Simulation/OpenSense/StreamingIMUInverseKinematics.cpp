@@ -0,0 +1,294 @@
+/* -------------------------------------------------------------------------- *
+ *               OpenSim: StreamingIMUInverseKinematics.cpp                   *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "StreamingIMUInverseKinematics.h"
+
+#include <OpenSim/Common/Logger.h>
+
+#include <algorithm>
+
+using namespace OpenSim;
+
+namespace {
+    double secondsBetween(const std::chrono::steady_clock::time_point& begin,
+            const std::chrono::steady_clock::time_point& end) {
+        return std::chrono::duration<double>(end - begin).count();
+    }
+}
+
+StreamingIMUInverseKinematics::StreamingIMUInverseKinematics(
+        const Model& model, const std::vector<std::string>& sensorNames,
+        const Set<OrientationWeight>* orientationWeightSet)
+        : m_model(model), m_sensorNames(sensorNames) {
+    OPENSIM_THROW_IF(sensorNames.empty(), Exception,
+            "Expected at least one sensor name.");
+    // The frames are queued by the engine, so the reference has no data of
+    // its own: only the names (and weights) of the sensors.
+    TimeSeriesTable_<SimTK::Rotation> orientationsData;
+    orientationsData.setColumnLabels(sensorNames);
+    m_orientationsReference = std::make_shared<BufferedOrientationsReference>(
+            orientationsData, orientationWeightSet);
+
+    m_model.finalizeFromProperties();
+    const CoordinateSet& coordinates = m_model.getCoordinateSet();
+    for (int i = 0; i < coordinates.getSize(); ++i) {
+        m_coordinateNames.push_back(coordinates[i].getName());
+    }
+}
+
+StreamingIMUInverseKinematics::~StreamingIMUInverseKinematics() {
+    try {
+        stop(false);
+    } catch (const std::exception& e) {
+        log_error("StreamingIMUInverseKinematics: {}", e.what());
+    }
+}
+
+void StreamingIMUInverseKinematics::setAccuracy(double accuracy) {
+    OPENSIM_THROW_IF(isRunning(), Exception,
+            "Cannot change the accuracy while running.");
+    m_accuracy = accuracy;
+}
+
+void StreamingIMUInverseKinematics::setDeadline(double deadline) {
+    OPENSIM_THROW_IF(isRunning(), Exception,
+            "Cannot change the deadline while running.");
+    OPENSIM_THROW_IF(!(deadline >= 0), Exception,
+            "Expected a nonnegative deadline, but got {}.", deadline);
+    m_deadline = deadline;
+}
+
+void StreamingIMUInverseKinematics::setQueueCapacity(int capacity) {
+    OPENSIM_THROW_IF(isRunning(), Exception,
+            "Cannot change the queue capacity while running.");
+    OPENSIM_THROW_IF(capacity <= 0, Exception,
+            "Expected a positive queue capacity, but got {}.", capacity);
+    m_capacity = capacity;
+}
+
+void StreamingIMUInverseKinematics::setListener(Listener listener) {
+    OPENSIM_THROW_IF(isRunning(), Exception,
+            "Cannot change the listener while running.");
+    m_listener = std::move(listener);
+}
+
+void StreamingIMUInverseKinematics::start() {
+    OPENSIM_THROW_IF(isRunning(), Exception, "Already running.");
+    if (m_thread.joinable()) m_thread.join();
+
+    m_state = m_model.initSystem();
+    const CoordinateSet& coordinates = m_model.getCoordinateSet();
+    m_coordinates.clear();
+    for (int i = 0; i < coordinates.getSize(); ++i) {
+        m_coordinates.push_back(&coordinates[i]);
+    }
+
+    // One frame is put into the reference right before the solver takes it
+    // out (see solveFrame()).
+    m_orientationsReference->setBufferCapacity(2);
+    SimTK::Array_<CoordinateReference> coordinateReferences;
+    m_solver.reset(new InverseKinematicsSolver(m_model, nullptr,
+            m_orientationsReference, coordinateReferences));
+    m_solver->setAccuracy(m_accuracy);
+    m_solver->setAdvanceTimeFromReference(true);
+    m_assembled = false;
+
+    const int numSensors = static_cast<int>(m_sensorNames.size());
+    m_frames.reserve(m_capacity, numSensors);
+    m_arrivals.assign(m_capacity, Clock::time_point());
+    m_numPushed = 0;
+    m_numPopped = 0;
+    m_frame.resize(numSensors);
+
+    const int numCoordinates = static_cast<int>(m_coordinates.size());
+    m_values.resize(numCoordinates);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_latestTime = SimTK::NaN;
+        m_latestValues.resize(numCoordinates);
+        m_numFramesSkipped = 0;
+        m_numFramesSolved = 0;
+        m_numFramesFailed = 0;
+        m_totalLatency = 0;
+        m_maxLatency = 0;
+        m_totalSolveTime = 0;
+        m_maxSolveTime = 0;
+        m_startTime = Clock::now();
+        m_stopTime = m_startTime;
+    }
+    m_numFramesReceived.store(0);
+    m_numFramesRejected.store(0);
+    m_exception = nullptr;
+
+    m_drain.store(true);
+    m_running.store(true);
+    m_thread = std::thread(&StreamingIMUInverseKinematics::solveFrames, this);
+}
+
+void StreamingIMUInverseKinematics::stop(bool drain) {
+    if (!m_thread.joinable()) return;
+    m_drain.store(drain);
+    m_running.store(false);
+    m_thread.join();
+    if (m_exception) {
+        std::exception_ptr exception = m_exception;
+        m_exception = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+bool StreamingIMUInverseKinematics::pushFrame(double time,
+        const SimTK::RowVectorView_<SimTK::Rotation>& orientations) {
+    ++m_numFramesReceived;
+    // Only the solver thread makes room in the queue, so the slot of this
+    // frame stays free until it is pushed.
+    if (!isRunning() || m_frames.getSize() >= m_capacity) {
+        ++m_numFramesRejected;
+        return false;
+    }
+    m_arrivals[m_numPushed % m_capacity] = Clock::now();
+    m_frames.try_push_back(time, orientations);
+    ++m_numPushed;
+    return true;
+}
+
+bool StreamingIMUInverseKinematics::getLatestSolution(
+        double& time, SimTK::Vector& values) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_numFramesSolved == 0) return false;
+    time = m_latestTime;
+    values = m_latestValues;
+    return true;
+}
+
+StreamingIMUInverseKinematics::Statistics
+StreamingIMUInverseKinematics::getStatistics() const {
+    Statistics stats;
+    stats.numFramesReceived = m_numFramesReceived.load();
+    stats.numFramesRejected = m_numFramesRejected.load();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    stats.numFramesSkipped = m_numFramesSkipped;
+    stats.numFramesSolved = m_numFramesSolved;
+    stats.numFramesFailed = m_numFramesFailed;
+    const int numFrames = m_numFramesSolved + m_numFramesFailed;
+    if (numFrames > 0) {
+        stats.meanLatency = m_totalLatency / numFrames;
+        stats.maxLatency = m_maxLatency;
+        stats.meanSolveTime = m_totalSolveTime / numFrames;
+        stats.maxSolveTime = m_maxSolveTime;
+    }
+    const double elapsed = secondsBetween(m_startTime,
+            isRunning() ? Clock::now() : m_stopTime);
+    if (elapsed > 0) stats.throughput = m_numFramesSolved / elapsed;
+    return stats;
+}
+
+void StreamingIMUInverseKinematics::solveFrames() {
+    double time;
+    Clock::time_point arrival;
+    try {
+        while (m_running.load() || m_drain.load()) {
+            if (!popFrame(time, arrival)) {
+                if (!m_running.load()) break;
+                std::this_thread::yield();
+                continue;
+            }
+            // If solving fell behind, skip to the newest frame that still
+            // meets the deadline (or to the newest frame).
+            int numSkipped = 0;
+            while (m_frames.getSize() > 0 &&
+                    secondsBetween(arrival, Clock::now()) > m_deadline) {
+                popFrame(time, arrival);
+                ++numSkipped;
+            }
+            if (numSkipped) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_numFramesSkipped += numSkipped;
+            }
+            solveFrame(time, arrival);
+        }
+    } catch (...) {
+        m_exception = std::current_exception();
+        m_running.store(false);
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopTime = Clock::now();
+}
+
+bool StreamingIMUInverseKinematics::popFrame(
+        double& time, Clock::time_point& arrival) {
+    // Read the arrival time before popping the frame, since the producer may
+    // reuse the slot as soon as the frame is popped.
+    if (m_frames.getSize() == 0) return false;
+    arrival = m_arrivals[m_numPopped % m_capacity];
+    m_frames.try_pop_front(time, m_frame);
+    ++m_numPopped;
+    return true;
+}
+
+void StreamingIMUInverseKinematics::solveFrame(
+        double time, const Clock::time_point& arrival) {
+    const Clock::time_point solveStart = Clock::now();
+    // The solver takes the frame out of the reference when it updates its
+    // goals (see InverseKinematicsSolver::setAdvanceTimeFromReference()).
+    m_orientationsReference->putValues(time, m_frame);
+    bool solved = true;
+    if (!m_assembled) {
+        // Without a solution to track, the first frame must be assembled;
+        // if that fails, there is nothing to track and the engine stops.
+        m_solver->assemble(m_state);
+        m_state.setTime(time);
+        m_assembled = true;
+    } else {
+        try {
+            m_solver->track(m_state);
+        } catch (const std::exception& e) {
+            log_warn("StreamingIMUInverseKinematics: Failed to solve the "
+                     "frame at time {}: {}", time, e.what());
+            solved = false;
+        }
+    }
+    if (solved) {
+        for (int i = 0; i < m_values.size(); ++i) {
+            m_values[i] = m_coordinates[i]->getValue(m_state);
+        }
+    }
+
+    const Clock::time_point solveEnd = Clock::now();
+    const double latency = secondsBetween(arrival, solveEnd);
+    const double solveTime = secondsBetween(solveStart, solveEnd);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (solved) {
+            m_latestTime = time;
+            m_latestValues = m_values;
+            ++m_numFramesSolved;
+        } else {
+            ++m_numFramesFailed;
+        }
+        m_totalLatency += latency;
+        m_maxLatency = std::max(m_maxLatency, latency);
+        m_totalSolveTime += solveTime;
+        m_maxSolveTime = std::max(m_maxSolveTime, solveTime);
+    }
+    if (solved && m_listener) m_listener(time, m_values);
+}
@@ -0,0 +1,222 @@
+#ifndef OPENSIM_STREAMING_IMU_INVERSE_KINEMATICS_H_
+#define OPENSIM_STREAMING_IMU_INVERSE_KINEMATICS_H_
+/* -------------------------------------------------------------------------- *
+ *                OpenSim: StreamingIMUInverseKinematics.h                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Common/DataQueue.h>
+#include <OpenSim/Simulation/BufferedOrientationsReference.h>
+#include <OpenSim/Simulation/InverseKinematicsSolver.h>
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OpenSim {
+
+/**
+ * Inverse kinematics of live orientation (IMU) data: frames of sensor
+ * orientations are pushed from a producer thread (e.g., the callback of a
+ * device driver), and are solved on a solver thread with an
+ * InverseKinematicsSolver whose orientations are the frames of a
+ * BufferedOrientationsReference. The coordinate values of each solved frame
+ * are published to a listener and can be polled with getLatestSolution().
+ *
+ * The frames are passed to the solver thread through a bounded,
+ * single-producer/single-consumer ring buffer (see DataQueue_::reserve()), so
+ * pushFrame() neither blocks nor allocates memory; if the queue is full, the
+ * frame is rejected. The solver tracks the previous solution (see
+ * AssemblySolver::track()), so each frame costs a few iterations of the
+ * assembler when the frames are close together. If solving falls behind the
+ * data, frames that waited in the queue for longer than the deadline are
+ * skipped in favor of newer frames (the newest frame is always solved), which
+ * bounds the latency of the published solutions.
+ *
+ * The orientations must be expressed in the ground frame of the model (e.g.,
+ * after OpenSenseUtilities::rotateOrientationTable()), and the model must
+ * have a calibrated frame for each sensor name (see IMUPlacer). As with
+ * IMUInverseKinematicsTool, translational coordinates cannot be determined
+ * from orientations and should be locked.
+ * @code
+ * StreamingIMUInverseKinematics ik(model, {"pelvis_imu", "femur_r_imu"});
+ * ik.setDeadline(0.02);
+ * ik.setListener([](double time, const SimTK::Vector& q) { ... });
+ * ik.start();
+ * // From the producer thread:
+ * ik.pushFrame(time, orientations);
+ * // ...
+ * ik.stop();
+ * log_info("{}", ik.getStatistics().meanLatency);
+ * @endcode
+ */
+class OSIMSIMULATION_API StreamingIMUInverseKinematics {
+public:
+    /** Counters of the frames and of the time it took to solve them. The
+    latency of a frame is the wall-clock time from its pushFrame() to the
+    publication of its solution. */
+    struct Statistics {
+        /// Frames passed to pushFrame(), including rejected frames.
+        int numFramesReceived = 0;
+        /// Frames that pushFrame() rejected because the queue was full.
+        int numFramesRejected = 0;
+        /// Frames that were skipped because they missed the deadline.
+        int numFramesSkipped = 0;
+        int numFramesSolved = 0;
+        /// Frames for which the solver threw (the previous solution is kept).
+        int numFramesFailed = 0;
+        double meanLatency = SimTK::NaN;
+        double maxLatency = SimTK::NaN;
+        double meanSolveTime = SimTK::NaN;
+        double maxSolveTime = SimTK::NaN;
+        /// Solved frames per second of wall-clock time since start().
+        double throughput = SimTK::NaN;
+    };
+
+    /** Called on the solver thread with the time of each solved frame and
+    the values of the coordinates (in the order of getCoordinateNames()). The
+    listener should return quickly, since it delays the next frame. */
+    typedef std::function<void(double time, const SimTK::Vector& values)>
+            Listener;
+
+    /** Track the orientations of the model frames named `sensorNames` (in the
+    order of the orientations of each frame) with a copy of `model`. */
+    StreamingIMUInverseKinematics(const Model& model,
+            const std::vector<std::string>& sensorNames,
+            const Set<OrientationWeight>* orientationWeightSet = nullptr);
+    ~StreamingIMUInverseKinematics();
+
+    StreamingIMUInverseKinematics(
+            const StreamingIMUInverseKinematics&) = delete;
+    StreamingIMUInverseKinematics& operator=(
+            const StreamingIMUInverseKinematics&) = delete;
+
+    /// @name Settings (these cannot be changed while running)
+    /// @{
+    /** The accuracy of each solution (see AssemblySolver::setAccuracy()).
+    Default: 1e-4, as in IMUInverseKinematicsTool. */
+    void setAccuracy(double accuracy);
+    double getAccuracy() const { return m_accuracy; }
+    /** The maximum time (in seconds) that a frame may wait in the queue
+    before it is solved, if newer frames are queued. Default: Infinity (all
+    frames are solved). */
+    void setDeadline(double deadline);
+    double getDeadline() const { return m_deadline; }
+    /** The number of frames that the queue can hold. Default: 64. */
+    void setQueueCapacity(int capacity);
+    int getQueueCapacity() const { return m_capacity; }
+    void setListener(Listener listener);
+    /// @}
+
+    /** The names of the coordinates of the model, in the order of the values
+    of each solution. */
+    const std::vector<std::string>& getCoordinateNames() const {
+        return m_coordinateNames;
+    }
+    const std::vector<std::string>& getSensorNames() const {
+        return m_sensorNames;
+    }
+
+    /** Initialize the system of the model copy and start the solver thread.
+    The first frame is assembled from the default pose of the model, and the
+    following frames are tracked. Any statistics of a previous run are
+    reset. */
+    void start();
+    /** Stop the solver thread, after solving (or skipping) the frames that
+    are queued if `drain` is true, or discarding them otherwise. If the first
+    frame could not be assembled, stop() rethrows the exception. */
+    void stop(bool drain = true);
+    bool isRunning() const { return m_running.load(); }
+
+    /** Queue a frame with an orientation for each sensor. This can be called
+    from one producer thread (at a time), and does not wait or allocate
+    memory. Returns false if the frame was rejected because the queue is full
+    or the engine is not running. */
+    bool pushFrame(double time,
+            const SimTK::RowVectorView_<SimTK::Rotation>& orientations);
+
+    /** Copy the time and coordinate values of the most recently solved
+    frame. Returns false if no frame has been solved since start(). */
+    bool getLatestSolution(double& time, SimTK::Vector& values) const;
+
+    Statistics getStatistics() const;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    void solveFrames();
+    bool popFrame(double& time, Clock::time_point& arrival);
+    void solveFrame(double time, const Clock::time_point& arrival);
+
+    Model m_model;
+    std::vector<std::string> m_sensorNames;
+    std::vector<std::string> m_coordinateNames;
+    std::vector<const Coordinate*> m_coordinates;
+    std::shared_ptr<BufferedOrientationsReference> m_orientationsReference;
+    std::unique_ptr<InverseKinematicsSolver> m_solver;
+    SimTK::State m_state;
+    double m_accuracy = 1e-4;
+    double m_deadline = SimTK::Infinity;
+    int m_capacity = 64;
+    Listener m_listener;
+
+    // The frames queued by pushFrame() and the wall-clock time at which each
+    // was pushed; the arrival time of the i-th pushed frame is at index
+    // i % m_capacity (a slot is written only once its frame is popped).
+    DataQueue_<SimTK::Rotation> m_frames;
+    std::vector<Clock::time_point> m_arrivals;
+    size_t m_numPushed = 0;
+    size_t m_numPopped = 0;
+    SimTK::RowVector_<SimTK::Rotation> m_frame;
+
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_drain{true};
+    bool m_assembled = false;
+    std::exception_ptr m_exception;
+
+    // The latest solution and the statistics, which are written by the
+    // solver thread and read by any thread.
+    mutable std::mutex m_mutex;
+    Clock::time_point m_startTime;
+    Clock::time_point m_stopTime;
+    double m_latestTime = SimTK::NaN;
+    SimTK::Vector m_latestValues;
+    SimTK::Vector m_values;
+    std::atomic<int> m_numFramesReceived{0};
+    std::atomic<int> m_numFramesRejected{0};
+    int m_numFramesSkipped = 0;
+    int m_numFramesSolved = 0;
+    int m_numFramesFailed = 0;
+    double m_totalLatency = 0;
+    double m_maxLatency = 0;
+    double m_totalSolveTime = 0;
+    double m_maxSolveTime = 0;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_STREAMING_IMU_INVERSE_KINEMATICS_H_
@@ -19,6 +19,7 @@
 #include "PositionMotion.h"
 
 #include <OpenSim/Common/Function.h>
+#include <OpenSim/Common/GCVSpline.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Moco/MocoUtilities.h>
 #include <OpenSim/Simulation/Model/Model.h>
@@ -27,11 +28,64 @@
 
 using namespace OpenSim;
 
+namespace {
+/// The functions, if they are all GCVSplines with the same knots; otherwise,
+/// empty.
+std::vector<const GCVSpline*> getSplinesWithSameKnots(
+        const FunctionSet& functions) {
+    std::vector<const GCVSpline*> splines;
+    for (int i = 0; i < functions.getSize(); ++i) {
+        const auto* spline = dynamic_cast<const GCVSpline*>(&functions.get(i));
+        if (!spline || (i && !spline->hasSameKnots(*splines[0]))) return {};
+        splines.push_back(spline);
+    }
+    return splines;
+}
+
+/// Evaluate the values, speeds, and accelerations (rows 0, 1, and 2) of the
+/// functions (columns) at a time.
+void calcKinematics(const FunctionSet& functions,
+        const std::vector<const GCVSpline*>& splines, double time,
+        int& interval, SimTK::Matrix& kinematics) {
+    const int numFunctions = functions.getSize();
+    kinematics.resize(3, numFunctions);
+    if (!splines.empty()) {
+        // The splines have the same knots, so the weights of their
+        // coefficients are computed once for all of them.
+        thread_local SimTK::Matrix weights;
+        int first = 0;
+        splines[0]->calcCoefficientWeights(time, 2, interval, first, weights);
+        for (int i = 0; i < numFunctions; ++i) {
+            for (int order = 0; order < 3; ++order) {
+                kinematics(order, i) =
+                        splines[i]->evaluate(order, first, weights);
+            }
+        }
+    } else {
+        static const std::vector<int> qdotDerivComponents = {0};
+        static const std::vector<int> qdotdotDerivComponents = {0, 0};
+        const SimTK::Vector funcArgs(1, time);
+        for (int i = 0; i < numFunctions; ++i) {
+            const Function& function = functions.get(i);
+            kinematics(0, i) = function.calcValue(funcArgs);
+            kinematics(1, i) =
+                    function.calcDerivative(qdotDerivComponents, funcArgs);
+            kinematics(2, i) =
+                    function.calcDerivative(qdotdotDerivComponents, funcArgs);
+        }
+    }
+}
+}
+
 class SimTKPositionMotionImplementation
         : public SimTK::Motion::Custom::Implementation {
 public:
-    void setFunctions(std::vector<Function*> functions) {
-        m_functions = std::move(functions);
+    /// The coordinates of this MobilizedBody are the columns `columns` of
+    /// PositionMotion::getKinematics().
+    void setKinematics(const PositionMotion* positionMotion,
+            std::vector<int> columns) {
+        m_positionMotion = positionMotion;
+        m_columns = std::move(columns);
     }
 
     SimTK::Motion::Level getLevel(const SimTK::State&) const override {
@@ -41,53 +95,41 @@ public:
     /// q: The values of the generalized coordinates to set, with length nq.
     void calcPrescribedPosition(
             const SimTK::State& s, int nq, SimTK::Real* q) const override {
-        if (m_functions.size()) {
-            for (int i = 0; i < nq; ++i) {
-                m_funcArgs[0] = s.getTime();
-                q[i] = m_functions[i]->calcValue(m_funcArgs);
-            }
-        }
+        copyKinematics(s, 0, nq, q);
     }
     void calcPrescribedPositionDot(
             const SimTK::State& s, int nq, SimTK::Real* qdot) const override {
-        if (m_functions.size()) {
-            for (int i = 0; i < nq; ++i) {
-                m_funcArgs[0] = s.getTime();
-                qdot[i] = m_functions[i]->calcDerivative(
-                        m_qdotDerivComponents, m_funcArgs);
-            }
-        }
+        copyKinematics(s, 1, nq, qdot);
     }
     void calcPrescribedPositionDotDot(const SimTK::State& s, int nq,
             SimTK::Real* qdotdot) const override {
-        if (m_functions.size()) {
+        copyKinematics(s, 2, nq, qdotdot);
+    }
+
+private:
+    void copyKinematics(const SimTK::State& s, int order, int nq,
+            SimTK::Real* values) const {
+        if (m_columns.size()) {
+            const SimTK::Matrix& kinematics =
+                    m_positionMotion->getKinematics(s);
             for (int i = 0; i < nq; ++i) {
-                m_funcArgs[0] = s.getTime();
-                qdotdot[i] = m_functions[i]->calcDerivative(
-                        m_qdotdotDerivComponents, m_funcArgs);
+                values[i] = kinematics(order, m_columns[i]);
             }
         }
     }
 
-private:
-    std::vector<Function*> m_functions;
-    mutable SimTK::Vector m_funcArgs = SimTK::Vector(1);
-    static const std::vector<int> m_qdotDerivComponents;
-    static const std::vector<int> m_qdotdotDerivComponents;
+    const PositionMotion* m_positionMotion = nullptr;
+    std::vector<int> m_columns;
 };
 
-const std::vector<int>
-        SimTKPositionMotionImplementation::m_qdotDerivComponents = {0};
-const std::vector<int>
-        SimTKPositionMotionImplementation::m_qdotdotDerivComponents = {0, 0};
-
 class SimTKPositionMotion : public SimTK::Motion::Custom {
 public:
     SimTKPositionMotion(SimTK::MobilizedBody& mobod)
             : Motion::Custom(mobod, new SimTKPositionMotionImplementation()) {}
-    void setFunctions(std::vector<Function*> functions) {
+    void setKinematics(const PositionMotion* positionMotion,
+            std::vector<int> columns) {
         static_cast<SimTKPositionMotionImplementation&>(updImplementation())
-                .setFunctions(std::move(functions));
+                .setKinematics(positionMotion, std::move(columns));
     }
 };
 
@@ -155,26 +197,46 @@ std::unique_ptr<PositionMotion> PositionMotion::createFromStatesTrajectory(
 TimeSeriesTable PositionMotion::exportToTable(
         const std::vector<double>& time) const {
     TimeSeriesTable table(time);
-    std::vector<std::string> labels;
-    SimTK::Vector value((int)time.size());
-    SimTK::Vector speed((int)time.size());
-    SimTK::Vector thisTime(1);
-    for (int ifunc = 0; ifunc < get_functions().getSize(); ++ifunc) {
-        for (int itime = 0; itime < (int)time.size(); ++itime) {
-            thisTime[0] = time[itime];
-            value[itime] = get_functions().get(ifunc).calcValue(thisTime);
-            speed[itime] = get_functions().get(ifunc).calcDerivative(
-                    std::vector<int>{0}, thisTime);
-        }
-        const std::string& name = get_functions().get(ifunc).getName();
-        table.appendColumn(name + "/value", value);
-        table.appendColumn(name + "/speed", speed);
+    const auto& functions = get_functions();
+    const int numFunctions = functions.getSize();
+    // Evaluate all the functions at each time, which shares the search for
+    // the knot interval if they are splines with the same knots.
+    const auto splines = getSplinesWithSameKnots(functions);
+    SimTK::Matrix values((int)time.size(), numFunctions);
+    SimTK::Matrix speeds((int)time.size(), numFunctions);
+    SimTK::Matrix kinematics;
+    int interval = 0;
+    for (int itime = 0; itime < (int)time.size(); ++itime) {
+        calcKinematics(functions, splines, time[itime], interval, kinematics);
+        values.updRow(itime) = kinematics.row(0);
+        speeds.updRow(itime) = kinematics.row(1);
+    }
+    for (int ifunc = 0; ifunc < numFunctions; ++ifunc) {
+        const std::string& name = functions.get(ifunc).getName();
+        table.appendColumn(name + "/value", SimTK::Vector(values.col(ifunc)));
+        table.appendColumn(name + "/speed", SimTK::Vector(speeds.col(ifunc)));
     }
     return table;
 }
 
+const SimTK::Matrix& PositionMotion::getKinematics(
+        const SimTK::State& s) const {
+    if (isCacheVariableValid(s, m_kinematicsCV)) {
+        return getCacheVariableValue(s, m_kinematicsCV);
+    }
+    SimTK::Matrix& kinematics = updCacheVariableValue(s, m_kinematicsCV);
+    int interval = m_intervalHint.value.load(std::memory_order_relaxed);
+    calcKinematics(get_functions(), m_splines, s.getTime(), interval,
+            kinematics);
+    m_intervalHint.value.store(interval, std::memory_order_relaxed);
+    markCacheVariableValid(s, m_kinematicsCV);
+    return kinematics;
+}
+
 void PositionMotion::extendAddToSystem(SimTK::MultibodySystem& system) const {
     Super::extendAddToSystem(system);
+    m_kinematicsCV = addCacheVariable(
+            "kinematics", SimTK::Matrix(), SimTK::Stage::Time);
     auto& matter = system.updMatterSubsystem();
     m_motions.clear();
     for (int imb = 0; imb < matter.getNumBodies(); ++imb) {
@@ -194,36 +256,36 @@ void PositionMotion::extendRealizeTopology(SimTK::State& state) const {
                 "No function provided for coordinate '{}'.", path);
     }
 
-    // Create a mapping from SimTK position DOFs to OpenSim Coordinates.
-    // We identify a SimTK DOF as a MobilizedBodyIndex and a Q index.
-    std::map<std::pair<SimTK::MobilizedBodyIndex, int>, std::string>
-            indicesToCoordName;
+    // Create a mapping from SimTK position DOFs to the functions (the columns
+    // of the kinematics). We identify a SimTK DOF as a MobilizedBodyIndex and
+    // a Q index.
+    std::map<std::pair<SimTK::MobilizedBodyIndex, int>, int> indicesToColumn;
     for (int i = 0; i < get_functions().getSize(); ++i) {
         const auto& path = get_functions().get(i).getName();
         const auto& coord = getModel().getComponent<Coordinate>(path);
         const auto mbi = coord.getBodyIndex();
         const auto qIndex = coord.getMobilizerQIndex();
-        indicesToCoordName[std::make_pair(mbi, qIndex)] = path;
+        indicesToColumn[std::make_pair(mbi, qIndex)] = i;
     }
+    m_splines = getSplinesWithSameKnots(get_functions());
+    m_intervalHint.value.store(0, std::memory_order_relaxed);
 
     auto& matter = getSystem().getMatterSubsystem();
     for (SimTK::MobilizedBodyIndex mbi(0); mbi < matter.getNumBodies(); ++mbi) {
         auto& mobod = matter.getMobilizedBody(mbi);
-        // Create the vector of functions to provide to the SimTK::Motion for
-        // this MobilizedBody.
-        std::vector<Function*> mobodFunctions;
+        // Create the vector of columns of the kinematics to provide to the
+        // SimTK::Motion for this MobilizedBody.
+        std::vector<int> mobodColumns;
         for (int iq = 0; iq < mobod.getNumQ(state); ++iq) {
             const auto key = std::make_pair(mbi, iq);
-            // This skips over unused quaternion slots, as indicesToCoordName
+            // This skips over unused quaternion slots, as indicesToColumn
             // doesn't have entries for such slots.
-            if (indicesToCoordName.count(key)) {
-                const auto& coordName = indicesToCoordName.at(key);
-                mobodFunctions.push_back(
-                        const_cast<Function*>(&get_functions().get(coordName)));
+            if (indicesToColumn.count(key)) {
+                mobodColumns.push_back(indicesToColumn.at(key));
             }
         }
         auto& motion = const_cast<SimTK::Motion&>(m_motions[mbi]);
         auto& customMotion = static_cast<SimTKPositionMotion&>(motion);
-        customMotion.setFunctions(std::move(mobodFunctions));
+        customMotion.setKinematics(this, std::move(mobodColumns));
     }
 }
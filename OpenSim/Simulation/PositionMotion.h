@@ -25,9 +25,12 @@
 #include <OpenSim/Simulation/Model/ModelComponent.h>
 #include "osimSimulationDLL.h"
 
+#include <atomic>
+
 namespace OpenSim {
 
 class Function;
+class GCVSpline;
 class Coordinate;
 class StatesTrajectory;
 
@@ -38,6 +41,12 @@ prescribing kinematics using Coordinate's prescribed_function, which uses a
 kinematic constraint. When prescribing motion, the system must compute
 constraint forces to apply to enforce the prescribed motion;
 such forces are available via SimbodyMatterSubsystem::findMotionForces().
+
+The values, speeds, and accelerations of all the coordinates are evaluated
+together, once per time (see getKinematics()). If the functions are
+GCVSpline%s with the same knots (e.g., from createFromTable()), this takes one
+search for the knot interval and one set of coefficient weights for all the
+coordinates and derivative orders (see GCVSpline::calcCoefficientWeights()).
 @note This class requires that *all* coordinates are prescribed. */
 class OSIMSIMULATION_API PositionMotion : public ModelComponent {
     OpenSim_DECLARE_CONCRETE_OBJECT(PositionMotion, ModelComponent);
@@ -92,6 +101,11 @@ public:
     static std::unique_ptr<PositionMotion> createFromStatesTrajectory(
             const Model& model, const StatesTrajectory& statesTraj);
     TimeSeriesTable exportToTable(const std::vector<double>& time) const;
+    /// The values, speeds, and accelerations (rows 0, 1, and 2) of the
+    /// coordinates at the time of the state, with a column for each function
+    /// (in the order of the `functions` property). This is available after
+    /// Model::initSystem(), and is computed once per time.
+    const SimTK::Matrix& getKinematics(const SimTK::State& s) const;
 
 private:
     /// Allocate SimTK::Motion%s.
@@ -100,6 +114,20 @@ private:
     /// so that we can iterate through the system's MobilizedBodies.
     void extendRealizeTopology(SimTK::State& state) const override;
     mutable SimTK::ResetOnCopy<std::vector<SimTK::Motion>> m_motions;
+    mutable CacheVariable<SimTK::Matrix> m_kinematicsCV;
+    /// The functions, if they are all GCVSplines with the same knots;
+    /// otherwise, empty.
+    mutable SimTK::ResetOnCopy<std::vector<const GCVSpline*>> m_splines;
+    /// The knot interval that contained the time of the last evaluation,
+    /// where the search for the next time starts. It is only a hint (the
+    /// results do not depend on it), so it is not copied.
+    struct IntervalHint {
+        IntervalHint() = default;
+        IntervalHint(const IntervalHint&) {}
+        IntervalHint& operator=(const IntervalHint&) { return *this; }
+        mutable std::atomic<int> value {0};
+    };
+    IntervalHint m_intervalHint;
 };
 
 } // namespace OpenSim
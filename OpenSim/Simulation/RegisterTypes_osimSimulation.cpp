@@ -49,6 +49,7 @@
 #include "Model/ElasticFoundationForce.h"
 #include "Model/HuntCrossleyForce.h"
 #include "Model/SmoothSphereHalfSpaceForce.h"
+#include "Model/SmoothSphereHalfSpaceForceGroup.h"
 #include "Model/Ligament.h"
 #include "Model/Blankevoort1991Ligament.h"
 #include "Model/JointSet.h"
@@ -90,6 +91,8 @@
 #include "Control/ControlConstant.h"
 #include "Control/ControlLinear.h"
 #include "Control/PrescribedController.h"
+#include "Control/ExternalController.h"
+#include "Control/TaskSpaceController.h"
 
 #include "Wrap/PathWrap.h"
 #include "Wrap/PathWrapSet.h"
@@ -246,6 +249,8 @@ OSIMSIMULATION_API void RegisterTypes_osimSimulation()
     Object::registerType( ContactSphere() );
     Object::registerType( CoordinateLimitForce() );
     Object::registerType( SmoothSphereHalfSpaceForce() );
+    Object::registerType( SmoothSphereHalfSpaceForceGroup_Contact() );
+    Object::registerType( SmoothSphereHalfSpaceForceGroup() );
     Object::registerType( HuntCrossleyForce() );
     Object::registerType( ElasticFoundationForce() );
     Object::registerType( HuntCrossleyForce::ContactParameters() );
@@ -267,6 +272,9 @@ OSIMSIMULATION_API void RegisterTypes_osimSimulation()
 
     Object::registerType( ControlSetController() );
     Object::registerType( PrescribedController() );
+    Object::registerType( ExternalController() );
+    Object::registerType( StationTask() );
+    Object::registerType( TaskSpaceController() );
 
     Object::registerType( PathActuator() );
     Object::registerType( ProbeSet() );
@@ -329,6 +337,6 @@ osimSimulationInstantiator::osimSimulationInstantiator()
     
 void osimSimulationInstantiator::registerDllClasses() 
 { 
-        RegisterTypes_osimSimulation(); 
+        Object::deferTypeRegistration(RegisterTypes_osimSimulation); 
 } 
     
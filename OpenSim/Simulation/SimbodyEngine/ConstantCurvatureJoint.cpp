@@ -380,13 +380,29 @@ Mat63 OpenSim::ConstantCurvatureJoint::getConstantCurveJacobian(
     return J;
 }
 
-Mat63 OpenSim::ConstantCurvatureJoint::getConstantCurveJacobianDerivWrtPosition(
-        const Vec3& pos, double d, int index) {
+namespace {
+/// The derivative of the Jacobian of getConstantCurveJacobian() in the
+/// direction `dPos` (i.e., the sum over i of dPos(i) times the derivative with
+/// respect to pos(i)). Every derivative below (the quantities with the suffix
+/// `_dFirst`) is linear in the derivatives of the rotation, of the Euler
+/// Jacobian and of the linear angle that seed it, so the derivatives with
+/// respect to all the degrees of freedom are combined in the seeds, and the
+/// rest of the chain is evaluated once rather than once per degree of
+/// freedom.
+Mat63 calcConstantCurveJacobianDirectionalDeriv(
+        const Vec3& pos, double d, const Vec3& dPos) {
+    using OpenSim::ConstantCurvatureJoint;
     // 1. Do the euler rotation
-    const Rotation rot = eulerXZYToMatrix(pos);
-    const Mat33 rot_dFirst = eulerXZYToMatrixGrad(pos, index);
-
-    Mat63 J_dFirst = getEulerJacobianDerivWrtPos(pos, index);
+    const Rotation rot = ConstantCurvatureJoint::eulerXZYToMatrix(pos);
+    Mat33 rot_dFirst(0);
+    Mat63 J_dFirst(0);
+    for (int i = 0; i < 3; ++i) {
+        if (dPos(i) == 0) continue;
+        rot_dFirst += dPos(i) * ConstantCurvatureJoint::eulerXZYToMatrixGrad(
+                                        pos, i);
+        J_dFirst += dPos(i) *
+                    ConstantCurvatureJoint::getEulerJacobianDerivWrtPos(pos, i);
+    }
 
     // Remember, this is X,*Z*,Y
 
@@ -405,18 +421,13 @@ Mat63 OpenSim::ConstantCurvatureJoint::getConstantCurveJacobianDerivWrtPosition(
     Mat33 dLinearAngle_dFirst;
     dLinearAngle_dFirst.setToZero();
 
-    Vec3 linearAngle_dFirst = Vec3(0, 0, 0);
-    if (index == 0) {
-        linearAngle_dFirst = Vec3(0, -sx * cz, cz * cx);
-        dLinearAngle_dFirst.col(0) = Vec3(0, -cx * cz, cz * -sx);
-        dLinearAngle_dFirst.col(1) = Vec3(0, sx * sz, -sz * cx);
-        dLinearAngle_dFirst.col(2).setToZero();
-    } else if (index == 1) {
-        linearAngle_dFirst = Vec3(-cz, cx * -sz, -sz * sx);
-        dLinearAngle_dFirst.col(0) = Vec3(0, -sx * -sz, -sz * cx);
-        dLinearAngle_dFirst.col(1) = Vec3(sz, -cx * cz, -cz * sx);
-        dLinearAngle_dFirst.col(2).setToZero();
-    }
+    // The linear angle does not depend on pos(2).
+    const Vec3 linearAngle_dFirst = dPos(0) * Vec3(0, -sx * cz, cz * cx) +
+                                    dPos(1) * Vec3(-cz, cx * -sz, -sz * sx);
+    dLinearAngle_dFirst.col(0) = dPos(0) * Vec3(0, -cx * cz, cz * -sx) +
+                                 dPos(1) * Vec3(0, -sx * -sz, -sz * cx);
+    dLinearAngle_dFirst.col(1) = dPos(0) * Vec3(0, sx * sz, -sz * cx) +
+                                 dPos(1) * Vec3(sz, -cx * cz, -cz * sx);
 
     const double sinTheta = sqrt(
             linearAngle(0) * linearAngle(0) + linearAngle(2) * linearAngle(2));
@@ -424,13 +435,13 @@ Mat63 OpenSim::ConstantCurvatureJoint::getConstantCurveJacobianDerivWrtPosition(
     if (sinTheta < 0.001 || sinTheta > 0.999) {
         // Near very vertical angles, don't worry about the bend, just
         // approximate with an euler joint
-        const Mat63 J = getEulerJacobian(pos);
+        const Mat63 J = ConstantCurvatureJoint::getEulerJacobian(pos);
 
         // 2. Computing translation from vertical
         Vec3 translation = rot * Vec3(0, d, 0);
 
         const Vec3 translation_dFirst =
-                rot * SimTK::cross(J.col(index).getSubVec<3>(0), translation);
+                rot * SimTK::cross((J * dPos).getSubVec<3>(0), translation);
 
         J_dFirst.col(0).updSubVec<3>(3) =
                 0.5 *
@@ -605,15 +616,19 @@ Mat63 OpenSim::ConstantCurvatureJoint::getConstantCurveJacobianDerivWrtPosition(
 
     return J_dFirst;
 }
+} // anonymous namespace
+
+Mat63 OpenSim::ConstantCurvatureJoint::getConstantCurveJacobianDerivWrtPosition(
+        const Vec3& pos, double d, int index) {
+    OPENSIM_ASSERT_FRMOBJ(index >= 0 && index < 3);
+    Vec3 direction(0);
+    direction(index) = 1;
+    return calcConstantCurveJacobianDirectionalDeriv(pos, d, direction);
+}
 
 Mat63 OpenSim::ConstantCurvatureJoint::getConstantCurveJacobianDerivWrtTime(
         const Vec3& pos, const Vec3& dPos, double d) {
-    Mat63 dJ;
-    dJ.setToZero();
-    for (int i = 0; i < 3; i++) {
-        dJ += dPos(i) * getConstantCurveJacobianDerivWrtPosition(pos, d, i);
-    }
-    return dJ;
+    return calcConstantCurveJacobianDirectionalDeriv(pos, d, dPos);
 }
 
 Transform OpenSim::ConstantCurvatureJoint::getTransform(Vec3 pos, double d) {
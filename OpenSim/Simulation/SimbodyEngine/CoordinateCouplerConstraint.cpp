@@ -25,9 +25,14 @@
 // INCLUDES
 //=============================================================================
 #include "CoordinateCouplerConstraint.h"
+#include <OpenSim/Common/GCVSpline.h>
+#include <OpenSim/Common/PiecewiseLinearFunction.h>
+#include <OpenSim/Common/SimmSpline.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include "simbody/internal/Constraint.h"
 
+#include <atomic>
+
 /**
  * This is a helper class that is used to take a function that computes the value
  * of a dependent coordinate as a function of independent coordinates and cast
@@ -155,6 +160,92 @@ public:
     }
 };
 
+/**
+ * The same constraint function as CompoundFunction for the common case of one
+ * independent coordinate:
+ *
+ * C(qi, qd) = 0 = s * f(qi) - qd
+ *
+ * The splines that are used for this (SimmSpline, GCVSpline, and
+ * PiecewiseLinearFunction) are evaluated directly at qi, starting the search
+ * for the knot interval at the interval of the previous evaluation (the value
+ * and the derivatives are evaluated at the same qi, one after another). Other
+ * functions are evaluated through their SimTK::Function. No argument vectors
+ * are allocated.
+ */
+class SingleCoordinateCouplerFunction : public SimTK::Function {
+
+private:
+    const SimmSpline* simmSpline;
+    const GCVSpline* gcvSpline;
+    const PiecewiseLinearFunction* piecewiseLinear;
+    std::unique_ptr<const SimTK::Function> otherFunction;
+    const double scaleFactor;
+    mutable std::atomic<int> intervalHint;
+
+public:
+
+    SingleCoordinateCouplerFunction(const OpenSim::Function& function,
+            double scaleFactor) :
+            simmSpline(dynamic_cast<const SimmSpline*>(&function)),
+            gcvSpline(dynamic_cast<const GCVSpline*>(&function)),
+            piecewiseLinear(
+                    dynamic_cast<const PiecewiseLinearFunction*>(&function)),
+            scaleFactor(scaleFactor), intervalHint(0) {
+        if (!simmSpline && !gcvSpline && !piecewiseLinear) {
+            otherFunction.reset(function.createSimTKFunction());
+        }
+    }
+
+    double calcValue(const SimTK::Vector& x) const override {
+        return scaleFactor * evaluate(x[0], 0) - x[1];
+    }
+
+    double calcDerivative(const SimTK::Array_<int>& derivComponents,
+            const SimTK::Vector& x) const override {
+        if (derivComponents.size() == 1) {
+            if (derivComponents[0] == 0)
+                return scaleFactor * evaluate(x[0], 1);
+            // Derivative with respect to the dependent coordinate.
+            return -1;
+        } else if (derivComponents.size() == 2) {
+            if (derivComponents[0] == 0 && derivComponents[1] == 0)
+                return scaleFactor * evaluate(x[0], 2);
+        }
+        return 0;
+    }
+
+    int getArgumentSize() const override { return 2; }
+
+    int getMaxDerivativeOrder() const override { return 2; }
+
+private:
+
+    /** The value (derivOrder = 0) or a derivative of f at qi. */
+    double evaluate(double qi, int derivOrder) const {
+        if (otherFunction) {
+            // A Vector of size 1 per thread, so that it is allocated once.
+            thread_local SimTK::Vector xi(1);
+            xi[0] = qi;
+            if (derivOrder == 0) return otherFunction->calcValue(xi);
+            static const SimTK::Array_<int> first(1, 0);
+            static const SimTK::Array_<int> second(2, 0);
+            return otherFunction->calcDerivative(
+                    derivOrder == 1 ? first : second, xi);
+        }
+        int interval = intervalHint.load(std::memory_order_relaxed);
+        double value;
+        if (simmSpline)
+            value = simmSpline->evaluate(qi, derivOrder, interval);
+        else if (gcvSpline)
+            value = gcvSpline->evaluate(qi, derivOrder, interval);
+        else
+            value = piecewiseLinear->evaluate(qi, derivOrder, interval);
+        intervalHint.store(interval, std::memory_order_relaxed);
+        return value;
+    }
+};
+
 
 //=============================================================================
 // STATICS
@@ -293,8 +384,14 @@ void CoordinateCouplerConstraint::extendAddToSystem(SimTK::MultibodySystem& syst
 
     // Create and set the underlying coupler constraint function;
     const Function& f = getFunction();
-    SimTK::Function *simtkCouplerFunction = new CompoundFunction(
-            f.createSimTKFunction(), get_scale_factor());
+    SimTK::Function *simtkCouplerFunction;
+    if (independentCoordNames.getSize() == 1 && f.getArgumentSize() == 1) {
+        simtkCouplerFunction =
+                new SingleCoordinateCouplerFunction(f, get_scale_factor());
+    } else {
+        simtkCouplerFunction = new CompoundFunction(
+                f.createSimTKFunction(), get_scale_factor());
+    }
 
 
     // Now create a Simbody Constraint::CoordinateCoupler
@@ -378,6 +378,30 @@ SimTK::SpatialVec Joint::calcEquivalentSpatialForce(const SimTK::State &s,
     return FB_G;
 }
 
+/* The reactions of all mobilizers are cached by the Model, so that the
+   reactions of several joints at the same State are computed only once. */
+SimTK::SpatialVec Joint::calcReactionOnParentExpressedInGround(
+        const SimTK::State &s) const
+{
+    const SimTK::MobilizedBody& mobod = getChildFrame().getMobilizedBody();
+    const SimTK::SpatialVec& reactionOnChild = getModel()
+            .getMobilizerReactionForces(s)[mobod.getMobilizedBodyIndex()];
+    // The reaction on the parent is equal and opposite, at the origin of the
+    // F frame (as in findMobilizerReactionOnParentAtFInGround()).
+    const SimTK::Transform X_GF = mobod.getParentMobilizedBody()
+            .getBodyTransform(s) * mobod.getInboardFrame(s);
+    const SimTK::Transform X_GM =
+            mobod.getBodyTransform(s) * mobod.getOutboardFrame(s);
+    return -SimTK::shiftForceBy(reactionOnChild, X_GF.p() - X_GM.p());
+}
+
+SimTK::SpatialVec Joint::calcReactionOnChildExpressedInGround(
+        const SimTK::State &s) const
+{
+    return getModel().getMobilizerReactionForces(s)[
+            getChildFrame().getMobilizedBodyIndex()];
+}
+
 /** Joints only produce power when internal constraint forces have components along
     the mobilities of the joint (for example to satisfy prescribed motion). In 
     which case the joint power is the constraint forces projected onto the mobilities
@@ -259,20 +259,14 @@ public:
     @return     SpatialVec of reaction force, RP_G, acting on parent frame, P,
                 and expressed in ground, G.  */
     SimTK::SpatialVec
-        calcReactionOnParentExpressedInGround(const SimTK::State &state) const {
-        return getChildFrame().getMobilizedBody()
-            .findMobilizerReactionOnParentAtFInGround(state);
-    }
+        calcReactionOnParentExpressedInGround(const SimTK::State &state) const;
     /** Calculate the joint reaction force and moment acting on the child frame
         and expressed in Ground.
     @param[in]  state containing the generalized coordinate and speed values 
     @return     SpatialVec of reaction force, RP_G, acting on child frame, C,
                 and expressed in ground, G.  */
     SimTK::SpatialVec
-        calcReactionOnChildExpressedInGround(const SimTK::State &state) const {
-        return getChildFrame().getMobilizedBody()
-            .findMobilizerReactionOnBodyAtMInGround(state);
-    }
+        calcReactionOnChildExpressedInGround(const SimTK::State &state) const;
 
     /** Joints in general do not contribute power since the reaction space
         forces are orthogonal to the mobility space. However, when joint motion 
@@ -414,11 +414,10 @@ void SimbodyEngine::computeReactions(const SimTK::State& s, Vector_<Vec3>& rForc
     OPENSIM_ASSERT_FRMOBJ(nj == rForces.size());
     OPENSIM_ASSERT_FRMOBJ(rForces.size() == rTorques.size());
 
-    SimTK::Vector_<SpatialVec> reactionForces(nj);
-
     // Systems must be realized to acceleration stage
     _model->getMultibodySystem().realize(s, Stage::Acceleration);
-    _model->getMatterSubsystem().calcMobilizerReactionForces(s, reactionForces);
+    const SimTK::Vector_<SpatialVec>& reactionForces =
+            _model->getMobilizerReactionForces(s);
 
 
     const JointSet &joints = _model->getJointSet();
@@ -28,8 +28,11 @@
 
 #include <simbody/internal/Visualizer_InputListener.h>
 
+#include <OpenSim/Common/StateVariableAccessor.h>
 #include <OpenSim/Common/TableUtilities.h>
 
+#include <algorithm>
+
 using namespace OpenSim;
 
 SimTK::State OpenSim::simulate(Model& model,
@@ -243,62 +246,32 @@ std::vector<std::string> OpenSim::createStateVariableNamesInSystemOrder(
 std::vector<std::string> OpenSim::createStateVariableNamesInSystemOrder(
         const Model& model, std::unordered_map<int, int>& yIndexMap) {
     yIndexMap.clear();
+    const auto sysYIndices = createSystemYIndexMap(model);
+    // Sort the state variables by their index in Y; empty slots (e.g., for
+    // quaternions) are skipped.
+    std::vector<std::pair<int, std::string>> svs;
+    for (const auto& sv : sysYIndices) svs.emplace_back(sv.second, sv.first);
+    std::sort(svs.begin(), svs.end());
     std::vector<std::string> svNamesInSysOrder;
-    auto s = model.getWorkingState();
-    const auto svNames = model.getStateVariableNames();
-    s.updY() = 0;
-    std::vector<int> yIndices;
-    for (int iy = 0; iy < s.getNY(); ++iy) {
-        s.updY()[iy] = SimTK::NaN;
-        const auto svValues = model.getStateVariableValues(s);
-        for (int isv = 0; isv < svNames.size(); ++isv) {
-            if (SimTK::isNaN(svValues[isv])) {
-                svNamesInSysOrder.push_back(svNames[isv]);
-                yIndices.emplace_back(iy);
-                s.updY()[iy] = 0;
-                break;
-            }
-        }
-        if (SimTK::isNaN(s.updY()[iy])) {
-            // If we reach here, this is an unused slot for a quaternion.
-            s.updY()[iy] = 0;
-        }
-    }
-    int count = 0;
-    for (const auto& iy : yIndices) {
-        yIndexMap.emplace(std::make_pair(count, iy));
-        ++count;
+    for (const auto& sv : svs) {
+        yIndexMap.emplace((int)svNamesInSysOrder.size(), sv.first);
+        svNamesInSysOrder.push_back(sv.second);
     }
-    SimTK_ASSERT2_ALWAYS((size_t)svNames.size() == svNamesInSysOrder.size(),
-            "Expected to get %i state names but found %i.", svNames.size(),
-            svNamesInSysOrder.size());
     return svNamesInSysOrder;
 }
 
 std::unordered_map<std::string, int> OpenSim::createSystemYIndexMap(
         const Model& model) {
     std::unordered_map<std::string, int> sysYIndices;
-    auto s = model.getWorkingState();
-    const auto svNames = model.getStateVariableNames();
-    s.updY() = 0;
-    for (int iy = 0; iy < s.getNY(); ++iy) {
-        s.updY()[iy] = SimTK::NaN;
-        const auto svValues = model.getStateVariableValues(s);
-        for (int isv = 0; isv < svNames.size(); ++isv) {
-            if (SimTK::isNaN(svValues[isv])) {
-                sysYIndices[svNames[isv]] = iy;
-                s.updY()[iy] = 0;
-                break;
-            }
-        }
-        if (SimTK::isNaN(s.updY()[iy])) {
-            // If we reach here, this is an unused slot for a quaternion.
-            s.updY()[iy] = 0;
-        }
+    const StateVariableAccessor accessor(model, model.getWorkingState());
+    const auto& svNames = accessor.getStateVariablePaths();
+    for (int isv = 0; isv < accessor.getNumStateVariables(); ++isv) {
+        const int iy = accessor.getSystemYIndex(isv);
+        SimTK_ASSERT1_ALWAYS(iy >= 0,
+                "Could not find the index of state variable '%s' in Y.",
+                svNames[isv].c_str());
+        sysYIndices[svNames[isv]] = iy;
     }
-    SimTK_ASSERT2_ALWAYS(svNames.size() == (int)sysYIndices.size(),
-            "Expected to find %i state indices but found %i.", svNames.size(),
-            sysYIndices.size());
     return sysYIndices;
 }
 
@@ -396,7 +369,19 @@ TimeSeriesTableVec3 OpenSim::createSyntheticIMUAccelerationSignals(
         const Model& model,
         const TimeSeriesTable& statesTable, const TimeSeriesTable& controlsTable,
         const std::vector<std::string>& framePaths) {
-    std::vector<std::string> outputPaths;
+    return createSyntheticIMUSignals(
+            model, statesTable, controlsTable, framePaths).accelerometerSignals;
+}
+
+SyntheticIMUSignals OpenSim::createSyntheticIMUSignals(const Model& model,
+        const TimeSeriesTable& statesTable, const TimeSeriesTable& controlsTable,
+        const std::vector<std::string>& framePaths, int numThreads) {
+    OPENSIM_THROW_IF(statesTable.getNumRows() != controlsTable.getNumRows(),
+            Exception,
+            "Expected statesTable and controlsTable to contain the "
+            "same number of rows, but statesTable contains {} rows "
+            "and controlsTable contains {} rows.",
+            statesTable.getNumRows(), controlsTable.getNumRows());
 
     ComponentPath path;
     for (const auto& framePath : framePaths) {
@@ -406,35 +391,86 @@ TimeSeriesTableVec3 OpenSim::createSyntheticIMUAccelerationSignals(
             !model.hasComponent<PhysicalFrame>(framePath), Exception,
             "Expected provided frame path '{}' to point to component of "
             "type PhysicalFrame, but no such component was found.", framePath);
-        outputPaths.push_back(framePath + "\\|linear_acceleration");
     }
-    TimeSeriesTableVec3 accelTableEffort = analyze<SimTK::Vec3>(
-            model, statesTable, controlsTable, outputPaths);
-
-    // Create synthetic IMU signals by extracting the gravitational acceleration
-    // vector from the solution accelerations and expressing them in the model
-    // frames.
-    const auto& statesTraj =
-            StatesTrajectory::createFromStatesTable(model, statesTable);
-    const auto& ground = model.getGround();
-    const auto& gravity = model.getGravity();
-    const auto& timeVec = accelTableEffort.getIndependentColumn();
-    TimeSeriesTableVec3 accelTableIMU(timeVec);
-    for (const auto& framePath : framePaths) {
-        std::string label = framePath + "|linear_acceleration";
-        const auto& col = accelTableEffort.getDependentColumn(label);
-        const auto& frame = model.getComponent<PhysicalFrame>(framePath);
-        SimTK::Vector_<SimTK::Vec3> colIMU(col.size());
-        for (int i = 0; i < (int)timeVec.size(); ++i) {
-            const auto& state = statesTraj.get(i);
-            model.realizeAcceleration(state);
-            SimTK::Vec3 accelIMU = ground.expressVectorInAnotherFrame(
-                    state, col[i] - gravity, frame);
-            colIMU[i] = accelIMU;
-        }
-        accelTableIMU.appendColumn(label, colIMU);
+
+    Model baseModel(model);
+    baseModel.initSystem();
+    const auto statesTraj =
+            StatesTrajectory::createFromStatesTable(baseModel, statesTable);
+    const std::unordered_map<std::string, int> controlMap =
+            createSystemControlIndexMap(baseModel);
+    std::vector<int> controlIndices;
+    for (const auto& controlName : controlsTable.getColumnLabels()) {
+        controlIndices.push_back(controlMap.at(controlName));
     }
-    accelTableIMU.setColumnLabels(framePaths);
 
-    return accelTableIMU;
-}
\ No newline at end of file
+    struct Worker {
+        explicit Worker(const Model& model) : model(model) {}
+        Model model;
+        bool hasSystem = false;
+        std::vector<const PhysicalFrame*> frames;
+    };
+    const int numRows = (int)statesTraj.getSize();
+    const int numFrames = (int)framePaths.size();
+    numThreads = std::max(
+            1, std::min(getNumThreadsOrDefault(numThreads), numRows));
+    std::vector<std::unique_ptr<Worker>> workers(numThreads);
+    for (auto& worker : workers) worker.reset(new Worker(model));
+
+    SimTK::Matrix_<SimTK::Quaternion> orientations(numRows, numFrames);
+    SimTK::Matrix_<SimTK::Vec3> gyroscopeSignals(numRows, numFrames);
+    SimTK::Matrix_<SimTK::Vec3> accelerometerSignals(numRows, numFrames);
+    parallelForEach(numRows, numThreads, [&](int thread, int itime) {
+        Worker& worker = *workers[thread];
+        Model& workerModel = worker.model;
+        if (!worker.hasSystem) {
+            workerModel.initSystem();
+            for (const auto& framePath : framePaths) {
+                worker.frames.push_back(
+                        &workerModel.getComponent<PhysicalFrame>(framePath));
+            }
+            worker.hasSystem = true;
+        }
+
+        // The states of the trajectory belong to the base model's system, so
+        // copy their values into this copy's state.
+        SimTK::State& state = workerModel.updWorkingState();
+        const SimTK::State& trajState = statesTraj[itime];
+        state.setTime(trajState.getTime());
+        state.updY() = trajState.getY();
+
+        // Enforce any SimTK::Motion's included in the model.
+        workerModel.getSystem().prescribe(state);
+
+        SimTK::Vector controls(workerModel.getNumControls(), 0.0);
+        const auto& controlsRow = controlsTable.getRowAtIndex(itime);
+        for (int icontrol = 0; icontrol < (int)controlIndices.size();
+                ++icontrol) {
+            controls[controlIndices[icontrol]] = controlsRow[icontrol];
+        }
+        workerModel.realizeVelocity(state);
+        workerModel.setControls(state, controls);
+        workerModel.realizeAcceleration(state);
+
+        // Mimic IMUs by subtracting the gravitational acceleration from the
+        // linear accelerations, and express the signals in the frames.
+        const SimTK::Vec3& gravity = workerModel.getGravity();
+        for (int iframe = 0; iframe < numFrames; ++iframe) {
+            const PhysicalFrame& frame = *worker.frames[iframe];
+            const SimTK::Rotation& R_GF =
+                    frame.getTransformInGround(state).R();
+            orientations(itime, iframe) = SimTK::Quaternion(R_GF);
+            gyroscopeSignals(itime, iframe) =
+                    ~R_GF * frame.getAngularVelocityInGround(state);
+            accelerometerSignals(itime, iframe) =
+                    ~R_GF * (frame.getLinearAccelerationInGround(state) -
+                                    gravity);
+        }
+    });
+
+    const auto& times = statesTable.getIndependentColumn();
+    return {TimeSeriesTable_<SimTK::Quaternion>(
+                    times, orientations, framePaths),
+            TimeSeriesTableVec3(times, gyroscopeSignals, framePaths),
+            TimeSeriesTableVec3(times, accelerometerSignals, framePaths)};
+}
@@ -29,6 +29,8 @@
 
 #include <SimTKcommon/internal/State.h>
 
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/OutputPlan.h>
 #include <OpenSim/Common/Reporter.h>
 #include <OpenSim/Common/Storage.h>
 #include <OpenSim/Simulation/Model/Model.h>
@@ -316,6 +318,7 @@ TimeSeriesTable_<T> analyze(Model model, const TimeSeriesTable& statesTable,
     }
 
     // Loop through the states trajectory to create the report.
+    reporter->reserveRows((int)statesTraj.getSize());
     for (int itime = 0; itime < (int)statesTraj.getSize(); ++itime) {
         // Get the current state.
         auto state = statesTraj[itime];
@@ -355,6 +358,168 @@ TimeSeriesTable_<T> analyze(Model model, const TimeSeriesTable& statesTable,
     return reporter->getTable();
 }
 
+/// A parallel version of analyze(), for long trajectories or expensive
+/// outputs (e.g., muscle fiber states or metabolics). The rows are divided
+/// among `numThreads` threads (if not positive, getNumThreadsOrDefault() is
+/// used), each of which uses its own copy of the model; the copies are made on
+/// the calling thread, and their systems are built on the threads that use
+/// them. The requested outputs are found once, by path, and each thread
+/// evaluates them directly with an OutputPlan (rather than with a
+/// TableReporter), realizing each state only as far as the outputs require,
+/// and writes its rows into a table that is preallocated for all rows. The result is the same
+/// as that of analyze(), provided that the model's components can be evaluated
+/// on different copies of the model concurrently.
+/// @ingroup simulationutil
+template <typename T>
+TimeSeriesTable_<T> analyzeParallel(const Model& model,
+        const TimeSeriesTable& statesTable,
+        const TimeSeriesTable& controlsTable,
+        const std::vector<std::string>& outputPaths,
+        const TimeSeriesTable& discreteVariablesTable = {},
+        int numThreads = -1) {
+    OPENSIM_THROW_IF(statesTable.getNumRows() != controlsTable.getNumRows(),
+            Exception,
+            "Expected statesTable and controlsTable to contain the "
+            "same number of rows, but statesTable contains {} rows "
+            "and controlsTable contains {} rows.",
+            statesTable.getNumRows(), controlsTable.getNumRows());
+    OPENSIM_THROW_IF(discreteVariablesTable.getNumColumns() &&
+                    discreteVariablesTable.getNumRows() !=
+                            statesTable.getNumRows(),
+            Exception,
+            "Expected discreteVariablesTable to contain the "
+            "same number of rows as statesTable and controlsTable, "
+            "but discreteVariablesTable contains {} rows "
+            "and statesTable contains {} rows.",
+            discreteVariablesTable.getNumRows(), statesTable.getNumRows());
+
+    // Find the outputs to report, in the same order as analyze(), on a copy
+    // of the model that also creates the states. Outputs are identified by
+    // the path of their component (empty for the model itself) and name.
+    Model baseModel(model);
+    baseModel.initSystem();
+    std::vector<std::pair<std::string, std::string>> outputRefs;
+    std::vector<std::string> labels;
+    auto addMatchingOutput = [&](const std::string& componentPath,
+                                     const AbstractOutput& output) {
+        const auto thisOutputPath = output.getPathName();
+        for (const auto& outputPathArg : outputPaths) {
+            if (!std::regex_match(thisOutputPath, std::regex(outputPathArg))) {
+                continue;
+            }
+            if (const auto* typedOutput =
+                            dynamic_cast<const Output<T>*>(&output)) {
+                log_debug("Adding output {} of type {}.", output.getPathName(),
+                        output.getTypeName());
+                outputRefs.emplace_back(componentPath, output.getName());
+                for (const auto& channel : typedOutput->getChannels()) {
+                    labels.push_back(channel.second.getPathName());
+                }
+            } else {
+                log_warn("Ignoring output {} of type {}.", output.getPathName(),
+                        output.getTypeName());
+            }
+        }
+    };
+    for (const auto& comp : baseModel.getComponentList()) {
+        for (const auto& outputName : comp.getOutputNames()) {
+            addMatchingOutput(comp.getAbsolutePathString(),
+                    comp.getOutput(outputName));
+        }
+    }
+    for (const auto& outputName : baseModel.getOutputNames()) {
+        addMatchingOutput("", baseModel.getOutput(outputName));
+    }
+
+    const auto statesTraj =
+            StatesTrajectory::createFromStatesTable(baseModel, statesTable);
+
+    const std::vector<std::string>& controlNames =
+            controlsTable.getColumnLabels();
+    const std::unordered_map<std::string, int> controlMap =
+            createSystemControlIndexMap(baseModel);
+    std::vector<int> controlIndices;
+    for (const auto& controlName : controlNames) {
+        controlIndices.push_back(controlMap.at(controlName));
+    }
+
+    // The path of the component and the name of each discrete variable (see
+    // analyze()).
+    std::vector<std::pair<std::string, std::string>> discreteVariableRefs;
+    for (const auto& label : discreteVariablesTable.getColumnLabels()) {
+        ComponentPath discreteVarPath(label);
+        discreteVariableRefs.emplace_back(
+                discreteVarPath.getParentPathString(),
+                discreteVarPath.getComponentName());
+    }
+
+    struct Worker {
+        explicit Worker(const Model& model) : model(model) {}
+        Model model;
+        bool hasSystem = false;
+        OutputPlan<T> outputPlan;
+        std::vector<const Component*> discreteComponents;
+    };
+    const int numRows = (int)statesTraj.getSize();
+    numThreads = std::max(
+            1, std::min(getNumThreadsOrDefault(numThreads), numRows));
+    std::vector<std::unique_ptr<Worker>> workers(numThreads);
+    for (auto& worker : workers) worker.reset(new Worker(model));
+
+    SimTK::Matrix_<T> data(numRows, (int)labels.size());
+    parallelForEach(numRows, numThreads, [&](int thread, int itime) {
+        Worker& worker = *workers[thread];
+        Model& workerModel = worker.model;
+        if (!worker.hasSystem) {
+            workerModel.initSystem();
+            for (const auto& outputRef : outputRefs) {
+                const Component& component =
+                        outputRef.first.empty()
+                                ? workerModel
+                                : workerModel.getComponent(outputRef.first);
+                worker.outputPlan.addOutput(
+                        component.getOutput(outputRef.second));
+            }
+            for (const auto& discreteVariableRef : discreteVariableRefs) {
+                worker.discreteComponents.push_back(
+                        &workerModel.getComponent(discreteVariableRef.first));
+            }
+            worker.hasSystem = true;
+        }
+
+        // The states of the trajectory belong to the base model's system, so
+        // copy their values into this copy's state.
+        SimTK::State& state = workerModel.updWorkingState();
+        const SimTK::State& trajState = statesTraj[itime];
+        state.setTime(trajState.getTime());
+        state.updY() = trajState.getY();
+
+        // Enforce any SimTK::Motion's included in the model.
+        workerModel.getSystem().prescribe(state);
+
+        SimTK::Vector controls(workerModel.getNumControls(), 0.0);
+        const auto& controlsRow = controlsTable.getRowAtIndex(itime);
+        for (int icontrol = 0; icontrol < (int)controlIndices.size();
+                ++icontrol) {
+            controls[controlIndices[icontrol]] = controlsRow[icontrol];
+        }
+        workerModel.realizeVelocity(state);
+        workerModel.setControls(state, controls);
+
+        for (int idv = 0; idv < (int)discreteVariableRefs.size(); ++idv) {
+            worker.discreteComponents[idv]->setDiscreteVariableValue(state,
+                    discreteVariableRefs[idv].second,
+                    discreteVariablesTable.getMatrix()(itime, idv));
+        }
+
+        // Realize only as far as the outputs require.
+        worker.outputPlan.evaluate(workerModel.getSystem(), state, data[itime]);
+    });
+
+    return TimeSeriesTable_<T>(statesTable.getIndependentColumn(), data,
+            labels);
+}
+
 /// Calculate "synthetic" acceleration signals equivalent to signals recorded
 /// from inertial measurement units (IMUs). First, this utility computes the
 /// linear acceleration for each frame included in 'framePaths' using Frame's
@@ -378,6 +543,48 @@ OSIMSIMULATION_API TimeSeriesTableVec3 createSyntheticIMUAccelerationSignals(
         const TimeSeriesTable& statesTable, const TimeSeriesTable& controlsTable,
         const std::vector<std::string>& framePaths);
 
+/// The synthetic IMU signals computed by createSyntheticIMUSignals(), with
+/// one column per frame (labeled by the frame path) and one row per time.
+/// The tables have the same meaning as the outputs of IMU and the tables of
+/// IMUDataReporter.
+/// @ingroup simulationutil
+struct SyntheticIMUSignals {
+    /// The orientations of the frames in ground.
+    TimeSeriesTable_<SimTK::Quaternion> orientations;
+    /// The angular velocities of the frames, expressed in the frames.
+    TimeSeriesTableVec3 gyroscopeSignals;
+    /// The linear accelerations of the frames minus the gravitational
+    /// acceleration, expressed in the frames (as returned by
+    /// createSyntheticIMUAccelerationSignals()).
+    TimeSeriesTableVec3 accelerometerSignals;
+};
+
+/// Calculate the synthetic orientation, gyroscope, and accelerometer signals
+/// of IMUs attached to the frames in `framePaths`, for the states and controls
+/// of a trajectory (e.g., a MocoTrajectory exported to tables). This is meant
+/// for generating large synthetic IMU datasets: all the signals of all the
+/// frames are computed in one pass per time (each state is realized to
+/// SimTK::Stage::Acceleration once), without evaluating Output%s or adding
+/// components to the model, and the times are divided among `numThreads`
+/// threads (if not positive, getNumThreadsOrDefault() is used), each with its
+/// own copy of the model (see analyzeParallel()). To store the signals
+/// compactly, write the tables to binary files with OSBFileAdapter:
+///
+/// @code{.cpp}
+/// const auto signals = createSyntheticIMUSignals(
+///         model, statesTable, controlsTable, framePaths);
+/// OSBFileAdapter::write(signals.orientations, "orientations.osb");
+/// OSBFileAdapter::write(signals.gyroscopeSignals, "gyroscope.osb");
+/// OSBFileAdapter::write(signals.accelerometerSignals, "accelerometer.osb");
+/// @endcode
+///
+/// The same requirements as for createSyntheticIMUAccelerationSignals() apply.
+/// @ingroup simulationutil
+OSIMSIMULATION_API SyntheticIMUSignals createSyntheticIMUSignals(
+        const Model& model,
+        const TimeSeriesTable& statesTable, const TimeSeriesTable& controlsTable,
+        const std::vector<std::string>& framePaths, int numThreads = -1);
+
 } // end of namespace OpenSim
 
 #endif // OPENSIM_SIMULATION_UTILITIES_H_
@@ -24,9 +24,11 @@
 #include "StatesTrajectory.h"
 
 #include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/StateVariableAccessor.h>
 #include <OpenSim/Common/Storage.h>
 #include <OpenSim/Common/TableUtilities.h>
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/SimulationUtilities.h>
 
 using namespace OpenSim;
 
@@ -139,23 +141,15 @@ TimeSeriesTable StatesTrajectory::exportToTable(const Model& model,
     table.setColumnLabels(stateVars);
     size_t numDepColumns = stateVars.size();
 
-    // Fill up the table with the data.
+    // Fill up the table with the data. The state variables are resolved to
+    // their slots in Y once, rather than for every state.
+    if (getSize() == 0) return table;
+    const StateVariableAccessor accessor(model, get(0), stateVars);
+    SimTK::Vector values(static_cast<int>(numDepColumns));
     for (size_t itime = 0; itime < getSize(); ++itime) {
         const auto& state = get(itime);
-        TimeSeriesTable::RowVector row(static_cast<int>(numDepColumns));
-
-        // Get each state variable's value.
-        if (requestedStateVars.empty()) {
-            // This is *much* faster than getting the values one-by-one.
-            row = model.getStateVariableValues(state).transpose();
-        } else {
-            for (unsigned icol = 0; icol < numDepColumns; ++icol) {
-                row[static_cast<int>(icol)] =
-                    model.getStateVariableValue(state, stateVars[icol]);
-            }
-        }
-
-        table.appendRow(state.getTime(), row);
+        accessor.getValues(state, values);
+        table.appendRow(state.getTime(), values.transpose());
     }
 
     return table;
@@ -171,19 +165,20 @@ StatesTrajectory StatesTrajectory::createFromStatesStorage(
             allowMissingColumns, allowExtraColumns, assemble);
 }
 
-StatesTrajectory StatesTrajectory::createFromStatesTable(
-        const Model& model,
+namespace {
+// Set a state of a copy of the model to each row of the table, and pass the
+// state to `append` (see StatesTrajectory::createFromStatesTable()).
+template <typename AppendFunction>
+void appendStatesFromTable(const Model& model,
         const TimeSeriesTable& table,
         bool allowMissingColumns,
         bool allowExtraColumns,
-        bool assemble) {
+        bool assemble,
+        AppendFunction append) {
 
     // Assemble the required objects.
     // ==============================
 
-    // This is what we'll return.
-    StatesTrajectory states;
-
     // Make a copy of the model so that we can get a corresponding state.
     Model localModel(model);
 
@@ -199,7 +194,8 @@ StatesTrajectory StatesTrajectory::createFromStatesTable(
     // Angular quantities must be expressed in radians.
     // TODO we could also manually convert the necessary coords/speeds to
     // radians.
-    OPENSIM_THROW_IF(TableUtilities::isInDegrees(table), DataIsInDegrees);
+    OPENSIM_THROW_IF(TableUtilities::isInDegrees(table),
+            StatesTrajectory::DataIsInDegrees);
 
     // If column labels aren't unique, it's unclear which column the user
     // wanted to use for the related state variable.
@@ -208,9 +204,11 @@ StatesTrajectory StatesTrajectory::createFromStatesTable(
     // Check if states are missing from the Storage.
     // ---------------------------------------------
     const auto& modelStateNames = localModel.getStateVariableNames();
+    const auto yIndices = createSystemYIndexMap(localModel);
     std::vector<std::string> missingColumnNames;
     // Also, assemble the indices of the states that we will actually set in the
-    // trajectory.
+    // trajectory: the index of the column in the table, and the index of the
+    // state variable in Y.
     std::map<int, int> statesToFillUp;
     for (int is = 0; is < modelStateNames.getSize(); ++is) {
         // getStateIndex() will check for pre-4.0 column names.
@@ -219,11 +217,11 @@ StatesTrajectory StatesTrajectory::createFromStatesTable(
         if (stateIndex == -1) {
             missingColumnNames.push_back(modelStateNames[is]);
         } else {
-            statesToFillUp[stateIndex] = is;
+            statesToFillUp[stateIndex] = yIndices.at(modelStateNames[is]);
         }
     }
     OPENSIM_THROW_IF(!allowMissingColumns && !missingColumnNames.empty(),
-            MissingColumns,
+            StatesTrajectory::MissingColumns,
             localModel.getName(), missingColumnNames);
 
     // Check if the Storage has columns that are not states in the Model.
@@ -239,45 +237,63 @@ StatesTrajectory StatesTrajectory::createFromStatesTable(
                     extraColumnNames.push_back(tableLabels[ic]);
                 }
             }
-            OPENSIM_THROW(ExtraColumns, localModel.getName(),
-                    extraColumnNames);
+            OPENSIM_THROW(StatesTrajectory::ExtraColumns,
+                    localModel.getName(), extraColumnNames);
         }
     }
 
     // Fill up trajectory.
     // ===================
 
-    // Reserve the memory we'll need to fit all the states.
-    states.m_states.reserve(table.getNumRows());
-
-    // Working memory for state. Initialize so that missing columns end up as
-    // NaN.
-    SimTK::Vector statesValues(modelStateNames.getSize(), SimTK::NaN);
-
     // Initialize so that missing columns end up as NaN.
     state.updY().setToNaN();
 
+    // The values are copied into Y directly (rather than with
+    // Model::setStateVariableValues(), which sets each state variable
+    // separately), so that the state is invalidated once per row.
+    const std::vector<std::pair<int, int>> columnsToY(
+            statesToFillUp.begin(), statesToFillUp.end());
+
     // Loop through all rows of the Storage.
+    const auto& matrix = table.getMatrix();
     for (int itime = 0; itime < (int)table.getNumRows(); ++itime) {
-        const auto& row = table.getRowAtIndex(itime);
-
         // Set the correct time in the state.
         state.setTime(table.getIndependentColumn()[itime]);
 
         // Fill up current State with the data for the current time.
-        for (const auto& kv : statesToFillUp) {
-            // 'first': index for Storage; 'second': index for Model.
-            statesValues[kv.second] = row[kv.first];
+        SimTK::Vector& y = state.updY();
+        for (const auto& kv : columnsToY) {
+            // 'first': index for Storage; 'second': index in Y.
+            y[kv.second] = matrix(itime, kv.first);
         }
-        localModel.setStateVariableValues(state, statesValues);
         if (assemble) {
             localModel.assemble(state);
         }
 
-        // Make a copy of the edited state and put it in the trajectory.
-        states.append(state);
+        append(state);
     }
+}
+} // anonymous namespace
 
+StatesTrajectory StatesTrajectory::createFromStatesTable(
+        const Model& model,
+        const TimeSeriesTable& table,
+        bool allowMissingColumns,
+        bool allowExtraColumns,
+        bool assemble) {
+    StatesTrajectory states;
+    // Reserve the memory we'll need to fit all the states.
+    states.m_states.reserve(table.getNumRows());
+    appendStatesFromTable(model, table, allowMissingColumns,
+            allowExtraColumns, assemble,
+            [&states](const SimTK::State& state) {
+                // Make a copy of the edited state and put it in the
+                // trajectory. The states are copies of the same state that
+                // differ only in their time and Y, and the times of a
+                // TimeSeriesTable are increasing, so the checks of append()
+                // are not necessary.
+                states.m_states.push_back(state);
+            });
     return states;
 }
 
@@ -298,3 +314,113 @@ StatesTrajectory::IncompatibleModel::IncompatibleModel(
             "compatible with the StatesTrajectory.";
     addMessage(msg.str());
 }
+
+//==============================================================================
+//                          COMPACT STATES TRAJECTORY
+//==============================================================================
+
+CompactStatesTrajectory::CompactStatesTrajectory(
+        const StatesTrajectory& states) {
+    reserve(states.getSize());
+    for (const auto& state : states) append(state);
+}
+
+void CompactStatesTrajectory::append(const SimTK::State& state) {
+    if (!m_times.empty()) {
+        SimTK_APIARGCHECK2_ALWAYS(m_times.back() <= state.getTime(),
+                "CompactStatesTrajectory", "append",
+                "New state's time (%f) must be equal to or greater than the "
+                "time for the last state in the trajectory (%f).",
+                state.getTime(), m_times.back());
+        OPENSIM_THROW_IF(!m_firstState.isConsistent(state),
+                StatesTrajectory::InconsistentState, state.getTime());
+    }
+    appendUnchecked(state);
+}
+
+void CompactStatesTrajectory::appendUnchecked(const SimTK::State& state) {
+    if (m_times.empty()) {
+        m_firstState = state;
+        m_numY = state.getNY();
+        m_Y.reserve(m_numStatesToReserve * m_numY);
+    }
+    m_times.push_back(state.getTime());
+    const SimTK::Vector& y = state.getY();
+    for (int i = 0; i < m_numY; ++i) m_Y.push_back(y[i]);
+}
+
+void CompactStatesTrajectory::reserve(size_t numStates) {
+    m_numStatesToReserve = numStates;
+    m_times.reserve(numStates);
+    if (m_numY) m_Y.reserve(numStates * m_numY);
+}
+
+void CompactStatesTrajectory::clear() {
+    m_firstState = SimTK::State();
+    m_numY = 0;
+    m_times.clear();
+    m_Y.clear();
+}
+
+void CompactStatesTrajectory::checkIndex(size_t index) const {
+    OPENSIM_THROW_IF(index >= getSize(), IndexOutOfRange, index, 0,
+            getSize() ? getSize() - 1 : 0);
+}
+
+double CompactStatesTrajectory::getTime(size_t index) const {
+    checkIndex(index);
+    return m_times[index];
+}
+
+SimTK::Vector CompactStatesTrajectory::getY(size_t index) const {
+    checkIndex(index);
+    return SimTK::Vector(m_numY, m_Y.data() + index * m_numY);
+}
+
+SimTK::State CompactStatesTrajectory::getState(size_t index) const {
+    checkIndex(index);
+    SimTK::State state(m_firstState);
+    copyToState(index, state);
+    return state;
+}
+
+void CompactStatesTrajectory::copyToState(size_t index,
+        SimTK::State& state) const {
+    checkIndex(index);
+    OPENSIM_THROW_IF(state.getNY() != m_numY, Exception,
+            "Expected a state with {} continuous state variables, but got {}.",
+            m_numY, state.getNY());
+    state.setTime(m_times[index]);
+    SimTK::Vector& y = state.updY();
+    const double* values = m_Y.data() + index * m_numY;
+    for (int i = 0; i < m_numY; ++i) y[i] = values[i];
+}
+
+StatesTrajectory CompactStatesTrajectory::createStatesTrajectory() const {
+    StatesTrajectory states;
+    if (m_times.empty()) return states;
+    SimTK::State state(m_firstState);
+    for (size_t i = 0; i < getSize(); ++i) {
+        copyToState(i, state);
+        states.append(state);
+    }
+    return states;
+}
+
+CompactStatesTrajectory CompactStatesTrajectory::createFromStatesTable(
+        const Model& model,
+        const TimeSeriesTable& table,
+        bool allowMissingColumns,
+        bool allowExtraColumns,
+        bool assemble) {
+    CompactStatesTrajectory states;
+    states.reserve(table.getNumRows());
+    appendStatesFromTable(model, table, allowMissingColumns,
+            allowExtraColumns, assemble,
+            [&states](const SimTK::State& state) {
+                // As for StatesTrajectory::createFromStatesTable(), the
+                // checks of append() are not necessary.
+                states.appendUnchecked(state);
+            });
+    return states;
+}
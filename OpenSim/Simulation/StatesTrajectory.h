@@ -209,6 +209,9 @@ public:
     /// @{
     /** Clear all the states in the trajectory. */
     void clear();
+    /** Preallocate memory for the given number of states, so that appending
+     * them does not reallocate memory. */
+    void reserve(size_t numStates) { m_states.reserve(numStates); }
     /** Append a SimTK::State to this trajectory.
      * This function ensures that the time in the new SimTK::State is greater
      * than or equal to the time in the last SimTK::State in the trajectory.
@@ -408,6 +411,13 @@ public:
      * this function optionally modifies each state to obey any constraints in
      * the model (by calling Model::assemble()).
      *
+     * The columns of the table are matched to the state variables of the
+     * model once; for each row, the values are copied into Y of a copy of the
+     * same state. Unless `assemble` is true, the cost per row is therefore
+     * mostly that of copying a SimTK::State; use
+     * CompactStatesTrajectory::createFromStatesTable() if you only need the
+     * values of the states.
+     *
      * The states in the resulting trajectory will be realized to
      * SimTK::Stage::Instance. You should not use the resulting trajectory with
      * an instance of the model other than the one you passed to this function
@@ -479,6 +489,97 @@ public:
             const std::string& filepath);
 };
 
+/**
+ * A trajectory of states that stores only the time and the continuous state
+ * variables (SimTK::State::getY(), that is, Q, U, and Z) of each state, in a
+ * contiguous block of memory. A StatesTrajectory stores a full
+ * SimTK::State (including its cache) for each time, which can take an order
+ * of magnitude more memory; use this class when you only need the values of
+ * the states, e.g., to analyze the states of many trials:
+ * @code{.cpp}
+ * Model model("subject01.osim");
+ * model.initSystem();
+ * auto states = CompactStatesTrajectory::createFromStatesTable(model,
+ *         TimeSeriesTable("subject01_states.sto"));
+ * SimTK::State state = states.getState(0);
+ * for (size_t i = 0; i < states.getSize(); ++i) {
+ *     states.copyToState(i, state); // Does not allocate a new State.
+ *     model.realizePosition(state);
+ *     std::cout << model.calcMassCenterPosition(state) << std::endl;
+ * }
+ * @endcode
+ *
+ * A SimTK::State is created (materialized) on demand from a copy of the first
+ * state of the trajectory, with the time and Y of the requested state. The
+ * discrete variables and modeling options of all the states are therefore
+ * those of the first state (for createFromStatesTable(), as for
+ * StatesTrajectory::createFromStatesTable(), these are the default values of
+ * the model).
+ *
+ * As with StatesTrajectory, the states are ordered nondecreasing in time and
+ * are consistent with each other.
+ */
+class OSIMSIMULATION_API CompactStatesTrajectory {
+public:
+    /** Create an empty trajectory of states. */
+    CompactStatesTrajectory() = default;
+    /** Create a trajectory with the time and Y of the given states. */
+    explicit CompactStatesTrajectory(const StatesTrajectory& states);
+
+    /** The number of states in the trajectory. */
+    size_t getSize() const { return m_times.size(); }
+    /** The number of continuous state variables (the size of Y) of each
+     * state, or 0 if the trajectory is empty. */
+    int getNumY() const { return m_numY; }
+
+    /** Append the time and Y of a state to the trajectory. The state must not
+     * be earlier than the last state of the trajectory, and must be
+     * consistent with the other states (see
+     * StatesTrajectory::append()). */
+    void append(const SimTK::State& state);
+    /** Preallocate memory for the given number of states. */
+    void reserve(size_t numStates);
+    /** Remove all the states from the trajectory. */
+    void clear();
+
+    /** The time of the state at the given index. */
+    double getTime(size_t index) const;
+    /** The Y of the state at the given index. */
+    SimTK::Vector getY(size_t index) const;
+
+    /** Create the SimTK::State at the given index. */
+    SimTK::State getState(size_t index) const;
+    /** Set the time and Y of `state` (e.g., created by getState()) to those
+     * of the state at the given index. This avoids creating a new
+     * SimTK::State for each state of the trajectory.
+     * @throws Exception if `state` has a different number of continuous
+     *      state variables than the trajectory. */
+    void copyToState(size_t index, SimTK::State& state) const;
+    /** Create the SimTK::State of each state of the trajectory. */
+    StatesTrajectory createStatesTrajectory() const;
+
+    /** Same as StatesTrajectory::createFromStatesTable(), but the trajectory
+     * stores only the time and Y of each state. */
+    static CompactStatesTrajectory createFromStatesTable(const Model& model,
+            const TimeSeriesTable& table,
+            bool allowMissingColumns = false,
+            bool allowExtraColumns = false,
+            bool assemble = false);
+
+private:
+    void checkIndex(size_t index) const;
+    // append() without checking the time and the consistency of the state.
+    void appendUnchecked(const SimTK::State& state);
+
+    // A copy of the first state, from which the states are created.
+    SimTK::State m_firstState;
+    int m_numY = 0;
+    std::vector<double> m_times;
+    // The Y of each state, one after another.
+    std::vector<double> m_Y;
+    size_t m_numStatesToReserve = 0;
+};
+
 } // namespace
 
 // TODO The following class description should be revisited when support for
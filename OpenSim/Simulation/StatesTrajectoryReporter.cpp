@@ -23,17 +23,53 @@
 
 #include "StatesTrajectoryReporter.h"
 
+#include <OpenSim/Common/STOFileAdapter.h>
+
+#include <limits>
+
 using namespace OpenSim;
 
+StatesTrajectoryReporter::StatesTrajectoryReporter() {
+    constructProperties();
+}
+
+void StatesTrajectoryReporter::constructProperties() {
+    constructProperty_output_file();
+    constructProperty_max_num_states(-1);
+}
 
 void StatesTrajectoryReporter::clear() {
     m_states.clear();
+    m_recentStates.clear();
+    m_outputStream.reset();
 }
 
 const StatesTrajectory& StatesTrajectoryReporter::getStates() const {
+    if (getMaxNumStatesInMemory() >= 0) {
+        m_states.clear();
+        for (const auto& state : m_recentStates) m_states.append(state);
+    }
     return m_states;
 }
 
+void StatesTrajectoryReporter::reserve(size_t numStates) {
+    if (getMaxNumStatesInMemory() < 0) m_states.reserve(numStates);
+}
+
+StatesTrajectory StatesTrajectoryReporter::releaseStates() {
+    getStates();
+    StatesTrajectory states(std::move(m_states));
+    m_states.clear();
+    m_recentStates.clear();
+    return states;
+}
+
+int StatesTrajectoryReporter::getMaxNumStatesInMemory() const {
+    if (get_max_num_states() < 0 && !getProperty_output_file().empty())
+        return 0;
+    return get_max_num_states();
+}
+
 /*
 TODO we have to discuss if the trajectory should be cleared.
 void StatesTrajectoryReporter::extendRealizeInstance(const SimTK::State& state) const {
@@ -43,5 +79,43 @@ void StatesTrajectoryReporter::extendRealizeInstance(const SimTK::State& state)
 */
 
 void StatesTrajectoryReporter::implementReport(const SimTK::State& state) const {
-    m_states.append(state);
+    if (!getProperty_output_file().empty()) writeState(state);
+
+    const int maxNumStates = getMaxNumStatesInMemory();
+    if (maxNumStates < 0) {
+        m_states.append(state);
+    } else if (maxNumStates > 0) {
+        if ((int)m_recentStates.size() == maxNumStates)
+            m_recentStates.pop_front();
+        m_recentStates.push_back(state);
+    }
+}
+
+void StatesTrajectoryReporter::writeState(const SimTK::State& state) const {
+    const Component& root = getRoot();
+    const SimTK::Vector values = root.getStateVariableValues(state);
+    if (m_outputStream.get() == nullptr) {
+        // Write the header and the first row with STOFileAdapter, so that the
+        // file has the same format as other STO files, then append the
+        // other rows as they are reported.
+        const std::string& fileName = get_output_file();
+        TimeSeriesTable table;
+        std::vector<std::string> labels;
+        const auto names = root.getStateVariableNames();
+        for (int i = 0; i < names.size(); ++i) labels.push_back(names[i]);
+        table.setColumnLabels(labels);
+        table.addTableMetaData<std::string>("inDegrees", "no");
+        table.appendRow(state.getTime(), values.transpose());
+        STOFileAdapter::write(table, fileName);
+        m_outputStream.reset(
+                new std::ofstream(fileName, std::ios::out | std::ios::app));
+        OPENSIM_THROW_IF_FRMOBJ(!*m_outputStream, Exception,
+                "Could not open the output file '{}'.", fileName);
+        m_outputStream->precision(std::numeric_limits<double>::digits10 + 1);
+        return;
+    }
+    std::ofstream& out = *m_outputStream;
+    out << state.getTime();
+    for (int i = 0; i < values.size(); ++i) out << '\t' << values[i];
+    out << '\n';
 }
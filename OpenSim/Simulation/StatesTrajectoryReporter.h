@@ -26,6 +26,9 @@
 #include "StatesTrajectory.h"
 #include <OpenSim/Common/Reporter.h>
 
+#include <deque>
+#include <fstream>
+
 #include "osimSimulationDLL.h"
 
 namespace OpenSim {
@@ -35,16 +38,56 @@ namespace OpenSim {
  * This class was introduced in v4.0 and is intended to replace the
  * StatesReporter analysis.
  *
+ * Storing every State (including its cache) of a long simulation with a
+ * small reporting interval can take a lot of memory. Instead, the values of
+ * the state variables can be written to an STO file as they are reported
+ * (output_file), and the number of states kept in memory can be limited to
+ * the most recent ones (max_num_states), e.g., for debugging the end of a
+ * simulation that failed:
+ * @code{.cpp}
+ * auto* reporter = new StatesTrajectoryReporter();
+ * reporter->set_output_file("states.sto");
+ * reporter->set_max_num_states(10); // Keep the last 10 states in memory.
+ * model.addComponent(reporter);
+ * ...
+ * reporter->clear(); // Close the file.
+ * TimeSeriesTable table("states.sto");
+ * auto states = StatesTrajectory::createFromStatesTable(model, table);
+ * @endcode
+ * The file contains the time and the values of the state variables of the
+ * model (in the units of the model, with the columns named as by
+ * Component::getStateVariableNames()), not the discrete variables, modeling
+ * options, or cache of the states.
+ *
  * @ingroup reporters
  */
 class OSIMSIMULATION_API StatesTrajectoryReporter : public AbstractReporter {
 OpenSim_DECLARE_CONCRETE_OBJECT(StatesTrajectoryReporter, AbstractReporter);
 
 public:
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(output_file, std::string,
+        "If set, the time and the values of the state variables of each "
+        "reported state are written to this STO file as they are reported. "
+        "The file is written from the start (overwritten) at the first report "
+        "after the construction of the reporter or a call to clear().");
+    OpenSim_DECLARE_PROPERTY(max_num_states, int,
+        "The maximum number of states kept in memory; when it is reached, "
+        "the oldest state is discarded for each new state. The default (-1) "
+        "keeps all the states, or none if output_file is set.");
+
+    StatesTrajectoryReporter();
+
     /** Access the accumulated states. */
     const StatesTrajectory& getStates() const; 
-    /** Clear the accumulated states. */ 
+    /** Clear the accumulated states, and finish writing output_file (if
+     * any). */ 
     void clear();
+    /** Preallocate memory for the given number of states (e.g., the number of
+     * reporting times of the next simulation). */
+    void reserve(size_t numStates);
+    /** Move the accumulated states out of this reporter, leaving it with an
+     * empty trajectory. This avoids copying the states after a simulation. */
+    StatesTrajectory releaseStates();
 
 protected:
     // /** Clears the internal StatesTrajectory in preparation for a (new)
@@ -56,9 +99,21 @@ protected:
     void implementReport(const SimTK::State& state) const override;
 
 private:
+    void constructProperties();
+    // Write the state to output_file, starting the file if necessary.
+    void writeState(const SimTK::State& state) const;
+    // The maximum number of states to keep in memory, or -1 for no limit.
+    int getMaxNumStatesInMemory() const;
+
     // Mutable because we append during reporting. This is OK to do since
     // reporting never occurs for trial states.
     mutable StatesTrajectory m_states;
+    // The most recent states, if max_num_states limits the number of states
+    // kept in memory; getStates() copies them to m_states.
+    mutable std::deque<SimTK::State> m_recentStates;
+    // The stream to which the rows of output_file are appended, once the
+    // file has been started by writing its header and first row.
+    mutable SimTK::ResetOnCopy<std::unique_ptr<std::ofstream>> m_outputStream;
 };
 
 } // namespace
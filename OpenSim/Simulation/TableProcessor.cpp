@@ -0,0 +1,294 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim: TableProcessor.cpp                                                *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "TableProcessor.h"
+
+#include <OpenSim/Common/About.h>
+#include <OpenSim/Common/IO.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <random>
+
+using namespace OpenSim;
+
+namespace {
+
+// Layout of the cache files (see TableProcessor::process()). All numbers are
+// stored with the byte order of the machine that wrote the file.
+const char cacheSignature[8] = {'O', 'S', 'I', 'M', 'T', 'A', 'B', 'C'};
+const std::uint32_t cacheByteOrderMark = 0x01020304;
+const std::uint32_t cacheFormatVersion = 1;
+
+std::string& cacheDirectory() {
+    static std::string directory = [] {
+        const char* env = std::getenv("OPENSIM_PROCESSOR_CACHE_DIR");
+        return std::string(env ? env : "");
+    }();
+    return directory;
+}
+
+// 64-bit FNV-1a hash, which can be computed in parts.
+class Hash {
+public:
+    void add(const void* data, std::size_t numBytes) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < numBytes; ++i) {
+            _hash ^= bytes[i];
+            _hash *= 1099511628211ULL;
+        }
+    }
+    void add(const std::string& str) {
+        const std::uint64_t size = str.size();
+        add(&size, sizeof(size));
+        add(str.data(), str.size());
+    }
+    std::uint64_t get() const { return _hash; }
+private:
+    std::uint64_t _hash = 14695981039346656037ULL;
+};
+
+template <typename U>
+void writePod(std::ostream& out, const U& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(U));
+}
+
+void writeString(std::ostream& out, const std::string& str) {
+    writePod<std::uint64_t>(out, str.size());
+    out.write(str.data(), str.size());
+}
+
+void readBytes(std::istream& in, char* dest, std::size_t numBytes) {
+    in.read(dest, numBytes);
+    OPENSIM_THROW_IF(!in, IOError, "Unexpected end of cache file.");
+}
+
+template <typename U>
+U readPod(std::istream& in) {
+    U value;
+    readBytes(in, reinterpret_cast<char*>(&value), sizeof(U));
+    return value;
+}
+
+std::string readString(std::istream& in) {
+    const auto size = readPod<std::uint64_t>(in);
+    std::string str(static_cast<std::size_t>(size), '\0');
+    if (size) readBytes(in, &str[0], str.size());
+    return str;
+}
+
+// The table metadata, if all of it can be stored in a cache file (only
+// strings, and no metadata for the columns other than their labels).
+bool getCacheableMetaData(const TimeSeriesTable& table,
+        std::vector<std::pair<std::string, std::string>>& metaData) {
+    for (const auto& key : table.getDependentsMetaData().getKeys()) {
+        if (key != "labels") return false;
+    }
+    for (const auto& key : table.getTableMetaDataKeys()) {
+        try {
+            metaData.emplace_back(
+                    key, table.getTableMetaData<std::string>(key));
+        } catch (const InvalidTemplateArgument&) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void hashTable(Hash& hash, const TimeSeriesTable& table) {
+    for (const auto& label : table.getColumnLabels()) hash.add(label);
+    for (const auto& key : table.getTableMetaDataKeys()) {
+        hash.add(key);
+        hash.add(table.getTableMetaData().getValueAsString(key));
+    }
+    const auto& time = table.getIndependentColumn();
+    hash.add(time.data(), sizeof(double) * time.size());
+    const auto& matrix = table.getMatrix();
+    for (int icol = 0; icol < matrix.ncol(); ++icol) {
+        for (int irow = 0; irow < matrix.nrow(); ++irow) {
+            const double value = matrix(irow, icol);
+            hash.add(&value, sizeof(value));
+        }
+    }
+}
+
+bool writeCacheFile(const std::string& fileName, std::uint64_t key,
+        const TimeSeriesTable& table) {
+    std::vector<std::pair<std::string, std::string>> metaData;
+    if (!getCacheableMetaData(table, metaData)) return false;
+    std::ofstream out(fileName, std::ios::binary);
+    if (!out.good()) return false;
+    out.write(cacheSignature, sizeof(cacheSignature));
+    writePod(out, cacheByteOrderMark);
+    writePod(out, cacheFormatVersion);
+    writePod<std::uint64_t>(out, key);
+    writePod<std::uint64_t>(out, metaData.size());
+    for (const auto& entry : metaData) {
+        writeString(out, entry.first);
+        writeString(out, entry.second);
+    }
+    const auto& labels = table.getColumnLabels();
+    writePod<std::uint64_t>(out, labels.size());
+    for (const auto& label : labels) writeString(out, label);
+    const auto& time = table.getIndependentColumn();
+    writePod<std::uint64_t>(out, time.size());
+    out.write(reinterpret_cast<const char*>(time.data()),
+            sizeof(double) * time.size());
+    const auto& matrix = table.getMatrix();
+    for (int icol = 0; icol < matrix.ncol(); ++icol) {
+        for (int irow = 0; irow < matrix.nrow(); ++irow) {
+            writePod<double>(out, matrix(irow, icol));
+        }
+    }
+    return out.good();
+}
+
+TimeSeriesTable readCacheFile(const std::string& fileName, std::uint64_t key) {
+    std::ifstream in(fileName, std::ios::binary);
+    OPENSIM_THROW_IF(!in.is_open(), IOError,
+            "Could not open '{}'.", fileName);
+    char signature[sizeof(cacheSignature)];
+    readBytes(in, signature, sizeof(signature));
+    OPENSIM_THROW_IF(!std::equal(signature, signature + sizeof(signature),
+                             cacheSignature) ||
+                    readPod<std::uint32_t>(in) != cacheByteOrderMark ||
+                    readPod<std::uint32_t>(in) != cacheFormatVersion ||
+                    readPod<std::uint64_t>(in) != key,
+            IOError, "Unexpected header.");
+    std::vector<std::pair<std::string, std::string>> metaData(
+            (std::size_t)readPod<std::uint64_t>(in));
+    for (auto& entry : metaData) {
+        entry.first = readString(in);
+        entry.second = readString(in);
+    }
+    std::vector<std::string> labels((std::size_t)readPod<std::uint64_t>(in));
+    for (auto& label : labels) label = readString(in);
+    std::vector<double> time((std::size_t)readPod<std::uint64_t>(in));
+    if (!time.empty()) {
+        readBytes(in, reinterpret_cast<char*>(time.data()),
+                sizeof(double) * time.size());
+    }
+    SimTK::Matrix matrix((int)time.size(), (int)labels.size());
+    for (int icol = 0; icol < matrix.ncol(); ++icol) {
+        for (int irow = 0; irow < matrix.nrow(); ++irow) {
+            matrix(irow, icol) = readPod<double>(in);
+        }
+    }
+    TimeSeriesTable table(time, matrix, labels);
+    for (const auto& entry : metaData) {
+        table.addTableMetaData(entry.first, entry.second);
+    }
+    return table;
+}
+
+} // anonymous namespace
+
+void TableProcessor::setCacheDirectory(const std::string& directory) {
+    cacheDirectory() = directory;
+}
+
+const std::string& TableProcessor::getCacheDirectory() {
+    return cacheDirectory();
+}
+
+std::string TableProcessor::getCacheFileName(const std::string& path,
+        const Model* model, unsigned long long& key) const {
+    const std::string& cacheDir = getCacheDirectory();
+    if (cacheDir.empty()) return {};
+    for (int i = 0; i < getProperty_operators().size(); ++i) {
+        if (!get_operators(i).isCacheable()) return {};
+    }
+
+    Hash hash;
+    hash.add(GetVersion());
+    if (m_tableProvided) {
+        hashTable(hash, m_table);
+    } else {
+        std::ifstream in(path, std::ios::binary);
+        if (!in.is_open()) return {};
+        // The file name determines the format of the file.
+        hash.add(IO::GetSuffix(path, 4));
+        hash.add(std::string((std::istreambuf_iterator<char>(in)),
+                std::istreambuf_iterator<char>()));
+    }
+    for (int i = 0; i < getProperty_operators().size(); ++i) {
+        hash.add(get_operators(i).dump());
+    }
+    hash.add(model ? model->dump() : std::string());
+
+    key = hash.get();
+    char name[64];
+    snprintf(name, sizeof(name), "%016llx.osimtabc", key);
+    const char last = cacheDir.back();
+    return cacheDir + (last == '/' || last == '\\' ? "" : "/") + name;
+}
+
+TimeSeriesTable TableProcessor::process(
+        std::string relativeToDirectory, const Model* model) const {
+    OPENSIM_THROW_IF_FRMOBJ(get_filepath().empty() && !m_tableProvided,
+            Exception, "No source table.");
+    OPENSIM_THROW_IF_FRMOBJ(!get_filepath().empty() && m_tableProvided,
+            Exception,
+            "Expected either an in-memory table or a filepath, but "
+            "both were provided.");
+    std::string path = get_filepath();
+    if (!m_tableProvided && !relativeToDirectory.empty()) {
+        using SimTK::Pathname;
+        path = Pathname::getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                relativeToDirectory, path);
+    }
+
+    unsigned long long key = 0;
+    const std::string cacheFileName = getCacheFileName(path, model, key);
+    if (!cacheFileName.empty() && IO::FileExists(cacheFileName)) {
+        try {
+            return readCacheFile(cacheFileName, key);
+        } catch (const std::exception& x) {
+            log_warn("Ignoring cache file '{}' of TableProcessor: {}",
+                    cacheFileName, x.what());
+        }
+    }
+
+    TimeSeriesTable table;
+    if (m_tableProvided) {
+        table = m_table;
+    } else {
+        table = TimeSeriesTable(path);
+    }
+
+    for (int i = 0; i < getProperty_operators().size(); ++i) {
+        get_operators(i).operate(table, model);
+    }
+
+    if (!cacheFileName.empty()) {
+        // Write under a temporary name and then rename, so that processes
+        // running the same processor concurrently never read an incomplete
+        // file.
+        const std::string tempFileName = cacheFileName + "." +
+                std::to_string(std::random_device{}()) + ".tmp";
+        if (!writeCacheFile(tempFileName, key, table) ||
+                std::rename(tempFileName.c_str(), cacheFileName.c_str()) != 0) {
+            // E.g., the table cannot be cached, or another process wrote the
+            // same cache file first.
+            std::remove(tempFileName.c_str());
+        }
+    }
+    return table;
+}
@@ -36,6 +36,12 @@ public:
     /** This function may or may not be provided with a model. If the operation
     requires a model and model == nullptr, an exception is thrown. */
     virtual void operate(TimeSeriesTable& table, const Model* model) const = 0;
+    /** Whether the result of this operator is determined by its properties,
+    the table, and the model, so that TableProcessor can cache the processed
+    table (see TableProcessor::setCacheDirectory()). Operators that read
+    files must return false, since changes to the files would go
+    unnoticed. */
+    virtual bool isCacheable() const { return true; }
 };
 
 /** This class describes a workflow for processing a table using
@@ -44,7 +50,17 @@ to a table or an in-memory TimeSeriesTable. In C++, one can easily chain
 together the operators in a processor using the C++ pipe operator:
 @code
 TableProcessor proc = TableProcessor("file.sto") | TabOpLowPassFilter(6);
-@endcode */
+@endcode
+
+If a cache directory is set (see setCacheDirectory()), process() stores the
+processed table in a binary file in that directory, named after a hash of the
+source table (the contents of the file, or the in-memory table), the
+properties of the operators, and the model (if provided). Processing the same
+table with the same operators again loads this file instead of applying the
+operators. Processors are not cached if any of their operators is not
+cacheable (see TableOperator::isCacheable()), or if the processed table has
+metadata that are not strings or metadata for its columns other than their
+labels. */
 class OSIMSIMULATION_API TableProcessor : public Object {
     OpenSim_DECLARE_CONCRETE_OBJECT(TableProcessor, Object);
 
@@ -79,32 +95,7 @@ public:
     contains such an operator, then the operator will throw an exception
     if you do not provide a model when invoking this function. */
     TimeSeriesTable process(std::string relativeToDirectory,
-            const Model* model = nullptr) const {
-        OPENSIM_THROW_IF_FRMOBJ(get_filepath().empty() && !m_tableProvided,
-                Exception, "No source table.");
-        OPENSIM_THROW_IF_FRMOBJ(!get_filepath().empty() && m_tableProvided,
-                Exception,
-                "Expected either an in-memory table or a filepath, but "
-                "both were provided.");
-        TimeSeriesTable table;
-        if (m_tableProvided) {
-            table = m_table;
-        } else {
-            std::string path = get_filepath();
-            if (!relativeToDirectory.empty()) {
-                using SimTK::Pathname;
-                path = Pathname::
-                        getAbsolutePathnameUsingSpecifiedWorkingDirectory(
-                                relativeToDirectory, path);
-            }
-            table = TimeSeriesTable(path);
-        }
-
-        for (int i = 0; i < getProperty_operators().size(); ++i) {
-            get_operators(i).operate(table, model);
-        }
-        return table;
-    }
+            const Model* model = nullptr) const;
     /** Same as above, but paths are evaluated with respect to the current
     working directory. */
     TimeSeriesTable process(const Model* model = nullptr) const {
@@ -154,7 +145,26 @@ public:
         return append(right);
     }
 
+    /** @name Cache of processed tables
+    Caching is disabled by default. The cache directory can also be set with
+    the `OPENSIM_PROCESSOR_CACHE_DIR` environment variable (which also
+    enables the cache of ModelProcessor); setCacheDirectory() takes
+    precedence. The directory is not thread-safe to change while tables are
+    being processed. */
+    /// @{
+    /** Set the directory for cache files (it must exist). An empty string
+    disables caching. */
+    static void setCacheDirectory(const std::string& directory);
+    static const std::string& getCacheDirectory();
+    /// @}
+
 private:
+    /** The path of the cache file of the processed table, or an empty string
+    if this processor cannot be cached; `key` is set to the hash in the name
+    of the file. */
+    std::string getCacheFileName(const std::string& path, const Model* model,
+            unsigned long long& key) const;
+
     bool m_tableProvided = false;
     TimeSeriesTable m_table;
 };
@@ -0,0 +1,176 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim: testAllocations.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Tests of the heap allocations of hot code (see AllocationScope.h). The
+functions that must not allocate are checked; the allocations per
+integration step and per realization are reported, so that changes to them
+can be seen in the output of the test. */
+
+#include <OpenSim/Actuators/DeGrooteFregly2016Muscle.h>
+#include <OpenSim/Actuators/ModelFactory.h>
+#include <OpenSim/Common/GCVSpline.h>
+#include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Simulation/Model/Model.h>
+
+#define OPENSIM_ALLOCATION_SCOPE_MAIN
+#include <OpenSim/Auxiliary/AllocationScope.h>
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch/catch.hpp>
+
+using namespace OpenSim;
+
+namespace {
+    /// A pendulum actuated by a muscle.
+    Model createMusclePendulum() {
+        Model model = ModelFactory::createPendulum();
+        auto* muscle = new DeGrooteFregly2016Muscle();
+        muscle->setName("muscle");
+        muscle->set_max_isometric_force(100);
+        muscle->set_optimal_fiber_length(0.8);
+        muscle->set_tendon_slack_length(0.4);
+        muscle->addNewPathPoint("origin", model.updGround(),
+                SimTK::Vec3(0, 1, 0));
+        muscle->addNewPathPoint("insertion",
+                model.updComponent<Body>("bodyset/b0"),
+                SimTK::Vec3(-0.5, 0, 0));
+        model.addForce(muscle);
+        model.finalizeConnections();
+        return model;
+    }
+}
+
+TEST_CASE("AllocationScope counts allocations") {
+    if (!isAllocationCountingEnabled()) {
+        WARN("Allocations are not counted on this platform.");
+        return;
+    }
+    AllocationScope scope;
+    Model model = ModelFactory::createPendulum();
+    CHECK(scope.getNumAllocations() > 0);
+    CHECK(scope.getNumBytesAllocated() > 0);
+    scope.reset();
+    CHECK(scope.getNumAllocations() == 0);
+}
+
+TEST_CASE("Hot functions do not allocate") {
+    if (!isAllocationCountingEnabled()) return;
+
+    SECTION("GCVSpline::evaluate()") {
+        const int size = 101;
+        double x[size], y[size];
+        for (int i = 0; i < size; ++i) {
+            x[i] = 0.01 * i;
+            y[i] = std::sin(2 * SimTK::Pi * x[i]);
+        }
+        GCVSpline spline(5, size, x, y);
+        // The coefficients are fit on the first evaluation.
+        spline.evaluate(0.0);
+
+        double sum = 0;
+        int interval = 0;
+        AllocationScope scope;
+        for (int i = 0; i < 1000; ++i) {
+            const double t = 0.001 * i;
+            sum += spline.evaluate(t, 0, interval);
+            sum += spline.evaluate(t, 1, interval);
+            sum += spline.evaluate(t);
+        }
+        CHECK(scope.getNumAllocations() == 0);
+        CHECK(SimTK::isFinite(sum));
+    }
+
+    SECTION("DeGrooteFregly2016Muscle curves") {
+        DeGrooteFregly2016Muscle muscle;
+        double sum = 0;
+        AllocationScope scope;
+        for (int i = 0; i < 1000; ++i) {
+            const double normLength = 0.5 + 0.001 * i;
+            const double normVelocity = -1 + 0.002 * i;
+            sum += muscle.calcActiveForceLengthMultiplier(normLength);
+            sum += muscle.calcPassiveForceMultiplier(normLength);
+            sum += muscle.calcTendonForceMultiplier(1 + 0.00005 * i);
+            sum += muscle.calcForceVelocityMultiplier(normVelocity);
+        }
+        CHECK(scope.getNumAllocations() == 0);
+        CHECK(SimTK::isFinite(sum));
+    }
+}
+
+TEST_CASE("Allocations per realization and integration step") {
+    if (!isAllocationCountingEnabled()) return;
+
+    Model model = createMusclePendulum();
+    SimTK::State state = model.initSystem();
+    model.getCoordinateSet().get("q0").setValue(state, 0.1);
+    model.realizeAcceleration(state);
+
+    SECTION("Model realizations") {
+        const int numRealizations = 100;
+        const std::vector<std::pair<std::string, SimTK::Stage>> stages = {
+                {"Position", SimTK::Stage::Position},
+                {"Velocity", SimTK::Stage::Velocity},
+                {"Dynamics", SimTK::Stage::Dynamics},
+                {"Acceleration", SimTK::Stage::Acceleration}};
+        for (const auto& stage : stages) {
+            AllocationScope scope;
+            for (int i = 0; i < numRealizations; ++i) {
+                state.invalidateAllCacheAtOrAbove(stage.second);
+                model.getMultibodySystem().realize(state, stage.second);
+            }
+            std::cout << "Allocations per realization to " << stage.first
+                      << ": " << (double)scope.getNumAllocations() /
+                                         numRealizations
+                      << std::endl;
+        }
+    }
+
+    SECTION("Manager::step()") {
+        Manager manager(model);
+        manager.initialize(state);
+        // The integrator allocates its workspace in the first steps.
+        for (int i = 0; i < 10; ++i) manager.step(0.001);
+        const int numSteps = 100;
+        AllocationScope scope;
+        for (int i = 0; i < numSteps; ++i) manager.step(0.001);
+        std::cout << "Allocations per Manager::step(): "
+                  << (double)scope.getNumAllocations() / numSteps
+                  << std::endl;
+    }
+
+    SECTION("Manager::integrate()") {
+        Manager manager(model);
+        manager.initialize(state);
+        manager.integrate(0.01);
+        const int numStepsBefore = manager.getIntegrator().getNumStepsTaken();
+        AllocationScope scope;
+        manager.integrate(0.5);
+        const int numSteps =
+                manager.getIntegrator().getNumStepsTaken() - numStepsBefore;
+        REQUIRE(numSteps > 0);
+        // This includes recording the states.
+        std::cout << "Allocations per integrator step of "
+                  << "Manager::integrate(): "
+                  << (double)scope.getNumAllocations() / numSteps
+                  << std::endl;
+    }
+}
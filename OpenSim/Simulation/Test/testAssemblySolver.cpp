@@ -30,6 +30,7 @@
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
 #include <OpenSim/Common/MultivariatePolynomialFunction.h>
+#include <OpenSim/Common/SimmSpline.h>
 #include <OpenSim/Simulation/osimSimulation.h>
 
 using namespace OpenSim;
@@ -41,7 +42,9 @@ void instrumentSetStateValues(const string& modelFile);
 void testAssembleModelWithConstraints(string modelFile);
 void testAssemblySatisfiesConstraints(string modelFile);
 double calcLigamentLengthError(const SimTK::State &s, const Model &model);
+void testSetCoordinateValues(const string& modelFile);
 void testCoordinateCouplerCompoundFunction();
+void testCoordinateCouplerSingleCoordinate();
 
 int main()
 {
@@ -53,10 +56,12 @@ int main()
         //       plus explicit Model::assemble() after model.setStateVariableValues()
         instrumentSetStateValues("PushUpToesOnGroundLessPreciseConstraints.osim");
         testAssemblySatisfiesConstraints("knee_patella_ligament.osim");
+        testSetCoordinateValues("knee_patella_ligament.osim");
         testAssembleModelWithConstraints("PushUpToesOnGroundExactConstraints.osim");
         testAssembleModelWithConstraints("PushUpToesOnGroundLessPreciseConstraints.osim");
         testAssembleModelWithConstraints("PushUpToesOnGroundWithMuscles.osim");
         testCoordinateCouplerCompoundFunction();
+        testCoordinateCouplerSingleCoordinate();
     }
     catch (const std::exception& e) {
         cout << "\ntestAssemblySolver FAILED " << e.what() <<endl;
@@ -345,6 +350,48 @@ void testAssemblySatisfiesConstraints(string modelFile)
     }
 }
 
+void testSetCoordinateValues(const string& modelFile)
+{
+    Model model(modelFile);
+    model.set_assembly_accuracy(1e-8);
+    SimTK::State& state = model.initSystem();
+    const CoordinateSet& coords = model.getCoordinateSet();
+
+    // Setting one coordinate is the same as Coordinate::setValue().
+    SimTK::State expected = state;
+    const double kneeAngle = -SimTK::Pi/4;
+    coords[0].setValue(expected, kneeAngle, true);
+    model.setCoordinateValues(state, {coords[0].getName()},
+            SimTK::Vector(1, kneeAngle));
+    SimTK_TEST_EQ(state.getQ(), expected.getQ());
+    ASSERT_EQUAL(0.0, calcLigamentLengthError(state, model),
+            model.get_assembly_accuracy(), __FILE__, __LINE__,
+            "Constraints NOT satisfied to within assembly accuracy");
+
+    // All the coordinates at once (with their current values), by index.
+    std::vector<int> indices;
+    SimTK::Vector values(coords.getSize());
+    for (int i = 0; i < coords.getSize(); ++i) {
+        indices.push_back(i);
+        values[i] = coords[i].getValue(state);
+    }
+    values[0] = -SimTK::Pi/3;
+    model.setCoordinateValues(state, indices, values);
+    ASSERT_EQUAL(0.0, calcLigamentLengthError(state, model),
+            model.get_assembly_accuracy(), __FILE__, __LINE__,
+            "Constraints NOT satisfied to within assembly accuracy");
+
+    // Without enforcing the constraints, the values are set as given.
+    values[0] = -SimTK::Pi/6;
+    model.setCoordinateValues(state, indices, values, false);
+    SimTK_TEST_EQ(coords[0].getValue(state), -SimTK::Pi/6);
+
+    SimTK_TEST_MUST_THROW_EXC(model.setCoordinateValues(state,
+            {coords[0].getName()}, SimTK::Vector(2, 0.0)), Exception);
+    SimTK_TEST_MUST_THROW_EXC(model.setCoordinateValues(state,
+            {"not_a_coordinate"}, SimTK::Vector(1, 0.0)), Exception);
+}
+
 double calcLigamentLengthError(const SimTK::State &s, const Model &model)
 {
     using namespace SimTK;
@@ -443,3 +490,47 @@ void testCoordinateCouplerCompoundFunction() {
                 "coordinate based on a MultivariatePolynomialFunction.");
     }
 }
+
+void testCoordinateCouplerSingleCoordinate() {
+
+    // Test the CoordinateCouplerConstraint of one independent coordinate,
+    // with a spline (evaluated directly) and with a LinearFunction (evaluated
+    // through its SimTK::Function), and a scale factor.
+
+    auto checkCoupler = [](const Function& f, const std::string& name) {
+        Model model = ModelFactory::createNLinkPendulum(2);
+        const double scaleFactor = 0.5;
+        auto* constraint = new CoordinateCouplerConstraint();
+        constraint->setFunction(f);
+        constraint->setDependentCoordinateName("q1");
+        Array<std::string> independentCoordinateNames;
+        independentCoordinateNames.append("q0");
+        constraint->setIndependentCoordinateNames(independentCoordinateNames);
+        constraint->set_scale_factor(scaleFactor);
+        model.addConstraint(constraint);
+        model.finalizeConnections();
+
+        auto state = model.initSystem();
+        for (int i = 0; i < 5; ++i) {
+            SimTK::Vector q_rand =
+                    SimTK::Test::randVector(model.getNumStateVariables());
+            model.setStateVariableValues(state, q_rand);
+            model.assemble(state);
+            const auto& q = state.getQ();
+            const auto error =
+                    q[1] - scaleFactor * f.calcValue(SimTK::Vector(1, q[0]));
+            ASSERT_EQUAL(0.0, error, 1e-10, __FILE__, __LINE__,
+                    "CoordinateCouplerConstraint failed to constrain the "
+                    "dependent coordinate based on a " + name + ".");
+        }
+    };
+
+    const int n = 9;
+    double x[n], y[n];
+    for (int i = 0; i < n; ++i) {
+        x[i] = -2.0 + 0.5 * i;
+        y[i] = std::sin(x[i]);
+    }
+    checkCoupler(SimmSpline(n, x, y), "SimmSpline");
+    checkCoupler(LinearFunction(-0.5, 0.1), "LinearFunction");
+}
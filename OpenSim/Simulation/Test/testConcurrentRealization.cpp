@@ -0,0 +1,171 @@
+/* -------------------------------------------------------------------------- *
+ *                  OpenSim:  testConcurrentRealization.cpp                   *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Tests of the thread safety of realizing distinct States of one Model from
+multiple threads at the same time (see the documentation of Model). The
+results must be identical to those of realizing the States one after another.
+Data races that do not change the results are only found when this test is
+built with ThreadSanitizer (-fsanitize=thread). */
+
+#include <OpenSim/Actuators/DeGrooteFregly2016Muscle.h>
+#include <OpenSim/Actuators/ModelFactory.h>
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/GCVSpline.h>
+#include <OpenSim/Common/PiecewiseLinearFunction.h>
+#include <OpenSim/Simulation/Model/ExpressionBasedCoordinateForce.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Wrap/WrapCylinder.h>
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch/catch.hpp>
+
+#include <memory>
+
+using namespace OpenSim;
+
+namespace {
+    /// A double pendulum with a muscle that wraps over a cylinder and an
+    /// expression-based force.
+    Model createModel() {
+        Model model = ModelFactory::createDoublePendulum();
+
+        auto* cylinder = new WrapCylinder();
+        cylinder->setName("cylinder");
+        cylinder->set_radius(0.1);
+        cylinder->set_length(1.0);
+        cylinder->set_translation(SimTK::Vec3(0.5, 0.5, 0));
+        model.updGround().addWrapObject(cylinder);
+
+        auto* muscle = new DeGrooteFregly2016Muscle();
+        muscle->setName("muscle");
+        muscle->set_max_isometric_force(100);
+        muscle->set_optimal_fiber_length(0.8);
+        muscle->set_tendon_slack_length(0.4);
+        muscle->addNewPathPoint("origin", model.updGround(),
+                SimTK::Vec3(0, 1, 0));
+        muscle->addNewPathPoint("insertion",
+                model.updComponent<Body>("bodyset/b1"), SimTK::Vec3(-0.5, 0, 0));
+        muscle->updGeometryPath().addPathWrap(*cylinder);
+        model.addForce(muscle);
+
+        auto* spring = new ExpressionBasedCoordinateForce("q1", "-10*q-qdot");
+        spring->setName("spring");
+        model.addForce(spring);
+
+        model.finalizeConnections();
+        return model;
+    }
+
+    /// The results of realizing a state to Stage::Acceleration.
+    struct Results {
+        SimTK::Vector udot;
+        double length;
+        double lengtheningSpeed;
+        double tendonForce;
+    };
+
+    Results realize(const Model& model, const SimTK::State& state) {
+        model.realizeAcceleration(state);
+        const auto& muscle =
+                model.getComponent<DeGrooteFregly2016Muscle>("forceset/muscle");
+        // The accelerations include the force of the spring.
+        return {state.getUDot(), muscle.getLength(state),
+                muscle.getLengtheningSpeed(state), muscle.getTendonForce(state)};
+    }
+}
+
+TEST_CASE("Distinct States of one Model can be realized concurrently") {
+    Model model = createModel();
+    SimTK::State defaultState = model.initSystem();
+
+    const int numStates = 64;
+    std::vector<SimTK::State> states(numStates, defaultState);
+    for (int i = 0; i < numStates; ++i) {
+        const double t = (double)i / numStates;
+        model.setStateVariableValue(states[i], "jointset/j0/q0/value",
+                -1.5 + 3 * t);
+        model.setStateVariableValue(states[i], "jointset/j1/q1/value",
+                std::sin(10 * t));
+        model.setStateVariableValue(states[i], "jointset/j0/q0/speed",
+                std::cos(7 * t));
+        model.setStateVariableValue(states[i], "forceset/muscle/activation",
+                0.01 + 0.9 * t);
+    }
+
+    std::vector<Results> expected;
+    for (const auto& state : states) {
+        SimTK::State copy = state;
+        expected.push_back(realize(model, copy));
+    }
+
+    // Each state is copied once per thread, so that the threads realize
+    // copies of the same state (and compute the same cache entries) at once.
+    const int numThreads = std::max(getNumThreadsOrDefault(), 4);
+    std::vector<SimTK::State> copies;
+    for (int i = 0; i < numThreads * numStates; ++i) {
+        copies.push_back(states[i % numStates]);
+    }
+    std::vector<Results> actual(copies.size());
+    parallelForEach((int)copies.size(), numThreads, [&](int, int i) {
+        actual[i] = realize(model, copies[i]);
+    });
+
+    for (int i = 0; i < (int)copies.size(); ++i) {
+        const Results& e = expected[i % numStates];
+        const Results& a = actual[i];
+        INFO("state " << i % numStates);
+        CHECK((a.udot - e.udot).normInf() == 0);
+        CHECK(a.length == e.length);
+        CHECK(a.lengtheningSpeed == e.lengtheningSpeed);
+        CHECK(a.tendonForce == e.tendonForce);
+    }
+}
+
+TEST_CASE("A Function can be evaluated concurrently for the first time") {
+    const int size = 21;
+    double x[size], y[size];
+    for (int i = 0; i < size; ++i) {
+        x[i] = 0.05 * i;
+        y[i] = std::sin(2 * SimTK::Pi * x[i]);
+    }
+    const GCVSpline spline(5, size, x, y);
+    const PiecewiseLinearFunction linear(size, x, y);
+
+    const int numEvaluations = 1000;
+    const auto evaluate = [&](const Function& function) {
+        std::unique_ptr<Function> copy(function.clone());
+        std::vector<double> values(numEvaluations);
+        parallelForEach(numEvaluations, std::max(getNumThreadsOrDefault(), 4),
+                [&](int, int i) {
+                    values[i] = copy->calcValue(
+                            SimTK::Vector(1, 0.001 * i));
+                });
+        return values;
+    };
+    for (const Function* function :
+            std::vector<const Function*>{&spline, &linear}) {
+        const std::vector<double> values = evaluate(*function);
+        for (int i = 0; i < numEvaluations; ++i) {
+            CHECK(values[i] == function->calcValue(SimTK::Vector(1, 0.001 * i)));
+        }
+    }
+}
@@ -77,6 +77,7 @@ int testBallToBallContact(bool useElasticFoundation, bool useMesh1, bool useMesh
 void compareHertzAndMeshContactResults();
 template <typename ContactType> // e.g., HuntCrossley.
 void testIntermediateFrames();
+void testContactMeshReuse();
 
 int main()
 {
@@ -97,6 +98,7 @@ int main()
 
         testIntermediateFrames<OpenSim::HuntCrossleyForce>();
         testIntermediateFrames<OpenSim::ElasticFoundationForce>();
+        testContactMeshReuse();
     }
     catch (const OpenSim::Exception& e) {
         e.print(cerr);
@@ -595,20 +597,32 @@ void testIntermediateFrames() {
     SimTK_TEST_EQ_TOL(stateWeld.getY(), stateIntermedFrameXY.getY(), 1e-10);
 }
 
+void testContactMeshReuse() {
+    // The loaded mesh is kept when the system is re-created and is shared by
+    // copies of the model, but is loaded again when the filename changes.
+    Model model = createBaseModel();
+    addContactComponents<OpenSim::ElasticFoundationForce>(model,
+            model.updBodySet().get("point"), Vec3(0, -0.05, 0),
+            model.updGround(), Vec3(0, 0, -0.5 * SimTK::Pi));
+    const auto getForces = [](Model& m) {
+        SimTK::State& state = m.initSystem();
+        m.realizeDynamics(state);
+        const auto& force = m.getForceSet().get(0);
+        return force.getRecordValues(state);
+    };
+    const auto forces = getForces(model);
+    const auto forcesReinitialized = getForces(model);
+    Model copy(model);
+    const auto forcesCopy = getForces(copy);
+    ASSERT(forces.getSize() == forcesCopy.getSize());
+    for (int i = 0; i < forces.getSize(); ++i) {
+        ASSERT_EQUAL(forces[i], forcesReinitialized[i], 1e-12);
+        ASSERT_EQUAL(forces[i], forcesCopy[i], 1e-12);
+    }
 
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
+    copy.updComponent<ContactMesh>("contactgeometryset/ball")
+            .set_filename("nonexistent_mesh.obj");
+    ASSERT_THROW(OpenSim::Exception, copy.initSystem());
+    // The original model still has its mesh.
+    getForces(model);
+}
@@ -0,0 +1,310 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  testControllers.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Tests that the controls that PrescribedController and ControlSetController
+evaluate on a shared grid of times (PiecewiseLinearControls) match those of
+evaluating each control function or ControlLinear separately, and that the
+controls published to an ExternalController from another thread are used
+whole. */
+
+#include <OpenSim/Actuators/ModelFactory.h>
+#include <OpenSim/Common/PiecewiseLinearFunction.h>
+#include <OpenSim/Simulation/Control/ControlLinear.h>
+#include <OpenSim/Simulation/Control/ControlSet.h>
+#include <OpenSim/Simulation/Control/ControlSetController.h>
+#include <OpenSim/Simulation/Control/ExternalController.h>
+#include <OpenSim/Simulation/Control/PiecewiseLinearControls.h>
+#include <OpenSim/Simulation/Control/PrescribedController.h>
+#include <OpenSim/Simulation/Control/TaskSpaceController.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/SimbodyEngine/BallJoint.h>
+#include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch/catch.hpp>
+
+#include <cmath>
+#include <memory>
+#include <thread>
+
+using namespace OpenSim;
+
+namespace {
+    const int numLinks = 5;
+    const int numTimes = 11;
+
+    double time(int k) { return 0.1 * k + 0.01 * k * k; }
+    double value(int i, int k) { return std::sin(3.0 * time(k) + i); }
+
+    /// The actuators tau0, tau1, ... of the pendulum (which are not in the
+    /// model's ForceSet) in order.
+    void addActuators(const Model& model, Controller& controller) {
+        for (int i = 0; i < numLinks; ++i) {
+            controller.addActuator(
+                    model.getComponent<Actuator>("/tau" + std::to_string(i)));
+        }
+    }
+
+    /// Times before, on, between, and after the nodes.
+    std::vector<double> createEvaluationTimes() {
+        std::vector<double> times;
+        for (int i = -10; i <= 250; ++i) times.push_back(0.01 * i);
+        for (int k = 0; k < numTimes; ++k) times.push_back(time(k));
+        return times;
+    }
+}
+
+TEST_CASE("PiecewiseLinearControls") {
+    CHECK_THROWS(PiecewiseLinearControls({0.0}, 1));
+    CHECK_THROWS(PiecewiseLinearControls({0.0, 1.0, 1.0}, 1));
+
+    for (bool extrapolate : {true, false}) {
+        PiecewiseLinearControls controls({0.0, 1.0, 3.0}, 2, extrapolate);
+        controls.set(0, 0, 1.0, 2.0);
+        controls.set(1, 0, 3.0, -1.0);
+        controls.set(2, 0, 1.0, -1.0);
+        controls.set(0, 1, -1.0, 0.0);
+        controls.set(1, 1, -1.0, 0.5);
+        controls.set(2, 1, 0.0, 0.5);
+        double values[2];
+        int hint = 0;
+        controls.calcValues(0.5, hint, values);
+        CHECK(values[0] == 2.0);
+        CHECK(values[1] == -1.0);
+        controls.calcValues(2.0, hint, values);
+        CHECK(hint == 1);
+        CHECK(values[0] == 2.0);
+        CHECK(values[1] == -0.5);
+        controls.calcValues(4.0, hint, values);
+        CHECK(values[0] == (extrapolate ? 0.0 : 1.0));
+        CHECK(values[1] == (extrapolate ? 0.5 : 0.0));
+        controls.calcValues(-1.0, hint, values);
+        CHECK(values[0] == (extrapolate ? -1.0 : 1.0));
+        CHECK(values[1] == -1.0);
+    }
+}
+
+TEST_CASE("PrescribedController with PiecewiseLinearFunctions") {
+    Model model = ModelFactory::createNLinkPendulum(numLinks);
+    std::vector<PiecewiseLinearFunction> functions;
+    auto* controller = new PrescribedController();
+    controller->setName("controller");
+    addActuators(model, *controller);
+    double x[numTimes], y[numTimes];
+    for (int i = 0; i < numLinks; ++i) {
+        for (int k = 0; k < numTimes; ++k) {
+            x[k] = time(k);
+            y[k] = value(i, k);
+        }
+        functions.emplace_back(numTimes, x, y);
+        controller->prescribeControlForActuator(
+                "tau" + std::to_string(i), functions.back().clone());
+    }
+    model.addController(controller);
+    SimTK::State state = model.initSystem();
+
+    for (double t : createEvaluationTimes()) {
+        state.setTime(t);
+        const SimTK::Vector& controls = model.getControls(state);
+        for (int i = 0; i < numLinks; ++i) {
+            INFO("time " << t << ", actuator " << i);
+            CHECK(controls[i] == Approx(functions[i].calcValue(
+                    SimTK::Vector(1, t))).margin(1e-12));
+        }
+    }
+}
+
+TEST_CASE("ControlSetController with ControlLinear controls") {
+    for (bool extrapolate : {true, false}) {
+        Model model = ModelFactory::createNLinkPendulum(numLinks);
+        auto* controlSet = new ControlSet();
+        for (int i = 0; i < numLinks; ++i) {
+            auto* control = new ControlLinear();
+            control->setName("tau" + std::to_string(i) + ".excitation");
+            control->setExtrapolate(extrapolate);
+            for (int k = 0; k < numTimes; ++k) {
+                control->setControlValue(time(k), value(i, k));
+            }
+            controlSet->adoptAndAppend(control);
+        }
+        std::unique_ptr<ControlSet> expected(controlSet->clone());
+        auto* controller = new ControlSetController();
+        controller->setName("controller");
+        controller->setControlSet(controlSet);
+        addActuators(model, *controller);
+        model.addController(controller);
+        SimTK::State state = model.initSystem();
+
+        for (double t : createEvaluationTimes()) {
+            state.setTime(t);
+            const SimTK::Vector& controls = model.getControls(state);
+            for (int i = 0; i < numLinks; ++i) {
+                INFO("extrapolate " << extrapolate << ", time " << t
+                                    << ", actuator " << i);
+                CHECK(controls[i] == Approx(expected->get(i).getControlValue(
+                        t)).margin(1e-12));
+            }
+        }
+
+        // Changing the controls through updControlSet() takes effect.
+        auto& control0 =
+                dynamic_cast<ControlLinear&>(controller->updControlSet()->get(0));
+        control0.setControlValue(time(3), 10.0);
+        state.setTime(time(3));
+        CHECK(model.getControls(state)[0] == 10.0);
+    }
+}
+
+namespace {
+    /// Adds the index of each actuator in the controller plus 1 to its
+    /// control.
+    class IndexController : public Controller {
+        OpenSim_DECLARE_CONCRETE_OBJECT(IndexController, Controller);
+    public:
+        void computeControls(const SimTK::State&,
+                SimTK::Vector& controls) const override {
+            for (int i = 0; i < getActuatorSet().getSize(); ++i) {
+                addInControl(i, i + 1, controls);
+            }
+        }
+    };
+}
+
+TEST_CASE("Controller::addInControl() writes to the actuators' controls") {
+    Model model = ModelFactory::createNLinkPendulum(numLinks);
+    auto* controller = new IndexController();
+    controller->setName("controller");
+    // Control the actuators in the reverse order of the model.
+    for (int i = numLinks - 1; i >= 0; --i) {
+        controller->addActuator(
+                model.getComponent<Actuator>("/tau" + std::to_string(i)));
+    }
+    model.addController(controller);
+    SimTK::State state = model.initSystem();
+
+    const std::vector<int>& indices = controller->getActuatorControlIndices();
+    REQUIRE((int)indices.size() == numLinks);
+    const SimTK::Vector& controls = model.getControls(state);
+    for (int i = 0; i < numLinks; ++i) {
+        const Actuator& actuator = controller->getActuatorSet()[i];
+        CHECK(indices[i] == actuator.getControlIndex());
+        CHECK(actuator.getControls(state)[0] == i + 1);
+        CHECK(controls[indices[i]] == i + 1);
+    }
+}
+
+TEST_CASE("ExternalController uses the most recently published controls") {
+    Model model = ModelFactory::createNLinkPendulum(numLinks);
+    auto* controller = new ExternalController();
+    controller->setName("controller");
+    addActuators(model, *controller);
+    model.addController(controller);
+    SimTK::State state = model.initSystem();
+
+    // Nothing is added to the controls before the first controls are
+    // published.
+    CHECK(model.getControls(state).normInf() == 0);
+    CHECK(SimTK::isNaN(controller->getControlsTime()));
+    CHECK_THROWS(controller->setControls(0, SimTK::Vector(numLinks + 1, 0.0)));
+
+    SimTK::Vector published(numLinks);
+    for (int i = 0; i < numLinks; ++i) published[i] = i + 1;
+    controller->setControls(0.5, published);
+    state.setTime(0.1);
+    const SimTK::Vector& controls = model.getControls(state);
+    for (int i = 0; i < numLinks; ++i) CHECK(controls[i] == i + 1);
+    CHECK(controller->getControlsTime() == 0.5);
+
+    SECTION("Controls published from another thread are never torn") {
+        // The producer publishes sets whose controls all equal the index of
+        // the set, while the controls are evaluated on this thread.
+        const int numSets = 20000;
+        std::thread producer([&]() {
+            for (int k = 1; k <= numSets; ++k) {
+                controller->setControls(k, SimTK::Vector(numLinks, (double)k));
+            }
+        });
+        double previous = 0;
+        for (int j = 1; previous < numSets; ++j) {
+            state.setTime(j);
+            const SimTK::Vector& current = model.getControls(state);
+            const double time = controller->getControlsTime();
+            if (time == 0.5) continue;
+            REQUIRE(time >= previous);
+            for (int i = 0; i < numLinks; ++i) REQUIRE(current[i] == time);
+            previous = time;
+        }
+        producer.join();
+    }
+}
+
+TEST_CASE("TaskSpaceController achieves the desired task accelerations") {
+    // A spatial two-link arm (4 degrees of freedom) whose hand is a task.
+    Model model;
+    auto* upper = new Body("upper", 2, SimTK::Vec3(0, -0.15, 0),
+            2 * SimTK::Inertia::cylinderAlongY(0.03, 0.15));
+    auto* lower = new Body("lower", 1, SimTK::Vec3(0, -0.15, 0),
+            SimTK::Inertia::cylinderAlongY(0.02, 0.15));
+    model.addBody(upper);
+    model.addBody(lower);
+    model.addJoint(new BallJoint("shoulder", model.getGround(),
+            SimTK::Vec3(0), SimTK::Vec3(0), *upper, SimTK::Vec3(0),
+            SimTK::Vec3(0)));
+    model.addJoint(new PinJoint("elbow", *upper, SimTK::Vec3(0, -0.3, 0),
+            SimTK::Vec3(0), *lower, SimTK::Vec3(0), SimTK::Vec3(0)));
+    auto* controller = new TaskSpaceController();
+    const SimTK::Vec3 hand(0, -0.3, 0);
+    controller->addTask(new StationTask("hand", *lower, hand,
+            SimTK::Vec3(0.2, -0.3, 0.1)));
+    model.addForce(controller);
+
+    const bool compensateGravity = GENERATE(true, false);
+    controller->set_compensate_gravity(compensateGravity);
+    SimTK::State state = model.initSystem();
+    // The ball joint uses Euler angles, so there are as many q's as u's.
+    for (int i = 0; i < state.getNU(); ++i) {
+        state.updQ()[i] = 0.3 + 0.1 * i;
+        state.updU()[i] = 0.5 - 0.4 * i;
+    }
+    model.realizeAcceleration(state);
+
+    const auto& task = controller->get_tasks(0);
+    const SimTK::Vec3 expected = task.calcDesiredAcceleration(state);
+    const SimTK::Vec3 actual =
+            lower->findStationAccelerationInGround(state, hand);
+    CHECK((actual - expected).norm() < 1e-8 * expected.norm());
+
+    // The task-space inertia is (J M^-1 J^T)^-1.
+    const auto& matter = model.getMatterSubsystem();
+    SimTK::Matrix J;
+    matter.calcStationJacobian(state, lower->getMobilizedBodyIndex(),
+            lower->findTransformInBaseFrame() * hand, J);
+    SimTK::Matrix M;
+    matter.calcM(state, M);
+    SimTK::Matrix MInvJT;
+    SimTK::FactorLU(M).solve(J.transpose(), MInvJT);
+    SimTK::Matrix inertia;
+    SimTK::FactorLU(J * MInvJT).inverse(inertia);
+    const SimTK::Matrix difference =
+            controller->getTaskSpaceInertia(state) - inertia;
+    CHECK(difference.norm() < 1e-10 * inertia.norm());
+}
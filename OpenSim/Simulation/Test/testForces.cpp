@@ -28,7 +28,7 @@
 //      2. BushingForce
 //      3. ElasticFoundationForce
 //      4. HuntCrossleyForce
-//      5. SmoothSphereHalfSpaceForce
+//      5. SmoothSphereHalfSpaceForce (and SmoothSphereHalfSpaceForceGroup)
 //      6. CoordinateLimitForce
 //      7. RotationalCoordinateLimitForce
 //      8. ExternalForce
@@ -66,11 +66,13 @@ void testExpressionBasedBushingForceRotational();
 void testElasticFoundation();
 void testHuntCrossleyForce();
 void testSmoothSphereHalfSpaceForce();
+void testSmoothSphereHalfSpaceForceGroup();
 void testCoordinateLimitForce();
 void testCoordinateLimitForceRotational();
 void testExpressionBasedPointToPointForce();
 void testExpressionBasedCoordinateForce();
 void testSerializeDeserialize();
+void testForcesComputedInParallel();
 void testTranslationalDampingEffect(Model& osimModel, Coordinate& sliderCoord,
         double start_h, Component& componentWithDamping);
 void testBlankevoort1991Ligament();
@@ -138,6 +140,12 @@ int main() {
         failures.push_back("testSmoothSphereHalfSpaceForce");
     }
 
+    try { testSmoothSphereHalfSpaceForceGroup(); }
+    catch (const std::exception& e){
+        cout << e.what() <<endl;
+        failures.push_back("testSmoothSphereHalfSpaceForceGroup");
+    }
+
     try { testCoordinateLimitForce(); }
     catch (const std::exception& e){
         cout << e.what() <<endl; failures.push_back("testCoordinateLimitForce");
@@ -174,6 +182,12 @@ int main() {
         failures.push_back("testBlankevoort1991Ligament");
     }
 
+    try { testForcesComputedInParallel(); }
+    catch (const std::exception& e){
+        cout << e.what() <<endl;
+        failures.push_back("testForcesComputedInParallel");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -1420,6 +1434,68 @@ void testSmoothSphereHalfSpaceForce()
     ASSERT(isEqual);
 }
 
+// The group should produce the same contact forces as the
+// SmoothSphereHalfSpaceForce it replaces, and the bouncing ball should settle
+// to rest on the ground just as it does with the individual force.
+void testSmoothSphereHalfSpaceForceGroup()
+{
+    using namespace SimTK;
+
+    double start_h = 0.5;
+
+    Model osimModel{"BouncingBall_SmoothSphereHalfSpace.osim"};
+    osimModel.finalizeConnections();
+    const auto& contact =
+            osimModel.getComponent<OpenSim::SmoothSphereHalfSpaceForce>(
+                    "forceset/contact");
+
+    // Compare the forces while the ball is pressed into the ground.
+    Model groupModel(osimModel);
+    auto* group = new SmoothSphereHalfSpaceForceGroup();
+    group->setName("contact_group");
+    groupModel.addForce(group);
+    groupModel.finalizeConnections();
+    group->addContact(groupModel.getComponent<
+            OpenSim::SmoothSphereHalfSpaceForce>("forceset/contact"));
+    groupModel.updComponent<OpenSim::SmoothSphereHalfSpaceForce>(
+            "forceset/contact").set_appliesForce(false);
+
+    SimTK::State& state = osimModel.initSystem();
+    SimTK::State& groupState = groupModel.initSystem();
+    for (double height : {0.1, 0.0, -0.005, -0.01}) {
+        osimModel.getCoordinateSet()[4].setValue(state, height);
+        groupModel.getCoordinateSet()[4].setValue(groupState, height);
+        osimModel.realizeDynamics(state);
+        groupModel.realizeDynamics(groupState);
+        const SpatialVec expected = contact.getSphereForce(state);
+        const SpatialVec actual =
+                group->getSphereForce(groupState, "contact");
+        ASSERT_EQUAL(actual[1], expected[1], 1e-10 * (1 + expected[1].norm()));
+    }
+    ASSERT(group->getRecordLabels().size() == 12);
+    ASSERT(group->getRecordLabels()[1] == "contact.Sphere.force.Y");
+
+    // Simulate with the group instead of the individual force.
+    groupModel.getCoordinateSet()[4].setValue(groupState, start_h);
+    Manager manager(groupModel);
+    manager.setIntegratorAccuracy(1e-6);
+    groupState.setTime(0.0);
+    manager.initialize(groupState);
+    groupState = manager.integrate(2.0);
+    groupModel.realizeAcceleration(groupState);
+
+    const OpenSim::Body& ball = groupModel.getBodySet().get("ball");
+    Array<double> contact_force = group->getRecordValues(groupState);
+    ASSERT_EQUAL(contact_force[0], 0.0, 1e-4); // no horizontal force on the ball
+    ASSERT_EQUAL(contact_force[1], -ball.getMass()*gravity_vec[1], 1e-3); // vertical is weight
+    ASSERT_EQUAL(contact_force[2], 0.0, 1e-4); // no horizontal force on the ball
+
+    // Copying the group should preserve its contacts.
+    std::unique_ptr<SmoothSphereHalfSpaceForceGroup> copyOfGroup(
+            group->clone());
+    ASSERT(*copyOfGroup == *group);
+}
+
 void testCoordinateLimitForce() {
     using namespace SimTK;
 
@@ -1562,6 +1638,27 @@ void testCoordinateLimitForce() {
         }
     }
 
+    // The stiffness and damping are the partial derivatives of the force,
+    // also in the transition regions.
+    auto calcForce = [&](double h, double v) {
+        q_h.setValue(osim_state, h, false);
+        q_h.setSpeedValue(osim_state, v);
+        osimModel->realizeDynamics(osim_state);
+        return clf->calcLimitForce(osim_state);
+    };
+    for (double h : {0.02, 0.07, 1.0, 2.02, 2.2}) {
+        const double v = 1.5;
+        const double eps = 1e-6;
+        const double stiffness =
+                -(calcForce(h + eps, v) - calcForce(h - eps, v)) / (2 * eps);
+        const double dampingFD =
+                -(calcForce(h, v + eps) - calcForce(h, v - eps)) / (2 * eps);
+        calcForce(h, v);
+        ASSERT_EQUAL(stiffness, clf->calcLimitStiffness(osim_state),
+                1e-4 * std::max(1.0, std::abs(stiffness)));
+        ASSERT_EQUAL(dampingFD, clf->calcLimitDamping(osim_state), 1e-6);
+    }
+
     manager.getStateStorage().print("coordinte_limit_force_model_states.sto");
 
     // Save the forces
@@ -1962,6 +2059,36 @@ void testSerializeDeserialize() {
     std::remove(newModelFile.c_str());
 }
 
+void testForcesComputedInParallel() {
+    std::cout << "Test forces computed in parallel." << std::endl;
+
+    // The accelerations must not depend on whether the muscles and contact
+    // forces are computed in parallel.
+    Model serialModel("PushUpToesOnGroundWithMuscles.osim");
+    Model parallelModel("PushUpToesOnGroundWithMuscles.osim");
+    for (auto& force : parallelModel.updComponentList<Force>()) {
+        force.set_compute_in_parallel(true);
+        ASSERT(force.shouldBeParallelized());
+    }
+    SimTK::State& serialState = serialModel.initSystem();
+    SimTK::State& parallelState = parallelModel.initSystem();
+
+    for (int i = 0; i < serialState.getNU(); ++i) {
+        serialState.updU()[i] = 0.1 * i;
+    }
+    for (const auto& muscle : serialModel.getComponentList<Muscle>()) {
+        muscle.setActivation(serialState, 0.5);
+    }
+    parallelState.updY() = serialState.getY();
+    serialModel.realizeAcceleration(serialState);
+    parallelModel.realizeAcceleration(parallelState);
+
+    ASSERT_EQUAL<double>((serialState.getUDot() -
+                                 parallelState.getUDot()).normInf(),
+            0.0, 1e-10, __FILE__, __LINE__,
+            "Accelerations differ when the forces are computed in parallel.");
+}
+
 void testTranslationalDampingEffect(Model& osimModel, Coordinate& sliderCoord,
         double start_h, Component& componentWithDamping) {
     using namespace SimTK;
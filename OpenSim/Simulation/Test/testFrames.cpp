@@ -50,6 +50,7 @@ void testPhysicalOffsetFrameOnPhysicalOffsetFrame();
 void testPhysicalOffsetFrameOnPhysicalOffsetFrameOrder();
 void testFilterByFrameType();
 void testVelocityAndAccelerationMethods();
+void testPhysicalOffsetFrameChainKinematics();
 
 class OrdinaryOffsetFrame : public OffsetFrame < Frame > {
     OpenSim_DECLARE_CONCRETE_OBJECT(OrdinaryOffsetFrame, OffsetFrame<Frame>);
@@ -107,6 +108,12 @@ int main()
         failures.push_back("testVelocityAndAccelerationMethods");
     }
 
+    try { testPhysicalOffsetFrameChainKinematics(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testPhysicalOffsetFrameChainKinematics");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -538,3 +545,59 @@ void testVelocityAndAccelerationMethods()
     SimTK_TEST_EQ(rod2.getAccelerationInGround(s)[1],
                   rod2.getLinearAccelerationInGround(s));
 }
+
+void testPhysicalOffsetFrameChainKinematics()
+{
+    cout << "\nRunning testPhysicalOffsetFrameChainKinematics" << endl;
+
+    // The kinematics of the last frame of a chain of PhysicalOffsetFrames,
+    // which are computed from the base frame of the chain, must match those
+    // of a station on the base frame.
+    Model* pendulum = new Model("double_pendulum.osim");
+    const OpenSim::Body& rod2 = pendulum->getBodySet().get("rod2");
+    const PhysicalFrame* parent = &rod2;
+    PhysicalOffsetFrame* last = nullptr;
+    for (int i = 0; i < 3; ++i) {
+        SimTK::Transform X_PF;
+        X_PF.setP(SimTK::Vec3(0.1 * i, -0.2, 0.3));
+        X_PF.updR().setRotationToBodyFixedXYZ(SimTK::Vec3(0.3, -0.2 * i, 0.1));
+        last = new PhysicalOffsetFrame("chain" + std::to_string(i), *parent,
+                X_PF);
+        pendulum->addComponent(last);
+        parent = last;
+    }
+
+    SimTK::State& s = pendulum->initSystem();
+    pendulum->getCoordinateSet().get("q1").setValue(s, 0.7);
+    pendulum->getCoordinateSet().get("q2").setValue(s, -1.2);
+    pendulum->getCoordinateSet().get("q1").setSpeedValue(s, 1.5);
+    pendulum->getCoordinateSet().get("q2").setSpeedValue(s, -0.4);
+    pendulum->realizeAcceleration(s);
+
+    ASSERT(&last->findBaseFrame() == &rod2, __FILE__, __LINE__,
+        "testPhysicalOffsetFrameChainKinematics(): incorrect base frame");
+    const SimTK::Transform X_BF = last->findTransformInBaseFrame();
+    const SimTK::Transform X_GF = rod2.getTransformInGround(s) * X_BF;
+    SimTK_TEST_EQ(last->getTransformInGround(s).p(), X_GF.p());
+    SimTK_TEST_EQ(last->getTransformInGround(s).R(), X_GF.R());
+    SimTK_TEST_EQ(last->getAngularVelocityInGround(s),
+                  rod2.getAngularVelocityInGround(s));
+    SimTK_TEST_EQ(last->getLinearVelocityInGround(s),
+                  rod2.findStationVelocityInGround(s, X_BF.p()));
+    SimTK_TEST_EQ(last->getAngularAccelerationInGround(s),
+                  rod2.getAngularAccelerationInGround(s));
+    SimTK_TEST_EQ(last->getLinearAccelerationInGround(s),
+                  rod2.findStationAccelerationInGround(s, X_BF.p()));
+
+    // Changing the offset of the last frame takes effect without calling
+    // initSystem() again.
+    SimTK::Transform X_PF = last->getOffsetTransform();
+    X_PF.updP() += SimTK::Vec3(0.5, 0, 0);
+    last->setOffsetTransform(X_PF);
+    SimTK::State s2 = s;
+    s2.invalidateAllCacheAtOrAbove(SimTK::Stage::Position);
+    pendulum->realizePosition(s2);
+    SimTK_TEST_EQ(last->getTransformInGround(s2).p(),
+                  rod2.getTransformInGround(s2) *
+                          last->findTransformInBaseFrame().p());
+}
@@ -32,7 +32,10 @@
 #include <OpenSim/Common/MarkerData.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/STOFileAdapter.h>
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <algorithm>
 #include <random>
+#include <thread>
 
 using namespace OpenSim;
 using namespace std;
@@ -41,6 +44,9 @@ using namespace std;
 // Verify that the marker weight are consistent with the initial Set
 // of MarkerWeights used to construct the MarkersReference
 void testMarkersReference();
+// Verify that the values of a MarkersReference are those of the nearest row of
+// its table, for uniformly and non-uniformly sampled frames
+void testMarkersReferenceValuesAtTime();
 // Verify that the orientations sensor weights are consistent with the initial
 // Set of OrientationWeights used to construct the OrientationsReference
 void testOrientationsReference();
@@ -82,12 +88,18 @@ void testUpdateMarkerWeights();
 // Verify that the track() solution is also effected by updating marker
 // weights and marker error is being reduced as its weighting increases.
 void testTrackWithUpdateMarkerWeights();
+// Verify that track() with the least-squares method finds the same solution
+// as the Assembler.
+void testLeastSquaresTracking();
 
 // Verify that solver does not confuse/mismanage markers when reference
 // has more markers than the model, order is changed or marker reference
 // includes intervals with NaNs (no observation)
 void testNumberOfMarkersMismatch();
 void testNumberOfOrientationsMismatch();
+// Verify that streamed orientations are solved in order (or skipped when they
+// miss the deadline) and that the published solutions track the data
+void testStreamingIMUInverseKinematics();
 
 int main()
 {
@@ -98,6 +110,11 @@ int main()
         cout << e.what() << endl;
         failures.push_back("testMarkersReference");
     }
+    try { testMarkersReferenceValuesAtTime(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testMarkersReferenceValuesAtTime");
+    }
     try { testOrientationsReference(); }
     catch (const std::exception& e) {
         cout << e.what() << endl;
@@ -119,6 +136,12 @@ int main()
         failures.push_back("testTrackWithUpdateMarkerWeights");
     }
 
+    try { testLeastSquaresTracking(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testLeastSquaresTracking");
+    }
+
     try { testNumberOfMarkersMismatch(); }
     catch (const std::exception& e) {
         cout << e.what() << endl;
@@ -131,6 +154,12 @@ int main()
         failures.push_back("testNumberOfOrientationsMismatch");
     }
 
+    try { testStreamingIMUInverseKinematics(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testStreamingIMUInverseKinematics");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -212,6 +241,48 @@ void testMarkersReference()
     }
 }
 
+void testMarkersReferenceValuesAtTime()
+{
+    vector<std::string> labels{ "A", "B", "C" };
+    const int nc = int(labels.size());
+    const int nr = 101;
+
+    // Times rounded as in a .trc file (uniform), and irregular times.
+    for (bool uniform : {true, false}) {
+        TimeSeriesTable_<SimTK::Vec3> markerData;
+        markerData.setColumnLabels(labels);
+        double time = 0.5;
+        for (int r = 0; r < nr; ++r) {
+            SimTK::RowVector_<SimTK::Vec3> row(nc);
+            for (int c = 0; c < nc; ++c) row[c] = SimTK::Vec3(r, c, r * c);
+            markerData.appendRow(
+                    uniform ? std::round((0.5 + r / 60.0) * 1e5) / 1e5 : time,
+                    row);
+            time += 0.01 * (1 + r % 3);
+        }
+        MarkersReference markersRef(markerData, Set<MarkerWeight>());
+        const auto& times = markerData.getIndependentColumn();
+
+        SimTK::Array_<SimTK::Vec3> values;
+        const int nt = 1000;
+        for (int i = 0; i <= nt; ++i) {
+            double t = times.front() + (times.back() - times.front()) * i / nt;
+            // Include the times of the frames and the midpoints between them.
+            if (i % 10 == 0) t = times[i / 10];
+            if (i % 10 == 5) t = 0.5 * (times[i / 10] + times[i / 10 + 1]);
+            markersRef.getValuesAtTime(t, values);
+            const auto row = markerData.getNearestRow(t);
+            ASSERT(values.size() == unsigned(nc));
+            for (int c = 0; c < nc; ++c) {
+                ASSERT(values[c] == row[c], __FILE__, __LINE__,
+                        "Marker value does not match the nearest row.");
+            }
+        }
+        ASSERT_THROW(TimeOutOfRange,
+                markersRef.getValuesAtTime(times.back() + 0.1, values));
+    }
+}
+
 void testOrientationsReference() {
     // column labels for orientation sensor data
     vector<std::string> labels{"A", "B", "C", "D", "E", "F"};
@@ -395,6 +466,22 @@ void testAccuracy()
     SimTK_ASSERT_ALWAYS(tightSumSqError <= looseSumSqError,
         "InverseKinematicsSolver failed to maintain or lower marker errors "
         "when accuracy was tightened.");
+
+    // the locations and errors computed together match those computed
+    // separately
+    SimTK::Array_<SimTK::Vec3> locations, jointLocations;
+    SimTK::Array_<double> jointSqMarkerErrors;
+    ikSolver.computeCurrentMarkerLocations(locations);
+    ikSolver.computeCurrentMarkerLocationsAndSquaredErrors(
+            jointLocations, jointSqMarkerErrors);
+    SimTK_ASSERT_ALWAYS(jointLocations.size() == locations.size() &&
+            jointSqMarkerErrors.size() == sqMarkerErrors.size(),
+        "InverseKinematicsSolver computed a different number of marker "
+        "locations or errors together than separately.");
+    for (unsigned i = 0; i < locations.size(); ++i) {
+        ASSERT_EQUAL(0.0, (locations[i] - jointLocations[i]).norm(), 1e-12);
+        ASSERT_EQUAL(sqMarkerErrors[i], jointSqMarkerErrors[i], 1e-12);
+    }
 }
 
 void testUpdateMarkerWeights()
@@ -576,6 +663,67 @@ void testTrackWithUpdateMarkerWeights()
     }
 }
 
+void testLeastSquaresTracking()
+{
+    cout << "\ntestInverseKinematicsSolver::testLeastSquaresTracking()"
+         << endl;
+    std::unique_ptr<Model> pendulum{ constructPendulumWithMarkers() };
+    Coordinate& coord = pendulum->getCoordinateSet()[0];
+
+    SimTK::State state = pendulum->initSystem();
+
+    StatesTrajectory states;
+    double dt = 0.01;
+    for (int i = 0; i < 101; ++i) {
+        state.updTime() = i*dt;
+        coord.setValue(state, SimTK::Pi/3 * std::sin(2*SimTK::Pi*i*dt));
+        states.append(state);
+    }
+
+    SimTK::RowVector_<SimTK::Vec3> biases(3, SimTK::Vec3(0));
+    std::shared_ptr<MarkersReference> markersRef(
+            new MarkersReference(generateMarkerDataFromModelAndStates(
+                    *pendulum, states, biases, 0.01),
+                    Set<MarkerWeight>()));
+    const double weights[] = {1.0, 2.0, 5.0};
+    for (int i = 0; i < (int)markersRef->getNames().size(); ++i) {
+        markersRef->updMarkerWeightSet().adoptAndAppend(
+            new MarkerWeight(markersRef->getNames()[i], weights[i]));
+    }
+
+    SimTK::Array_<CoordinateReference> coordRefs;
+    coord.setValue(state, 0.0);
+    SimTK::State stateLeastSquares = state;
+
+    InverseKinematicsSolver ikSolver(*pendulum, markersRef, coordRefs);
+    ikSolver.setAccuracy(1e-8);
+    ikSolver.assemble(state);
+
+    InverseKinematicsSolver ikSolverLeastSquares(
+            *pendulum, markersRef, coordRefs);
+    ikSolverLeastSquares.setAccuracy(1e-8);
+    ikSolverLeastSquares.setUseLeastSquaresTracking(true);
+    ikSolverLeastSquares.assemble(stateLeastSquares);
+
+    SimTK::Array_<double> errors, errorsLeastSquares;
+    for (unsigned i = 1; i < markersRef->getNumFrames(); ++i) {
+        state.updTime() = i*dt;
+        stateLeastSquares.updTime() = i*dt;
+        ikSolver.track(state);
+        ikSolverLeastSquares.track(stateLeastSquares);
+        ASSERT_EQUAL(state.getQ()[0], stateLeastSquares.getQ()[0], 1e-6,
+                __FILE__, __LINE__,
+                "The least-squares solution differs from the Assembler's.");
+        // The marker errors are those of the least-squares solution.
+        ikSolver.computeCurrentMarkerErrors(errors);
+        ikSolverLeastSquares.computeCurrentMarkerErrors(errorsLeastSquares);
+        for (unsigned j = 0; j < errors.size(); ++j) {
+            ASSERT_EQUAL(errors[j], errorsLeastSquares[j], 1e-6,
+                    __FILE__, __LINE__);
+        }
+    }
+}
+
 void testNumberOfMarkersMismatch()
 {
     cout << 
@@ -789,6 +937,12 @@ void testNumberOfOrientationsMismatch()
 
             cout << " " << orientationName << " error = " << orientationErrors[j];
 
+            // The batched errors must match those of the assembly condition.
+            SimTK_ASSERT_ALWAYS(abs(orientationErrors[j] -
+                    ikSolver.computeCurrentOrientationError(j)) <= 1e-8,
+                "InverseKinematicsSolver batched orientation error differs "
+                "from the error of the assembly condition.");
+
             SimTK_ASSERT_ALWAYS(*namesIter++ != "unused",
                 "InverseKinematicsSolver failed to ignore "
                 "unused orientation reference (observation).");
@@ -806,6 +960,96 @@ void testNumberOfOrientationsMismatch()
     }
 }
 
+void testStreamingIMUInverseKinematics()
+{
+    cout << "\ntestInverseKinematicsSolver::testStreamingIMUInverseKinematics()"
+         << endl;
+
+    std::unique_ptr<Model> leg{ constructLegWithOrientationFrames() };
+    SimTK::State state = leg->initSystem();
+    StatesTrajectory states;
+    const int N = 51;
+    for (int i = 0; i < N; ++i) {
+        state.updTime() = 0.01 * i;
+        for (int j = 0; j < leg->getCoordinateSet().getSize(); ++j) {
+            leg->getCoordinateSet()[j].setValue(
+                    state, 0.5 * std::sin(0.02 * i * (j + 1)));
+        }
+        states.append(state);
+    }
+    const auto orientationsTable = generateOrientationsDataFromModelAndStates(
+            *leg, states, SimTK::RowVector_<SimTK::Rotation>(3,
+                    SimTK::Rotation()), 0.0, true);
+    const auto& times = orientationsTable.getIndependentColumn();
+
+    for (double deadline : {SimTK::Infinity, 0.0}) {
+        StreamingIMUInverseKinematics ik(
+                *leg, orientationsTable.getColumnLabels());
+        ik.setDeadline(deadline);
+        std::vector<double> solvedTimes;
+        std::vector<SimTK::Vector> solutions;
+        ik.setListener([&](double time, const SimTK::Vector& values) {
+            solvedTimes.push_back(time);
+            solutions.push_back(values);
+        });
+        ik.start();
+        std::thread producer([&]() {
+            for (int i = 0; i < N; ++i) {
+                // Retry rejected frames so that all frames are received.
+                while (!ik.pushFrame(times[i],
+                               orientationsTable.getRowAtIndex(i))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        producer.join();
+        ik.stop();
+
+        const auto stats = ik.getStatistics();
+        cout << "deadline: " << deadline
+             << " solved: " << stats.numFramesSolved
+             << " skipped: " << stats.numFramesSkipped
+             << " rejected: " << stats.numFramesRejected
+             << " mean latency: " << stats.meanLatency << endl;
+        SimTK_ASSERT_ALWAYS(stats.numFramesFailed == 0,
+                "Streaming inverse kinematics failed to solve a frame.");
+        SimTK_ASSERT_ALWAYS(stats.numFramesReceived - stats.numFramesRejected
+                        == stats.numFramesSolved + stats.numFramesSkipped,
+                "Streaming inverse kinematics lost frames.");
+        SimTK_ASSERT_ALWAYS(int(solvedTimes.size()) == stats.numFramesSolved,
+                "Listener was not called for every solved frame.");
+        if (deadline == SimTK::Infinity) {
+            SimTK_ASSERT_ALWAYS(stats.numFramesSolved == N,
+                    "Expected all frames to be solved without a deadline.");
+        }
+        // The newest frame is always solved, and frames are solved in order.
+        ASSERT_EQUAL(times.back(), solvedTimes.back(), 0.0);
+        SimTK_ASSERT_ALWAYS(
+                std::is_sorted(solvedTimes.begin(), solvedTimes.end()),
+                "Frames were not solved in order.");
+
+        // Compare the solutions to the coordinates of the data.
+        // The solutions are in the order of the coordinates of the model.
+        const auto& coordSet = leg->getCoordinateSet();
+        SimTK_ASSERT_ALWAYS(
+                int(ik.getCoordinateNames().size()) == coordSet.getSize(),
+                "Expected a value for each coordinate.");
+        for (size_t k = 0; k < solvedTimes.size(); ++k) {
+            const int i = int(std::round(solvedTimes[k] / 0.01));
+            for (int j = 0; j < coordSet.getSize(); ++j) {
+                ASSERT_EQUAL(coordSet[j].getValue(states[i]),
+                        solutions[k][j], 1e-3,
+                        __FILE__, __LINE__,
+                        "Streamed solution does not match the data.");
+            }
+        }
+        double latestTime;
+        SimTK::Vector latest;
+        SimTK_ASSERT_ALWAYS(ik.getLatestSolution(latestTime, latest) &&
+                latestTime == times.back(), "Latest solution is not the last.");
+    }
+}
+
 Model* constructPendulumWithMarkers()
 {
     Model* pendulum = new Model();
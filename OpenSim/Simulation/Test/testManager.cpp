@@ -37,16 +37,31 @@ Manager Tests:
 4. testConstructors: Ensure different constructors work as intended.
 5. testIntegratorInterface: Ensure setting integrator options works as intended.
 6. testExceptions: Test that misuse actually triggers exceptions.
+7. testBatchManager: Simulate a falling ball from several initial states
+   concurrently, with and without a parameterization of the model.
+8. testFixedStepping: Step a falling ball with Manager::step() and check the
+   times, the trajectory, and the latency statistics.
+9. testRecordInterval: Record the states of a falling ball at fixed intervals.
+10. testConcurrentAnalyses: Perform a Kinematics analysis on a separate thread
+   and compare its results to those of performing it during the integration.
+11. testImplicitIntegrator: Simulate a stiff system with the CPodes integrator
+   and check that it takes fewer steps than RungeKuttaMerson.
+12. testPerformanceStats: Check the performance statistics and the performance
+   trace of integrating and stepping a falling ball.
 
 //=============================================================================*/
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
 #include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
+#include <OpenSim/Simulation/SimbodyEngine/SliderJoint.h>
+#include <OpenSim/Simulation/Model/ExpressionBasedCoordinateForce.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Simulation/Manager/BatchManager.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
 #include <OpenSim/Simulation/Control/PrescribedController.h>
 #include <OpenSim/Common/Constant.h>
+#include <OpenSim/Analyses/Kinematics.h>
 
 using namespace OpenSim;
 using namespace std;
@@ -56,6 +71,12 @@ void testExcitationUpdatesWithManager();
 void testConstructors();
 void testIntegratorInterface();
 void testExceptions();
+void testBatchManager();
+void testFixedStepping();
+void testRecordInterval();
+void testConcurrentAnalyses();
+void testImplicitIntegrator();
+void testPerformanceStats();
 
 int main()
 {
@@ -97,6 +118,42 @@ int main()
         failures.push_back("testExceptions");
     }
 
+    try { testBatchManager(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testBatchManager");
+    }
+
+    try { testFixedStepping(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testFixedStepping");
+    }
+
+    try { testRecordInterval(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testRecordInterval");
+    }
+
+    try { testConcurrentAnalyses(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testConcurrentAnalyses");
+    }
+
+    try { testImplicitIntegrator(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testImplicitIntegrator");
+    }
+
+    try { testPerformanceStats(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testPerformanceStats");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -406,9 +463,9 @@ void testIntegratorInterface()
     SimTK_TEST(method == "RungeKuttaMerson");
     
     // Test setIntegratorMethod()
-    //manager.setIntegratorMethod(Manager::IntegratorMethod::CPodes);
-    //method = manager.getIntegrator().getMethodName();
-    //SimTK_TEST(method == "CPodesBDF");
+    manager.setIntegratorMethod(Manager::IntegratorMethod::CPodes);
+    method = manager.getIntegrator().getMethodName();
+    SimTK_TEST(method == "CPodesBDF");
 
     manager.setIntegratorMethod(Manager::IntegratorMethod::ExplicitEuler);
     method = manager.getIntegrator().getMethodName();
@@ -478,3 +535,324 @@ void testExceptions()
     manager.setIntegratorAccuracy(1e-4);
     manager.setIntegratorMinimumStepSize(0.01);
 }
+
+void testBatchManager()
+{
+    cout << "Running testBatchManager" << endl;
+
+    using SimTK::Vec3;
+
+    Model model;
+    model.setName("ball");
+    auto ball = new Body("ball", 0.7, Vec3(0.1), SimTK::Inertia::sphere(0.5));
+    model.addBody(ball);
+    auto freeJoint = new FreeJoint("freeJoint", model.getGround(), Vec3(0),
+        Vec3(0), *ball, Vec3(0), Vec3(0));
+    model.addJoint(freeJoint);
+    const double g = 9.81;
+    model.setGravity(Vec3(0, -g, 0));
+
+    SimTK::State& state = model.initSystem();
+    const Coordinate& sliderCoord =
+        freeJoint->getCoordinate(FreeJoint::Coord::TranslationY);
+
+    std::vector<double> initHeights = {0.0, 13.3, 6.5, -2.0, 1.0};
+    std::vector<double> initSpeeds = {0.0, 0.5, -0.5, 3.0, 1.0};
+    std::vector<SimTK::State> initialStates;
+    for (size_t i = 0; i < initHeights.size(); ++i) {
+        sliderCoord.setValue(state, initHeights[i]);
+        sliderCoord.setSpeedValue(state, initSpeeds[i]);
+        initialStates.push_back(state);
+    }
+
+    const double finalTime = 1.0;
+    BatchManager batch(model);
+    batch.setIntegratorAccuracy(1e-8);
+    batch.setReportTimeInterval(0.1);
+    batch.setNumThreads(2);
+
+    // The ball falls with the gravity of the model, or with the gravity set by
+    // the parameterization.
+    for (double gravity : {g, 2 * g}) {
+        if (gravity != g) {
+            batch.setParameterization([&](int, Model& copy) {
+                copy.setGravity(Vec3(0, -gravity, 0));
+            });
+        }
+        std::vector<StatesTrajectory> trajectories =
+            batch.integrate(initialStates, finalTime);
+        ASSERT(trajectories.size() == initialStates.size());
+        for (size_t i = 0; i < trajectories.size(); ++i) {
+            const StatesTrajectory& traj = trajectories[i];
+            ASSERT(traj.getSize() >= 10);
+            // The trajectory states belong to copies of the model, but the
+            // state variables are at the same indices.
+            const SimTK::State& last = traj.back();
+            const double t = last.getTime();
+            const double height =
+                initHeights[i] + initSpeeds[i] * t - 0.5 * gravity * t * t;
+            SimTK_TEST_EQ_TOL(last.getQ()[sliderCoord.getMobilizerQIndex()],
+                height, 1e-6);
+        }
+    }
+
+    // Mismatched initial states and final times are rejected.
+    ASSERT_THROW(OpenSim::Exception,
+        batch.integrate({initialStates[0]}, initialStates[0].getTime()));
+    Model other;
+    SimTK::State otherState = other.initSystem();
+    otherState.setTime(0);
+    ASSERT_THROW(OpenSim::Exception,
+        batch.integrate({initialStates[0], otherState}, finalTime));
+}
+
+void testFixedStepping()
+{
+    cout << "Running testFixedStepping" << endl;
+
+    using SimTK::Vec3;
+
+    Model model;
+    model.setName("ball");
+    auto ball = new Body("ball", 0.7, Vec3(0.1), SimTK::Inertia::sphere(0.5));
+    model.addBody(ball);
+    auto freeJoint = new FreeJoint("freeJoint", model.getGround(), Vec3(0),
+        Vec3(0), *ball, Vec3(0), Vec3(0));
+    model.addJoint(freeJoint);
+    const double g = 9.81;
+    model.setGravity(Vec3(0, -g, 0));
+
+    SimTK::State& state = model.initSystem();
+    const Coordinate& sliderCoord =
+        freeJoint->getCoordinate(FreeJoint::Coord::TranslationY);
+
+    Manager manager(model);
+    // Stepping requires an initialized Manager.
+    ASSERT_THROW(OpenSim::Exception, manager.step(0.01));
+    manager.initialize(state);
+    ASSERT_THROW(OpenSim::Exception, manager.step(0));
+
+    const double stepSize = 0.01;
+    for (int i = 1; i <= 100; ++i) {
+        const SimTK::State& s = manager.step(stepSize);
+        SimTK_TEST_EQ(s.getTime(), i * stepSize);
+    }
+    // Without error control, RungeKuttaMerson is exact for a falling ball.
+    const SimTK::State& s = manager.getState();
+    SimTK_TEST_EQ(sliderCoord.getValue(s), -0.5 * g);
+    SimTK_TEST_EQ(sliderCoord.getSpeedValue(s), -g);
+    // Nothing is recorded.
+    ASSERT(manager.getStateStorage().getSize() == 0);
+
+    ASSERT(manager.getNumSteps() == 100);
+    ASSERT(manager.getMaxStepLatency() >= manager.getMeanStepLatency());
+    ASSERT(manager.getMeanStepLatency() > 0);
+    manager.resetStepLatencies();
+    ASSERT(manager.getNumSteps() == 0);
+    ASSERT(manager.getMaxStepLatency() == 0);
+
+    // Stepping can be continued with integrate(), and vice versa.
+    manager.integrate(1.5);
+    SimTK_TEST_EQ(manager.step(stepSize).getTime(), 1.5 + stepSize);
+}
+
+void testRecordInterval()
+{
+    cout << "Running testRecordInterval" << endl;
+
+    using SimTK::Vec3;
+
+    Model model;
+    auto ball = new Body("ball", 0.7, Vec3(0.1), SimTK::Inertia::sphere(0.5));
+    model.addBody(ball);
+    auto freeJoint = new FreeJoint("freeJoint", model.getGround(), Vec3(0),
+        Vec3(0), *ball, Vec3(0), Vec3(0));
+    model.addJoint(freeJoint);
+    const double g = 9.81;
+    model.setGravity(Vec3(0, -g, 0));
+    SimTK::State& state = model.initSystem();
+
+    Manager manager(model);
+    ASSERT_THROW(OpenSim::Exception, manager.setRecordInterval(-1));
+    manager.setRecordInterval(0.1);
+    manager.initialize(state);
+    manager.integrate(1.0);
+
+    // The initial state, one state per interval, and the final state.
+    const Storage& states = manager.getStateStorage();
+    ASSERT(states.getSize() == 12);
+    const Coordinate& yCoord =
+        freeJoint->getCoordinate(FreeJoint::Coord::TranslationY);
+    const int iy = model.getStateVariableNames().findIndex(
+        yCoord.getAbsolutePathString() + "/value");
+    for (int i = 0; i <= 10; ++i) {
+        const double time = states.getStateVector(i)->getTime();
+        SimTK_TEST_EQ(time, 0.1 * i);
+        // The interpolated states are as accurate as the integrator.
+        const double y = states.getStateVector(i)->getData()[iy];
+        SimTK_TEST_EQ_TOL(y, -0.5 * g * time * time, 1e-4);
+    }
+}
+
+void testConcurrentAnalyses()
+{
+    cout << "Running testConcurrentAnalyses" << endl;
+
+    using SimTK::Vec3;
+
+    Model model;
+    auto link = new Body("link", 1.0, Vec3(0), SimTK::Inertia(0.1));
+    model.addBody(link);
+    auto pin = new PinJoint("pin", model.getGround(), Vec3(0), Vec3(0),
+        *link, Vec3(0, 0.5, 0), Vec3(0));
+    model.addJoint(pin);
+    auto kinematics = new Kinematics(&model);
+    kinematics->setStepInterval(1);
+    model.addAnalysis(kinematics);
+    SimTK::State& state = model.initSystem();
+    pin->getCoordinate().setValue(state, 0.5);
+
+    const auto simulate = [&](bool concurrently) {
+        kinematics->getPositionStorage()->purge();
+        SimTK::State s(state);
+        Manager manager(model);
+        ASSERT(!manager.getPerformAnalysesConcurrently());
+        manager.setPerformAnalysesConcurrently(concurrently);
+        manager.initialize(s);
+        manager.integrate(1.0);
+        return Storage(*kinematics->getPositionStorage());
+    };
+
+    const Storage serial = simulate(false);
+    const Storage concurrent = simulate(true);
+    ASSERT(serial.getSize() > 10);
+    ASSERT(concurrent.getSize() == serial.getSize());
+    for (int i = 0; i < serial.getSize(); ++i) {
+        const StateVector& expected = *serial.getStateVector(i);
+        const StateVector& actual = *concurrent.getStateVector(i);
+        ASSERT_EQUAL(expected.getTime(), actual.getTime(), 0.0);
+        ASSERT(expected.getSize() == actual.getSize());
+        for (int j = 0; j < expected.getSize(); ++j) {
+            ASSERT_EQUAL(expected.getData()[j], actual.getData()[j], 0.0);
+        }
+    }
+}
+
+void testImplicitIntegrator()
+{
+    cout << "Running testImplicitIntegrator" << endl;
+
+    using SimTK::Vec3;
+
+    // A block on a stiff, heavily damped spring: the time constants of the
+    // system are 1e-4 s and 1e-2 s, so explicit integrators must take many
+    // more steps than the fast time constant requires for accuracy.
+    Model model;
+    auto block = new Body("block", 1., Vec3(0), SimTK::Inertia::sphere(0.1));
+    model.addBody(block);
+    auto slider = new SliderJoint("slider", model.getGround(), *block);
+    slider->updCoordinate().setName("x");
+    model.addJoint(slider);
+    model.addForce(new ExpressionBasedCoordinateForce(
+            "x", "-1e6*q-1.01e4*qdot"));
+    model.setGravity(Vec3(0));
+    SimTK::State& state = model.initSystem();
+    model.getCoordinateSet().get("x").setValue(state, 0.1);
+
+    auto simulate = [&](Manager::IntegratorMethod method, int& numSteps) {
+        Manager manager(model);
+        manager.setIntegratorMethod(method);
+        manager.setIntegratorAccuracy(1e-6);
+        state.setTime(0);
+        manager.initialize(state);
+        const double x = model.getCoordinateSet().get("x").getValue(
+                manager.integrate(0.02));
+        manager.integrate(0.5);
+        numSteps = manager.getIntegrator().getNumStepsTaken();
+        return x;
+    };
+
+    int numStepsExplicit = 0;
+    int numStepsImplicit = 0;
+    const double xExplicit = simulate(
+            Manager::IntegratorMethod::RungeKuttaMerson, numStepsExplicit);
+    const double xImplicit = simulate(
+            Manager::IntegratorMethod::CPodes, numStepsImplicit);
+    // x(t) = 0.1 (100 exp(-100 t) - exp(-1e4 t)) / 99.
+    const double xExpected = 0.1 *
+            (100 * std::exp(-100 * 0.02) - std::exp(-1e4 * 0.02)) / 99;
+    ASSERT_EQUAL(xExpected, xExplicit, 1e-5);
+    ASSERT_EQUAL(xExpected, xImplicit, 1e-5);
+    ASSERT(numStepsImplicit < numStepsExplicit);
+    cout << "Steps taken: RungeKuttaMerson " << numStepsExplicit
+         << ", CPodes " << numStepsImplicit << endl;
+
+    // Replacing and destroying a CPodes integrator is safe.
+    Manager manager(model);
+    manager.setIntegratorMethod(Manager::IntegratorMethod::CPodes);
+    manager.setIntegratorMethod(Manager::IntegratorMethod::CPodes);
+    manager.setIntegratorMethod(Manager::IntegratorMethod::RungeKuttaMerson);
+    manager.setIntegratorMethod(Manager::IntegratorMethod::CPodes);
+}
+
+void testPerformanceStats()
+{
+    cout << "Running testPerformanceStats" << endl;
+
+    using SimTK::Vec3;
+
+    Model model;
+    auto ball = new Body("ball", 0.7, Vec3(0.1), SimTK::Inertia::sphere(0.5));
+    model.addBody(ball);
+    auto freeJoint = new FreeJoint("freeJoint", model.getGround(), Vec3(0),
+        Vec3(0), *ball, Vec3(0), Vec3(0));
+    model.addJoint(freeJoint);
+    SimTK::State& state = model.initSystem();
+
+    Manager manager(model);
+    ASSERT_THROW(OpenSim::Exception, manager.getPerformanceStats());
+    ASSERT(!manager.getRecordPerformanceTrace());
+    manager.setRecordPerformanceTrace(true);
+    manager.initialize(state);
+    Manager::PerformanceStats stats = manager.getPerformanceStats();
+    ASSERT(stats.numStepsTaken == 0);
+    ASSERT(stats.wallClockTime == 0);
+
+    manager.integrate(1.0);
+    stats = manager.getPerformanceStats();
+    const SimTK::Integrator& integ = manager.getIntegrator();
+    ASSERT(stats.numStepsTaken > 0);
+    ASSERT(stats.numStepsTaken == integ.getNumStepsTaken());
+    ASSERT(stats.numStepsAttempted >= stats.numStepsTaken);
+    ASSERT(stats.numRealizations > 0);
+    ASSERT(stats.numRealizations <= integ.getNumRealizations());
+    ASSERT(stats.numRealizationsPerStage.size() == 10);
+    ASSERT(stats.numRealizationsPerStage[SimTK::Stage::Acceleration] > 0);
+    ASSERT(stats.wallClockTime > 0);
+    ASSERT(stats.getWallClockTimePerStep() > 0);
+
+    // A row per step, whose counts add up to the statistics.
+    const TimeSeriesTable& trace = manager.getPerformanceTrace();
+    ASSERT(trace.getNumColumns() == 6);
+    ASSERT(trace.getNumRows() > 0);
+    ASSERT((int)trace.getNumRows() <= stats.numStepsTaken);
+    SimTK_TEST_EQ(trace.getIndependentColumn().back(), 1.0);
+    const auto stepsTaken = trace.getDependentColumn("num_steps_taken");
+    const auto realizations = trace.getDependentColumn("num_realizations");
+    ASSERT(SimTK::sum(stepsTaken) == stats.numStepsTaken);
+    ASSERT(SimTK::sum(realizations) <= stats.numRealizations);
+
+    // The statistics can be reset, and include step().
+    manager.resetPerformanceStats();
+    ASSERT(manager.getPerformanceStats().numStepsTaken == 0);
+    ASSERT(manager.getPerformanceTrace().getNumRows() == 0);
+    for (int i = 0; i < 5; ++i) manager.step(0.01);
+    stats = manager.getPerformanceStats();
+    ASSERT(stats.numStepsTaken >= 5);
+    ASSERT(manager.getPerformanceTrace().getNumRows() == 5);
+    const auto stepSizes =
+            manager.getPerformanceTrace().getDependentColumn("step_size");
+    for (int i = 0; i < stepSizes.size(); ++i) {
+        SimTK_TEST_EQ(stepSizes[i], 0.01);
+    }
+}
@@ -25,7 +25,9 @@
 #include <OpenSim/Simulation/Model/PhysicalOffsetFrame.h>
 #include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
+#include <OpenSim/Common/XMLDocument.h>
 
 #include <memory>
 
@@ -35,6 +37,9 @@ using namespace std;
 void testModelFinalizePropertiesAndConnections();
 void testModelTopologyErrors();
 void testDoesNotSegfaultWithUnusualConnections();
+void testModelFileCache();
+void testInitSystemFrom();
+void testJointReactionsShareMobilizerReactions();
 
 int main() {
     LoadOpenSimLibrary("osimActuators");
@@ -43,6 +48,9 @@ int main() {
         SimTK_SUBTEST(testModelFinalizePropertiesAndConnections);
         SimTK_SUBTEST(testModelTopologyErrors);
         SimTK_SUBTEST(testDoesNotSegfaultWithUnusualConnections);
+        SimTK_SUBTEST(testModelFileCache);
+        SimTK_SUBTEST(testInitSystemFrom);
+        SimTK_SUBTEST(testJointReactionsShareMobilizerReactions);
     SimTK_END_TEST();
 }
 
@@ -262,3 +270,84 @@ void testDoesNotSegfaultWithUnusualConnections()
         // a runtime exception (for now... ;))
     }
 }
+
+void testModelFileCache()
+{
+    // arm26.osim has an old document version, so the first read migrates it.
+    const std::string cacheDir = "testModelInterface_cache";
+    IO::makeDir(cacheDir);
+    XMLDocument::setCacheDirectory(cacheDir);
+
+    Model original("arm26.osim");
+    ASSERT(!original.getDocument()->isReadFromCache());
+    Model cached("arm26.osim");
+    ASSERT(cached.getDocument()->isReadFromCache());
+    ASSERT(cached.getDocumentFileVersion() == XMLDocument::getLatestVersion());
+    ASSERT(cached == original);
+
+    std::unique_ptr<Object> object(Object::makeObjectFromFile("arm26.osim"));
+    ASSERT(dynamic_cast<Model*>(object.get()) != nullptr);
+    ASSERT(*object == original);
+
+    // Disabling the cache reads the XML file again.
+    XMLDocument::setCacheDirectory("");
+    Model uncached("arm26.osim");
+    ASSERT(!uncached.getDocument()->isReadFromCache());
+    ASSERT(uncached == original);
+
+    SimTK::State& s = cached.initSystem();
+    ASSERT(s.getNQ() == original.initSystem().getNQ());
+}
+
+void testInitSystemFrom()
+{
+    // This model has constraints, so initSystem() assembles it.
+    Model model("PushUpToesOnGroundExactConstraints.osim");
+    const SimTK::State& s0 = model.initSystem();
+    model.realizeAcceleration(s0);
+
+    Model copy(model);
+    SimTK::State& s = copy.initSystemFrom(s0);
+    ASSERT(s.getTime() == s0.getTime());
+    ASSERT(s.getQ() == s0.getQ());
+    ASSERT(s.getU() == s0.getU());
+    ASSERT(s.getZ() == s0.getZ());
+    copy.realizeAcceleration(s);
+    ASSERT((s.getUDot() - s0.getUDot()).normInf() < 1e-12);
+
+    // The copy can still assemble a modified configuration.
+    const Coordinate& coord = copy.getCoordinateSet().get(0);
+    coord.setValue(s, coord.getValue(s) + 0.01);
+    copy.realizePosition(s);
+    ASSERT(s.getQErr().normInf() < 1e-6);
+
+    // The numbers of state variables must match.
+    Model other("arm26.osim");
+    ASSERT_THROW(Exception, other.initSystemFrom(s0));
+}
+
+void testJointReactionsShareMobilizerReactions()
+{
+    Model model("arm26.osim");
+    SimTK::State& s = model.initSystem();
+    for (int i = 0; i < s.getNU(); ++i) s.updU()[i] = 0.5 * (i + 1);
+
+    // The reactions match those computed by Simbody for each mobilizer, also
+    // after the state changes (which invalidates the cached reactions).
+    for (int k = 0; k < 2; ++k) {
+        model.realizeAcceleration(s);
+        for (const auto& joint : model.getComponentList<Joint>()) {
+            const auto& mobod = joint.getChildFrame().getMobilizedBody();
+            ASSERT_EQUAL(mobod.findMobilizerReactionOnBodyAtMInGround(s),
+                    joint.calcReactionOnChildExpressedInGround(s), 1e-10,
+                    __FILE__, __LINE__);
+            ASSERT_EQUAL(mobod.findMobilizerReactionOnParentAtFInGround(s),
+                    joint.calcReactionOnParentExpressedInGround(s), 1e-10,
+                    __FILE__, __LINE__);
+        }
+        ASSERT(model.getMobilizerReactionForces(s).size() ==
+               model.getMatterSubsystem().getNumBodies());
+        const Coordinate& coord = model.getCoordinateSet().get(0);
+        coord.setValue(s, coord.getValue(s) + 0.3);
+    }
+}
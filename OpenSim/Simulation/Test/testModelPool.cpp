@@ -0,0 +1,99 @@
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  testModelPool.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Actuators/ModelFactory.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/ModelPool.h>
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch/catch.hpp>
+
+#include <algorithm>
+#include <set>
+
+using namespace OpenSim;
+
+TEST_CASE("ModelPool") {
+    Model model = ModelFactory::createDoublePendulum();
+    model.initSystem();
+
+    ModelPool pool(model, 3);
+    REQUIRE(pool.getNumModels() == 3);
+    CHECK_THROWS_AS(pool.updModel(3), IndexOutOfRange);
+
+    SECTION("parallelForFrames() evaluates each frame") {
+        const int numRows = 50;
+        std::vector<double> times(numRows);
+        SimTK::Matrix values(numRows, 1);
+        for (int i = 0; i < numRows; ++i) {
+            times[i] = 0.01 * i;
+            values(i, 0) = std::sin(times[i]);
+        }
+        TimeSeriesTable table(times, values, {"q0"});
+
+        std::vector<SimTK::Vec3> locations(numRows);
+        std::vector<double> stateTimes(numRows);
+        std::vector<const Model*> models(numRows);
+        pool.parallelForFrames(table,
+                [&](Model& model, SimTK::State& state, int row) {
+                    model.getCoordinateSet().get("q0").setValue(
+                            state, table.getMatrix()(row, 0), false);
+                    model.realizePosition(state);
+                    locations[row] = model.getBodySet().get("b1")
+                            .getPositionInGround(state);
+                    stateTimes[row] = state.getTime();
+                    models[row] = &model;
+                });
+
+        SimTK::State state = model.initSystem();
+        for (int i = 0; i < numRows; ++i) {
+            model.getCoordinateSet().get("q0").setValue(
+                    state, values(i, 0), false);
+            model.realizePosition(state);
+            CHECK((locations[i] - model.getBodySet().get("b1")
+                    .getPositionInGround(state)).norm() < 1e-12);
+            CHECK(stateTimes[i] == times[i]);
+            CHECK(models[i] != &model);
+        }
+        // Each thread uses its own copy, for a contiguous range of frames.
+        std::set<const Model*> distinct(models.begin(), models.end());
+        CHECK(distinct.size() <= 3);
+        for (int i = 1; i < numRows; ++i) {
+            if (models[i] != models[i - 1]) {
+                CHECK(std::find(models.begin(), models.begin() + i,
+                        models[i]) == models.begin() + i);
+            }
+        }
+    }
+
+    SECTION("resetState() restores the initial state") {
+        SimTK::State& state = pool.updState(1);
+        const double initialValue =
+                pool.updModel(1).getCoordinateSet().get("q0").getValue(state);
+        pool.updModel(1).getCoordinateSet().get("q0").setValue(
+                state, initialValue + 1, false);
+        SimTK::State& reset = pool.resetState(1);
+        CHECK(&reset == &state);
+        CHECK(pool.updModel(1).getCoordinateSet().get("q0").getValue(reset)
+                == initialValue);
+    }
+}
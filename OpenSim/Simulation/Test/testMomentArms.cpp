@@ -55,6 +55,9 @@ void testMomentArmDefinitionForModel(const string &filename,
                                      double mass = -1.0, string errorMessage = "");
 
 void testMomentArmsAcrossCompoundJoint();
+void testBatchMomentArms(const string& filename);
+void testPathSurrogate(const string& filename);
+void testEquivalentForces(const string& filename);
 
 int main()
 {
@@ -67,6 +70,19 @@ int main()
         testMomentArmsAcrossCompoundJoint();
         cout << "Joint composed of more than one mobilized body: PASSED\n" << endl;
 
+        testBatchMomentArms("CoupledCoordinatesMPPsMomentArmTest.osim");
+        cout << "Batch moment arms with coupled coordinates: PASSED\n" << endl;
+
+        testBatchMomentArms("WrapPathCustomJointMomentArmTest.osim");
+        cout << "Batch moment arms with wrapping: PASSED\n" << endl;
+
+        testPathSurrogate("WrapPathCustomJointMomentArmTest.osim");
+        cout << "Path surrogate with wrapping: PASSED\n" << endl;
+
+        testEquivalentForces("CoupledCoordinatesMPPsMomentArmTest.osim");
+        testEquivalentForces("WrapPathCustomJointMomentArmTest.osim");
+        cout << "Equivalent forces of path tension: PASSED\n" << endl;
+
         testMomentArmDefinitionForModel("BothLegs22.osim", "r_knee_angle", "VASINT", 
             SimTK::Vec2(-2*SimTK::Pi/3, SimTK::Pi/18), 0.0, 
             "VASINT of BothLegs with no mass: FAILED");
@@ -269,6 +285,173 @@ SimTK::Vector computeGenForceScaling(const Model &osimModel, const SimTK::State
 //==========================================================================================================
 // Main test driver can be used on any model so test cases should be very easy to add
 //==========================================================================================================
+// The lengths and moment arms of all muscles about all coordinates, solved in
+// one sweep over a trajectory (on multiple threads), must match those solved
+// one muscle and coordinate at a time.
+void testBatchMomentArms(const string& filename)
+{
+    Model model(filename);
+    SimTK::State& s = model.initSystem();
+    MomentArmSolver maSolver(model);
+
+    std::vector<const Coordinate*> coords;
+    for (const auto& coord : model.getComponentList<Coordinate>())
+        coords.push_back(&coord);
+    std::vector<const GeometryPath*> paths;
+    for (const auto& path : model.getComponentList<GeometryPath>())
+        paths.push_back(&path);
+    const int nc = (int)coords.size();
+    const int np = (int)paths.size();
+
+    // Sweep the coordinates from 0 to half of their range maxima.
+    const int nf = 8;
+    SimTK::Matrix qTrajectory(nf, s.getNQ());
+    for (int i = 0; i < nf; ++i) {
+        for (const auto* coord : coords)
+            coord->setValue(s, 0.5 * coord->getRangeMax() * i / (nf - 1),
+                    false);
+        model.assemble(s);
+        qTrajectory.updRow(i) = ~s.getQ();
+    }
+
+    SimTK::Matrix lengths;
+    std::vector<SimTK::Matrix> momentArms;
+    maSolver.solve(qTrajectory, coords, paths, lengths, momentArms, 3);
+    ASSERT(lengths.nrow() == nf && lengths.ncol() == np);
+    ASSERT((int)momentArms.size() == np);
+
+    for (int i = 0; i < nf; ++i) {
+        s.updQ() = ~qTrajectory[i];
+        model.realizePosition(s);
+        for (int k = 0; k < np; ++k) {
+            ASSERT_EQUAL(paths[k]->getLength(s), lengths(i, k), 1e-12,
+                    __FILE__, __LINE__, "Batch lengths do not match.");
+            for (int j = 0; j < nc; ++j) {
+                ASSERT_EQUAL(maSolver.solve(s, *coords[j], *paths[k]),
+                        momentArms[k](i, j), 1e-12, __FILE__, __LINE__,
+                        "Batch moment arms do not match.");
+                // The path computes its moment arms about all coordinates
+                // at once, analytically if no constraints couple them.
+                ASSERT_EQUAL(maSolver.solve(s, *coords[j], *paths[k]),
+                        paths[k]->computeMomentArm(s, *coords[j]), 1e-12,
+                        __FILE__, __LINE__,
+                        "Path moment arms do not match the solver.");
+            }
+        }
+    }
+}
+
+void testPathSurrogate(const string& filename)
+{
+    // The surrogate must answer repeated sweeps of the coordinates within
+    // (a small multiple of) its tolerance, including across the changes in
+    // wrapping.
+    const double tolerance = 1e-4;
+    Model exactModel(filename);
+    Model model(filename);
+    for (auto& path : model.updComponentList<GeometryPath>()) {
+        path.set_surrogate_tolerance(tolerance);
+        path.set_surrogate_resolution(0.05);
+    }
+    SimTK::State& exactState = exactModel.initSystem();
+    SimTK::State& s = model.initSystem();
+
+    std::vector<const Coordinate*> coords;
+    for (const auto& coord : model.getComponentList<Coordinate>())
+        coords.push_back(&coord);
+    std::vector<const GeometryPath*> paths;
+    for (const auto& path : model.getComponentList<GeometryPath>())
+        paths.push_back(&path);
+    std::vector<const GeometryPath*> exactPaths;
+    for (const auto& path : exactModel.getComponentList<GeometryPath>())
+        exactPaths.push_back(&path);
+
+    const int nf = 200;
+    for (int sweep = 0; sweep < 3; ++sweep) {
+        for (int i = 0; i < nf; ++i) {
+            for (const auto* coord : coords) {
+                const double t = 0.5 + 0.5 * std::sin(0.37 * i + sweep);
+                coord->setValue(s, coord->getRangeMin() + t *
+                        (coord->getRangeMax() - coord->getRangeMin()), false);
+            }
+            exactState.updQ() = s.getQ();
+            model.realizePosition(s);
+            exactModel.realizePosition(exactState);
+            for (int k = 0; k < (int)paths.size(); ++k) {
+                ASSERT_EQUAL(exactPaths[k]->getLength(exactState),
+                        paths[k]->getLength(s), 10 * tolerance,
+                        __FILE__, __LINE__, "Surrogate length is inaccurate.");
+                for (const auto* coord : coords) {
+                    const auto& exactCoord = exactModel.getComponent<
+                            Coordinate>(coord->getAbsolutePathString());
+                    ASSERT_EQUAL(exactPaths[k]->computeMomentArm(exactState,
+                                         exactCoord),
+                            paths[k]->computeMomentArm(s, *coord),
+                            10 * tolerance, __FILE__, __LINE__,
+                            "Surrogate moment arm is inaccurate.");
+                }
+            }
+        }
+    }
+}
+
+void testEquivalentForces(const string& filename)
+{
+    // The body forces summed for each body must match the point forces along
+    // the path, and applying the tension as generalized forces must not
+    // change the generalized forces.
+    const double tension = 13.0;
+    Model model(filename);
+    SimTK::State& s = model.initSystem();
+    const SimTK::SimbodyMatterSubsystem& matter = model.getMatterSubsystem();
+
+    for (const auto* coord : model.getComponentList<Coordinate>()) {
+        coord->setValue(s, 0.3 * coord->getRangeMax(), false);
+    }
+    model.assemble(s);
+    model.realizePosition(s);
+
+    for (auto& path : model.updComponentList<GeometryPath>()) {
+        SimTK::Vector_<SimTK::SpatialVec> bodyForces(matter.getNumBodies(),
+                SimTK::SpatialVec(SimTK::Vec3(0), SimTK::Vec3(0)));
+        SimTK::Vector mobilityForces(s.getNU(), 0.0);
+        path.addInEquivalentForces(s, tension, bodyForces, mobilityForces);
+
+        SimTK::Vector_<SimTK::SpatialVec> pointForces(matter.getNumBodies(),
+                SimTK::SpatialVec(SimTK::Vec3(0), SimTK::Vec3(0)));
+        Array<PointForceDirection*> pfds;
+        path.getPointForceDirections(s, &pfds);
+        for (int i = 0; i < pfds.getSize(); ++i) {
+            const PhysicalFrame& frame = pfds[i]->frame();
+            frame.getMobilizedBody().applyForceToBodyPoint(s,
+                    frame.findTransformInBaseFrame() * pfds[i]->point(),
+                    tension * pfds[i]->direction(), pointForces);
+            delete pfds[i];
+        }
+        for (int b = 0; b < matter.getNumBodies(); ++b) {
+            SimTK_TEST_EQ_TOL(pointForces[b], bodyForces[b], 1e-10);
+        }
+
+        SimTK::Vector forces(s.getNU());
+        matter.multiplyBySystemJacobianTranspose(s, bodyForces, forces);
+        forces += mobilityForces;
+
+        path.set_apply_tension_as_generalized_forces(true);
+        bodyForces.setToZero();
+        mobilityForces = 0;
+        path.addInEquivalentForces(s, tension, bodyForces, mobilityForces);
+        path.set_apply_tension_as_generalized_forces(false);
+        for (int b = 0; b < matter.getNumBodies(); ++b) {
+            ASSERT(bodyForces[b] ==
+                   SimTK::SpatialVec(SimTK::Vec3(0), SimTK::Vec3(0)));
+        }
+        for (int i = 0; i < s.getNU(); ++i) {
+            ASSERT_EQUAL(forces[i], mobilityForces[i], 1e-10, __FILE__,
+                    __LINE__, "Generalized forces of the tension differ.");
+        }
+    }
+}
+
 void testMomentArmDefinitionForModel(const string &filename, const string &coordName, 
                                     const string &muscleName, SimTK::Vec2 rom,
                                     double mass, string errorMessage)
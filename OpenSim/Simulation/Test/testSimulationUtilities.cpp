@@ -22,7 +22,9 @@
  * -------------------------------------------------------------------------- */
 
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <OpenSim/Simulation/Manager/Manager.h>
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/OpenSense/IMU.h>
 #include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
 #include <OpenSim/Simulation/SimulationUtilities.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
@@ -31,12 +33,16 @@ using namespace OpenSim;
 using namespace std;
 
 void testUpdatePre40KinematicsFor40MotionType();
+void testAnalyzeParallel();
+void testCreateSyntheticIMUSignals();
 
 int main() {
     LoadOpenSimLibrary("osimActuators");
 
     SimTK_START_TEST("testSimulationUtilities");
         SimTK_SUBTEST(testUpdatePre40KinematicsFor40MotionType);
+        SimTK_SUBTEST(testAnalyzeParallel);
+        SimTK_SUBTEST(testCreateSyntheticIMUSignals);
     SimTK_END_TEST();
 }
 
@@ -174,22 +180,95 @@ void testUpdatePre40KinematicsFor40MotionType() {
     }
 }
 
+void testAnalyzeParallel() {
+    Model model("testSimulationUtilities_leg6dof9musc_20303.osim");
 
+    // Create a states trajectory by simulating the model.
+    SimTK::State state = model.initSystem();
+    Manager manager(model);
+    manager.initialize(state);
+    manager.integrate(0.2);
+    const TimeSeriesTable statesTable = manager.getStatesTable();
+
+    TimeSeriesTable controlsTable(statesTable.getIndependentColumn());
+    const auto& actuators = model.getActuators();
+    for (int i = 0; i < actuators.getSize(); ++i) {
+        controlsTable.appendColumn(actuators[i].getAbsolutePathString(),
+                SimTK::Vector((int)statesTable.getNumRows(), 0.05 * (i + 1)));
+    }
 
+    const std::vector<std::string> outputPaths{".*active_fiber_force",
+            ".*\\|tendon_length", "/bodyset/tibia_r\\|position"};
+    const auto expected = analyze<double>(
+            model, statesTable, controlsTable, outputPaths);
+    SimTK_TEST(expected.getNumColumns() > 0);
+    for (int numThreads : {1, 3}) {
+        const auto actual = analyzeParallel<double>(model, statesTable,
+                controlsTable, outputPaths, {}, numThreads);
+        SimTK_TEST(actual.getColumnLabels() == expected.getColumnLabels());
+        SimTK_TEST(actual.getIndependentColumn() ==
+                   expected.getIndependentColumn());
+        SimTK_TEST_EQ(actual.getMatrix(), expected.getMatrix());
+    }
 
+    const auto expectedVec3 = analyze<SimTK::Vec3>(
+            model, statesTable, controlsTable, outputPaths);
+    const auto actualVec3 = analyzeParallel<SimTK::Vec3>(
+            model, statesTable, controlsTable, outputPaths, {}, 2);
+    SimTK_TEST(actualVec3.getColumnLabels() == expectedVec3.getColumnLabels());
+    SimTK_TEST_EQ(actualVec3.getMatrix(), expectedVec3.getMatrix());
+}
 
+void testCreateSyntheticIMUSignals() {
+    Model model("testSimulationUtilities_leg6dof9musc_20303.osim");
 
+    SimTK::State state = model.initSystem();
+    Manager manager(model);
+    manager.initialize(state);
+    manager.integrate(0.1);
+    const TimeSeriesTable statesTable = manager.getStatesTable();
+
+    TimeSeriesTable controlsTable(statesTable.getIndependentColumn());
+    const auto& actuators = model.getActuators();
+    for (int i = 0; i < actuators.getSize(); ++i) {
+        controlsTable.appendColumn(actuators[i].getAbsolutePathString(),
+                SimTK::Vector((int)statesTable.getNumRows(), 0.05 * (i + 1)));
+    }
 
-
-
-
-
-
-
-
-
-
-
-
-
-
+    // The signals must match the outputs of IMU components on the frames.
+    const std::vector<std::string> framePaths{
+            "/bodyset/pelvis", "/bodyset/tibia_r"};
+    Model modelWithIMUs(model);
+    for (int i = 0; i < (int)framePaths.size(); ++i) {
+        auto* imu = new IMU();
+        imu->setName("imu" + std::to_string(i));
+        imu->connectSocket_frame(
+                modelWithIMUs.getComponent<PhysicalFrame>(framePaths[i]));
+        modelWithIMUs.addComponent(imu);
+    }
+    const auto orientations = analyze<SimTK::Quaternion>(modelWithIMUs,
+            statesTable, controlsTable, {".*orientation_as_quaternion"});
+    const auto gyroscopeSignals = analyze<SimTK::Vec3>(modelWithIMUs,
+            statesTable, controlsTable, {".*gyroscope_signal"});
+    const auto accelerometerSignals = analyze<SimTK::Vec3>(modelWithIMUs,
+            statesTable, controlsTable, {".*accelerometer_signal"});
+
+    for (int numThreads : {1, 3}) {
+        const SyntheticIMUSignals signals = createSyntheticIMUSignals(
+                model, statesTable, controlsTable, framePaths, numThreads);
+        SimTK_TEST(signals.accelerometerSignals.getColumnLabels() ==
+                   framePaths);
+        SimTK_TEST(signals.orientations.getIndependentColumn() ==
+                   statesTable.getIndependentColumn());
+        for (int i = 0; i < (int)orientations.getNumRows(); ++i) {
+            for (int j = 0; j < (int)framePaths.size(); ++j) {
+                SimTK_TEST_EQ(signals.orientations.getMatrix()(i, j).asVec4(),
+                        orientations.getMatrix()(i, j).asVec4());
+            }
+        }
+        SimTK_TEST_EQ(signals.gyroscopeSignals.getMatrix(),
+                gyroscopeSignals.getMatrix());
+        SimTK_TEST_EQ(signals.accelerometerSignals.getMatrix(),
+                accelerometerSignals.getMatrix());
+    }
+}
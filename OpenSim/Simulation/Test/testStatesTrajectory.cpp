@@ -23,6 +23,7 @@
 
 #include <OpenSim/Simulation/osimSimulation.h>
 #include <OpenSim/Common/Constant.h>
+#include <OpenSim/Actuators/ModelFactory.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
 #include <random>
 #include <cstdio>
@@ -125,6 +126,61 @@ void testPopulateTrajectoryAndStatesTrajectoryReporter() {
     }
 }
 
+void testStatesTrajectoryReporterOutputFileAndMaxNumStates() {
+    Model model = ModelFactory::createDoublePendulum();
+    const std::string fileName =
+            "testStatesTrajectory_StatesTrajectoryReporter_output_file.sto";
+
+    auto* allStates = new StatesTrajectoryReporter();
+    allStates->setName("all_states");
+    allStates->set_report_time_interval(0.01);
+    model.addComponent(allStates);
+
+    auto* streamed = new StatesTrajectoryReporter();
+    streamed->setName("streamed_states");
+    streamed->set_report_time_interval(0.01);
+    streamed->set_output_file(fileName);
+    model.addComponent(streamed);
+
+    auto* recentStates = new StatesTrajectoryReporter();
+    recentStates->setName("recent_states");
+    recentStates->set_report_time_interval(0.01);
+    recentStates->set_max_num_states(3);
+    model.addComponent(recentStates);
+
+    SimTK::State state = model.initSystem();
+    model.getCoordinateSet().get("q0").setValue(state, 0.5);
+    Manager manager(model);
+    manager.initialize(state);
+    manager.integrate(0.1);
+
+    const StatesTrajectory& all = allStates->getStates();
+    SimTK_TEST(all.getSize() == 11);
+
+    // With output_file, no states are kept in memory by default.
+    SimTK_TEST(streamed->getStates().getSize() == 0);
+    streamed->clear(); // Finish writing the file.
+    TimeSeriesTable table(fileName);
+    SimTK_TEST(table.getNumRows() == all.getSize());
+    const auto fromFile =
+            StatesTrajectory::createFromStatesTable(model, table);
+    for (size_t i = 0; i < all.getSize(); ++i) {
+        ASSERT_EQUAL(fromFile[i].getTime(), all[i].getTime(), 1e-12);
+        SimTK_TEST_EQ_TOL(fromFile[i].getY(), all[i].getY(), 1e-12);
+    }
+
+    // Only the last 3 states are kept.
+    const StatesTrajectory& recent = recentStates->getStates();
+    SimTK_TEST(recent.getSize() == 3);
+    for (size_t i = 0; i < 3; ++i) {
+        ASSERT_EQUAL(recent[i].getTime(),
+                all[all.getSize() - 3 + i].getTime(), 1e-15);
+    }
+    const StatesTrajectory released = recentStates->releaseStates();
+    SimTK_TEST(released.getSize() == 3);
+    SimTK_TEST(recentStates->getStates().getSize() == 0);
+}
+
 void testFrontBack() {
     Model model("arm26.osim");
     const auto& state = model.initSystem();
@@ -300,6 +356,44 @@ Storage newStorageWithRemovedRows(const Storage& origSto,
     return sto;
 }
 
+void testCompactStatesTrajectory() {
+    Model model("gait2354_simbody.osim");
+    const TimeSeriesTable table(statesStoFname);
+    const auto states = StatesTrajectory::createFromStatesTable(model, table);
+    const auto compact =
+            CompactStatesTrajectory::createFromStatesTable(model, table);
+    model.initSystem();
+
+    SimTK_TEST(compact.getSize() == states.getSize());
+    SimTK_TEST(compact.getNumY() == states[0].getNY());
+    SimTK::State state = compact.getState(0);
+    for (size_t i = 0; i < states.getSize(); ++i) {
+        SimTK_TEST_EQ(compact.getTime(i), states[i].getTime());
+        SimTK_TEST_EQ(compact.getY(i), states[i].getY());
+        compact.copyToState(i, state);
+        SimTK_TEST_EQ(state.getTime(), states[i].getTime());
+        SimTK_TEST_EQ(state.getY(), states[i].getY());
+        // The materialized states can be used with the model.
+        model.realizePosition(state);
+        model.realizePosition(states[i]);
+        SimTK_TEST_EQ(model.calcMassCenterPosition(state),
+                model.calcMassCenterPosition(states[i]));
+    }
+
+    // Round trip through a StatesTrajectory.
+    const CompactStatesTrajectory fromStates(states);
+    SimTK_TEST(fromStates.getSize() == states.getSize());
+    const StatesTrajectory roundTrip = fromStates.createStatesTrajectory();
+    SimTK_TEST(roundTrip.getSize() == states.getSize());
+    SimTK_TEST(roundTrip.isConsistent());
+    SimTK_TEST_EQ(roundTrip.back().getY(), states.back().getY());
+
+    SimTK_TEST_MUST_THROW_EXC(compact.getTime(compact.getSize()),
+            IndexOutOfRange);
+    SimTK::State otherState = ModelFactory::createPendulum().initSystem();
+    SimTK_TEST_MUST_THROW_EXC(compact.copyToState(0, otherState), Exception);
+}
+
 void testFromStatesStorageInconsistentModel(const std::string &stoFilepath) {
 
     // States are missing from the Storage.
@@ -782,6 +876,7 @@ int main() {
         remove(statesStoFname.c_str());
 
         SimTK_SUBTEST(testPopulateTrajectoryAndStatesTrajectoryReporter);
+        SimTK_SUBTEST(testStatesTrajectoryReporterOutputFileAndMaxNumStates);
         SimTK_SUBTEST(testFrontBack);
         SimTK_SUBTEST(testBoundsCheck);
         SimTK_SUBTEST(testIntegrityChecks);
@@ -797,6 +892,7 @@ int main() {
         // v4.0 states storage
         createStateStorageFile();
         SimTK_SUBTEST(testFromStatesStorageGivesCorrectStates);
+        SimTK_SUBTEST(testCompactStatesTrajectory);
         SimTK_SUBTEST1(testFromStatesStorageInconsistentModel, statesStoFname);
         SimTK_SUBTEST(testFromStatesStorageUniqueColumnLabels);
 
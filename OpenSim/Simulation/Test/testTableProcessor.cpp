@@ -20,11 +20,18 @@
 #include <OpenSim/Auxiliary/catch/catch.hpp>
 
 #include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Simulation/TableProcessor.h>
 
+#include <random>
+
 using namespace OpenSim;
 
+namespace {
+    int numOperations = 0;
+}
+
 TEST_CASE("TableProcessor") {
     Object::registerType(TableProcessor());
 
@@ -33,6 +40,7 @@ TEST_CASE("TableProcessor") {
 
     public:
         void operate(TimeSeriesTable& table, const Model*) const override {
+            ++numOperations;
             table.appendRow(10.0, ~createVectorLinspace(
                                           (int)table.getNumColumns(), 0, 1));
         }
@@ -76,4 +84,29 @@ TEST_CASE("TableProcessor") {
             CHECK(out.getNumRows() == 4);
         }
     }
+
+    SECTION("Cache") {
+        IO::makeDir("testTableProcessor_cache");
+        TableProcessor::setCacheDirectory("testTableProcessor_cache");
+        // Make the data unique to this run, so that the first process() does
+        // not find a cache file from a previous run.
+        TimeSeriesTable uniqueTable = table;
+        uniqueTable.updMatrix()(0, 0) = std::random_device{}();
+        TableProcessor proc = TableProcessor(uniqueTable) | MyTableOperator();
+        numOperations = 0;
+        TimeSeriesTable first = proc.process();
+        CHECK(numOperations == 1);
+        TimeSeriesTable second = proc.process();
+        CHECK(numOperations == 1);
+        CHECK(second.getColumnLabels() == first.getColumnLabels());
+        CHECK(second.getIndependentColumn() == first.getIndependentColumn());
+        CHECK(SimTK::Test::numericallyEqual(
+                second.getMatrix(), first.getMatrix(), 1, 0));
+
+        // A different table is not found in the cache.
+        uniqueTable.updMatrix()(1, 1) += 1;
+        (TableProcessor(uniqueTable) | MyTableOperator()).process();
+        CHECK(numOperations == 2);
+        TableProcessor::setCacheDirectory("");
+    }
 }
@@ -0,0 +1,89 @@
+/* -------------------------------------------------------------------------- *
+ *                  OpenSim:  testVectorizedEnvironment.cpp                   *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+
+#include <OpenSim/Actuators/ModelFactory.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/VectorizedEnvironment.h>
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch/catch.hpp>
+
+using namespace OpenSim;
+
+TEST_CASE("VectorizedEnvironment") {
+    // A unit mass that slides along x without gravity, pushed by a force
+    // equal to its control.
+    Model model = ModelFactory::createSlidingPointMass();
+    const int numEnvironments = 5;
+
+    CHECK_THROWS(VectorizedEnvironment(model, numEnvironments,
+            {"/slider/position"}));
+    CHECK_THROWS(VectorizedEnvironment(model, numEnvironments,
+            {"/slider/position|nonexistent"}));
+
+    VectorizedEnvironment envs(model, numEnvironments,
+            {"/slider/position|value", "/slider/position|speed"}, 2);
+    REQUIRE(envs.getNumEnvironments() == numEnvironments);
+    REQUIRE(envs.getNumActions() == 1);
+    REQUIRE(envs.getNumObservations() == 2);
+    CHECK(envs.getActuatorPaths()[0] == "/forceset/actuator");
+    CHECK_THROWS_AS(envs.getState(numEnvironments), IndexOutOfRange);
+
+    const double* observations = envs.getObservations();
+    for (int i = 0; i < 2 * numEnvironments; ++i) {
+        CHECK(observations[i] == 0);
+    }
+
+    // The environment with index i is pushed by a force i.
+    std::vector<double> actions(numEnvironments);
+    for (int i = 0; i < numEnvironments; ++i) actions[i] = i;
+    const int numSteps = 10;
+    for (int k = 0; k < numSteps; ++k) envs.step(actions.data());
+    const double t = numSteps * envs.getStepSize();
+    for (int i = 0; i < numEnvironments; ++i) {
+        INFO("environment " << i);
+        CHECK(envs.getState(i).getTime() == Approx(t));
+        CHECK(observations[2 * i] == Approx(0.5 * i * t * t).margin(1e-12));
+        CHECK(observations[2 * i + 1] == Approx(i * t).margin(1e-12));
+    }
+
+    SECTION("reset() restores the initial state") {
+        envs.reset(3);
+        CHECK(envs.getState(3).getTime() == 0);
+        CHECK(observations[6] == 0);
+        CHECK(observations[7] == 0);
+        // The other environments are unaffected.
+        CHECK(observations[8] == Approx(0.5 * 4 * t * t).margin(1e-12));
+    }
+
+    SECTION("reset() to a given state") {
+        SimTK::State state = envs.getState(1);
+        envs.getModel(1).getComponent<Coordinate>("/slider/position")
+                .setSpeedValue(state, -2.0);
+        envs.reset(1, state);
+        CHECK(observations[3] == -2.0);
+        envs.step(actions.data());
+        CHECK(observations[3] ==
+                Approx(-2.0 + envs.getStepSize()).margin(1e-12));
+    }
+}
@@ -0,0 +1,194 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  VectorizedEnvironment.cpp                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "VectorizedEnvironment.h"
+
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Simulation/Control/ExternalController.h>
+#include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <exception>
+
+using namespace OpenSim;
+
+namespace {
+    const std::string controllerName = "vectorized_environment_controller";
+
+    // A copy of the model with an ExternalController for all its actuators.
+    std::unique_ptr<Model> createModelWithController(const Model& model) {
+        std::unique_ptr<Model> copy(model.clone());
+        copy->finalizeFromProperties();
+        auto* controller = new ExternalController();
+        controller->setName(controllerName);
+        for (const auto& actuator : copy->getComponentList<Actuator>()) {
+            controller->addActuator(actuator);
+        }
+        copy->addController(controller);
+        return copy;
+    }
+}
+
+struct VectorizedEnvironment::Environment {
+    Model* model = nullptr;
+    const ExternalController* controller = nullptr;
+    std::unique_ptr<Manager> manager;
+    std::vector<const Output<double>*> outputs;
+    // The stage to realize to for evaluating the outputs.
+    SimTK::Stage stage = SimTK::Stage::Time;
+    // The actions of a step, as controls for the controller.
+    SimTK::Vector controls;
+};
+
+VectorizedEnvironment::VectorizedEnvironment(const Model& model,
+        int numEnvironments, const std::vector<std::string>& observationPaths,
+        int numThreads)
+        : m_pool(*createModelWithController(model), numEnvironments),
+          m_numThreads(getNumThreadsOrDefault(numThreads)),
+          m_observationPaths(observationPaths) {
+    OPENSIM_THROW_IF(numEnvironments < 1, Exception,
+            "Expected at least one environment, but got {}.",
+            numEnvironments);
+
+    for (int i = 0; i < numEnvironments; ++i) {
+        std::unique_ptr<Environment> env(new Environment());
+        env->model = &m_pool.updModel(i);
+        env->controller = &env->model->getComponent<ExternalController>(
+                "/controllerset/" + controllerName);
+        for (const auto& path : m_observationPaths) {
+            const auto separator = path.rfind('|');
+            OPENSIM_THROW_IF(separator == std::string::npos, Exception,
+                    "Expected the observation '{}' to have the form "
+                    "'<component path>|<output name>'.", path);
+            const AbstractOutput& output =
+                    env->model->getComponent(path.substr(0, separator))
+                            .getOutput(path.substr(separator + 1));
+            const auto* outputDouble =
+                    dynamic_cast<const Output<double>*>(&output);
+            OPENSIM_THROW_IF(!outputDouble, Exception,
+                    "Expected the output of observation '{}' to have type "
+                    "double, but it has type {}.", path,
+                    output.getTypeName());
+            env->outputs.push_back(outputDouble);
+            if (output.getDependsOnStage() > env->stage) {
+                env->stage = output.getDependsOnStage();
+            }
+        }
+        env->manager.reset(new Manager(*env->model));
+        env->controls.resize(env->controller->getActuatorSet().getSize());
+        m_environments.push_back(std::move(env));
+    }
+
+    const auto& actuators = m_environments[0]->controller->getActuatorSet();
+    for (int i = 0; i < actuators.getSize(); ++i) {
+        m_actuatorPaths.push_back(actuators[i].getAbsolutePathString());
+    }
+    m_observations.resize(
+            (size_t)numEnvironments * m_observationPaths.size(), 0.0);
+    reset();
+}
+
+VectorizedEnvironment::~VectorizedEnvironment() = default;
+
+void VectorizedEnvironment::setStepSize(double stepSize) {
+    OPENSIM_THROW_IF(!(stepSize > 0), Exception,
+            "Expected the step size to be positive, but it is {}.", stepSize);
+    m_stepSize = stepSize;
+}
+
+void VectorizedEnvironment::setNumSubsteps(int numSubsteps) {
+    OPENSIM_THROW_IF(numSubsteps < 1, Exception,
+            "Expected at least one substep, but got {}.", numSubsteps);
+    m_numSubsteps = numSubsteps;
+}
+
+VectorizedEnvironment::Environment& VectorizedEnvironment::getEnvironment(
+        int index) const {
+    OPENSIM_THROW_IF(index < 0 || index >= getNumEnvironments(),
+            IndexOutOfRange, (size_t)index, 0,
+            (size_t)getNumEnvironments() - 1);
+    return *m_environments[index];
+}
+
+void VectorizedEnvironment::reset() {
+    for (int i = 0; i < getNumEnvironments(); ++i) reset(i);
+}
+
+void VectorizedEnvironment::reset(int index) {
+    getEnvironment(index);
+    reset(index, m_pool.resetState(index));
+}
+
+void VectorizedEnvironment::reset(int index, const SimTK::State& state) {
+    getEnvironment(index).manager->initialize(state);
+    evaluateObservations(index);
+}
+
+void VectorizedEnvironment::evaluateObservations(int index) {
+    const Environment& env = *m_environments[index];
+    const SimTK::State& state = env.manager->getState();
+    env.model->getSystem().realize(state, env.stage);
+    double* observations =
+            m_observations.data() + (size_t)index * env.outputs.size();
+    for (int j = 0; j < (int)env.outputs.size(); ++j) {
+        observations[j] = env.outputs[j]->getValue(state);
+    }
+}
+
+void VectorizedEnvironment::step(const double* actions) {
+    const int numActions = getNumActions();
+    std::vector<std::exception_ptr> exceptions(getNumEnvironments());
+    // A failure of one environment does not stop the others of its thread.
+    parallelForChunks(getNumEnvironments(), m_numThreads,
+            [&](int, int begin, int end) {
+                for (int i = begin; i < end; ++i) {
+                    try {
+                        Environment& env = *m_environments[i];
+                        const double* envActions =
+                                actions + (size_t)i * numActions;
+                        for (int j = 0; j < numActions; ++j) {
+                            env.controls[j] = envActions[j];
+                        }
+                        env.controller->setControls(
+                                env.manager->getState().getTime(),
+                                env.controls);
+                        for (int k = 0; k < m_numSubsteps; ++k) {
+                            env.manager->step(m_stepSize / m_numSubsteps);
+                        }
+                        evaluateObservations(i);
+                    } catch (...) {
+                        exceptions[i] = std::current_exception();
+                    }
+                }
+            });
+    for (const auto& exception : exceptions) {
+        if (exception) std::rethrow_exception(exception);
+    }
+}
+
+const SimTK::State& VectorizedEnvironment::getState(int index) const {
+    return getEnvironment(index).manager->getState();
+}
+
+const Model& VectorizedEnvironment::getModel(int index) const {
+    return *getEnvironment(index).model;
+}
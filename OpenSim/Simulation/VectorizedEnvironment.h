@@ -0,0 +1,147 @@
+#ifndef OPENSIM_VECTORIZED_ENVIRONMENT_H_
+#define OPENSIM_VECTORIZED_ENVIRONMENT_H_
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  VectorizedEnvironment.h                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ModelPool.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+/** A batch of independent simulations of one model that are advanced in
+lockstep on multiple threads, e.g., as the environments of reinforcement
+learning. Each environment has its own copy of the model (see ModelPool), with
+an ExternalController for all the actuators of the model that applies the
+actions of the environment, and its own Manager:
+
+@code
+VectorizedEnvironment envs(model, 64,
+        {"/jointset/j0/q0|value", "/jointset/j0/q0|speed"});
+envs.setStepSize(0.01);
+envs.reset();
+std::vector<double> actions(envs.getNumEnvironments() * envs.getNumActions());
+while (...) {
+    // Compute the actions from envs.getObservations().
+    envs.step(actions.data());
+}
+@endcode
+
+The actions are the controls of the actuators listed by getActuatorPaths(),
+held constant during each step. The observations are the values of the given
+outputs (each of type double, given as `<component path>|<output name>`),
+which are looked up once when the environments are created and evaluated into
+one contiguous array (rows are environments) after each step and reset. A
+reset copies the initial state of the copy of the model (the state returned by
+initSystem()) instead of initializing the system again; to randomize the
+initial states, reset the environments to modified copies of their states.
+
+The copies of the model are made and initialized when the environments are
+created. step() and reset() must not be invoked by more than one thread at a
+time. */
+class OSIMSIMULATION_API VectorizedEnvironment {
+public:
+    /** Create `numEnvironments` environments of `model` that observe the
+    values of the given outputs. The environments are stepped with at most
+    `numThreads` threads; if `numThreads` is not positive, the number of
+    hardware threads is used (see getNumThreadsOrDefault()). All the
+    environments are reset. */
+    VectorizedEnvironment(const Model& model, int numEnvironments,
+            const std::vector<std::string>& observationPaths,
+            int numThreads = -1);
+    ~VectorizedEnvironment();
+
+    VectorizedEnvironment(const VectorizedEnvironment&) = delete;
+    VectorizedEnvironment& operator=(const VectorizedEnvironment&) = delete;
+
+    int getNumEnvironments() const { return (int)m_environments.size(); }
+    /** The number of actions of each environment, which is the number of
+    actuators of the model. */
+    int getNumActions() const { return (int)m_actuatorPaths.size(); }
+    /** The number of observations of each environment. */
+    int getNumObservations() const { return (int)m_observationPaths.size(); }
+    int getNumThreads() const { return m_numThreads; }
+
+    /** The absolute paths of the actuators, in the order of the actions. */
+    const std::vector<std::string>& getActuatorPaths() const {
+        return m_actuatorPaths;
+    }
+    /** The paths of the outputs, in the order of the observations. */
+    const std::vector<std::string>& getObservationPaths() const {
+        return m_observationPaths;
+    }
+
+    /** The duration of a step (default: 0.01). */
+    void setStepSize(double stepSize);
+    double getStepSize() const { return m_stepSize; }
+    /** The number of fixed integrator steps per step (default: 1; see
+    Manager::step()). */
+    void setNumSubsteps(int numSubsteps);
+    int getNumSubsteps() const { return m_numSubsteps; }
+
+    /** Reset all the environments. */
+    void reset();
+    /** Reset the environment with the given index to the initial state of its
+    copy of the model, and evaluate its observations. */
+    void reset(int index);
+    /** Reset the environment with the given index to `state` (e.g., a
+    randomized copy of getState()), and evaluate its observations. */
+    void reset(int index, const SimTK::State& state);
+
+    /** Advance all the environments by the step size, with `actions`
+    holding getNumActions() actions for each environment (rows are
+    environments), and evaluate their observations. If an environment throws
+    (e.g., the integration fails), the first exception is rethrown after all
+    the environments are stepped; reset the failed environments before the
+    next step. */
+    void step(const double* actions);
+
+    /** The observations of all the environments, with getNumObservations()
+    values for each environment (rows are environments), as of their last
+    step or reset. */
+    const double* getObservations() const { return m_observations.data(); }
+
+    /** The current state of the environment with the given index. */
+    const SimTK::State& getState(int index) const;
+    /** The copy of the model of the environment with the given index. */
+    const Model& getModel(int index) const;
+
+private:
+    struct Environment;
+    Environment& getEnvironment(int index) const;
+    void evaluateObservations(int index);
+
+    ModelPool m_pool;
+    int m_numThreads;
+    double m_stepSize = 0.01;
+    int m_numSubsteps = 1;
+    std::vector<std::string> m_actuatorPaths;
+    std::vector<std::string> m_observationPaths;
+    std::vector<std::unique_ptr<Environment>> m_environments;
+    std::vector<double> m_observations;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_VECTORIZED_ENVIRONMENT_H_
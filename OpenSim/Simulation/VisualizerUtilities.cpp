@@ -27,17 +27,173 @@
 #include "VisualizerUtilities.h"
 
 #include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/TableCursor.h>
 #include <OpenSim/Common/TableSource.h>
 #include <OpenSim/Common/TableUtilities.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/OpenSense/ExperimentalMarker.h>
 #include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
-#include <OpenSim/Simulation/StatesTrajectory.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 using namespace std;
 using namespace OpenSim;
 using namespace SimTK;
 
+namespace {
+
+/// The states of the frames of a motion, computed on a worker thread ahead of
+/// playback, so that a long motion is never converted to states all at once.
+/// Frame `i` is the motion at time `initialTime + i / dataRate`, interpolated
+/// linearly; the frames after the last frame are the first frames again, for
+/// looping. The states are realized to Report, and assembled only if the
+/// model has constraints.
+class MotionFrames {
+public:
+    MotionFrames(Model& model, const TimeSeriesTable& table,
+            double dataRate, int numFrames)
+            : m_model(model), m_cursor(table),
+              m_initialTime(table.getIndependentColumn().front()),
+              m_finalTime(table.getIndependentColumn().back()),
+              m_dataRate(dataRate), m_numFrames(numFrames),
+              m_assemble(model.getConstraintSet().getSize() > 0) {
+        // The table columns of the state variables; the state variables
+        // without a column keep their values from the model's working state.
+        const auto& labels = table.getColumnLabels();
+        const auto& names = model.getStateVariableNames();
+        for (int is = 0; is < names.getSize(); ++is) {
+            // findStateLabelIndex() also checks for pre-4.0 column names.
+            const int ic = TableUtilities::findStateLabelIndex(labels, names[is]);
+            if (ic != -1) m_columns.emplace_back(ic, is);
+        }
+        m_state = model.getWorkingState();
+        m_values = model.getStateVariableValues(m_state);
+        m_thread = std::thread(&MotionFrames::run, this);
+    }
+
+    ~MotionFrames() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_condition.notify_all();
+        m_thread.join();
+    }
+
+    int getNumFrames() const { return m_numFrames; }
+
+    /// The state of frame `index`, which is valid until the next call (asking
+    /// for the same frame again returns the same state). If the
+    /// index is not the frame after the previous one (e.g., the user moved the
+    /// time slider), the prefetched frames are discarded.
+    const State& getFrame(int index) {
+        if (index == m_currentIndex) return m_current;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (index != m_first) {
+            m_frames.clear();
+            m_first = index;
+            m_next = index;
+            ++m_generation;
+            m_condition.notify_all();
+        }
+        m_condition.wait(lock, [this] { return !m_frames.empty() || m_error; });
+        if (m_error) std::rethrow_exception(m_error);
+        m_current = m_frames.front().second;
+        m_currentIndex = index;
+        m_frames.pop_front();
+        m_first = (m_first + 1) % m_numFrames;
+        m_condition.notify_all();
+        return m_current;
+    }
+
+private:
+    void computeFrame(int index) {
+        const double time =
+                std::min(m_initialTime + index / m_dataRate, m_finalTime);
+        m_cursor.getValuesAtTime(time, m_row);
+        for (const auto& column : m_columns) {
+            m_values[column.second] = m_row[column.first];
+        }
+        m_state.setTime(time);
+        m_model.setStateVariableValues(m_state, m_values);
+        if (m_assemble) m_model.assemble(m_state);
+        // This allows muscle activity to be visualized. To get muscle
+        // activity we probably need to realize only to Dynamics, but
+        // realizing to Report will catch any other calculations that custom
+        // components require for visualizing.
+        m_model.realizeReport(m_state);
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_condition.wait(lock, [this] {
+                return m_stop || (int)m_frames.size() < Capacity;
+            });
+            if (m_stop) return;
+            const int index = m_next;
+            const int generation = m_generation;
+            m_next = (m_next + 1) % m_numFrames;
+            lock.unlock();
+            try {
+                computeFrame(index);
+            } catch (...) {
+                lock.lock();
+                m_error = std::current_exception();
+                m_condition.notify_all();
+                return;
+            }
+            lock.lock();
+            // Discard the frame if playback moved elsewhere meanwhile.
+            if (generation == m_generation) {
+                m_frames.emplace_back(index, m_state);
+                m_condition.notify_all();
+            }
+        }
+    }
+
+    // The number of frames computed ahead of playback.
+    static const int Capacity = 64;
+
+    Model& m_model;
+    // Only used by the worker thread.
+    TableCursor m_cursor;
+    RowVector m_row;
+    Vector m_values;
+    State m_state;
+
+    const double m_initialTime;
+    const double m_finalTime;
+    const double m_dataRate;
+    const int m_numFrames;
+    const bool m_assemble;
+    // (table column, state variable) pairs.
+    std::vector<std::pair<int, int>> m_columns;
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    // The prefetched frames: consecutive (modulo the number of frames),
+    // starting at frame m_first.
+    std::deque<std::pair<int, State>> m_frames;
+    int m_first = 0;
+    int m_next = 0;
+    int m_generation = 0;
+    bool m_stop = false;
+    std::exception_ptr m_error;
+    // Only used by the playback thread.
+    State m_current;
+    int m_currentIndex = -1;
+
+    std::thread m_thread;
+};
+
+} // anonymous namespace
+
 void VisualizerUtilities::showModel(Model model) {
     model.setUseVisualizer(true);
 
@@ -77,35 +233,24 @@ void VisualizerUtilities::showMotion(Model model, TimeSeriesTable statesTable) {
     const SimTK::Real duration = finalTime - initialTime;
 
     // A data rate of 300 Hz means we can maintain 30 fps down to
-    // realTimeScale = 0.1. But if we have more than 20 seconds of data, then
-    // we lower the data rate to avoid using too much memory.
-    const double desiredNumStates = std::min(300 * duration, 300.0 * 20.0);
-    const double dataRate = desiredNumStates / duration; // Hz
-    const double frameRate = 30;                         // Hz.
+    // realTimeScale = 0.1. The frames are computed from the table while they
+    // are played back, so the data rate does not depend on the duration.
+    const double dataRate = 300;  // Hz
+    const double frameRate = 30;  // Hz.
+    const int numStates = (int)std::floor(duration * dataRate) + 1;
 
     // Prepare data.
     // -------------
-    statesTable =
-            TableUtilities::resampleWithInterval(statesTable, 1.0 / dataRate);
     if (TableUtilities::isInDegrees(statesTable)) {
         model.setUseVisualizer(false);
         model.initSystem();
         model.getSimbodyEngine().convertDegreesToRadians(statesTable);
     }
-    auto statesTraj = StatesTrajectory::createFromStatesTable(
-            model, statesTable, true, true, false);
-    const int numStates = (int)statesTraj.getSize();
+    TableUtilities::checkNonUniqueLabels(statesTable.getColumnLabels());
 
-    // Must setUseVisualizer(true) *after* createFromStatesStorage(), otherwise
-    // createFromStatesStorage() spawns a visualizer.
     model.setUseVisualizer(true);
     model.initSystem();
-
-    // This line allows muscle activity to be visualized. To get muscle activity
-    // we probably need to realize only to Dynamics, but realizing to Report
-    // will catch any other calculations that custom components require for
-    // visualizing.
-    for (const auto& state : statesTraj) { model.realizeReport(state); }
+    MotionFrames frames(model, statesTable, dataRate, numStates);
 
     // Set up visualization.
     // ---------------------
@@ -187,7 +332,7 @@ void VisualizerUtilities::showMotion(Model model, TimeSeriesTable statesTable) {
                 istate = (int)SimTK::clamp(0, desiredIndex, numStates - 1);
                 // Allow the user to drag this slider to visualize different
                 // times.
-                viz.drawFrameNow(statesTraj[istate]);
+                viz.drawFrameNow(frames.getFrame(istate));
             } else {
                 log_cout("Internal error: unrecognized slider.");
             }
@@ -212,7 +357,7 @@ void VisualizerUtilities::showMotion(Model model, TimeSeriesTable statesTable) {
                         viz.updDecoration(pausedIndex));
                 text.setText(paused ? "Paused (hit Space to resume)" : "");
                 // Show the updated text.
-                viz.drawFrameNow(statesTraj[istate]);
+                viz.drawFrameNow(frames.getFrame(istate));
             }
         }
 
@@ -223,7 +368,7 @@ void VisualizerUtilities::showMotion(Model model, TimeSeriesTable statesTable) {
         if (paused) {
             std::this_thread::sleep_for(std::chrono::milliseconds(5));
         } else {
-            viz.report(statesTraj[istate]);
+            viz.report(frames.getFrame(istate));
             ++istate;
         }
     }
@@ -38,6 +38,13 @@ public:
     /// coordinates. The visualizer window allows the user to control playback
     /// speed. This function blocks until the user exits the simbody-visualizer
     /// window.
+    ///
+    /// The frames are computed (interpolated from the table at 300 Hz, and
+    /// realized) by a worker thread shortly before they are played back, so
+    /// playback starts immediately and uses the same memory for motions of
+    /// any duration. The state variables that are not in the table keep
+    /// their default values. The frames are assembled only if the model has
+    /// constraints.
     static void showMotion(Model, TimeSeriesTable);
     /// @}
 
@@ -118,6 +118,53 @@ void PathWrap::extendConnectToModel(Model& model)
     }
 }
 
+void PathWrap::extendAddToSystem(SimTK::MultibodySystem& system) const
+{
+    Super::extendAddToSystem(system);
+
+    _recentWrapsCV = addCacheVariable("recent_wraps",
+            std::vector<RecentWrap>{}, SimTK::Stage::Instance);
+}
+
+bool PathWrap::findRecentWrap(const SimTK::State& s, const SimTK::Vec3& aPoint1,
+        const SimTK::Vec3& aPoint2, WrapResult& rWrapResult,
+        int& rReturnCode) const
+{
+    if (!isCacheVariableValid(s, _recentWrapsCV)) return false;
+    const std::vector<RecentWrap>& recent =
+            getCacheVariableValue(s, _recentWrapsCV);
+    for (auto it = recent.rbegin(); it != recent.rend(); ++it) {
+        if (it->point1 == aPoint1 && it->point2 == aPoint2 &&
+                it->singleWrap == rWrapResult.singleWrap) {
+            const int startPoint = rWrapResult.startPoint;
+            const int endPoint = rWrapResult.endPoint;
+            rWrapResult = it->result;
+            rWrapResult.startPoint = startPoint;
+            rWrapResult.endPoint = endPoint;
+            rReturnCode = it->returnCode;
+            return true;
+        }
+    }
+    return false;
+}
+
+void PathWrap::addRecentWrap(const SimTK::State& s, const SimTK::Vec3& aPoint1,
+        const SimTK::Vec3& aPoint2, const WrapResult& aWrapResult,
+        int aReturnCode) const
+{
+    // Enough for every segment a path checks for wrapping over this object in
+    // one or two evaluations of the path.
+    static const std::size_t maxRecentWraps = 16;
+    std::vector<RecentWrap>& recent = updCacheVariableValue(s, _recentWrapsCV);
+    if (!isCacheVariableValid(s, _recentWrapsCV)) {
+        recent.clear();
+        markCacheVariableValid(s, _recentWrapsCV);
+    }
+    if (recent.size() >= maxRecentWraps) recent.erase(recent.begin());
+    recent.push_back({aPoint1, aPoint2, aWrapResult.singleWrap, aReturnCode,
+                      aWrapResult});
+}
+
 void PathWrap::setStartPoint( const SimTK::State& s, int aIndex)
 {
     if ((aIndex != get_range(0)) && 
@@ -116,9 +116,28 @@ public:
     void setPreviousWrap(const WrapResult& aWrapResult);
     void resetPreviousWrap();
 
+#ifndef SWIG
+    /** Look up the result of wrapping a path segment whose end points, in the
+    frame of the wrap object, are exactly at `aPoint1` and `aPoint2`, among
+    the results most recently computed with the given state (see
+    WrapObject::wrapPathSegment()). If found, the result is copied into
+    `rWrapResult` (except for the indices of the segment's points) and its
+    return code into `rReturnCode`. This allows paths to skip solving for the
+    wrapping of segments that did not move relative to the wrap object (e.g.,
+    when only coordinates elsewhere in the model were perturbed).           */
+    bool findRecentWrap(const SimTK::State& s, const SimTK::Vec3& aPoint1,
+            const SimTK::Vec3& aPoint2, WrapResult& rWrapResult,
+            int& rReturnCode) const;
+    /** Remember the result of wrapping a path segment for findRecentWrap(). */
+    void addRecentWrap(const SimTK::State& s, const SimTK::Vec3& aPoint1,
+            const SimTK::Vec3& aPoint2, const WrapResult& aWrapResult,
+            int aReturnCode) const;
+#endif
+
 private:
     void constructProperties();
     void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
     void setNull();
 
 private:
@@ -129,6 +148,19 @@ private:
 
     WrapResult _previousWrap;  // results from previous wrapping
 
+    // A wrapping result and the segment end points it was computed for.
+    struct RecentWrap {
+        SimTK::Vec3 point1;
+        SimTK::Vec3 point2;
+        bool singleWrap;
+        int returnCode;
+        WrapResult result;
+    };
+    // The most recently computed wrapping results, oldest first. Since the
+    // entries are looked up by the locations of the segment end points, this
+    // only depends on the Instance stage and survives changes to coordinates.
+    mutable CacheVariable<std::vector<RecentWrap>> _recentWrapsCV;
+
     MemberSubcomponentIndex _wrapPoint1Ix{
         constructSubcomponent<PathWrapPoint>("pwpt1") };
     MemberSubcomponentIndex _wrapPoint2Ix{
@@ -163,6 +163,24 @@ string WrapCylinder::getDimensionsString() const
 //=============================================================================
 // WRAPPING
 //=============================================================================
+//_____________________________________________________________________________
+/**
+ * If the cylinder is not constrained to a quadrant, the segment does not wrap
+ * over it if the segment stays outside of the (infinite) cylinder, i.e., if
+ * its projection onto the XY plane stays outside of the circle. A segment can
+ * wrap over a constrained cylinder without entering it (if it passes on the
+ * wrong side).
+ */
+bool WrapCylinder::isSegmentClearOfObject(const SimTK::Vec3& aPoint1,
+        const SimTK::Vec3& aPoint2) const
+{
+    if (_wrapSign != 0) return false;
+    return WrapMath::CalcDistanceSquaredLineSegmentToPoint(
+                   Vec3(aPoint1[0], aPoint1[1], 0),
+                   Vec3(aPoint2[0], aPoint2[1], 0), Vec3(0)) >
+           get_radius() * get_radius();
+}
+
 //_____________________________________________________________________________
 /**
  * Calculate the wrapping of one line segment over the cylinder.
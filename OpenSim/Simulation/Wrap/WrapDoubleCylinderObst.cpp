@@ -24,6 +24,8 @@
 #include <OpenSim/Simulation/Wrap/WrapResult.h>
 #include <OpenSim/Simulation/Model/Model.h>
 
+#include <algorithm>
+
 //=============================================================================
 // STATICS
 //=============================================================================
@@ -85,6 +87,7 @@ void WrapDoubleCylinderObst::constructProperties()
     constructProperty_translationVcyl(defaultTranslations);
 
     constructProperty_length(1.0);
+    constructProperty_warm_start(false);
 }
 
 //_____________________________________________________________________________
@@ -158,6 +161,15 @@ void WrapDoubleCylinderObst::extendFinalizeFromProperties()
 
 }
 
+void WrapDoubleCylinderObst::extendAddToSystem(
+        SimTK::MultibodySystem& system) const
+{
+    Super::extendAddToSystem(system);
+
+    _warmStartsCV = addCacheVariable("warm_starts",
+            std::vector<WarmStart>{}, SimTK::Stage::Instance);
+}
+
 //_____________________________________________________________________________
 /**
  * Get the name of the type of wrap object ("cylinderObst" in this case)
@@ -441,7 +453,51 @@ int WrapDoubleCylinderObst::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1
 
     int activeState=(int)aWrapResult.c1[0]; // _activeState;    // TEMP set to zero
     if( (int)aWrapResult.c1[1] != 12345 ) { aWrapResult.c1[1]=12345.01; activeState=0; }    // Initialize activeState first iteration
-    double_cylinder(u,Ru,v,Rv,  VcylObstToUcylObst,  P,q,Q,T,t,vs, &Pq,&qQ,&QT,&Tt,&tS,&L, &activeState, &ru,&rv);
+
+    // With a warm start, the iteration starts from the active cylinders and
+    // the tangent point T of the previous wrap of this segment, so that it
+    // converges in a few steps and stays on the same solution as the path
+    // moves. If it does not converge, start again from neither cylinder
+    // being active.
+    const WarmStart* warmStart = nullptr;
+    if (get_warm_start() && isCacheVariableValid(s, _warmStartsCV)) {
+        for (const WarmStart& entry : getCacheVariableValue(s, _warmStartsCV)) {
+            if (entry.pathWrap == &aPathWrap &&
+                    entry.startPoint == aWrapResult.startPoint) {
+                warmStart = &entry;
+                break;
+            }
+        }
+    }
+    if (warmStart) {
+        activeState = warmStart->activeState;
+        SimTK::Vec3::updAs(T) = warmStart->T;
+    }
+    int status = double_cylinder(u,Ru,v,Rv,  VcylObstToUcylObst,  P,q,Q,T,t,vs, &Pq,&qQ,&QT,&Tt,&tS,&L, &activeState, &ru,&rv);
+    if (warmStart && status != 0) {
+        activeState = 0;
+        status = double_cylinder(u,Ru,v,Rv,  VcylObstToUcylObst,  P,q,Q,T,t,vs, &Pq,&qQ,&QT,&Tt,&tS,&L, &activeState, &ru,&rv);
+    }
+    if (get_warm_start() && status == 0) {
+        std::vector<WarmStart>& warmStarts =
+                updCacheVariableValue(s, _warmStartsCV);
+        if (!isCacheVariableValid(s, _warmStartsCV)) {
+            warmStarts.clear();
+            markCacheVariableValid(s, _warmStartsCV);
+        }
+        auto it = std::find_if(warmStarts.begin(), warmStarts.end(),
+                [&](const WarmStart& entry) {
+                    return entry.pathWrap == &aPathWrap &&
+                           entry.startPoint == aWrapResult.startPoint;
+                });
+        if (it == warmStarts.end()) {
+            warmStarts.push_back({&aPathWrap, aWrapResult.startPoint,
+                                  activeState, SimTK::Vec3::getAs(T)});
+        } else {
+            it->activeState = activeState;
+            it->T = SimTK::Vec3::getAs(T);
+        }
+    }
 //  _activeState=activeState;       ???? I CAN'T SEEM TO SET THIS!!!  GARNER - Needs to be Set in a WrapResult variable.
     aWrapResult.c1[0]=activeState+0.01; // Save active state for reference in next iteration
 
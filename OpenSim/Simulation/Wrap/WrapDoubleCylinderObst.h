@@ -75,6 +75,12 @@ public:
     OpenSim_DECLARE_PROPERTY(translationVcyl, SimTK::Vec3, "The translation of the second cylinder.");
     OpenSim_DECLARE_PROPERTY(xyz_body_rotationVcyl, SimTK::Vec3, "The rotation of the second cylinder.");
     OpenSim_DECLARE_PROPERTY(length, double, "The length of the cylinder.");
+    OpenSim_DECLARE_PROPERTY(warm_start, bool,
+        "Start the iteration for the tangent points from the cylinders that "
+        "were active and the tangent point on the second cylinder of the "
+        "previous wrap of the same path segment (if any), instead of from "
+        "neither cylinder being active. The cold start is used whenever the "
+        "warm-started iteration does not converge. Default is false.");
 
 private:
     PhysicalFrame* _wrapVcylHomeBody;
@@ -85,6 +91,19 @@ private:
     int _activeState;
     Model* _model;
 
+    // The solution of the previous wrap of a path segment, from which the
+    // next wrap of the segment starts if warm_start is true.
+    struct WarmStart {
+        const PathWrap* pathWrap;
+        int startPoint;
+        int activeState;
+        SimTK::Vec3 T; // in the V cylinder's obstacle frame
+    };
+    // One entry per path segment that wrapped over this obstacle. Like the
+    // recent wraps of PathWrap, this only depends on the Instance stage, so
+    // that it survives changes to the coordinates.
+    mutable CacheVariable<std::vector<WarmStart>> _warmStartsCV;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -104,6 +123,7 @@ protected:
         const PathWrap& aPathWrap, WrapResult& aWrapResult, bool& aFlag) const override;
 
     void extendFinalizeFromProperties() override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
 
 private:
     void constructProperties();
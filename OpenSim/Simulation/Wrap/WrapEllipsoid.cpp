@@ -49,6 +49,15 @@ static const char* wrapTypeName = "ellipsoid";
 #define N_STEPS               16
 #define SV_BOUNDARY_BLEND     0.3
 
+// Whether points r and c lie on the same side of the line through p and m
+// within the plane with normal vs.
+static bool isOnSameSide(const Vec3& r, const Vec3& c, const Vec3& p,
+                         const Vec3& m, const Vec3& vs)
+{
+    const Vec3 pm = m - p;
+    return (~vs * ((r - p) % pm)) * (~vs * ((c - p) % pm)) > 0.0;
+}
+
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //=============================================================================
@@ -83,6 +92,7 @@ void WrapEllipsoid::constructProperties()
 
     SimTK::Vec3 defaultDimensions = {0.05, 0.05, 0.05};
     constructProperty_dimensions(defaultDimensions);
+    constructProperty_warm_start(false);
 }
 
 //_____________________________________________________________________________
@@ -175,6 +185,21 @@ SimTK::Vec3 WrapEllipsoid::getRadii() const
 //=============================================================================
 // WRAPPING
 //=============================================================================
+//_____________________________________________________________________________
+/**
+ * The segment does not wrap over the ellipsoid if it does not enter the
+ * ellipsoid, whatever the quadrant; the sphere with the largest radius of the
+ * ellipsoid contains the ellipsoid.
+ */
+bool WrapEllipsoid::isSegmentClearOfObject(const SimTK::Vec3& aPoint1,
+        const SimTK::Vec3& aPoint2) const
+{
+    const Vec3& dims = get_dimensions();
+    const double radius = std::max({dims[0], dims[1], dims[2]});
+    return WrapMath::CalcDistanceSquaredLineSegmentToPoint(
+            aPoint1, aPoint2, Vec3(0)) > radius * radius;
+}
+
 //_____________________________________________________________________________
 /**
  * Calculate the wrapping of one line segment over the ellipsoid.
@@ -539,9 +564,41 @@ int WrapEllipsoid::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::
 
     vs4 = - (~vs*aWrapResult.c1);
 
-    // find r1 & r2 by starting at c1 moving toward p1 & p2
-    calcTangentPoint(p1e, aWrapResult.r1, p1, m, a, vs, vs4);
-    calcTangentPoint(p2e, aWrapResult.r2, p2, m, a, vs, vs4);
+    // find r1 & r2 by starting at c1 moving toward p1 & p2. If warm
+    // starting, first try starting at the tangent points of the previous
+    // wrap of this segment (which were transformed to the base frame and
+    // un-normalized). Fall back to the cold start if either search does not
+    // converge or ends up on the other side of the line from p1 (or p2) to
+    // the ellipsoid origin than the cold starting point.
+    {
+        const SimTK::Vec3 r1Cold = aWrapResult.r1;
+        const SimTK::Vec3 r2Cold = aWrapResult.r2;
+        bool warmStarted = false;
+
+        if (get_warm_start() && previousWrap.wrap_pts.getSize() > 0 &&
+                previousWrap.startPoint == aWrapResult.startPoint &&
+                previousWrap.r1.isFinite() && previousWrap.r2.isFinite())
+        {
+            aWrapResult.r1 = _pose.shiftBaseStationToFrame(previousWrap.r1) *
+                             aWrapResult.factor;
+            aWrapResult.r2 = _pose.shiftBaseStationToFrame(previousWrap.r2) *
+                             aWrapResult.factor;
+
+            warmStarted =
+                calcTangentPoint(p1e, aWrapResult.r1, p1, m, a, vs, vs4) &&
+                calcTangentPoint(p2e, aWrapResult.r2, p2, m, a, vs, vs4) &&
+                isOnSameSide(aWrapResult.r1, r1Cold, p1, m, vs) &&
+                isOnSameSide(aWrapResult.r2, r2Cold, p2, m, vs);
+        }
+
+        if (!warmStarted)
+        {
+            aWrapResult.r1 = r1Cold;
+            aWrapResult.r2 = r2Cold;
+            calcTangentPoint(p1e, aWrapResult.r1, p1, m, a, vs, vs4);
+            calcTangentPoint(p2e, aWrapResult.r2, p2, m, a, vs, vs4);
+        }
+    }
 
     // create a series of line segments connecting r1 & r2 along the
     // surface of the ellipsoid.
@@ -610,7 +667,7 @@ calc_wrap_path:
  * @param a Ellipsoid axis
  * @param vs Plane vector
  * @param vs4 Plane coefficient
- * @return '1' if the point was adjusted, '0' otherwise
+ * @return '1' if the search converged to a tangent point, '0' otherwise
  */
 int WrapEllipsoid::calcTangentPoint(double p1e, SimTK::Vec3& r1, SimTK::Vec3& p1, SimTK::Vec3& m,
                                                 SimTK::Vec3& a, SimTK::Vec3& vs, double vs4) const
@@ -794,6 +851,9 @@ int WrapEllipsoid::calcTangentPoint(double p1e, SimTK::Vec3& r1, SimTK::Vec3& p1
             ssq = SQR(ee[0]) + SQR(ee[1]) + SQR(ee[2]) + SQR(ee[3]);
             ssqo = ssq;     
         }
+
+        if (ssq > ELLIPSOID_TINY)
+            return 0;
     }   
     return 1;
 
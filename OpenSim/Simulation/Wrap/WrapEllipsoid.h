@@ -48,6 +48,12 @@ public:
 //=============================================================================
     OpenSim_DECLARE_PROPERTY(dimensions, SimTK::Vec3,
                              "The length of the radii of the ellipsoid.");
+    OpenSim_DECLARE_PROPERTY(warm_start, bool,
+        "Start the search for the tangent points from those of the previous "
+        "wrap of the same path segment (if any), instead of from the point "
+        "on the ellipsoid closest to the wrapping plane. The cold start is "
+        "used whenever the warm-started search does not converge to a "
+        "tangent point on the wrapping side. Default is false.");
 
 //=============================================================================
 // METHODS
@@ -67,6 +73,8 @@ public:
 protected:
     int wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::Vec3& aPoint2,
         const PathWrap& aPathWrap, WrapResult& aWrapResult, bool& aFlag) const override;
+    bool isSegmentClearOfObject(const SimTK::Vec3& aPoint1,
+            const SimTK::Vec3& aPoint2) const override;
 
     /// Implement generateDecorations to draw geometry in visualizer
     void generateDecorations(bool fixed, const ModelDisplayHints& hints, const SimTK::State& state,
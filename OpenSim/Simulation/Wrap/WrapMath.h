@@ -30,6 +30,7 @@
 #include <OpenSim/Simulation/osimSimulationDLL.h>
 #include "SimTKcommon/SmallMatrix.h"
 #include "SimTKcommon/internal/UnitVec.h"
+#include <algorithm>
 
 namespace OpenSim { 
 
@@ -68,6 +69,18 @@ public:
         SimTK::Vec3 n = line.normalize();
         return (pToLinePt - (~pToLinePt * n) * n).normSqr();
     };
+    /** The squared distance from `point` to the closest point of the line
+     * segment from `segStart` to `segEnd`. */
+    inline static double CalcDistanceSquaredLineSegmentToPoint(
+            const SimTK::Vec3& segStart, const SimTK::Vec3& segEnd,
+            const SimTK::Vec3& point) {
+        const SimTK::Vec3 seg = segEnd - segStart;
+        const SimTK::Vec3 toPoint = point - segStart;
+        const double lengthSqr = seg.normSqr();
+        double t = lengthSqr > 0 ? (~toPoint * seg) / lengthSqr : 0;
+        t = std::max(0.0, std::min(1.0, t));
+        return (toPoint - t * seg).normSqr();
+    }
     /**
      * Normalize a vector or Zero it out if norm < Epsilon.
      *
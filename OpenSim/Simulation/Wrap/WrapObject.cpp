@@ -25,6 +25,7 @@
 // INCLUDES
 //=============================================================================
 #include "WrapObject.h"
+#include "PathWrap.h"
 #include "WrapResult.h"
 #include <OpenSim/Simulation/Model/PathPoint.h>
 #include <OpenSim/Simulation/Model/PhysicalFrame.h>
@@ -166,6 +167,17 @@ int WrapObject::wrapPathSegment(const SimTK::State& s,
     pt1 = _pose.shiftBaseStationToFrame(pt1);
     pt2 = _pose.shiftBaseStationToFrame(pt2);
 
+    // Skip segments that cannot touch this object.
+    if (isSegmentClearOfObject(pt1, pt2))
+        return noWrap;
+
+    // Reuse the result if this segment was wrapped recently at the same
+    // location relative to this object.
+    if (aPathWrap.findRecentWrap(s, pt1, pt2, aWrapResult, return_code))
+        return return_code;
+    const Vec3 key1 = pt1;
+    const Vec3 key2 = pt2;
+
     return_code = wrapLine(s, pt1, pt2, aPathWrap, aWrapResult, p_flag);
 
    if (p_flag == true && return_code > 0) {
@@ -180,6 +192,7 @@ int WrapObject::wrapPathSegment(const SimTK::State& s,
             aWrapResult.wrap_pts.updElt(i) = _pose.shiftFrameStationToBase(aWrapResult.wrap_pts.get(i));
    }
 
+   aPathWrap.addRecentWrap(s, key1, key2, aWrapResult, return_code);
    return return_code;
 }
 
@@ -137,6 +137,20 @@ protected:
                          const PathWrap& aPathWrap,
                          WrapResult& aWrapResult, bool& aFlag) const = 0;
 
+    /**
+     * A cheap test, done by wrapPathSegment() before wrapLine(), of whether
+     * the line segment from `aPoint1` to `aPoint2` (in the frame of this
+     * object) is so far from the object that wrapLine() would return noWrap
+     * (and not insideRadius). Return false if unsure, in which case
+     * wrapLine() decides. This test lets paths skip the many wrap objects
+     * that they do not touch most of the time. By default, the segment is
+     * never skipped.
+     */
+    virtual bool isSegmentClearOfObject(const SimTK::Vec3& aPoint1,
+            const SimTK::Vec3& aPoint2) const {
+        return false;
+    }
+
     /**
      * Compute the transform of the wrap geomerty w.r.t. the mobilized body 
      * it is attached to.
@@ -150,6 +150,18 @@ double WrapSphere::getRadius() const
 //=============================================================================
 // WRAPPING
 //=============================================================================
+//_____________________________________________________________________________
+/**
+ * The segment does not wrap over the sphere if it does not enter the sphere,
+ * whatever the quadrant.
+ */
+bool WrapSphere::isSegmentClearOfObject(const SimTK::Vec3& aPoint1,
+        const SimTK::Vec3& aPoint2) const
+{
+    return WrapMath::CalcDistanceSquaredLineSegmentToPoint(
+            aPoint1, aPoint2, Vec3(0)) > get_radius() * get_radius();
+}
+
 //_____________________________________________________________________________
 /**
  * Calculate the wrapping of one line segment over the sphere.
@@ -70,6 +70,8 @@ public:
 protected:
     int wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::Vec3& aPoint2,
         const PathWrap& aPathWrap, WrapResult& aWrapResult, bool& aFlag) const override;
+    bool isSegmentClearOfObject(const SimTK::Vec3& aPoint1,
+            const SimTK::Vec3& aPoint2) const override;
 
     /// Implement generateDecorations to draw geometry in visualizer
     void generateDecorations(bool fixed, const ModelDisplayHints& hints, const SimTK::State& state,
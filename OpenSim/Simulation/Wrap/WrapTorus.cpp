@@ -300,10 +300,13 @@ int WrapTorus::findClosestPoint(double radius, double p1[], double p2[],
 
    q[0] = 0.0;
 
-   lmdif_C(calcCircleResids, numResid, numQs, q, resid,
-           ftol, xtol, gtol, max_iter, epsfcn, diag, mode, step_factor,
-           nprint, &info, &num_func_calls, fjac, ldfjac, ipvt, qtf,
-           wa1, wa2, wa3, wa4, (void*)&cb);
+   if (!findCircleResidRoot(cb, q[0])) {
+      q[0] = 0.0;
+      lmdif_C(calcCircleResids, numResid, numQs, q, resid,
+              ftol, xtol, gtol, max_iter, epsfcn, diag, mode, step_factor,
+              nprint, &info, &num_func_calls, fjac, ldfjac, ipvt, qtf,
+              wa1, wa2, wa3, wa4, (void*)&cb);
+   }
 
    u = q[0];
 
@@ -335,10 +338,13 @@ int WrapTorus::findClosestPoint(double radius, double p1[], double p2[],
 
    q[0] = 0.0;
 
-   lmdif_C(calcCircleResids, numResid, numQs, q, resid,
-           ftol, xtol, gtol, max_iter, epsfcn, diag, mode, step_factor,
-           nprint, &info, &num_func_calls, fjac, ldfjac, ipvt, qtf,
-           wa1, wa2, wa3, wa4, (void*)&cb);
+   if (!findCircleResidRoot(cb, q[0])) {
+      q[0] = 0.0;
+      lmdif_C(calcCircleResids, numResid, numQs, q, resid,
+              ftol, xtol, gtol, max_iter, epsfcn, diag, mode, step_factor,
+              nprint, &info, &num_func_calls, fjac, ldfjac, ipvt, qtf,
+              wa1, wa2, wa3, wa4, (void*)&cb);
+   }
 
    u = q[0];
 
@@ -414,6 +420,87 @@ int WrapTorus::findClosestPoint(double radius, double p1[], double p2[],
    return 1;
 }
 
+//_____________________________________________________________________________
+/**
+ * Find the root of the residual of calcCircleResids() that is reached from
+ * u = 0 with Newton's method. The derivative of the residual is analytic:
+ * with c3, c4, and c5 as in calcCircleResids(), it is
+ * 2 - 4 r (c4 c5 - c3^2) / (u^2 c4 + 2 c3 u + c5)^(3/2). Each step is halved
+ * until it decreases the magnitude of the residual, so that, like the
+ * Levenberg-Marquardt search that findClosestPoint() falls back to, the
+ * iteration descends to the root in the basin of u = 0. This typically
+ * converges in a few iterations, whereas lmdif_C() estimates the derivative
+ * with finite differences and takes many more evaluations.
+ *
+ * @param cb The current point and circle radius
+ * @param u The root (output); the distance from cb.p1 along the line
+ * @return false if the iteration does not converge
+ */
+bool WrapTorus::findCircleResidRoot(const CircleCallback& cb, double& u)
+{
+   const double mag = sqrt((cb.p2[0]-cb.p1[0])*(cb.p2[0]-cb.p1[0]) +
+         (cb.p2[1]-cb.p1[1])*(cb.p2[1]-cb.p1[1]) +
+         (cb.p2[2]-cb.p1[2])*(cb.p2[2]-cb.p1[2]));
+   if (!(mag > 0.0))
+      return false;
+   const double nx = (cb.p2[0]-cb.p1[0]) / mag;
+   const double ny = (cb.p2[1]-cb.p1[1]) / mag;
+   const double nz = (cb.p2[2]-cb.p1[2]) / mag;
+   const double c2 = 2.0 * (cb.p1[0]*nx + cb.p1[1]*ny + cb.p1[2]*nz);
+   const double c3 = cb.p1[0]*nx + cb.p1[1]*ny;
+   const double c4 = nx*nx + ny*ny;
+   const double c5 = cb.p1[0]*cb.p1[0] + cb.p1[1]*cb.p1[1];
+   const double c6 = c4 * c5 - c3 * c3;
+   // The residual and its derivative; false where the line is on the axis
+   // of the circle, where the residual is not defined.
+   auto evaluate = [&](double x, double& resid, double& deriv) {
+      const double rho2 = x * x * c4 + 2.0 * c3 * x + c5;
+      if (!(rho2 > 0.0))
+         return false;
+      const double rho = sqrt(rho2);
+      resid = c2 + 2.0 * x - 2.0 * cb.r * (2.0 * c4 * x + 2.0 * c3) / rho;
+      deriv = 2.0 - 4.0 * cb.r * c6 / (rho2 * rho);
+      return true;
+   };
+
+   const int maxIter = 50;
+   const double tol = 1e-12 * (1.0 + mag + cb.r);
+   double x = 0.0, resid, deriv;
+   if (!evaluate(x, resid, deriv))
+      return false;
+   for (int iter = 0; iter < maxIter; ++iter) {
+      if (fabs(deriv) < SimTK::Eps)
+         return false;
+      double step = -resid / deriv;
+      double xNew, residNew, derivNew;
+      bool decreased = false;
+      for (int halving = 0; halving < 30; ++halving) {
+         xNew = x + step;
+         if (evaluate(xNew, residNew, derivNew) &&
+               fabs(residNew) < fabs(resid)) {
+            decreased = true;
+            break;
+         }
+         step *= 0.5;
+      }
+      if (!decreased) {
+         // The residual cannot be decreased further.
+         if (fabs(resid) > tol)
+            return false;
+         u = x;
+         return true;
+      }
+      x = xNew;
+      resid = residNew;
+      deriv = derivNew;
+      if (fabs(step) <= tol || fabs(resid) <= tol) {
+         u = x;
+         return true;
+      }
+   }
+   return false;
+}
+
 //_____________________________________________________________________________
 /**
  * A utility function used by findClosestPoint. The single residual that it
@@ -92,6 +92,7 @@ private:
         int wrap_sign, int wrap_axis) const;
     static void calcCircleResids(int numResid, int numQs, double q[],
         double resid[], int *flag2, void *ptr);
+    static bool findCircleResidRoot(const CircleCallback& cb, double& u);
 
 //=============================================================================
 };  // END of class WrapTorus
@@ -42,6 +42,7 @@
 #include "Model/ElasticFoundationForce.h"
 #include "Model/HuntCrossleyForce.h"
 #include "Model/SmoothSphereHalfSpaceForce.h"
+#include "Model/SmoothSphereHalfSpaceForceGroup.h"
 #include "Model/Ligament.h"
 #include "Model/Blankevoort1991Ligament.h"
 #include "Model/JointSet.h"
@@ -74,12 +75,15 @@
 #include "Model/Ground.h"
 
 #include "Manager/Manager.h"
+#include "Manager/BatchManager.h"
 
 #include "Control/ControlSet.h"
 #include "Control/ControlSetController.h"
 #include "Control/ControlConstant.h"
 #include "Control/ControlLinear.h"
 #include "Control/PrescribedController.h"
+#include "Control/ExternalController.h"
+#include "Control/TaskSpaceController.h"
 #include "Wrap/PathWrap.h"
 #include "Wrap/PathWrapSet.h"
 #include "Wrap/WrapCylinder.h"
@@ -129,7 +133,10 @@
 #include "PositionMotion.h"
 #include "OpenSense/OpenSenseUtilities.h"
 #include "OpenSense/IMU.h"
+#include "OpenSense/StreamingIMUInverseKinematics.h"
 #include "SimulationUtilities.h"
+#include "ModelPool.h"
+#include "VectorizedEnvironment.h"
 
 #include "RegisterTypes_osimSimulation.h"   // to expose RegisterTypes_osimSimulation
 
@@ -220,10 +220,45 @@ void testJacobians3() {
     (void)J; // keep compiler from complaining
 }
 
+void testJacobianDerivWrtPosition() {
+    using namespace SimTK;
+
+    double d = 0.2;
+    Vec3 q(0.5, 0.5, 0.5);
+    Vec3 qDot(0.1, 0.2, 0.3);
+
+    // The derivative with respect to each DOF matches central differences of
+    // the Jacobian, and the time derivative is their combination.
+    const double h = 1e-6;
+    Mat63 JdotFromPosition(0);
+    for (int i = 0; i < 3; ++i) {
+        Vec3 qPlus = q;
+        Vec3 qMinus = q;
+        qPlus(i) += h;
+        qMinus(i) -= h;
+        const Mat63 expected =
+                (ConstantCurvatureJoint::getConstantCurveJacobian(qPlus, d) -
+                        ConstantCurvatureJoint::getConstantCurveJacobian(
+                                qMinus, d)) /
+                (2 * h);
+        const Mat63 dJ = ConstantCurvatureJoint::
+                getConstantCurveJacobianDerivWrtPosition(q, d, i);
+        ASSERT((dJ - expected).norm() < 1e-7, __FILE__, __LINE__,
+                "Jacobian deriv wrt position didn't match finite differences");
+        JdotFromPosition += qDot(i) * dJ;
+    }
+    const Mat63 Jdot =
+            ConstantCurvatureJoint::getConstantCurveJacobianDerivWrtTime(
+                    q, qDot, d);
+    ASSERT((Jdot - JdotFromPosition).norm() < 1e-12, __FILE__, __LINE__,
+            "Jacobian time deriv didn't match the derivs wrt position");
+}
+
 int main() {
     testJacobians1();
     testJacobians2();
     testJacobians3();
+    testJacobianDerivWrtPosition();
 
     Model model;
     model.setName("spring-stack");
@@ -218,6 +218,62 @@ TEST_CASE("testWrapCylinder") {
     }
 }
 
+TEST_CASE("testWrapObjectsSkipDistantSegments") {
+    // A straight path at height q above wrap objects at the origin wraps
+    // only while it passes through the object; wrapPathSegment() skips the
+    // segment when it is far from the object without changing the length.
+    Model model;
+    auto* body = new OpenSim::Body("body", 1, Vec3(0), Inertia(1));
+    model.addBody(body);
+    auto* slider = new SliderJoint("slider", model.getGround(), Vec3(0),
+            Vec3(0, 0, 0.5 * SimTK::Pi), *body, Vec3(0),
+            Vec3(0, 0, 0.5 * SimTK::Pi));
+    model.addJoint(slider);
+
+    auto* sphere = new WrapSphere();
+    sphere->setName("sphere");
+    sphere->set_radius(0.1);
+    auto* ellipsoid = new WrapEllipsoid();
+    ellipsoid->setName("ellipsoid");
+    ellipsoid->set_dimensions(Vec3(0.1, 0.2, 0.3));
+    auto* cylinder = new WrapCylinder();
+    cylinder->setName("cylinder");
+    cylinder->set_radius(0.1);
+    cylinder->set_length(1.0);
+    // The height of each object above the origin along the path.
+    std::vector<std::pair<WrapObject*, double>> objects{
+            {sphere, 0.1}, {ellipsoid, 0.2}, {cylinder, 0.1}};
+    for (const auto& object : objects) {
+        model.updGround().addWrapObject(object.first);
+        auto* spring = new PathSpring(
+                std::string("spring_") + object.first->getName(), 1, 1, 0);
+        spring->updGeometryPath().appendNewPathPoint(
+                "origin", *body, Vec3(-0.5, 0, 0));
+        spring->updGeometryPath().appendNewPathPoint(
+                "insertion", *body, Vec3(0.5, 0, 0));
+        spring->updGeometryPath().addPathWrap(*object.first);
+        model.addForce(spring);
+    }
+
+    SimTK::State& state = model.initSystem();
+    const auto& coord = slider->getCoordinate();
+    for (double q : {0.05, 0.15, 0.25, 0.35, -0.15, -0.35}) {
+        coord.setValue(state, q);
+        model.realizePosition(state);
+        for (const auto& object : objects) {
+            const auto& spring = model.getComponent<PathSpring>(
+                    std::string("forceset/spring_") + object.first->getName());
+            INFO(object.first->getName() << " at q = " << q);
+            if (std::abs(q) < object.second) {
+                CHECK(spring.getLength(state) > 1.0 + 1e-6);
+            } else {
+                CHECK_THAT(spring.getLength(state),
+                        Catch::WithinAbs(1.0, 1e-12));
+            }
+        }
+    }
+}
+
 TEST_CASE("testShoulderWrapping") {
     // Test the performance of multiple paths with wrapping in the 
     // upper-extremity.
@@ -341,6 +397,58 @@ TEST_CASE("testMuscleLengths") {
     }
 }
 
+TEST_CASE("testRecentWrapsAreReused") {
+    // Perturbing one coordinate at a time (e.g., for finite differences)
+    // reuses the wrapping results of the path segments that did not move. The
+    // lengths must be the same as those computed without any previous
+    // results.
+    Model model("walk_gait1018_subject01.osim");
+    SimTK::State& state = model.initSystem();
+    const auto& muscles = model.getMuscles();
+    for (const auto& coord : model.getComponentList<Coordinate>()) {
+        const double value = coord.getValue(state);
+        coord.setValue(state, value + 1e-3, false);
+        model.realizePosition(state);
+
+        Model fresh("walk_gait1018_subject01.osim");
+        SimTK::State freshState = fresh.initSystem();
+        freshState.updQ() = state.getQ();
+        fresh.realizePosition(freshState);
+        for (int i = 0; i < muscles.getSize(); ++i) {
+            CHECK_THAT(muscles[i].getLength(state),
+                    Catch::WithinAbs(
+                            fresh.getMuscles()[i].getLength(freshState),
+                            1e-12));
+        }
+        coord.setValue(state, value, false);
+    }
+}
+
+TEST_CASE("testWrapEllipsoidWarmStart") {
+    // Starting the tangent point search from the previous wrap must give the
+    // same muscle lengths (within the solver tolerance) as the cold start.
+    Model cold("TestShoulderWrapping.osim");
+    Model warm("TestShoulderWrapping.osim");
+    for (auto& ellipsoid : warm.updComponentList<WrapEllipsoid>()) {
+        ellipsoid.set_warm_start(true);
+    }
+    SimTK::State& coldState = cold.initSystem();
+    SimTK::State& warmState = warm.initSystem();
+    const auto& coldMuscles = cold.getMuscles();
+    const auto& warmMuscles = warm.getMuscles();
+    const auto& coldCoord = cold.getCoordinateSet().get("shoulder_elv");
+    const auto& warmCoord = warm.getCoordinateSet().get("shoulder_elv");
+    for (double angle = 0; angle <= 1.5; angle += 0.05) {
+        coldCoord.setValue(coldState, angle);
+        warmCoord.setValue(warmState, angle);
+        for (int i = 0; i < coldMuscles.getSize(); ++i) {
+            CHECK_THAT(warmMuscles[i].getLength(warmState),
+                    Catch::WithinAbs(
+                            coldMuscles[i].getLength(coldState), 1e-5));
+        }
+    }
+}
+
 TEST_CASE("testFunctionBasedPath") {
     
     const double q_x = 0.12;
@@ -33,6 +33,9 @@
 #include "CMC_TaskSet.h"
 #include <SimTKlapack.h>
 #include "StateTrackingTask.h"
+#include <OpenSim/Common/CommonUtilities.h>
+
+#include <algorithm>
 
 using namespace std;
 using namespace OpenSim;
@@ -65,7 +68,8 @@ ActuatorForceTarget::~ActuatorForceTarget()
  * @param aController Parent controller.
  */
 ActuatorForceTarget::ActuatorForceTarget(int aNX,CMC *aController) :
-    OptimizationTarget(aNX), _controller(aController), _stressTermWeight(1.0)
+    OptimizationTarget(aNX), _controller(aController), _stressTermWeight(1.0),
+    _numThreads(1)
 {
     // NUMBER OF CONTROLS
     if(getNumParameters()<=0) {
@@ -133,7 +137,7 @@ prepareToOptimize(SimTK::State& s, double *x)
     _forcePerformanceMatrix.resize(nf,nf);
     _forcePerformanceVector.resize(nf);
 
-    Vector f(nf), accelVec(nacc), forceVec(nf);
+    Vector f(nf);
 
     // Build matrices and vectors assuming performance is a linear least squares problem.
     // i.e. assume we're solving
@@ -141,14 +145,22 @@ prepareToOptimize(SimTK::State& s, double *x)
     f = 0;
     computePerformanceVectors(s, f, _accelPerformanceVector, _forcePerformanceVector);
 
-
-    for(int j=0; j<nf; j++) {
-        f[j] = 1;
-        computePerformanceVectors(s, f, accelVec, forceVec);
-        for(int i=0; i<nacc; i++) _accelPerformanceMatrix(i,j) = (accelVec[i] - _accelPerformanceVector[i]);
-        for(int i=0; i<nf; i++) _forcePerformanceMatrix(i,j) = (forceVec[i] - _forcePerformanceVector[i]);
-        f[j] = 0;
-    }
+    // The columns are independent: each realizes the model with a unit force
+    // of one actuator. Additional threads use their own copies of the state.
+    const int numThreads = std::min(getNumThreadsOrDefault(_numThreads), nf);
+    _threadStates.resize(std::max(numThreads - 1, 0));
+    for(auto& threadState : _threadStates) threadState = s;
+    parallelForChunks(nf, numThreads, [&](int chunk, int begin, int end) {
+        SimTK::State& state = chunk == 0 ? s : _threadStates[chunk - 1];
+        Vector unitF(nf, 0.0), accelVec(nacc), forceVec(nf);
+        for(int j=begin; j<end; j++) {
+            unitF[j] = 1;
+            computePerformanceVectors(state, unitF, accelVec, forceVec);
+            for(int i=0; i<nacc; i++) _accelPerformanceMatrix(i,j) = (accelVec[i] - _accelPerformanceVector[i]);
+            for(int i=0; i<nf; i++) _forcePerformanceMatrix(i,j) = (forceVec[i] - _forcePerformanceVector[i]);
+            unitF[j] = 0;
+        }
+    });
 
 #ifdef USE_LAPACK_DIRECT_SOLVE
     // 
@@ -238,12 +250,6 @@ computePerformanceVectors(SimTK::State& s, const Vector &aF, Vector &rAccelPerfo
 
     _controller->getModel().getMultibodySystem().realize(s, SimTK::Stage::Acceleration );
 
-    CMC_TaskSet& taskSet = _controller->updTaskSet();
-    taskSet.computeAccelerations(s);
-    Array<double> &w = taskSet.getWeights();
-    Array<double> &aDes = taskSet.getDesiredAccelerations();
-    Array<double> &a = taskSet.getAccelerations();
-
     // PERFORMANCE
     double sqrtStressTermWeight = sqrt(_stressTermWeight);
     for(int i=0;i<fSet.getSize();i++) {
@@ -251,8 +257,17 @@ computePerformanceVectors(SimTK::State& s, const Vector &aF, Vector &rAccelPerfo
         rForcePerformanceVector[i] = sqrtStressTermWeight * act->getStress(s);
      }
 
-    int nacc = aDes.getSize();
-    for(int i=0;i<nacc;i++) rAccelPerformanceVector[i] = sqrt(w[i]) * (a[i] - aDes[i]);
+    {
+        std::lock_guard<std::mutex> lock(_taskSetMutex);
+        CMC_TaskSet& taskSet = _controller->updTaskSet();
+        taskSet.computeAccelerations(s);
+        Array<double> &w = taskSet.getWeights();
+        Array<double> &aDes = taskSet.getDesiredAccelerations();
+        Array<double> &a = taskSet.getAccelerations();
+
+        int nacc = aDes.getSize();
+        for(int i=0;i<nacc;i++) rAccelPerformanceVector[i] = sqrt(w[i]) * (a[i] - aDes[i]);
+    }
 
     // reset the actuator control
     for(int i=0;i<fSet.getSize();i++) {
@@ -32,6 +32,9 @@
 #include <OpenSim/Common/Array.h>
 #include <OpenSim/Common/OptimizationTarget.h>
 
+#include <mutex>
+#include <vector>
+
 namespace OpenSim {
 
 class CMC;
@@ -97,6 +100,15 @@ private:
     // Save a (copy) of the state for state tracking purposes
     SimTK::State    _saveState;
 
+    /** Number of threads used to compute the performance matrices. */
+    int _numThreads;
+    /** Copies of the state, one per additional thread, kept between calls
+    to prepareToOptimize() to reuse their storage. */
+    std::vector<SimTK::State> _threadStates;
+    /** Serializes the use of the task set, whose accelerations are stored in
+    the tasks. */
+    std::mutex _taskSetMutex;
+
 //==============================================================================
 // METHODS
 //==============================================================================
@@ -109,6 +121,12 @@ public:
 
 public:
     void setStressTermWeight(double aWeight);
+    /** Set the number of threads used to compute the columns of the
+    performance matrices (one realization of the model per actuator) in
+    prepareToOptimize(). A value of 0 or less uses all available hardware
+    threads. The default is 1. */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
     bool prepareToOptimize(SimTK::State& s, double *x) override;
 
     //--------------------------------------------------------------------------
@@ -118,25 +118,7 @@ prepareToOptimize(SimTK::State& s, double *x)
     // in cases where we're tracking states
     _saveState = s;
 #ifdef USE_LINEAR_CONSTRAINT_MATRIX
-    int nf = _controller->getActuatorSet().getSize();
-    int nc = getNumConstraints();
-
-    _constraintMatrix.resize(nc,nf);
-    _constraintVector.resize(nc);
-
-    Vector f(nf), c(nc);
-
-    // Build linear constraint matrix and constant constraint vector
-    f = 0;
-
-    computeConstraintVector(s, f, _constraintVector);
-
-    for(int j=0; j<nf; j++) {
-        f[j] = 1;
-        computeConstraintVector(s, f, c);
-        _constraintMatrix(j) = (c - _constraintVector);
-        f[j] = 0;
-    }
+    computeConstraintMatrix(s);
 #endif
 
     // use temporary copy of state because computeIsokineticForceAssumingInfinitelyStiffTendon
@@ -329,6 +311,64 @@ computeConstraintVector(SimTK::State& s, const Vector &x,Vector &c) const
     _controller->getModel().getMultibodySystem().realizeModel(s);
 }
 //______________________________________________________________________________
+/**
+ * Compute the linear constraint matrix and constant constraint vector, which
+ * give the constraints as _constraintMatrix * x + _constraintVector.
+ *
+ * Column j of the matrix holds the (weighted) task accelerations induced by a
+ * unit actuation of actuator j. The actuators are overridden once, and the
+ * positions and velocities are realized once; for each column, only the
+ * forces and accelerations are computed again, since the override actuation
+ * invalidates only the Dynamics stage.
+ */
+void ActuatorForceTargetFast::
+computeConstraintMatrix(SimTK::State& s)
+{
+    CMC_TaskSet& taskSet = _controller->updTaskSet();
+    const Set<const Actuator>& fSet = _controller->getActuatorSet();
+    const SimTK::MultibodySystem& system =
+            _controller->getModel().getMultibodySystem();
+    const int nf = fSet.getSize();
+    const int nc = getNumConstraints();
+
+    _constraintMatrix.resize(nc,nf);
+    _constraintVector.resize(nc);
+
+    for(int i=0;i<nf;i++) {
+        auto act = dynamic_cast<const ScalarActuator*>(&fSet[i]);
+        act->overrideActuation(s, true);
+        act->setOverrideActuation(s, 0.0);
+    }
+    system.realize(s, SimTK::Stage::Velocity);
+
+    Array<double> &w = taskSet.getWeights();
+    Array<double> &aDes = taskSet.getDesiredAccelerations();
+    Array<double> &a = taskSet.getAccelerations();
+    const auto computeConstraints = [&](SimTK::Vector& c) {
+        system.realize(s, SimTK::Stage::Acceleration);
+        taskSet.computeAccelerations(s);
+        for(int i=0; i<nc; i++) c[i] = w[i]*(aDes[i]-a[i]);
+    };
+
+    computeConstraints(_constraintVector);
+    Vector c(nc);
+    for(int j=0; j<nf; j++) {
+        auto act = dynamic_cast<const ScalarActuator*>(&fSet[j]);
+        act->setOverrideActuation(s, 1.0);
+        computeConstraints(c);
+        _constraintMatrix(j) = (c - _constraintVector);
+        act->setOverrideActuation(s, 0.0);
+    }
+
+    // reset the actuator control 
+    for(int i=0;i<nf;i++) {
+        auto act = dynamic_cast<const ScalarActuator*>(&fSet[i]);
+        act->overrideActuation(s, false);
+    }
+
+    system.realizeModel(s);
+}
+//______________________________________________________________________________
 /**
  * Compute the gradient of constraint i given x.
  *
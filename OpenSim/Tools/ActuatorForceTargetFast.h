@@ -120,6 +120,7 @@ public:
     CMC* getController() {return (_controller); }
 private:
     void computeConstraintVector(SimTK::State& s, const SimTK::Vector &x, SimTK::Vector &c) const;
+    void computeConstraintMatrix(SimTK::State& s);
 
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 };  // END class ActuatorForceTargetFast
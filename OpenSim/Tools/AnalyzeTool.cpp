@@ -21,8 +21,12 @@
  * -------------------------------------------------------------------------- */
 #include <OpenSim/Common/XMLDocument.h>
 #include "AnalyzeTool.h"
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/GCVSplineSet.h>
+#ifdef WITH_HDF5
+#include <OpenSim/Common/HDF5FileAdapter.h>
+#endif
 
 #include <OpenSim/Simulation/Control/ControlLinear.h>
 #include <OpenSim/Simulation/Control/ControlSet.h>
@@ -35,6 +39,9 @@
 #include <OpenSim/Simulation/Model/PrescribedForce.h>
 #include <OpenSim/Actuators/Thelen2003Muscle.h>
 
+#include <algorithm>
+#include <memory>
+
 using namespace OpenSim;
 using namespace std;
 
@@ -59,6 +66,8 @@ AnalyzeTool::AnalyzeTool() :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
+    _resultsFileName(_resultsFileNameProp.getValueStr()),
     _printResultFiles(true),
     _loadModelAndInput(false)
 {
@@ -79,6 +88,8 @@ AnalyzeTool::AnalyzeTool(const string &aFileName, bool aLoadModelAndInput) :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
+    _resultsFileName(_resultsFileNameProp.getValueStr()),
     _printResultFiles(true),
     _loadModelAndInput(aLoadModelAndInput)
 {
@@ -111,6 +122,8 @@ AnalyzeTool::AnalyzeTool(Model& aModel) :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
+    _resultsFileName(_resultsFileNameProp.getValueStr()),
     _printResultFiles(true),
     _loadModelAndInput(false)
 {
@@ -171,6 +184,8 @@ AnalyzeTool(const AnalyzeTool &aTool) :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
+    _resultsFileName(_resultsFileNameProp.getValueStr()),
     _loadModelAndInput(false)
 {
     setNull();
@@ -191,6 +206,8 @@ setNull()
     _coordinatesFileName = "";
     _speedsFileName = "";
     _lowpassCutoffFrequency = -1.0;
+    _numThreads = 1;
+    _resultsFileName = "";
 
     _statesStore = NULL;
 
@@ -236,6 +253,27 @@ void AnalyzeTool::setupProperties()
     _lowpassCutoffFrequencyProp.setName("lowpass_cutoff_frequency_for_coordinates");
     _propertySet.append( &_lowpassCutoffFrequencyProp );
 
+    comment = "Number of threads used to analyze the time frames. With more than one thread, "
+                 "the frames are split into contiguous blocks that are analyzed concurrently, each with "
+                 "its own copy of the model and analyses, and the results are concatenated in time order. "
+                 "This is only done if the results of all analyses at a frame depend only on the states at "
+                 "that frame (e.g., MuscleAnalysis, BodyKinematics, JointReaction, ForceReporter). "
+                 "A value of 0 or less uses all available hardware threads. Default is 1.";
+    _numThreadsProp.setComment(comment);
+    _numThreadsProp.setName("num_threads");
+    _numThreadsProp.setValue(1);
+    _propertySet.append( &_numThreadsProp );
+
+    comment = "Name of an HDF5 file (.h5), in the results directory, to which the results of all "
+                 "analyses are written as tables named <analysis name>/<result name>, instead of writing "
+                 "a file per result (analyses that do not expose their results still write their own "
+                 "files). Requires that OpenSim was built with HDF5. "
+                 "If empty (the default), each analysis writes its own files.";
+    _resultsFileNameProp.setComment(comment);
+    _resultsFileNameProp.setName("results_file");
+    _resultsFileNameProp.setValue("");
+    _propertySet.append( &_resultsFileNameProp );
+
 }
 
 
@@ -259,6 +297,8 @@ operator=(const AnalyzeTool &aTool)
     _coordinatesFileName = aTool._coordinatesFileName;
     _speedsFileName = aTool._speedsFileName;
     _lowpassCutoffFrequency= aTool._lowpassCutoffFrequency;
+    _numThreads = aTool._numThreads;
+    _resultsFileName = aTool._resultsFileName;
     _statesStore = aTool._statesStore;
     _printResultFiles = aTool._printResultFiles;
     return(*this);
@@ -590,7 +630,22 @@ bool AnalyzeTool::run(bool plotting)
     //}
 
     log_info("Executing the analyses from {} to {}...", ti, tf);
-    run(s, *_model, iInitial, iFinal, *_statesStore, _solveForEquilibriumForAuxiliaryStates);
+    int numThreads = std::min(getNumThreadsOrDefault(_numThreads),
+            iFinal - iInitial + 1);
+    for (int i = 0; i < analysisSet.getSize() && numThreads > 1; ++i) {
+        if (!analysisSet.get(i).getFramesAreIndependent()) {
+            log_warn("Analysis '{}' must analyze the frames in order; using "
+                     "1 thread instead of {}.",
+                    analysisSet.get(i).getName(), numThreads);
+            numThreads = 1;
+        }
+    }
+    if (numThreads > 1 && !plotting) {
+        runInParallel(s, iInitial, iFinal, numThreads);
+    } else {
+        run(s, *_model, iInitial, iFinal, *_statesStore,
+                _solveForEquilibriumForAuxiliaryStates);
+    }
     _model->getMultibodySystem().realize(s, SimTK::Stage::Position );
     } catch (const Exception& x) {
         x.print(cout);
@@ -600,8 +655,12 @@ bool AnalyzeTool::run(bool plotting)
 
     // PRINT RESULTS
     // TODO: give option to write partial results if not completed
-    if (completed && _printResultFiles)
-        printResults(getName(),getResultsDir()); // this will create results directory if necessary
+    if (completed && _printResultFiles) {
+        if (_resultsFileName.empty())
+            printResults(getName(),getResultsDir()); // this will create results directory if necessary
+        else
+            printResultsToFile(_resultsFileName);
+    }
 
     cwd.restore();
 
@@ -613,6 +672,97 @@ bool AnalyzeTool::run(bool plotting)
 //=============================================================================
 // HELPER
 //=============================================================================
+//_____________________________________________________________________________
+/**
+ * Analyze contiguous blocks of the frames iInitial to iFinal concurrently.
+ * The first block is analyzed with the tool's model and analyses; the others
+ * with copies, whose results are then appended in time order.
+ */
+void AnalyzeTool::runInParallel(SimTK::State& s, int iInitial, int iFinal,
+        int numThreads)
+{
+    AnalysisSet& analysisSet = _model->updAnalysisSet();
+
+    // The copies are made here, on the calling thread.
+    std::vector<std::unique_ptr<Model>> models(numThreads);
+    std::vector<SimTK::State*> states(numThreads, &s);
+    for (int t = 1; t < numThreads; ++t) {
+        models[t].reset(_model->clone());
+        models[t]->finalizeFromProperties();
+        for (int i = 0; i < analysisSet.getSize(); ++i) {
+            Analysis* analysis = analysisSet.get(i).clone();
+            analysis->setModel(*models[t]);
+            models[t]->addAnalysis(analysis);
+        }
+        states[t] = &models[t]->initSystem();
+    }
+
+    std::vector<char> analyzed(numThreads, false);
+    parallelForChunks(iFinal - iInitial + 1, numThreads,
+            [&](int chunk, int begin, int end) {
+                Model& model = models[chunk] ? *models[chunk] : *_model;
+                run(*states[chunk], model, iInitial + begin,
+                        iInitial + end - 1, *_statesStore,
+                        _solveForEquilibriumForAuxiliaryStates);
+                analyzed[chunk] = true;
+            });
+
+    for (int t = 1; t < numThreads; ++t) {
+        if (!analyzed[t]) continue;
+        AnalysisSet& copies = models[t]->updAnalysisSet();
+        for (int i = 0; i < analysisSet.getSize(); ++i) {
+            analysisSet.get(i).appendResults(copies.get(i));
+        }
+    }
+}
+
+/**
+ * Write the results of all analyses as tables of one HDF5 file in the
+ * results directory. Analyses without a storage list print their own files.
+ */
+void AnalyzeTool::printResultsToFile(const std::string& aFileName)
+{
+#ifdef WITH_HDF5
+    OPENSIM_THROW_IF_FRMOBJ(!IO::EndsWith(IO::Lowercase(aFileName), ".h5"),
+            Exception,
+            "Expected the results file to have the extension .h5, but got "
+            "'{}'.", aFileName);
+    log_info("Printing results of investigation {} to {}", getName(),
+            getResultsDir() + "/" + aFileName);
+    IO::makeDir(getResultsDir());
+
+    std::vector<std::unique_ptr<TimeSeriesTable>> tables;
+    DataAdapter::InputTables inputTables;
+    AnalysisSet& analysisSet = _model->updAnalysisSet();
+    for (int i = 0; i < analysisSet.getSize(); ++i) {
+        Analysis& analysis = analysisSet.get(i);
+        if (!analysis.getOn() || !analysis.getPrintResultFiles()) continue;
+        ArrayPtrs<Storage>& storages = analysis.getStorageList();
+        if (storages.getSize() == 0) {
+            analysis.printResults(getName(), getResultsDir());
+            continue;
+        }
+        for (int j = 0; j < storages.getSize(); ++j) {
+            if (storages[j] == nullptr) continue;
+            std::string key = analysis.getName() + "/" +
+                    (storages[j]->getName().empty() ? std::to_string(j)
+                                                    : storages[j]->getName());
+            if (inputTables.count(key)) key += "_" + std::to_string(j);
+            tables.emplace_back(new TimeSeriesTable(
+                    storages[j]->exportToTable()));
+            inputTables.emplace(key, tables.back().get());
+        }
+    }
+    if (inputTables.empty()) return;
+    HDF5FileAdapter().writeTables(inputTables,
+            getResultsDir() + "/" + aFileName);
+#else
+    OPENSIM_THROW_FRMOBJ(Exception,
+            "Cannot write the results to '{}': OpenSim was built without "
+            "HDF5 (OPENSIM_WITH_HDF5).", aFileName);
+#endif
+}
+
 void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium)
 {
     AnalysisSet& analysisSet = aModel.updAnalysisSet();
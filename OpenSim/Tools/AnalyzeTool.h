@@ -68,6 +68,13 @@ private:
     /** Low-pass cut-off frequency for filtering the coordinates (does not apply to states). */
     PropertyDbl _lowpassCutoffFrequencyProp;
     double &_lowpassCutoffFrequency;
+    /** Number of threads used to analyze the time frames. */
+    PropertyInt _numThreadsProp;
+    int &_numThreads;
+    /** Name of an HDF5 file to which the results of all analyses are
+    written, instead of a file per result. */
+    PropertyStr _resultsFileNameProp;
+    std::string &_resultsFileName;
 
     /** Storage for the model states. */
     Storage *_statesStore;
@@ -94,6 +101,9 @@ private:
     void setNull();
     void setupProperties();
     void constructCorrectiveSprings();
+    void runInParallel(SimTK::State& s, int iInitial, int iFinal,
+            int numThreads);
+    void printResultsToFile(const std::string& aFileName);
 
     //--------------------------------------------------------------------------
     // OPERATORS
@@ -121,6 +131,25 @@ public:
     void setLowpassCutoffFrequency(double aLowpassCutoffFrequency) { _lowpassCutoffFrequency = aLowpassCutoffFrequency; }
     bool getLoadModelAndInput() const { return _loadModelAndInput; }
     void setLoadModelAndInput(bool b) { _loadModelAndInput = b; }
+    /**
+     * get/set the number of threads used to analyze the time frames. A value
+     * of 0 or less uses all available hardware threads.
+     */
+    int getNumThreads() const { return _numThreads; }
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    /**
+     * get/set the name of an HDF5 file (.h5), in the results directory, to
+     * which the results of all the analyses are written as the tables
+     * "<analysis name>/<result name>" (see HDF5FileAdapter), instead of
+     * writing a file per result. Analyses that do not expose their results
+     * with Analysis::getStorageList() still write their own files. If empty
+     * (the default), each analysis writes its own files. Writing to an HDF5
+     * file requires that OpenSim was built with HDF5.
+     */
+    const std::string& getResultsFileName() const { return _resultsFileName; }
+    void setResultsFileName(const std::string& aFileName) {
+        _resultsFileName = aFileName;
+    }
 
     //--------------------------------------------------------------------------
     // UTILITIES
@@ -711,8 +711,9 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
 
     int i,j;
 
-    // TURN ANALYSES OFF
-    _model->updAnalysisSet().setOn(false);
+    // The analyses are not turned off here: nothing below performs them, and
+    // the Manager may be performing them on another thread (see
+    // Manager::setPerformAnalysesConcurrently()).
 
     // TIME STUFF
     double tiReal = s.getTime(); 
@@ -957,8 +958,6 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
 
     // SET EXCITATIONS
     controlSet.setControlValues(_tf,&controls[0]);
-
-    _model->updAnalysisSet().setOn(true);
 }
 
 //_____________________________________________________________________________
@@ -1097,10 +1096,10 @@ void CMC::computeControls(const SimTK::State& s, SimTK::Vector& controls)  const
     SimTK_ASSERT( _controlSet.getSize() == getActuatorSet().getSize() , 
         "CMC::computeControls number of controls does not match number of actuators.");
     
-    SimTK::Vector actControls(1, 0.0);
     for(int i=0; i<getActuatorSet().getSize(); i++){
-        actControls[0] = _controlSet[_controlSetIndices[i]].getControlValue(s.getTime());
-        getActuatorSet()[i].addInControls(actControls, controls);
+        addInControl(i,
+                _controlSet[_controlSetIndices[i]].getControlValue(s.getTime()),
+                controls);
     }
 
     // double *val = &controls[0];
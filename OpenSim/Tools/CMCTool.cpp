@@ -76,7 +76,8 @@ CMCTool::CMCTool() :
     _optimizationConvergenceTolerance(_optimizationConvergenceToleranceProp.getValueDbl()),
     _maxIterations(_maxIterationsProp.getValueInt()),
     _printLevel(_printLevelProp.getValueInt()),
-    _verbose(_verboseProp.getValueBool())
+    _verbose(_verboseProp.getValueBool()),
+    _useConcurrentAnalyses(_useConcurrentAnalysesProp.getValueBool())
 {
     setNull();
 }
@@ -106,7 +107,8 @@ CMCTool::CMCTool(const string &aFileName, bool aLoadModel) :
     _optimizationConvergenceTolerance(_optimizationConvergenceToleranceProp.getValueDbl()),
     _maxIterations(_maxIterationsProp.getValueInt()),
     _printLevel(_printLevelProp.getValueInt()),
-    _verbose(_verboseProp.getValueBool())
+    _verbose(_verboseProp.getValueBool()),
+    _useConcurrentAnalyses(_useConcurrentAnalysesProp.getValueBool())
 {
     setNull();
     updateFromXMLDocument();
@@ -176,7 +178,8 @@ CMCTool(const CMCTool &aTool) :
     _optimizationConvergenceTolerance(_optimizationConvergenceToleranceProp.getValueDbl()),
     _maxIterations(_maxIterationsProp.getValueInt()),
     _printLevel(_printLevelProp.getValueInt()),
-    _verbose(_verboseProp.getValueBool())
+    _verbose(_verboseProp.getValueBool()),
+    _useConcurrentAnalyses(_useConcurrentAnalysesProp.getValueBool())
 {
     setNull();
     *this = aTool;
@@ -209,6 +212,7 @@ setNull()
     _maxIterations = 1000;
     _printLevel = 0;
     _verbose = false;
+    _useConcurrentAnalyses = false;
 
     _replaceForceSet = false;   // default should be false for Forward.
     _solveForEquilibriumForAuxiliaryStates = true;
@@ -328,6 +332,14 @@ void CMCTool::setupProperties()
     _verboseProp.setName("use_verbose_printing");
     _propertySet.append( &_verboseProp );
 
+    comment = "True-false flag indicating whether or not to perform the "
+              "analyses on a separate thread, while the controller computes "
+              "the controls of the next time window. The analyses must not "
+              "modify the model.";
+    _useConcurrentAnalysesProp.setComment(comment);
+    _useConcurrentAnalysesProp.setName("use_concurrent_analyses");
+    _propertySet.append( &_useConcurrentAnalysesProp );
+
 }
 
 
@@ -366,6 +378,7 @@ operator=(const CMCTool &aTool)
     _maxIterations = aTool._maxIterations;
     _printLevel = aTool._printLevel;
     _verbose = aTool._verbose;
+    _useConcurrentAnalyses = aTool._useConcurrentAnalyses;
 
     return(*this);
 }
@@ -747,6 +760,7 @@ bool CMCTool::run()
     manager.setIntegratorMaximumStepSize(_maxDT);
     manager.setIntegratorMinimumStepSize(_minDT);
     manager.setIntegratorAccuracy(_errorTolerance);
+    manager.setPerformAnalysesConcurrently(_useConcurrentAnalyses);
     
     _model->setAllControllersEnabled( true );
 
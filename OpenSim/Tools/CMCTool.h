@@ -122,6 +122,11 @@ private:
     /** Flag for turning on and off verbose printing. */
     PropertyBool _verboseProp;
     bool &_verbose;
+    /** Flag indicating whether to perform the analyses on a separate thread,
+    overlapping with the optimizations of the controller (see
+    Manager::setPerformAnalysesConcurrently()). */
+    PropertyBool _useConcurrentAnalysesProp;
+    bool &_useConcurrentAnalyses;
 
     ForceSet _originalForceSet;
 
@@ -196,6 +201,11 @@ public:
     bool getUseVerbosePrinting() const {return _verbose;};
     void setUseVerbosePrinting(bool verbose) const { _verbose=verbose;};
 
+    // Concurrent analyses
+    bool getUseConcurrentAnalyses() const { return _useConcurrentAnalyses; }
+    void setUseConcurrentAnalyses(bool useConcurrentAnalyses)
+    { _useConcurrentAnalyses = useConcurrentAnalyses; }
+
 
     //--------------------------------------------------------------------------
     // INTERFACE
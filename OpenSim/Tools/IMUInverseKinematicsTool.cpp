@@ -11,7 +11,9 @@
 #include <OpenSim/Simulation/Model/PhysicalOffsetFrame.h>
 #include <OpenSim/Simulation/InverseKinematicsSolver.h>
 #include <OpenSim/Simulation/OrientationsReference.h>
+#include <OpenSim/Common/CommonUtilities.h>
 
+#include <mutex>
 
 using namespace OpenSim;
 using namespace SimTK;
@@ -40,6 +42,7 @@ void IMUInverseKinematicsTool::constructProperties()
     constructProperty_orientations_file("");
     OrientationWeightSet orientationWeights;
     constructProperty_orientation_weights(orientationWeights);
+    constructProperty_num_threads(1);
 }
 /**
 void IMUInverseKinematicsTool::
@@ -94,6 +97,34 @@ void IMUInverseKinematicsTool::
 void IMUInverseKinematicsTool::runInverseKinematicsWithOrientationsFromFile(
         Model& model, const std::string& orientationsFileName,
         bool visualizeResults) {
+    solveOrientationsFile(model, orientationsFileName, visualizeResults,
+            get_output_motion_file(), get_num_threads());
+}
+
+void IMUInverseKinematicsTool::runInverseKinematicsWithOrientationsFromFiles(
+        const Model& model,
+        const std::vector<std::string>& orientationsFileNames) const {
+    const int numFiles = (int)orientationsFileNames.size();
+    log_info("Solving {} orientations files on up to {} threads.", numFiles,
+            std::min(getNumThreadsOrDefault(get_num_threads()), numFiles));
+    // Each trial is solved (on one thread) with its own copy of the model;
+    // the copies are made one at a time since cloning reads the model.
+    std::mutex cloneMutex;
+    parallelForEach(numFiles, get_num_threads(),
+            [&](int /*thread*/, int i) {
+        std::unique_ptr<Model> trialModel;
+        {
+            std::lock_guard<std::mutex> lock(cloneMutex);
+            trialModel.reset(model.clone());
+        }
+        solveOrientationsFile(*trialModel, orientationsFileNames[i], false,
+                "", 1);
+    });
+}
+
+void IMUInverseKinematicsTool::solveOrientationsFile(Model& model,
+        const std::string& orientationsFileName, bool visualizeResults,
+        const std::string& outputMotionFile, int numThreads) const {
 
     // Ideally if we add a Reporter, we also remove it at the end for good hygiene but 
     // at the moment there's no interface to remove Reporter so we'll reuse one if exists
@@ -137,10 +168,8 @@ void IMUInverseKinematicsTool::runInverseKinematicsWithOrientationsFromFile(
             rotations[0], SimTK::XAxis, rotations[1], SimTK::YAxis, 
             rotations[2], SimTK::ZAxis);
 
-    // Rotate data so Y-Axis is up
+    // Rotate data (in place) so Y-Axis is up
     OpenSenseUtilities::rotateOrientationTable(quatTable, sensorToOpenSim);
-    //Trim to time window required by Tool
-    quatTable.trim(getStartTime(), getEndTime());
 
     TimeSeriesTable_<SimTK::Rotation> orientationsData =
         OpenSenseUtilities::convertQuaternionsToRotations(quatTable);
@@ -192,22 +221,84 @@ void IMUInverseKinematicsTool::runInverseKinematicsWithOrientationsFromFile(
         model.getVisualizer().show(s0);
         model.getVisualizer().getSimbodyVisualizer().setShowSimTime(true);
     }
-    int step = 0;
-    for (auto time : times) {
-        s0.updTime() = time;
-        ikSolver.track(s0);
-        if (get_report_errors()) {
-            ikSolver.computeCurrentOrientationErrors(orientationErrors);
-            modelOrientationErrors->appendRow(
-                    s0.getTime(), orientationErrors);
+
+    const int nt = (int)times.size();
+    if (!visualizeResults)
+        numThreads = std::min(getNumThreadsOrDefault(numThreads), nt);
+    if (!visualizeResults && numThreads > 1) {
+        log_info("Solving {} frames in {} segments on separate threads.",
+                nt, numThreads);
+
+        // Each segment is solved with its own model, state, and solver,
+        // which are created here so that the model and the reference are
+        // only read by this thread.
+        struct Segment {
+            std::unique_ptr<Model> model;
+            std::unique_ptr<InverseKinematicsSolver> solver;
+            SimTK::State* state = nullptr;
+        };
+        std::vector<Segment> segments(numThreads);
+        for (auto& segment : segments) {
+            segment.model.reset(model.clone());
+            // All frames are reported on the original model.
+            segment.model->updAnalysisSet().clearAndDestroy();
+            segment.model->finalizeFromProperties();
+            segment.state = &segment.model->initSystem();
+            segment.solver.reset(new InverseKinematicsSolver(
+                    *segment.model, nullptr,
+                    std::make_shared<OrientationsReference>(oRefs),
+                    coordinateReferences));
+            segment.solver->setAccuracy(accuracy);
+        }
+
+        std::vector<SimTK::Vector> qs(nt);
+        std::vector<SimTK::Array_<double>> errors(
+                get_report_errors() ? nt : 0);
+        parallelForChunks(nt, numThreads,
+                [&](int iseg, int begin, int end) {
+            auto& solver = *segments[iseg].solver;
+            SimTK::State& segState = *segments[iseg].state;
+            segState.updTime() = times[begin];
+            solver.assemble(segState);
+            for (int i = begin; i < end; ++i) {
+                segState.updTime() = times[i];
+                solver.track(segState);
+                qs[i] = segState.getQ();
+                if (get_report_errors()) {
+                    solver.computeCurrentOrientationErrors(errors[i]);
+                }
+            }
+        });
+        log_info("Solved {} frame(s).", nt);
+
+        // Report the frames in order on this thread.
+        for (int i = 0; i < nt; ++i) {
+            s0.updTime() = times[i];
+            s0.updQ() = qs[i];
+            if (get_report_errors()) {
+                modelOrientationErrors->appendRow(times[i], errors[i]);
+            }
+            analysisSet.step(s0, i);
+            model.realizeReport(s0);
+        }
+    } else {
+        int step = 0;
+        for (auto time : times) {
+            s0.updTime() = time;
+            ikSolver.track(s0);
+            if (get_report_errors()) {
+                ikSolver.computeCurrentOrientationErrors(orientationErrors);
+                modelOrientationErrors->appendRow(
+                        s0.getTime(), orientationErrors);
+            }
+            if (visualizeResults)  
+                model.getVisualizer().show(s0);
+            else
+                log_info("Solved at time: {} s", time);
+            // realize to report to get reporter to pull values from model
+            analysisSet.step(s0, step++);
+            model.realizeReport(s0);
         }
-        if (visualizeResults)  
-            model.getVisualizer().show(s0);
-        else
-            log_info("Solved at time: {} s", time);
-        // realize to report to get reporter to pull values from model
-        analysisSet.step(s0, step++);
-        model.realizeReport(s0);
     }
 
     auto report = ikReporter->getTable();
@@ -217,10 +308,13 @@ void IMUInverseKinematicsTool::runInverseKinematicsWithOrientationsFromFile(
         resultsDir = IO::getParentDirectory(get_output_motion_file());
     if (!resultsDir.empty()) {
         IO::makeDir(resultsDir);
-        // directory will be restored on block exit
-        // by changing dir all other files are created in resultsDir
-        auto cwd = IO::CwdChanger::changeTo(resultsDir);
-        std::string outName = get_output_motion_file();
+        // The files are created in resultsDir. Their paths are resolved
+        // rather than changing the working directory, so that
+        // runInverseKinematicsWithOrientationsFromFiles() can write the
+        // results of several trials at once.
+        const std::string absResultsDir =
+                SimTK::Pathname::getAbsoluteDirectoryPathname(resultsDir);
+        std::string outName = outputMotionFile;
         outName = IO::GetFileNameFromURI(outName);
         if (outName.empty()) {
             bool isAbsolutePath;
@@ -239,13 +333,19 @@ void IMUInverseKinematicsTool::runInverseKinematicsWithOrientationsFromFile(
         auto fullOutputFilename = outputFile;
         std::string::size_type extSep = fullOutputFilename.rfind(".");
         if (extSep == std::string::npos) { fullOutputFilename.append(".mot"); }
-        STOFileAdapter_<double>::write(report, fullOutputFilename);
+        STOFileAdapter_<double>::write(report,
+                SimTK::Pathname::
+                        getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                                absResultsDir, fullOutputFilename));
 
         log_info("Wrote IK with IMU tracking results to: '{}'.",
                 fullOutputFilename);
         if (get_report_errors()) {
             STOFileAdapter_<double>::write(*modelOrientationErrors,
-                    outName + "_orientationErrors.sto");
+                    SimTK::Pathname::
+                            getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                                    absResultsDir,
+                                    outName + "_orientationErrors.sto"));
         }
     } 
     else
@@ -44,6 +44,8 @@
 #include <OpenSim/Simulation/OrientationsReference.h>
 #include <OpenSim/Tools/InverseKinematicsToolBase.h>
 
+#include <vector>
+
 namespace OpenSim {
 
 class Model;
@@ -87,6 +89,15 @@ public:
             "Set of orientation weights identified by orientation name with "
             "weight being a positive scalar. If not provided, all IMU "
             "orientations are tracked with weight 1.0.");
+    OpenSim_DECLARE_PROPERTY(num_threads, int,
+            "Number of threads used to solve the frames. With more than one "
+            "thread, the frames are split into contiguous time segments, each "
+            "solved with its own copy of the model; the first frame of each "
+            "segment is assembled from the model's default pose instead of "
+            "being warm-started from the previous frame. When solving several "
+            "orientations files, the files are instead solved concurrently. A "
+            "value of 0 or less uses all available hardware threads. Default "
+            "is 1.");
 
     //=============================================================================
 // METHODS
@@ -112,8 +123,25 @@ public:
     void runInverseKinematicsWithOrientationsFromFile(Model& model,
                             const std::string& quaternionStoFileName, bool visualizeResults=false);
 
+    /** Solve several orientations files (e.g., the trials of a subject) with
+    the same calibrated model (see IMUPlacer), on up to num_threads threads.
+    Each file is solved with its own copy of `model`, and its results are
+    written to the results directory with the name "ik_<file name>", as when
+    no output_motion_file is specified. */
+    void runInverseKinematicsWithOrientationsFromFiles(const Model& model,
+            const std::vector<std::string>& quaternionStoFileNames) const;
+
+    void setNumThreads(int numThreads) { upd_num_threads() = numThreads; }
+    int getNumThreads() const { return get_num_threads(); }
+
 private:
     void constructProperties();
+    /** Solve one orientations file with `model` on `numThreads` threads, and
+    write the results to `outputMotionFile` (or to "ik_<file name>" if it is
+    empty) in the results directory. */
+    void solveOrientationsFile(Model& model,
+            const std::string& quaternionStoFileName, bool visualizeResults,
+            const std::string& outputMotionFile, int numThreads) const;
 
 //=============================================================================
 };  // END of class IMUInverseKinematicsTool
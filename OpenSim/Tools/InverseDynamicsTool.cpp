@@ -26,6 +26,7 @@
 //=============================================================================
 #include "InverseDynamicsTool.h"
 
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/FunctionSet.h>
 #include <OpenSim/Common/GCVSplineSet.h>
@@ -36,6 +37,8 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/SimulationUtilities.h>
 
+#include <algorithm>
+
 using namespace OpenSim;
 using namespace std;
 using namespace SimTK;
@@ -63,7 +66,8 @@ InverseDynamicsTool::InverseDynamicsTool() : DynamicsTool(),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
-    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
+    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
 }
@@ -82,7 +86,8 @@ InverseDynamicsTool::InverseDynamicsTool(const string &aFileName, bool aLoadMode
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
-    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
+    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
     updateFromXMLDocument();
@@ -104,7 +109,8 @@ InverseDynamicsTool::InverseDynamicsTool(const InverseDynamicsTool &aTool) :
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
-    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
+    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
     *this = aTool;
@@ -119,6 +125,7 @@ void InverseDynamicsTool::setNull()
     setupProperties();
     _model = NULL;
     _lowpassCutoffFrequency = -1.0;
+    _numThreads = 1;
     _coordinateValues = NULL;
 }
 //_____________________________________________________________________________
@@ -156,6 +163,15 @@ void InverseDynamicsTool::setupProperties()
     _outputBodyForcesAtJointsFileNameProp.setName("output_body_forces_file");
     _outputBodyForcesAtJointsFileNameProp.setValue("body_forces_at_joints.sto");
     _propertySet.append(&_outputBodyForcesAtJointsFileNameProp);
+
+    _numThreadsProp.setComment("Number of threads used to solve the time "
+        "frames. With more than one thread, the frames are split into "
+        "contiguous blocks that are solved concurrently; this is not done if "
+        "the model has analyses, which must be stepped in order. A value of "
+        "0 or less uses all available hardware threads. Default is 1.");
+    _numThreadsProp.setName("num_threads");
+    _numThreadsProp.setValue(1);
+    _propertySet.append(&_numThreadsProp);
 }
 
 //_____________________________________________________________________________
@@ -187,6 +203,7 @@ operator=(const InverseDynamicsTool &aTool)
     _lowpassCutoffFrequency = aTool._lowpassCutoffFrequency;
     _outputGenForceFileName = aTool._outputGenForceFileName;
     _outputBodyForcesAtJointsFileName = aTool._outputBodyForcesAtJointsFileName;
+    _numThreads = aTool._numThreads;
     _coordinateValues = NULL;
 
     return(*this);
@@ -421,8 +438,29 @@ bool InverseDynamicsTool::run()
 
         // solve for the trajectory of generalized forces that correspond to the 
         // coordinate trajectories provided
-        ivdSolver.solve(s, coordFunctions, coordinatesToSpeedsIndexMap, times,
-                genForceTraj);
+        const int numThreads =
+                std::min(getNumThreadsOrDefault(_numThreads), nt);
+        if (numThreads > 1 && _model->getAnalysisSet().getSize() == 0) {
+            std::vector<std::string> columnLabels(nCoords);
+            for (int i = 0; i < nCoords; ++i) {
+                columnLabels[i] = coords[i]->getName();
+            }
+            TimeSeriesTable genForceTable(
+                    std::vector<double>(times.begin(), times.end()),
+                    Matrix(nt, nCoords, 0.0), columnLabels);
+            ivdSolver.solve(s, coordFunctions, coordinatesToSpeedsIndexMap,
+                    genForceTable, numThreads);
+            for (int i = 0; i < nt; ++i) {
+                genForceTraj[i] = ~genForceTable.getRowAtIndex(i);
+            }
+        } else {
+            if (numThreads > 1) {
+                log_info("InverseDynamicsTool: the model has analyses, so "
+                         "the time frames are solved on a single thread.");
+            }
+            ivdSolver.solve(s, coordFunctions, coordinatesToSpeedsIndexMap,
+                    times, genForceTraj);
+        }
         success = true;
 
         log_info("InverseDynamicsTool: {} time frames in {}.", nt, 
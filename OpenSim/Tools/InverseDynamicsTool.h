@@ -88,6 +88,10 @@ protected:
     PropertyStr _outputBodyForcesAtJointsFileNameProp;
     std::string &_outputBodyForcesAtJointsFileName;
 
+    /** Number of threads used to solve the time frames */
+    PropertyInt _numThreadsProp;
+    int &_numThreads;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -156,6 +160,12 @@ public:
     void setLowpassCutoffFrequency(double aFrequency) {
         _lowpassCutoffFrequency = aFrequency;
     }
+    /**
+     * get/set the number of threads used to solve the time frames. A value of
+     * 0 or less uses all available hardware threads.
+     */
+    int getNumThreads() const { return _numThreads; }
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
     //--------------------------------------------------------------------------
     // INTERFACE
     //--------------------------------------------------------------------------
@@ -30,6 +30,7 @@
 #include "IKTaskSet.h"
 
 #include <OpenSim/Analyses/Kinematics.h>
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/FunctionSet.h>
 #include <OpenSim/Common/GCVSplineSet.h>
@@ -86,6 +87,8 @@ void InverseKinematicsTool::constructProperties()
     constructProperty_marker_file("");
     constructProperty_coordinate_file("");
     constructProperty_report_marker_locations(false);
+    constructProperty_num_threads(1);
+    constructProperty_use_least_squares_tracking(false);
 }
 
 //=============================================================================
@@ -93,6 +96,33 @@ void InverseKinematicsTool::constructProperties()
 //=============================================================================
 
 
+namespace {
+    // The name of the trial of a marker file, which is the name of the file
+    // without its directory and extension.
+    std::string getTrialName(const std::string& markerFile) {
+        std::string name = IO::GetFileNameFromURI(markerFile);
+        const auto dot = name.rfind('.');
+        if (dot != std::string::npos && dot > 0) name.erase(dot);
+        return name;
+    }
+}
+
+// The solvers of the trials of runTrials(), which are created for the first
+// trial and given the marker data of each of the following trials.
+struct InverseKinematicsTool::TrialSolvers {
+    SimTK::Array_<CoordinateReference> coordinateReferences;
+    std::unique_ptr<InverseKinematicsSolver> solver;
+    // The frames of a trial solved on multiple threads are split into
+    // segments, and each segment is solved with its own model, state, and
+    // solver.
+    struct Segment {
+        std::unique_ptr<Model> model;
+        std::unique_ptr<InverseKinematicsSolver> solver;
+        SimTK::State* state = nullptr;
+    };
+    std::vector<Segment> segments;
+};
+
 //=============================================================================
 // RUN
 //=============================================================================
@@ -101,6 +131,28 @@ void InverseKinematicsTool::constructProperties()
  * Run the inverse kinematics tool.
  */
 bool InverseKinematicsTool::run()
+{
+    return runTrials({get_marker_file()}, {getName()},
+            {get_output_motion_file()});
+}
+
+bool InverseKinematicsTool::runTrials(
+        const std::vector<std::string>& markerFiles)
+{
+    std::vector<std::string> trialNames;
+    std::vector<std::string> motionFiles;
+    for (const auto& markerFile : markerFiles) {
+        trialNames.push_back(getTrialName(markerFile));
+        motionFiles.push_back(
+                getResultsDir() + "/" + trialNames.back() + "_ik.mot");
+    }
+    return runTrials(markerFiles, trialNames, motionFiles);
+}
+
+bool InverseKinematicsTool::runTrials(
+        const std::vector<std::string>& markerFiles,
+        const std::vector<std::string>& trialNames,
+        const std::vector<std::string>& motionFiles)
 {
     bool success = false;
     bool modelFromFile=true;
@@ -131,185 +183,358 @@ bool InverseKinematicsTool::run()
 
         log_info("Running tool {}.", getName());
 
-        // Get the trial name to label data written to files
-        string trialName = getName();
-
         // Initialize the model's underlying system and get its default state.
+        // The system, and the solvers, are reused by all the trials.
         SimTK::State& s = _model->initSystem();
 
-        //Convert old Tasks to references for assembly and tracking
-        MarkersReference markersReference;
-        SimTK::Array_<CoordinateReference> coordinateReferences;
-        // populate the references according to the setting of this Tool
-        populateReferences(markersReference, coordinateReferences);
-
-        // Determine the start time, if the provided time range is not 
-        // specified then use time from marker reference.
-        // Adjust the time range for the tool if the provided range exceeds
-        // that of the marker data.
-        SimTK::Vec2 markersValidTimeRange = markersReference.getValidTimeRange();
-        double start_time = (markersValidTimeRange[0] > get_time_range(0)) ?
-            markersValidTimeRange[0] : get_time_range(0);
-        double final_time = (markersValidTimeRange[1] < get_time_range(1)) ?
-            markersValidTimeRange[1] : get_time_range(1);
-
-        SimTK_ASSERT2_ALWAYS(final_time >= start_time,
-            "InverseKinematicsTool final time (%f) is before start time (%f).",
-            final_time, start_time);
-
-        const auto& markersTable = markersReference.getMarkerTable();
-        const int start_ix = int(
-            markersTable.getNearestRowIndexForTime(start_time) );
-        const int final_ix = int(
-            markersTable.getNearestRowIndexForTime(final_time) );
-        const int Nframes = final_ix - start_ix + 1;
-        const auto& times = markersTable.getIndependentColumn();
-
-        // create the solver given the input data
-        InverseKinematicsSolver ikSolver(*_model, make_shared<MarkersReference>(markersReference),
-            coordinateReferences, get_constraint_weight());
-        ikSolver.setAccuracy(get_accuracy());
-        s.updTime() = times[start_ix];
-        ikSolver.assemble(s);
-        kinematicsReporter->begin(s);
-
-        AnalysisSet& analysisSet = _model->updAnalysisSet();
-        analysisSet.begin(s);
-        // Get the actual number of markers the Solver is using, which
-        // can be fewer than the number of references if there isn't a
-        // corresponding model marker for each reference.
-        int nm = ikSolver.getNumMarkersInUse();
-        SimTK::Array_<double> squaredMarkerErrors(nm, 0.0);
-        SimTK::Array_<Vec3> markerLocations(nm, Vec3(0));
-        
-        Storage *modelMarkerLocations = get_report_marker_locations() ?
-            new Storage(Nframes, "ModelMarkerLocations") : nullptr;
-        Storage *modelMarkerErrors = get_report_errors() ? 
-            new Storage(Nframes, "ModelMarkerErrors") : nullptr;
-
-        Stopwatch watch;
+        if (markerFiles.size() > 1) IO::makeDir(getResultsDir());
+        TrialSolvers solvers;
+        for (int itrial = 0; itrial < (int)markerFiles.size(); ++itrial) {
+            if (markerFiles.size() > 1) {
+                log_info("Trial {} ({} of {}): {}", trialNames[itrial],
+                        itrial + 1, markerFiles.size(), markerFiles[itrial]);
+            }
+            solveTrial(s, *kinematicsReporter, markerFiles[itrial],
+                    trialNames[itrial], motionFiles[itrial], solvers);
+        }
 
-        for (int i = start_ix; i <= final_ix; ++i) {
-            s.updTime() = times[i];
-            ikSolver.track(s);
-            // show progress line every 1000 frames so users see progress
-            if (std::remainder(i - start_ix, 1000) == 0 && i != start_ix)
-                log_info("Solved {} frame(s)...", i - start_ix);
-            if(get_report_errors()){
-                Array<double> markerErrors(0.0, 3);
-                double totalSquaredMarkerError = 0.0;
-                double maxSquaredMarkerError = 0.0;
-                int worst = -1;
-
-                ikSolver.computeCurrentSquaredMarkerErrors(squaredMarkerErrors);
-                for(int j=0; j<nm; ++j){
-                    totalSquaredMarkerError += squaredMarkerErrors[j];
-                    if(squaredMarkerErrors[j] > maxSquaredMarkerError){
-                        maxSquaredMarkerError = squaredMarkerErrors[j];
-                        worst = j;
-                    }
+        // Remove the analysis we added to the model, do not delete as 
+        // the unique_ptr takes care of that automatically
+        _model->removeAnalysis(kinematicsReporter.get(), false);
+
+        success = true;
+    }
+    catch (const std::exception& ex) {
+        log_error("InverseKinematicsTool Failed: {}", ex.what());
+        // If failure happened after kinematicsReporter was added, make sure to cleanup
+        if (kinematicsReporter!= nullptr)
+            _model->removeAnalysis(kinematicsReporter.get());
+        throw (Exception("InverseKinematicsTool Failed, "
+            "please see messages window for details..."));
+    }
+
+    if (modelFromFile) { 
+        log_debug("Deleting Model {} at end of IK.run", _model->getName());
+        delete _model.get();
+        _model.reset();
+    }
+
+    return success;
+}
+
+
+void InverseKinematicsTool::solveTrial(SimTK::State& s,
+        Kinematics& kinematicsReporter, const std::string& markerFile,
+        const std::string& trialName, const std::string& motionFile,
+        TrialSolvers& solvers)
+{
+    //Convert old Tasks to references for assembly and tracking. The
+    // coordinate references do not depend on the trial, so they are
+    // populated only with the solver of the first trial.
+    MarkersReference markersReference;
+    populateMarkersReference(markerFile, markersReference);
+    if (!solvers.solver)
+        populateCoordinateReferences(solvers.coordinateReferences);
+
+    // Determine the start time, if the provided time range is not 
+    // specified then use time from marker reference.
+    // Adjust the time range for the tool if the provided range exceeds
+    // that of the marker data.
+    SimTK::Vec2 markersValidTimeRange = markersReference.getValidTimeRange();
+    double start_time = (markersValidTimeRange[0] > get_time_range(0)) ?
+        markersValidTimeRange[0] : get_time_range(0);
+    double final_time = (markersValidTimeRange[1] < get_time_range(1)) ?
+        markersValidTimeRange[1] : get_time_range(1);
+
+    SimTK_ASSERT2_ALWAYS(final_time >= start_time,
+        "InverseKinematicsTool final time (%f) is before start time (%f).",
+        final_time, start_time);
+
+    const auto& markersTable = markersReference.getMarkerTable();
+    const int start_ix = int(
+        markersTable.getNearestRowIndexForTime(start_time) );
+    const int final_ix = int(
+        markersTable.getNearestRowIndexForTime(final_time) );
+    const int Nframes = final_ix - start_ix + 1;
+    const auto& times = markersTable.getIndependentColumn();
+
+    // create the solver given the input data, or give the solver of the
+    // previous trial the marker data of this trial
+    if (solvers.solver) {
+        solvers.solver->setMarkersReference(
+                make_shared<MarkersReference>(markersReference));
+    } else {
+        solvers.solver.reset(new InverseKinematicsSolver(*_model,
+                make_shared<MarkersReference>(markersReference),
+                solvers.coordinateReferences, get_constraint_weight()));
+        solvers.solver->setAccuracy(get_accuracy());
+        solvers.solver->setUseLeastSquaresTracking(
+                get_use_least_squares_tracking());
+    }
+    InverseKinematicsSolver& ikSolver = *solvers.solver;
+    s.updTime() = times[start_ix];
+    ikSolver.assemble(s);
+    kinematicsReporter.begin(s);
+
+    AnalysisSet& analysisSet = _model->updAnalysisSet();
+    analysisSet.begin(s);
+    // Get the actual number of markers the Solver is using, which
+    // can be fewer than the number of references if there isn't a
+    // corresponding model marker for each reference.
+    int nm = ikSolver.getNumMarkersInUse();
+    SimTK::Array_<double> squaredMarkerErrors(nm, 0.0);
+    SimTK::Array_<Vec3> markerLocations(nm, Vec3(0));
+    
+    Storage *modelMarkerLocations = get_report_marker_locations() ?
+        new Storage(Nframes, "ModelMarkerLocations") : nullptr;
+    Storage *modelMarkerErrors = get_report_errors() ? 
+        new Storage(Nframes, "ModelMarkerErrors") : nullptr;
+
+    // The rows of the storages, reused for all frames.
+    Array<double> errorsRow(0.0, 3);
+    Array<double> locationsRow(0.0, 3*nm);
+
+    // Compute the errors and locations of the current frame that are
+    // reported, with the locations computed once if both are.
+    auto computeFrame = [&](InverseKinematicsSolver& solver,
+            SimTK::Array_<double>& frameErrors,
+            SimTK::Array_<Vec3>& frameLocations) {
+        if (get_report_errors() && get_report_marker_locations()) {
+            solver.computeCurrentMarkerLocationsAndSquaredErrors(
+                    frameLocations, frameErrors);
+        } else if (get_report_errors()) {
+            solver.computeCurrentSquaredMarkerErrors(frameErrors);
+        } else if (get_report_marker_locations()) {
+            solver.computeCurrentMarkerLocations(frameLocations);
+        }
+    };
+    const bool logEachFrame = Logger::shouldLog(Logger::Level::Debug);
+
+    Stopwatch watch;
+
+    // The marker errors of each frame are logged at the debug level; at
+    // the info level, they are summarized every errorSummaryInterval
+    // frames, so that long trials do not log a line per frame.
+    const int errorSummaryInterval = 100;
+    int summaryFirstFrame = -1;
+    double summaryStartTime = 0;
+    int summaryNumFrames = 0;
+    double summarySumRMS = 0;
+    double summaryMaxError = -1;
+    int summaryWorstFrame = -1;
+    std::string summaryWorstMarker;
+
+    // Report the solution of frame i, which must already be in s, to the
+    // marker error and location storages and to the analyses.
+    auto reportFrame = [&](int i) {
+        if(get_report_errors()){
+            double totalSquaredMarkerError = 0.0;
+            double maxSquaredMarkerError = 0.0;
+            int worst = -1;
+
+            for(int j=0; j<nm; ++j){
+                totalSquaredMarkerError += squaredMarkerErrors[j];
+                if(squaredMarkerErrors[j] > maxSquaredMarkerError){
+                    maxSquaredMarkerError = squaredMarkerErrors[j];
+                    worst = j;
                 }
+            }
 
-                double rms = nm > 0 ? sqrt(totalSquaredMarkerError / nm) : 0;
-                markerErrors.set(0, totalSquaredMarkerError); 
-                markerErrors.set(1, rms);
-                markerErrors.set(2, sqrt(maxSquaredMarkerError));
-                modelMarkerErrors->append(s.getTime(), 3, &markerErrors[0]);
+            double rms = nm > 0 ? sqrt(totalSquaredMarkerError / nm) : 0;
+            errorsRow.set(0, totalSquaredMarkerError);
+            errorsRow.set(1, rms);
+            errorsRow.set(2, sqrt(maxSquaredMarkerError));
+            modelMarkerErrors->append(s.getTime(), 3, &errorsRow[0]);
 
-                log_info("Frame {} (t = {}):\t total squared error = {}, "
-                         "marker error: RMS = {}, max = {} ({})", 
+            if (logEachFrame) {
+                log_debug("Frame {} (t = {}):\t total squared error = {}, "
+                          "marker error: RMS = {}, max = {} ({})",
                     i, s.getTime(), totalSquaredMarkerError, rms,
-                    sqrt(maxSquaredMarkerError), 
-                    ikSolver.getMarkerNameForIndex(worst));
+                    sqrt(maxSquaredMarkerError),
+                    worst >= 0 ? ikSolver.getMarkerNameForIndex(worst)
+                               : std::string());
             }
 
-            if(get_report_marker_locations()){
-                ikSolver.computeCurrentMarkerLocations(markerLocations);
-                Array<double> locations(0.0, 3*nm);
-                for(int j=0; j<nm; ++j){
-                    for(int k=0; k<3; ++k)
-                        locations.set(3*j+k, markerLocations[j][k]);
+            if (summaryNumFrames == 0) {
+                summaryFirstFrame = i;
+                summaryStartTime = s.getTime();
+                summarySumRMS = 0;
+                summaryMaxError = -1;
+            }
+            ++summaryNumFrames;
+            summarySumRMS += rms;
+            if (worst >= 0 &&
+                    sqrt(maxSquaredMarkerError) > summaryMaxError) {
+                summaryMaxError = sqrt(maxSquaredMarkerError);
+                summaryWorstFrame = i;
+                summaryWorstMarker = ikSolver.getMarkerNameForIndex(worst);
+            }
+            if (summaryNumFrames == errorSummaryInterval ||
+                    i == final_ix) {
+                if (summaryMaxError >= 0) {
+                    log_info("Frames {}-{} (t = {} to {}):\t marker error: "
+                             "mean RMS = {}, max = {} ({}, frame {})",
+                        summaryFirstFrame, i, summaryStartTime,
+                        s.getTime(), summarySumRMS / summaryNumFrames,
+                        summaryMaxError, summaryWorstMarker,
+                        summaryWorstFrame);
+                } else {
+                    log_info("Frames {}-{} (t = {} to {}):\t marker error: "
+                             "mean RMS = {}",
+                        summaryFirstFrame, i, summaryStartTime,
+                        s.getTime(), summarySumRMS / summaryNumFrames);
                 }
+                summaryNumFrames = 0;
+            }
+        }
 
-                modelMarkerLocations->append(s.getTime(), 3*nm, &locations[0]);
-
+        if(get_report_marker_locations()){
+            for(int j=0; j<nm; ++j){
+                for(int k=0; k<3; ++k)
+                    locationsRow.set(3*j+k, markerLocations[j][k]);
             }
 
-            kinematicsReporter->step(s, i);
-            analysisSet.step(s, i);
-        }
+            modelMarkerLocations->append(s.getTime(), 3*nm, &locationsRow[0]);
 
-        // Do the maneuver to change then restore working directory 
-        // so that output files are saved to same folder as setup file.
-        if (get_output_motion_file() != "" &&
-                get_output_motion_file() != "Unassigned") {
-            kinematicsReporter->getPositionStorage()->print(
-                    get_output_motion_file());
         }
-        // Remove the analysis we added to the model, do not delete as 
-        // the unique_ptr takes care of that automatically
-        _model->removeAnalysis(kinematicsReporter.get(), false);
 
-        if (modelMarkerErrors) {
-            Array<string> labels("", 4);
-            labels[0] = "time";
-            labels[1] = "total_squared_error";
-            labels[2] = "marker_error_RMS";
-            labels[3] = "marker_error_max";
-
-            modelMarkerErrors->setColumnLabels(labels);
-            modelMarkerErrors->setName("Model Marker Errors from IK");
+        kinematicsReporter.step(s, i);
+        analysisSet.step(s, i);
+    };
+
+    const int numThreads =
+            std::min(getNumThreadsOrDefault(get_num_threads()), Nframes);
+    if (numThreads > 1) {
+        log_info("Solving {} frames in {} segments on separate threads.",
+                Nframes, numThreads);
+
+        // Each segment is solved with its own model, state, and solver.
+        // These are created here (rather than on the worker threads) so
+        // that the shared model and references are only read by one
+        // thread, and are kept for the next trial, which only needs to
+        // give the solvers its marker data.
+        auto& segments = solvers.segments;
+        if ((int)segments.size() < numThreads) segments.resize(numThreads);
+        for (int iseg = 0; iseg < numThreads; ++iseg) {
+            auto& segment = segments[iseg];
+            if (segment.solver) {
+                segment.solver->setMarkersReference(
+                        make_shared<MarkersReference>(markersReference));
+                continue;
+            }
+            segment.model.reset(_model->clone());
+            // The copy gets its own copies of the analyses, which are not
+            // needed since all frames are reported on the original model.
+            segment.model->updAnalysisSet().clearAndDestroy();
+            segment.model->finalizeFromProperties();
+            segment.state = &segment.model->initSystem();
+            segment.solver.reset(new InverseKinematicsSolver(
+                    *segment.model,
+                    make_shared<MarkersReference>(markersReference),
+                    solvers.coordinateReferences,
+                    get_constraint_weight()));
+            segment.solver->setAccuracy(get_accuracy());
+            segment.solver->setUseLeastSquaresTracking(
+                    get_use_least_squares_tracking());
+        }
 
-            IO::makeDir(getResultsDir());
-            string errorFileName = trialName + "_ik_marker_errors";
-            Storage::printResult(modelMarkerErrors, errorFileName,
-                                 getResultsDir(), -1, ".sto");
+        std::vector<SimTK::Vector> qs(Nframes);
+        std::vector<SimTK::Array_<double>> errors(
+                get_report_errors() ? Nframes : 0);
+        std::vector<SimTK::Array_<Vec3>> locations(
+                get_report_marker_locations() ? Nframes : 0);
+        parallelForChunks(Nframes, numThreads,
+                [&](int iseg, int begin, int end) {
+            auto& solver = *segments[iseg].solver;
+            SimTK::State& segState = *segments[iseg].state;
+            segState.updTime() = times[start_ix + begin];
+            solver.assemble(segState);
+            for (int iframe = begin; iframe < end; ++iframe) {
+                segState.updTime() = times[start_ix + iframe];
+                solver.track(segState);
+                qs[iframe] = segState.getQ();
+                // The arrays of the quantities that are not reported are
+                // not written.
+                computeFrame(solver,
+                        get_report_errors() ? errors[iframe]
+                                            : squaredMarkerErrors,
+                        get_report_marker_locations() ? locations[iframe]
+                                                      : markerLocations);
+            }
+        });
+        log_info("Solved {} frame(s).", Nframes);
 
-            delete modelMarkerErrors;
+        // Report the frames in order on this thread.
+        for (int i = start_ix; i <= final_ix; ++i) {
+            const int iframe = i - start_ix;
+            s.updTime() = times[i];
+            s.updQ() = qs[iframe];
+            _model->realizePosition(s);
+            if (get_report_errors())
+                squaredMarkerErrors = errors[iframe];
+            if (get_report_marker_locations())
+                markerLocations = locations[iframe];
+            reportFrame(i);
         }
+    } else {
+        for (int i = start_ix; i <= final_ix; ++i) {
+            s.updTime() = times[i];
+            ikSolver.track(s);
+            // show progress line every 1000 frames so users see progress
+            if (std::remainder(i - start_ix, 1000) == 0 && i != start_ix)
+                log_info("Solved {} frame(s)...", i - start_ix);
+            computeFrame(ikSolver, squaredMarkerErrors, markerLocations);
+            reportFrame(i);
+        }
+    }
 
-        if(modelMarkerLocations){
-            Array<string> labels("", 3*nm+1);
-            labels[0] = "time";
-            Array<string> XYZ("", 3*nm);
-            XYZ[0] = "_tx"; XYZ[1] = "_ty"; XYZ[2] = "_tz";
+    // Do the maneuver to change then restore working directory 
+    // so that output files are saved to same folder as setup file.
+    if (motionFile != "" && motionFile != "Unassigned") {
+        kinematicsReporter.getPositionStorage()->print(motionFile);
+    }
 
-            for(int j=0; j<nm; ++j){
-                for(int k=0; k<3; ++k)
-                    labels.set(3*j+k+1, ikSolver.getMarkerNameForIndex(j)+XYZ[k]);
-            }
-            modelMarkerLocations->setColumnLabels(labels);
-            modelMarkerLocations->setName("Model Marker Locations from IK");
-    
-            IO::makeDir(getResultsDir());
-            string markerFileName = trialName + "_ik_model_marker_locations";
-            Storage::printResult(modelMarkerLocations, markerFileName,
-                                 getResultsDir(), -1, ".sto");
+    if (modelMarkerErrors) {
+        Array<string> labels("", 4);
+        labels[0] = "time";
+        labels[1] = "total_squared_error";
+        labels[2] = "marker_error_RMS";
+        labels[3] = "marker_error_max";
 
-            delete modelMarkerLocations;
-        }
+        modelMarkerErrors->setColumnLabels(labels);
+        modelMarkerErrors->setName("Model Marker Errors from IK");
 
-        success = true;
+        IO::makeDir(getResultsDir());
+        string errorFileName = trialName + "_ik_marker_errors";
+        Storage::printResult(modelMarkerErrors, errorFileName,
+                             getResultsDir(), -1, ".sto");
 
-        log_info("InverseKinematicsTool completed {} frames in {}.", Nframes,
-            watch.getElapsedTimeFormatted());
-    }
-    catch (const std::exception& ex) {
-        log_error("InverseKinematicsTool Failed: {}", ex.what());
-        // If failure happened after kinematicsReporter was added, make sure to cleanup
-        if (kinematicsReporter!= nullptr)
-            _model->removeAnalysis(kinematicsReporter.get());
-        throw (Exception("InverseKinematicsTool Failed, "
-            "please see messages window for details..."));
+        delete modelMarkerErrors;
     }
 
-    if (modelFromFile) { 
-        log_debug("Deleting Model {} at end of IK.run", _model->getName());
-        delete _model.get();
-        _model.reset();
+    if(modelMarkerLocations){
+        Array<string> labels("", 3*nm+1);
+        labels[0] = "time";
+        Array<string> XYZ("", 3*nm);
+        XYZ[0] = "_tx"; XYZ[1] = "_ty"; XYZ[2] = "_tz";
+
+        for(int j=0; j<nm; ++j){
+            for(int k=0; k<3; ++k)
+                labels.set(3*j+k+1, ikSolver.getMarkerNameForIndex(j)+XYZ[k]);
+        }
+        modelMarkerLocations->setColumnLabels(labels);
+        modelMarkerLocations->setName("Model Marker Locations from IK");
+
+        IO::makeDir(getResultsDir());
+        string markerFileName = trialName + "_ik_model_marker_locations";
+        Storage::printResult(modelMarkerLocations, markerFileName,
+                             getResultsDir(), -1, ".sto");
+
+        delete modelMarkerLocations;
     }
 
-    return success;
+    log_info("InverseKinematicsTool completed {} frames in {}.", Nframes,
+        watch.getElapsedTimeFormatted());
 }
 
 // Handle conversion from older format
@@ -403,6 +628,13 @@ void InverseKinematicsTool::updateFromXMLNode(SimTK::Xml::Element& aNode, int ve
 
 void InverseKinematicsTool::populateReferences(MarkersReference& markersReference,
     SimTK::Array_<CoordinateReference>&coordinateReferences) const
+{
+    populateCoordinateReferences(coordinateReferences);
+    populateMarkersReference(get_marker_file(), markersReference);
+}
+
+void InverseKinematicsTool::populateCoordinateReferences(
+        SimTK::Array_<CoordinateReference>& coordinateReferences) const
 {
     FunctionSet *coordFunctions = NULL;
     // Load the coordinate data
@@ -415,8 +647,7 @@ void InverseKinematicsTool::populateReferences(MarkersReference& markersReferenc
         coordFunctions = new GCVSplineSet(5, &coordinateValues);
     }
 
-    Set<MarkerWeight> markerWeights;
-    // Loop through old "IKTaskSet" and assign weights to the coordinate and marker references
+    // Loop through old "IKTaskSet" and assign weights to the coordinate references
     // For coordinates, create the functions for coordinate reference values
     int index = 0;
     for (int i = 0; i < get_IKTaskSet().getSize(); i++) {
@@ -449,19 +680,25 @@ void InverseKinematicsTool::populateReferences(MarkersReference& markersReferenc
 
             coordinateReferences.push_back(*coordRef);
         }
-        else if (IKMarkerTask *markerTask = dynamic_cast<IKMarkerTask *>(&get_IKTaskSet()[i])) {
-            if (markerTask->getApply()) {
-                // Only track markers that have a task and it is "applied"
-                markerWeights.adoptAndAppend(
-                    new MarkerWeight(markerTask->getName(), markerTask->getWeight()));
-            }
+    }
+}
+
+void InverseKinematicsTool::populateMarkersReference(
+        const std::string& markerFile,
+        MarkersReference& markersReference) const
+{
+    Set<MarkerWeight> markerWeights;
+    for (int i = 0; i < get_IKTaskSet().getSize(); i++) {
+        if (!get_IKTaskSet()[i].getApply()) continue;
+        if (IKMarkerTask *markerTask = dynamic_cast<IKMarkerTask *>(&get_IKTaskSet()[i])) {
+            // Only track markers that have a task and it is "applied"
+            markerWeights.adoptAndAppend(
+                new MarkerWeight(markerTask->getName(), markerTask->getWeight()));
         }
     }
 
     //Read in the marker data file and set the weights for associated markers.
     //Markers in the model and the marker file but not in the markerWeights are
     //ignored
-    markersReference.initializeFromMarkersFile(get_marker_file(), markerWeights);
+    markersReference.initializeFromMarkersFile(markerFile, markerWeights);
 }
-
-
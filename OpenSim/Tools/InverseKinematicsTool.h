@@ -31,6 +31,7 @@
 namespace OpenSim {
 
 class Model;
+class Kinematics;
 class MarkersReference;
 class CoordinateReference;
 
@@ -71,6 +72,23 @@ public:
             "Flag indicating whether or not to report model marker locations. "
             "Note, model marker locations are expressed in Ground.");
 
+    OpenSim_DECLARE_PROPERTY(num_threads, int,
+            "Number of threads used to solve the frames. With more than one "
+            "thread, the frames are split into contiguous time segments, each "
+            "solved with its own copy of the model; the first frame of each "
+            "segment is assembled from the model's default pose instead of "
+            "being warm-started from the previous frame. A value of 0 or less "
+            "uses all available hardware threads. Default is 1.");
+
+    OpenSim_DECLARE_PROPERTY(use_least_squares_tracking, bool,
+            "Flag (true or false) indicating whether frames after the first "
+            "are solved with a Levenberg-Marquardt method specialized for the "
+            "least-squares marker and coordinate objective, which needs far "
+            "fewer evaluations of the model kinematics, instead of the general "
+            "assembly optimizer. It applies only to models without enabled "
+            "constraints; otherwise the assembly optimizer is used. "
+            "Default is false.");
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -102,10 +120,28 @@ public:
 
     IKTaskSet& getIKTaskSet() { return upd_IKTaskSet(); }
 
+    void setNumThreads(int numThreads) { upd_num_threads() = numThreads; }
+    int getNumThreads() const { return get_num_threads(); }
+
     //--------------------------------------------------------------------------
     // INTERFACE
     //--------------------------------------------------------------------------
     bool run() override SWIG_DECLARE_EXCEPTION;
+
+    /** Solve the inverse kinematics of each of the given marker files
+    (trials) with the settings of this tool, in order. The model's system is
+    initialized, and the solver (and, with more than one thread, the copies
+    of the model for the segments of frames) is created, only once; each
+    trial after the first only gives the solver its marker data. The
+    coordinate file, time range, and tasks apply to all the trials. The
+    motion of each trial is written to `<trial>_ik.mot` in the results
+    directory, and its marker errors and locations (if reported) to
+    `<trial>_ik_marker_errors.sto` and
+    `<trial>_ik_model_marker_locations.sto`, where `<trial>` is the name of
+    the marker file without its directory and extension. The marker_file
+    and output_motion_file properties are not used. */
+    bool runTrials(const std::vector<std::string>& markerFiles)
+            SWIG_DECLARE_EXCEPTION;
 #ifndef SWIG
     /** @cond **/ // hide from Doxygen
 #endif
@@ -120,6 +156,20 @@ public:
 private:
     void constructProperties();
 
+    struct TrialSolvers;
+    bool runTrials(const std::vector<std::string>& markerFiles,
+            const std::vector<std::string>& trialNames,
+            const std::vector<std::string>& motionFiles);
+    // Solve one trial, starting from `s`, with the solvers of the previous
+    // trial if there is one, and write its results.
+    void solveTrial(SimTK::State& s, Kinematics& kinematicsReporter,
+            const std::string& markerFile, const std::string& trialName,
+            const std::string& motionFile, TrialSolvers& solvers);
+    void populateCoordinateReferences(
+            SimTK::Array_<CoordinateReference>& coordinateReferences) const;
+    void populateMarkersReference(const std::string& markerFile,
+            MarkersReference& markersReference) const;
+
     //=============================================================================
 };  // END of class InverseKinematicsTool
 //=============================================================================
@@ -44,6 +44,19 @@
 using namespace std;
 using namespace OpenSim;
 using SimTK::Vec3;
+
+namespace {
+// Whether the system of the model was built from the current properties of
+// the model and all its components.
+bool isSystemUpToDate(const Model& model) {
+    if (!model.isValidSystem() || !model.isObjectUpToDateWithProperties())
+        return false;
+    for (const auto& comp : model.getComponentList())
+        if (!comp.isObjectUpToDateWithProperties()) return false;
+    return true;
+}
+} // anonymous namespace
+
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //=============================================================================
@@ -229,10 +242,13 @@ MarkerPlacer& MarkerPlacer::operator=(const MarkerPlacer &aMarkerPlacer)
  * output files selected by the user.
  *
  * @param aModel the model to use for the marker placing process.
+ * @param aMarkerData the contents of the marker file, if already read.
+ * @param aMarkerTable the contents of the marker file, if already read.
  * @return Whether the marker placing process was successful or not.
  */
 bool MarkerPlacer::processModel(Model* aModel,
-        const string& aPathToSubject) const {
+        const string& aPathToSubject, const MarkerData* aMarkerData,
+        const TimeSeriesTableVec3* aMarkerTable) const {
 
     if(!getApply()) return false;
 
@@ -244,7 +260,9 @@ bool MarkerPlacer::processModel(Model* aModel,
     /* Load the static pose marker file, and average all the
     * frames in the user-specified time range.
     */
-    TimeSeriesTableVec3 staticPoseTable{aPathToSubject + _markerFileName};
+    TimeSeriesTableVec3 staticPoseTable = aMarkerTable
+            ? *aMarkerTable
+            : TimeSeriesTableVec3(aPathToSubject + _markerFileName);
     const auto& timeCol = staticPoseTable.getIndependentColumn();
 
     // Users often set a time range that purposely exceeds the range of
@@ -283,23 +301,30 @@ bool MarkerPlacer::processModel(Model* aModel,
                                          staticPoseUnits.getAbbreviation());
     }
     
-    MarkerData* staticPose = new MarkerData(aPathToSubject + _markerFileName);
+    std::unique_ptr<MarkerData> staticPose(aMarkerData
+            ? new MarkerData(*aMarkerData)
+            : new MarkerData(aPathToSubject + _markerFileName));
     staticPose->averageFrames(_maxMarkerMovement, _timeRange[0], _timeRange[1]);
     staticPose->convertToUnits(aModel->getLengthUnits());
 
     /* Delete any markers from the model that are not in the static
      * pose marker file.
      */
-    aModel->deleteUnusedMarkers(staticPose->getMarkerNames());
-
-    // Construct the system and get the working state when done changing the model
-    SimTK::State& s = aModel->initSystem();
+    const int numDeleted =
+            aModel->deleteUnusedMarkers(staticPose->getMarkerNames());
+
+    // Construct the system and get the working state when done changing the
+    // model. If the model did not change since its system was last built
+    // (e.g., by ModelScaler), only the working state is created again, since
+    // rebuilding the system of a large model is costly.
+    SimTK::State& s = numDeleted == 0 && isSystemUpToDate(*aModel)
+            ? aModel->initializeState()
+            : aModel->initSystem();
     s.updTime() = _timeRange[0];
     
     // Create references and WeightSets needed to initialize InverseKinemaicsSolver
     Set<MarkerWeight> markerWeightSet;
     _ikTaskSet.createMarkerWeightSet(markerWeightSet); // order in tasks file
-    // MarkersReference takes ownership of marker data (staticPose)
     std::shared_ptr<MarkersReference> markersReference(new MarkersReference(staticPoseTable, markerWeightSet));
     SimTK::Array_<CoordinateReference> coordinateReferences;
 
@@ -390,22 +415,28 @@ bool MarkerPlacer::processModel(Model* aModel,
     _outputStorage->getStateVector(0)->setTime(s.getTime());
 
     if(_printResultFiles) {
-        auto cwd = IO::CwdChanger::changeTo(aPathToSubject);
+        // The output files are relative to the subject directory (see
+        // ModelScaler::processModel()).
+        const auto getOutputPath = [&](const std::string& fileName) {
+            return SimTK::Pathname::
+                    getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                            aPathToSubject, fileName);
+        };
 
         if (_outputModelFileNameProp.isValidFileName()) {
-            aModel->print(aPathToSubject + _outputModelFileName);
+            aModel->print(getOutputPath(_outputModelFileName));
             log_info("Wrote model file '{}' from model {}.",
                 _outputModelFileName, aModel->getName());
         }
 
         if (_outputMarkerFileNameProp.isValidFileName()) {
-            aModel->writeMarkerFile(aPathToSubject + _outputMarkerFileName);
+            aModel->writeMarkerFile(getOutputPath(_outputMarkerFileName));
             log_info("Wrote marker file '{}' from model {}.",
                 _outputMarkerFileName, aModel->getName());
         }
 
         if (_outputMotionFileNameProp.isValidFileName()) {
-            _outputStorage->print(aPathToSubject + _outputMotionFileName,
+            _outputStorage->print(getOutputPath(_outputMotionFileName),
                 "w", "File generated from solving marker data for model "
                 + aModel->getName());
         }
@@ -31,6 +31,7 @@
 #include <OpenSim/Common/PropertyObj.h>
 #include <OpenSim/Common/PropertyStr.h>
 #include "osimToolsDLL.h"
+#include <OpenSim/Common/TimeSeriesTable.h>
 #include <SimTKcommon/internal/ResetOnCopy.h>
 
 namespace SimTK {
@@ -125,8 +126,14 @@ public:
 #ifndef SWIG
     MarkerPlacer& operator=(const MarkerPlacer &aMarkerPlacementParams);
 #endif
+    /** Place the markers of `aModel`. If they are not null, `aMarkerData`
+    and `aMarkerTable` are used (copies of them, that is) as the contents of
+    marker_file, which is then not read again (e.g., when ScaleTool has
+    already read it for the ModelScaler). */
     bool processModel(Model* aModel,
-            const std::string& aPathToSubject="") const;
+            const std::string& aPathToSubject="",
+            const MarkerData* aMarkerData = nullptr,
+            const TimeSeriesTable_<SimTK::Vec3>* aMarkerTable = nullptr) const;
 
     //--------------------------------------------------------------------------
     // GET AND SET
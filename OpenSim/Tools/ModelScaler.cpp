@@ -218,10 +218,11 @@ ModelScaler& ModelScaler::operator=(const ModelScaler &aModelScaler)
  *
  * @param aModel the model to scale.
  * @param aSubjectMass the final mass of the model after scaling.
+ * @param aMarkerData the contents of the marker file, if already read.
  * @return Whether the scaling process was successful or not.
  */
 bool ModelScaler::processModel(Model* aModel, const string& aPathToSubject,
-        double aSubjectMass) const
+        double aSubjectMass, const MarkerData* aMarkerData) const
 {
     if (!getApply()) return false;
 
@@ -261,7 +262,10 @@ bool ModelScaler::processModel(Model* aModel, const string& aPathToSubject,
                 /* Load the static pose marker file, and convert units.
                 */
                 std::unique_ptr<MarkerData> markerData{};
-                if(!_markerFileName.empty() && _markerFileName!=PropertyStr::getDefaultStr()) {
+                if (aMarkerData) {
+                    markerData.reset(new MarkerData(*aMarkerData));
+                    markerData->convertToUnits(aModel->getLengthUnits());
+                } else if(!_markerFileName.empty() && _markerFileName!=PropertyStr::getDefaultStr()) {
                     markerData.reset(new MarkerData(aPathToSubject + _markerFileName));
                     markerData->convertToUnits(aModel->getLengthUnits());
                 }
@@ -314,16 +318,22 @@ bool ModelScaler::processModel(Model* aModel, const string& aPathToSubject,
         aModel->scale(s, theScaleSet, _preserveMassDist, aSubjectMass);
 
         if(_printResultFiles) {
-            auto cwd = IO::CwdChanger::changeTo(aPathToSubject);
-
+            // The output files are relative to the subject directory. They
+            // are resolved here rather than by changing the working
+            // directory, so that ScaleTool::runBatch() can scale several
+            // subjects at once.
             if (_outputModelFileNameProp.isValidFileName()) {
-                if (aModel->print(_outputModelFileName))
+                if (aModel->print(SimTK::Pathname::
+                        getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                                aPathToSubject, _outputModelFileName)))
                     log_info("Wrote model file '{}' from model.",
                         _outputModelFileName, aModel->getName());
             }
 
             if (_outputScaleFileNameProp.isValidFileName()) {
-                if (theScaleSet.print(_outputScaleFileName))
+                if (theScaleSet.print(SimTK::Pathname::
+                        getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                                aPathToSubject, _outputScaleFileName)))
                     log_info("Wrote scale file '{}' for model {}.",
                         _outputScaleFileName, aModel->getName());
             }
@@ -111,8 +111,13 @@ public:
 #endif
    void copyData(const ModelScaler &aModelScaler);
 
+    /** Scale `aModel`. If `aMarkerData` is not null, it is used (after
+    converting a copy to the units of the model) as the contents of
+    marker_file, which is then not read again (e.g., when ScaleTool has
+    already read it for the MarkerPlacer). */
     bool processModel(Model* aModel, const std::string& aPathToSubject="",
-            double aFinalMass = -1.0) const;
+            double aFinalMass = -1.0,
+            const MarkerData* aMarkerData = nullptr) const;
     /* Register types to be used when reading a ModelScaler object from xml file. */
     static void registerTypes();
 
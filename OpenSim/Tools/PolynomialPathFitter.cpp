@@ -0,0 +1,339 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  PolynomialPathFitter.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "PolynomialPathFitter.h"
+
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/LatinHypercubeDesign.h>
+#include <OpenSim/Common/MultivariatePolynomialFunction.h>
+#include <OpenSim/Simulation/Model/FunctionBasedPath.h>
+#include <OpenSim/Simulation/Model/GeometryPath.h>
+#include <OpenSim/Simulation/MomentArmSolver.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace OpenSim;
+
+namespace {
+    // The GeometryPath of a force with a "path" property, or nullptr if the
+    // force has no such property or its path is of another type.
+    const GeometryPath* getGeometryPath(const Force& force) {
+        if (!force.hasProperty("path")) { return nullptr; }
+        return dynamic_cast<const GeometryPath*>(
+                &force.getPropertyByName("path").getValueAsObject());
+    }
+
+    // The result of fitting a single path.
+    struct PathFit {
+        // Indices (into the sampled coordinates) of the function arguments.
+        std::vector<int> coordinates;
+        int order = 0;
+        SimTK::Vector coefficients;
+        double lengthError = SimTK::Infinity;
+        double momentArmError = SimTK::Infinity;
+    };
+}
+
+//=============================================================================
+// CONSTRUCTOR(S)
+//=============================================================================
+PolynomialPathFitter::PolynomialPathFitter() : Tool() {
+    constructProperties();
+}
+
+PolynomialPathFitter::PolynomialPathFitter(const std::string& aFileName) :
+        Tool(aFileName, false) {
+    constructProperties();
+    updateFromXMLDocument();
+}
+
+void PolynomialPathFitter::constructProperties() {
+    constructProperty_model_file("");
+    constructProperty_output_model_file("");
+    constructProperty_num_samples(1000);
+    constructProperty_maximum_polynomial_order(6);
+    constructProperty_path_length_tolerance(1e-4);
+    constructProperty_moment_arm_tolerance(1e-4);
+    constructProperty_moment_arm_threshold(1e-3);
+    constructProperty_num_threads(0);
+}
+
+const Model& PolynomialPathFitter::getFittedModel() const {
+    OPENSIM_THROW_IF_FRMOBJ(!_fittedModel, Exception,
+            "No fitted model is available; call run() first.");
+    return *_fittedModel;
+}
+
+//=============================================================================
+// RUN
+//=============================================================================
+bool PolynomialPathFitter::run() {
+    const int numSamples = get_num_samples();
+    const int maxOrder = get_maximum_polynomial_order();
+    OPENSIM_THROW_IF_FRMOBJ(numSamples < 1, Exception,
+            "Expected num_samples to be positive, but got {}.", numSamples);
+    OPENSIM_THROW_IF_FRMOBJ(maxOrder < 1, Exception,
+            "Expected maximum_polynomial_order to be positive, but got {}.",
+            maxOrder);
+
+    // Change to the directory of the setup file so that relative paths in it
+    // are resolved as expected.
+    auto cwd = IO::CwdChanger::changeToParentOf(getDocumentFileName());
+
+    std::unique_ptr<Model> model;
+    if (_model) {
+        model.reset(new Model(*_model));
+    } else {
+        OPENSIM_THROW_IF_FRMOBJ(get_model_file().empty(), Exception,
+                "No model filename was provided.");
+        model.reset(new Model(get_model_file()));
+    }
+    model->finalizeFromProperties();
+    const SimTK::State& defaultState = model->initSystem();
+
+    // Forces with a GeometryPath.
+    std::vector<std::string> forcePaths;
+    for (const auto& force : model->getComponentList<Force>()) {
+        if (getGeometryPath(force)) {
+            forcePaths.push_back(force.getAbsolutePathString());
+        }
+    }
+    const int numPaths = (int)forcePaths.size();
+
+    // Independent, unlocked coordinates, which are sampled.
+    std::vector<std::string> coordinatePaths;
+    std::vector<double> lower;
+    std::vector<double> upper;
+    for (const auto& coord : model->getComponentList<Coordinate>()) {
+        if (coord.getDefaultLocked() || coord.isDependent(defaultState)) {
+            continue;
+        }
+        OPENSIM_THROW_IF_FRMOBJ(!SimTK::isFinite(coord.getRangeMin()) ||
+                                !SimTK::isFinite(coord.getRangeMax()),
+                Exception,
+                "Expected coordinate '{}' to have a finite range; lock the "
+                "coordinate to exclude it from the fit.",
+                coord.getAbsolutePathString());
+        coordinatePaths.push_back(coord.getAbsolutePathString());
+        lower.push_back(coord.getRangeMin());
+        upper.push_back(coord.getRangeMax());
+    }
+    const int numCoords = (int)coordinatePaths.size();
+
+    log_info("Fitting {} path(s) of model '{}' as functions of {} "
+             "coordinate(s) with {} samples.",
+            numPaths, model->getName(), numCoords, numSamples);
+
+    std::vector<PathFit> fits(numPaths);
+    if (numPaths > 0 && numCoords > 0) {
+        LatinHypercubeDesign lhs;
+        lhs.setNumSamples(numSamples);
+        lhs.setNumVariables(numCoords);
+        lhs.setNumThreads(get_num_threads());
+        const SimTK::Matrix design = lhs.generateRandomDesign();
+
+        // Sample the lengths and moment arms.
+        // -----------------------------------
+        // Each thread evaluates the paths with its own copy of the model,
+        // state, and solver. These are created here, on the calling thread.
+        struct Worker {
+            std::unique_ptr<Model> model;
+            SimTK::State* state = nullptr;
+            std::unique_ptr<MomentArmSolver> solver;
+            std::vector<const Coordinate*> coords;
+            std::vector<const GeometryPath*> paths;
+        };
+        const int numThreads = std::min(
+                getNumThreadsOrDefault(get_num_threads()), numSamples);
+        std::vector<Worker> workers(numThreads);
+        for (auto& worker : workers) {
+            worker.model.reset(model->clone());
+            worker.model->finalizeFromProperties();
+            worker.state = &worker.model->initSystem();
+            worker.solver.reset(new MomentArmSolver(*worker.model));
+            for (const auto& coordPath : coordinatePaths) {
+                worker.coords.push_back(
+                        &worker.model->getComponent<Coordinate>(coordPath));
+            }
+            for (const auto& forcePath : forcePaths) {
+                worker.paths.push_back(getGeometryPath(
+                        worker.model->getComponent<Force>(forcePath)));
+            }
+        }
+        const bool assemble = model->getConstraintSet().getSize() > 0;
+
+        SimTK::Matrix coordValues(numSamples, numCoords);
+        SimTK::Matrix lengths(numSamples, numPaths);
+        std::vector<SimTK::Matrix> momentArms(
+                numPaths, SimTK::Matrix(numSamples, numCoords));
+        parallelForChunks(numSamples, numThreads,
+                [&](int chunk, int begin, int end) {
+            Worker& worker = workers[chunk];
+            SimTK::State& s = *worker.state;
+            SimTK::Vector sampleLengths;
+            SimTK::Matrix sampleMomentArms;
+            for (int i = begin; i < end; ++i) {
+                for (int j = 0; j < numCoords; ++j) {
+                    worker.coords[j]->setValue(s,
+                            lower[j] + design(i, j) * (upper[j] - lower[j]),
+                            false);
+                }
+                if (assemble) { worker.model->assemble(s); }
+                worker.model->realizePosition(s);
+                for (int j = 0; j < numCoords; ++j) {
+                    coordValues(i, j) = worker.coords[j]->getValue(s);
+                }
+                worker.solver->solve(s, worker.coords, worker.paths,
+                        sampleLengths, sampleMomentArms);
+                lengths.updRow(i) = ~sampleLengths;
+                for (int k = 0; k < numPaths; ++k) {
+                    momentArms[k].updRow(i) = sampleMomentArms[k];
+                }
+            }
+        });
+
+        // Fit the paths.
+        // --------------
+        const int numFitThreads = std::min(
+                getNumThreadsOrDefault(get_num_threads()), numPaths);
+        parallelForChunks(numPaths, numFitThreads,
+                [&](int, int begin, int end) {
+            for (int k = begin; k < end; ++k) {
+                PathFit& fit = fits[k];
+                for (int j = 0; j < numCoords; ++j) {
+                    if (momentArms[k].col(j).normInf() >
+                            get_moment_arm_threshold()) {
+                        fit.coordinates.push_back(j);
+                    }
+                }
+                const int nd = (int)fit.coordinates.size();
+                if (nd == 0 || nd > 6) { continue; }
+
+                const int numRows = numSamples * (1 + nd);
+                SimTK::Vector x(nd);
+                SimTK::Vector b(numRows);
+                for (int i = 0; i < numSamples; ++i) {
+                    b[i] = lengths(i, k);
+                    for (int d = 0; d < nd; ++d) {
+                        b[numSamples + i * nd + d] =
+                                momentArms[k](i, fit.coordinates[d]);
+                    }
+                }
+
+                // Increase the order until both tolerances are met.
+                for (int order = 1; order <= maxOrder; ++order) {
+                    MultivariatePolynomialFunction basis;
+                    basis.setDimension(nd);
+                    basis.setOrder(order);
+                    SimTK::Matrix A;
+                    for (int i = 0; i < numSamples; ++i) {
+                        for (int d = 0; d < nd; ++d) {
+                            x[d] = coordValues(i, fit.coordinates[d]);
+                        }
+                        const SimTK::Vector terms = basis.getTermValues(x);
+                        if (i == 0) { A.resize(numRows, terms.size()); }
+                        A.updRow(i) = ~terms;
+                        // Moment arms are the negated partial derivatives of
+                        // the length.
+                        for (int d = 0; d < nd; ++d) {
+                            A.updRow(numSamples + i * nd + d) =
+                                    -~basis.getTermDerivatives(d, x);
+                        }
+                    }
+                    // Not enough data to determine the coefficients.
+                    if (A.ncol() > numRows) { break; }
+
+                    SimTK::Vector coefficients;
+                    SimTK::FactorQTZ(A).solve(b, coefficients);
+                    const SimTK::Vector residual = A * coefficients - b;
+                    const double lengthError = std::sqrt(
+                            residual(0, numSamples).normSqr() / numSamples);
+                    const double momentArmError = std::sqrt(
+                            residual(numSamples, numSamples * nd).normSqr() /
+                            (numSamples * nd));
+                    if (lengthError + momentArmError <
+                            fit.lengthError + fit.momentArmError) {
+                        fit.order = order;
+                        fit.coefficients = coefficients;
+                        fit.lengthError = lengthError;
+                        fit.momentArmError = momentArmError;
+                    }
+                    if (lengthError <= get_path_length_tolerance() &&
+                            momentArmError <= get_moment_arm_tolerance()) {
+                        break;
+                    }
+                }
+            }
+        });
+    }
+
+    // Replace the fitted paths.
+    // -------------------------
+    _fittedModel.reset(new Model(*model));
+    int numFitted = 0;
+    for (int k = 0; k < numPaths; ++k) {
+        const PathFit& fit = fits[k];
+        const int nd = (int)fit.coordinates.size();
+        if (fit.order == 0) {
+            log_warn("Path of '{}' (depending on {} coordinate(s)) could "
+                     "not be fitted and was not replaced.", forcePaths[k], nd);
+            continue;
+        }
+        if (fit.lengthError > get_path_length_tolerance() ||
+                fit.momentArmError > get_moment_arm_tolerance()) {
+            log_warn("Path of '{}' does not meet the tolerances with "
+                     "polynomial order up to {}.", forcePaths[k], maxOrder);
+        }
+        std::vector<std::string> argumentPaths;
+        for (int j : fit.coordinates) {
+            argumentPaths.push_back(coordinatePaths[j]);
+        }
+        log_info("Fitted path of '{}': order {}, {} coordinate(s), length "
+                 "RMS error {} m, moment arm RMS error {} m.",
+                forcePaths[k], fit.order, nd, fit.lengthError,
+                fit.momentArmError);
+
+        auto& force = _fittedModel->updComponent<Force>(forcePaths[k]);
+        FunctionBasedPath functionBasedPath;
+        functionBasedPath.setName(getGeometryPath(force)->getName());
+        functionBasedPath.setCoordinatePaths(argumentPaths);
+        functionBasedPath.setLengthFunction(MultivariatePolynomialFunction(
+                fit.coefficients, nd, fit.order));
+        Property<AbstractPath>::updAs(force.updPropertyByName("path"))
+                .setValue(functionBasedPath);
+        ++numFitted;
+    }
+    _fittedModel->finalizeFromProperties();
+    log_info("Replaced {} of {} path(s) with FunctionBasedPaths.", numFitted,
+            numPaths);
+
+    if (!get_output_model_file().empty()) {
+        IO::makeDir(getResultsDir());
+        const std::string fileName =
+                getResultsDir() + "/" + get_output_model_file();
+        log_info("Printing fitted model to '{}'.", fileName);
+        _fittedModel->print(fileName);
+    }
+    return true;
+}
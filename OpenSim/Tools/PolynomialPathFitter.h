@@ -0,0 +1,177 @@
+#ifndef OPENSIM_POLYNOMIAL_PATH_FITTER_H_
+#define OPENSIM_POLYNOMIAL_PATH_FITTER_H_
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  PolynomialPathFitter.h                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Tool.h"
+#include "osimToolsDLL.h"
+
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <memory>
+
+namespace OpenSim {
+
+//=============================================================================
+//=============================================================================
+/**
+ * A Tool that replaces the GeometryPath%s of a model's path-based forces
+ * (e.g., muscles, ligaments, and path springs) with FunctionBasedPath%s whose
+ * length functions are MultivariatePolynomialFunction%s fitted to the original
+ * paths. FunctionBasedPath%s are much cheaper to evaluate than GeometryPath%s
+ * with wrapping, which is useful for, e.g., direct collocation problems.
+ *
+ * The tool proceeds as follows:
+ * -# The independent, unlocked coordinates of the model are sampled within
+ *    their ranges with a random Latin hypercube design (see
+ *    LatinHypercubeDesign). Locked coordinates are kept at their default
+ *    values, and dependent (e.g., coupled) coordinates follow from assembly.
+ * -# The length of each path and its moment arms about the sampled
+ *    coordinates (see MomentArmSolver) are computed at each sample.
+ * -# Each path is assumed to depend on the coordinates about which the largest
+ *    absolute moment arm across all samples exceeds `moment_arm_threshold`.
+ * -# The coefficients of polynomials of increasing order (up to
+ *    `maximum_polynomial_order`) are fitted, in the least-squares sense, to the
+ *    sampled lengths and moment arms (the moment arms are the negated
+ *    derivatives of the length). The lowest order for which the root-mean-
+ *    square errors of both lengths and moment arms are below the tolerances is
+ *    used.
+ *
+ * Sampling and fitting are performed on multiple threads (see `num_threads`);
+ * the paths are fitted independently of each other. Paths that depend on more
+ * than 6 coordinates (the maximum supported by MultivariatePolynomialFunction)
+ * or on none are left unchanged. The coordinate ranges must be finite.
+ *
+ * Moment arms and lengthening speeds of the fitted FunctionBasedPath%s are
+ * computed from the derivatives of the length function, so the fitted paths
+ * assume that the constraints of the model are workless (see
+ * FunctionBasedPath).
+ */
+class OSIMTOOLS_API PolynomialPathFitter : public Tool {
+OpenSim_DECLARE_CONCRETE_OBJECT(PolynomialPathFitter, Tool);
+
+public:
+    OpenSim_DECLARE_PROPERTY(model_file, std::string,
+            "Name of the .osim file containing the model whose paths are "
+            "fitted. Ignored if a model is provided with setModel().");
+    OpenSim_DECLARE_PROPERTY(output_model_file, std::string,
+            "Name of the .osim file to which the model with fitted paths is "
+            "written, relative to the results directory. If empty (default), "
+            "the model is not written to a file.");
+    OpenSim_DECLARE_PROPERTY(num_samples, int,
+            "Number of samples of the coordinate values to which the paths are "
+            "fitted. Default is 1000.");
+    OpenSim_DECLARE_PROPERTY(maximum_polynomial_order, int,
+            "The largest polynomial order (the largest sum of exponents in a "
+            "single term) used to fit a path. Default is 6.");
+    OpenSim_DECLARE_PROPERTY(path_length_tolerance, double,
+            "The largest acceptable root-mean-square error of the fitted path "
+            "lengths (m). Default is 1e-4.");
+    OpenSim_DECLARE_PROPERTY(moment_arm_tolerance, double,
+            "The largest acceptable root-mean-square error of the fitted "
+            "moment arms (m). Default is 1e-4.");
+    OpenSim_DECLARE_PROPERTY(moment_arm_threshold, double,
+            "A path is fitted as a function of a coordinate only if the "
+            "absolute moment arm of the path about the coordinate exceeds "
+            "this value for some sample (m). Default is 1e-3.");
+    OpenSim_DECLARE_PROPERTY(num_threads, int,
+            "Number of threads used to sample and fit the paths. A value of 0 "
+            "or less uses all available hardware threads. Default is 0.");
+
+//=============================================================================
+// METHODS
+//=============================================================================
+    //--------------------------------------------------------------------------
+    // CONSTRUCTION
+    //--------------------------------------------------------------------------
+public:
+    PolynomialPathFitter();
+    PolynomialPathFitter(const std::string& aFileName) SWIG_DECLARE_EXCEPTION;
+
+    //--------------------------------------------------------------------------
+    // GET AND SET
+    //--------------------------------------------------------------------------
+    /** Fit the paths of this model instead of the one in `model_file`. The
+    model is not modified; the fitted model is available from
+    getFittedModel() after run().                                            */
+    void setModel(const Model& model) { _model.reset(new Model(model)); }
+
+    void setModelFileName(const std::string& fileName) {
+        set_model_file(fileName);
+    }
+    const std::string& getModelFileName() const { return get_model_file(); }
+
+    void setOutputModelFileName(const std::string& fileName) {
+        set_output_model_file(fileName);
+    }
+    const std::string& getOutputModelFileName() const {
+        return get_output_model_file();
+    }
+
+    void setNumSamples(int numSamples) { set_num_samples(numSamples); }
+    int getNumSamples() const { return get_num_samples(); }
+
+    void setMaximumPolynomialOrder(int order) {
+        set_maximum_polynomial_order(order);
+    }
+    int getMaximumPolynomialOrder() const {
+        return get_maximum_polynomial_order();
+    }
+
+    void setPathLengthTolerance(double tol) { set_path_length_tolerance(tol); }
+    double getPathLengthTolerance() const {
+        return get_path_length_tolerance();
+    }
+
+    void setMomentArmTolerance(double tol) { set_moment_arm_tolerance(tol); }
+    double getMomentArmTolerance() const { return get_moment_arm_tolerance(); }
+
+    void setMomentArmThreshold(double threshold) {
+        set_moment_arm_threshold(threshold);
+    }
+    double getMomentArmThreshold() const {
+        return get_moment_arm_threshold();
+    }
+
+    void setNumThreads(int numThreads) { set_num_threads(numThreads); }
+    int getNumThreads() const { return get_num_threads(); }
+
+    /** The model with fitted paths, available after run().                  */
+    const Model& getFittedModel() const;
+
+    //--------------------------------------------------------------------------
+    // INTERFACE
+    //--------------------------------------------------------------------------
+    bool run() override SWIG_DECLARE_EXCEPTION;
+
+private:
+    void constructProperties();
+
+    SimTK::ResetOnCopy<std::unique_ptr<Model>> _model;
+    SimTK::ResetOnCopy<std::unique_ptr<Model>> _fittedModel;
+
+//=============================================================================
+};  // END of class PolynomialPathFitter
+
+} // namespace OpenSim
+
+#endif // OPENSIM_POLYNOMIAL_PATH_FITTER_H_
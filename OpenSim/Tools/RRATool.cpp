@@ -72,7 +72,8 @@ RRATool::RRATool() :
     _finalTimeForCOMAdjustment(_finalTimeForCOMAdjustmentProp.getValueDbl()),
     _adjustedCOMBody(_adjustedCOMBodyProp.getValueStr()),
     _outputModelFile(_outputModelFileProp.getValueStr()),
-    _verbose(_verboseProp.getValueBool())
+    _verbose(_verboseProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
 }
@@ -97,7 +98,8 @@ RRATool::RRATool(const string &aFileName, bool aLoadModel) :
     _finalTimeForCOMAdjustment(_finalTimeForCOMAdjustmentProp.getValueDbl()),
     _adjustedCOMBody(_adjustedCOMBodyProp.getValueStr()),
     _outputModelFile(_outputModelFileProp.getValueStr()),
-    _verbose(_verboseProp.getValueBool())
+    _verbose(_verboseProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
     updateFromXMLDocument();
@@ -162,7 +164,8 @@ RRATool(const RRATool &aTool) :
     _finalTimeForCOMAdjustment(_finalTimeForCOMAdjustmentProp.getValueDbl()),
     _adjustedCOMBody(_adjustedCOMBodyProp.getValueStr()),
     _outputModelFile(_outputModelFileProp.getValueStr()),
-    _verbose(_verboseProp.getValueBool())
+    _verbose(_verboseProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
     *this = aTool;
@@ -194,6 +197,7 @@ setNull()
     _outputModelFile = "";
     _adjustKinematicsToReduceResiduals=true;
     _verbose = false;
+    _numThreads = 1;
     _targetDT = .001;
     _replaceForceSet = false;   // default should be false for Forward.
 
@@ -293,6 +297,14 @@ void RRATool::setupProperties()
     _verboseProp.setName("use_verbose_printing");
     _propertySet.append( &_verboseProp );
 
+    comment = "Number of threads used to compute the effects of the actuators on the tracked "
+                 "accelerations in each time window. Each thread realizes its own copy of the state. "
+                 "A value of 0 or less uses all available hardware threads. Default is 1.";
+    _numThreadsProp.setComment(comment);
+    _numThreadsProp.setName("num_threads");
+    _numThreadsProp.setValue(1);
+    _propertySet.append( &_numThreadsProp );
+
 }
 
 
@@ -327,6 +339,7 @@ operator=(const RRATool &aTool)
     _initialTimeForCOMAdjustment = aTool._initialTimeForCOMAdjustment;
     _finalTimeForCOMAdjustment = aTool._finalTimeForCOMAdjustment;
     _verbose = aTool._verbose;
+    _numThreads = aTool._numThreads;
 
     return(*this);
 }
@@ -472,7 +485,7 @@ bool RRATool::run()
     // filtered trajectories
     if(desiredPointsFlag) {
         desiredPointsStore->pad(60);
-        desiredPointsStore->print("desiredPoints_padded.sto");
+        if (_verbose) desiredPointsStore->print("desiredPoints_padded.sto");
         if(_lowpassCutoffFrequency>=0) {
             int order = 50;
             log_info("Low-pass filtering desired points with a cutoff "
@@ -674,7 +687,9 @@ bool RRATool::run()
     if(false) {
         target = new ActuatorForceTargetFast(s, na,controller);
     } else {
-        target = new ActuatorForceTarget(na,controller);
+        ActuatorForceTarget* forceTarget = new ActuatorForceTarget(na,controller);
+        forceTarget->setNumThreads(_numThreads);
+        target = forceTarget;
     }
     target->setDX(_numericalDerivativeStepSize);
 
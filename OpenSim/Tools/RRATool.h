@@ -117,6 +117,10 @@ private:
     /** Flag for turning on and off verbose printing. */
     PropertyBool _verboseProp;
     bool &_verbose;
+    /** Number of threads used to compute the effects of the actuators in
+    each time window. */
+    PropertyInt _numThreadsProp;
+    int &_numThreads;
 
     ForceSet _originalForceSet;
 
@@ -173,6 +177,14 @@ public:
     double getLowpassCutoffFrequency() const { return _lowpassCutoffFrequency; }
     void setLowpassCutoffFrequency(double aLowpassCutoffFrequency) { _lowpassCutoffFrequency = aLowpassCutoffFrequency; }
 
+    /**
+     * get/set the number of threads used to compute the effects of the
+     * actuators in each time window. A value of 0 or less uses all available
+     * hardware threads.
+     */
+    int getNumThreads() const { return _numThreads; }
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+
     // External loads get/set
     const std::string &getExternalLoadsFileName() const { return _externalLoadsFileName; }
     void setExternalLoadsFileName(const std::string &aFileName) { _externalLoadsFileName = aFileName; }
@@ -36,6 +36,7 @@
 #include "IMUInverseKinematicsTool.h"
 
 #include "InverseDynamicsTool.h"
+#include "PolynomialPathFitter.h"
 
 #include "GenericModelMaker.h"
 #include "IKCoordinateTask.h"
@@ -103,6 +104,7 @@ OSIMTOOLS_API void RegisterTypes_osimTools()
     Object::registerType( InverseKinematicsTool() );
     Object::registerType( IMUInverseKinematicsTool());
     Object::registerType( InverseDynamicsTool() );
+    Object::registerType( PolynomialPathFitter() );
     // Old versions
     Object::RenameType("rdCMC_Joint",   "CMC_Joint");
     Object::RenameType("rdCMC_Point",   "CMC_Point");
@@ -124,5 +126,5 @@ osimToolsInstantiator::osimToolsInstantiator()
 
 void osimToolsInstantiator::registerDllClasses()
 {
-       RegisterTypes_osimTools();
+       Object::deferTypeRegistration(RegisterTypes_osimTools);
 }
\ No newline at end of file
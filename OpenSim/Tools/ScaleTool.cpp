@@ -25,10 +25,15 @@
 // INCLUDES
 //=============================================================================
 #include "ScaleTool.h"
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/MarkerData.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include "GenericModelMaker.h"
 
+#include <map>
+#include <mutex>
+
 //=============================================================================
 // STATICS
 //=============================================================================
@@ -260,10 +265,32 @@ bool ScaleTool::run() const {
         throw Exception(msg, __FILE__, __LINE__);
     }
 
-    if (!isDefaultModelScaler() && getModelScaler().getApply())
+    return processModel(model.get());
+}
+
+bool ScaleTool::processModel(Model* model) const {
+    // The ModelScaler and MarkerPlacer usually use the same (static trial)
+    // marker file, which is read only once for both.
+    const auto isSet = [](const std::string& fileName) {
+        return !fileName.empty() && fileName != PropertyStr::getDefaultStr();
+    };
+    const bool scale = !isDefaultModelScaler() && getModelScaler().getApply();
+    const bool place = !isDefaultMarkerPlacer();
+    std::unique_ptr<MarkerData> markerData;
+    if (scale && isSet(getModelScaler().getMarkerFileName())) {
+        markerData.reset(new MarkerData(
+                getPathToSubject() + getModelScaler().getMarkerFileName()));
+    }
+    const bool shareMarkerData = markerData && place &&
+            getMarkerPlacer().getApply() &&
+            getMarkerPlacer().getStaticPoseFileName() ==
+                    getModelScaler().getMarkerFileName();
+
+    if (scale)
     {
         const ModelScaler& scaler = getModelScaler();
-        if(!scaler.processModel(model.get(), getPathToSubject(), getSubjectMass())) {
+        if(!scaler.processModel(model, getPathToSubject(), getSubjectMass(),
+                   markerData.get())) {
             return false;
         }
     }
@@ -273,10 +300,11 @@ bool ScaleTool::run() const {
             "Model is not scaled.");
     }
 
-    if (!isDefaultMarkerPlacer())
+    if (place)
     {
         const MarkerPlacer& placer = getMarkerPlacer();
-        if(!placer.processModel(model.get(), getPathToSubject())) {
+        if(!placer.processModel(model, getPathToSubject(),
+                   shareMarkerData ? markerData.get() : nullptr)) {
             return false;
         }
     }
@@ -287,3 +315,74 @@ bool ScaleTool::run() const {
     }
     return true;
 }
+
+std::vector<bool> ScaleTool::runBatch(
+        const std::vector<std::string>& setupFiles, int numThreads) {
+    const int numSubjects = (int)setupFiles.size();
+
+    // Read the setup files and load the generic models on this thread, since
+    // reading files changes the working directory of the process. The
+    // subjects are then processed with absolute paths only.
+    std::vector<std::unique_ptr<ScaleTool>> tools;
+    for (const auto& setupFile : setupFiles) {
+        tools.emplace_back(new ScaleTool(setupFile));
+        tools.back()->setPathToSubject(IO::getParentDirectory(
+                SimTK::Pathname::getAbsolutePathname(setupFile)));
+    }
+    std::map<std::pair<std::string, std::string>, std::unique_ptr<Model>>
+            genericModels;
+    std::vector<const Model*> toolGenericModels(numSubjects, nullptr);
+    for (int i = 0; i < numSubjects; ++i) {
+        const ScaleTool& tool = *tools[i];
+        if (tool.isDefaultGenericModelMaker()) {
+            log_warn("ScaleTool::runBatch: Unscaled model not specified for "
+                     "subject {}.", tool.getName());
+            continue;
+        }
+        const GenericModelMaker& maker = tool.getGenericModelMaker();
+        const std::string& path = tool.getPathToSubject();
+        const auto key = std::make_pair(
+                SimTK::Pathname::
+                        getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                                path, maker.getModelFileName()),
+                maker.getMarkerSetFileName() == "Unassigned"
+                        ? std::string()
+                        : SimTK::Pathname::
+                          getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                                  path, maker.getMarkerSetFileName()));
+        auto it = genericModels.find(key);
+        if (it == genericModels.end()) {
+            it = genericModels.emplace(key, std::unique_ptr<Model>(
+                    maker.processModel(path))).first;
+        }
+        toolGenericModels[i] = it->second.get();
+        if (!toolGenericModels[i]) {
+            log_error("Unable to load the generic model or marker set file "
+                      "of subject {}.", tool.getName());
+        }
+    }
+
+    // The working directory may still be changed by other threads (e.g.,
+    // when printing the result files), so restore it once at the end.
+    auto cwd = IO::CwdChanger::changeTo(IO::getCwd());
+    std::vector<char> success(numSubjects, false);
+    std::mutex copyMutex;
+    parallelForEach(numSubjects, numThreads, [&](int, int i) {
+        const ScaleTool& tool = *tools[i];
+        if (!toolGenericModels[i]) return;
+        log_info("Processing subject {}...", tool.getName());
+        std::unique_ptr<Model> model;
+        {
+            std::lock_guard<std::mutex> lock(copyMutex);
+            model.reset(toolGenericModels[i]->clone());
+        }
+        model->setName(tool.getName());
+        try {
+            success[i] = tool.processModel(model.get());
+        } catch (const std::exception& e) {
+            log_error("ScaleTool::runBatch: Scaling subject {} failed: {}",
+                    tool.getName(), e.what());
+        }
+    });
+    return std::vector<bool>(success.begin(), success.end());
+}
@@ -115,6 +115,18 @@ public:
      * @returns whether or not the scale procedure was successful. */
     bool run() const;
 
+    /** Run the ScaleTool of each of `setupFiles` (e.g., one per subject), as
+     * with run(), on `numThreads` threads (see getNumThreadsOrDefault()).
+     * The generic models are loaded before scaling, once for each distinct
+     * pair of model and marker set files, and each subject is scaled with
+     * its own copy of its generic model. The files of each subject are
+     * resolved relative to the absolute directory of its setup file. A
+     * subject whose scaling fails (or throws) does not stop the others.
+     * @returns whether or not the scale procedure of each subject was
+     * successful. */
+    static std::vector<bool> runBatch(
+            const std::vector<std::string>& setupFiles, int numThreads = -1);
+
     bool isDefaultGenericModelMaker() const
     { return _genericModelMakerProp.getValueIsDefault(); }
     bool isDefaultModelScaler() const
@@ -157,6 +169,9 @@ protected:
 private:
     void setNull();
     void setupProperties();
+    /** Scale `model` (which createModel() created) and place its markers,
+     * reading each marker file once for both steps. */
+    bool processModel(Model* model) const;
 //=============================================================================
 };  // END of class ScaleTool
 //=============================================================================
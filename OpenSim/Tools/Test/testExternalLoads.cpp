@@ -246,6 +246,35 @@ void testExternalLoad()
 
     // kinematics should match to within integ accuracy
     ASSERT_EQUAL(0.0, norm_err, integ_accuracy);
+
+    // Re-express the force in ground and the point in the applied body once
+    // for the known kinematics instead.
+    extLoads->setSize(0);
+    extLoads->adoptAndAppend(&xf2);
+    extLoads->setDataFileName(forceStore2.getName());
+    model.initSystem();
+    extLoads->transformToAppliedBodies(*qStore);
+    ASSERT(extLoads->get(0).getPointExpressedInBodyName() == pendBodyName);
+    ASSERT(extLoads->get(0).getForceExpressedInBodyName() == "ground");
+
+    SimTK::State &s4 = model.initSystem();
+    model.updGravityForce().disable(s4);
+    model.updCoordinateSet()[0].setValue(s4, q_init);
+
+    Manager manager4(model);
+    manager4.setIntegratorAccuracy(integ_accuracy);
+    s4.setTime(init_t);
+    manager4.initialize(s4);
+
+    Vector_<double> q_xf3(nsteps+1);
+    for(int i = 0; i < nsteps+1; i++){
+        manager4.integrate(dt*i);
+        q_xf3[i] = model.updCoordinateSet()[0].getValue(s4);
+    }
+
+    err = q_xf3-q_grav;
+    norm_err = err.norm();
+    ASSERT_EQUAL(0.0, norm_err, integ_accuracy);
 }
 
 // Ensure the default values for the ExternalForce properties work as expected.
@@ -0,0 +1,100 @@
+/* -------------------------------------------------------------------------- *
+ *                  OpenSim:  testPolynomialPathFitter.cpp                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Simulation/Model/FunctionBasedPath.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/PathSpring.h>
+#include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
+#include <OpenSim/Simulation/SimbodyEngine/SliderJoint.h>
+#include <OpenSim/Tools/PolynomialPathFitter.h>
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch/catch.hpp>
+
+using namespace OpenSim;
+
+namespace {
+    // A body on a pin joint (and a locked slider), spanned by a path spring
+    // whose length depends only on the pin angle.
+    Model createModel() {
+        Model model;
+        model.setName("pin_with_spring");
+        auto* carriage = new Body("carriage", 1, SimTK::Vec3(0),
+                SimTK::Inertia(1));
+        auto* slider = new SliderJoint("slider", model.getGround(),
+                *carriage);
+        slider->updCoordinate().setName("x");
+        slider->updCoordinate().setDefaultLocked(true);
+        auto* arm = new Body("arm", 1, SimTK::Vec3(0), SimTK::Inertia(1));
+        auto* pin = new PinJoint("pin", *carriage, *arm);
+        Coordinate& q = pin->updCoordinate();
+        q.setName("q");
+        q.setRangeMin(-1);
+        q.setRangeMax(1);
+        model.addBody(carriage);
+        model.addBody(arm);
+        model.addJoint(slider);
+        model.addJoint(pin);
+
+        auto* spring = new PathSpring("spring", 0.1, 100, 0);
+        spring->updGeometryPath().appendNewPathPoint(
+                "origin", *carriage, SimTK::Vec3(-0.2, 0, 0));
+        spring->updGeometryPath().appendNewPathPoint(
+                "insertion", *arm, SimTK::Vec3(0.3, 0, 0));
+        model.addForce(spring);
+        model.finalizeConnections();
+        return model;
+    }
+}
+
+TEST_CASE("PolynomialPathFitter replaces GeometryPaths") {
+    Model model = createModel();
+
+    PolynomialPathFitter fitter;
+    fitter.setModel(model);
+    fitter.setNumSamples(100);
+    fitter.setNumThreads(2);
+    REQUIRE(fitter.run());
+
+    Model fitted = fitter.getFittedModel();
+    const auto& spring = fitted.getComponent<PathSpring>("/forceset/spring");
+    const auto* path = spring.tryGetPath<FunctionBasedPath>();
+    REQUIRE(path);
+    // The locked slider is not an argument of the length function.
+    REQUIRE(path->getProperty_coordinate_paths().size() == 1);
+    CHECK(path->get_coordinate_paths(0) == "/jointset/pin/q");
+
+    SimTK::State& sOrig = model.initSystem();
+    SimTK::State& sFit = fitted.initSystem();
+    const auto& orig = model.getComponent<PathSpring>("/forceset/spring");
+    const auto& qOrig = model.getCoordinateSet().get("q");
+    const auto& qFit = fitted.getCoordinateSet().get("q");
+    for (double angle = -0.9; angle <= 0.9; angle += 0.3) {
+        qOrig.setValue(sOrig, angle);
+        qFit.setValue(sFit, angle);
+        CHECK(path->getLength(sFit) ==
+                Approx(orig.getLength(sOrig)).margin(1e-3));
+        CHECK(path->computeMomentArm(sFit, qFit) ==
+                Approx(orig.getPath().computeMomentArm(sOrig, qOrig))
+                        .margin(1e-3));
+    }
+}
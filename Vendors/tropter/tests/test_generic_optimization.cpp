@@ -273,3 +273,48 @@ TEST_CASE("OptimizerSolver options") {
 }
 
 
+
+/// The control flow of the objective depends on the variable: the objective is
+/// continuously differentiable, but has different expressions on either side
+/// of x = 1. A tape recorded at x < 1 is not valid at the minimum, x = 2 (the
+/// expression for x < 1 decreases up to the upper bound).
+template<typename T>
+class Piecewise : public Problem<T> {
+public:
+    Piecewise() : Problem<T>(1, 0) {
+        this->set_variable_bounds(VectorXd::Constant(1, 0),
+                                  VectorXd::Constant(1, 5));
+    }
+    void calc_objective(const VectorX<T>& x, T& obj_value) const override {
+        if (x[0] >= 1) {
+            obj_value = (x[0] - 2) * (x[0] - 2);
+        } else {
+            obj_value = 1 + 2 * (1 - x[0]) + 0.1 * (1 - x[0]) * (1 - x[0]);
+        }
+    }
+};
+
+TEST_CASE("ADOL-C tapes are re-recorded when the control flow changes",
+        "[adolc]") {
+    Piecewise<adouble> problem;
+    IPOPTSolver solver(problem);
+    // Record the tapes at the guess, on the x < 1 branch.
+    solver.set_sparsity_detection("initial-guess");
+    const VectorXd guess = VectorXd::Constant(1, 0.5);
+
+    SECTION("check") {
+        solver.set_ad_retaping("check");
+        const auto solution = solver.optimize(guess);
+        REQUIRE(Approx(solution.variables[0]).margin(1e-6) == 2);
+        REQUIRE(Approx(solution.objective).margin(1e-10) == 0);
+    }
+    SECTION("always") {
+        solver.set_ad_retaping("always");
+        const auto solution = solver.optimize(guess);
+        REQUIRE(Approx(solution.variables[0]).margin(1e-6) == 2);
+    }
+    SECTION("invalid") {
+        REQUIRE_THROWS_WITH(solver.set_ad_retaping("sometimes"),
+                Catch::Contains("Invalid value for ad_retaping"));
+    }
+}
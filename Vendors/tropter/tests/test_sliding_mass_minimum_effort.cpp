@@ -188,6 +188,31 @@ TEST_CASE("IPOPT") {
     }
 }
 
+TEST_CASE("Evaluating mesh points in parallel matches serial evaluation") {
+    for (const std::string transcription : {"trapezoidal", "hermite-simpson"}) {
+        auto solve = [&](int num_threads) {
+            auto ocp = std::make_shared<SlidingMass<double>>();
+            DirectCollocationSolver<double> dircol(
+                    ocp, transcription, "ipopt", 25);
+            std::vector<std::shared_ptr<const Problem<double>>> copies;
+            for (int i = 1; i < num_threads; ++i) {
+                copies.push_back(std::make_shared<SlidingMass<double>>());
+            }
+            dircol.set_thread_problems(copies);
+            REQUIRE(dircol.get_num_threads() == num_threads);
+            dircol.get_opt_solver().set_findiff_hessian_step_size(1e-3);
+            dircol.get_opt_solver().set_hessian_approximation("exact");
+            return dircol.solve();
+        };
+        Solution serial = solve(1);
+        Solution parallel = solve(4);
+        REQUIRE(parallel.success);
+        REQUIRE(parallel.num_iterations == serial.num_iterations);
+        TROPTER_REQUIRE_EIGEN_ABS(parallel.states, serial.states, 1e-10);
+        TROPTER_REQUIRE_EIGEN_ABS(parallel.controls, serial.controls, 1e-10);
+    }
+}
+
 #if defined(TROPTER_WITH_SNOPT)
 TEST_CASE("SNOPT, trapezoidal") {
 
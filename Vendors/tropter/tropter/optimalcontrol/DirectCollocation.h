@@ -21,6 +21,7 @@
 #include "Iterate.h"
 #include <fstream>
 #include <memory>
+#include <vector>
 
 namespace tropter {
 
@@ -100,6 +101,19 @@ public:
     bool get_interpolate_control_midpoints() const
     { return m_interpolate_control_midpoints; }
 
+    /// Evaluate the optimal control problem at the mesh points on multiple
+    /// threads: the calling thread, with the problem given to the
+    /// constructor, and one additional thread for each of these problems. Each
+    /// problem must be an independent copy of the original problem (same
+    /// variables, and no mutable state shared with the other problems), as
+    /// the problems are evaluated concurrently. Pass an empty vector (default)
+    /// to evaluate the mesh points serially. This setting is copied into the
+    /// underlying transcription scheme, and only has an effect if T is double.
+    void set_thread_problems(
+            std::vector<std::shared_ptr<const OCProblem>> problems);
+    /// The number of threads on which the mesh points are evaluated.
+    int get_num_threads() const;
+
     /// Solve the problem using an initial guess that is based on the bounds
     /// on the variables.
     Solution solve() const;
@@ -92,6 +92,35 @@ void DirectCollocationSolver<T>::set_interpolate_control_midpoints(bool tf) {
     m_interpolate_control_midpoints = tf;
 }
 
+template<typename T>
+void DirectCollocationSolver<T>::set_thread_problems(
+        std::vector<std::shared_ptr<const OCProblem>> problems) {
+    for (const auto& problem : problems) {
+        TROPTER_THROW_IF(!problem, "Expected non-null thread problems.");
+        TROPTER_THROW_IF(
+                problem->get_num_states() != m_ocproblem->get_num_states() ||
+                problem->get_num_controls() !=
+                        m_ocproblem->get_num_controls() ||
+                problem->get_num_adjuncts() !=
+                        m_ocproblem->get_num_adjuncts() ||
+                problem->get_num_diffuses() !=
+                        m_ocproblem->get_num_diffuses() ||
+                problem->get_num_parameters() !=
+                        m_ocproblem->get_num_parameters() ||
+                problem->get_num_path_constraints() !=
+                        m_ocproblem->get_num_path_constraints() ||
+                problem->get_num_costs() != m_ocproblem->get_num_costs(),
+                "Expected the thread problems to have the same variables, "
+                "path constraints, and costs as the problem.");
+    }
+    m_transcription->set_thread_ocproblems(std::move(problems));
+}
+
+template<typename T>
+int DirectCollocationSolver<T>::get_num_threads() const {
+    return m_transcription->get_num_threads();
+}
+
 template<typename T>
 Solution DirectCollocationSolver<T>::solve() const
 {
@@ -20,6 +20,12 @@
 #include <tropter/optimization/ProblemDecorator_double.h>
 #include <tropter/optimization/ProblemDecorator_adouble.h>
 #include <tropter/optimalcontrol/Iterate.h>
+#include <tropter/optimalcontrol/Problem.h>
+#include <tropter/utilities.h>
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
 
 //namespace transcription {
 //
@@ -58,6 +64,8 @@ namespace transcription {
 template<typename T>
 class Base : public optimization::Problem<T> {
 public:
+    typedef tropter::Problem<T> OCProblem;
+
     /// Create a vector of optimization variables (for the generic
     /// optimization problem) from an states and controls.
     virtual Eigen::VectorXd
@@ -96,8 +104,82 @@ public:
     std::string get_exact_hessian_block_sparsity_mode () const
     {   return m_exact_hessian_block_sparsity_mode; }
 
+    /// Evaluate the differential-algebraic equations and the cost integrands
+    /// at the mesh points in parallel: the mesh points are split into
+    /// contiguous ranges, the first evaluated with the transcribed optimal
+    /// control problem and each of the others with one of these problems.
+    /// Each problem must be an independent copy of the transcribed problem
+    /// (with the same variables), as the problems are evaluated concurrently.
+    /// The problems are initialized on the mesh, and on the parameters of
+    /// each iterate, along with the transcribed problem. Only transcriptions
+    /// with T = double evaluate in parallel (recording derivatives with
+    /// ADOL-C is not thread-safe); otherwise, these problems are unused.
+    void set_thread_ocproblems(
+            std::vector<std::shared_ptr<const OCProblem>> ocproblems) {
+        for (const auto& ocproblem : ocproblems) {
+            TROPTER_THROW_IF(!ocproblem, "Expected non-null thread problems.");
+            if (m_mesh.size()) ocproblem->initialize_on_mesh(m_mesh);
+        }
+        m_thread_ocproblems = std::move(ocproblems);
+        m_thread_pool.reset();
+        if (std::is_same<T, double>::value && !m_thread_ocproblems.empty()) {
+            m_thread_pool.reset(
+                    new ThreadPool((int)m_thread_ocproblems.size() + 1));
+        }
+    }
+    /// The number of threads on which the mesh points are evaluated.
+    int get_num_threads() const
+    {   return m_thread_pool ? m_thread_pool->get_num_threads() : 1; }
+
+protected:
+    /// Initialize `ocproblem` and the thread problems (see
+    /// set_thread_ocproblems()) on the given mesh.
+    void initialize_ocproblems_on_mesh(const OCProblem& ocproblem,
+            const Eigen::VectorXd& mesh) {
+        m_mesh = mesh;
+        ocproblem.initialize_on_mesh(m_mesh);
+        for (const auto& thread_ocproblem : m_thread_ocproblems) {
+            thread_ocproblem->initialize_on_mesh(m_mesh);
+        }
+    }
+    /// Initialize the thread problems on the parameters of an iterate (in
+    /// parallel). The transcribed problem is initialized separately.
+    void initialize_thread_ocproblems_on_iterate(
+            const VectorX<T>& parameters) const {
+        if (!m_thread_pool) return;
+        m_thread_pool->parallel_for_each((int)m_thread_ocproblems.size(),
+                [&](int index) {
+                    m_thread_ocproblems[index]->initialize_on_iterate(
+                            parameters);
+                });
+    }
+    /// Invoke `func(problem, begin, end)` for contiguous ranges [begin, end)
+    /// that together cover [0, num_points), each on its own thread with its
+    /// own problem: `ocproblem` (the transcribed problem) for the first range
+    /// and the thread problems for the others. `func` must only write outputs
+    /// of the points in its range.
+    void for_each_point_range(const OCProblem& ocproblem, int num_points,
+            const std::function<void(const OCProblem&, int, int)>& func)
+            const {
+        const int num_ranges = m_thread_pool
+                ? std::min(m_thread_pool->get_num_threads(), num_points) : 1;
+        if (num_ranges <= 1) {
+            func(ocproblem, 0, num_points);
+            return;
+        }
+        m_thread_pool->parallel_for_each(num_ranges, [&](int index) {
+            const OCProblem& problem =
+                    index == 0 ? ocproblem : *m_thread_ocproblems[index - 1];
+            func(problem, index * num_points / num_ranges,
+                    (index + 1) * num_points / num_ranges);
+        });
+    }
+
 private:
     std::string m_exact_hessian_block_sparsity_mode{"dense"};
+    Eigen::VectorXd m_mesh;
+    std::vector<std::shared_ptr<const OCProblem>> m_thread_ocproblems;
+    std::unique_ptr<ThreadPool> m_thread_pool;
 
 };
 
@@ -315,7 +315,7 @@ void HermiteSimpson<T>::set_ocproblem(
             m_mesh_and_midpoints[i] = 0.5 * (m_mesh[i / 2] + m_mesh[i / 2 + 1]);
         }
     }
-    m_ocproblem->initialize_on_mesh(m_mesh_and_midpoints);
+    this->initialize_ocproblems_on_mesh(*m_ocproblem, m_mesh_and_midpoints);
 }
 
 template <typename T>
@@ -337,6 +337,7 @@ void HermiteSimpson<T>::calc_objective(
     // Initialize on iterate.
     // ----------------------
     m_ocproblem->initialize_on_iterate(parameters);
+    this->initialize_thread_ocproblems_on_iterate(parameters);
 
     for (int i_cost = 0; i_cost < m_ocproblem->get_num_costs(); ++i_cost) {
         // Compute integral.
@@ -344,27 +345,28 @@ void HermiteSimpson<T>::calc_objective(
         T integral = 0;
         if (m_ocproblem->get_cost_requires_integral(i_cost)) {
             m_integrand.setZero();
-            int i_diff = 0;
-            // TODO avoid this copy. use Ref?
-            VectorX<T> diffuse_to_use;
-            for (int i_col = 0; i_col < m_num_col_points; ++i_col) {
-                const T time =
-                        duration * m_mesh_and_midpoints[i_col] + initial_time;
-                // Only pass diffuse variables on the midpoints where they are
-                // defined, otherwise pass an empty variable.
-                if (i_col % 2) {
-                    diffuse_to_use = diffuses.col(i_diff);
-                    ++i_diff;
-                } else {
-                    diffuse_to_use = m_empty_diffuse_col;
-                }
+            this->for_each_point_range(*m_ocproblem, m_num_col_points,
+                    [&](const OCProblem& ocproblem, int begin, int end) {
+                // TODO avoid this copy. use Ref?
+                VectorX<T> diffuse_to_use;
+                for (int i_col = begin; i_col < end; ++i_col) {
+                    const T time = duration * m_mesh_and_midpoints[i_col] +
+                                   initial_time;
+                    // Only pass diffuse variables on the midpoints where they
+                    // are defined, otherwise pass an empty variable.
+                    if (i_col % 2) {
+                        diffuse_to_use = diffuses.col(i_col / 2);
+                    } else {
+                        diffuse_to_use = m_empty_diffuse_col;
+                    }
 
-                m_ocproblem->calc_cost_integrand(i_cost,
-                        {i_col, time, states.col(i_col), controls.col(i_col),
-                                adjuncts.col(i_col), diffuse_to_use,
-                                parameters},
-                        m_integrand[i_col]);
-            }
+                    ocproblem.calc_cost_integrand(i_cost,
+                            {i_col, time, states.col(i_col),
+                                    controls.col(i_col), adjuncts.col(i_col),
+                                    diffuse_to_use, parameters},
+                            m_integrand[i_col]);
+                }
+            });
 
             for (int i_col = 0; i_col < m_num_col_points; ++i_col) {
                 integral += m_simpson_quadrature_coefficients[i_col] *
@@ -394,7 +396,6 @@ void HermiteSimpson<T>::calc_objective(
 template <typename T>
 void HermiteSimpson<T>::calc_constraints(
         const VectorX<T>& x, Eigen::Ref<VectorX<T>> constraints) const {
-    // TODO parallelize.
     const T& initial_time = x[0];
     const T& final_time = x[1];
     const T duration = final_time - initial_time;
@@ -408,6 +409,7 @@ void HermiteSimpson<T>::calc_constraints(
     // Initialize on iterate.
     // ======================
     m_ocproblem->initialize_on_iterate(parameters);
+    this->initialize_thread_ocproblems_on_iterate(parameters);
 
     // Organize the constrants vector.
     ConstraintsView constr_view = make_constraints_view(constraints);
@@ -418,29 +420,41 @@ void HermiteSimpson<T>::calc_constraints(
 
     // Obtain state derivatives at each mesh point.
     // --------------------------------------------
-    // Evaluate points on the mesh.
-    int i_mesh = 0;
-    for (int i_col = 0; i_col < m_num_col_points; i_col += 2) {
-        const T time = duration * m_mesh_and_midpoints[i_col] + initial_time;
-        m_ocproblem->calc_differential_algebraic_equations(
-                {i_col, time, states.col(i_col), controls.col(i_col),
-                        adjuncts.col(i_col), m_empty_diffuse_col, parameters},
-                {m_derivs_mesh.col(i_mesh),
-                        constr_view.path_constraints.col(i_mesh)});
-        i_mesh++;
-    }
-    // Evaluate points on the mesh interval interior.
-    int i_mid = 0;
-    for (int i_col = 1; i_col < m_num_col_points; i_col += 2) {
-        const T time = duration * m_mesh_and_midpoints[i_col] + initial_time;
-        m_ocproblem->calc_differential_algebraic_equations(
-                {i_col, time, states.col(i_col), controls.col(i_col),
-                        adjuncts.col(i_col), diffuses.col(i_mid), parameters},
-                {m_derivs_mid.col(i_mid), m_empty_path_constraint_col});
-        TROPTER_THROW_IF(m_empty_path_constraint_col.size() != 0,
-                "Invalid resize of empty path constraint output.");
-        i_mid++;
-    }
+    // Evaluate points on the mesh (even collocation points) and on the mesh
+    // interval interior (odd collocation points). The points are evaluated in
+    // parallel if there are thread problems (see set_thread_ocproblems()).
+    this->for_each_point_range(*m_ocproblem, m_num_col_points,
+            [&](const OCProblem& ocproblem, int begin, int end) {
+        // This empty vector is passed to
+        // calc_differential_algebraic_equations() for collocation points not
+        // on the mesh where we do not enforce path constraints. If the user
+        // tries to write to it, an Eigen runtime assertion will be violated.
+        // If the user tries to resize it, tropter will throw an exception
+        // after exiting the function call. Each range has its own vector.
+        VectorX<T> empty_path_constraint_col;
+        for (int i_col = begin; i_col < end; ++i_col) {
+            const T time =
+                    duration * m_mesh_and_midpoints[i_col] + initial_time;
+            if (i_col % 2 == 0) {
+                const int i_mesh = i_col / 2;
+                ocproblem.calc_differential_algebraic_equations(
+                        {i_col, time, states.col(i_col), controls.col(i_col),
+                                adjuncts.col(i_col), m_empty_diffuse_col,
+                                parameters},
+                        {m_derivs_mesh.col(i_mesh),
+                                constr_view.path_constraints.col(i_mesh)});
+            } else {
+                const int i_mid = i_col / 2;
+                ocproblem.calc_differential_algebraic_equations(
+                        {i_col, time, states.col(i_col), controls.col(i_col),
+                                adjuncts.col(i_col), diffuses.col(i_mid),
+                                parameters},
+                        {m_derivs_mid.col(i_mid), empty_path_constraint_col});
+                TROPTER_THROW_IF(empty_path_constraint_col.size() != 0,
+                        "Invalid resize of empty path constraint output.");
+            }
+        }
+    });
 
     // Compute constraint defects.
     // ---------------------------
@@ -212,7 +212,7 @@ void Trapezoidal<T>::set_ocproblem(std::shared_ptr<const OCProblem> ocproblem) {
     m_integrand.resize(m_num_mesh_points);
     m_derivs.resize(m_num_states, m_num_mesh_points);
 
-    m_ocproblem->initialize_on_mesh(m_mesh_eigen);
+    this->initialize_ocproblems_on_mesh(*m_ocproblem, m_mesh_eigen);
 }
 
 template <typename T>
@@ -232,6 +232,7 @@ void Trapezoidal<T>::calc_objective(const VectorX<T>& x, T& obj_value) const {
     // Initialize on iterate.
     // ----------------------
     m_ocproblem->initialize_on_iterate(parameters);
+    this->initialize_thread_ocproblems_on_iterate(parameters);
 
     for (int i_cost = 0; i_cost < m_ocproblem->get_num_costs(); ++i_cost) {
         // Compute integral.
@@ -239,14 +240,17 @@ void Trapezoidal<T>::calc_objective(const VectorX<T>& x, T& obj_value) const {
         T integral = 0;
         if (m_ocproblem->get_cost_requires_integral(i_cost)) {
             m_integrand.setZero();
-            for (int i_mesh = 0; i_mesh < m_num_mesh_points; ++i_mesh) {
-                const T time = duration * m_mesh[i_mesh] + initial_time;
-                m_ocproblem->calc_cost_integrand(i_cost,
-                        {i_mesh, time, states.col(i_mesh), controls.col(i_mesh),
-                                adjuncts.col(i_mesh), m_empty_diffuse_col,
-                                parameters},
-                        m_integrand[i_mesh]);
-            }
+            this->for_each_point_range(*m_ocproblem, m_num_mesh_points,
+                    [&](const OCProblem& ocproblem, int begin, int end) {
+                for (int i_mesh = begin; i_mesh < end; ++i_mesh) {
+                    const T time = duration * m_mesh[i_mesh] + initial_time;
+                    ocproblem.calc_cost_integrand(i_cost,
+                            {i_mesh, time, states.col(i_mesh),
+                                    controls.col(i_mesh), adjuncts.col(i_mesh),
+                                    m_empty_diffuse_col, parameters},
+                            m_integrand[i_mesh]);
+                }
+            });
 
             for (int i_mesh = 0; i_mesh < m_num_mesh_points; ++i_mesh) {
                 integral += m_trapezoidal_quadrature_coefficients[i_mesh] *
@@ -276,7 +280,6 @@ void Trapezoidal<T>::calc_objective(const VectorX<T>& x, T& obj_value) const {
 template <typename T>
 void Trapezoidal<T>::calc_constraints(
         const VectorX<T>& x, Eigen::Ref<VectorX<T>> constraints) const {
-    // TODO parallelize.
     const T& initial_time = x[0];
     const T& final_time = x[1];
     const T duration = final_time - initial_time;
@@ -288,6 +291,7 @@ void Trapezoidal<T>::calc_constraints(
     // Initialize on iterate.
     // ======================
     m_ocproblem->initialize_on_iterate(parameters);
+    this->initialize_thread_ocproblems_on_iterate(parameters);
 
     // Organize the constraints vector.
     ConstraintsView constr_view = make_constraints_view(constraints);
@@ -300,16 +304,20 @@ void Trapezoidal<T>::calc_constraints(
     // --------------------------------------------
     // TODO storing 1 too many derivatives trajectory; don't need the first
     // xdot (at t0). (TODO I don't think this is true anymore).
-    // TODO tradeoff between memory and parallelism.
-    for (int i_mesh = 0; i_mesh < m_num_mesh_points; ++i_mesh) {
-        // TODO should pass the time.
-        const T time = duration * m_mesh[i_mesh] + initial_time;
-        m_ocproblem->calc_differential_algebraic_equations(
-                {i_mesh, time, states.col(i_mesh), controls.col(i_mesh),
-                        adjuncts.col(i_mesh), m_empty_diffuse_col, parameters},
-                {m_derivs.col(i_mesh),
-                        constr_view.path_constraints.col(i_mesh)});
-    }
+    // The mesh points are evaluated in parallel if there are thread problems
+    // (see set_thread_ocproblems()).
+    this->for_each_point_range(*m_ocproblem, m_num_mesh_points,
+            [&](const OCProblem& ocproblem, int begin, int end) {
+        for (int i_mesh = begin; i_mesh < end; ++i_mesh) {
+            const T time = duration * m_mesh[i_mesh] + initial_time;
+            ocproblem.calc_differential_algebraic_equations(
+                    {i_mesh, time, states.col(i_mesh), controls.col(i_mesh),
+                            adjuncts.col(i_mesh), m_empty_diffuse_col,
+                            parameters},
+                    {m_derivs.col(i_mesh),
+                            constr_view.path_constraints.col(i_mesh)});
+        }
+    });
 
     // Compute constraint defects.
     // ---------------------------
@@ -38,6 +38,13 @@ void ProblemDecorator::set_findiff_hessian_mode(std::string value) {
     m_findiff_hessian_mode = std::move(value);
 }
 
+void ProblemDecorator::set_ad_retaping(std::string value) {
+    TROPTER_VALUECHECK(
+            value == "check" || value == "never" || value == "always",
+            "ad_retaping", value, "'check', 'never', or 'always'");
+    m_ad_retaping = std::move(value);
+}
+
 // Explicit instantiation.
 
 template class Problem<double>;
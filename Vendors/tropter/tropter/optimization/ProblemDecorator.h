@@ -120,6 +120,30 @@ public:
     const std::string& get_findiff_hessian_mode() const;
     /// @}
 
+    /// @name Options for automatic differentiation
+    /// These options are only used when the scalar type is adouble.
+    /// @{
+
+    /// When to re-record the ADOL-C tapes of the objective, constraints,
+    /// and Lagrangian. The tapes are recorded once, when the sparsity is
+    /// computed, and are reused for all the iterations of the solve. A tape
+    /// is only valid at other variables if the control flow (the outcomes of
+    /// comparisons of adoubles, fabs(), fmin(), etc.) is the same as when it
+    /// was recorded; ADOL-C detects when it is not.
+    ///  - "check": default. Reuse the tapes while ADOL-C reports that they
+    ///    are valid, and re-record all tapes at the variables at which they
+    ///    are not. The sparsity of the re-recorded tapes must be contained in
+    ///    the sparsity given to the solver (otherwise, an exception is
+    ///    thrown).
+    ///  - "never": always reuse the tapes as recorded, which is only correct
+    ///    if the control flow does not depend on the variables.
+    ///  - "always": re-record the tapes at every new iterate; this is slow
+    ///    and is meant for debugging.
+    void set_ad_retaping(std::string value);
+    /// @copydoc set_ad_retaping()
+    const std::string& get_ad_retaping() const;
+    /// @}
+
 protected:
     template<typename ...Types>
     void print(const std::string& format_string, Types... args) const;
@@ -128,6 +152,7 @@ private:
     int m_verbosity = 1;
     double m_findiff_hessian_step_size = 1e-5;
     std::string m_findiff_hessian_mode = "fast";
+    std::string m_ad_retaping = "check";
 };
 
 inline int ProblemDecorator::get_verbosity() const
@@ -136,6 +161,8 @@ inline double ProblemDecorator::get_findiff_hessian_step_size() const
 {   return m_findiff_hessian_step_size; }
 inline const std::string& ProblemDecorator::get_findiff_hessian_mode() const
 {   return m_findiff_hessian_mode; }
+inline const std::string& ProblemDecorator::get_ad_retaping() const
+{   return m_ad_retaping; }
 template<typename ...Types>
 inline void ProblemDecorator::print(
         const std::string& format_string, Types... args) const {
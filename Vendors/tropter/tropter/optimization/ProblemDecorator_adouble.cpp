@@ -30,12 +30,57 @@
 #pragma warning(pop)
 #endif
 
+#include <map>
+
 using Eigen::VectorXd;
 using Eigen::Ref;
 
 namespace tropter {
 namespace optimization {
 
+namespace {
+// Find the position of each of the nonzeros (rows[i], cols[i]) in the
+// sparsity pattern given to the solver. The positions are left empty if the
+// nonzeros are those of the pattern, in the same order.
+void find_nonzero_positions(const SparsityCoordinates& solver_sparsity,
+        int num_nonzeros, const unsigned int* rows, const unsigned int* cols,
+        const std::string& name, std::vector<unsigned int>& positions) {
+    positions.clear();
+    if (num_nonzeros == (int)solver_sparsity.row.size() &&
+            std::equal(rows, rows + num_nonzeros,
+                    solver_sparsity.row.begin()) &&
+            std::equal(cols, cols + num_nonzeros,
+                    solver_sparsity.col.begin())) {
+        return;
+    }
+    std::map<std::pair<unsigned int, unsigned int>, unsigned int> indices;
+    for (unsigned int i = 0; i < solver_sparsity.row.size(); ++i) {
+        indices[{solver_sparsity.row[i], solver_sparsity.col[i]}] = i;
+    }
+    positions.resize(num_nonzeros);
+    for (int i = 0; i < num_nonzeros; ++i) {
+        const auto it = indices.find({rows[i], cols[i]});
+        TROPTER_THROW_IF(it == indices.end(),
+                "After re-recording the ADOL-C tapes, the %s has a nonzero "
+                "at (%i, %i) that is not in the sparsity pattern given to the "
+                "solver. Try detecting the sparsity at random variables, or "
+                "set ad_retaping to 'never'.", name, rows[i], cols[i]);
+        positions[i] = it->second;
+    }
+}
+
+// Copy the nonzeros computed with the sparsity of the re-recorded tapes to
+// their positions in the sparsity pattern given to the solver.
+void scatter_nonzeros(const std::vector<unsigned int>& positions,
+        const std::vector<double>& work, unsigned num_nonzeros,
+        double* nonzeros) {
+    std::fill(nonzeros, nonzeros + num_nonzeros, 0.0);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        nonzeros[positions[i]] = work[i];
+    }
+}
+} // namespace
+
 Problem<adouble>::Decorator::Decorator(
         const Problem<adouble>& problem) :
         ProblemDecorator(problem), m_problem(problem)
@@ -130,6 +175,8 @@ calc_sparsity(const Eigen::VectorXd& x,
                 jacobian_sparsity.col.data());
         // TODO don't duplicate the memory consumption for storing the sparsity
         // pattern: store the pointer to Ipopt's sparsity pattern?
+        m_solver_jacobian_sparsity = jacobian_sparsity;
+        m_jacobian_nonzero_positions.clear();
 
         //SparsityPattern jac_sparsity(num_constraints, num_variables,
         //        jacobian_row_indices, jacobian_col_indices);
@@ -141,6 +188,7 @@ calc_sparsity(const Eigen::VectorXd& x,
     TROPTER_THROW_IF(m_problem.get_use_supplied_sparsity_hessian_lagrangian(),
             "Cannot use supplied sparsity pattern for "
             "Hessian of Lagrangian when using automatic differentiation.");
+    m_provide_hessian_sparsity = provide_hessian_sparsity;
     if (provide_hessian_sparsity) {
         VectorXd lambda_vector = Eigen::VectorXd::Ones(num_constraints);
         double lagr_value; // Unused.
@@ -172,6 +220,9 @@ calc_sparsity(const Eigen::VectorXd& x,
         // Working memory to hold obj_factor and lambda (multipliers).
         m_hessian_obj_factor_lambda.resize(1 + num_constraints);
 
+        m_solver_hessian_sparsity = hessian_sparsity;
+        m_hessian_nonzero_positions.clear();
+
         //SparsityPattern hes_sparsity(num_variables, num_variables,
         //        hessian_sparsity.row, hessian_sparsity.col);
         //hes_sparsity.write("DEBUG_adolc_hessian_lagrangian_sparsity.csv");
@@ -180,27 +231,34 @@ calc_sparsity(const Eigen::VectorXd& x,
 
 void Problem<adouble>::Decorator::
 calc_objective(unsigned num_variables, const double* x,
-        bool /*new_x*/,
+        bool new_x,
         double& obj_value) const
 {
+    if (retape_at_new_variables(new_x)) retape(num_variables, x);
+    // The signature of ::function() should take a const double*; I'm
+    // fairly sure ADOL-C won't try to edit the independent variables.
     int status = ::function(m_objective_tag,
             1, // number of dependent variables.
             num_variables, // number of independent variables.
-            // The signature of ::function() should take a const double*; I'm
-            // fairly sure ADOL-C won't try to edit the independent variables.
             const_cast<double*>(x), &obj_value);
+    if (retape_after_status(status)) {
+        retape(num_variables, x);
+        status = ::function(m_objective_tag, 1, num_variables,
+                const_cast<double*>(x), &obj_value);
+    }
     // TODO create fancy return value checking (create a class for it).
     // check_adolc_driver_return_value(status);
-    //assert(status == 3);
-    assert(status >= 0);
-    // TODO if status != 3, retape.
+    assert(status >= 0 || get_ad_retaping() == "never");
 }
 
 void Problem<adouble>::Decorator::
 calc_constraints(unsigned num_variables, const double* variables,
-        bool /*new_variables*/,
+        bool new_variables,
         unsigned num_constraints, double* constr) const
 {
+    if (retape_at_new_variables(new_variables)) {
+        retape(num_variables, variables);
+    }
     // Evaluate the constraints tape.
     int status = ::function(m_constraints_tag,
             num_constraints, // number of dependent variables.
@@ -208,45 +266,70 @@ calc_constraints(unsigned num_variables, const double* variables,
             // The signature of ::function() should take a const double*; I'm
             // fairly sure ADOL-C won't try to edit the independent variables.
             const_cast<double*>(variables), constr);
-    //assert(status == 3);
-    assert(status >= 0);
+    if (retape_after_status(status)) {
+        retape(num_variables, variables);
+        status = ::function(m_constraints_tag, num_constraints,
+                num_variables, const_cast<double*>(variables), constr);
+    }
+    assert(status >= 0 || get_ad_retaping() == "never");
 }
 
 void Problem<adouble>::Decorator::
-calc_gradient(unsigned num_variables, const double* x, bool /*new_x*/,
+calc_gradient(unsigned num_variables, const double* x, bool new_x,
         double* grad) const
 {
+    if (retape_at_new_variables(new_x)) retape(num_variables, x);
     int status = ::gradient(m_objective_tag, num_variables, x, grad);
-    assert(status); // TODO error codes can be -2,-1,0,1,2,3; improve assert!
+    if (retape_after_status(status)) {
+        retape(num_variables, x);
+        status = ::gradient(m_objective_tag, num_variables, x, grad);
+    }
+    // TODO error codes can be -2,-1,0,1,2,3; improve assert!
+    assert(status >= 0 || get_ad_retaping() == "never");
 }
 
 void Problem<adouble>::Decorator::
-calc_jacobian(unsigned num_variables, const double* x, bool /*new_x*/,
-        unsigned /*num_nonzeros*/, double* jacobian_values) const
+calc_jacobian(unsigned num_variables, const double* x, bool new_x,
+        unsigned num_nonzeros, double* jacobian_values) const
 {
-    int repeated_call = 1; // We already have the sparsity structure.
-    int status = ::sparse_jac(m_constraints_tag, get_num_constraints(),
-            num_variables, repeated_call, x,
-            &m_jacobian_num_nonzeros,
-            &m_jacobian_row_indices, &m_jacobian_col_indices,
-            &jacobian_values, const_cast<int*>(m_sparse_jac_options.data()));
+    if (retape_at_new_variables(new_x)) retape(num_variables, x);
+    int status = -1;
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        // If the sparsity of the tape differs from that given to the solver,
+        // compute the nonzeros in the work memory.
+        double* values = m_jacobian_nonzero_positions.empty()
+                ? jacobian_values : m_jacobian_values_work.data();
+        int repeated_call = 1; // We already have the sparsity structure.
+        status = ::sparse_jac(m_constraints_tag, get_num_constraints(),
+                num_variables, repeated_call, x,
+                &m_jacobian_num_nonzeros,
+                &m_jacobian_row_indices, &m_jacobian_col_indices,
+                &values, const_cast<int*>(m_sparse_jac_options.data()));
+        if (attempt == 0 && retape_after_status(status)) {
+            retape(num_variables, x);
+            continue;
+        }
+        break;
+    }
     // TODO create enums for ADOL-C's return values.
-    //assert(status == 3);
-    assert(status >= 0);
-
-    // TODO if we call with repeated_call == 0, we must first delete the
-    // previous memory for row indices, etc.
+    assert(status >= 0 || get_ad_retaping() == "never");
+    if (!m_jacobian_nonzero_positions.empty()) {
+        scatter_nonzeros(m_jacobian_nonzero_positions, m_jacobian_values_work,
+                num_nonzeros, jacobian_values);
+    }
 }
 
 void Problem<adouble>::Decorator::
 calc_hessian_lagrangian(unsigned num_variables, const double* x,
-        bool /*new_x*/, double obj_factor,
+        bool new_x, double obj_factor,
         unsigned num_constraints, const double* lambda,
         bool /*new_lambda TODO */,
-        unsigned /*num_nonzeros*/, double* hessian_values) const
+        unsigned num_nonzeros, double* hessian_values) const
 {
     // TODO if not new_x, then do NOT re-eval objective()!!!
 
+    if (retape_at_new_variables(new_x)) retape(num_variables, x);
+
     int repeated_call = 1;
     // http://list.coin-or.org/pipermail/adol-c/2013-April/000900.html
     // TODO "since lambda changes, the Lagrangian function has to be
@@ -282,15 +365,98 @@ calc_hessian_lagrangian(unsigned num_variables, const double* x,
     m_hessian_obj_factor_lambda[0] = obj_factor;
     std::copy(lambda, lambda + num_constraints,
             m_hessian_obj_factor_lambda.begin() + 1);
-    set_param_vec(m_lagrangian_tag, 1 + num_constraints,
-            m_hessian_obj_factor_lambda.data());
-
-    int status = sparse_hess(m_lagrangian_tag, num_variables, repeated_call,
-            x, &m_hessian_num_nonzeros, &m_hessian_row_indices,
-            &m_hessian_col_indices,
-            &hessian_values,
-            const_cast<int*>(m_sparse_hess_options.data()));
-    assert(status >= 0);
+
+    int status = -1;
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        // The parameters are set again after the Lagrangian is re-recorded.
+        set_param_vec(m_lagrangian_tag, 1 + num_constraints,
+                m_hessian_obj_factor_lambda.data());
+        double* values = m_hessian_nonzero_positions.empty()
+                ? hessian_values : m_hessian_values_work.data();
+        status = sparse_hess(m_lagrangian_tag, num_variables, repeated_call,
+                x, &m_hessian_num_nonzeros, &m_hessian_row_indices,
+                &m_hessian_col_indices,
+                &values,
+                const_cast<int*>(m_sparse_hess_options.data()));
+        if (attempt == 0 && retape_after_status(status)) {
+            retape(num_variables, x);
+            continue;
+        }
+        break;
+    }
+    assert(status >= 0 || get_ad_retaping() == "never");
+    if (!m_hessian_nonzero_positions.empty()) {
+        scatter_nonzeros(m_hessian_nonzero_positions, m_hessian_values_work,
+                num_nonzeros, hessian_values);
+    }
+}
+
+void Problem<adouble>::Decorator::
+retape(unsigned num_variables, const double* x) const
+{
+    if (get_ad_retaping() == "check") {
+        print("Re-recording the ADOL-C tapes, since the control flow at the "
+              "current variables differs from that of the tapes.");
+    }
+    const unsigned num_constraints = get_num_constraints();
+
+    double obj_value; // Unused.
+    trace_objective(m_objective_tag, num_variables, x, obj_value);
+
+    // The sparsity of the derivatives of the new tapes is computed again
+    // (with repeated_call = 0), since ADOL-C's drivers keep the sparsity
+    // structure of the tape with which they were first called.
+    {
+        Eigen::VectorXd constraint_values(num_constraints); // Unused.
+        trace_constraints(m_constraints_tag, num_variables, x,
+                num_constraints, constraint_values.data());
+        delete [] m_jacobian_row_indices;
+        m_jacobian_row_indices = nullptr;
+        delete [] m_jacobian_col_indices;
+        m_jacobian_col_indices = nullptr;
+        int repeated_call = 0;
+        double* jacobian_values = nullptr; // Unused.
+        int status = ::sparse_jac(m_constraints_tag, num_constraints,
+                num_variables, repeated_call, x,
+                &m_jacobian_num_nonzeros,
+                &m_jacobian_row_indices, &m_jacobian_col_indices,
+                &jacobian_values,
+                const_cast<int*>(m_sparse_jac_options.data()));
+        TROPTER_THROW_IF(status < 0, "Could not compute the Jacobian of the "
+                "re-recorded constraints tape (ADOL-C status %i).", status);
+        delete [] jacobian_values;
+        find_nonzero_positions(m_solver_jacobian_sparsity,
+                m_jacobian_num_nonzeros,
+                m_jacobian_row_indices, m_jacobian_col_indices,
+                "Jacobian", m_jacobian_nonzero_positions);
+        m_jacobian_values_work.resize(m_jacobian_nonzero_positions.size());
+    }
+
+    if (m_provide_hessian_sparsity) {
+        VectorXd lambda_vector = Eigen::VectorXd::Ones(num_constraints);
+        double lagr_value; // Unused.
+        trace_lagrangian(m_lagrangian_tag, num_variables, x, 1.0,
+                num_constraints, lambda_vector.data(), lagr_value);
+        delete [] m_hessian_row_indices;
+        m_hessian_row_indices = nullptr;
+        delete [] m_hessian_col_indices;
+        m_hessian_col_indices = nullptr;
+        int repeated_call = 0;
+        double* hessian_values = nullptr; // Unused.
+        int status = ::sparse_hess(m_lagrangian_tag, num_variables,
+                repeated_call, x, &m_hessian_num_nonzeros,
+                &m_hessian_row_indices, &m_hessian_col_indices,
+                &hessian_values,
+                const_cast<int*>(m_sparse_hess_options.data()));
+        TROPTER_THROW_IF(status < 0, "Could not compute the Hessian of the "
+                "re-recorded Lagrangian tape (ADOL-C status %i).", status);
+        delete [] hessian_values;
+        find_nonzero_positions(m_solver_hessian_sparsity,
+                m_hessian_num_nonzeros,
+                m_hessian_row_indices, m_hessian_col_indices,
+                "Hessian of the Lagrangian", m_hessian_nonzero_positions);
+        m_hessian_values_work.resize(m_hessian_nonzero_positions.size());
+    }
 }
 
 void Problem<adouble>::Decorator::
@@ -18,11 +18,10 @@
 
 #include "Problem.h"
 #include "ProblemDecorator.h"
+#include <tropter/SparsityPattern.h>
 
 namespace tropter {
 
-struct SparsityCoordinates;
-
 namespace optimization {
 
 /// This specialization uses automatic differentiation (via ADOL-C) to
@@ -68,6 +67,20 @@ private:
             unsigned num_constraints, const double* lambda,
             double& lagrangian_value) const;
 
+    /// Whether the tapes must be re-recorded before evaluating them at new
+    /// variables (see set_ad_retaping()).
+    bool retape_at_new_variables(bool new_variables) const
+    {   return new_variables && get_ad_retaping() == "always"; }
+    /// Whether a (negative) return value of an ADOL-C driver shows that the
+    /// control flow at the evaluated variables differs from that of the tape,
+    /// and the tapes must be re-recorded.
+    bool retape_after_status(int status) const
+    {   return status < 0 && get_ad_retaping() != "never"; }
+    /// Re-record the tapes at the given variables, and find the sparsity of
+    /// their derivatives in the sparsity that calc_sparsity() gave to the
+    /// solver.
+    void retape(unsigned num_variables, const double* variables) const;
+
     const Problem<adouble>& m_problem;
 
     // ADOL-C
@@ -93,6 +106,19 @@ private:
     // Working memory for lambda multipliers and the "obj_factor."
     mutable std::vector<double> m_hessian_obj_factor_lambda;
     std::vector<int> m_sparse_hess_options;
+
+    // The sparsity patterns given to the solver by calc_sparsity(). If the
+    // tapes are re-recorded and the sparsity of their derivatives differs,
+    // the nonzeros are computed in the work memory and copied to their
+    // positions in these patterns. The positions are empty while the
+    // sparsity of the tapes is that given to the solver.
+    mutable bool m_provide_hessian_sparsity = false;
+    mutable SparsityCoordinates m_solver_jacobian_sparsity;
+    mutable SparsityCoordinates m_solver_hessian_sparsity;
+    mutable std::vector<unsigned int> m_jacobian_nonzero_positions;
+    mutable std::vector<unsigned int> m_hessian_nonzero_positions;
+    mutable std::vector<double> m_jacobian_values_work;
+    mutable std::vector<double> m_hessian_values_work;
 };
 
 } // namespace optimization
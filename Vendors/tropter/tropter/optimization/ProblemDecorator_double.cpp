@@ -341,8 +341,20 @@ calc_hessian_lagrangian(unsigned num_variables, const double* x_raw,
     Eigen::MatrixXd hescon_cc(num_constraints, num_jac_seeds);
     // Store perturbed values of constraints.
     VectorXd p2(num_constraints);
-    VectorXd p3(num_constraints);
     VectorXd p4(num_constraints);
+    // The constraints perturbed along each Jacobian seed do not depend on the
+    // Hessian seed, so they are computed once for all Hessian seeds. This
+    // evaluates the constraints 1 + H + J + H * J times (for H Hessian seeds
+    // and J Jacobian seeds) instead of 1 + H + 2 * H * J times.
+    Eigen::MatrixXd p3(num_constraints, num_jac_seeds);
+    VectorXd p3_col(num_constraints);
+    for (int ijacseed = 0; ijacseed < num_jac_seeds; ++ijacseed) {
+        p3_col.setZero();
+        m_problem.calc_constraints(x0 + eps * jac_seed.col(ijacseed), p3_col);
+        p3.col(ijacseed) = p3_col;
+    }
+    Eigen::VectorXd Bgunc_coeffs(num_jac_nonzeros);
+    Eigen::SparseMatrix<double> Bgunc;
 
     // Loop through Hessian seeds.
     for (int ihesseed = 0; ihesseed < num_hescon_seeds; ++ihesseed) {
@@ -353,20 +365,16 @@ calc_hessian_lagrangian(unsigned num_variables, const double* x_raw,
 
         for (int ijacseed = 0; ijacseed < num_jac_seeds; ++ijacseed) {
             const auto jac_direction = jac_seed.col(ijacseed);
-            p3.setZero();
-            m_problem.calc_constraints(x0 + eps * jac_direction, p3);
             p4.setZero();
             m_problem.calc_constraints(xb + eps * jac_direction, p4);
 
             // Finite difference.
-            hescon_cc.col(ijacseed) = (p1 - p2 - p3 + p4) / eps_squared;
+            hescon_cc.col(ijacseed) =
+                    (p1 - p2 - p3.col(ijacseed) + p4) / eps_squared;
         }
 
         // Recover (uncompress).
-        Eigen::VectorXd Bgunc_coeffs(num_jac_nonzeros);
         m_jacobian_coloring->recover(hescon_cc, Bgunc_coeffs.data());
-        // TODO preallocate:
-        Eigen::SparseMatrix<double> Bgunc;
         m_jacobian_coloring->convert(Bgunc_coeffs.data(), Bgunc);
 
         hescon_c.col(ihesseed) = Bgunc.transpose() * lambda;
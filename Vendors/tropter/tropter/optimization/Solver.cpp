@@ -89,6 +89,9 @@ void Solver::set_findiff_hessian_mode(std::string v) {
 void Solver::set_findiff_hessian_step_size(double v) {
     m_problem->set_findiff_hessian_step_size(v);
 }
+void Solver::set_ad_retaping(std::string v) {
+    m_problem->set_ad_retaping(std::move(v));
+}
 
 void Solver::print_option_values(std::ostream& stream) const {
     const std::string unset("<unset>");
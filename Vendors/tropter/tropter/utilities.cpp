@@ -16,6 +16,8 @@
 
 #include "utilities.h"
 
+#include "Exception.hpp"
+
 #include <cstdarg>
 #include <cstdio>
 #include <memory>
@@ -41,3 +43,83 @@ std::vector<double> tropter::linspace(double start, double end, int length) {
     std::vector<double> ret(tmp.data(), tmp.data() + length);
     return ret;
 }
+
+using tropter::ThreadPool;
+
+ThreadPool::ThreadPool(int num_threads) {
+    TROPTER_VALUECHECK(num_threads >= 1, "num_threads", num_threads,
+            "at least 1");
+    for (int i = 1; i < num_threads; ++i) {
+        m_workers.emplace_back(&ThreadPool::run_worker, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_loop_started.notify_all();
+    for (auto& worker : m_workers) worker.join();
+}
+
+void ThreadPool::parallel_for_each(
+        int size, const std::function<void(int)>& func) {
+    if (size <= 0) return;
+    if (m_workers.empty() || size == 1) {
+        for (int index = 0; index < size; ++index) func(index);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_func = &func;
+        m_size = size;
+        m_next = 0;
+        m_exceptions.assign(size, nullptr);
+        m_num_workers_running = (int)m_workers.size();
+        ++m_loop_index;
+    }
+    m_loop_started.notify_all();
+    run_iterations();
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_loop_finished.wait(lock, [this] {
+            return m_num_workers_running == 0;
+        });
+        m_func = nullptr;
+    }
+    for (const auto& exception : m_exceptions) {
+        if (exception) std::rethrow_exception(exception);
+    }
+}
+
+void ThreadPool::run_worker() {
+    long long last_loop_index = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_loop_started.wait(lock, [&] {
+                return m_stop || m_loop_index != last_loop_index;
+            });
+            if (m_stop) return;
+            last_loop_index = m_loop_index;
+        }
+        run_iterations();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_num_workers_running;
+        }
+        m_loop_finished.notify_one();
+    }
+}
+
+void ThreadPool::run_iterations() {
+    int index;
+    while ((index = m_next++) < m_size) {
+        try {
+            (*m_func)(index);
+        } catch (...) {
+            m_exceptions[index] = std::current_exception();
+        }
+    }
+}
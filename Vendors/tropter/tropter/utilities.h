@@ -16,8 +16,14 @@
 // limitations under the License.
 // ----------------------------------------------------------------------------
 
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace tropter {
@@ -59,6 +65,56 @@ private:
     std::ios m_format{nullptr};
 }; // StreamFormat
 
+/// A fixed set of threads that perform the iterations of parallel loops. The
+/// threads are created once rather than for each loop, so that loops that are
+/// run many times (e.g., evaluating the mesh points in every evaluation of the
+/// constraints) avoid the cost of creating threads.
+///
+/// @code
+/// ThreadPool pool(4);
+/// pool.parallel_for_each(num_points, [&](int index) {
+///     // ... evaluate point `index` ...
+/// });
+/// @endcode
+class ThreadPool {
+public:
+    /// Create a pool with `num_threads` threads in total, including the thread
+    /// that calls parallel_for_each().
+    explicit ThreadPool(int num_threads);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int get_num_threads() const { return (int)m_workers.size() + 1; }
+
+    /// Invoke `func(index)` for each index in [0, size), on all threads of the
+    /// pool (the calling thread included); each thread claims the next
+    /// unprocessed index once it is done with the previous one. Returns when
+    /// all iterations are done; if any iteration threw, the exception of the
+    /// lowest index is then rethrown. Only one thread at a time may invoke
+    /// this function, and not from within an iteration.
+    void parallel_for_each(int size, const std::function<void(int)>& func);
+
+private:
+    void run_worker();
+    void run_iterations();
+
+    std::vector<std::thread> m_workers;
+
+    // The current loop, and the state with which the workers are notified of
+    // it (guarded by m_mutex).
+    std::mutex m_mutex;
+    std::condition_variable m_loop_started;
+    std::condition_variable m_loop_finished;
+    long long m_loop_index = 0;
+    int m_num_workers_running = 0;
+    bool m_stop = false;
+    const std::function<void(int)>* m_func = nullptr;
+    int m_size = 0;
+    std::atomic<int> m_next{0};
+    std::vector<std::exception_ptr> m_exceptions;
+}; // ThreadPool
+
 } // namespace tropter
 
 #endif // TROPTER_UTILITIES_H_